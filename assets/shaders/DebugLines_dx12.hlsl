@@ -27,6 +27,32 @@ VSOut VS_DebugLines(VSIn vin)
     return v;
 }
 
+// Instanced wire shapes (DebugShapeInstance in DebugDraw.cppm).
+struct VSShapeIn
+{
+    float4 pos        : POSITION;  // unit shape vertex, w = capsule half (-1 bottom, +1 top, 0 none)
+    float4 centerHalf : TEXCOORD1; // per instance: center, capsule half length
+    float3 axisX      : TEXCOORD2;
+    float3 axisY      : TEXCOORD3;
+    float3 axisZ      : TEXCOORD4;
+    float4 col        : COLOR0;
+};
+
+VSOut VS_DebugShapes(VSShapeIn vin)
+{
+    const float3 capDir = vin.axisY * rsqrt(max(dot(vin.axisY, vin.axisY), 1e-12f));
+    const float3 worldPos = vin.centerHalf.xyz
+        + vin.axisX * vin.pos.x
+        + vin.axisY * vin.pos.y
+        + vin.axisZ * vin.pos.z
+        + capDir * (vin.pos.w * vin.centerHalf.w);
+
+    VSOut v;
+    v.posH = mul(float4(worldPos, 1.0f), uViewProj);
+    v.col = vin.col;
+    return v;
+}
+
 float4 PS_DebugLines(VSOut pin) : SV_TARGET
 {
     return pin.col;
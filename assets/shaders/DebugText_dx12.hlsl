@@ -1,21 +1,29 @@
 // DebugText_dx12.hlsl
-// Screen-space debug text rendering (pixel coords -> NDC)
+// Screen-space debug text rendering (pixel coords -> NDC), one instance per glyph.
 
 cbuffer DebugTextCB : register(b0)
 {
     float2 uInvViewportSize; // (1/width, 1/height)
-    float2 _pad;
+    uint uAtlasWidth;        // glyph atlas width in texels
+    uint _pad;
 };
 
+// 1 bit per texel, row-major, 32 texels per uint (BuildGlyphAtlasBits).
+StructuredBuffer<uint> gGlyphAtlas : register(t0);
+
 struct VSIn
 {
-    float2 posPx : POSITION; // pixel coordinates (0,0 is top-left)
-    float4 color : COLOR0; // from R8G8B8A8_UNORM, normalized to 0..1
+    float2 corner    : POSITION;  // quad corner, 0..1
+    float4 rectPx    : TEXCOORD1; // per instance: x, y, width, height in pixels (0,0 is top-left)
+    uint4  atlasRect : TEXCOORD2; // per instance: x, y, width, height in atlas texels
+    float4 color     : COLOR0;    // from R8G8B8A8_UNORM, normalized to 0..1
 };
 
 struct VSOut
 {
     float4 posH : SV_POSITION;
+    float2 atlasTexel : TEXCOORD0;
+    nointerpolation uint4 atlasRect : TEXCOORD1;
     float4 color : COLOR0;
 };
 
@@ -23,18 +31,28 @@ VSOut VS_DebugText(VSIn IN)
 {
     VSOut OUT;
 
+    const float2 posPx = IN.rectPx.xy + IN.corner * IN.rectPx.zw;
+
     // Convert pixel coords to NDC:
     // x: [0..W] -> [-1..+1]
     // y: [0..H] -> [+1..-1] (top-left origin, so invert)
-    float x = IN.posPx.x * uInvViewportSize.x * 2.0f - 1.0f;
-    float y = 1.0f - IN.posPx.y * uInvViewportSize.y * 2.0f;
+    float x = posPx.x * uInvViewportSize.x * 2.0f - 1.0f;
+    float y = 1.0f - posPx.y * uInvViewportSize.y * 2.0f;
 
     OUT.posH = float4(x, y, 0.0f, 1.0f);
+    OUT.atlasTexel = float2(IN.atlasRect.xy) + IN.corner * float2(IN.atlasRect.zw);
+    OUT.atlasRect = IN.atlasRect;
     OUT.color = IN.color;
     return OUT;
 }
 
 float4 PS_DebugText(VSOut IN) : SV_TARGET0
 {
+    const uint2 texel = clamp(uint2(IN.atlasTexel), IN.atlasRect.xy, IN.atlasRect.xy + IN.atlasRect.zw - 1);
+    const uint bit = texel.y * uAtlasWidth + texel.x;
+    if (((gGlyphAtlas[bit >> 5] >> (bit & 31)) & 1) == 0)
+    {
+        discard;
+    }
     return IN.color;
-}
\ No newline at end of file
+}
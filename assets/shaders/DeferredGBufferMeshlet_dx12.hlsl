@@ -0,0 +1,85 @@
+// DeferredGBufferMeshlet_dx12.hlsl
+// SM6.5 amplification + mesh shaders for the G-buffer pass. The pixel shader is PS_GBuffer from
+// DeferredGBuffer_dx12.hlsl: VSOut and the first 304 bytes of the constants match it.
+
+#include "Meshlet_dx12.hlsli"
+#include "GBufferMaterials_dx12.hlsli"
+
+cbuffer PerBatch : register(b0)
+{
+	float4x4 uViewProj;
+	float4x4 uLightViewProj;
+	float4 uCameraAmbient;
+	float4 uCameraForward;
+	float4 uBaseColor;
+	float4 uMaterialFlags;
+	float4 uPbrParams;
+	float4 uCounts;
+	float4 uShadowBias;
+	float4 uEnvProbeBoxMin;
+	float4 uEnvProbeBoxMax;
+	float4 uTexIndices0;
+	float4 uTexIndices1;
+
+	// MeshletGBufferConstants
+	float4 uPlanes[6];
+	uint4 uMeshlet; // firstMeshlet, meshletCount, first instance, instanceCount
+};
+
+struct VSOut
+{
+	float4 svPos : SV_POSITION;
+	float3 worldPos : TEXCOORD0;
+	float3 nrmW : TEXCOORD1;
+	float2 uv : TEXCOORD2;
+	float3 tangentW : TEXCOORD3;
+	float3 bitangentW : TEXCOORD4;
+	nointerpolation uint materialIndex : TEXCOORD5;
+};
+
+[numthreads(kMeshletsPerGroup, 1, 1)]
+void AS_GBufferMeshlet(uint threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+	AmplifyMeshlets(threadId, groupId.xy, uMeshlet, uPlanes, uCameraAmbient.xyz, true);
+}
+
+[outputtopology("triangle")]
+[numthreads(kMeshletThreads, 1, 1)]
+void MS_GBufferMeshlet(
+	uint threadId : SV_GroupThreadID,
+	uint groupId : SV_GroupID,
+	in payload MeshletPayload payload,
+	out vertices VSOut verts[kMeshletMaxVertices],
+	out indices uint3 tris[kMeshletMaxTriangles])
+{
+	const Meshlet m = gMeshlets[payload.meshlets[groupId]];
+	const InstanceData inst = gMeshletInstances[payload.instance];
+	const uint materialIndex = gInstanceMaterials[payload.instance];
+
+	SetMeshOutputCounts(m.vertexCount, m.triangleCount);
+
+	if (threadId < m.vertexCount)
+	{
+		const MeshletVertex v = LoadMeshletVertex(m, threadId);
+
+		// Same as VS_GBuffer (meshlet vertices are always full VertexDesc).
+		const float3 worldPos = MeshletTransformPoint(inst, v.pos);
+		const float3 nrmW = normalize(v.nrm.x * inst.i0.xyz + v.nrm.y * inst.i1.xyz + v.nrm.z * inst.i2.xyz);
+		float3 tangentW = normalize(v.tangent.x * inst.i0.xyz + v.tangent.y * inst.i1.xyz + v.tangent.z * inst.i2.xyz);
+		tangentW = normalize(tangentW - nrmW * dot(nrmW, tangentW));
+
+		VSOut OUT;
+		OUT.worldPos = worldPos;
+		OUT.nrmW = nrmW;
+		OUT.tangentW = tangentW;
+		OUT.bitangentW = normalize(cross(nrmW, tangentW)) * v.tangent.w;
+		OUT.uv = v.uv;
+		OUT.materialIndex = materialIndex;
+		OUT.svPos = mul(float4(worldPos, 1.0f), uViewProj);
+		verts[threadId] = OUT;
+	}
+	if (threadId < m.triangleCount)
+	{
+		tris[threadId] = MeshletTriangle(m, threadId);
+	}
+}
@@ -7,6 +7,7 @@ SamplerState gPointClamp : register(s2);
 SamplerState gLinearClamp : register(s3);
 
 #include "SkinningCommon_dx12.hlsli"
+#include "GBufferCompact_dx12.hlsli"
 
 // Bindless SRV heap view (space1) for material textures.
 Texture2D gBindlessTex[] : register(t0, space1);
@@ -184,6 +185,14 @@ float3x3 CotangentFrame(float3 N, float3 p, float2 uv)
 	return float3x3(T * invMax, B * invMax, N);
 }
 
+#if GBUFFER_COMPACT
+struct PSOut
+{
+	float4 rt0 : SV_Target0; // albedo.rgb (sRGB target), env selector
+	float2 rt1 : SV_Target1; // octahedral normal
+	float4 rt2 : SV_Target2; // roughness, metalness, ao, emissive scale
+};
+#else
 struct PSOut
 {
 	float4 rt0 : SV_Target0; // albedo.rgb, roughness
@@ -191,6 +200,7 @@ struct PSOut
 	float4 rt2 : SV_Target2; // emissive.rgb, ao
 	float4 rt3 : SV_Target3; // env selector
 };
+#endif
 
 // Flags must match C++ (DirectX12Renderer_RenderFrame_04_MainPass.inl)
 static const uint kFlagUseTex = 1u << 0;
@@ -268,18 +278,20 @@ PSOut PS_GBuffer(VSOut IN)
 	}
 
     // Encode to gbuffer
-	OUT.rt0 = float4(albedo, roughness);
-	OUT.rt1 = float4(N * 0.5f + 0.5f, metallic);
-	OUT.rt2 = float4(emissive, ao);
-	
 	// CPU packs:
 	// uEnvProbeBoxMin.w = envSource (0 = Skybox, 1 = ReflectionCapture)
-	// uEnvProbeBoxMax.xyz = packed reflection cubemap descriptor bytes / 255
+	// uEnvProbeBoxMax.w = normalized reflection probe index (decoded with uCounts.w probes)
 	const float envSource = saturate(uEnvProbeBoxMin.w);
-	OUT.rt3 = float4(envSource,
-	                 saturate(uEnvProbeBoxMax.x),
-	                 saturate(uEnvProbeBoxMax.y),
-	                 saturate(uEnvProbeBoxMax.z));
+#if GBUFFER_COMPACT
+	OUT.rt0 = float4(albedo, GBufferEncodeEnvSelector(envSource, uEnvProbeBoxMax.w, (uint)uCounts.w));
+	OUT.rt1 = GBufferOctEncode(N);
+	OUT.rt2 = float4(roughness, metallic, ao, GBufferEncodeEmissiveScale(emissive, albedo));
+#else
+	OUT.rt0 = float4(albedo, roughness);
+	OUT.rt1 = float4(N * 0.5f + 0.5f, metallic);
+	OUT.rt2 = float4(emissive, ao);
+	OUT.rt3 = float4(envSource, saturate(uEnvProbeBoxMax.w), 0.0f, 0.0f);
+#endif
 	
 	return OUT;
 }
\ No newline at end of file
@@ -1,5 +1,10 @@
 // DeferredGBuffer_dx12.hlsl
-// SM6 bindless material sampling (space1).
+// SM6 bindless material sampling (space1). The material comes from the material table
+// (GBufferMaterials_dx12.hlsli) through the instance's entry, so one batch can mix materials.
+
+#include "VertexCompact_dx12.hlsli"
+#include "GBufferCompact_dx12.hlsli"
+#include "GBufferMaterials_dx12.hlsli"
 
 SamplerState gLinear : register(s0);
 SamplerComparisonState gShadowCmp : register(s1);
@@ -15,17 +20,16 @@ cbuffer PerBatch : register(b0)
 	float4x4 uLightViewProj;
 	float4 uCameraAmbient;
 	float4 uCameraForward;
-	float4 uBaseColor;
-	float4 uMaterialFlags;
-	float4 uPbrParams;
+	float4 uBaseColor;     // unused (material table)
+	float4 uMaterialFlags; // unused (material table)
+	float4 uPbrParams;     // unused (material table)
 	float4 uCounts;
 	float4 uShadowBias;
 	float4 uEnvProbeBoxMin;
 	float4 uEnvProbeBoxMax;
 
-    // x=albedo, y=normal, z=metalness, w=roughness
-	float4 uTexIndices0;
-    // x=ao, y=emissive
+	float4 uTexIndices0;   // unused (material table)
+    // z = bits of the instanceBuffer_ index of the batch's first instance
 	float4 uTexIndices1;
 };
 
@@ -42,7 +46,7 @@ cbuffer PerBatch : register(b0)
 
 struct VSIn
 {
-	float3 pos : POSITION;
+	float4 pos : POSITION;
 	float3 nrm : NORMAL;
 	float2 uv : TEXCOORD0;
 	float4 tangent : TANGENT;
@@ -52,6 +56,8 @@ struct VSIn
 	float4 i1 : TEXCOORD2;
 	float4 i2 : TEXCOORD3;
 	float4 i3 : TEXCOORD4;
+
+	uint instanceId : SV_InstanceID;
 };
 
 struct VSOut
@@ -62,6 +68,7 @@ struct VSOut
 	float2 uv : TEXCOORD2;
 	float3 tangentW : TEXCOORD3;
 	float3 bitangentW : TEXCOORD4;
+	nointerpolation uint materialIndex : TEXCOORD5;
 };
 
 VSOut VS_GBuffer(VSIn IN)
@@ -69,16 +76,19 @@ VSOut VS_GBuffer(VSIn IN)
 	VSOut OUT;
 
 	const float3 worldPos = IN.pos.x * IN.i0.xyz + IN.pos.y * IN.i1.xyz + IN.pos.z * IN.i2.xyz + IN.i3.xyz;
-	const float3 nrmW = normalize(IN.nrm.x * IN.i0.xyz + IN.nrm.y * IN.i1.xyz + IN.nrm.z * IN.i2.xyz);
-	float3 tangentW = normalize(IN.tangent.x * IN.i0.xyz + IN.tangent.y * IN.i1.xyz + IN.tangent.z * IN.i2.xyz);
+	const float3 nrm = DecodeVertexNormal(IN.pos, IN.nrm);
+	const float4 tangent = DecodeVertexTangent(IN.pos, IN.tangent);
+	const float3 nrmW = normalize(nrm.x * IN.i0.xyz + nrm.y * IN.i1.xyz + nrm.z * IN.i2.xyz);
+	float3 tangentW = normalize(tangent.x * IN.i0.xyz + tangent.y * IN.i1.xyz + tangent.z * IN.i2.xyz);
 	tangentW = normalize(tangentW - nrmW * dot(nrmW, tangentW));
-	const float3 bitangentW = normalize(cross(nrmW, tangentW)) * IN.tangent.w;
+	const float3 bitangentW = normalize(cross(nrmW, tangentW)) * tangent.w;
 
 	OUT.worldPos = worldPos;
 	OUT.nrmW = nrmW;
 	OUT.tangentW = tangentW;
 	OUT.bitangentW = bitangentW;
 	OUT.uv = IN.uv;
+	OUT.materialIndex = gInstanceMaterials[asuint(uTexIndices1.z) + IN.instanceId];
 
 	OUT.svPos = mul(float4(worldPos, 1.0f), uViewProj);
 	return OUT;
@@ -101,6 +111,14 @@ float3x3 CotangentFrame(float3 N, float3 p, float2 uv)
 	return float3x3(T * invMax, B * invMax, N);
 }
 
+#if GBUFFER_COMPACT
+struct PSOut
+{
+	float4 rt0 : SV_Target0; // albedo.rgb (sRGB target), env selector
+	float2 rt1 : SV_Target1; // octahedral normal
+	float4 rt2 : SV_Target2; // roughness, metalness, ao, emissive scale
+};
+#else
 struct PSOut
 {
 	float4 rt0 : SV_Target0; // albedo.rgb, roughness
@@ -108,8 +126,9 @@ struct PSOut
 	float4 rt2 : SV_Target2; // emissive.rgb, ao
 	float4 rt3 : SV_Target3; // env selector
 };
+#endif
 
-// Flags must match C++ (DirectX12Renderer_RenderFrame_04_MainPass.inl)
+// Flags must match C++ (kGBufferFlag* in CommonDX12Structs.cppm)
 static const uint kFlagUseTex = 1u << 0;
 static const uint kFlagUseNormal = 1u << 2;
 static const uint kFlagUseMetalTex = 1u << 3;
@@ -121,17 +140,18 @@ PSOut PS_GBuffer(VSOut IN)
 {
 	PSOut OUT;
 
-	const uint flags = asuint(uMaterialFlags.w);
+	const MaterialGpu material = gMaterials[IN.materialIndex];
+	const uint flags = material.textures1.z;
 
-	const uint albedoIdx = (uint) uTexIndices0.x;
-	const uint normalIdx = (uint) uTexIndices0.y;
-	const uint metalIdx = (uint) uTexIndices0.z;
-	const uint roughIdx = (uint) uTexIndices0.w;
+	const uint albedoIdx = material.textures0.x;
+	const uint normalIdx = material.textures0.y;
+	const uint metalIdx = material.textures0.z;
+	const uint roughIdx = material.textures0.w;
 
-	const uint aoIdx = (uint) uTexIndices1.x;
-	const uint emissiveIdx = (uint) uTexIndices1.y;
+	const uint aoIdx = material.textures1.x;
+	const uint emissiveIdx = material.textures1.y;
 
-	float3 albedo = uBaseColor.rgb;
+	float3 albedo = material.baseColor.rgb;
 	if ((flags & kFlagUseTex) != 0u && albedoIdx != 0u)
 	{
         // Non-uniform indexing (bindless)
@@ -139,19 +159,19 @@ PSOut PS_GBuffer(VSOut IN)
 		albedo *= t.rgb;
 	}
 
-	float metallic = saturate(uPbrParams.x);
+	float metallic = saturate(material.pbr.x);
 	if ((flags & kFlagUseMetalTex) != 0u && metalIdx != 0u)
 	{
 		metallic = gBindlessTex[NonUniformResourceIndex(metalIdx)].Sample(gLinear, IN.uv).r;
 	}
 
-	float roughness = saturate(uPbrParams.y);
+	float roughness = saturate(material.pbr.y);
 	if ((flags & kFlagUseRoughTex) != 0u && roughIdx != 0u)
 	{
 		roughness = gBindlessTex[NonUniformResourceIndex(roughIdx)].Sample(gLinear, IN.uv).r;
 	}
 
-	float ao = saturate(uPbrParams.z);
+	float ao = saturate(material.pbr.z);
 	if ((flags & kFlagUseAOTex) != 0u && aoIdx != 0u)
 	{
 		ao = gBindlessTex[NonUniformResourceIndex(aoIdx)].Sample(gLinear, IN.uv).r;
@@ -177,7 +197,7 @@ PSOut PS_GBuffer(VSOut IN)
 		N = normalize(mul(nTS, TBN));
 	}
 
-	float emissiveStrength = max(uPbrParams.w, 0.0f);
+	float emissiveStrength = max(material.pbr.w, 0.0f);
 	float3 emissive = 0.0f;
 	if ((flags & kFlagUseEmissive) != 0u && emissiveIdx != 0u)
 	{
@@ -185,18 +205,22 @@ PSOut PS_GBuffer(VSOut IN)
 	}
 
     // Encode to gbuffer
+	// CPU packs the batch's probe:
+	// uEnvProbeBoxMin.w = 1 when the batch has a captured probe (0 = Skybox)
+	// uEnvProbeBoxMax.w = normalized reflection probe index (decoded with uCounts.w probes)
+	// and the material picks whether it uses it.
+	const float envSource = (material.textures1.w != 0u) ? saturate(uEnvProbeBoxMin.w) : 0.0f;
+	const float envProbeN = (material.textures1.w != 0u) ? uEnvProbeBoxMax.w : 0.0f;
+#if GBUFFER_COMPACT
+	OUT.rt0 = float4(albedo, GBufferEncodeEnvSelector(envSource, envProbeN, (uint)uCounts.w));
+	OUT.rt1 = GBufferOctEncode(N);
+	OUT.rt2 = float4(roughness, metallic, ao, GBufferEncodeEmissiveScale(emissive, albedo));
+#else
 	OUT.rt0 = float4(albedo, roughness);
 	OUT.rt1 = float4(N * 0.5f + 0.5f, metallic);
 	OUT.rt2 = float4(emissive, ao);
-	
-	// CPU packs:
-	// uEnvProbeBoxMin.w = envSource (0 = Skybox, 1 = ReflectionCapture)
-	// uEnvProbeBoxMax.xyz = packed reflection cubemap descriptor bytes / 255
-	const float envSource = saturate(uEnvProbeBoxMin.w);
-	OUT.rt3 = float4(envSource,
-	                 saturate(uEnvProbeBoxMax.x),
-	                 saturate(uEnvProbeBoxMax.y),
-	                 saturate(uEnvProbeBoxMax.z));
+	OUT.rt3 = float4(envSource, saturate(envProbeN), 0.0f, 0.0f);
+#endif
 	
 	return OUT;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 // DeferredLighting_dx12.hlsl
 // Fullscreen deferred lighting resolve.
 
+#include "GBufferCompact_dx12.hlsli"
+
 SamplerState gLinear : register(s0);
 SamplerComparisonState gShadowCmp : register(s1);
 SamplerState gPointClamp : register(s2);
@@ -9,11 +11,18 @@ SamplerState gLinearClamp : register(s3);
 // -----------------------------------------------------------------------------
 // GBuffer + depth
 // -----------------------------------------------------------------------------
+#if GBUFFER_COMPACT
+Texture2D gGBuffer0 : register(t0); // albedo.rgb (sRGB), env selector
+Texture2D<float2> gGBuffer1 : register(t1); // octahedral normal
+Texture2D gGBuffer2 : register(t2); // roughness, metalness, ao, emissive scale
+Texture2D<float> gDepth : register(t3); // depth SRV (0..1)
+#else
 Texture2D gGBuffer0 : register(t0); // albedo.rgb, roughness
 Texture2D gGBuffer1 : register(t1); // normal.xyz (encoded), metalness
 Texture2D gGBuffer2 : register(t2); // emissive.rgb, ao
 Texture2D<float> gDepth : register(t3); // depth SRV (0..1)
 Texture2D gGBuffer3 : register(t4); // env selector: r=envSource, g=probeIdxN
+#endif
 
 // -----------------------------------------------------------------------------
 // Shadows
@@ -28,8 +37,9 @@ struct ShadowDataSB
     float4 dirSplits; // { split1, split2, split3(max), fadeFrac }
     float4 dirInfo;   // { invAtlasW, invAtlasH, invTileRes, cascadeCount }
 
-    float4 spotVPRows[16];
-    float4 spotInfo[4];
+    float4 spotVPRows[32];
+    float4 spotInfo[8];
+    float4 spotAtlasRect[8]; // { u0, v0, tileSize / atlasSize, 1 / tileSize }
 
     float4 pointPosRange[4];
     float4 pointInfo[4];
@@ -37,11 +47,8 @@ struct ShadowDataSB
 
 StructuredBuffer<ShadowDataSB> gShadowData : register(t6);
 
-// Spot shadow maps (depth)
-Texture2D<float> gSpotShadow0 : register(t7);
-Texture2D<float> gSpotShadow1 : register(t8);
-Texture2D<float> gSpotShadow2 : register(t9);
-Texture2D<float> gSpotShadow3 : register(t10);
+// Spot shadow atlas (depth): every spot shadow is a tile of it (ShadowDataSB::spotAtlasRect)
+Texture2D<float> gSpotShadowAtlas : register(t7);
 
 // Point distance cubemaps (normalized distance) as Texture2DArray[6] (cubemap faces)
 Texture2DArray<float> gPointShadow0 : register(t11);
@@ -81,6 +88,12 @@ struct GPULight
 
 StructuredBuffer<GPULight> gLights : register(t16);
 
+// Clustered light lists (t20), rebuilt on the CPU for the main camera every frame (LightClusterBuilder):
+//   [0..15] header: grid xyz, global count, tiles per pixel xy, depth slice scale/bias,
+//           camera pos + global list offset, camera forward + enabled flag
+//   [16..]  per-cluster (offset, count), then the light indices they point at
+StructuredBuffer<uint> gLightClusters : register(t20);
+
 // -----------------------------------------------------------------------------
 // Constants
 // -----------------------------------------------------------------------------
@@ -364,7 +377,7 @@ float3 BoxProjectReflectionDir(
 // -----------------------------------------------------------------------------
 // Shared shadow helpers (spot + point)
 // -----------------------------------------------------------------------------
-static const uint kMaxSpotShadows = 4u;
+static const uint kMaxSpotShadows = 8u;
 static const uint kMaxPointShadows = 4u;
 
 float SlopeScaleTerm(float NdotL)
@@ -385,21 +398,31 @@ float ComputeBiasTexels(float NdotL,
          + extraBiasTexels;
 }
 
-float Shadow2D(Texture2D<float> shadowMap, float4 shadowClip, float biasTexels)
+// ---------------- Spot shadow atlas ----------------
+// Every spot shadow is a square tile of one atlas: spotAtlasRect[slot] = { u0, v0, tileSize / atlasSize, 1 / tileSize }.
+// Tile-clamped 3x3 PCF as in ShadowAtlasCSM, so taps never read a neighbouring light's tile.
+float ShadowAtlasSpot(float4 clip, float4 rect, float biasTexels)
 {
-    float3 p = shadowClip.xyz / max(shadowClip.w, 1e-6f);
-
+    float3 p = clip.xyz / max(clip.w, 1e-6f);
     if (p.z < 0.0f || p.z > 1.0f)
         return 1.0f;
 
-    float2 uv = float2(p.x, -p.y) * 0.5f + 0.5f;
+    // NDC -> tile-local UV (flip Y); outside the light frustum => fully lit.
+    float2 uvLocal = float2(p.x, -p.y) * 0.5f + 0.5f;
+    if (uvLocal.x < 0.0f || uvLocal.x > 1.0f || uvLocal.y < 0.0f || uvLocal.y > 1.0f)
+        return 1.0f;
+
+    // Bias in tile texels, so a smaller tile gets a proportionally larger depth bias.
+    const float z = p.z - biasTexels * rect.w;
 
-    uint w, h;
-    shadowMap.GetDimensions(w, h);
-    float2 texel = 1.0f / float2(max(w, 1u), max(h, 1u));
+    const float2 uvMin = rect.xy;
+    const float2 uvMax = rect.xy + rect.zz;
+    const float2 uv = uvMin + uvLocal * rect.z;
 
-    float biasDepth = biasTexels * max(texel.x, texel.y);
-    float z = p.z - biasDepth;
+    // One tile texel in atlas UV, and a guard band against taps outside the tile.
+    const float2 stepUV = (rect.z * rect.w).xx;
+    const float2 uvMinP = uvMin + stepUV * 1.5f;
+    const float2 uvMaxP = uvMax - stepUV * 1.5f;
 
     float s = 0.0f;
     [unroll]
@@ -408,15 +431,14 @@ float Shadow2D(Texture2D<float> shadowMap, float4 shadowClip, float biasTexels)
         [unroll]
         for (int x = -1; x <= 1; ++x)
         {
-            s += shadowMap.SampleCmpLevelZero(gShadowCmp, uv + texel * float2(x, y), z);
+            const float2 uvTap = uv + stepUV * float2((float)x, (float)y);
+            const float inside = step(uvMinP.x, uvTap.x) * step(uvTap.x, uvMaxP.x) * step(uvMinP.y, uvTap.y) * step(uvTap.y, uvMaxP.y);
+            const float sample = gSpotShadowAtlas.SampleCmpLevelZero(gShadowCmp, uvTap, z);
+            s += lerp(1.0f, sample, inside);
         }
     }
 
-    float shadow = s / 9.0f;
-
-    float edge = min(min(uv.x, uv.y), min(1.0f - uv.x, 1.0f - uv.y));
-    float fade = saturate(edge / (2.0f * max(texel.x, texel.y)));
-    return lerp(1.0f, shadow, fade);
+    return s / 9.0f;
 }
 
 int FindSpotShadowSlot(uint lightIndex, uint spotShadowCount)
@@ -447,9 +469,50 @@ int FindPointShadowSlot(uint lightIndex, uint pointShadowCount)
     return -1;
 }
 
+struct LightClusterRange
+{
+    uint globalBegin;
+    uint globalCount;
+    uint clusterBegin;
+    uint clusterCount;
+};
+
+// False when the lists are disabled: the caller loops every light instead.
+bool GetLightClusterRange(float2 pixelPos, float3 worldPos, out LightClusterRange range)
+{
+    range = (LightClusterRange)0;
+    if (gLightClusters[15] == 0u)
+        return false;
+
+    const uint3 grid = uint3(gLightClusters[0], gLightClusters[1], gLightClusters[2]);
+    const float3 camPos = float3(asfloat(gLightClusters[8]), asfloat(gLightClusters[9]), asfloat(gLightClusters[10]));
+    const float3 camFwd = float3(asfloat(gLightClusters[12]), asfloat(gLightClusters[13]), asfloat(gLightClusters[14]));
+    const float viewZ = max(dot(worldPos - camPos, camFwd), 1e-4f);
+    const float slice = log(viewZ) * asfloat(gLightClusters[6]) + asfloat(gLightClusters[7]);
+
+    const uint x = min((uint)(pixelPos.x * asfloat(gLightClusters[4])), grid.x - 1u);
+    const uint y = min((uint)(pixelPos.y * asfloat(gLightClusters[5])), grid.y - 1u);
+    const uint z = (uint)clamp(slice, 0.0f, (float)(grid.z - 1u));
+    const uint cluster = (z * grid.y + y) * grid.x + x;
+
+    range.globalBegin = gLightClusters[11];
+    range.globalCount = gLightClusters[3];
+    range.clusterBegin = gLightClusters[16u + cluster * 2u];
+    range.clusterCount = gLightClusters[17u + cluster * 2u];
+    return true;
+}
+
+// k-th light of the range: the global (directional) lights first, then the cluster's own.
+uint LightClusterLight(LightClusterRange range, uint k)
+{
+    return (k < range.globalCount)
+        ? gLightClusters[range.globalBegin + k]
+        : gLightClusters[range.clusterBegin + (k - range.globalCount)];
+}
+
 float SpotShadowFactor(uint slot, ShadowDataSB sd, float3 worldPos, float biasTexels)
 {
-    if (slot >= 4u)
+    if (slot >= kMaxSpotShadows)
         return 1.0f;
 
     float4 r0 = sd.spotVPRows[slot * 4u + 0u];
@@ -460,10 +523,7 @@ float SpotShadowFactor(uint slot, ShadowDataSB sd, float3 worldPos, float biasTe
     float4x4 VP = float4x4(r0, r1, r2, r3);
     float4 clip = mul(float4(worldPos, 1.0f), VP);
 
-    if (slot == 0u) return Shadow2D(gSpotShadow0, clip, biasTexels);
-    if (slot == 1u) return Shadow2D(gSpotShadow1, clip, biasTexels);
-    if (slot == 2u) return Shadow2D(gSpotShadow2, clip, biasTexels);
-    return Shadow2D(gSpotShadow3, clip, biasTexels);
+    return ShadowAtlasSpot(clip, sd.spotAtlasRect[slot], biasTexels);
 }
 
 struct CubeFaceUV
@@ -583,6 +643,22 @@ float PointShadowFactor(uint slot, ShadowDataSB sd, float3 worldPos, float biasT
 // -----------------------------------------------------------------------------
 float4 PS_DeferredLighting(VSOut IN) : SV_Target0
 {
+#if GBUFFER_COMPACT
+    const float4 g0 = gGBuffer0.Sample(gPointClamp, IN.uv);
+    const float2 g1 = gGBuffer1.Sample(gPointClamp, IN.uv);
+    const float4 g2 = gGBuffer2.Sample(gPointClamp, IN.uv);
+
+    float3 albedo = g0.rgb;
+    float roughness = saturate(g2.r);
+
+    float3 N = GBufferOctDecode(g1);
+    float metallic = saturate(g2.g);
+
+    float3 emissive = GBufferDecodeEmissive(g2.a, albedo);
+    float ao = saturate(g2.b);
+
+    const float2 envSel = GBufferDecodeEnvSelector(g0.a, (uint)uCounts.w);
+#else
     float4 g0 = gGBuffer0.Sample(gPointClamp, IN.uv);
     float4 g1 = gGBuffer1.Sample(gPointClamp, IN.uv);
     float4 g2 = gGBuffer2.Sample(gPointClamp, IN.uv);
@@ -596,9 +672,10 @@ float4 PS_DeferredLighting(VSOut IN) : SV_Target0
     float3 emissive = g2.rgb;
     float ao = saturate(g2.a);
 
-    ao *= saturate(gSSAO.Sample(gPointClamp, IN.uv).r);
-
     const float2 envSel = gGBuffer3.SampleLevel(gPointClamp, IN.uv, 0).rg;
+#endif
+
+    ao *= saturate(gSSAO.Sample(gPointClamp, IN.uv).r);
 
     float depth = gDepth.Sample(gPointClamp, IN.uv).r;
     if (depth >= 0.999999f)
@@ -616,11 +693,16 @@ float4 PS_DeferredLighting(VSOut IN) : SV_Target0
     const float viewDist = max(0.0f, dot(worldPos - camPos, uCameraForward.xyz));
     const uint lightCount = (uint)uCounts.x;
 
+    LightClusterRange clusterRange;
+    const bool clustered = GetLightClusterRange(IN.svPos.xy, worldPos, clusterRange);
+    const uint loopCount = clustered ? (clusterRange.globalCount + clusterRange.clusterCount) : lightCount;
+
     float3 Lo = 0.0f;
 
     [loop]
-    for (uint i = 0; i < lightCount; ++i)
+    for (uint k = 0; k < loopCount; ++k)
     {
+        const uint i = clustered ? LightClusterLight(clusterRange, k) : k;
         GPULight l = gLights[i];
         const uint type = (uint)l.p0.w;
 
@@ -1,16 +1,43 @@
-#version 330 core
+#version 450 core
+#ifdef BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
 in vec2 vUV;
 in vec3 vN;
 out vec4 oColor;
 
-uniform sampler2D uTex;
-uniform int uUseTex;
-uniform vec4 uColor;
+#ifdef BINDLESS
+// TextureDescIndex -> texture handle (OpenGLRHI's bindless table, SSBO binding 0).
+layout(std430, binding = 0) readonly buffer BindlessTextures
+{
+  uvec2 gTextures[];
+};
+#else
+layout(binding = 0) uniform sampler2D uTex;
+#endif
+
+// Per-batch constants (std140), streamed by the OpenGL RHI's constant ring. Must match VS.vert and
+// GLMeshRenderer::BatchConstants.
+layout(std140, binding = 0) uniform PerBatch
+{
+  mat4 uViewProj;
+  vec4 uColor;
+  int uUseTex;
+  uint uAlbedoIndex;
+};
 
 void main()
 {
   float ndotl = max(dot(normalize(vN), normalize(vec3(0.3,1.0,0.2))), 0.0);
   vec4 c = uColor;
-  if (uUseTex != 0) c = texture(uTex, vUV);
+  if (uUseTex != 0)
+  {
+#ifdef BINDLESS
+    // uAlbedoIndex is the same for the whole draw, as ARB_bindless_texture requires.
+    c = texture(sampler2D(gTextures[uAlbedoIndex]), vUV);
+#else
+    c = texture(uTex, vUV);
+#endif
+  }
   oColor = vec4(c.rgb * (0.2 + 0.8 * ndotl), c.a);
 }
@@ -0,0 +1,68 @@
+#ifndef CORE_GBUFFER_COMPACT_DX12_HLSLI
+#define CORE_GBUFFER_COMPACT_DX12_HLSLI
+
+// Compact deferred G-buffer (RendererSettings::compactGBuffer, GBUFFER_COMPACT=1), 12 bytes/pixel:
+//   rt0 RGBA8_UNORM_SRGB: albedo.rgb, env selector (0 = skybox, else reflection probe index + 1, / 255)
+//   rt1 RG16_UNORM:       octahedral world normal
+//   rt2 RGBA8_UNORM:      roughness, metalness, ao, emissive scale
+// Emissive is stored as a scale of albedo (sqrt-encoded up to kGBufferEmissiveScaleMax).
+
+static const float kGBufferEmissiveScaleMax = 32.0f;
+
+float2 GBufferOctEncode(float3 n)
+{
+	n /= (abs(n.x) + abs(n.y) + abs(n.z));
+	float2 e = n.xy;
+	if (n.z < 0.0f)
+	{
+		e = (1.0f - abs(n.yx)) * float2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+	}
+	return e * 0.5f + 0.5f;
+}
+
+float3 GBufferOctDecode(float2 encoded)
+{
+	const float2 e = encoded * 2.0f - 1.0f;
+	float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+	const float t = saturate(-n.z);
+	n.x += (n.x >= 0.0f) ? -t : t;
+	n.y += (n.y >= 0.0f) ? -t : t;
+	return normalize(n);
+}
+
+// envSource / probeIdxN as packed by the CPU (ComputeDeferredGBufferReflectionMeta).
+float GBufferEncodeEnvSelector(float envSource, float probeIdxN, uint probeCount)
+{
+	if (envSource < 0.5f || probeCount == 0u)
+	{
+		return 0.0f;
+	}
+	const uint probeIdx = min((uint)(saturate(probeIdxN) * (float)probeCount), probeCount - 1u);
+	return (float)(probeIdx + 1u) / 255.0f;
+}
+
+// Returns the layout of the full G-buffer's env selector: x = envSource, y = probeIdxN.
+float2 GBufferDecodeEnvSelector(float encoded, uint probeCount)
+{
+	const uint code = (uint)round(saturate(encoded) * 255.0f);
+	if (code == 0u || probeCount == 0u)
+	{
+		return float2(0.0f, 0.0f);
+	}
+	return float2(1.0f, ((float)(code - 1u) + 0.5f) / (float)probeCount);
+}
+
+float GBufferEncodeEmissiveScale(float3 emissive, float3 albedo)
+{
+	const float3 lumaWeights = float3(0.2126f, 0.7152f, 0.0722f);
+	const float emissiveLuma = dot(emissive, lumaWeights);
+	const float albedoLuma = max(dot(albedo, lumaWeights), 1.0f / 255.0f);
+	return sqrt(saturate(emissiveLuma / albedoLuma / kGBufferEmissiveScaleMax));
+}
+
+float3 GBufferDecodeEmissive(float encodedScale, float3 albedo)
+{
+	return albedo * (encodedScale * encodedScale * kGBufferEmissiveScaleMax);
+}
+
+#endif
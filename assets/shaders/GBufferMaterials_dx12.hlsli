@@ -0,0 +1,19 @@
+#ifndef CORE_GBUFFER_MATERIALS_DX12_HLSLI
+#define CORE_GBUFFER_MATERIALS_DX12_HLSLI
+
+// Deferred G-buffer material table (MaterialGpu / PackMaterialGpu in CommonDX12Structs.cppm).
+// gMaterials[0] = items without a material, gMaterials[h] = the scene material with handle id h.
+// gInstanceMaterials holds the table index of every instanceBuffer_ entry of the main pass.
+
+struct MaterialGpu
+{
+	float4 baseColor;
+	float4 pbr;      // metallic, roughness, ao, emissiveStrength
+	uint4 textures0; // albedo, normal, metalness, roughness (bindless descriptor indices)
+	uint4 textures1; // ao, emissive, flags, env source (1 = reflection capture)
+};
+
+StructuredBuffer<MaterialGpu> gMaterials : register(t7);
+StructuredBuffer<uint> gInstanceMaterials : register(t8);
+
+#endif
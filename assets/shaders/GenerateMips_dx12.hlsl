@@ -0,0 +1,243 @@
+// Mip generation (compute), single pass in the style of AMD's SPD. The device compiles this file
+// itself for CommandGenerateMips. Each group reduces a 64x64 tile of the source level (relative
+// mip 0) down to one texel of relative mip 6: every thread turns a 4x4 block into 2x2 texels of
+// mip 1 and one of mip 2, the rest goes through groupshared memory. When more than six levels are
+// wanted, the last group of a slice to finish (atomic counter in gCounters) reads all of mip 6
+// back and reduces it down to mip 12 the same way. The host caps the source at 4096 texels per
+// side for those passes so mip 6 fits one tile.
+//
+// Every texel is the box average of its 2x2 children; odd edges clamp to the last row/column.
+// sRGB data is averaged in linear space, normal maps as renormalized vectors. One dispatch covers
+// every array slice (cube faces): SV_GroupID.z is the slice.
+
+cbuffer GenerateMipsCB : register(b0)
+{
+	uint2 uSrcSize;    // relative mip 0
+	uint uMipCount;    // levels written: relative mips 1..uMipCount (at most 12)
+	uint uFlags;       // 1 = sRGB, 2 = normal map
+	uint uGroupCount;  // groups per slice (x * y)
+	uint3 uPad;
+};
+
+static const uint kFlagSrgb = 1u;
+static const uint kFlagNormal = 2u;
+
+RWTexture2DArray<unorm float4> gMip0 : register(u0);
+RWTexture2DArray<unorm float4> gMip1 : register(u1);
+RWTexture2DArray<unorm float4> gMip2 : register(u2);
+RWTexture2DArray<unorm float4> gMip3 : register(u3);
+RWTexture2DArray<unorm float4> gMip4 : register(u4);
+RWTexture2DArray<unorm float4> gMip5 : register(u5);
+// Written by every group, read back by the last one.
+globallycoherent RWTexture2DArray<unorm float4> gMip6 : register(u6);
+RWTexture2DArray<unorm float4> gMip7 : register(u7);
+RWTexture2DArray<unorm float4> gMip8 : register(u8);
+RWTexture2DArray<unorm float4> gMip9 : register(u9);
+RWTexture2DArray<unorm float4> gMip10 : register(u10);
+RWTexture2DArray<unorm float4> gMip11 : register(u11);
+RWTexture2DArray<unorm float4> gMip12 : register(u12);
+// One counter per slice; the last group resets it for the next dispatch.
+globallycoherent RWStructuredBuffer<uint> gCounters : register(u13);
+
+groupshared float4 gTile[16][16];
+groupshared uint gIsLastGroup;
+
+uint2 LevelSize(uint level)
+{
+	return max(uSrcSize >> level, uint2(1u, 1u));
+}
+
+float3 SrgbToLinear(float3 c)
+{
+	return (c <= 0.04045) ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+float3 LinearToSrgb(float3 c)
+{
+	c = saturate(c);
+	return (c <= 0.0031308) ? c * 12.92 : 1.055 * pow(c, 1.0 / 2.4) - 0.055;
+}
+
+float3 NormalizeOrFlat(float3 n)
+{
+	const float lenSq = dot(n, n);
+	return (lenSq > 1e-12) ? n * rsqrt(lenSq) : float3(0.0, 0.0, 1.0);
+}
+
+// Stored texel -> working space (linear color or unit normal).
+float4 Decode(float4 v)
+{
+	if (uFlags & kFlagNormal)
+	{
+		return float4(NormalizeOrFlat(v.xyz * 2.0 - 1.0), v.w);
+	}
+	if (uFlags & kFlagSrgb)
+	{
+		return float4(SrgbToLinear(v.rgb), v.a);
+	}
+	return v;
+}
+
+float4 Encode(float4 v)
+{
+	if (uFlags & kFlagNormal)
+	{
+		return float4(v.xyz * 0.5 + 0.5, v.w);
+	}
+	if (uFlags & kFlagSrgb)
+	{
+		return float4(LinearToSrgb(v.rgb), v.a);
+	}
+	return v;
+}
+
+float4 Reduce(float4 a, float4 b, float4 c, float4 d)
+{
+	const float4 avg = (a + b + c + d) * 0.25;
+	if (uFlags & kFlagNormal)
+	{
+		return float4(NormalizeOrFlat(avg.xyz), avg.w);
+	}
+	return avg;
+}
+
+// Only the pass source and the mip 6 hand-off are ever read.
+float4 LoadLevel(uint level, uint2 p, uint slice)
+{
+	const uint3 c = uint3(min(p, LevelSize(level) - 1u), slice);
+	return Decode((level == 0u) ? gMip0[c] : gMip6[c]);
+}
+
+void StoreLevel(uint level, uint2 p, uint slice, float4 v)
+{
+	if (level > uMipCount || any(p >= LevelSize(level)))
+	{
+		return;
+	}
+
+	const uint3 c = uint3(p, slice);
+	const float4 e = Encode(v);
+	switch (level)
+	{
+	case 1: gMip1[c] = e; break;
+	case 2: gMip2[c] = e; break;
+	case 3: gMip3[c] = e; break;
+	case 4: gMip4[c] = e; break;
+	case 5: gMip5[c] = e; break;
+	case 6: gMip6[c] = e; break;
+	case 7: gMip7[c] = e; break;
+	case 8: gMip8[c] = e; break;
+	case 9: gMip9[c] = e; break;
+	case 10: gMip10[c] = e; break;
+	case 11: gMip11[c] = e; break;
+	default: gMip12[c] = e; break;
+	}
+}
+
+// Reduces the 64x64 tile `tile` of `baseLevel` into levels baseLevel + 1..6. Every thread of the
+// group must call it (barriers); `active` = 0 only keeps them company without touching memory.
+void DownsampleTile(uint baseLevel, uint2 tile, uint slice, uint threadIndex, bool active)
+{
+	const uint2 t = uint2(threadIndex % 16u, threadIndex / 16u);
+	const uint2 baseSize = LevelSize(baseLevel);
+	const uint2 size1 = LevelSize(baseLevel + 1u);
+
+	float4 m1[2][2];
+	[unroll]
+	for (uint j = 0; j < 2u; ++j)
+	{
+		[unroll]
+		for (uint i = 0; i < 2u; ++i)
+		{
+			const uint2 p1 = tile * 32u + t * 2u + uint2(i, j);
+			m1[j][i] = 0;
+			if (active)
+			{
+				const uint2 s = p1 * 2u;
+				const uint2 hi = (s + 1u < baseSize) ? uint2(1u, 1u) : uint2(0u, 0u);
+				m1[j][i] = Reduce(
+					LoadLevel(baseLevel, s, slice),
+					LoadLevel(baseLevel, s + uint2(hi.x, 0u), slice),
+					LoadLevel(baseLevel, s + uint2(0u, hi.y), slice),
+					LoadLevel(baseLevel, s + hi, slice));
+				StoreLevel(baseLevel + 1u, p1, slice, m1[j][i]);
+			}
+		}
+	}
+
+	// Second level from the thread's own 2x2, with the same edge clamp.
+	const uint2 p2 = tile * 16u + t;
+	const uint2 hi2 = (p2 * 2u + 1u < size1) ? uint2(1u, 1u) : uint2(0u, 0u);
+	const float4 b = hi2.x ? m1[0][1] : m1[0][0];
+	const float4 c = hi2.y ? m1[1][0] : m1[0][0];
+	const float4 d = hi2.y ? (hi2.x ? m1[1][1] : m1[1][0]) : b;
+	const float4 m2 = Reduce(m1[0][0], b, c, d);
+	if (active)
+	{
+		StoreLevel(baseLevel + 2u, p2, slice, m2);
+	}
+	gTile[t.y][t.x] = m2;
+	GroupMemoryBarrierWithGroupSync();
+
+	// 16x16 -> 8x8 -> 4x4 -> 2x2 -> 1x1 in groupshared memory: read, sync, then overwrite.
+	[unroll]
+	for (uint step = 1u; step <= 4u; ++step)
+	{
+		const uint level = baseLevel + 2u + step;
+		const uint side = 16u >> step;
+		const bool inTile = all(t < side);
+		const uint2 p = tile * side + t;
+
+		float4 v = 0;
+		if (inTile)
+		{
+			const uint2 hi = (p * 2u + 1u < LevelSize(level - 1u)) ? uint2(1u, 1u) : uint2(0u, 0u);
+			const uint2 s = t * 2u;
+			v = Reduce(
+				gTile[s.y][s.x],
+				gTile[s.y][s.x + hi.x],
+				gTile[s.y + hi.y][s.x],
+				gTile[s.y + hi.y][s.x + hi.x]);
+		}
+		GroupMemoryBarrierWithGroupSync();
+
+		if (inTile)
+		{
+			gTile[t.y][t.x] = v;
+			if (active)
+			{
+				StoreLevel(level, p, slice, v);
+			}
+		}
+		GroupMemoryBarrierWithGroupSync();
+	}
+}
+
+[numthreads(256, 1, 1)]
+void CS_GenerateMips(uint3 groupId : SV_GroupID, uint threadIndex : SV_GroupIndex)
+{
+	const uint slice = groupId.z;
+	DownsampleTile(0u, groupId.xy, slice, threadIndex, true);
+
+	if (uMipCount <= 6u)
+	{
+		return;
+	}
+
+	// Thread 0 wrote this group's mip 6 texel; publish it before counting the group as done.
+	if (threadIndex == 0u)
+	{
+		DeviceMemoryBarrier();
+		uint previous = 0u;
+		InterlockedAdd(gCounters[slice], 1u, previous);
+		gIsLastGroup = (previous == uGroupCount - 1u) ? 1u : 0u;
+	}
+	GroupMemoryBarrierWithGroupSync();
+
+	const bool last = gIsLastGroup != 0u;
+	if (last && threadIndex == 0u)
+	{
+		gCounters[slice] = 0u;
+	}
+	DownsampleTile(6u, uint2(0u, 0u), slice, threadIndex, last);
+}
@@ -1,3 +1,5 @@
+#include "VertexCompact_dx12.hlsli"
+
 SamplerState gLinear : register(s0);
 SamplerComparisonState gShadowCmp : register(s1);
 SamplerState gPointClamp : register(s2);
@@ -19,11 +21,14 @@ struct GPULight
 };
 StructuredBuffer<GPULight> gLights : register(t2);
 
-// Spot shadow maps (depth) - NO ARRAYS (root sig uses 1-descriptor tables per tN)
-Texture2D<float> gSpotShadow0 : register(t3);
-Texture2D<float> gSpotShadow1 : register(t4);
-Texture2D<float> gSpotShadow2 : register(t5);
-Texture2D<float> gSpotShadow3 : register(t6);
+// Clustered light lists (t20), rebuilt on the CPU for the main camera every frame (LightClusterBuilder):
+//   [0..15] header: grid xyz, global count, tiles per pixel xy, depth slice scale/bias,
+//           camera pos + global list offset, camera forward + enabled flag
+//   [16..]  per-cluster (offset, count), then the light indices they point at
+StructuredBuffer<uint> gLightClusters : register(t20);
+
+// Spot shadow atlas (depth): every spot shadow is a tile of it (ShadowDataSB::spotAtlasRect)
+Texture2D<float> gSpotShadowAtlas : register(t3);
 
 // Point distance cubemaps (normalized distance)
 Texture2DArray<float> gPointShadow0 : register(t7);
@@ -45,8 +50,9 @@ struct ShadowDataSB
     // x=invAtlasW, y=invAtlasH, z=invTileRes, w=cascadeCount
 	float4 dirInfo;
 
-	float4 spotVPRows[16]; // 4 matrices * 4 rows (row-major rows)
-	float4 spotInfo[4]; // { lightIndexBits, 0, extraBiasTexels, 0 }
+	float4 spotVPRows[32]; // 8 matrices * 4 rows (row-major rows)
+	float4 spotInfo[8]; // { lightIndexBits, 0, extraBiasTexels, 0 }
+	float4 spotAtlasRect[8]; // { u0, v0, tileSize / atlasSize, 1 / tileSize }
 
 	float4 pointPosRange[4]; // { pos.xyz, range }
 	float4 pointInfo[4]; // { lightIndexBits, 0, extraBiasTexels, 0 }
@@ -144,7 +150,7 @@ static const uint FLAG_ENV_FORCE_MIP0 = 1u << 9;
 #define CORE_OUTLINE 0
 #endif
 
-static const uint kMaxSpotShadows = 4;
+static const uint kMaxSpotShadows = 8;
 static const uint kMaxPointShadows = 4;
 
 // Light types (must match rendern::LightType in C++)
@@ -356,10 +362,51 @@ int FindPointShadowSlot(uint lightIndex, uint pointShadowCount)
 	return -1;
 }
 
+struct LightClusterRange
+{
+	uint globalBegin;
+	uint globalCount;
+	uint clusterBegin;
+	uint clusterCount;
+};
+
+// False when the pass is not clustered (other camera): the caller loops every light instead.
+bool GetLightClusterRange(float2 pixelPos, float3 worldPos, out LightClusterRange range)
+{
+	range = (LightClusterRange) 0;
+	if (gLightClusters[15] == 0u)
+		return false;
+
+	const uint3 grid = uint3(gLightClusters[0], gLightClusters[1], gLightClusters[2]);
+	const float3 camPos = float3(asfloat(gLightClusters[8]), asfloat(gLightClusters[9]), asfloat(gLightClusters[10]));
+	const float3 camFwd = float3(asfloat(gLightClusters[12]), asfloat(gLightClusters[13]), asfloat(gLightClusters[14]));
+	const float viewZ = max(dot(worldPos - camPos, camFwd), 1e-4f);
+	const float slice = log(viewZ) * asfloat(gLightClusters[6]) + asfloat(gLightClusters[7]);
+
+	const uint x = min((uint) (pixelPos.x * asfloat(gLightClusters[4])), grid.x - 1u);
+	const uint y = min((uint) (pixelPos.y * asfloat(gLightClusters[5])), grid.y - 1u);
+	const uint z = (uint) clamp(slice, 0.0f, (float) (grid.z - 1u));
+	const uint cluster = (z * grid.y + y) * grid.x + x;
+
+	range.globalBegin = gLightClusters[11];
+	range.globalCount = gLightClusters[3];
+	range.clusterBegin = gLightClusters[16u + cluster * 2u];
+	range.clusterCount = gLightClusters[17u + cluster * 2u];
+	return true;
+}
+
+// k-th light of the range: the global (directional) lights first, then the cluster's own.
+uint LightClusterLight(LightClusterRange range, uint k)
+{
+	return (k < range.globalCount)
+		? gLightClusters[range.globalBegin + k]
+		: gLightClusters[range.clusterBegin + (k - range.globalCount)];
+}
+
 // Vertex IO
 struct VSIn
 {
-	float3 pos : POSITION;
+	float4 pos : POSITION;
 	float3 nrm : NORMAL;
 	float2 uv : TEXCOORD0;
 	float4 tangent : TANGENT;
@@ -385,7 +432,7 @@ struct VSOut
 #endif
 };
 
-// Shadow sampling (generic 2D depth compare, used by spots and legacy dir)
+// Shadow sampling (generic 2D depth compare, used by the legacy dir path)
 float Shadow2D(Texture2D<float> shadowMap, float4 shadowClip, float biasTexels)
 {
 	float3 p = shadowClip.xyz / max(shadowClip.w, 1e-6f);
@@ -584,9 +631,52 @@ float DirShadowFactor(float3 worldPos, float NdotL,
 	return s;
 }
 
+// ---------------- Spot shadow atlas ----------------
+// Every spot shadow is a square tile of one atlas: spotAtlasRect[slot] = { u0, v0, tileSize / atlasSize, 1 / tileSize }.
+// Tile-clamped 3x3 PCF as in ShadowAtlasCSM, so taps never read a neighbouring light's tile.
+float ShadowAtlasSpot(float4 clip, float4 rect, float biasTexels)
+{
+	float3 p = clip.xyz / max(clip.w, 1e-6f);
+	if (p.z < 0.0f || p.z > 1.0f)
+		return 1.0f;
+
+	// NDC -> tile-local UV (flip Y); outside the light frustum => fully lit.
+	float2 uvLocal = float2(p.x, -p.y) * 0.5f + 0.5f;
+	if (uvLocal.x < 0.0f || uvLocal.x > 1.0f || uvLocal.y < 0.0f || uvLocal.y > 1.0f)
+		return 1.0f;
+
+	// Bias in tile texels, so a smaller tile gets a proportionally larger depth bias.
+	const float z = p.z - biasTexels * rect.w;
+
+	const float2 uvMin = rect.xy;
+	const float2 uvMax = rect.xy + rect.zz;
+	const float2 uv = uvMin + uvLocal * rect.z;
+
+	// One tile texel in atlas UV, and a guard band against taps outside the tile.
+	const float2 stepUV = (rect.z * rect.w).xx;
+	const float2 uvMinP = uvMin + stepUV * 1.5f;
+	const float2 uvMaxP = uvMax - stepUV * 1.5f;
+
+	float s = 0.0f;
+	[unroll]
+	for (int y = -1; y <= 1; ++y)
+	{
+		[unroll]
+		for (int x = -1; x <= 1; ++x)
+		{
+			const float2 uvTap = uv + stepUV * float2((float) x, (float) y);
+			const float inside = step(uvMinP.x, uvTap.x) * step(uvTap.x, uvMaxP.x) * step(uvMinP.y, uvTap.y) * step(uvTap.y, uvMaxP.y);
+			const float sample = gSpotShadowAtlas.SampleCmpLevelZero(gShadowCmp, uvTap, z);
+			s += lerp(1.0f, sample, inside);
+		}
+	}
+
+	return s / 9.0f;
+}
+
 float SpotShadowFactor(uint slot, ShadowDataSB sd, float3 worldPos, float biasTexels)
 {
-	if (slot >= 4)
+	if (slot >= kMaxSpotShadows)
 		return 1.0f;
 
 	float4 r0 = sd.spotVPRows[slot * 4 + 0];
@@ -597,13 +687,7 @@ float SpotShadowFactor(uint slot, ShadowDataSB sd, float3 worldPos, float biasTe
 
 	float4 clip = mul(float4(worldPos, 1.0f), VP);
 
-	if (slot == 0)
-		return Shadow2D(gSpotShadow0, clip, biasTexels);
-	if (slot == 1)
-		return Shadow2D(gSpotShadow1, clip, biasTexels);
-	if (slot == 2)
-		return Shadow2D(gSpotShadow2, clip, biasTexels);
-	return Shadow2D(gSpotShadow3, clip, biasTexels);
+	return ShadowAtlasSpot(clip, sd.spotAtlasRect[slot], biasTexels);
 }
 
 // ---------------- Point shadow sampling without TextureCube face selection ----------------
@@ -862,7 +946,7 @@ float ShadowPoint_SimpleSeam(Texture2DArray<float> distArr,
 // NOTE: slopeScaleTexels is currently ignored here; kept for ABI stability with C++.
 float SpotShadowFactor(uint slot, float3 worldPos, float NdotL, float materialBiasTexels, float baseBiasTexels, float slopeScaleTexels)
 {
-	if (slot >= 4)
+	if (slot >= kMaxSpotShadows)
 		return 1.0f;
 	ShadowDataSB sd = gShadowData[0];
 	const float extraBiasTexels = sd.spotInfo[slot].z;
@@ -906,13 +990,14 @@ VSOut VSMain(VSIn IN)
     float4x4 model = MakeMatRows(IN.i0, IN.i1, IN.i2, IN.i3);
     float3x3 model3x3 = (float3x3) model;
 
-    float4 world = mul(float4(IN.pos, 1.0f), model);
+    float4 world = mul(float4(IN.pos.xyz, 1.0f), model);
 
     float3x3 normalMatrix = InverseTranspose3x3(model3x3);
-    float3 nrmW = normalize(mul(IN.nrm, normalMatrix));
-    float3 tangentW = normalize(mul(IN.tangent.xyz, model3x3));
+    const float4 tangent = DecodeVertexTangent(IN.pos, IN.tangent);
+    float3 nrmW = normalize(mul(DecodeVertexNormal(IN.pos, IN.nrm), normalMatrix));
+    float3 tangentW = normalize(mul(tangent.xyz, model3x3));
     tangentW = normalize(tangentW - nrmW * dot(nrmW, tangentW));
-    float3 bitangentW = normalize(cross(nrmW, tangentW)) * IN.tangent.w;
+    float3 bitangentW = normalize(cross(nrmW, tangentW)) * tangent.w;
 	
 	OUT.worldPos = world.xyz;
 	OUT.nrmW = nrmW;
@@ -1000,8 +1085,8 @@ float3 ComputeReflectionDir(float3 V, float3 N)
 #endif
 }
 
-// Pixel Shader
-float4 PSMain(VSOut IN) : SV_Target0
+// Lit surface color with straight alpha (the body of PSMain).
+float4 ShadePixel(VSOut IN)
 {
 	#if defined(CORE_HIGHLIGHT) && CORE_HIGHLIGHT
 		// Unlit overlay: color comes from uBaseColor (set by C++).
@@ -1089,9 +1174,14 @@ float4 PSMain(VSOut IN) : SV_Target0
 	const int spotShadowCount = (int) uCounts.y;
 	const int pointShadowCount = (int) uCounts.z;
 
+	LightClusterRange clusterRange;
+	const bool clustered = GetLightClusterRange(IN.posH.xy, IN.worldPos, clusterRange);
+	const int loopCount = clustered ? (int) (clusterRange.globalCount + clusterRange.clusterCount) : lightCount;
+
     [loop]
-	for (int i = 0; i < lightCount; ++i)
+	for (int k = 0; k < loopCount; ++k)
 	{
+		const int i = clustered ? (int) LightClusterLight(clusterRange, (uint) k) : k;
 		const GPULight Ld = gLights[i];
 		const int type = (int) Ld.p0.w;
 
@@ -1288,3 +1378,38 @@ float4 PSMain(VSOut IN) : SV_Target0
 	const float3 color = ambient + Lo + emissive;
 	return float4(color, saturate(alphaOut));
 }
+
+// Pixel Shader
+#if defined(CORE_WEIGHTED_OIT) && CORE_WEIGHTED_OIT
+// Weighted blended OIT (McGuire & Bavoil 2013): premultiplied color times a depth weight into the
+// accumulation target, alpha into the coverage target (BlendMode::WeightedOit). Nearer and more opaque
+// surfaces get larger weights; WeightedOitComposite_dx12.hlsl divides the weights back out.
+struct OitOut
+{
+	float4 accum : SV_Target0;
+	float coverage : SV_Target1;
+};
+
+float OitWeight(float depth, float alpha)
+{
+	const float d = 1.0f - depth;
+	return alpha * clamp(3e3f * d * d * d, 1e-2f, 3e3f);
+}
+
+OitOut PSMain(VSOut IN)
+{
+	const float4 color = ShadePixel(IN);
+	const float alpha = saturate(color.a);
+	const float w = OitWeight(IN.posH.z, alpha);
+
+	OitOut o;
+	o.accum = float4(color.rgb * alpha, alpha) * w;
+	o.coverage = alpha;
+	return o;
+}
+#else
+float4 PSMain(VSOut IN) : SV_Target0
+{
+	return ShadePixel(IN);
+}
+#endif
@@ -0,0 +1,133 @@
+// GPU culling of the main opaque instances (compute), one thread per instance.
+// Frustum test of the world bounding sphere, then (with a depth prepass) a HiZ occlusion test of
+// the sphere's screen rectangle. Survivors are appended to their batch's range of gCulled; the
+// batch's DrawIndexedIndirect instanceCount is the append counter.
+
+cbuffer GpuCullCB : register(b0)
+{
+	float4x4 uViewProj;
+	float4 uPlanes[6];    // (n.xyz, d), inside if dot(n, p) + d >= 0
+	uint4 uCounts;        // x = instanceCount, y = occlusion on/off, z = HiZ level count, w = main instance base
+	float4 uDepthSize;    // width, height, 1/width, 1/height
+	uint4 uHiZLevels[14]; // offset, width, height, 0
+};
+
+struct InstanceData
+{
+	float4 i0;
+	float4 i1;
+	float4 i2;
+	float4 i3;
+};
+
+struct CullBatch
+{
+	float4 sphere; // mesh local center xyz, radius
+	uint outputOffset;
+	uint instanceCount;
+	uint pad0;
+	uint pad1;
+};
+
+StructuredBuffer<float> gHiZ : register(t0);
+StructuredBuffer<InstanceData> gInstances : register(t1);
+StructuredBuffer<CullBatch> gBatches : register(t2);
+StructuredBuffer<uint> gInstanceBatch : register(t3);
+
+RWStructuredBuffer<InstanceData> gCulled : register(u0);
+RWByteAddressBuffer gArgs : register(u1); // DrawIndexedIndirectArgs per batch
+
+static const uint kArgsStrideBytes = 20;
+static const uint kArgsInstanceCountOffset = 4;
+
+float LoadHiZ(uint4 level, uint2 t)
+{
+	return gHiZ[level.x + t.y * level.y + t.x];
+}
+
+bool IsOccluded(float3 center, float radius)
+{
+	float2 uvMin = 1.0f;
+	float2 uvMax = 0.0f;
+	float nearestZ = 1.0f;
+
+	[unroll]
+	for (uint i = 0; i < 8; ++i)
+	{
+		const float3 corner = center + radius * float3(
+			(i & 1) ? 1.0f : -1.0f,
+			(i & 2) ? 1.0f : -1.0f,
+			(i & 4) ? 1.0f : -1.0f);
+		const float4 clip = mul(float4(corner, 1.0f), uViewProj);
+		if (clip.w <= 1e-4f)
+		{
+			// Crosses the near plane: no reliable rectangle, keep it.
+			return false;
+		}
+
+		const float3 ndc = clip.xyz / clip.w;
+		const float2 uv = float2(ndc.x * 0.5f + 0.5f, 0.5f - ndc.y * 0.5f);
+		uvMin = min(uvMin, uv);
+		uvMax = max(uvMax, uv);
+		nearestZ = min(nearestZ, ndc.z);
+	}
+
+	const float2 pxMin = saturate(uvMin) * uDepthSize.xy;
+	const float2 pxMax = saturate(uvMax) * uDepthSize.xy;
+
+	// HiZ level L texels cover 2^(L+1) depth pixels: pick the level where the rectangle spans
+	// at most 2x2 texels, then take the farthest depth of those four.
+	const float sizePx = max(max(pxMax.x - pxMin.x, pxMax.y - pxMin.y), 1.0f);
+	const uint levelIndex = min((uint)max(ceil(log2(sizePx)) - 1.0f, 0.0f), uCounts.z - 1);
+	const uint4 level = uHiZLevels[levelIndex];
+	const float texelPx = exp2((float)(levelIndex + 1));
+
+	const uint2 t0 = min((uint2)floor(pxMin / texelPx), level.yz - 1);
+	const uint2 t1 = min((uint2)floor(pxMax / texelPx), level.yz - 1);
+	const float farthest = max(
+		max(LoadHiZ(level, t0), LoadHiZ(level, uint2(t1.x, t0.y))),
+		max(LoadHiZ(level, uint2(t0.x, t1.y)), LoadHiZ(level, t1)));
+
+	return nearestZ > farthest;
+}
+
+[numthreads(64, 1, 1)]
+void CS_GpuCull(uint3 id : SV_DispatchThreadID)
+{
+	const uint instanceIndex = id.x;
+	if (instanceIndex >= uCounts.x)
+	{
+		return;
+	}
+
+	const uint batchIndex = gInstanceBatch[instanceIndex];
+	const CullBatch batch = gBatches[batchIndex];
+	const InstanceData inst = gInstances[uCounts.w + instanceIndex];
+
+	// Matches rendern::IsVisibleSphere: no bounds means always visible.
+	if (batch.sphere.w > 0.0f)
+	{
+		const float4x4 model = float4x4(inst.i0, inst.i1, inst.i2, inst.i3);
+		const float3 center = mul(float4(batch.sphere.xyz, 1.0f), model).xyz;
+		const float maxScale = max(length(inst.i0.xyz), max(length(inst.i1.xyz), length(inst.i2.xyz)));
+		const float radius = batch.sphere.w * maxScale;
+
+		[unroll]
+		for (uint p = 0; p < 6; ++p)
+		{
+			if (dot(uPlanes[p].xyz, center) + uPlanes[p].w < -radius)
+			{
+				return;
+			}
+		}
+
+		if (uCounts.y != 0 && IsOccluded(center, radius))
+		{
+			return;
+		}
+	}
+
+	uint slot;
+	gArgs.InterlockedAdd(batchIndex * kArgsStrideBytes + kArgsInstanceCountOffset, 1, slot);
+	gCulled[batch.outputOffset + slot] = inst;
+}
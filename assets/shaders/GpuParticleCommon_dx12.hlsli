@@ -0,0 +1,62 @@
+#ifndef CORE_GPU_PARTICLE_COMMON_DX12_HLSLI
+#define CORE_GPU_PARTICLE_COMMON_DX12_HLSLI
+
+// Shared layout of the GPU particle pool (matches GpuParticleData in CommonDX12Structs).
+// A slot is live while meta.w != 0; color and size are interpolated from the age at use.
+struct GpuParticle
+{
+	float4 positionAge;      // xyz = world position, w = age (seconds)
+	float4 velocityLifetime; // xyz = velocity, w = lifetime (<= 0: never expires)
+	float4 colorBegin;
+	float4 colorEnd;
+	float4 sizeRotation;     // x = sizeBegin, y = sizeEnd, z = rotation (radians)
+	uint4 meta;              // x = emitter index, y = emitter generation, z = texture desc index (0 = procedural), w = live
+};
+
+// Per-emitter spawn and appearance parameters (matches GpuParticleEmitterData in CommonDX12Structs).
+struct GpuParticleEmitter
+{
+	float4 positionLifetimeMin;  // xyz = position, w = lifetimeMin
+	float4 jitterLifetimeMax;    // xyz = position jitter, w = lifetimeMax
+	float4 velocityMinSizeMin;   // xyz = velocityMin, w = sizeMin
+	float4 velocityMaxSizeMax;   // xyz = velocityMax, w = sizeMax
+	float4 colorBegin;
+	float4 colorEnd;
+	float4 sizeBeginEnd;         // x = sizeBegin, y = sizeEnd (<= 0: randomised / same as begin)
+	uint4 params;                // x = texture desc index, y = maxParticles (0 = no limit), z = generation
+	float4 uvRect;               // atlas region: u0, v0, width, height
+	float4 flipbook;             // x = columns, y = rows, z = frames per second (0: spread over the lifetime)
+};
+
+float GpuParticleLifeT(GpuParticle p)
+{
+	return (p.velocityLifetime.w > 0.0f) ? saturate(p.positionAge.w / p.velocityLifetime.w) : 1.0f;
+}
+
+// UV sub-rectangle (u0, v0, width, height) of the flipbook frame shown at `age`; the same computation as
+// ParticleFrameUvRect in Scene. A lifetime <= 0 (never expires) without fps stays on the first frame.
+float4 GpuParticleFrameUvRect(float4 uvRect, float4 flipbook, float age, float lifetime)
+{
+	const uint columns = max((uint)flipbook.x, 1u);
+	const uint rows = max((uint)flipbook.y, 1u);
+	const uint frameCount = columns * rows;
+
+	uint frame = 0u;
+	if (frameCount > 1u)
+	{
+		if (flipbook.z > 0.0f)
+		{
+			frame = (uint)fmod(max(age, 0.0f) * flipbook.z, (float)frameCount);
+		}
+		else if (lifetime > 0.0f)
+		{
+			frame = (uint)(saturate(age / lifetime) * (float)frameCount);
+		}
+		frame = min(frame, frameCount - 1u);
+	}
+
+	const float2 frameSize = uvRect.zw / float2(columns, rows);
+	return float4(uvRect.xy + float2(frame % columns, frame / columns) * frameSize, frameSize);
+}
+
+#endif
@@ -0,0 +1,290 @@
+// GPU particle pool (compute).
+// Free slots live in a dead list. Emit pops one per new particle and initialises it from its emitter with
+// the same random stream as Scene::EmitParticleFromEmitter. Simulate advances every live slot, pushes
+// expired ones back onto the dead list, counts the survivors into the indirect draw args and writes a
+// (key, slot) pair for every slot: -view depth for live slots, +FLT_MAX for free ones. The bitonic sort
+// then orders the pairs ascending, so the first instanceCount entries are the live particles back to front.
+#include "GpuParticleCommon_dx12.hlsli"
+
+cbuffer GpuParticleCB : register(b0)
+{
+	float4 uCameraPosDt;   // xyz = camera position, w = simulation step (seconds)
+	float4 uCameraForward; // xyz = camera forward
+	uint4 uCounts;         // x = spawn range count, y = spawn count, z = emitter count, w = pool size
+	uint4 uParams;         // x, y = bitonic k, j; z = billboard index count (init)
+};
+
+StructuredBuffer<GpuParticleEmitter> gEmitters : register(t0);
+StructuredBuffer<uint4> gSpawnRanges : register(t1); // emitter index, first spawn sequence, count, first spawn
+
+RWStructuredBuffer<GpuParticle> gParticles : register(u0);
+RWStructuredBuffer<uint> gDeadList : register(u1);
+RWByteAddressBuffer gCounters : register(u2); // DrawIndexedIndirectArgs, dead count, live count per emitter
+RWStructuredBuffer<uint2> gSortList : register(u3);
+
+static const uint kArgsIndexCountOffset = 0;
+static const uint kArgsInstanceCountOffset = 4;
+static const uint kDeadCountOffset = 20;
+static const uint kEmitterAliveOffset = 32;
+static const uint kMaxEmitters = 1024;
+static const uint kSortBlock = 1024;
+static const float kFreeSlotKey = 3.402823466e+38f;
+
+uint NextRand(inout uint state)
+{
+	state = state * 1664525u + 1013904223u;
+	return state;
+}
+
+float RandRange(inout uint state, float lo, float hi)
+{
+	const float t = (float)(NextRand(state) & 0x00FFFFFFu) / 16777215.0f;
+	return lo + (hi - lo) * t;
+}
+
+[numthreads(64, 1, 1)]
+void CS_ParticleInit(uint3 id : SV_DispatchThreadID)
+{
+	const uint slot = id.x;
+	if (slot < kMaxEmitters)
+	{
+		gCounters.Store(kEmitterAliveOffset + slot * 4, 0u);
+	}
+	if (slot == 0)
+	{
+		gCounters.Store4(kArgsIndexCountOffset, uint4(uParams.z, 0u, 0u, 0u)); // indexCount, instanceCount, firstIndex, baseVertex
+		gCounters.Store2(16, uint2(0u, uCounts.w));                             // firstInstance, dead count
+	}
+	if (slot >= uCounts.w)
+	{
+		return;
+	}
+
+	gParticles[slot] = (GpuParticle)0;
+	gDeadList[slot] = slot;
+	gSortList[slot] = uint2(asuint(kFreeSlotKey), slot);
+}
+
+[numthreads(64, 1, 1)]
+void CS_ParticleEmit(uint3 id : SV_DispatchThreadID)
+{
+	const uint spawnIndex = id.x;
+	if (spawnIndex >= uCounts.y)
+	{
+		return;
+	}
+
+	// Last range starting at or before this spawn.
+	uint lo = 0;
+	uint hi = uCounts.x - 1;
+	while (lo < hi)
+	{
+		const uint mid = (lo + hi + 1) >> 1;
+		if (gSpawnRanges[mid].w <= spawnIndex)
+		{
+			lo = mid;
+		}
+		else
+		{
+			hi = mid - 1;
+		}
+	}
+	const uint4 range = gSpawnRanges[lo];
+	const uint emitterIndex = range.x;
+	const GpuParticleEmitter emitter = gEmitters[emitterIndex];
+
+	uint prev;
+	if (emitter.params.y != 0)
+	{
+		gCounters.InterlockedAdd(kEmitterAliveOffset + emitterIndex * 4, 1u, prev);
+		if (prev >= emitter.params.y)
+		{
+			return;
+		}
+	}
+
+	// Pop a free slot; on an empty list undo the pop (the count never rises above the real size).
+	gCounters.InterlockedAdd(kDeadCountOffset, 0xFFFFFFFFu, prev);
+	if ((int)prev <= 0)
+	{
+		gCounters.InterlockedAdd(kDeadCountOffset, 1u, prev);
+		return;
+	}
+	const uint slot = gDeadList[prev - 1];
+
+	const uint sequence = range.y + (spawnIndex - range.w);
+	uint rng = (sequence + 1u) * 747796405u + 2891336453u;
+
+	const float3 jitter = emitter.jitterLifetimeMax.xyz;
+	GpuParticle p;
+	p.positionAge.xyz = emitter.positionLifetimeMin.xyz;
+	p.positionAge.x += RandRange(rng, -jitter.x, jitter.x);
+	p.positionAge.y += RandRange(rng, -jitter.y, jitter.y);
+	p.positionAge.z += RandRange(rng, -jitter.z, jitter.z);
+	p.positionAge.w = 0.0f;
+
+	const float3 vMin = emitter.velocityMinSizeMin.xyz;
+	const float3 vMax = emitter.velocityMaxSizeMax.xyz;
+	p.velocityLifetime.x = RandRange(rng, vMin.x, vMax.x);
+	p.velocityLifetime.y = RandRange(rng, vMin.y, vMax.y);
+	p.velocityLifetime.z = RandRange(rng, vMin.z, vMax.z);
+
+	p.colorBegin = emitter.colorBegin;
+	p.colorEnd = emitter.colorEnd;
+
+	const float randomizedSizeBegin = RandRange(rng, emitter.velocityMinSizeMin.w, emitter.velocityMaxSizeMax.w);
+	p.sizeRotation.x = (emitter.sizeBeginEnd.x > 0.0f) ? emitter.sizeBeginEnd.x : randomizedSizeBegin;
+	p.sizeRotation.y = (emitter.sizeBeginEnd.y > 0.0f) ? emitter.sizeBeginEnd.y : p.sizeRotation.x;
+	p.velocityLifetime.w = RandRange(rng, emitter.positionLifetimeMin.w, emitter.jitterLifetimeMax.w);
+	p.sizeRotation.z = RandRange(rng, 0.0f, 6.28318530718f);
+	p.sizeRotation.w = 0.0f;
+
+	p.meta = uint4(emitterIndex, emitter.params.z, emitter.params.x, 1u);
+	gParticles[slot] = p;
+}
+
+// Runs between Emit and Simulate: the live counts are rebuilt by Simulate.
+[numthreads(64, 1, 1)]
+void CS_ParticleBeginSimulate(uint3 id : SV_DispatchThreadID)
+{
+	if (id.x < kMaxEmitters)
+	{
+		gCounters.Store(kEmitterAliveOffset + id.x * 4, 0u);
+	}
+	if (id.x == 0)
+	{
+		gCounters.Store(kArgsInstanceCountOffset, 0u);
+	}
+}
+
+[numthreads(64, 1, 1)]
+void CS_ParticleSimulate(uint3 id : SV_DispatchThreadID)
+{
+	const uint slot = id.x;
+	if (slot >= uCounts.w)
+	{
+		return;
+	}
+
+	float key = kFreeSlotKey;
+	GpuParticle p = gParticles[slot];
+	if (p.meta.w != 0)
+	{
+		const float dt = uCameraPosDt.w;
+		p.positionAge.w += dt;
+		p.positionAge.xyz += p.velocityLifetime.xyz * dt;
+
+		const float lifeT = GpuParticleLifeT(p);
+		const float size = lerp(p.sizeRotation.x, p.sizeRotation.y, lifeT);
+		const float alpha = lerp(p.colorBegin.a, p.colorEnd.a, lifeT);
+		const uint emitterIndex = p.meta.x;
+		const bool expired =
+			(p.velocityLifetime.w > 0.0f && p.positionAge.w >= p.velocityLifetime.w) ||
+			size <= 0.0f || alpha <= 0.0f ||
+			emitterIndex >= uCounts.z || gEmitters[emitterIndex].params.z != p.meta.y; // removed or restarted emitter
+
+		uint prev;
+		if (expired)
+		{
+			p.meta.w = 0;
+			gCounters.InterlockedAdd(kDeadCountOffset, 1u, prev);
+			gDeadList[prev] = slot;
+		}
+		else
+		{
+			gCounters.InterlockedAdd(kArgsInstanceCountOffset, 1u, prev);
+			gCounters.InterlockedAdd(kEmitterAliveOffset + emitterIndex * 4, 1u, prev);
+			key = -dot(p.positionAge.xyz - uCameraPosDt.xyz, uCameraForward.xyz);
+		}
+		gParticles[slot] = p;
+	}
+
+	gSortList[slot] = uint2(asuint(key), slot);
+}
+
+// ---------------- Bitonic sort of gSortList (ascending key) ----------------
+// Stages with j >= kSortBlock run one dispatch each (CS_ParticleSortStep); the rest of every stage runs
+// in groupshared memory, one group per kSortBlock elements.
+
+groupshared uint2 gsSort[kSortBlock];
+
+void CompareExchangeShared(uint base, uint k, uint j, uint thread)
+{
+	const uint i = 2 * j * (thread / j) + (thread % j);
+	const uint l = i + j;
+	const bool ascending = ((base + i) & k) == 0;
+	const uint2 a = gsSort[i];
+	const uint2 b = gsSort[l];
+	if ((asfloat(a.x) > asfloat(b.x)) == ascending)
+	{
+		gsSort[i] = b;
+		gsSort[l] = a;
+	}
+}
+
+// Sorts every block: stages k = 2 .. kSortBlock.
+[numthreads(kSortBlock / 2, 1, 1)]
+void CS_ParticleSortLocal(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID)
+{
+	const uint t = threadId.x;
+	const uint base = groupId.x * kSortBlock;
+	gsSort[t] = gSortList[base + t];
+	gsSort[t + kSortBlock / 2] = gSortList[base + t + kSortBlock / 2];
+	GroupMemoryBarrierWithGroupSync();
+
+	for (uint k = 2; k <= kSortBlock; k <<= 1)
+	{
+		for (uint j = k >> 1; j > 0; j >>= 1)
+		{
+			CompareExchangeShared(base, k, j, t);
+			GroupMemoryBarrierWithGroupSync();
+		}
+	}
+
+	gSortList[base + t] = gsSort[t];
+	gSortList[base + t + kSortBlock / 2] = gsSort[t + kSortBlock / 2];
+}
+
+// Finishes stage k = uParams.x: the steps j = kSortBlock / 2 .. 1.
+[numthreads(kSortBlock / 2, 1, 1)]
+void CS_ParticleSortMerge(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID)
+{
+	const uint t = threadId.x;
+	const uint base = groupId.x * kSortBlock;
+	gsSort[t] = gSortList[base + t];
+	gsSort[t + kSortBlock / 2] = gSortList[base + t + kSortBlock / 2];
+	GroupMemoryBarrierWithGroupSync();
+
+	for (uint j = kSortBlock / 2; j > 0; j >>= 1)
+	{
+		CompareExchangeShared(base, uParams.x, j, t);
+		GroupMemoryBarrierWithGroupSync();
+	}
+
+	gSortList[base + t] = gsSort[t];
+	gSortList[base + t + kSortBlock / 2] = gsSort[t + kSortBlock / 2];
+}
+
+// One step (k = uParams.x, j = uParams.y >= kSortBlock) over the whole list, one thread per pair.
+[numthreads(256, 1, 1)]
+void CS_ParticleSortStep(uint3 id : SV_DispatchThreadID)
+{
+	const uint k = uParams.x;
+	const uint j = uParams.y;
+	const uint thread = id.x;
+	if (thread >= uCounts.w / 2)
+	{
+		return;
+	}
+
+	const uint i = 2 * j * (thread / j) + (thread % j);
+	const uint l = i + j;
+	const bool ascending = (i & k) == 0;
+	const uint2 a = gSortList[i];
+	const uint2 b = gSortList[l];
+	if ((asfloat(a.x) > asfloat(b.x)) == ascending)
+	{
+		gSortList[i] = b;
+		gSortList[l] = a;
+	}
+}
@@ -0,0 +1,38 @@
+// HiZ pyramid build (compute). One dispatch per level: level 0 reads the swapchain depth (t0),
+// every other level reads the previous level out of the same buffer. Each texel keeps the
+// farthest (max) depth of its 2x2 source texels; odd edges clamp to the last row/column.
+
+cbuffer HiZBuildCB : register(b0)
+{
+	uint4 uSrc; // offset, width, height, 1 = read gDepth
+	uint4 uDst; // offset, width, height, 0
+};
+
+Texture2D<float> gDepth : register(t0);
+RWStructuredBuffer<float> gHiZ : register(u0);
+
+float LoadSource(uint2 p)
+{
+	p = min(p, uSrc.yz - 1);
+	if (uSrc.w != 0)
+	{
+		return gDepth.Load(int3(p, 0));
+	}
+	return gHiZ[uSrc.x + p.y * uSrc.y + p.x];
+}
+
+[numthreads(8, 8, 1)]
+void CS_HiZBuild(uint3 id : SV_DispatchThreadID)
+{
+	if (id.x >= uDst.y || id.y >= uDst.z)
+	{
+		return;
+	}
+
+	const uint2 s = id.xy * 2;
+	const float d = max(
+		max(LoadSource(s), LoadSource(s + uint2(1, 0))),
+		max(LoadSource(s + uint2(0, 1)), LoadSource(s + uint2(1, 1))));
+
+	gHiZ[uDst.x + id.y * uDst.y + id.x] = d;
+}
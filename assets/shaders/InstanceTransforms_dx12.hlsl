@@ -0,0 +1,69 @@
+// Persistent instance transforms.
+// gTransforms holds one InstanceData per draw item (its slot) and survives across frames.
+// CS_InstanceScatter writes the slots whose transform changed this frame; CS_InstanceGather then expands
+// the frame's instance references (slot + optional cubemap face) into the instance vertex stream.
+
+cbuffer InstanceTransformsCB : register(b0)
+{
+	uint4 uCounts; // x = update count (scatter) / instance count (gather)
+};
+
+struct InstanceData
+{
+	float4 i0;
+	float4 i1;
+	float4 i2;
+	float4 i3;
+};
+
+struct InstanceTransformUpdate
+{
+	uint4 slot; // x = slot
+	InstanceData rows;
+};
+
+static const uint kInstanceRefFaceShift = 29;
+static const uint kInstanceRefSlotMask = (1u << kInstanceRefFaceShift) - 1u;
+static const uint kNoInstanceRef = 0xFFFFFFFFu;
+
+StructuredBuffer<InstanceTransformUpdate> gUpdates : register(t0);
+RWStructuredBuffer<InstanceData> gTransformsRW : register(u0);
+
+[numthreads(64, 1, 1)]
+void CS_InstanceScatter(uint3 id : SV_DispatchThreadID)
+{
+	if (id.x >= uCounts.x)
+	{
+		return;
+	}
+
+	const InstanceTransformUpdate update = gUpdates[id.x];
+	gTransformsRW[update.slot.x] = update.rows;
+}
+
+StructuredBuffer<InstanceData> gTransforms : register(t0);
+StructuredBuffer<uint> gInstanceRefs : register(t1);
+RWStructuredBuffer<InstanceData> gInstances : register(u0);
+
+[numthreads(64, 1, 1)]
+void CS_InstanceGather(uint3 id : SV_DispatchThreadID)
+{
+	if (id.x >= uCounts.x)
+	{
+		return;
+	}
+
+	const uint ref = gInstanceRefs[id.x];
+	InstanceData inst = (InstanceData)0;
+	if (ref != kNoInstanceRef)
+	{
+		inst = gTransforms[ref & kInstanceRefSlotMask];
+		const uint facePlusOne = ref >> kInstanceRefFaceShift;
+		if (facePlusOne != 0u)
+		{
+			// Layered point shadows: the VS renders into this face and restores w = 0.
+			inst.i0.w = (float)(facePlusOne - 1u);
+		}
+	}
+	gInstances[id.x] = inst;
+}
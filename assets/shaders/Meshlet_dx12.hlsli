@@ -0,0 +1,147 @@
+#ifndef CORE_MESHLET_DX12_HLSLI
+#define CORE_MESHLET_DX12_HLSLI
+
+// Meshlet records and culling shared by the mesh-shader passes (Meshlet.cppm builds the data).
+// Bindings (DirectX12Renderer::DispatchMeshlets): t3 vertices, t4 meshlets, t5 vertex indices +
+// packed triangles, t6 instance rows. Dispatch: x = groups of kMeshletsPerGroup meshlets, y = instance.
+// Vertices are VertexDesc in the space of the mesh's vertex buffer: for VertexCompact meshes the
+// positions and bounds are quantized, and the instance rows carry the dequantization.
+
+static const uint kMeshletsPerGroup = 32;     // kMeshletsPerTaskGroup (CommonDX12Structs.cppm)
+static const uint kMeshletMaxVertices = 64;   // kMeshletMaxVertices (Meshlet.cppm)
+static const uint kMeshletMaxTriangles = 124; // kMeshletMaxTriangles (Meshlet.cppm)
+static const uint kMeshletThreads = 128;
+
+struct MeshletVertex
+{
+    float3 pos;
+    float3 nrm;
+    float2 uv;
+    float4 tangent;
+};
+
+struct Meshlet
+{
+    uint vertexOffset;
+    uint triangleOffset;
+    uint vertexCount;
+    uint triangleCount;
+    float3 center;
+    float radius;
+    float3 coneAxis;
+    float coneCutoff;
+};
+
+struct InstanceData
+{
+    float4 i0;
+    float4 i1;
+    float4 i2;
+    float4 i3;
+};
+
+StructuredBuffer<MeshletVertex> gMeshletVertices : register(t3);
+StructuredBuffer<Meshlet> gMeshlets : register(t4);
+StructuredBuffer<uint> gMeshletData : register(t5);
+StructuredBuffer<InstanceData> gMeshletInstances : register(t6);
+
+// Amplification -> mesh: the surviving meshlets of one group, all of one instance.
+struct MeshletPayload
+{
+    uint instance;
+    uint meshlets[kMeshletsPerGroup];
+};
+
+float3 MeshletTransformPoint(InstanceData inst, float3 p)
+{
+    return p.x * inst.i0.xyz + p.y * inst.i1.xyz + p.z * inst.i2.xyz + inst.i3.xyz;
+}
+
+uint3 MeshletTriangle(Meshlet m, uint triangleIndex)
+{
+    const uint packed = gMeshletData[m.triangleOffset + triangleIndex];
+    return uint3(packed & 0xFFu, (packed >> 8) & 0xFFu, (packed >> 16) & 0xFFu);
+}
+
+MeshletVertex LoadMeshletVertex(Meshlet m, uint vertexIndex)
+{
+    return gMeshletVertices[gMeshletData[m.vertexOffset + vertexIndex]];
+}
+
+// planes: (n.xyz, d), inside if dot(n, p) + d >= 0.
+bool MeshletSphereInFrustum(float4 planes[6], float3 center, float radius)
+{
+    [unroll]
+    for (uint i = 0; i < 6; ++i)
+    {
+        if (dot(planes[i].xyz, center) + planes[i].w < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// MeshletConeCulled in world space. The cone only survives a rotation + uniform scale: other
+// instances (non-uniform scale, mirrored) are never cone culled.
+bool MeshletConeCulled(Meshlet m, InstanceData inst, float3 centerW, float radiusW, float3 cameraPos)
+{
+    if (m.coneCutoff >= 1.0f)
+    {
+        return false;
+    }
+    const float s0 = dot(inst.i0.xyz, inst.i0.xyz);
+    const float s1 = dot(inst.i1.xyz, inst.i1.xyz);
+    const float s2 = dot(inst.i2.xyz, inst.i2.xyz);
+    if (min(s0, min(s1, s2)) < 0.999f * max(s0, max(s1, s2)) || dot(cross(inst.i0.xyz, inst.i1.xyz), inst.i2.xyz) <= 0.0f)
+    {
+        return false;
+    }
+    const float3 axis = normalize(m.coneAxis.x * inst.i0.xyz + m.coneAxis.y * inst.i1.xyz + m.coneAxis.z * inst.i2.xyz);
+    const float3 toCenter = centerW - cameraPos;
+    return dot(toCenter, axis) >= m.coneCutoff * length(toCenter) + radiusW;
+}
+
+groupshared MeshletPayload sMeshletPayload;
+groupshared uint sMeshletCount;
+
+// Amplification body: each thread tests one meshlet of instance meshletParams.z + groupId.y and
+// the survivors go to the mesh shader. meshletParams = firstMeshlet, meshletCount, first instance, instanceCount.
+void AmplifyMeshlets(uint threadId, uint2 groupId, uint4 meshletParams, float4 planes[6], float3 cameraPos, bool coneCull)
+{
+    if (threadId == 0)
+    {
+        sMeshletCount = 0;
+        sMeshletPayload.instance = meshletParams.z + groupId.y;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    const uint local = groupId.x * kMeshletsPerGroup + threadId;
+    if (local < meshletParams.y)
+    {
+        const uint meshletIndex = meshletParams.x + local;
+        const Meshlet m = gMeshlets[meshletIndex];
+        const InstanceData inst = gMeshletInstances[meshletParams.z + groupId.y];
+
+        const float3 centerW = MeshletTransformPoint(inst, m.center);
+        const float maxScale = sqrt(max(dot(inst.i0.xyz, inst.i0.xyz), max(dot(inst.i1.xyz, inst.i1.xyz), dot(inst.i2.xyz, inst.i2.xyz))));
+        const float radiusW = m.radius * maxScale;
+
+        bool visible = MeshletSphereInFrustum(planes, centerW, radiusW);
+        if (visible && coneCull)
+        {
+            visible = !MeshletConeCulled(m, inst, centerW, radiusW, cameraPos);
+        }
+        if (visible)
+        {
+            uint slot;
+            InterlockedAdd(sMeshletCount, 1u, slot);
+            sMeshletPayload.meshlets[slot] = meshletIndex;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    DispatchMesh(sMeshletCount, 1, 1, sMeshletPayload);
+}
+
+#endif
@@ -0,0 +1,45 @@
+// Editor object-ID buffer (R32_UINT): every instance writes its entry of the per-instance ID list.
+cbuffer ObjectIdCB : register(b0)
+{
+    float4x4 uViewProj;
+    uint4    uObject; // x = first instance of the batch in gObjectIds
+};
+
+StructuredBuffer<uint> gObjectIds : register(t0);
+
+struct VSIn
+{
+    float3 pos : POSITION;
+    float3 nrm : NORMAL;
+    float2 uv  : TEXCOORD0;
+
+    // Instance matrix rows in TEXCOORD1..4
+    float4 i0  : TEXCOORD1;
+    float4 i1  : TEXCOORD2;
+    float4 i2  : TEXCOORD3;
+    float4 i3  : TEXCOORD4;
+};
+
+struct VSOut
+{
+    float4 posH : SV_Position;
+    nointerpolation uint objectId : OBJECTID;
+};
+
+VSOut VS_ObjectId(VSIn IN, uint instanceId : SV_InstanceID)
+{
+    VSOut OUT;
+
+    // Rows provided by CPU, use row-vector mul().
+    float4x4 model = float4x4(IN.i0, IN.i1, IN.i2, IN.i3);
+    float4 world = mul(float4(IN.pos, 1.0f), model);
+
+    OUT.posH = mul(world, uViewProj);
+    OUT.objectId = gObjectIds[uObject.x + instanceId];
+    return OUT;
+}
+
+uint PS_ObjectId(VSOut IN) : SV_Target0
+{
+    return IN.objectId;
+}
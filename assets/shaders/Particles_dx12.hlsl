@@ -1,10 +1,18 @@
-#ifndef PARTICLE_TEXTURED
-#define PARTICLE_TEXTURED 0
+// VSMain/PSMain draw the CPU particle instances in one draw: each instance carries its bindless texture
+// index (0 = procedural falloff only) and the UV rect of its atlas region / flipbook frame.
+// PARTICLE_GPU: VSMainGpu/PSMainGpu draw the sorted GPU particle pool (GpuParticles_dx12.hlsl) with one
+// indirect draw; instance i is the i-th entry of the sorted list, textures come from the bindless heap.
+#ifndef PARTICLE_GPU
+#define PARTICLE_GPU 0
 #endif
 
 SamplerState gLinear : register(s0);
-#if PARTICLE_TEXTURED
-Texture2D gParticleTex : register(t0);
+Texture2D gBindlessTex[] : register(t0, space1);
+#if PARTICLE_GPU
+#include "GpuParticleCommon_dx12.hlsli"
+StructuredBuffer<GpuParticle> gParticles : register(t1);
+StructuredBuffer<uint2> gSortedParticles : register(t2); // (key, slot), live particles first
+StructuredBuffer<GpuParticleEmitter> gEmitters : register(t3); // atlas region and flipbook per emitter
 #endif
 
 cbuffer ParticleCB : register(b0)
@@ -20,50 +28,105 @@ struct VSIn
     float2 uv         : TEXCOORD0;
     float4 centerSize : TEXCOORD1;
     float4 color      : TEXCOORD2;
-    float4 params0    : TEXCOORD3;
-    float4 params1    : TEXCOORD4;
+    float4 params0    : TEXCOORD3; // x = rotation, y = asfloat(texture index)
+    float4 params1    : TEXCOORD4; // frame UV rect: xy = offset, zw = size
 };
 
 struct VSOut
 {
-    float4 pos   : SV_POSITION;
-    float2 uv    : TEXCOORD0;
-    float4 color : TEXCOORD1;
+    float4 pos                    : SV_POSITION;
+    float2 uv                     : TEXCOORD0; // quad-local, drives the falloff
+    float4 color                  : TEXCOORD1;
+    float2 texUv                  : TEXCOORD2; // inside the frame rect
+    nointerpolation uint texIndex : TEXCOORD3;
 };
 
-VSOut VSMain(VSIn IN)
+float4 BillboardClipPos(float2 localPos, float3 center, float size, float angle)
 {
-    const float size = IN.centerSize.w;
-    const float angle = IN.params0.x;
-
-    float2 local = IN.localPos.xy;
+    float2 local = localPos;
     const float s = sin(angle);
     const float c = cos(angle);
     local = float2(local.x * c - local.y * s, local.x * s + local.y * c);
 
-    const float3 worldPos = IN.centerSize.xyz
+    const float3 worldPos = center
         + uCameraRight.xyz * (local.x * size)
         + uCameraUp.xyz * (local.y * size);
+    return mul(float4(worldPos, 1.0f), uViewProj);
+}
+
+float ParticleIntensity(float2 uv)
+{
+    const float2 d = uv * 2.0f - 1.0f;
+    const float r2 = dot(d, d);
+    const float falloff = saturate(1.0f - r2);
+    return falloff * falloff;
+}
 
+// Premultiplied output for the additive particle blend.
+float4 ShadeParticle(float2 uv, float2 texUv, float4 color, uint texIndex)
+{
+    const float intensity = ParticleIntensity(uv);
+    if (texIndex != 0)
+    {
+        const float4 texel = gBindlessTex[NonUniformResourceIndex(texIndex)].Sample(gLinear, texUv);
+        const float alpha = texel.a * intensity * color.a;
+        return float4(texel.rgb * color.rgb * alpha, alpha);
+    }
+    return float4(color.rgb * intensity * color.a, intensity * color.a);
+}
+
+VSOut VSMain(VSIn IN)
+{
     VSOut OUT;
-    OUT.pos = mul(float4(worldPos, 1.0f), uViewProj);
+    OUT.pos = BillboardClipPos(IN.localPos.xy, IN.centerSize.xyz, IN.centerSize.w, IN.params0.x);
     OUT.uv = IN.uv;
     OUT.color = IN.color;
+    OUT.texUv = IN.params1.xy + IN.uv * IN.params1.zw;
+    OUT.texIndex = asuint(IN.params0.y);
     return OUT;
 }
 
 float4 PSMain(VSOut IN) : SV_Target
 {
-    const float2 d = IN.uv * 2.0f - 1.0f;
-    const float r2 = dot(d, d);
-    const float falloff = saturate(1.0f - r2);
-    const float intensity = falloff * falloff;
+    return ShadeParticle(IN.uv, IN.texUv, IN.color, IN.texIndex);
+}
 
-#if PARTICLE_TEXTURED
-    const float4 texel = gParticleTex.Sample(gLinear, IN.uv);
-    const float alpha = texel.a * intensity * IN.color.a;
-    return float4(texel.rgb * IN.color.rgb * alpha, alpha);
-#else
-    return float4(IN.color.rgb * intensity * IN.color.a, intensity * IN.color.a);
-#endif
+#if PARTICLE_GPU
+struct VSInGpu
+{
+    float3 localPos : POSITION;
+    float2 uv       : TEXCOORD0;
+    uint instance   : SV_InstanceID;
+};
+
+struct VSOutGpu
+{
+    float4 pos                    : SV_POSITION;
+    float2 uv                     : TEXCOORD0; // quad-local, drives the falloff
+    float4 color                  : TEXCOORD1;
+    float2 texUv                  : TEXCOORD2; // inside the frame rect
+    nointerpolation uint texIndex : TEXCOORD3;
+};
+
+VSOutGpu VSMainGpu(VSInGpu IN)
+{
+    const GpuParticle p = gParticles[gSortedParticles[IN.instance].y];
+    const float lifeT = GpuParticleLifeT(p);
+    const float size = lerp(p.sizeRotation.x, p.sizeRotation.y, lifeT);
+    const GpuParticleEmitter emitter = gEmitters[p.meta.x];
+    const float4 frameRect = GpuParticleFrameUvRect(emitter.uvRect, emitter.flipbook, p.positionAge.w, p.velocityLifetime.w);
+
+    VSOutGpu OUT;
+    OUT.pos = BillboardClipPos(IN.localPos.xy, p.positionAge.xyz, size, p.sizeRotation.z);
+    OUT.uv = IN.uv;
+    OUT.color = lerp(p.colorBegin, p.colorEnd, lifeT);
+    OUT.texUv = frameRect.xy + IN.uv * frameRect.zw;
+    OUT.texIndex = p.meta.z;
+    return OUT;
 }
+
+float4 PSMainGpu(VSOutGpu IN) : SV_Target
+{
+    return ShadeParticle(IN.uv, IN.texUv, IN.color, IN.texIndex);
+}
+#endif
@@ -1,6 +1,8 @@
 // ReflectionCapture_dx12.hlsl (fallback: render ONE face per pass)
 // Save as UTF-8 without BOM.
 
+#include "VertexCompact_dx12.hlsli"
+
 SamplerState gLinear : register(s0);
 Texture2D gAlbedo : register(t0);
 
@@ -33,7 +35,7 @@ float4x4 MakeMatRows(float4 r0, float4 r1, float4 r2, float4 r3)
 
 struct VSIn
 {
-    float3 pos : POSITION;
+    float4 pos : POSITION;
     float3 nrm : NORMAL;
     float2 uv : TEXCOORD0;
 
@@ -56,10 +58,10 @@ VSOut VS_ReflectionCapture(VSIn IN)
     VSOut OUT;
 
     float4x4 model = MakeMatRows(IN.i0, IN.i1, IN.i2, IN.i3);
-    float4 world = mul(float4(IN.pos, 1.0f), model);
+    float4 world = mul(float4(IN.pos.xyz, 1.0f), model);
 
     OUT.worldPos = world.xyz;
-    OUT.nrmW = normalize(mul(float4(IN.nrm, 0.0f), model).xyz);
+    OUT.nrmW = normalize(mul(float4(DecodeVertexNormal(IN.pos, IN.nrm), 0.0f), model).xyz);
     OUT.uv = IN.uv;
 
     float4x4 vp = uViewProj;
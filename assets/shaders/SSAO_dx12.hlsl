@@ -6,6 +6,10 @@ SamplerState gPointClamp : register(s2);
 
 #if FORWARD_SSAO_FROM_DEPTH
 Texture2D gDepth : register(t0); // depth (0..1)
+#elif GBUFFER_COMPACT
+#include "GBufferCompact_dx12.hlsli"
+Texture2D<float2> gGBuffer1 : register(t0); // octahedral normal
+Texture2D gDepth : register(t1); // depth (0..1)
 #else
 Texture2D gGBuffer1 : register(t0); // normal.xyz (encoded), metalness
 Texture2D gDepth : register(t1); // depth (0..1)
@@ -88,6 +92,8 @@ float PS_SSAO(VSOut IN) : SV_Target0
 
 #if FORWARD_SSAO_FROM_DEPTH
 	    float3 N = ReconstructNormalFromDepth(IN.uv, depthC);
+#elif GBUFFER_COMPACT
+	float3 N = GBufferOctDecode(gGBuffer1.Sample(gPointClamp, IN.uv));
 #else
 	float3 N = normalize(gGBuffer1.Sample(gPointClamp, IN.uv).rgb * 2.0f - 1.0f);
 	#endif
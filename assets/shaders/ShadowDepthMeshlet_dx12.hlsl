@@ -0,0 +1,47 @@
+// SM6.5 amplification + mesh shaders for the directional cascades (depth-only, no pixel shader).
+// Casters draw two-sided, so meshlets are only frustum culled.
+
+#include "Meshlet_dx12.hlsli"
+
+cbuffer ShadowCB : register(b0)
+{
+    float4x4 uLightViewProj;
+    float4 uPlanes[6];
+    uint4 uMeshlet; // firstMeshlet, meshletCount, first instance, instanceCount
+};
+
+struct VSOut
+{
+    float4 posH : SV_Position;
+};
+
+[numthreads(kMeshletsPerGroup, 1, 1)]
+void AS_ShadowMeshlet(uint threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    AmplifyMeshlets(threadId, groupId.xy, uMeshlet, uPlanes, float3(0.0f, 0.0f, 0.0f), false);
+}
+
+[outputtopology("triangle")]
+[numthreads(kMeshletThreads, 1, 1)]
+void MS_ShadowMeshlet(
+    uint threadId : SV_GroupThreadID,
+    uint groupId : SV_GroupID,
+    in payload MeshletPayload payload,
+    out vertices VSOut verts[kMeshletMaxVertices],
+    out indices uint3 tris[kMeshletMaxTriangles])
+{
+    const Meshlet m = gMeshlets[payload.meshlets[groupId]];
+    const InstanceData inst = gMeshletInstances[payload.instance];
+
+    SetMeshOutputCounts(m.vertexCount, m.triangleCount);
+
+    if (threadId < m.vertexCount)
+    {
+        const float3 world = MeshletTransformPoint(inst, LoadMeshletVertex(m, threadId).pos);
+        verts[threadId].posH = mul(float4(world, 1.0f), uLightViewProj);
+    }
+    if (threadId < m.triangleCount)
+    {
+        tris[threadId] = MeshletTriangle(m, threadId);
+    }
+}
@@ -5,9 +5,8 @@ cbuffer ShadowCB : register(b0)
 
 struct VSIn
 {
+    // POSITION only: the depth-only vertex stream (MeshRHI::layoutDepthInstanced) has nothing else.
     float3 pos : POSITION;
-    float3 nrm : NORMAL;
-    float2 uv  : TEXCOORD0;
 
     // Instance matrix rows in TEXCOORD1..4
     float4 i0  : TEXCOORD1;
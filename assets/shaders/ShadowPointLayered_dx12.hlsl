@@ -12,16 +12,13 @@ cbuffer PointShadowCB : register(b0)
 
 struct VSIn
 {
+    // POSITION only: the depth-only vertex stream (MeshRHI::layoutDepthInstanced) has nothing else.
     float3 pos : POSITION;
-    float3 nrm : NORMAL;
-    float2 uv  : TEXCOORD0;
 
     float4 i0  : TEXCOORD1;
     float4 i1  : TEXCOORD2;
     float4 i2  : TEXCOORD3;
-    float4 i3  : TEXCOORD4;
-
-    uint   instanceId : SV_InstanceID;
+    float4 i3  : TEXCOORD4; // i0.w = cubemap face (see VS)
 };
 
 float4x4 MakeMatRows(float4 r0, float4 r1, float4 r2, float4 r3)
@@ -40,15 +37,15 @@ VSOut VS_ShadowPointLayered(VSIn IN)
 {
     VSOut OUT;
 
-    const float4x4 model = MakeMatRows(IN.i0, IN.i1, IN.i2, IN.i3);
+    // The CPU emits one instance per (caster, face) pair that survived per-face culling and stores the
+    // face in i0.w; column 0 of an affine model has w = 0, so restore it before transforming.
+    const uint face = min((uint)IN.i0.w, 5u);
+
+    const float4x4 model = MakeMatRows(float4(IN.i0.xyz, 0.0f), IN.i1, IN.i2, IN.i3);
     const float4 world   = mul(float4(IN.pos, 1.0f), model);
 
     OUT.worldPos = world.xyz;
 
-    // Assumes instance data is duplicated 6 times per original instance: for each object instance,
-    // we emit faces 0..5 in that order. Then face = instanceId % 6.
-    const uint face = IN.instanceId % 6u;
-
     OUT.posH   = mul(world, uFaceViewProj[face]);
     OUT.rtIndex = face;
     return OUT;
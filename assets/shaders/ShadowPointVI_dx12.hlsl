@@ -11,9 +11,8 @@ cbuffer PointShadowCB : register(b0)
 
 struct VSIn
 {
+    // POSITION only: the depth-only vertex stream (MeshRHI::layoutDepthInstanced) has nothing else.
     float3 pos : POSITION;
-    float3 nrm : NORMAL;
-    float2 uv  : TEXCOORD0;
 
     float4 i0  : TEXCOORD1;
     float4 i1  : TEXCOORD2;
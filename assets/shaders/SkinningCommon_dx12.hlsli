@@ -6,7 +6,12 @@
 // Each draw selects its palette slice via:
 //   uSkinning.x = paletteOffset
 //   uSkinning.y = boneCount
-StructuredBuffer<float4x4> gSkinMatrices : register(t19);
+// boneCount 0 marks vertices the compute skinning pre-pass already skinned: they pass through unchanged.
+// The compute pass only has t0..t3 and includes this file with SKIN_MATRICES_REGISTER defined.
+#ifndef SKIN_MATRICES_REGISTER
+#define SKIN_MATRICES_REGISTER t19
+#endif
+StructuredBuffer<float4x4> gSkinMatrices : register(SKIN_MATRICES_REGISTER);
 
 float4x4 Identity4x4()
 {
@@ -62,6 +67,14 @@ void ApplySkinning(
     out float3 outNrm,
     out float4 outTangent)
 {
+    if (boneCount == 0)
+    {
+        outPos = inPos;
+        outNrm = inNrm;
+        outTangent = inTangent;
+        return;
+    }
+
     const float4x4 skin = BuildSkinMatrix(paletteOffset, boneCount, boneIndices, boneWeights);
     const float4 skinnedPos = mul(skin, float4(inPos, 1.0f));
     const float3x3 skin3x3 = (float3x3) skin;
@@ -0,0 +1,58 @@
+// Compute skinning pre-pass.
+// One dispatch per skinned draw: the draw's bind-pose vertices are skinned with its palette slice and
+// written to a slice of the skinned vertex cache in the same SkinnedVertexDesc layout (bone indices and
+// weights are copied through). The shadow, depth, main and reflection passes then draw the cache with
+// boneCount 0, so a character is skinned once per frame however many views it is drawn into.
+#define SKIN_MATRICES_REGISTER t0
+#include "SkinningCommon_dx12.hlsli"
+
+cbuffer SkinningCB : register(b0)
+{
+	uint4 uSkinning; // x = vertex count, y = first cached vertex, z = palette offset, w = bone count
+};
+
+// SkinnedVertexDesc (72 bytes).
+struct SkinnedVertex
+{
+	float3 position;
+	float3 normal;
+	float2 uv;
+	float4 tangent;
+	uint2 boneIndices; // 4 x uint16
+	float4 boneWeights;
+};
+
+StructuredBuffer<SkinnedVertex> gBindPose : register(t1);
+RWStructuredBuffer<SkinnedVertex> gSkinnedVertices : register(u0);
+
+[numthreads(64, 1, 1)]
+void CS_SkinVertices(uint3 id : SV_DispatchThreadID)
+{
+	const uint vertexIndex = id.x;
+	if (vertexIndex >= uSkinning.x)
+	{
+		return;
+	}
+
+	const SkinnedVertex src = gBindPose[vertexIndex];
+	const uint4 boneIndices = uint4(
+		src.boneIndices.x & 0xFFFFu,
+		src.boneIndices.x >> 16,
+		src.boneIndices.y & 0xFFFFu,
+		src.boneIndices.y >> 16);
+
+	SkinnedVertex dst = src;
+	ApplySkinning(
+		uSkinning.z,
+		uSkinning.w,
+		boneIndices,
+		src.boneWeights,
+		src.position,
+		src.normal,
+		src.tangent,
+		dst.position,
+		dst.normal,
+		dst.tangent);
+
+	gSkinnedVertices[uSkinning.y + vertexIndex] = dst;
+}
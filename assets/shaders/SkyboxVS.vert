@@ -4,7 +4,11 @@ layout(location = 0) in vec3 aPos;
 
 out vec3 vDir;
 
-uniform mat4 uVP;
+// std140; GLMeshRenderer::SkyboxConstants.
+layout(std140) uniform PerDraw
+{
+    mat4 uVP;
+};
 
 void main()
 {
@@ -0,0 +1,110 @@
+// Upscale_dx12.hlsl
+// Dynamic resolution present (deferred DX12 path): the tone-mapped LDR image rendered at the scaled size is
+// resampled to the swap chain with a Catmull-Rom bicubic filter (9 bilinear taps) and a light sharpen
+// clamped to the neighbourhood. The scaled scene depth is written alongside (nearest texel) so the debug
+// passes after the present still depth test against the scene.
+
+SamplerState gLinear : register(s0);
+SamplerComparisonState gShadowCmp : register(s1);
+SamplerState gPointClamp : register(s2);
+SamplerState gLinearClamp : register(s3);
+
+Texture2D gSource : register(t0);
+Texture2D<float> gDepth : register(t1);
+
+cbuffer UpscaleConstants : register(b0)
+{
+    float4 uSourceSize; // x=w, y=h, z=1/w, w=1/h of gSource
+    float4 uParams;     // x=sharpness (0..1)
+};
+
+struct VSOut
+{
+    float4 svPos : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+VSOut VS_Fullscreen(uint id : SV_VertexID)
+{
+    float2 pos = float2((id == 2) ? 3.0 : -1.0, (id == 1) ? 3.0 : -1.0);
+    float2 uv = float2((pos.x + 1.0) * 0.5, 1.0 - (pos.y + 1.0) * 0.5);
+
+    VSOut o;
+    o.svPos = float4(pos, 0.0, 1.0);
+    o.uv = uv;
+    return o;
+}
+
+float3 SampleSource(float2 uv)
+{
+    return gSource.SampleLevel(gLinearClamp, uv, 0.0f).rgb;
+}
+
+// Catmull-Rom over a 4x4 texel footprint; the middle two rows/columns share one bilinear tap.
+float3 SampleCatmullRom(float2 uv)
+{
+    const float2 samplePos = uv * uSourceSize.xy;
+    const float2 texPos1 = floor(samplePos - 0.5f) + 0.5f;
+    const float2 f = samplePos - texPos1;
+
+    const float2 w0 = f * (-0.5f + f * (1.0f - 0.5f * f));
+    const float2 w1 = 1.0f + f * f * (-2.5f + 1.5f * f);
+    const float2 w2 = f * (0.5f + f * (2.0f - 1.5f * f));
+    const float2 w3 = f * f * (-0.5f + 0.5f * f);
+
+    const float2 w12 = w1 + w2;
+    const float2 offset12 = w2 / w12;
+
+    const float2 uv0 = (texPos1 - 1.0f) * uSourceSize.zw;
+    const float2 uv3 = (texPos1 + 2.0f) * uSourceSize.zw;
+    const float2 uv12 = (texPos1 + offset12) * uSourceSize.zw;
+
+    float3 result = 0.0f;
+    result += SampleSource(float2(uv0.x, uv0.y)) * (w0.x * w0.y);
+    result += SampleSource(float2(uv12.x, uv0.y)) * (w12.x * w0.y);
+    result += SampleSource(float2(uv3.x, uv0.y)) * (w3.x * w0.y);
+
+    result += SampleSource(float2(uv0.x, uv12.y)) * (w0.x * w12.y);
+    result += SampleSource(float2(uv12.x, uv12.y)) * (w12.x * w12.y);
+    result += SampleSource(float2(uv3.x, uv12.y)) * (w3.x * w12.y);
+
+    result += SampleSource(float2(uv0.x, uv3.y)) * (w0.x * w3.y);
+    result += SampleSource(float2(uv12.x, uv3.y)) * (w12.x * w3.y);
+    result += SampleSource(float2(uv3.x, uv3.y)) * (w3.x * w3.y);
+
+    return result;
+}
+
+struct PSOut
+{
+    float4 color : SV_Target0;
+    float depth : SV_Depth;
+};
+
+PSOut PS_Upscale(VSOut IN)
+{
+    const float2 texel = uSourceSize.zw;
+    const float3 n = SampleSource(IN.uv + float2(0.0f, -texel.y));
+    const float3 s = SampleSource(IN.uv + float2(0.0f, texel.y));
+    const float3 e = SampleSource(IN.uv + float2(texel.x, 0.0f));
+    const float3 w = SampleSource(IN.uv + float2(-texel.x, 0.0f));
+    const float3 c = SampleSource(IN.uv);
+
+    float3 color = SampleCatmullRom(IN.uv);
+
+    // Unsharp mask against the cross average; clamping to the local range also removes the bicubic ringing.
+    const float3 localMin = min(c, min(min(n, s), min(e, w)));
+    const float3 localMax = max(c, max(max(n, s), max(e, w)));
+    const float3 blurred = (n + s + e + w) * 0.25f;
+    color += (color - blurred) * saturate(uParams.x);
+    color = clamp(color, localMin, localMax);
+
+    uint depthW, depthH;
+    gDepth.GetDimensions(depthW, depthH);
+    const int2 depthTexel = min(int2(IN.uv * float2(depthW, depthH)), int2(depthW, depthH) - 1);
+
+    PSOut o;
+    o.color = float4(color, 1.0f);
+    o.depth = gDepth.Load(int3(depthTexel, 0));
+    return o;
+}
@@ -1,16 +1,31 @@
-#version 330 core
+#version 450 core
 layout(location=0) in vec3 aPos;
 layout(location=1) in vec3 aN;
 layout(location=2) in vec2 aUV;
 
-uniform mat4 uMVP;
+// Per instance (vertex slot 1, TEXCOORD1..4): model matrix columns.
+layout(location=7) in vec4 iModel0;
+layout(location=8) in vec4 iModel1;
+layout(location=9) in vec4 iModel2;
+layout(location=10) in vec4 iModel3;
+
+// Per-batch constants (std140), streamed by the OpenGL RHI's constant ring. Must match FS.frag and
+// GLMeshRenderer::BatchConstants.
+layout(std140, binding = 0) uniform PerBatch
+{
+  mat4 uViewProj;
+  vec4 uColor;
+  int uUseTex;
+  uint uAlbedoIndex;
+};
 
 out vec2 vUV;
 out vec3 vN;
 
 void main()
 {
+  mat4 model = mat4(iModel0, iModel1, iModel2, iModel3);
   vUV = aUV;
-  vN = aN;
-  gl_Position = uMVP * vec4(aPos, 1.0);
-}
\ No newline at end of file
+  vN = mat3(model) * aN;
+  gl_Position = uViewProj * (model * vec4(aPos, 1.0));
+}
@@ -0,0 +1,33 @@
+#ifndef CORE_VERTEX_COMPACT_DX12_HLSLI
+#define CORE_VERTEX_COMPACT_DX12_HLSLI
+
+// Static-mesh vertex decode shared by the VertexDesc and VertexCompact layouts (Mesh.cppm).
+// Declare POSITION as float4: VertexDesc reads w = 1, VertexCompact stores the tangent sign in
+// w as 0 (-1) or 0.5 (+1) and octahedral NORMAL/TANGENT in .xy. Compact positions are in the
+// mesh's quantization box; the instance rows already carry the dequantization.
+
+bool IsCompactVertex(float4 pos)
+{
+    return pos.w < 0.75f;
+}
+
+float3 OctahedralDecode(float2 e)
+{
+    float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    const float t = saturate(-n.z);
+    n.x += (n.x >= 0.0f) ? -t : t;
+    n.y += (n.y >= 0.0f) ? -t : t;
+    return normalize(n);
+}
+
+float3 DecodeVertexNormal(float4 pos, float3 nrm)
+{
+    return IsCompactVertex(pos) ? OctahedralDecode(nrm.xy) : nrm;
+}
+
+float4 DecodeVertexTangent(float4 pos, float4 tangent)
+{
+    return IsCompactVertex(pos) ? float4(OctahedralDecode(tangent.xy), (pos.w > 0.25f) ? 1.0f : -1.0f) : tangent;
+}
+
+#endif
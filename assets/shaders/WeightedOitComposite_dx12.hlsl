@@ -0,0 +1,38 @@
+// WeightedOitComposite_dx12.hlsl
+// Fullscreen resolve of weighted blended OIT: the weighted average color of all transparent layers,
+// blended over SceneColor by their total coverage (SrcAlpha, InvSrcAlpha).
+
+Texture2D gOitAccum : register(t0);
+Texture2D<float> gOitCoverage : register(t1);
+
+struct VSOut
+{
+	float4 pos : SV_Position;
+	float2 uv : TEXCOORD0;
+};
+
+VSOut VS_Fullscreen(uint vid : SV_VertexID)
+{
+	float2 verts[3] = { float2(-1.0, -1.0), float2(-1.0, 3.0), float2(3.0, -1.0) };
+	float2 p = verts[vid];
+
+	VSOut o;
+	o.pos = float4(p, 0.0, 1.0);
+	o.uv = float2((p.x + 1.0f) * 0.5f, 1.0f - (p.y + 1.0f) * 0.5f);
+	return o;
+}
+
+float4 PS_WeightedOitComposite(VSOut i) : SV_Target0
+{
+	// Same extent as SceneColor, so texels are read 1:1.
+	const int3 texel = int3(i.pos.xy, 0);
+	const float coverage = gOitCoverage.Load(texel);
+	if (coverage <= 1e-4f)
+	{
+		discard;
+	}
+
+	const float4 accum = gOitAccum.Load(texel);
+	const float3 color = accum.rgb / max(accum.a, 1e-5f);
+	return float4(color, saturate(coverage));
+}
@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+import core;
+
+namespace
+{
+	constexpr float kClipTicks = 120.0f;
+
+	std::vector<rendern::TranslationKey> MakeTranslationKeys(std::uint32_t keyCount)
+	{
+		std::vector<rendern::TranslationKey> keys;
+		keys.reserve(keyCount);
+		for (std::uint32_t k = 0; k < keyCount; ++k)
+		{
+			const float t = kClipTicks * static_cast<float>(k) / static_cast<float>(keyCount - 1);
+			keys.push_back(rendern::TranslationKey{ .timeTicks = t, .value = { t, 0.5f * t, 0.0f } });
+		}
+		return keys;
+	}
+
+	// A skeleton shaped like a character rig (spine chains with short branches) and a clip that
+	// animates every bone with evenly spaced keys, as baked clips come out of the importer.
+	struct AnimationFixture
+	{
+		rendern::Skeleton skeleton{};
+		rendern::AnimationClip clip{};
+		rendern::AnimatorState animator{};
+
+		AnimationFixture(std::uint32_t boneCount, std::uint32_t keyCount)
+		{
+			for (std::uint32_t bone = 0; bone < boneCount; ++bone)
+			{
+				rendern::SkeletonBone b{};
+				b.name = "bone" + std::to_string(bone);
+				b.parentIndex = bone == 0 ? -1 : static_cast<int>((bone - 1) & ~3u);
+				b.bindLocalTransform = mathUtils::Translate(mathUtils::Mat4(1.0f), mathUtils::Vec3(0.0f, 0.1f, 0.0f));
+				skeleton.bones.push_back(b);
+			}
+
+			clip.durationTicks = kClipTicks;
+			clip.ticksPerSecond = 30.0f;
+			clip.looping = true;
+			for (std::uint32_t bone = 0; bone < boneCount; ++bone)
+			{
+				rendern::BoneAnimationChannel channel{};
+				channel.boneIndex = static_cast<int>(bone);
+				channel.translationKeys = MakeTranslationKeys(keyCount);
+				for (std::uint32_t k = 0; k < keyCount; ++k)
+				{
+					const float t = kClipTicks * static_cast<float>(k) / static_cast<float>(keyCount - 1);
+					const float s = std::sin(t * 0.05f);
+					channel.rotationKeys.push_back(rendern::RotationKey{ .timeTicks = t, .value = rendern::NormalizeQuat(mathUtils::Vec4(s, 0.0f, 0.0f, 1.0f)) });
+					channel.scaleKeys.push_back(rendern::ScaleKey{ .timeTicks = t, .value = { 1.0f, 1.0f, 1.0f } });
+				}
+				clip.channels.push_back(std::move(channel));
+			}
+			rendern::BuildUniformKeyTiming(clip);
+
+			rendern::InitializeAnimator(animator, &skeleton, &clip);
+		}
+
+		// Moves forward like a 60 Hz frame, so key cursors see the usual small steps.
+		void Advance() noexcept
+		{
+			animator.timeSeconds += 1.0f / 60.0f;
+		}
+	};
+}
+
+static void BM_SampleTranslationKeys_Search(benchmark::State& state)
+{
+	const std::vector<rendern::TranslationKey> keys = MakeTranslationKeys(static_cast<std::uint32_t>(state.range(0)));
+	float t = 0.0f;
+	for (auto _ : state)
+	{
+		mathUtils::Vec3 v = rendern::SampleTranslationKeys(keys, t, mathUtils::Vec3(0.0f, 0.0f, 0.0f));
+		benchmark::DoNotOptimize(v);
+		t = t + 0.5f < kClipTicks ? t + 0.5f : 0.0f;
+	}
+}
+BENCHMARK(BM_SampleTranslationKeys_Search)->Arg(16)->Arg(256);
+
+static void BM_SampleTranslationKeys_Uniform(benchmark::State& state)
+{
+	rendern::AnimationClip clip{};
+	clip.durationTicks = kClipTicks;
+	clip.channels.emplace_back().translationKeys = MakeTranslationKeys(static_cast<std::uint32_t>(state.range(0)));
+	rendern::BuildUniformKeyTiming(clip);
+	const rendern::BoneAnimationChannel& channel = clip.channels.front();
+
+	std::uint32_t cursor = 0;
+	float t = 0.0f;
+	for (auto _ : state)
+	{
+		mathUtils::Vec3 v = rendern::SampleTranslationKeys(channel.translationKeys, t, mathUtils::Vec3(0.0f, 0.0f, 0.0f), channel.translationTiming, cursor);
+		benchmark::DoNotOptimize(v);
+		t = t + 0.5f < kClipTicks ? t + 0.5f : 0.0f;
+	}
+}
+BENCHMARK(BM_SampleTranslationKeys_Uniform)->Arg(16)->Arg(256);
+
+static void BM_EvaluateAnimatorLocalPose(benchmark::State& state)
+{
+	AnimationFixture fixture(static_cast<std::uint32_t>(state.range(0)), 64);
+	for (auto _ : state)
+	{
+		fixture.Advance();
+		rendern::EvaluateAnimatorLocalPose(fixture.animator);
+		benchmark::DoNotOptimize(fixture.animator.localPose.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EvaluateAnimatorLocalPose)->Arg(64)->Arg(256);
+
+static void BM_BuildAnimatorMatrices(benchmark::State& state)
+{
+	AnimationFixture fixture(static_cast<std::uint32_t>(state.range(0)), 64);
+	rendern::EvaluateAnimatorLocalPose(fixture.animator);
+	for (auto _ : state)
+	{
+		rendern::BuildAnimatorMatrices(fixture.animator);
+		benchmark::DoNotOptimize(fixture.animator.skinMatrices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuildAnimatorMatrices)->Arg(64)->Arg(256);
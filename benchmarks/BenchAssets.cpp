@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+import core;
+
+// Asset paths are resolved against the "assets" directory found by walking up from the working
+// directory, so run the benchmarks from the build tree or the repository root.
+
+namespace
+{
+	// Decodes nothing and never runs a job: LoadOrGet then only exercises the cache lookup.
+	struct NullTextureDecoder final : ITextureDecoder
+	{
+		std::optional<TextureCPUData> Decode(const TextureProperties&, std::string_view) override { return std::nullopt; }
+	};
+
+	struct NullTextureUploader final : ITextureUploader
+	{
+		std::optional<GPUTexture> CreateAndUpload(const TextureCPUData&, const TextureProperties&) override { return std::nullopt; }
+		void Destroy(GPUTexture) noexcept override {}
+	};
+
+	struct NullJobSystem final : IJobSystem
+	{
+		void Enqueue(std::function<void()>) override {}
+		void WaitIdle() override {}
+	};
+
+	struct NullRenderQueue final : IRenderQueue
+	{
+		void Enqueue(std::function<void()>) override {}
+	};
+
+	constexpr int kContendedTextureCount = 256;
+
+	std::string ContendedTextureId(int index)
+	{
+		return "bench/texture_" + std::to_string(index);
+	}
+}
+
+static void BM_LoadLevelAssetFromJson(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		rendern::LevelAsset level = rendern::LoadLevelAssetFromJson("levels/demo.level.json");
+		benchmark::DoNotOptimize(level.nodes.data());
+	}
+}
+BENCHMARK(BM_LoadLevelAssetFromJson)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadObj(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		rendern::MeshCPU mesh = rendern::LoadObj("models/watermelon.obj");
+		benchmark::DoNotOptimize(mesh.vertices.data());
+	}
+}
+BENCHMARK(BM_LoadObj)->Unit(benchmark::kMillisecond);
+
+static void BM_StbDecode(benchmark::State& state)
+{
+	StbTextureDecoder decoder;
+	TextureProperties properties{};
+	properties.filePath = "textures/watermelon_albedo.jpg";
+	properties.generateMips = state.range(0) != 0;
+	for (auto _ : state)
+	{
+		std::optional<TextureCPUData> cpu = decoder.Decode(properties, properties.filePath);
+		benchmark::DoNotOptimize(cpu);
+	}
+}
+BENCHMARK(BM_StbDecode)->ArgName("mips")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Cache hits from several threads at once: every LoadOrGet takes the storage mutex.
+static void BM_ResourceStorageLoadOrGet(benchmark::State& state)
+{
+	static NullTextureDecoder decoder;
+	static NullTextureUploader uploader;
+	static NullJobSystem jobSystem;
+	static NullRenderQueue renderQueue;
+	static TextureIO io{ decoder, uploader, jobSystem, renderQueue };
+
+	static ResourceManager resources;
+	static const std::vector<std::string> ids = []()
+		{
+			std::vector<std::string> out;
+			for (int i = 0; i < kContendedTextureCount; ++i)
+			{
+				out.push_back(ContendedTextureId(i));
+				TextureProperties properties{};
+				properties.filePath = out.back();
+				resources.Load<TextureResource>(out.back(), io, std::move(properties));
+			}
+			return out;
+		}();
+
+	auto& storage = resources.GetStorage<TextureResource>();
+	const TextureProperties properties{};
+	std::size_t next = static_cast<std::size_t>(state.thread_index()) * 17u;
+	for (auto _ : state)
+	{
+		std::shared_ptr<TextureResource> handle = storage.LoadOrGet(ids[next % ids.size()], io, properties);
+		benchmark::DoNotOptimize(handle.get());
+		++next;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ResourceStorageLoadOrGet)->ThreadRange(1, 8)->UseRealTime();
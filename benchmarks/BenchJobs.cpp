@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+import core;
+
+namespace
+{
+	constexpr int kJobsPerBatch = 4096;
+
+	// Enqueue a batch of tiny jobs through IJobSystem and wait for all of them: measures queueing and
+	// wake-up overhead, which is what the decode path pays per texture.
+	void RunBatch(IJobSystem& jobSystem, std::atomic<int>& counter)
+	{
+		for (int i = 0; i < kJobsPerBatch; ++i)
+		{
+			jobSystem.Enqueue([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+		}
+		jobSystem.WaitIdle();
+	}
+}
+
+static void BM_JobSystemThreadPoolThroughput(benchmark::State& state)
+{
+	rendern::JobSystemThreadPool jobSystem(static_cast<std::uint32_t>(state.range(0)));
+	std::atomic<int> counter{ 0 };
+	for (auto _ : state)
+	{
+		RunBatch(jobSystem, counter);
+	}
+	benchmark::DoNotOptimize(counter.load());
+	state.SetItemsProcessed(state.iterations() * kJobsPerBatch);
+}
+BENCHMARK(BM_JobSystemThreadPoolThroughput)->ArgName("workers")->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+
+static void BM_JobSystemWorkStealingThroughput(benchmark::State& state)
+{
+	rendern::JobSystemWorkStealing jobSystem(static_cast<std::uint32_t>(state.range(0)));
+	std::atomic<int> counter{ 0 };
+	for (auto _ : state)
+	{
+		RunBatch(jobSystem, counter);
+	}
+	benchmark::DoNotOptimize(counter.load());
+	state.SetItemsProcessed(state.iterations() * kJobsPerBatch);
+}
+BENCHMARK(BM_JobSystemWorkStealingThroughput)->ArgName("workers")->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+
+static void BM_ParallelFor(benchmark::State& state)
+{
+	jobs::Scheduler scheduler(static_cast<std::uint32_t>(state.range(0)));
+	constexpr std::size_t kCount = 1u << 16;
+	std::vector<float> values(kCount, 1.0f);
+	for (auto _ : state)
+	{
+		jobs::ParallelFor(&scheduler, kCount, 1024, [&values](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					values[i] = values[i] * 1.0001f + 0.5f;
+				}
+			});
+		benchmark::DoNotOptimize(values.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kCount));
+}
+BENCHMARK(BM_ParallelFor)->ArgName("workers")->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
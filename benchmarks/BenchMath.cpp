@@ -0,0 +1,154 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+import core;
+
+using namespace mathUtils;
+
+namespace
+{
+	Mat4 MakeViewProj()
+	{
+		const Mat4 proj = PerspectiveRH_ZO(DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+		const Mat4 view = LookAtRH(Vec3(0.0f, 5.0f, 20.0f), Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+		return proj * view;
+	}
+
+	// Spheres and boxes scattered around the camera: roughly a third end up inside the frustum.
+	struct CullSet
+	{
+		std::vector<float> x, y, z, radius;
+		std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+		std::vector<std::uint32_t> mask;
+
+		explicit CullSet(std::size_t count)
+		{
+			std::mt19937 rng(1234u);
+			std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+			std::uniform_real_distribution<float> size(0.25f, 4.0f);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const float cx = pos(rng);
+				const float cy = pos(rng) * 0.1f;
+				const float cz = pos(rng);
+				const float r = size(rng);
+				x.push_back(cx);
+				y.push_back(cy);
+				z.push_back(cz);
+				radius.push_back(r);
+				minX.push_back(cx - r);
+				minY.push_back(cy - r);
+				minZ.push_back(cz - r);
+				maxX.push_back(cx + r);
+				maxY.push_back(cy + r);
+				maxZ.push_back(cz + r);
+			}
+			mask.resize(CullMaskWordCount(count));
+		}
+	};
+}
+
+static void BM_Mat4Mul(benchmark::State& state)
+{
+	Mat4 a = Rotate(Translate(Mat4(1.0f), Vec3(1.0f, 2.0f, 3.0f)), 0.3f, Vec3(0.0f, 1.0f, 0.0f));
+	const Mat4 b = Scale(Mat4(1.0f), Vec3(1.01f, 0.99f, 1.0f));
+	for (auto _ : state)
+	{
+		a = a * b;
+		benchmark::DoNotOptimize(a);
+	}
+}
+BENCHMARK(BM_Mat4Mul);
+
+static void BM_Mat4Inverse(benchmark::State& state)
+{
+	const Mat4 m = MakeViewProj();
+	for (auto _ : state)
+	{
+		Mat4 inv = Inverse(m);
+		benchmark::DoNotOptimize(inv);
+	}
+}
+BENCHMARK(BM_Mat4Inverse);
+
+static void BM_Mat4MulVec4(benchmark::State& state)
+{
+	const Mat4 m = MakeViewProj();
+	Vec4 v(1.0f, 2.0f, 3.0f, 1.0f);
+	for (auto _ : state)
+	{
+		Vec4 r = m * v;
+		benchmark::DoNotOptimize(r);
+		v.x += 1e-3f;
+	}
+}
+BENCHMARK(BM_Mat4MulVec4);
+
+static void BM_QuatToMat4(benchmark::State& state)
+{
+	const Vec4 q(0.1826f, 0.3651f, 0.5477f, 0.7303f);
+	for (auto _ : state)
+	{
+		Mat4 m = QuatToMat4(q);
+		benchmark::DoNotOptimize(m);
+	}
+}
+BENCHMARK(BM_QuatToMat4);
+
+static void BM_ExtractFrustum(benchmark::State& state)
+{
+	const Mat4 viewProj = MakeViewProj();
+	for (auto _ : state)
+	{
+		Frustum frustum = ExtractFrustumRH_ZO(viewProj);
+		benchmark::DoNotOptimize(frustum);
+	}
+}
+BENCHMARK(BM_ExtractFrustum);
+
+static void BM_FrustumSphereScalar(benchmark::State& state)
+{
+	const Frustum frustum = ExtractFrustumRH_ZO(MakeViewProj());
+	const CullSet set(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		std::size_t visible = 0;
+		for (std::size_t i = 0; i < set.radius.size(); ++i)
+		{
+			visible += IntersectsSphere(frustum, Vec3(set.x[i], set.y[i], set.z[i]), set.radius[i]) ? 1u : 0u;
+		}
+		benchmark::DoNotOptimize(visible);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FrustumSphereScalar)->Arg(1024)->Arg(16384);
+
+static void BM_CullSpheres(benchmark::State& state)
+{
+	const Frustum frustum = ExtractFrustumRH_ZO(MakeViewProj());
+	CullSet set(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		CullSpheres(frustum, set.x, set.y, set.z, set.radius, set.mask);
+		benchmark::DoNotOptimize(set.mask.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CullSpheres)->Arg(1024)->Arg(16384);
+
+static void BM_CullAabbs(benchmark::State& state)
+{
+	const Frustum frustum = ExtractFrustumRH_ZO(MakeViewProj());
+	CullSet set(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		CullAabbs(frustum, set.minX, set.minY, set.minZ, set.maxX, set.maxY, set.maxZ, set.mask);
+		benchmark::DoNotOptimize(set.mask.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CullAabbs)->Arg(1024)->Arg(16384);
@@ -0,0 +1,373 @@
+import core;
+import std;
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include "AppBenchmark.h"
+
+namespace appBenchmark
+{
+    namespace
+    {
+        constexpr std::string_view kBenchmarkPrefix = "--benchmark-";
+
+        bool TryGetOptionValue(std::string_view arg, std::string_view name, std::string_view& outValue)
+        {
+            if (arg.size() <= name.size() + 1 || !arg.starts_with(name) || arg[name.size()] != '=')
+            {
+                return false;
+            }
+            outValue = arg.substr(name.size() + 1);
+            return true;
+        }
+
+        template <typename T>
+        T ParseNumber(std::string_view name, std::string_view value)
+        {
+            T out{};
+            const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), out);
+            if (ec != std::errc{} || end != value.data() + value.size())
+            {
+                throw std::runtime_error("Bad value for " + std::string(name) + ": " + std::string(value));
+            }
+            return out;
+        }
+
+        struct Summary
+        {
+            double mean = 0.0;
+            double min = 0.0;
+            double p50 = 0.0;
+            double p95 = 0.0;
+            double max = 0.0;
+        };
+
+        Summary Summarize(std::vector<double> values)
+        {
+            Summary s{};
+            if (values.empty())
+            {
+                return s;
+            }
+
+            std::sort(values.begin(), values.end());
+            const auto Percentile = [&values](double p)
+                {
+                    const std::size_t index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+                    return values[std::min(index, values.size() - 1)];
+                };
+
+            s.mean = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+            s.min = values.front();
+            s.p50 = Percentile(0.50);
+            s.p95 = Percentile(0.95);
+            s.max = values.back();
+            return s;
+        }
+
+        void WriteSummary(std::ostream& out, const Summary& s)
+        {
+            out << "{\"mean\":" << s.mean
+                << ",\"min\":" << s.min
+                << ",\"p50\":" << s.p50
+                << ",\"p95\":" << s.p95
+                << ",\"max\":" << s.max << "}";
+        }
+
+        void WriteJsonString(std::ostream& out, std::string_view text)
+        {
+            out << '"';
+            for (const char c : text)
+            {
+                switch (c)
+                {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        out << ' ';
+                    }
+                    else
+                    {
+                        out << c;
+                    }
+                    break;
+                }
+            }
+            out << '"';
+        }
+
+        void WriteZones(std::ostream& out, const std::map<std::string, std::vector<double>>& zones)
+        {
+            out << "[";
+            bool first = true;
+            for (const auto& [name, values] : zones)
+            {
+                out << (first ? "\n    " : ",\n    ");
+                first = false;
+                out << "{\"name\":";
+                WriteJsonString(out, name);
+                out << ",\"frames\":" << values.size() << ",\"ms\":";
+                WriteSummary(out, Summarize(values));
+                out << "}";
+            }
+            out << (first ? "]" : "\n  ]");
+        }
+
+        std::string_view BackendName(rhi::Backend backend) noexcept
+        {
+            switch (backend)
+            {
+            case rhi::Backend::DirectX12: return "DirectX12";
+            case rhi::Backend::OpenGL: return "OpenGL";
+            case rhi::Backend::Null: return "Null";
+            }
+            return "Unknown";
+        }
+    }
+
+    BenchmarkConfig ParseBenchmarkArgs(int argc, char** argv)
+    {
+        BenchmarkConfig config{};
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            const std::string_view arg = argv[argIndex];
+            if (arg == "--benchmark")
+            {
+                config.enabled = true;
+                continue;
+            }
+            if (!arg.starts_with(kBenchmarkPrefix))
+            {
+                continue;
+            }
+
+            config.enabled = true;
+            std::string_view value;
+            if (TryGetOptionValue(arg, "--benchmark-level", value))
+            {
+                config.levelPath = std::string(value);
+            }
+            else if (TryGetOptionValue(arg, "--benchmark-camera", value))
+            {
+                config.cameraPath = std::string(value);
+            }
+            else if (TryGetOptionValue(arg, "--benchmark-out", value))
+            {
+                config.outputPath = std::string(value);
+            }
+            else if (TryGetOptionValue(arg, "--benchmark-warmup", value))
+            {
+                config.warmupFrames = ParseNumber<std::uint32_t>("--benchmark-warmup", value);
+            }
+            else if (TryGetOptionValue(arg, "--benchmark-frames", value))
+            {
+                config.measuredFrames = std::max(ParseNumber<std::uint32_t>("--benchmark-frames", value), 1u);
+            }
+            else if (TryGetOptionValue(arg, "--benchmark-dt", value))
+            {
+                const float dt = ParseNumber<float>("--benchmark-dt", value);
+                if (!(dt > 0.0f))
+                {
+                    throw std::runtime_error("--benchmark-dt must be positive");
+                }
+                config.fixedDeltaSeconds = dt;
+            }
+            else
+            {
+                throw std::runtime_error("Unknown benchmark option: " + std::string(arg));
+            }
+        }
+        return config;
+    }
+
+    std::string ParseRecordCameraArg(int argc, char** argv)
+    {
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            std::string_view value;
+            if (TryGetOptionValue(argv[argIndex], "--record-camera", value))
+            {
+                return std::string(value);
+            }
+        }
+        return {};
+    }
+
+    rendern::CameraPath MakeDefaultCameraPath(const rendern::Camera& startCamera)
+    {
+        const mathUtils::Vec3 offset = startCamera.position - startCamera.target;
+        const float radius = std::max(mathUtils::Length(mathUtils::Vec3(offset.x, 0.0f, offset.z)), 5.0f);
+        const float height = std::max(offset.y, 1.0f);
+        return rendern::MakeOrbitCameraPath(startCamera.target, radius, height, /*durationSeconds=*/20.0f);
+    }
+
+    BenchmarkRun::BenchmarkRun(BenchmarkConfig config, rendern::CameraPath cameraPath, std::string levelPath)
+        : config_(std::move(config))
+        , cameraPath_(std::move(cameraPath))
+        , levelPath_(std::move(levelPath))
+    {
+        samples_.reserve(config_.measuredFrames);
+    }
+
+    void BenchmarkRun::ApplyCamera(rendern::Camera& camera) const
+    {
+        float timeSeconds = static_cast<float>(pathFrames_) * config_.fixedDeltaSeconds;
+        const float duration = cameraPath_.DurationSeconds();
+        if (duration > 0.0f)
+        {
+            timeSeconds = std::fmod(timeSeconds, duration);
+        }
+        rendern::ApplyCameraPath(cameraPath_, timeSeconds, camera);
+    }
+
+    void BenchmarkRun::EndFrame(
+        bool levelReady,
+        const rhi::SubmissionStats& submission,
+        std::uint64_t uploadBytes,
+        const profiling::FrameCapture* capture)
+    {
+        if (IsDone())
+        {
+            return;
+        }
+
+        if (!started_)
+        {
+            ++loadingFrames_;
+            if (!levelReady && loadingFrames_ < config_.maxLoadingFrames)
+            {
+                return;
+            }
+            started_ = true;
+            levelReadyAtStart_ = levelReady;
+        }
+
+        const std::uint32_t frame = pathFrames_++;
+        if (frame < config_.warmupFrames)
+        {
+            return;
+        }
+
+        FrameSample sample{};
+        sample.cpuFrameMs = capture ? capture->DurationMs() : 0.0;
+        sample.draws = submission.draws;
+        sample.instances = submission.instances;
+        sample.dispatches = submission.dispatches;
+        sample.uploadBytes = uploadBytes;
+        samples_.push_back(sample);
+
+        if (!capture)
+        {
+            return;
+        }
+
+        std::map<std::string_view, double> frameZones;
+        for (const profiling::ThreadCapture& thread : capture->threads)
+        {
+            for (const profiling::ZoneEvent& zone : thread.zones)
+            {
+                if (zone.name)
+                {
+                    frameZones[zone.name] += static_cast<double>(zone.endNs - zone.beginNs) * 1e-6;
+                }
+            }
+        }
+        for (const auto& [name, ms] : frameZones)
+        {
+            cpuZoneMs_[std::string(name)].push_back(ms);
+        }
+
+        frameZones.clear();
+        for (const profiling::GpuZone& zone : capture->gpuZones)
+        {
+            frameZones[zone.name] += zone.endMs - zone.beginMs;
+        }
+        for (const auto& [name, ms] : frameZones)
+        {
+            gpuZoneMs_[std::string(name)].push_back(ms);
+        }
+    }
+
+    void BenchmarkRun::WriteResults(const std::filesystem::path& path, rhi::Backend backend, int width, int height) const
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("Benchmark: can't write " + path.string());
+        }
+        out << std::fixed << std::setprecision(3);
+
+        std::vector<double> frameMs;
+        std::vector<double> draws;
+        std::vector<double> instances;
+        std::vector<double> dispatches;
+        std::vector<double> uploadBytes;
+        std::uint64_t totalUploadBytes = 0;
+        for (const FrameSample& sample : samples_)
+        {
+            frameMs.push_back(sample.cpuFrameMs);
+            draws.push_back(sample.draws);
+            instances.push_back(sample.instances);
+            dispatches.push_back(sample.dispatches);
+            uploadBytes.push_back(static_cast<double>(sample.uploadBytes));
+            totalUploadBytes += sample.uploadBytes;
+        }
+
+        out << "{\n  \"level\":";
+        WriteJsonString(out, levelPath_);
+        out << ",\n  \"cameraPath\":";
+        WriteJsonString(out, config_.cameraPath.empty() ? std::string_view("<orbit>") : std::string_view(config_.cameraPath));
+        out << ",\n  \"backend\":";
+        WriteJsonString(out, BackendName(backend));
+        out << ",\n  \"width\":" << width
+            << ",\n  \"height\":" << height
+            << ",\n  \"fixedDeltaSeconds\":" << std::setprecision(6) << config_.fixedDeltaSeconds << std::setprecision(3)
+            << ",\n  \"loadingFrames\":" << loadingFrames_
+            << ",\n  \"levelLoaded\":" << (levelReadyAtStart_ ? "true" : "false")
+            << ",\n  \"warmupFrames\":" << config_.warmupFrames
+            << ",\n  \"measuredFrames\":" << samples_.size()
+            << ",\n  \"cpuFrameMs\":";
+        WriteSummary(out, Summarize(frameMs));
+        out << ",\n  \"draws\":";
+        WriteSummary(out, Summarize(draws));
+        out << ",\n  \"instances\":";
+        WriteSummary(out, Summarize(instances));
+        out << ",\n  \"dispatches\":";
+        WriteSummary(out, Summarize(dispatches));
+        out << ",\n  \"uploadBytes\":";
+        WriteSummary(out, Summarize(uploadBytes));
+        out << ",\n  \"uploadBytesTotal\":" << totalUploadBytes
+            << ",\n  \"cpuZones\":";
+        WriteZones(out, cpuZoneMs_);
+        out << ",\n  \"gpuZones\":";
+        WriteZones(out, gpuZoneMs_);
+
+        out << ",\n  \"frames\":[";
+        for (std::size_t i = 0; i < samples_.size(); ++i)
+        {
+            const FrameSample& sample = samples_[i];
+            out << (i == 0 ? "\n    " : ",\n    ")
+                << "{\"cpuMs\":" << sample.cpuFrameMs
+                << ",\"draws\":" << sample.draws
+                << ",\"instances\":" << sample.instances
+                << ",\"dispatches\":" << sample.dispatches
+                << ",\"uploadBytes\":" << sample.uploadBytes << "}";
+        }
+        out << (samples_.empty() ? "]" : "\n  ]") << "\n}\n";
+
+        if (!out)
+        {
+            throw std::runtime_error("Benchmark: failed writing " + path.string());
+        }
+    }
+}
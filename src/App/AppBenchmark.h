@@ -0,0 +1,81 @@
+#pragma once
+
+namespace appBenchmark
+{
+    // Headless benchmark run (--benchmark): the app loads a level without showing a window, flies a
+    // camera path at a fixed timestep, waits for the level to finish loading, runs the warm-up frames
+    // and then writes statistics of the measured frames to JSON.
+    struct BenchmarkConfig
+    {
+        bool enabled = false;
+        std::string levelPath;      // empty: the app's default level
+        std::string cameraPath;     // empty: orbit around the level's start camera target
+        std::string outputPath = "benchmark_results.json";
+        std::uint32_t warmupFrames = 120;
+        std::uint32_t measuredFrames = 600;
+        float fixedDeltaSeconds = 1.0f / 60.0f;
+
+        // Warm-up starts once the level is loaded, or after this many frames if it never is.
+        std::uint32_t maxLoadingFrames = 20000;
+    };
+
+    // --benchmark, --benchmark-level=<path>, --benchmark-camera=<path>, --benchmark-out=<path>,
+    // --benchmark-warmup=<frames>, --benchmark-frames=<frames>, --benchmark-dt=<seconds>.
+    // Any --benchmark-* option implies --benchmark.
+    BenchmarkConfig ParseBenchmarkArgs(int argc, char** argv);
+
+    // --record-camera=<path>: an interactive session saves the camera path it flew on exit, in the
+    // format --benchmark-camera reads. Empty when not given.
+    std::string ParseRecordCameraArg(int argc, char** argv);
+
+    // Orbit used when the benchmark has no recorded camera path.
+    rendern::CameraPath MakeDefaultCameraPath(const rendern::Camera& startCamera);
+
+    struct FrameSample
+    {
+        double cpuFrameMs = 0.0;
+        std::uint32_t draws = 0;
+        std::uint32_t instances = 0;
+        std::uint32_t dispatches = 0;
+        std::uint64_t uploadBytes = 0;
+    };
+
+    class BenchmarkRun
+    {
+    public:
+        BenchmarkRun(BenchmarkConfig config, rendern::CameraPath cameraPath, std::string levelPath);
+
+        const BenchmarkConfig& GetConfig() const noexcept { return config_; }
+        bool IsDone() const noexcept { return samples_.size() >= config_.measuredFrames; }
+
+        // Moves the camera to this frame's point on the path. The path clock starts when the level
+        // is loaded and loops when the path is shorter than the run.
+        void ApplyCamera(rendern::Camera& camera) const;
+
+        // Call once per frame after Profiler::EndFrame. `capture` is the frame just closed (null when
+        // the profiler is off).
+        void EndFrame(
+            bool levelReady,
+            const rhi::SubmissionStats& submission,
+            std::uint64_t uploadBytes,
+            const profiling::FrameCapture* capture);
+
+        void WriteResults(const std::filesystem::path& path, rhi::Backend backend, int width, int height) const;
+
+    private:
+        BenchmarkConfig config_{};
+        rendern::CameraPath cameraPath_{};
+        std::string levelPath_;
+
+        std::uint32_t loadingFrames_ = 0;
+        std::uint32_t pathFrames_ = 0; // frames since loading finished (warm-up + measured)
+        bool started_ = false;
+        bool levelReadyAtStart_ = false;
+
+        std::vector<FrameSample> samples_;
+        // Per measured frame, the summed duration of every zone with that name (frames where the
+        // zone did not run are not listed).
+        std::map<std::string, std::vector<double>> cpuZoneMs_;
+        std::map<std::string, std::vector<double>> gpuZoneMs_;
+    };
+}
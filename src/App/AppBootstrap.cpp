@@ -27,6 +27,67 @@ namespace appBootstrap
         return rhi::Backend::DirectX12;
     }
 
+    bool ParsePipelinedFramesFromArgs(int argc, char** argv)
+    {
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            if (std::string_view(argv[argIndex]) == "--pipelined-frames")
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool ParseLowLatencyFromArgs(int argc, char** argv)
+    {
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            if (std::string_view(argv[argIndex]) == "--low-latency")
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool ParseRawInputFromArgs(int argc, char** argv)
+    {
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            if (std::string_view(argv[argIndex]) == "--polled-input")
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    double ParseGameplayTickRateFromArgs(int argc, char** argv)
+    {
+        constexpr std::string_view prefix = "--gameplay-hz=";
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            const std::string_view argValue = argv[argIndex];
+            if (argValue.starts_with(prefix))
+            {
+                const std::string_view value = argValue.substr(prefix.size());
+                double rate = 0.0;
+                const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), rate);
+                if (error != std::errc{} || end != value.data() + value.size() || rate < 0.0)
+                {
+                    throw std::runtime_error("Bad value for --gameplay-hz: " + std::string(value));
+                }
+                return rate;
+            }
+        }
+
+        return 0.0;
+    }
+
     bool CanUseDebugWindow([[maybe_unused]] rhi::Backend backend)
     {
 #if defined(CORE_USE_DX12)
@@ -40,6 +101,7 @@ namespace appBootstrap
         int mainWidth,
         int mainHeight,
         const std::wstring& mainTitle,
+        bool showMainWindow,
         bool canUseDebugWindow,
         appWin32::Win32Window& outMainWindow
 #if defined(CORE_USE_DX12)
@@ -52,7 +114,7 @@ namespace appBootstrap
 #endif
 
         appWin32::g_mainMenu = appWin32::CreateMainMenu(canUseDebugWindow, canUseDebugWindow);
-        outMainWindow = appWin32::CreateWindowWin32(mainWidth, mainHeight, mainTitle, /*show=*/true, appWin32::g_mainMenu);
+        outMainWindow = appWin32::CreateWindowWin32(mainWidth, mainHeight, mainTitle, showMainWindow, appWin32::g_mainMenu);
         appWin32::g_window = &outMainWindow;
 
 #if defined(CORE_USE_DX12)
@@ -82,6 +144,7 @@ namespace appBootstrap
         HWND hwnd,
         int initialWidth,
         int initialHeight,
+        [[maybe_unused]] bool lowLatency,
         std::unique_ptr<rhi::IRHIDevice>& outDevice,
         std::unique_ptr<rhi::IRHISwapChain>& outSwapChain)
     {
@@ -99,6 +162,9 @@ namespace appBootstrap
             };
             swapChainDesc.base.backbufferFormat = rhi::Format::BGRA8_UNORM;
             swapChainDesc.base.vsync = false;
+            swapChainDesc.base.lowLatency = lowLatency;
+            swapChainDesc.base.maxFrameLatency = 1;
+            swapChainDesc.base.allowTearing = lowLatency;
 
             outSwapChain = rhi::CreateDX12SwapChain(*outDevice, swapChainDesc);
 #else
@@ -147,13 +213,17 @@ namespace appBootstrap
     }
 #endif
 
-    std::unique_ptr<ITextureUploader> CreateTextureUploader(rhi::Backend backend, rhi::IRHIDevice& device)
+    std::unique_ptr<ITextureUploader> CreateTextureUploader(rhi::Backend backend, rhi::IRHIDevice& device, bool gpuMipGeneration)
     {
         switch (backend)
         {
         case rhi::Backend::DirectX12:
 #if defined(CORE_USE_DX12)
-            return std::make_unique<rendern::DX12TextureUploader>(device);
+        {
+            auto uploader = std::make_unique<rendern::DX12TextureUploader>(device);
+            uploader->SetGpuMipGeneration(gpuMipGeneration);
+            return uploader;
+        }
 #else
             return std::make_unique<rendern::NullTextureUploader>(device);
 #endif
@@ -161,4 +231,175 @@ namespace appBootstrap
             return std::make_unique<rendern::NullTextureUploader>(device);
         }
     }
+
+    StartupGraph::StageId StartupGraph::AddMainStage(std::string name, std::function<void()> work, std::initializer_list<StageId> dependencies)
+    {
+        return AddStage_(std::move(name), std::move(work), dependencies, /*worker=*/false);
+    }
+
+    StartupGraph::StageId StartupGraph::AddWorkerStage(std::string name, std::function<void()> work, std::initializer_list<StageId> dependencies)
+    {
+        return AddStage_(std::move(name), std::move(work), dependencies, /*worker=*/true);
+    }
+
+    StartupGraph::StageId StartupGraph::AddStage_(std::string name, std::function<void()> work, std::initializer_list<StageId> dependencies, bool worker)
+    {
+        const StageId id = static_cast<StageId>(stages_.size());
+        for (const StageId dependency : dependencies)
+        {
+            // Only earlier stages, so the graph can't have cycles.
+            if (dependency >= id)
+            {
+                throw std::logic_error("StartupGraph: stage '" + name + "' depends on a later stage");
+            }
+        }
+        stages_.push_back(Stage{ std::move(name), std::move(work), std::vector<StageId>(dependencies), worker });
+        return id;
+    }
+
+    void StartupGraph::Run(IJobSystem& jobs)
+    {
+        using Clock = std::chrono::steady_clock;
+        enum class StageState : std::uint8_t { Waiting, Running, Done };
+
+        const Clock::time_point runStart = Clock::now();
+        const auto msSinceStart = [runStart]
+            {
+                return std::chrono::duration<double, std::milli>(Clock::now() - runStart).count();
+            };
+
+        timings_.assign(stages_.size(), StageTiming{});
+        for (std::size_t i = 0; i < stages_.size(); ++i)
+        {
+            timings_[i].name = stages_[i].name;
+            timings_[i].worker = stages_[i].worker;
+        }
+
+        std::mutex mutex;
+        std::condition_variable stageDone;
+        std::vector<StageState> states(stages_.size(), StageState::Waiting);
+        std::size_t runningWorkers = 0;
+        std::size_t finished = 0;
+        std::exception_ptr firstError;
+
+        // Runs outside the lock; each stage only writes its own timing slot.
+        const auto execute = [&](StageId id) -> std::exception_ptr
+            {
+                timings_[id].startMs = msSinceStart();
+                std::exception_ptr error;
+                try
+                {
+                    stages_[id].work();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                timings_[id].endMs = msSinceStart();
+                return error;
+            };
+
+        const auto isReady = [&](StageId id)
+            {
+                return states[id] == StageState::Waiting && std::ranges::all_of(stages_[id].dependencies,
+                    [&](StageId dependency) { return states[dependency] == StageState::Done; });
+            };
+
+        std::unique_lock lock(mutex);
+        while (finished < stages_.size() && !firstError)
+        {
+            std::vector<StageId> launch;
+            std::optional<StageId> mainStage;
+            for (StageId id = 0; id < stages_.size(); ++id)
+            {
+                if (!isReady(id))
+                {
+                    continue;
+                }
+                if (stages_[id].worker)
+                {
+                    states[id] = StageState::Running;
+                    launch.push_back(id);
+                }
+                else if (!mainStage)
+                {
+                    mainStage = id;
+                }
+            }
+            runningWorkers += launch.size();
+
+            if (!launch.empty())
+            {
+                // Unlocked: an inline job system runs the stage right here.
+                lock.unlock();
+                for (const StageId id : launch)
+                {
+                    jobs.Enqueue([&, id]
+                        {
+                            std::exception_ptr error = execute(id);
+                            std::scoped_lock stageLock(mutex);
+                            states[id] = StageState::Done;
+                            --runningWorkers;
+                            ++finished;
+                            if (error && !firstError)
+                            {
+                                firstError = std::move(error);
+                            }
+                            stageDone.notify_all();
+                        }, jobs::JobPriority::Critical, {});
+                }
+                lock.lock();
+                continue;
+            }
+
+            if (mainStage)
+            {
+                states[*mainStage] = StageState::Running;
+                lock.unlock();
+                std::exception_ptr error = execute(*mainStage);
+                lock.lock();
+                states[*mainStage] = StageState::Done;
+                ++finished;
+                if (error && !firstError)
+                {
+                    firstError = std::move(error);
+                }
+                continue;
+            }
+
+            // Nothing runnable here: wait for a worker stage to unblock something.
+            const std::size_t finishedBefore = finished;
+            stageDone.wait(lock, [&] { return finished != finishedBefore; });
+        }
+
+        // Worker stages reference this frame; let them finish even after an error.
+        stageDone.wait(lock, [&] { return runningWorkers == 0; });
+        totalMs_ = msSinceStart();
+
+        if (firstError)
+        {
+            std::rethrow_exception(firstError);
+        }
+    }
+
+    std::string StartupGraph::FormatReport() const
+    {
+        int nameWidth = 0;
+        for (const StageTiming& timing : timings_)
+        {
+            nameWidth = std::max(nameWidth, static_cast<int>(timing.name.size()));
+        }
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "Startup: %.1f ms\n", totalMs_);
+        std::string report = line;
+        for (const StageTiming& timing : timings_)
+        {
+            std::snprintf(line, sizeof(line), "  %-*s  %-6s  %8.1f -> %8.1f ms  (%.1f ms)\n",
+                nameWidth, timing.name.c_str(), timing.worker ? "worker" : "main",
+                timing.startMs, timing.endMs, timing.endMs - timing.startMs);
+            report += line;
+        }
+        return report;
+    }
 }
@@ -5,12 +5,21 @@
 namespace appBootstrap
 {
     rhi::Backend ParseBackendFromArgs(int argc, char** argv);
+    // --pipelined-frames
+    bool ParsePipelinedFramesFromArgs(int argc, char** argv);
+    // --low-latency
+    bool ParseLowLatencyFromArgs(int argc, char** argv);
+    // --gameplay-hz=<rate>; 0 when not given.
+    double ParseGameplayTickRateFromArgs(int argc, char** argv);
+    // --polled-input; true (raw input thread) when not given.
+    bool ParseRawInputFromArgs(int argc, char** argv);
     bool CanUseDebugWindow([[maybe_unused]] rhi::Backend backend);
 
     void CreatePrimaryWindowSet(
         int mainWidth,
         int mainHeight,
         const std::wstring& mainTitle,
+        bool showMainWindow,
         bool canUseDebugWindow,
         appWin32::Win32Window& outMainWindow
 #if defined(CORE_USE_DX12)
@@ -25,6 +34,7 @@ namespace appBootstrap
         HWND hwnd,
         int initialWidth,
         int initialHeight,
+        bool lowLatency,
         std::unique_ptr<rhi::IRHIDevice>& outDevice,
         std::unique_ptr<rhi::IRHISwapChain>& outSwapChain);
 
@@ -36,5 +46,49 @@ namespace appBootstrap
         std::unique_ptr<rhi::IRHISwapChain>& outDebugSwapChain);
 #endif
 
-    std::unique_ptr<ITextureUploader> CreateTextureUploader(rhi::Backend backend, rhi::IRHIDevice& device);
+    // gpuMipGeneration: see DX12TextureUploader::SetGpuMipGeneration (ignored by other uploaders).
+    std::unique_ptr<ITextureUploader> CreateTextureUploader(rhi::Backend backend, rhi::IRHIDevice& device, bool gpuMipGeneration);
+
+    // Startup as a small task graph. Worker stages go to the job system as soon as their dependencies
+    // are done; main stages (windows, device, anything not thread safe) run on the thread calling Run,
+    // in the order they were added, once theirs are. Run returns when every stage has finished and
+    // rethrows the first error; stages depending on a failed one never run.
+    class StartupGraph
+    {
+    public:
+        using StageId = std::uint32_t;
+
+        struct StageTiming
+        {
+            std::string name;
+            bool worker{ false };
+            double startMs{ 0.0 }; // since Run started
+            double endMs{ 0.0 };
+        };
+
+        StageId AddMainStage(std::string name, std::function<void()> work, std::initializer_list<StageId> dependencies = {});
+        StageId AddWorkerStage(std::string name, std::function<void()> work, std::initializer_list<StageId> dependencies = {});
+
+        void Run(IJobSystem& jobs);
+
+        std::span<const StageTiming> Timings() const noexcept { return timings_; }
+        double TotalMs() const noexcept { return totalMs_; }
+        // One line per stage in the order they were added, e.g. "  Level parse   worker    12.0 ->  140.5 ms  (128.5 ms)".
+        std::string FormatReport() const;
+
+    private:
+        struct Stage
+        {
+            std::string name;
+            std::function<void()> work;
+            std::vector<StageId> dependencies;
+            bool worker{ false };
+        };
+
+        StageId AddStage_(std::string name, std::function<void()> work, std::initializer_list<StageId> dependencies, bool worker);
+
+        std::vector<Stage> stages_;
+        std::vector<StageTiming> timings_;
+        double totalMs_{ 0.0 };
+    };
 }
@@ -38,6 +38,7 @@ namespace appLifecycle
         appEditor::ResetGizmoState(app.scene.editorRotateGizmo);
         appEditor::ResetGizmoState(app.scene.editorScaleGizmo);
         app.scene.editorParticleEmitterTranslateDrag = {};
+        appEditor::ResetObjectIdPickState(app.editorViewportInteraction);
         app.scene.EditorClearSelection();
     }
 
@@ -92,15 +93,52 @@ namespace appLifecycle
         }
     }
 
+    // Device-side end of a rendered frame, once RenderFrame has returned.
+    static void FinishRenderedFrame(AppState& app)
+    {
+        app.lastSubmissionStats = app.device->GetLastSubmissionStats();
+        appRuntime::SubmitGpuProfilerZones(*app.device);
+        app.meshMemory->EndFrame();
+        app.meshGeometry->EndFrame();
+    }
+
+    // Pipelined frames: waits for the frame in flight on the render thread, after which the main
+    // thread owns the device again.
+    static void WaitForRenderedFrame(AppState& app)
+    {
+        if (app.renderThread && app.renderThread->Wait())
+        {
+            FinishRenderedFrame(app);
+        }
+    }
+
     void InitializeApp(AppState& app, int argc, char** argv)
     {
+        profiling::SetThreadName("Main");
         app.requestedBackend = appBootstrap::ParseBackendFromArgs(argc, argv);
-        app.canUseDebugWindow = appBootstrap::CanUseDebugWindow(app.requestedBackend);
+        app.config.benchmark = appBenchmark::ParseBenchmarkArgs(argc, argv);
+        app.config.recordCameraPath = appBenchmark::ParseRecordCameraArg(argc, argv);
+        app.config.pipelinedFrames = appBootstrap::ParsePipelinedFramesFromArgs(argc, argv);
+        app.config.lowLatency = appBootstrap::ParseLowLatencyFromArgs(argc, argv);
+        app.config.gameplayTickHz = appBootstrap::ParseGameplayTickRateFromArgs(argc, argv);
+        app.config.rawInput = appBootstrap::ParseRawInputFromArgs(argc, argv);
+        const bool benchmarkMode = app.config.benchmark.enabled;
+        if (benchmarkMode && !app.config.benchmark.levelPath.empty())
+        {
+            app.config.levelPath = app.config.benchmark.levelPath;
+        }
+
+        // Benchmark runs are headless: hidden main window, no debug window / ImGui.
+        app.canUseDebugWindow = !benchmarkMode && appBootstrap::CanUseDebugWindow(app.requestedBackend);
+
+        // Shipping builds read assets from packs next to assets/; mount them before any load.
+        corefs::MountAssetPacks();
 
         appBootstrap::CreatePrimaryWindowSet(
             app.config.windowWidth,
             app.config.windowHeight,
             app.config.windowTitle,
+            /*showMainWindow=*/!benchmarkMode,
             app.canUseDebugWindow,
             app.window
 #if defined(CORE_USE_DX12)
@@ -109,54 +147,135 @@ namespace appLifecycle
         );
 
         appBootstrap::BindWin32Input(app.win32Input);
-        appBootstrap::CreateDeviceAndSwapChain(
-            app.requestedBackend,
-            app.window.hwnd,
-            app.config.windowWidth,
-            app.config.windowHeight,
-            app.device,
-            app.swapChain);
+        if (app.config.rawInput && !benchmarkMode && !app.win32Input.StartRawInputThread())
+        {
+            std::cerr << "Raw input unavailable, polling input instead\n";
+        }
 
-#if defined(CORE_USE_DX12)
-        appBootstrap::CreateDebugSwapChainIfNeeded(app.requestedBackend, *app.device, app.debugWindow, app.debugSwapChain);
-#endif
+        app.jobSystem = std::make_unique<rendern::JobSystemWorkStealing>(ComputeStreamingWorkerCount());
+        app.textureDecoder.SetJobSystem(app.jobSystem.get());
 
-        app.jobSystem = std::make_unique<rendern::JobSystemThreadPool>(ComputeStreamingWorkerCount());
+        // Device work stays on this thread; the level JSON parse and the shader compiles run on the
+        // workers next to it, and the level's texture/mesh decodes are queued before the renderer builds
+        // its pipelines so they overlap too. Everything is joined before the first frame.
+        appBootstrap::StartupGraph startup;
+        std::optional<rendern::LevelAsset> parsedLevel;
 
-        app.textureUploader = appBootstrap::CreateTextureUploader(app.device->GetBackend(), *app.device);
-        app.textureIO = std::make_unique<TextureIO>(app.textureDecoder, *app.textureUploader, *app.jobSystem, app.renderQueue);
-        app.meshIO = std::make_unique<rendern::MeshIO>(*app.device, *app.jobSystem, app.renderQueue);
-        app.assets = std::make_unique<AssetManager>(*app.textureIO, *app.meshIO);
+        const auto levelParse = startup.AddWorkerStage("Level parse", [&]
+            {
+                // The level high-water marks (debug UI memory budgets) start with the level load.
+                memory::ResetLevelMemoryPeaks();
+                parsedLevel.emplace(rendern::LoadLevelAsset(app.config.levelPath));
+            });
+
+        const auto device = startup.AddMainStage("Device", [&]
+            {
+                appBootstrap::CreateDeviceAndSwapChain(
+                    app.requestedBackend,
+                    app.window.hwnd,
+                    app.config.windowWidth,
+                    app.config.windowHeight,
+                    app.config.lowLatency,
+                    app.device,
+                    app.swapChain);
 
-        app.levelAsset = std::make_unique<rendern::LevelAsset>(rendern::LoadLevelAssetFromJson("levels/demo.level.with_fsm_test.locomotion.phaseB.json"));
+#if defined(CORE_USE_DX12)
+                appBootstrap::CreateDebugSwapChainIfNeeded(app.requestedBackend, *app.device, app.debugWindow, app.debugSwapChain);
+#endif
+            });
 
-        app.rendererSettings.drawLightGizmos = true;
-        app.rendererSettings.loadingOverlayVisible = true;
-        app.rendererSettings.loadingOverlayProgressBar = 0.0f;
-        app.renderer = std::make_unique<rendern::Renderer>(*app.device, app.rendererSettings);
+        const auto shaders = startup.AddWorkerStage("Shader compile", [&]
+            {
+                rendern::Renderer::PrecompileStartupShaders(*app.device, &app.jobSystem->GetScheduler());
+            }, { device });
 
+        const auto assetIO = startup.AddMainStage("Asset IO", [&]
+            {
+                const bool gpuTextureMips = app.config.gpuTextureMips
+                    && !app.config.textureStreaming.enabled
+                    && app.device->SupportsGenerateMips();
+                app.textureDecoder.SetCpuMipGeneration(!gpuTextureMips);
+
+                app.textureUploader = appBootstrap::CreateTextureUploader(app.device->GetBackend(), *app.device, gpuTextureMips);
+                app.fileReader = std::make_unique<corefs::AsyncFileReader>();
+                app.textureIO = std::make_unique<TextureIO>(app.textureDecoder, *app.textureUploader, *app.jobSystem, app.renderQueue);
+                app.textureIO->files = app.fileReader.get();
+                app.meshMemory = std::make_unique<renderer::PooledGPUMemoryAllocator>(*app.device);
+                app.meshGeometry = std::make_unique<rendern::GeometryPool>(*app.device);
+                app.meshIO = std::make_unique<rendern::MeshIO>(*app.device, *app.jobSystem, app.renderQueue);
+                app.meshIO->allocator = app.meshMemory.get();
+                app.meshIO->geometry = app.meshGeometry.get();
+                app.assets = std::make_unique<AssetManager>(*app.textureIO, *app.meshIO);
+                app.assets->SetTextureStreaming(app.config.textureStreaming);
+            }, { device });
+
+        startup.AddMainStage("ImGui", [&]
+            {
 #if defined(CORE_USE_DX12)
-        if (app.requestedBackend == rhi::Backend::DirectX12 && app.debugSwapChain && app.debugWindow.hwnd)
-        {
-            appUi::InitializeImGui(app.debugWindow.hwnd, *app.device, app.debugSwapChain->GetDesc().backbufferFormat, /*backbufferCount=*/2);
-        }
+                if (app.requestedBackend == rhi::Backend::DirectX12 && app.debugSwapChain && app.debugWindow.hwnd)
+                {
+                    appUi::InitializeImGui(app.debugWindow.hwnd, *app.device, app.debugSwapChain->GetDesc().backbufferFormat, /*backbufferCount=*/2);
+                }
 #endif
+            }, { device });
 
-        app.scene.Clear();
-        app.bindless = std::make_unique<rendern::BindlessTable>(*app.device);
-        app.levelInstance = std::make_unique<rendern::LevelInstance>(rendern::InstantiateLevel(
-            app.scene,
-            *app.assets,
-            *app.bindless,
-            *app.levelAsset,
-            mathUtils::Mat4(1.0f)));
+        // Instantiating queues the level's decodes (skybox and material textures, meshes) on the workers.
+        const auto levelPrefetch = startup.AddMainStage("Level prefetch", [&]
+            {
+                app.levelAsset = std::make_unique<rendern::LevelAsset>(std::move(*parsedLevel));
+                app.scene.Clear();
+                app.bindless = std::make_unique<rendern::BindlessTable>(*app.device);
+                app.levelInstance = std::make_unique<rendern::LevelInstance>(rendern::InstantiateLevel(
+                    app.scene,
+                    *app.assets,
+                    *app.bindless,
+                    *app.levelAsset,
+                    mathUtils::Mat4(1.0f)));
+            }, { assetIO, levelParse });
+
+        startup.AddMainStage("Renderer", [&]
+            {
+                app.rendererSettings.drawLightGizmos = !benchmarkMode;
+                app.rendererSettings.loadingOverlayVisible = !benchmarkMode;
+                app.rendererSettings.loadingOverlayProgressBar = 0.0f;
+                app.renderer = std::make_unique<rendern::Renderer>(*app.device, app.rendererSettings, &app.jobSystem->GetScheduler());
+                app.renderer->SetMeshAllocator(app.meshMemory.get());
+                if (app.config.pipelinedFrames && app.device->GetBackend() != rhi::Backend::OpenGL)
+                {
+                    app.renderThread = std::make_unique<appRuntime::RenderThread>();
+                }
+
+                ResidencySettings residency = app.config.residency;
+                residency.enabled = residency.enabled && app.renderer->SupportsResidencyFeedback();
+                app.assets->SetResidency(residency);
+            }, { shaders, levelPrefetch });
+
+        startup.AddMainStage("Gameplay", [&]
+            {
+                app.gameplayRuntime = std::make_unique<rendern::GameplayRuntime>();
+                app.gameplayRuntime->Initialize(*app.levelAsset, *app.levelInstance, app.scene);
+                app.gameplayRuntime->SetFixedStep(app.config.gameplayTickHz, app.config.gameplayMaxCatchupTicks);
+            }, { levelPrefetch });
 
-        app.gameplayRuntime = std::make_unique<rendern::GameplayRuntime>();
-        app.gameplayRuntime->Initialize(*app.levelAsset, *app.levelInstance, app.scene);
+        startup.Run(*app.jobSystem);
+        std::cout << startup.FormatReport();
 
         app.cameraController = std::make_unique<rendern::CameraController>();
         app.cameraController->ResetFromCamera(app.scene.camera);
 
+        if (benchmarkMode)
+        {
+            rendern::CameraPath cameraPath = app.config.benchmark.cameraPath.empty()
+                ? appBenchmark::MakeDefaultCameraPath(app.scene.camera)
+                : rendern::LoadCameraPath(app.config.benchmark.cameraPath);
+            app.benchmark = std::make_unique<appBenchmark::BenchmarkRun>(app.config.benchmark, std::move(cameraPath), app.config.levelPath);
+            profiling::Profiler::Get().SetEnabled(true);
+        }
+        else if (!app.config.recordCameraPath.empty())
+        {
+            app.cameraRecorder = std::make_unique<rendern::CameraPathRecorder>();
+        }
+
         app.gameplayMode = rendern::GameplayRuntimeMode::Editor;
 
         app.frameTimer.SetMaxDelta(0.05);
@@ -166,12 +285,31 @@ namespace appLifecycle
 
     bool TickApp(AppState& app)
     {
+        // Low latency: block until the swap chain can queue this frame before messages and input are read,
+        // so the frame reacts to the newest input.
+        if (app.config.lowLatency)
+        {
+            app.swapChain->WaitForNextFrame();
+        }
+
         appWin32::PumpMessages(app.window);
         if (!app.window.running)
         {
             return false;
         }
 
+        // Pipelined frames: the previous frame may still be rendering from app.renderSnapshot while
+        // this one simulates on app.scene. Resizing a swap chain needs it done.
+        const bool pipelined = app.renderThread != nullptr;
+        if (pipelined && (app.window.pendingResize
+#if defined(CORE_USE_DX12)
+            || app.debugWindow.pendingResize
+#endif
+            || appRuntime::ShouldSkipMainViewportFrame(app.window)))
+        {
+            WaitForRenderedFrame(app);
+        }
+
         appRuntime::ApplyPendingResize(app.window, app.swapChain.get());
 #if defined(CORE_USE_DX12)
         appRuntime::ApplyPendingResize(app.debugWindow, app.debugSwapChain.get());
@@ -183,13 +321,21 @@ namespace appLifecycle
             return true;
         }
 
-        appRuntime::DriveAssetStreaming(*app.assets, *app.levelInstance, *app.bindless, app.scene, app.config.uploadBudget);
+        profiling::Profiler::Get().BeginFrame();
+        if (!pipelined)
+        {
+            appRuntime::DriveAssetStreaming(*app.assets, *app.levelAsset, *app.levelInstance, *app.bindless, app.scene, app.config.uploadBudget, static_cast<float>(app.window.height), app.renderer->GetDrawnMaterials());
+        }
 
         app.frameTimer.Tick();
-        const float deltaSeconds = static_cast<float>(app.frameTimer.GetDeltaTime());
+        const float deltaSeconds = app.benchmark
+            ? app.config.benchmark.fixedDeltaSeconds
+            : static_cast<float>(app.frameTimer.GetDeltaTime());
 
+        // The overlay covers the level's own loads; mip streaming and residency reloads that
+        // follow are not loading time.
         const AssetStreamingStats streamingStats = app.assets->GetStreamingStats();
-        const bool hasPendingStreaming = streamingStats.HasPendingWork();
+        const bool hasPendingStreaming = !app.levelInstance->IsReady();
         const float targetProgress01 = streamingStats.Completion01();
 
         auto& overlay = app.loadingOverlay;
@@ -211,7 +357,7 @@ namespace appLifecycle
             }
         }
 
-        app.rendererSettings.loadingOverlayVisible = overlay.visible;
+        app.rendererSettings.loadingOverlayVisible = overlay.visible && !app.benchmark;
         app.rendererSettings.loadingOverlayProgressBar = overlay.visible
             ? std::clamp(overlay.displayProgressBar, hasPendingStreaming ? 0.02f : 1.0f, 1.0f)
             : 0.0f;
@@ -221,15 +367,27 @@ namespace appLifecycle
 
         app.win32Input.SetCaptureMode(appUi::GetInputCaptureForImGui());
         app.win32Input.NewFrame(app.window.hwnd);
+        app.scene.inputSampleTime = std::chrono::steady_clock::now();
 
-        if (app.win32Input.State().KeyPressed(VK_F5))
+        if (!app.benchmark && app.win32Input.State().KeyPressed(VK_F5))
         {
             app.gameplayMode = (app.gameplayMode == rendern::GameplayRuntimeMode::Editor)
                 ? rendern::GameplayRuntimeMode::Game
                 : rendern::GameplayRuntimeMode::Editor;
         }
 
-        if (app.gameplayMode == rendern::GameplayRuntimeMode::Game)
+        // Only game and benchmark frames overlap the frame in flight: editor picking and level
+        // edits may load assets and write descriptors.
+        if (pipelined && !app.benchmark && app.gameplayMode == rendern::GameplayRuntimeMode::Editor)
+        {
+            WaitForRenderedFrame(app);
+        }
+
+        if (app.benchmark)
+        {
+            app.benchmark->ApplyCamera(app.scene.camera);
+        }
+        else if (app.gameplayMode == rendern::GameplayRuntimeMode::Game)
         {
             ResetEditorInteractionState(app);
         }
@@ -239,11 +397,12 @@ namespace appLifecycle
             appEditor::ApplyGizmoModeHotkeys(app.editorViewportInteraction, app.scene, app.win32Input.State());
             appEditor::SyncEditorGizmoVisuals(app.editorViewportInteraction, *app.levelAsset, *app.levelInstance, app.scene);
             appEditor::UpdateViewportGizmoHover(app.editorViewportInteraction, app.window.hwnd, app.window.width, app.window.height, app.scene, app.win32Input.State());
-            appEditor::HandleViewportMouseInteraction(app.editorViewportInteraction, app.window.hwnd, app.window.width, app.window.height, *app.levelAsset, *app.levelInstance, app.scene, app.win32Input.State());
+            appEditor::HandleViewportMouseInteraction(app.editorViewportInteraction, app.window.hwnd, app.window.width, app.window.height, *app.levelAsset, *app.levelInstance, app.scene, *app.renderer, app.win32Input.State());
         }
 
         if (app.gameplayRuntime)
         {
+            profiling::ScopedZone zone{ "Gameplay::PreAnimation" };
             rendern::GameplayUpdateContext gameplayCtx{};
             gameplayCtx.deltaSeconds = deltaSeconds;
             gameplayCtx.mode = app.gameplayMode;
@@ -251,15 +410,23 @@ namespace appLifecycle
             gameplayCtx.levelAsset = app.levelAsset.get();
             gameplayCtx.levelInstance = app.levelInstance.get();
             gameplayCtx.scene = &app.scene;
+            gameplayCtx.scheduler = &app.jobSystem->GetScheduler();
 
-            app.gameplayRuntime->BeginFrame();
-            app.gameplayRuntime->PreAnimationUpdate(gameplayCtx);
+            app.gameplayRuntime->UpdateSimulation(gameplayCtx);
         }
 
-        app.scene.UpdateSkinned(deltaSeconds);
+        if (app.window.width > 0 && app.window.height > 0)
+        {
+            app.scene.viewAspect = static_cast<float>(app.window.width) / static_cast<float>(app.window.height);
+        }
+        {
+            profiling::ScopedZone zone{ "Scene::UpdateSkinned" };
+            app.scene.UpdateSkinned(deltaSeconds, &app.jobSystem->GetScheduler());
+        }
 
         if (app.gameplayRuntime)
         {
+            profiling::ScopedZone zone{ "Gameplay::PostAnimation" };
             rendern::GameplayUpdateContext gameplayCtx{};
             gameplayCtx.deltaSeconds = deltaSeconds;
             gameplayCtx.mode = app.gameplayMode;
@@ -267,24 +434,46 @@ namespace appLifecycle
             gameplayCtx.levelAsset = app.levelAsset.get();
             gameplayCtx.levelInstance = app.levelInstance.get();
             gameplayCtx.scene = &app.scene;
+            gameplayCtx.scheduler = &app.jobSystem->GetScheduler();
             app.gameplayRuntime->PostAnimationUpdate(gameplayCtx);
         }
 
         UpdateGameplayMovementDebug(app);
-        app.scene.UpdateParticles(deltaSeconds);
+        app.scene.simulateParticlesOnGpu = app.rendererSettings.enableGpuParticles && app.device->SupportsCompute();
+        {
+            profiling::ScopedZone zone{ "Scene::UpdateParticles" };
+            app.scene.UpdateParticles(deltaSeconds, &app.jobSystem->GetScheduler());
+        }
+
+        if (pipelined)
+        {
+            // Everything from here on touches the device or the renderer.
+            WaitForRenderedFrame(app);
+            appRuntime::DriveAssetStreaming(*app.assets, *app.levelAsset, *app.levelInstance, *app.bindless, app.scene, app.config.uploadBudget, static_cast<float>(app.window.height), app.renderer->GetDrawnMaterials());
+        }
 
         const void* imguiDrawData = appUi::BuildImGuiFrameIfEnabled(
             *app.device,
             app.rendererSettings,
+            app.renderer->GetFrameStats(),
             app.scene,
             *app.cameraController,
             *app.levelAsset,
             *app.levelInstance,
             *app.assets,
+            app.jobSystem->GetScheduler(),
             app.gameplayMode);
 
+        if (app.cameraRecorder)
+        {
+            app.cameraRecorder->Record(deltaSeconds, app.scene.camera);
+        }
+
         app.renderer->SetSettings(app.rendererSettings);
-        app.renderer->RenderFrame(*app.swapChain, app.scene, /*imguiDrawData=*/nullptr);
+        if (!pipelined)
+        {
+            app.renderer->RenderFrame(*app.swapChain, app.scene, /*imguiDrawData=*/nullptr);
+        }
 
 #if defined(CORE_USE_DX12)
         if (appRuntime::CanRenderDebugSwapChain(app.debugWindow, app.debugSwapChain.get()))
@@ -293,6 +482,38 @@ namespace appLifecycle
         }
 #endif
 
+        if (pipelined)
+        {
+            {
+                profiling::ScopedZone zone{ "Frame::RenderSnapshot" };
+                app.renderSnapshot = app.scene; // copy-assignment reuses the snapshot's storage
+            }
+            app.renderThread->Kick(*app.renderer, *app.swapChain, app.renderSnapshot);
+        }
+        else
+        {
+            FinishRenderedFrame(app);
+        }
+        profiling::Profiler::Get().EndFrame();
+
+        if (app.benchmark)
+        {
+            const std::deque<profiling::FrameCapture>& history = profiling::Profiler::Get().GetHistory();
+            app.benchmark->EndFrame(
+                app.levelInstance->IsReady(),
+                app.lastSubmissionStats,
+                app.assets->GetStreamingStats().total.lastUploadBytes,
+                history.empty() ? nullptr : &history.back());
+            if (app.benchmark->IsDone())
+            {
+                app.benchmark->WriteResults(app.config.benchmark.outputPath, app.device->GetBackend(), app.window.width, app.window.height);
+                return false;
+            }
+
+            // Benchmark frames run back to back.
+            return true;
+        }
+
         appWin32::TinySleep();
         return true;
     }
@@ -304,6 +525,20 @@ namespace appLifecycle
             return;
         }
 
+        if (app.renderThread)
+        {
+            WaitForRenderedFrame(app);
+            app.renderThread.reset();
+            app.renderSnapshot = {};
+        }
+
+        app.win32Input.StopRawInputThread();
+
+        if (app.cameraRecorder && !app.cameraRecorder->GetPath().Empty())
+        {
+            rendern::SaveCameraPath(app.config.recordCameraPath, app.cameraRecorder->GetPath());
+        }
+
         appRuntime::ShutdownRuntime(
             *app.device,
             *app.renderer,
@@ -328,11 +563,17 @@ namespace appLifecycle
         app.levelAsset.reset();
         app.assets.reset();
         app.meshIO.reset();
+        app.meshGeometry.reset();
+        app.meshMemory.reset();
+        app.fileReader.reset();
         app.textureIO.reset();
         app.textureUploader.reset();
+        app.textureDecoder.SetJobSystem(nullptr);
         app.jobSystem.reset();
         app.device.reset();
         app.cameraController.reset();
+        app.cameraRecorder.reset();
+        app.benchmark.reset();
         app.initialized = false;
     }
 }
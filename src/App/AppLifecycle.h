@@ -5,6 +5,8 @@
 #include "EditorViewportInteraction.h"
 #include "AppRuntimeHelpers.h"
 #include "AppBootstrap.h"
+#include "AppBenchmark.h"
+#include "AppRenderThread.h"
 
 namespace appLifecycle
 {
@@ -21,6 +23,26 @@ namespace appLifecycle
         int windowHeight = 1024;
         std::wstring windowTitle = L"CoreEngineModule (DX12)";
         appRuntime::UploadBudget uploadBudget{};
+        TextureStreamingSettings textureStreaming{ .enabled = true };
+        ResidencySettings residency{ .enabled = true };
+        // Build runtime texture mips with the GPU GenerateMips pass instead of on the decode
+        // workers. Only honoured with streaming off: streamed mip tails come from the CPU chain.
+        bool gpuTextureMips = false;
+        std::string levelPath = "levels/demo.level.with_fsm_test.locomotion.phaseB.json";
+        appBenchmark::BenchmarkConfig benchmark{};
+        std::string recordCameraPath; // --record-camera: saved on shutdown
+        // --pipelined-frames: render frame N on a render thread while frame N+1 is simulated.
+        // Editor frames still run serially (see TickApp); OpenGL contexts are thread-bound, so
+        // that backend ignores it.
+        bool pipelinedFrames = false;
+        // --low-latency: waitable swap chain with one queued frame, waited on before input is sampled;
+        // presents without vsync may tear (VRR).
+        bool lowLatency = false;
+        // --gameplay-hz=<rate>: gameplay ticks at a fixed rate, rendered interpolated (0 = once per frame).
+        double gameplayTickHz = 0.0;
+        int gameplayMaxCatchupTicks = 4;
+        // --polled-input: sample input by polling at frame start instead of on the raw input thread.
+        bool rawInput = true;
     };
 
 
@@ -43,10 +65,13 @@ namespace appLifecycle
 #endif
 
         StbTextureDecoder textureDecoder{};
-        std::unique_ptr<rendern::JobSystemThreadPool> jobSystem;
+        std::unique_ptr<rendern::JobSystemWorkStealing> jobSystem;
         rendern::RenderQueueImmediate renderQueue{};
+        std::unique_ptr<corefs::AsyncFileReader> fileReader;
         std::unique_ptr<ITextureUploader> textureUploader;
         std::unique_ptr<TextureIO> textureIO;
+        std::unique_ptr<renderer::PooledGPUMemoryAllocator> meshMemory;
+        std::unique_ptr<rendern::GeometryPool> meshGeometry;
         std::unique_ptr<rendern::MeshIO> meshIO;
         std::unique_ptr<AssetManager> assets;
 
@@ -54,6 +79,10 @@ namespace appLifecycle
         rendern::RendererSettings rendererSettings{};
         std::unique_ptr<rendern::Renderer> renderer;
         rendern::Scene scene{};
+        // Pipelined frames: copy of `scene` the render thread draws while `scene` simulates on.
+        rendern::Scene renderSnapshot{};
+        std::unique_ptr<appRuntime::RenderThread> renderThread;
+        rhi::SubmissionStats lastSubmissionStats{}; // of the last frame that finished rendering
         std::unique_ptr<rendern::BindlessTable> bindless;
         std::unique_ptr<rendern::LevelInstance> levelInstance;
         std::unique_ptr<rendern::GameplayRuntime> gameplayRuntime;
@@ -62,6 +91,8 @@ namespace appLifecycle
         rendern::GameplayRuntimeMode gameplayMode{ rendern::GameplayRuntimeMode::Editor };
         GameTimer frameTimer{};
         LoadingOverlayState loadingOverlay{};
+        std::unique_ptr<appBenchmark::BenchmarkRun> benchmark;
+        std::unique_ptr<rendern::CameraPathRecorder> cameraRecorder;
 
         bool initialized = false;
     };
@@ -0,0 +1,101 @@
+import core;
+import std;
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include "AppRenderThread.h"
+
+namespace appRuntime
+{
+    RenderThread::RenderThread()
+        : thread_([this] { ThreadMain_(); })
+    {
+    }
+
+    RenderThread::~RenderThread()
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    void RenderThread::Kick(rendern::Renderer& renderer, rhi::IRHISwapChain& swapChain, const rendern::Scene& scene)
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            renderer_ = &renderer;
+            swapChain_ = &swapChain;
+            scene_ = &scene;
+            kicked_ = true;
+            busy_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    bool RenderThread::Wait()
+    {
+        profiling::ScopedZone zone{ "RenderThread::Wait" };
+
+        std::exception_ptr error;
+        {
+            std::unique_lock lock(mutex_);
+            if (!kicked_)
+            {
+                return false;
+            }
+            cv_.wait(lock, [this] { return !busy_; });
+            kicked_ = false;
+            error = std::exchange(error_, nullptr);
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        return true;
+    }
+
+    void RenderThread::ThreadMain_()
+    {
+        profiling::SetThreadName("Render");
+
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            cv_.wait(lock, [this] { return stop_ || scene_ != nullptr; });
+            if (stop_)
+            {
+                return;
+            }
+
+            rendern::Renderer* renderer = std::exchange(renderer_, nullptr);
+            rhi::IRHISwapChain* swapChain = std::exchange(swapChain_, nullptr);
+            const rendern::Scene* scene = std::exchange(scene_, nullptr);
+            lock.unlock();
+
+            std::exception_ptr error;
+            try
+            {
+                profiling::ScopedZone zone{ "RenderThread::RenderFrame" };
+                renderer->RenderFrame(*swapChain, *scene, /*imguiDrawData=*/nullptr);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            error_ = error;
+            busy_ = false;
+            cv_.notify_all();
+        }
+    }
+}
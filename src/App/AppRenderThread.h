@@ -0,0 +1,39 @@
+#pragma once
+
+namespace appRuntime
+{
+    // Pipelined frames (--pipelined-frames): records and presents one frame on a dedicated thread
+    // while the main thread simulates the next one. Only Renderer::RenderFrame runs here; every
+    // other use of the device stays on the main thread and waits for the frame in flight first.
+    class RenderThread
+    {
+    public:
+        RenderThread();
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        // Starts rendering `scene`; the previous frame must have been waited for. The renderer,
+        // swap chain and scene must stay untouched until Wait returns.
+        void Kick(rendern::Renderer& renderer, rhi::IRHISwapChain& swapChain, const rendern::Scene& scene);
+
+        // Blocks until the kicked frame was submitted and presented; false when none was in flight.
+        // Rethrows what RenderFrame threw.
+        bool Wait();
+
+    private:
+        void ThreadMain_();
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        rendern::Renderer* renderer_{ nullptr };
+        rhi::IRHISwapChain* swapChain_{ nullptr };
+        const rendern::Scene* scene_{ nullptr };
+        bool kicked_{ false }; // kicked and not waited for yet
+        bool busy_{ false };
+        bool stop_{ false };
+        std::exception_ptr error_{};
+        std::thread thread_;
+    };
+}
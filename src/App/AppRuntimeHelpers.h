@@ -11,6 +11,11 @@ namespace appRuntime
         int maxMeshUploadsPerFrame = 32;
         int maxTextureDeletesPerFrame = 2;
         int maxMeshDeletesPerFrame = 32;
+
+        // Shared texture+mesh upload budget per frame (0 = off). The time budget is checked
+        // against a cost estimate that calibrates itself from measured uploads.
+        std::uint64_t maxUploadBytesPerFrame = 0;
+        std::uint32_t maxUploadMicrosecondsPerFrame = 4000;
     };
 
     inline void ApplyPendingResize(appWin32::Win32Window& window, rhi::IRHISwapChain* swapChain)
@@ -39,12 +44,28 @@ namespace appRuntime
 
     inline void DriveAssetStreaming(
         AssetManager& assets,
+        const rendern::LevelAsset& levelAsset,
         rendern::LevelInstance& levelInstance,
         rendern::BindlessTable& bindless,
         rendern::Scene& scene,
-        const UploadBudget& budget)
+        const UploadBudget& budget,
+        float viewportHeightPixels,
+        std::span<const rendern::MaterialHandle> drawnMaterials)
     {
+        profiling::ScopedZone zone{ "DriveAssetStreaming" };
+
+        // Screen-size feedback from the last submitted scene decides which mips get streamed,
+        // what the renderer drew keeps textures resident.
+        levelInstance.ReportTextureStreamingFeedback(assets, scene, viewportHeightPixels);
+        levelInstance.MarkTexturesUsed(assets, drawnMaterials, scene);
+
+        // Streaming cells request their loads before this frame's uploads are processed.
+        levelInstance.UpdateCellStreaming(levelAsset, scene, assets, scene.camera.position);
+
         assets.ProcessUploads(
+            StreamingUploadBudget{
+                .maxBytes = budget.maxUploadBytesPerFrame,
+                .maxMicroseconds = budget.maxUploadMicrosecondsPerFrame },
             budget.maxTextureUploadsPerFrame,
             budget.maxTextureDeletesPerFrame,
             budget.maxMeshUploadsPerFrame,
@@ -53,6 +74,25 @@ namespace appRuntime
         levelInstance.ResolveTextureBindings(assets, bindless, scene);
     }
 
+    // Hands the device's latest resolved timestamp zones to the profiler for this frame.
+    inline void SubmitGpuProfilerZones(const rhi::IRHIDevice& device)
+    {
+        profiling::Profiler& profiler = profiling::Profiler::Get();
+        if (!profiler.IsEnabled() || !device.SupportsTimestampQueries())
+        {
+            return;
+        }
+
+        std::vector<profiling::GpuZone> zones;
+        const std::span<const rhi::GpuTimestampZone> gpuZones = device.GetLastGpuTimestampZones();
+        zones.reserve(gpuZones.size());
+        for (const rhi::GpuTimestampZone& zone : gpuZones)
+        {
+            zones.push_back(profiling::GpuZone{ zone.name, zone.beginMs, zone.endMs, zone.depth });
+        }
+        profiler.SubmitGpuZones(std::move(zones));
+    }
+
     inline bool CanRenderDebugSwapChain(const appWin32::Win32Window& debugWindow, const rhi::IRHISwapChain* debugSwapChain)
     {
         return debugSwapChain
@@ -67,7 +107,7 @@ namespace appRuntime
         rendern::Renderer& renderer,
         rendern::LevelInstance& levelInstance,
         rendern::BindlessTable& bindless,
-        rendern::JobSystemThreadPool& jobSystem,
+        IJobSystem& jobSystem,
         AssetManager& assets,
         appWin32::Win32Window& mainWindow
 #if defined(CORE_USE_DX12)
@@ -82,6 +122,7 @@ namespace appRuntime
         renderer.Shutdown();
         levelInstance.FreeDescriptors(bindless);
 
+        assets.CancelPendingLoads();
         jobSystem.WaitIdle();
         assets.ClearAll();
         assets.ProcessUploads(64, 256, 64, 256);
@@ -48,11 +48,13 @@ namespace appUi
     const void* BuildImGuiFrameIfEnabled(
         rhi::IRHIDevice& device,
         rendern::RendererSettings& settings,
+        const rendern::RendererFrameStats& frameStats,
         rendern::Scene& scene,
         rendern::CameraController& cameraController,
         rendern::LevelAsset& levelAsset,
         rendern::LevelInstance& levelInstance,
         AssetManager& assets,
+        jobs::Scheduler& jobScheduler,
         rendern::GameplayRuntimeMode& runtimeMode)
     {
         if (!appWin32::g_imguiInitialized || !appWin32::g_showDebugWindow || !appWin32::g_debugWindow || !appWin32::g_debugWindow->hwnd)
@@ -70,7 +72,7 @@ namespace appUi
         ImGui::NewFrame();
 
         rendern::ui::BeginDebugDockSpace();
-        rendern::ui::DrawRendererDebugUI(settings, scene, cameraController);
+        rendern::ui::DrawRendererDebugUI(settings, frameStats, scene, cameraController);
 
         ImGui::Begin("App Runtime");
         const bool inGameMode = runtimeMode == rendern::GameplayRuntimeMode::Game;
@@ -83,7 +85,7 @@ namespace appUi
 
         if (runtimeMode == rendern::GameplayRuntimeMode::Editor)
         {
-            rendern::ui::DrawLevelEditorUI(levelAsset, levelInstance, assets, scene, cameraController);
+            rendern::ui::DrawLevelEditorUI(levelAsset, levelInstance, assets, jobScheduler, scene, cameraController);
         }
         else
         {
@@ -155,11 +157,13 @@ namespace appUi
     const void* BuildImGuiFrameIfEnabled(
         rhi::IRHIDevice&,
         rendern::RendererSettings&,
+        const rendern::RendererFrameStats&,
         rendern::Scene&,
         rendern::CameraController&,
         rendern::LevelAsset&,
         rendern::LevelInstance&,
         AssetManager&,
+        jobs::Scheduler&,
         rendern::GameplayRuntimeMode&)
     {
         return nullptr;
@@ -10,11 +10,13 @@ namespace appUi
     const void* BuildImGuiFrameIfEnabled(
         rhi::IRHIDevice& device,
         rendern::RendererSettings& settings,
+        const rendern::RendererFrameStats& frameStats,
         rendern::Scene& scene,
         rendern::CameraController& cameraController,
         rendern::LevelAsset& levelAsset,
         rendern::LevelInstance& levelInstance,
         AssetManager& assets,
+        jobs::Scheduler& jobScheduler,
         rendern::GameplayRuntimeMode& runtimeMode);
 
     rendern::InputCapture GetInputCaptureForImGui();
@@ -123,13 +123,41 @@ namespace appEditor
         scene.editorTranslateGizmo.activeAxis = rendern::GizmoAxis::None;
     }
 
+    // A GPU object-ID pick waiting for its readback (requestId == 0: none).
+    struct PendingObjectIdPick
+    {
+        std::uint64_t requestId{ 0 };
+        bool ctrlDown{ false };
+        bool marquee{ false };
+        float mouseX{ 0.0f };
+        float mouseY{ 0.0f };
+        float viewportWidth{ 0.0f };
+        float viewportHeight{ 0.0f };
+    };
+
     struct EditorViewportInteraction
     {
         rendern::TranslateGizmoController translateGizmo{};
         rendern::RotateGizmoController rotateGizmo{};
         rendern::ScaleGizmoController scaleGizmo{};
+
+        PendingObjectIdPick pendingPick{};
+
+        // Marquee selection (object-ID picking only): armed on an unconsumed LMB press,
+        // active once the cursor moved far enough away from the press point.
+        bool marqueeArmed{ false };
+        bool marqueeActive{ false };
+        int marqueeStartX{ 0 };
+        int marqueeStartY{ 0 };
     };
 
+    inline void ResetObjectIdPickState(EditorViewportInteraction& interaction)
+    {
+        interaction.pendingPick = {};
+        interaction.marqueeArmed = false;
+        interaction.marqueeActive = false;
+    }
+
     template <typename TGizmoState>
     inline void ResetGizmoState(TGizmoState& gizmo)
     {
@@ -352,12 +380,142 @@ namespace appEditor
     {
         if (!HasLightSelection(scene))
         {
-            levelInstance.MarkTransformsDirty();
+            // Gizmos only move selected nodes; their subtrees are all that needs recomputing.
+            levelInstance.MarkNodeTransformDirty(scene.editorSelectedNode);
+            for (const int nodeIndex : scene.editorSelectedNodes)
+            {
+                levelInstance.MarkNodeTransformDirty(nodeIndex);
+            }
             levelInstance.SyncTransformsIfDirty(levelAsset, scene);
         }
         SyncCurrentGizmoVisual(interaction, levelAsset, levelInstance, scene);
     }
 
+    inline void ApplyViewportPick(
+        rendern::LevelAsset& levelAsset,
+        rendern::LevelInstance& levelInstance,
+        rendern::Scene& scene,
+        const rendern::PickResult& pick,
+        bool ctrlDown)
+    {
+        scene.debugPickRay.enabled = true;
+        scene.debugPickRay.origin = pick.rayOrigin;
+        scene.debugPickRay.direction = pick.rayDir;
+        scene.debugPickRay.hit = ((pick.nodeIndex >= 0) || (pick.particleEmitterIndex >= 0) || (pick.lightIndex >= 0)) && std::isfinite(pick.t);
+        scene.debugPickRay.length = scene.debugPickRay.hit ? pick.t : scene.camera.farZ;
+
+        if (scene.debugPickRay.hit && levelInstance.IsNodeAlive(levelAsset, pick.nodeIndex))
+        {
+            if (ctrlDown)
+            {
+                scene.EditorToggleSelectionNode(pick.nodeIndex);
+            }
+            else
+            {
+                scene.EditorSetSelectionSingle(pick.nodeIndex);
+            }
+        }
+        else if (scene.debugPickRay.hit && levelInstance.IsValidParticleEmitterIndex(pick.particleEmitterIndex))
+        {
+            if (ctrlDown)
+            {
+                scene.EditorToggleSelectionParticleEmitter(pick.particleEmitterIndex);
+            }
+            else
+            {
+                scene.EditorSetSelectionSingleParticleEmitter(pick.particleEmitterIndex);
+            }
+        }
+        else if (scene.debugPickRay.hit && pick.lightIndex >= 0)
+        {
+            if (ctrlDown)
+            {
+                scene.EditorToggleSelectionLight(pick.lightIndex);
+            }
+            else
+            {
+                scene.EditorSetLightSelectionSingle(pick.lightIndex);
+            }
+        }
+        else
+        {
+            // Click on empty space: clear selection only when Ctrl is not pressed.
+            if (!ctrlDown)
+            {
+                scene.EditorClearSelection();
+            }
+        }
+    }
+
+    // Marquee result: every alive node with a pixel in the rect. Ctrl adds to the selection.
+    inline void ApplyViewportMarqueePick(
+        rendern::LevelAsset& levelAsset,
+        rendern::LevelInstance& levelInstance,
+        rendern::Scene& scene,
+        const rendern::ObjectIdPickResult& result,
+        bool ctrlDown)
+    {
+        if (!ctrlDown)
+        {
+            scene.EditorClearSelection();
+        }
+
+        std::uint32_t lastId = rendern::kObjectIdNone;
+        for (const std::uint32_t objectId : result.ids)
+        {
+            if (objectId == rendern::kObjectIdNone || objectId == lastId)
+            {
+                continue;
+            }
+            lastId = objectId;
+
+            const int nodeIndex = rendern::NodeIndexFromObjectId(levelInstance, objectId);
+            if (!levelInstance.IsNodeAlive(levelAsset, nodeIndex) || scene.EditorIsNodeSelected(nodeIndex))
+            {
+                continue;
+            }
+            scene.EditorToggleSelectionNode(nodeIndex);
+        }
+    }
+
+    // Applies finished object-ID picks. Results of requests that were superseded or reset are dropped.
+    inline void ResolveObjectIdPicks(
+        EditorViewportInteraction& interaction,
+        rendern::Renderer& renderer,
+        rendern::LevelAsset& levelAsset,
+        rendern::LevelInstance& levelInstance,
+        rendern::Scene& scene)
+    {
+        rendern::ObjectIdPickResult result{};
+        while (renderer.TakeObjectIdPick(result))
+        {
+            const PendingObjectIdPick& pending = interaction.pendingPick;
+            if (pending.requestId == 0 || result.requestId != pending.requestId)
+            {
+                continue;
+            }
+
+            if (pending.marquee)
+            {
+                ApplyViewportMarqueePick(levelAsset, levelInstance, scene, result, pending.ctrlDown);
+            }
+            else
+            {
+                const std::uint32_t objectId = result.ids.empty() ? rendern::kObjectIdNone : result.ids.front();
+                const rendern::PickResult pick = rendern::PickEditorObjectWithObjectId(
+                    scene,
+                    levelInstance,
+                    objectId,
+                    pending.mouseX,
+                    pending.mouseY,
+                    pending.viewportWidth,
+                    pending.viewportHeight);
+                ApplyViewportPick(levelAsset, levelInstance, scene, pick, pending.ctrlDown);
+            }
+            interaction.pendingPick = {};
+        }
+    }
+
     inline void HandleViewportMouseInteraction(
         EditorViewportInteraction& interaction,
         HWND hwnd,
@@ -366,13 +524,18 @@ namespace appEditor
         rendern::LevelAsset& levelAsset,
         rendern::LevelInstance& levelInstance,
         rendern::Scene& scene,
+        rendern::Renderer& renderer,
         const rendern::InputState& input)
     {
+        ResolveObjectIdPicks(interaction, renderer, levelAsset, levelInstance, scene);
+
         if (!input.hasFocus || input.mouse.rmbDown || input.capture.captureMouse)
         {
             if (!input.KeyDown(VK_LBUTTON))
             {
                 EndAllGizmoDrags(interaction, scene);
+                interaction.marqueeArmed = false;
+                interaction.marqueeActive = false;
             }
             return;
         }
@@ -486,64 +649,72 @@ namespace appEditor
             SyncTransformsAndCurrentGizmoVisual(interaction, levelAsset, levelInstance, scene);
         }
 
-        if (!gizmoConsumed && input.KeyPressed(VK_LBUTTON))
-        {
-            const bool ctrlDown = input.KeyDown(VK_CONTROL) || input.KeyDown(VK_LCONTROL) || input.KeyDown(VK_RCONTROL);
-
-            const rendern::PickResult pick = rendern::PickEditorObjectUnderScreenPoint(
-                scene,
-                levelInstance,
-                mouseXF,
-                mouseYF,
-                viewportWidthF,
-                viewportHeightF);
+        const bool ctrlDown = input.KeyDown(VK_CONTROL) || input.KeyDown(VK_LCONTROL) || input.KeyDown(VK_RCONTROL);
+        const bool gpuPicking = renderer.SupportsObjectIdPicking();
 
-            scene.debugPickRay.enabled = true;
-            scene.debugPickRay.origin = pick.rayOrigin;
-            scene.debugPickRay.direction = pick.rayDir;
-            scene.debugPickRay.hit = ((pick.nodeIndex >= 0) || (pick.particleEmitterIndex >= 0) || (pick.lightIndex >= 0)) && std::isfinite(pick.t);
-            scene.debugPickRay.length = scene.debugPickRay.hit ? pick.t : scene.camera.farZ;
-
-            if (scene.debugPickRay.hit && levelInstance.IsNodeAlive(levelAsset, pick.nodeIndex))
+        auto requestPick = [&](int x, int y, int width, int height, bool marquee)
             {
-                if (ctrlDown)
-                {
-                    scene.EditorToggleSelectionNode(pick.nodeIndex);
-                }
-                else
-                {
-                    scene.EditorSetSelectionSingle(pick.nodeIndex);
-                }
-            }
-            else if (scene.debugPickRay.hit && levelInstance.IsValidParticleEmitterIndex(pick.particleEmitterIndex))
+                rendern::ObjectIdPickRequest request{};
+                request.x = static_cast<std::uint32_t>(x);
+                request.y = static_cast<std::uint32_t>(y);
+                request.width = static_cast<std::uint32_t>(width);
+                request.height = static_cast<std::uint32_t>(height);
+
+                PendingObjectIdPick pending{};
+                pending.requestId = renderer.RequestObjectIdPick(request);
+                pending.ctrlDown = ctrlDown;
+                pending.marquee = marquee;
+                pending.mouseX = mouseXF;
+                pending.mouseY = mouseYF;
+                pending.viewportWidth = viewportWidthF;
+                pending.viewportHeight = viewportHeightF;
+                interaction.pendingPick = pending;
+                return pending.requestId != 0;
+            };
+
+        if (!gizmoConsumed && input.KeyPressed(VK_LBUTTON))
+        {
+            // The object-ID buffer answers a frame or two later; the CPU ray pick stays as the
+            // fallback for backends without texture readback.
+            if (!gpuPicking || !requestPick(mouseX, mouseY, 1, 1, /*marquee=*/false))
             {
-                if (ctrlDown)
-                {
-                    scene.EditorToggleSelectionParticleEmitter(pick.particleEmitterIndex);
-                }
-                else
-                {
-                    scene.EditorSetSelectionSingleParticleEmitter(pick.particleEmitterIndex);
-                }
+                const rendern::PickResult pick = rendern::PickEditorObjectUnderScreenPoint(
+                    scene,
+                    levelInstance,
+                    mouseXF,
+                    mouseYF,
+                    viewportWidthF,
+                    viewportHeightF);
+                ApplyViewportPick(levelAsset, levelInstance, scene, pick, ctrlDown);
             }
-            else if (scene.debugPickRay.hit && pick.lightIndex >= 0)
+
+            interaction.marqueeArmed = gpuPicking;
+            interaction.marqueeActive = false;
+            interaction.marqueeStartX = mouseX;
+            interaction.marqueeStartY = mouseY;
+        }
+        else if (interaction.marqueeArmed)
+        {
+            constexpr int kMarqueeThresholdPx = 4;
+            if (!interaction.marqueeActive &&
+                (std::abs(mouseX - interaction.marqueeStartX) > kMarqueeThresholdPx ||
+                 std::abs(mouseY - interaction.marqueeStartY) > kMarqueeThresholdPx))
             {
-                if (ctrlDown)
-                {
-                    scene.EditorToggleSelectionLight(pick.lightIndex);
-                }
-                else
-                {
-                    scene.EditorSetLightSelectionSingle(pick.lightIndex);
-                }
+                interaction.marqueeActive = true;
             }
-            else
+
+            if (!input.KeyDown(VK_LBUTTON))
             {
-                // Click on empty space: clear selection only when Ctrl is not pressed.
-                if (!ctrlDown)
+                if (interaction.marqueeActive)
                 {
-                    scene.EditorClearSelection();
+                    const int x0 = (std::min)(mouseX, interaction.marqueeStartX);
+                    const int y0 = (std::min)(mouseY, interaction.marqueeStartY);
+                    const int x1 = (std::max)(mouseX, interaction.marqueeStartX);
+                    const int y1 = (std::max)(mouseY, interaction.marqueeStartY);
+                    requestPick(x0, y0, x1 - x0 + 1, y1 - y0 + 1, /*marquee=*/true);
                 }
+                interaction.marqueeArmed = false;
+                interaction.marqueeActive = false;
             }
         }
     }
@@ -0,0 +1,84 @@
+module;
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+export module core:asset_id;
+
+import :hash_utils;
+
+// Interned asset name: the 64-bit FNV-1a hash of the id string. Storages key their maps by
+// it, so a lookup from a string_view hashes once and never allocates. Debug builds keep a
+// reverse table (AssetIdName) filled by InternAssetId and assert that no two names collide.
+
+export struct AssetId
+{
+	std::uint64_t value{ 0 };
+
+	constexpr AssetId() = default;
+	constexpr explicit AssetId(std::string_view name) noexcept : value(hashUtils::Fnv1a64(name)) {}
+
+	constexpr bool IsValid() const noexcept { return value != 0; }
+
+	friend constexpr bool operator==(AssetId, AssetId) noexcept = default;
+};
+
+export struct AssetIdHash
+{
+	std::size_t operator()(AssetId id) const noexcept
+	{
+		return static_cast<std::size_t>(hashUtils::Mix64(id.value));
+	}
+};
+
+#ifndef NDEBUG
+namespace
+{
+	struct AssetIdNameTable
+	{
+		std::mutex mutex{};
+		std::unordered_map<std::uint64_t, std::string> names{};
+	};
+
+	AssetIdNameTable& AssetIdNames()
+	{
+		static AssetIdNameTable table{};
+		return table;
+	}
+}
+#endif
+
+// AssetId of `name`; in debug builds also records the name for AssetIdName. Call it where an
+// id is first created (storage entries), plain AssetId{ name } everywhere else.
+export AssetId InternAssetId(std::string_view name)
+{
+	const AssetId id{ name };
+#ifndef NDEBUG
+	AssetIdNameTable& table = AssetIdNames();
+	std::scoped_lock lock(table.mutex);
+	const auto [it, inserted] = table.names.try_emplace(id.value, name);
+	assert((inserted || it->second == name) && "AssetId hash collision");
+#endif
+	return id;
+}
+
+// Name an id was interned from; empty in release builds or for ids never interned.
+export std::string_view AssetIdName(AssetId id)
+{
+#ifndef NDEBUG
+	AssetIdNameTable& table = AssetIdNames();
+	std::scoped_lock lock(table.mutex);
+	if (const auto it = table.names.find(id.value); it != table.names.end())
+	{
+		return it->second;
+	}
+#else
+	(void)id;
+#endif
+	return {};
+}
@@ -12,14 +12,20 @@ module;
 #include <vector>
 #include <optional>
 #include <array>
+#include <future>
 
 export module core:asset_manager;
 
 import :resource_manager;
+import :cooked_assets;
+import :residency_manager;
+import :job_system;
+import :profiler;
 import :file_system;
 
-// Mesh resource types live in rendern namespace.
+// Mesh and animation resource types live in rendern namespace.
 import :resource_manager_mesh;
+import :resource_manager_animation;
 
 namespace
 {
@@ -40,7 +46,7 @@ namespace
 
 	inline bool FileExists(const std::filesystem::path& maybeRel)
 	{
-		return std::filesystem::exists(ToAbsIfNeeded(maybeRel));
+		return corefs::AssetFileExists(ToAbsIfNeeded(maybeRel));
 	}
 
 	std::array<std::string, 6> ResolveCubemapFacesFromBase(std::filesystem::path basePath)
@@ -249,6 +255,12 @@ export struct AssetStreamingStats
 	ResourceStreamingStats meshes{};
 	ResourceStreamingStats total{};
 
+	// Budget applied by the last budgeted ProcessUploads call and how much of it was spent.
+	StreamingUploadBudget uploadBudget{};
+	std::uint32_t uploadBudgetItemsUsed{};
+	std::uint64_t uploadBudgetBytesUsed{};
+	float uploadBudgetMicrosecondsUsed{};
+
 	[[nodiscard]] bool HasPendingWork() const noexcept
 	{
 		return total.HasPendingWork();
@@ -260,15 +272,35 @@ export struct AssetStreamingStats
 	}
 };
 
+// Resources a caller waits on as one unit (see AssetManager::WhenLoaded).
+export struct AssetLoadSet
+{
+	std::vector<std::string> textures;
+	std::vector<std::string> meshes;
+};
+
 export class AssetManager
 {
 public:
 	AssetManager(TextureIO& textureIO, rendern::MeshIO& meshIO)
 		: textureIO_(&textureIO)
 		, meshIO_(&meshIO)
+		, animationIO_{ meshIO.jobs }
+	{
+		textureIO_->cancellation = loadCancellation_.GetToken();
+		meshIO_->cancellation = loadCancellation_.GetToken();
+		animationIO_.cancellation = loadCancellation_.GetToken();
+	}
+
+	// Re-reads the cooker manifest (e.g. after running ResourceCooker with the app open).
+	// Only affects loads queued afterwards.
+	void ReloadCookedManifest()
 	{
+		cookedManifest_ = CookedAssetManifest::Load(CookedAssetManifest::DefaultPath());
 	}
 
+	std::size_t CookedManifestSize() const noexcept { return cookedManifest_.Size(); }
+
 	std::shared_ptr<TextureResource> LoadTextureAsync(std::string_view id, TextureProperties props)
 	{
 		return LoadTexture_(id, std::move(props), false);
@@ -326,26 +358,151 @@ public:
 		return LoadMesh_(id, std::move(props), true);
 	}
 
+	// Skinned sources and animation clip sets are CPU-only and shared process-wide: a file is
+	// imported once per key (see MakeSkinnedSourceKey / MakeAnimationClipSetKey) however many
+	// levels and nodes use it. The Sync variants run the import on the calling thread unless a
+	// worker already started it. The payload is null if the import failed (see GetError).
+	std::shared_ptr<rendern::SkinnedSourceResource> LoadSkinnedSourceAsync(rendern::SkinnedSourceProperties props)
+	{
+		const std::string key = rendern::MakeSkinnedSourceKey(props);
+		return rm_.LoadAsync<rendern::SkinnedSourceResource>(key, animationIO_, std::move(props));
+	}
+
+	std::shared_ptr<rendern::SkinnedSourceResource> LoadSkinnedSourceSync(rendern::SkinnedSourceProperties props)
+	{
+		const std::string key = rendern::MakeSkinnedSourceKey(props);
+		return rm_.LoadSync<rendern::SkinnedSourceResource>(key, animationIO_, std::move(props));
+	}
+
+	std::shared_ptr<rendern::AnimationClipSetResource> LoadAnimationClipSetAsync(rendern::AnimationClipSetProperties props)
+	{
+		const std::string key = rendern::MakeAnimationClipSetKey(props);
+		return rm_.LoadAsync<rendern::AnimationClipSetResource>(key, animationIO_, std::move(props));
+	}
+
+	std::shared_ptr<rendern::AnimationClipSetResource> LoadAnimationClipSetSync(rendern::AnimationClipSetProperties props)
+	{
+		const std::string key = rendern::MakeAnimationClipSetKey(props);
+		return rm_.LoadSync<rendern::AnimationClipSetResource>(key, animationIO_, std::move(props));
+	}
+
 	// Drive GPU upload + destruction queues for all managed resource types.
 	void ProcessUploads(std::size_t maxTexUploadsPerCall = 8,
 		std::size_t maxTexDestroyedPerCall = 32,
 		std::size_t maxMeshUploadsPerCall = 2,
 		std::size_t maxMeshDestroyedPerCall = 32)
 	{
+		profiling::ScopedZone zone{ "AssetManager::ProcessUploads" };
+		UpdateResidency_();
 		rm_.ProcessUploads<TextureResource>(*textureIO_, maxTexUploadsPerCall, maxTexDestroyedPerCall);
 		rm_.ProcessUploads<rendern::MeshResource>(*meshIO_, maxMeshUploadsPerCall, maxMeshDestroyedPerCall);
+		UpdateLoadWatches_();
+	}
+
+	// Budgeted variant: textures and meshes draw from one byte/time budget (textures first).
+	// The item counts still act as upper bounds.
+	void ProcessUploads(const StreamingUploadBudget& budget,
+		std::size_t maxTexUploadsPerCall = 8,
+		std::size_t maxTexDestroyedPerCall = 32,
+		std::size_t maxMeshUploadsPerCall = 2,
+		std::size_t maxMeshDestroyedPerCall = 32)
+	{
+		profiling::ScopedZone zone{ "AssetManager::ProcessUploads" };
+		UploadBudgetTracker tracker{ .budget = budget };
+		UpdateResidency_();
+		rm_.ProcessUploads<TextureResource>(*textureIO_, tracker, maxTexUploadsPerCall, maxTexDestroyedPerCall);
+		rm_.ProcessUploads<rendern::MeshResource>(*meshIO_, tracker, maxMeshUploadsPerCall, maxMeshDestroyedPerCall);
+		lastUploadBudget_ = tracker;
+		UpdateLoadWatches_();
+	}
+
+	// Becomes ready once every resource of the set has left Loading (loaded, failed, cancelled
+	// or never requested). Checked at the end of ProcessUploads, so it resolves on the thread
+	// driving uploads; the set should already be requested, so all of it is in flight at once.
+	std::shared_future<void> WhenLoaded(AssetLoadSet set)
+	{
+		LoadWatch_ watch{ .set = std::move(set) };
+		std::shared_future<void> future = watch.done.get_future().share();
+		if (AdvanceLoadWatch_(watch))
+		{
+			watch.done.set_value();
+		}
+		else
+		{
+			loadWatches_.push_back(std::move(watch));
+		}
+		return future;
+	}
+
+	// Mip streaming of 2D textures (see TextureStreamingSettings); applies to loads queued after
+	// the call.
+	void SetTextureStreaming(const TextureStreamingSettings& settings)
+	{
+		TextureStorage_().SetMipStreaming(settings);
+	}
+
+	// Renderer feedback for mip streaming, once per frame per visible texture. `screenPixels` is
+	// the larger on-screen side of the surface the texture is mapped onto.
+	void ReportTextureScreenSize(std::string_view id, float screenPixels)
+	{
+		TextureStorage_().ReportScreenSize(id, screenPixels);
+	}
+
+	// GPU memory budgets for textures and meshes (see ResidencyManager).
+	void SetResidency(const ResidencySettings& settings) noexcept
+	{
+		residency_.SetSettings(settings);
+	}
+
+	// Residency usage mark for a texture drawn this frame (meshes are marked on the resource
+	// by the renderer directly).
+	void MarkTextureUsed(std::string_view id) const
+	{
+		if (const auto texture = rm_.GetStorage<TextureResource>().Find(id))
+		{
+			texture->MarkUsed();
+		}
 	}
 
 	void UnloadUnused()
 	{
 		rm_.UnloadUnused<TextureResource>();
 		rm_.UnloadUnused<rendern::MeshResource>();
+		rm_.UnloadUnused<rendern::SkinnedSourceResource>();
+		rm_.UnloadUnused<rendern::AnimationClipSetResource>();
+	}
+
+	// Meshes only: level textures are referenced through bindless descriptors rather than
+	// handles, so they must not be dropped this way while a level is live.
+	void UnloadUnusedMeshes()
+	{
+		rm_.UnloadUnused<rendern::MeshResource>();
+	}
+
+	// Drops every decode/import that has not started yet (level switch, shutdown).
+	// Affected entries return to Unloaded and restart on their next Load*Async.
+	void CancelPendingLoads()
+	{
+		loadCancellation_.Cancel();
+		loadCancellation_ = jobs::CancellationSource{};
+		textureIO_->cancellation = loadCancellation_.GetToken();
+		meshIO_->cancellation = loadCancellation_.GetToken();
+		animationIO_.cancellation = loadCancellation_.GetToken();
+
+		// Reads still in flight complete as cancelled and queue their decode jobs, so a
+		// following jobs WaitIdle covers them.
+		if (textureIO_->files != nullptr)
+		{
+			textureIO_->files->WaitIdle();
+		}
 	}
 
 	void ClearAll()
 	{
 		rm_.Clear<TextureResource>();
 		rm_.Clear<rendern::MeshResource>();
+		rm_.Clear<rendern::SkinnedSourceResource>();
+		rm_.Clear<rendern::AnimationClipSetResource>();
 	}
 
 	AssetStreamingStats GetStreamingStats() const
@@ -361,6 +518,27 @@ public:
 		stats.total.pendingCpuEntries = stats.textures.pendingCpuEntries + stats.meshes.pendingCpuEntries;
 		stats.total.queuedUploads = stats.textures.queuedUploads + stats.meshes.queuedUploads;
 		stats.total.queuedDestroys = stats.textures.queuedDestroys + stats.meshes.queuedDestroys;
+		stats.total.gpuPendingUploads = stats.textures.gpuPendingUploads + stats.meshes.gpuPendingUploads;
+		stats.total.lastUploadItems = stats.textures.lastUploadItems + stats.meshes.lastUploadItems;
+		stats.total.lastUploadBytes = stats.textures.lastUploadBytes + stats.meshes.lastUploadBytes;
+		stats.total.lastUploadEstimatedMicroseconds = stats.textures.lastUploadEstimatedMicroseconds + stats.meshes.lastUploadEstimatedMicroseconds;
+		stats.total.streamedResidentBytes = stats.textures.streamedResidentBytes;
+		stats.total.pendingMipStreams = stats.textures.pendingMipStreams;
+
+		const bool residencyEnabled = residency_.GetSettings().enabled;
+		stats.textures.residencyBudgetBytes = residencyEnabled ? residency_.TextureStats().budgetBytes : 0;
+		stats.textures.lastEvictions = residency_.TextureStats().lastEvictions;
+		stats.meshes.residencyBudgetBytes = residencyEnabled ? residency_.MeshStats().budgetBytes : 0;
+		stats.meshes.lastEvictions = residency_.MeshStats().lastEvictions;
+		stats.total.residentBytes = stats.textures.residentBytes + stats.meshes.residentBytes;
+		stats.total.evictedEntries = stats.textures.evictedEntries + stats.meshes.evictedEntries;
+		stats.total.residencyBudgetBytes = stats.textures.residencyBudgetBytes + stats.meshes.residencyBudgetBytes;
+		stats.total.lastEvictions = stats.textures.lastEvictions + stats.meshes.lastEvictions;
+
+		stats.uploadBudget = lastUploadBudget_.budget;
+		stats.uploadBudgetItemsUsed = lastUploadBudget_.items;
+		stats.uploadBudgetBytesUsed = lastUploadBudget_.bytes;
+		stats.uploadBudgetMicrosecondsUsed = lastUploadBudget_.estimatedMicroseconds;
 		return stats;
 	}
 
@@ -368,13 +546,79 @@ public:
 	const ResourceManager& GetResourceManager() const noexcept { return rm_; }
 
 private:
+	ResourceStorage<TextureResource>& TextureStorage_()
+	{
+		return rm_.GetStorage<TextureResource>();
+	}
+
+	// Once per frame, before the upload queues drain: residency first (evictions free budget,
+	// restarts queue decodes), then mip streaming.
+	void UpdateResidency_()
+	{
+		residency_.Update(TextureStorage_(), *textureIO_, rm_.GetStorage<rendern::MeshResource>(), *meshIO_);
+		TextureStorage_().UpdateMipStreaming(*textureIO_);
+	}
+
+	struct LoadWatch_
+	{
+		AssetLoadSet set{};
+		std::size_t nextTexture{ 0 };
+		std::size_t nextMesh{ 0 };
+		std::promise<void> done{};
+	};
+
+	// Skips the settled prefix of both lists (a resource never returns to Loading on its own, so
+	// settled ones are not rechecked); true once both are exhausted.
+	bool AdvanceLoadWatch_(LoadWatch_& watch) const
+	{
+		while (watch.nextTexture < watch.set.textures.size() &&
+			rm_.GetState<TextureResource>(watch.set.textures[watch.nextTexture]) != ResourceState::Loading)
+		{
+			++watch.nextTexture;
+		}
+		while (watch.nextMesh < watch.set.meshes.size() &&
+			rm_.GetState<rendern::MeshResource>(watch.set.meshes[watch.nextMesh]) != ResourceState::Loading)
+		{
+			++watch.nextMesh;
+		}
+		return watch.nextTexture == watch.set.textures.size() && watch.nextMesh == watch.set.meshes.size();
+	}
+
+	void UpdateLoadWatches_()
+	{
+		for (auto it = loadWatches_.begin(); it != loadWatches_.end(); )
+		{
+			if (AdvanceLoadWatch_(*it))
+			{
+				it->done.set_value();
+				it = loadWatches_.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
 	std::shared_ptr<TextureResource> LoadTexture_(
 		std::string_view id,
 		TextureProperties props,
 		bool sync)
 	{
+		// Cubemaps are decoded from six faces and are not cooked; 2D textures with a current
+		// cooked DDS skip stb and CPU mip generation.
+		if (props.dimension == TextureDimension::Tex2D)
+		{
+			const std::string_view source = props.filePath.empty() ? id : std::string_view(props.filePath);
+			if (auto artifact = cookedManifest_.ResolveArtifact(CookedAssetKind::Texture, source, TextureCookSettingsKey(props)))
+			{
+				props.filePath = artifact->string();
+			}
+		}
+
 		if (sync)
 		{
+			props.streamingPriority = jobs::JobPriority::Critical;
 			return rm_.LoadSync<TextureResource>(id, *textureIO_, std::move(props));
 		}
 		return rm_.LoadAsync<TextureResource>(id, *textureIO_, std::move(props));
@@ -385,8 +629,19 @@ private:
 		rendern::MeshProperties props,
 		bool sync)
 	{
+		const std::string_view source = props.filePath.empty() ? id : std::string_view(props.filePath);
+		if (auto artifact = cookedManifest_.ResolveArtifact(CookedAssetKind::Mesh, source, rendern::MeshCookSettingsKey(props)))
+		{
+			if (props.debugName.empty())
+			{
+				props.debugName = rendern::DefaultDebugNameFromPath(source);
+			}
+			props.filePath = artifact->string();
+		}
+
 		if (sync)
 		{
+			props.streamingPriority = jobs::JobPriority::Critical;
 			return rm_.LoadSync<rendern::MeshResource>(id, *meshIO_, std::move(props));
 		}
 		return rm_.LoadAsync<rendern::MeshResource>(id, *meshIO_, std::move(props));
@@ -433,5 +688,11 @@ private:
 private:
 	TextureIO* textureIO_{};
 	rendern::MeshIO* meshIO_{};
+	rendern::AnimationIO animationIO_;
 	ResourceManager rm_{};
+	jobs::CancellationSource loadCancellation_{};
+	UploadBudgetTracker lastUploadBudget_{};
+	CookedAssetManifest cookedManifest_{ CookedAssetManifest::Load(CookedAssetManifest::DefaultPath()) };
+	ResidencyManager residency_{};
+	std::vector<LoadWatch_> loadWatches_{};
 };
\ No newline at end of file
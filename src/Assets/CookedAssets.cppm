@@ -0,0 +1,334 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+export module core:cooked_assets;
+
+import :resource_manager_core;
+import :cooked_mesh;
+import :file_system;
+
+// Dependency manifest of the offline cooker (ResourceCooker). One record per
+// (kind, source, import settings): the cooked artifact and the size/mtime stamps of every input
+// it was built from. AssetManager consults it before queueing a load and swaps the source path
+// for the artifact, so a cooked build never opens FBX/OBJ/PNG at runtime.
+//
+// Stored as tab-separated text next to the artifacts (CookedCacheRoot()/manifest.txt):
+//   kind  settingsKey  cookKey  artifact  depCount  { path  bytes  writeTime } x (1 + depCount)
+// The first stamp is the source itself. Paths are relative to the asset root ('/' separators);
+// the artifact is relative to the cooked root.
+
+export enum class CookedAssetKind : std::uint8_t
+{
+	Mesh,
+	Texture,
+	AnimationClips
+};
+
+export struct CookedFileStamp
+{
+	std::string path{};
+	std::uint64_t bytes{ 0 };
+	std::int64_t writeTime{ 0 };
+};
+
+export struct CookedAssetRecord
+{
+	CookedAssetKind kind{ CookedAssetKind::Mesh };
+	std::uint64_t settingsKey{ 0 };
+	std::uint64_t cookKey{ 0 };
+	std::string artifact{};
+	CookedFileStamp source{};
+	std::vector<CookedFileStamp> dependencies{};
+};
+
+// Manifest key of an asset path: relative to the asset root when it lies inside it, normalized,
+// generic separators. "models/a.obj", "./models/a.obj" and "<root>/models/a.obj" all agree.
+export std::string NormalizeCookedAssetPath(const std::filesystem::path& path)
+{
+	namespace fs = std::filesystem;
+
+	fs::path p = path.lexically_normal();
+	if (p.is_absolute())
+	{
+		std::error_code ec;
+		const fs::path root = fs::absolute(corefs::FindAssetRoot(), ec).lexically_normal();
+		if (!ec)
+		{
+			const fs::path rel = p.lexically_relative(root);
+			if (!rel.empty() && *rel.begin() != "..")
+			{
+				p = rel;
+			}
+		}
+	}
+	return p.generic_string();
+}
+
+// Stat of an asset-relative path; nullopt if it does not exist.
+export std::optional<CookedFileStamp> StampCookedInput(std::string_view assetPath)
+{
+	namespace fs = std::filesystem;
+
+	// Packed sources report the stamp recorded when the pack was built.
+	const std::optional<corefs::FileStat> stat = corefs::StatAssetFile(corefs::ResolveAsset(fs::path(std::string(assetPath))));
+	if (!stat)
+	{
+		return std::nullopt;
+	}
+	return CookedFileStamp{
+		.path = std::string(assetPath),
+		.bytes = stat->bytes,
+		.writeTime = static_cast<std::int64_t>(stat->writeTime.time_since_epoch().count()) };
+}
+
+// Import settings that change a decoded 2D texture; part of the manifest lookup key.
+export std::uint64_t TextureCookSettingsKey(const TextureProperties& props) noexcept
+{
+	const std::array<std::byte, 4> settings{
+		static_cast<std::byte>(props.srgb ? 1 : 0),
+		static_cast<std::byte>(props.generateMips ? 1 : 0),
+		static_cast<std::byte>(props.isNormalMap ? 1 : 0),
+		static_cast<std::byte>(props.flipY ? 1 : 0),
+	};
+	return rendern::HashCookBytes(settings);
+}
+
+export class CookedAssetManifest
+{
+public:
+	static std::filesystem::path DefaultPath()
+	{
+		return corefs::CookedCacheRoot() / "manifest.txt";
+	}
+
+	// Missing file -> empty manifest. Malformed lines are skipped (the cooker rewrites them).
+	static CookedAssetManifest Load(const std::filesystem::path& path)
+	{
+		CookedAssetManifest manifest{};
+		if (!corefs::AssetFileExists(path))
+		{
+			return manifest;
+		}
+		std::istringstream in(corefs::ReadAllText(path));
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (line.empty() || line.front() == '#')
+			{
+				continue;
+			}
+			if (std::optional<CookedAssetRecord> record = ParseLine_(line))
+			{
+				manifest.Upsert(std::move(*record));
+			}
+		}
+		return manifest;
+	}
+
+	// Written through a temp file + rename, like the artifacts.
+	bool Save(const std::filesystem::path& path) const
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+		std::filesystem::path tmpPath = path;
+		tmpPath += ".tmp";
+		{
+			std::ofstream out(tmpPath, std::ios::trunc);
+			if (!out)
+			{
+				return false;
+			}
+
+			// Sorted so re-cooking an unchanged tree rewrites an identical file.
+			std::vector<const std::pair<const std::string, CookedAssetRecord>*> sorted;
+			sorted.reserve(records_.size());
+			for (const auto& entry : records_)
+			{
+				sorted.push_back(&entry);
+			}
+			std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+			out << "# cooked asset manifest v1\n";
+			for (const auto* entry : sorted)
+			{
+				const CookedAssetRecord& record = entry->second;
+				out << static_cast<unsigned>(record.kind)
+					<< '\t' << rendern::CookKeyHex(record.settingsKey)
+					<< '\t' << rendern::CookKeyHex(record.cookKey)
+					<< '\t' << record.artifact
+					<< '\t' << record.dependencies.size();
+				WriteStamp_(out, record.source);
+				for (const CookedFileStamp& dep : record.dependencies)
+				{
+					WriteStamp_(out, dep);
+				}
+				out << '\n';
+			}
+			if (!out)
+			{
+				return false;
+			}
+		}
+
+		std::filesystem::rename(tmpPath, path, ec);
+		return !ec;
+	}
+
+	void Upsert(CookedAssetRecord record)
+	{
+		std::string key = MakeKey_(record.kind, record.source.path, record.settingsKey);
+		records_.insert_or_assign(std::move(key), std::move(record));
+	}
+
+	const CookedAssetRecord* Find(CookedAssetKind kind, std::string_view sourcePath, std::uint64_t settingsKey) const
+	{
+		const auto it = records_.find(MakeKey_(kind, sourcePath, settingsKey));
+		return it != records_.end() ? &it->second : nullptr;
+	}
+
+	// True when every input still matches its stamp. Inputs that are gone count as current:
+	// shipping builds carry only the cooked cache.
+	static bool IsCurrent(const CookedAssetRecord& record)
+	{
+		const auto Matches = [](const CookedFileStamp& stamp)
+			{
+				const std::optional<CookedFileStamp> now = StampCookedInput(stamp.path);
+				return !now || (now->bytes == stamp.bytes && now->writeTime == stamp.writeTime);
+			};
+
+		if (!Matches(record.source))
+		{
+			return false;
+		}
+		for (const CookedFileStamp& dep : record.dependencies)
+		{
+			if (!Matches(dep))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Absolute artifact path to load instead of `sourcePath`, if a current one exists.
+	std::optional<std::filesystem::path> ResolveArtifact(CookedAssetKind kind, std::string_view sourcePath, std::uint64_t settingsKey) const
+	{
+		if (records_.empty())
+		{
+			return std::nullopt;
+		}
+
+		const CookedAssetRecord* record = Find(kind, NormalizeCookedAssetPath(std::filesystem::path(std::string(sourcePath))), settingsKey);
+		if (record == nullptr || !IsCurrent(*record))
+		{
+			return std::nullopt;
+		}
+
+		std::filesystem::path artifact = corefs::CookedCacheRoot() / std::filesystem::path(record->artifact);
+		if (!corefs::AssetFileExists(artifact))
+		{
+			return std::nullopt;
+		}
+		return artifact;
+	}
+
+	std::size_t Size() const noexcept { return records_.size(); }
+	bool Empty() const noexcept { return records_.empty(); }
+
+private:
+	static std::string MakeKey_(CookedAssetKind kind, std::string_view sourcePath, std::uint64_t settingsKey)
+	{
+		std::string key;
+		key.reserve(sourcePath.size() + 20);
+		key += static_cast<char>('0' + static_cast<unsigned>(kind));
+		key += rendern::CookKeyHex(settingsKey);
+		key += sourcePath;
+		return key;
+	}
+
+	static void WriteStamp_(std::ofstream& out, const CookedFileStamp& stamp)
+	{
+		out << '\t' << stamp.path << '\t' << stamp.bytes << '\t' << stamp.writeTime;
+	}
+
+	static std::optional<CookedAssetRecord> ParseLine_(std::string_view line)
+	{
+		std::vector<std::string_view> fields;
+		std::size_t begin = 0;
+		while (begin <= line.size())
+		{
+			const std::size_t end = std::min(line.find('\t', begin), line.size());
+			fields.push_back(line.substr(begin, end - begin));
+			begin = end + 1;
+		}
+
+		const auto ParseInt = [](std::string_view s, auto& out, int base = 10)
+			{
+				const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out, base);
+				return ec == std::errc{} && ptr == s.data() + s.size();
+			};
+
+		constexpr std::size_t kFixed = 5;
+		constexpr std::size_t kStampFields = 3;
+		if (fields.size() < kFixed + kStampFields)
+		{
+			return std::nullopt;
+		}
+
+		CookedAssetRecord record{};
+		unsigned kind = 0;
+		std::size_t depCount = 0;
+		if (!ParseInt(fields[0], kind) || kind > static_cast<unsigned>(CookedAssetKind::AnimationClips) ||
+			!ParseInt(fields[1], record.settingsKey, 16) ||
+			!ParseInt(fields[2], record.cookKey, 16) ||
+			fields[3].empty() ||
+			!ParseInt(fields[4], depCount) ||
+			fields.size() != kFixed + kStampFields * (1 + depCount))
+		{
+			return std::nullopt;
+		}
+		record.kind = static_cast<CookedAssetKind>(kind);
+		record.artifact = std::string(fields[3]);
+
+		const auto ParseStamp = [&](std::size_t first, CookedFileStamp& stamp)
+			{
+				stamp.path = std::string(fields[first]);
+				return !stamp.path.empty()
+					&& ParseInt(fields[first + 1], stamp.bytes)
+					&& ParseInt(fields[first + 2], stamp.writeTime);
+			};
+
+		if (!ParseStamp(kFixed, record.source))
+		{
+			return std::nullopt;
+		}
+		record.dependencies.resize(depCount);
+		for (std::size_t i = 0; i < depCount; ++i)
+		{
+			if (!ParseStamp(kFixed + kStampFields * (1 + i), record.dependencies[i]))
+			{
+				return std::nullopt;
+			}
+		}
+		return record;
+	}
+
+	std::unordered_map<std::string, CookedAssetRecord> records_{};
+};
@@ -0,0 +1,114 @@
+module;
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+export module core:residency_manager;
+
+import :asset_id;
+import :resource_manager_core;
+import :resource_manager_texture;
+import :resource_manager_mesh;
+
+// Keeps the GPU bytes of the texture and mesh storages within ResidencySettings budgets.
+// The renderer marks what it draws (MarkUsed on the resource while packing draws); once per
+// frame Update turns the marks into last-used frames, restarts evicted resources that were
+// drawn again, and evicts the least recently drawn ones while a storage is over its budget.
+//
+// Eviction only releases the GPU copy: handles stay valid, the entry goes back to Unloaded and
+// is reloaded with its original properties. Anything drawn within minUnusedFrames is kept even
+// over budget, so a scene that needs more than the budget degrades to "no eviction" instead of
+// thrashing.
+
+export struct ResidencyUsageStats
+{
+	std::uint64_t budgetBytes{};
+	std::uint32_t lastEvictions{};
+	std::uint32_t lastRestores{};
+};
+
+export class ResidencyManager
+{
+public:
+	void SetSettings(const ResidencySettings& settings) noexcept { settings_ = settings; }
+	const ResidencySettings& GetSettings() const noexcept { return settings_; }
+
+	void Update(
+		ResourceStorage<TextureResource>& textures,
+		TextureIO& textureIO,
+		ResourceStorage<rendern::MeshResource>& meshes,
+		rendern::MeshIO& meshIO)
+	{
+		if (!settings_.enabled)
+		{
+			return;
+		}
+
+		++frame_;
+		textureStats_ = Balance(textures, textureIO, settings_.textureBudgetBytes);
+		meshStats_ = Balance(meshes, meshIO, settings_.meshBudgetBytes);
+	}
+
+	const ResidencyUsageStats& TextureStats() const noexcept { return textureStats_; }
+	const ResidencyUsageStats& MeshStats() const noexcept { return meshStats_; }
+
+private:
+	template <typename Storage, typename IO>
+	ResidencyUsageStats Balance(Storage& storage, IO& io, std::uint64_t budgetBytes)
+	{
+		ResidencyUsageStats stats{};
+		stats.budgetBytes = budgetBytes;
+
+		candidates_.clear();
+		restores_.clear();
+		std::uint64_t residentBytes = storage.SampleResidency(frame_, candidates_, restores_);
+
+		for (const AssetId id : restores_)
+		{
+			storage.Restore(id, io);
+		}
+		stats.lastRestores = static_cast<std::uint32_t>(restores_.size());
+
+		if (budgetBytes == 0 || residentBytes <= budgetBytes)
+		{
+			return stats;
+		}
+
+		// Least recently drawn first; among equals the largest, so fewer evictions free the bytes.
+		std::sort(candidates_.begin(), candidates_.end(), [](const ResidencyCandidate& a, const ResidencyCandidate& b)
+			{
+				if (a.lastUsedFrame != b.lastUsedFrame)
+				{
+					return a.lastUsedFrame < b.lastUsedFrame;
+				}
+				return a.bytes > b.bytes;
+			});
+
+		for (const ResidencyCandidate& candidate : candidates_)
+		{
+			if (residentBytes <= budgetBytes ||
+				stats.lastEvictions >= settings_.maxEvictionsPerFrame ||
+				frame_ - candidate.lastUsedFrame < settings_.minUnusedFrames)
+			{
+				break;
+			}
+
+			const std::uint64_t freed = storage.Evict(candidate.id);
+			if (freed != 0)
+			{
+				residentBytes -= std::min(freed, residentBytes);
+				++stats.lastEvictions;
+			}
+		}
+		return stats;
+	}
+
+	ResidencySettings settings_{};
+	std::uint64_t frame_{ 0 };
+	ResidencyUsageStats textureStats_{};
+	ResidencyUsageStats meshStats_{};
+
+	std::vector<ResidencyCandidate> candidates_{};
+	std::vector<AssetId> restores_{};
+};
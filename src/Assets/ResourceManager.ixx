@@ -1,5 +1,9 @@
 export module core:resource_manager;
 
+export import :asset_id;
 export import :resource_manager_core;
 export import :resource_manager_texture;
-export import :resource_manager_mesh;
\ No newline at end of file
+export import :resource_manager_mesh;
+export import :resource_manager_animation;
+export import :cooked_assets;
+export import :residency_manager;
\ No newline at end of file
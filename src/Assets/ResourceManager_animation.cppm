@@ -0,0 +1,400 @@
+module;
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+export module core:resource_manager_animation;
+
+import :resource_manager_core;
+import :job_system;
+import :asset_id;
+import :flat_hash_map;
+import :assimp_loader;
+import :skinned_mesh;
+import :skeleton;
+import :animation_clip;
+import :animation_compression;
+
+export namespace rendern
+{
+	// A skinned source file: mesh, skeleton and the clips embedded in it.
+	struct SkinnedSourceProperties
+	{
+		std::string path;
+		std::string debugName; // not part of the key: the first request names the shared bundle
+		bool flipUVs{ true };
+		std::optional<std::uint32_t> submeshIndex{};
+		jobs::JobPriority streamingPriority{ jobs::JobPriority::Visible };
+	};
+
+	// The clips of an animation file retargeted onto `skeleton`.
+	struct AnimationClipSetProperties
+	{
+		std::string path;
+		bool flipUVs{ true };
+		std::shared_ptr<const Skeleton> skeleton{};
+		jobs::JobPriority streamingPriority{ jobs::JobPriority::Visible };
+	};
+
+	std::string MakeSkinnedSourceKey(const SkinnedSourceProperties& properties)
+	{
+		std::string key = "skinned:" + properties.path;
+		key += properties.flipUVs ? "|flip" : "|noflip";
+		key += properties.submeshIndex ? ("|sub=" + std::to_string(*properties.submeshIndex)) : std::string("|sub=all");
+		return key;
+	}
+
+	std::string MakeAnimationClipSetKey(const AnimationClipSetProperties& properties)
+	{
+		std::string key = "anim:" + properties.path;
+		key += properties.flipUVs ? "|flip" : "|noflip";
+		key += "|skel=" + std::to_string(properties.skeleton ? HashSkeletonLayout(*properties.skeleton) : 0u);
+		return key;
+	}
+
+	// CPU-only asset handle: empty until the import finished, immutable afterwards. The payload
+	// is shared by every holder of the handle.
+	template <typename PayloadType, typename PropertiesType>
+	class CpuAssetResource
+	{
+	public:
+		using Payload = PayloadType;
+		using Properties = PropertiesType;
+
+		explicit CpuAssetResource(Properties properties) : properties_(std::move(properties)) {}
+
+		const Properties& GetProperties() const noexcept { return properties_; }
+
+		std::shared_ptr<const Payload> Get() const noexcept { return payload_.load(std::memory_order_acquire); }
+
+		void SetPayload(std::shared_ptr<const Payload> payload) noexcept
+		{
+			payload_.store(std::move(payload), std::memory_order_release);
+		}
+
+	private:
+		Properties properties_;
+		std::atomic<std::shared_ptr<const Payload>> payload_{};
+	};
+
+	// clipSourceAssetIds are empty: the clips are the ones embedded in the source.
+	using SkinnedSourceResource = CpuAssetResource<SkinnedAssetBundle, SkinnedSourceProperties>;
+	// Clips are compressed; the channel counts and diagnostics describe the retarget.
+	using AnimationClipSetResource = CpuAssetResource<AssimpAnimationImportResult, AnimationClipSetProperties>;
+
+	export struct AnimationIO
+	{
+		IJobSystem& jobs;
+
+		// Same contract as TextureIO::cancellation.
+		jobs::CancellationToken cancellation{};
+	};
+
+	std::shared_ptr<const SkinnedAssetBundle> ImportCpuAsset(const SkinnedSourceProperties& properties)
+	{
+		AssimpSkinnedImportResult imported = LoadAssimpSkinnedAsset(properties.path, properties.flipUVs, properties.submeshIndex);
+		auto bundle = std::make_shared<SkinnedAssetBundle>();
+		bundle->debugName = properties.debugName;
+		bundle->mesh = std::move(imported.mesh);
+		bundle->clips = std::move(imported.clips);
+		for (AnimationClip& clip : bundle->clips)
+		{
+			CompressAnimationClip(clip);
+			RebuildClipChannelLayoutHash(clip);
+		}
+		bundle->clipSourceAssetIds.assign(bundle->clips.size(), std::string{});
+		return bundle;
+	}
+
+	std::shared_ptr<const AssimpAnimationImportResult> ImportCpuAsset(const AnimationClipSetProperties& properties)
+	{
+		if (!properties.skeleton)
+		{
+			throw std::runtime_error("Animation clip set '" + properties.path + "' has no target skeleton");
+		}
+
+		auto imported = std::make_shared<AssimpAnimationImportResult>(
+			LoadAssimpAnimationClips(properties.path, *properties.skeleton, properties.flipUVs));
+		for (AnimationClip& clip : imported->clips)
+		{
+			CompressAnimationClip(clip);
+			RebuildClipChannelLayoutHash(clip);
+		}
+		return imported;
+	}
+} // namespace rendern
+
+// Storage of CPU-only assets imported on the job system (no upload step). An entry is
+// imported once however many requests arrive while it is Loading: LoadAsync queues the
+// import, LoadSync claims and runs it on the calling thread unless a worker already started
+// it, in which case it waits for that worker.
+template <typename ResourceType>
+class CpuAssetStorage
+{
+public:
+	using Resource = ResourceType;
+	using Properties = typename Resource::Properties;
+	using Handle = std::shared_ptr<Resource>;
+	using Id = AssetId;
+
+	Handle LoadOrGet(std::string_view id, rendern::AnimationIO& io, Properties properties)
+	{
+		return LoadAsync(id, io, std::move(properties));
+	}
+
+	Handle LoadAsync(std::string_view id, rendern::AnimationIO& io, Properties properties)
+	{
+		Request request = Request_(id, std::move(properties));
+		if (request.import)
+		{
+			Enqueue_(std::move(request), io);
+		}
+		return request.handle;
+	}
+
+	Handle LoadSync(std::string_view id, rendern::AnimationIO&, Properties properties)
+	{
+		while (true)
+		{
+			Request request = Request_(id, properties);
+			if (!request.import)
+			{
+				if (GetState(id) != ResourceState::Loading)
+				{
+					return request.handle;
+				}
+				request.import = PendingImport_(request.key);
+				if (!request.import)
+				{
+					continue; // finished in between
+				}
+			}
+
+			Run_(request);
+			request.import->finished.wait();
+
+			// A worker that found its load cancelled leaves the entry Unloaded: claim it again.
+			if (GetState(id) != ResourceState::Unloaded)
+			{
+				return request.handle;
+			}
+		}
+	}
+
+	Handle Find(std::string_view id) const
+	{
+		const Id key{ id };
+		std::scoped_lock lock(mutex_);
+		if (auto it = entries_.find(key); it != entries_.end())
+		{
+			return it->second.handle;
+		}
+		return {};
+	}
+
+	ResourceState GetState(std::string_view id) const
+	{
+		const Id key{ id };
+		std::scoped_lock lock(mutex_);
+		if (auto it = entries_.find(key); it != entries_.end())
+		{
+			return it->second.state;
+		}
+		return ResourceState::Unknown;
+	}
+
+	const std::string& GetError(std::string_view id) const
+	{
+		static const std::string empty{};
+		const Id key{ id };
+		std::scoped_lock lock(mutex_);
+		if (auto it = entries_.find(key); it != entries_.end())
+		{
+			return it->second.error;
+		}
+		return empty;
+	}
+
+	// Imports in flight hold their handle, so they are never dropped here.
+	void UnloadUnused()
+	{
+		std::scoped_lock lock(mutex_);
+		for (auto it = entries_.begin(); it != entries_.end(); )
+		{
+			if (it->second.handle.use_count() == 1)
+			{
+				it = entries_.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	void Clear()
+	{
+		std::scoped_lock lock(mutex_);
+		entries_.clear();
+	}
+
+private:
+	// One import attempt. Whoever flips `claimed` runs it; everybody else waits on `finished`.
+	struct Import
+	{
+		std::atomic<bool> claimed{ false };
+		std::promise<void> done{};
+		std::shared_future<void> finished{ done.get_future().share() };
+	};
+
+	struct Entry
+	{
+		Handle handle{};
+		ResourceState state{ ResourceState::Unloaded };
+		std::string error{};
+		std::uint64_t generation{ 0 };
+		std::shared_ptr<Import> import{}; // set while Loading
+	};
+
+	// `import` is set when this request started a new attempt.
+	struct Request
+	{
+		Id key{};
+		Handle handle{};
+		std::uint64_t generation{ 0 };
+		std::shared_ptr<Import> import{};
+		jobs::JobPriority priority{ jobs::JobPriority::Visible };
+	};
+
+	Request Request_(std::string_view id, Properties properties)
+	{
+		Request request{};
+		request.key = Id{ id };
+		request.priority = properties.streamingPriority;
+
+		std::scoped_lock lock(mutex_);
+		auto it = entries_.find(request.key);
+		if (it == entries_.end())
+		{
+			Entry entry{};
+			entry.handle = std::make_shared<Resource>(std::move(properties));
+			it = entries_.try_emplace(InternAssetId(id), std::move(entry)).first;
+		}
+
+		Entry& entry = it->second;
+		request.handle = entry.handle;
+		if (entry.state == ResourceState::Loading || entry.state == ResourceState::Loaded)
+		{
+			return request;
+		}
+
+		// New, failed or cancelled: start another attempt with the entry's own properties.
+		entry.state = ResourceState::Loading;
+		entry.error.clear();
+		entry.import = std::make_shared<Import>();
+		request.generation = ++entry.generation;
+		request.import = entry.import;
+		return request;
+	}
+
+	std::shared_ptr<Import> PendingImport_(Id key) const
+	{
+		std::scoped_lock lock(mutex_);
+		if (auto it = entries_.find(key); it != entries_.end() && it->second.state == ResourceState::Loading)
+		{
+			return it->second.import;
+		}
+		return {};
+	}
+
+	void Enqueue_(Request request, rendern::AnimationIO& io)
+	{
+		const jobs::JobPriority priority = request.priority;
+		io.jobs.Enqueue([this, request = std::move(request), cancellation = io.cancellation]() mutable
+			{
+				if (cancellation.IsCancelled())
+				{
+					if (!request.import->claimed.exchange(true))
+					{
+						Finish_(request, nullptr, {}, ResourceState::Unloaded);
+					}
+					return;
+				}
+				Run_(request);
+			}, priority, jobs::CancellationToken{});
+	}
+
+	// Runs the attempt unless somebody else claimed it first.
+	void Run_(const Request& request)
+	{
+		if (request.import->claimed.exchange(true))
+		{
+			return;
+		}
+
+		std::shared_ptr<const typename Resource::Payload> payload;
+		std::string error;
+		try
+		{
+			payload = rendern::ImportCpuAsset(request.handle->GetProperties());
+		}
+		catch (const std::exception& e)
+		{
+			error = e.what();
+		}
+		catch (...)
+		{
+			error = "Unknown import error";
+		}
+
+		const ResourceState state = payload ? ResourceState::Loaded : ResourceState::Failed;
+		Finish_(request, std::move(payload), std::move(error), state);
+	}
+
+	void Finish_(const Request& request, std::shared_ptr<const typename Resource::Payload> payload, std::string error, ResourceState state)
+	{
+		{
+			std::scoped_lock lock(mutex_);
+			auto it = entries_.find(request.key);
+			if (it != entries_.end() && it->second.generation == request.generation)
+			{
+				Entry& entry = it->second;
+				if (payload)
+				{
+					entry.handle->SetPayload(std::move(payload));
+				}
+				entry.state = state;
+				entry.error = std::move(error);
+				entry.import.reset();
+			}
+		}
+		request.import->done.set_value();
+	}
+
+	mutable std::mutex mutex_{};
+	containers::FlatHashMap<Id, Entry, AssetIdHash> entries_;
+};
+
+// Skinned sources and clip sets are shared by every level and instance that names the same
+// file (and, for clips, the same skeleton layout); keys come from MakeSkinnedSourceKey and
+// MakeAnimationClipSetKey.
+export template <>
+class ResourceStorage<rendern::SkinnedSourceResource> : public CpuAssetStorage<rendern::SkinnedSourceResource>
+{
+};
+
+export template <>
+class ResourceStorage<rendern::AnimationClipSetResource> : public CpuAssetStorage<rendern::AnimationClipSetResource>
+{
+};
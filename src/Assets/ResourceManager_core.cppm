@@ -15,18 +15,69 @@ module;
 #include <functional>
 #include <mutex>
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <exception>
+#include <future>
 
 export module core:resource_manager_core;
 
+import :job_system;
+import :asset_id;
+import :flat_hash_map;
+import :async_file_io;
+
 export constexpr int SyncLoadNumberPerCall = 64;
 
 export enum class TextureFormat : uint8_t
 {
 	RGB,
 	RGBA,
-	GRAYSCALE
+	GRAYSCALE,
+
+	// Block-compressed (4x4 blocks), produced by pre-baked containers only.
+	BC1, // RGB(A1), 8 bytes/block
+	BC3, // RGBA, 16 bytes/block
+	BC5, // RG (normal maps), 16 bytes/block
+	BC7  // RGBA, 16 bytes/block
 };
 
+export constexpr bool IsBlockCompressed(TextureFormat format) noexcept
+{
+	return format == TextureFormat::BC1 || format == TextureFormat::BC3
+		|| format == TextureFormat::BC5 || format == TextureFormat::BC7;
+}
+
+// Bytes of one row of texels (uncompressed) or of one row of 4x4 blocks (BC).
+export constexpr std::size_t TextureRowPitchBytes(TextureFormat format, std::uint32_t width) noexcept
+{
+	switch (format)
+	{
+	case TextureFormat::RGB:
+		return static_cast<std::size_t>(width) * 3u;
+	case TextureFormat::RGBA:
+		return static_cast<std::size_t>(width) * 4u;
+	case TextureFormat::GRAYSCALE:
+		return static_cast<std::size_t>(width);
+	case TextureFormat::BC1:
+		return static_cast<std::size_t>((width + 3u) / 4u) * 8u;
+	default:
+		return static_cast<std::size_t>((width + 3u) / 4u) * 16u;
+	}
+}
+
+// Rows of TextureRowPitchBytes in a mip: texel rows, or block rows for BC.
+export constexpr std::uint32_t TextureRowCount(TextureFormat format, std::uint32_t height) noexcept
+{
+	return IsBlockCompressed(format) ? (height + 3u) / 4u : height;
+}
+
+export constexpr std::size_t TextureMipBytes(TextureFormat format, std::uint32_t width, std::uint32_t height) noexcept
+{
+	return TextureRowPitchBytes(format, width) * TextureRowCount(format, height);
+}
+
 export enum class TextureDimension : uint8_t
 {
 	Tex2D,
@@ -75,6 +126,13 @@ export struct TextureProperties
 	bool flipY{ false };
 
 	bool cubeFromCross{ false };
+
+	// 2D only: with mip streaming enabled the first upload may hold just the coarse mip tail,
+	// finer mips follow screen-size feedback. Turn off for textures that must be sharp at once.
+	bool allowMipStreaming{ true };
+
+	// Scheduling class of the decode job (cubemaps/skyboxes typically go to Background).
+	jobs::JobPriority streamingPriority{ jobs::JobPriority::Visible };
 };
 
 
@@ -83,7 +141,8 @@ export struct TextureMipLevel
 	std::uint32_t width{};
 	std::uint32_t height{};
 
-	// Tightly packed pixel data (width * height * channels).
+	// Tightly packed pixel data (width * height * channels), or 4x4 blocks in row order for
+	// BC formats; TextureMipBytes gives the expected size either way.
 	std::vector<unsigned char> pixels{};
 };
 
@@ -111,6 +170,104 @@ export struct GPUTexture
 	unsigned int id{};
 };
 
+// Mip streaming of 2D textures in ResourceStorage<TextureResource>. Off by default: every
+// texture is then uploaded with its whole chain, as before.
+export struct TextureStreamingSettings
+{
+	bool enabled{ false };
+
+	// Bytes all streamed textures may keep resident together (0 = unlimited). When a request
+	// does not fit, the least recently requested textures drop back to their mip tail.
+	std::uint64_t vramBudgetBytes{ 512ull * 1024ull * 1024ull };
+
+	// The first upload holds only the mips whose larger side is <= this (the mip tail), so the
+	// entry turns Loaded after a small upload and is usable right away.
+	std::uint32_t mipTailMaxDimension{ 64 };
+
+	// A texture without screen-size feedback for this many frames falls back to its tail.
+	std::uint32_t evictAfterFrames{ 300 };
+
+	// Re-decodes started per UpdateMipStreaming call.
+	std::uint32_t maxRequestsPerFrame{ 4 };
+};
+
+// First level of the mip tail: the first mip whose larger side is <= maxDimension. BC chains
+// stop at the last block-aligned level (a BC resource's top level must be block aligned).
+export constexpr std::uint32_t MipTailFirstLevel(
+	TextureFormat format,
+	std::uint32_t width,
+	std::uint32_t height,
+	std::uint32_t mipCount,
+	std::uint32_t maxDimension) noexcept
+{
+	std::uint32_t first = 0;
+	while (first + 1 < mipCount)
+	{
+		const std::uint32_t w = std::max(1u, width >> first);
+		const std::uint32_t h = std::max(1u, height >> first);
+		if (std::max(w, h) <= maxDimension)
+		{
+			break;
+		}
+
+		const std::uint32_t nextW = std::max(1u, width >> (first + 1));
+		const std::uint32_t nextH = std::max(1u, height >> (first + 1));
+		if (IsBlockCompressed(format) && (nextW % 4u != 0u || nextH % 4u != 0u))
+		{
+			break;
+		}
+		++first;
+	}
+	return first;
+}
+
+// Coarsest mip that still has at least `screenPixels` texels along the larger side of the
+// base level (`baseDimension`), i.e. the finest mip worth keeping for that footprint.
+export constexpr std::uint32_t MipForScreenSize(std::uint32_t baseDimension, float screenPixels, std::uint32_t mipCount) noexcept
+{
+	if (mipCount == 0)
+	{
+		return 0;
+	}
+
+	std::uint32_t mip = 0;
+	while (mip + 1 < mipCount && static_cast<float>(std::max(1u, baseDimension >> (mip + 1))) >= screenPixels)
+	{
+		++mip;
+	}
+	return mip;
+}
+
+// Bytes of mips [firstMip, mipCount) of a chain with the given base size.
+export constexpr std::uint64_t MipChainBytes(
+	TextureFormat format,
+	std::uint32_t width,
+	std::uint32_t height,
+	std::uint32_t firstMip,
+	std::uint32_t mipCount) noexcept
+{
+	std::uint64_t bytes = 0;
+	for (std::uint32_t mip = firstMip; mip < mipCount; ++mip)
+	{
+		bytes += TextureMipBytes(format, std::max(1u, width >> mip), std::max(1u, height >> mip));
+	}
+	return bytes;
+}
+
+// Drops the `count` finest levels of a 2D chain; the next level becomes the base.
+export inline void DropTopMips(TextureCPUData& cpu, std::uint32_t count)
+{
+	count = std::min<std::uint32_t>(count, cpu.mips.empty() ? 0u : static_cast<std::uint32_t>(cpu.mips.size() - 1));
+	if (count == 0)
+	{
+		return;
+	}
+
+	cpu.mips.erase(cpu.mips.begin(), cpu.mips.begin() + count);
+	cpu.width = cpu.mips.front().width;
+	cpu.height = cpu.mips.front().height;
+}
+
 export struct ResourceStreamingStats
 {
 	std::uint32_t totalEntries{};
@@ -120,10 +277,30 @@ export struct ResourceStreamingStats
 	std::uint32_t pendingCpuEntries{};
 	std::uint32_t queuedUploads{};
 	std::uint32_t queuedDestroys{};
+	std::uint32_t gpuPendingUploads{};
+
+	// Work done by the last ProcessUploads call and the calibrated cost model behind it.
+	std::uint32_t lastUploadItems{};
+	std::uint64_t lastUploadBytes{};
+	float lastUploadEstimatedMicroseconds{};
+	float microsecondsPerMiB{};
+
+	// Mip streaming (textures only): bytes held by streamed textures and mip-range changes
+	// still decoding or queued for upload. Not counted as pending loads.
+	std::uint64_t streamedResidentBytes{};
+	std::uint32_t pendingMipStreams{};
+
+	// Residency (ResidencyManager): GPU bytes of Loaded entries, entries whose GPU copy was
+	// evicted (reloaded when drawn again), the configured budget (0 = unlimited) and the
+	// evictions done by the last update.
+	std::uint64_t residentBytes{};
+	std::uint32_t evictedEntries{};
+	std::uint64_t residencyBudgetBytes{};
+	std::uint32_t lastEvictions{};
 
 	[[nodiscard]] bool HasPendingWork() const noexcept
 	{
-		return loadingEntries > 0u || pendingCpuEntries > 0u || queuedUploads > 0u;
+		return loadingEntries > 0u || pendingCpuEntries > 0u || queuedUploads > 0u || gpuPendingUploads > 0u;
 	}
 
 	[[nodiscard]] float Completion01() const noexcept
@@ -138,11 +315,117 @@ export struct ResourceStreamingStats
 	}
 };
 
+// Per-frame upload limits shared by all storages drained in one frame. Zero disables a limit.
+// Each storage always takes its first queued item even if it alone exceeds what is left,
+// otherwise a single huge texture (or meshes behind a texture burst) would never upload.
+export struct StreamingUploadBudget
+{
+	std::uint64_t maxBytes{ 0 };
+	std::uint32_t maxMicroseconds{ 0 };
+};
+
+// Running estimate of upload cost: fixed per-item overhead + time per byte. The per-byte term
+// is refined from measured uploads (exponential moving average), so the time budget tracks
+// what the device actually does instead of a hard-coded bandwidth.
+export class UploadCostModel
+{
+public:
+	static constexpr float kFixedMicrosecondsPerItem = 20.0f;
+	static constexpr float kInitialMicrosecondsPerByte = 1.0f / 2000.0f; // ~2 GB/s
+	static constexpr float kSmoothing = 0.125f;
+
+	[[nodiscard]] float EstimateMicroseconds(std::uint64_t bytes) const noexcept
+	{
+		return kFixedMicrosecondsPerItem + static_cast<float>(bytes) * microsecondsPerByte_.load(std::memory_order_relaxed);
+	}
+
+	// Called from the render queue after an upload (or a batch of `items` uploads) finished.
+	void Record(std::uint64_t bytes, std::uint32_t items, float measuredMicroseconds) noexcept
+	{
+		if (bytes == 0)
+		{
+			return;
+		}
+
+		const float variable = std::max(measuredMicroseconds - kFixedMicrosecondsPerItem * static_cast<float>(items), 0.0f);
+		const float sample = variable / static_cast<float>(bytes);
+		const float current = microsecondsPerByte_.load(std::memory_order_relaxed);
+		microsecondsPerByte_.store(current + (sample - current) * kSmoothing, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] float MicrosecondsPerMiB() const noexcept
+	{
+		return microsecondsPerByte_.load(std::memory_order_relaxed) * 1024.0f * 1024.0f;
+	}
+
+private:
+	std::atomic<float> microsecondsPerByte_{ kInitialMicrosecondsPerByte };
+};
+
+// Tracks how much of a StreamingUploadBudget has been spent this frame.
+export struct UploadBudgetTracker
+{
+	StreamingUploadBudget budget{};
+	std::uint32_t items{};
+	std::uint64_t bytes{};
+	float estimatedMicroseconds{};
+
+	[[nodiscard]] bool Allows(std::uint64_t itemBytes, float itemMicroseconds) const noexcept
+	{
+		if (budget.maxBytes != 0 && bytes + itemBytes > budget.maxBytes)
+		{
+			return false;
+		}
+		if (budget.maxMicroseconds != 0 && estimatedMicroseconds + itemMicroseconds > static_cast<float>(budget.maxMicroseconds))
+		{
+			return false;
+		}
+		return true;
+	}
+
+	void Consume(std::uint64_t itemBytes, float itemMicroseconds) noexcept
+	{
+		++items;
+		bytes += itemBytes;
+		estimatedMicroseconds += itemMicroseconds;
+	}
+};
+
+export inline std::uint64_t EstimateUploadBytes(const TextureCPUData& cpu) noexcept
+{
+	std::uint64_t bytes = 0;
+	for (const TextureMipLevel& mip : cpu.mips)
+	{
+		bytes += mip.pixels.size();
+	}
+	for (const auto& faceMips : cpu.cubeMips)
+	{
+		for (const TextureMipLevel& mip : faceMips)
+		{
+			bytes += mip.pixels.size();
+		}
+	}
+	return bytes;
+}
+
 export class ITextureDecoder
 {
 public:
 	virtual ~ITextureDecoder() = default;
 	virtual std::optional<TextureCPUData> Decode(const TextureProperties& properties, std::string_view resolvedPath) = 0;
+
+	// Files Decode would read, in order. A decoder that lists them lets the storage read them
+	// ahead on TextureIO::files and decode with DecodeFromMemory, so the decode job never waits
+	// on the disk. Empty: Decode reads its own files.
+	virtual std::vector<std::string> SourceFiles(const TextureProperties&, std::string_view) const { return {}; }
+
+	virtual std::optional<TextureCPUData> DecodeFromMemory(
+		const TextureProperties& properties,
+		std::string_view resolvedPath,
+		std::span<const std::span<const std::byte>>)
+	{
+		return Decode(properties, resolvedPath);
+	}
 };
 
 export class ITextureUploader
@@ -153,6 +436,11 @@ public:
 	virtual void EndUploadBatch() {}
 	virtual std::optional<GPUTexture> CreateAndUpload(const TextureCPUData& cpuData, const TextureProperties& properties) = 0;
 	virtual void Destroy(GPUTexture texture) noexcept = 0;
+
+	// Asynchronous uploaders (DX12 copy queue) may return from CreateAndUpload/EndUploadBatch
+	// before the GPU copy finished. The storage keeps such textures in Loading, without a
+	// resource, until this reports true. Polled on the render queue.
+	virtual bool IsUploadComplete(GPUTexture) { return true; }
 };
 
 export class IJobSystem
@@ -160,9 +448,92 @@ export class IJobSystem
 public:
 	virtual ~IJobSystem() = default;
 	virtual void Enqueue(std::function<void()> job) = 0;
+
+	// Priority/cancellation aware submission. A job whose token is cancelled before it
+	// starts is dropped. Implementations without priority classes ignore the priority.
+	virtual void Enqueue(std::function<void()> job, jobs::JobPriority priority, jobs::CancellationToken cancellation)
+	{
+		(void)priority;
+		Enqueue([job = std::move(job), cancellation = std::move(cancellation)]()
+			{
+				if (!cancellation.IsCancelled())
+				{
+					job();
+				}
+			});
+	}
+
 	virtual void WaitIdle() = 0;
 };
 
+// Runs task(i) for every i in [0, count) on `jobs` and the calling thread, returns when all of
+// them are done and rethrows the first exception. The caller claims tasks from the same counter
+// as the helper jobs and only waits for tasks that already started, so this is safe from inside a
+// job of the same (possibly fully busy) system. Null jobs or a single task run inline.
+export void RunSubtasks(IJobSystem* jobs, std::size_t count, std::function<void(std::size_t)> task)
+{
+	if (jobs == nullptr || count <= 1)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			task(i);
+		}
+		return;
+	}
+
+	struct State
+	{
+		std::function<void(std::size_t)> task;
+		std::size_t count{ 0 };
+		std::atomic<std::size_t> next{ 0 };
+		std::atomic<std::size_t> done{ 0 };
+		std::mutex errorMutex;
+		std::exception_ptr error;
+
+		void Drain()
+		{
+			for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed))
+			{
+				try
+				{
+					task(i);
+				}
+				catch (...)
+				{
+					std::scoped_lock lock(errorMutex);
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+				}
+				if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == count)
+				{
+					done.notify_all();
+				}
+			}
+		}
+	};
+
+	// Helpers that start after everything was claimed only touch the shared state.
+	auto state = std::make_shared<State>();
+	state->task = std::move(task);
+	state->count = count;
+	for (std::size_t helper = 1; helper < count; ++helper)
+	{
+		jobs->Enqueue([state] { state->Drain(); });
+	}
+	state->Drain();
+
+	for (std::size_t done = state->done.load(std::memory_order_acquire); done != count; done = state->done.load(std::memory_order_acquire))
+	{
+		state->done.wait(done, std::memory_order_acquire);
+	}
+	if (state->error)
+	{
+		std::rethrow_exception(state->error);
+	}
+}
+
 export class IRenderQueue
 {
 public:
@@ -176,6 +547,54 @@ export struct TextureIO
 	ITextureUploader& uploader;
 	IJobSystem& jobs;
 	IRenderQueue& render;
+
+	// Cancels every decode requested through this IO (e.g. on level switch). Entries whose
+	// decode was dropped go back to Unloaded and restart on the next LoadAsync.
+	jobs::CancellationToken cancellation{};
+
+	// Optional read-ahead for decoders that list their SourceFiles (null: decoders read on the
+	// decode worker).
+	corefs::AsyncFileReader* files{ nullptr };
+};
+
+// Residency budgets of ResidencyManager. Off by default: nothing is evicted while a handle is
+// alive, as before.
+export struct ResidencySettings
+{
+	bool enabled{ false };
+
+	// GPU bytes each storage may keep resident (0 = unlimited).
+	std::uint64_t textureBudgetBytes{ 1536ull * 1024ull * 1024ull };
+	std::uint64_t meshBudgetBytes{ 512ull * 1024ull * 1024ull };
+
+	// Resources drawn within this many updates are never evicted, however far over budget.
+	std::uint32_t minUnusedFrames{ 120 };
+
+	std::uint32_t maxEvictionsPerFrame{ 16 };
+};
+
+// Resident entry as seen by ResidencyManager.
+export struct ResidencyCandidate
+{
+	AssetId id{};
+	std::uint64_t bytes{};
+	std::uint64_t lastUsedFrame{};
+};
+
+// "Drawn since the last residency update" flag of a resource. The renderer marks it while
+// packing draws (any thread); ResidencyManager consumes it once per update. Copies start clear.
+export class ResidencyUsage
+{
+public:
+	ResidencyUsage() = default;
+	ResidencyUsage(const ResidencyUsage&) noexcept {}
+	ResidencyUsage& operator=(const ResidencyUsage&) noexcept { return *this; }
+
+	void Mark() const noexcept { used_.store(true, std::memory_order_relaxed); }
+	bool Consume() const noexcept { return used_.exchange(false, std::memory_order_relaxed); }
+
+private:
+	mutable std::atomic<bool> used_{ false };
 };
 
 export template <class Resource>
@@ -196,6 +615,9 @@ public:
 	const Properties& GetProperties() const { return properties_; }
 	const Resource& GetResource() const { return resource_; }
 
+	void MarkUsed() const noexcept { usage_.Mark(); }
+	bool ConsumeUsed() const noexcept { return usage_.Consume(); }
+
 	template<typename PropertiesType>
 		requires std::same_as<std::remove_cvref_t<PropertiesType>, Properties>
 	void SetProperties(PropertiesType&& inProperties)
@@ -213,6 +635,7 @@ public:
 private:
 	Resource resource_{};
 	Properties properties_{};
+	ResidencyUsage usage_{};
 };
 
 template <typename T>
@@ -223,7 +646,9 @@ concept TexturePropertyType = requires(const T & propertyType)
 	{ propertyType.format } -> std::convertible_to<TextureFormat>;
 };
 
-template<typename T>
+// Specialize with `static std::shared_ptr<T> Load(std::string_view id, Args...)` to load T through the
+// generic ResourceStorage.
+export template<typename T>
 struct ResourceTraits;
 
 template <typename ResourceType>
@@ -232,44 +657,145 @@ class ResourceStorage
 public:
 	using Handle = std::shared_ptr<ResourceType>;
 	using WeakHandle = std::weak_ptr<ResourceType>;
-	using Id = std::string;
+	using Id = AssetId;
 
+	// Concurrent requests for the same id share one Load: the first caller loads outside the lock,
+	// the others block on its in-flight future and get the same handle (or its exception).
+	// A Load must not request its own id again.
 	template <typename... Args>
 	Handle LoadOrGet(std::string_view id, Args&&... args)
-		requires requires(const Id& sid)
+		requires requires(std::string_view sid)
 	{
 		{ ResourceTraits<ResourceType>::Load(sid, std::forward<Args>(args)...) } ->std::same_as<Handle>;
 	}
 	{
-		Id key{ id };
+		const Id key{ id };
+		Handle alive;
+		std::shared_future<Handle> pending;
+		std::promise<Handle> promise;
+		{
+			std::scoped_lock lock(mutex_);
+			if (!AcquireLocked_(key, id, promise, alive, pending))
+			{
+				return alive;
+			}
+		}
+
+		if (pending.valid())
+		{
+			return pending.get();
+		}
+
+		std::exception_ptr error;
+		Handle resource = LoadOwned_(id, error, std::forward<Args>(args)...);
+		{
+			std::scoped_lock lock(mutex_);
+			PublishLocked_(key, id, resource, error);
+		}
+		ResolveOwned_(promise, resource, error);
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+		return resource;
+	}
+
+	// LoadOrGet for many ids with one lock round trip for the lookups and one for publishing the
+	// loads this call owns. Results follow `ids`; `args` are passed to every Load. The first load
+	// error is rethrown after every id was resolved.
+	template <typename... Args>
+	std::vector<Handle> LoadOrGetMany(std::span<const std::string_view> ids, Args&... args)
+		requires requires(std::string_view sid)
+	{
+		{ ResourceTraits<ResourceType>::Load(sid, args...) } ->std::same_as<Handle>;
+	}
+	{
+		struct Request
+		{
+			Handle alive{};
+			std::shared_future<Handle> pending{};
+			std::promise<Handle> promise{};
+			bool owned{ false };
+			std::exception_ptr error{};
+		};
+
+		std::vector<Request> requests(ids.size());
+		{
+			std::scoped_lock lock(mutex_);
+			for (std::size_t i = 0; i < ids.size(); ++i)
+			{
+				Request& r = requests[i];
+				r.owned = AcquireLocked_(Id{ ids[i] }, ids[i], r.promise, r.alive, r.pending) && !r.pending.valid();
+			}
+		}
 
-		// Fast path: return an alive cached resource.
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			Request& r = requests[i];
+			if (r.owned)
+			{
+				r.alive = LoadOwned_(ids[i], r.error, args...);
+			}
+		}
+
+		std::exception_ptr firstError;
 		{
 			std::scoped_lock lock(mutex_);
-			if (auto it = cache_.find(key); it != cache_.end())
+			for (std::size_t i = 0; i < ids.size(); ++i)
 			{
-				if (auto alive = it->second.lock())
+				if (requests[i].owned)
 				{
-					return alive;
+					PublishLocked_(Id{ ids[i] }, ids[i], requests[i].alive, requests[i].error);
 				}
-				cache_.erase(it);
 			}
 		}
 
-		// Slow path: load outside the lock.
-		Handle resource = ResourceTraits<ResourceType>::Load(key, std::forward<Args>(args)...);
+		// Owned results are resolved before waiting, so repeated ids in `ids` can't deadlock.
+		std::vector<Handle> out(ids.size());
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			Request& r = requests[i];
+			if (r.owned)
+			{
+				ResolveOwned_(r.promise, r.alive, r.error);
+				if (r.error && !firstError)
+				{
+					firstError = r.error;
+				}
+			}
+		}
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			Request& r = requests[i];
+			if (r.pending.valid())
+			{
+				try
+				{
+					r.alive = r.pending.get();
+				}
+				catch (...)
+				{
+					if (!firstError)
+					{
+						firstError = std::current_exception();
+					}
+				}
+			}
+			out[i] = std::move(r.alive);
+		}
 
+		if (firstError)
 		{
-			std::scoped_lock lock(mutex_);
-			cache_[std::move(key)] = resource;
+			std::rethrow_exception(firstError);
 		}
-		return resource;
+		return out;
 	}
 
-	Handle Find(const Id& id) const
+	Handle Find(std::string_view id) const
 	{
+		const Id key{ id };
 		std::scoped_lock lock(mutex_);
-		if (auto it = cache_.find(id); it != cache_.end())
+		if (auto it = cache_.find(key); it != cache_.end())
 		{
 			return it->second.lock();
 		}
@@ -292,6 +818,7 @@ public:
 		}
 	}
 
+	// Loads in flight are not cancelled; they publish into the cleared cache when they finish.
 	void Clear()
 	{
 		std::scoped_lock lock(mutex_);
@@ -299,14 +826,77 @@ public:
 	}
 
 private:
+	// Under mutex_. False: `alive` holds the cached resource. True: the caller either waits on
+	// `pending` (another load is in flight) or, with `pending` left empty, owns the load and
+	// `promise` was registered as the id's in-flight future.
+	bool AcquireLocked_(const Id& key, std::string_view id, std::promise<Handle>& promise,
+		Handle& alive, std::shared_future<Handle>& pending)
+	{
+		if (auto it = cache_.find(key); it != cache_.end())
+		{
+			if ((alive = it->second.lock()))
+			{
+				return false;
+			}
+			cache_.erase(it);
+		}
+
+		if (auto it = inFlight_.find(key); it != inFlight_.end())
+		{
+			pending = it->second;
+			return true;
+		}
+
+		inFlight_.try_emplace(InternAssetId(id), promise.get_future().share());
+		return true;
+	}
+
+	template <typename... Args>
+	static Handle LoadOwned_(std::string_view id, std::exception_ptr& error, Args&&... args)
+	{
+		try
+		{
+			return ResourceTraits<ResourceType>::Load(id, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+			return {};
+		}
+	}
+
+	// Under mutex_. Failed loads leave no cache entry, so the next request retries.
+	void PublishLocked_(const Id& key, std::string_view id, const Handle& resource, const std::exception_ptr& error)
+	{
+		if (!error)
+		{
+			cache_.insert_or_assign(InternAssetId(id), WeakHandle(resource));
+		}
+		inFlight_.erase(key);
+	}
+
+	static void ResolveOwned_(std::promise<Handle>& promise, const Handle& resource, const std::exception_ptr& error)
+	{
+		if (error)
+		{
+			promise.set_exception(error);
+		}
+		else
+		{
+			promise.set_value(resource);
+		}
+	}
+
 	mutable std::mutex mutex_{};
-	std::unordered_map<Id, WeakHandle> cache_;
+	containers::FlatHashMap<Id, WeakHandle, AssetIdHash> cache_;
+	// Loads running outside the lock; waiters share the owner's result.
+	containers::FlatHashMap<Id, std::shared_future<Handle>, AssetIdHash> inFlight_;
 };
 
 export class ResourceManager
 {
 public:
-	using Id = std::string;
+	using Id = AssetId;
 
 	template <typename T, typename... Args>
 	std::shared_ptr<T> Load(std::string_view id, Args&&... argss)
@@ -314,6 +904,13 @@ public:
 		return storage<T>().LoadOrGet(id, std::forward<Args>(argss)...);
 	}
 
+	// Results follow `ids`; see ResourceStorage::LoadOrGetMany.
+	template <typename T, typename... Args>
+	std::vector<std::shared_ptr<T>> LoadMany(std::span<const std::string_view> ids, Args&... args)
+	{
+		return storage<T>().LoadOrGetMany(ids, args...);
+	}
+
 	template <typename T, typename... Args>
 	std::shared_ptr<T> LoadAsync(std::string_view id, Args&&... args)
 	{
@@ -346,7 +943,7 @@ public:
 	template <typename T>
 	std::shared_ptr<T> Get(std::string_view id)
 	{
-		return storage<T>().Find(Id{ id });
+		return storage<T>().Find(id);
 	}
 
 	// Optional helpers for storages that expose extended APIs.
@@ -16,15 +16,28 @@ module;
 #include <functional>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <array>
+#include <span>
 
 export module core:resource_manager_mesh;
 
 import :resource_manager_core;
 import :mesh;
+import :mesh_lod;
+import :mesh_optimize;
+import :meshlet;
+import :render_gpu_memory;
+import :cooked_mesh;
 import :math_utils;
 import :obj_loader;
 import :assimp_loader;
 import :file_system;
+import :job_system;
+import :mpsc_queue;
+import :asset_id;
+import :flat_hash_map;
+import :memory_tracking;
 
 // NOTE: Mesh loading is CPU-side (ObjLoader) and does NOT touch the renderer.
 // GPU upload/destruction is deferred via IRenderQueue (same pattern as textures).
@@ -46,6 +59,27 @@ export namespace rendern
 		bool flipUVs{ true };
 		std::optional<std::uint32_t> submeshIndex{};
 		bool bakeNodeTransforms{ true };
+
+		// Scheduling class of the import job.
+		jobs::JobPriority streamingPriority{ jobs::JobPriority::Visible };
+
+		// Load from / write to the cooked .cmesh cache (see CookedMesh.cppm).
+		bool useCookedCache{ true };
+
+		// Simplified levels of detail are generated on import and cooked with the mesh (see MeshLod.cppm).
+		bool generateLods{ true };
+
+		// Vertex cache / overdraw / vertex fetch ordering on import (see MeshOptimize.cppm).
+		bool optimizeVertexOrder{ true };
+
+		// Upload as VertexCompact (20 instead of 48 bytes per vertex). DX12 only; other backends
+		// and the shared GeometryPool keep VertexDesc. Not part of the cook key: the cooked
+		// mesh stays VertexDesc and is encoded at upload.
+		bool compactVertices{ false };
+
+		// Meshlets for the mesh-shader path (see Meshlet.cppm), built after import or cooked-mesh
+		// mapping when the device supports mesh shaders. Not cooked: rebuilding them is cheap.
+		bool buildMeshlets{ true };
 	};
 
 
@@ -73,9 +107,18 @@ export namespace rendern
 		}
 
 		const Properties& GetProperties() const noexcept { return properties_; }
-		const MeshRHI& GetResource() const noexcept { return resource_; }
+		// Level 0 (full detail).
+		const MeshRHI& GetResource() const noexcept { return lods_[0]; }
 		const MeshBounds& GetBounds() const noexcept { return bounds_; }
 
+		// The same buffers drawing level `lod`'s index range (clamped to the coarsest level).
+		const MeshRHI& GetLodResource(std::uint32_t lod) const noexcept { return lods_[std::min(lod, lodCount_ - 1u)]; }
+		std::uint32_t GetLodCount() const noexcept { return lodCount_; }
+
+		// Residency: set by the renderer for drawn meshes (see ResidencyUsage).
+		void MarkUsed() const noexcept { usage_.Mark(); }
+		bool ConsumeUsed() const noexcept { return usage_.Consume(); }
+
 		void SetBounds(const MeshBounds& b) noexcept { bounds_ = b; }
 
 		template <typename PropertiesType>
@@ -85,18 +128,54 @@ export namespace rendern
 			properties_ = std::forward<PropertiesType>(inProperties);
 		}
 
-		// Replace the GPU resource and return the previous value.
-		MeshRHI ReplaceResource(MeshRHI&& inResource) noexcept
+		// Replace the GPU resource and return the previous value. `lods` are index ranges of the new
+		// resource (MeshCPU::lods); empty or out of range ones leave its whole index buffer as the only level.
+		// `meshletLods` (MeshletData::lods) pick each level's meshlets; a level without one draws no meshlets.
+		MeshRHI ReplaceResource(MeshRHI&& inResource, std::span<const MeshLod> lods = {}, std::span<const MeshletRange> meshletLods = {}) noexcept
 		{
 			MeshRHI old = std::move(resource_);
 			resource_ = std::move(inResource);
+
+			lodCount_ = 0;
+			for (const MeshLod& lod : lods.first(std::min<std::size_t>(lods.size(), kMaxMeshLods)))
+			{
+				if (lod.indexCount == 0 || lod.firstIndex > resource_.indexCount || lod.indexCount > resource_.indexCount - lod.firstIndex)
+				{
+					lodCount_ = 0;
+					break;
+				}
+				MeshRHI& view = lods_[lodCount_];
+				view = resource_;
+				view.firstIndex += lod.firstIndex;
+				view.indexCount = lod.indexCount;
+				SetMeshletRange_(view, meshletLods, lodCount_);
+				++lodCount_;
+			}
+			if (lodCount_ == 0)
+			{
+				lods_[0] = resource_;
+				lodCount_ = 1;
+				// The whole index buffer: only matches the meshlets when there is a single level.
+				SetMeshletRange_(lods_[0], (meshletLods.size() == 1) ? meshletLods : std::span<const MeshletRange>{}, 0);
+			}
 			return old;
 		}
 
 	private:
+		static void SetMeshletRange_(MeshRHI& view, std::span<const MeshletRange> meshletLods, std::uint32_t lod) noexcept
+		{
+			const bool valid = view.meshletBuffer && lod < meshletLods.size()
+				&& meshletLods[lod].firstMeshlet + meshletLods[lod].meshletCount <= view.meshletCount;
+			view.firstMeshlet = valid ? meshletLods[lod].firstMeshlet : 0u;
+			view.meshletCount = valid ? meshletLods[lod].meshletCount : 0u;
+		}
+
 		MeshRHI resource_{};
+		std::array<MeshRHI, kMaxMeshLods> lods_{};
+		std::uint32_t lodCount_{ 1 };
 		Properties properties_{};
 		MeshBounds bounds_{};
+		ResidencyUsage usage_{};
 	};
 
 	export struct MeshIO
@@ -104,6 +183,16 @@ export namespace rendern
 		rhi::IRHIDevice& device;
 		IJobSystem& jobs;
 		IRenderQueue& render;
+
+		// Same contract as TextureIO::cancellation.
+		jobs::CancellationToken cancellation{};
+
+		// Optional: vertex/index buffers are sub-allocated from it instead of created one by one.
+		// Used on the render queue only; must outlive every mesh uploaded through it.
+		renderer::IGPUMemoryAllocator* allocator{ nullptr };
+
+		// Optional, tried before `allocator`: meshes become ranges of its shared buffers.
+		GeometryPool* geometry{ nullptr };
 	};
 }
 
@@ -116,16 +205,45 @@ namespace rendern
 		Handle meshHandle;
 		ResourceState state{ ResourceState::Unloaded };
 		std::uint64_t generation{ 0 };
-		std::optional<MeshCPU> pendingCpu{};
 		std::string error{};
+
+		// Path handed to the importer (filePath, or the id when that is empty).
+		std::string sourcePath{};
+
+		// Residency (see TextureEntry).
+		std::uint64_t gpuBytes{ 0 };
+		std::uint64_t lastUsedFrame{ 0 };
+		bool evicted{ false };
+
+		// Cancelled when the entry is restarted or dropped (see TextureEntry::cancel).
+		jobs::CancellationSource cancel{};
 	};
 
+	// Imported payload handed from a job worker to ProcessUploads without taking the storage lock.
+	// Either owns a fresh import (`cpu`) or views a mapped cooked mesh (`cooked`).
 	struct MeshUploadTicket
 	{
-		std::string id;
+		AssetId id{};
 		std::uint64_t generation{};
+		MeshCPU cpu{};
+		std::optional<CookedMesh> cooked{};
+		MeshBounds bounds{};
+		// Empty unless MeshProperties::buildMeshlets and the device supports mesh shaders.
+		MeshletData meshlets{};
+		// Owned import data charged to the mesh budget until the ticket is consumed (cooked meshes are mapped).
+		memory::TrackedBytes cpuBytes{ memory::MemoryTag::Meshes };
+
+		std::span<const VertexDesc> Vertices() const noexcept { return cooked ? cooked->Vertices() : std::span<const VertexDesc>(cpu.vertices); }
+		std::span<const std::uint32_t> Indices() const noexcept { return cooked ? cooked->Indices() : std::span<const std::uint32_t>(cpu.indices); }
+		std::span<const MeshLod> Lods() const noexcept { return cooked ? cooked->Lods() : std::span<const MeshLod>(cpu.lods); }
 	};
 
+	std::uint64_t EstimateUploadBytes(const MeshUploadTicket& ticket) noexcept
+	{
+		return static_cast<std::uint64_t>(ticket.Vertices().size()) * sizeof(VertexDesc)
+			+ static_cast<std::uint64_t>(ticket.Indices().size()) * sizeof(std::uint32_t);
+	}
+
 	std::string DefaultDebugNameFromPath(std::string_view path)
 	{
 		try
@@ -164,6 +282,144 @@ namespace rendern
 		b.sphereRadius = mathUtils::Length(ext);
 		return b;
 	}
+
+	CookedMeshBounds ToCookedBounds(const MeshBounds& b) noexcept
+	{
+		CookedMeshBounds out{};
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			out.aabbMin[i] = b.aabbMin[i];
+			out.aabbMax[i] = b.aabbMax[i];
+			out.sphereCenter[i] = b.sphereCenter[i];
+		}
+		out.sphereRadius = b.sphereRadius;
+		return out;
+	}
+
+	MeshBounds FromCookedBounds(const CookedMeshBounds& b) noexcept
+	{
+		MeshBounds out{};
+		out.aabbMin = mathUtils::Vec3(b.aabbMin[0], b.aabbMin[1], b.aabbMin[2]);
+		out.aabbMax = mathUtils::Vec3(b.aabbMax[0], b.aabbMax[1], b.aabbMax[2]);
+		out.sphereCenter = mathUtils::Vec3(b.sphereCenter[0], b.sphereCenter[1], b.sphereCenter[2]);
+		out.sphereRadius = b.sphereRadius;
+		return out;
+	}
+
+	// Import settings that change the produced MeshCPU; part of the cook key.
+	std::array<std::byte, 8> MeshImportSettingsBytes(const MeshProperties& props) noexcept
+	{
+		const std::uint32_t submesh = props.submeshIndex.value_or(0u);
+		return {
+			static_cast<std::byte>(props.flipUVs ? 1 : 0),
+			static_cast<std::byte>(props.bakeNodeTransforms ? 1 : 0),
+			static_cast<std::byte>(props.submeshIndex.has_value() ? 1 : 0),
+			static_cast<std::byte>((props.generateLods ? 1 : 0) | (props.optimizeVertexOrder ? 2 : 0)),
+			static_cast<std::byte>(submesh & 0xFFu),
+			static_cast<std::byte>((submesh >> 8) & 0xFFu),
+			static_cast<std::byte>((submesh >> 16) & 0xFFu),
+			static_cast<std::byte>((submesh >> 24) & 0xFFu),
+		};
+	}
+
+	std::uint64_t MeshCookSettingsKey(const MeshProperties& props) noexcept
+	{
+		return HashCookBytes(MeshImportSettingsBytes(props));
+	}
+
+	// Parses the source file (OBJ through ObjLoader, everything else through Assimp), appends
+	// the generated levels of detail and reorders indices and vertices for the GPU.
+	MeshCPU ImportMeshSource(const std::filesystem::path& abs, const MeshProperties& props)
+	{
+		std::string ext = abs.extension().string();
+		for (char& c : ext)
+		{
+			c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		}
+
+		MeshCPU cpu = (ext == ".obj")
+			? LoadObj(abs)
+			: LoadAssimp(abs, props.flipUVs, props.submeshIndex, props.bakeNodeTransforms);
+		if (props.generateLods)
+		{
+			GenerateMeshLods(cpu);
+		}
+		if (props.optimizeVertexOrder)
+		{
+			OptimizeMesh(cpu);
+		}
+		return cpu;
+	}
+
+	struct CookedMeshArtifact
+	{
+		std::uint64_t cookKey{ 0 };
+		std::filesystem::path path{};
+	};
+
+	// Offline side of the cache (ResourceCooker): makes sure the .cmesh for this source and
+	// settings exists and returns it. Unlike ImportMesh, a failed write is an error here.
+	CookedMeshArtifact CookMesh(const std::filesystem::path& abs, const MeshProperties& props)
+	{
+		CookedMeshArtifact artifact{};
+		artifact.cookKey = ComputeMeshCookKey(abs, MeshImportSettingsBytes(props));
+		artifact.path = CookedMeshPath(artifact.cookKey);
+		if (!OpenCookedMesh(artifact.path, artifact.cookKey))
+		{
+			const MeshCPU cpu = ImportMeshSource(abs, props);
+			WriteCookedMesh(artifact.path, artifact.cookKey, cpu, ToCookedBounds(ComputeMeshBounds(cpu)));
+		}
+		return artifact;
+	}
+
+	// Fills ticket.cpu or ticket.cooked plus ticket.bounds. A .cmesh path (AssetManager
+	// redirected the load through the cooked manifest) is mapped directly. Otherwise a valid
+	// cooked mesh for the same source bytes and settings is mapped instead of re-importing, or
+	// the source is imported and cooked for next time. A failed cook write is not a load failure.
+	void ImportMesh(const std::filesystem::path& abs, const MeshProperties& props, MeshUploadTicket& ticket)
+	{
+		if (abs.extension() == ".cmesh")
+		{
+			std::optional<CookedMesh> cooked = OpenCookedMesh(abs, std::nullopt);
+			if (!cooked)
+			{
+				throw std::runtime_error("Malformed cooked mesh: " + abs.string());
+			}
+			ticket.bounds = FromCookedBounds(cooked->Bounds());
+			ticket.cooked = std::move(cooked);
+			return;
+		}
+
+		std::uint64_t cookKey = 0;
+		std::filesystem::path cookedPath{};
+		if (props.useCookedCache)
+		{
+			const auto settings = MeshImportSettingsBytes(props);
+			cookKey = ComputeMeshCookKey(abs, settings);
+			cookedPath = CookedMeshPath(cookKey);
+			if (std::optional<CookedMesh> cooked = OpenCookedMesh(cookedPath, cookKey))
+			{
+				ticket.bounds = FromCookedBounds(cooked->Bounds());
+				ticket.cooked = std::move(cooked);
+				return;
+			}
+		}
+
+		ticket.cpu = ImportMeshSource(abs, props);
+		ticket.bounds = ComputeMeshBounds(ticket.cpu);
+
+		if (props.useCookedCache)
+		{
+			try
+			{
+				WriteCookedMesh(cookedPath, cookKey, ticket.cpu, ToCookedBounds(ticket.bounds));
+			}
+			catch (...)
+			{
+				// Read-only asset tree or full disk: keep serving the fresh import.
+			}
+		}
+	}
 } // namespace rendern
 
 export template <>
@@ -178,7 +434,7 @@ public:
 	using MeshEntry = rendern::MeshEntry;
 	using MeshUploadTicket = rendern::MeshUploadTicket;
 	using Handle = std::shared_ptr<Resource>;
-	using Id = std::string;
+	using Id = AssetId;
 
 	template <typename PropertiesType>
 		requires std::same_as<std::remove_cvref_t<PropertiesType>, typename Resource::Properties>
@@ -191,9 +447,11 @@ public:
 		requires std::same_as<std::remove_cvref_t<PropertiesType>, typename Resource::Properties>
 	Handle LoadAsync(std::string_view id, MeshIO& io, PropertiesType&& properties)
 	{
-		Id stableKey = Id{ id };
+		const Id stableKey{ id };
 		Handle handle{};
 		std::uint64_t generation{};
+		jobs::CancellationToken entryToken{};
+		std::string path{};
 
 		{
 			std::scoped_lock lock(mutex_);
@@ -203,18 +461,23 @@ public:
 				handle = existing.meshHandle;
 
 				// If already loading/loaded, just return.
-				if (existing.state != ResourceState::Failed)
+				if (existing.state != ResourceState::Failed && existing.state != ResourceState::Unloaded)
 				{
 					return handle;
 				}
 
-				// Restart failed load.
+				// Restart failed/cancelled/evicted load.
 				existing.state = ResourceState::Loading;
+				existing.evicted = false;
 				existing.error.clear();
-				existing.pendingCpu.reset();
+				existing.cancel.Cancel();
+				existing.cancel = jobs::CancellationSource{};
 				++existing.generation;
 				generation = existing.generation;
+				entryToken = existing.cancel.GetToken();
 				handle->SetProperties(std::forward<PropertiesType>(properties));
+				existing.sourcePath = SourcePathOf(handle->GetProperties(), id);
+				path = existing.sourcePath;
 			}
 			else
 			{
@@ -224,86 +487,14 @@ public:
 				entry.generation = 1;
 				handle = entry.meshHandle;
 				generation = entry.generation;
-				entries_.emplace(stableKey, std::move(entry));
+				entryToken = entry.cancel.GetToken();
+				entry.sourcePath = SourcePathOf(entry.meshHandle->GetProperties(), id);
+				path = entry.sourcePath;
+				entries_.emplace(InternAssetId(id), std::move(entry));
 			}
 		}
 
-		MeshProperties propsCopy = handle->GetProperties();
-		std::string path = propsCopy.filePath.empty() ? std::string(stableKey) : propsCopy.filePath;
-		if (propsCopy.debugName.empty())
-		{
-			propsCopy.debugName = rendern::DefaultDebugNameFromPath(path);
-		}
-
-		MeshIO ioCopy = io;
-
-		ioCopy.jobs.Enqueue([this,
-			key = stableKey,
-			generation,
-			propsCopy = std::move(propsCopy),
-			path = std::move(path),
-			ioCopy]() mutable
-			{
-				std::optional<MeshCPU> cpuOpt;
-				std::string error;
-				try
-				{
-					// Resolve via assets/ root unless absolute.
-					const auto abs = corefs::ResolveAsset(std::filesystem::path(path));
-
-					auto ToLower = [](std::string s)
-						{
-							for (char& c : s)
-							{
-								c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-							}
-							return s;
-						};
-
-					const std::string ext = ToLower(abs.extension().string());
-					if (ext == ".obj")
-					{
-						cpuOpt = rendern::LoadObj(abs);
-					}
-					else
-					{
-						cpuOpt = rendern::LoadAssimp(abs, propsCopy.flipUVs, propsCopy.submeshIndex, propsCopy.bakeNodeTransforms);
-					}
-				}
-				catch (const std::exception& e)
-				{
-					error = e.what();
-				}
-				catch (...)
-				{
-					error = "Unknown mesh load error";
-				}
-
-				std::scoped_lock lock(mutex_);
-				auto it = entries_.find(key);
-				if (it == entries_.end())
-				{
-					return;
-				}
-
-				MeshEntry& entry = it->second;
-				if (entry.generation != generation)
-				{
-					// Outdated request.
-					return;
-				}
-
-				if (!cpuOpt)
-				{
-					entry.state = ResourceState::Failed;
-					entry.error = std::move(error);
-					return;
-				}
-
-				entry.pendingCpu = std::move(*cpuOpt);
-				uploadQueue_.push_back(MeshUploadTicket{ key, generation });
-			});
-
+		EnqueueImport(stableKey, generation, handle->GetProperties(), std::move(path), io, std::move(entryToken));
 		return handle;
 	}
 
@@ -323,7 +514,7 @@ public:
 
 	Handle Find(std::string_view id) const
 	{
-		Id key{ id };
+		const Id key{ id };
 		std::scoped_lock lock(mutex_);
 		if (auto it = entries_.find(key); it != entries_.end())
 		{
@@ -344,6 +535,7 @@ public:
 					MeshRHI old = it->second.meshHandle->ReplaceResource(MeshRHI{});
 					EnqueueDestroy(std::move(old));
 				}
+				it->second.cancel.Cancel();
 				it = entries_.erase(it);
 			}
 			else
@@ -363,14 +555,90 @@ public:
 				MeshRHI old = entry.meshHandle->ReplaceResource(MeshRHI{});
 				EnqueueDestroy(std::move(old));
 			}
+			entry.cancel.Cancel();
 		}
 		entries_.clear();
-		uploadQueue_.clear();
+		uploadQueue_.Clear();
+		deferredUpload_.reset();
+	}
+
+	// Residency, once per ResidencyManager update (see the texture storage).
+	std::uint64_t SampleResidency(std::uint64_t frame, std::vector<ResidencyCandidate>& candidates, std::vector<Id>& restores)
+	{
+		std::scoped_lock lock(mutex_);
+		std::uint64_t residentBytes = 0;
+		for (auto& [id, entry] : entries_)
+		{
+			const bool used = entry.meshHandle->ConsumeUsed();
+			if (used || entry.lastUsedFrame == 0)
+			{
+				entry.lastUsedFrame = frame;
+			}
+
+			if (entry.state == ResourceState::Unloaded && entry.evicted && used)
+			{
+				restores.push_back(id);
+			}
+			if (entry.state == ResourceState::Loaded)
+			{
+				residentBytes += entry.gpuBytes;
+				candidates.push_back(ResidencyCandidate{ id, entry.gpuBytes, entry.lastUsedFrame });
+			}
+		}
+		return residentBytes;
+	}
+
+	// Releases the GPU buffers of a Loaded entry; draws skip it (indexCount 0) until a Restore
+	// reloads it. Bounds stay, so culling keeps reporting it. Returns the bytes freed.
+	std::uint64_t Evict(Id id)
+	{
+		std::scoped_lock lock(mutex_);
+		auto it = entries_.find(id);
+		if (it == entries_.end() || it->second.state != ResourceState::Loaded)
+		{
+			return 0;
+		}
+
+		MeshEntry& entry = it->second;
+		EnqueueDestroy(entry.meshHandle->ReplaceResource(MeshRHI{}));
+		entry.state = ResourceState::Unloaded;
+		entry.evicted = true;
+		return std::exchange(entry.gpuBytes, 0);
+	}
+
+	// Restarts the import of an evicted entry with the properties it was loaded with.
+	void Restore(Id id, MeshIO& io)
+	{
+		std::uint64_t generation{};
+		jobs::CancellationToken entryToken{};
+		MeshProperties properties{};
+		std::string path{};
+		{
+			std::scoped_lock lock(mutex_);
+			auto it = entries_.find(id);
+			if (it == entries_.end() || it->second.state != ResourceState::Unloaded || !it->second.evicted)
+			{
+				return;
+			}
+
+			MeshEntry& entry = it->second;
+			entry.state = ResourceState::Loading;
+			entry.evicted = false;
+			entry.cancel.Cancel();
+			entry.cancel = jobs::CancellationSource{};
+			++entry.generation;
+			generation = entry.generation;
+			entryToken = entry.cancel.GetToken();
+			properties = entry.meshHandle->GetProperties();
+			path = entry.sourcePath;
+		}
+
+		EnqueueImport(id, generation, std::move(properties), std::move(path), io, std::move(entryToken));
 	}
 
 	ResourceState GetState(std::string_view id) const
 	{
-		Id key{ id };
+		const Id key{ id };
 		std::scoped_lock lock(mutex_);
 		if (auto it = entries_.find(key); it != entries_.end())
 		{
@@ -382,7 +650,7 @@ public:
 	const std::string& GetError(std::string_view id) const
 	{
 		static const std::string empty{};
-		Id key{ id };
+		const Id key{ id };
 		std::scoped_lock lock(mutex_);
 		if (auto it = entries_.find(key); it != entries_.end())
 		{
@@ -397,7 +665,12 @@ public:
 
 		ResourceStreamingStats stats{};
 		stats.totalEntries = static_cast<std::uint32_t>(entries_.size());
-		stats.queuedUploads = static_cast<std::uint32_t>(uploadQueue_.size());
+		stats.queuedUploads = static_cast<std::uint32_t>(uploadQueue_.SizeApprox()) + lastUploadUsage_.deferred;
+		stats.pendingCpuEntries = stats.queuedUploads;
+		stats.lastUploadItems = lastUploadUsage_.items;
+		stats.lastUploadBytes = lastUploadUsage_.bytes;
+		stats.lastUploadEstimatedMicroseconds = lastUploadUsage_.estimatedMicroseconds;
+		stats.microsecondsPerMiB = costModel_.MicrosecondsPerMiB();
 		stats.queuedDestroys = static_cast<std::uint32_t>(destroyQueue_.size());
 
 		for (const auto& [id, entry] : entries_)
@@ -409,18 +682,20 @@ public:
 				break;
 			case ResourceState::Loaded:
 				++stats.loadedEntries;
+				stats.residentBytes += entry.gpuBytes;
 				break;
 			case ResourceState::Failed:
 				++stats.failedEntries;
 				break;
+			case ResourceState::Unloaded:
+				if (entry.evicted)
+				{
+					++stats.evictedEntries;
+				}
+				break;
 			default:
 				break;
 			}
-
-			if (entry.pendingCpu.has_value())
-			{
-				++stats.pendingCpuEntries;
-			}
 		}
 
 		return stats;
@@ -428,8 +703,17 @@ public:
 
 	bool ProcessUploads(MeshIO& io, std::size_t maxPerCall = 2, std::size_t maxDestroyedPerCall = 32)
 	{
-		std::size_t uploaded = 0;
+		UploadBudgetTracker unlimited{};
+		return ProcessUploads(io, unlimited, maxPerCall, maxDestroyedPerCall);
+	}
+
+	// Budgeted variant (see the texture storage): vertex + index bytes drive the estimate.
+	bool ProcessUploads(MeshIO& io, UploadBudgetTracker& tracker, std::size_t maxPerCall, std::size_t maxDestroyedPerCall)
+	{
+		const memory::ScopedGpuMemoryTag gpuTag(memory::MemoryTag::Meshes);
 		std::size_t destroyed = 0;
+		const UploadBudgetTracker spentBefore = tracker;
+		std::size_t uploaded = 0;
 
 		while (destroyed < maxDestroyedPerCall)
 		{
@@ -456,56 +740,75 @@ public:
 
 		while (uploaded < maxPerCall)
 		{
-			MeshUploadTicket ticket{};
-			MeshCPU cpu{};
+			std::optional<MeshUploadTicket> ticket = PopUploadTicket();
+			if (!ticket)
+				break;
+
+			const std::uint64_t bytes = rendern::EstimateUploadBytes(*ticket);
+			const float estimatedMicroseconds = costModel_.EstimateMicroseconds(bytes);
+			if (uploaded > 0 && !tracker.Allows(bytes, estimatedMicroseconds))
+			{
+				deferredUpload_ = std::move(ticket);
+				break;
+			}
+
 			Handle handle{};
 			MeshProperties props{};
+			std::string sourcePath{};
 
 			{
+				// Only a short validation under the entry lock; the payload travelled with the ticket.
 				std::scoped_lock lock(mutex_);
-				if (uploadQueue_.empty())
-					break;
-
-				ticket = std::move(uploadQueue_.front());
-				uploadQueue_.pop_front();
-
-				auto it = entries_.find(ticket.id);
+				auto it = entries_.find(ticket->id);
 				if (it == entries_.end())
 					continue;
 
-				MeshEntry& entry = it->second;
-				if (entry.generation != ticket.generation)
-					continue;
-
-				if (!entry.pendingCpu)
+				const MeshEntry& entry = it->second;
+				if (entry.generation != ticket->generation || entry.state != ResourceState::Loading)
 					continue;
 
-				cpu = std::move(*entry.pendingCpu);
-				entry.pendingCpu.reset();
 				handle = entry.meshHandle;
 				props = handle->GetProperties();
-				if (props.debugName.empty())
-				{
-					props.debugName = rendern::DefaultDebugNameFromPath(props.filePath.empty() ? ticket.id : props.filePath);
-				}
+				sourcePath = entry.sourcePath;
 			}
 
-			auto cpuPtr = std::make_shared<MeshCPU>(std::move(cpu));
-			const rendern::MeshBounds bounds = ComputeMeshBounds(*cpuPtr);
+			if (props.debugName.empty())
+			{
+				props.debugName = rendern::DefaultDebugNameFromPath(sourcePath);
+			}
+
+			// Shared so the render-queue closure stays copyable; keeps a cooked mapping alive until uploaded.
+			auto payload = std::make_shared<MeshUploadTicket>(std::move(*ticket));
 			MeshIO ioCopy = io;
 
 			ioCopy.render.Enqueue([this,
-				id = ticket.id,
-				generation = ticket.generation,
-				cpuPtr,
-				bounds,
+				payload,
+				bytes,
 				props = std::move(props),
 				ioCopy]() mutable
 				{
+					const Id id = payload->id;
+					const std::uint64_t generation = payload->generation;
+
 					MeshRHI gpu{};
 					try
 					{
-						gpu = UploadMesh(ioCopy.device, *cpuPtr, props.debugName);
+						const auto uploadStart = std::chrono::steady_clock::now();
+						if (props.compactVertices && ioCopy.device.GetBackend() == rhi::Backend::DirectX12)
+						{
+							gpu = UploadMeshCompact(ioCopy.device, payload->Vertices(), payload->Indices(),
+								MakeVertexQuantization(payload->bounds.aabbMin, payload->bounds.aabbMax), props.debugName, ioCopy.allocator);
+						}
+						else if (ioCopy.geometry)
+						{
+							gpu = ioCopy.geometry->Upload(payload->Vertices(), payload->Indices());
+						}
+						if (!gpu.vertexBuffer)
+						{
+							gpu = UploadMesh(ioCopy.device, payload->Vertices(), payload->Indices(), props.debugName, ioCopy.allocator);
+						}
+						UploadMeshlets(ioCopy.device, gpu, payload->Vertices(), payload->meshlets, props.debugName);
+						costModel_.Record(bytes, 1u, std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - uploadStart).count());
 					}
 					catch (const std::exception& e)
 					{
@@ -541,23 +844,153 @@ public:
 					}
 
 					MeshEntry& entry = it->second;
-					entry.meshHandle->SetBounds(bounds);
-					MeshRHI old = entry.meshHandle->ReplaceResource(std::move(gpu));
+					entry.meshHandle->SetBounds(payload->bounds);
+					MeshRHI old = entry.meshHandle->ReplaceResource(std::move(gpu), payload->Lods(), payload->meshlets.lods);
 					if (old.vertexBuffer.id != 0 || old.indexBuffer.id != 0)
 					{
 						DestroyMesh(ioCopy.device, old);
 					}
+					entry.gpuBytes = bytes;
 					entry.state = ResourceState::Loaded;
 					entry.error.clear();
 				});
 
+			tracker.Consume(bytes, estimatedMicroseconds);
 			++uploaded;
 		}
 
+		{
+			std::scoped_lock lock(mutex_);
+			lastUploadUsage_.items = static_cast<std::uint32_t>(uploaded);
+			lastUploadUsage_.bytes = tracker.bytes - spentBefore.bytes;
+			lastUploadUsage_.estimatedMicroseconds = tracker.estimatedMicroseconds - spentBefore.estimatedMicroseconds;
+			lastUploadUsage_.deferred = deferredUpload_ ? 1u : 0u;
+		}
+
 		return (uploaded > 0) || (destroyed > 0);
 	}
 
 private:
+	struct UploadUsage
+	{
+		std::uint32_t items{};
+		std::uint64_t bytes{};
+		float estimatedMicroseconds{};
+		std::uint32_t deferred{};
+	};
+
+	// Consumer side of the upload queue: the ticket held back by the last budget check goes first.
+	std::optional<MeshUploadTicket> PopUploadTicket()
+	{
+		if (deferredUpload_)
+		{
+			return std::exchange(deferredUpload_, std::nullopt);
+		}
+		return uploadQueue_.TryPop();
+	}
+
+	// Queues the import of one generation of an entry; the result travels to ProcessUploads
+	// through uploadQueue_.
+	void EnqueueImport(
+		Id stableKey,
+		std::uint64_t generation,
+		MeshProperties propsCopy,
+		std::string path,
+		MeshIO& io,
+		jobs::CancellationToken entryToken)
+	{
+		if (propsCopy.debugName.empty())
+		{
+			propsCopy.debugName = rendern::DefaultDebugNameFromPath(path);
+		}
+
+		const jobs::JobPriority priority = propsCopy.streamingPriority;
+		MeshIO ioCopy = io;
+
+		ioCopy.jobs.Enqueue([this,
+			key = stableKey,
+			generation,
+			propsCopy = std::move(propsCopy),
+			path = std::move(path),
+			ioCopy]() mutable
+			{
+				if (ioCopy.cancellation.IsCancelled())
+				{
+					MarkCancelled(key, generation);
+					return;
+				}
+
+				MeshUploadTicket ticket{};
+				bool imported = false;
+				std::string error;
+				try
+				{
+					// Resolve via assets/ root unless absolute.
+					const auto abs = corefs::ResolveAsset(std::filesystem::path(path));
+					rendern::ImportMesh(abs, propsCopy, ticket);
+					if (propsCopy.buildMeshlets && ioCopy.device.SupportsMeshShaders())
+					{
+						ticket.meshlets = rendern::BuildMeshlets(ticket.Vertices(), ticket.Indices(), ticket.Lods());
+					}
+					imported = true;
+				}
+				catch (const std::exception& e)
+				{
+					error = e.what();
+				}
+				catch (...)
+				{
+					error = "Unknown mesh load error";
+				}
+
+				if (imported)
+				{
+					// Hot path: publish without the entry lock; ProcessUploads validates the generation.
+					ticket.id = key;
+					ticket.generation = generation;
+					if (!ticket.cooked)
+					{
+						ticket.cpuBytes.Set(static_cast<std::size_t>(rendern::EstimateUploadBytes(ticket)));
+					}
+					uploadQueue_.Push(std::move(ticket));
+					return;
+				}
+
+				std::scoped_lock lock(mutex_);
+				auto it = entries_.find(key);
+				if (it == entries_.end())
+				{
+					return;
+				}
+
+				MeshEntry& entry = it->second;
+				if (entry.generation != generation)
+				{
+					// Outdated request.
+					return;
+				}
+
+				entry.state = ResourceState::Failed;
+				entry.error = std::move(error);
+			}, priority, std::move(entryToken));
+	}
+
+	static std::string SourcePathOf(const MeshProperties& properties, std::string_view id)
+	{
+		return properties.filePath.empty() ? std::string(id) : properties.filePath;
+	}
+
+	// Import dropped by MeshIO::cancellation: put the entry back so a later request restarts it.
+	void MarkCancelled(Id key, std::uint64_t generation)
+	{
+		std::scoped_lock lock(mutex_);
+		auto it = entries_.find(key);
+		if (it != entries_.end() && it->second.generation == generation && it->second.state == ResourceState::Loading)
+		{
+			it->second.state = ResourceState::Unloaded;
+		}
+	}
+
 	void EnqueueDestroy(MeshRHI&& mesh)
 	{
 		if (mesh.vertexBuffer.id == 0 && mesh.indexBuffer.id == 0)
@@ -566,7 +999,10 @@ private:
 	}
 
 	mutable std::mutex mutex_{};
-	std::unordered_map<Id, MeshEntry> entries_;
-	std::deque<MeshUploadTicket> uploadQueue_;
+	containers::FlatHashMap<Id, MeshEntry, AssetIdHash> entries_;
+	jobs::MpscQueue<MeshUploadTicket> uploadQueue_;
+	std::optional<MeshUploadTicket> deferredUpload_{};
+	UploadCostModel costModel_{};
+	UploadUsage lastUploadUsage_{};
 	std::deque<MeshRHI> destroyQueue_;
 };
\ No newline at end of file
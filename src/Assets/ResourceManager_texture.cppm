@@ -11,12 +11,25 @@ module;
 #include <mutex>
 #include <vector>
 #include <exception>
+#include <stdexcept>
 #include <concepts>
 #include <type_traits>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <filesystem>
+#include <span>
+#include <cstddef>
 
 export module core:resource_manager_texture;
 
 import :resource_manager_core;
+import :job_system;
+import :mpsc_queue;
+import :asset_id;
+import :flat_hash_map;
+import :async_file_io;
+import :memory_tracking;
 
 export using TextureResource = Texture<GPUTexture>;
 
@@ -27,23 +40,82 @@ export struct TextureEntry
 	Handle textureHandle;
 	ResourceState state{ ResourceState::Unloaded };
 	std::uint64_t generation{ 0 };
-	std::optional<TextureCPUData> pendingCpu{};
 	std::string error{};
+
+	// Path handed to the decoder (filePath, or the id when that is empty).
+	std::string sourcePath{};
+
+	// Cancelled when the entry is restarted or dropped, so queued decodes for the old
+	// generation are skipped before they start.
+	jobs::CancellationSource cancel{};
+
+	// Mip streaming (TextureStreamingSettings). Mip indices refer to the full decoded chain;
+	// residentFirstMip is the finest level on the GPU, requestedFirstMip what feedback asked for.
+	bool streamed{ false };
+	TextureFormat format{ TextureFormat::RGBA };
+	std::uint32_t baseWidth{ 0 };
+	std::uint32_t baseHeight{ 0 };
+	std::uint32_t mipCount{ 0 };
+	std::uint32_t tailFirstMip{ 0 };
+	std::uint32_t residentFirstMip{ 0 };
+	std::uint32_t requestedFirstMip{ 0 };
+	std::uint64_t residentBytes{ 0 };
+	std::uint64_t lastFeedbackFrame{ 0 };
+
+	// Bumped for every mip-range change; uploads carrying an older serial are dropped.
+	std::uint64_t streamSerial{ 0 };
+	bool streamPending{ false };
+	std::uint64_t pendingBytes{ 0 };
+
+	// CPU copy of the tail, so dropping back to it needs no decode.
+	std::shared_ptr<const TextureCPUData> mipTail{};
+
+	// Residency (ResidencyManager): bytes of the uploaded texture, last update it was drawn in,
+	// and whether its GPU copy was evicted (state Unloaded, restarted once drawn again).
+	std::uint64_t gpuBytes{ 0 };
+	std::uint64_t lastUsedFrame{ 0 };
+	bool evicted{ false };
+};
+
+// Mip range carried by an upload. Serial 0 is the entry's initial load; anything else is a
+// mip-range change of a Loaded entry.
+struct TextureStreamRange
+{
+	bool streamed{ false };
+	std::uint64_t serial{ 0 };
+	TextureFormat format{ TextureFormat::RGBA };
+	std::uint32_t baseWidth{ 0 };
+	std::uint32_t baseHeight{ 0 };
+	std::uint32_t mipCount{ 0 };
+	std::uint32_t tailFirstMip{ 0 };
+	std::uint32_t firstMip{ 0 };
 };
 
+// Decoded payload handed from a decode worker to ProcessUploads without taking mutex_.
 struct TextureUploadTicket
 {
-	std::string id;
+	AssetId id{};
 	std::uint64_t generation{};
+	TextureCPUData cpu{};
+	TextureStreamRange range{};
+	// Decoded pixels are charged to the texture budget until the ticket is consumed.
+	memory::TrackedBytes cpuBytes{ memory::MemoryTag::Textures };
 };
 
+TextureUploadTicket MakeTextureUploadTicket(AssetId id, std::uint64_t generation, TextureCPUData cpu, TextureStreamRange range)
+{
+	TextureUploadTicket ticket{ id, generation, std::move(cpu), range };
+	ticket.cpuBytes.Set(static_cast<std::size_t>(EstimateUploadBytes(ticket.cpu)));
+	return ticket;
+}
+
 export template <>
 class ResourceStorage<TextureResource>
 {
 public:
 	using Resource = TextureResource;
 	using Handle = std::shared_ptr<Resource>;
-	using Id = std::string;
+	using Id = AssetId;
 
 	template <typename PropertiesType>
 		requires std::same_as<std::remove_cvref_t<PropertiesType>, typename Resource::Properties>
@@ -56,29 +128,39 @@ public:
 		requires std::same_as<std::remove_cvref_t<PropertiesType>, typename Resource::Properties>
 	Handle LoadAsync(std::string_view id, TextureIO& io, PropertiesType&& properties)
 	{
-		Id stableKey = Id{ id };
+		const Id stableKey{ id };
 		Handle handle{};
 		std::uint64_t generation{};
+		jobs::CancellationToken entryToken{};
+		TextureStreamingSettings streaming{};
+		std::string path{};
 
 		{
 			std::scoped_lock lock(mutex_);
+			streaming = streaming_;
 			if (auto it = entries_.find(stableKey); it != entries_.end())
 			{
-				// If the resource exists, return it. If it previously failed, restart loading.
+				// If the resource exists, return it. If it previously failed (or its decode was
+				// cancelled), restart loading.
 				TextureEntry& existing = it->second;
 				handle = existing.textureHandle;
-				if (existing.state != ResourceState::Failed)
+				if (existing.state != ResourceState::Failed && existing.state != ResourceState::Unloaded)
 				{
 					return handle;
 				}
 
-				// Restart failed load.
+				// Restart failed/cancelled/evicted load.
 				existing.state = ResourceState::Loading;
+				existing.evicted = false;
 				existing.error.clear();
-				existing.pendingCpu.reset();
+				existing.cancel.Cancel();
+				existing.cancel = jobs::CancellationSource{};
 				++existing.generation;
 				generation = existing.generation;
+				entryToken = existing.cancel.GetToken();
 				handle->SetProperties(std::forward<PropertiesType>(properties));
+				existing.sourcePath = DecodePathOf(handle->GetProperties(), id);
+				path = existing.sourcePath;
 			}
 			else
 			{
@@ -89,68 +171,14 @@ public:
 
 				handle = entry.textureHandle;
 				generation = entry.generation;
-				entries_.emplace(stableKey, std::move(entry));
+				entryToken = entry.cancel.GetToken();
+				entry.sourcePath = DecodePathOf(entry.textureHandle->GetProperties(), id);
+				path = entry.sourcePath;
+				entries_.emplace(InternAssetId(id), std::move(entry));
 			}
 		}
 
-		TextureProperties propertiesCopy = handle->GetProperties();
-		std::string path = propertiesCopy.filePath.empty() ? std::string(stableKey) : propertiesCopy.filePath;
-
-		TextureIO ioCopy = io;
-
-		ioCopy.jobs.Enqueue([this,
-			key = stableKey,
-			generation,
-			propertiesCopy = std::move(propertiesCopy),
-			path = std::move(path),
-			ioCopy]() mutable
-			{
-				std::optional<TextureCPUData> cpuOpt{};
-				std::string decodeError{};
-				try
-				{
-					cpuOpt = ioCopy.decoder.Decode(propertiesCopy, path);
-				}
-				catch (const std::exception& e)
-				{
-					decodeError = e.what();
-				}
-				catch (...)
-				{
-					decodeError = "Texture decode threw (unknown exception)";
-				}
-
-				std::scoped_lock lock(mutex_);
-
-				auto it = entries_.find(key);
-				if (it == entries_.end())
-				{
-					return;
-				}
-
-				TextureEntry& entry = it->second;
-				if (entry.generation != generation)
-				{
-					return;
-				}
-
-				if (entry.state != ResourceState::Loading)
-				{
-					return;
-				}
-
-				if (!cpuOpt)
-				{
-					entry.state = ResourceState::Failed;
-					entry.error = decodeError.empty() ? "Texture decode failed" : decodeError;
-					entry.pendingCpu.reset();
-					return;
-				}
-
-				entry.pendingCpu = std::move(*cpuOpt);
-				uploadQueue_.push_back(TextureUploadTicket{ key, generation });
-			});
-
+		EnqueueDecode(stableKey, generation, handle->GetProperties(), std::move(path), streaming, io, std::move(entryToken));
 		return handle;
 	}
 
@@ -164,11 +192,15 @@ public:
 		{
 			auto state = GetState(id);
 
-			if (state == ResourceState::Loaded || state == ResourceState::Failed)
+			if (state == ResourceState::Loaded || state == ResourceState::Failed || state == ResourceState::Unloaded)
 			{
 				return handle;
 			}
 
+			if (io.files != nullptr)
+			{
+				io.files->WaitIdle();
+			}
 			io.jobs.WaitIdle();
 
 			ProcessUploads(io, SyncLoadNumberPerCall, SyncLoadNumberPerCall);
@@ -177,7 +209,7 @@ public:
 
 	Handle Find(std::string_view id) const
 	{
-		Id key{ id };
+		const Id key{ id };
 		std::scoped_lock lock(mutex_);
 
 		if (auto it = entries_.find(key); it != entries_.end())
@@ -199,6 +231,11 @@ public:
 				{
 					EnqueueDestroy(it->second.textureHandle->GetResource());
 				}
+				if (it->second.streamed)
+				{
+					streamedResidentBytes_ -= it->second.residentBytes;
+				}
+				it->second.cancel.Cancel();
 				it = entries_.erase(it);
 			}
 			else
@@ -218,15 +255,325 @@ public:
 			{
 				EnqueueDestroy(entry.textureHandle->GetResource());
 			}
+			entry.cancel.Cancel();
 		}
 
 		entries_.clear();
-		uploadQueue_.clear();
+		uploadQueue_.Clear();
+		streamQueue_.Clear();
+		deferredUpload_.reset();
+		streamedResidentBytes_ = 0;
+	}
+
+	// Enables/disables mip streaming for textures loaded from now on. Already loaded entries
+	// keep the range they have (and keep streaming if they were streamed).
+	void SetMipStreaming(const TextureStreamingSettings& settings)
+	{
+		std::scoped_lock lock(mutex_);
+		streaming_ = settings;
+	}
+
+	TextureStreamingSettings GetMipStreaming() const
+	{
+		std::scoped_lock lock(mutex_);
+		return streaming_;
+	}
+
+	// Screen-size feedback from the renderer: `screenPixels` is the larger on-screen side of a
+	// surface sampling the texture. Reports within one frame keep the largest footprint.
+	void ReportScreenSize(std::string_view id, float screenPixels)
+	{
+		std::scoped_lock lock(mutex_);
+		auto it = entries_.find(Id{ id });
+		if (it == entries_.end() || !it->second.streamed)
+		{
+			return;
+		}
+
+		TextureEntry& entry = it->second;
+		const std::uint32_t mip = std::min(
+			MipForScreenSize(std::max(entry.baseWidth, entry.baseHeight), screenPixels, entry.mipCount),
+			entry.tailFirstMip);
+		if (entry.lastFeedbackFrame != streamFrame_)
+		{
+			entry.requestedFirstMip = mip;
+			entry.lastFeedbackFrame = streamFrame_;
+		}
+		else
+		{
+			entry.requestedFirstMip = std::min(entry.requestedFirstMip, mip);
+		}
+	}
+
+	// Once per frame, before ProcessUploads. Turns feedback into mip-range changes: finer ranges
+	// are re-decoded on the job system (most recently requested first, within the VRAM budget,
+	// evicting least recently requested textures to their tail when needed); textures without
+	// feedback for evictAfterFrames drop to their cached tail. Both kinds of change go through
+	// the regular, budgeted upload path after the initial loads of that frame.
+	void UpdateMipStreaming(TextureIO& io)
+	{
+		struct StreamRequest
+		{
+			Id key{};
+			std::uint64_t generation{};
+			TextureStreamRange range{};
+			TextureProperties properties{};
+			std::string path{};
+			jobs::CancellationToken token{};
+		};
+
+		std::vector<StreamRequest> requests{};
+		{
+			std::scoped_lock lock(mutex_);
+			const std::uint64_t frame = ++streamFrame_;
+			if (!streaming_.enabled)
+			{
+				return;
+			}
+
+			struct Candidate
+			{
+				const Id* id{};
+				TextureEntry* entry{};
+			};
+			std::vector<Candidate> promotions{};
+			std::vector<Candidate> evictable{};
+			std::uint64_t projectedBytes = 0;
+
+			for (auto& [id, entry] : entries_)
+			{
+				if (!entry.streamed || entry.state != ResourceState::Loaded)
+				{
+					continue;
+				}
+				if (entry.streamPending)
+				{
+					projectedBytes += entry.pendingBytes;
+					continue;
+				}
+				projectedBytes += entry.residentBytes;
+
+				const bool stale = frame - entry.lastFeedbackFrame > streaming_.evictAfterFrames;
+				if (stale)
+				{
+					if (entry.residentFirstMip < entry.tailFirstMip)
+					{
+						projectedBytes -= entry.residentBytes;
+						projectedBytes += DemoteToTail(id, entry);
+					}
+					continue;
+				}
+
+				if (entry.requestedFirstMip < entry.residentFirstMip)
+				{
+					promotions.push_back(Candidate{ &id, &entry });
+				}
+				else if (entry.residentFirstMip < entry.tailFirstMip)
+				{
+					evictable.push_back(Candidate{ &id, &entry });
+				}
+			}
+
+			std::sort(promotions.begin(), promotions.end(), [](const Candidate& a, const Candidate& b)
+				{
+					if (a.entry->lastFeedbackFrame != b.entry->lastFeedbackFrame)
+					{
+						return a.entry->lastFeedbackFrame > b.entry->lastFeedbackFrame;
+					}
+					return (a.entry->residentFirstMip - a.entry->requestedFirstMip) > (b.entry->residentFirstMip - b.entry->requestedFirstMip);
+				});
+			std::sort(evictable.begin(), evictable.end(), [](const Candidate& a, const Candidate& b)
+				{
+					return a.entry->lastFeedbackFrame < b.entry->lastFeedbackFrame;
+				});
+
+			const std::uint64_t budget = streaming_.vramBudgetBytes;
+			const auto Fits = [&](std::uint64_t extra) { return budget == 0 || projectedBytes + extra <= budget; };
+			std::size_t nextVictim = 0;
+
+			for (const Candidate& candidate : promotions)
+			{
+				if (requests.size() >= streaming_.maxRequestsPerFrame)
+				{
+					break;
+				}
+
+				TextureEntry& entry = *candidate.entry;
+				const auto ExtraBytes = [&](std::uint32_t firstMip)
+					{
+						return MipChainBytes(entry.format, entry.baseWidth, entry.baseHeight, firstMip, entry.mipCount) - entry.residentBytes;
+					};
+
+				// Make room from textures nobody asked for as recently as this one.
+				while (!Fits(ExtraBytes(entry.requestedFirstMip)) && nextVictim < evictable.size() &&
+					evictable[nextVictim].entry->lastFeedbackFrame < entry.lastFeedbackFrame)
+				{
+					TextureEntry& victim = *evictable[nextVictim].entry;
+					projectedBytes -= victim.residentBytes;
+					projectedBytes += DemoteToTail(*evictable[nextVictim].id, victim);
+					++nextVictim;
+				}
+
+				// Whatever still does not fit is refined only as far as the budget allows.
+				std::uint32_t firstMip = entry.requestedFirstMip;
+				while (firstMip < entry.residentFirstMip && !Fits(ExtraBytes(firstMip)))
+				{
+					++firstMip;
+				}
+				if (firstMip == entry.residentFirstMip)
+				{
+					continue;
+				}
+
+				projectedBytes += ExtraBytes(firstMip);
+				entry.streamPending = true;
+				entry.pendingBytes = entry.residentBytes + ExtraBytes(firstMip);
+				++entry.streamSerial;
+
+				StreamRequest request{};
+				request.key = *candidate.id;
+				request.generation = entry.generation;
+				request.range = StreamRangeOf(entry, firstMip);
+				request.properties = entry.textureHandle->GetProperties();
+				request.path = entry.sourcePath;
+				request.token = entry.cancel.GetToken();
+				requests.push_back(std::move(request));
+			}
+		}
+
+		for (StreamRequest& request : requests)
+		{
+			jobs::CancellationToken token = request.token;
+			TextureIO ioCopy = io;
+			const TextureProperties properties = request.properties;
+			const std::string path = request.path;
+			EnqueueDecodeJob(io, properties, path, jobs::JobPriority::Prefetch, std::move(token),
+				[this, request = std::move(request), ioCopy](const std::vector<corefs::FileReadResult>* files) mutable
+				{
+					std::optional<TextureCPUData> cpuOpt{};
+					try
+					{
+						cpuOpt = DecodeWith(ioCopy.decoder, request.properties, request.path, files);
+					}
+					catch (...)
+					{
+					}
+
+					// The source may have changed on disk since the tail was decoded.
+					if (cpuOpt && cpuOpt->dimension == TextureDimension::Tex2D &&
+						cpuOpt->width == request.range.baseWidth && cpuOpt->height == request.range.baseHeight &&
+						cpuOpt->mips.size() == request.range.mipCount)
+					{
+						DropTopMips(*cpuOpt, request.range.firstMip);
+						streamQueue_.Push(MakeTextureUploadTicket(request.key, request.generation, std::move(*cpuOpt), request.range));
+						return;
+					}
+
+					std::scoped_lock lock(mutex_);
+					auto it = entries_.find(request.key);
+					if (it != entries_.end() && it->second.generation == request.generation && it->second.streamSerial == request.range.serial)
+					{
+						AbandonStream(it->second);
+					}
+				});
+		}
+	}
+
+	// Residency, once per ResidencyManager update. Consumes the renderer's usage marks (stamping
+	// `frame`), lists resident 2D textures as eviction candidates, lists evicted textures drawn
+	// again in `restores`, and returns the resident GPU bytes.
+	std::uint64_t SampleResidency(std::uint64_t frame, std::vector<ResidencyCandidate>& candidates, std::vector<Id>& restores)
+	{
+		std::scoped_lock lock(mutex_);
+		std::uint64_t residentBytes = 0;
+		for (auto& [id, entry] : entries_)
+		{
+			const bool used = entry.textureHandle->ConsumeUsed();
+			if (used || entry.lastUsedFrame == 0)
+			{
+				entry.lastUsedFrame = frame;
+			}
+
+			if (entry.state == ResourceState::Unloaded && entry.evicted && used)
+			{
+				restores.push_back(id);
+			}
+			if (entry.state != ResourceState::Loaded)
+			{
+				continue;
+			}
+
+			residentBytes += entry.gpuBytes;
+			// Cubemaps (skybox, probes) are not referenced through materials, so they never get
+			// usage marks: keep them.
+			if (!entry.streamPending && entry.textureHandle->GetProperties().dimension == TextureDimension::Tex2D)
+			{
+				candidates.push_back(ResidencyCandidate{ id, entry.gpuBytes, entry.lastUsedFrame });
+			}
+		}
+		return residentBytes;
+	}
+
+	// Releases the GPU copy of a Loaded entry; the handle stays valid (resource id 0) until a
+	// Restore reloads it. Returns the bytes freed (0 if the entry could not be evicted).
+	std::uint64_t Evict(Id id)
+	{
+		std::scoped_lock lock(mutex_);
+		auto it = entries_.find(id);
+		if (it == entries_.end() || it->second.state != ResourceState::Loaded || it->second.streamPending)
+		{
+			return 0;
+		}
+
+		TextureEntry& entry = it->second;
+		EnqueueDestroy(entry.textureHandle->GetResource());
+		entry.textureHandle->SetResource(GPUTexture{});
+		if (entry.streamed)
+		{
+			streamedResidentBytes_ -= entry.residentBytes;
+			entry.residentBytes = 0;
+		}
+		entry.mipTail.reset();
+		entry.state = ResourceState::Unloaded;
+		entry.evicted = true;
+		return std::exchange(entry.gpuBytes, 0);
+	}
+
+	// Restarts the load of an evicted entry with the properties it was loaded with.
+	void Restore(Id id, TextureIO& io)
+	{
+		std::uint64_t generation{};
+		jobs::CancellationToken entryToken{};
+		TextureProperties properties{};
+		std::string path{};
+		TextureStreamingSettings streaming{};
+		{
+			std::scoped_lock lock(mutex_);
+			auto it = entries_.find(id);
+			if (it == entries_.end() || it->second.state != ResourceState::Unloaded || !it->second.evicted)
+			{
+				return;
+			}
+
+			TextureEntry& entry = it->second;
+			entry.state = ResourceState::Loading;
+			entry.evicted = false;
+			entry.cancel.Cancel();
+			entry.cancel = jobs::CancellationSource{};
+			++entry.generation;
+			generation = entry.generation;
+			entryToken = entry.cancel.GetToken();
+			properties = entry.textureHandle->GetProperties();
+			path = entry.sourcePath;
+			streaming = streaming_;
+		}
+
+		EnqueueDecode(id, generation, std::move(properties), std::move(path), streaming, io, std::move(entryToken));
 	}
 
 	ResourceState GetState(std::string_view id) const
 	{
-		Id key{ id };
+		const Id key{ id };
 		std::scoped_lock lock(mutex_);
 
 		if (auto it = entries_.find(key); it != entries_.end())
@@ -240,7 +587,7 @@ public:
 	const std::string& GetError(std::string_view id) const
 	{
 		static const std::string errorStr{};
-		Id key{ id };
+		const Id key{ id };
 		std::scoped_lock lock(mutex_);
 
 		if (auto it = entries_.find(key); it != entries_.end())
@@ -256,7 +603,15 @@ public:
 
 		ResourceStreamingStats stats{};
 		stats.totalEntries = static_cast<std::uint32_t>(entries_.size());
-		stats.queuedUploads = static_cast<std::uint32_t>(uploadQueue_.size());
+		stats.queuedUploads = static_cast<std::uint32_t>(uploadQueue_.SizeApprox()) + lastUploadUsage_.deferred;
+		stats.streamedResidentBytes = streamedResidentBytes_;
+		stats.pendingCpuEntries = stats.queuedUploads;
+		stats.gpuPendingUploads = static_cast<std::uint32_t>(std::count_if(gpuInFlight_.begin(), gpuInFlight_.end(),
+			[](const GpuInFlight& upload) { return upload.range.serial == 0; }));
+		stats.lastUploadItems = lastUploadUsage_.items;
+		stats.lastUploadBytes = lastUploadUsage_.bytes;
+		stats.lastUploadEstimatedMicroseconds = lastUploadUsage_.estimatedMicroseconds;
+		stats.microsecondsPerMiB = costModel_.MicrosecondsPerMiB();
 		stats.queuedDestroys = static_cast<std::uint32_t>(destroyQueue_.size());
 
 		for (const auto& [id, entry] : entries_)
@@ -268,6 +623,17 @@ public:
 				break;
 			case ResourceState::Loaded:
 				++stats.loadedEntries;
+				stats.residentBytes += entry.gpuBytes;
+				if (entry.streamPending)
+				{
+					++stats.pendingMipStreams;
+				}
+				break;
+			case ResourceState::Unloaded:
+				if (entry.evicted)
+				{
+					++stats.evictedEntries;
+				}
 				break;
 			case ResourceState::Failed:
 				++stats.failedEntries;
@@ -275,11 +641,6 @@ public:
 			default:
 				break;
 			}
-
-			if (entry.pendingCpu.has_value())
-			{
-				++stats.pendingCpuEntries;
-			}
 		}
 
 		return stats;
@@ -287,20 +648,41 @@ public:
 
 	bool ProcessUploads(TextureIO& io, std::size_t maxPerCall = 8, std::size_t maxDestroyedPerCall = 32)
 	{
+		UploadBudgetTracker unlimited{};
+		return ProcessUploads(io, unlimited, maxPerCall, maxDestroyedPerCall);
+	}
+
+	// Budgeted variant: stops once the estimated cost of the next texture (bytes of all mips,
+	// time from the calibrated cost model) would overrun `tracker`. That texture is kept for
+	// the next call.
+	bool ProcessUploads(TextureIO& io, UploadBudgetTracker& tracker, std::size_t maxPerCall, std::size_t maxDestroyedPerCall)
+	{
+		const memory::ScopedGpuMemoryTag gpuTag(memory::MemoryTag::Textures);
 		struct PendingUpload
 		{
-			std::string id{};
+			Id id{};
 			std::uint64_t generation{};
 			Handle handle{};
 			TextureProperties properties{};
 			std::shared_ptr<TextureCPUData> cpuPtr{};
+			std::uint64_t bytes{};
+			TextureStreamRange range{};
 		};
 
-		std::size_t uploaded = 0;
 		std::size_t destroyed = 0;
+		const UploadBudgetTracker spentBefore = tracker;
+		std::size_t uploaded = 0;
 
 		std::vector<PendingUpload> readyUploads{};
-		readyUploads.reserve(maxPerCall);
+
+		if (gpuInFlightCount_.load(std::memory_order_relaxed) != 0)
+		{
+			TextureIO ioCopy = io;
+			ioCopy.render.Enqueue([this, ioCopy]() mutable
+				{
+					PollGpuInFlight(ioCopy);
+				});
+		}
 
 		while (destroyed < maxDestroyedPerCall)
 		{
@@ -330,58 +712,62 @@ public:
 
 		while (uploaded < maxPerCall)
 		{
-			TextureUploadTicket ticket{};
-			TextureProperties properties{};
-			Handle handle{};
-			TextureCPUData cpuData{};
-			std::uint64_t generation{};
-
+			std::optional<TextureUploadTicket> ticket = PopUploadTicket();
+			if (!ticket)
 			{
-				std::scoped_lock lock(mutex_);
-
-				if (uploadQueue_.empty())
-				{
-					break;
-				}
+				break;
+			}
 
-				ticket = std::move(uploadQueue_.front());
-				uploadQueue_.pop_front();
+			const std::uint64_t bytes = EstimateUploadBytes(ticket->cpu);
+			const float estimatedMicroseconds = costModel_.EstimateMicroseconds(bytes);
+			if (uploaded > 0 && !tracker.Allows(bytes, estimatedMicroseconds))
+			{
+				deferredUpload_ = std::move(ticket);
+				break;
+			}
 
-				auto it = entries_.find(ticket.id);
+			Handle handle{};
+			TextureProperties properties{};
+			{
+				// Only a short validation under the entry lock; the payload travelled with the ticket.
+				std::scoped_lock lock(mutex_);
+				auto it = entries_.find(ticket->id);
 				if (it == entries_.end())
 				{
 					continue;
 				}
 
-				TextureEntry& entry = it->second;
-				generation = ticket.generation;
-				if (entry.generation != generation)
+				const TextureEntry& entry = it->second;
+				if (!IsUploadCurrent(entry, ticket->generation, ticket->range))
 				{
 					continue;
 				}
 
-				if (entry.state != ResourceState::Loading || !entry.pendingCpu.has_value())
-				{
-					continue;
-				}
-
-				cpuData = std::move(*entry.pendingCpu);
-				entry.pendingCpu.reset();
-
 				handle = entry.textureHandle;
 				properties = handle->GetProperties();
 			}
 
 			PendingUpload upload{};
-			upload.id = std::move(ticket.id);
-			upload.generation = generation;
-			upload.handle = handle;
+			upload.id = ticket->id;
+			upload.generation = ticket->generation;
+			upload.handle = std::move(handle);
 			upload.properties = std::move(properties);
-			upload.cpuPtr = std::make_shared<TextureCPUData>(std::move(cpuData));
+			upload.cpuPtr = std::make_shared<TextureCPUData>(std::move(ticket->cpu));
+			upload.bytes = bytes;
+			upload.range = ticket->range;
 			readyUploads.push_back(std::move(upload));
+			tracker.Consume(bytes, estimatedMicroseconds);
 			++uploaded;
 		}
 
+		{
+			std::scoped_lock lock(mutex_);
+			lastUploadUsage_.items = static_cast<std::uint32_t>(uploaded);
+			lastUploadUsage_.bytes = tracker.bytes - spentBefore.bytes;
+			lastUploadUsage_.estimatedMicroseconds = tracker.estimatedMicroseconds - spentBefore.estimatedMicroseconds;
+			lastUploadUsage_.deferred = (deferredUpload_ && deferredUpload_->range.serial == 0) ? 1u : 0u;
+		}
+
 		if (!readyUploads.empty())
 		{
 			TextureIO ioCopy = io;
@@ -396,6 +782,7 @@ public:
 					std::vector<UploadResult> results(uploads.size());
 					bool batchBegun = false;
 					std::string batchError{};
+					const auto batchStart = std::chrono::steady_clock::now();
 
 					try
 					{
@@ -454,7 +841,18 @@ public:
 						}
 					}
 
-					if (!batchError.empty())
+					if (batchError.empty())
+					{
+						// Feed the measured batch time back into the time-budget estimate.
+						std::uint64_t batchBytes = 0;
+						for (const PendingUpload& upload : uploads)
+						{
+							batchBytes += upload.bytes;
+						}
+						const float batchMicroseconds = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - batchStart).count();
+						costModel_.Record(batchBytes, static_cast<std::uint32_t>(uploads.size()), batchMicroseconds);
+					}
+					else
 					{
 						for (auto& result : results)
 						{
@@ -490,7 +888,7 @@ public:
 							}
 
 							TextureEntry& entry = it->second;
-							if (entry.generation != upload.generation || entry.textureHandle != upload.handle || entry.state != ResourceState::Loading)
+							if (entry.textureHandle != upload.handle || !IsUploadCurrent(entry, upload.generation, upload.range))
 							{
 								if (result.gpuOpt && result.gpuOpt->id != 0)
 								{
@@ -501,14 +899,26 @@ public:
 
 							if (!result.gpuOpt)
 							{
+								if (upload.range.serial != 0)
+								{
+									// A failed mip-range change keeps the texture it already has.
+									AbandonStream(entry);
+									continue;
+								}
 								entry.state = ResourceState::Failed;
 								entry.error = result.error.empty() ? "GPU texture upload failed" : result.error;
 								continue;
 							}
 
-							entry.textureHandle->SetResource(*result.gpuOpt);
-							entry.state = ResourceState::Loaded;
-							entry.error.clear();
+							if (!ioCopy.uploader.IsUploadComplete(*result.gpuOpt))
+							{
+								// Copy still running on the GPU: publish on a later poll.
+								gpuInFlight_.push_back(GpuInFlight{ upload.id, upload.generation, upload.handle, *result.gpuOpt, upload.range, upload.bytes, upload.range.streamed ? upload.cpuPtr : nullptr });
+								gpuInFlightCount_.fetch_add(1, std::memory_order_relaxed);
+								continue;
+							}
+
+							Publish(entry, *result.gpuOpt, upload.range, upload.bytes, upload.cpuPtr, destroyList);
 						}
 					}
 
@@ -523,19 +933,383 @@ public:
 	}
 
 private:
+	// Uploaded texture whose GPU copy has not completed yet (render queue only).
+	struct GpuInFlight
+	{
+		Id id{};
+		std::uint64_t generation{};
+		Handle handle{};
+		GPUTexture texture{};
+		TextureStreamRange range{};
+		std::uint64_t bytes{};
+		std::shared_ptr<const TextureCPUData> cpu{};
+	};
+
+	// Render queue: mark textures Loaded once their asynchronous copy has landed. Entries that
+	// were dropped or restarted meanwhile get their texture destroyed instead.
+	void PollGpuInFlight(TextureIO& io)
+	{
+		std::vector<GPUTexture> destroyList{};
+		std::size_t completed = 0;
+		{
+			std::scoped_lock lock(mutex_);
+			for (auto it = gpuInFlight_.begin(); it != gpuInFlight_.end(); )
+			{
+				if (!io.uploader.IsUploadComplete(it->texture))
+				{
+					++it;
+					continue;
+				}
+
+				auto entryIt = entries_.find(it->id);
+				if (entryIt == entries_.end() ||
+					entryIt->second.textureHandle != it->handle ||
+					!IsUploadCurrent(entryIt->second, it->generation, it->range))
+				{
+					destroyList.push_back(it->texture);
+				}
+				else
+				{
+					Publish(entryIt->second, it->texture, it->range, it->bytes, it->cpu, destroyList);
+				}
+
+				it = gpuInFlight_.erase(it);
+				++completed;
+			}
+		}
+
+		gpuInFlightCount_.fetch_sub(completed, std::memory_order_relaxed);
+		for (const GPUTexture texture : destroyList)
+		{
+			io.uploader.Destroy(texture);
+		}
+	}
+
+	struct UploadUsage
+	{
+		std::uint32_t items{};
+		std::uint64_t bytes{};
+		float estimatedMicroseconds{};
+		std::uint32_t deferred{};
+	};
+
+	// Consumer side of the upload queues: the ticket held back by the last budget check goes
+	// first, then initial loads, then mip-range changes.
+	std::optional<TextureUploadTicket> PopUploadTicket()
+	{
+		if (deferredUpload_)
+		{
+			return std::exchange(deferredUpload_, std::nullopt);
+		}
+		if (std::optional<TextureUploadTicket> ticket = uploadQueue_.TryPop())
+		{
+			return ticket;
+		}
+		return streamQueue_.TryPop();
+	}
 
+	// The entry still expects this upload: same generation and, for mip-range changes, the
+	// serial of the latest change.
+	static bool IsUploadCurrent(const TextureEntry& entry, std::uint64_t generation, const TextureStreamRange& range) noexcept
+	{
+		if (entry.generation != generation)
+		{
+			return false;
+		}
+		if (range.serial == 0)
+		{
+			return entry.state == ResourceState::Loading;
+		}
+		return entry.state == ResourceState::Loaded && entry.streamSerial == range.serial;
+	}
+
+	// Streaming range of a freshly decoded chain: large enough 2D chains start at their tail.
+	static TextureStreamRange MakeStreamRange(const TextureCPUData& cpu, std::uint32_t tailMaxDimension) noexcept
+	{
+		TextureStreamRange range{};
+		if (cpu.dimension != TextureDimension::Tex2D || cpu.mips.size() < 2)
+		{
+			return range;
+		}
+
+		const std::uint32_t mipCount = static_cast<std::uint32_t>(cpu.mips.size());
+		const std::uint32_t tail = MipTailFirstLevel(cpu.format, cpu.width, cpu.height, mipCount, tailMaxDimension);
+		if (tail == 0)
+		{
+			return range;
+		}
+
+		range.streamed = true;
+		range.format = cpu.format;
+		range.baseWidth = cpu.width;
+		range.baseHeight = cpu.height;
+		range.mipCount = mipCount;
+		range.tailFirstMip = tail;
+		range.firstMip = tail;
+		return range;
+	}
+
+	static TextureStreamRange StreamRangeOf(const TextureEntry& entry, std::uint32_t firstMip) noexcept
+	{
+		TextureStreamRange range{};
+		range.streamed = true;
+		range.serial = entry.streamSerial;
+		range.format = entry.format;
+		range.baseWidth = entry.baseWidth;
+		range.baseHeight = entry.baseHeight;
+		range.mipCount = entry.mipCount;
+		range.tailFirstMip = entry.tailFirstMip;
+		range.firstMip = firstMip;
+		return range;
+	}
+
+	// Caller holds mutex_. Queues an upload of the cached tail; returns the bytes it will hold.
+	std::uint64_t DemoteToTail(Id id, TextureEntry& entry)
+	{
+		if (!entry.mipTail)
+		{
+			return entry.residentBytes;
+		}
+
+		++entry.streamSerial;
+		entry.streamPending = true;
+		entry.pendingBytes = EstimateUploadBytes(*entry.mipTail);
+		streamQueue_.Push(MakeTextureUploadTicket(id, entry.generation, *entry.mipTail, StreamRangeOf(entry, entry.tailFirstMip)));
+		return entry.pendingBytes;
+	}
+
+	// Caller holds mutex_.
+	static void AbandonStream(TextureEntry& entry) noexcept
+	{
+		entry.streamPending = false;
+		entry.pendingBytes = 0;
+	}
+
+	// Render queue, caller holds mutex_. Installs an uploaded texture; a mip-range change swaps
+	// it in and retires the texture it replaces (the device defers the release past in-flight
+	// frames).
+	void Publish(
+		TextureEntry& entry,
+		GPUTexture texture,
+		const TextureStreamRange& range,
+		std::uint64_t bytes,
+		std::shared_ptr<const TextureCPUData> cpu,
+		std::vector<GPUTexture>& destroyList)
+	{
+		if (range.serial == 0)
+		{
+			entry.streamed = range.streamed;
+			entry.format = range.format;
+			entry.baseWidth = range.baseWidth;
+			entry.baseHeight = range.baseHeight;
+			entry.mipCount = range.mipCount;
+			entry.tailFirstMip = range.tailFirstMip;
+			entry.requestedFirstMip = range.firstMip;
+			entry.lastFeedbackFrame = streamFrame_;
+			entry.residentBytes = 0;
+			entry.mipTail = range.streamed ? std::move(cpu) : nullptr;
+			entry.state = ResourceState::Loaded;
+			entry.error.clear();
+		}
+		else
+		{
+			destroyList.push_back(entry.textureHandle->GetResource());
+			AbandonStream(entry);
+		}
+
+		if (entry.streamed)
+		{
+			streamedResidentBytes_ -= entry.residentBytes;
+			streamedResidentBytes_ += bytes;
+			entry.residentBytes = bytes;
+			entry.residentFirstMip = range.firstMip;
+		}
+		entry.gpuBytes = bytes;
+		entry.textureHandle->SetResource(texture);
+	}
+
+	// Queues the decode of one generation of an entry; the result travels to ProcessUploads
+	// through uploadQueue_.
+	void EnqueueDecode(
+		Id stableKey,
+		std::uint64_t generation,
+		TextureProperties propertiesCopy,
+		std::string path,
+		const TextureStreamingSettings& streaming,
+		TextureIO& io,
+		jobs::CancellationToken entryToken)
+	{
+		const jobs::JobPriority priority = propertiesCopy.streamingPriority;
+
+		TextureIO ioCopy = io;
+		const TextureProperties properties = propertiesCopy;
+		const std::string sourcePath = path;
+
+		EnqueueDecodeJob(io, properties, sourcePath, priority, std::move(entryToken), [this,
+			key = stableKey,
+			generation,
+			propertiesCopy = std::move(propertiesCopy),
+			path = std::move(path),
+			streaming,
+			ioCopy](const std::vector<corefs::FileReadResult>* files) mutable
+			{
+				if (ioCopy.cancellation.IsCancelled())
+				{
+					MarkCancelled(key, generation);
+					return;
+				}
+
+				std::optional<TextureCPUData> cpuOpt{};
+				std::string decodeError{};
+				try
+				{
+					cpuOpt = DecodeWith(ioCopy.decoder, propertiesCopy, path, files);
+				}
+				catch (const std::exception& e)
+				{
+					decodeError = e.what();
+				}
+				catch (...)
+				{
+					decodeError = "Texture decode threw (unknown exception)";
+				}
+
+				if (cpuOpt)
+				{
+					// Large 2D textures start as their mip tail; UpdateMipStreaming refines them.
+					TextureStreamRange range{};
+					if (streaming.enabled && propertiesCopy.allowMipStreaming)
+					{
+						range = MakeStreamRange(*cpuOpt, streaming.mipTailMaxDimension);
+						DropTopMips(*cpuOpt, range.firstMip);
+					}
+
+					// Hot path: publish without the entry lock; ProcessUploads validates the generation.
+					uploadQueue_.Push(MakeTextureUploadTicket(key, generation, std::move(*cpuOpt), range));
+					return;
+				}
+
+				std::scoped_lock lock(mutex_);
+				auto it = entries_.find(key);
+				if (it == entries_.end())
+				{
+					return;
+				}
+
+				TextureEntry& entry = it->second;
+				if (entry.generation != generation || entry.state != ResourceState::Loading)
+				{
+					return;
+				}
+
+				entry.state = ResourceState::Failed;
+				entry.error = decodeError.empty() ? "Texture decode failed" : decodeError;
+			});
+	}
+
+	// Queues `decode(files)` on the job system. With a file reader and a decoder that lists its
+	// source files, the job is queued only once they are read (`files` non-null), so it never
+	// waits on the disk; otherwise `files` is null and the decoder reads them itself.
+	template <typename DecodeFn>
+	static void EnqueueDecodeJob(
+		TextureIO& io,
+		const TextureProperties& properties,
+		std::string_view path,
+		jobs::JobPriority priority,
+		jobs::CancellationToken token,
+		DecodeFn decode)
+	{
+		std::vector<std::string> sources{};
+		if (io.files != nullptr)
+		{
+			sources = io.decoder.SourceFiles(properties, path);
+		}
+
+		if (sources.empty())
+		{
+			io.jobs.Enqueue([decode = std::move(decode)]() mutable
+				{
+					decode(nullptr);
+				}, priority, std::move(token));
+			return;
+		}
+
+		IJobSystem& jobSystem = io.jobs;
+		jobs::CancellationToken readToken = token;
+		io.files->ReadBatch(
+			std::vector<std::filesystem::path>(sources.begin(), sources.end()),
+			[&jobSystem, priority, token = std::move(token), decode = std::move(decode)](std::vector<corefs::FileReadResult>&& files) mutable
+			{
+				jobSystem.Enqueue([decode = std::move(decode), files = std::move(files)]() mutable
+					{
+						decode(&files);
+					}, priority, std::move(token));
+			},
+			std::move(readToken));
+	}
+
+	static std::optional<TextureCPUData> DecodeWith(
+		ITextureDecoder& decoder,
+		const TextureProperties& properties,
+		std::string_view path,
+		const std::vector<corefs::FileReadResult>* files)
+	{
+		if (files == nullptr)
+		{
+			return decoder.Decode(properties, path);
+		}
+
+		std::vector<std::span<const std::byte>> bytes;
+		bytes.reserve(files->size());
+		for (const corefs::FileReadResult& file : *files)
+		{
+			if (!file.Ok())
+			{
+				throw std::runtime_error(file.error);
+			}
+			bytes.push_back(file.Bytes());
+		}
+		return decoder.DecodeFromMemory(properties, path, bytes);
+	}
+
+	static std::string DecodePathOf(const TextureProperties& properties, std::string_view id)
+	{
+		return properties.filePath.empty() ? std::string(id) : properties.filePath;
+	}
+
+	// Decode dropped by TextureIO::cancellation: put the entry back so a later request restarts it.
+	void MarkCancelled(Id key, std::uint64_t generation)
+	{
+		std::scoped_lock lock(mutex_);
+		auto it = entries_.find(key);
+		if (it != entries_.end() && it->second.generation == generation && it->second.state == ResourceState::Loading)
+		{
+			it->second.state = ResourceState::Unloaded;
+		}
+	}
+
+	// Caller holds mutex_.
 	void EnqueueDestroy(GPUTexture texture)
 	{
 		if (texture.id == 0)
 		{
 			return;
 		}
-		std::scoped_lock lock(mutex_);
 		destroyQueue_.push_back(texture);
 	}
 
 	mutable std::mutex mutex_{};
-	std::unordered_map<Id, TextureEntry> entries_;
-	std::deque<TextureUploadTicket> uploadQueue_;
+	containers::FlatHashMap<Id, TextureEntry, AssetIdHash> entries_;
+	jobs::MpscQueue<TextureUploadTicket> uploadQueue_;
+	jobs::MpscQueue<TextureUploadTicket> streamQueue_;
+	std::optional<TextureUploadTicket> deferredUpload_{};
+	UploadCostModel costModel_{};
+	UploadUsage lastUploadUsage_{};
+	std::vector<GpuInFlight> gpuInFlight_{};
+	std::atomic<std::size_t> gpuInFlightCount_{ 0 };
 	std::deque<GPUTexture> destroyQueue_;
+
+	TextureStreamingSettings streaming_{};
+	std::uint64_t streamFrame_{ 0 };
+	std::uint64_t streamedResidentBytes_{ 0 };
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+export module core:radix_sort;
+
+// Stable LSD radix sort on 64-bit keys, one byte per pass. All eight histograms come from a single
+// read of the input, and a pass whose digit is the same for every element is skipped, so packed
+// sort keys that leave most of their bits constant only pay for the bytes that actually vary.
+
+export namespace algorithms
+{
+	// Sorts `values` ascending by key(value); elements with equal keys keep their relative order.
+	// `scratch` must hold at least values.size() elements and is left with unspecified contents.
+	template <typename T, typename KeyFn>
+	void RadixSort64(std::span<T> values, std::span<T> scratch, KeyFn&& key)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "RadixSort64 moves elements by copy");
+
+		const std::size_t count = values.size();
+		if (count < 2)
+		{
+			return;
+		}
+		if (scratch.size() < count)
+		{
+			throw std::invalid_argument("RadixSort64: scratch is smaller than the input");
+		}
+
+		std::array<std::array<std::size_t, 256>, 8> histograms{};
+		for (const T& value : values)
+		{
+			const std::uint64_t k = key(value);
+			for (std::size_t digit = 0; digit < 8; ++digit)
+			{
+				++histograms[digit][(k >> (digit * 8)) & 0xFFu];
+			}
+		}
+
+		const std::uint64_t firstKey = key(values[0]);
+		T* src = values.data();
+		T* dst = scratch.data();
+		for (std::size_t digit = 0; digit < 8; ++digit)
+		{
+			std::array<std::size_t, 256>& histogram = histograms[digit];
+			const std::size_t shift = digit * 8;
+			if (histogram[(firstKey >> shift) & 0xFFu] == count)
+			{
+				continue;
+			}
+
+			std::size_t offset = 0;
+			for (std::size_t& bucket : histogram)
+			{
+				offset += std::exchange(bucket, offset);
+			}
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				dst[histogram[(key(src[i]) >> shift) & 0xFFu]++] = src[i];
+			}
+			std::swap(src, dst);
+		}
+
+		if (src != values.data())
+		{
+			std::copy(src, src + count, values.data());
+		}
+	}
+}
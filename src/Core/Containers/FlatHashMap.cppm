@@ -0,0 +1,286 @@
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+export module core:flat_hash_map;
+
+// Open-addressing hash map (linear probing, power-of-two capacity, tombstone erase). Slots are
+// one contiguous array plus a byte of control state each, so a lookup is a hash and a short scan
+// instead of a bucket-list walk.
+//
+// Unlike std::unordered_map, inserting may move every element (rehash): references, pointers
+// and iterators are only stable while nothing is inserted. Erasing never moves other elements,
+// so erase-while-iterating works as usual. Keys must not be modified through an iterator.
+
+export namespace containers
+{
+	template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+	class FlatHashMap
+	{
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<Key, Value>;
+		using size_type = std::size_t;
+
+	private:
+		enum class Ctrl : std::uint8_t
+		{
+			Empty,
+			Tombstone,
+			Full
+		};
+
+		template <bool Const>
+		class IteratorImpl
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = FlatHashMap::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+			using reference = std::conditional_t<Const, const value_type&, value_type&>;
+			using MapPtr = std::conditional_t<Const, const FlatHashMap*, FlatHashMap*>;
+
+			IteratorImpl() = default;
+			IteratorImpl(MapPtr map, std::size_t index) noexcept : map_(map), index_(index) { SkipFree(); }
+
+			// iterator -> const_iterator
+			template <bool OtherConst>
+				requires (Const && !OtherConst)
+			IteratorImpl(const IteratorImpl<OtherConst>& other) noexcept : map_(other.map_), index_(other.index_) {}
+
+			reference operator*() const noexcept { return *map_->slots_[index_]; }
+			pointer operator->() const noexcept { return &*map_->slots_[index_]; }
+
+			IteratorImpl& operator++() noexcept
+			{
+				++index_;
+				SkipFree();
+				return *this;
+			}
+
+			IteratorImpl operator++(int) noexcept
+			{
+				IteratorImpl copy = *this;
+				++*this;
+				return copy;
+			}
+
+			friend bool operator==(const IteratorImpl& a, const IteratorImpl& b) noexcept { return a.index_ == b.index_; }
+
+		private:
+			friend class FlatHashMap;
+			template <bool> friend class IteratorImpl;
+
+			void SkipFree() noexcept
+			{
+				while (index_ < map_->ctrl_.size() && map_->ctrl_[index_] != Ctrl::Full)
+				{
+					++index_;
+				}
+			}
+
+			MapPtr map_{};
+			std::size_t index_{ 0 };
+		};
+
+	public:
+		using iterator = IteratorImpl<false>;
+		using const_iterator = IteratorImpl<true>;
+
+		FlatHashMap() = default;
+
+		iterator begin() noexcept { return iterator(this, 0); }
+		iterator end() noexcept { return iterator(this, ctrl_.size()); }
+		const_iterator begin() const noexcept { return const_iterator(this, 0); }
+		const_iterator end() const noexcept { return const_iterator(this, ctrl_.size()); }
+
+		size_type size() const noexcept { return size_; }
+		bool empty() const noexcept { return size_ == 0; }
+
+		void clear() noexcept
+		{
+			ctrl_.clear();
+			slots_.clear();
+			size_ = 0;
+			tombstones_ = 0;
+		}
+
+		void reserve(size_type count)
+		{
+			std::size_t capacity = kMinCapacity;
+			while (!FitsLoad(count, capacity))
+			{
+				capacity *= 2;
+			}
+			if (capacity > ctrl_.size())
+			{
+				Rehash(capacity);
+			}
+		}
+
+		iterator find(const Key& key) noexcept
+		{
+			const std::optional<std::size_t> index = FindIndex(key);
+			return index ? iterator(this, *index) : end();
+		}
+
+		const_iterator find(const Key& key) const noexcept
+		{
+			const std::optional<std::size_t> index = FindIndex(key);
+			return index ? const_iterator(this, *index) : end();
+		}
+
+		bool contains(const Key& key) const noexcept
+		{
+			return FindIndex(key).has_value();
+		}
+
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+		{
+			if (const std::optional<std::size_t> index = FindIndex(key))
+			{
+				return { iterator(this, *index), false };
+			}
+
+			if (!FitsLoad(size_ + tombstones_ + 1, ctrl_.size()))
+			{
+				// Mostly tombstones: rebuild at the same size, otherwise grow.
+				Rehash(FitsLoad(size_ + 1, ctrl_.size()) ? ctrl_.size() : std::max(kMinCapacity, ctrl_.size() * 2));
+			}
+
+			const std::size_t index = InsertSlot(key);
+			slots_[index].emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { iterator(this, index), true };
+		}
+
+		template <typename V>
+		std::pair<iterator, bool> emplace(const Key& key, V&& value)
+		{
+			return try_emplace(key, std::forward<V>(value));
+		}
+
+		template <typename V>
+		std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+		{
+			auto [it, inserted] = try_emplace(key, std::forward<V>(value));
+			if (!inserted)
+			{
+				it->second = std::forward<V>(value);
+			}
+			return { it, inserted };
+		}
+
+		Value& operator[](const Key& key)
+		{
+			return try_emplace(key).first->second;
+		}
+
+		iterator erase(const_iterator pos) noexcept
+		{
+			const std::size_t index = pos.index_;
+			slots_[index].reset();
+			ctrl_[index] = Ctrl::Tombstone;
+			--size_;
+			++tombstones_;
+			return iterator(this, index + 1);
+		}
+
+		size_type erase(const Key& key) noexcept
+		{
+			if (const std::optional<std::size_t> index = FindIndex(key))
+			{
+				erase(const_iterator(this, *index));
+				return 1;
+			}
+			return 0;
+		}
+
+	private:
+		static constexpr std::size_t kMinCapacity = 16;
+
+		// Max load (live + tombstones) of 7/8.
+		static constexpr bool FitsLoad(std::size_t used, std::size_t capacity) noexcept
+		{
+			return used * 8 <= capacity * 7;
+		}
+
+		std::size_t Mask() const noexcept { return ctrl_.size() - 1; }
+
+		std::optional<std::size_t> FindIndex(const Key& key) const noexcept
+		{
+			if (ctrl_.empty())
+			{
+				return std::nullopt;
+			}
+
+			for (std::size_t index = Hash{}(key) & Mask(); ; index = (index + 1) & Mask())
+			{
+				switch (ctrl_[index])
+				{
+				case Ctrl::Empty:
+					return std::nullopt;
+				case Ctrl::Full:
+					if (KeyEqual{}(slots_[index]->first, key))
+					{
+						return index;
+					}
+					break;
+				case Ctrl::Tombstone:
+					break;
+				}
+			}
+		}
+
+		// First free slot on the probe sequence of `key` (caller checked it is absent and that
+		// the table has room), marked Full.
+		std::size_t InsertSlot(const Key& key) noexcept
+		{
+			std::size_t index = Hash{}(key) & Mask();
+			while (ctrl_[index] == Ctrl::Full)
+			{
+				index = (index + 1) & Mask();
+			}
+			if (ctrl_[index] == Ctrl::Tombstone)
+			{
+				--tombstones_;
+			}
+			ctrl_[index] = Ctrl::Full;
+			++size_;
+			return index;
+		}
+
+		void Rehash(std::size_t capacity)
+		{
+			std::vector<Ctrl> oldCtrl = std::exchange(ctrl_, std::vector<Ctrl>(capacity, Ctrl::Empty));
+			std::vector<std::optional<value_type>> oldSlots = std::exchange(slots_, std::vector<std::optional<value_type>>(capacity));
+			size_ = 0;
+			tombstones_ = 0;
+
+			for (std::size_t i = 0; i < oldCtrl.size(); ++i)
+			{
+				if (oldCtrl[i] == Ctrl::Full)
+				{
+					const std::size_t index = InsertSlot(oldSlots[i]->first);
+					slots_[index].emplace(std::move(*oldSlots[i]));
+				}
+			}
+		}
+
+		std::vector<Ctrl> ctrl_{};
+		std::vector<std::optional<value_type>> slots_{};
+		std::size_t size_{ 0 };
+		std::size_t tombstones_{ 0 };
+	};
+}
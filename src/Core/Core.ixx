@@ -3,6 +3,7 @@ export module core;
 export import :resource_manager;
 export import :asset_manager;
 export import :input;
+export import :input_events;
 export import :input_core;
 export import :controller_base;
 export import :win32_input;
@@ -17,10 +18,18 @@ export import :skinned_mesh;
 export import :obj_loader;
 export import :math_utils;
 export import :geometry;
+export import :job_system;
+export import :mpsc_queue;
+export import :profiler;
+export import :flat_hash_map;
+export import :frame_arena;
+export import :memory_tracking;
+export import :radix_sort;
 export import :EnTTHelpers;
 export import :gameplay;
 export import :gameplay_graph;
 export import :gameplay_runtime;
+export import :gameplay_system_scheduler;
 
 #if defined(CORE_USE_DX12)
 export import :render_dx12;
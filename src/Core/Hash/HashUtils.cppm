@@ -3,12 +3,6 @@ module;
 export module core:hash_utils;
 
 import std;
-import :mesh;
-import :rhi;
-import :math_utils;
-#if defined(CORE_USE_DX12)
-import :common_DX12_Structs;
-#endif
 
 export namespace hashUtils
 {
@@ -17,52 +11,42 @@ export namespace hashUtils
 		seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
 	}
 
-#if defined(CORE_USE_DX12)
-	struct BatchKeyHash
-	{
-		static std::size_t HashU32(std::uint32_t value) noexcept { return std::hash<std::uint32_t>{}(value); }
-		static std::size_t HashPtr(const void* ptr) noexcept { return std::hash<const void*>{}(ptr); }
+	inline constexpr std::uint64_t kFnv1a64Offset = 0xcbf29ce484222325ull;
+	inline constexpr std::uint64_t kFnv1a64Prime = 0x00000100000001b3ull;
 
-		static std::uint32_t FloatBits(float value) noexcept
+	// 64-bit FNV-1a. constexpr so ids of literal names fold at compile time.
+	constexpr std::uint64_t Fnv1a64(std::string_view text, std::uint64_t seed = kFnv1a64Offset) noexcept
+	{
+		std::uint64_t hash = seed;
+		for (const char c : text)
 		{
-			std::uint32_t bits{};
-			std::memcpy(&bits, &value, sizeof(bits));
-			return bits;
+			hash ^= static_cast<std::uint8_t>(c);
+			hash *= kFnv1a64Prime;
 		}
+		return hash;
+	}
 
-		std::size_t operator()(const rendern::BatchKey& key) const noexcept
+	// Same hash over raw bytes; equal to the string_view overload for the same byte sequence.
+	constexpr std::uint64_t Fnv1a64(std::span<const std::byte> bytes, std::uint64_t seed = kFnv1a64Offset) noexcept
+	{
+		std::uint64_t hash = seed;
+		for (const std::byte b : bytes)
 		{
-			std::size_t seed = HashPtr(key.mesh);
-
-			HashCombine(seed, HashU32(key.permBits));
-
-			HashCombine(seed, HashU32(key.envSource));
-			HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.reflectionProbeIndex)));
-
-			HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.albedoDescIndex)));
-			HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.normalDescIndex)));
-			HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.metalnessDescIndex)));
-			HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.roughnessDescIndex)));
-			HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.aoDescIndex)));
-			HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.emissiveDescIndex)));
-
-			HashCombine(seed, HashU32(FloatBits(key.baseColor.x)));
-			HashCombine(seed, HashU32(FloatBits(key.baseColor.y)));
-			HashCombine(seed, HashU32(FloatBits(key.baseColor.z)));
-			HashCombine(seed, HashU32(FloatBits(key.baseColor.w)));
-
-			HashCombine(seed, HashU32(FloatBits(key.shadowBias)));
-
-			HashCombine(seed, HashU32(FloatBits(key.metallic)));
-			HashCombine(seed, HashU32(FloatBits(key.roughness)));
-			HashCombine(seed, HashU32(FloatBits(key.ao)));
-			HashCombine(seed, HashU32(FloatBits(key.emissiveStrength)));
-
-			// Legacy
-			HashCombine(seed, HashU32(FloatBits(key.shininess)));
-			HashCombine(seed, HashU32(FloatBits(key.specStrength)));
-			return seed;
+			hash ^= static_cast<std::uint8_t>(b);
+			hash *= kFnv1a64Prime;
 		}
-	};
-#endif
-}
\ No newline at end of file
+		return hash;
+	}
+
+	// splitmix64 finalizer: spreads every input bit over the low bits that power-of-two
+	// tables index with.
+	constexpr std::uint64_t Mix64(std::uint64_t x) noexcept
+	{
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ull;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebull;
+		x ^= x >> 31;
+		return x;
+	}
+}
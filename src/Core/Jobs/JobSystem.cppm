@@ -0,0 +1,952 @@
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+export module core:job_system;
+
+import :profiler;
+
+// Work-stealing job scheduler
+//
+// Every worker owns a Chase-Lev deque: the owner pushes/pops at the bottom without locks,
+// idle workers steal from the top of other deques. Jobs submitted from non-worker threads
+// (main thread, render thread) go through lock-free injection lists that workers
+// drain in batches, so there is no per-job mutex anywhere on the hot path.
+//
+// Job nodes are pooled and addressed by index. A JobHandle is (index, generation): the
+// generation is bumped when the job finishes, so a stale handle simply reports "done".
+//
+// Each priority class has its own deques and injection list. Workers always look for
+// Critical work first (own deque, injected, stolen) before falling back to lower classes.
+
+export namespace jobs
+{
+	inline constexpr std::uint32_t kInvalidJobIndex = 0xFFFFFFFFu;
+
+	enum class JobPriority : std::uint8_t
+	{
+		Critical,   // Needed this frame (sync loads, render-side work).
+		Visible,    // Resources the camera is currently looking at (default).
+		Prefetch,   // Likely needed soon (level manifests, neighbouring cells).
+		Background  // Large/low value work: skyboxes, cooking, warm-up.
+	};
+
+	inline constexpr std::size_t kJobPriorityCount = 4;
+
+	// Read side of a cancellation flag. A default-constructed token is never cancelled.
+	class CancellationToken
+	{
+	public:
+		CancellationToken() noexcept = default;
+
+		[[nodiscard]] bool IsCancelled() const noexcept
+		{
+			return state_ && state_->load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] bool CanBeCancelled() const noexcept { return state_ != nullptr; }
+
+	private:
+		friend class CancellationSource;
+
+		explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> state) noexcept
+			: state_(std::move(state))
+		{
+		}
+
+		std::shared_ptr<const std::atomic<bool>> state_{};
+	};
+
+	class CancellationSource
+	{
+	public:
+		CancellationSource()
+			: state_(std::make_shared<std::atomic<bool>>(false))
+		{
+		}
+
+		void Cancel() noexcept
+		{
+			state_->store(true, std::memory_order_release);
+		}
+
+		[[nodiscard]] bool IsCancelled() const noexcept
+		{
+			return state_->load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] CancellationToken GetToken() const
+		{
+			return CancellationToken(state_);
+		}
+
+	private:
+		std::shared_ptr<std::atomic<bool>> state_;
+	};
+
+	namespace detail
+	{
+		struct JobFunctionOps
+		{
+			void (*invoke)(void* storage);
+			void (*move)(void* dst, void* src) noexcept;
+			void (*destroy)(void* storage) noexcept;
+		};
+
+		template <class F>
+		void InlineInvoke(void* storage)
+		{
+			(*std::launder(static_cast<F*>(storage)))();
+		}
+
+		template <class F>
+		void InlineMove(void* dst, void* src) noexcept
+		{
+			F* from = std::launder(static_cast<F*>(src));
+			::new (dst) F(std::move(*from));
+			from->~F();
+		}
+
+		template <class F>
+		void InlineDestroy(void* storage) noexcept
+		{
+			std::launder(static_cast<F*>(storage))->~F();
+		}
+
+		template <class F>
+		void HeapInvoke(void* storage)
+		{
+			(**static_cast<F**>(storage))();
+		}
+
+		template <class F>
+		void HeapMove(void* dst, void* src) noexcept
+		{
+			*static_cast<F**>(dst) = *static_cast<F**>(src);
+			*static_cast<F**>(src) = nullptr;
+		}
+
+		template <class F>
+		void HeapDestroy(void* storage) noexcept
+		{
+			delete *static_cast<F**>(storage);
+		}
+
+		template <class F>
+		inline constexpr JobFunctionOps kInlineOps{ &InlineInvoke<F>, &InlineMove<F>, &InlineDestroy<F> };
+
+		template <class F>
+		inline constexpr JobFunctionOps kHeapOps{ &HeapInvoke<F>, &HeapMove<F>, &HeapDestroy<F> };
+	}
+
+	// Move-only void() callable with inline storage. Callables up to kInlineSize bytes
+	// (this includes a whole std::function on every major STL) never touch the heap.
+	class JobFunction
+	{
+	public:
+		static constexpr std::size_t kInlineSize = 64;
+
+		JobFunction() noexcept = default;
+
+		template <class F>
+			requires (!std::same_as<std::remove_cvref_t<F>, JobFunction>) && std::invocable<std::decay_t<F>&>
+		JobFunction(F&& function)
+		{
+			using Fn = std::decay_t<F>;
+			if constexpr (kFitsInline<Fn>)
+			{
+				::new (static_cast<void*>(storage_)) Fn(std::forward<F>(function));
+				ops_ = &detail::kInlineOps<Fn>;
+			}
+			else
+			{
+				::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(function)));
+				ops_ = &detail::kHeapOps<Fn>;
+			}
+		}
+
+		JobFunction(JobFunction&& other) noexcept
+		{
+			MoveFrom(other);
+		}
+
+		JobFunction& operator=(JobFunction&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Reset();
+				MoveFrom(other);
+			}
+			return *this;
+		}
+
+		JobFunction(const JobFunction&) = delete;
+		JobFunction& operator=(const JobFunction&) = delete;
+
+		~JobFunction()
+		{
+			Reset();
+		}
+
+		explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+		void operator()()
+		{
+			ops_->invoke(storage_);
+		}
+
+		void Reset() noexcept
+		{
+			if (ops_)
+			{
+				ops_->destroy(storage_);
+				ops_ = nullptr;
+			}
+		}
+
+		template <class F>
+		static constexpr bool kFitsInline =
+			sizeof(F) <= kInlineSize
+			&& alignof(F) <= alignof(std::max_align_t)
+			&& std::is_nothrow_move_constructible_v<F>;
+
+	private:
+		void MoveFrom(JobFunction& other) noexcept
+		{
+			if (other.ops_)
+			{
+				other.ops_->move(storage_, other.storage_);
+				ops_ = other.ops_;
+				other.ops_ = nullptr;
+			}
+		}
+
+		alignas(std::max_align_t) std::byte storage_[kInlineSize];
+		const detail::JobFunctionOps* ops_{ nullptr };
+	};
+
+	struct JobHandle
+	{
+		std::uint32_t index{ kInvalidJobIndex };
+		std::uint32_t generation{ 0 };
+
+		[[nodiscard]] bool IsValid() const noexcept { return index != kInvalidJobIndex; }
+	};
+
+	// Chase-Lev deque of job indices ("Correct and Efficient Work-Stealing for Weak Memory Models").
+	// Push/Pop: owner thread only. Steal: any thread.
+	class WorkStealingDeque
+	{
+	public:
+		WorkStealingDeque() : WorkStealingDeque(1024) {}
+
+		explicit WorkStealingDeque(std::int64_t initialCapacity)
+		{
+			std::int64_t capacity = 1;
+			while (capacity < initialCapacity)
+			{
+				capacity <<= 1;
+			}
+			rings_.push_back(std::make_unique<Ring>(capacity));
+			ring_.store(rings_.back().get(), std::memory_order_relaxed);
+		}
+
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+		void Push(std::uint32_t value)
+		{
+			const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+			const std::int64_t t = top_.load(std::memory_order_acquire);
+			Ring* ring = ring_.load(std::memory_order_relaxed);
+			if (b - t > ring->capacity - 1)
+			{
+				ring = Grow(ring, b, t);
+			}
+			ring->Put(b, value);
+			bottom_.store(b + 1, std::memory_order_release);
+		}
+
+		std::uint32_t Pop()
+		{
+			const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+			Ring* ring = ring_.load(std::memory_order_relaxed);
+			bottom_.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t t = top_.load(std::memory_order_relaxed);
+
+			if (t > b)
+			{
+				// Empty.
+				bottom_.store(b + 1, std::memory_order_relaxed);
+				return kInvalidJobIndex;
+			}
+
+			std::uint32_t value = ring->Get(b);
+			if (t == b)
+			{
+				// Last element: race against stealers.
+				if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					value = kInvalidJobIndex;
+				}
+				bottom_.store(b + 1, std::memory_order_relaxed);
+			}
+			return value;
+		}
+
+		std::uint32_t Steal()
+		{
+			std::int64_t t = top_.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const std::int64_t b = bottom_.load(std::memory_order_acquire);
+			if (t >= b)
+			{
+				return kInvalidJobIndex;
+			}
+
+			Ring* ring = ring_.load(std::memory_order_acquire);
+			const std::uint32_t value = ring->Get(t);
+			if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				// Lost the race to the owner or another thief.
+				return kInvalidJobIndex;
+			}
+			return value;
+		}
+
+		[[nodiscard]] std::int64_t SizeApprox() const noexcept
+		{
+			const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+			const std::int64_t t = top_.load(std::memory_order_relaxed);
+			return b > t ? (b - t) : 0;
+		}
+
+	private:
+		struct Ring
+		{
+			explicit Ring(std::int64_t inCapacity)
+				: capacity(inCapacity)
+				, mask(inCapacity - 1)
+				, slots(std::make_unique<std::atomic<std::uint32_t>[]>(static_cast<std::size_t>(inCapacity)))
+			{
+			}
+
+			void Put(std::int64_t i, std::uint32_t value) noexcept
+			{
+				slots[static_cast<std::size_t>(i & mask)].store(value, std::memory_order_relaxed);
+			}
+
+			std::uint32_t Get(std::int64_t i) const noexcept
+			{
+				return slots[static_cast<std::size_t>(i & mask)].load(std::memory_order_relaxed);
+			}
+
+			std::int64_t capacity;
+			std::int64_t mask;
+			std::unique_ptr<std::atomic<std::uint32_t>[]> slots;
+		};
+
+		Ring* Grow(Ring* old, std::int64_t b, std::int64_t t)
+		{
+			auto bigger = std::make_unique<Ring>(old->capacity * 2);
+			for (std::int64_t i = t; i < b; ++i)
+			{
+				bigger->Put(i, old->Get(i));
+			}
+
+			// Thieves may still be reading the old ring, so it stays alive until the deque dies.
+			Ring* raw = bigger.get();
+			rings_.push_back(std::move(bigger));
+			ring_.store(raw, std::memory_order_release);
+			return raw;
+		}
+
+		alignas(64) std::atomic<std::int64_t> top_{ 0 };
+		alignas(64) std::atomic<std::int64_t> bottom_{ 0 };
+		std::atomic<Ring*> ring_{ nullptr };
+		std::vector<std::unique_ptr<Ring>> rings_;
+	};
+
+	struct JobOptions
+	{
+		JobPriority priority{ JobPriority::Visible };
+
+		// Checked right before the job body runs; a cancelled job still completes its handle.
+		CancellationToken cancellation{};
+	};
+
+	class Scheduler;
+
+	namespace detail
+	{
+		struct WorkerContext
+		{
+			Scheduler* scheduler{ nullptr };
+			std::uint32_t index{ kInvalidJobIndex };
+		};
+	}
+
+	class Scheduler
+	{
+	public:
+		explicit Scheduler(std::uint32_t workerCount = 1)
+		{
+			if (workerCount == 0)
+			{
+				workerCount = 1;
+			}
+
+			workers_.reserve(workerCount);
+			for (std::uint32_t i = 0; i < workerCount; ++i)
+			{
+				workers_.push_back(std::make_unique<Worker>(0x9E3779B9u * (i + 1u)));
+			}
+
+			threads_.reserve(workerCount);
+			for (std::uint32_t i = 0; i < workerCount; ++i)
+			{
+				threads_.emplace_back([this, i](std::stop_token st) { WorkerMain(st, i); });
+			}
+		}
+
+		~Scheduler()
+		{
+			stopping_.store(true, std::memory_order_seq_cst);
+			for (auto& thread : threads_)
+			{
+				thread.request_stop();
+			}
+			WakeWorkers(/*all=*/true);
+			threads_.clear(); // joins
+		}
+
+		Scheduler(const Scheduler&) = delete;
+		Scheduler& operator=(const Scheduler&) = delete;
+
+		std::uint32_t GetWorkerCount() const noexcept
+		{
+			return static_cast<std::uint32_t>(workers_.size());
+		}
+
+		// Allocates a job without making it runnable. Use this when children must be attached
+		// before the parent can possibly finish (fan-out/join from outside a job).
+		// Every created job must be passed to Run(), otherwise WaitIdle() never returns.
+		JobHandle CreateJob(JobFunction function, JobHandle parent = {}, JobOptions options = {})
+		{
+			const std::uint32_t index = pool_.Allocate();
+			JobNode& node = pool_.Node(index);
+			node.function = std::move(function);
+			node.cancellation = std::move(options.cancellation);
+			node.priority = options.priority;
+			node.parent = kInvalidJobIndex;
+			node.unfinished.store(1, std::memory_order_relaxed);
+
+			if (parent.IsValid())
+			{
+				// Valid only while the parent has not finished: before Run(parent) or from inside its body.
+				JobNode& parentNode = pool_.Node(parent.index);
+				parentNode.unfinished.fetch_add(1, std::memory_order_relaxed);
+				node.parent = parent.index;
+			}
+
+			liveJobs_.fetch_add(1, std::memory_order_relaxed);
+			return JobHandle{ index, node.generation.load(std::memory_order_relaxed) };
+		}
+
+		void Run(JobHandle job)
+		{
+			if (!job.IsValid())
+			{
+				return;
+			}
+
+			const std::size_t priority = static_cast<std::size_t>(pool_.Node(job.index).priority);
+			if (Worker* self = CurrentWorker())
+			{
+				self->deques[priority].Push(job.index);
+			}
+			else
+			{
+				PushInjected(job.index, priority);
+			}
+			WakeWorkers(/*all=*/false);
+		}
+
+		JobHandle Schedule(JobFunction function, JobHandle parent = {}, JobOptions options = {})
+		{
+			const JobHandle job = CreateJob(std::move(function), parent, std::move(options));
+			Run(job);
+			return job;
+		}
+
+		[[nodiscard]] bool IsDone(JobHandle job) const noexcept
+		{
+			if (!job.IsValid())
+			{
+				return true;
+			}
+			return pool_.Node(job.index).generation.load(std::memory_order_acquire) != job.generation;
+		}
+
+		// Worker threads keep executing other jobs while waiting; other threads block.
+		void Wait(JobHandle job)
+		{
+			if (!job.IsValid())
+			{
+				return;
+			}
+
+			if (CurrentWorker() != nullptr)
+			{
+				const std::uint32_t self = tlsWorker_.index;
+				while (!IsDone(job))
+				{
+					if (!RunOne(self))
+					{
+						std::this_thread::yield();
+					}
+				}
+				return;
+			}
+
+			JobNode& node = pool_.Node(job.index);
+			externalWaiters_.fetch_add(1, std::memory_order_seq_cst);
+			while (node.generation.load(std::memory_order_seq_cst) == job.generation)
+			{
+				node.generation.wait(job.generation, std::memory_order_seq_cst);
+			}
+			externalWaiters_.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void WaitIdle()
+		{
+			if (CurrentWorker() != nullptr)
+			{
+				const std::uint32_t self = tlsWorker_.index;
+				while (liveJobs_.load(std::memory_order_acquire) != 0)
+				{
+					if (!RunOne(self))
+					{
+						std::this_thread::yield();
+					}
+				}
+				return;
+			}
+
+			externalWaiters_.fetch_add(1, std::memory_order_seq_cst);
+			for (;;)
+			{
+				const std::uint64_t live = liveJobs_.load(std::memory_order_seq_cst);
+				if (live == 0)
+				{
+					break;
+				}
+				liveJobs_.wait(live, std::memory_order_seq_cst);
+			}
+			externalWaiters_.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		// Index of the calling worker thread, or kInvalidJobIndex for non-worker threads.
+		[[nodiscard]] std::uint32_t CurrentWorkerIndex() const noexcept
+		{
+			return (tlsWorker_.scheduler == this) ? tlsWorker_.index : kInvalidJobIndex;
+		}
+
+	private:
+		struct alignas(64) JobNode
+		{
+			JobFunction function{};
+			CancellationToken cancellation{};
+			std::atomic<std::uint32_t> unfinished{ 0 };
+			std::atomic<std::uint32_t> generation{ 0 };
+			std::atomic<std::uint32_t> nextFree{ kInvalidJobIndex };
+			std::atomic<std::uint32_t> nextInjected{ kInvalidJobIndex };
+			std::uint32_t parent{ kInvalidJobIndex };
+			JobPriority priority{ JobPriority::Visible };
+		};
+
+		// Chunked node pool. Free list is a Treiber stack whose head carries an ABA tag in the high bits.
+		class JobPool
+		{
+		public:
+			static constexpr std::uint32_t kChunkShift = 10;
+			static constexpr std::uint32_t kChunkSize = 1u << kChunkShift;
+			static constexpr std::uint32_t kMaxChunks = 1024;
+
+			JobPool()
+			{
+				for (auto& chunk : chunks_)
+				{
+					chunk.store(nullptr, std::memory_order_relaxed);
+				}
+			}
+
+			~JobPool()
+			{
+				const std::uint32_t count = chunkCount_.load(std::memory_order_relaxed);
+				for (std::uint32_t i = 0; i < count; ++i)
+				{
+					delete[] chunks_[i].load(std::memory_order_relaxed);
+				}
+			}
+
+			JobNode& Node(std::uint32_t index) const noexcept
+			{
+				return chunks_[index >> kChunkShift].load(std::memory_order_acquire)[index & (kChunkSize - 1u)];
+			}
+
+			std::uint32_t Allocate()
+			{
+				for (;;)
+				{
+					std::uint64_t head = freeHead_.load(std::memory_order_acquire);
+					while (Index(head) != kInvalidJobIndex)
+					{
+						const std::uint32_t index = Index(head);
+						const std::uint32_t next = Node(index).nextFree.load(std::memory_order_relaxed);
+						if (freeHead_.compare_exchange_weak(head, Pack(Tag(head) + 1u, next), std::memory_order_acq_rel, std::memory_order_acquire))
+						{
+							return index;
+						}
+					}
+					Grow();
+				}
+			}
+
+			void Free(std::uint32_t index) noexcept
+			{
+				JobNode& node = Node(index);
+				std::uint64_t head = freeHead_.load(std::memory_order_relaxed);
+				do
+				{
+					node.nextFree.store(Index(head), std::memory_order_relaxed);
+				} while (!freeHead_.compare_exchange_weak(head, Pack(Tag(head) + 1u, index), std::memory_order_release, std::memory_order_relaxed));
+			}
+
+		private:
+			static constexpr std::uint32_t Index(std::uint64_t packed) noexcept { return static_cast<std::uint32_t>(packed); }
+			static constexpr std::uint32_t Tag(std::uint64_t packed) noexcept { return static_cast<std::uint32_t>(packed >> 32u); }
+			static constexpr std::uint64_t Pack(std::uint32_t tag, std::uint32_t index) noexcept
+			{
+				return (static_cast<std::uint64_t>(tag) << 32u) | index;
+			}
+
+			void Grow()
+			{
+				std::scoped_lock lock(growMutex_);
+				if (Index(freeHead_.load(std::memory_order_acquire)) != kInvalidJobIndex)
+				{
+					return; // Somebody else refilled the list.
+				}
+
+				const std::uint32_t chunkIndex = chunkCount_.load(std::memory_order_relaxed);
+				if (chunkIndex >= kMaxChunks)
+				{
+					throw std::bad_alloc{};
+				}
+
+				JobNode* chunk = new JobNode[kChunkSize];
+				const std::uint32_t base = chunkIndex << kChunkShift;
+				for (std::uint32_t i = 0; i + 1u < kChunkSize; ++i)
+				{
+					chunk[i].nextFree.store(base + i + 1u, std::memory_order_relaxed);
+				}
+				chunks_[chunkIndex].store(chunk, std::memory_order_release);
+				chunkCount_.store(chunkIndex + 1u, std::memory_order_release);
+
+				// Splice the whole chunk in front of the (possibly refilled by Free) list.
+				JobNode& last = chunk[kChunkSize - 1u];
+				std::uint64_t head = freeHead_.load(std::memory_order_relaxed);
+				do
+				{
+					last.nextFree.store(Index(head), std::memory_order_relaxed);
+				} while (!freeHead_.compare_exchange_weak(head, Pack(Tag(head) + 1u, base), std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			std::atomic<JobNode*> chunks_[kMaxChunks];
+			std::atomic<std::uint32_t> chunkCount_{ 0 };
+			std::atomic<std::uint64_t> freeHead_{ Pack(0u, kInvalidJobIndex) };
+			std::mutex growMutex_;
+		};
+
+		struct Worker
+		{
+			explicit Worker(std::uint32_t seed) : rng(seed ? seed : 1u) {}
+
+			WorkStealingDeque deques[kJobPriorityCount];
+			std::uint32_t rng;
+		};
+
+		Worker* CurrentWorker() noexcept
+		{
+			return (tlsWorker_.scheduler == this) ? workers_[tlsWorker_.index].get() : nullptr;
+		}
+
+		void PushInjected(std::uint32_t index, std::size_t priority) noexcept
+		{
+			JobNode& node = pool_.Node(index);
+			std::atomic<std::uint32_t>& injectedHead = injected_[priority].head;
+			std::uint32_t head = injectedHead.load(std::memory_order_relaxed);
+			do
+			{
+				node.nextInjected.store(head, std::memory_order_relaxed);
+			} while (!injectedHead.compare_exchange_weak(head, index, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		// Moves every injected job onto the caller's deque (oldest ends up at the bottom, so the
+		// owner runs submissions roughly in FIFO order while thieves take the newest).
+		bool DrainInjected(Worker& self, std::size_t priority) noexcept
+		{
+			std::atomic<std::uint32_t>& injectedHead = injected_[priority].head;
+			if (injectedHead.load(std::memory_order_relaxed) == kInvalidJobIndex)
+			{
+				return false;
+			}
+
+			std::uint32_t index = injectedHead.exchange(kInvalidJobIndex, std::memory_order_acquire);
+			if (index == kInvalidJobIndex)
+			{
+				return false;
+			}
+
+			while (index != kInvalidJobIndex)
+			{
+				const std::uint32_t next = pool_.Node(index).nextInjected.load(std::memory_order_relaxed);
+				self.deques[priority].Push(index);
+				index = next;
+			}
+			return true;
+		}
+
+		std::uint32_t TrySteal(std::uint32_t selfIndex, std::size_t priority) noexcept
+		{
+			const std::uint32_t count = static_cast<std::uint32_t>(workers_.size());
+			if (count <= 1u)
+			{
+				return kInvalidJobIndex;
+			}
+
+			Worker& self = *workers_[selfIndex];
+			self.rng ^= self.rng << 13u;
+			self.rng ^= self.rng >> 17u;
+			self.rng ^= self.rng << 5u;
+
+			const std::uint32_t start = self.rng % count;
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				const std::uint32_t victim = (start + i) % count;
+				if (victim == selfIndex)
+				{
+					continue;
+				}
+
+				const std::uint32_t stolen = workers_[victim]->deques[priority].Steal();
+				if (stolen != kInvalidJobIndex)
+				{
+					return stolen;
+				}
+			}
+			return kInvalidJobIndex;
+		}
+
+		bool RunOne(std::uint32_t selfIndex)
+		{
+			Worker& self = *workers_[selfIndex];
+
+			for (std::size_t priority = 0; priority < kJobPriorityCount; ++priority)
+			{
+				std::uint32_t index = self.deques[priority].Pop();
+				if (index == kInvalidJobIndex && DrainInjected(self, priority))
+				{
+					index = self.deques[priority].Pop();
+				}
+				if (index == kInvalidJobIndex)
+				{
+					index = TrySteal(selfIndex, priority);
+				}
+				if (index != kInvalidJobIndex)
+				{
+					Execute(index);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void Execute(std::uint32_t index)
+		{
+			JobNode& node = pool_.Node(index);
+			if (node.function && !node.cancellation.IsCancelled())
+			{
+				try { node.function(); }
+				catch (...) { /* swallow, same policy as JobSystemThreadPool */ }
+			}
+			node.function.Reset();
+			node.cancellation = {};
+			Finish(index);
+		}
+
+		void Finish(std::uint32_t index) noexcept
+		{
+			while (index != kInvalidJobIndex)
+			{
+				JobNode& node = pool_.Node(index);
+				if (node.unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				{
+					return;
+				}
+
+				const std::uint32_t parent = node.parent;
+				node.generation.fetch_add(1, std::memory_order_seq_cst);
+				if (externalWaiters_.load(std::memory_order_seq_cst) != 0)
+				{
+					node.generation.notify_all();
+				}
+				pool_.Free(index);
+
+				// Check for waiters only after the decrement: a WaitIdle that registers before this load is
+				// woken, one that registers after it reads the new count.
+				if (liveJobs_.fetch_sub(1, std::memory_order_seq_cst) == 1
+					&& externalWaiters_.load(std::memory_order_seq_cst) != 0)
+				{
+					liveJobs_.notify_all();
+				}
+
+				index = parent;
+			}
+		}
+
+		void WakeWorkers(bool all) noexcept
+		{
+			wakeEpoch_.fetch_add(1, std::memory_order_seq_cst);
+			if (all)
+			{
+				wakeEpoch_.notify_all();
+			}
+			else if (sleepingWorkers_.load(std::memory_order_seq_cst) != 0)
+			{
+				wakeEpoch_.notify_one();
+			}
+		}
+
+		void WorkerMain(std::stop_token st, std::uint32_t index)
+		{
+			tlsWorker_ = detail::WorkerContext{ this, index };
+			profiling::SetThreadName("Job worker " + std::to_string(index));
+
+			constexpr int kSpinCount = 32;
+			while (!st.stop_requested())
+			{
+				bool ranAny = false;
+				for (int spin = 0; spin < kSpinCount; ++spin)
+				{
+					if (RunOne(index))
+					{
+						ranAny = true;
+						break;
+					}
+					std::this_thread::yield();
+				}
+				if (ranAny)
+				{
+					continue;
+				}
+
+				const std::uint32_t epoch = wakeEpoch_.load(std::memory_order_seq_cst);
+				if (RunOne(index))
+				{
+					continue;
+				}
+				if (stopping_.load(std::memory_order_seq_cst) || st.stop_requested())
+				{
+					break;
+				}
+
+				sleepingWorkers_.fetch_add(1, std::memory_order_seq_cst);
+				wakeEpoch_.wait(epoch, std::memory_order_seq_cst);
+				sleepingWorkers_.fetch_sub(1, std::memory_order_seq_cst);
+			}
+
+			tlsWorker_ = detail::WorkerContext{};
+		}
+
+		static inline thread_local detail::WorkerContext tlsWorker_{};
+
+		JobPool pool_{};
+		std::vector<std::unique_ptr<Worker>> workers_;
+		std::vector<std::jthread> threads_;
+
+		struct alignas(64) InjectionList
+		{
+			std::atomic<std::uint32_t> head{ kInvalidJobIndex };
+		};
+
+		InjectionList injected_[kJobPriorityCount]{};
+		alignas(64) std::atomic<std::uint64_t> liveJobs_{ 0 };
+		alignas(64) std::atomic<std::uint32_t> wakeEpoch_{ 0 };
+		std::atomic<std::uint32_t> sleepingWorkers_{ 0 };
+		std::atomic<std::uint32_t> externalWaiters_{ 0 };
+		std::atomic<bool> stopping_{ false };
+	};
+
+	// Number of chunks ParallelFor splits [0, count) into. Chunk c covers [c * grain, min((c + 1) * grain, count)).
+	[[nodiscard]] constexpr std::size_t ParallelForChunkCount(std::size_t count, std::size_t grain) noexcept
+	{
+		grain = std::max<std::size_t>(grain, 1);
+		return (count + grain - 1) / grain;
+	}
+
+	// Calls body(begin, end) for every chunk of [0, count) and returns when all of them are done.
+	// Chunk 1..N run as Critical jobs while the calling thread runs chunk 0 and then helps/waits,
+	// so this is meant for short render-side fan-outs. Chunk boundaries depend only on count and
+	// grain (see ParallelForChunkCount), which lets callers keep results in per-chunk slots and
+	// merge them in a fixed order. With no scheduler, or a single chunk, everything runs inline.
+	// The body must not throw: exceptions inside jobs are swallowed by the scheduler.
+	template <class Body>
+	void ParallelFor(Scheduler* scheduler, std::size_t count, std::size_t grain, Body&& body)
+	{
+		grain = std::max<std::size_t>(grain, 1);
+		const std::size_t chunkCount = ParallelForChunkCount(count, grain);
+		if (chunkCount == 0)
+		{
+			return;
+		}
+		if (scheduler == nullptr || chunkCount == 1)
+		{
+			for (std::size_t begin = 0; begin < count; begin += grain)
+			{
+				body(begin, std::min(begin + grain, count));
+			}
+			return;
+		}
+
+		const JobOptions options{ JobPriority::Critical };
+		const JobHandle root = scheduler->CreateJob([] {}, {}, options);
+		auto* bodyPtr = &body;
+		for (std::size_t chunk = 1; chunk < chunkCount; ++chunk)
+		{
+			const std::size_t begin = chunk * grain;
+			const std::size_t end = std::min(begin + grain, count);
+			scheduler->Schedule([bodyPtr, begin, end] { (*bodyPtr)(begin, end); }, root, options);
+		}
+		scheduler->Run(root);
+
+		body(std::size_t{ 0 }, std::min(grain, count));
+		scheduler->Wait(root);
+	}
+}
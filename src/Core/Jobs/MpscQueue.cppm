@@ -0,0 +1,93 @@
+module;
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+export module core:mpsc_queue;
+
+// Unbounded intrusive MPSC queue (Vyukov). Producers publish with a single exchange on the
+// head and never wait; the consumer walks the tail without atomic RMWs. A producer that has
+// swapped the head but not linked its node yet makes the queue look empty for that instant,
+// which the consumer just treats as "nothing ready" and picks up on the next drain.
+//
+// Exactly one thread may call TryPop/Clear at a time; Push is safe from any thread.
+
+export namespace jobs
+{
+	template <typename T>
+	class MpscQueue
+	{
+	public:
+		MpscQueue()
+		{
+			Node* stub = new Node{};
+			head_.store(stub, std::memory_order_relaxed);
+			tail_ = stub;
+		}
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		~MpscQueue()
+		{
+			Clear();
+			delete tail_;
+		}
+
+		void Push(T value)
+		{
+			Node* node = new Node{};
+			node->value.emplace(std::move(value));
+			size_.fetch_add(1, std::memory_order_relaxed);
+
+			Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+			prev->next.store(node, std::memory_order_release);
+		}
+
+		// Consumer only.
+		[[nodiscard]] std::optional<T> TryPop()
+		{
+			Node* tail = tail_;
+			Node* next = tail->next.load(std::memory_order_acquire);
+			if (next == nullptr)
+			{
+				return std::nullopt;
+			}
+
+			std::optional<T> out{ std::move(*next->value) };
+			next->value.reset();
+			tail_ = next; // `next` becomes the new stub.
+			delete tail;
+
+			size_.fetch_sub(1, std::memory_order_relaxed);
+			return out;
+		}
+
+		// Consumer only. Drops everything that is already linked.
+		void Clear()
+		{
+			while (TryPop().has_value())
+			{
+			}
+		}
+
+		// Approximate: may briefly count items that are not linked yet.
+		[[nodiscard]] std::size_t SizeApprox() const noexcept
+		{
+			return size_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		struct Node
+		{
+			std::atomic<Node*> next{ nullptr };
+			std::optional<T> value{};
+		};
+
+		alignas(64) std::atomic<Node*> head_{ nullptr };
+		alignas(64) Node* tail_{ nullptr };
+		std::atomic<std::size_t> size_{ 0 };
+	};
+}
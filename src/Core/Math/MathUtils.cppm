@@ -1,14 +1,27 @@
 module;
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <numbers>
+#include <span>
 #include <string_view>
 
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <xmmintrin.h>
+#define CORE_MATH_SIMD_SSE 1
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CORE_MATH_SIMD_AVX 1
+#endif
+
 export module core:math_utils;
 
 using namespace std::numbers;
@@ -235,23 +248,84 @@ export namespace mathUtils
 		return &m.columns[0].x;
 	}
 
+	// Reference implementations of the SIMD-backed operations below. The SIMD paths do the same operations in
+	// the same order, so they match these exactly unless the compiler contracts the scalar code into FMAs.
+	namespace scalar
+	{
+		inline Vec4 Mul(const Mat4& m, const Vec4& v) noexcept
+		{
+			return m[0] * v.x + m[1] * v.y + m[2] * v.z + m[3] * v.w;
+		}
+
+		inline Mat4 Mul(const Mat4& a, const Mat4& b) noexcept
+		{
+			Mat4 multipliedMat(0.0f);
+			// Each column of result is a * (column of b)
+			for (int col = 0; col < 4; ++col)
+			{
+				multipliedMat[col] = Mul(a, b[col]);
+			}
+			return multipliedMat;
+		}
+	}
+
 	// Matrix * vector (column-vector convention): v' = M * v
 	inline Vec4 Mul(const Mat4& m, const Vec4& v) noexcept
 	{
-		return m[0] * v.x + m[1] * v.y + m[2] * v.z + m[3] * v.w;
+#if defined(CORE_MATH_SIMD_SSE)
+		__m128 r = _mm_mul_ps(_mm_load_ps(&m[0].x), _mm_set1_ps(v.x));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&m[1].x), _mm_set1_ps(v.y)));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&m[2].x), _mm_set1_ps(v.z)));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&m[3].x), _mm_set1_ps(v.w)));
+		Vec4 out;
+		_mm_store_ps(&out.x, r);
+		return out;
+#else
+		return scalar::Mul(m, v);
+#endif
 	}
 
 	inline Vec4 operator*(const Mat4& m, const Vec4& v) noexcept { return Mul(m, v); }
 
 	inline Mat4 Mul(const Mat4& a, const Mat4& b) noexcept
 	{
+#if defined(CORE_MATH_SIMD_AVX)
+		// Two result columns per step: a's columns in both 128-bit lanes, each lane broadcasts its own b column.
+		const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a[0].x));
+		const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a[1].x));
+		const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a[2].x));
+		const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a[3].x));
+		Mat4 multipliedMat(0.0f);
+		for (int col = 0; col < 4; col += 2)
+		{
+			const __m256 bc = _mm256_loadu_ps(&b[col].x);
+			__m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(bc, 0x00));
+			r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_permute_ps(bc, 0x55)));
+			r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_permute_ps(bc, 0xAA)));
+			r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_permute_ps(bc, 0xFF)));
+			_mm256_storeu_ps(&multipliedMat[col].x, r);
+		}
+		return multipliedMat;
+#elif defined(CORE_MATH_SIMD_SSE)
+		// Same sums in the same order as the scalar path, four rows at a time (columns are 16-byte aligned).
+		const __m128 a0 = _mm_load_ps(&a[0].x);
+		const __m128 a1 = _mm_load_ps(&a[1].x);
+		const __m128 a2 = _mm_load_ps(&a[2].x);
+		const __m128 a3 = _mm_load_ps(&a[3].x);
 		Mat4 multipliedMat(0.0f);
-		// Each column of result is a * (column of b)
 		for (int col = 0; col < 4; ++col)
 		{
-			multipliedMat[col] = Mul(a, b[col]);
+			const Vec4& bc = b[col];
+			__m128 r = _mm_mul_ps(a0, _mm_set1_ps(bc.x));
+			r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(bc.y)));
+			r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(bc.z)));
+			r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(bc.w)));
+			_mm_store_ps(&multipliedMat[col].x, r);
 		}
 		return multipliedMat;
+#else
+		return scalar::Mul(a, b);
+#endif
 	}
 
 	// ------------------------------------------------------------
@@ -333,50 +407,351 @@ export namespace mathUtils
 		return true;
 	}
 
+	// p-vertex test: false only when the box is completely outside one of the planes.
+	inline bool IntersectsAabb(const Frustum& frustrum, const Vec3& bmin, const Vec3& bmax) noexcept
+	{
+		for (const Plane& plane : frustrum.planes)
+		{
+			const Vec3 p{
+				plane.norm.x >= 0.0f ? bmax.x : bmin.x,
+				plane.norm.y >= 0.0f ? bmax.y : bmin.y,
+				plane.norm.z >= 0.0f ? bmax.z : bmin.z };
+			if (Distance(plane, p) < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// ------------------------------------------------------------
+	// Batched frustum culling (structure-of-arrays in, bitmask out)
+	// ------------------------------------------------------------
+	// Element i of the input streams maps to bit (i % 32) of word (i / 32) of the output mask, which is set when
+	// the element is visible; every word is written, the bits past the element count are cleared. The per-plane
+	// math is the one of IntersectsSphere / IntersectsAabb in the same order, so every path returns the scalar
+	// result. 8 elements per step with AVX, 4 with SSE, a scalar loop for the tail and other targets.
+
+	inline constexpr std::size_t CullMaskWordCount(std::size_t count) noexcept
+	{
+		return (count + 31) / 32;
+	}
+
+	inline bool TestCullMaskBit(std::span<const std::uint32_t> mask, std::size_t index) noexcept
+	{
+		return ((mask[index >> 5] >> (index & 31)) & 1u) != 0u;
+	}
+
+	// Writes the indices of the set bits (ascending) and returns how many there are; outIndices must hold count entries.
+	inline std::size_t CompactCullMask(std::span<const std::uint32_t> mask, std::size_t count, std::span<std::uint32_t> outIndices) noexcept
+	{
+		std::size_t written = 0;
+		for (std::size_t word = 0; word < CullMaskWordCount(count); ++word)
+		{
+			std::uint32_t bits = mask[word];
+			while (bits != 0u)
+			{
+				const std::uint32_t bit = static_cast<std::uint32_t>(std::countr_zero(bits));
+				outIndices[written++] = static_cast<std::uint32_t>(word * 32 + bit);
+				bits &= bits - 1u;
+			}
+		}
+		return written;
+	}
+
+	inline void CullSpheres(
+		const Frustum& frustrum,
+		std::span<const float> centerX,
+		std::span<const float> centerY,
+		std::span<const float> centerZ,
+		std::span<const float> radius,
+		std::span<std::uint32_t> outVisibleMask) noexcept
+	{
+		const std::size_t count = radius.size();
+		std::fill_n(outVisibleMask.begin(), CullMaskWordCount(count), 0u);
+
+		std::size_t i = 0;
+#if defined(CORE_MATH_SIMD_AVX)
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 cx = _mm256_loadu_ps(centerX.data() + i);
+			const __m256 cy = _mm256_loadu_ps(centerY.data() + i);
+			const __m256 cz = _mm256_loadu_ps(centerZ.data() + i);
+			const __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius.data() + i));
+			__m256 outside = _mm256_setzero_ps();
+			for (const Plane& plane : frustrum.planes)
+			{
+				__m256 d = _mm256_mul_ps(_mm256_set1_ps(plane.norm.x), cx);
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.norm.y), cy));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.norm.z), cz));
+				d = _mm256_add_ps(d, _mm256_set1_ps(plane.dist));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, negR, _CMP_LT_OQ));
+			}
+			const std::uint32_t visible = ~static_cast<std::uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+			outVisibleMask[i >> 5] |= visible << (i & 31);
+		}
+#elif defined(CORE_MATH_SIMD_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 cx = _mm_loadu_ps(centerX.data() + i);
+			const __m128 cy = _mm_loadu_ps(centerY.data() + i);
+			const __m128 cz = _mm_loadu_ps(centerZ.data() + i);
+			const __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius.data() + i));
+			__m128 outside = _mm_setzero_ps();
+			for (const Plane& plane : frustrum.planes)
+			{
+				__m128 d = _mm_mul_ps(_mm_set1_ps(plane.norm.x), cx);
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.norm.y), cy));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.norm.z), cz));
+				d = _mm_add_ps(d, _mm_set1_ps(plane.dist));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negR));
+			}
+			const std::uint32_t visible = ~static_cast<std::uint32_t>(_mm_movemask_ps(outside)) & 0xFu;
+			outVisibleMask[i >> 5] |= visible << (i & 31);
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			if (IntersectsSphere(frustrum, Vec3(centerX[i], centerY[i], centerZ[i]), radius[i]))
+			{
+				outVisibleMask[i >> 5] |= 1u << (i & 31);
+			}
+		}
+	}
+
+	inline void CullAabbs(
+		const Frustum& frustrum,
+		std::span<const float> minX,
+		std::span<const float> minY,
+		std::span<const float> minZ,
+		std::span<const float> maxX,
+		std::span<const float> maxY,
+		std::span<const float> maxZ,
+		std::span<std::uint32_t> outVisibleMask) noexcept
+	{
+		const std::size_t count = minX.size();
+		std::fill_n(outVisibleMask.begin(), CullMaskWordCount(count), 0u);
+
+		// The p-vertex corner only depends on the plane's normal signs, so each plane reads whole streams.
+		std::array<const float*, 6 * 3> pv{};
+		for (std::size_t p = 0; p < 6; ++p)
+		{
+			const Plane& plane = frustrum.planes[p];
+			pv[p * 3 + 0] = plane.norm.x >= 0.0f ? maxX.data() : minX.data();
+			pv[p * 3 + 1] = plane.norm.y >= 0.0f ? maxY.data() : minY.data();
+			pv[p * 3 + 2] = plane.norm.z >= 0.0f ? maxZ.data() : minZ.data();
+		}
+
+		std::size_t i = 0;
+#if defined(CORE_MATH_SIMD_AVX)
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 outside = _mm256_setzero_ps();
+			for (std::size_t p = 0; p < 6; ++p)
+			{
+				const Plane& plane = frustrum.planes[p];
+				__m256 d = _mm256_mul_ps(_mm256_set1_ps(plane.norm.x), _mm256_loadu_ps(pv[p * 3 + 0] + i));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.norm.y), _mm256_loadu_ps(pv[p * 3 + 1] + i)));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.norm.z), _mm256_loadu_ps(pv[p * 3 + 2] + i)));
+				d = _mm256_add_ps(d, _mm256_set1_ps(plane.dist));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ));
+			}
+			const std::uint32_t visible = ~static_cast<std::uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+			outVisibleMask[i >> 5] |= visible << (i & 31);
+		}
+#elif defined(CORE_MATH_SIMD_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 outside = _mm_setzero_ps();
+			for (std::size_t p = 0; p < 6; ++p)
+			{
+				const Plane& plane = frustrum.planes[p];
+				__m128 d = _mm_mul_ps(_mm_set1_ps(plane.norm.x), _mm_loadu_ps(pv[p * 3 + 0] + i));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.norm.y), _mm_loadu_ps(pv[p * 3 + 1] + i)));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.norm.z), _mm_loadu_ps(pv[p * 3 + 2] + i)));
+				d = _mm_add_ps(d, _mm_set1_ps(plane.dist));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(d, _mm_setzero_ps()));
+			}
+			const std::uint32_t visible = ~static_cast<std::uint32_t>(_mm_movemask_ps(outside)) & 0xFu;
+			outVisibleMask[i >> 5] |= visible << (i & 31);
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			if (IntersectsAabb(frustrum, Vec3(minX[i], minY[i], minZ[i]), Vec3(maxX[i], maxY[i], maxZ[i])))
+			{
+				outVisibleMask[i >> 5] |= 1u << (i & 31);
+			}
+		}
+	}
+
 	inline Mat4 operator*(const Mat4& a, const Mat4& b) noexcept { return Mul(a, b); }
 
-	Mat4 Inverse(const Mat4& m) noexcept
+	namespace scalar
 	{
-		const Vec3 a = m[0].xyz();
-		const Vec3 b = m[1].xyz();
-		const Vec3 c = m[2].xyz();
-		const Vec3 d = m[3].xyz();
+		inline Mat4 Inverse(const Mat4& m) noexcept
+		{
+			const Vec3 a = m[0].xyz();
+			const Vec3 b = m[1].xyz();
+			const Vec3 c = m[2].xyz();
+			const Vec3 d = m[3].xyz();
+
+			const float x = m(3, 0);
+			const float y = m(3, 1);
+			const float z = m(3, 2);
+			const float w = m(3, 3);
+
+			Vec3 s = Cross(a, b);
+			Vec3 t = Cross(c, d);
+			Vec3 u = a * y - b * x;
+			Vec3 v = c * w - d * z;
+
+			const float det = Dot(s, v) + Dot(t, u);
+
+			if (std::fabs(det) < 1e-8f)
+			{
+				return Mat4(1.0f);
+			}
+
+			float invDet = 1.0f / det;
+			s *= invDet;
+			t *= invDet;
+			u *= invDet;
+			v *= invDet;
 
-		const float x = m(3, 0);
-		const float y = m(3, 1);
-		const float z = m(3, 2);
-		const float w = m(3, 3);
+			Vec3 r0 = Cross(b, v) + t * y;
+			Vec3 r1 = Cross(v, a) - t * x;
+			Vec3 r2 = Cross(d, u) + s * w;
+			Vec3 r3 = Cross(u, c) - s * z;
 
-		Vec3 s = Cross(a, b);
-		Vec3 t = Cross(c, d);
-		Vec3 u = a * y - b * x;
-		Vec3 v = c * w - d * z;
+			Mat4 inverse(0.0f);
+			inverse[0] = Vec4(r0, -Dot(b, t));
+			inverse[1] = Vec4(r1, Dot(a, t));
+			inverse[2] = Vec4(r2, -Dot(d, s));
+			inverse[3] = Vec4(r3, Dot(c, s));
 
-		const float det = Dot(s, v) + Dot(t, u);
+			return Transpose(inverse);
+		}
+
+		inline Mat4 QuatToMat4(const Vec4& q) noexcept
+		{
+			const float xx = q.x * q.x;
+			const float yy = q.y * q.y;
+			const float zz = q.z * q.z;
+			const float xy = q.x * q.y;
+			const float xz = q.x * q.z;
+			const float yz = q.y * q.z;
+			const float wx = q.w * q.x;
+			const float wy = q.w * q.y;
+			const float wz = q.w * q.z;
+
+			Mat4 m(1.0f);
+			m[0] = Vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f);
+			m[1] = Vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f);
+			m[2] = Vec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f);
+			return m;
+		}
+	}
+
+#if defined(CORE_MATH_SIMD_SSE)
+	namespace simd_detail
+	{
+		// (a.y, a.z, a.x) style lane rotations for the 3-component cross products (w lane ignored).
+		inline __m128 Yzx(__m128 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); }
+		inline __m128 Zxy(__m128 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2)); }
 
+		inline __m128 Cross3(__m128 a, __m128 b) noexcept
+		{
+			return _mm_sub_ps(_mm_mul_ps(Yzx(a), Zxy(b)), _mm_mul_ps(Zxy(a), Yzx(b)));
+		}
+
+		// x*x' + y*y' + z*z' summed left to right, as Dot(Vec3, Vec3).
+		inline float Dot3(__m128 a, __m128 b) noexcept
+		{
+			const __m128 p = _mm_mul_ps(a, b);
+			const __m128 xy = _mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)));
+			return _mm_cvtss_f32(_mm_add_ss(xy, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2))));
+		}
+	}
+#endif
+
+	// Inverse of an affine or projective matrix (identity when singular).
+	Mat4 Inverse(const Mat4& m) noexcept
+	{
+#if defined(CORE_MATH_SIMD_SSE)
+		using namespace simd_detail;
+		// The scalar algorithm on whole columns: a..d are the columns, their w lanes are row 3 (x, y, z, w).
+		const __m128 a = _mm_load_ps(&m[0].x);
+		const __m128 b = _mm_load_ps(&m[1].x);
+		const __m128 c = _mm_load_ps(&m[2].x);
+		const __m128 d = _mm_load_ps(&m[3].x);
+		const __m128 x = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+		const __m128 y = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3));
+		const __m128 z = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+		const __m128 w = _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3));
+
+		__m128 s = Cross3(a, b);
+		__m128 t = Cross3(c, d);
+		__m128 u = _mm_sub_ps(_mm_mul_ps(a, y), _mm_mul_ps(b, x));
+		__m128 v = _mm_sub_ps(_mm_mul_ps(c, w), _mm_mul_ps(d, z));
+
+		const float det = Dot3(s, v) + Dot3(t, u);
 		if (std::fabs(det) < 1e-8f)
 		{
 			return Mat4(1.0f);
 		}
 
-		float invDet = 1.0f / det;
-		s *= invDet;
-		t *= invDet;
-		u *= invDet;
-		v *= invDet;
+		const __m128 invDet = _mm_set1_ps(1.0f / det);
+		s = _mm_mul_ps(s, invDet);
+		t = _mm_mul_ps(t, invDet);
+		u = _mm_mul_ps(u, invDet);
+		v = _mm_mul_ps(v, invDet);
 
-		Vec3 r0 = Cross(b, v) + t * y;
-		Vec3 r1 = Cross(v, a) - t * x;
-		Vec3 r2 = Cross(d, u) + s * w;
-		Vec3 r3 = Cross(u, c) - s * z;
+		__m128 r0 = _mm_add_ps(Cross3(b, v), _mm_mul_ps(t, y));
+		__m128 r1 = _mm_sub_ps(Cross3(v, a), _mm_mul_ps(t, x));
+		__m128 r2 = _mm_add_ps(Cross3(d, u), _mm_mul_ps(s, w));
+		__m128 r3 = _mm_sub_ps(Cross3(u, c), _mm_mul_ps(s, z));
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
 
+		// The r* rows are the first three columns; the last column is the scalar path's dot products.
 		Mat4 inverse(0.0f);
-		inverse[0] = Vec4(r0, -Dot(b, t));
-		inverse[1] = Vec4(r1, Dot(a, t));
-		inverse[2] = Vec4(r2, -Dot(d, s));
-		inverse[3] = Vec4(r3, Dot(c, s));
+		_mm_store_ps(&inverse[0].x, r0);
+		_mm_store_ps(&inverse[1].x, r1);
+		_mm_store_ps(&inverse[2].x, r2);
+		inverse[3] = Vec4(-Dot3(b, t), Dot3(a, t), -Dot3(d, s), Dot3(c, s));
+		return inverse;
+#else
+		return scalar::Inverse(m);
+#endif
+	}
 
-		return Transpose(inverse);
+	// Rotation matrix of a unit quaternion (x, y, z, w).
+	inline Mat4 QuatToMat4(const Vec4& q) noexcept
+	{
+#if defined(CORE_MATH_SIMD_SSE)
+		// Column k = base + scale * (P + sign * Q), the scalar path's products and sums three lanes at a time.
+		const __m128 qv = _mm_load_ps(&q.x);
+		const __m128 p0 = _mm_mul_ps(_mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 0, 0, 1)), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 2, 1, 1)));
+		const __m128 q0 = _mm_mul_ps(_mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 3, 3, 2)), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 1, 2, 2)));
+		const __m128 p1 = _mm_mul_ps(_mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 1, 0, 0)), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 2, 0, 1)));
+		const __m128 q1 = _mm_mul_ps(_mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 3, 2, 3)), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 0, 2, 2)));
+		const __m128 p2 = _mm_mul_ps(_mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 0, 1, 0)), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 0, 2, 2)));
+		const __m128 q2 = _mm_mul_ps(_mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 1, 3, 3)), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 1, 0, 1)));
+
+		auto Column = [](__m128 p, __m128 qq, __m128 sign, __m128 scale, __m128 base) noexcept
+			{
+				const __m128 sum = _mm_add_ps(p, _mm_mul_ps(qq, sign));
+				return _mm_add_ps(base, _mm_mul_ps(scale, sum));
+			};
+		// Lane 3 of sign / scale / base is zero, so the w components come out 0 as in the scalar path.
+		Mat4 m(1.0f);
+		_mm_store_ps(&m[0].x, Column(p0, q0, _mm_setr_ps(1.0f, 1.0f, -1.0f, 0.0f), _mm_setr_ps(-2.0f, 2.0f, 2.0f, 0.0f), _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f)));
+		_mm_store_ps(&m[1].x, Column(p1, q1, _mm_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f), _mm_setr_ps(2.0f, -2.0f, 2.0f, 0.0f), _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f)));
+		_mm_store_ps(&m[2].x, Column(p2, q2, _mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f), _mm_setr_ps(2.0f, 2.0f, -2.0f, 0.0f), _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f)));
+		return m;
+#else
+		return scalar::QuatToMat4(q);
+#endif
 	}
 
 	// --- GLM-compatible transforms (column-major, post-multiply by transform) ---
@@ -597,6 +972,63 @@ export namespace mathUtils
 		return v - n * (2.0f * Dot(n, v));
 	}
 
+	// Axis-aligned NDC rectangle (D3D: x and y in [-1..1], y up).
+	struct NdcRect
+	{
+		float x0{ -1.0f };
+		float y0{ -1.0f };
+		float x1{ 1.0f };
+		float y1{ 1.0f };
+
+		[[nodiscard]] bool Empty() const noexcept { return x1 <= x0 || y1 <= y0; }
+	};
+
+	// Conservative on-screen bounds of a world-space sphere: the projected corners of its bounding cube,
+	// clamped to the screen (empty when it is off-screen). The whole screen when a corner is behind the eye.
+	NdcRect ProjectSphereNdcRect(const Mat4& viewProj, const Vec3& center, float radius) noexcept
+	{
+		NdcRect rect{ 1.0f, 1.0f, -1.0f, -1.0f };
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			const Vec3 p{
+				center.x + ((corner & 1) ? radius : -radius),
+				center.y + ((corner & 2) ? radius : -radius),
+				center.z + ((corner & 4) ? radius : -radius) };
+			const Vec4 clip = viewProj * Vec4(p, 1.0f);
+			if (clip.w <= 1e-5f)
+			{
+				return NdcRect{};
+			}
+			const float x = clip.x / clip.w;
+			const float y = clip.y / clip.w;
+			rect.x0 = std::min(rect.x0, x);
+			rect.y0 = std::min(rect.y0, y);
+			rect.x1 = std::max(rect.x1, x);
+			rect.y1 = std::max(rect.y1, y);
+		}
+		rect.x0 = std::max(rect.x0, -1.0f);
+		rect.y0 = std::max(rect.y0, -1.0f);
+		rect.x1 = std::min(rect.x1, 1.0f);
+		rect.y1 = std::min(rect.y1, 1.0f);
+		return rect;
+	}
+
+	// Frustum of viewProj with its side planes pulled in to an NDC sub-rectangle (portal / mirror frustum).
+	Frustum ExtractFrustumRH_ZO(const Mat4& viewProj, const NdcRect& rect) noexcept
+	{
+		const Vec4 r0 = Row(viewProj, 0);
+		const Vec4 r1 = Row(viewProj, 1);
+		const Vec4 r3 = Row(viewProj, 3);
+
+		// x >= x0 * w, x <= x1 * w, y >= y0 * w, y <= y1 * w
+		Frustum frustum = ExtractFrustumRH_ZO(viewProj);
+		frustum.planes[static_cast<std::uint32_t>(FrustumPlane::Left)] = NormalizePlane(r0 - r3 * rect.x0);
+		frustum.planes[static_cast<std::uint32_t>(FrustumPlane::Right)] = NormalizePlane(r3 * rect.x1 - r0);
+		frustum.planes[static_cast<std::uint32_t>(FrustumPlane::Bottom)] = NormalizePlane(r1 - r3 * rect.y0);
+		frustum.planes[static_cast<std::uint32_t>(FrustumPlane::Top)] = NormalizePlane(r3 * rect.y1 - r1);
+		return frustum;
+	}
+
 	bool NearlyEqualVec3_(const mathUtils::Vec3& a, const mathUtils::Vec3& b, const float eps = 1e-4f) noexcept
 	{
 		return std::fabs(a.x - b.x) <= eps &&
@@ -0,0 +1,129 @@
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+export module core:frame_arena;
+
+// Linear (bump) allocator for scratch that lives for one frame. Allocation advances an offset
+// inside the current block, deallocation does nothing and Reset() rewinds everything at once.
+//
+// Memory is never returned to the heap between frames. When a frame overflows the first block,
+// more blocks are chained for the rest of that frame and the next Reset() replaces them with a
+// single block of the peak size, so a steady workload allocates from one block with no heap calls.
+//
+// Use it through std::pmr containers (std::pmr::vector<T> v{ &arena }). Anything allocated from
+// the arena must be dead before Reset(). Not thread safe.
+
+export namespace memory
+{
+	class FrameArena final : public std::pmr::memory_resource
+	{
+	public:
+		explicit FrameArena(std::size_t initialBytes = 1u << 20)
+		{
+			AddBlock_(std::max<std::size_t>(initialBytes, kMinBlockBytes));
+		}
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		void Reset()
+		{
+			peakBytes_ = std::max(peakBytes_, usedBytes_);
+			if (blocks_.size() > 1)
+			{
+				const std::size_t capacity = Capacity();
+				blocks_.clear();
+				AddBlock_(capacity);
+			}
+			current_ = 0;
+			offset_ = 0;
+			usedBytes_ = 0;
+		}
+
+		std::pmr::polymorphic_allocator<> Allocator() noexcept { return std::pmr::polymorphic_allocator<>(this); }
+
+		// Bytes handed out since the last Reset (including alignment padding).
+		std::size_t UsedBytes() const noexcept { return usedBytes_; }
+		// Largest UsedBytes seen at a Reset.
+		std::size_t PeakBytes() const noexcept { return peakBytes_; }
+
+		std::size_t Capacity() const noexcept
+		{
+			std::size_t bytes = 0;
+			for (const Block_& block : blocks_)
+			{
+				bytes += block.size;
+			}
+			return bytes;
+		}
+
+	private:
+		static constexpr std::size_t kMinBlockBytes = 4096;
+		static constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+		struct BlockDeleter_
+		{
+			void operator()(std::byte* p) const noexcept { ::operator delete(p, std::align_val_t{ kBlockAlignment }); }
+		};
+
+		struct Block_
+		{
+			std::unique_ptr<std::byte, BlockDeleter_> data;
+			std::size_t size{ 0 };
+		};
+
+		void AddBlock_(std::size_t bytes)
+		{
+			Block_ block{};
+			block.data.reset(static_cast<std::byte*>(::operator new(bytes, std::align_val_t{ kBlockAlignment })));
+			block.size = bytes;
+			blocks_.push_back(std::move(block));
+		}
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			bytes = std::max<std::size_t>(bytes, 1);
+			for (;;)
+			{
+				Block_& block = blocks_[current_];
+				const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data.get());
+				const std::uintptr_t aligned = (base + offset_ + (alignment - 1)) & ~static_cast<std::uintptr_t>(alignment - 1);
+				const std::size_t begin = static_cast<std::size_t>(aligned - base);
+				if (begin <= block.size && bytes <= block.size - begin)
+				{
+					usedBytes_ += begin + bytes - offset_;
+					offset_ = begin + bytes;
+					return block.data.get() + begin;
+				}
+
+				// Grow geometrically; the tail of this block is skipped for the rest of the frame.
+				usedBytes_ += block.size - offset_;
+				AddBlock_(std::max(block.size * 2, bytes + alignment));
+				++current_;
+				offset_ = 0;
+			}
+		}
+
+		void do_deallocate(void*, std::size_t, std::size_t) override
+		{
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+		std::vector<Block_> blocks_{};
+		std::size_t current_{ 0 };
+		std::size_t offset_{ 0 };
+		std::size_t usedBytes_{ 0 };
+		std::size_t peakBytes_{ 0 };
+	};
+}
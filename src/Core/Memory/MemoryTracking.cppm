@@ -0,0 +1,318 @@
+module;
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+
+export module core:memory_tracking;
+
+// Per-subsystem memory accounting. Every byte is charged to a MemoryTag, separately for CPU and GPU:
+//  - CPU: std::pmr containers allocate through TrackingResource(tag); owners of plain std containers
+//    report their footprint with a TrackedBytes member instead.
+//  - GPU: the RHI charges committed resources to CurrentGpuMemoryTag(), which callers set around
+//    uploads with ScopedGpuMemoryTag (untagged resources belong to the renderer).
+//
+// Counters are process-wide atomics, so any thread may allocate. Besides the all-time peak each tag
+// keeps a level peak that ResetLevelMemoryPeaks() rewinds whenever a level is (re)loaded.
+
+export namespace memory
+{
+	enum class MemoryTag : std::uint8_t
+	{
+		Textures,
+		Meshes,
+		Animation,
+		Level,
+		Renderer,
+		Count
+	};
+
+	inline constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+	constexpr std::string_view MemoryTagName(MemoryTag tag) noexcept
+	{
+		switch (tag)
+		{
+		case MemoryTag::Textures: return "Textures";
+		case MemoryTag::Meshes: return "Meshes";
+		case MemoryTag::Animation: return "Animation";
+		case MemoryTag::Level: return "Level";
+		case MemoryTag::Renderer: return "Renderer";
+		default: return "?";
+		}
+	}
+
+	struct MemoryTagStats
+	{
+		std::uint64_t cpuBytes{ 0 };
+		std::uint64_t cpuPeakBytes{ 0 };
+		std::uint64_t cpuLevelPeakBytes{ 0 };
+		std::uint64_t cpuAllocations{ 0 }; // live CPU allocations
+
+		std::uint64_t gpuBytes{ 0 };
+		std::uint64_t gpuPeakBytes{ 0 };
+		std::uint64_t gpuLevelPeakBytes{ 0 };
+		std::uint64_t gpuAllocations{ 0 }; // live GPU resources
+	};
+
+	struct MemoryBudget
+	{
+		std::uint64_t cpuBytes{ 0 };
+		std::uint64_t gpuBytes{ 0 };
+	};
+
+	// Soft budgets shown in the debug UI; nothing is refused when they are exceeded.
+	constexpr MemoryBudget DefaultMemoryBudget(MemoryTag tag) noexcept
+	{
+		constexpr std::uint64_t MiB = 1024ull * 1024ull;
+		switch (tag)
+		{
+		case MemoryTag::Textures: return { 64 * MiB, 1024 * MiB };
+		case MemoryTag::Meshes: return { 128 * MiB, 512 * MiB };
+		case MemoryTag::Animation: return { 64 * MiB, 64 * MiB };
+		case MemoryTag::Level: return { 32 * MiB, 16 * MiB };
+		case MemoryTag::Renderer: return { 64 * MiB, 768 * MiB };
+		default: return {};
+		}
+	}
+}
+
+namespace memory
+{
+	struct TagCounters_
+	{
+		std::atomic<std::uint64_t> bytes{ 0 };
+		std::atomic<std::uint64_t> peak{ 0 };
+		std::atomic<std::uint64_t> levelPeak{ 0 };
+		std::atomic<std::uint64_t> allocations{ 0 };
+	};
+
+	struct Counters_
+	{
+		std::array<TagCounters_, kMemoryTagCount> cpu{};
+		std::array<TagCounters_, kMemoryTagCount> gpu{};
+	};
+
+	Counters_& GlobalCounters_() noexcept
+	{
+		static Counters_ counters{};
+		return counters;
+	}
+
+	MemoryTag& ThreadGpuTag_() noexcept
+	{
+		thread_local MemoryTag tag{ MemoryTag::Renderer };
+		return tag;
+	}
+
+	void RaisePeak_(std::atomic<std::uint64_t>& peak, std::uint64_t value) noexcept
+	{
+		std::uint64_t seen = peak.load(std::memory_order_relaxed);
+		while (seen < value && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void Add_(TagCounters_& c, std::uint64_t bytes) noexcept
+	{
+		const std::uint64_t now = c.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		c.allocations.fetch_add(1, std::memory_order_relaxed);
+		RaisePeak_(c.peak, now);
+		RaisePeak_(c.levelPeak, now);
+	}
+
+	void Sub_(TagCounters_& c, std::uint64_t bytes) noexcept
+	{
+		c.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+		c.allocations.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	std::size_t Index_(MemoryTag tag) noexcept
+	{
+		const std::size_t i = static_cast<std::size_t>(tag);
+		return i < kMemoryTagCount ? i : static_cast<std::size_t>(MemoryTag::Renderer);
+	}
+}
+
+export namespace memory
+{
+	void TrackCpuAlloc(MemoryTag tag, std::size_t bytes) noexcept { Add_(GlobalCounters_().cpu[Index_(tag)], bytes); }
+	void TrackCpuFree(MemoryTag tag, std::size_t bytes) noexcept { Sub_(GlobalCounters_().cpu[Index_(tag)], bytes); }
+	void TrackGpuAlloc(MemoryTag tag, std::uint64_t bytes) noexcept { Add_(GlobalCounters_().gpu[Index_(tag)], bytes); }
+	void TrackGpuFree(MemoryTag tag, std::uint64_t bytes) noexcept { Sub_(GlobalCounters_().gpu[Index_(tag)], bytes); }
+
+	MemoryTagStats GetMemoryTagStats(MemoryTag tag) noexcept
+	{
+		const Counters_& counters = GlobalCounters_();
+		const TagCounters_& cpu = counters.cpu[Index_(tag)];
+		const TagCounters_& gpu = counters.gpu[Index_(tag)];
+
+		MemoryTagStats stats{};
+		stats.cpuBytes = cpu.bytes.load(std::memory_order_relaxed);
+		stats.cpuPeakBytes = cpu.peak.load(std::memory_order_relaxed);
+		stats.cpuLevelPeakBytes = cpu.levelPeak.load(std::memory_order_relaxed);
+		stats.cpuAllocations = cpu.allocations.load(std::memory_order_relaxed);
+		stats.gpuBytes = gpu.bytes.load(std::memory_order_relaxed);
+		stats.gpuPeakBytes = gpu.peak.load(std::memory_order_relaxed);
+		stats.gpuLevelPeakBytes = gpu.levelPeak.load(std::memory_order_relaxed);
+		stats.gpuAllocations = gpu.allocations.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	// Starts a new level high-water mark at the current usage of every tag.
+	void ResetLevelMemoryPeaks() noexcept
+	{
+		Counters_& counters = GlobalCounters_();
+		for (std::size_t i = 0; i < kMemoryTagCount; ++i)
+		{
+			counters.cpu[i].levelPeak.store(counters.cpu[i].bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			counters.gpu[i].levelPeak.store(counters.gpu[i].bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	}
+
+	// Forwards to an upstream resource and charges every block to one tag.
+	class TrackingMemoryResource final : public std::pmr::memory_resource
+	{
+	public:
+		explicit TrackingMemoryResource(MemoryTag tag, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+			: tag_(tag)
+			, upstream_(upstream)
+		{
+		}
+
+		MemoryTag Tag() const noexcept { return tag_; }
+		std::pmr::memory_resource* Upstream() const noexcept { return upstream_; }
+
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			void* p = upstream_->allocate(bytes, alignment);
+			TrackCpuAlloc(tag_, bytes);
+			return p;
+		}
+
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+		{
+			upstream_->deallocate(p, bytes, alignment);
+			TrackCpuFree(tag_, bytes);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+		MemoryTag tag_;
+		std::pmr::memory_resource* upstream_;
+	};
+
+	// Process-wide tracking resource of a tag (heap upstream).
+	std::pmr::memory_resource* TrackingResource(MemoryTag tag) noexcept
+	{
+		static std::array<TrackingMemoryResource, kMemoryTagCount> resources{
+			TrackingMemoryResource{ MemoryTag::Textures },
+			TrackingMemoryResource{ MemoryTag::Meshes },
+			TrackingMemoryResource{ MemoryTag::Animation },
+			TrackingMemoryResource{ MemoryTag::Level },
+			TrackingMemoryResource{ MemoryTag::Renderer },
+		};
+		return &resources[Index_(tag)];
+	}
+
+	// Tag the RHI charges GPU resources created on this thread to.
+	MemoryTag CurrentGpuMemoryTag() noexcept { return ThreadGpuTag_(); }
+
+	class ScopedGpuMemoryTag
+	{
+	public:
+		explicit ScopedGpuMemoryTag(MemoryTag tag) noexcept
+			: previous_(ThreadGpuTag_())
+		{
+			ThreadGpuTag_() = tag;
+		}
+
+		~ScopedGpuMemoryTag() { ThreadGpuTag_() = previous_; }
+
+		ScopedGpuMemoryTag(const ScopedGpuMemoryTag&) = delete;
+		ScopedGpuMemoryTag& operator=(const ScopedGpuMemoryTag&) = delete;
+
+	private:
+		MemoryTag previous_;
+	};
+
+	// CPU footprint reported by an owner that keeps its data in ordinary containers.
+	// Set() replaces the charged amount; copies charge their own bytes, moves transfer them.
+	class TrackedBytes
+	{
+	public:
+		explicit TrackedBytes(MemoryTag tag) noexcept
+			: tag_(tag)
+		{
+		}
+
+		TrackedBytes(const TrackedBytes& other) noexcept
+			: tag_(other.tag_)
+		{
+			Set(other.bytes_);
+		}
+
+		TrackedBytes(TrackedBytes&& other) noexcept
+			: tag_(other.tag_)
+			, bytes_(other.bytes_)
+		{
+			other.bytes_ = 0;
+		}
+
+		TrackedBytes& operator=(const TrackedBytes& other) noexcept
+		{
+			if (this != &other)
+			{
+				Set(0);
+				tag_ = other.tag_;
+				Set(other.bytes_);
+			}
+			return *this;
+		}
+
+		TrackedBytes& operator=(TrackedBytes&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Set(0);
+				tag_ = other.tag_;
+				bytes_ = other.bytes_;
+				other.bytes_ = 0;
+			}
+			return *this;
+		}
+
+		~TrackedBytes() { Set(0); }
+
+		void Set(std::size_t bytes) noexcept
+		{
+			if (bytes == bytes_)
+			{
+				return;
+			}
+			if (bytes_ != 0)
+			{
+				TrackCpuFree(tag_, bytes_);
+			}
+			if (bytes != 0)
+			{
+				TrackCpuAlloc(tag_, bytes);
+			}
+			bytes_ = bytes;
+		}
+
+		std::size_t Bytes() const noexcept { return bytes_; }
+		MemoryTag Tag() const noexcept { return tag_; }
+
+	private:
+		MemoryTag tag_;
+		std::size_t bytes_{ 0 };
+	};
+}
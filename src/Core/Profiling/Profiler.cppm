@@ -0,0 +1,428 @@
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+export module core:profiler;
+
+// Hierarchical frame profiler.
+//
+// ScopedZone records one complete event (name, begin, end, nesting depth) when it goes out of scope.
+// Every thread writes into its own single-producer ring, so recording takes no lock; EndFrame drains
+// the rings on the calling thread and appends the events to the frame history. A full ring drops
+// events (FrameCapture::droppedZones) instead of blocking the recording thread.
+//
+// GPU zones come from the RHI timestamp queries. Their results arrive a few frames late, so they are
+// attached to the frame that submits them, not to the frame that recorded them.
+//
+// Zone names are stored as pointers: use string literals, or InternZoneName for names built at runtime.
+
+export namespace profiling
+{
+	struct ZoneEvent
+	{
+		const char* name{ nullptr };
+		std::int64_t beginNs{ 0 };
+		std::int64_t endNs{ 0 };
+		std::uint32_t depth{ 0 };
+	};
+
+	struct ThreadCapture
+	{
+		std::uint32_t threadIndex{ 0 };
+		std::string name;
+		std::vector<ZoneEvent> zones; // in end order: children before their parent
+	};
+
+	struct GpuZone
+	{
+		std::string name;
+		double beginMs{ 0.0 }; // relative to the first zone of its submission
+		double endMs{ 0.0 };
+		std::uint32_t depth{ 0 };
+	};
+
+	struct FrameCapture
+	{
+		std::uint64_t frameIndex{ 0 };
+		std::int64_t beginNs{ 0 };
+		std::int64_t endNs{ 0 };
+		std::vector<ThreadCapture> threads; // threads that recorded zones this frame
+		std::vector<GpuZone> gpuZones;
+		std::uint32_t droppedZones{ 0 };
+
+		double DurationMs() const noexcept
+		{
+			return static_cast<double>(endNs - beginNs) * 1e-6;
+		}
+	};
+
+	class Profiler
+	{
+	public:
+		static constexpr std::size_t kRingCapacity = 1u << 13;
+		static constexpr std::size_t kDefaultHistoryFrames = 240;
+
+		static Profiler& Get() noexcept
+		{
+			static Profiler profiler;
+			return profiler;
+		}
+
+		Profiler(const Profiler&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+
+		// Nanoseconds on the profiler clock (steady, shared by all threads).
+		static std::int64_t NowNs() noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		// Disabled: zones cost one relaxed load and EndFrame keeps the history as it is.
+		void SetEnabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+		bool IsEnabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+		// Label for the calling thread in the timeline and the trace export.
+		void SetThreadName(std::string_view name)
+		{
+			ThreadRing_& ring = LocalRing_();
+			std::lock_guard lock(ringsMutex_);
+			ring.name.assign(name);
+		}
+
+		// Called by ScopedZone on the recording thread.
+		void Record(const ZoneEvent& event) noexcept
+		{
+			ThreadRing_* ring = tlsRing_.ring;
+			if (!ring)
+			{
+				try
+				{
+					ring = &LocalRing_();
+				}
+				catch (...)
+				{
+					return;
+				}
+			}
+
+			const std::uint64_t head = ring->head.load(std::memory_order_relaxed);
+			if (head - ring->tail.load(std::memory_order_acquire) >= kRingCapacity)
+			{
+				ring->dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			ring->events[head & (kRingCapacity - 1)] = event;
+			ring->head.store(head + 1, std::memory_order_release);
+		}
+
+		void BeginFrame() noexcept
+		{
+			frameBeginNs_ = NowNs();
+		}
+
+		// Drains every thread's ring into a new history frame. Call from one thread (the main loop).
+		void EndFrame()
+		{
+			FrameCapture frame{};
+			frame.frameIndex = frameIndex_++;
+			frame.beginNs = frameBeginNs_;
+			frame.endNs = NowNs();
+			frame.gpuZones = std::move(pendingGpuZones_);
+			pendingGpuZones_.clear();
+
+			{
+				std::lock_guard lock(ringsMutex_);
+				for (const std::unique_ptr<ThreadRing_>& ring : rings_)
+				{
+					const std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+					const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+					frame.droppedZones += ring->dropped.exchange(0, std::memory_order_relaxed);
+					if (head == tail)
+					{
+						continue;
+					}
+
+					ThreadCapture& thread = frame.threads.emplace_back();
+					thread.threadIndex = ring->index;
+					thread.name = ring->name;
+					thread.zones.reserve(static_cast<std::size_t>(head - tail));
+					for (std::uint64_t i = tail; i != head; ++i)
+					{
+						thread.zones.push_back(ring->events[i & (kRingCapacity - 1)]);
+					}
+					ring->tail.store(head, std::memory_order_release);
+				}
+			}
+
+			if (!IsEnabled())
+			{
+				return;
+			}
+			history_.push_back(std::move(frame));
+			while (history_.size() > historyCapacity_)
+			{
+				history_.pop_front();
+			}
+		}
+
+		// GPU zones of one completed submission; they go into the next EndFrame.
+		void SubmitGpuZones(std::vector<GpuZone> zones)
+		{
+			pendingGpuZones_ = std::move(zones);
+		}
+
+		const std::deque<FrameCapture>& GetHistory() const noexcept { return history_; }
+
+		void SetHistoryCapacity(std::size_t frames)
+		{
+			historyCapacity_ = std::max<std::size_t>(frames, 1);
+			while (history_.size() > historyCapacity_)
+			{
+				history_.pop_front();
+			}
+		}
+
+		void ClearHistory() noexcept { history_.clear(); }
+
+		// Chrome trace event format (chrome://tracing, Perfetto): one complete ("X") event per zone, CPU
+		// threads under pid 1, GPU zones under pid 2 placed at the start of the frame that received them.
+		bool WriteChromeTrace(const std::filesystem::path& path) const
+		{
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			if (!out)
+			{
+				return false;
+			}
+
+			const std::int64_t originNs = history_.empty() ? 0 : history_.front().beginNs;
+			const auto Micros = [originNs](std::int64_t ns) { return static_cast<double>(ns - originNs) * 1e-3; };
+
+			out << std::fixed << std::setprecision(3);
+			out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+			bool first = true;
+			const auto Separator = [&]()
+				{
+					out << (first ? "\n" : ",\n");
+					first = false;
+				};
+
+			std::unordered_set<std::uint32_t> namedThreads;
+			for (const FrameCapture& frame : history_)
+			{
+				for (const ThreadCapture& thread : frame.threads)
+				{
+					if (namedThreads.insert(thread.threadIndex).second)
+					{
+						Separator();
+						out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.threadIndex << ",\"args\":{\"name\":";
+						WriteJsonString_(out, thread.name.empty() ? "Thread " + std::to_string(thread.threadIndex) : thread.name);
+						out << "}}";
+					}
+				}
+			}
+			Separator();
+			out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << kFrameTrackTid_ << ",\"args\":{\"name\":\"Frames\"}}";
+			Separator();
+			out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+
+			for (const FrameCapture& frame : history_)
+			{
+				Separator();
+				out << "{\"name\":\"Frame " << frame.frameIndex << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" << kFrameTrackTid_
+					<< ",\"ts\":" << Micros(frame.beginNs) << ",\"dur\":" << static_cast<double>(frame.endNs - frame.beginNs) * 1e-3 << "}";
+
+				for (const ThreadCapture& thread : frame.threads)
+				{
+					for (const ZoneEvent& zone : thread.zones)
+					{
+						Separator();
+						out << "{\"name\":";
+						WriteJsonString_(out, zone.name ? zone.name : "?");
+						out << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.threadIndex
+							<< ",\"ts\":" << Micros(zone.beginNs) << ",\"dur\":" << static_cast<double>(zone.endNs - zone.beginNs) * 1e-3 << "}";
+					}
+				}
+
+				for (const GpuZone& zone : frame.gpuZones)
+				{
+					Separator();
+					out << "{\"name\":";
+					WriteJsonString_(out, zone.name);
+					out << ",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":2,\"tid\":0"
+						<< ",\"ts\":" << Micros(frame.beginNs) + zone.beginMs * 1e3 << ",\"dur\":" << (zone.endMs - zone.beginMs) * 1e3 << "}";
+				}
+			}
+			out << "\n]}\n";
+			return static_cast<bool>(out.flush());
+		}
+
+		// Stable copy of `name` for zones whose name is built at runtime (pass names and the like).
+		const char* InternName(std::string_view name)
+		{
+			std::lock_guard lock(namesMutex_);
+			return names_.emplace(name).first->c_str();
+		}
+
+	private:
+		static constexpr std::uint32_t kFrameTrackTid_ = 0xFFFF;
+
+		Profiler() = default;
+
+		struct ThreadRing_
+		{
+			std::uint32_t index{ 0 };
+			std::string name;           // guarded by ringsMutex_
+			bool owned{ true };         // guarded by ringsMutex_; false once the thread has exited
+			std::unique_ptr<ZoneEvent[]> events{ std::make_unique<ZoneEvent[]>(kRingCapacity) };
+			alignas(64) std::atomic<std::uint64_t> head{ 0 }; // written by the owning thread
+			alignas(64) std::atomic<std::uint64_t> tail{ 0 }; // written by EndFrame
+			std::atomic<std::uint32_t> dropped{ 0 };
+		};
+
+		// Hands the ring back when its thread exits; a later thread reuses it (and its index) once drained.
+		struct RingOwner_
+		{
+			ThreadRing_* ring{ nullptr };
+
+			~RingOwner_()
+			{
+				if (ring)
+				{
+					Profiler& profiler = Get();
+					std::lock_guard lock(profiler.ringsMutex_);
+					ring->owned = false;
+				}
+			}
+		};
+
+		ThreadRing_& LocalRing_()
+		{
+			if (tlsRing_.ring)
+			{
+				return *tlsRing_.ring;
+			}
+
+			std::lock_guard lock(ringsMutex_);
+			for (const std::unique_ptr<ThreadRing_>& ring : rings_)
+			{
+				// Only drained rings: the events still in it belong to the exited thread's track.
+				if (!ring->owned && ring->head.load(std::memory_order_relaxed) == ring->tail.load(std::memory_order_relaxed))
+				{
+					ring->owned = true;
+					ring->name.clear();
+					tlsRing_.ring = ring.get();
+					return *ring;
+				}
+			}
+			std::unique_ptr<ThreadRing_>& ring = rings_.emplace_back(std::make_unique<ThreadRing_>());
+			ring->index = static_cast<std::uint32_t>(rings_.size() - 1);
+			tlsRing_.ring = ring.get();
+			return *ring;
+		}
+
+		static void WriteJsonString_(std::ofstream& out, std::string_view text)
+		{
+			out << '"';
+			for (const char c : text)
+			{
+				switch (c)
+				{
+				case '"': out << "\\\""; break;
+				case '\\': out << "\\\\"; break;
+				case '\n': out << "\\n"; break;
+				case '\t': out << "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+					{
+						out << ' ';
+					}
+					else
+					{
+						out << c;
+					}
+					break;
+				}
+			}
+			out << '"';
+		}
+
+		static thread_local RingOwner_ tlsRing_;
+
+		std::atomic<bool> enabled_{ true };
+
+		std::mutex ringsMutex_;
+		std::vector<std::unique_ptr<ThreadRing_>> rings_;
+
+		std::mutex namesMutex_;
+		std::unordered_set<std::string> names_;
+
+		std::int64_t frameBeginNs_{ NowNs() };
+		std::uint64_t frameIndex_{ 0 };
+		std::vector<GpuZone> pendingGpuZones_;
+		std::deque<FrameCapture> history_;
+		std::size_t historyCapacity_{ kDefaultHistoryFrames };
+	};
+
+	inline thread_local Profiler::RingOwner_ Profiler::tlsRing_{};
+
+	inline void SetThreadName(std::string_view name)
+	{
+		Profiler::Get().SetThreadName(name);
+	}
+
+	inline const char* InternZoneName(std::string_view name)
+	{
+		return Profiler::Get().InternName(name);
+	}
+
+	// Times the enclosing scope on the calling thread. `name` must outlive the profiler; nullptr records nothing.
+	class ScopedZone
+	{
+	public:
+		explicit ScopedZone(const char* name) noexcept
+		{
+			if (!name || !Profiler::Get().IsEnabled())
+			{
+				return;
+			}
+			name_ = name;
+			depth_ = tlsDepth_++;
+			beginNs_ = Profiler::NowNs();
+		}
+
+		~ScopedZone()
+		{
+			if (!name_)
+			{
+				return;
+			}
+			const std::int64_t endNs = Profiler::NowNs();
+			--tlsDepth_;
+			Profiler::Get().Record(ZoneEvent{ name_, beginNs_, endNs, depth_ });
+		}
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+
+	private:
+		static inline thread_local std::uint32_t tlsDepth_{ 0 };
+
+		const char* name_{ nullptr };
+		std::int64_t beginNs_{ 0 };
+		std::uint32_t depth_{ 0 };
+	};
+}
@@ -3,6 +3,7 @@ module;
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <initializer_list>
@@ -277,23 +278,17 @@ export namespace rendern
     }
 
     inline void CollectGameplayEventIdsForAnimationEvent(
-        const AnimationControllerAsset* asset,
+        const AnimationControllerRuntime& controller,
         const AnimationNotifyEvent& event,
         std::vector<std::string>& outGameplayEventIds)
     {
         outGameplayEventIds.clear();
-        if (asset != nullptr)
+        if (controller.stateMachineAsset != nullptr)
         {
-            for (const AnimationEventBindingDesc& binding : asset->eventBindings)
+            // Bindings were matched to the state's notifies when the controller was compiled.
+            for (const std::uint32_t bindingIndex : GetAnimationNotifyEventBindings(controller, event))
             {
-                if (binding.animationEventId.empty() || binding.gameplayEventId.empty())
-                {
-                    continue;
-                }
-                if (detail::NameMatchesAnyAlias_(event.id, { binding.animationEventId }))
-                {
-                    outGameplayEventIds.push_back(binding.gameplayEventId);
-                }
+                outGameplayEventIds.push_back(controller.stateMachineAsset->eventBindings[bindingIndex].gameplayEventId);
             }
         }
 
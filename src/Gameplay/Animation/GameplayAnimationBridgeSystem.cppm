@@ -14,6 +14,38 @@ import :animation_controller;
 
 export namespace rendern
 {
+    // Reads AnimationLink and Locomotion; writes Action (requestDispatched) and the entity's own
+    // animation controller. ctx.levelInstance and ctx.scene must be set.
+    inline void PushGameplayStateToAnimationForEntity(
+        GameplayWorld& world,
+        const EntityHandle entity,
+        const GameplayUpdateContext& ctx)
+    {
+        const GameplayAnimationLinkComponent* animLink = world.TryGetAnimationLink(entity);
+        const GameplayLocomotionComponent* locomotion = world.TryGetLocomotion(entity);
+        GameplayActionComponent* action = world.TryGetAction(entity);
+        if (animLink == nullptr || animLink->skinnedDrawIndex < 0)
+        {
+            return;
+        }
+
+        SkinnedDrawItem* skinnedItem = ctx.levelInstance->GetSkinnedDrawItem(*ctx.scene, animLink->skinnedDrawIndex);
+        if (skinnedItem == nullptr || skinnedItem->controller.stateMachineAsset == nullptr)
+        {
+            return;
+        }
+
+        if (locomotion != nullptr)
+        {
+            WriteGameplayLocomotionAnimationParameters(skinnedItem->controller, *locomotion);
+        }
+
+        if (action != nullptr)
+        {
+            WriteGameplayActionAnimationParameters(skinnedItem->controller, *action);
+        }
+    }
+
     inline void PushGameplayStateToAnimation(
         GameplayWorld& world,
         const std::vector<EntityHandle>& entities,
@@ -26,29 +58,7 @@ export namespace rendern
 
         for (const EntityHandle entity : entities)
         {
-            const GameplayAnimationLinkComponent* animLink = world.TryGetAnimationLink(entity);
-            const GameplayLocomotionComponent* locomotion = world.TryGetLocomotion(entity);
-            GameplayActionComponent* action = world.TryGetAction(entity);
-            if (animLink == nullptr || animLink->skinnedDrawIndex < 0)
-            {
-                continue;
-            }
-
-            SkinnedDrawItem* skinnedItem = ctx.levelInstance->GetSkinnedDrawItem(*ctx.scene, animLink->skinnedDrawIndex);
-            if (skinnedItem == nullptr || skinnedItem->controller.stateMachineAsset == nullptr)
-            {
-                continue;
-            }
-
-            if (locomotion != nullptr)
-            {
-                WriteGameplayLocomotionAnimationParameters(skinnedItem->controller, *locomotion);
-            }
-
-            if (action != nullptr)
-            {
-                WriteGameplayActionAnimationParameters(skinnedItem->controller, *action);
-            }
+            PushGameplayStateToAnimationForEntity(world, entity, ctx);
         }
     }
 
@@ -102,7 +112,7 @@ export namespace rendern
                 ApplyAnimationNotifyToGameplayState(*notifyState, action, event);
 
                 std::vector<std::string> gameplayEventIds{};
-                CollectGameplayEventIdsForAnimationEvent(skinnedItem->controller.stateMachineAsset, event, gameplayEventIds);
+                CollectGameplayEventIdsForAnimationEvent(skinnedItem->controller, event, gameplayEventIds);
                 for (const std::string& gameplayEventId : gameplayEventIds)
                 {
                     ApplyGameplayEventToGameplayState(*notifyState, action, gameplayEventId, event);
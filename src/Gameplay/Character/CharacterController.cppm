@@ -57,66 +57,88 @@ export namespace rendern
         return mathUtils::RadToDeg(std::atan2(forward.x, forward.z));
     }
 
-    inline void BuildGameplayCharacterCommands(
-        GameplayWorld& world,
-        const std::vector<EntityHandle>& entities,
-        const GameplayUpdateContext& ctx)
+    // Camera-derived inputs shared by every entity's command this frame.
+    struct GameplayCharacterCommandFrame
     {
-        mathUtils::Vec3 moveRight(1.0f, 0.0f, 0.0f);
-        mathUtils::Vec3 moveForward(0.0f, 0.0f, 1.0f);
-        float cameraYawDegrees = 0.0f;
+        mathUtils::Vec3 moveRight{ 1.0f, 0.0f, 0.0f };
+        mathUtils::Vec3 moveForward{ 0.0f, 0.0f, 1.0f };
+        float cameraYawDegrees{ 0.0f };
+        bool faceCamera{ false };
+    };
+
+    [[nodiscard]] inline GameplayCharacterCommandFrame MakeGameplayCharacterCommandFrame(const GameplayUpdateContext& ctx) noexcept
+    {
+        GameplayCharacterCommandFrame frame{};
         if (ctx.scene != nullptr)
         {
-            BuildGameplayPlanarMovementBasis(ctx.scene->camera, moveRight, moveForward);
-            cameraYawDegrees = ExtractGameplayCameraYawDegrees(ctx.scene->camera);
+            BuildGameplayPlanarMovementBasis(ctx.scene->camera, frame.moveRight, frame.moveForward);
+            frame.cameraYawDegrees = ExtractGameplayCameraYawDegrees(ctx.scene->camera);
+            frame.faceCamera = ctx.mode == GameplayRuntimeMode::Game;
         }
+        return frame;
+    }
 
-        for (const EntityHandle entity : entities)
+    // Reads InputIntent; writes CharacterCommand, CharacterMotor and CharacterMovementState.
+    inline void BuildGameplayCharacterCommandForEntity(
+        GameplayWorld& world,
+        const EntityHandle entity,
+        const GameplayCharacterCommandFrame& frame)
+    {
+        const GameplayInputIntentComponent* intent = world.TryGetInputIntent(entity);
+        GameplayCharacterCommandComponent* command = world.TryGetCharacterCommand(entity);
+        GameplayCharacterMotorComponent* motor = world.TryGetCharacterMotor(entity);
+        GameplayCharacterMovementStateComponent* movementState = world.TryGetCharacterMovementState(entity);
+        if (intent == nullptr || command == nullptr || motor == nullptr)
         {
-            GameplayInputIntentComponent* intent = world.TryGetInputIntent(entity);
-            GameplayCharacterCommandComponent* command = world.TryGetCharacterCommand(entity);
-            GameplayCharacterMotorComponent* motor = world.TryGetCharacterMotor(entity);
-            GameplayCharacterMovementStateComponent* movementState = world.TryGetCharacterMovementState(entity);
-            if (intent == nullptr || command == nullptr || motor == nullptr)
-            {
-                continue;
-            }
+            return;
+        }
 
-            *command = {};
-            command->moveInputX = intent->moveX;
-            command->moveInputY = intent->moveY;
-            command->wantsRun = intent->runHeld;
-            command->wantsJump = intent->jumpPressed;
-            command->wantsAttack = intent->attackPressed;
-            command->wantsInteract = intent->interactPressed;
-
-            mathUtils::Vec3 desiredMove = moveRight * intent->moveX + moveForward * intent->moveY;
-            desiredMove.y = 0.0f;
-            const float desiredLen = mathUtils::Length(desiredMove);
-            if (desiredLen > 1e-6f)
-            {
-                command->moveWorld = desiredMove / desiredLen;
-                command->moveMagnitude = std::clamp(desiredLen, 0.0f, 1.0f);
-            }
+        *command = {};
+        command->moveInputX = intent->moveX;
+        command->moveInputY = intent->moveY;
+        command->wantsRun = intent->runHeld;
+        command->wantsJump = intent->jumpPressed;
+        command->wantsAttack = intent->attackPressed;
+        command->wantsInteract = intent->interactPressed;
 
-            motor->desiredMoveWorld = command->moveWorld;
+        mathUtils::Vec3 desiredMove = frame.moveRight * intent->moveX + frame.moveForward * intent->moveY;
+        desiredMove.y = 0.0f;
+        const float desiredLen = mathUtils::Length(desiredMove);
+        if (desiredLen > 1e-6f)
+        {
+            command->moveWorld = desiredMove / desiredLen;
+            command->moveMagnitude = std::clamp(desiredLen, 0.0f, 1.0f);
+        }
 
-            if (movementState != nullptr)
+        motor->desiredMoveWorld = command->moveWorld;
+
+        if (movementState != nullptr)
+        {
+            if (frame.faceCamera)
             {
-                if (ctx.mode == GameplayRuntimeMode::Game && ctx.scene != nullptr)
-                {
-                    movementState->desiredFacingYawDegrees = cameraYawDegrees;
-                }
-                else
+                movementState->desiredFacingYawDegrees = frame.cameraYawDegrees;
+            }
+            else
+            {
+                movementState->desiredFacingYawDegrees = movementState->facingYawDegrees;
+                if (command->moveInputY > 0.1f && mathUtils::Length(command->moveWorld) > 1e-6f)
                 {
-                    movementState->desiredFacingYawDegrees = movementState->facingYawDegrees;
-                    if (command->moveInputY > 0.1f && mathUtils::Length(command->moveWorld) > 1e-6f)
-                    {
-                        movementState->desiredFacingYawDegrees = mathUtils::RadToDeg(
-                            std::atan2(command->moveWorld.x, command->moveWorld.z));
-                    }
+                    movementState->desiredFacingYawDegrees = mathUtils::RadToDeg(
+                        std::atan2(command->moveWorld.x, command->moveWorld.z));
                 }
             }
         }
     }
+
+    inline void BuildGameplayCharacterCommands(
+        GameplayWorld& world,
+        const std::vector<EntityHandle>& entities,
+        const GameplayUpdateContext& ctx)
+    {
+        const GameplayCharacterCommandFrame frame = MakeGameplayCharacterCommandFrame(ctx);
+        for (const EntityHandle entity : entities)
+        {
+            BuildGameplayCharacterCommandForEntity(world, entity, frame);
+        }
+    }
 }
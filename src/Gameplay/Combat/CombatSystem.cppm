@@ -8,32 +8,40 @@ import :gameplay;
 
 export namespace rendern
 {
+    // Reads CharacterCommand; writes Action.
+    inline void UpdateGameplayCombatRequestForEntity(
+        GameplayWorld& world,
+        const EntityHandle entity)
+    {
+        const GameplayCharacterCommandComponent* command = world.TryGetCharacterCommand(entity);
+        GameplayActionComponent* action = world.TryGetAction(entity);
+        if (command == nullptr || action == nullptr)
+        {
+            return;
+        }
+
+        if (action->busy || action->requested != GameplayActionKind::None)
+        {
+            return;
+        }
+
+        if (command->wantsJump)
+        {
+            action->requested = GameplayActionKind::Jump;
+        }
+        else if (command->wantsAttack)
+        {
+            action->requested = GameplayActionKind::LightAttack;
+        }
+    }
+
     inline void UpdateGameplayCombatRequests(
         GameplayWorld& world,
         const std::vector<EntityHandle>& entities)
     {
         for (const EntityHandle entity : entities)
         {
-            const GameplayCharacterCommandComponent* command = world.TryGetCharacterCommand(entity);
-            GameplayActionComponent* action = world.TryGetAction(entity);
-            if (command == nullptr || action == nullptr)
-            {
-                continue;
-            }
-
-            if (action->busy || action->requested != GameplayActionKind::None)
-            {
-                continue;
-            }
-
-            if (command->wantsJump)
-            {
-                action->requested = GameplayActionKind::Jump;
-            }
-            else if (command->wantsAttack)
-            {
-                action->requested = GameplayActionKind::LightAttack;
-            }
+            UpdateGameplayCombatRequestForEntity(world, entity);
         }
     }
 }
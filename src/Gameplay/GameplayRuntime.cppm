@@ -1090,12 +1090,12 @@ export namespace rendern
                 node.transform.position = desiredTransform.position;
                 node.transform.rotationDegrees = desiredTransform.rotationDegrees;
                 node.transform.scale = desiredTransform.scale;
+                ctx.levelInstance->MarkNodeTransformDirty(nodeLink->nodeIndex);
                 anyTransformChanged = true;
             }
 
             if (anyTransformChanged)
             {
-                ctx.levelInstance->MarkTransformsDirty();
                 ctx.levelInstance->SyncTransformsIfDirty(*ctx.levelAsset, *ctx.scene);
             }
         }
@@ -4,6 +4,7 @@ module;
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 export module core:gameplay;
 
@@ -166,6 +167,12 @@ export namespace rendern
         [[nodiscard]] bool HasTransform(EntityHandle entity) const noexcept;
         void RemoveTransform(EntityHandle entity);
 
+        // Transform change tracking. Add/SetTransform mark the entity themselves; code writing
+        // through TryGetTransform calls MarkTransformChanged, which is safe from concurrent systems.
+        // ConsumeChangedTransforms appends every marked entity once and clears the marks.
+        void MarkTransformChanged(EntityHandle entity);
+        void ConsumeChangedTransforms(std::vector<EntityHandle>& outEntities);
+
         void AddNodeLink(EntityHandle entity, const GameplayNodeLinkComponent& value);
         void SetNodeLink(EntityHandle entity, const GameplayNodeLinkComponent& value);
         [[nodiscard]] GameplayNodeLinkComponent* TryGetNodeLink(EntityHandle entity) noexcept;
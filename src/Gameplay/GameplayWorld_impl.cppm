@@ -1,7 +1,9 @@
 module;
 
 #include <entt/entt.hpp>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 module core:gameplay_impl;
 
@@ -9,10 +11,64 @@ import :gameplay;
 
 namespace rendern
 {
+    // Entities whose transform changed since the last ConsumeChangedTransforms.
+    struct GameplayTransformChangedTag
+    {
+    };
+
     struct GameplayWorld::Impl
     {
+        // Every pool exists up front: a non-const try_get would otherwise create it on first use,
+        // which races once systems call TryGet* from several jobs (GameplaySystemScheduler).
+        Impl()
+        {
+            registry.storage<GameplayTransformComponent>();
+            registry.storage<GameplayNodeLinkComponent>();
+            registry.storage<GameplayAnimationLinkComponent>();
+            registry.storage<GameplayPlayerControlledComponent>();
+            registry.storage<GameplayInputIntentComponent>();
+            registry.storage<GameplayCharacterCommandComponent>();
+            registry.storage<GameplayCharacterMotorComponent>();
+            registry.storage<GameplayCharacterMovementStateComponent>();
+            registry.storage<GameplayFollowCameraComponent>();
+            registry.storage<GameplayLocomotionComponent>();
+            registry.storage<GameplayActionComponent>();
+            registry.storage<GameplayAnimationNotifyStateComponent>();
+            registry.storage<GameplayTransformChangedTag>();
+
+            registry.on_construct<GameplayTransformComponent>().connect<&Impl::OnTransformChanged>(*this);
+            registry.on_update<GameplayTransformComponent>().connect<&Impl::OnTransformChanged>(*this);
+            registry.on_destroy<GameplayTransformComponent>().connect<&Impl::OnTransformRemoved>(*this);
+        }
+
+        // The registry keeps a pointer to the Impl for the signals: it must not move.
+        Impl(const Impl&) = delete;
+        Impl& operator=(const Impl&) = delete;
+
+        void MarkTransformChanged(const entt::entity entity)
+        {
+            std::scoped_lock lock(transformChangedMutex);
+            auto& changed = registry.storage<GameplayTransformChangedTag>();
+            if (!changed.contains(entity))
+            {
+                changed.emplace(entity);
+            }
+        }
+
+        void OnTransformChanged(entt::registry&, const entt::entity entity)
+        {
+            MarkTransformChanged(entity);
+        }
+
+        void OnTransformRemoved(entt::registry&, const entt::entity entity)
+        {
+            std::scoped_lock lock(transformChangedMutex);
+            registry.storage<GameplayTransformChangedTag>().remove(entity);
+        }
+
         entt::registry registry{};
         std::size_t aliveCount{ 0 };
+        std::mutex transformChangedMutex{};
     };
 
     GameplayWorld::GameplayWorld()
@@ -107,6 +163,28 @@ namespace rendern
         impl_->registry.remove<GameplayTransformComponent>(ToEnTT(entity));
     }
 
+    void GameplayWorld::MarkTransformChanged(const EntityHandle entity)
+    {
+        if (!HasTransform(entity))
+        {
+            return;
+        }
+
+        impl_->MarkTransformChanged(ToEnTT(entity));
+    }
+
+    void GameplayWorld::ConsumeChangedTransforms(std::vector<EntityHandle>& outEntities)
+    {
+        std::scoped_lock lock(impl_->transformChangedMutex);
+        auto& changed = impl_->registry.storage<GameplayTransformChangedTag>();
+        outEntities.reserve(outEntities.size() + changed.size());
+        for (std::size_t i = 0; i < changed.size(); ++i)
+        {
+            outEntities.push_back(FromEnTT(changed.data()[i]));
+        }
+        changed.clear();
+    }
+
     void GameplayWorld::AddNodeLink(const EntityHandle entity, const GameplayNodeLinkComponent& value)
     {
         if (!IsEntityValid(entity))
@@ -3,6 +3,7 @@ module;
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -90,10 +91,94 @@ export namespace rendern
         bool enterPending{ true };
     };
 
+    // ---- Compiled graph ----
+    // CompileGameplayGraph flattens an asset into index-addressed arrays: parameters become slots, states
+    // and transition targets become indices and conditions / tasks become op codes, so ticking a graph
+    // compares no strings and allocates nothing.
+
+    enum class GameplayGraphConditionOp : std::uint8_t
+    {
+        BoolTrue = 0,
+        BoolFalse = 1,
+        FloatGreater = 2,
+        FloatLess = 3,
+        Never = 4 // unknown condition name: the transition never fires
+    };
+
+    enum class GameplayGraphTaskOp : std::uint8_t
+    {
+        BeginActionState = 0
+    };
+
+    struct GameplayGraphCondition
+    {
+        GameplayGraphConditionOp op{ GameplayGraphConditionOp::Never };
+        std::uint16_t parameter{ 0 };
+        float threshold{ 0.0f };
+    };
+
+    struct GameplayGraphRange
+    {
+        std::uint32_t first{ 0 };
+        std::uint32_t count{ 0 };
+    };
+
+    struct GameplayGraphTransition
+    {
+        int toState{ -1 }; // state index in the layer, -1 = unknown (the layer restarts at its default state)
+        GameplayGraphRange conditions{};
+    };
+
+    struct GameplayGraphState
+    {
+        GameplayGraphRange onEnter{};
+        GameplayGraphRange onUpdate{};
+        GameplayGraphRange onExit{};
+        GameplayGraphRange transitions{};
+    };
+
+    struct GameplayGraphLayer
+    {
+        GameplayGraphRange states{};
+        int defaultState{ -1 };
+    };
+
+    struct GameplayGraphProgram
+    {
+        std::vector<std::string> parameterNames{}; // slot -> parameter name
+        std::vector<GameplayGraphLayer> layers{};
+        std::vector<GameplayGraphState> states{};
+        std::vector<GameplayGraphTransition> transitions{};
+        std::vector<GameplayGraphCondition> conditions{};
+        std::vector<GameplayGraphTaskOp> tasks{};
+
+        [[nodiscard]] int FindParameter(std::string_view name) const noexcept
+        {
+            for (std::size_t i = 0; i < parameterNames.size(); ++i)
+            {
+                if (parameterNames[i] == name)
+                {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+    };
+
+    // Value of a parameter slot; reads convert between the types like the GetGameplayGraph* functions.
+    struct GameplayGraphSlot
+    {
+        GameplayGraphValueType type{ GameplayGraphValueType::Bool };
+        bool boolValue{ false };
+        int intValue{ 0 };
+        float floatValue{ 0.0f };
+    };
+
     struct GameplayGraphInstance
     {
         const GameplayGraphAsset* asset{ nullptr };
-        GameplayGraphParameterStore parameters{};
+        const GameplayGraphProgram* program{ nullptr };
+        std::vector<GameplayGraphSlot> slots{}; // one per program->parameterNames
         GameplayGraphParameterStore blackboard{};
         std::vector<GameplayGraphLayerRuntimeState> layers{};
         std::vector<GameplayGraphEvent> eventsThisFrame{};
@@ -116,11 +201,11 @@ export namespace rendern
 
     inline void ClearGameplayGraphFrameState(GameplayGraphInstance& instance)
     {
-        for (auto& [name, value] : instance.parameters.values)
+        for (GameplayGraphSlot& slot : instance.slots)
         {
-            if (value.type == GameplayGraphValueType::Trigger)
+            if (slot.type == GameplayGraphValueType::Trigger)
             {
-                value.boolValue = false;
+                slot.boolValue = false;
             }
         }
         instance.eventsThisFrame.clear();
@@ -286,4 +371,268 @@ export namespace rendern
         }
         return -1;
     }
+
+    // Parameters referenced by conditions get slots in order of first use, then the declared ones that are
+    // still missing (parameters the game writes without a condition reading them).
+    [[nodiscard]] inline GameplayGraphProgram CompileGameplayGraph(
+        const GameplayGraphAsset& asset,
+        std::span<const std::string_view> declaredParameters = {})
+    {
+        GameplayGraphProgram program{};
+        auto ParameterSlot = [&program](std::string_view name) -> std::uint16_t
+            {
+                const int existing = program.FindParameter(name);
+                if (existing >= 0)
+                {
+                    return static_cast<std::uint16_t>(existing);
+                }
+                program.parameterNames.emplace_back(name);
+                return static_cast<std::uint16_t>(program.parameterNames.size() - 1u);
+            };
+        auto CompileTasks = [&program](const std::vector<GameplayGraphTaskDesc>& tasks) -> GameplayGraphRange
+            {
+                GameplayGraphRange range{ static_cast<std::uint32_t>(program.tasks.size()), 0u };
+                for (const GameplayGraphTaskDesc& task : tasks)
+                {
+                    // Tasks the runtime does not know are dropped, as the interpreter ignored them.
+                    if (CanonicalizeGameplayGraphToken(task.name) == "beginactionstate")
+                    {
+                        program.tasks.push_back(GameplayGraphTaskOp::BeginActionState);
+                        ++range.count;
+                    }
+                }
+                return range;
+            };
+
+        program.layers.reserve(asset.layers.size());
+        for (const GameplayGraphLayerDesc& layerDesc : asset.layers)
+        {
+            GameplayGraphLayer layer{};
+            layer.states = { static_cast<std::uint32_t>(program.states.size()), static_cast<std::uint32_t>(layerDesc.states.size()) };
+            layer.defaultState = FindGameplayGraphStateIndex(layerDesc, layerDesc.defaultState);
+
+            for (const GameplayGraphStateDesc& stateDesc : layerDesc.states)
+            {
+                GameplayGraphState state{};
+                state.onEnter = CompileTasks(stateDesc.onEnter);
+                state.onUpdate = CompileTasks(stateDesc.onUpdate);
+                state.onExit = CompileTasks(stateDesc.onExit);
+                state.transitions = { static_cast<std::uint32_t>(program.transitions.size()), static_cast<std::uint32_t>(stateDesc.transitions.size()) };
+
+                for (const GameplayGraphTransitionDesc& transitionDesc : stateDesc.transitions)
+                {
+                    GameplayGraphTransition transition{};
+                    transition.toState = FindGameplayGraphStateIndex(layerDesc, transitionDesc.toState);
+                    transition.conditions = { static_cast<std::uint32_t>(program.conditions.size()), static_cast<std::uint32_t>(transitionDesc.conditions.size()) };
+                    for (const GameplayGraphConditionDesc& conditionDesc : transitionDesc.conditions)
+                    {
+                        const std::string conditionName = CanonicalizeGameplayGraphToken(conditionDesc.name);
+                        GameplayGraphCondition condition{};
+                        condition.threshold = conditionDesc.threshold;
+                        if (conditionName == "booltrue")
+                        {
+                            condition.op = GameplayGraphConditionOp::BoolTrue;
+                        }
+                        else if (conditionName == "boolfalse")
+                        {
+                            condition.op = GameplayGraphConditionOp::BoolFalse;
+                        }
+                        else if (conditionName == "floatgreater")
+                        {
+                            condition.op = GameplayGraphConditionOp::FloatGreater;
+                        }
+                        else if (conditionName == "floatless")
+                        {
+                            condition.op = GameplayGraphConditionOp::FloatLess;
+                        }
+                        if (condition.op != GameplayGraphConditionOp::Never)
+                        {
+                            condition.parameter = ParameterSlot(conditionDesc.parameter);
+                        }
+                        program.conditions.push_back(condition);
+                    }
+                    program.transitions.push_back(transition);
+                }
+                program.states.push_back(state);
+            }
+            program.layers.push_back(layer);
+        }
+
+        for (const std::string_view name : declaredParameters)
+        {
+            ParameterSlot(name);
+        }
+        return program;
+    }
+
+    inline void SetGameplayGraphSlotBool(std::span<GameplayGraphSlot> slots, int slot, bool value) noexcept
+    {
+        if (slot >= 0 && static_cast<std::size_t>(slot) < slots.size())
+        {
+            slots[static_cast<std::size_t>(slot)] = GameplayGraphSlot{ .type = GameplayGraphValueType::Bool, .boolValue = value };
+        }
+    }
+
+    inline void SetGameplayGraphSlotInt(std::span<GameplayGraphSlot> slots, int slot, int value) noexcept
+    {
+        if (slot >= 0 && static_cast<std::size_t>(slot) < slots.size())
+        {
+            slots[static_cast<std::size_t>(slot)] = GameplayGraphSlot{ .type = GameplayGraphValueType::Int, .intValue = value };
+        }
+    }
+
+    inline void SetGameplayGraphSlotFloat(std::span<GameplayGraphSlot> slots, int slot, float value) noexcept
+    {
+        if (slot >= 0 && static_cast<std::size_t>(slot) < slots.size())
+        {
+            slots[static_cast<std::size_t>(slot)] = GameplayGraphSlot{ .type = GameplayGraphValueType::Float, .floatValue = value };
+        }
+    }
+
+    inline void SetGameplayGraphSlotTrigger(std::span<GameplayGraphSlot> slots, int slot) noexcept
+    {
+        if (slot >= 0 && static_cast<std::size_t>(slot) < slots.size())
+        {
+            slots[static_cast<std::size_t>(slot)] = GameplayGraphSlot{ .type = GameplayGraphValueType::Trigger, .boolValue = true };
+        }
+    }
+
+    [[nodiscard]] inline bool GetGameplayGraphSlotBool(const GameplayGraphSlot& slot) noexcept
+    {
+        switch (slot.type)
+        {
+        case GameplayGraphValueType::Bool:
+        case GameplayGraphValueType::Trigger:
+            return slot.boolValue;
+        case GameplayGraphValueType::Int:
+            return slot.intValue != 0;
+        case GameplayGraphValueType::Float:
+            return slot.floatValue > 1e-6f || slot.floatValue < -1e-6f;
+        default:
+            return false;
+        }
+    }
+
+    [[nodiscard]] inline float GetGameplayGraphSlotFloat(const GameplayGraphSlot& slot) noexcept
+    {
+        switch (slot.type)
+        {
+        case GameplayGraphValueType::Bool:
+        case GameplayGraphValueType::Trigger:
+            return slot.boolValue ? 1.0f : 0.0f;
+        case GameplayGraphValueType::Int:
+            return static_cast<float>(slot.intValue);
+        case GameplayGraphValueType::Float:
+            return slot.floatValue;
+        default:
+            return 0.0f;
+        }
+    }
+
+    [[nodiscard]] inline bool EvaluateGameplayGraphTransition(
+        const GameplayGraphProgram& program,
+        const GameplayGraphTransition& transition,
+        std::span<const GameplayGraphSlot> slots) noexcept
+    {
+        for (std::uint32_t i = 0; i < transition.conditions.count; ++i)
+        {
+            const GameplayGraphCondition& condition = program.conditions[transition.conditions.first + i];
+            const GameplayGraphSlot slot = condition.parameter < slots.size() ? slots[condition.parameter] : GameplayGraphSlot{};
+            bool passed = false;
+            switch (condition.op)
+            {
+            case GameplayGraphConditionOp::BoolTrue:
+                passed = GetGameplayGraphSlotBool(slot);
+                break;
+            case GameplayGraphConditionOp::BoolFalse:
+                passed = !GetGameplayGraphSlotBool(slot);
+                break;
+            case GameplayGraphConditionOp::FloatGreater:
+                passed = GetGameplayGraphSlotFloat(slot) > condition.threshold;
+                break;
+            case GameplayGraphConditionOp::FloatLess:
+                passed = GetGameplayGraphSlotFloat(slot) < condition.threshold;
+                break;
+            default:
+                break;
+            }
+            if (!passed)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // One tick of a layer: pending onEnter, onUpdate, then the first transition whose conditions hold
+    // (onExit, switch, onEnter of the new state). runTask(GameplayGraphTaskOp) runs the tasks; it may
+    // write the slots the following conditions read.
+    template <class RunTask>
+    void TickGameplayGraphLayer(
+        const GameplayGraphProgram& program,
+        std::size_t layerIndex,
+        GameplayGraphLayerRuntimeState& runtimeLayer,
+        std::span<const GameplayGraphSlot> slots,
+        float deltaSeconds,
+        RunTask&& runTask)
+    {
+        const GameplayGraphLayer& layer = program.layers[layerIndex];
+        auto RunTasks = [&](GameplayGraphRange range)
+            {
+                for (std::uint32_t i = 0; i < range.count; ++i)
+                {
+                    runTask(program.tasks[range.first + i]);
+                }
+            };
+        auto StateOf = [&](int stateIndex) -> const GameplayGraphState&
+            {
+                return program.states[layer.states.first + static_cast<std::uint32_t>(stateIndex)];
+            };
+
+        if (runtimeLayer.activeStateIndex < 0 ||
+            static_cast<std::uint32_t>(runtimeLayer.activeStateIndex) >= layer.states.count)
+        {
+            runtimeLayer.activeStateIndex = layer.defaultState;
+            runtimeLayer.enterPending = true;
+            runtimeLayer.stateTime = 0.0f;
+        }
+        if (runtimeLayer.activeStateIndex < 0)
+        {
+            return;
+        }
+
+        const GameplayGraphState& state = StateOf(runtimeLayer.activeStateIndex);
+        if (runtimeLayer.enterPending)
+        {
+            RunTasks(state.onEnter);
+            runtimeLayer.enterPending = false;
+        }
+
+        RunTasks(state.onUpdate);
+
+        for (std::uint32_t i = 0; i < state.transitions.count; ++i)
+        {
+            const GameplayGraphTransition& transition = program.transitions[state.transitions.first + i];
+            if (!EvaluateGameplayGraphTransition(program, transition, slots))
+            {
+                continue;
+            }
+
+            RunTasks(state.onExit);
+
+            runtimeLayer.previousStateIndex = runtimeLayer.activeStateIndex;
+            runtimeLayer.activeStateIndex = transition.toState;
+            runtimeLayer.stateTime = 0.0f;
+            runtimeLayer.enterPending = true;
+
+            if (transition.toState >= 0)
+            {
+                RunTasks(StateOf(transition.toState).onEnter);
+                runtimeLayer.enterPending = false;
+            }
+            return;
+        }
+
+        runtimeLayer.stateTime += std::max(deltaSeconds, 0.0f);
+    }
 }
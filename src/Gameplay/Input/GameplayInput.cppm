@@ -1,5 +1,6 @@
 module;
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -37,10 +38,12 @@ export namespace rendern
         return binding.key != 0 && input.KeyPressed(binding.key);
     }
 
+    // Keys count for the share of the sampled interval they were held (InputState::keyDownFraction),
+    // so a key pressed halfway through a tick moves the character for half of it; polled input is 0 or 1.
     inline void ReadGameplayAxisFromKeys(const InputState& input, const GameplayAxisKeyBinding& binding, float& outValue) noexcept
     {
-        const float positive = (binding.positiveKey != 0 && input.KeyDown(binding.positiveKey)) ? 1.0f : 0.0f;
-        const float negative = (binding.negativeKey != 0 && input.KeyDown(binding.negativeKey)) ? 1.0f : 0.0f;
+        const float positive = (binding.positiveKey != 0) ? input.KeyDownFraction(binding.positiveKey) : 0.0f;
+        const float negative = (binding.negativeKey != 0) ? input.KeyDownFraction(binding.negativeKey) : 0.0f;
         outValue = positive - negative;
     }
 
@@ -53,7 +56,10 @@ export namespace rendern
         float moveY = 0.0f;
         ReadGameplayAxisFromKeys(input, bindings.moveX, moveX);
         ReadGameplayAxisFromKeys(input, bindings.moveY, moveY);
-        NormalizeGameplayMoveAxis(moveX, moveY, outIntent.moveX, outIntent.moveY);
+        // Full presses normalise to unit length; partly held keys keep their shorter length.
+        const float moveLength = std::min(NormalizeGameplayMoveAxis(moveX, moveY, outIntent.moveX, outIntent.moveY), 1.0f);
+        outIntent.moveX *= moveLength;
+        outIntent.moveY *= moveLength;
 
         outIntent.runHeld = ReadGameplayHeldButton(input, bindings.run);
         outIntent.jumpPressed = ReadGameplayPressedButton(input, bindings.jump);
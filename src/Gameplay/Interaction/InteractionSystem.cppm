@@ -8,28 +8,36 @@ import :gameplay;
 
 export namespace rendern
 {
+    // Reads CharacterCommand; writes Action.
+    inline void UpdateGameplayInteractionRequestForEntity(
+        GameplayWorld& world,
+        const EntityHandle entity)
+    {
+        const GameplayCharacterCommandComponent* command = world.TryGetCharacterCommand(entity);
+        GameplayActionComponent* action = world.TryGetAction(entity);
+        if (command == nullptr || action == nullptr)
+        {
+            return;
+        }
+
+        if (action->busy || action->requested != GameplayActionKind::None)
+        {
+            return;
+        }
+
+        if (command->wantsInteract)
+        {
+            action->requested = GameplayActionKind::Interact;
+        }
+    }
+
     inline void UpdateGameplayInteractionRequests(
         GameplayWorld& world,
         const std::vector<EntityHandle>& entities)
     {
         for (const EntityHandle entity : entities)
         {
-            const GameplayCharacterCommandComponent* command = world.TryGetCharacterCommand(entity);
-            GameplayActionComponent* action = world.TryGetAction(entity);
-            if (command == nullptr || action == nullptr)
-            {
-                continue;
-            }
-
-            if (action->busy || action->requested != GameplayActionKind::None)
-            {
-                continue;
-            }
-
-            if (command->wantsInteract)
-            {
-                action->requested = GameplayActionKind::Interact;
-            }
+            UpdateGameplayInteractionRequestForEntity(world, entity);
         }
     }
 }
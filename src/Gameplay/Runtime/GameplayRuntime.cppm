@@ -1,7 +1,9 @@
 module;
 
 #include <algorithm>
+#include <array>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <unordered_map>
 #include <vector>
@@ -22,17 +24,31 @@ import :combat_system;
 import :interaction_system;
 import :gameplay_animation_bridge;
 import :gameplay_animation_bridge_system;
+import :gameplay_system_scheduler;
+import :gametimer_core;
+import :input;
+import :input_core;
+import :math_utils;
+import :scene;
 
 export namespace rendern
 {
     class GameplayRuntime
     {
     public:
-        GameplayRuntime() = default;
+        GameplayRuntime()
+        {
+            RegisterPreAnimationSystems_();
+        }
+
+        // The registered systems point back at this runtime.
+        GameplayRuntime(const GameplayRuntime&) = delete;
+        GameplayRuntime& operator=(const GameplayRuntime&) = delete;
 
         void Initialize(LevelAsset& levelAsset, LevelInstance& levelInstance, Scene& scene)
         {
             defaultGraphAsset_ = MakeDefaultHumanoidGameplayGraphAsset();
+            CompileDefaultGraph_();
 
             GameplayUpdateContext ctx{};
             ctx.mode = GameplayRuntimeMode::Editor;
@@ -53,6 +69,82 @@ export namespace rendern
             graphInstances_.clear();
             controlledEntity_ = kNullEntity;
             lastMode_ = GameplayRuntimeMode::Editor;
+            ResetFixedStep_();
+        }
+
+        // tickHz <= 0 keeps the variable step: UpdateSimulation runs one PreAnimationUpdate per frame.
+        void SetFixedStep(const double tickHz, const int maxCatchupTicks = 4)
+        {
+            fixedStepEnabled_ = tickHz > 0.0;
+            if (fixedStepEnabled_)
+            {
+                fixedStep_.SetFixedDeltaSec(1.0 / tickHz);
+                fixedStep_.SetMaxCatchupTicks(maxCatchupTicks);
+            }
+            ResetFixedStep_();
+        }
+
+        [[nodiscard]] bool IsFixedStep() const noexcept
+        {
+            return fixedStepEnabled_;
+        }
+
+        // BeginFrame + PreAnimationUpdate for one rendered frame. With a fixed step in Game mode they
+        // run once per tick that is due, with the fixed delta; key edges and mouse deltas of frames
+        // without a tick carry over to the next tick. Level nodes and the scene camera then show the
+        // state interpolated between the last two ticks.
+        void UpdateSimulation(const GameplayUpdateContext& frameCtx)
+        {
+            if (!fixedStepEnabled_ || frameCtx.mode != GameplayRuntimeMode::Game)
+            {
+                ResetFixedStep_();
+                BeginFrame();
+                PreAnimationUpdate(frameCtx);
+                return;
+            }
+
+            if (frameCtx.input != nullptr)
+            {
+                AccumulateInputFrame(pendingInput_, *frameCtx.input);
+            }
+
+            // Ticks continue from the last tick's camera, not from the interpolated one.
+            Scene* scene = frameCtx.scene;
+            if (scene != nullptr && hasTickCamera_)
+            {
+                scene->camera = tickCamera_;
+            }
+
+            GameplayUpdateContext tickCtx = frameCtx;
+            tickCtx.deltaSeconds = static_cast<float>(fixedStep_.GetFixedDeltaSec());
+            tickCtx.input = (frameCtx.input != nullptr) ? &pendingInput_ : nullptr;
+
+            const FixedStepResult step = fixedStep_.Advance(frameCtx.deltaSeconds);
+            for (int tick = 0; tick < step.tickToSimulate; ++tick)
+            {
+                const Camera cameraBeforeTick = (scene != nullptr) ? scene->camera : Camera{};
+
+                BeginFrame();
+                recordingTicks_ = true;
+                PreAnimationUpdate(tickCtx);
+                recordingTicks_ = false;
+                ClearInputEdges(pendingInput_);
+
+                if (scene != nullptr)
+                {
+                    previousTickCamera_ = hasTickCamera_ ? cameraBeforeTick : scene->camera;
+                    tickCamera_ = scene->camera;
+                    hasTickCamera_ = true;
+                }
+            }
+
+            const float alpha = static_cast<float>(step.alpha);
+            SyncInterpolatedGameplayTransforms(world_, frameCtx, interpolation_, alpha);
+            if (scene != nullptr && hasTickCamera_)
+            {
+                scene->camera.position = mathUtils::Lerp(previousTickCamera_.position, tickCamera_.position, alpha);
+                scene->camera.target = mathUtils::Lerp(previousTickCamera_.target, tickCamera_.target, alpha);
+            }
         }
 
         void BindIntentSource(const EntityHandle entity, GameplayIntentSourceCallback callback)
@@ -143,26 +235,7 @@ export namespace rendern
                 return;
             }
 
-            if (ctx.scene != nullptr)
-            {
-                followCameraController_.Update(world_, controlledEntity_, ctx);
-            }
-
-            UpdateGameplayIntentSources(world_, intentBindings_, ctx);
-            BuildGameplayCharacterCommands(world_, nodeBoundEntities_, ctx);
-            UpdateGameplayCombatRequests(world_, nodeBoundEntities_);
-            UpdateGameplayInteractionRequests(world_, nodeBoundEntities_);
-            ExecuteGameplayGraphs_(ctx);
-            UpdateGameplayCharacterMovement(world_, nodeBoundEntities_, ctx.deltaSeconds);
-            UpdateGameplayCharacterLocomotion(world_, nodeBoundEntities_);
-            SyncGameplayTransformsToRuntime(world_, nodeBoundEntities_, ctx);
-            if (ctx.scene != nullptr)
-            {
-                GameplayUpdateContext cameraCtx = ctx;
-                cameraCtx.input = nullptr;
-                followCameraController_.Update(world_, controlledEntity_, ctx);
-            }
-            PushGameplayStateToAnimation(world_, nodeBoundEntities_, ctx);
+            preAnimationSystems_.Run(world_, nodeBoundEntities_, ctx);
         }
 
         void PostAnimationUpdate(const GameplayUpdateContext& ctx)
@@ -241,52 +314,6 @@ export namespace rendern
         }
 
     private:
-        [[nodiscard]] static bool EvaluateGraphTransition_(
-            const GameplayGraphInstance& graph,
-            const GameplayGraphTransitionDesc& transition)
-        {
-            for (const GameplayGraphConditionDesc& condition : transition.conditions)
-            {
-                const std::string conditionName = CanonicalizeGameplayGraphToken(condition.name);
-                if (conditionName == "booltrue")
-                {
-                    if (!GetGameplayGraphBool(graph.parameters, condition.parameter, false))
-                    {
-                        return false;
-                    }
-                    continue;
-                }
-                if (conditionName == "boolfalse")
-                {
-                    if (GetGameplayGraphBool(graph.parameters, condition.parameter, false))
-                    {
-                        return false;
-                    }
-                    continue;
-                }
-                if (conditionName == "floatgreater")
-                {
-                    if (!(GetGameplayGraphFloat(graph.parameters, condition.parameter, 0.0f) > condition.threshold))
-                    {
-                        return false;
-                    }
-                    continue;
-                }
-                if (conditionName == "floatless")
-                {
-                    if (!(GetGameplayGraphFloat(graph.parameters, condition.parameter, 0.0f) < condition.threshold))
-                    {
-                        return false;
-                    }
-                    continue;
-                }
-
-                return false;
-            }
-
-            return true;
-        }
-
         static void CompactEntityVector_(std::vector<EntityHandle>& entities, const GameplayWorld& world)
         {
             entities.erase(
@@ -353,139 +380,240 @@ export namespace rendern
         {
             GameplayGraphInstance instance{};
             instance.asset = &defaultGraphAsset_;
-            instance.layers.reserve(defaultGraphAsset_.layers.size());
+            instance.program = &defaultGraphProgram_;
+            instance.slots.resize(defaultGraphProgram_.parameterNames.size());
+            instance.layers.reserve(defaultGraphProgram_.layers.size());
 
-            for (const GameplayGraphLayerDesc& layer : defaultGraphAsset_.layers)
+            for (const GameplayGraphLayer& layer : defaultGraphProgram_.layers)
             {
-                const int defaultStateIndex = FindGameplayGraphStateIndex(layer, layer.defaultState);
                 instance.layers.push_back(GameplayGraphLayerRuntimeState{
-                    .activeStateIndex = defaultStateIndex,
+                    .activeStateIndex = layer.defaultState,
                     .previousStateIndex = -1,
                     .stateTime = 0.0f,
                     .enterPending = true
                 });
             }
 
-            SetGameplayGraphBool(instance.parameters, "hasActionRequest", false);
-            SetGameplayGraphBool(instance.parameters, "actionBusy", false);
-            SetGameplayGraphInt(instance.parameters, "requestedActionKind", 0);
-            SetGameplayGraphInt(instance.parameters, "currentAction", 0);
+            WriteActionGraphParameters_(instance, false, false, GameplayActionKind::None, GameplayActionKind::None);
 
             graphInstances_.insert_or_assign(entity, std::move(instance));
         }
 
+        // The parameters the runtime writes every tick are resolved to slots once, at compile time.
+        void CompileDefaultGraph_()
+        {
+            static constexpr std::array<std::string_view, 4> kActionParameters{
+                "hasActionRequest", "actionBusy", "requestedActionKind", "currentAction" };
+
+            defaultGraphProgram_ = CompileGameplayGraph(defaultGraphAsset_, kActionParameters);
+            actionSlots_.hasActionRequest = defaultGraphProgram_.FindParameter("hasActionRequest");
+            actionSlots_.actionBusy = defaultGraphProgram_.FindParameter("actionBusy");
+            actionSlots_.requestedActionKind = defaultGraphProgram_.FindParameter("requestedActionKind");
+            actionSlots_.currentAction = defaultGraphProgram_.FindParameter("currentAction");
+        }
+
+        void WriteActionGraphParameters_(
+            GameplayGraphInstance& graph,
+            const bool hasActionRequest,
+            const bool actionBusy,
+            const GameplayActionKind requested,
+            const GameplayActionKind current) const
+        {
+            SetGameplayGraphSlotBool(graph.slots, actionSlots_.hasActionRequest, hasActionRequest);
+            SetGameplayGraphSlotBool(graph.slots, actionSlots_.actionBusy, actionBusy);
+            SetGameplayGraphSlotInt(graph.slots, actionSlots_.requestedActionKind, static_cast<int>(requested));
+            SetGameplayGraphSlotInt(graph.slots, actionSlots_.currentAction, static_cast<int>(current));
+        }
+
         void SyncActionStateToGraphParameters_(const EntityHandle entity, GameplayGraphInstance& graph)
         {
             const GameplayActionComponent* action = world_.TryGetAction(entity);
             if (action == nullptr)
             {
-                SetGameplayGraphBool(graph.parameters, "hasActionRequest", false);
-                SetGameplayGraphBool(graph.parameters, "actionBusy", false);
-                SetGameplayGraphInt(graph.parameters, "requestedActionKind", 0);
-                SetGameplayGraphInt(graph.parameters, "currentAction", 0);
+                WriteActionGraphParameters_(graph, false, false, GameplayActionKind::None, GameplayActionKind::None);
                 return;
             }
 
-            SetGameplayGraphBool(graph.parameters, "hasActionRequest", action->requested != GameplayActionKind::None);
-            SetGameplayGraphBool(graph.parameters, "actionBusy", action->busy);
-            SetGameplayGraphInt(graph.parameters, "requestedActionKind", static_cast<int>(action->requested));
-            SetGameplayGraphInt(graph.parameters, "currentAction", static_cast<int>(action->current));
+            WriteActionGraphParameters_(graph, action->requested != GameplayActionKind::None, action->busy, action->requested, action->current);
         }
 
-        void ExecuteGameplayGraphs_(const GameplayUpdateContext& ctx)
+        // The same order as the serial loop this replaced; accesses are listed per system. Entity
+        // systems only touch their own entity (and, for the graphs, its own graph instance).
+        void RegisterPreAnimationSystems_()
         {
-            for (const EntityHandle entity : nodeBoundEntities_)
-            {
-                auto it = graphInstances_.find(entity);
-                if (it == graphInstances_.end())
+            constexpr std::size_t kEntityGrain = 64;
+
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::FollowCamera",
+                .reads = GameplayAccess::Transform,
+                .writes = GameplayAccess::FollowCamera | GameplayAccess::SceneCamera,
+                .run = [this](const GameplaySystemContext& sys)
                 {
-                    continue;
+                    if (sys.update.scene != nullptr)
+                    {
+                        followCameraController_.Update(sys.world, controlledEntity_, sys.update);
+                    }
                 }
+            });
 
-                GameplayGraphInstance& graph = it->second;
-                SyncActionStateToGraphParameters_(entity, graph);
-
-                for (std::size_t layerIndex = 0; layerIndex < graph.layers.size() && layerIndex < graph.asset->layers.size(); ++layerIndex)
+            // Callbacks get the whole world.
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::IntentSources",
+                .reads = GameplayAccess::All,
+                .writes = GameplayAccess::All,
+                .run = [this](const GameplaySystemContext& sys)
                 {
-                    GameplayGraphLayerRuntimeState& runtimeLayer = graph.layers[layerIndex];
-                    const GameplayGraphLayerDesc& assetLayer = graph.asset->layers[layerIndex];
-                    ExecuteGraphLayer_(entity, graph, runtimeLayer, assetLayer, ctx);
+                    UpdateGameplayIntentSources(sys.world, intentBindings_, sys.update);
                 }
+            });
 
-                SyncActionStateToGraphParameters_(entity, graph);
-            }
-        }
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::CharacterCommands",
+                .reads = GameplayAccess::InputIntent | GameplayAccess::SceneCamera,
+                .writes = GameplayAccess::CharacterCommand | GameplayAccess::CharacterMotor | GameplayAccess::CharacterMovementState,
+                .entityGrain = kEntityGrain,
+                .run = [](const GameplaySystemContext& sys)
+                {
+                    const GameplayCharacterCommandFrame frame = MakeGameplayCharacterCommandFrame(sys.update);
+                    sys.ForEachEntity([&](const EntityHandle entity)
+                        {
+                            BuildGameplayCharacterCommandForEntity(sys.world, entity, frame);
+                        });
+                }
+            });
 
-        void ExecuteGraphLayer_(
-            const EntityHandle entity,
-            GameplayGraphInstance& graph,
-            GameplayGraphLayerRuntimeState& runtimeLayer,
-            const GameplayGraphLayerDesc& assetLayer,
-            const GameplayUpdateContext& ctx)
-        {
-            if (runtimeLayer.activeStateIndex < 0 ||
-                static_cast<std::size_t>(runtimeLayer.activeStateIndex) >= assetLayer.states.size())
-            {
-                runtimeLayer.activeStateIndex = FindGameplayGraphStateIndex(assetLayer, assetLayer.defaultState);
-                runtimeLayer.enterPending = true;
-                runtimeLayer.stateTime = 0.0f;
-            }
-            if (runtimeLayer.activeStateIndex < 0)
-            {
-                return;
-            }
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::CombatRequests",
+                .reads = GameplayAccess::CharacterCommand,
+                .writes = GameplayAccess::Action,
+                .entityGrain = kEntityGrain,
+                .run = [](const GameplaySystemContext& sys)
+                {
+                    sys.ForEachEntity([&](const EntityHandle entity) { UpdateGameplayCombatRequestForEntity(sys.world, entity); });
+                }
+            });
 
-            const GameplayGraphStateDesc* state = &assetLayer.states[static_cast<std::size_t>(runtimeLayer.activeStateIndex)];
-            if (runtimeLayer.enterPending)
-            {
-                ExecuteGraphTasks_(entity, graph, *state, state->onEnter);
-                runtimeLayer.enterPending = false;
-            }
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::InteractionRequests",
+                .reads = GameplayAccess::CharacterCommand,
+                .writes = GameplayAccess::Action,
+                .entityGrain = kEntityGrain,
+                .run = [](const GameplaySystemContext& sys)
+                {
+                    sys.ForEachEntity([&](const EntityHandle entity) { UpdateGameplayInteractionRequestForEntity(sys.world, entity); });
+                }
+            });
 
-            ExecuteGraphTasks_(entity, graph, *state, state->onUpdate);
+            // graphInstances_ is only looked up here, never resized.
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::Graphs",
+                .reads = GameplayAccess::None,
+                .writes = GameplayAccess::Action | GameplayAccess::RuntimeState,
+                .entityGrain = kEntityGrain,
+                .run = [this](const GameplaySystemContext& sys)
+                {
+                    sys.ForEachEntity([&](const EntityHandle entity) { ExecuteGameplayGraphForEntity_(entity, sys.update); });
+                }
+            });
 
-            for (const GameplayGraphTransitionDesc& transition : state->transitions)
-            {
-                if (!EvaluateGraphTransition_(graph, transition))
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::CharacterMovement",
+                .reads = GameplayAccess::CharacterCommand | GameplayAccess::Action,
+                .writes = GameplayAccess::Transform | GameplayAccess::CharacterMotor | GameplayAccess::CharacterMovementState,
+                .entityGrain = kEntityGrain,
+                .run = [](const GameplaySystemContext& sys)
                 {
-                    continue;
+                    sys.ForEachEntity([&](const EntityHandle entity)
+                        {
+                            UpdateGameplayCharacterMovementForEntity(sys.world, entity, sys.update.deltaSeconds);
+                        });
                 }
+            });
 
-                ExecuteGraphTasks_(entity, graph, *state, state->onExit);
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::Locomotion",
+                .reads = GameplayAccess::Transform | GameplayAccess::CharacterMotor | GameplayAccess::CharacterCommand,
+                .writes = GameplayAccess::CharacterMovementState | GameplayAccess::Locomotion,
+                .entityGrain = kEntityGrain,
+                .run = [](const GameplaySystemContext& sys)
+                {
+                    sys.ForEachEntity([&](const EntityHandle entity) { UpdateGameplayCharacterLocomotionForEntity(sys.world, entity); });
+                }
+            });
 
-                runtimeLayer.previousStateIndex = runtimeLayer.activeStateIndex;
-                runtimeLayer.activeStateIndex = FindGameplayGraphStateIndex(assetLayer, transition.toState);
-                runtimeLayer.stateTime = 0.0f;
-                runtimeLayer.enterPending = true;
+            // One batch into the level's incremental transform update; it fans out on its own.
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::SceneSync",
+                .reads = GameplayAccess::Transform | GameplayAccess::NodeLink,
+                .writes = GameplayAccess::LevelRuntime,
+                .run = [this](const GameplaySystemContext& sys)
+                {
+                    if (recordingTicks_)
+                    {
+                        RecordGameplayTickTransforms(sys.world, sys.update, interpolation_);
+                    }
+                    else
+                    {
+                        SyncGameplayTransformsToRuntime(sys.world, sys.update, sceneSyncScratch_);
+                    }
+                }
+            });
 
-                if (runtimeLayer.activeStateIndex >= 0 &&
-                    static_cast<std::size_t>(runtimeLayer.activeStateIndex) < assetLayer.states.size())
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::FollowCameraLate",
+                .reads = GameplayAccess::Transform,
+                .writes = GameplayAccess::FollowCamera | GameplayAccess::SceneCamera,
+                .run = [this](const GameplaySystemContext& sys)
                 {
-                    const GameplayGraphStateDesc& newState = assetLayer.states[static_cast<std::size_t>(runtimeLayer.activeStateIndex)];
-                    ExecuteGraphTasks_(entity, graph, newState, newState.onEnter);
-                    runtimeLayer.enterPending = false;
+                    if (sys.update.scene != nullptr)
+                    {
+                        followCameraController_.Update(sys.world, controlledEntity_, sys.update);
+                    }
                 }
-                return;
-            }
+            });
 
-            runtimeLayer.stateTime += std::max(ctx.deltaSeconds, 0.0f);
+            // Every entity drives the controller of its own skinned draw.
+            preAnimationSystems_.AddSystem(GameplaySystemDesc{
+                .name = "Gameplay::PushToAnimation",
+                .reads = GameplayAccess::AnimationLink | GameplayAccess::Locomotion,
+                .writes = GameplayAccess::Action | GameplayAccess::LevelRuntime,
+                .entityGrain = kEntityGrain,
+                .run = [](const GameplaySystemContext& sys)
+                {
+                    if (sys.update.levelInstance == nullptr || sys.update.scene == nullptr)
+                    {
+                        return;
+                    }
+                    sys.ForEachEntity([&](const EntityHandle entity) { PushGameplayStateToAnimationForEntity(sys.world, entity, sys.update); });
+                }
+            });
         }
 
-        void ExecuteGraphTasks_(
-            const EntityHandle entity,
-            GameplayGraphInstance& graph,
-            const GameplayGraphStateDesc& state,
-            const std::vector<GameplayGraphTaskDesc>& tasks)
+        void ExecuteGameplayGraphForEntity_(const EntityHandle entity, const GameplayUpdateContext& ctx)
         {
-            for (const GameplayGraphTaskDesc& task : tasks)
+            auto it = graphInstances_.find(entity);
+            if (it == graphInstances_.end())
             {
-                const std::string taskName = CanonicalizeGameplayGraphToken(task.name);
-                if (taskName == "beginactionstate")
+                return;
+            }
+
+            GameplayGraphInstance& graph = it->second;
+            SyncActionStateToGraphParameters_(entity, graph);
+
+            const GameplayGraphProgram& program = *graph.program;
+            auto RunTask = [&](const GameplayGraphTaskOp task)
                 {
-                    BeginActionState_(entity, graph);
-                }
-                [[maybe_unused]] const auto& unusedState = state;
+                    if (task == GameplayGraphTaskOp::BeginActionState)
+                    {
+                        BeginActionState_(entity, graph);
+                    }
+                };
+            for (std::size_t layerIndex = 0; layerIndex < graph.layers.size() && layerIndex < program.layers.size(); ++layerIndex)
+            {
+                TickGameplayGraphLayer(program, layerIndex, graph.layers[layerIndex], graph.slots, ctx.deltaSeconds, RunTask);
             }
+
+            SyncActionStateToGraphParameters_(entity, graph);
         }
 
         void BeginActionState_(const EntityHandle entity, GameplayGraphInstance& graph)
@@ -502,10 +630,7 @@ export namespace rendern
                 action->current = action->requested;
             }
 
-            SetGameplayGraphBool(graph.parameters, "hasActionRequest", true);
-            SetGameplayGraphBool(graph.parameters, "actionBusy", action->busy);
-            SetGameplayGraphInt(graph.parameters, "requestedActionKind", static_cast<int>(action->requested));
-            SetGameplayGraphInt(graph.parameters, "currentAction", static_cast<int>(action->current));
+            WriteActionGraphParameters_(graph, true, action->busy, action->requested, action->current);
         }
 
         void ResetSimulationState_()
@@ -567,6 +692,7 @@ export namespace rendern
         {
             recentNotifyEvents_.clear();
             recentGameplayEvents_.clear();
+            interpolation_.Reset();
 
             for (const EntityHandle entity : nodeBoundEntities_)
             {
@@ -574,6 +700,9 @@ export namespace rendern
                 {
                     followCamera->initialized = false;
                 }
+
+                // The editor may have moved the nodes: the first synced frame puts them back.
+                world_.MarkTransformChanged(entity);
             }
 
             if (ctx.mode == GameplayRuntimeMode::Editor)
@@ -586,6 +715,14 @@ export namespace rendern
             }
         }
 
+        void ResetFixedStep_()
+        {
+            fixedStep_.Reset();
+            pendingInput_ = {};
+            interpolation_.Reset();
+            hasTickCamera_ = false;
+        }
+
         void EnsureBootstrapEntity_(const GameplayUpdateContext& ctx)
         {
             if (controlledEntity_ != kNullEntity && world_.IsEntityValid(controlledEntity_))
@@ -613,9 +750,29 @@ export namespace rendern
         std::vector<EntityHandle> nodeBoundEntities_{};
         std::unordered_map<EntityHandle, GameplayGraphInstance> graphInstances_{};
         GameplayGraphAsset defaultGraphAsset_{};
+        GameplayGraphProgram defaultGraphProgram_{};
+        struct ActionGraphSlots
+        {
+            int hasActionRequest{ -1 };
+            int actionBusy{ -1 };
+            int requestedActionKind{ -1 };
+            int currentAction{ -1 };
+        } actionSlots_{};
         GameplayRuntimeMode lastMode_{ GameplayRuntimeMode::Editor };
         std::vector<GameplayAnimationNotifyRecord> recentNotifyEvents_{};
         std::vector<GameplayEventRecord> recentGameplayEvents_{};
         GameplayFollowCameraController followCameraController_{};
+        GameplaySystemScheduler preAnimationSystems_{};
+        GameplaySceneSyncScratch sceneSyncScratch_{};
+
+        // Fixed-step simulation (SetFixedStep).
+        FixedStepScheduler fixedStep_{};
+        bool fixedStepEnabled_{ false };
+        bool recordingTicks_{ false };
+        InputState pendingInput_{};
+        GameplayTransformInterpolation interpolation_{};
+        Camera previousTickCamera_{};
+        Camera tickCamera_{};
+        bool hasTickCamera_{ false };
     };
 }
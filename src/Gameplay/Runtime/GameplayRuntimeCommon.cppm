@@ -13,6 +13,7 @@ import :input;
 import :level;
 import :scene;
 import :animation_controller;
+import :job_system;
 
 export namespace rendern
 {
@@ -51,6 +52,9 @@ export namespace rendern
         LevelAsset* levelAsset{ nullptr };
         LevelInstance* levelInstance{ nullptr };
         Scene* scene{ nullptr };
+
+        // Gameplay systems spread over it (GameplaySystemScheduler); null runs them inline.
+        jobs::Scheduler* scheduler{ nullptr };
     };
 
     struct GameplayAxisKeyBinding
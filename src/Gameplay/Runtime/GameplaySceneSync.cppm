@@ -1,5 +1,9 @@
 module;
 
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <unordered_map>
 #include <vector>
 
 export module core:gameplay_scene_sync;
@@ -12,10 +16,21 @@ import :scene;
 
 export namespace rendern
 {
+    // Kept by the caller so the per-frame batch reuses its storage.
+    struct GameplaySceneSyncScratch
+    {
+        std::vector<EntityHandle> changedEntities{};
+        std::vector<int> dirtyNodes{};
+    };
+
+    // Visits only the entities whose transform changed since the last sync (GameplayWorld change
+    // tracking), writes their level nodes, and hands the moved nodes to the level as one batch:
+    // one incremental world update, which pushes just those nodes to the scene draw items.
+    // Outside Game mode the changes stay queued.
     inline void SyncGameplayTransformsToRuntime(
         GameplayWorld& world,
-        const std::vector<EntityHandle>& entities,
-        const GameplayUpdateContext& ctx)
+        const GameplayUpdateContext& ctx,
+        GameplaySceneSyncScratch& scratch)
     {
         if (ctx.mode != GameplayRuntimeMode::Game ||
             ctx.levelAsset == nullptr || ctx.levelInstance == nullptr || ctx.scene == nullptr)
@@ -23,8 +38,11 @@ export namespace rendern
             return;
         }
 
-        bool anyTransformChanged = false;
-        for (const EntityHandle entity : entities)
+        scratch.changedEntities.clear();
+        scratch.dirtyNodes.clear();
+        world.ConsumeChangedTransforms(scratch.changedEntities);
+
+        for (const EntityHandle entity : scratch.changedEntities)
         {
             const GameplayTransformComponent* transform = world.TryGetTransform(entity);
             const GameplayNodeLinkComponent* nodeLink = world.TryGetNodeLink(entity);
@@ -43,29 +61,173 @@ export namespace rendern
                 continue;
             }
 
-            const Transform desiredTransform{
-                .position = transform->position,
-                .rotationDegrees = transform->rotationDegrees,
-                .scale = transform->scale
-            };
+            if (mathUtils::NearlyEqualVec3_(node.transform.position, transform->position) &&
+                mathUtils::NearlyEqualVec3_(node.transform.rotationDegrees, transform->rotationDegrees) &&
+                mathUtils::NearlyEqualVec3_(node.transform.scale, transform->scale))
+            {
+                continue;
+            }
+
+            node.transform.position = transform->position;
+            node.transform.rotationDegrees = transform->rotationDegrees;
+            node.transform.scale = transform->scale;
+            scratch.dirtyNodes.push_back(nodeLink->nodeIndex);
+        }
+
+        if (!scratch.dirtyNodes.empty())
+        {
+            ctx.levelInstance->MarkNodeTransformsDirty(scratch.dirtyNodes);
+            ctx.levelInstance->SyncTransformsIfDirty(*ctx.levelAsset, *ctx.scene, ctx.scheduler);
+        }
+    }
+
+    // Fixed-step gameplay: the transforms of the last two ticks for the entities that moved in
+    // them, so frames between ticks draw those entities interpolated.
+    struct GameplayTransformInterpolation
+    {
+        struct Entry
+        {
+            GameplayTransformComponent previous{};
+            GameplayTransformComponent current{};
+            bool movedThisTick{ false };
+        };
+
+        std::unordered_map<EntityHandle, Entry> entries{};
+        // The next recorded tick starts from its own result (after a mode change or teleport).
+        bool snapNextTick{ true };
+        GameplaySceneSyncScratch scratch{};
+
+        void Reset()
+        {
+            entries.clear();
+            snapNextTick = true;
+        }
+    };
+
+    namespace detail
+    {
+        [[nodiscard]] inline float LerpDegrees(const float a, const float b, const float t) noexcept
+        {
+            return a + std::remainder(b - a, 360.0f) * t;
+        }
+
+        [[nodiscard]] inline mathUtils::Vec3 LerpEulerDegrees(const mathUtils::Vec3& a, const mathUtils::Vec3& b, const float t) noexcept
+        {
+            return mathUtils::Vec3(LerpDegrees(a.x, b.x, t), LerpDegrees(a.y, b.y, t), LerpDegrees(a.z, b.z, t));
+        }
+
+        [[nodiscard]] inline bool SameTransform(const GameplayTransformComponent& a, const GameplayTransformComponent& b) noexcept
+        {
+            return mathUtils::NearlyEqualVec3_(a.position, b.position) &&
+                mathUtils::NearlyEqualVec3_(a.rotationDegrees, b.rotationDegrees) &&
+                mathUtils::NearlyEqualVec3_(a.scale, b.scale);
+        }
+    }
+
+    // Runs in place of SyncGameplayTransformsToRuntime at the end of every fixed tick: records where
+    // the changed entities were before the tick (their previous tick, or their level node the first
+    // time) and where they are now. The level is only written by SyncInterpolatedGameplayTransforms.
+    inline void RecordGameplayTickTransforms(
+        GameplayWorld& world,
+        const GameplayUpdateContext& ctx,
+        GameplayTransformInterpolation& interpolation)
+    {
+        if (ctx.mode != GameplayRuntimeMode::Game || ctx.levelAsset == nullptr)
+        {
+            return;
+        }
 
-            if (mathUtils::NearlyEqualVec3_(node.transform.position, desiredTransform.position) &&
-                mathUtils::NearlyEqualVec3_(node.transform.rotationDegrees, desiredTransform.rotationDegrees) &&
-                mathUtils::NearlyEqualVec3_(node.transform.scale, desiredTransform.scale))
+        std::vector<EntityHandle>& changed = interpolation.scratch.changedEntities;
+        changed.clear();
+        world.ConsumeChangedTransforms(changed);
+
+        for (const EntityHandle entity : changed)
+        {
+            const GameplayTransformComponent* transform = world.TryGetTransform(entity);
+            const GameplayNodeLinkComponent* nodeLink = world.TryGetNodeLink(entity);
+            if (transform == nullptr || nodeLink == nullptr ||
+                nodeLink->nodeIndex < 0 || static_cast<std::size_t>(nodeLink->nodeIndex) >= ctx.levelAsset->nodes.size())
             {
                 continue;
             }
 
-            node.transform.position = desiredTransform.position;
-            node.transform.rotationDegrees = desiredTransform.rotationDegrees;
-            node.transform.scale = desiredTransform.scale;
-            anyTransformChanged = true;
+            auto [it, inserted] = interpolation.entries.try_emplace(entity);
+            GameplayTransformInterpolation::Entry& entry = it->second;
+            if (interpolation.snapNextTick)
+            {
+                entry.previous = *transform;
+            }
+            else if (inserted)
+            {
+                const Transform& nodeTransform = ctx.levelAsset->nodes[static_cast<std::size_t>(nodeLink->nodeIndex)].transform;
+                entry.previous = GameplayTransformComponent{ nodeTransform.position, nodeTransform.rotationDegrees, nodeTransform.scale };
+            }
+            else
+            {
+                entry.previous = entry.current;
+            }
+            entry.current = *transform;
+            entry.movedThisTick = true;
+        }
+
+        // Entities that did not move in this tick rest at their last position.
+        for (auto& [entity, entry] : interpolation.entries)
+        {
+            if (!entry.movedThisTick)
+            {
+                entry.previous = entry.current;
+            }
+            entry.movedThisTick = false;
+        }
+        interpolation.snapNextTick = false;
+    }
+
+    // Once per rendered frame after the ticks: writes the recorded entities' level nodes at `alpha`
+    // between their last two ticks as one batch (as SyncGameplayTransformsToRuntime does). Entities
+    // at rest are written one last time and dropped.
+    inline void SyncInterpolatedGameplayTransforms(
+        GameplayWorld& world,
+        const GameplayUpdateContext& ctx,
+        GameplayTransformInterpolation& interpolation,
+        const float alpha)
+    {
+        if (ctx.mode != GameplayRuntimeMode::Game ||
+            ctx.levelAsset == nullptr || ctx.levelInstance == nullptr || ctx.scene == nullptr)
+        {
+            return;
+        }
+
+        std::vector<int>& dirtyNodes = interpolation.scratch.dirtyNodes;
+        dirtyNodes.clear();
+        for (auto it = interpolation.entries.begin(); it != interpolation.entries.end(); )
+        {
+            const GameplayTransformInterpolation::Entry& entry = it->second;
+            const GameplayNodeLinkComponent* nodeLink = world.TryGetNodeLink(it->first);
+            if (nodeLink == nullptr ||
+                nodeLink->nodeIndex < 0 || static_cast<std::size_t>(nodeLink->nodeIndex) >= ctx.levelAsset->nodes.size())
+            {
+                it = interpolation.entries.erase(it);
+                continue;
+            }
+
+            LevelNode& node = ctx.levelAsset->nodes[static_cast<std::size_t>(nodeLink->nodeIndex)];
+            const bool atRest = detail::SameTransform(entry.previous, entry.current);
+            if (node.alive)
+            {
+                const GameplayTransformComponent& from = atRest ? entry.current : entry.previous;
+                node.transform.position = mathUtils::Lerp(from.position, entry.current.position, alpha);
+                node.transform.rotationDegrees = detail::LerpEulerDegrees(from.rotationDegrees, entry.current.rotationDegrees, alpha);
+                node.transform.scale = mathUtils::Lerp(from.scale, entry.current.scale, alpha);
+                dirtyNodes.push_back(nodeLink->nodeIndex);
+            }
+
+            it = atRest ? interpolation.entries.erase(it) : std::next(it);
         }
 
-        if (anyTransformChanged)
+        if (!dirtyNodes.empty())
         {
-            ctx.levelInstance->MarkTransformsDirty();
-            ctx.levelInstance->SyncTransformsIfDirty(*ctx.levelAsset, *ctx.scene);
+            ctx.levelInstance->MarkNodeTransformsDirty(dirtyNodes);
+            ctx.levelInstance->SyncTransformsIfDirty(*ctx.levelAsset, *ctx.scene, ctx.scheduler);
         }
     }
 }
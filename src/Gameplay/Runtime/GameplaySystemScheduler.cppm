@@ -0,0 +1,220 @@
+module;
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+export module core:gameplay_system_scheduler;
+
+import :gameplay;
+import :gameplay_runtime_common;
+import :job_system;
+import :profiler;
+
+export namespace rendern
+{
+    // What a gameplay system touches: one bit per GameplayWorld component type, plus the state
+    // outside the world that systems share.
+    enum class GameplayAccess : std::uint32_t
+    {
+        None = 0,
+        Transform = 1u << 0,
+        NodeLink = 1u << 1,
+        AnimationLink = 1u << 2,
+        PlayerControlled = 1u << 3,
+        InputIntent = 1u << 4,
+        CharacterCommand = 1u << 5,
+        CharacterMotor = 1u << 6,
+        CharacterMovementState = 1u << 7,
+        FollowCamera = 1u << 8,
+        Locomotion = 1u << 9,
+        Action = 1u << 10,
+        AnimationNotifyState = 1u << 11,
+
+        SceneCamera = 1u << 16,
+        // Level nodes, scene draw items and their animation controllers.
+        LevelRuntime = 1u << 17,
+        // GameplayRuntime's graph instances and event records.
+        RuntimeState = 1u << 18,
+
+        All = 0xFFFFFFFFu
+    };
+
+    constexpr GameplayAccess operator|(GameplayAccess a, GameplayAccess b) noexcept
+    {
+        return static_cast<GameplayAccess>(static_cast<std::uint32_t>(a) | static_cast<std::uint32_t>(b));
+    }
+    constexpr GameplayAccess operator&(GameplayAccess a, GameplayAccess b) noexcept
+    {
+        return static_cast<GameplayAccess>(static_cast<std::uint32_t>(a) & static_cast<std::uint32_t>(b));
+    }
+    constexpr GameplayAccess& operator|=(GameplayAccess& a, GameplayAccess b) noexcept
+    {
+        a = a | b;
+        return a;
+    }
+    constexpr bool HasFlag(GameplayAccess a, GameplayAccess b) noexcept
+    {
+        return static_cast<std::uint32_t>(a & b) != 0;
+    }
+
+    struct GameplaySystemContext
+    {
+        GameplayWorld& world;
+        const GameplayUpdateContext& update;
+        std::span<const EntityHandle> entities;
+        jobs::Scheduler* scheduler{ nullptr };
+        std::size_t entityGrain{ 0 };
+
+        // body(entity) for every entity, in chunks of entityGrain spread over the job system.
+        // The body may only touch what the system declared, and only for that entity.
+        template <class Body>
+        void ForEachEntity(Body&& body) const
+        {
+            const std::size_t grain = (entityGrain == 0) ? entities.size() : entityGrain;
+            jobs::ParallelFor(scheduler, entities.size(), grain, [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        body(entities[i]);
+                    }
+                });
+        }
+    };
+
+    struct GameplaySystemDesc
+    {
+        const char* name{ "GameplaySystem" }; // profiler zone, must outlive the scheduler
+        GameplayAccess reads{ GameplayAccess::None };
+        GameplayAccess writes{ GameplayAccess::None };
+
+        // Entities per ForEachEntity chunk; 0 keeps the whole list on one thread.
+        std::size_t entityGrain{ 0 };
+
+        // Must not throw (it may run inside a job).
+        std::function<void(const GameplaySystemContext&)> run{};
+    };
+
+    // Runs gameplay systems in registration order, except that systems whose declared accesses
+    // do not conflict (no write shared with another read or write) form a wave and run
+    // concurrently on the job system. A system always sees the writes of every earlier system it
+    // conflicts with, so the result matches a serial run.
+    class GameplaySystemScheduler
+    {
+    public:
+        void AddSystem(GameplaySystemDesc desc)
+        {
+            systems_.push_back(std::move(desc));
+            wavesDirty_ = true;
+        }
+
+        void Clear()
+        {
+            systems_.clear();
+            waves_.clear();
+            wavesDirty_ = false;
+        }
+
+        [[nodiscard]] std::size_t GetSystemCount() const noexcept
+        {
+            return systems_.size();
+        }
+
+        // System indices per wave, in execution order.
+        [[nodiscard]] const std::vector<std::vector<std::uint32_t>>& GetWaves()
+        {
+            BuildWaves_();
+            return waves_;
+        }
+
+        // Without ctx.scheduler every system and chunk runs inline on the calling thread.
+        void Run(GameplayWorld& world, std::span<const EntityHandle> entities, const GameplayUpdateContext& ctx)
+        {
+            BuildWaves_();
+
+            jobs::Scheduler* scheduler = ctx.scheduler;
+            auto runSystem = [&](const GameplaySystemDesc& system)
+                {
+                    profiling::ScopedZone zone{ system.name };
+                    const GameplaySystemContext systemCtx{
+                        .world = world,
+                        .update = ctx,
+                        .entities = entities,
+                        .scheduler = scheduler,
+                        .entityGrain = system.entityGrain
+                    };
+                    system.run(systemCtx);
+                };
+
+            for (const std::vector<std::uint32_t>& wave : waves_)
+            {
+                if (scheduler == nullptr || wave.size() == 1)
+                {
+                    for (const std::uint32_t index : wave)
+                    {
+                        runSystem(systems_[index]);
+                    }
+                    continue;
+                }
+
+                // Same shape as jobs::ParallelFor: the calling thread runs the first system, then helps.
+                const jobs::JobOptions options{ jobs::JobPriority::Critical };
+                const jobs::JobHandle root = scheduler->CreateJob([] {}, {}, options);
+                for (std::size_t i = 1; i < wave.size(); ++i)
+                {
+                    const GameplaySystemDesc* system = &systems_[wave[i]];
+                    scheduler->Schedule([&runSystem, system] { runSystem(*system); }, root, options);
+                }
+                scheduler->Run(root);
+
+                runSystem(systems_[wave.front()]);
+                scheduler->Wait(root);
+            }
+        }
+
+    private:
+        [[nodiscard]] static bool Conflicts_(const GameplaySystemDesc& a, const GameplaySystemDesc& b) noexcept
+        {
+            return HasFlag(a.writes, b.reads | b.writes) || HasFlag(b.writes, a.reads);
+        }
+
+        // Each system lands one wave after the latest earlier system it conflicts with.
+        void BuildWaves_()
+        {
+            if (!wavesDirty_)
+            {
+                return;
+            }
+
+            waves_.clear();
+            std::vector<std::uint32_t> waveOf(systems_.size(), 0);
+            for (std::size_t i = 0; i < systems_.size(); ++i)
+            {
+                std::uint32_t wave = 0;
+                for (std::size_t j = 0; j < i; ++j)
+                {
+                    if (Conflicts_(systems_[j], systems_[i]))
+                    {
+                        wave = std::max(wave, waveOf[j] + 1u);
+                    }
+                }
+
+                waveOf[i] = wave;
+                if (waves_.size() <= wave)
+                {
+                    waves_.resize(wave + 1u);
+                }
+                waves_[wave].push_back(static_cast<std::uint32_t>(i));
+            }
+            wavesDirty_ = false;
+        }
+
+        std::vector<GameplaySystemDesc> systems_{};
+        std::vector<std::vector<std::uint32_t>> waves_{};
+        bool wavesDirty_{ false };
+    };
+}
@@ -36,6 +36,12 @@ export namespace rendern
         std::array<std::uint8_t, 256> keyPressed{};
         std::array<std::uint8_t, 256> keyReleased{};
 
+        // Share of the sampled interval each key was held, from the event timestamps (raw input path).
+        // Only meaningful while sampleSeconds > 0; read it through KeyDownFraction.
+        std::array<float, 256> keyDownFraction{};
+        // Length of the interval the events covered (0: polled, no timing).
+        float sampleSeconds{ 0.0f };
+
         MouseInput mouse{};
 
         bool KeyDown(int vk) const noexcept
@@ -52,5 +58,16 @@ export namespace rendern
         {
             return (vk >= 0 && vk < 256) ? (keyReleased[static_cast<std::uint8_t>(vk)] != 0) : false;
         }
+
+        // Untimed states (polled, or filled by hand) report the level.
+        float KeyDownFraction(int vk) const noexcept
+        {
+            if (vk < 0 || vk >= 256)
+            {
+                return 0.0f;
+            }
+            const auto idx = static_cast<std::uint8_t>(vk);
+            return (sampleSeconds > 0.0f) ? keyDownFraction[idx] : static_cast<float>(keyDown[idx] != 0);
+        }
     };
 }
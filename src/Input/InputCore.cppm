@@ -1,12 +1,16 @@
 module;
 
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
+#include <span>
 
 export module core:input_core;
 
 import :input;
+import :input_events;
 
 export namespace rendern
 {
@@ -50,14 +54,111 @@ export namespace rendern
                 state_.keyDown[idx] = static_cast<std::uint8_t>(down);
                 state_.keyPressed[idx] = static_cast<std::uint8_t>(down && !wasDown);
                 state_.keyReleased[idx] = static_cast<std::uint8_t>(!down && wasDown);
+                state_.keyDownFraction[idx] = down ? 1.0f : 0.0f;
 
                 prevKeyDown_[idx] = state_.keyDown[idx];
             }
+            state_.sampleSeconds = 0.0f;
 
             // Mouse: carry deltas as-is (platform decides when look is active).
             state_.mouse = mouse;
+            state_.mouse.wheelSteps = TakeWheelSteps_(wheelDeltaUnits);
+        }
+
+        // Event path (raw input): replays the timestamped events of [intervalBegin, intervalEnd], oldest
+        // first, on top of the key states of the previous frame. A key pressed and released within the
+        // frame reports both edges; keyDownFraction is the share of the interval each key was held.
+        // Mouse motion becomes the look delta only while lookActive (the platform owns look mode).
+        void NewFrameFromEvents(
+            InputCapture capture,
+            bool hasFocus,
+            std::span<const InputEvent> events,
+            bool lookActive,
+            InputClock::time_point intervalBegin,
+            InputClock::time_point intervalEnd)
+        {
+            constexpr std::uint8_t kVkRButton = 0x02;
+            constexpr std::uint8_t kVkShift = 0x10;
+
+            intervalEnd = std::max(intervalEnd, intervalBegin);
+            const auto Clamp = [intervalBegin, intervalEnd](InputClock::time_point t) noexcept
+                {
+                    return std::clamp(t, intervalBegin, intervalEnd);
+                };
+
+            state_.capture = capture;
+            state_.hasFocus = hasFocus;
+            state_.keyDown = prevKeyDown_;
+            state_.keyPressed = {};
+            state_.keyReleased = {};
+            state_.mouse = {};
+
+            std::array<InputClock::time_point, 256> downSince{};
+            std::array<InputClock::duration, 256> held{};
+            downSince.fill(intervalBegin);
+            held.fill(InputClock::duration::zero());
 
-            // Wheel: convert delta units to integer steps (positive/negative), keep remainder.
+            int wheelDeltaUnits = 0;
+            for (const InputEvent& event : events)
+            {
+                const std::uint8_t key = event.key;
+                switch (event.kind)
+                {
+                case InputEventKind::KeyDown:
+                    if (state_.keyDown[key] == 0)
+                    {
+                        state_.keyDown[key] = 1;
+                        state_.keyPressed[key] = 1;
+                        downSince[key] = Clamp(event.time);
+                    }
+                    break;
+
+                case InputEventKind::KeyUp:
+                    if (state_.keyDown[key] != 0)
+                    {
+                        state_.keyDown[key] = 0;
+                        state_.keyReleased[key] = 1;
+                        held[key] += Clamp(event.time) - downSince[key];
+                    }
+                    break;
+
+                case InputEventKind::MouseMove:
+                    if (lookActive)
+                    {
+                        state_.mouse.lookDx += event.dx;
+                        state_.mouse.lookDy += event.dy;
+                    }
+                    break;
+
+                case InputEventKind::MouseWheel:
+                    wheelDeltaUnits += event.dx;
+                    break;
+                }
+            }
+
+            const InputClock::duration interval = intervalEnd - intervalBegin;
+            state_.sampleSeconds = std::chrono::duration<float>(interval).count();
+            for (std::size_t i = 0; i < 256; ++i)
+            {
+                if (state_.keyDown[i] != 0)
+                {
+                    held[i] += intervalEnd - downSince[i];
+                }
+                state_.keyDownFraction[i] = (interval > InputClock::duration::zero())
+                    ? std::clamp(std::chrono::duration<float>(held[i]).count() / state_.sampleSeconds, 0.0f, 1.0f)
+                    : static_cast<float>(state_.keyDown[i]);
+            }
+            prevKeyDown_ = state_.keyDown;
+
+            state_.shiftDown = state_.keyDown[kVkShift] != 0;
+            state_.mouse.rmbDown = state_.keyDown[kVkRButton] != 0;
+            state_.mouse.wheelSteps = TakeWheelSteps_(wheelDeltaUnits);
+        }
+
+    private:
+        // Wheel: convert delta units to integer steps (positive/negative), keep remainder.
+        int TakeWheelSteps_(int wheelDeltaUnits) noexcept
+        {
             constexpr int kWheelDelta = 120;
             wheelRemainderUnits_ += wheelDeltaUnits;
 
@@ -67,13 +168,59 @@ export namespace rendern
                 steps = wheelRemainderUnits_ / kWheelDelta;
                 wheelRemainderUnits_ -= steps * kWheelDelta;
             }
-
-            state_.mouse.wheelSteps = steps;
+            return steps;
         }
 
-    private:
         InputState state_{};
         std::array<std::uint8_t, 256> prevKeyDown_{};
         int wheelRemainderUnits_{ 0 };
     };
+
+    // Folds the next frame's input into `into` for a consumer that steps less often than frames
+    // (fixed-step gameplay): levels come from `next`, edges are kept until consumed, mouse deltas add up.
+    inline void AccumulateInputFrame(InputState& into, const InputState& next) noexcept
+    {
+        into.capture = next.capture;
+        into.hasFocus = next.hasFocus;
+        into.shiftDown = next.shiftDown;
+        into.keyDown = next.keyDown;
+        for (std::size_t i = 0; i < into.keyPressed.size(); ++i)
+        {
+            into.keyPressed[i] = static_cast<std::uint8_t>(into.keyPressed[i] | next.keyPressed[i]);
+            into.keyReleased[i] = static_cast<std::uint8_t>(into.keyReleased[i] | next.keyReleased[i]);
+        }
+
+        // Held fractions average over the frames by their length; untimed (polled) frames are levels.
+        const float totalSeconds = into.sampleSeconds + next.sampleSeconds;
+        if (totalSeconds > 0.0f && next.sampleSeconds > 0.0f)
+        {
+            for (std::size_t i = 0; i < into.keyDownFraction.size(); ++i)
+            {
+                into.keyDownFraction[i] =
+                    (into.keyDownFraction[i] * into.sampleSeconds + next.keyDownFraction[i] * next.sampleSeconds) / totalSeconds;
+            }
+            into.sampleSeconds = totalSeconds;
+        }
+        else
+        {
+            into.keyDownFraction = next.keyDownFraction;
+            into.sampleSeconds = 0.0f;
+        }
+
+        into.mouse.lookDx += next.mouse.lookDx;
+        into.mouse.lookDy += next.mouse.lookDy;
+        into.mouse.wheelSteps += next.mouse.wheelSteps;
+        into.mouse.rmbDown = next.mouse.rmbDown;
+    }
+
+    // Drops what AccumulateInputFrame collected once a step consumed it; levels stay.
+    inline void ClearInputEdges(InputState& state) noexcept
+    {
+        state.keyPressed = {};
+        state.keyReleased = {};
+        state.sampleSeconds = 0.0f;
+        state.mouse.lookDx = 0;
+        state.mouse.lookDy = 0;
+        state.mouse.wheelSteps = 0;
+    }
 }
@@ -0,0 +1,84 @@
+module;
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+export module core:input_events;
+
+export namespace rendern
+{
+    using InputClock = std::chrono::steady_clock;
+
+    enum class InputEventKind : std::uint8_t
+    {
+        KeyDown,    // key: virtual key (mouse buttons use VK_LBUTTON / VK_RBUTTON / VK_MBUTTON)
+        KeyUp,
+        MouseMove,  // dx, dy: relative motion in mouse counts
+        MouseWheel  // dx: wheel delta units (120 per notch)
+    };
+
+    // One input event as the platform received it, stamped when it was read (not when the frame
+    // sampled it), so consumers can tell where inside the frame it happened.
+    struct InputEvent
+    {
+        InputClock::time_point time{};
+        InputEventKind kind{ InputEventKind::KeyDown };
+        std::uint8_t key{ 0 };
+        std::int32_t dx{ 0 };
+        std::int32_t dy{ 0 };
+    };
+
+    // Fixed-capacity lock-free ring between one producer (the input thread) and one consumer (the
+    // frame). Neither side ever waits or allocates; a full ring drops the newest events and counts them.
+    class InputEventRing
+    {
+    public:
+        static constexpr std::size_t kCapacity = 4096; // power of two
+
+        InputEventRing() = default;
+        InputEventRing(const InputEventRing&) = delete;
+        InputEventRing& operator=(const InputEventRing&) = delete;
+
+        // Producer only.
+        bool Push(const InputEvent& event) noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (head - tail_.load(std::memory_order_acquire) >= kCapacity)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            events_[head & (kCapacity - 1)] = event;
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only. Appends everything published so far to `out`, oldest first; returns the count.
+        std::size_t Drain(std::vector<InputEvent>& out)
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            for (std::size_t i = tail; i != head; ++i)
+            {
+                out.push_back(events_[i & (kCapacity - 1)]);
+            }
+            tail_.store(head, std::memory_order_release);
+            return head - tail;
+        }
+
+        [[nodiscard]] std::uint64_t DroppedCount() const noexcept
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::array<InputEvent, kCapacity> events_{};
+        alignas(64) std::atomic<std::size_t> head_{ 0 }; // written by the producer
+        alignas(64) std::atomic<std::size_t> tail_{ 0 }; // written by the consumer
+        std::atomic<std::uint64_t> dropped_{ 0 };
+    };
+}
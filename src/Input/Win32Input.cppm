@@ -9,20 +9,40 @@ module;
   #include <windowsx.h> // GET_WHEEL_DELTA_WPARAM
 #endif
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
 
 export module core:win32_input;
 
 import :input;
 import :input_core;
+import :input_events;
 
 export namespace rendern
 {
+    // Two ways to sample input. Polled (default): GetAsyncKeyState and the cursor position at the start
+    // of the frame, so a key's timing is only known to the frame it was seen in. Raw input thread
+    // (StartRawInputThread): a dedicated thread receives WM_INPUT for keyboard and mouse as soon as it
+    // arrives, stamps each event and pushes it into a lock-free ring; NewFrame replays the ring through
+    // InputCore::NewFrameFromEvents, which keeps the sub-frame timing (keyDownFraction) and edges of
+    // keys tapped within one frame.
     class Win32Input
     {
     public:
         Win32Input() = default;
+        Win32Input(const Win32Input&) = delete;
+        Win32Input& operator=(const Win32Input&) = delete;
+
+        ~Win32Input()
+        {
+            StopRawInputThread();
+        }
 
         void SetCaptureMode(InputCapture cap) noexcept
         {
@@ -38,7 +58,11 @@ export namespace rendern
             switch (msg)
             {
             case WM_MOUSEWHEEL:
-                wheelDeltaUnits_ += GET_WHEEL_DELTA_WPARAM(wParam);
+                // The raw input thread reports the wheel itself.
+                if (!RawInputActive())
+                {
+                    wheelDeltaUnits_ += GET_WHEEL_DELTA_WPARAM(wParam);
+                }
                 break;
 
             case WM_KILLFOCUS:
@@ -56,9 +80,63 @@ export namespace rendern
             }
         }
 
+        // Registers keyboard and mouse raw input on a thread of its own (message-only window, input
+        // sink so key releases are seen while unfocused too). false: raw input is unavailable and
+        // NewFrame keeps polling.
+        bool StartRawInputThread()
+        {
+            if (rawThread_.joinable())
+            {
+                return true;
+            }
+
+            rawRing_ = std::make_unique<InputEventRing>();
+            frameEvents_.reserve(InputEventRing::kCapacity);
+            lastSampleTime_ = {};
+
+            std::promise<bool> started;
+            std::future<bool> startedFuture = started.get_future();
+            rawThread_ = std::thread([this, started = std::move(started)]() mutable { RawInputThreadMain_(started); });
+            if (!startedFuture.get())
+            {
+                rawThread_.join();
+                rawRing_.reset();
+                return false;
+            }
+            return true;
+        }
+
+        void StopRawInputThread()
+        {
+            if (!rawThread_.joinable())
+            {
+                return;
+            }
+            PostThreadMessageW(rawThreadId_.load(std::memory_order_acquire), WM_QUIT, 0, 0);
+            rawThread_.join();
+            rawRing_.reset();
+        }
+
+        [[nodiscard]] bool RawInputActive() const noexcept
+        {
+            return rawThread_.joinable();
+        }
+
+        // Events lost to a full ring (frames longer than the ring covers).
+        [[nodiscard]] std::uint64_t DroppedRawInputEvents() const noexcept
+        {
+            return rawRing_ ? rawRing_->DroppedCount() : 0u;
+        }
+
         // Poll keyboard/mouse and update internal InputState for this frame.
         void NewFrame(HWND hwnd)
         {
+            if (RawInputActive())
+            {
+                NewFrameFromRawInput_(hwnd);
+                return;
+            }
+
             MouseInput mouse{};
 
             // Focus check
@@ -112,10 +190,209 @@ export namespace rendern
         // Stubs for non-Windows builds.
         void OnWndProc(void*, unsigned, std::uintptr_t, std::intptr_t) {}
         void NewFrame(void*) {}
+        bool StartRawInputThread() { return false; }
+        void StopRawInputThread() {}
+        [[nodiscard]] bool RawInputActive() const noexcept { return false; }
+        [[nodiscard]] std::uint64_t DroppedRawInputEvents() const noexcept { return 0u; }
 #endif
 
     private:
 #if defined(_WIN32)
+        void NewFrameFromRawInput_(HWND hwnd)
+        {
+            frameEvents_.clear();
+            rawRing_->Drain(frameEvents_);
+            // Read after the drain: every drained event is older than the end of the interval.
+            const InputClock::time_point now = InputClock::now();
+            const InputClock::time_point begin = (lastSampleTime_ == InputClock::time_point{}) ? now : lastSampleTime_;
+            lastSampleTime_ = now;
+
+            const bool hasFocus = (GetForegroundWindow() == hwnd);
+            if (!hasFocus)
+            {
+                // Keys keep their state (the sink sees releases), but motion and wheel belong to whatever
+                // window had the focus.
+                std::erase_if(frameEvents_, [](const InputEvent& event)
+                    {
+                        return event.kind == InputEventKind::MouseMove || event.kind == InputEventKind::MouseWheel;
+                    });
+            }
+
+            // Look mode follows RMB as it is at the end of the frame.
+            bool rmbDown = core_.State().KeyDown(VK_RBUTTON);
+            for (const InputEvent& event : frameEvents_)
+            {
+                if (event.key == VK_RBUTTON && (event.kind == InputEventKind::KeyDown || event.kind == InputEventKind::KeyUp))
+                {
+                    rmbDown = event.kind == InputEventKind::KeyDown;
+                }
+            }
+
+            const bool allowMouse = hasFocus && !capture_.captureMouse;
+            if (!allowMouse || (!rmbDown && lookActive_))
+            {
+                ReleaseLook(hwnd);
+            }
+            else if (rmbDown && !lookActive_)
+            {
+                BeginLook(hwnd);
+            }
+            else if (lookActive_)
+            {
+                // Raw motion is read from the device, so re-centring the cursor does not show up in it;
+                // it only keeps the hidden cursor inside the window.
+                CenterCursor(hwnd);
+            }
+
+            core_.NewFrameFromEvents(capture_, hasFocus, frameEvents_, lookActive_, begin, now);
+        }
+
+        void RawInputThreadMain_(std::promise<bool>& started)
+        {
+            rawThreadId_.store(GetCurrentThreadId(), std::memory_order_release);
+
+            constexpr wchar_t kSinkClassName[] = L"CoreEngineRawInputSink";
+            WNDCLASSEXW wc{};
+            wc.cbSize = sizeof(wc);
+            wc.lpfnWndProc = DefWindowProcW;
+            wc.hInstance = GetModuleHandleW(nullptr);
+            wc.lpszClassName = kSinkClassName;
+            RegisterClassExW(&wc); // fails harmlessly when a previous thread registered it
+
+            HWND sink = CreateWindowExW(0, kSinkClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr, wc.hInstance, nullptr);
+
+            // Generic desktop page: mouse (2) and keyboard (6). Legacy messages stay on, the window
+            // procedure and ImGui still get WM_KEYDOWN / WM_MOUSEMOVE.
+            std::array<RAWINPUTDEVICE, 2> devices{};
+            devices[0] = RAWINPUTDEVICE{ 0x01, 0x02, RIDEV_INPUTSINK, sink };
+            devices[1] = RAWINPUTDEVICE{ 0x01, 0x06, RIDEV_INPUTSINK, sink };
+            if (sink == nullptr || !RegisterRawInputDevices(devices.data(), static_cast<UINT>(devices.size()), sizeof(RAWINPUTDEVICE)))
+            {
+                if (sink != nullptr)
+                {
+                    DestroyWindow(sink);
+                }
+                started.set_value(false);
+                return;
+            }
+            started.set_value(true);
+
+            // Mouse and keyboard records have a fixed size; 64 per GetRawInputBuffer call.
+            std::array<RAWINPUT, 64> buffer{};
+            bool running = true;
+            while (running)
+            {
+                MsgWaitForMultipleObjects(0, nullptr, FALSE, INFINITE, QS_ALLINPUT);
+
+                // The thread wakes as input arrives, so the read time is the event time give or take the
+                // wake-up latency (RAWINPUT carries no timestamp of its own).
+                for (;;)
+                {
+                    UINT bufferBytes = static_cast<UINT>(sizeof(buffer));
+                    const UINT count = GetRawInputBuffer(buffer.data(), &bufferBytes, sizeof(RAWINPUTHEADER));
+                    if (count == 0 || count == static_cast<UINT>(-1))
+                    {
+                        break;
+                    }
+
+                    const InputClock::time_point now = InputClock::now();
+                    PRAWINPUT raw = buffer.data();
+                    for (UINT i = 0; i < count; ++i)
+                    {
+                        PushRawInput_(*raw, now);
+                        raw = NEXTRAWINPUTBLOCK(raw);
+                    }
+                }
+
+                MSG msg{};
+                while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+                {
+                    if (msg.message == WM_QUIT)
+                    {
+                        running = false;
+                        break;
+                    }
+                    if (msg.message == WM_INPUT)
+                    {
+                        RAWINPUT raw{};
+                        UINT rawBytes = sizeof(raw);
+                        if (GetRawInputData(reinterpret_cast<HRAWINPUT>(msg.lParam), RID_INPUT, &raw, &rawBytes, sizeof(RAWINPUTHEADER)) != static_cast<UINT>(-1))
+                        {
+                            PushRawInput_(raw, InputClock::now());
+                        }
+                    }
+                    DispatchMessageW(&msg);
+                }
+            }
+
+            devices[0] = RAWINPUTDEVICE{ 0x01, 0x02, RIDEV_REMOVE, nullptr };
+            devices[1] = RAWINPUTDEVICE{ 0x01, 0x06, RIDEV_REMOVE, nullptr };
+            RegisterRawInputDevices(devices.data(), static_cast<UINT>(devices.size()), sizeof(RAWINPUTDEVICE));
+            DestroyWindow(sink);
+        }
+
+        // Input thread only (the ring's producer).
+        void PushRawInput_(const RAWINPUT& raw, InputClock::time_point time) noexcept
+        {
+            const auto Push = [this, time](InputEventKind kind, std::uint8_t key, std::int32_t dx, std::int32_t dy) noexcept
+                {
+                    rawRing_->Push(InputEvent{ .time = time, .kind = kind, .key = key, .dx = dx, .dy = dy });
+                };
+
+            if (raw.header.dwType == RIM_TYPEKEYBOARD)
+            {
+                const RAWKEYBOARD& keyboard = raw.data.keyboard;
+                // 0xFF: fake key of escaped sequences.
+                if (keyboard.VKey == 0 || keyboard.VKey >= 0xFF)
+                {
+                    return;
+                }
+                const bool up = (keyboard.Flags & RI_KEY_BREAK) != 0;
+                Push(up ? InputEventKind::KeyUp : InputEventKind::KeyDown, static_cast<std::uint8_t>(keyboard.VKey), 0, 0);
+                return;
+            }
+
+            if (raw.header.dwType != RIM_TYPEMOUSE)
+            {
+                return;
+            }
+
+            const RAWMOUSE& mouse = raw.data.mouse;
+            if ((mouse.usFlags & MOUSE_MOVE_ABSOLUTE) == 0 && (mouse.lLastX != 0 || mouse.lLastY != 0))
+            {
+                Push(InputEventKind::MouseMove, 0, mouse.lLastX, mouse.lLastY);
+            }
+
+            struct ButtonFlags
+            {
+                USHORT down;
+                USHORT up;
+                std::uint8_t vk;
+            };
+            constexpr std::array<ButtonFlags, 5> kButtons{ {
+                { RI_MOUSE_LEFT_BUTTON_DOWN, RI_MOUSE_LEFT_BUTTON_UP, VK_LBUTTON },
+                { RI_MOUSE_RIGHT_BUTTON_DOWN, RI_MOUSE_RIGHT_BUTTON_UP, VK_RBUTTON },
+                { RI_MOUSE_MIDDLE_BUTTON_DOWN, RI_MOUSE_MIDDLE_BUTTON_UP, VK_MBUTTON },
+                { RI_MOUSE_BUTTON_4_DOWN, RI_MOUSE_BUTTON_4_UP, VK_XBUTTON1 },
+                { RI_MOUSE_BUTTON_5_DOWN, RI_MOUSE_BUTTON_5_UP, VK_XBUTTON2 } } };
+            for (const ButtonFlags& button : kButtons)
+            {
+                if ((mouse.usButtonFlags & button.down) != 0)
+                {
+                    Push(InputEventKind::KeyDown, button.vk, 0, 0);
+                }
+                if ((mouse.usButtonFlags & button.up) != 0)
+                {
+                    Push(InputEventKind::KeyUp, button.vk, 0, 0);
+                }
+            }
+
+            if ((mouse.usButtonFlags & RI_MOUSE_WHEEL) != 0)
+            {
+                Push(InputEventKind::MouseWheel, 0, static_cast<SHORT>(mouse.usButtonData), 0);
+            }
+        }
+
         int TakeWheelDeltaUnits_() noexcept
         {
             const int v = wheelDeltaUnits_;
@@ -205,6 +482,12 @@ export namespace rendern
 #if defined(_WIN32)
         int wheelDeltaUnits_{ 0 };
 
+        std::unique_ptr<InputEventRing> rawRing_;
+        std::thread rawThread_;
+        std::atomic<DWORD> rawThreadId_{ 0 };
+        std::vector<InputEvent> frameEvents_;
+        InputClock::time_point lastSampleTime_{};
+
         bool lookActive_{ false };
         bool lastCenterValid_{ false };
         POINT savedCursorPos_{};
@@ -7,9 +7,9 @@ module;
 #include <type_traits>
 #include <cstddef>
 #include <cctype>
+#include <span>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 #include <utility>
 #include <limits>
@@ -39,9 +39,13 @@ export namespace rendern
 		bool triggerValue{ false };
 	};
 
+	// Flat parameter array. Binding a controller fills it in AnimationControllerAsset::parameters order and the
+	// compiled controller addresses it by slot; the name-based setters below look slots up linearly.
 	struct AnimationParameterStore
 	{
-		std::unordered_map<std::string, AnimationParameterValue> values;
+		std::vector<std::string> names;
+		std::vector<AnimationParameterValue> values;
+		std::vector<std::uint8_t> assigned; // 0: the slot only exists because a compiled condition names it
 	};
 
 	enum class AnimationConditionOp : std::uint8_t
@@ -138,6 +142,8 @@ export namespace rendern
 		std::string stateName;
 		std::string clipName;
 		float normalizedTime{ 0.0f };
+		int stateIndex{ -1 };  // AnimationControllerAsset::states
+		int notifyIndex{ -1 }; // AnimationStateDesc::notifies
 	};
 
 	enum class AnimationControllerMode : std::uint8_t
@@ -146,6 +152,51 @@ export namespace rendern
 		StateMachine = 1
 	};
 
+	struct CompiledAnimationCondition
+	{
+		int parameterSlot{ -1 };
+		AnimationConditionOp op{ AnimationConditionOp::IfTrue };
+		AnimationParameterValue value{};
+	};
+
+	struct CompiledAnimationTransition
+	{
+		int toStateIndex{ -1 };
+		bool hasExitTime{ false };
+		bool consumesTriggers{ false };
+		float exitTimeNormalized{ 1.0f };
+		float blendDurationSeconds{ 0.0f };
+		int priority{ 0 };
+		std::uint32_t firstCondition{ 0 };
+		std::uint32_t conditionCount{ 0 };
+	};
+
+	struct CompiledAnimationState
+	{
+		int blendParameterSlot{ -1 };
+		std::uint32_t firstTransition{ 0 }; // into CompiledAnimationController::stateTransitions
+		std::uint32_t transitionCount{ 0 };
+		std::uint32_t firstNotify{ 0 };     // into CompiledAnimationController::notifyBindingOffsets
+	};
+
+	// Bind-time form of an AnimationControllerAsset: states, transition targets, condition parameters and
+	// notify event bindings resolved to indices, so the controller tick does no string work. transitions
+	// follow AnimationControllerAsset::transitions; stateTransitions lists, per state, the ones leaving it
+	// (wildcards included) in asset order.
+	struct CompiledAnimationController
+	{
+		const AnimationControllerAsset* asset{ nullptr };
+		int defaultStateIndex{ -1 };
+		std::vector<CompiledAnimationState> states;
+		std::vector<CompiledAnimationTransition> transitions;
+		std::vector<std::uint32_t> stateTransitions;
+		std::vector<CompiledAnimationCondition> conditions;
+		// Notify n of state s binds eventBindings[notifyBindings[i]] for i in
+		// [notifyBindingOffsets[k], notifyBindingOffsets[k + 1]), k = states[s].firstNotify + n.
+		std::vector<std::uint32_t> notifyBindingOffsets;
+		std::vector<std::uint32_t> notifyBindings;
+	};
+
 	struct AnimationControllerRuntime
 	{
 		AnimationControllerMode mode{ AnimationControllerMode::LegacyClip };
@@ -156,25 +207,22 @@ export namespace rendern
 		const std::vector<std::string>* clipSourceAssetIds{ nullptr };
 
 		std::string controllerAssetId;
-		std::string currentStateName;
-		std::string requestedStateName;
 		const AnimationControllerAsset* stateMachineAsset{ nullptr };
+		CompiledAnimationController compiled{};
 		int currentStateIndex{ -1 };
+		int requestedStateIndex{ -1 };
 		std::vector<int> resolvedStateClipIndices;
 		std::vector<std::vector<int>> resolvedStateBlendClipIndices;
 
 		bool currentStateUsesBlend1D{ false };
-		std::string currentBlendParameterName;
 		float currentBlendParameterValue{ 0.0f };
-		std::string currentBlendPrimaryClipName;
-		std::string currentBlendSecondaryClipName;
+		int blendPrimaryClipIndex{ -1 };
 		AnimatorState blendSecondaryAnimator{};
 		int blendSecondaryClipIndex{ -1 };
 		float blendSecondaryAlpha{ 0.0f };
 
 		bool transitionActive{ false };
 		int transitionSourceStateIndex{ -1 };
-		std::string transitionSourceStateName;
 		float transitionElapsedSeconds{ 0.0f };
 		float transitionDurationSeconds{ 0.0f };
 		AnimatorState transitionSourceAnimator{};
@@ -188,13 +236,22 @@ export namespace rendern
 		float playRate{ 1.0f };
 		bool paused{ false };
 		bool forceBindPose{ false };
+		// Animation LOD: evaluate the current state's primary clip only (no Blend1D secondary, no
+		// transition source pose; transitions still run their clock and end on time).
+		bool lodPrimaryLayerOnly{ false };
 		mathUtils::Vec3 lastAppliedRootMotionDelta{ 0.0f, 0.0f, 0.0f };
+		// In-place motion bone resolved for this skeleton/clip pair (rootMotionBoneName is read on a miss).
+		const Skeleton* inPlaceMotionSkeleton{ nullptr };
+		const AnimationClip* inPlaceMotionClip{ nullptr };
+		std::size_t inPlaceMotionBoneIndex{ 0 };
 		float previousStateNormalizedTime{ 0.0f };
 		bool stateEnteredThisFrame{ true };
 		std::uint64_t nextNotifySequence{ 0 };
 		std::vector<AnimationNotifyEvent> pendingNotifyEvents;
 		std::vector<AnimationNotifyEvent> notifyHistory;
 		std::vector<std::string> recentRoutedGameplayEvents;
+		// Filled by the next tick only when debugCaptureTransitions is set (the debug UI sets it while it shows them).
+		bool debugCaptureTransitions{ false };
 		std::vector<std::string> debugTransitionCandidates;
 		std::string debugLastTransitionSelection;
 
@@ -377,10 +434,48 @@ export namespace rendern
 			int secondaryClipIndex{ -1 };
 			float secondaryAlpha{ 0.0f };
 			bool usesBlend1D{ false };
-			std::string parameterName;
 			float parameterValue{ 0.0f };
 		};
 
+		// The value in a parameter slot, or null when the slot is out of range or was never written.
+		[[nodiscard]] inline const AnimationParameterValue* FindAssignedParameter(
+			const AnimationParameterStore& store,
+			int slot) noexcept
+		{
+			if (slot < 0 ||
+				static_cast<std::size_t>(slot) >= store.values.size() ||
+				static_cast<std::size_t>(slot) >= store.assigned.size() ||
+				store.assigned[static_cast<std::size_t>(slot)] == 0)
+			{
+				return nullptr;
+			}
+			return &store.values[static_cast<std::size_t>(slot)];
+		}
+
+		[[nodiscard]] inline int FindParameterSlot(const AnimationParameterStore& store, std::string_view name) noexcept
+		{
+			for (std::size_t i = 0; i < store.names.size(); ++i)
+			{
+				if (store.names[i] == name)
+				{
+					return static_cast<int>(i);
+				}
+			}
+			return -1;
+		}
+
+		inline int AddParameterSlot(AnimationParameterStore& store, std::string_view name)
+		{
+			if (const int slot = FindParameterSlot(store, name); slot >= 0)
+			{
+				return slot;
+			}
+			store.names.emplace_back(name);
+			store.values.emplace_back();
+			store.assigned.push_back(0);
+			return static_cast<int>(store.names.size() - 1);
+		}
+
 		[[nodiscard]] inline StateSampleConfig BuildStateSampleConfig(
 			const AnimationControllerRuntime& runtime,
 			int stateIndex) noexcept
@@ -406,10 +501,13 @@ export namespace rendern
 			}
 
 			sample.usesBlend1D = true;
-			sample.parameterName = state.blendParameter;
-			if (auto it = runtime.parameters.values.find(state.blendParameter); it != runtime.parameters.values.end())
+			const int parameterSlot =
+				(static_cast<std::size_t>(stateIndex) < runtime.compiled.states.size())
+				? runtime.compiled.states[static_cast<std::size_t>(stateIndex)].blendParameterSlot
+				: -1;
+			if (const AnimationParameterValue* parameter = FindAssignedParameter(runtime.parameters, parameterSlot))
 			{
-				sample.parameterValue = GetParameterAsFloat(it->second);
+				sample.parameterValue = GetParameterAsFloat(*parameter);
 			}
 
 			const std::vector<int>* resolvedIndices =
@@ -507,10 +605,14 @@ export namespace rendern
 
 		inline void ApplyParameterDefaults(AnimationParameterStore& store, const AnimationControllerAsset& asset)
 		{
+			store.names.clear();
 			store.values.clear();
+			store.assigned.clear();
 			for (const AnimationParameterDesc& param : asset.parameters)
 			{
-				store.values[param.name] = param.defaultValue;
+				const std::size_t slot = static_cast<std::size_t>(AddParameterSlot(store, param.name));
+				store.values[slot] = param.defaultValue;
+				store.assigned[slot] = 1;
 			}
 		}
 
@@ -532,15 +634,15 @@ export namespace rendern
 		}
 
 		[[nodiscard]] inline bool EvaluateCondition(
-			const AnimationConditionDesc& condition,
+			const CompiledAnimationCondition& condition,
 			const AnimationParameterStore& store) noexcept
 		{
-			auto it = store.values.find(condition.parameter);
-			if (it == store.values.end())
+			const AnimationParameterValue* assigned = FindAssignedParameter(store, condition.parameterSlot);
+			if (assigned == nullptr)
 			{
 				return false;
 			}
-			const AnimationParameterValue& param = it->second;
+			const AnimationParameterValue& param = *assigned;
 
 			switch (condition.op)
 			{
@@ -577,17 +679,22 @@ export namespace rendern
 			}
 		}
 
-		inline void ConsumeTransitionTriggers(AnimationParameterStore& store, const AnimationTransitionDesc& transition)
+		inline void ConsumeTransitionTriggers(
+			AnimationParameterStore& store,
+			const CompiledAnimationController& compiled,
+			const CompiledAnimationTransition& transition) noexcept
 		{
-			for (const AnimationConditionDesc& condition : transition.conditions)
+			if (!transition.consumesTriggers)
+			{
+				return;
+			}
+			for (std::uint32_t i = 0; i < transition.conditionCount; ++i)
 			{
-				if (condition.op == AnimationConditionOp::Triggered)
+				const CompiledAnimationCondition& condition = compiled.conditions[transition.firstCondition + i];
+				if (condition.op == AnimationConditionOp::Triggered &&
+					FindAssignedParameter(store, condition.parameterSlot) != nullptr)
 				{
-					auto it = store.values.find(condition.parameter);
-					if (it != store.values.end())
-					{
-						it->second.triggerValue = false;
-					}
+					store.values[static_cast<std::size_t>(condition.parameterSlot)].triggerValue = false;
 				}
 			}
 		}
@@ -649,8 +756,28 @@ export namespace rendern
 			if (secondaryAnimator != nullptr && IsAnimatorReady(*secondaryAnimator) && secondaryAnimator->clip != nullptr && secondaryAlpha > 1e-6f)
 			{
 				EvaluateAnimatorLocalPose(*secondaryAnimator);
-				const std::vector<LocalBoneTransform> primaryPose = primaryAnimator.localPose;
-				BlendLocalPoses(primaryAnimator.localPose, primaryPose, secondaryAnimator->localPose, secondaryAlpha);
+				// BlendLocalPoses works bone by bone, so it can write over its source pose.
+				BlendLocalPoses(primaryAnimator.localPose, primaryAnimator.localPose, secondaryAnimator->localPose, secondaryAlpha);
+			}
+		}
+
+		// Clocks of everything the current state machine frame plays: the state's animators and, during a
+		// transition, the source state's.
+		inline void AdvanceStateMachineAnimators(AnimationControllerRuntime& runtime, AnimatorState& animator, float deltaSeconds)
+		{
+			AdvanceAnimator(animator, deltaSeconds);
+			if (runtime.blendSecondaryClipIndex >= 0 && IsAnimatorReady(runtime.blendSecondaryAnimator))
+			{
+				AdvanceAnimator(runtime.blendSecondaryAnimator, deltaSeconds);
+			}
+			if (runtime.transitionActive)
+			{
+				runtime.transitionElapsedSeconds += deltaSeconds;
+				AdvanceAnimator(runtime.transitionSourceAnimator, deltaSeconds);
+				if (runtime.transitionSourceSecondaryClipIndex >= 0 && IsAnimatorReady(runtime.transitionSourceBlendSecondaryAnimator))
+				{
+					AdvanceAnimator(runtime.transitionSourceBlendSecondaryAnimator, deltaSeconds);
+				}
 			}
 		}
 
@@ -684,6 +811,35 @@ export namespace rendern
 			return false;
 		}
 
+		// Event id comparison used for notify bindings: ASCII letters and digits only, case-insensitive
+		// (the same canonical form as gameplay event aliases).
+		[[nodiscard]] inline bool AnimationEventIdsMatch(std::string_view a, std::string_view b) noexcept
+		{
+			std::size_t i = 0;
+			std::size_t j = 0;
+			for (;;)
+			{
+				while (i < a.size() && !std::isalnum(static_cast<unsigned char>(a[i])))
+				{
+					++i;
+				}
+				while (j < b.size() && !std::isalnum(static_cast<unsigned char>(b[j])))
+				{
+					++j;
+				}
+				if (i == a.size() || j == b.size())
+				{
+					return i == a.size() && j == b.size();
+				}
+				if (ToLowerAscii(a[i]) != ToLowerAscii(b[j]))
+				{
+					return false;
+				}
+				++i;
+				++j;
+			}
+		}
+
 		[[nodiscard]] inline int GetBoneDepth(const Skeleton& skeleton, std::size_t boneIndex) noexcept
 		{
 			int depth = 0;
@@ -717,12 +873,24 @@ export namespace rendern
 				bindRotation,
 				bindScale);
 
+			const auto differsFromBind = [&bindTranslation](const mathUtils::Vec3& value) noexcept
+				{
+					const mathUtils::Vec3 delta = value - bindTranslation;
+					return std::fabs(delta.x) > 1e-4f ||
+						std::fabs(delta.y) > 1e-4f ||
+						std::fabs(delta.z) > 1e-4f;
+				};
+
 			for (const TranslationKey& key : channel.translationKeys)
 			{
-				const mathUtils::Vec3 delta = key.value - bindTranslation;
-				if (std::fabs(delta.x) > 1e-4f ||
-					std::fabs(delta.y) > 1e-4f ||
-					std::fabs(delta.z) > 1e-4f)
+				if (differsFromBind(key.value))
+				{
+					return true;
+				}
+			}
+			for (const PackedKey& key : channel.packedTranslation.keys)
+			{
+				if (differsFromBind(UnpackVec3Key(channel.packedTranslation, key)))
 				{
 					return true;
 				}
@@ -805,7 +973,13 @@ export namespace rendern
 				return;
 			}
 
-			const std::size_t motionBoneIndex = ResolveInPlaceMotionBoneIndex(runtime, animator);
+			if (runtime.inPlaceMotionSkeleton != animator.skeleton || runtime.inPlaceMotionClip != animator.clip)
+			{
+				runtime.inPlaceMotionSkeleton = animator.skeleton;
+				runtime.inPlaceMotionClip = animator.clip;
+				runtime.inPlaceMotionBoneIndex = ResolveInPlaceMotionBoneIndex(runtime, animator);
+			}
+			const std::size_t motionBoneIndex = runtime.inPlaceMotionBoneIndex;
 			if (motionBoneIndex >= animator.localPose.size() || motionBoneIndex >= animator.skeleton->bones.size())
 			{
 				return;
@@ -832,15 +1006,18 @@ export namespace rendern
 		inline void PushNotifyEvent(
 			AnimationControllerRuntime& runtime,
 			const AnimationStateDesc& state,
-			const AnimationNotifyDesc& notify,
+			std::size_t notifyIndex,
 			const AnimationClip* clip)
 		{
+			const AnimationNotifyDesc& notify = state.notifies[notifyIndex];
 			AnimationNotifyEvent event{};
 			event.sequence = ++runtime.nextNotifySequence;
 			event.id = notify.id;
 			event.stateName = state.name;
 			event.clipName = (clip != nullptr) ? clip->name : std::string{};
 			event.normalizedTime = std::clamp(notify.timeNormalized, 0.0f, 1.0f);
+			event.stateIndex = runtime.currentStateIndex;
+			event.notifyIndex = static_cast<int>(notifyIndex);
 			runtime.pendingNotifyEvents.push_back(event);
 			runtime.notifyHistory.push_back(std::move(event));
 
@@ -893,8 +1070,9 @@ export namespace rendern
 			if (!state.notifies.empty())
 			{
 				const bool looping = animator.clip != nullptr && animator.looping && animator.clip->looping;
-				for (const AnimationNotifyDesc& notify : state.notifies)
+				for (std::size_t notifyIndex = 0; notifyIndex < state.notifies.size(); ++notifyIndex)
 				{
+					const AnimationNotifyDesc& notify = state.notifies[notifyIndex];
 					if (notify.id.empty())
 					{
 						continue;
@@ -903,13 +1081,13 @@ export namespace rendern
 					const float notifyTime = std::clamp(notify.timeNormalized, 0.0f, 1.0f);
 					if (runtime.stateEnteredThisFrame && (notify.fireOnEnter || notifyTime <= 1e-6f))
 					{
-						PushNotifyEvent(runtime, state, notify, animator.clip);
+						PushNotifyEvent(runtime, state, notifyIndex, animator.clip);
 						continue;
 					}
 
 					if (DidNormalizedTimePass(runtime.previousStateNormalizedTime, currentNormalizedTime, notifyTime, looping))
 					{
-						PushNotifyEvent(runtime, state, notify, animator.clip);
+						PushNotifyEvent(runtime, state, notifyIndex, animator.clip);
 					}
 				}
 			}
@@ -921,18 +1099,8 @@ export namespace rendern
 		inline void SyncRuntimeBlendMetadata(AnimationControllerRuntime& runtime, const StateSampleConfig& sample)
 		{
 			runtime.currentStateUsesBlend1D = sample.usesBlend1D;
-			runtime.currentBlendParameterName = sample.parameterName;
 			runtime.currentBlendParameterValue = sample.parameterValue;
-			runtime.currentBlendPrimaryClipName.clear();
-			runtime.currentBlendSecondaryClipName.clear();
-			if (const AnimationClip* primaryClip = ResolveClipByIndex(runtime.clips, sample.primaryClipIndex))
-			{
-				runtime.currentBlendPrimaryClipName = primaryClip->name;
-			}
-			if (const AnimationClip* secondaryClip = ResolveClipByIndex(runtime.clips, sample.secondaryClipIndex))
-			{
-				runtime.currentBlendSecondaryClipName = secondaryClip->name;
-			}
+			runtime.blendPrimaryClipIndex = sample.primaryClipIndex;
 			runtime.blendSecondaryClipIndex = sample.secondaryClipIndex;
 			runtime.blendSecondaryAlpha = sample.secondaryAlpha;
 		}
@@ -981,10 +1149,8 @@ export namespace rendern
 		inline void ClearActiveBlendMetadata(AnimationControllerRuntime& runtime)
 		{
 			runtime.currentStateUsesBlend1D = false;
-			runtime.currentBlendParameterName.clear();
 			runtime.currentBlendParameterValue = 0.0f;
-			runtime.currentBlendPrimaryClipName.clear();
-			runtime.currentBlendSecondaryClipName.clear();
+			runtime.blendPrimaryClipIndex = -1;
 			runtime.blendSecondaryAnimator = {};
 			runtime.blendSecondaryClipIndex = -1;
 			runtime.blendSecondaryAlpha = 0.0f;
@@ -997,7 +1163,6 @@ export namespace rendern
 				static_cast<std::size_t>(stateIndex) >= runtime.stateMachineAsset->states.size())
 			{
 				runtime.currentStateIndex = -1;
-				runtime.currentStateName.clear();
 				runtime.legacyClipIndex = -1;
 				ClearActiveBlendMetadata(runtime);
 				if (resetStateTracking)
@@ -1009,7 +1174,6 @@ export namespace rendern
 			}
 			runtime.currentStateIndex = stateIndex;
 			const AnimationStateDesc& state = runtime.stateMachineAsset->states[static_cast<std::size_t>(stateIndex)];
-			runtime.currentStateName = state.name;
 			runtime.looping = state.looping;
 			runtime.playRate = state.playRate;
 			runtime.legacyClipIndex =
@@ -1017,10 +1181,8 @@ export namespace rendern
 				? runtime.resolvedStateClipIndices[static_cast<std::size_t>(stateIndex)]
 				: -1;
 			runtime.currentStateUsesBlend1D = !state.blendParameter.empty() && !state.blend1D.empty();
-			runtime.currentBlendParameterName = state.blendParameter;
 			runtime.currentBlendParameterValue = 0.0f;
-			runtime.currentBlendPrimaryClipName.clear();
-			runtime.currentBlendSecondaryClipName.clear();
+			runtime.blendPrimaryClipIndex = -1;
 			runtime.blendSecondaryClipIndex = -1;
 			runtime.blendSecondaryAlpha = 0.0f;
 			if (resetStateTracking)
@@ -1030,16 +1192,15 @@ export namespace rendern
 			}
 		}
 
-		[[nodiscard]] inline bool TransitionMatchesState(const AnimationTransitionDesc& transition, std::string_view currentState) noexcept
+		[[nodiscard]] inline bool TransitionLeavesState(const AnimationTransitionDesc& transition, std::string_view stateName) noexcept
 		{
-			return transition.fromState.empty() || transition.fromState == "*" || transition.fromState == currentState;
+			return transition.fromState.empty() || transition.fromState == "*" || transition.fromState == stateName;
 		}
 
 		inline void ResetBlendState(AnimationControllerRuntime& runtime)
 		{
 			runtime.transitionActive = false;
 			runtime.transitionSourceStateIndex = -1;
-			runtime.transitionSourceStateName.clear();
 			runtime.transitionElapsedSeconds = 0.0f;
 			runtime.transitionDurationSeconds = 0.0f;
 			runtime.transitionSourceAnimator = {};
@@ -1047,23 +1208,127 @@ export namespace rendern
 			runtime.transitionSourceSecondaryClipIndex = -1;
 			runtime.transitionSourceSecondaryAlpha = 0.0f;
 		}
+
+		// Resolves the bound asset into runtime.compiled. Condition and blend parameters get store slots
+		// (undeclared ones an unassigned slot, so they read as missing until something sets them).
+		inline void CompileAnimationController(AnimationControllerRuntime& runtime)
+		{
+			CompiledAnimationController& compiled = runtime.compiled;
+			compiled = {};
+			if (runtime.stateMachineAsset == nullptr)
+			{
+				return;
+			}
+
+			const AnimationControllerAsset& asset = *runtime.stateMachineAsset;
+			compiled.asset = &asset;
+			compiled.defaultStateIndex =
+				!asset.defaultState.empty()
+				? FindStateIndexByName(asset, asset.defaultState)
+				: (asset.states.empty() ? -1 : 0);
+
+			compiled.transitions.reserve(asset.transitions.size());
+			for (const AnimationTransitionDesc& transition : asset.transitions)
+			{
+				CompiledAnimationTransition out{};
+				out.toStateIndex = FindStateIndexByName(asset, transition.toState);
+				out.hasExitTime = transition.hasExitTime;
+				out.exitTimeNormalized = transition.exitTimeNormalized;
+				out.blendDurationSeconds = std::max(0.0f, transition.blendDurationSeconds);
+				out.priority = transition.priority;
+				out.firstCondition = static_cast<std::uint32_t>(compiled.conditions.size());
+				out.conditionCount = static_cast<std::uint32_t>(transition.conditions.size());
+				for (const AnimationConditionDesc& condition : transition.conditions)
+				{
+					compiled.conditions.push_back(CompiledAnimationCondition{
+						.parameterSlot = AddParameterSlot(runtime.parameters, condition.parameter),
+						.op = condition.op,
+						.value = condition.value });
+					out.consumesTriggers = out.consumesTriggers || condition.op == AnimationConditionOp::Triggered;
+				}
+				compiled.transitions.push_back(out);
+			}
+
+			compiled.states.resize(asset.states.size());
+			for (std::size_t stateIndex = 0; stateIndex < asset.states.size(); ++stateIndex)
+			{
+				const AnimationStateDesc& state = asset.states[stateIndex];
+				CompiledAnimationState& out = compiled.states[stateIndex];
+				if (!state.blendParameter.empty() && !state.blend1D.empty())
+				{
+					out.blendParameterSlot = AddParameterSlot(runtime.parameters, state.blendParameter);
+				}
+
+				out.firstTransition = static_cast<std::uint32_t>(compiled.stateTransitions.size());
+				for (std::size_t transitionIndex = 0; transitionIndex < asset.transitions.size(); ++transitionIndex)
+				{
+					if (TransitionLeavesState(asset.transitions[transitionIndex], state.name))
+					{
+						compiled.stateTransitions.push_back(static_cast<std::uint32_t>(transitionIndex));
+					}
+				}
+				out.transitionCount = static_cast<std::uint32_t>(compiled.stateTransitions.size()) - out.firstTransition;
+
+				out.firstNotify = static_cast<std::uint32_t>(compiled.notifyBindingOffsets.size());
+				for (const AnimationNotifyDesc& notify : state.notifies)
+				{
+					compiled.notifyBindingOffsets.push_back(static_cast<std::uint32_t>(compiled.notifyBindings.size()));
+					for (std::size_t bindingIndex = 0; bindingIndex < asset.eventBindings.size(); ++bindingIndex)
+					{
+						const AnimationEventBindingDesc& binding = asset.eventBindings[bindingIndex];
+						if (!binding.animationEventId.empty() &&
+							!binding.gameplayEventId.empty() &&
+							AnimationEventIdsMatch(notify.id, binding.animationEventId))
+						{
+							compiled.notifyBindings.push_back(static_cast<std::uint32_t>(bindingIndex));
+						}
+					}
+				}
+			}
+			compiled.notifyBindingOffsets.push_back(static_cast<std::uint32_t>(compiled.notifyBindings.size()));
+		}
+
+		// "<from> -> <to> [<outcome>]" for the debug UI's transition candidate list.
+		[[nodiscard]] inline std::string DescribeTransitionCandidate(const AnimationTransitionDesc& transition, std::string_view outcome)
+		{
+			std::string label = transition.fromState.empty() ? std::string("*") : transition.fromState;
+			label += " -> ";
+			label += transition.toState;
+			label += " [";
+			label += outcome;
+			label += "]";
+			return label;
+		}
 	}
 
+	// Unassigns every parameter; the slots stay so compiled controllers keep addressing the same names.
 	inline void ResetAnimationParameters(AnimationParameterStore& store)
 	{
-		store.values.clear();
+		std::fill(store.values.begin(), store.values.end(), AnimationParameterValue{});
+		std::fill(store.assigned.begin(), store.assigned.end(), std::uint8_t{ 0 });
+	}
+
+	[[nodiscard]] inline int FindAnimationParameterSlot(const AnimationParameterStore& store, std::string_view name) noexcept
+	{
+		return detail::FindParameterSlot(store, name);
 	}
 
-	[[nodiscard]] inline AnimationParameterValue* FindAnimationParameter(AnimationParameterStore& store, std::string_view name)
+	[[nodiscard]] inline AnimationParameterValue* FindAnimationParameter(AnimationParameterStore& store, std::string_view name) noexcept
 	{
-		auto it = store.values.find(std::string(name));
-		return (it == store.values.end()) ? nullptr : &it->second;
+		const int slot = detail::FindParameterSlot(store, name);
+		return (detail::FindAssignedParameter(store, slot) != nullptr) ? &store.values[static_cast<std::size_t>(slot)] : nullptr;
 	}
 
-	[[nodiscard]] inline const AnimationParameterValue* FindAnimationParameter(const AnimationParameterStore& store, std::string_view name)
+	[[nodiscard]] inline const AnimationParameterValue* FindAnimationParameter(const AnimationParameterStore& store, std::string_view name) noexcept
 	{
-		auto it = store.values.find(std::string(name));
-		return (it == store.values.end()) ? nullptr : &it->second;
+		return detail::FindAssignedParameter(store, detail::FindParameterSlot(store, name));
+	}
+
+	inline void SetAnimationParameterValue(AnimationParameterStore& store, std::string_view name, const AnimationParameterValue& value)
+	{
+		const std::size_t slot = static_cast<std::size_t>(detail::AddParameterSlot(store, name));
+		store.values[slot] = value;
+		store.assigned[slot] = 1;
 	}
 
 	[[nodiscard]] inline const AnimationParameterDesc* FindAnimationParameterDesc(const AnimationControllerAsset& asset, std::string_view name) noexcept
@@ -1084,12 +1349,18 @@ export namespace rendern
 		std::same_as<std::remove_cvref_t<T>, int> ||
 		std::same_as<std::remove_cvref_t<T>, float>;
 
+	// Slot-addressed setter for callers that resolved FindAnimationParameterSlot once; out-of-range slots are ignored.
 	template<AnimationParameterTypeC T>
-	inline void SetAnimationParameter(AnimationParameterStore& store, std::string_view name, T value)
+	inline void SetAnimationParameterAt(AnimationParameterStore& store, int slot, T value) noexcept
 	{
 		using ValueT = std::remove_cvref_t<T>;
 
-		AnimationParameterValue& param = store.values[std::string(name)];
+		if (slot < 0 || static_cast<std::size_t>(slot) >= store.values.size())
+		{
+			return;
+		}
+		AnimationParameterValue& param = store.values[static_cast<std::size_t>(slot)];
+		store.assigned[static_cast<std::size_t>(slot)] = 1;
 
 		if constexpr (std::same_as<ValueT, bool>)
 		{
@@ -1108,13 +1379,29 @@ export namespace rendern
 		}
 	}
 
-	inline void FireAnimationTrigger(AnimationParameterStore& store, std::string_view name)
+	template<AnimationParameterTypeC T>
+	inline void SetAnimationParameter(AnimationParameterStore& store, std::string_view name, T value)
+	{
+		SetAnimationParameterAt(store, detail::AddParameterSlot(store, name), value);
+	}
+
+	inline void FireAnimationTriggerAt(AnimationParameterStore& store, int slot) noexcept
 	{
-		AnimationParameterValue& param = store.values[std::string(name)];
+		if (slot < 0 || static_cast<std::size_t>(slot) >= store.values.size())
+		{
+			return;
+		}
+		AnimationParameterValue& param = store.values[static_cast<std::size_t>(slot)];
+		store.assigned[static_cast<std::size_t>(slot)] = 1;
 		param.type = AnimationParameterType::Trigger;
 		param.triggerValue = true;
 	}
 
+	inline void FireAnimationTrigger(AnimationParameterStore& store, std::string_view name)
+	{
+		FireAnimationTriggerAt(store, detail::AddParameterSlot(store, name));
+	}
+
 	inline void ResetAnimationTrigger(AnimationParameterStore& store, std::string_view name)
 	{
 		if (AnimationParameterValue* param = FindAnimationParameter(store, name))
@@ -1216,6 +1503,7 @@ export namespace rendern
 		runtime.clips = &clips;
 		runtime.clipSourceAssetIds = nullptr;
 		runtime.stateMachineAsset = nullptr;
+		runtime.compiled = {};
 		runtime.currentStateIndex = -1;
 		runtime.resolvedStateClipIndices.clear();
 		runtime.resolvedStateBlendClipIndices.clear();
@@ -1227,9 +1515,6 @@ export namespace rendern
 		runtime.playRate = playRate;
 		runtime.paused = paused;
 		runtime.forceBindPose = forceBindPose;
-		runtime.currentStateName = (ResolveLegacyAnimationClip(runtime) != nullptr)
-			? ResolveLegacyAnimationClip(runtime)->name
-			: std::string("BindPose");
 	}
 
 	inline void BindAnimationControllerStateMachine(
@@ -1252,6 +1537,8 @@ export namespace rendern
 		runtime.autoplay = autoplay;
 		runtime.paused = paused;
 		runtime.forceBindPose = forceBindPose;
+		runtime.inPlaceMotionSkeleton = nullptr;
+		runtime.inPlaceMotionClip = nullptr;
 		detail::ResolveStateClipIndices(runtime);
 		detail::ResetBlendState(runtime);
 		detail::ClearActiveBlendMetadata(runtime);
@@ -1259,19 +1546,22 @@ export namespace rendern
 		if (!sameAsset)
 		{
 			detail::ApplyParameterDefaults(runtime.parameters, asset);
-			runtime.requestedStateName.clear();
-			const int defaultIndex =
-				!asset.defaultState.empty()
-				? detail::FindStateIndexByName(asset, asset.defaultState)
-				: (asset.states.empty() ? -1 : 0);
-			detail::ApplyRuntimeState(runtime, defaultIndex, true);
+			detail::CompileAnimationController(runtime);
+			runtime.requestedStateIndex = -1;
+			detail::ApplyRuntimeState(runtime, runtime.compiled.defaultStateIndex, true);
 		}
-		else if (runtime.currentStateIndex >= 0)
+		else
 		{
-			detail::ApplyRuntimeState(runtime, runtime.currentStateIndex, false);
+			detail::CompileAnimationController(runtime);
+			if (runtime.currentStateIndex >= 0)
+			{
+				detail::ApplyRuntimeState(runtime, runtime.currentStateIndex, false);
+			}
 		}
 	}
 
+	// Per-frame binding sync. Clip indices are only re-resolved (and a running transition dropped) when the
+	// skeleton or clip set actually changed.
 	inline void RefreshAnimationControllerRuntimeBindings(
 		AnimationControllerRuntime& runtime,
 		const Skeleton& skeleton,
@@ -1281,13 +1571,17 @@ export namespace rendern
 		bool paused,
 		bool forceBindPose)
 	{
+		const bool bindingsChanged =
+			runtime.skeleton != &skeleton ||
+			runtime.clips != &clips ||
+			runtime.clipSourceAssetIds != &clipSourceAssetIds;
 		runtime.skeleton = &skeleton;
 		runtime.clips = &clips;
 		runtime.clipSourceAssetIds = &clipSourceAssetIds;
 		runtime.autoplay = autoplay;
 		runtime.paused = paused;
 		runtime.forceBindPose = forceBindPose;
-		if (runtime.mode == AnimationControllerMode::StateMachine && runtime.stateMachineAsset != nullptr)
+		if (bindingsChanged && runtime.mode == AnimationControllerMode::StateMachine && runtime.stateMachineAsset != nullptr)
 		{
 			detail::ResolveStateClipIndices(runtime);
 			if (runtime.currentStateIndex >= 0)
@@ -1305,9 +1599,13 @@ export namespace rendern
 		}
 	}
 
+	// Resolved here, not per tick; unknown names (or no bound controller) request nothing.
 	inline void RequestAnimationControllerState(AnimationControllerRuntime& runtime, std::string_view stateName)
 	{
-		runtime.requestedStateName = std::string(stateName);
+		runtime.requestedStateIndex =
+			(runtime.stateMachineAsset != nullptr)
+			? detail::FindStateIndexByName(*runtime.stateMachineAsset, stateName)
+			: -1;
 	}
 
 	inline void UpdateAnimationControllerRuntime(AnimationControllerRuntime& runtime, AnimatorState& animator, float deltaSeconds)
@@ -1319,13 +1617,10 @@ export namespace rendern
 
 		if (runtime.mode == AnimationControllerMode::StateMachine && runtime.stateMachineAsset != nullptr)
 		{
+			const CompiledAnimationController& compiled = runtime.compiled;
 			if (runtime.currentStateIndex < 0)
 			{
-				const int defaultIndex =
-					!runtime.stateMachineAsset->defaultState.empty()
-					? detail::FindStateIndexByName(*runtime.stateMachineAsset, runtime.stateMachineAsset->defaultState)
-					: (runtime.stateMachineAsset->states.empty() ? -1 : 0);
-				detail::ApplyRuntimeState(runtime, defaultIndex, true);
+				detail::ApplyRuntimeState(runtime, compiled.defaultStateIndex, true);
 			}
 
 			if (runtime.forceBindPose)
@@ -1343,95 +1638,92 @@ export namespace rendern
 
 			if (runtime.autoplay && !runtime.paused)
 			{
-				AdvanceAnimator(animator, deltaSeconds);
-				if (runtime.blendSecondaryClipIndex >= 0 && IsAnimatorReady(runtime.blendSecondaryAnimator))
-				{
-					AdvanceAnimator(runtime.blendSecondaryAnimator, deltaSeconds);
-				}
-				if (runtime.transitionActive)
-				{
-					runtime.transitionElapsedSeconds += deltaSeconds;
-					AdvanceAnimator(runtime.transitionSourceAnimator, deltaSeconds);
-					if (runtime.transitionSourceSecondaryClipIndex >= 0 && IsAnimatorReady(runtime.transitionSourceBlendSecondaryAnimator))
-					{
-						AdvanceAnimator(runtime.transitionSourceBlendSecondaryAnimator, deltaSeconds);
-					}
-				}
+				detail::AdvanceStateMachineAnimators(runtime, animator, deltaSeconds);
 			}
 
 			int targetStateIndex = -1;
-			const AnimationTransitionDesc* matchedTransition = nullptr;
-			int matchedTransitionPriority = std::numeric_limits<int>::min();
+			const CompiledAnimationTransition* matchedTransition = nullptr;
+			std::size_t matchedTransitionIndex = 0;
+			const bool captureDebug = std::exchange(runtime.debugCaptureTransitions, false);
 			runtime.debugTransitionCandidates.clear();
 			runtime.debugLastTransitionSelection.clear();
 
-			if (!runtime.requestedStateName.empty())
+			if (runtime.requestedStateIndex >= 0)
 			{
-				targetStateIndex = detail::FindStateIndexByName(*runtime.stateMachineAsset, runtime.requestedStateName);
-				runtime.requestedStateName.clear();
+				targetStateIndex = std::exchange(runtime.requestedStateIndex, -1);
 			}
-			else if (!runtime.transitionActive)
+			else if (!runtime.transitionActive &&
+				static_cast<std::size_t>(runtime.currentStateIndex) < compiled.states.size())
 			{
-				for (const AnimationTransitionDesc& transition : runtime.stateMachineAsset->transitions)
+				const CompiledAnimationState& state = compiled.states[static_cast<std::size_t>(runtime.currentStateIndex)];
+				for (std::uint32_t i = 0; i < state.transitionCount; ++i)
 				{
-					if (!detail::TransitionMatchesState(transition, runtime.currentStateName))
-					{
-						continue;
-					}
-
-					std::string debugLabel = transition.fromState.empty() ? std::string("*") : transition.fromState;
-					debugLabel += " -> ";
-					debugLabel += transition.toState;
+					const std::uint32_t transitionIndex = compiled.stateTransitions[state.firstTransition + i];
+					const CompiledAnimationTransition& transition = compiled.transitions[transitionIndex];
 
 					if (transition.hasExitTime &&
 						detail::GetAnimatorNormalizedTime(animator) < transition.exitTimeNormalized)
 					{
-						debugLabel += " [exit-time blocked]";
-						runtime.debugTransitionCandidates.push_back(std::move(debugLabel));
+						if (captureDebug)
+						{
+							runtime.debugTransitionCandidates.push_back(detail::DescribeTransitionCandidate(
+								runtime.stateMachineAsset->transitions[transitionIndex], "exit-time blocked"));
+						}
 						continue;
 					}
-					bool passed = true;
-					for (const AnimationConditionDesc& condition : transition.conditions)
+					int failedCondition = -1;
+					for (std::uint32_t c = 0; c < transition.conditionCount; ++c)
 					{
-						if (!detail::EvaluateCondition(condition, runtime.parameters))
+						if (!detail::EvaluateCondition(compiled.conditions[transition.firstCondition + c], runtime.parameters))
 						{
-							passed = false;
-							debugLabel += " [condition failed: ";
-							debugLabel += condition.parameter;
-							debugLabel += "]";
+							failedCondition = static_cast<int>(c);
 							break;
 						}
 					}
-					if (!passed)
+					if (failedCondition >= 0)
 					{
-						runtime.debugTransitionCandidates.push_back(std::move(debugLabel));
+						if (captureDebug)
+						{
+							const AnimationTransitionDesc& desc = runtime.stateMachineAsset->transitions[transitionIndex];
+							runtime.debugTransitionCandidates.push_back(detail::DescribeTransitionCandidate(
+								desc, "condition failed: " + desc.conditions[static_cast<std::size_t>(failedCondition)].parameter));
+						}
 						continue;
 					}
-					const int candidateStateIndex = detail::FindStateIndexByName(*runtime.stateMachineAsset, transition.toState);
-					if (candidateStateIndex < 0)
+					if (transition.toStateIndex < 0)
 					{
-						debugLabel += " [target missing]";
-						runtime.debugTransitionCandidates.push_back(std::move(debugLabel));
+						if (captureDebug)
+						{
+							runtime.debugTransitionCandidates.push_back(detail::DescribeTransitionCandidate(
+								runtime.stateMachineAsset->transitions[transitionIndex], "target missing"));
+						}
 						continue;
 					}
-					debugLabel += " [pass, priority=" + std::to_string(transition.priority) + "]";
-					runtime.debugTransitionCandidates.push_back(debugLabel);
-					if (matchedTransition == nullptr || transition.priority > matchedTransitionPriority)
+					if (captureDebug)
 					{
-						targetStateIndex = candidateStateIndex;
+						runtime.debugTransitionCandidates.push_back(detail::DescribeTransitionCandidate(
+							runtime.stateMachineAsset->transitions[transitionIndex],
+							"pass, priority=" + std::to_string(transition.priority)));
+					}
+					if (matchedTransition == nullptr || transition.priority > matchedTransition->priority)
+					{
+						targetStateIndex = transition.toStateIndex;
 						matchedTransition = &transition;
-						matchedTransitionPriority = transition.priority;
-						runtime.debugLastTransitionSelection = std::move(debugLabel);
+						matchedTransitionIndex = transitionIndex;
 					}
 				}
+				if (captureDebug && matchedTransition != nullptr)
+				{
+					runtime.debugLastTransitionSelection = detail::DescribeTransitionCandidate(
+						runtime.stateMachineAsset->transitions[matchedTransitionIndex],
+						"pass, priority=" + std::to_string(matchedTransition->priority));
+				}
 			}
 
 			if (targetStateIndex >= 0 && targetStateIndex != runtime.currentStateIndex)
 			{
 				const float blendDurationSeconds =
-					(matchedTransition != nullptr)
-					? std::max(0.0f, matchedTransition->blendDurationSeconds)
-					: 0.0f;
+					(matchedTransition != nullptr) ? matchedTransition->blendDurationSeconds : 0.0f;
 				const bool canBlend =
 					blendDurationSeconds > 1e-4f &&
 					IsAnimatorReady(animator) &&
@@ -1446,7 +1738,6 @@ export namespace rendern
 					runtime.transitionSourceSecondaryClipIndex = runtime.blendSecondaryClipIndex;
 					runtime.transitionSourceSecondaryAlpha = runtime.blendSecondaryAlpha;
 					runtime.transitionSourceStateIndex = runtime.currentStateIndex;
-					runtime.transitionSourceStateName = runtime.currentStateName;
 					runtime.transitionElapsedSeconds = 0.0f;
 					runtime.transitionDurationSeconds = blendDurationSeconds;
 					runtime.transitionActive = true;
@@ -1461,7 +1752,7 @@ export namespace rendern
 				detail::SyncActiveStateAnimators(runtime, animator, targetSample, true);
 				if (matchedTransition != nullptr)
 				{
-					detail::ConsumeTransitionTriggers(runtime.parameters, *matchedTransition);
+					detail::ConsumeTransitionTriggers(runtime.parameters, compiled, *matchedTransition);
 				}
 			}
 			else
@@ -1473,10 +1764,17 @@ export namespace rendern
 			animator.paused = runtime.paused;
 			detail::EvaluateAnimatorPairToLocalPose(
 				animator,
-				(runtime.blendSecondaryClipIndex >= 0) ? &runtime.blendSecondaryAnimator : nullptr,
+				(runtime.blendSecondaryClipIndex >= 0 && !runtime.lodPrimaryLayerOnly) ? &runtime.blendSecondaryAnimator : nullptr,
 				runtime.blendSecondaryAlpha);
 
-			if (runtime.transitionActive)
+			if (runtime.transitionActive && runtime.lodPrimaryLayerOnly)
+			{
+				if (runtime.transitionElapsedSeconds >= runtime.transitionDurationSeconds)
+				{
+					detail::ResetBlendState(runtime);
+				}
+			}
+			else if (runtime.transitionActive)
 			{
 				const bool validBlend =
 					IsAnimatorReady(runtime.transitionSourceAnimator) &&
@@ -1494,8 +1792,7 @@ export namespace rendern
 						runtime.transitionElapsedSeconds / runtime.transitionDurationSeconds,
 						0.0f,
 						1.0f);
-					const std::vector<LocalBoneTransform> targetPose = animator.localPose;
-					BlendLocalPoses(animator.localPose, runtime.transitionSourceAnimator.localPose, targetPose, alpha);
+					BlendLocalPoses(animator.localPose, runtime.transitionSourceAnimator.localPose, animator.localPose, alpha);
 					if (alpha >= 1.0f - 1e-6f)
 					{
 						detail::ResetBlendState(runtime);
@@ -1545,4 +1842,89 @@ export namespace rendern
 		detail::ApplyRootMotionModeToAnimatorPose(runtime, animator);
 		BuildAnimatorMatrices(animator);
 	}
+
+	// Animation LOD for characters out of view: the clocks move on (playback time, Blend1D secondaries,
+	// transition progress), but no transition is evaluated, no pose sampled and no matrix rebuilt. The
+	// skin matrices keep the last evaluated pose until the next UpdateAnimationControllerRuntime.
+	inline void AdvanceAnimationControllerTime(AnimationControllerRuntime& runtime, AnimatorState& animator, float deltaSeconds)
+	{
+		if (runtime.skeleton == nullptr || runtime.forceBindPose || !runtime.autoplay)
+		{
+			return;
+		}
+
+		if (runtime.mode == AnimationControllerMode::StateMachine && runtime.stateMachineAsset != nullptr)
+		{
+			if (!runtime.paused && runtime.currentStateIndex >= 0)
+			{
+				detail::AdvanceStateMachineAnimators(runtime, animator, deltaSeconds);
+			}
+			return;
+		}
+
+		if (!animator.paused)
+		{
+			AdvanceAnimator(animator, deltaSeconds);
+		}
+	}
+	// Display names, resolved from indices on demand. The views point into the bound asset and clips.
+	[[nodiscard]] inline std::string_view GetAnimationControllerStateName(const AnimationControllerRuntime& runtime) noexcept
+	{
+		if (runtime.mode == AnimationControllerMode::StateMachine)
+		{
+			return (runtime.stateMachineAsset != nullptr &&
+				runtime.currentStateIndex >= 0 &&
+				static_cast<std::size_t>(runtime.currentStateIndex) < runtime.stateMachineAsset->states.size())
+				? std::string_view(runtime.stateMachineAsset->states[static_cast<std::size_t>(runtime.currentStateIndex)].name)
+				: std::string_view{};
+		}
+		const AnimationClip* clip = ResolveLegacyAnimationClip(runtime);
+		return (clip != nullptr) ? std::string_view(clip->name) : std::string_view("BindPose");
+	}
+
+	[[nodiscard]] inline std::string_view GetAnimationControllerTransitionSourceStateName(const AnimationControllerRuntime& runtime) noexcept
+	{
+		return (runtime.stateMachineAsset != nullptr &&
+			runtime.transitionSourceStateIndex >= 0 &&
+			static_cast<std::size_t>(runtime.transitionSourceStateIndex) < runtime.stateMachineAsset->states.size())
+			? std::string_view(runtime.stateMachineAsset->states[static_cast<std::size_t>(runtime.transitionSourceStateIndex)].name)
+			: std::string_view{};
+	}
+
+	[[nodiscard]] inline std::string_view GetAnimationControllerBlendParameterName(const AnimationControllerRuntime& runtime) noexcept
+	{
+		return (runtime.currentStateUsesBlend1D &&
+			runtime.stateMachineAsset != nullptr &&
+			runtime.currentStateIndex >= 0 &&
+			static_cast<std::size_t>(runtime.currentStateIndex) < runtime.stateMachineAsset->states.size())
+			? std::string_view(runtime.stateMachineAsset->states[static_cast<std::size_t>(runtime.currentStateIndex)].blendParameter)
+			: std::string_view{};
+	}
+
+	[[nodiscard]] inline std::string_view GetAnimationControllerClipName(const AnimationControllerRuntime& runtime, int clipIndex) noexcept
+	{
+		const AnimationClip* clip = detail::ResolveClipByIndex(runtime.clips, clipIndex);
+		return (clip != nullptr) ? std::string_view(clip->name) : std::string_view{};
+	}
+
+	// AnimationControllerAsset::eventBindings indices bound to a notify event of the runtime's compiled controller.
+	[[nodiscard]] inline std::span<const std::uint32_t> GetAnimationNotifyEventBindings(
+		const AnimationControllerRuntime& runtime,
+		const AnimationNotifyEvent& event) noexcept
+	{
+		const CompiledAnimationController& compiled = runtime.compiled;
+		if (compiled.asset == nullptr ||
+			compiled.asset != runtime.stateMachineAsset ||
+			event.stateIndex < 0 ||
+			event.notifyIndex < 0 ||
+			static_cast<std::size_t>(event.stateIndex) >= compiled.states.size() ||
+			static_cast<std::size_t>(event.notifyIndex) >= compiled.asset->states[static_cast<std::size_t>(event.stateIndex)].notifies.size())
+		{
+			return {};
+		}
+		const std::size_t k = compiled.states[static_cast<std::size_t>(event.stateIndex)].firstNotify + static_cast<std::size_t>(event.notifyIndex);
+		return std::span<const std::uint32_t>(compiled.notifyBindings).subspan(
+			compiled.notifyBindingOffsets[k],
+			compiled.notifyBindingOffsets[k + 1] - compiled.notifyBindingOffsets[k]);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,193 @@
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+export module core:animation_lod;
+
+import :math_utils;
+import :animator;
+import :animation_controller;
+
+// Animation LOD: how much of a character's animation runs each frame, picked from its on-screen size.
+//   Full      - every frame, every layer and bone.
+//   Reduced   - every reducedUpdateInterval frames with the elapsed time caught up; the frames in between
+//               interpolate between the last two evaluated poses (so the pose trails by one interval).
+//   Low       - every lowUpdateInterval frames, primary clip only (no Blend1D secondary or transition
+//               source), bones deeper than lowMaxBoneDepth frozen; the pose is held in between.
+//   Offscreen - clocks only (AdvanceAnimationControllerTime); the pose is refreshed when it comes back.
+
+export namespace rendern
+{
+	enum class AnimationLodLevel : std::uint8_t
+	{
+		Full = 0,
+		Reduced = 1,
+		Low = 2,
+		Offscreen = 3
+	};
+
+	struct AnimationLodSettings
+	{
+		bool enabled{ true };
+		// Bounding sphere diameter over the viewport height at and above which a level applies.
+		float fullScreenSize{ 0.3f };
+		float reducedScreenSize{ 0.08f };
+		std::uint32_t reducedUpdateInterval{ 2 };
+		std::uint32_t lowUpdateInterval{ 4 };
+		int lowMaxBoneDepth{ 6 };
+	};
+
+	struct AnimationLodState
+	{
+		AnimationLodLevel level{ AnimationLodLevel::Full };
+		std::uint32_t stagger{ 0 };              // spreads the evaluations of characters on the same interval
+		std::uint32_t frameIndex{ 0 };
+		std::uint32_t framesSinceEvaluation{ 0 };
+		float pendingSeconds{ 0.0f };            // time not yet handed to the controller
+		bool evaluated{ false };
+		std::vector<LocalBoneTransform> previousPose; // the last two evaluated poses (Reduced interpolation)
+		std::vector<LocalBoneTransform> currentPose;
+	};
+
+	// Diameter of a world-space bounding sphere over the viewport height at its distance (1 = fills the view).
+	[[nodiscard]] inline float AnimationLodScreenSize(
+		const mathUtils::Vec3& sphereCenter,
+		float sphereRadius,
+		const mathUtils::Vec3& cameraPosition,
+		float fovYRadians) noexcept
+	{
+		const float distance = mathUtils::Length(sphereCenter - cameraPosition);
+		if (distance <= sphereRadius)
+		{
+			return 1.0f;
+		}
+		const float halfHeight = distance * std::tan(0.5f * fovYRadians);
+		return (halfHeight > 0.0f) ? sphereRadius / halfHeight : 1.0f;
+	}
+
+	[[nodiscard]] inline AnimationLodLevel SelectAnimationLodLevel(
+		const AnimationLodSettings& settings,
+		bool visible,
+		float screenSize) noexcept
+	{
+		if (!settings.enabled)
+		{
+			return AnimationLodLevel::Full;
+		}
+		if (!visible)
+		{
+			return AnimationLodLevel::Offscreen;
+		}
+		if (screenSize >= settings.fullScreenSize)
+		{
+			return AnimationLodLevel::Full;
+		}
+		return (screenSize >= settings.reducedScreenSize) ? AnimationLodLevel::Reduced : AnimationLodLevel::Low;
+	}
+
+	[[nodiscard]] inline std::uint32_t AnimationLodUpdateInterval(const AnimationLodSettings& settings, AnimationLodLevel level) noexcept
+	{
+		switch (level)
+		{
+		case AnimationLodLevel::Reduced:
+			return std::max(1u, settings.reducedUpdateInterval);
+		case AnimationLodLevel::Low:
+			return std::max(1u, settings.lowUpdateInterval);
+		default:
+			return 1u;
+		}
+	}
+
+	// Records this frame's level and time. True when the controller has to run this frame: the level's
+	// interval came round, the character has no pose yet, or it became more detailed (or visible again).
+	[[nodiscard]] inline bool BeginAnimationLodFrame(
+		AnimationLodState& lod,
+		AnimationLodLevel level,
+		const AnimationLodSettings& settings,
+		float deltaSeconds) noexcept
+	{
+		const AnimationLodLevel previousLevel = std::exchange(lod.level, level);
+		lod.pendingSeconds += deltaSeconds;
+		++lod.frameIndex;
+		++lod.framesSinceEvaluation;
+
+		if (level == AnimationLodLevel::Offscreen)
+		{
+			return false;
+		}
+		if (!lod.evaluated || level < previousLevel)
+		{
+			return true;
+		}
+		const std::uint32_t interval = AnimationLodUpdateInterval(settings, level);
+		return (lod.frameIndex + lod.stagger) % interval == 0u;
+	}
+
+	// Runs the controller at the LOD's detail with all the time gathered since its last run.
+	inline void EvaluateAnimationWithLod(
+		AnimationControllerRuntime& runtime,
+		AnimatorState& animator,
+		AnimationLodState& lod,
+		const AnimationLodSettings& settings)
+	{
+		const bool low = lod.level == AnimationLodLevel::Low;
+		runtime.lodPrimaryLayerOnly = low;
+		animator.maxEvaluatedBoneDepth = low ? settings.lowMaxBoneDepth : -1;
+
+		UpdateAnimationControllerRuntime(runtime, animator, lod.pendingSeconds);
+		lod.pendingSeconds = 0.0f;
+		lod.framesSinceEvaluation = 0;
+
+		if (lod.level != AnimationLodLevel::Reduced)
+		{
+			lod.previousPose.clear();
+			lod.currentPose.clear();
+		}
+		else
+		{
+			std::swap(lod.previousPose, lod.currentPose);
+			lod.currentPose = animator.localPose;
+			if (lod.evaluated && lod.previousPose.size() == lod.currentPose.size())
+			{
+				// Trail by one interval: start from the previous pose and reach this one by the next evaluation.
+				animator.localPose = lod.previousPose;
+				BuildAnimatorMatrices(animator);
+			}
+		}
+		lod.evaluated = true;
+	}
+
+	// A frame without a controller run: offscreen characters move their clocks on, Reduced ones blend
+	// towards the last evaluated pose, Low ones keep theirs.
+	inline void StepAnimationLodWithoutEvaluation(
+		AnimationControllerRuntime& runtime,
+		AnimatorState& animator,
+		AnimationLodState& lod,
+		const AnimationLodSettings& settings)
+	{
+		if (lod.level == AnimationLodLevel::Offscreen)
+		{
+			AdvanceAnimationControllerTime(runtime, animator, lod.pendingSeconds);
+			lod.pendingSeconds = 0.0f;
+			lod.previousPose.clear();
+			lod.currentPose.clear();
+			return;
+		}
+
+		if (lod.level != AnimationLodLevel::Reduced ||
+			lod.previousPose.empty() ||
+			lod.previousPose.size() != lod.currentPose.size())
+		{
+			return;
+		}
+
+		const float alpha = static_cast<float>(lod.framesSinceEvaluation) /
+			static_cast<float>(AnimationLodUpdateInterval(settings, lod.level));
+		BlendLocalPoses(animator.localPose, lod.previousPose, lod.currentPose, alpha);
+		BuildAnimatorMatrices(animator);
+	}
+}
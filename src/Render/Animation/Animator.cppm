@@ -3,6 +3,9 @@ module;
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 export module core:animator;
@@ -10,6 +13,9 @@ export module core:animator;
 import :animation_clip;
 import :math_utils;
 import :skeleton;
+import :memory_tracking;
+import :hash_utils;
+import :flat_hash_map;
 
 export namespace rendern
 {
@@ -20,6 +26,181 @@ export namespace rendern
 		mathUtils::Vec3 scale{ 1.0f, 1.0f, 1.0f };
 	};
 
+	// Key pair each track of a bone sampled last; forward playback usually finds the next sample there.
+	struct BoneKeyCursor
+	{
+		std::uint32_t translation{ 0u };
+		std::uint32_t rotation{ 0u };
+		std::uint32_t scale{ 0u };
+	};
+
+	// Channel -> bone remap of one clip on one skeleton. Depends only on the skeleton's bone names and
+	// hierarchy and on the clip's channel targets, so every animator playing an equal pair shares one
+	// (AnimationBindingCache).
+	struct ClipSkeletonBinding
+	{
+		std::uint32_t boneCount{ 0u };
+		std::uint32_t channelCount{ 0u };
+		std::vector<int> channelIndexByBone; // -1: the bone is not animated by the clip
+		std::vector<std::uint16_t> boneDepths; // counted from the root (0)
+	};
+
+	// Resolves the channels of `clip` (nullptr: none) against `skeleton`: by bone index when the clip was
+	// imported against it, by name otherwise.
+	[[nodiscard]] inline ClipSkeletonBinding BuildClipSkeletonBinding(const Skeleton& skeleton, const AnimationClip* clip)
+	{
+		const std::size_t boneCount = skeleton.bones.size();
+		ClipSkeletonBinding binding{};
+		binding.boneCount = static_cast<std::uint32_t>(boneCount);
+		binding.channelCount = (clip != nullptr) ? static_cast<std::uint32_t>(clip->channels.size()) : 0u;
+		binding.channelIndexByBone.assign(boneCount, -1);
+		binding.boneDepths.assign(boneCount, 0u);
+		for (std::size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+		{
+			const int parentIndex = skeleton.bones[boneIndex].parentIndex;
+			if (parentIndex >= 0 && static_cast<std::size_t>(parentIndex) < boneIndex)
+			{
+				binding.boneDepths[boneIndex] = static_cast<std::uint16_t>(binding.boneDepths[static_cast<std::size_t>(parentIndex)] + 1u);
+			}
+		}
+		if (clip == nullptr)
+		{
+			return binding;
+		}
+
+		for (std::size_t channelIndex = 0; channelIndex < clip->channels.size(); ++channelIndex)
+		{
+			const BoneAnimationChannel& channel = clip->channels[channelIndex];
+			int boneIndex = channel.boneIndex;
+
+			if (boneIndex < 0)
+			{
+				if (const auto found = FindBoneIndex(skeleton, channel.boneName))
+				{
+					boneIndex = static_cast<int>(*found);
+				}
+			}
+
+			if (boneIndex < 0 || boneIndex >= static_cast<int>(boneCount))
+			{
+				continue;
+			}
+
+			binding.channelIndexByBone[static_cast<std::size_t>(boneIndex)] = static_cast<int>(channelIndex);
+		}
+		return binding;
+	}
+
+	// Binding tables keyed by the (skeleton layout, clip channel layout) hash pair. A hit costs one hash
+	// combine and a lookup when the skeleton and clip carry their layout hashes (RebuildBoneNameLookup,
+	// RebuildClipChannelLayoutHash); otherwise the hashes are computed from the names, which still
+	// allocates nothing. Entries are immutable and shared: replacing a stale one leaves the animators
+	// holding it untouched. Thread safe (animators are updated in parallel).
+	class AnimationBindingCache
+	{
+	public:
+		[[nodiscard]] std::shared_ptr<const ClipSkeletonBinding> Get(const Skeleton& skeleton, const AnimationClip* clip)
+		{
+			const std::uint32_t boneCount = static_cast<std::uint32_t>(skeleton.bones.size());
+			const std::uint32_t channelCount = (clip != nullptr) ? static_cast<std::uint32_t>(clip->channels.size()) : 0u;
+
+			const bool skeletonHashed = skeleton.layoutHash != 0 && skeleton.boneNameLookup.size() == skeleton.bones.size();
+			const bool clipHashed = clip == nullptr || clip->channelLayoutHash != 0;
+			std::uint64_t key = MakeKey(
+				skeletonHashed ? skeleton.layoutHash : HashSkeletonLayout(skeleton),
+				(clip == nullptr) ? 0u : (clipHashed ? clip->channelLayoutHash : HashClipChannelLayout(*clip)));
+			if (auto found = Find(key, boneCount, channelCount))
+			{
+				return found;
+			}
+
+			// A stored hash older than an edit of the skeleton or clip: key by the current content instead.
+			if (skeletonHashed || (clip != nullptr && clipHashed))
+			{
+				key = MakeKey(HashSkeletonLayout(skeleton), (clip != nullptr) ? HashClipChannelLayout(*clip) : 0u);
+				if (auto found = Find(key, boneCount, channelCount))
+				{
+					return found;
+				}
+			}
+
+			// Built outside the lock; two threads missing on the same pair both build, the first insert wins.
+			auto binding = std::make_shared<const ClipSkeletonBinding>(BuildClipSkeletonBinding(skeleton, clip));
+
+			std::unique_lock lock(mutex_);
+			auto [it, inserted] = entries_.try_emplace(key, binding);
+			if (!inserted)
+			{
+				if (Matches(*it->second, boneCount, channelCount))
+				{
+					return it->second;
+				}
+				// Hash collision: the newer pair takes the slot.
+				bytes_ -= BindingBytes(*it->second);
+				it->second = binding;
+			}
+			bytes_ += BindingBytes(*binding);
+			trackedBytes_.Set(bytes_);
+			return binding;
+		}
+
+		// Animators keep the bindings they hold; the next Get rebuilds.
+		void Clear()
+		{
+			std::unique_lock lock(mutex_);
+			entries_.clear();
+			bytes_ = 0;
+			trackedBytes_.Set(0);
+		}
+
+		[[nodiscard]] std::size_t Size() const
+		{
+			std::shared_lock lock(mutex_);
+			return entries_.size();
+		}
+
+	private:
+		[[nodiscard]] static std::uint64_t MakeKey(std::uint64_t skeletonHash, std::uint64_t clipHash) noexcept
+		{
+			return hashUtils::Mix64(skeletonHash ^ hashUtils::Mix64(clipHash + 0x9e3779b97f4a7c15ull));
+		}
+
+		[[nodiscard]] static bool Matches(const ClipSkeletonBinding& binding, std::uint32_t boneCount, std::uint32_t channelCount) noexcept
+		{
+			return binding.boneCount == boneCount && binding.channelCount == channelCount;
+		}
+
+		[[nodiscard]] static std::size_t BindingBytes(const ClipSkeletonBinding& binding) noexcept
+		{
+			return sizeof(ClipSkeletonBinding) +
+				binding.channelIndexByBone.capacity() * sizeof(int) +
+				binding.boneDepths.capacity() * sizeof(std::uint16_t);
+		}
+
+		[[nodiscard]] std::shared_ptr<const ClipSkeletonBinding> Find(std::uint64_t key, std::uint32_t boneCount, std::uint32_t channelCount) const
+		{
+			std::shared_lock lock(mutex_);
+			const auto it = entries_.find(key);
+			if (it == entries_.end() || !Matches(*it->second, boneCount, channelCount))
+			{
+				return {};
+			}
+			return it->second;
+		}
+
+		mutable std::shared_mutex mutex_;
+		containers::FlatHashMap<std::uint64_t, std::shared_ptr<const ClipSkeletonBinding>> entries_;
+		std::size_t bytes_{ 0 };
+		memory::TrackedBytes trackedBytes_{ memory::MemoryTag::Animation };
+	};
+
+	// The cache every animator binds through.
+	[[nodiscard]] inline AnimationBindingCache& SharedAnimationBindingCache()
+	{
+		static AnimationBindingCache cache;
+		return cache;
+	}
+
 	struct AnimatorState
 	{
 		const Skeleton* skeleton{ nullptr };
@@ -30,13 +211,29 @@ export namespace rendern
 		bool looping{ true };
 		bool paused{ false };
 
-		std::vector<int> channelIndexByBone;
+		// Animation LOD: bones deeper in the hierarchy than this are not sampled and keep the local
+		// transform they had (-1 = every bone). Depths are counted from the root (0).
+		int maxEvaluatedBoneDepth{ -1 };
+
+		// Shared remap table of (skeleton, clip) from SharedAnimationBindingCache; not charged below.
+		std::shared_ptr<const ClipSkeletonBinding> binding;
+		std::vector<BoneKeyCursor> keyCursors;
 		std::vector<LocalBoneTransform> localPose;
-		std::vector<mathUtils::Mat4> localMatrices;
 		std::vector<mathUtils::Mat4> globalMatrices;
 		std::vector<mathUtils::Mat4> skinMatrices;
+
+		// Capacity of the vectors above, charged to the animation memory budget (UpdateAnimatorMemory).
+		memory::TrackedBytes trackedBytes{ memory::MemoryTag::Animation };
 	};
 
+	inline void UpdateAnimatorMemory(AnimatorState& state) noexcept
+	{
+		state.trackedBytes.Set(
+			state.keyCursors.capacity() * sizeof(BoneKeyCursor) +
+			state.localPose.capacity() * sizeof(LocalBoneTransform) +
+			(state.globalMatrices.capacity() + state.skinMatrices.capacity()) * sizeof(mathUtils::Mat4));
+	}
+
 	[[nodiscard]] inline LocalBoneTransform BlendLocalBoneTransform(
 		const LocalBoneTransform& from,
 		const LocalBoneTransform& to,
@@ -135,20 +332,24 @@ export namespace rendern
 	{
 		if (!IsAnimatorReady(state))
 		{
-			state.channelIndexByBone.clear();
+			state.binding.reset();
 			state.localPose.clear();
-			state.localMatrices.clear();
 			state.globalMatrices.clear();
 			state.skinMatrices.clear();
 			return;
 		}
 
+		// In place: a clip switch reuses the pose storage instead of allocating a new bind pose.
 		const std::size_t boneCount = state.skeleton->bones.size();
-		state.channelIndexByBone.assign(boneCount, -1);
-		state.localPose = BuildBindPoseLocalPose(*state.skeleton);
-		state.localMatrices.assign(boneCount, mathUtils::Mat4(1.0f));
+		state.localPose.resize(boneCount);
+		for (std::size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+		{
+			LocalBoneTransform& dst = state.localPose[boneIndex];
+			DecomposeTRS(state.skeleton->bones[boneIndex].bindLocalTransform, dst.translation, dst.rotation, dst.scale);
+		}
 		state.globalMatrices.assign(boneCount, mathUtils::Mat4(1.0f));
 		state.skinMatrices.assign(boneCount, mathUtils::Mat4(1.0f));
+		UpdateAnimatorMemory(state);
 	}
 
 	inline void ResetAnimatorToBindPose(AnimatorState& state, const Skeleton& skeleton)
@@ -157,40 +358,20 @@ export namespace rendern
 		ResetAnimatorToBindPose(state);
 	}
 
+	// A cache lookup (SharedAnimationBindingCache); allocates nothing once the pair has been bound and the
+	// cursors have grown to the bone count.
 	inline void RebuildAnimatorClipBinding(AnimatorState& state)
 	{
 		if (!IsAnimatorReady(state))
 		{
-			state.channelIndexByBone.clear();
-			return;
-		}
-
-		state.channelIndexByBone.assign(state.skeleton->bones.size(), -1);
-		if (state.clip == nullptr)
-		{
+			state.binding.reset();
+			state.keyCursors.clear();
 			return;
 		}
 
-		for (std::size_t channelIndex = 0; channelIndex < state.clip->channels.size(); ++channelIndex)
-		{
-			const BoneAnimationChannel& channel = state.clip->channels[channelIndex];
-			int boneIndex = channel.boneIndex;
-
-			if (boneIndex < 0)
-			{
-				if (const auto found = FindBoneIndex(*state.skeleton, channel.boneName))
-				{
-					boneIndex = static_cast<int>(*found);
-				}
-			}
-
-			if (boneIndex < 0 || boneIndex >= static_cast<int>(state.channelIndexByBone.size()))
-			{
-				continue;
-			}
-
-			state.channelIndexByBone[static_cast<std::size_t>(boneIndex)] = static_cast<int>(channelIndex);
-		}
+		state.binding = SharedAnimationBindingCache().Get(*state.skeleton, state.clip);
+		state.keyCursors.assign(state.skeleton->bones.size(), BoneKeyCursor{});
+		UpdateAnimatorMemory(state);
 	}
 
 	inline void InitializeAnimator(AnimatorState& state, const Skeleton* skeleton, const AnimationClip* clip = nullptr)
@@ -296,7 +477,23 @@ export namespace rendern
 			RebuildAnimatorClipBinding(state);
 		}
 
-		state.localPose = BuildBindPoseLocalPose(*state.skeleton);
+		const ClipSkeletonBinding* binding = state.binding.get();
+		const bool limitDepth =
+			state.maxEvaluatedBoneDepth >= 0 &&
+			binding != nullptr && binding->boneDepths.size() == state.localPose.size();
+		const auto skipBone = [&state, binding, limitDepth](std::size_t boneIndex) noexcept
+			{
+				return limitDepth && static_cast<int>(binding->boneDepths[boneIndex]) > state.maxEvaluatedBoneDepth;
+			};
+
+		for (std::size_t boneIndex = 0; boneIndex < state.localPose.size(); ++boneIndex)
+		{
+			if (!skipBone(boneIndex))
+			{
+				LocalBoneTransform& dst = state.localPose[boneIndex];
+				DecomposeTRS(state.skeleton->bones[boneIndex].bindLocalTransform, dst.translation, dst.rotation, dst.scale);
+			}
+		}
 
 		if (state.clip == nullptr || !IsValidAnimationClip(*state.clip))
 		{
@@ -305,12 +502,22 @@ export namespace rendern
 
 		const float timeSeconds = NormalizeAnimationTimeSeconds(*state.clip, state.timeSeconds, state.looping);
 		const float timeTicks = timeSeconds * state.clip->ticksPerSecond;
+		if (state.keyCursors.size() != state.localPose.size())
+		{
+			state.keyCursors.assign(state.localPose.size(), BoneKeyCursor{});
+			UpdateAnimatorMemory(state);
+		}
 
 		for (std::size_t boneIndex = 0; boneIndex < state.localPose.size(); ++boneIndex)
 		{
+			if (skipBone(boneIndex))
+			{
+				continue;
+			}
+
 			const int channelIndex =
-				(boneIndex < state.channelIndexByBone.size())
-				? state.channelIndexByBone[boneIndex]
+				(binding != nullptr && boneIndex < binding->channelIndexByBone.size())
+				? binding->channelIndexByBone[boneIndex]
 				: -1;
 
 			if (channelIndex < 0 || channelIndex >= static_cast<int>(state.clip->channels.size()))
@@ -320,10 +527,13 @@ export namespace rendern
 
 			const BoneAnimationChannel& channel = state.clip->channels[static_cast<std::size_t>(channelIndex)];
 			LocalBoneTransform& dst = state.localPose[boneIndex];
+			BoneKeyCursor& cursor = state.keyCursors[boneIndex];
+
+			const float durationTicks = state.clip->durationTicks;
 
-			dst.translation = SampleTranslationKeys(channel.translationKeys, timeTicks, dst.translation);
-			dst.rotation = SampleRotationKeys(channel.rotationKeys, timeTicks, dst.rotation);
-			dst.scale = SampleScaleKeys(channel.scaleKeys, timeTicks, dst.scale);
+			dst.translation = SampleChannelTranslation(channel, timeTicks, durationTicks, dst.translation, cursor.translation);
+			dst.rotation = SampleChannelRotation(channel, timeTicks, durationTicks, dst.rotation, cursor.rotation);
+			dst.scale = SampleChannelScale(channel, timeTicks, durationTicks, dst.scale, cursor.scale);
 		}
 	}
 
@@ -355,31 +565,21 @@ export namespace rendern
 			ResetAnimatorToBindPose(state);
 		}
 
-		state.localMatrices.resize(boneCount, mathUtils::Mat4(1.0f));
 		state.globalMatrices.resize(boneCount, mathUtils::Mat4(1.0f));
 		state.skinMatrices.resize(boneCount, mathUtils::Mat4(1.0f));
+		UpdateAnimatorMemory(state);
 
+		// One pass: parents come before their children, so the local matrix is composed and consumed in
+		// place instead of going through a separate array.
 		for (std::size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex)
 		{
 			const LocalBoneTransform& trs = state.localPose[boneIndex];
-			state.localMatrices[boneIndex] = ComposeTRS(trs.translation, trs.rotation, trs.scale);
-		}
-
-		for (std::size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex)
-		{
+			const mathUtils::Mat4 local = ComposeTRS(trs.translation, trs.rotation, trs.scale);
 			const int parentIndex = state.skeleton->bones[boneIndex].parentIndex;
 
-			if (parentIndex >= 0)
-			{
-				state.globalMatrices[boneIndex] =
-					state.globalMatrices[static_cast<std::size_t>(parentIndex)] *
-					state.localMatrices[boneIndex];
-			}
-			else
-			{
-				state.globalMatrices[boneIndex] = state.localMatrices[boneIndex];
-			}
-
+			state.globalMatrices[boneIndex] = (parentIndex >= 0)
+				? state.globalMatrices[static_cast<std::size_t>(parentIndex)] * local
+				: local;
 			state.skinMatrices[boneIndex] =
 				state.globalMatrices[boneIndex] *
 				state.skeleton->bones[boneIndex].inverseBindMatrix;
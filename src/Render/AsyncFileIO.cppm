@@ -0,0 +1,460 @@
+module;
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+export module core:async_file_io;
+
+import :job_system;
+import :file_system;
+
+// Whole-file reads off the decode workers. Callers submit a batch of paths and get one
+// callback with every file's bytes once the whole batch is read, so a decode job is only
+// queued when it can run without touching the disk.
+//
+// Windows: overlapped reads on an I/O completion port, driven by one thread that keeps up to
+// `maxReadsInFlight` files in flight. Elsewhere: a small pool of threads doing blocking reads.
+// Reads of the same path that overlap in time are coalesced into one and share the bytes.
+// Files in a mounted pack are copied (or decompressed) out of the archive instead.
+
+export namespace corefs
+{
+	namespace fs = std::filesystem;
+
+	struct FileReadResult
+	{
+		fs::path path;
+		std::shared_ptr<const std::vector<std::byte>> data{};
+		std::string error{};
+
+		[[nodiscard]] bool Ok() const noexcept { return error.empty() && data != nullptr; }
+
+		std::span<const std::byte> Bytes() const noexcept
+		{
+			return data ? std::span<const std::byte>(*data) : std::span<const std::byte>{};
+		}
+	};
+
+	// Results are in request order. Runs on an I/O thread: queue work, don't do it.
+	using FileReadBatchCallback = std::function<void(std::vector<FileReadResult>&& results)>;
+
+	class AsyncFileReader
+	{
+	public:
+		explicit AsyncFileReader(std::size_t maxReadsInFlight = 8)
+			: maxReadsInFlight_(std::max<std::size_t>(1, maxReadsInFlight))
+		{
+#if defined(_WIN32)
+			port_ = ::CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+			threads_.emplace_back([this] { CompletionLoop_(); });
+#else
+			const std::size_t threadCount = std::min<std::size_t>(maxReadsInFlight_, 4);
+			for (std::size_t i = 0; i < threadCount; ++i)
+			{
+				threads_.emplace_back([this] { WorkerLoop_(); });
+			}
+#endif
+		}
+
+		AsyncFileReader(const AsyncFileReader&) = delete;
+		AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+		// Queued reads are dropped without a callback; reads already running finish first.
+		~AsyncFileReader()
+		{
+			{
+				std::scoped_lock lock(mutex_);
+				stop_ = true;
+				for (const std::shared_ptr<Read_>& read : queue_)
+				{
+					readsByPath_.erase(read->key);
+				}
+				queue_.clear();
+			}
+			Wake_();
+			for (std::thread& thread : threads_)
+			{
+				thread.join();
+			}
+#if defined(_WIN32)
+			if (port_ != nullptr)
+			{
+				::CloseHandle(port_);
+			}
+#endif
+		}
+
+		// Files of a batch whose token is cancelled before their read starts are not read (error
+		// "cancelled"); the callback still runs.
+		void ReadBatch(std::vector<fs::path> paths, FileReadBatchCallback onComplete, jobs::CancellationToken cancellation = {})
+		{
+			auto batch = std::make_shared<Batch_>();
+			batch->results.resize(paths.size());
+			batch->remaining.store(paths.size(), std::memory_order_relaxed);
+			batch->onComplete = std::move(onComplete);
+			batch->cancellation = std::move(cancellation);
+
+			if (paths.empty())
+			{
+				batch->onComplete(std::move(batch->results));
+				return;
+			}
+
+			{
+				std::scoped_lock lock(mutex_);
+				for (std::size_t i = 0; i < paths.size(); ++i)
+				{
+					std::string key = paths[i].lexically_normal().generic_string();
+					auto it = readsByPath_.find(key);
+					if (it == readsByPath_.end())
+					{
+						auto read = std::make_shared<Read_>();
+						read->path = std::move(paths[i]);
+						read->key = key;
+						it = readsByPath_.emplace(std::move(key), read).first;
+						queue_.push_back(std::move(read));
+					}
+					it->second->waiters.emplace_back(batch, i);
+				}
+			}
+			Wake_();
+		}
+
+		// Blocks until nothing is queued or being read (all callbacks of finished reads returned).
+		void WaitIdle()
+		{
+			std::unique_lock lock(mutex_);
+			idleCv_.wait(lock, [this] { return queue_.empty() && running_ == 0; });
+		}
+
+	private:
+		struct Batch_
+		{
+			std::vector<FileReadResult> results;
+			std::atomic<std::size_t> remaining{ 0 };
+			FileReadBatchCallback onComplete;
+			jobs::CancellationToken cancellation;
+		};
+
+		struct Read_
+		{
+			fs::path path;
+			std::string key;
+			std::vector<std::pair<std::shared_ptr<Batch_>, std::size_t>> waiters;
+
+			std::shared_ptr<std::vector<std::byte>> data;
+			std::string error;
+		};
+
+		// Next queued read (counted as running), or null once stopping and drained. Queued reads
+		// every waiter of which was cancelled complete right away.
+		std::shared_ptr<Read_> TryPopRead_()
+		{
+			std::scoped_lock lock(mutex_);
+			if (queue_.empty())
+			{
+				return {};
+			}
+			std::shared_ptr<Read_> read = std::move(queue_.front());
+			queue_.pop_front();
+			++running_;
+
+			const bool wanted = std::any_of(read->waiters.begin(), read->waiters.end(), [](const auto& waiter)
+				{
+					return !waiter.first->cancellation.IsCancelled();
+				});
+			if (!wanted)
+			{
+				read->error = "cancelled";
+			}
+			return read;
+		}
+
+		// True if `read` was served from a mounted pack (bytes or error set).
+		static bool TryReadPacked_(Read_& read)
+		{
+			try
+			{
+				const std::optional<PackedFile> packed = OpenPackedFile(read.path);
+				if (!packed)
+				{
+					return false;
+				}
+				read.data = std::make_shared<std::vector<std::byte>>(packed->bytes.begin(), packed->bytes.end());
+			}
+			catch (const std::exception& e)
+			{
+				read.error = e.what();
+			}
+			return true;
+		}
+
+		void Complete_(std::shared_ptr<Read_> read)
+		{
+			std::vector<std::pair<std::shared_ptr<Batch_>, std::size_t>> waiters;
+			{
+				std::scoped_lock lock(mutex_);
+				readsByPath_.erase(read->key);
+				waiters = std::move(read->waiters);
+			}
+
+			std::shared_ptr<const std::vector<std::byte>> data = read->error.empty() ? std::move(read->data) : nullptr;
+			for (auto& [batch, index] : waiters)
+			{
+				batch->results[index] = FileReadResult{ read->path, data, read->error };
+				if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					batch->onComplete(std::move(batch->results));
+				}
+			}
+
+			{
+				std::scoped_lock lock(mutex_);
+				--running_;
+			}
+			idleCv_.notify_all();
+		}
+
+#if defined(_WIN32)
+		static constexpr DWORD kChunkBytes = 8u * 1024u * 1024u;
+
+		struct OverlappedRead_
+		{
+			OVERLAPPED overlapped{};
+			HANDLE file{ INVALID_HANDLE_VALUE };
+			std::uint64_t offset{ 0 };
+			std::shared_ptr<Read_> read;
+		};
+
+		void Wake_()
+		{
+			::PostQueuedCompletionStatus(port_, 0, 0, nullptr);
+		}
+
+		// False (error set) if the read could not be queued.
+		bool IssueChunk_(OverlappedRead_& op)
+		{
+			std::vector<std::byte>& bytes = *op.read->data;
+			const std::uint64_t left = bytes.size() - op.offset;
+			const DWORD chunk = static_cast<DWORD>(std::min<std::uint64_t>(left, kChunkBytes));
+
+			op.overlapped = OVERLAPPED{};
+			op.overlapped.Offset = static_cast<DWORD>(op.offset & 0xFFFFFFFFull);
+			op.overlapped.OffsetHigh = static_cast<DWORD>(op.offset >> 32);
+			if (!::ReadFile(op.file, bytes.data() + op.offset, chunk, nullptr, &op.overlapped) &&
+				::GetLastError() != ERROR_IO_PENDING)
+			{
+				op.read->error = "Failed to read file: " + op.read->path.string();
+				return false;
+			}
+			return true;
+		}
+
+		void Finish_(OverlappedRead_* op)
+		{
+			::CloseHandle(op->file);
+			std::shared_ptr<Read_> read = std::move(op->read);
+			std::erase_if(active_, [op](const std::unique_ptr<OverlappedRead_>& candidate) { return candidate.get() == op; });
+			Complete_(std::move(read));
+		}
+
+		// Opens and issues the first chunk of queued reads while below the in-flight limit.
+		void StartQueuedReads_()
+		{
+			while (active_.size() < maxReadsInFlight_)
+			{
+				std::shared_ptr<Read_> read = TryPopRead_();
+				if (!read)
+				{
+					return;
+				}
+				if (!read->error.empty() || TryReadPacked_(*read))
+				{
+					Complete_(std::move(read));
+					continue;
+				}
+
+				HANDLE file = ::CreateFileW(read->path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+					FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+				LARGE_INTEGER size{};
+				if (file == INVALID_HANDLE_VALUE || !::GetFileSizeEx(file, &size) ||
+					::CreateIoCompletionPort(file, port_, 0, 0) == nullptr)
+				{
+					if (file != INVALID_HANDLE_VALUE)
+					{
+						::CloseHandle(file);
+					}
+					read->error = "Failed to open file: " + read->path.string();
+					Complete_(std::move(read));
+					continue;
+				}
+
+				read->data = std::make_shared<std::vector<std::byte>>(static_cast<std::size_t>(size.QuadPart));
+				if (read->data->empty())
+				{
+					::CloseHandle(file);
+					Complete_(std::move(read));
+					continue;
+				}
+
+				auto op = std::make_unique<OverlappedRead_>();
+				op->file = file;
+				op->read = std::move(read);
+				OverlappedRead_* raw = op.get();
+				active_.push_back(std::move(op));
+				if (!IssueChunk_(*raw))
+				{
+					Finish_(raw);
+				}
+			}
+		}
+
+		void CompletionLoop_()
+		{
+			for (;;)
+			{
+				StartQueuedReads_();
+				{
+					std::scoped_lock lock(mutex_);
+					if (stop_ && active_.empty())
+					{
+						return;
+					}
+				}
+
+				DWORD transferred = 0;
+				ULONG_PTR key = 0;
+				OVERLAPPED* overlapped = nullptr;
+				const BOOL ok = ::GetQueuedCompletionStatus(port_, &transferred, &key, &overlapped, INFINITE);
+				if (overlapped == nullptr)
+				{
+					continue; // Wake_
+				}
+
+				OverlappedRead_* op = CONTAINING_RECORD(overlapped, OverlappedRead_, overlapped);
+				if (!ok || transferred == 0)
+				{
+					op->read->error = "Failed to read file: " + op->read->path.string();
+					Finish_(op);
+					continue;
+				}
+
+				op->offset += transferred;
+				if (op->offset >= op->read->data->size() || !IssueChunk_(*op))
+				{
+					Finish_(op);
+				}
+			}
+		}
+
+		HANDLE port_{ nullptr };
+		std::vector<std::unique_ptr<OverlappedRead_>> active_; // completion thread only
+#else
+		void Wake_()
+		{
+			queueCv_.notify_all();
+		}
+
+		static void ReadWholeFile_(Read_& read)
+		{
+			const int fd = ::open(read.path.c_str(), O_RDONLY);
+			struct stat st{};
+			if (fd < 0 || ::fstat(fd, &st) != 0)
+			{
+				if (fd >= 0)
+				{
+					::close(fd);
+				}
+				read.error = "Failed to open file: " + read.path.string();
+				return;
+			}
+
+			read.data = std::make_shared<std::vector<std::byte>>(static_cast<std::size_t>(st.st_size));
+			std::size_t offset = 0;
+			while (offset < read.data->size())
+			{
+				const ::ssize_t n = ::read(fd, read.data->data() + offset, read.data->size() - offset);
+				if (n < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				if (n <= 0)
+				{
+					read.error = "Failed to read file: " + read.path.string();
+					break;
+				}
+				offset += static_cast<std::size_t>(n);
+			}
+			::close(fd);
+		}
+
+		void WorkerLoop_()
+		{
+			for (;;)
+			{
+				{
+					std::unique_lock lock(mutex_);
+					queueCv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+					if (stop_ && queue_.empty())
+					{
+						return;
+					}
+				}
+
+				std::shared_ptr<Read_> read = TryPopRead_();
+				if (!read)
+				{
+					continue;
+				}
+				if (read->error.empty() && !TryReadPacked_(*read))
+				{
+					ReadWholeFile_(*read);
+				}
+				Complete_(std::move(read));
+			}
+		}
+
+		std::condition_variable queueCv_;
+#endif
+
+		const std::size_t maxReadsInFlight_;
+
+		std::mutex mutex_;
+		std::condition_variable idleCv_;
+		std::deque<std::shared_ptr<Read_>> queue_;
+		std::unordered_map<std::string, std::shared_ptr<Read_>> readsByPath_; // queued or running
+		std::size_t running_{ 0 };
+		bool stop_{ false };
+
+		std::vector<std::thread> threads_;
+	};
+}
@@ -28,11 +28,17 @@ export namespace rendern
 			device_.UpdateTextureDescriptor(index, texture);
 		}
 
+		// The index stays valid for the frames already in flight; the backend recycles it after they retire.
 		void UnregisterTexture(rhi::TextureDescIndex index) noexcept
 		{
 			device_.FreeTextureDescriptor(index);
 		}
 
+		rhi::DescriptorSlotAllocator::Stats GetStats() const
+		{
+			return device_.GetDescriptorHeapStats();
+		}
+
 	private:
 		rhi::IRHIDevice& device_;
 	};
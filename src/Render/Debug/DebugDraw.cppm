@@ -26,17 +26,154 @@ export namespace rendern::debugDraw
 			| (static_cast<std::uint32_t>(a) << 24);
 	}
 
+	// Wire shapes drawn instanced from one unit line mesh each, instead of being expanded into
+	// line vertices on the CPU.
+	enum class DebugShape : std::uint8_t
+	{
+		Box,     // edges of the [-1, 1] cube
+		Sphere,  // three great circles of the unit sphere
+		Capsule, // unit-radius capsule along Y (see DebugShapeVertex::capSide)
+		Axis     // +-1 cross on each axis
+	};
+
+	inline constexpr std::size_t kDebugShapeCount = 4;
+
+	// Vertex of a unit shape mesh (line list).
+	struct DebugShapeVertex
+	{
+		mathUtils::Vec3 pos{};
+		// Capsule only: -1/+1 for vertices of the bottom/top half, which are pushed out along the
+		// capsule axis by the instance's capsuleHalfLength. 0 for every other shape.
+		float capSide{ 0.0f };
+	};
+	static_assert(sizeof(DebugShapeVertex) == 16);
+
+	// Per-instance data. The unit mesh is placed as
+	//   center + axisX * p.x + axisY * p.y + axisZ * p.z + normalize(axisY) * capSide * capsuleHalfLength
+	// so the axes carry orientation and size (half extents for a box, radius for a sphere/capsule).
+	struct DebugShapeInstance
+	{
+		mathUtils::Vec3 center{};
+		float capsuleHalfLength{ 0.0f };
+		mathUtils::Vec3 axisX{ 1.0f, 0.0f, 0.0f };
+		mathUtils::Vec3 axisY{ 0.0f, 1.0f, 0.0f };
+		mathUtils::Vec3 axisZ{ 0.0f, 0.0f, 1.0f };
+		std::uint32_t rgba{ 0xffffffffu };
+	};
+	static_assert(sizeof(DebugShapeInstance) == 56);
+
+	// Line-list vertices of the unit mesh for `shape`; `segments` is the tessellation of a full circle.
+	inline std::vector<DebugShapeVertex> BuildUnitShapeLines(DebugShape shape, std::uint32_t segments = 32)
+	{
+		segments = std::max(segments, 8u) & ~1u;
+
+		std::vector<DebugShapeVertex> out;
+		auto Line = [&out](const mathUtils::Vec3& a, const mathUtils::Vec3& b, float capSideA = 0.0f, float capSideB = 0.0f)
+			{
+				out.push_back(DebugShapeVertex{ a, capSideA });
+				out.push_back(DebugShapeVertex{ b, capSideB });
+			};
+		// Arc from angle t0 to t1 in the plane spanned by a and b.
+		auto Arc = [&](const mathUtils::Vec3& a, const mathUtils::Vec3& b, float t0, float t1, std::uint32_t steps, float capSide)
+			{
+				mathUtils::Vec3 prev = a * std::cos(t0) + b * std::sin(t0);
+				for (std::uint32_t i = 1; i <= steps; ++i)
+				{
+					const float t = std::lerp(t0, t1, static_cast<float>(i) / static_cast<float>(steps));
+					const mathUtils::Vec3 p = a * std::cos(t) + b * std::sin(t);
+					Line(prev, p, capSide, capSide);
+					prev = p;
+				}
+			};
+
+		const mathUtils::Vec3 x(1.0f, 0.0f, 0.0f);
+		const mathUtils::Vec3 y(0.0f, 1.0f, 0.0f);
+		const mathUtils::Vec3 z(0.0f, 0.0f, 1.0f);
+		const float twoPi = mathUtils::Pi * 2.0f;
+
+		switch (shape)
+		{
+		case DebugShape::Box:
+		{
+			out.reserve(24);
+			for (int i = 0; i < 4; ++i)
+			{
+				const float u = (i & 1) ? 1.0f : -1.0f;
+				const float v = (i & 2) ? 1.0f : -1.0f;
+				Line(mathUtils::Vec3(-1.0f, u, v), mathUtils::Vec3(1.0f, u, v));
+				Line(mathUtils::Vec3(u, -1.0f, v), mathUtils::Vec3(u, 1.0f, v));
+				Line(mathUtils::Vec3(u, v, -1.0f), mathUtils::Vec3(u, v, 1.0f));
+			}
+			break;
+		}
+		case DebugShape::Sphere:
+			out.reserve(segments * 6);
+			Arc(x, y, 0.0f, twoPi, segments, 0.0f);
+			Arc(x, z, 0.0f, twoPi, segments, 0.0f);
+			Arc(y, z, 0.0f, twoPi, segments, 0.0f);
+			break;
+		case DebugShape::Capsule:
+		{
+			const std::uint32_t half = segments / 2;
+			out.reserve(segments * 8 + 8);
+			// Rings where the cylinder meets the caps, the four side lines and two half circles per cap.
+			Arc(x, z, 0.0f, twoPi, segments, -1.0f);
+			Arc(x, z, 0.0f, twoPi, segments, 1.0f);
+			for (const mathUtils::Vec3& side : { x, -x, z, -z })
+			{
+				Line(side, side, -1.0f, 1.0f);
+			}
+			Arc(x, y, 0.0f, mathUtils::Pi, half, 1.0f);
+			Arc(z, y, 0.0f, mathUtils::Pi, half, 1.0f);
+			Arc(x, -y, 0.0f, mathUtils::Pi, half, -1.0f);
+			Arc(z, -y, 0.0f, mathUtils::Pi, half, -1.0f);
+			break;
+		}
+		case DebugShape::Axis:
+			out.reserve(6);
+			Line(-x, x);
+			Line(-y, y);
+			Line(-z, z);
+			break;
+		}
+		return out;
+	}
+
 	struct DebugDrawList
 	{
 		std::vector<DebugVertex> lineVertices;
 		std::vector<DebugVertex> overlayLineVertices;
 		std::vector<DebugVertex> screenOverlayLineVertices;
 
+		// Instanced shapes, indexed by DebugShape (depth-tested / overlay).
+		std::array<std::vector<DebugShapeInstance>, kDebugShapeCount> shapeInstances;
+		std::array<std::vector<DebugShapeInstance>, kDebugShapeCount> overlayShapeInstances;
+
 		void Clear()
 		{
 			lineVertices.clear();
 			overlayLineVertices.clear();
 			screenOverlayLineVertices.clear();
+			for (std::size_t i = 0; i < kDebugShapeCount; ++i)
+			{
+				shapeInstances[i].clear();
+				overlayShapeInstances[i].clear();
+			}
+		}
+
+		bool Empty() const noexcept
+		{
+			return VertexCount() == 0 && ShapeInstanceCount() == 0;
+		}
+
+		std::size_t ShapeInstanceCount() const noexcept
+		{
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < kDebugShapeCount; ++i)
+			{
+				count += shapeInstances[i].size() + overlayShapeInstances[i].size();
+			}
+			return count;
 		}
 
 		void ReserveLines(std::size_t lineCount)
@@ -81,6 +218,83 @@ export namespace rendern::debugDraw
 			dst.push_back(DebugVertex{ b, rgba });
 		}
 
+		void AddShape(DebugShape shape, const DebugShapeInstance& instance, bool overlay = false)
+		{
+			auto& dst = overlay ? overlayShapeInstances : shapeInstances;
+			dst[static_cast<std::size_t>(shape)].push_back(instance);
+		}
+
+		// Axes are scaled to the half extents.
+		void AddOrientedBox(const mathUtils::Vec3& center,
+			const mathUtils::Vec3& axisX,
+			const mathUtils::Vec3& axisY,
+			const mathUtils::Vec3& axisZ,
+			std::uint32_t rgba,
+			bool overlay = false)
+		{
+			AddShape(DebugShape::Box, DebugShapeInstance{ center, 0.0f, axisX, axisY, axisZ, rgba }, overlay);
+		}
+
+		void AddBox(const mathUtils::Vec3& center, const mathUtils::Vec3& halfExtents, std::uint32_t rgba, bool overlay = false)
+		{
+			AddOrientedBox(center,
+				mathUtils::Vec3(halfExtents.x, 0.0f, 0.0f),
+				mathUtils::Vec3(0.0f, halfExtents.y, 0.0f),
+				mathUtils::Vec3(0.0f, 0.0f, halfExtents.z),
+				rgba, overlay);
+		}
+
+		void AddAabb(const mathUtils::Vec3& bmin, const mathUtils::Vec3& bmax, std::uint32_t rgba, bool overlay = false)
+		{
+			AddBox((bmin + bmax) * 0.5f, (bmax - bmin) * 0.5f, rgba, overlay);
+		}
+
+		void AddSphere(const mathUtils::Vec3& center, float radius, std::uint32_t rgba, bool overlay = false)
+		{
+			if (radius <= 1e-5f)
+			{
+				return;
+			}
+			AddShape(DebugShape::Sphere, DebugShapeInstance{
+				center, 0.0f,
+				mathUtils::Vec3(radius, 0.0f, 0.0f), mathUtils::Vec3(0.0f, radius, 0.0f), mathUtils::Vec3(0.0f, 0.0f, radius),
+				rgba }, overlay);
+		}
+
+		// Capsule around the segment a-b.
+		void AddCapsule(const mathUtils::Vec3& a, const mathUtils::Vec3& b, float radius, std::uint32_t rgba, bool overlay = false)
+		{
+			if (radius <= 1e-5f)
+			{
+				return;
+			}
+
+			const mathUtils::Vec3 dir = b - a;
+			const float len = mathUtils::Length(dir);
+			const mathUtils::Vec3 up = (len > 1e-5f) ? dir / len : mathUtils::Vec3(0.0f, 1.0f, 0.0f);
+			mathUtils::Vec3 ref = mathUtils::Vec3(1.0f, 0.0f, 0.0f);
+			if (std::abs(mathUtils::Dot(up, ref)) > 0.95f)
+			{
+				ref = mathUtils::Vec3(0.0f, 0.0f, 1.0f);
+			}
+			const mathUtils::Vec3 side = mathUtils::Normalize(mathUtils::Cross(ref, up));
+			const mathUtils::Vec3 side2 = mathUtils::Cross(up, side);
+
+			AddShape(DebugShape::Capsule, DebugShapeInstance{
+				(a + b) * 0.5f, len * 0.5f,
+				side2 * radius, up * radius, side * radius,
+				rgba }, overlay);
+		}
+
+		// Instanced equivalent of AddAxesCross.
+		void AddAxis(const mathUtils::Vec3& origin, float halfSize, std::uint32_t rgba, bool overlay = false)
+		{
+			AddShape(DebugShape::Axis, DebugShapeInstance{
+				origin, 0.0f,
+				mathUtils::Vec3(halfSize, 0.0f, 0.0f), mathUtils::Vec3(0.0f, halfSize, 0.0f), mathUtils::Vec3(0.0f, 0.0f, halfSize),
+				rgba }, overlay);
+		}
+
 		void AddScreenSpaceLineNdc(const mathUtils::Vec3& a, const mathUtils::Vec3& b, std::uint32_t rgba)
 		{
 			screenOverlayLineVertices.push_back(DebugVertex{ a, rgba });
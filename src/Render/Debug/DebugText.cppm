@@ -38,6 +38,92 @@ export namespace rendern::debugText
 			| (static_cast<std::uint32_t>(a) << 24);
 	}
 
+	// One visible glyph of a laid-out string, in glyph cells from the text origin (a cell is
+	// DebugTextList::kGlyphAdvanceCols x kLineAdvanceRows font pixels).
+	struct GlyphPlacement
+	{
+		std::uint16_t column{ 0 };
+		std::uint16_t line{ 0 };
+		char ch{ ' ' };
+	};
+
+	// Spaces and newlines take up room but produce no placement.
+	inline std::vector<GlyphPlacement> LayoutText(std::string_view text)
+	{
+		std::vector<GlyphPlacement> out;
+		out.reserve(text.size());
+		std::uint16_t column = 0;
+		std::uint16_t line = 0;
+		for (const char c : text)
+		{
+			if (c == '\n')
+			{
+				column = 0;
+				++line;
+				continue;
+			}
+			if (c != ' ')
+			{
+				out.push_back(GlyphPlacement{ column, line, c });
+			}
+			++column;
+		}
+		return out;
+	}
+
+	// Layouts keyed by string hash and reused across frames, so labels that repeat every frame
+	// are laid out once. EndFrame drops entries that went unused for a while.
+	class TextLayoutCache
+	{
+	public:
+		const std::vector<GlyphPlacement>& Get(std::string_view text)
+		{
+			const std::size_t key = std::hash<std::string_view>{}(text);
+			auto [it, inserted] = entries_.try_emplace(key);
+			Entry& entry = it->second;
+			if (inserted || entry.text != text)
+			{
+				entry.text.assign(text);
+				entry.glyphs = LayoutText(text);
+				++misses_;
+			}
+			else
+			{
+				++hits_;
+			}
+			entry.lastUsedFrame = frame_;
+			return entry.glyphs;
+		}
+
+		void EndFrame(std::uint32_t maxIdleFrames = 120)
+		{
+			std::erase_if(entries_, [&](const auto& kv) { return frame_ - kv.second.lastUsedFrame > maxIdleFrames; });
+			++frame_;
+		}
+
+		void Clear()
+		{
+			entries_.clear();
+		}
+
+		std::size_t Size() const noexcept { return entries_.size(); }
+		std::uint64_t Hits() const noexcept { return hits_; }
+		std::uint64_t Misses() const noexcept { return misses_; }
+
+	private:
+		struct Entry
+		{
+			std::string text;
+			std::vector<GlyphPlacement> glyphs;
+			std::uint64_t lastUsedFrame{ 0 };
+		};
+
+		std::unordered_map<std::size_t, Entry> entries_;
+		std::uint64_t frame_{ 0 };
+		std::uint64_t hits_{ 0 };
+		std::uint64_t misses_{ 0 };
+	};
+
 	struct DebugTextItem
 	{
 		float xPx{ 0.0f };
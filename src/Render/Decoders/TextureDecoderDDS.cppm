@@ -0,0 +1,354 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+export module core:texture_decoder_dds;
+
+import :resource_manager_core;
+import :file_system;
+
+// Pre-baked DDS container: BC1/BC3/BC5/BC7 (legacy FourCC or DX10 header) and plain 32-bit
+// RGBA/BGRA, 2D or cubemap, with whatever mip chain was baked into the file. Blocks are copied
+// through untouched, so no CPU mip generation or conversion runs on load (BGRA is swizzled,
+// it is the only exception).
+//
+// TextureProperties::srgb still decides the view format, like for PNG/JPG; the file's
+// _SRGB/_UNORM choice is not used. generateMips and flipY are ignored: mips come from the
+// file and block data cannot be flipped cheaply.
+
+namespace dds
+{
+	constexpr std::uint32_t MakeFourCC(char a, char b, char c, char d) noexcept
+	{
+		return static_cast<std::uint32_t>(static_cast<unsigned char>(a))
+			| (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8)
+			| (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16)
+			| (static_cast<std::uint32_t>(static_cast<unsigned char>(d)) << 24);
+	}
+
+	constexpr std::uint32_t kMagic = MakeFourCC('D', 'D', 'S', ' ');
+
+	constexpr std::uint32_t kFlagMipMapCount = 0x20000u;
+	constexpr std::uint32_t kPixelFourCC = 0x4u;
+	constexpr std::uint32_t kPixelRGB = 0x40u;
+	constexpr std::uint32_t kCaps2Cubemap = 0x200u;
+	constexpr std::uint32_t kCaps2AllFaces = 0xFC00u;
+	constexpr std::uint32_t kDx10MiscTextureCube = 0x4u;
+
+	// D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION, which is also the cube face limit.
+	constexpr std::uint32_t kMaxDimension = 16384u;
+
+	struct PixelFormat
+	{
+		std::uint32_t size;
+		std::uint32_t flags;
+		std::uint32_t fourCC;
+		std::uint32_t rgbBitCount;
+		std::uint32_t rMask;
+		std::uint32_t gMask;
+		std::uint32_t bMask;
+		std::uint32_t aMask;
+	};
+
+	struct Header
+	{
+		std::uint32_t size;
+		std::uint32_t flags;
+		std::uint32_t height;
+		std::uint32_t width;
+		std::uint32_t pitchOrLinearSize;
+		std::uint32_t depth;
+		std::uint32_t mipMapCount;
+		std::uint32_t reserved1[11];
+		PixelFormat pixelFormat;
+		std::uint32_t caps;
+		std::uint32_t caps2;
+		std::uint32_t caps3;
+		std::uint32_t caps4;
+		std::uint32_t reserved2;
+	};
+
+	struct HeaderDx10
+	{
+		std::uint32_t dxgiFormat;
+		std::uint32_t resourceDimension;
+		std::uint32_t miscFlag;
+		std::uint32_t arraySize;
+		std::uint32_t miscFlags2;
+	};
+
+	static_assert(sizeof(Header) == 124);
+	static_assert(sizeof(HeaderDx10) == 20);
+
+	// Payload layout as stored in the file; `swizzleBgra` marks 32-bit BGRA that must be
+	// reordered into TextureFormat::RGBA.
+	struct Layout
+	{
+		TextureFormat format{ TextureFormat::RGBA };
+		int channels{ 4 };
+		bool swizzleBgra{ false };
+	};
+
+	std::optional<Layout> LayoutFromDxgi(std::uint32_t dxgiFormat) noexcept
+	{
+		switch (dxgiFormat)
+		{
+		case 27: case 28: case 29: // R8G8B8A8_{TYPELESS,UNORM,UNORM_SRGB}
+			return Layout{ TextureFormat::RGBA, 4, false };
+		case 87: case 90: case 91: // B8G8R8A8_UNORM, B8G8R8A8_{TYPELESS,UNORM_SRGB}
+			return Layout{ TextureFormat::RGBA, 4, true };
+		case 70: case 71: case 72: // BC1
+			return Layout{ TextureFormat::BC1, 4, false };
+		case 76: case 77: case 78: // BC3
+			return Layout{ TextureFormat::BC3, 4, false };
+		case 82: case 83:          // BC5_{TYPELESS,UNORM}
+			return Layout{ TextureFormat::BC5, 2, false };
+		case 97: case 98: case 99: // BC7
+			return Layout{ TextureFormat::BC7, 4, false };
+		default:
+			return std::nullopt;
+		}
+	}
+
+	std::optional<Layout> LayoutFromLegacy(const PixelFormat& pf) noexcept
+	{
+		if ((pf.flags & kPixelFourCC) != 0u)
+		{
+			switch (pf.fourCC)
+			{
+			case MakeFourCC('D', 'X', 'T', '1'):
+				return Layout{ TextureFormat::BC1, 4, false };
+			case MakeFourCC('D', 'X', 'T', '4'):
+			case MakeFourCC('D', 'X', 'T', '5'):
+				return Layout{ TextureFormat::BC3, 4, false };
+			case MakeFourCC('A', 'T', 'I', '2'):
+			case MakeFourCC('B', 'C', '5', 'U'):
+				return Layout{ TextureFormat::BC5, 2, false };
+			default:
+				return std::nullopt;
+			}
+		}
+
+		if ((pf.flags & kPixelRGB) != 0u && pf.rgbBitCount == 32u)
+		{
+			if (pf.rMask == 0x000000FFu && pf.gMask == 0x0000FF00u && pf.bMask == 0x00FF0000u)
+			{
+				return Layout{ TextureFormat::RGBA, 4, false };
+			}
+			if (pf.rMask == 0x00FF0000u && pf.gMask == 0x0000FF00u && pf.bMask == 0x000000FFu)
+			{
+				return Layout{ TextureFormat::RGBA, 4, true };
+			}
+		}
+		return std::nullopt;
+	}
+}
+
+export class DdsTextureDecoder final : public ITextureDecoder
+{
+public:
+	static bool IsDdsPath(std::string_view path) noexcept
+	{
+		if (path.size() < 4)
+		{
+			return false;
+		}
+		const std::string_view ext = path.substr(path.size() - 4);
+		return ext[0] == '.'
+			&& (ext[1] == 'd' || ext[1] == 'D')
+			&& (ext[2] == 'd' || ext[2] == 'D')
+			&& (ext[3] == 's' || ext[3] == 'S');
+	}
+
+	std::optional<TextureCPUData> Decode(const TextureProperties& properties, std::string_view resolvedPath) override
+	{
+		const std::filesystem::path path = ResolvePath(properties, resolvedPath);
+		if (!corefs::AssetFileExists(path))
+		{
+			throw std::runtime_error("DdsTextureDecoder couldn't find file: " + path.string());
+		}
+
+		const corefs::MappedFile file(path);
+		return DecodeBytes(properties, path, file.Bytes());
+	}
+
+	std::vector<std::string> SourceFiles(const TextureProperties& properties, std::string_view resolvedPath) const override
+	{
+		return { ResolvePath(properties, resolvedPath).string() };
+	}
+
+	std::optional<TextureCPUData> DecodeFromMemory(
+		const TextureProperties& properties,
+		std::string_view resolvedPath,
+		std::span<const std::span<const std::byte>> files) override
+	{
+		if (files.size() != 1)
+		{
+			throw std::runtime_error("DdsTextureDecoder: expected one source file");
+		}
+		return DecodeBytes(properties, ResolvePath(properties, resolvedPath), files.front());
+	}
+
+private:
+	static std::filesystem::path ResolvePath(const TextureProperties& properties, std::string_view resolvedPath)
+	{
+		std::filesystem::path path = std::filesystem::path(std::string(resolvedPath.empty() ? std::string_view(properties.filePath) : resolvedPath));
+		if (!path.is_absolute())
+		{
+			path = corefs::ResolveAsset(path);
+		}
+		return path;
+	}
+
+	// `path` is only used in error messages.
+	static std::optional<TextureCPUData> DecodeBytes(const TextureProperties& properties, const std::filesystem::path& path, std::span<const std::byte> bytes)
+	{
+		std::size_t offset = 0;
+		const auto Read = [&](void* dst, std::size_t size)
+			{
+				if (bytes.size() - offset < size)
+				{
+					throw std::runtime_error("DdsTextureDecoder: truncated file: " + path.string());
+				}
+				std::memcpy(dst, bytes.data() + offset, size);
+				offset += size;
+			};
+
+		if (bytes.size() < sizeof(std::uint32_t) + sizeof(dds::Header))
+		{
+			throw std::runtime_error("DdsTextureDecoder: file too small: " + path.string());
+		}
+
+		std::uint32_t magic = 0;
+		Read(&magic, sizeof(magic));
+		dds::Header header{};
+		Read(&header, sizeof(header));
+		if (magic != dds::kMagic || header.size != sizeof(dds::Header) || header.pixelFormat.size != sizeof(dds::PixelFormat))
+		{
+			throw std::runtime_error("DdsTextureDecoder: not a DDS file: " + path.string());
+		}
+		if (header.depth > 1u)
+		{
+			throw std::runtime_error("DdsTextureDecoder: volume textures are not supported: " + path.string());
+		}
+
+		std::optional<dds::Layout> layout{};
+		bool isCube = (header.caps2 & dds::kCaps2Cubemap) != 0u;
+		if ((header.pixelFormat.flags & dds::kPixelFourCC) != 0u && header.pixelFormat.fourCC == dds::MakeFourCC('D', 'X', '1', '0'))
+		{
+			dds::HeaderDx10 dx10{};
+			Read(&dx10, sizeof(dx10));
+			layout = dds::LayoutFromDxgi(dx10.dxgiFormat);
+			isCube = (dx10.miscFlag & dds::kDx10MiscTextureCube) != 0u;
+			if (dx10.arraySize > 1u)
+			{
+				throw std::runtime_error("DdsTextureDecoder: texture arrays are not supported: " + path.string());
+			}
+		}
+		else
+		{
+			layout = dds::LayoutFromLegacy(header.pixelFormat);
+		}
+
+		if (!layout)
+		{
+			throw std::runtime_error("DdsTextureDecoder: unsupported pixel format: " + path.string());
+		}
+		const bool legacyCube = (header.caps2 & dds::kCaps2Cubemap) != 0u;
+		if (legacyCube && (header.caps2 & dds::kCaps2AllFaces) != dds::kCaps2AllFaces)
+		{
+			throw std::runtime_error("DdsTextureDecoder: partial cubemaps are not supported: " + path.string());
+		}
+		if (isCube != (properties.dimension == TextureDimension::Cube))
+		{
+			throw std::runtime_error("DdsTextureDecoder: dimension does not match the request: " + path.string());
+		}
+		if (header.width == 0u || header.height == 0u)
+		{
+			throw std::runtime_error("DdsTextureDecoder: zero-sized texture: " + path.string());
+		}
+		if (header.width > dds::kMaxDimension || header.height > dds::kMaxDimension)
+		{
+			throw std::runtime_error("DdsTextureDecoder: texture exceeds the maximum size: " + path.string());
+		}
+		if (IsBlockCompressed(layout->format) && (header.width % 4u != 0u || header.height % 4u != 0u))
+		{
+			// D3D12 requires the top level of a BC resource to be block aligned.
+			throw std::runtime_error("DdsTextureDecoder: BC texture size must be a multiple of 4: " + path.string());
+		}
+
+		const std::uint32_t maxMips = static_cast<std::uint32_t>(std::bit_width(std::max(header.width, header.height)));
+		std::uint32_t mipCount = ((header.flags & dds::kFlagMipMapCount) != 0u) ? std::max(1u, header.mipMapCount) : 1u;
+		mipCount = std::min(mipCount, maxMips);
+
+		// Check the whole payload against the file before allocating anything, so a corrupt header cannot
+		// make us zero-fill gigabytes first. The size cap keeps the sum far below 2^64.
+		std::uint64_t chainBytes = 0;
+		for (std::uint32_t mip = 0; mip < mipCount; ++mip)
+		{
+			chainBytes += TextureMipBytes(layout->format, std::max(1u, header.width >> mip), std::max(1u, header.height >> mip));
+		}
+		const std::uint64_t payloadBytes = chainBytes * (isCube ? 6u : 1u);
+		if (payloadBytes > bytes.size() - offset)
+		{
+			throw std::runtime_error("DdsTextureDecoder: truncated file: " + path.string());
+		}
+
+		TextureCPUData out{};
+		out.dimension = isCube ? TextureDimension::Cube : TextureDimension::Tex2D;
+		out.width = header.width;
+		out.height = header.height;
+		out.format = layout->format;
+		out.channels = layout->channels;
+
+		const auto ReadChain = [&](std::vector<TextureMipLevel>& chain)
+			{
+				chain.reserve(mipCount);
+				for (std::uint32_t mip = 0; mip < mipCount; ++mip)
+				{
+					TextureMipLevel level{};
+					level.width = std::max(1u, header.width >> mip);
+					level.height = std::max(1u, header.height >> mip);
+					level.pixels.resize(TextureMipBytes(layout->format, level.width, level.height));
+					Read(level.pixels.data(), level.pixels.size());
+
+					if (layout->swizzleBgra)
+					{
+						for (std::size_t i = 0; i + 3 < level.pixels.size(); i += 4)
+						{
+							std::swap(level.pixels[i + 0], level.pixels[i + 2]);
+						}
+					}
+					chain.push_back(std::move(level));
+				}
+			};
+
+		if (isCube)
+		{
+			// Stored face-major: +X, -X, +Y, -Y, +Z, -Z, each with its own mip chain.
+			for (auto& faceMips : out.cubeMips)
+			{
+				ReadChain(faceMips);
+			}
+		}
+		else
+		{
+			ReadChain(out.mips);
+		}
+
+		return out;
+	}
+};
@@ -7,251 +7,57 @@
 #include <optional>
 #include <string>
 #include <vector>
+#include <span>
+#include <cstddef>
 #include <cstring>
 #include <stdexcept>
 #include <algorithm>
 #include <cstdint>
 #include <cmath>
-#include <bit>
+#include <array>
+#include <utility>
 
 export module core:texture_decoder_stb;
 
 import :resource_manager_core;
+import :texture_decoder_dds;
 import :file_system;
 import :rhi;
+import :texture_mip_chain;
 
 export class StbTextureDecoder final : public ITextureDecoder
 {
-	static void CopyRectRGBA8(
-		const std::uint8_t* src, int srcW, int srcH,
-		int x0, int y0, int size,
-		std::vector<unsigned char>& outFace)
-	{
-		outFace.resize(static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * 4u);
+public:
+	StbTextureDecoder() = default;
+	explicit StbTextureDecoder(IJobSystem* jobs) noexcept : jobs_(jobs) {}
 
-		for (int y = 0; y < size; ++y)
-		{
-			const std::uint8_t* srcRow = src + ((y0 + y) * srcW + x0) * 4;
-			unsigned char* dstRow = outFace.data() + (static_cast<std::size_t>(y) * static_cast<std::size_t>(size)) * 4u;
-			std::memcpy(dstRow, srcRow, static_cast<std::size_t>(size) * 4u);
-		}
-	}
+	// Must not change while decodes are in flight.
+	void SetJobSystem(IJobSystem* jobs) noexcept { jobs_ = jobs; }
 
-	static void FlipImageRowsRGBA8(std::vector<unsigned char>& pixels, int width, int height)
-	{
-		if (width <= 0 || height <= 1)
-		{
-			return;
-		}
+	// Off: generateMips textures decode to mip 0 only and the uploader builds the rest on the GPU
+	// (DX12TextureUploader::SetGpuMipGeneration). Must not change while decodes are in flight.
+	void SetCpuMipGeneration(bool enabled) noexcept { cpuMips_ = enabled; }
 
-		const std::size_t rowBytes = static_cast<std::size_t>(width) * 4u;
-		std::vector<unsigned char> scratch(rowBytes);
-		for (int y = 0; y < height / 2; ++y)
-		{
-			auto* rowA = pixels.data() + static_cast<std::size_t>(y) * rowBytes;
-			auto* rowB = pixels.data() + static_cast<std::size_t>(height - 1 - y) * rowBytes;
-			std::memcpy(scratch.data(), rowA, rowBytes);
-			std::memcpy(rowA, rowB, rowBytes);
-			std::memcpy(rowB, scratch.data(), rowBytes);
-		}
-	}
-
-	static std::vector<TextureMipLevel> MakeMipChain_Box2x2(
-		const std::vector<unsigned char>& mip0,
-		std::uint32_t width0,
-		std::uint32_t height0,
-		int channels,
-		bool genMips,
-		bool srgb,
-		bool isNormalMap)
+private:
+	// Copies a size x size face out of the cross; flipY reads the rows bottom-up.
+	static std::vector<unsigned char> CopyRectRGBA8(
+		const std::uint8_t* src, int srcW,
+		int x0, int y0, int size,
+		bool flipY)
 	{
-		std::vector<TextureMipLevel> chain;
-		chain.reserve(1u + static_cast<std::size_t>(std::bit_width(std::max(width0, height0))));
-
-		// Normal maps must stay in linear space.
-		const bool effectiveSrgb = srgb && !isNormalMap;
-
-		auto SrgbToLinear = [](float c) noexcept -> float
-			{
-				// IEC 61966-2-1:1999
-				if (c <= 0.04045f)
-				{
-					return c / 12.92f;
-				}
-				return std::pow((c + 0.055f) / 1.055f, 2.4f);
-			};
-
-		auto LinearToSrgbU8 = [](float c) noexcept -> unsigned char
-			{
-				c = std::clamp(c, 0.0f, 1.0f);
-				float s = 0.0f;
-				if (c <= 0.0031308f)
-				{
-					s = c * 12.92f;
-				}
-				else
-				{
-					s = 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
-				}
-
-				const int iv = static_cast<int>(std::round(std::clamp(s, 0.0f, 1.0f) * 255.0f));
-				return static_cast<unsigned char>(std::clamp(iv, 0, 255));
-			};
-
-		TextureMipLevel base{};
-		base.width = width0;
-		base.height = height0;
-		base.pixels = mip0;
-		chain.push_back(std::move(base));
-
-		if (!genMips)
-		{
-			return chain;
-		}
-
-		std::uint32_t curW = width0;
-		std::uint32_t curH = height0;
-
-		while (curW > 1 || curH > 1)
+		std::vector<unsigned char> face(static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * 4u);
+		const std::size_t rowBytes = static_cast<std::size_t>(size) * 4u;
+		for (int y = 0; y < size; ++y)
 		{
-			const std::uint32_t nextW = std::max(1u, curW / 2u);
-			const std::uint32_t nextH = std::max(1u, curH / 2u);
-
-			const auto& prev = chain.back();
-
-			TextureMipLevel next{};
-			next.width = nextW;
-			next.height = nextH;
-			next.pixels.resize(
-				static_cast<std::size_t>(nextW) * static_cast<std::size_t>(nextH) * static_cast<std::size_t>(channels));
-
-			for (std::uint32_t y = 0; y < nextH; ++y)
-			{
-				for (std::uint32_t x = 0; x < nextW; ++x)
-				{
-					std::uint32_t acc[4] = { 0,0,0,0 };
-					float accLin[3] = { 0.0f, 0.0f, 0.0f };
-					std::uint32_t cnt = 0;
-
-					for (std::uint32_t ky = 0; ky < 2; ++ky)
-					{
-						for (std::uint32_t kx = 0; kx < 2; ++kx)
-						{
-							const std::uint32_t sx = std::min(curW - 1u, x * 2u + kx);
-							const std::uint32_t sy = std::min(curH - 1u, y * 2u + ky);
-
-							const std::size_t si =
-								(static_cast<std::size_t>(sy) * static_cast<std::size_t>(curW) + static_cast<std::size_t>(sx))
-								* static_cast<std::size_t>(channels);
-
-							for (int c = 0; c < channels; ++c)
-							{
-								const unsigned char v = prev.pixels[si + static_cast<std::size_t>(c)];
-								acc[c] += v;
-								if (effectiveSrgb && c < 3)
-								{
-									accLin[c] += SrgbToLinear(static_cast<float>(v) / 255.0f);
-								}
-							}
-							++cnt;
-						}
-					}
-
-					const std::size_t di =
-						(static_cast<std::size_t>(y) * static_cast<std::size_t>(nextW) + static_cast<std::size_t>(x))
-						* static_cast<std::size_t>(channels);
-
-					if (isNormalMap && channels >= 3)
-					{
-						// Decode to [-1..1], average, renormalize, encode back to [0..255].
-						auto DecodeN = [](unsigned char v) noexcept -> float
-							{
-								return (static_cast<float>(v) / 255.0f) * 2.0f - 1.0f;
-							};
-
-						float nx = 0.0f;
-						float ny = 0.0f;
-						float nz = 0.0f;
-
-						for (std::uint32_t ky = 0; ky < 2; ++ky)
-						{
-							for (std::uint32_t kx = 0; kx < 2; ++kx)
-							{
-								const std::uint32_t sx = std::min(curW - 1u, x * 2u + kx);
-								const std::uint32_t sy = std::min(curH - 1u, y * 2u + ky);
-								const std::size_t si =
-									(static_cast<std::size_t>(sy) * static_cast<std::size_t>(curW) + static_cast<std::size_t>(sx))
-									* static_cast<std::size_t>(channels);
-
-								nx += DecodeN(prev.pixels[si + 0]);
-								ny += DecodeN(prev.pixels[si + 1]);
-								nz += DecodeN(prev.pixels[si + 2]);
-							}
-						}
-
-						nx /= static_cast<float>(cnt);
-						ny /= static_cast<float>(cnt);
-						nz /= static_cast<float>(cnt);
-
-						const float len = std::sqrt(nx * nx + ny * ny + nz * nz);
-						if (len > 1e-6f)
-						{
-							nx /= len;
-							ny /= len;
-							nz /= len;
-						}
-						else
-						{
-							// Fallback to a flat normal.
-							nx = 0.0f;
-							ny = 0.0f;
-							nz = 1.0f;
-						}
-
-						auto EncodeN = [](float v) noexcept -> unsigned char
-							{
-								const float n01 = std::clamp(v * 0.5f + 0.5f, 0.0f, 1.0f);
-								const int iv = static_cast<int>(std::round(n01 * 255.0f));
-								return static_cast<unsigned char>(std::clamp(iv, 0, 255));
-							};
-
-						next.pixels[di + 0] = EncodeN(nx);
-						next.pixels[di + 1] = EncodeN(ny);
-						next.pixels[di + 2] = EncodeN(nz);
-
-						for (int c = 3; c < channels; ++c)
-						{
-							next.pixels[di + static_cast<std::size_t>(c)] = static_cast<unsigned char>(acc[c] / cnt);
-						}
-					}
-					else
-					{
-						for (int c = 0; c < channels; ++c)
-						{
-							if (effectiveSrgb && c < 3)
-							{
-								const float lin = accLin[c] / static_cast<float>(cnt);
-								next.pixels[di + static_cast<std::size_t>(c)] = LinearToSrgbU8(lin);
-							}
-							else
-							{
-								next.pixels[di + static_cast<std::size_t>(c)] = static_cast<unsigned char>(acc[c] / cnt);
-							}
-						}
-					}
-				}
-			}
-
-			chain.push_back(std::move(next));
-			curW = nextW;
-			curH = nextH;
+			const int srcY = flipY ? (size - 1 - y) : y;
+			const std::uint8_t* srcRow = src + (static_cast<std::size_t>(y0 + srcY) * static_cast<std::size_t>(srcW) + static_cast<std::size_t>(x0)) * 4u;
+			std::memcpy(face.data() + static_cast<std::size_t>(y) * rowBytes, srcRow, rowBytes);
 		}
-
-		return chain;
+		return face;
 	}
 
-	static bool TryDecodeCubeCrossRGBA8(
-		const std::filesystem::path& filePath,
+	bool TryDecodeCubeCrossRGBA8(
+		std::span<const std::byte> file,
 		bool generateMips,
 		bool srgb,
 		bool isNormalMap,
@@ -263,7 +69,7 @@ export class StbTextureDecoder final : public ITextureDecoder
 		int height = 0;
 		int channels = 0;
 
-		std::uint8_t* pixels = stbi_load(filePath.string().c_str(), &width, &height, &channels, 4);
+		std::uint8_t* pixels = LoadRGBA8(file, width, height, channels, false);
 		if (!pixels)
 		{
 			outError = stbi_failure_reason() ? stbi_failure_reason() : "stbi_load failed";
@@ -296,51 +102,118 @@ export class StbTextureDecoder final : public ITextureDecoder
 		outCpu.format = TextureFormat::RGBA;
 		outCpu.channels = 4;
 
-		for (int face = 0; face < 6; ++face)
+		try
 		{
-			std::vector<unsigned char> mip0;
-			CopyRectRGBA8(pixels, width, height, rects[face].x, rects[face].y, faceSize, mip0);
-			if (flipY)
-			{
-				FlipImageRowsRGBA8(mip0, faceSize, faceSize);
-			}
-			outCpu.cubeMips[static_cast<std::size_t>(face)] = MakeMipChain_Box2x2(
-				mip0,
-				static_cast<std::uint32_t>(faceSize),
-				static_cast<std::uint32_t>(faceSize),
-				4,
-				generateMips,
-				srgb,
-				isNormalMap);
+			RunSubtasks(jobs_, 6, [&](std::size_t face)
+				{
+					outCpu.cubeMips[face] = BuildMipChainRGBA8(
+						CopyRectRGBA8(pixels, width, rects[face].x, rects[face].y, faceSize, flipY),
+						static_cast<std::uint32_t>(faceSize),
+						static_cast<std::uint32_t>(faceSize),
+						generateMips,
+						srgb,
+						isNormalMap,
+						jobs_);
+				});
+		}
+		catch (...)
+		{
+			stbi_image_free(pixels);
+			throw;
 		}
 
 		stbi_image_free(pixels);
 		return true;
 	}
 
-	std::optional<TextureCPUData> Decode(const TextureProperties& properties, std::string_view resolvedPath)
+public:
+	std::optional<TextureCPUData> Decode(const TextureProperties& properties, std::string_view resolvedPath) override
 	{
 		namespace fs = std::filesystem;
 
-		auto resolvePath = [](std::string_view pth) -> fs::path
+		// Pre-baked containers carry their own (possibly block-compressed) mips: skip stb and
+		// CPU mip generation entirely.
+		const std::string_view containerPath = ContainerPath(properties, resolvedPath);
+		if (DdsTextureDecoder::IsDdsPath(containerPath))
+		{
+			return dds_.Decode(properties, containerPath);
+		}
+		if (properties.dimension == TextureDimension::Cube && !properties.cubeFromCross)
+		{
+			ValidateCubeFacePaths(properties);
+		}
+
+		std::vector<corefs::BinaryFile> files;
+		std::vector<std::span<const std::byte>> bytes;
+		for (const std::string& source : SourceFiles(properties, resolvedPath))
+		{
+			if (!corefs::AssetFileExists(source))
 			{
-				fs::path p = fs::path(std::string(pth));
-				if (!p.is_absolute())
-				{
-					p = corefs::ResolveAsset(p);
-				}
-				return p;
-			};
+				throw std::runtime_error("StbTextureDecoder couldn't find file: " + source);
+			}
+			files.push_back(corefs::ReadBinaryFile(source));
+		}
+		for (const corefs::BinaryFile& file : files)
+		{
+			bytes.emplace_back(file.data);
+		}
+		return DecodeFromMemory(properties, resolvedPath, bytes);
+	}
 
-		auto loadFaceRGBA8 = [&](const fs::path& facePath, int& outW, int& outH) -> std::vector<unsigned char>
+	std::vector<std::string> SourceFiles(const TextureProperties& properties, std::string_view resolvedPath) const override
+	{
+		const std::string_view containerPath = ContainerPath(properties, resolvedPath);
+		if (DdsTextureDecoder::IsDdsPath(containerPath))
+		{
+			return dds_.SourceFiles(properties, containerPath);
+		}
+
+		if (properties.dimension == TextureDimension::Cube)
+		{
+			if (properties.cubeFromCross)
+			{
+				return { ResolvePath(properties.filePath).string() };
+			}
+
+			std::vector<std::string> faces;
+			for (const std::string& face : properties.cubeFacePaths)
 			{
-				if (!fs::exists(facePath))
+				if (face.empty())
 				{
-					throw std::runtime_error("StbTextureDecoder couldn't find file: " + facePath.string());
+					return {}; // Decode reports it
 				}
+				faces.push_back(ResolvePath(face).string());
+			}
+			return faces;
+		}
+
+		return { ResolvePath(resolvedPath).string() };
+	}
+
+	// `files` holds the bytes of SourceFiles(properties, resolvedPath), in the same order.
+	std::optional<TextureCPUData> DecodeFromMemory(
+		const TextureProperties& properties,
+		std::string_view resolvedPath,
+		std::span<const std::span<const std::byte>> files) override
+	{
+		const std::string_view containerPath = ContainerPath(properties, resolvedPath);
+		if (DdsTextureDecoder::IsDdsPath(containerPath))
+		{
+			return dds_.DecodeFromMemory(properties, containerPath, files);
+		}
+
+		const std::size_t expectedFiles =
+			(properties.dimension == TextureDimension::Cube && !properties.cubeFromCross) ? 6u : 1u;
+		if (files.size() != expectedFiles)
+		{
+			throw std::runtime_error("StbTextureDecoder: expected " + std::to_string(expectedFiles) + " source file(s)");
+		}
 
+		// stb flips while decoding (flipY), so the pixels are copied out exactly once.
+		auto loadRGBA8 = [&](std::span<const std::byte> file, int& outW, int& outH) -> std::vector<unsigned char>
+			{
 				int w = 0, h = 0, comp = 0;
-				stbi_uc* data = stbi_load(facePath.string().c_str(), &w, &h, &comp, 4 /*force RGBA*/);
+				stbi_uc* data = LoadRGBA8(file, w, h, comp, properties.flipY);
 				if (!data)
 				{
 					throw std::runtime_error(std::string("stbi_load failed: ") + stbi_failure_reason());
@@ -350,13 +223,13 @@ export class StbTextureDecoder final : public ITextureDecoder
 				outH = h;
 
 				const std::size_t size = static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u;
-				std::vector<unsigned char> pixels;
-				pixels.resize(size);
-				std::memcpy(pixels.data(), data, size);
+				std::vector<unsigned char> pixels(data, data + size);
 				stbi_image_free(data);
 				return pixels;
 			};
 
+		const bool generateMips = properties.generateMips && cpuMips_;
+
 		// ---------------------- Cubemap ----------------------
 
 		if (properties.dimension == TextureDimension::Cube)
@@ -369,79 +242,48 @@ export class StbTextureDecoder final : public ITextureDecoder
 			if (properties.cubeFromCross)
 			{
 				std::string error;
-				if (!TryDecodeCubeCrossRGBA8(resolvePath(properties.filePath), properties.generateMips, properties.srgb, properties.isNormalMap, properties.flipY, out, error))
+				if (!TryDecodeCubeCrossRGBA8(files.front(), generateMips, properties.srgb, properties.isNormalMap, properties.flipY, out, error))
 				{
 					throw std::runtime_error("Cubemap cross decode failed: " + error);
 				}
 				return out;
 			}
 
-			// Expect explicit face paths in properties.cubeFacePaths.
-			for (std::size_t i = 0; i < 6; ++i)
-			{
-				if (properties.cubeFacePaths[i].empty())
+			// Faces decode and build their chains in parallel; sizes are checked in face order after.
+			std::array<int, 6> widths{};
+			std::array<int, 6> heights{};
+			RunSubtasks(jobs_, 6, [&](std::size_t face)
 				{
-					throw std::runtime_error("StbTextureDecoder: cubemap face path is empty (index " + std::to_string(i) + ")");
-				}
-			}
-
-			int w0 = 0, h0 = 0;
-			for (std::size_t face = 0; face < 6; ++face)
+					std::vector<unsigned char> mip0 = loadRGBA8(files[face], widths[face], heights[face]);
+					out.cubeMips[face] = BuildMipChainRGBA8(
+						std::move(mip0),
+						static_cast<std::uint32_t>(widths[face]),
+						static_cast<std::uint32_t>(heights[face]),
+						generateMips,
+						properties.srgb,
+						properties.isNormalMap,
+						jobs_);
+				});
+
+			for (std::size_t face = 1; face < 6; ++face)
 			{
-				const fs::path facePath = resolvePath(properties.cubeFacePaths[face]);
-
-				int w = 0, h = 0;
-				auto mip0 = loadFaceRGBA8(facePath, w, h);
-				if (properties.flipY)
-				{
-					FlipImageRowsRGBA8(mip0, w, h);
-				}
-
-				if (face == 0)
-				{
-					w0 = w;
-					h0 = h;
-				}
-				else
+				if (widths[face] != widths[0] || heights[face] != heights[0])
 				{
-					if (w != w0 || h != h0)
-					{
-						throw std::runtime_error(
-							"StbTextureDecoder: cubemap faces must have the same size. "
-							"Face " + std::to_string(face) + " has " + std::to_string(w) + "x" + std::to_string(h) +
-							", expected " + std::to_string(w0) + "x" + std::to_string(h0));
-					}
+					throw std::runtime_error(
+						"StbTextureDecoder: cubemap faces must have the same size. "
+						"Face " + std::to_string(face) + " has " + std::to_string(widths[face]) + "x" + std::to_string(heights[face]) +
+						", expected " + std::to_string(widths[0]) + "x" + std::to_string(heights[0]));
 				}
-
-				out.cubeMips[face] = MakeMipChain_Box2x2(
-					mip0,
-					static_cast<std::uint32_t>(w),
-					static_cast<std::uint32_t>(h),
-					4,
-					properties.generateMips,
-					properties.srgb,
-					properties.isNormalMap);
 			}
 
-			out.width = static_cast<std::uint32_t>(w0);
-			out.height = static_cast<std::uint32_t>(h0);
+			out.width = static_cast<std::uint32_t>(widths[0]);
+			out.height = static_cast<std::uint32_t>(heights[0]);
 			return out;
 		}
 
 		// ---------------------- Tex2D ----------------------
-		fs::path correctPath = resolvePath(resolvedPath);
-
-		if (!fs::exists(correctPath))
-		{
-			throw std::runtime_error("StbTextureDecoder couldn't find file: " + correctPath.string());
-		}
-
-		int width = 0, height = 0, comp = 0;
-		stbi_uc* data = stbi_load(correctPath.string().c_str(), &width, &height, &comp, 4 /*force RGBA*/);
-		if (!data)
-		{
-			throw std::runtime_error(std::string("stbi_load failed: ") + stbi_failure_reason());
-		}
+		int width = 0, height = 0;
+		std::vector<unsigned char> mip0 = loadRGBA8(files.front(), width, height);
 
 		TextureCPUData out{};
 		out.dimension = TextureDimension::Tex2D;
@@ -450,25 +292,61 @@ export class StbTextureDecoder final : public ITextureDecoder
 		out.channels = 4;
 		out.format = TextureFormat::RGBA;
 
-		const std::size_t size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
-		std::vector<unsigned char> mip0;
-		mip0.resize(size);
-		std::memcpy(mip0.data(), data, size);
-		if (properties.flipY)
-		{
-			FlipImageRowsRGBA8(mip0, width, height);
-		}
-
-		stbi_image_free(data);
-
-		out.mips = MakeMipChain_Box2x2(
-			mip0,
+		out.mips = BuildMipChainRGBA8(
+			std::move(mip0),
 			out.width,
 			out.height,
-			out.channels,
-			properties.generateMips,
+			generateMips,
 			properties.srgb,
-			properties.isNormalMap);
+			properties.isNormalMap,
+			jobs_);
 		return out;
 	}
+
+private:
+	// Cubemaps are identified by filePath, 2D textures by the resolved path.
+	static std::string_view ContainerPath(const TextureProperties& properties, std::string_view resolvedPath) noexcept
+	{
+		return (properties.dimension == TextureDimension::Cube) ? std::string_view(properties.filePath) : resolvedPath;
+	}
+
+	static std::filesystem::path ResolvePath(std::string_view path)
+	{
+		std::filesystem::path p = std::filesystem::path(std::string(path));
+		if (!p.is_absolute())
+		{
+			p = corefs::ResolveAsset(p);
+		}
+		return p;
+	}
+
+	static void ValidateCubeFacePaths(const TextureProperties& properties)
+	{
+		for (std::size_t i = 0; i < 6; ++i)
+		{
+			if (properties.cubeFacePaths[i].empty())
+			{
+				throw std::runtime_error("StbTextureDecoder: cubemap face path is empty (index " + std::to_string(i) + ")");
+			}
+		}
+	}
+
+	// Forced RGBA8, rows bottom-up if flipY (stb flips in place while decoding); free with
+	// stbi_image_free.
+	static stbi_uc* LoadRGBA8(std::span<const std::byte> file, int& width, int& height, int& channels, bool flipY)
+	{
+		stbi_set_flip_vertically_on_load_thread(flipY ? 1 : 0);
+		stbi_uc* pixels = stbi_load_from_memory(
+			reinterpret_cast<const stbi_uc*>(file.data()),
+			static_cast<int>(file.size()),
+			&width, &height, &channels, 4 /*force RGBA*/);
+		stbi_set_flip_vertically_on_load_thread(0);
+		return pixels;
+	}
+
+	DdsTextureDecoder dds_{};
+
+	// Cube faces and large mip levels run as RunSubtasks here (null: on the decoding thread).
+	IJobSystem* jobs_{ nullptr };
+	bool cpuMips_{ true };
 };
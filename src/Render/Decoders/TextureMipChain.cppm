@@ -0,0 +1,447 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CORE_MIP_SIMD_SSE2 1
+#endif
+
+export module core:texture_mip_chain;
+
+import :resource_manager_core;
+
+// CPU mip chains for RGBA8 images (stb-decoded textures and cubemap faces).
+//
+// Every level is a 2x2 box filter of the one above it: an odd last row/column is dropped and a
+// 1-pixel dimension repeats its pixel. sRGB color channels are averaged in linear light, alpha and
+// linear textures average the bytes (truncating; SSE2 does two output pixels per step), normal
+// maps average the decoded vectors and renormalize. Levels with many pixels are split into row
+// bands that run as RunSubtasks on the job system.
+
+namespace
+{
+	// IEC 61966-2-1:1999
+	float SrgbToLinear(float c) noexcept
+	{
+		if (c <= 0.04045f)
+		{
+			return c / 12.92f;
+		}
+		return std::pow((c + 0.055f) / 1.055f, 2.4f);
+	}
+
+	unsigned char LinearToSrgbU8(float c) noexcept
+	{
+		c = std::clamp(c, 0.0f, 1.0f);
+		float s = 0.0f;
+		if (c <= 0.0031308f)
+		{
+			s = c * 12.92f;
+		}
+		else
+		{
+			s = 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+		}
+
+		const int iv = static_cast<int>(std::round(std::clamp(s, 0.0f, 1.0f) * 255.0f));
+		return static_cast<unsigned char>(std::clamp(iv, 0, 255));
+	}
+
+	unsigned char EncodeNormalU8(float v) noexcept
+	{
+		const float n01 = std::clamp(v * 0.5f + 0.5f, 0.0f, 1.0f);
+		const int iv = static_cast<int>(std::round(n01 * 255.0f));
+		return static_cast<unsigned char>(std::clamp(iv, 0, 255));
+	}
+
+	float DecodeNormal(unsigned char v) noexcept
+	{
+		return (static_cast<float>(v) / 255.0f) * 2.0f - 1.0f;
+	}
+
+	constexpr std::uint32_t kSrgbEncodeSteps = 65535;
+
+	const std::array<float, 256>& SrgbDecodeTable() noexcept
+	{
+		static const std::array<float, 256> table = []
+			{
+				std::array<float, 256> t{};
+				for (std::size_t i = 0; i < t.size(); ++i)
+				{
+					t[i] = SrgbToLinear(static_cast<float>(i) / 255.0f);
+				}
+				return t;
+			}();
+		return table;
+	}
+
+	// LinearToSrgbU8 sampled at kSrgbEncodeSteps + 1 points: within one step of the exact encode
+	// (only values within 1/131070 of a rounding boundary can land on the other side).
+	const std::vector<unsigned char>& SrgbEncodeTable()
+	{
+		static const std::vector<unsigned char> table = []
+			{
+				std::vector<unsigned char> t(kSrgbEncodeSteps + 1u);
+				for (std::size_t i = 0; i < t.size(); ++i)
+				{
+					t[i] = LinearToSrgbU8(static_cast<float>(i) / static_cast<float>(kSrgbEncodeSteps));
+				}
+				return t;
+			}();
+		return table;
+	}
+
+	enum class MipMode : std::uint8_t
+	{
+		Linear,
+		Srgb,
+		Normal
+	};
+
+	// Output pixels at or above this run as parallel row bands (about kMipBandPixels each).
+	constexpr std::size_t kParallelMipPixels = 256u * 256u;
+	constexpr std::size_t kMipBandPixels = 128u * 1024u;
+	constexpr std::size_t kMaxMipBands = 16;
+
+	// Rows [y0, y1) of dst (RGBA8) from src, the level above it.
+	void DownsampleRowsRGBA8(const TextureMipLevel& src, TextureMipLevel& dst, std::uint32_t y0, std::uint32_t y1, MipMode mode)
+	{
+		const std::uint32_t srcW = src.width;
+		const std::uint32_t srcH = src.height;
+		const std::uint32_t dstW = dst.width;
+		const std::array<float, 256>& decode = SrgbDecodeTable();
+		const unsigned char* encode = (mode == MipMode::Srgb) ? SrgbEncodeTable().data() : nullptr;
+
+		for (std::uint32_t y = y0; y < y1; ++y)
+		{
+			const unsigned char* row0 = src.pixels.data() + static_cast<std::size_t>(std::min(srcH - 1u, y * 2u)) * srcW * 4u;
+			const unsigned char* row1 = src.pixels.data() + static_cast<std::size_t>(std::min(srcH - 1u, y * 2u + 1u)) * srcW * 4u;
+			unsigned char* out = dst.pixels.data() + static_cast<std::size_t>(y) * dstW * 4u;
+
+			if (mode == MipMode::Normal)
+			{
+				for (std::uint32_t x = 0; x < dstW; ++x)
+				{
+					const unsigned char* p[4] = {
+						row0 + std::min(srcW - 1u, x * 2u) * 4u,
+						row0 + std::min(srcW - 1u, x * 2u + 1u) * 4u,
+						row1 + std::min(srcW - 1u, x * 2u) * 4u,
+						row1 + std::min(srcW - 1u, x * 2u + 1u) * 4u,
+					};
+
+					float n[3] = { 0.0f, 0.0f, 0.0f };
+					for (const unsigned char* s : p)
+					{
+						n[0] += DecodeNormal(s[0]);
+						n[1] += DecodeNormal(s[1]);
+						n[2] += DecodeNormal(s[2]);
+					}
+					n[0] /= 4.0f;
+					n[1] /= 4.0f;
+					n[2] /= 4.0f;
+
+					const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+					if (len > 1e-6f)
+					{
+						n[0] /= len;
+						n[1] /= len;
+						n[2] /= len;
+					}
+					else
+					{
+						// Fallback to a flat normal.
+						n[0] = 0.0f;
+						n[1] = 0.0f;
+						n[2] = 1.0f;
+					}
+
+					unsigned char* d = out + x * 4u;
+					d[0] = EncodeNormalU8(n[0]);
+					d[1] = EncodeNormalU8(n[1]);
+					d[2] = EncodeNormalU8(n[2]);
+					d[3] = static_cast<unsigned char>((static_cast<std::uint32_t>(p[0][3]) + p[1][3] + p[2][3] + p[3][3]) / 4u);
+				}
+				continue;
+			}
+
+			// Byte average of all four channels (sRGB color is redone below).
+			std::uint32_t x = 0;
+#if defined(CORE_MIP_SIMD_SSE2)
+			if (srcW >= 2)
+			{
+				const __m128i zero = _mm_setzero_si128();
+				for (; x + 2 <= dstW; x += 2)
+				{
+					// 4 source pixels from each row -> 2 output pixels.
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8u));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8u));
+					const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)); // pixels 0, 1
+					const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)); // pixels 2, 3
+					const __m128i sumA = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+					const __m128i sumB = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+					const __m128i avg = _mm_srli_epi16(_mm_unpacklo_epi64(sumA, sumB), 2);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(out + x * 4u), _mm_packus_epi16(avg, avg));
+				}
+			}
+#endif
+			for (; x < dstW; ++x)
+			{
+				const std::uint32_t sx0 = std::min(srcW - 1u, x * 2u) * 4u;
+				const std::uint32_t sx1 = std::min(srcW - 1u, x * 2u + 1u) * 4u;
+				for (std::uint32_t c = 0; c < 4; ++c)
+				{
+					const std::uint32_t sum = static_cast<std::uint32_t>(row0[sx0 + c]) + row0[sx1 + c] + row1[sx0 + c] + row1[sx1 + c];
+					out[x * 4u + c] = static_cast<unsigned char>(sum / 4u);
+				}
+			}
+
+			if (mode != MipMode::Srgb)
+			{
+				continue;
+			}
+
+			for (x = 0; x < dstW; ++x)
+			{
+				const std::uint32_t sx0 = std::min(srcW - 1u, x * 2u) * 4u;
+				const std::uint32_t sx1 = std::min(srcW - 1u, x * 2u + 1u) * 4u;
+				unsigned char* d = out + x * 4u;
+#if defined(CORE_MIP_SIMD_SSE2)
+				const auto load = [&decode](const unsigned char* s)
+					{
+						return _mm_set_ps(0.0f, decode[s[2]], decode[s[1]], decode[s[0]]);
+					};
+				const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(load(row0 + sx0), load(row0 + sx1)), load(row1 + sx0)), load(row1 + sx1));
+				const __m128 scaled = _mm_mul_ps(_mm_mul_ps(sum, _mm_set1_ps(0.25f)), _mm_set1_ps(static_cast<float>(kSrgbEncodeSteps)));
+				const __m128i index = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(scaled, _mm_setzero_ps()), _mm_set1_ps(static_cast<float>(kSrgbEncodeSteps))));
+				alignas(16) std::int32_t lanes[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(lanes), index);
+				d[0] = encode[lanes[0]];
+				d[1] = encode[lanes[1]];
+				d[2] = encode[lanes[2]];
+#else
+				for (std::uint32_t c = 0; c < 3; ++c)
+				{
+					const float lin = (((decode[row0[sx0 + c]] + decode[row0[sx1 + c]]) + decode[row1[sx0 + c]]) + decode[row1[sx1 + c]]) * 0.25f;
+					const float scaled = std::clamp(lin, 0.0f, 1.0f) * static_cast<float>(kSrgbEncodeSteps);
+					d[c] = encode[static_cast<std::uint32_t>(std::lround(scaled))];
+				}
+#endif
+			}
+		}
+	}
+}
+
+// Levels below mip0 (moved in as level 0) down to 1x1, or only level 0 when !generateMips.
+export std::vector<TextureMipLevel> BuildMipChainRGBA8(
+	std::vector<unsigned char> mip0,
+	std::uint32_t width0,
+	std::uint32_t height0,
+	bool generateMips,
+	bool srgb,
+	bool isNormalMap,
+	IJobSystem* jobs = nullptr)
+{
+	std::vector<TextureMipLevel> chain;
+	chain.reserve(1u + static_cast<std::size_t>(std::bit_width(std::max(width0, height0))));
+
+	TextureMipLevel base{};
+	base.width = width0;
+	base.height = height0;
+	base.pixels = std::move(mip0);
+	chain.push_back(std::move(base));
+
+	if (!generateMips || width0 == 0 || height0 == 0)
+	{
+		return chain;
+	}
+
+	// Normal maps must stay in linear space.
+	const MipMode mode = isNormalMap ? MipMode::Normal : (srgb ? MipMode::Srgb : MipMode::Linear);
+
+	while (chain.back().width > 1 || chain.back().height > 1)
+	{
+		TextureMipLevel next{};
+		next.width = std::max(1u, chain.back().width / 2u);
+		next.height = std::max(1u, chain.back().height / 2u);
+		next.pixels.resize(static_cast<std::size_t>(next.width) * next.height * 4u);
+
+		const TextureMipLevel& prev = chain.back();
+		const std::size_t pixels = static_cast<std::size_t>(next.width) * next.height;
+		const std::size_t bands = (jobs != nullptr && pixels >= kParallelMipPixels)
+			? std::min<std::size_t>({ (pixels + kMipBandPixels - 1) / kMipBandPixels, kMaxMipBands, next.height })
+			: 1u;
+		RunSubtasks(bands > 1 ? jobs : nullptr, bands, [&](std::size_t band)
+			{
+				const std::uint32_t y0 = static_cast<std::uint32_t>(next.height * band / bands);
+				const std::uint32_t y1 = static_cast<std::uint32_t>(next.height * (band + 1) / bands);
+				DownsampleRowsRGBA8(prev, next, y0, y1, mode);
+			});
+
+		chain.push_back(std::move(next));
+	}
+	return chain;
+}
+
+// Single-threaded scalar implementation the fast path is checked against (any channel count,
+// std::pow per sample). Same results except sRGB color, which may differ by one step.
+export std::vector<TextureMipLevel> BuildMipChainReference(
+	const std::vector<unsigned char>& mip0,
+	std::uint32_t width0,
+	std::uint32_t height0,
+	int channels,
+	bool genMips,
+	bool srgb,
+	bool isNormalMap)
+{
+	std::vector<TextureMipLevel> chain;
+	chain.reserve(1u + static_cast<std::size_t>(std::bit_width(std::max(width0, height0))));
+
+	// Normal maps must stay in linear space.
+	const bool effectiveSrgb = srgb && !isNormalMap;
+
+	TextureMipLevel base{};
+	base.width = width0;
+	base.height = height0;
+	base.pixels = mip0;
+	chain.push_back(std::move(base));
+
+	if (!genMips)
+	{
+		return chain;
+	}
+
+	std::uint32_t curW = width0;
+	std::uint32_t curH = height0;
+
+	while (curW > 1 || curH > 1)
+	{
+		const std::uint32_t nextW = std::max(1u, curW / 2u);
+		const std::uint32_t nextH = std::max(1u, curH / 2u);
+
+		const auto& prev = chain.back();
+
+		TextureMipLevel next{};
+		next.width = nextW;
+		next.height = nextH;
+		next.pixels.resize(
+			static_cast<std::size_t>(nextW) * static_cast<std::size_t>(nextH) * static_cast<std::size_t>(channels));
+
+		for (std::uint32_t y = 0; y < nextH; ++y)
+		{
+			for (std::uint32_t x = 0; x < nextW; ++x)
+			{
+				std::uint32_t acc[4] = { 0,0,0,0 };
+				float accLin[3] = { 0.0f, 0.0f, 0.0f };
+				std::uint32_t cnt = 0;
+
+				for (std::uint32_t ky = 0; ky < 2; ++ky)
+				{
+					for (std::uint32_t kx = 0; kx < 2; ++kx)
+					{
+						const std::uint32_t sx = std::min(curW - 1u, x * 2u + kx);
+						const std::uint32_t sy = std::min(curH - 1u, y * 2u + ky);
+
+						const std::size_t si =
+							(static_cast<std::size_t>(sy) * static_cast<std::size_t>(curW) + static_cast<std::size_t>(sx))
+							* static_cast<std::size_t>(channels);
+
+						for (int c = 0; c < channels; ++c)
+						{
+							const unsigned char v = prev.pixels[si + static_cast<std::size_t>(c)];
+							acc[c] += v;
+							if (effectiveSrgb && c < 3)
+							{
+								accLin[c] += SrgbToLinear(static_cast<float>(v) / 255.0f);
+							}
+						}
+						++cnt;
+					}
+				}
+
+				const std::size_t di =
+					(static_cast<std::size_t>(y) * static_cast<std::size_t>(nextW) + static_cast<std::size_t>(x))
+					* static_cast<std::size_t>(channels);
+
+				if (isNormalMap && channels >= 3)
+				{
+					// Decode to [-1..1], average, renormalize, encode back to [0..255].
+					float nx = 0.0f;
+					float ny = 0.0f;
+					float nz = 0.0f;
+
+					for (std::uint32_t ky = 0; ky < 2; ++ky)
+					{
+						for (std::uint32_t kx = 0; kx < 2; ++kx)
+						{
+							const std::uint32_t sx = std::min(curW - 1u, x * 2u + kx);
+							const std::uint32_t sy = std::min(curH - 1u, y * 2u + ky);
+							const std::size_t si =
+								(static_cast<std::size_t>(sy) * static_cast<std::size_t>(curW) + static_cast<std::size_t>(sx))
+								* static_cast<std::size_t>(channels);
+
+							nx += DecodeNormal(prev.pixels[si + 0]);
+							ny += DecodeNormal(prev.pixels[si + 1]);
+							nz += DecodeNormal(prev.pixels[si + 2]);
+						}
+					}
+
+					nx /= static_cast<float>(cnt);
+					ny /= static_cast<float>(cnt);
+					nz /= static_cast<float>(cnt);
+
+					const float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+					if (len > 1e-6f)
+					{
+						nx /= len;
+						ny /= len;
+						nz /= len;
+					}
+					else
+					{
+						// Fallback to a flat normal.
+						nx = 0.0f;
+						ny = 0.0f;
+						nz = 1.0f;
+					}
+
+					next.pixels[di + 0] = EncodeNormalU8(nx);
+					next.pixels[di + 1] = EncodeNormalU8(ny);
+					next.pixels[di + 2] = EncodeNormalU8(nz);
+
+					for (int c = 3; c < channels; ++c)
+					{
+						next.pixels[di + static_cast<std::size_t>(c)] = static_cast<unsigned char>(acc[c] / cnt);
+					}
+				}
+				else
+				{
+					for (int c = 0; c < channels; ++c)
+					{
+						if (effectiveSrgb && c < 3)
+						{
+							const float lin = accLin[c] / static_cast<float>(cnt);
+							next.pixels[di + static_cast<std::size_t>(c)] = LinearToSrgbU8(lin);
+						}
+						else
+						{
+							next.pixels[di + static_cast<std::size_t>(c)] = static_cast<unsigned char>(acc[c] / cnt);
+						}
+					}
+				}
+			}
+		}
+
+		chain.push_back(std::move(next));
+		curW = nextW;
+		curH = nextH;
+	}
+
+	return chain;
+}
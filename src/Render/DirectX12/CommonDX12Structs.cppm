@@ -9,12 +9,23 @@ import :rhi;
 import :math_utils;
 import :scene;
 import :render_graph;
+import :hash_utils;
+import :reflection_probe_scheduler;
+import :shadow_atlas;
 
 export namespace rendern
 {
 	// multiple Spot/Point shadow casters (DX12). Keep small caps for now.
-	constexpr std::uint32_t kMaxSpotShadows = 4;
+	// Spot shadows share one depth atlas (RendererSettings::spotShadowAtlasSize), so their cap costs no textures.
+	constexpr std::uint32_t kMaxSpotShadows = 8;
 	constexpr std::uint32_t kMaxPointShadows = 4;
+	constexpr std::uint32_t kPointShadowFaces = 6;
+	static_assert(kMaxPointShadows * kPointShadowFaces <= 32, "DrawItemPrep::pointShadowFaceMask is 32 bits");
+	// Directional CSM cascades, packed side by side in one depth atlas.
+	constexpr std::uint32_t kMaxDirCascades = 3;
+	static_assert(kMaxSpotShadows <= 32, "DrawItemPrep::spotShadowMask is 32 bits");
+	// Views of one cached shadow depth: the cascades of the directional atlas or the tiles of the spot atlas.
+	constexpr std::uint32_t kMaxShadowCacheViews = (kMaxSpotShadows > kMaxDirCascades) ? kMaxSpotShadows : kMaxDirCascades;
 
 	struct DeferredReflectionProbeGpu
 	{
@@ -80,12 +91,43 @@ export namespace rendern
 	};
 	static_assert(sizeof(InstanceData) == 64);
 
+	// Persistent instance transforms (InstanceTransforms_dx12.hlsl): every draw item's InstanceData lives in
+	// a GPU buffer slot indexed by its draw item index and is only re-uploaded when it changes (scattered
+	// in by CS_InstanceScatter). The per-pass instance lists are InstanceRefs into it, which CS_InstanceGather
+	// expands into instanceBuffer_ for the vertex stream.
+	// An InstanceRef is the slot plus, for layered point shadows, the cubemap face + 1 in the top bits
+	// (the face lands in i0.w); kNoInstanceRef is padding and expands to a zero instance.
+	using InstanceRef = std::uint32_t;
+	constexpr std::uint32_t kInstanceRefFaceShift = 29;
+	constexpr std::uint32_t kInstanceRefSlotMask = (1u << kInstanceRefFaceShift) - 1u;
+	constexpr InstanceRef kNoInstanceRef = ~0u;
+	constexpr std::uint32_t kMaxInstanceTransforms = 1u << 18;       // slots (16 MB)
+	constexpr std::uint32_t kMaxInstanceTransformUpdates = 1u << 14; // scattered per frame; more is one full upload
+
+	[[nodiscard]] constexpr InstanceRef MakeInstanceRef(std::uint32_t slot, std::uint32_t facePlusOne = 0u) noexcept
+	{
+		return (slot & kInstanceRefSlotMask) | (facePlusOne << kInstanceRefFaceShift);
+	}
+
+	struct InstanceTransformUpdate
+	{
+		std::array<std::uint32_t, 4> slot{}; // x = slot
+		InstanceData rows{};
+	};
+	static_assert(sizeof(InstanceTransformUpdate) == 80);
+
+	struct alignas(16) InstanceTransformConstants
+	{
+		std::array<std::uint32_t, 4> uCounts{}; // x = update / instance count
+	};
+	static_assert(sizeof(InstanceTransformConstants) == 16);
+
 	struct ParticleInstanceData
 	{
 		mathUtils::Vec4 centerSize; // xyz = world center, w = size
 		mathUtils::Vec4 color;      // rgba
-		mathUtils::Vec4 params0;    // x = rotationRad, yzw unused for now
-		mathUtils::Vec4 params1{};  // reserved
+		mathUtils::Vec4 params0;    // x = rotationRad, y = asfloat(bindless texture desc index, 0 = procedural), zw unused
+		mathUtils::Vec4 params1{};  // flipbook frame UV rect: xy = offset, zw = size
 	};
 	static_assert(sizeof(ParticleInstanceData) == 64);
 
@@ -97,6 +139,119 @@ export namespace rendern
 	};
 	static_assert(sizeof(ParticleConstants) <= 96);
 
+	// GPU culling (compute, DX12). The HiZ pyramid lives in one float structured buffer,
+	// level 0 = max depth over 2x2 swapchain depth texels, each next level halves (rounding up).
+	constexpr std::uint32_t kMaxHiZLevels = 14;
+
+	struct alignas(16) GpuCullConstants
+	{
+		std::array<float, 16> uViewProj{};
+		std::array<float, 4 * 6> uPlanes{};          // frustum planes (n.xyz, d), inside if dot(n, p) + d >= 0
+		std::array<std::uint32_t, 4> uCounts{};      // instanceCount, occlusion on/off, HiZ level count, main instance base
+		std::array<float, 4> uDepthSize{};           // depth width, height, 1/width, 1/height
+		std::array<std::uint32_t, 4 * kMaxHiZLevels> uHiZLevels{}; // per level: offset, width, height, 0
+	};
+	static_assert(sizeof(GpuCullConstants) <= 512);
+
+	struct alignas(16) HiZBuildConstants
+	{
+		std::array<std::uint32_t, 4> uSrc{}; // offset, width, height, 1 = read the depth texture (t0)
+		std::array<std::uint32_t, 4> uDst{}; // offset, width, height, 0
+	};
+	static_assert(sizeof(HiZBuildConstants) == 32);
+
+	// One record per main batch: mesh bounding sphere (local) and where its survivors go.
+	struct GpuCullBatchData
+	{
+		mathUtils::Vec4 sphere{};            // local center xyz, radius
+		std::uint32_t outputOffset{ 0 };     // first instance in the culled instance buffer
+		std::uint32_t instanceCount{ 0 };
+		std::uint32_t pad0{ 0 };
+		std::uint32_t pad1{ 0 };
+	};
+	static_assert(sizeof(GpuCullBatchData) == 32);
+
+	// GPU particles (compute, DX12): a fixed pool of slots with a dead list of free ones. Emitters spawn
+	// into it, the simulation returns expired slots and writes a depth key per slot, a bitonic sort orders
+	// the keys back to front and one indirect draw renders the live prefix (GpuParticles_dx12.hlsl).
+	constexpr std::uint32_t kGpuParticlePoolSize = 1u << 18;
+	constexpr std::uint32_t kGpuParticleSortBlock = 1024u; // entries sorted in groupshared memory per group
+	constexpr std::uint32_t kMaxGpuParticleEmitters = 1024u;
+	static_assert(std::has_single_bit(kGpuParticlePoolSize) && kGpuParticlePoolSize % kGpuParticleSortBlock == 0);
+
+	// Byte offsets in the counters buffer: DrawIndexedIndirectArgs first, then the dead list size, then
+	// the live particle count of every emitter.
+	constexpr std::uint32_t kGpuParticleDeadCountOffset = 20u;
+	constexpr std::uint32_t kGpuParticleEmitterAliveOffset = 32u;
+	constexpr std::uint32_t kGpuParticleCountersSizeBytes = kGpuParticleEmitterAliveOffset + 4u * kMaxGpuParticleEmitters;
+
+	struct GpuParticleData
+	{
+		mathUtils::Vec4 positionAge{};      // xyz, age
+		mathUtils::Vec4 velocityLifetime{}; // xyz, lifetime
+		mathUtils::Vec4 colorBegin{};
+		mathUtils::Vec4 colorEnd{};
+		mathUtils::Vec4 sizeRotation{};     // sizeBegin, sizeEnd, rotation, 0
+		std::array<std::uint32_t, 4> meta{}; // emitter index, emitter generation, texture desc index, live
+	};
+	static_assert(sizeof(GpuParticleData) == 96);
+
+	// ParticleEmitter spawn parameters, rebuilt every frame.
+	struct GpuParticleEmitterData
+	{
+		mathUtils::Vec4 positionLifetimeMin{}; // xyz = position, w = lifetimeMin
+		mathUtils::Vec4 jitterLifetimeMax{};   // xyz = position jitter, w = lifetimeMax
+		mathUtils::Vec4 velocityMinSizeMin{};  // xyz = velocityMin, w = sizeMin
+		mathUtils::Vec4 velocityMaxSizeMax{};  // xyz = velocityMax, w = sizeMax
+		mathUtils::Vec4 colorBegin{};
+		mathUtils::Vec4 colorEnd{};
+		mathUtils::Vec4 sizeBeginEnd{};        // sizeBegin, sizeEnd, 0, 0
+		std::array<std::uint32_t, 4> params{}; // texture desc index, maxParticles, generation, 0
+		mathUtils::Vec4 uvRect{};              // atlas region: u0, v0, width, height
+		mathUtils::Vec4 flipbook{};            // ParticleFlipbookParams: columns, rows, fps, 0
+	};
+	static_assert(sizeof(GpuParticleEmitterData) == 160);
+
+	// Spawn sequence numbers [firstSequence, firstSequence + count) of one emitter, handled by the emit
+	// threads [firstSpawn, firstSpawn + count).
+	struct GpuParticleSpawnRange
+	{
+		std::uint32_t emitterIndex{ 0 };
+		std::uint32_t firstSequence{ 0 };
+		std::uint32_t count{ 0 };
+		std::uint32_t firstSpawn{ 0 };
+	};
+	static_assert(sizeof(GpuParticleSpawnRange) == 16);
+
+	struct alignas(16) GpuParticleConstants
+	{
+		std::array<float, 4> uCameraPosDt{};     // camera position, simulation step (seconds)
+		std::array<float, 4> uCameraForward{};
+		std::array<std::uint32_t, 4> uCounts{};  // spawn range count, spawn count, emitter count, pool size
+		std::array<std::uint32_t, 4> uParams{};  // bitonic k, j; billboard index count (init)
+	};
+	static_assert(sizeof(GpuParticleConstants) == 64);
+
+	// Renderer-side view of one scene emitter: the spawn sequence already handed to the GPU and a
+	// generation that is bumped on restart (the simulation kills particles of older generations).
+	struct GpuParticleEmitterState
+	{
+		std::uint32_t spawnedSequence{ 0 };
+		std::uint32_t generation{ 0 };
+	};
+
+	// Compute skinning pre-pass (SkinningCompute_dx12.hlsl): every skinned draw's bind-pose vertices are
+	// skinned once per frame into a slice of the renderer's skinned vertex cache, which the later passes
+	// draw like a static mesh (boneCount 0 in uSkinning).
+	constexpr std::uint32_t kSkinnedVertexCacheCapacity = 1u << 19; // vertices (36 MB)
+	constexpr std::uint32_t kNoSkinnedVertexCache = ~0u;
+
+	struct alignas(16) SkinningComputeConstants
+	{
+		std::array<std::uint32_t, 4> uSkinning{}; // vertex count, first cached vertex, palette offset, bone count
+	};
+	static_assert(sizeof(SkinningComputeConstants) == 16);
+
 	// shadow metadata for Spot/Point arrays (bound as StructuredBuffer at t11).
 	// We pack indices/bias as floats to keep the struct simple across compilers.
 	struct alignas(16) ShadowDataSB
@@ -111,10 +266,12 @@ export namespace rendern
 		// dirInfo = { invAtlasW, invAtlasH, invTileRes, cascadeCount }
 		mathUtils::Vec4 dirInfo{};
 
-		// Spot view-projection matrices as ROWS (4 matrices * 4 rows = 16 float4).
+		// Spot view-projection matrices as ROWS (kMaxSpotShadows matrices * 4 rows).
 		std::array<mathUtils::Vec4, kMaxSpotShadows * 4> spotVPRows{};
 		// spotInfo[i] = { lightIndexBits, bias, 0, 0 }
 		std::array<mathUtils::Vec4, kMaxSpotShadows>     spotInfo{};
+		// Tile of spot shadow i in the spot atlas: { u0, v0, tileSize / atlasSize, 1 / tileSize }
+		std::array<mathUtils::Vec4, kMaxSpotShadows>     spotAtlasRect{};
 
 		// pointPosRange[i] = { pos.x, pos.y, pos.z, range }
 		std::array<mathUtils::Vec4, kMaxPointShadows>    pointPosRange{};
@@ -124,10 +281,11 @@ export namespace rendern
 	static_assert((sizeof(ShadowDataSB) % 16) == 0);
 
 	// ---------------- Spot/Point shadow maps (arrays) ----------------
+	// Spot shadows are tiles of one atlas texture (spotShadowAtlasRG).
 	struct SpotShadowRec
 	{
-		renderGraph::RGTextureHandle tex{};
 		mathUtils::Mat4 viewProj{};
+		ShadowAtlasTile tile{};
 		std::uint32_t lightIndex{ 0 };
 	};
 
@@ -145,19 +303,53 @@ export namespace rendern
 		std::array<float, 16> uMVP{}; // lightProj * lightView * model
 	};
 
+	// Persistent depth holding only the static casters of one shadow atlas (directional or spot).
+	// It stays valid while the views (matrices and tiles) and the static caster content (staticHash) are unchanged.
+	struct ShadowCacheEntry
+	{
+		rhi::TextureHandle depth{};
+		rhi::Extent2D extent{};
+		std::array<mathUtils::Mat4, kMaxShadowCacheViews> viewProj{}; // per cascade / spot tile
+		std::array<ShadowAtlasTile, kMaxShadowCacheViews> tiles{};
+		std::size_t viewCount{ 0 };
+		std::size_t staticHash{ 0 };
+		bool valid{ false };
+	};
+
 	struct ShadowBatch
 	{
 		const rendern::MeshRHI* mesh{};
-		std::uint32_t instanceOffset{ 0 }; // in combinedInstances[]
+		std::uint32_t instanceOffset{ 0 }; // in combinedInstanceRefs[] (= instanceBuffer_)
 		std::uint32_t instanceCount{ 0 };
 	};
 
+	// The shadow batches one view draws, and the index of batches[0]'s record in the shadow indirect
+	// args (~0u = kNoShadowIndirectArgs: one DrawIndexed per batch).
+	struct ShadowDrawList
+	{
+		std::vector<ShadowBatch> batches;
+		std::uint32_t argsBase{ ~0u };
+	};
+
+	// Directional atlas kept across frames for the amortized far-cascade schedule
+	// (RendererSettings::dirShadowFarCascadeInterval). Each tile keeps the matrix it was last rendered with.
+	struct CascadeScheduleState
+	{
+		rhi::TextureHandle atlas{};
+		rhi::Extent2D extent{};
+		std::array<mathUtils::Mat4, kMaxDirCascades> viewProj{};
+		std::array<bool, kMaxDirCascades> rendered{};
+		mathUtils::Vec3 lightDir{ 0.0f, 0.0f, 0.0f };
+		std::uint64_t frame{ 0 };
+	};
+
 	struct TransparentDraw
 	{
 		const rendern::MeshRHI* mesh{};
 		MaterialParams material{};
 		MaterialHandle materialHandle{};
 		std::uint32_t instanceOffset{ 0 }; // absolute offset in combined instance buffer
+		std::uint32_t instanceCount{ 1 };  // 1 when sorted; a whole batch with weighted blended OIT
 		float dist2{ 0.0f };               // for sorting (bigger first)
 	};
 
@@ -169,6 +361,7 @@ export namespace rendern
 		std::uint32_t instanceOffset{ 0 }; // absolute offset in combined instance buffer
 		mathUtils::Vec3 planePoint{ 0.0f, 0.0f, 0.0f };
 		mathUtils::Vec3 planeNormal{ 0.0f, 1.0f, 0.0f };
+		mathUtils::Vec4 boundsSphere{ 0.0f, 0.0f, 0.0f, 0.0f }; // world center + radius (0: unknown)
 	};
 
 	struct TransparentTemp
@@ -177,6 +370,7 @@ export namespace rendern
 		MaterialParams material{};
 		MaterialHandle materialHandle{};
 		std::uint32_t localInstanceOffset{};
+		std::uint32_t instanceCount{ 1 };
 		float dist2{};
 	};
 
@@ -189,12 +383,20 @@ export namespace rendern
 	{
 		int ownerDrawItem = -1;
 		mathUtils::Vec3 capturePos{};
-		bool dirty = true;
 		bool hasLastPos = false;
 		mathUtils::Vec3 lastPos{};
 		rhi::TextureHandle cube{};
 		rhi::TextureHandle depthCube{};
 		rhi::TextureDescIndex cubeDescIndex{};
+		// Time-sliced recapture (ScheduleReflectionProbeFaces): faces still waiting for a capture,
+		// whether every face has been captured once, and how many frames the probe has been waiting.
+		std::uint8_t staleFaces = kAllReflectionProbeFaces;
+		bool captured = false;
+		std::uint32_t framesWaiting = 0;
+		// Static probes (static owner) are not refreshed every frame; they recapture when they move or
+		// when neighbourhoodHash (the static items around them) changes.
+		bool isStatic = false;
+		std::size_t neighbourhoodHash = 0;
 	};
 
 	struct BatchKey
@@ -255,14 +457,175 @@ export namespace rendern
 		}
 	};
 
-	struct BatchTemp
+	struct BatchKeyHash
 	{
-		MaterialParams material{};
-		MaterialHandle materialHandle{};
-		int reflectionProbeIndex = -1;
-		std::vector<InstanceData> inst;
+		static std::size_t HashU32(std::uint32_t value) noexcept { return std::hash<std::uint32_t>{}(value); }
+		static std::size_t HashPtr(const void* ptr) noexcept { return std::hash<const void*>{}(ptr); }
+
+		static std::uint32_t FloatBits(float value) noexcept
+		{
+			std::uint32_t bits{};
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		std::size_t operator()(const rendern::BatchKey& key) const noexcept
+		{
+			std::size_t seed = HashPtr(key.mesh);
+
+			hashUtils::HashCombine(seed, HashU32(key.permBits));
+
+			hashUtils::HashCombine(seed, HashU32(key.envSource));
+			hashUtils::HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.reflectionProbeIndex)));
+
+			hashUtils::HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.albedoDescIndex)));
+			hashUtils::HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.normalDescIndex)));
+			hashUtils::HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.metalnessDescIndex)));
+			hashUtils::HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.roughnessDescIndex)));
+			hashUtils::HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.aoDescIndex)));
+			hashUtils::HashCombine(seed, HashU32(static_cast<std::uint32_t>(key.emissiveDescIndex)));
+
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.baseColor.x)));
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.baseColor.y)));
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.baseColor.z)));
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.baseColor.w)));
+
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.shadowBias)));
+
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.metallic)));
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.roughness)));
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.ao)));
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.emissiveStrength)));
+
+			// Legacy
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.shininess)));
+			hashUtils::HashCombine(seed, HashU32(FloatBits(key.specStrength)));
+			return seed;
+		}
+	};
+
+	// Passes that share the per-frame draw key sort, in key order.
+	enum class DrawPass : std::uint32_t
+	{
+		Shadow = 0,
+		Main = 1,
+		CaptureNoCull = 2,
+		Transparent = 3
 	};
 
+	// One draw of one pass: its sort key and the scene draw item it came from.
+	struct DrawSortEntry
+	{
+		std::uint64_t key{ 0 };
+		std::uint32_t drawItemIndex{ 0 };
+	};
+
+	// What one scene draw item contributes this frame. Filled per item by the parallel part of the
+	// build-instances stage; the mesh ids and materialState are assigned afterwards on the render thread.
+	struct DrawItemPrep
+	{
+		enum Flags : std::uint32_t
+		{
+			Visible = 1u << 0,        // passed camera culling (frame stats)
+			ShadowKey = 1u << 1,
+			CaptureKey = 1u << 2,
+			MainKey = 1u << 3,
+			TransparentKey = 1u << 4,
+			PlanarMirror = 1u << 5,   // mirror candidate: becomes a mirror or a main key in item order
+			StaticShadow = 1u << 6,   // static caster: its shadow key sorts into the cached static batches
+			TransformDirty = 1u << 7, // model differs from its resident instance transform slot
+			PrepassOccluder = 1u << 8, // main key large enough on screen for the depth prepass
+			CaptureCandidate = 1u << 9, // drawn by reflection capture when uploaded (not alpha blended)
+			Used = 1u << 10           // drawn by some pass this frame: camera, shadow view or capture (residency feedback)
+		};
+
+		std::uint32_t flags{ 0 };
+		std::uint32_t perm{ 0 };      // MaterialPerm bits
+		float dist2{ 0.0f };          // transparent: squared camera distance
+		std::uint32_t lod{ 0 };       // mesh level of detail of the main / transparent draws
+		std::uint32_t shadowLod{ 0 }; // ... and of the shadow draws (capture draws use level 0)
+		std::uint32_t meshId{ 0 };    // ids of the levels' MeshRHI views (DrawMeshId)
+		std::uint32_t shadowMeshId{ 0 };
+		std::uint32_t captureMeshId{ 0 };
+		std::uint32_t materialState{ 0 };
+		std::uint32_t shadowCascadeMask{ 0 }; // bit c: inside cascade c's light-space box (cascade caster culling)
+		std::uint32_t pointShadowFaceMask{ 0 }; // bit p * kPointShadowFaces + f: touches face f of layered point shadow p
+		std::uint32_t spotShadowMask{ 0 };      // bit s: inside the frustum of spot shadow s
+	};
+
+	// Draw key layout, most significant bits first:
+	//   opaque passes: pass:3 | pipeline (MaterialPerm bits):5 | material state:22 | reflection probe + 1:5 | mesh:29
+	//   (shadow keys use the pipeline field for kStaticShadowBits only, so static casters sort after dynamic ones)
+	//   (deferred main keys order the same fields mesh first, see OpaqueMeshMajor)
+	//   transparent:   pass:3 | zero:29 | inverted float bits of the squared camera distance:32 (far to near)
+	//   (with weighted blended OIT transparent keys use the opaque layout instead, see TransparentBatched)
+	// Equal opaque keys share pipeline, constants, textures, probe and mesh, so after sorting every
+	// batch is a run of equal keys.
+	namespace drawKey
+	{
+		inline constexpr std::uint32_t kPassShift = 61;
+		inline constexpr std::uint32_t kPipelineShift = 56;
+		inline constexpr std::uint32_t kMaterialShift = 34;
+		inline constexpr std::uint32_t kProbeShift = 29;
+
+		inline constexpr std::uint32_t kStaticShadowBits = 1u;
+
+		inline constexpr std::uint32_t kMaxMaterialStates = 1u << 22;
+		inline constexpr std::uint32_t kMaxMeshes = 1u << 29;
+
+		constexpr std::uint64_t Opaque(DrawPass pass, std::uint32_t pipelineBits, std::uint32_t materialState, int reflectionProbeIndex, std::uint32_t meshId) noexcept
+		{
+			const std::uint64_t probeSlot = static_cast<std::uint64_t>(reflectionProbeIndex + 1) & 0x1Fu;
+			return (static_cast<std::uint64_t>(pass) << kPassShift) |
+				(static_cast<std::uint64_t>(pipelineBits & 0x1Fu) << kPipelineShift) |
+				(static_cast<std::uint64_t>(materialState & (kMaxMaterialStates - 1u)) << kMaterialShift) |
+				(probeSlot << kProbeShift) |
+				static_cast<std::uint64_t>(meshId & (kMaxMeshes - 1u));
+		}
+
+		// Main keys of the deferred G-buffer with the material table (MaterialGpu): one pipeline for every
+		// material, so the mesh goes above the material state and the batches of one mesh and probe end up
+		// next to each other in instanceBuffer_, where the G-buffer pass draws them as one.
+		//   pass:3 | reflection probe + 1:5 | zero:5 | mesh:29 | material state:22
+		constexpr std::uint64_t OpaqueMeshMajor(DrawPass pass, std::uint32_t materialState, int reflectionProbeIndex, std::uint32_t meshId) noexcept
+		{
+			const std::uint64_t probeSlot = static_cast<std::uint64_t>(reflectionProbeIndex + 1) & 0x1Fu;
+			return (static_cast<std::uint64_t>(pass) << kPassShift) |
+				(probeSlot << kPipelineShift) |
+				(static_cast<std::uint64_t>(meshId & (kMaxMeshes - 1u)) << 22u) |
+				static_cast<std::uint64_t>(materialState & (kMaxMaterialStates - 1u));
+		}
+
+		inline std::uint64_t Transparent(float dist2) noexcept
+		{
+			// Non-negative floats order like their bit patterns; NaN sorts as distance 0.
+			const std::uint32_t bits = std::bit_cast<std::uint32_t>(dist2 > 0.0f ? dist2 : 0.0f);
+			return (static_cast<std::uint64_t>(DrawPass::Transparent) << kPassShift) | static_cast<std::uint64_t>(~bits);
+		}
+
+		// Weighted blended OIT does not depend on draw order, so transparent items batch like opaque ones.
+		// The env binding of a transparent draw only depends on the material state, so there is no probe.
+		constexpr std::uint64_t TransparentBatched(std::uint32_t pipelineBits, std::uint32_t materialState, std::uint32_t meshId) noexcept
+		{
+			return Opaque(DrawPass::Transparent, pipelineBits, materialState, -1, meshId);
+		}
+
+		inline float TransparentDist2(std::uint64_t key) noexcept
+		{
+			return std::bit_cast<float>(~static_cast<std::uint32_t>(key));
+		}
+
+		constexpr DrawPass PassOf(std::uint64_t key) noexcept
+		{
+			return static_cast<DrawPass>(key >> kPassShift);
+		}
+
+		constexpr std::uint32_t PipelineOf(std::uint64_t key) noexcept
+		{
+			return static_cast<std::uint32_t>(key >> kPipelineShift) & 0x1Fu;
+		}
+	}
+
 	struct Batch
 	{
 		const rendern::MeshRHI* mesh{};
@@ -271,6 +634,7 @@ export namespace rendern
 		std::uint32_t instanceOffset = 0; // in instances[]
 		std::uint32_t instanceCount = 0;
 		int reflectionProbeIndex = -1;
+		mathUtils::Vec4 boundsSphere{};
 	};
 
 	struct SkinnedOpaqueDraw
@@ -282,6 +646,8 @@ export namespace rendern
 		std::uint32_t paletteOffset{ 0 };
 		std::uint32_t boneCount{ 0 };
 		int sourceSkinnedDrawIndex{ -1 };
+		// First vertex of this draw in the skinned vertex cache; kNoSkinnedVertexCache = skinned in the vertex shader.
+		std::uint32_t cachedVertexOffset{ kNoSkinnedVertexCache };
 	};
 
 	struct alignas(16) PerBatchConstants
@@ -313,11 +679,61 @@ export namespace rendern
 		// Packed as float4 to keep the constant buffer simple across backends.
 		// x=albedo, y=normal, z=metalness, w=roughness
 		std::array<float, 4> uTexIndices0{};
-		// x=ao, y=emissive, z,w unused
+		// x=ao, y=emissive, z=G-buffer: bits of the instanceBuffer_ index of the batch's first instance, w unused
 		std::array<float, 4> uTexIndices1{};
 	};
 	static_assert(sizeof(PerBatchConstants) == 304);
 
+	// Entry of the deferred material table (MaterialTableSB, DeferredGBuffer_dx12.hlsl gMaterials):
+	// entry 0 = items without a material, entry h = the scene material with handle id h.
+	struct MaterialGpu
+	{
+		std::array<float, 4> baseColor{};
+		std::array<float, 4> pbr{};                 // metallic, roughness, ao, emissiveStrength
+		std::array<std::uint32_t, 4> textures0{};   // albedo, normal, metalness, roughness descriptor indices
+		std::array<std::uint32_t, 4> textures1{};   // ao, emissive descriptor indices, flags, env source
+
+		bool operator==(const MaterialGpu&) const = default;
+	};
+	static_assert(sizeof(MaterialGpu) == 64);
+
+	// Flags must match DeferredGBuffer_dx12.hlsl (and the per-draw flags of the skinned G-buffer draws).
+	inline constexpr std::uint32_t kGBufferFlagUseTex = 1u << 0;
+	inline constexpr std::uint32_t kGBufferFlagUseNormal = 1u << 2;
+	inline constexpr std::uint32_t kGBufferFlagUseMetalTex = 1u << 3;
+	inline constexpr std::uint32_t kGBufferFlagUseRoughTex = 1u << 4;
+	inline constexpr std::uint32_t kGBufferFlagUseAOTex = 1u << 5;
+	inline constexpr std::uint32_t kGBufferFlagUseEmissiveTex = 1u << 6;
+
+	inline MaterialGpu PackMaterialGpu(const MaterialParams& params, MaterialPerm perm, EnvSource envSource) noexcept
+	{
+		std::uint32_t flags = 0u;
+		if (HasFlag(perm, MaterialPerm::UseTex) && params.albedoDescIndex != 0)
+		{
+			flags |= kGBufferFlagUseTex;
+		}
+		flags |= params.normalDescIndex != 0 ? kGBufferFlagUseNormal : 0u;
+		flags |= params.metalnessDescIndex != 0 ? kGBufferFlagUseMetalTex : 0u;
+		flags |= params.roughnessDescIndex != 0 ? kGBufferFlagUseRoughTex : 0u;
+		flags |= params.aoDescIndex != 0 ? kGBufferFlagUseAOTex : 0u;
+		flags |= params.emissiveDescIndex != 0 ? kGBufferFlagUseEmissiveTex : 0u;
+
+		MaterialGpu gpu{};
+		gpu.baseColor = { params.baseColor.x, params.baseColor.y, params.baseColor.z, params.baseColor.w };
+		gpu.pbr = { params.metallic, params.roughness, params.ao, params.emissiveStrength };
+		gpu.textures0 = {
+			static_cast<std::uint32_t>(params.albedoDescIndex),
+			static_cast<std::uint32_t>(params.normalDescIndex),
+			static_cast<std::uint32_t>(params.metalnessDescIndex),
+			static_cast<std::uint32_t>(params.roughnessDescIndex) };
+		gpu.textures1 = {
+			static_cast<std::uint32_t>(params.aoDescIndex),
+			static_cast<std::uint32_t>(params.emissiveDescIndex),
+			flags,
+			envSource == EnvSource::ReflectionCapture ? 1u : 0u };
+		return gpu;
+	}
+
 	struct alignas(16) SkinnedPerDrawConstants
 	{
 		std::array<float, 16> uViewProj{};
@@ -338,6 +754,28 @@ export namespace rendern
 	};
 	static_assert(sizeof(SkinnedPerDrawConstants) == 384);
 
+	// Meshlets one amplification group tests (kMeshletsPerGroup in Meshlet_dx12.hlsli).
+	constexpr std::uint32_t kMeshletsPerTaskGroup = 32;
+
+	// Mesh-shader G-buffer pass (DeferredGBufferMeshlet_dx12.hlsl): the batch constants, then what the
+	// amplification shader culls meshlets with.
+	struct alignas(16) MeshletGBufferConstants
+	{
+		PerBatchConstants batch{};
+		std::array<float, 4 * 6> uPlanes{};          // frustum planes (n.xyz, d), inside if dot(n, p) + d >= 0
+		std::array<std::uint32_t, 4> uMeshlet{};     // firstMeshlet, meshletCount, first instance, instanceCount
+	};
+	static_assert(sizeof(MeshletGBufferConstants) == 416);
+
+	// Mesh-shader shadow pass (ShadowDepthMeshlet_dx12.hlsl). Casters draw two-sided: frustum culling only.
+	struct alignas(16) MeshletShadowConstants
+	{
+		std::array<float, 16> uLightViewProj{};
+		std::array<float, 4 * 6> uPlanes{};
+		std::array<std::uint32_t, 4> uMeshlet{};     // firstMeshlet, meshletCount, first instance, instanceCount
+	};
+	static_assert(sizeof(MeshletShadowConstants) == 176);
+
 	struct alignas(16) SkinnedSingleMatrixPassConstants
 	{
 		std::array<float, 16> uLightViewProj{};
@@ -346,6 +784,25 @@ export namespace rendern
 	};
 	static_assert(sizeof(SkinnedSingleMatrixPassConstants) == 144);
 
+	// ObjectId_dx12.hlsl: uObject.x = instanceBuffer_ index of the batch's first instance (the
+	// objectIdBuffer_ entry of instance i is uObject.x + SV_InstanceID).
+	struct alignas(16) ObjectIdPassConstants
+	{
+		std::array<float, 16> uViewProj{};
+		std::array<std::uint32_t, 4> uObject{};
+	};
+	static_assert(sizeof(ObjectIdPassConstants) == 80);
+
+	// ObjectIdSkinned_dx12.hlsl: uObject.x = the draw's object ID.
+	struct alignas(16) SkinnedObjectIdPassConstants
+	{
+		std::array<float, 16> uViewProj{};
+		std::array<float, 16> uModel{};
+		std::array<float, 4> uSkinning{};
+		std::array<std::uint32_t, 4> uObject{};
+	};
+	static_assert(sizeof(SkinnedObjectIdPassConstants) == 160);
+
 	struct alignas(16) SkinnedPointShadowCubeConstants
 	{
 		std::array<float, 16 * 6> uFaceViewProj{};
@@ -458,6 +915,13 @@ export namespace rendern
 	};
 	static_assert(sizeof(FXAAConstants) % 16 == 0);
 
+	struct alignas(16) UpscaleConstants
+	{
+		mathUtils::Vec4 uSourceSize{}; // w, h, 1/w, 1/h of the scaled image
+		mathUtils::Vec4 uParams{};     // x=sharpness
+	};
+	static_assert(sizeof(UpscaleConstants) % 16 == 0);
+
 	struct FrameCameraData
 	{
 		mathUtils::Mat4 proj{ 1.0f };
@@ -485,11 +949,4 @@ export namespace rendern
 		std::array<float, 4>  uCounts{};           // x = lightCount, y = spotShadowCount, z = pointShadowCount, w = activeReflectionProbeCount
 	};
 	static_assert(sizeof(DeferredLightingConstants) == 128);
-
-	struct ParticleDrawBatch
-	{
-		rhi::TextureDescIndex textureDescIndex{ 0 };
-		std::uint32_t instanceOffset{ 0 };
-		std::uint32_t instanceCount{ 0 };
-	};
 }
\ No newline at end of file
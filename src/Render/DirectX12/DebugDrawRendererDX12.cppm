@@ -25,6 +25,8 @@ export namespace rendern::debugDraw
 		{
 		}
 
+		// Copies this frame's lines and shape instances into the next region of the stream ring:
+		// [line vertices | depth shape instances | overlay shape instances].
 		void Upload(const DebugDrawList& list)
 		{
 			EnsureResources();
@@ -33,37 +35,72 @@ export namespace rendern::debugDraw
 			lastOverlayVertexCount_ = static_cast<std::uint32_t>(list.OverlayVertexCount());
 			lastScreenOverlayVertexCount_ = static_cast<std::uint32_t>(list.ScreenOverlayVertexCount());
 			lastVertexCount_ = lastDepthVertexCount_ + lastOverlayVertexCount_ + lastScreenOverlayVertexCount_;
-			if (lastVertexCount_ == 0)
+			lastShapeInstanceCount_ = static_cast<std::uint32_t>(list.ShapeInstanceCount());
+			if (lastVertexCount_ == 0 && lastShapeInstanceCount_ == 0)
 			{
 				return;
 			}
 
-			EnsureVertexBufferCapacity(lastVertexCount_);
+			const std::size_t vertexBytes = static_cast<std::size_t>(lastVertexCount_) * sizeof(DebugVertex);
+			const std::size_t instanceBytes = static_cast<std::size_t>(lastShapeInstanceCount_) * sizeof(DebugShapeInstance);
+			EnsureStreamCapacity(vertexBytes + instanceBytes);
+
+			ringRegion_ = (ringRegion_ + 1u) % ringRegionCount_;
+			regionOffsetBytes_ = static_cast<std::uint32_t>(ringRegion_ * regionBytes_);
+			instanceOffsetBytes_ = regionOffsetBytes_ + static_cast<std::uint32_t>(vertexBytes);
+
+			const std::span<std::byte> mapped = device_.MapBuffer(streamBuffer_);
+			std::size_t writeOffset = 0;
+			auto Write = [&]<typename T>(const std::vector<T>& items)
+				{
+					const std::span<const std::byte> bytes = std::as_bytes(std::span{ items });
+					if (bytes.empty())
+					{
+						return;
+					}
+					if (!mapped.empty())
+					{
+						std::memcpy(mapped.data() + regionOffsetBytes_ + writeOffset, bytes.data(), bytes.size());
+					}
+					else
+					{
+						uploadScratch_.insert(uploadScratch_.end(), bytes.begin(), bytes.end());
+					}
+					writeOffset += bytes.size();
+				};
 
 			uploadScratch_.clear();
-			uploadScratch_.reserve(list.lineVertices.size() + list.overlayLineVertices.size() + list.screenOverlayLineVertices.size());
-			uploadScratch_.insert(uploadScratch_.end(), list.lineVertices.begin(), list.lineVertices.end());
-			uploadScratch_.insert(uploadScratch_.end(), list.overlayLineVertices.begin(), list.overlayLineVertices.end());
-			uploadScratch_.insert(uploadScratch_.end(), list.screenOverlayLineVertices.begin(), list.screenOverlayLineVertices.end());
+			Write(list.lineVertices);
+			Write(list.overlayLineVertices);
+			Write(list.screenOverlayLineVertices);
 
-			const std::span<const DebugVertex> verts{ uploadScratch_.data(), uploadScratch_.size() };
-			device_.UpdateBuffer(vertexBuffer_, std::as_bytes(verts), 0);
+			std::uint32_t firstInstance = 0;
+			for (std::size_t overlay = 0; overlay < 2; ++overlay)
+			{
+				const auto& shapes = overlay ? list.overlayShapeInstances : list.shapeInstances;
+				for (std::size_t shape = 0; shape < kDebugShapeCount; ++shape)
+				{
+					Write(shapes[shape]);
+					shapeBatches_[overlay][shape] = ShapeBatch{ firstInstance, static_cast<std::uint32_t>(shapes[shape].size()) };
+					firstInstance += static_cast<std::uint32_t>(shapes[shape].size());
+				}
+			}
+
+			if (mapped.empty())
+			{
+				device_.UpdateBuffer(streamBuffer_, uploadScratch_, regionOffsetBytes_);
+			}
 		}
 
 		void Draw(rhi::CommandList& cmd, const mathUtils::Mat4& viewProj, bool depthTest)
 		{
-			if (lastVertexCount_ == 0)
+			if (lastVertexCount_ == 0 && lastShapeInstanceCount_ == 0)
 			{
 				return;
 			}
 
 			EnsureResources();
 
-			cmd.BindPipeline(psoLines_);
-			cmd.BindInputLayout(inputLayout_);
-			cmd.BindVertexBuffer(0, vertexBuffer_, static_cast<std::uint32_t>(sizeof(DebugVertex)), 0);
-			cmd.SetPrimitiveTopology(rhi::PrimitiveTopology::LineList);
-
 			struct alignas(16) Constants
 			{
 				std::array<float, 16> uViewProj{};
@@ -72,46 +109,73 @@ export namespace rendern::debugDraw
 			Constants c{};
 			const mathUtils::Mat4 vpT = mathUtils::Transpose(viewProj);
 			std::memcpy(c.uViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
-			cmd.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
 
+			rhi::GraphicsState depthState{};
+			depthState.depth.testEnable = depthTest;
+			depthState.depth.writeEnable = false;
+			depthState.depth.depthCompareOp = rhi::CompareOp::LessEqual;
+			depthState.rasterizer.cullMode = rhi::CullMode::None;
+			depthState.blend.enable = false;
+
+			rhi::GraphicsState overlayState{};
+			overlayState.depth.testEnable = false;
+			overlayState.depth.writeEnable = false;
+			overlayState.depth.depthCompareOp = rhi::CompareOp::Always;
+			overlayState.rasterizer.cullMode = rhi::CullMode::None;
+			overlayState.blend.enable = false;
+
+			auto BindLines = [&]()
+				{
+					cmd.BindPipeline(psoLines_);
+					cmd.BindInputLayout(inputLayout_);
+					cmd.BindVertexBuffer(0, streamBuffer_, static_cast<std::uint32_t>(sizeof(DebugVertex)), regionOffsetBytes_);
+					cmd.SetPrimitiveTopology(rhi::PrimitiveTopology::LineList);
+					cmd.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
+				};
+			auto DrawShapes = [&](std::size_t overlay)
+				{
+					bool bound = false;
+					for (std::size_t shape = 0; shape < kDebugShapeCount; ++shape)
+					{
+						const ShapeBatch& batch = shapeBatches_[overlay][shape];
+						if (batch.instanceCount == 0)
+						{
+							continue;
+						}
+						if (!bound)
+						{
+							cmd.BindPipeline(psoShapes_);
+							cmd.BindInputLayout(shapeInputLayout_);
+							cmd.BindVertexBuffer(0, shapeMeshBuffer_, static_cast<std::uint32_t>(sizeof(DebugShapeVertex)), 0);
+							cmd.BindVertexBuffer(1, streamBuffer_, static_cast<std::uint32_t>(sizeof(DebugShapeInstance)), instanceOffsetBytes_);
+							cmd.SetPrimitiveTopology(rhi::PrimitiveTopology::LineList);
+							cmd.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
+							bound = true;
+						}
+						cmd.Draw(shapeMeshes_[shape].vertexCount, shapeMeshes_[shape].firstVertex, batch.instanceCount, batch.firstInstance);
+					}
+				};
+
+			cmd.SetState(depthState);
 			if (lastDepthVertexCount_ > 0)
 			{
-				rhi::GraphicsState depthState{};
-				depthState.depth.testEnable = depthTest;
-				depthState.depth.writeEnable = false;
-				depthState.depth.depthCompareOp = rhi::CompareOp::LessEqual;
-				depthState.rasterizer.cullMode = rhi::CullMode::None;
-				depthState.blend.enable = false;
-
-				cmd.SetState(depthState);
+				BindLines();
 				cmd.Draw(lastDepthVertexCount_, 0);
 			}
+			DrawShapes(0);
 
+			cmd.SetState(overlayState);
 			const std::uint32_t overlayStartVertex = lastDepthVertexCount_;
-			if (lastOverlayVertexCount_ > 0)
+			if (lastOverlayVertexCount_ > 0 || lastScreenOverlayVertexCount_ > 0)
 			{
-				rhi::GraphicsState overlayState{};
-				overlayState.depth.testEnable = false;
-				overlayState.depth.writeEnable = false;
-				overlayState.depth.depthCompareOp = rhi::CompareOp::Always;
-				overlayState.rasterizer.cullMode = rhi::CullMode::None;
-				overlayState.blend.enable = false;
-
-				cmd.SetState(overlayState);
-				cmd.Draw(lastOverlayVertexCount_, overlayStartVertex);
+				BindLines();
+				if (lastOverlayVertexCount_ > 0)
+				{
+					cmd.Draw(lastOverlayVertexCount_, overlayStartVertex);
+				}
 			}
-
 			if (lastScreenOverlayVertexCount_ > 0)
 			{
-				rhi::GraphicsState overlayState{};
-				overlayState.depth.testEnable = false;
-				overlayState.depth.writeEnable = false;
-				overlayState.depth.depthCompareOp = rhi::CompareOp::Always;
-				overlayState.rasterizer.cullMode = rhi::CullMode::None;
-				overlayState.blend.enable = false;
-
-				cmd.SetState(overlayState);
-
 				Constants screenC{};
 				const mathUtils::Mat4 identityT = mathUtils::Transpose(mathUtils::Mat4(1.0f));
 				std::memcpy(screenC.uViewProj.data(), mathUtils::ValuePtr(identityT), sizeof(float) * 16);
@@ -119,20 +183,31 @@ export namespace rendern::debugDraw
 
 				cmd.Draw(lastScreenOverlayVertexCount_, overlayStartVertex + lastOverlayVertexCount_);
 			}
+			DrawShapes(1);
 		}
 
 		void Shutdown()
 		{
-			if (vertexBuffer_)
+			if (streamBuffer_)
+			{
+				device_.DestroyBuffer(streamBuffer_);
+				streamBuffer_ = {};
+			}
+			if (shapeMeshBuffer_)
 			{
-				device_.DestroyBuffer(vertexBuffer_);
-				vertexBuffer_ = {};
+				device_.DestroyBuffer(shapeMeshBuffer_);
+				shapeMeshBuffer_ = {};
 			}
-			vbCapacityVertices_ = 0;
+			regionBytes_ = 0;
+			ringRegion_ = 0;
+			regionOffsetBytes_ = 0;
+			instanceOffsetBytes_ = 0;
 			lastVertexCount_ = 0;
 			lastDepthVertexCount_ = 0;
 			lastOverlayVertexCount_ = 0;
 			lastScreenOverlayVertexCount_ = 0;
+			lastShapeInstanceCount_ = 0;
+			shapeBatches_ = {};
 			uploadScratch_.clear();
 
 			if (inputLayout_)
@@ -140,12 +215,30 @@ export namespace rendern::debugDraw
 				device_.DestroyInputLayout(inputLayout_);
 				inputLayout_ = {};
 			}
+			if (shapeInputLayout_)
+			{
+				device_.DestroyInputLayout(shapeInputLayout_);
+				shapeInputLayout_ = {};
+			}
 
 			psoLines_ = {};
+			psoShapes_ = {};
 			initialized_ = false;
 		}
 
 	private:
+		struct ShapeBatch
+		{
+			std::uint32_t firstInstance{ 0 };
+			std::uint32_t instanceCount{ 0 };
+		};
+
+		struct ShapeMeshRange
+		{
+			std::uint32_t firstVertex{ 0 };
+			std::uint32_t vertexCount{ 0 };
+		};
+
 		void EnsureResources()
 		{
 			if (initialized_)
@@ -176,6 +269,20 @@ export namespace rendern::debugDraw
 			};
 			inputLayout_ = device_.CreateInputLayout(il);
 
+			// Slot 0: unit shape mesh, slot 1: DebugShapeInstance (per instance).
+			rhi::InputLayoutDesc shapeIl{};
+			shapeIl.debugName = "DebugShapesInputLayout";
+			shapeIl.strideBytes = static_cast<std::uint32_t>(sizeof(DebugShapeVertex));
+			shapeIl.attributes = {
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Position,.semanticIndex = 0,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 0,.offsetBytes = 0 },
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 1,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 0 },
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 2,.format = rhi::VertexFormat::R32G32B32_FLOAT,.inputSlot = 1,.offsetBytes = 16 },
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 3,.format = rhi::VertexFormat::R32G32B32_FLOAT,.inputSlot = 1,.offsetBytes = 28 },
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 4,.format = rhi::VertexFormat::R32G32B32_FLOAT,.inputSlot = 1,.offsetBytes = 40 },
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Color,.semanticIndex = 0,.format = rhi::VertexFormat::R8G8B8A8_UNORM,.inputSlot = 1,.offsetBytes = 52,.normalized = true },
+			};
+			shapeInputLayout_ = device_.CreateInputLayout(shapeIl);
+
 			const std::filesystem::path shaderPath = corefs::ResolveAsset("shaders\\DebugLines_dx12.hlsl");
 
 			rendern::ShaderKey vsKey{};
@@ -184,6 +291,10 @@ export namespace rendern::debugDraw
 			vsKey.filePath = shaderPath.string();
 			rhi::ShaderHandle vs = shaderLibrary_.GetOrCreateShader(vsKey);
 
+			rendern::ShaderKey shapeVsKey = vsKey;
+			shapeVsKey.name = "VS_DebugShapes";
+			rhi::ShaderHandle shapeVs = shaderLibrary_.GetOrCreateShader(shapeVsKey);
+
 			rendern::ShaderKey psKey{};
 			psKey.stage = rhi::ShaderStage::Pixel;
 			psKey.name = "PS_DebugLines";
@@ -191,55 +302,99 @@ export namespace rendern::debugDraw
 			rhi::ShaderHandle ps = shaderLibrary_.GetOrCreateShader(psKey);
 
 			psoLines_ = psoCache_.GetOrCreate("PSO_DebugLines", vs, ps, rhi::PrimitiveTopologyType::Line);
+			psoShapes_ = psoCache_.GetOrCreate("PSO_DebugShapes", shapeVs, ps, rhi::PrimitiveTopologyType::Line);
 
-			EnsureVertexBufferCapacity(4096);
+			CreateShapeMeshes();
+
+			ringRegionCount_ = std::max(device_.GetFramesInFlight(), 1u);
+			EnsureStreamCapacity(kMinRegionBytes);
 
 			initialized_ = true;
 		}
 
-		void EnsureVertexBufferCapacity(std::uint32_t vertexCount)
+		void CreateShapeMeshes()
 		{
-			if (vertexBuffer_.id != 0 && vbCapacityVertices_ >= vertexCount)
+			std::vector<DebugShapeVertex> vertices;
+			for (std::size_t shape = 0; shape < kDebugShapeCount; ++shape)
 			{
-				return;
+				const std::vector<DebugShapeVertex> lines = BuildUnitShapeLines(static_cast<DebugShape>(shape));
+				shapeMeshes_[shape] = ShapeMeshRange{ static_cast<std::uint32_t>(vertices.size()), static_cast<std::uint32_t>(lines.size()) };
+				vertices.insert(vertices.end(), lines.begin(), lines.end());
 			}
 
-			std::uint32_t newCap = std::max<std::uint32_t>(vertexCount, 4096u);
-			if (vbCapacityVertices_ != 0)
+			rhi::BufferDesc desc{};
+			desc.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+			desc.usageFlag = rhi::BufferUsageFlag::Static;
+			desc.sizeInBytes = vertices.size() * sizeof(DebugShapeVertex);
+			desc.debugName = "DebugShapeMeshesVB";
+			shapeMeshBuffer_ = device_.CreateBuffer(desc);
+			device_.UpdateBuffer(shapeMeshBuffer_, std::as_bytes(std::span{ vertices }), 0);
+		}
+
+		// One region per frame in flight, so a region is only rewritten once the GPU is done with it.
+		// Growing replaces the buffer; DestroyBuffer keeps the old one alive until its frames retire.
+		void EnsureStreamCapacity(std::size_t bytesPerFrame)
+		{
+			if (streamBuffer_.id != 0 && regionBytes_ >= bytesPerFrame)
 			{
-				newCap = std::max<std::uint32_t>(newCap, vbCapacityVertices_ * 2u);
+				return;
 			}
 
-			vbCapacityVertices_ = newCap;
+			std::size_t newRegionBytes = std::max(bytesPerFrame, kMinRegionBytes);
+			if (regionBytes_ != 0)
+			{
+				newRegionBytes = std::max(newRegionBytes, regionBytes_ * 2u);
+			}
+			// Keep every region's vertex and instance offsets aligned for either stride.
+			newRegionBytes = (newRegionBytes + kRegionAlignment - 1) / kRegionAlignment * kRegionAlignment;
+			regionBytes_ = newRegionBytes;
 
-			if (vertexBuffer_.id != 0)
+			if (streamBuffer_.id != 0)
 			{
-				device_.DestroyBuffer(vertexBuffer_);
-				vertexBuffer_ = {};
+				device_.DestroyBuffer(streamBuffer_);
+				streamBuffer_ = {};
 			}
 
 			rhi::BufferDesc vbDesc{};
 			vbDesc.bindFlag = rhi::BufferBindFlag::VertexBuffer;
-			vbDesc.usageFlag = rhi::BufferUsageFlag::Dynamic;
-			vbDesc.sizeInBytes = static_cast<std::size_t>(vbCapacityVertices_) * sizeof(DebugVertex);
-			vbDesc.debugName = "DebugLinesVB";
-			vertexBuffer_ = device_.CreateBuffer(vbDesc);
+			vbDesc.usageFlag = rhi::BufferUsageFlag::Stream;
+			vbDesc.sizeInBytes = regionBytes_ * ringRegionCount_;
+			vbDesc.debugName = "DebugDrawStreamVB";
+			streamBuffer_ = device_.CreateBuffer(vbDesc);
+			ringRegion_ = 0;
 		}
 
 	private:
+		static constexpr std::size_t kMinRegionBytes = 4096 * sizeof(DebugVertex);
+		static constexpr std::size_t kRegionAlignment = 256;
+
 		rhi::IRHIDevice& device_;
 		ShaderLibrary& shaderLibrary_;
 		PSOCache& psoCache_;
 
 		rhi::InputLayoutHandle inputLayout_{};
+		rhi::InputLayoutHandle shapeInputLayout_{};
 		rhi::PipelineHandle psoLines_{};
-		rhi::BufferHandle vertexBuffer_{};
-		std::vector<DebugVertex> uploadScratch_{};
-		std::uint32_t vbCapacityVertices_{ 0 };
+		rhi::PipelineHandle psoShapes_{};
+
+		rhi::BufferHandle shapeMeshBuffer_{};
+		std::array<ShapeMeshRange, kDebugShapeCount> shapeMeshes_{};
+
+		// Stream ring: ringRegionCount_ regions of regionBytes_, one per frame.
+		rhi::BufferHandle streamBuffer_{};
+		std::size_t regionBytes_{ 0 };
+		std::uint32_t ringRegionCount_{ 1 };
+		std::uint32_t ringRegion_{ 0 };
+		std::uint32_t regionOffsetBytes_{ 0 };
+		std::uint32_t instanceOffsetBytes_{ 0 };
+		std::vector<std::byte> uploadScratch_{}; // only used when the backend can't map the stream buffer
+
 		std::uint32_t lastVertexCount_{ 0 };
 		std::uint32_t lastDepthVertexCount_{ 0 };
 		std::uint32_t lastOverlayVertexCount_{ 0 };
 		std::uint32_t lastScreenOverlayVertexCount_{ 0 };
+		std::uint32_t lastShapeInstanceCount_{ 0 };
+		std::array<std::array<ShapeBatch, kDebugShapeCount>, 2> shapeBatches_{}; // [overlay][shape]
 		bool initialized_{ false };
 	};
-}
\ No newline at end of file
+}
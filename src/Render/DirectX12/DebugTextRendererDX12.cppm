@@ -15,13 +15,18 @@ import :debug_text;
 
 export namespace rendern::debugText
 {
-	// Simple “pixel font” vertex: position in pixels (top-left origin), plus color.
-	struct DebugTextVertex
+	// One glyph quad, drawn instanced: screen rect in pixels (top-left origin), the glyph's texel
+	// rect in the atlas and its color.
+	struct DebugGlyphInstance
 	{
-		float x{};
-		float y{};
+		float xPx{};
+		float yPx{};
+		float widthPx{};
+		float heightPx{};
+		std::array<std::uint16_t, 4> atlasRect{}; // x, y, width, height in atlas texels
 		std::uint32_t rgba{ 0xffffffffu };
 	};
+	static_assert(sizeof(DebugGlyphInstance) == 28);
 
 	// Built-in 5x7 bitmap font (ASCII subset).
 	// Each glyph is 7 rows, 5 bits per row (LSB is leftmost bit 0..4).
@@ -161,20 +166,51 @@ export namespace rendern::debugText
 		}
 	}
 
-	inline void EmitQuad(std::vector<DebugTextVertex>& out, 
-		float x0, float y0, float x1, float y1, 
-		std::uint32_t rgba)
+	// 1-bit atlas of the printable ASCII range (32..127): 16 x 6 cells of 5x7 texels, row-major,
+	// packed 32 texels per uint. Lives in a StructuredBuffer<uint> (t0) rather than a texture, which
+	// keeps it a plain buffer upload.
+	inline constexpr std::uint32_t kGlyphAtlasFirstChar = 32;
+	inline constexpr std::uint32_t kGlyphAtlasColumns = 16;
+	inline constexpr std::uint32_t kGlyphAtlasRows = 6;
+	inline constexpr std::uint32_t kGlyphAtlasWidth = kGlyphAtlasColumns * 5;
+	inline constexpr std::uint32_t kGlyphAtlasHeight = kGlyphAtlasRows * 7;
+
+	inline std::vector<std::uint32_t> BuildGlyphAtlasBits()
 	{
-		// Two triangles:
-		// (x0,y0) (x1,y0) (x1,y1)
-		// (x0,y0) (x1,y1) (x0,y1)
-		out.push_back(DebugTextVertex{ x0, y0, rgba });
-		out.push_back(DebugTextVertex{ x1, y0, rgba });
-		out.push_back(DebugTextVertex{ x1, y1, rgba });
-
-		out.push_back(DebugTextVertex{ x0, y0, rgba });
-		out.push_back(DebugTextVertex{ x1, y1, rgba });
-		out.push_back(DebugTextVertex{ x0, y1, rgba });
+		std::vector<std::uint32_t> bits((kGlyphAtlasWidth * kGlyphAtlasHeight + 31) / 32, 0u);
+		for (std::uint32_t cellIndex = 0; cellIndex < kGlyphAtlasColumns * kGlyphAtlasRows; ++cellIndex)
+		{
+			const Glyph5x7& g = GetGlyph(static_cast<char>(kGlyphAtlasFirstChar + cellIndex));
+			const std::uint32_t x0 = (cellIndex % kGlyphAtlasColumns) * 5;
+			const std::uint32_t y0 = (cellIndex / kGlyphAtlasColumns) * 7;
+			for (std::uint32_t row = 0; row < 7; ++row)
+			{
+				for (std::uint32_t col = 0; col < 5; ++col)
+				{
+					if ((g.row[row] & (1u << (4 - col))) == 0)
+					{
+						continue;
+					}
+					const std::uint32_t bit = (y0 + row) * kGlyphAtlasWidth + x0 + col;
+					bits[bit / 32] |= 1u << (bit % 32);
+				}
+			}
+		}
+		return bits;
+	}
+
+	inline std::array<std::uint16_t, 4> GlyphAtlasRect(char c) noexcept
+	{
+		std::uint32_t cellIndex = static_cast<unsigned char>(c) - kGlyphAtlasFirstChar;
+		if (static_cast<unsigned char>(c) < kGlyphAtlasFirstChar || cellIndex >= kGlyphAtlasColumns * kGlyphAtlasRows)
+		{
+			cellIndex = static_cast<std::uint32_t>('?') - kGlyphAtlasFirstChar;
+		}
+		return {
+			static_cast<std::uint16_t>((cellIndex % kGlyphAtlasColumns) * 5),
+			static_cast<std::uint16_t>((cellIndex / kGlyphAtlasColumns) * 7),
+			5,
+			7 };
 	}
 
 	class DebugTextRendererDX12
@@ -187,86 +223,55 @@ export namespace rendern::debugText
 		{
 		}
 
+		// One instance per visible glyph, written into this frame's region of the instance ring.
 		void Upload(const DebugTextList& list)
 		{
 			EnsureResources();
 
-			lastVertexCount_ = 0;
-			uploadScratch_.clear();
-
-			if (list.items.empty())
-			{
-				return;
-			}
-
-			// Rough reserve: average ~60 vertices per character is usually enough for short labels.
-			std::size_t totalChars = 0;
-			for (const auto& it : list.items)
-			{
-				totalChars += it.text.size();
-			}
-			uploadScratch_.reserve(std::max<std::size_t>(256, totalChars * 60));
+			lastInstanceCount_ = 0;
+			instanceScratch_.clear();
 
 			for (const auto& it : list.items)
 			{
 				const float cell = std::max(1.0f, it.scale);
-				float penX = it.xPx;
-				float penY = it.yPx;
-
-				for (char ch : it.text)
+				for (const GlyphPlacement& glyph : layoutCache_.Get(it.text))
 				{
-					if (ch == '\n')
-					{
-						penX = it.xPx;
-						penY += cell * 8.0f;
-						continue;
-					}
-
-					const Glyph5x7& g = GetGlyph(ch);
-
-					// Render 5x7 pixels; 1 pixel spacing between glyphs.
-					for (int row = 0; row < 7; ++row)
-					{
-						const std::uint8_t bits = g.row[static_cast<std::size_t>(row)];
-						if (bits == 0)
-						{
-							continue;
-						}
-
-						for (int col = 0; col < 5; ++col)
-						{
-							const std::uint8_t mask = static_cast<std::uint8_t>(1u << (4 - col));
-							if ((bits & mask) == 0)
-							{
-								continue;
-							}
-
-							const float x0 = penX + static_cast<float>(col) * cell;
-							const float y0 = penY + static_cast<float>(row) * cell;
-							const float x1 = x0 + cell;
-							const float y1 = y0 + cell;
-							EmitQuad(uploadScratch_, x0, y0, x1, y1, it.rgba);
-						}
-					}
-
-					penX += cell * 6.0f; // 5 cols + 1 spacing
+					DebugGlyphInstance& instance = instanceScratch_.emplace_back();
+					instance.xPx = it.xPx + static_cast<float>(glyph.column) * DebugTextList::kGlyphAdvanceCols * cell;
+					instance.yPx = it.yPx + static_cast<float>(glyph.line) * DebugTextList::kLineAdvanceRows * cell;
+					instance.widthPx = DebugTextList::kGlyphCols * cell;
+					instance.heightPx = DebugTextList::kGlyphRows * cell;
+					instance.atlasRect = GlyphAtlasRect(glyph.ch);
+					instance.rgba = it.rgba;
 				}
 			}
+			layoutCache_.EndFrame();
 
-			lastVertexCount_ = static_cast<std::uint32_t>(uploadScratch_.size());
-			if (lastVertexCount_ == 0)
+			lastInstanceCount_ = static_cast<std::uint32_t>(instanceScratch_.size());
+			if (lastInstanceCount_ == 0)
 			{
 				return;
 			}
 
-			EnsureVertexBufferCapacity(lastVertexCount_);
-			const std::span<const DebugTextVertex> verts{ uploadScratch_.data(), uploadScratch_.size() };
-			device_.UpdateBuffer(vertexBuffer_, std::as_bytes(verts), 0);
+			const std::span<const std::byte> bytes = std::as_bytes(std::span{ instanceScratch_ });
+			EnsureInstanceCapacity(bytes.size());
+			ringRegion_ = (ringRegion_ + 1u) % ringRegionCount_;
+			regionOffsetBytes_ = static_cast<std::uint32_t>(ringRegion_ * regionBytes_);
+
+			const std::span<std::byte> mapped = device_.MapBuffer(instanceBuffer_);
+			if (!mapped.empty())
+			{
+				std::memcpy(mapped.data() + regionOffsetBytes_, bytes.data(), bytes.size());
+			}
+			else
+			{
+				device_.UpdateBuffer(instanceBuffer_, bytes, regionOffsetBytes_);
+			}
 		}
 
 		void Draw(rhi::CommandList& cmd, std::uint32_t viewportWidth, std::uint32_t viewportHeight)
 		{
-			if (lastVertexCount_ == 0)
+			if (lastInstanceCount_ == 0)
 			{
 				return;
 			}
@@ -275,13 +280,16 @@ export namespace rendern::debugText
 
 			cmd.BindPipeline(psoText_);
 			cmd.BindInputLayout(inputLayout_);
-			cmd.BindVertexBuffer(0, vertexBuffer_, static_cast<std::uint32_t>(sizeof(DebugTextVertex)), 0);
+			cmd.BindVertexBuffer(0, quadBuffer_, static_cast<std::uint32_t>(sizeof(float) * 2), 0);
+			cmd.BindVertexBuffer(1, instanceBuffer_, static_cast<std::uint32_t>(sizeof(DebugGlyphInstance)), regionOffsetBytes_);
+			cmd.BindStructuredBufferSRV(0, atlasBuffer_);
 			cmd.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
 
 			struct alignas(16) Constants
 			{
 				float uInvViewportSize[2]{};
-				float _pad[2]{};
+				std::uint32_t uAtlasWidth{ kGlyphAtlasWidth };
+				std::uint32_t _pad{ 0 };
 			};
 
 			Constants c{};
@@ -297,19 +305,25 @@ export namespace rendern::debugText
 			s.blend.enable = true;
 
 			cmd.SetState(s);
-			cmd.Draw(lastVertexCount_, 0);
+			cmd.Draw(6, 0, lastInstanceCount_, 0);
 		}
 
 		void Shutdown()
 		{
-			if (vertexBuffer_)
+			for (rhi::BufferHandle* buffer : { &instanceBuffer_, &quadBuffer_, &atlasBuffer_ })
 			{
-				device_.DestroyBuffer(vertexBuffer_);
-				vertexBuffer_ = {};
+				if (*buffer)
+				{
+					device_.DestroyBuffer(*buffer);
+					*buffer = {};
+				}
 			}
-			vbCapacityVertices_ = 0;
-			lastVertexCount_ = 0;
-			uploadScratch_.clear();
+			regionBytes_ = 0;
+			ringRegion_ = 0;
+			regionOffsetBytes_ = 0;
+			lastInstanceCount_ = 0;
+			instanceScratch_.clear();
+			layoutCache_.Clear();
 
 			if (inputLayout_)
 			{
@@ -321,6 +335,8 @@ export namespace rendern::debugText
 			initialized_ = false;
 		}
 
+		const TextLayoutCache& GetLayoutCache() const noexcept { return layoutCache_; }
+
 	private:
 		void EnsureResources()
 		{
@@ -329,26 +345,15 @@ export namespace rendern::debugText
 				return;
 			}
 
+			// Slot 0: quad corner (0..1), slot 1: DebugGlyphInstance (per instance).
 			rhi::InputLayoutDesc il{};
 			il.debugName = "DebugTextInputLayout";
-			il.strideBytes = static_cast<std::uint32_t>(sizeof(DebugTextVertex));
+			il.strideBytes = static_cast<std::uint32_t>(sizeof(float) * 2);
 			il.attributes = {
-				rhi::VertexAttributeDesc{
-					.semantic = rhi::VertexSemantic::Position,
-					.semanticIndex = 0,
-					.format = rhi::VertexFormat::R32G32_FLOAT,
-					.inputSlot = 0,
-					.offsetBytes = 0,
-					.normalized = false
-				},
-				rhi::VertexAttributeDesc{
-					.semantic = rhi::VertexSemantic::Color,
-					.semanticIndex = 0,
-					.format = rhi::VertexFormat::R8G8B8A8_UNORM,
-					.inputSlot = 0,
-					.offsetBytes = 8,
-					.normalized = true
-				},
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Position,.semanticIndex = 0,.format = rhi::VertexFormat::R32G32_FLOAT,.inputSlot = 0,.offsetBytes = 0 },
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 1,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 0 },
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 2,.format = rhi::VertexFormat::R16G16B16A16_UINT,.inputSlot = 1,.offsetBytes = 16 },
+				rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Color,.semanticIndex = 0,.format = rhi::VertexFormat::R8G8B8A8_UNORM,.inputSlot = 1,.offsetBytes = 24,.normalized = true },
 			};
 			inputLayout_ = device_.CreateInputLayout(il);
 
@@ -368,50 +373,85 @@ export namespace rendern::debugText
 
 			psoText_ = psoCache_.GetOrCreate("PSO_DebugText", vs, ps, rhi::PrimitiveTopologyType::Triangle);
 
-			EnsureVertexBufferCapacity(4096);
+			// Two triangles: (0,0) (1,0) (1,1) / (0,0) (1,1) (0,1).
+			constexpr std::array<float, 12> kQuad{ 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+			rhi::BufferDesc quadDesc{};
+			quadDesc.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+			quadDesc.usageFlag = rhi::BufferUsageFlag::Static;
+			quadDesc.sizeInBytes = sizeof(kQuad);
+			quadDesc.debugName = "DebugTextQuadVB";
+			quadBuffer_ = device_.CreateBuffer(quadDesc);
+			device_.UpdateBuffer(quadBuffer_, std::as_bytes(std::span{ kQuad }), 0);
+
+			const std::vector<std::uint32_t> atlasBits = BuildGlyphAtlasBits();
+			rhi::BufferDesc atlasDesc{};
+			atlasDesc.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+			atlasDesc.usageFlag = rhi::BufferUsageFlag::Static;
+			atlasDesc.sizeInBytes = atlasBits.size() * sizeof(std::uint32_t);
+			atlasDesc.structuredStrideBytes = sizeof(std::uint32_t);
+			atlasDesc.debugName = "DebugTextGlyphAtlas";
+			atlasBuffer_ = device_.CreateBuffer(atlasDesc);
+			device_.UpdateBuffer(atlasBuffer_, std::as_bytes(std::span{ atlasBits }), 0);
+
+			ringRegionCount_ = std::max(device_.GetFramesInFlight(), 1u);
+			EnsureInstanceCapacity(kMinRegionBytes);
 			initialized_ = true;
 		}
 
-		void EnsureVertexBufferCapacity(std::uint32_t vertexCount)
+		// One region per frame in flight (see DebugDrawRendererDX12::EnsureStreamCapacity).
+		void EnsureInstanceCapacity(std::size_t bytesPerFrame)
 		{
-			if (vertexBuffer_.id != 0 && vbCapacityVertices_ >= vertexCount)
+			if (instanceBuffer_.id != 0 && regionBytes_ >= bytesPerFrame)
 			{
 				return;
 			}
 
-			std::uint32_t newCap = std::max<std::uint32_t>(vertexCount, 4096u);
-			if (vbCapacityVertices_ != 0)
+			std::size_t newRegionBytes = std::max(bytesPerFrame, kMinRegionBytes);
+			if (regionBytes_ != 0)
 			{
-				newCap = std::max<std::uint32_t>(newCap, vbCapacityVertices_ * 2u);
+				newRegionBytes = std::max(newRegionBytes, regionBytes_ * 2u);
 			}
-			vbCapacityVertices_ = newCap;
+			newRegionBytes = (newRegionBytes + kRegionAlignment - 1) / kRegionAlignment * kRegionAlignment;
+			regionBytes_ = newRegionBytes;
 
-			if (vertexBuffer_.id != 0)
+			if (instanceBuffer_.id != 0)
 			{
-				device_.DestroyBuffer(vertexBuffer_);
-				vertexBuffer_ = {};
+				device_.DestroyBuffer(instanceBuffer_);
+				instanceBuffer_ = {};
 			}
 
-			rhi::BufferDesc vbDesc{};
-			vbDesc.bindFlag = rhi::BufferBindFlag::VertexBuffer;
-			vbDesc.usageFlag = rhi::BufferUsageFlag::Dynamic;
-			vbDesc.sizeInBytes = static_cast<std::size_t>(vbCapacityVertices_) * sizeof(DebugTextVertex);
-			vbDesc.debugName = "DebugTextVB";
-			vertexBuffer_ = device_.CreateBuffer(vbDesc);
+			rhi::BufferDesc desc{};
+			desc.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+			desc.usageFlag = rhi::BufferUsageFlag::Stream;
+			desc.sizeInBytes = regionBytes_ * ringRegionCount_;
+			desc.debugName = "DebugTextGlyphInstances";
+			instanceBuffer_ = device_.CreateBuffer(desc);
+			ringRegion_ = 0;
 		}
 
 	private:
+		static constexpr std::size_t kMinRegionBytes = 1024 * sizeof(DebugGlyphInstance);
+		static constexpr std::size_t kRegionAlignment = 256;
+
 		rhi::IRHIDevice& device_;
 		ShaderLibrary& shaderLibrary_;
 		PSOCache& psoCache_;
 
 		rhi::InputLayoutHandle inputLayout_{};
 		rhi::PipelineHandle psoText_{};
-		rhi::BufferHandle vertexBuffer_{};
-
-		std::vector<DebugTextVertex> uploadScratch_{};
-		std::uint32_t vbCapacityVertices_{ 0 };
-		std::uint32_t lastVertexCount_{ 0 };
+		rhi::BufferHandle quadBuffer_{};
+		rhi::BufferHandle atlasBuffer_{};
+
+		// Instance ring: ringRegionCount_ regions of regionBytes_, one per frame.
+		rhi::BufferHandle instanceBuffer_{};
+		std::size_t regionBytes_{ 0 };
+		std::uint32_t ringRegionCount_{ 1 };
+		std::uint32_t ringRegion_{ 0 };
+		std::uint32_t regionOffsetBytes_{ 0 };
+
+		TextLayoutCache layoutCache_{};
+		std::vector<DebugGlyphInstance> instanceScratch_{};
+		std::uint32_t lastInstanceCount_{ 0 };
 		bool initialized_{ false };
 	};
-}
\ No newline at end of file
+}
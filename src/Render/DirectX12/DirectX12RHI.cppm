@@ -29,6 +29,7 @@ module;
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <memory>
 #include <optional>
@@ -39,16 +40,28 @@ module;
 #include <utility>
 #include <variant>
 #include <vector>
+#include <deque>
+#include <limits>
 #include <array>
+#include <atomic>
 #include <stdexcept>
 #include <algorithm>
 #include <cassert>
 #include <bit>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
 
 export module core:rhi_dx12;
 
 import :rhi;
 import :dx12_core;
+import :profiler;
+import :memory_tracking;
+import :file_system;
 
 #if defined(_WIN32)
 using Microsoft::WRL::ComPtr;
@@ -72,12 +85,18 @@ DXGI_FORMAT ToDXGIFormat(rhi::Format format)
     {
     case rhi::Format::RGBA8_UNORM:
         return DXGI_FORMAT_R8G8B8A8_UNORM;
+    case rhi::Format::RGBA8_UNORM_SRGB:
+        return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
     case rhi::Format::RGBA16_FLOAT:
         return DXGI_FORMAT_R16G16B16A16_FLOAT;
     case rhi::Format::BGRA8_UNORM:
         return DXGI_FORMAT_B8G8R8A8_UNORM;
     case rhi::Format::R32_FLOAT:
         return DXGI_FORMAT_R32_FLOAT;
+    case rhi::Format::R32_UINT:
+        return DXGI_FORMAT_R32_UINT;
+    case rhi::Format::RG16_UNORM:
+        return DXGI_FORMAT_R16G16_UNORM;
     case rhi::Format::D32_FLOAT:
         return DXGI_FORMAT_D32_FLOAT;
     case rhi::Format::D24_UNORM_S8_UINT:
@@ -105,11 +124,35 @@ DXGI_FORMAT ToDXGIVertexFormat(rhi::VertexFormat format)
         return DXGI_FORMAT_R16G16B16A16_UNORM;
     case rhi::VertexFormat::R32G32B32A32_UINT:
         return DXGI_FORMAT_R32G32B32A32_UINT;
+    case rhi::VertexFormat::R16G16_SNORM:
+        return DXGI_FORMAT_R16G16_SNORM;
+    case rhi::VertexFormat::R16G16_FLOAT:
+        return DXGI_FORMAT_R16G16_FLOAT;
     default:
         return DXGI_FORMAT_UNKNOWN;
     }
 }
 
+D3D12_RESOURCE_STATES ToD3D12TextureState(rhi::TextureState state)
+{
+    switch (state)
+    {
+    case rhi::TextureState::RenderTarget:
+        return D3D12_RESOURCE_STATE_RENDER_TARGET;
+    case rhi::TextureState::DepthWrite:
+        return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+    case rhi::TextureState::UnorderedAccess:
+        return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+    case rhi::TextureState::CopySource:
+        return D3D12_RESOURCE_STATE_COPY_SOURCE;
+    case rhi::TextureState::CopyDest:
+        return D3D12_RESOURCE_STATE_COPY_DEST;
+    case rhi::TextureState::ShaderRead:
+    default:
+        return D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+    }
+}
+
 D3D12_COMPARISON_FUNC ToD3DCompare(rhi::CompareOp compareOp)
 {
     switch (compareOp)
@@ -204,6 +247,25 @@ bool IsDepthFormat(rhi::Format format)
     return format == rhi::Format::D32_FLOAT || format == rhi::Format::D24_UNORM_S8_UINT;
 }
 
+// Size of one texel of a color format (0 for depth and unknown formats).
+UINT BytesPerTexel(rhi::Format format)
+{
+    switch (format)
+    {
+    case rhi::Format::RGBA8_UNORM:
+    case rhi::Format::RGBA8_UNORM_SRGB:
+    case rhi::Format::BGRA8_UNORM:
+    case rhi::Format::R32_FLOAT:
+    case rhi::Format::R32_UINT:
+    case rhi::Format::RG16_UNORM:
+        return 4;
+    case rhi::Format::RGBA16_FLOAT:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
 const char* SemanticName(rhi::VertexSemantic semantic)
 {
     switch (semantic)
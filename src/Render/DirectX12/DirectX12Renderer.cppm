@@ -12,6 +12,8 @@ module;
 // D3D-style clip-space helpers (Z in [0..1]).
 
 #include <array>
+#include <bit>
+#include <chrono>
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
@@ -27,13 +29,16 @@ module;
 #include <memory>
 #include <limits>
 #include <unordered_map>
+#include <memory_resource>
 #include "assert.h"
 
 export module core:renderer_dx12;
 
 import :rhi;
+import :render_gpu_memory;
 import :scene;
 import :visibility;
+import :scene_bvh;
 import :math_utils;
 import :hash_utils;
 import :renderer_settings;
@@ -41,6 +46,8 @@ import :render_core;
 import :render_graph;
 import :file_system;
 import :mesh;
+import :mesh_lod;
+import :meshlet;
 import :skinned_mesh;
 import :scene_bridge;
 import :debug_draw;
@@ -48,6 +55,15 @@ import :debug_draw_renderer_dx12;
 import :debug_text;
 import :debug_text_renderer_dx12;
 import :common_DX12_Structs;
+import :job_system;
+import :frame_arena;
+import :flat_hash_map;
+import :radix_sort;
+import :light_clusters;
+import :reflection_probe_scheduler;
+import :shadow_atlas;
+import :dynamic_resolution;
+import :profiler;
 
 export namespace rendern
 {
@@ -84,7 +100,7 @@ export namespace rendern
 	class DX12Renderer
 	{
 	public:
-		DX12Renderer(rhi::IRHIDevice& device, RendererSettings settings = {})
+		DX12Renderer(rhi::IRHIDevice& device, RendererSettings settings = {}, jobs::Scheduler* scheduler = nullptr)
 			: device_(device)
 			, settings_(std::move(settings))
 			, shaderLibrary_(device)
@@ -92,22 +108,62 @@ export namespace rendern
 			, debugDrawRenderer_(device, shaderLibrary_, psoCache_)
 			, debugTextRenderer_(device, shaderLibrary_, psoCache_)
 		{
+			jobScheduler_ = scheduler;
+			device_.LoadPipelineCache(PipelineCacheDir().string());
+			// Last session's shaders compile on the workers first; CreateResources then only creates handles.
+			shaderLibrary_.PrecompileShaders(LoadShaderKeyManifest(PipelineCacheDir() / "shader_keys.txt"), jobScheduler_);
 			CreateResources();
+			device_.WarmPipelineCache();
+			shaderLibrary_.EnableHotReload(settings_.enableShaderHotReload);
+		}
+
+		// Compiles last session's shaders into the device's bytecode cache before any renderer exists, so
+		// startup can overlap it with other work. The constructor's PrecompileShaders then finds them cached.
+		static void PrecompileStartupShaders(rhi::IRHIDevice& device, jobs::Scheduler* scheduler)
+		{
+			ShaderLibrary library(device);
+			library.PrecompileShaders(LoadShaderKeyManifest(PipelineCacheDir() / "shader_keys.txt"), scheduler);
 		}
 
 		void SetSettings(const RendererSettings& settings)
 		{
 			settings_ = settings;
 			EnsureReflectionCaptureResources();
+			shaderLibrary_.EnableHotReload(settings_.enableShaderHotReload);
+		}
+
+		// Workers for the parallel parts of RenderFrame (not owned). nullptr keeps everything on the calling thread.
+		void SetJobScheduler(jobs::Scheduler* scheduler) noexcept
+		{
+			jobScheduler_ = scheduler;
+		}
+
+		// Sub-allocator for skinned mesh buffers uploaded from now on (not owned). nullptr gives each its own buffers.
+		void SetMeshAllocator(renderer::IGPUMemoryAllocator* allocator) noexcept
+		{
+			meshAllocator_ = allocator;
 		}
 
 		void RenderFrame(rhi::IRHISwapChain& swapChain, const Scene& scene, const void* imguiDrawData)
 		{
+			profiling::ScopedZone frameZone{ "Renderer::RenderFrame" };
+			// Everything the previous frame took from the arena died with its render graph.
+			frameArena_.Reset();
+			// Nothing of this frame is recorded yet, so edited shaders swap in here; the PSOs they replace
+			// are released by the device once the frames still using them have retired.
+			shaderLibrary_.ApplyHotReloads();
+			frameStats_.cullTested = 0;
+			frameStats_.cullVisible = 0;
+
 #include "RendererImpl/DirectX12Renderer_RenderFrame_00_SetupCSM.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_01a_ComputeSkinning.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_01b_InstanceTransforms.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_03_PreDepth.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_03a_GpuCulling.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_03b_GpuParticles.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_02_ShadowPasses.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_02_ReflectionCapture.inl"
-#include "RendererImpl/DirectX12Renderer_RenderFrame_03_PreDepth.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_04_MainPass.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_05_DebugAndPresent.inl"
 		}
@@ -117,40 +173,349 @@ export namespace rendern
 #include "RendererImpl/DirectX12Renderer_Shutdown.inl"
 		}
 
+		// Materials of the items that passed camera culling in the last RenderFrame (deduped).
+		std::span<const MaterialHandle> GetDrawnMaterials() const noexcept
+		{
+			return drawnMaterials_;
+		}
+
+		const RendererFrameStats& GetFrameStats() const noexcept
+		{
+			return frameStats_;
+		}
+
+		bool SupportsObjectIdPicking() const noexcept
+		{
+			return psoObjectId_ && objectIdBuffer_ && device_.SupportsTextureReadback();
+		}
+
+		// The next RenderFrame draws the ID buffer and reads the rect back.
+		std::uint64_t RequestObjectIdPick(const ObjectIdPickRequest& request)
+		{
+			if (!SupportsObjectIdPicking())
+			{
+				return 0;
+			}
+			const std::uint64_t requestId = nextObjectIdPickId_++;
+			objectIdPickRequests_.emplace_back(requestId, request);
+			return requestId;
+		}
+
+		bool TakeObjectIdPick(ObjectIdPickResult& out)
+		{
+			device_.TakeCompletedTextureReadbacks(objectIdReadbacks_);
+			if (objectIdReadbacks_.empty())
+			{
+				return false;
+			}
+
+			rhi::TextureReadback& readback = objectIdReadbacks_.front();
+			out.requestId = readback.requestId;
+			out.x = readback.x;
+			out.y = readback.y;
+			out.width = readback.width;
+			out.height = readback.height;
+			out.ids.resize(readback.data.size() / sizeof(std::uint32_t));
+			std::memcpy(out.ids.data(), readback.data.data(), out.ids.size() * sizeof(std::uint32_t));
+			objectIdReadbacks_.erase(objectIdReadbacks_.begin());
+			return true;
+		}
+
 	private:
 
-		void DrawInstancedShadowBatches(rhi::CommandList& commandList, std::span<const ShadowBatch> shadowBatches, std::uint32_t instanceStrideBytes) const
+		std::uint32_t MaxGpuCullInstances() const noexcept
+		{
+			return instanceBufferSizeBytes_ / static_cast<std::uint32_t>(sizeof(InstanceData));
+		}
+
+		// (Re)creates the HiZ pyramid buffer for a depth extent; levels halve (rounding up) down to 1x1.
+		void EnsureHiZBuffer(const rhi::Extent2D& depthExtent)
+		{
+			if (hiZBuffer_ && hiZExtent_.width == depthExtent.width && hiZExtent_.height == depthExtent.height)
+			{
+				return;
+			}
+			if (hiZBuffer_)
+			{
+				device_.DestroyBuffer(hiZBuffer_);
+				hiZBuffer_ = {};
+			}
+
+			hiZExtent_ = depthExtent;
+			hiZLevelCount_ = 0;
+			std::uint32_t width = std::max(1u, (depthExtent.width + 1u) / 2u);
+			std::uint32_t height = std::max(1u, (depthExtent.height + 1u) / 2u);
+			std::uint32_t offset = 0;
+			while (hiZLevelCount_ < kMaxHiZLevels)
+			{
+				hiZLevels_[hiZLevelCount_++] = { offset, width, height, 0u };
+				offset += width * height;
+				if (width == 1u && height == 1u)
+				{
+					break;
+				}
+				width = std::max(1u, (width + 1u) / 2u);
+				height = std::max(1u, (height + 1u) / 2u);
+			}
+
+			rhi::BufferDesc hd{};
+			hd.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+			hd.usageFlag = rhi::BufferUsageFlag::Default;
+			hd.sizeInBytes = offset * static_cast<std::uint32_t>(sizeof(float));
+			hd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(float));
+			hd.debugName = "HiZPyramidSB";
+			hiZBuffer_ = device_.CreateBuffer(hd);
+		}
+
+		// Grows the deferred material table to hold at least entryCount entries (never shrinks). Returns whether
+		// the buffer was (re)created, i.e. its contents have to be uploaded again.
+		bool EnsureMaterialTableBuffer(std::uint32_t entryCount)
+		{
+			if (materialTableBuffer_ && entryCount <= materialTableCapacity_)
+			{
+				return false;
+			}
+			if (materialTableBuffer_)
+			{
+				device_.DestroyBuffer(materialTableBuffer_);
+				materialTableBuffer_ = {};
+			}
+
+			materialTableCapacity_ = std::max({ entryCount, materialTableCapacity_ * 2u, 64u });
+			rhi::BufferDesc md{};
+			md.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+			md.usageFlag = rhi::BufferUsageFlag::Default;
+			md.sizeInBytes = materialTableCapacity_ * static_cast<std::uint32_t>(sizeof(MaterialGpu));
+			md.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(MaterialGpu));
+			md.debugName = "MaterialTableSB";
+			materialTableBuffer_ = device_.CreateBuffer(md);
+			materialTableUploaded_.clear();
+			return true;
+		}
+
+		// (Re)creates the static caster depth of a shadow cache entry for an extent; a new texture starts invalid.
+		bool EnsureShadowCacheTexture(ShadowCacheEntry& entry, const rhi::Extent2D& extent)
+		{
+			if (entry.depth && entry.extent.width == extent.width && entry.extent.height == extent.height)
+			{
+				return true;
+			}
+			ReleaseShadowCacheTexture(entry);
+
+			entry.depth = device_.CreateTexture2D(extent, rhi::Format::D32_FLOAT);
+			entry.extent = extent;
+			return static_cast<bool>(entry.depth);
+		}
+
+		void ReleaseShadowCacheTexture(ShadowCacheEntry& entry)
+		{
+			if (entry.depth)
+			{
+				device_.DestroyTexture(entry.depth);
+			}
+			entry = ShadowCacheEntry{};
+		}
+
+		// (Re)creates the persistent directional atlas of the amortized cascade schedule; a new atlas has no
+		// rendered tiles.
+		bool EnsureCascadeScheduleAtlas(const rhi::Extent2D& extent)
+		{
+			CascadeScheduleState& schedule = dirCascadeSchedule_;
+			if (schedule.atlas && schedule.extent.width == extent.width && schedule.extent.height == extent.height)
+			{
+				return true;
+			}
+			ReleaseCascadeScheduleAtlas();
+
+			schedule.atlas = device_.CreateTexture2D(extent, rhi::Format::D32_FLOAT);
+			schedule.extent = extent;
+			return static_cast<bool>(schedule.atlas);
+		}
+
+		void ReleaseCascadeScheduleAtlas()
+		{
+			if (dirCascadeSchedule_.atlas)
+			{
+				device_.DestroyTexture(dirCascadeSchedule_.atlas);
+			}
+			dirCascadeSchedule_ = CascadeScheduleState{};
+		}
+
+		// Consecutive batches can go out as one multi-draw when they read the same geometry streams.
+		static bool SharesShadowDrawStreams(const rendern::MeshRHI& mesh, const ShadowBatch& batch) noexcept
 		{
-			for (std::size_t batchIndex = 0; batchIndex < shadowBatches.size(); ++batchIndex)
+			return batch.mesh &&
+				batch.mesh->vertexBuffer == mesh.vertexBuffer &&
+				batch.mesh->vertexOffsetBytes == mesh.vertexOffsetBytes &&
+				batch.mesh->indexBuffer == mesh.indexBuffer &&
+				batch.mesh->indexOffsetBytes == mesh.indexOffsetBytes &&
+				batch.mesh->layoutInstanced == mesh.layoutInstanced &&
+				batch.mesh->vertexStrideBytes == mesh.vertexStrideBytes &&
+				batch.mesh->depthVertexBuffer == mesh.depthVertexBuffer &&
+				batch.mesh->depthVertexOffsetBytes == mesh.depthVertexOffsetBytes &&
+				batch.mesh->layoutDepthInstanced == mesh.layoutDepthInstanced &&
+				batch.mesh->indexType == mesh.indexType;
+		}
+
+		// Depth-only draws read positions alone: the mesh's depth-only stream when it has one, else the full vertices.
+		static void BindDepthOnlyVertices(rhi::CommandList& commandList, const rendern::MeshRHI& mesh)
+		{
+			if (mesh.depthVertexBuffer)
+			{
+				commandList.BindInputLayout(mesh.layoutDepthInstanced);
+				commandList.BindVertexBuffer(0, mesh.depthVertexBuffer, mesh.depthVertexStrideBytes, mesh.depthVertexOffsetBytes);
+			}
+			else
+			{
+				commandList.BindInputLayout(mesh.layoutInstanced);
+				commandList.BindVertexBuffer(0, mesh.vertexBuffer, mesh.vertexStrideBytes, mesh.vertexOffsetBytes);
+			}
+		}
+
+		// firstArgsRecord: index of shadowBatches[0]'s record in shadowIndirectArgsBuffer_, or
+		// kNoShadowIndirectArgs to record one DrawIndexed per batch. Batches that go through
+		// meshletPipeline (DispatchMeshletShadowBatches) are skipped.
+		void DrawInstancedShadowBatches(
+			rhi::CommandList& commandList,
+			std::span<const ShadowBatch> shadowBatches,
+			std::uint32_t instanceStrideBytes,
+			std::uint32_t firstArgsRecord = kNoShadowIndirectArgs,
+			rhi::PipelineHandle meshletPipeline = {}) const
+		{
+			const bool indirect = shadowIndirectArgsBuffer_ && firstArgsRecord != kNoShadowIndirectArgs;
+
+			std::size_t batchIndex = 0;
+			while (batchIndex < shadowBatches.size())
 			{
 				const ShadowBatch& shadowBatch = shadowBatches[batchIndex];
-				if (!shadowBatch.mesh || shadowBatch.instanceCount == 0)
+				if (!shadowBatch.mesh || shadowBatch.instanceCount == 0 || UsesMeshlets(*shadowBatch.mesh, meshletPipeline))
 				{
+					++batchIndex;
 					continue;
 				}
 
-				commandList.BindInputLayout(shadowBatch.mesh->layoutInstanced);
-				commandList.BindVertexBuffer(0, shadowBatch.mesh->vertexBuffer, shadowBatch.mesh->vertexStrideBytes, 0);
-				commandList.BindVertexBuffer(1, instanceBuffer_, instanceStrideBytes, shadowBatch.instanceOffset * instanceStrideBytes);
-				commandList.BindIndexBuffer(shadowBatch.mesh->indexBuffer, shadowBatch.mesh->indexType, 0);
+				const rendern::MeshRHI& mesh = *shadowBatch.mesh;
+				BindDepthOnlyVertices(commandList, mesh);
+				commandList.BindIndexBuffer(mesh.indexBuffer, mesh.indexType, mesh.indexOffsetBytes);
 
-				commandList.DrawIndexed(
-					shadowBatch.mesh->indexCount,
-					shadowBatch.mesh->indexType,
-					0,
-					0,
-					shadowBatch.instanceCount,
-					0);
+				if (!indirect)
+				{
+					commandList.BindVertexBuffer(1, instanceBuffer_, instanceStrideBytes, shadowBatch.instanceOffset * instanceStrideBytes);
+					commandList.DrawIndexed(mesh.indexCount, mesh.indexType, mesh.firstIndex, mesh.baseVertex, shadowBatch.instanceCount, 0);
+					++batchIndex;
+					continue;
+				}
+
+				// The records carry firstInstance, so the instance stream is bound at its start.
+				commandList.BindVertexBuffer(1, instanceBuffer_, instanceStrideBytes, 0);
+
+				std::size_t runEnd = batchIndex + 1;
+				while (runEnd < shadowBatches.size() && SharesShadowDrawStreams(mesh, shadowBatches[runEnd])
+					&& !(shadowBatches[runEnd].mesh && UsesMeshlets(*shadowBatches[runEnd].mesh, meshletPipeline)))
+				{
+					++runEnd;
+				}
+
+				if (runEnd - batchIndex == 1)
+				{
+					// A single draw is cheaper recorded directly than through ExecuteIndirect.
+					commandList.DrawIndexed(mesh.indexCount, mesh.indexType, mesh.firstIndex, mesh.baseVertex, shadowBatch.instanceCount, shadowBatch.instanceOffset);
+				}
+				else
+				{
+					commandList.DrawIndexedIndirect(
+						shadowIndirectArgsBuffer_,
+						static_cast<std::uint32_t>((firstArgsRecord + batchIndex) * sizeof(rhi::DrawIndexedIndirectArgs)),
+						mesh.indexType,
+						static_cast<std::uint32_t>(runEnd - batchIndex));
+				}
+				batchIndex = runEnd;
+			}
+		}
+
+		// Whether `mesh` goes through the meshlet path of a pass using `meshPipeline`.
+		bool UsesMeshlets(const rendern::MeshRHI& mesh, rhi::PipelineHandle meshPipeline) const noexcept
+		{
+			return meshPipeline && settings_.enableMeshShaders && mesh.meshletBuffer && mesh.meshletCount > 0
+				&& (mesh.meshletCount + kMeshletsPerTaskGroup - 1u) / kMeshletsPerTaskGroup <= kMaxDispatchMeshGroups;
+		}
+
+		static void SetMeshletCullPlanes(std::array<float, 4 * 6>& planes, const mathUtils::Frustum& frustum) noexcept
+		{
+			for (std::size_t planeIndex = 0; planeIndex < 6; ++planeIndex)
+			{
+				const mathUtils::Plane& plane = frustum.planes[planeIndex];
+				planes[planeIndex * 4 + 0] = plane.norm.x;
+				planes[planeIndex * 4 + 1] = plane.norm.y;
+				planes[planeIndex * 4 + 2] = plane.norm.z;
+				planes[planeIndex * 4 + 3] = plane.dist;
+			}
+		}
+
+		// Draws instanceBuffer_[firstInstance, +instanceCount) of `mesh` with the bound mesh pipeline:
+		// amplification groups of kMeshletsPerTaskGroup meshlets along x, one instance per y. Fills
+		// constants.uMeshlet for each dispatch; instance counts past the dispatch limits are split.
+		template <typename MeshletConstants>
+		void DispatchMeshlets(
+			rhi::CommandList& commandList,
+			const rendern::MeshRHI& mesh,
+			std::uint32_t firstInstance,
+			std::uint32_t instanceCount,
+			MeshletConstants& constants) const
+		{
+			// t3..t6 in Meshlet_dx12.hlsli.
+			commandList.BindStructuredBufferSRV(3, mesh.meshletVertexBuffer);
+			commandList.BindStructuredBufferSRV(4, mesh.meshletBuffer);
+			commandList.BindStructuredBufferSRV(5, mesh.meshletDataBuffer);
+			commandList.BindStructuredBufferSRV(6, instanceBuffer_);
+
+			const std::uint32_t groupsX = (mesh.meshletCount + kMeshletsPerTaskGroup - 1u) / kMeshletsPerTaskGroup;
+			const std::uint32_t maxInstances = std::min(kMaxDispatchMeshGroups, kMaxDispatchMeshGroupsTotal / groupsX);
+			for (std::uint32_t done = 0; done < instanceCount; done += maxInstances)
+			{
+				const std::uint32_t count = std::min(maxInstances, instanceCount - done);
+				constants.uMeshlet = { mesh.firstMeshlet, mesh.meshletCount, firstInstance + done, count };
+				commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
+				commandList.DispatchMesh(groupsX, count);
 			}
 		}
 
+		// The shadowBatches UsesMeshlets accepts for psoShadowMeshlet_, drawn with it (frustum culling only:
+		// casters draw two-sided). Returns whether it bound the pipeline.
+		bool DispatchMeshletShadowBatches(
+			rhi::CommandList& commandList,
+			std::span<const ShadowBatch> shadowBatches,
+			const mathUtils::Mat4& viewProj) const
+		{
+			MeshletShadowConstants constants{};
+			const mathUtils::Mat4 viewProjT = mathUtils::Transpose(viewProj);
+			std::memcpy(constants.uLightViewProj.data(), mathUtils::ValuePtr(viewProjT), sizeof(float) * 16);
+			SetMeshletCullPlanes(constants.uPlanes, mathUtils::ExtractFrustumRH_ZO(viewProj));
+
+			bool bound = false;
+			for (const ShadowBatch& shadowBatch : shadowBatches)
+			{
+				if (!shadowBatch.mesh || shadowBatch.instanceCount == 0 || !UsesMeshlets(*shadowBatch.mesh, psoShadowMeshlet_))
+				{
+					continue;
+				}
+				if (!bound)
+				{
+					commandList.BindPipeline(psoShadowMeshlet_);
+					bound = true;
+				}
+				DispatchMeshlets(commandList, *shadowBatch.mesh, shadowBatch.instanceOffset, shadowBatch.instanceCount, constants);
+			}
+			return bound;
+		}
+
 		void DrawParticleBillboards(
 			rhi::CommandList& commandList,
 			const Scene& scene,
 			const FrameCameraData& camera,
 			std::uint32_t particleCount) const
 		{
-			if (!psoParticles_ || !particleMesh_.vertexBuffer || !particleMesh_.indexBuffer || !particleInstanceBuffer_ || particleCount == 0 || particleBatches_.empty())
+			if (!psoParticles_ || !particleMesh_.vertexBuffer || !particleMesh_.indexBuffer || !particleInstanceBuffer_ || particleCount == 0)
 			{
 				return;
 			}
@@ -170,29 +535,61 @@ export namespace rendern
 			constants.uCameraRight = { right.x, right.y, right.z, 0.0f };
 			constants.uCameraUp = { up.x, up.y, up.z, 0.0f };
 
+			// One draw for every emitter: textures are bindless indices in the instance data (see BuildInstances).
 			commandList.SetState(particleState_);
+			commandList.BindPipeline(psoParticles_);
 			commandList.BindInputLayout(particleMesh_.layoutInstanced);
 			commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
-			commandList.BindVertexBuffer(0, particleMesh_.vertexBuffer, particleMesh_.vertexStrideBytes, 0);
+			commandList.BindVertexBuffer(0, particleMesh_.vertexBuffer, particleMesh_.vertexStrideBytes, particleMesh_.vertexOffsetBytes);
 			commandList.BindVertexBuffer(1, particleInstanceBuffer_, static_cast<std::uint32_t>(sizeof(ParticleInstanceData)), 0);
-			commandList.BindIndexBuffer(particleMesh_.indexBuffer, particleMesh_.indexType, 0);
+			commandList.BindIndexBuffer(particleMesh_.indexBuffer, particleMesh_.indexType, particleMesh_.indexOffsetBytes);
 			commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
+			commandList.DrawIndexed(particleMesh_.indexCount, particleMesh_.indexType, particleMesh_.firstIndex, particleMesh_.baseVertex, particleCount, 0);
+		}
 
-			for (const ParticleDrawBatch& batch : particleBatches_)
+		// The live prefix of the sorted GPU particle pool; the instance count comes from the simulation.
+		// The pass must declare reads of the pool, sort list, counters and emitter buffers.
+		void DrawGpuParticles(
+			rhi::CommandList& commandList,
+			const Scene& scene,
+			const FrameCameraData& camera) const
+		{
+			if (!psoParticlesGpu_ || !particleMesh_.vertexBuffer || !particleMesh_.indexBuffer || !gpuParticleBuffer_)
 			{
-				if (batch.instanceCount == 0)
-				{
-					continue;
-				}
+				return;
+			}
 
-				const bool textured = (batch.textureDescIndex != 0) && psoParticlesTextured_;
-				commandList.BindPipeline(textured ? psoParticlesTextured_ : psoParticles_);
-				if (textured)
-				{
-					commandList.BindTextureDesc(0, batch.textureDescIndex);
-				}
-				commandList.DrawIndexed(particleMesh_.indexCount, particleMesh_.indexType, 0, 0, batch.instanceCount, batch.instanceOffset);
+			const mathUtils::Vec3 forward = mathUtils::Normalize(scene.camera.target - scene.camera.position);
+			mathUtils::Vec3 right = mathUtils::Cross(forward, scene.camera.up);
+			if (mathUtils::Length(right) <= 0.0001f)
+			{
+				right = mathUtils::Vec3(1.0f, 0.0f, 0.0f);
 			}
+			right = mathUtils::Normalize(right);
+			const mathUtils::Vec3 up = mathUtils::Normalize(mathUtils::Cross(right, forward));
+
+			ParticleConstants constants{};
+			const mathUtils::Mat4 viewProjT = mathUtils::Transpose(camera.viewProj);
+			std::memcpy(constants.uViewProj.data(), mathUtils::ValuePtr(viewProjT), sizeof(float) * 16);
+			constants.uCameraRight = { right.x, right.y, right.z, 0.0f };
+			constants.uCameraUp = { up.x, up.y, up.z, 0.0f };
+
+			commandList.SetState(particleState_);
+			commandList.BindPipeline(psoParticlesGpu_);
+			commandList.BindInputLayout(particleMesh_.layout);
+			commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
+			commandList.BindVertexBuffer(0, particleMesh_.vertexBuffer, particleMesh_.vertexStrideBytes, particleMesh_.vertexOffsetBytes);
+			commandList.BindIndexBuffer(particleMesh_.indexBuffer, particleMesh_.indexType, particleMesh_.indexOffsetBytes);
+			commandList.BindStructuredBufferSRV(1, gpuParticleBuffer_);
+			commandList.BindStructuredBufferSRV(2, gpuParticleSortBuffer_);
+			commandList.BindStructuredBufferSRV(3, gpuParticleEmitterBuffer_);
+			commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
+			commandList.DrawIndexedIndirect(gpuParticleCountersBuffer_, 0, particleMesh_.indexType);
+
+			// Back to the defaults: null texture SRV at t1, null buffer SRVs at t2 and t3.
+			commandList.BindTextureDesc(1, 0);
+			commandList.BindStructuredBufferSRV(2, {});
+			commandList.BindStructuredBufferSRV(3, {});
 		}
 
 		rhi::PipelineHandle PlanarPipelineFor(MaterialPerm perm) const noexcept
@@ -219,6 +616,14 @@ export namespace rendern
 			return psoMain_[idx];
 		}
 
+		rhi::PipelineHandle MainOitPipelineFor(MaterialPerm perm) const noexcept
+		{
+			const bool useTex = HasFlag(perm, MaterialPerm::UseTex);
+			const bool useShadow = HasFlag(perm, MaterialPerm::UseShadow);
+			const std::uint32_t idx = (useTex ? 1u : 0u) | (useShadow ? 2u : 0u);
+			return psoMainOit_[idx];
+		}
+
 		rhi::PipelineHandle MainSkinnedPipelineFor(MaterialPerm perm) const noexcept
 		{
 			const bool useTex = HasFlag(perm, MaterialPerm::UseTex);
@@ -234,7 +639,30 @@ export namespace rendern
 			return floatValue;
 		}
 
-		SkinnedMeshRHI& GetOrCreateSkinnedMeshRHI(const std::shared_ptr<SkinnedAssetBundle>& asset)
+		// Vertices of a skinned draw: its slice of the skinned vertex cache when the compute pre-pass skinned
+		// it this frame, the bind-pose mesh (skinned in the vertex shader) otherwise.
+		void BindSkinnedDrawVertices(rhi::CommandList& commandList, const SkinnedOpaqueDraw& draw) const
+		{
+			commandList.BindInputLayout(draw.mesh->layout);
+			if (draw.cachedVertexOffset != kNoSkinnedVertexCache)
+			{
+				commandList.BindVertexBuffer(0, skinnedVertexBuffer_, draw.mesh->vertexStrideBytes, draw.cachedVertexOffset * draw.mesh->vertexStrideBytes);
+			}
+			else
+			{
+				commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, draw.mesh->vertexOffsetBytes);
+			}
+			commandList.BindIndexBuffer(draw.mesh->indexBuffer, draw.mesh->indexType, draw.mesh->indexOffsetBytes);
+		}
+
+		// uSkinning of a skinned draw: boneCount 0 tells the shader the vertices are already skinned.
+		static std::array<float, 4> SkinningConstantsFor(const SkinnedOpaqueDraw& draw) noexcept
+		{
+			const bool cached = draw.cachedVertexOffset != kNoSkinnedVertexCache;
+			return { static_cast<float>(draw.paletteOffset), cached ? 0.0f : static_cast<float>(draw.boneCount), 0.0f, 0.0f };
+		}
+
+		SkinnedMeshRHI& GetOrCreateSkinnedMeshRHI(const std::shared_ptr<const SkinnedAssetBundle>& asset)
 		{
 			auto it = skinnedMeshCache_.find(asset.get());
 			if (it != skinnedMeshCache_.end())
@@ -242,7 +670,7 @@ export namespace rendern
 				return it->second;
 			}
 			const std::string debugName = (asset && !asset->debugName.empty()) ? asset->debugName : "SkinnedMesh";
-			auto [insertedIt, _] = skinnedMeshCache_.emplace(asset.get(), UploadSkinnedMesh(device_, asset->mesh, debugName));
+			auto [insertedIt, _] = skinnedMeshCache_.emplace(asset.get(), UploadSkinnedMesh(device_, asset->mesh, debugName, meshAllocator_));
 			return insertedIt->second;
 		}
 
@@ -289,7 +717,7 @@ export namespace rendern
 			return reflected;
 		}
 
-		std::uint32_t UploadLights(const Scene& scene, const mathUtils::Vec3& camPos)
+		std::uint32_t UploadLights(const Scene& scene, const mathUtils::Vec3& camPos, const rhi::Extent2D& viewport)
 		{
 #include "RendererImpl/DirectX12Renderer_UploadLights.inl"
 		}
@@ -378,8 +806,9 @@ export namespace rendern
 					device_.DestroyTexture(probe.depthCube);
 					probe.depthCube = {};
 				}
-				probe.dirty = true;
 				probe.hasLastPos = false;
+				probe.staleFaces = kAllReflectionProbeFaces;
+				probe.captured = false;
 			}
 		}
 
@@ -444,8 +873,10 @@ export namespace rendern
 					device_.UpdateTextureDescriptor(probe.cubeDescIndex, probe.cube);
 				}
 
-				probe.dirty = true;
 				probe.hasLastPos = false;
+				probe.staleFaces = kAllReflectionProbeFaces;
+				probe.captured = false;
+				probe.framesWaiting = 0;
 				probe.ownerDrawItem = -1;
 				probe.capturePos = {};
 				probe.lastPos = {};
@@ -453,12 +884,24 @@ export namespace rendern
 		}
 
 	private:
-		static constexpr std::uint32_t kMaxLights = 64;
+		static constexpr std::uint32_t kMaxLights = 4096;
+		// Passes rendered from other cameras (reflection capture, planar mirrors) loop lights unclustered.
+		static constexpr std::uint32_t kMaxUnclusteredLights = 64;
+		static constexpr std::uint32_t kMaxLightClusterIndices = 256u * 1024u;
 		static constexpr std::uint32_t kDefaultInstanceBufferSizeBytes = 8u * 1024u * 1024u; // 8 MB (combined shadow+main instances)
 		static constexpr std::uint32_t kDefaultSkinPaletteBufferSizeBytes = 4u * 1024u * 1024u;
 		static constexpr std::uint32_t kMaxDeferredReflectionProbes = 255u;
 		static constexpr std::uint32_t kMaxParticles = 16384u;
 		static constexpr std::uint32_t kParticleInstanceBufferSizeBytes = static_cast<std::uint32_t>(sizeof(ParticleInstanceData) * kMaxParticles);
+		static constexpr std::uint32_t kMaxGpuCullBatches = 16384u;
+		static constexpr std::uint32_t kMaxShadowIndirectDraws = 16384u;
+		// DispatchMesh limits: per dimension and in total.
+		static constexpr std::uint32_t kMaxDispatchMeshGroups = 65535u;
+		static constexpr std::uint32_t kMaxDispatchMeshGroupsTotal = 1u << 22;
+		static constexpr std::size_t kFrameArenaBytes = 4u << 20;
+		static constexpr std::size_t kBuildInstancesGrain = 256; // draw items per build-instances job
+		static constexpr std::uint32_t kNoMaterialState = ~0u;
+		static constexpr std::uint32_t kNoShadowIndirectArgs = ~0u;
 
 		rhi::IRHIDevice& device_;
 		RendererSettings settings_{};
@@ -473,15 +916,24 @@ export namespace rendern
 		std::array<rhi::PipelineHandle, 4> psoMainSkinned_{};
 		std::array<rhi::PipelineHandle, 4> psoPlanar_{}; // same indexing, compiled with CORE_PLANAR_CLIP
 		std::array<rhi::PipelineHandle, 4> psoPlanarSkinned_{};
+		std::array<rhi::PipelineHandle, 4> psoMainOit_{}; // same indexing, compiled with CORE_WEIGHTED_OIT (accum + coverage MRT)
 		rhi::PipelineHandle psoPlanarComposite_{}; // fullscreen planar composite (mask+color -> SceneColor)
+		rhi::PipelineHandle psoWeightedOitComposite_{}; // fullscreen OIT resolve (accum+coverage -> SceneColor)
 		rhi::PipelineHandle psoHighlight_{}; // editor selection highlight overlay
 		rhi::PipelineHandle psoHighlightSkinned_{};
 		rhi::PipelineHandle psoOutline_{}; // editor selection outline shell
 		rhi::PipelineHandle psoOutlineSkinned_{};
 		rhi::PipelineHandle psoDeferredGBuffer_{}; // MRT G-Buffer writer
 		rhi::PipelineHandle psoDeferredGBufferSkinned_{}; // MRT G-Buffer writer for skinned meshes
+		rhi::PipelineHandle psoDeferredGBufferMeshlet_{}; // MRT G-Buffer writer, amplification + mesh shaders
 		rhi::PipelineHandle psoDeferredLighting_{}; // fullscreen deferred lighting
 		rhi::PipelineHandle psoSSAO_{};          // deferred SSAO (normal+depth -> R32_FLOAT)
+		// GBUFFER_COMPACT variants of the above (settings_.compactGBuffer)
+		rhi::PipelineHandle psoDeferredGBufferCompact_{};
+		rhi::PipelineHandle psoDeferredGBufferSkinnedCompact_{};
+		rhi::PipelineHandle psoDeferredGBufferMeshletCompact_{};
+		rhi::PipelineHandle psoDeferredLightingCompact_{};
+		rhi::PipelineHandle psoSSAOCompact_{};
 		rhi::PipelineHandle psoSSAOForward_{};   // forward SSAO (depth-only reconstruction -> R32_FLOAT)
 		rhi::PipelineHandle psoSSAOBlur_{};      // fullscreen SSAO blur (R32_FLOAT)
 		rhi::PipelineHandle psoSSAOComposite_{}; // fullscreen SceneColor * AO
@@ -491,15 +943,19 @@ export namespace rendern
 		rhi::PipelineHandle psoBloomComposite_{}; // fullscreen SceneColor + Bloom
 		rhi::PipelineHandle psoToneMap_{};       // fullscreen tonemap SceneColor -> RGBA8 target / swapchain
 		rhi::PipelineHandle psoFXAA_{};          // fullscreen FXAA RGBA8 target -> swapchain
+		rhi::PipelineHandle psoUpscale_{};       // fullscreen bicubic upscale of the scaled LDR image + depth -> swapchain
 		rhi::PipelineHandle psoCopyToSwapChain_{}; // fullscreen copy SceneColor -> swapchain
-		rhi::PipelineHandle psoParticles_{};      // instanced billboard particles (procedural)
-		rhi::PipelineHandle psoParticlesTextured_{}; // instanced billboard particles (textured)
+		rhi::PipelineHandle psoParticles_{};      // instanced billboard particles (bindless texture + flipbook frame per instance)
+		rhi::PipelineHandle psoParticlesGpu_{};      // indirect billboards of the GPU particle pool
 		rhi::InputLayoutHandle fullscreenLayout_{}; // empty input layout for fullscreen VS (SV_VertexID)
 		rhi::GraphicsState deferredLightingState_{};
 		rhi::GraphicsState planarCompositeState_{};
+		rhi::GraphicsState weightedOitCompositeState_{};
 		rhi::GraphicsState copyToSwapChainState_{};
+		rhi::GraphicsState upscaleState_{};      // writes SV_Depth: depth test Always, depth write on
 		rhi::GraphicsState state_{};
 		rhi::GraphicsState transparentState_{};
+		rhi::GraphicsState weightedOitState_{};  // transparentState_ with BlendMode::WeightedOit
 		rhi::GraphicsState highlightState_{};
 		rhi::GraphicsState outlineMarkState_{};
 		rhi::GraphicsState outlineState_{};
@@ -516,14 +972,94 @@ export namespace rendern
 		rhi::BufferHandle highlightInstanceBuffer_{}; // single-instance VB for selection highlight
 		rhi::BufferHandle particleInstanceBuffer_{};
 
+		// GPU culling (forward opaque batches, compute). Created only when the device supports compute.
+		rhi::PipelineHandle psoHiZBuild_{};
+		rhi::PipelineHandle psoGpuCull_{};
+		rhi::BufferHandle gpuCulledInstanceBuffer_{};    // compacted main instances, VB slot1 of the indirect draws
+		rhi::BufferHandle gpuCullArgsBuffer_{};          // DrawIndexedIndirectArgs per main batch
+		rhi::BufferHandle gpuCullBatchBuffer_{};         // GpuCullBatchData per main batch
+		rhi::BufferHandle gpuCullInstanceBatchBuffer_{}; // main instance -> batch index
+		rhi::BufferHandle hiZBuffer_{};
+		rhi::Extent2D hiZExtent_{};
+		std::array<std::array<std::uint32_t, 4>, kMaxHiZLevels> hiZLevels_{}; // offset, width, height, 0
+		std::uint32_t hiZLevelCount_{ 0 };
+
+		// GPU particle pool (compute). Created only when the device supports compute.
+		rhi::PipelineHandle psoParticleInit_{};
+		rhi::PipelineHandle psoParticleEmit_{};
+		rhi::PipelineHandle psoParticleBeginSimulate_{};
+		rhi::PipelineHandle psoParticleSimulate_{};
+		rhi::PipelineHandle psoParticleSortLocal_{};
+		rhi::PipelineHandle psoParticleSortMerge_{};
+		rhi::PipelineHandle psoParticleSortStep_{};
+		rhi::BufferHandle gpuParticleBuffer_{};         // GpuParticleData per pool slot
+		rhi::BufferHandle gpuParticleDeadListBuffer_{}; // free slot indices
+		rhi::BufferHandle gpuParticleSortBuffer_{};     // (depth key, slot) per pool slot, sorted
+		rhi::BufferHandle gpuParticleCountersBuffer_{}; // indirect draw args + dead count + live count per emitter
+		rhi::BufferHandle gpuParticleEmitterBuffer_{};  // GpuParticleEmitterData per scene emitter
+		rhi::BufferHandle gpuParticleSpawnBuffer_{};    // GpuParticleSpawnRange per emitter spawning this frame
+		std::vector<GpuParticleEmitterState> gpuParticleEmitters_;
+		bool gpuParticlePoolReset_{ true }; // the next GPU particle frame clears the pool first
+
+		// Compute skinning pre-pass. Created only when the device supports compute.
+		rhi::PipelineHandle psoSkinVertices_{};
+		rhi::BufferHandle skinnedVertexBuffer_{}; // SkinnedVertexDesc x kSkinnedVertexCacheCapacity, rewritten every frame
+
+		// Persistent instance transforms (compute). Created only when the device supports compute.
+		rhi::PipelineHandle psoInstanceScatter_{};
+		rhi::PipelineHandle psoInstanceGather_{};
+		rhi::BufferHandle instanceTransformBuffer_{};       // InstanceData per draw item slot, kept across frames
+		rhi::BufferHandle instanceTransformUpdateBuffer_{}; // InstanceTransformUpdate per slot changed this frame
+		rhi::BufferHandle instanceRefBuffer_{};             // InstanceRef per instanceBuffer_ entry
+		std::vector<InstanceData> instanceTransformResident_;  // CPU copy of instanceTransformBuffer_
+		std::vector<std::uint8_t> instanceTransformValid_;     // slot of instanceTransformResident_ is on the GPU
+
+		// World bounding spheres of the draw items (rebuilt every frame) and the CPU culling BVH over them:
+		// one leaf per draw item with bounds, refit when the item's world sphere moves.
+		rendern::WorldSphereStreams drawItemSpheres_{};
+		rendern::SceneBvh cullBvh_{};
+		std::vector<rendern::SceneBvh::ProxyId> cullBvhProxy_; // per draw item
+		std::vector<mathUtils::Vec4> cullBvhSphere_;           // per draw item: world sphere the leaf was built from
+
+		// DrawIndexedIndirectArgs per shadow batch (shadowBatches, the layered point shadows', then the cascades'), rebuilt each frame.
+		rhi::BufferHandle shadowIndirectArgsBuffer_{};
+
 		// Shadow pass
 		rhi::PipelineHandle psoShadow_{};
 		rhi::PipelineHandle psoShadowSkinned_{};
+		rhi::PipelineHandle psoShadowMeshlet_{}; // directional cascades, amplification + mesh shaders
 		rhi::GraphicsState shadowState_{};
 
+		// Object-ID picking (RequestObjectIdPick). The ID pass only runs on frames with requests.
+		rhi::PipelineHandle psoObjectId_{};
+		rhi::PipelineHandle psoObjectIdSkinned_{};
+		rhi::BufferHandle objectIdBuffer_{};                   // object ID per instanceBuffer_ entry (0 = none)
+		std::vector<std::pair<std::uint64_t, ObjectIdPickRequest>> objectIdPickRequests_; // for the next frame
+		std::vector<rhi::TextureReadback> objectIdReadbacks_;  // finished, oldest first
+		std::uint64_t nextObjectIdPickId_{ 1 };
+
+		// Deferred G-buffer material table (GBufferMaterials_dx12.hlsli). The table is packed from the scene's
+		// materials every frame and only uploaded when that differs from what the GPU holds.
+		rhi::BufferHandle materialTableBuffer_{};        // MaterialGpu per material handle id (0 = no material)
+		std::uint32_t materialTableCapacity_{ 0 };
+		std::vector<MaterialGpu> materialTableUploaded_; // CPU copy of materialTableBuffer_
+		std::vector<MaterialGpu> materialTableScratch_;
+		rhi::BufferHandle instanceMaterialBuffer_{};     // material table index per instanceBuffer_ entry of the main pass
+
+		// Static caster depth of the directional atlas and of the spot shadow atlas (enableShadowCaching).
+		ShadowCacheEntry dirShadowCache_{};
+		ShadowCacheEntry spotShadowCache_{};
+		CascadeScheduleState dirCascadeSchedule_{};
+
 		rhi::BufferHandle lightsBuffer_{};
 		rhi::BufferHandle shadowDataBuffer_{};
 
+		// Clustered light lists for the main camera (t20) and a disabled header for other cameras.
+		LightClusterBuilder lightClusters_{ LightClusterGrid{}, kMaxLightClusterIndices };
+		std::vector<LightClusterBounds> lightClusterBounds_;
+		rhi::BufferHandle lightClustersBuffer_{};
+		rhi::BufferHandle lightClustersOffBuffer_{};
+
 		rhi::BufferHandle reflectionProbeMetaBuffer_{};
 
 		// Point shadow pass (R32_FLOAT distance cubemap)
@@ -552,18 +1088,34 @@ export namespace rendern
 
 		std::vector<ReflectionProbeRuntime> reflectionProbes_;
 		std::vector<int> reflectiveOwnerDrawItems_;           // frame list of owners
+		std::vector<MaterialHandle> drawnMaterials_;          // frame list, residency feedback
+		std::vector<std::uint8_t> drawnMaterialMask_;         // size == scene material count
 		std::vector<int> drawItemReflectionProbeIndices_;     // size == scene.drawItems.size()
 		std::vector<TransparentDraw> scratchTransparentDraws_;
 		std::vector<InstanceData> scratchCombinedInstances_;
 		std::vector<DeferredReflectionProbeGpu> scratchDeferredReflectionProbes_;
 		std::vector<int> scratchDeferredReflectionProbeRemap_;
 
+		jobs::Scheduler* jobScheduler_{ nullptr };
+		renderer::IGPUMemoryAllocator* meshAllocator_{ nullptr };
+
+		static std::filesystem::path PipelineCacheDir()
+		{
+			return corefs::CookedCacheRoot() / "pipelines";
+		}
+		memory::FrameArena frameArena_{ kFrameArenaBytes };               // per-frame scratch of the build-instances stage
+		renderGraph::TransientResourcePool transientPool_{};              // render graph targets and framebuffers, reused across frames
+		RendererFrameStats frameStats_{};                                 // last frame, see GetFrameStats
+		rhi::DeviceCounters lastDeviceCounters_{};                        // device totals at the end of the last frame
+		DynamicResolutionController dynamicResolution_{};                 // deferred render scale from the GPU frame time
+		containers::FlatHashMap<const rendern::MeshRHI*, std::uint32_t> drawMeshIds_{};                   // frame: mesh -> draw key mesh id
+		containers::FlatHashMap<BatchKey, std::uint32_t, BatchKeyHash, BatchKeyEq> materialStateIds_{}; // frame: material part -> state id
 		std::vector<TransparentDraw> transparentDrawsScratch_;
-		std::vector<InstanceData> combinedInstancesScratch_;
+		std::vector<InstanceData> combinedInstancesScratch_; // CPU expansion of the instance refs (no compute)
+		std::vector<InstanceTransformUpdate> instanceTransformUpdatesScratch_;
 		std::unordered_map<const SkinnedAssetBundle*, SkinnedMeshRHI> skinnedMeshCache_{};
 		std::vector<DeferredReflectionProbeGpu> deferredReflectionProbesScratch_;
 		std::vector<int> deferredReflectionProbeRemapScratch_;
-		std::vector<ParticleDrawBatch> particleBatches_{};
 		static constexpr std::size_t kMaxReflectionProbes = 16;
 
 		int reflectionCaptureLastAnchorKind_{ 0 }; // 0=auto/none, 1=selected, 2=owner, 3=debugOwnerIndex
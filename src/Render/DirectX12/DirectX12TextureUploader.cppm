@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <cstring>
 #include <optional>
+#include <unordered_map>
 
 #include "d3dx12.h"
 #endif
@@ -36,6 +37,38 @@ DXGI_FORMAT DxgiRGBA8(bool srgb)
 	return srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
 }
 
+// Formats the uploader accepts as-is; BC payloads are copied block for block.
+// DXGI_FORMAT_UNKNOWN for anything else (RGB/GRAYSCALE are expanded by the decoder).
+DXGI_FORMAT DxgiTextureFormat(const TextureCPUData& cpuData, bool srgb)
+{
+	switch (cpuData.format)
+	{
+	case TextureFormat::RGBA:
+		return (cpuData.channels == 4) ? DxgiRGBA8(srgb) : DXGI_FORMAT_UNKNOWN;
+	case TextureFormat::BC1:
+		return srgb ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+	case TextureFormat::BC3:
+		return srgb ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+	case TextureFormat::BC5:
+		return DXGI_FORMAT_BC5_UNORM; // two-channel data has no sRGB variant
+	case TextureFormat::BC7:
+		return srgb ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+	default:
+		return DXGI_FORMAT_UNKNOWN;
+	}
+}
+
+// Full chain down to 1x1.
+UINT FullMipLevels(std::uint32_t width, std::uint32_t height)
+{
+	UINT levels = 1;
+	for (std::uint32_t side = std::max(width, height); side > 1u; side >>= 1)
+	{
+		++levels;
+	}
+	return levels;
+}
+
 export namespace rendern
 {
 #if defined(_WIN32)
@@ -50,14 +83,23 @@ export namespace rendern
 
 		~DX12TextureUploader() override
 		{
-			AbortUploadBatch_();
-			if (batchEvent_)
+			if (batchDepth_ != 0u)
 			{
-				CloseHandle(batchEvent_);
-				batchEvent_ = nullptr;
+				AbortUploadBatch_();
 			}
 		}
 
+		// On: RGBA8 textures that asked for mips but arrive with mip 0 only (StbTextureDecoder with
+		// CPU mips off) are created with the full chain and get it from the device's GenerateMips
+		// pass after the copy; IsUploadComplete stays false until then. Ignored without
+		// SupportsGenerateMips().
+		void SetGpuMipGeneration(bool enabled) noexcept { gpuMipGeneration_ = enabled; }
+
+		// Upload batches record into the device's copy-queue list (direct-queue list if the
+		// device has no copy queue) and take their staging memory from the shared ring.
+		// EndUploadBatch submits without waiting. On the copy queue, textures are reported
+		// through IsUploadComplete once the batch's copy fence passed; nothing samples them
+		// before that because the storage withholds the resource until then.
 		void BeginUploadBatch() override
 		{
 			auto* dxDev = dynamic_cast<rhi::DX12Device*>(&device_);
@@ -66,12 +108,6 @@ export namespace rendern
 				return;
 			}
 
-			ID3D12Device* d3d = dxDev->NativeDevice();
-			if (!d3d)
-			{
-				return;
-			}
-
 			++batchDepth_;
 			if (batchDepth_ > 1u)
 			{
@@ -80,16 +116,17 @@ export namespace rendern
 
 			try
 			{
-				EnsureBatchObjects_(d3d);
-				ThrowIfFailed(batchAllocator_->Reset(), "DX12TextureUploader: batch allocator reset failed");
-				ThrowIfFailed(batchList_->Reset(batchAllocator_.Get(), nullptr), "DX12TextureUploader: batch cmdlist reset failed");
-				batchPendingUploads_.clear();
+				ReleaseFinishedDestroys_(*dxDev);
+				batchOnCopyQueue_ = dxDev->HasCopyQueue();
+				batchList_ = batchOnCopyQueue_ ? dxDev->BeginCopyCommands() : dxDev->BeginUploadCommands();
 				batchHasCommands_ = false;
+				batchTextures_.clear();
+				batchMipTextures_.clear();
 			}
 			catch (...)
 			{
 				batchDepth_ = 0u;
-				batchPendingUploads_.clear();
+				batchList_ = nullptr;
 				batchHasCommands_ = false;
 				throw;
 			}
@@ -114,13 +151,64 @@ export namespace rendern
 				return;
 			}
 
-			ID3D12CommandQueue* queue = dxDev->NativeQueue();
-			if (!queue)
+			try
 			{
-				AbortUploadBatch_();
-				return;
+				if (!batchHasCommands_)
+				{
+					AbortBatchCommands_(*dxDev);
+				}
+				else if (batchOnCopyQueue_)
+				{
+					const UINT64 fenceValue = dxDev->SubmitCopyCommands();
+					for (const unsigned int id : batchTextures_)
+					{
+						copyFenceByTexture_[id] = fenceValue;
+					}
+					QueueBatchMipGenerations_(*dxDev, fenceValue);
+				}
+				else
+				{
+					dxDev->SubmitUploadCommands();
+					QueueBatchMipGenerations_(*dxDev, 0);
+				}
+			}
+			catch (...)
+			{
+				AbortBatchCommands_(*dxDev);
+				batchList_ = nullptr;
+				batchHasCommands_ = false;
+				batchTextures_.clear();
+				batchMipTextures_.clear();
+				throw;
 			}
-			SubmitAndWaitBatch_(queue);
+
+			batchList_ = nullptr;
+			batchHasCommands_ = false;
+			batchTextures_.clear();
+			batchMipTextures_.clear();
+		}
+
+		bool IsUploadComplete(GPUTexture texture) override
+		{
+			auto* dxDev = dynamic_cast<rhi::DX12Device*>(&device_);
+			if (dxDev && dxDev->IsMipGenerationPending(rhi::TextureHandle{ static_cast<std::uint32_t>(texture.id) }))
+			{
+				return false;
+			}
+
+			auto it = copyFenceByTexture_.find(texture.id);
+			if (it == copyFenceByTexture_.end())
+			{
+				return true;
+			}
+
+			if (dxDev && !dxDev->IsCopyFenceComplete(it->second))
+			{
+				return false;
+			}
+
+			copyFenceByTexture_.erase(it);
+			return true;
 		}
 
 		std::optional<GPUTexture> CreateAndUpload(const TextureCPUData& cpuData, const TextureProperties& properties) override
@@ -183,6 +271,20 @@ export namespace rendern
 				return;
 			}
 
+			// The device defers releases by its direct-queue frame fence only, so a texture the
+			// copy queue may still be writing is parked until its copy fence passes.
+			if (auto it = copyFenceByTexture_.find(texture.id); it != copyFenceByTexture_.end())
+			{
+				auto* dxDev = dynamic_cast<rhi::DX12Device*>(&device_);
+				if (dxDev && !dxDev->IsCopyFenceComplete(it->second))
+				{
+					destroyAfterCopy_.push_back(DeferredDestroy{ texture, it->second });
+					copyFenceByTexture_.erase(it);
+					return;
+				}
+				copyFenceByTexture_.erase(it);
+			}
+
 			rhi::TextureHandle textureHandle{};
 			textureHandle.id = static_cast<std::uint32_t>(texture.id);
 			device_.DestroyTexture(textureHandle);
@@ -202,89 +304,79 @@ export namespace rendern
 			return RecordTexture2DUpload_(dxDev, d3d, cpuData, properties);
 		}
 
-		void EnsureBatchObjects_(ID3D12Device* d3d)
+		struct DeferredDestroy
 		{
-			if (!batchFence_)
-			{
-				ThrowIfFailed(d3d->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&batchFence_)),
-					"DX12TextureUploader: CreateFence failed");
-			}
-
-			if (!batchEvent_)
-			{
-				batchEvent_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-				if (!batchEvent_)
-				{
-					throw std::runtime_error("DX12TextureUploader: CreateEvent failed");
-				}
-			}
+			GPUTexture texture{};
+			UINT64 copyFenceValue{ 0 };
+		};
 
-			if (!batchAllocator_)
-			{
-				ThrowIfFailed(
-					d3d->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&batchAllocator_)),
-					"DX12TextureUploader: CreateCommandAllocator failed");
-			}
+		struct BatchMipTexture
+		{
+			unsigned int id{ 0 };
+			bool normalMap{ false };
+		};
 
-			if (!batchList_)
-			{
-				ThrowIfFailed(
-					d3d->CreateCommandList(
-						0,
-						D3D12_COMMAND_LIST_TYPE_DIRECT,
-						batchAllocator_.Get(),
-						nullptr,
-						IID_PPV_ARGS(&batchList_)),
-					"DX12TextureUploader: CreateCommandList failed");
-				ThrowIfFailed(batchList_->Close(), "DX12TextureUploader: Close initial batch cmdlist failed");
-			}
+		// Mip count of the created resource: the CPU chain, or the full chain for GenerateMips.
+		UINT ResourceMipLevels_(rhi::DX12Device& dxDev, const TextureCPUData& cpuData, const TextureProperties& properties,
+			UINT cpuMipLevels, std::uint32_t width, std::uint32_t height) const
+		{
+			const bool gpuMips = gpuMipGeneration_
+				&& properties.generateMips
+				&& cpuData.format == TextureFormat::RGBA
+				&& cpuMipLevels == 1u
+				&& (width > 1u || height > 1u)
+				&& dxDev.SupportsGenerateMips();
+			return gpuMips ? FullMipLevels(width, height) : cpuMipLevels;
 		}
 
-		void SubmitAndWaitBatch_(ID3D12CommandQueue* queue)
+		// The device runs the pass once the batch's copy fence passed (0: direct-queue batch).
+		void QueueBatchMipGenerations_(rhi::DX12Device& dxDev, UINT64 copyFenceValue)
 		{
-			if (!batchList_)
+			for (const BatchMipTexture& t : batchMipTextures_)
 			{
-				batchPendingUploads_.clear();
-				batchHasCommands_ = false;
-				return;
+				dxDev.QueueGenerateMips(rhi::TextureHandle{ static_cast<std::uint32_t>(t.id) }, copyFenceValue, t.normalMap);
 			}
+		}
 
-			try
+		void AbortBatchCommands_(rhi::DX12Device& dxDev) noexcept
+		{
+			if (batchOnCopyQueue_)
 			{
-				ThrowIfFailed(batchList_->Close(), "DX12TextureUploader: Close batch cmdlist failed");
-				if (batchHasCommands_)
-				{
-					ID3D12CommandList* lists[] = { batchList_.Get() };
-					queue->ExecuteCommandLists(1, lists);
-
-					const UINT64 fenceValue = ++batchFenceValue_;
-					ThrowIfFailed(queue->Signal(batchFence_.Get(), fenceValue), "DX12TextureUploader: Signal failed");
-					if (batchFence_->GetCompletedValue() < fenceValue)
-					{
-						ThrowIfFailed(batchFence_->SetEventOnCompletion(fenceValue, batchEvent_),
-							"DX12TextureUploader: SetEventOnCompletion failed");
-						WaitForSingleObject(batchEvent_, INFINITE);
-					}
-				}
-
-				batchPendingUploads_.clear();
-				batchHasCommands_ = false;
+				dxDev.AbortCopyCommands();
 			}
-			catch (...)
+			else
 			{
-				AbortUploadBatch_();
-				throw;
+				dxDev.AbortUploadCommands();
 			}
 		}
 
 		void AbortUploadBatch_() noexcept
 		{
+			if (auto* dxDev = dynamic_cast<rhi::DX12Device*>(&device_))
+			{
+				AbortBatchCommands_(*dxDev);
+			}
 			batchDepth_ = 0u;
-			batchPendingUploads_.clear();
+			batchList_ = nullptr;
 			batchHasCommands_ = false;
-			batchList_.Reset();
-			batchAllocator_.Reset();
-			batchFence_.Reset();
+			batchTextures_.clear();
+			batchMipTextures_.clear();
+		}
+
+		void ReleaseFinishedDestroys_(rhi::DX12Device& dxDev)
+		{
+			std::erase_if(destroyAfterCopy_, [&](const DeferredDestroy& d)
+				{
+					if (!dxDev.IsCopyFenceComplete(d.copyFenceValue))
+					{
+						return false;
+					}
+
+					rhi::TextureHandle textureHandle{};
+					textureHandle.id = static_cast<std::uint32_t>(d.texture.id);
+					device_.DestroyTexture(textureHandle);
+					return true;
+				});
 		}
 
 		std::optional<GPUTexture> RecordCubeUpload_(
@@ -293,7 +385,7 @@ export namespace rendern
 			const TextureCPUData& cpuData,
 			const TextureProperties& properties)
 		{
-			ID3D12GraphicsCommandList* list = batchList_.Get();
+			ID3D12GraphicsCommandList* list = batchList_;
 			if (!list)
 			{
 				return std::nullopt;
@@ -307,7 +399,12 @@ export namespace rendern
 				return std::nullopt;
 			}
 
-			if (cpuData.format != TextureFormat::RGBA || cpuData.channels != 4)
+			const DXGI_FORMAT fmt = DxgiTextureFormat(cpuData, properties.srgb);
+			if (fmt == DXGI_FORMAT_UNKNOWN)
+			{
+				return std::nullopt;
+			}
+			if (IsBlockCompressed(cpuData.format) && (width % 4u != 0u || height % 4u != 0u))
 			{
 				return std::nullopt;
 			}
@@ -337,7 +434,7 @@ export namespace rendern
 					{
 						return std::nullopt;
 					}
-					const std::size_t expectedSize = static_cast<std::size_t>(ml.width) * static_cast<std::size_t>(ml.height) * 4u;
+					const std::size_t expectedSize = TextureMipBytes(cpuData.format, ml.width, ml.height);
 					if (ml.pixels.empty() || ml.pixels.size() != expectedSize)
 					{
 						return std::nullopt;
@@ -345,26 +442,31 @@ export namespace rendern
 				}
 			}
 
-			const DXGI_FORMAT fmt = DxgiRGBA8(properties.srgb);
+			const UINT resourceMips = ResourceMipLevels_(dxDev, cpuData, properties, mipLevels, width, height);
+			const bool gpuMips = resourceMips != mipLevels;
+
 			ComPtr<ID3D12Resource> texture;
-			ComPtr<ID3D12Resource> upload;
 			rhi::TextureHandle registeredHandle{};
 
 			try
 			{
+				// GPU mips: typeless so the sRGB SRV and the UNORM UAVs share the resource.
 				D3D12_RESOURCE_DESC texDesc{};
 				texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
 				texDesc.Alignment = 0;
 				texDesc.Width = width;
 				texDesc.Height = height;
 				texDesc.DepthOrArraySize = 6;
-				texDesc.MipLevels = static_cast<UINT16>(mipLevels);
-				texDesc.Format = fmt;
+				texDesc.MipLevels = static_cast<UINT16>(resourceMips);
+				texDesc.Format = gpuMips ? DXGI_FORMAT_R8G8B8A8_TYPELESS : fmt;
 				texDesc.SampleDesc.Count = 1;
 				texDesc.SampleDesc.Quality = 0;
 				texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-				texDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+				texDesc.Flags = gpuMips ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
 
+				// Copy queue: create in COMMON (implicitly promoted to COPY_DEST there, decays back
+				// to COMMON afterwards, then promoted to a shader-read state by the direct queue).
+				const D3D12_RESOURCE_STATES initialState = batchOnCopyQueue_ ? D3D12_RESOURCE_STATE_COMMON : D3D12_RESOURCE_STATE_COPY_DEST;
 				{
 					D3D12_HEAP_PROPERTIES heapProps{};
 					heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
@@ -373,37 +475,20 @@ export namespace rendern
 							&heapProps,
 							D3D12_HEAP_FLAG_NONE,
 							&texDesc,
-							D3D12_RESOURCE_STATE_COPY_DEST,
+							initialState,
 							nullptr,
 							IID_PPV_ARGS(&texture)),
 						"DX12TextureUploader: CreateCommittedResource(textureCube) failed");
 				}
 
-				registeredHandle = dxDev.RegisterSampledTextureCube(texture.Get(), fmt, mipLevels);
+				registeredHandle = dxDev.RegisterSampledTextureCube(texture.Get(), fmt, resourceMips,
+					batchOnCopyQueue_ ? D3D12_RESOURCE_STATE_COMMON : D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 				if (!registeredHandle)
 				{
 					return std::nullopt;
 				}
 
 				const UINT numSubresources = mipLevels * 6u;
-				UINT64 uploadBytes = 0;
-				d3d->GetCopyableFootprints(&texDesc, 0, numSubresources, 0, nullptr, nullptr, nullptr, &uploadBytes);
-
-				{
-					D3D12_HEAP_PROPERTIES uploadProps{};
-					uploadProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-					auto upDesc = CD3DX12_RESOURCE_DESC::Buffer(uploadBytes);
-					ThrowIfFailed(
-						d3d->CreateCommittedResource(
-							&uploadProps,
-							D3D12_HEAP_FLAG_NONE,
-							&upDesc,
-							D3D12_RESOURCE_STATE_GENERIC_READ,
-							nullptr,
-							IID_PPV_ARGS(&upload)),
-						"DX12TextureUploader: CreateCommittedResource(uploadCube) failed");
-				}
-
 				std::vector<D3D12_SUBRESOURCE_DATA> subs{};
 				subs.reserve(numSubresources);
 				for (UINT slice = 0; slice < 6u; ++slice)
@@ -414,21 +499,52 @@ export namespace rendern
 						const auto& mipInst = mips[mip];
 						D3D12_SUBRESOURCE_DATA subResData{};
 						subResData.pData = mipInst.pixels.data();
-						subResData.RowPitch = static_cast<LONG_PTR>(mipInst.width) * 4;
-						subResData.SlicePitch = subResData.RowPitch * static_cast<LONG_PTR>(mipInst.height);
+						subResData.RowPitch = static_cast<LONG_PTR>(TextureRowPitchBytes(cpuData.format, mipInst.width));
+						subResData.SlicePitch = subResData.RowPitch * static_cast<LONG_PTR>(TextureRowCount(cpuData.format, mipInst.height));
 						subs.push_back(subResData);
 					}
 				}
 
-				UpdateSubresources(list, texture.Get(), upload.Get(), 0, 0, numSubresources, subs.data());
-				auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-					texture.Get(),
-					D3D12_RESOURCE_STATE_COPY_DEST,
-					D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-				list->ResourceBarrier(1, &barrier);
+				if (!gpuMips)
+				{
+					UINT64 uploadBytes = 0;
+					d3d->GetCopyableFootprints(&texDesc, 0, numSubresources, 0, nullptr, nullptr, nullptr, &uploadBytes);
+
+					const rhi::DX12Device::StagingAllocation staging =
+						dxDev.AllocateStaging(uploadBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+					UpdateSubresources(list, texture.Get(), staging.resource, staging.offset, 0, numSubresources, subs.data());
+				}
+				else
+				{
+					// Only mip 0 of each face is uploaded, and those subresources aren't contiguous.
+					UINT64 faceBytes = 0;
+					d3d->GetCopyableFootprints(&texDesc, 0, 1, 0, nullptr, nullptr, nullptr, &faceBytes);
+					const UINT64 faceStride = (faceBytes + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1)
+						& ~static_cast<UINT64>(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
+
+					const rhi::DX12Device::StagingAllocation staging =
+						dxDev.AllocateStaging(faceStride * 6u, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+					for (UINT slice = 0; slice < 6u; ++slice)
+					{
+						UpdateSubresources(list, texture.Get(), staging.resource, staging.offset + faceStride * slice,
+							slice * resourceMips, 1, &subs[slice]);
+					}
+				}
+				if (!batchOnCopyQueue_)
+				{
+					auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+						texture.Get(),
+						D3D12_RESOURCE_STATE_COPY_DEST,
+						D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+					list->ResourceBarrier(1, &barrier);
+				}
 
-				batchPendingUploads_.push_back(upload);
 				batchHasCommands_ = true;
+				batchTextures_.push_back(static_cast<unsigned int>(registeredHandle.id));
+				if (gpuMips)
+				{
+					batchMipTextures_.push_back(BatchMipTexture{ static_cast<unsigned int>(registeredHandle.id), properties.isNormalMap });
+				}
 				return GPUTexture{ static_cast<unsigned int>(registeredHandle.id) };
 			}
 			catch (...)
@@ -447,13 +563,14 @@ export namespace rendern
 			const TextureCPUData& cpuData,
 			const TextureProperties& properties)
 		{
-			ID3D12GraphicsCommandList* list = batchList_.Get();
+			ID3D12GraphicsCommandList* list = batchList_;
 			if (!list)
 			{
 				return std::nullopt;
 			}
 
-			if (cpuData.format != TextureFormat::RGBA || cpuData.channels != 4)
+			const DXGI_FORMAT fmt = DxgiTextureFormat(cpuData, properties.srgb);
+			if (fmt == DXGI_FORMAT_UNKNOWN)
 			{
 				return std::nullopt;
 			}
@@ -473,6 +590,10 @@ export namespace rendern
 			{
 				return std::nullopt;
 			}
+			if (IsBlockCompressed(cpuData.format) && (baseWidth % 4u != 0u || baseHeight % 4u != 0u))
+			{
+				return std::nullopt;
+			}
 
 			const UINT mipLevels = static_cast<UINT>(mips.size());
 			for (UINT mip = 0; mip < mipLevels; ++mip)
@@ -484,33 +605,38 @@ export namespace rendern
 				{
 					return std::nullopt;
 				}
-				const std::size_t expectedSize = static_cast<std::size_t>(mw) * static_cast<std::size_t>(mh) * 4u;
+				const std::size_t expectedSize = TextureMipBytes(cpuData.format, mw, mh);
 				if (ml.pixels.empty() || ml.pixels.size() != expectedSize)
 				{
 					return std::nullopt;
 				}
 			}
 
-			const DXGI_FORMAT fmt = DxgiRGBA8(properties.srgb);
+			const UINT resourceMips = ResourceMipLevels_(dxDev, cpuData, properties, mipLevels, baseWidth, baseHeight);
+			const bool gpuMips = resourceMips != mipLevels;
+
 			ComPtr<ID3D12Resource> texture;
-			ComPtr<ID3D12Resource> upload;
 			rhi::TextureHandle registeredHandle{};
 
 			try
 			{
+				// GPU mips: typeless so the sRGB SRV and the UNORM UAVs share the resource.
 				D3D12_RESOURCE_DESC texDesc{};
 				texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
 				texDesc.Alignment = 0;
 				texDesc.Width = baseWidth;
 				texDesc.Height = baseHeight;
 				texDesc.DepthOrArraySize = 1;
-				texDesc.MipLevels = static_cast<UINT16>(mipLevels);
-				texDesc.Format = fmt;
+				texDesc.MipLevels = static_cast<UINT16>(resourceMips);
+				texDesc.Format = gpuMips ? DXGI_FORMAT_R8G8B8A8_TYPELESS : fmt;
 				texDesc.SampleDesc.Count = 1;
 				texDesc.SampleDesc.Quality = 0;
 				texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-				texDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+				texDesc.Flags = gpuMips ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
 
+				// Copy queue: create in COMMON (implicitly promoted to COPY_DEST there, decays back
+				// to COMMON afterwards, then promoted to a shader-read state by the direct queue).
+				const D3D12_RESOURCE_STATES initialState = batchOnCopyQueue_ ? D3D12_RESOURCE_STATE_COMMON : D3D12_RESOURCE_STATE_COPY_DEST;
 				{
 					D3D12_HEAP_PROPERTIES heapProps{};
 					heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
@@ -519,35 +645,25 @@ export namespace rendern
 							&heapProps,
 							D3D12_HEAP_FLAG_NONE,
 							&texDesc,
-							D3D12_RESOURCE_STATE_COPY_DEST,
+							initialState,
 							nullptr,
 							IID_PPV_ARGS(&texture)),
 						"DX12TextureUploader: CreateCommittedResource(texture2D) failed");
 				}
 
-				registeredHandle = dxDev.RegisterSampledTexture(texture.Get(), fmt, mipLevels);
+				registeredHandle = dxDev.RegisterSampledTexture(texture.Get(), fmt, resourceMips,
+					batchOnCopyQueue_ ? D3D12_RESOURCE_STATE_COMMON : D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 				if (!registeredHandle)
 				{
 					return std::nullopt;
 				}
 
+				// GPU mips upload subresource 0 only; the rest is written by GenerateMips.
 				UINT64 uploadBytes = 0;
 				d3d->GetCopyableFootprints(&texDesc, 0, mipLevels, 0, nullptr, nullptr, nullptr, &uploadBytes);
 
-				{
-					D3D12_HEAP_PROPERTIES uploadProps{};
-					uploadProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-					auto upDesc = CD3DX12_RESOURCE_DESC::Buffer(uploadBytes);
-					ThrowIfFailed(
-						d3d->CreateCommittedResource(
-							&uploadProps,
-							D3D12_HEAP_FLAG_NONE,
-							&upDesc,
-							D3D12_RESOURCE_STATE_GENERIC_READ,
-							nullptr,
-							IID_PPV_ARGS(&upload)),
-						"DX12TextureUploader: CreateCommittedResource(upload2D) failed");
-				}
+				const rhi::DX12Device::StagingAllocation staging =
+					dxDev.AllocateStaging(uploadBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
 
 				std::vector<D3D12_SUBRESOURCE_DATA> subs{};
 				subs.reserve(mipLevels);
@@ -558,20 +674,27 @@ export namespace rendern
 					const std::uint32_t mh = (mipInst.height != 0u) ? mipInst.height : std::max(1u, baseHeight >> mip);
 					D3D12_SUBRESOURCE_DATA subResData{};
 					subResData.pData = mipInst.pixels.data();
-					subResData.RowPitch = static_cast<LONG_PTR>(mw) * 4;
-					subResData.SlicePitch = subResData.RowPitch * static_cast<LONG_PTR>(mh);
+					subResData.RowPitch = static_cast<LONG_PTR>(TextureRowPitchBytes(cpuData.format, mw));
+					subResData.SlicePitch = subResData.RowPitch * static_cast<LONG_PTR>(TextureRowCount(cpuData.format, mh));
 					subs.push_back(subResData);
 				}
 
-				UpdateSubresources(list, texture.Get(), upload.Get(), 0, 0, mipLevels, subs.data());
-				auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-					texture.Get(),
-					D3D12_RESOURCE_STATE_COPY_DEST,
-					D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-				list->ResourceBarrier(1, &barrier);
+				UpdateSubresources(list, texture.Get(), staging.resource, staging.offset, 0, mipLevels, subs.data());
+				if (!batchOnCopyQueue_)
+				{
+					auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+						texture.Get(),
+						D3D12_RESOURCE_STATE_COPY_DEST,
+						D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+					list->ResourceBarrier(1, &barrier);
+				}
 
-				batchPendingUploads_.push_back(upload);
 				batchHasCommands_ = true;
+				batchTextures_.push_back(static_cast<unsigned int>(registeredHandle.id));
+				if (gpuMips)
+				{
+					batchMipTextures_.push_back(BatchMipTexture{ static_cast<unsigned int>(registeredHandle.id), properties.isNormalMap });
+				}
 				return GPUTexture{ static_cast<unsigned int>(registeredHandle.id) };
 			}
 			catch (...)
@@ -585,14 +708,15 @@ export namespace rendern
 		}
 
 		rhi::IRHIDevice& device_;
-		ComPtr<ID3D12CommandAllocator> batchAllocator_{};
-		ComPtr<ID3D12GraphicsCommandList> batchList_{};
-		ComPtr<ID3D12Fence> batchFence_{};
-		HANDLE batchEvent_{ nullptr };
-		UINT64 batchFenceValue_{ 0 };
-		std::vector<ComPtr<ID3D12Resource>> batchPendingUploads_{};
+		ID3D12GraphicsCommandList* batchList_{ nullptr };
 		std::uint32_t batchDepth_{ 0 };
+		bool batchOnCopyQueue_{ false };
+		std::vector<unsigned int> batchTextures_{};
+		std::vector<BatchMipTexture> batchMipTextures_{};
+		std::unordered_map<unsigned int, UINT64> copyFenceByTexture_{};
+		std::vector<DeferredDestroy> destroyAfterCopy_{};
 		bool batchHasCommands_{ false };
+		bool gpuMipGeneration_{ false };
 	};
 
 
@@ -602,6 +726,7 @@ export namespace rendern
 	{
 	public:
 		explicit DX12TextureUploader(rhi::IRHIDevice&) {}
+		void SetGpuMipGeneration(bool) noexcept {}
 		std::optional<GPUTexture> CreateAndUpload(const TextureCPUData&, const TextureProperties&) override { return std::nullopt; }
 		void Destroy(GPUTexture) noexcept override {}
 	};
@@ -74,10 +74,13 @@
             if (SUCCEEDED(NativeDevice()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &opt, sizeof(opt))))
             {
                 supportsVPAndRTArrayIndexFromAnyShader_ = ReadVPAndRTArrayIndexSupport(opt);
+                // GenerateMips reads RGBA8 mips back through typed UAVs.
+                supportsTypedUAVLoadAdditionalFormats_ = opt.TypedUAVLoadAdditionalFormats ? true : false;
             }
             else
             {
                 supportsVPAndRTArrayIndexFromAnyShader_ = false;
+                supportsTypedUAVLoadAdditionalFormats_ = false;
             }
 
             supportsViewInstancing_ = (device2_ != nullptr) && (viewInstancingTier_ != D3D12_VIEW_INSTANCING_TIER_NOT_SUPPORTED);
@@ -94,8 +97,17 @@
 #if CORE_DX12_HAS_DXC
             // We only claim SM6.1 support if both hardware and dxcompiler.dll are available.
             supportsSM6_1_ = (highestShaderModel_ >= D3D_SHADER_MODEL_6_1) && EnsureDXC_();
+
+            // Mesh shaders: SM6.5 plus a MeshShaderTier; their PSOs go through the pipeline state stream (ID3D12Device2).
+            D3D12_FEATURE_DATA_D3D12_OPTIONS7 options7{};
+            supportsMeshShaders_ = supportsSM6_1_
+                && (device2_ != nullptr)
+                && (highestShaderModel_ >= D3D_SHADER_MODEL_6_5)
+                && SUCCEEDED(NativeDevice()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &options7, sizeof(options7)))
+                && (options7.MeshShaderTier != D3D12_MESH_SHADER_TIER_NOT_SUPPORTED);
 #else
             supportsSM6_1_ = false;
+            supportsMeshShaders_ = false;
 #endif
         }
 
@@ -168,11 +180,20 @@
             std::string_view entryPoint,
             [[maybe_unused]] std::string_view debugName,
             ComPtr<ID3DBlob>& outCode,
-            std::string* outErrors) noexcept
+            std::string* outErrors,
+            IDxcCompiler3* compiler = nullptr,
+            IDxcIncludeHandler* includeHandler = nullptr) noexcept
         {
+            profiling::ScopedZone zone{ "DXC::Compile" };
             outCode.Reset();
 
-            if (!dxcUtils_ || !dxcCompiler_)
+            // Null means the device's shared instances (render thread only).
+            if (!compiler)
+            {
+                compiler = dxcCompiler_.Get();
+                includeHandler = dxcIncludeHandler_.Get();
+            }
+            if (!dxcUtils_ || !compiler)
             {
                 return false;
             }
@@ -200,11 +221,11 @@
             buffer.Encoding = DXC_CP_UTF8;
 
             ComPtr<IDxcResult> result;
-            HRESULT hr = dxcCompiler_->Compile(
+            HRESULT hr = compiler->Compile(
                 &buffer,
                 args.data(),
                 static_cast<uint32_t>(args.size()),
-                dxcIncludeHandler_.Get(),
+                includeHandler,
                 IID_PPV_ARGS(&result));
 
             if (FAILED(hr) || !result)
@@ -199,28 +199,37 @@
             NativeDevice()->CreateDepthStencilView(res, &viewDesc, handle);
             return handle;
         }
-        UINT AllocateSrvIndex()
+        // `staticRange`: renderer-owned views (render targets, depth, structured buffers), kept apart from
+        // streamed texture descriptors.
+        UINT AllocateSrvIndex(bool staticRange = false)
         {
-            UINT idx = 0;
-
-            if (!freeSrv_.empty())
-            {
-                idx = freeSrv_.back();
-                freeSrv_.pop_back();
-            }
-            else
-            {
-                idx = nextSrvIndex_++;
-            }
-
-            if (idx >= kSrvHeapNumDescriptors)
+            const std::uint32_t idx = staticRange ? srvSlots_.AllocateStatic() : srvSlots_.Allocate();
+            if (idx == DescriptorSlotAllocator::kInvalidSlot || idx >= kSrvHeapNumDescriptors)
             {
                 throw std::runtime_error("DX12: SRV heap exhausted (increase SRV heap NumDescriptors).");
             }
-
+            ++deviceCounters_.descriptorAllocations;
             return idx;
         }
 
+        // The slot is reused only after the GPU has finished every frame that may still read it (BeginFrame).
+        void FreeSrvIndex(UINT idx) noexcept
+        {
+            srvSlots_.Free(idx, hasSubmitted_ ? submitIndex_ : 0);
+        }
+
+        void ReclaimSrvIndices(std::uint64_t completedFrame)
+        {
+            // Reclaimed slots get the null view so nothing can sample a released resource through a stale index.
+            const D3D12_CPU_DESCRIPTOR_HANDLE nullSrv = srvHeap_->GetCPUDescriptorHandleForHeapStart(); // slot 0
+            srvSlots_.Reclaim(completedFrame, [&](std::uint32_t idx)
+                {
+                    D3D12_CPU_DESCRIPTOR_HANDLE dst = nullSrv;
+                    dst.ptr += static_cast<SIZE_T>(idx) * srvInc_;
+                    NativeDevice()->CopyDescriptorsSimple(1, dst, nullSrv, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                });
+        }
+
         void AllocateStructuredBufferSRV(BufferEntry& entry)
         {
             if (entry.hasSRV)
@@ -241,7 +250,7 @@
                 throw std::runtime_error("DX12: StructuredBuffer SRV requested but NumElements == 0");
             }
 
-            const UINT idx = AllocateSrvIndex();
+            const UINT idx = AllocateSrvIndex(true);
 
             D3D12_CPU_DESCRIPTOR_HANDLE cpu = srvHeap_->GetCPUDescriptorHandleForHeapStart();
             cpu.ptr += static_cast<SIZE_T>(idx) * srvInc_;
@@ -266,14 +275,14 @@
             entry.srvGpu = gpu;
         }
 
-        void AllocateSRV(TextureEntry& entry, DXGI_FORMAT fmt, UINT mipLevels)
+        void AllocateSRV(TextureEntry& entry, DXGI_FORMAT fmt, UINT mipLevels, bool staticRange = false)
         {
             if (entry.hasSRV)
             {
                 return;
             }
 
-            const UINT idx = AllocateSrvIndex();
+            const UINT idx = AllocateSrvIndex(staticRange);
 
             D3D12_CPU_DESCRIPTOR_HANDLE cpu = srvHeap_->GetCPUDescriptorHandleForHeapStart();
             cpu.ptr += static_cast<SIZE_T>(idx) * srvInc_;
@@ -307,6 +316,7 @@
             entry.srvIndex = idx;
             entry.srvCpu = cpu;
             entry.srvGpu = gpu;
+            entry.mipLevels = mipLevels;
         }
 
         void AllocateSRV_CubeAsArray(TextureEntry& entry, DXGI_FORMAT fmt, UINT mipLevels)
@@ -317,7 +327,7 @@
             if (entry.type != TextureEntry::Type::Cube)
                 throw std::runtime_error("DX12: AllocateSRV_CubeAsArray: texture is not a cube");
 
-            const UINT idx = AllocateSrvIndex();
+            const UINT idx = AllocateSrvIndex(true);
 
             D3D12_CPU_DESCRIPTOR_HANDLE cpu = srvHeap_->GetCPUDescriptorHandleForHeapStart();
             cpu.ptr += static_cast<SIZE_T>(idx) * srvInc_;
@@ -344,3 +354,28 @@
             entry.srvCpuArray = cpu;
             entry.srvGpuArray = gpu;
         }
+
+        // Charges the committed resource of a buffer/texture entry to a memory tag; UnchargeGpuMemory undoes it.
+        template <typename Entry>
+        void ChargeGpuMemory(Entry& entry, memory::MemoryTag tag)
+        {
+            if (!entry.resource)
+            {
+                return;
+            }
+
+            const D3D12_RESOURCE_DESC desc = entry.resource->GetDesc();
+            entry.memoryTag = tag;
+            entry.gpuBytes = NativeDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+            memory::TrackGpuAlloc(entry.memoryTag, entry.gpuBytes);
+        }
+
+        template <typename Entry>
+        void UnchargeGpuMemory(Entry& entry) noexcept
+        {
+            if (entry.gpuBytes != 0)
+            {
+                memory::TrackGpuFree(entry.memoryTag, entry.gpuBytes);
+                entry.gpuBytes = 0;
+            }
+        }
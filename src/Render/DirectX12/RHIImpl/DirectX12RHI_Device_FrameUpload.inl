@@ -1,11 +1,16 @@
         void WaitForFence(UINT64 v)
         {
-            if (v == 0)
+            WaitForFenceValue(fence_.Get(), v);
+        }
+
+        void WaitForFenceValue(ID3D12Fence* fence, UINT64 v)
+        {
+            if (v == 0 || !fence)
                 return;
 
-            if (fence_->GetCompletedValue() < v)
+            if (fence->GetCompletedValue() < v)
             {
-                ThrowIfFailed(fence_->SetEventOnCompletion(v, fenceEvent_), "DX12: SetEventOnCompletion failed");
+                ThrowIfFailed(fence->SetEventOnCompletion(v, fenceEvent_), "DX12: SetEventOnCompletion failed");
                 WaitForSingleObject(fenceEvent_, INFINITE);
             }
         }
@@ -38,20 +43,97 @@
             currentState = desired;
         }
 
-        void ImmediateUploadBuffer(BufferEntry& dst, std::span<const std::byte> data, std::size_t dstOffsetBytes)
+        void CreateStagingRing()
         {
-            if (!dst.resource || data.empty())
+            D3D12_HEAP_PROPERTIES heapProps{};
+            heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+            const auto desc = CD3DX12_RESOURCE_DESC::Buffer(kStagingRingBytes);
+
+            ThrowIfFailed(NativeDevice()->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &desc,
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                nullptr,
+                IID_PPV_ARGS(&staging_.resource)),
+                "DX12: Create staging ring failed");
+
+            void* mapped = nullptr;
+            ThrowIfFailed(staging_.resource->Map(0, nullptr, &mapped), "DX12: Map staging ring failed");
+            staging_.mapped = reinterpret_cast<std::byte*>(mapped);
+            staging_.capacity = kStagingRingBytes;
+        }
+
+        void CreateCopyQueue()
+        {
+            D3D12_COMMAND_QUEUE_DESC desc{};
+            desc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+            desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+            desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+            if (FAILED(NativeDevice()->CreateCommandQueue(&desc, IID_PPV_ARGS(&copyQueue_))) ||
+                FAILED(NativeDevice()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&copyFence_))))
+            {
+                copyQueue_.Reset();
+                copyFence_.Reset();
                 return;
+            }
 
-            // Temp upload resource
-            ComPtr<ID3D12Resource> upload;
+            copyQueue_->SetName(L"DX12 streaming copy queue");
+        }
+
+        void CreateComputeQueue()
+        {
+            D3D12_COMMAND_QUEUE_DESC desc{};
+            desc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+            desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+            desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+            bool ok = SUCCEEDED(NativeDevice()->CreateCommandQueue(&desc, IID_PPV_ARGS(&computeQueue_))) &&
+                SUCCEEDED(NativeDevice()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&computeFence_)));
+            for (FrameResource& fr : frames_)
+            {
+                ok = ok && SUCCEEDED(NativeDevice()->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COMPUTE, IID_PPV_ARGS(&fr.computeCmdAlloc)));
+            }
+            ok = ok && SUCCEEDED(NativeDevice()->CreateCommandList(
+                0,
+                D3D12_COMMAND_LIST_TYPE_COMPUTE,
+                frames_[0].computeCmdAlloc.Get(),
+                nullptr,
+                IID_PPV_ARGS(&computeCmdList_)));
+            if (!ok)
+            {
+                computeQueue_.Reset();
+                computeFence_.Reset();
+                computeCmdList_.Reset();
+                for (FrameResource& fr : frames_)
+                {
+                    fr.computeCmdAlloc.Reset();
+                }
+                return;
+            }
+
+            computeCmdList_->Close();
+            computeQueue_->SetName(L"DX12 async compute queue");
+        }
+
+        void CreateTimestampQueries()
+        {
+            if (FAILED(NativeQueue()->GetTimestampFrequency(&timestampFrequency_)) || timestampFrequency_ == 0)
+            {
+                return;
+            }
+
+            D3D12_QUERY_HEAP_DESC heapDesc{};
+            heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+            heapDesc.Count = kFramesInFlight * kTimestampQueriesPerFrame;
 
             D3D12_HEAP_PROPERTIES heapProps{};
-            heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+            heapProps.Type = D3D12_HEAP_TYPE_READBACK;
 
             D3D12_RESOURCE_DESC resourceDesc{};
             resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-            resourceDesc.Width = std::max<UINT64>(1, static_cast<UINT64>(data.size()));
+            resourceDesc.Width = static_cast<UINT64>(heapDesc.Count) * sizeof(UINT64);
             resourceDesc.Height = 1;
             resourceDesc.DepthOrArraySize = 1;
             resourceDesc.MipLevels = 1;
@@ -59,63 +141,280 @@
             resourceDesc.SampleDesc.Count = 1;
             resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 
+            if (FAILED(NativeDevice()->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&timestampHeap_))) ||
+                FAILED(NativeDevice()->CreateCommittedResource(
+                    &heapProps,
+                    D3D12_HEAP_FLAG_NONE,
+                    &resourceDesc,
+                    D3D12_RESOURCE_STATE_COPY_DEST,
+                    nullptr,
+                    IID_PPV_ARGS(&timestampReadback_))))
+            {
+                timestampHeap_.Reset();
+                timestampReadback_.Reset();
+                return;
+            }
+            timestampReadback_->SetName(L"DX12 timestamp readback");
+        }
+
+        // The frame that last used `fr` has completed: turn its resolved timestamps into zones.
+        void ReadTimestampZones(const FrameResource& fr)
+        {
+            if (!timestampReadback_ || fr.timestampZones.empty())
+            {
+                return;
+            }
+
+            const UINT base = activeFrameIndex_ * kTimestampQueriesPerFrame;
+            const D3D12_RANGE readRange{
+                static_cast<SIZE_T>(base) * sizeof(UINT64),
+                static_cast<SIZE_T>(base + fr.timestampQueries) * sizeof(UINT64) };
+            void* mapped = nullptr;
+            if (FAILED(timestampReadback_->Map(0, &readRange, &mapped)))
+            {
+                return;
+            }
+            const UINT64* ticks = static_cast<const UINT64*>(mapped) + base;
+
+            UINT64 origin = ticks[fr.timestampZones.front().beginQuery];
+            for (const TimestampZoneRecord& zone : fr.timestampZones)
+            {
+                origin = std::min(origin, ticks[zone.beginQuery]);
+            }
+            const double msPerTick = 1000.0 / static_cast<double>(timestampFrequency_);
+
+            lastGpuZones_.clear();
+            lastGpuZones_.reserve(fr.timestampZones.size());
+            for (const TimestampZoneRecord& zone : fr.timestampZones)
+            {
+                GpuTimestampZone& out = lastGpuZones_.emplace_back();
+                out.name = zone.name;
+                out.beginMs = static_cast<double>(ticks[zone.beginQuery] - origin) * msPerTick;
+                out.endMs = static_cast<double>(std::max(ticks[zone.endQuery], ticks[zone.beginQuery]) - origin) * msPerTick;
+                out.depth = zone.depth;
+            }
+
+            const D3D12_RANGE noWrite{ 0, 0 };
+            timestampReadback_->Unmap(0, &noWrite);
+        }
+
+        // Every Signal closes the current staging block: all copies that read it have been
+        // submitted by then. Frame copies (EndFrame), direct out-of-frame copies and copy-queue
+        // batches are recorded one after another on the device thread and never interleave.
+        UINT64 SignalQueue(const char* what)
+        {
+            const UINT64 v = ++fenceValue_;
+            ThrowIfFailed(NativeQueue()->Signal(fence_.Get(), v), what);
+            staging_.Retire(fence_.Get(), v);
+            return v;
+        }
+
+        UINT64 SignalCopyQueue()
+        {
+            const UINT64 v = ++copyFenceValue_;
+            ThrowIfFailed(copyQueue_->Signal(copyFence_.Get(), v), "DX12: copy queue Signal failed");
+            staging_.Retire(copyFence_.Get(), v);
+            return v;
+        }
+
+        ID3D12Fence* FenceFor(const UploadContext& ctx) const noexcept
+        {
+            return (ctx.type == D3D12_COMMAND_LIST_TYPE_COPY) ? copyFence_.Get() : fence_.Get();
+        }
+
+        StagingAllocation AllocateStagingInternal(UINT64 size, UINT64 alignment)
+        {
+            size = std::max<UINT64>(size, 1);
+
+            if (size + alignment <= staging_.capacity)
+            {
+                for (;;)
+                {
+                    staging_.Reclaim();
+                    if (const std::optional<UINT64> offset = staging_.TryAllocate(size, alignment))
+                    {
+                        return StagingAllocation{ staging_.resource.Get(), *offset, staging_.mapped + *offset };
+                    }
+
+                    // Only blocks when the GPU is a whole ring behind the CPU.
+                    if (staging_.inFlight.empty())
+                    {
+                        break;
+                    }
+                    WaitForFenceValue(staging_.inFlight.front().fence, staging_.inFlight.front().fenceValue);
+                }
+            }
+
+            // Larger than the ring (or the current unsubmitted block already fills it).
+            D3D12_HEAP_PROPERTIES heapProps{};
+            heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+            const auto desc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+            ComPtr<ID3D12Resource> dedicated;
             ThrowIfFailed(NativeDevice()->CreateCommittedResource(
                 &heapProps,
                 D3D12_HEAP_FLAG_NONE,
-                &resourceDesc,
+                &desc,
                 D3D12_RESOURCE_STATE_GENERIC_READ,
                 nullptr,
-                IID_PPV_ARGS(&upload)),
-                "DX12: ImmediateUploadBuffer - Create upload resource failed");
+                IID_PPV_ARGS(&dedicated)),
+                "DX12: Create dedicated staging buffer failed");
 
             void* mapped = nullptr;
-            ThrowIfFailed(upload->Map(0, nullptr, &mapped), "DX12: ImmediateUploadBuffer - Map upload failed");
-            std::memcpy(mapped, data.data(), data.size());
-            upload->Unmap(0, nullptr);
-
-            // Record tiny copy list
-            ComPtr<ID3D12CommandAllocator> alloc;
-            ThrowIfFailed(NativeDevice()->CreateCommandAllocator(
-                D3D12_COMMAND_LIST_TYPE_DIRECT,
-                IID_PPV_ARGS(&alloc)),
-                "DX12: ImmediateUploadBuffer - CreateCommandAllocator failed");
-
-            ComPtr<ID3D12GraphicsCommandList> cl;
-            ThrowIfFailed(NativeDevice()->CreateCommandList(
-                0,
-                D3D12_COMMAND_LIST_TYPE_DIRECT,
-                alloc.Get(),
-                nullptr,
-                IID_PPV_ARGS(&cl)),
-                "DX12: ImmediateUploadBuffer - CreateCommandList failed");
-
-            TransitionResource(
-                cl.Get(),
-                dst.resource.Get(),
-                dst.state,
-                D3D12_RESOURCE_STATE_COPY_DEST);
-
-            cl->CopyBufferRegion(
-                dst.resource.Get(),
-                static_cast<UINT64>(dstOffsetBytes),
-                upload.Get(),
-                0,
-                static_cast<UINT64>(data.size()));
+            ThrowIfFailed(dedicated->Map(0, nullptr, &mapped), "DX12: Map dedicated staging buffer failed");
 
-            TransitionResource(
-                cl.Get(),
-                dst.resource.Get(),
-                dst.state,
-                D3D12_RESOURCE_STATE_GENERIC_READ);
+            StagingAllocation out{ dedicated.Get(), 0, reinterpret_cast<std::byte*>(mapped) };
+            staging_.pendingDedicated.push_back(std::move(dedicated));
+            return out;
+        }
 
-            ThrowIfFailed(cl->Close(), "DX12: ImmediateUploadBuffer - Close failed");
+        ID3D12GraphicsCommandList* BeginUploadContext(UploadContext& ctx)
+        {
+            if (ctx.depth++ > 0)
+            {
+                return ctx.list.Get();
+            }
 
-            ID3D12CommandList* lists[] = { cl.Get() };
-            NativeQueue()->ExecuteCommandLists(1, lists);
+            // See SignalQueue: one out-of-frame context open at a time.
+            assert((&ctx == &directUpload_ ? copyUpload_.depth : directUpload_.depth) == 0);
 
-            const UINT64 v = ++fenceValue_;
-            ThrowIfFailed(NativeQueue()->Signal(fence_.Get(), v), "DX12: ImmediateUploadBuffer - Signal failed");
-            WaitForFence(v);
+            try
+            {
+                const UINT64 completed = FenceFor(ctx)->GetCompletedValue();
+
+                std::size_t index = ctx.allocators.size();
+                for (std::size_t i = 0; i < ctx.allocators.size(); ++i)
+                {
+                    if (ctx.allocators[i].fenceValue <= completed)
+                    {
+                        index = i;
+                        break;
+                    }
+                }
+
+                if (index == ctx.allocators.size())
+                {
+                    UploadAllocator fresh{};
+                    ThrowIfFailed(NativeDevice()->CreateCommandAllocator(
+                        ctx.type,
+                        IID_PPV_ARGS(&fresh.alloc)),
+                        "DX12: Create upload command allocator failed");
+                    ctx.allocators.push_back(std::move(fresh));
+                }
+                else
+                {
+                    ThrowIfFailed(ctx.allocators[index].alloc->Reset(), "DX12: upload allocator reset failed");
+                }
+
+                ID3D12CommandAllocator* alloc = ctx.allocators[index].alloc.Get();
+                if (!ctx.list)
+                {
+                    ThrowIfFailed(NativeDevice()->CreateCommandList(
+                        0,
+                        ctx.type,
+                        alloc,
+                        nullptr,
+                        IID_PPV_ARGS(&ctx.list)),
+                        "DX12: Create upload command list failed");
+                }
+                else
+                {
+                    ThrowIfFailed(ctx.list->Reset(alloc, nullptr), "DX12: upload command list reset failed");
+                }
+
+                ctx.allocatorIndex = index;
+                return ctx.list.Get();
+            }
+            catch (...)
+            {
+                ctx.depth = 0;
+                throw;
+            }
+        }
+
+        // Closes and executes the context's list. Does not wait: direct-queue work is ordered by
+        // the queue itself, copy-queue work is tracked by the returned copy fence value.
+        UINT64 SubmitUploadContext(UploadContext& ctx)
+        {
+            if (ctx.depth == 0)
+            {
+                return 0;
+            }
+            if (--ctx.depth > 0)
+            {
+                return 0;
+            }
+
+            ThrowIfFailed(ctx.list->Close(), "DX12: upload command list close failed");
+
+            ID3D12CommandList* lists[] = { ctx.list.Get() };
+            UINT64 v = 0;
+            if (ctx.type == D3D12_COMMAND_LIST_TYPE_COPY)
+            {
+                copyQueue_->ExecuteCommandLists(1, lists);
+                v = SignalCopyQueue();
+            }
+            else
+            {
+                NativeQueue()->ExecuteCommandLists(1, lists);
+                v = SignalQueue("DX12: upload Signal failed");
+            }
+
+            ctx.allocators[ctx.allocatorIndex].fenceValue = v;
+            return v;
+        }
+
+        void AbortUploadContext(UploadContext& ctx) noexcept
+        {
+            if (ctx.depth == 0)
+            {
+                return;
+            }
+
+            ctx.depth = 0;
+            if (ctx.list)
+            {
+                ctx.list->Close();
+            }
+        }
+
+        void ImmediateUploadBuffer(BufferEntry& dst, std::span<const std::byte> data, std::size_t dstOffsetBytes)
+        {
+            if (!dst.resource || data.empty())
+                return;
+
+            const StagingAllocation src = AllocateStagingInternal(static_cast<UINT64>(data.size()), 16);
+            std::memcpy(src.cpu, data.data(), data.size());
+
+            ID3D12GraphicsCommandList* cl = BeginUploadContext(directUpload_);
+            try
+            {
+                TransitionResource(
+                    cl,
+                    dst.resource.Get(),
+                    dst.state,
+                    D3D12_RESOURCE_STATE_COPY_DEST);
+
+                cl->CopyBufferRegion(
+                    dst.resource.Get(),
+                    static_cast<UINT64>(dstOffsetBytes),
+                    src.resource,
+                    src.offset,
+                    static_cast<UINT64>(data.size()));
+
+                TransitionResource(
+                    cl,
+                    dst.resource.Get(),
+                    dst.state,
+                    D3D12_RESOURCE_STATE_GENERIC_READ);
+
+                SubmitUploadContext(directUpload_);
+            }
+            catch (...)
+            {
+                AbortUploadContext(directUpload_);
+                throw;
+            }
         }
 
         void FlushPendingBufferUpdates()
@@ -123,8 +422,6 @@
             if (pendingBufferUpdates_.empty())
                 return;
 
-            FrameResource& fr = CurrentFrame();
-
             for (const PendingBufferUpdate& u : pendingBufferUpdates_)
             {
                 auto it = buffers_.find(u.buffer.id);
@@ -133,15 +430,8 @@
                 BufferEntry& dst = it->second;
                 if (!dst.resource || u.data.empty()) continue;
 
-                const std::uint32_t size = static_cast<std::uint32_t>(u.data.size());
-                const std::uint32_t aligned = AlignUp(size, 16u);
-
-                if (fr.bufCursor + aligned > kPerFrameBufUploadBytes)
-                {
-                    throw std::runtime_error("DX12: per-frame buffer upload ring overflow (increase kPerFrameBufUploadBytes)");
-                }
-
-                std::memcpy(fr.bufMapped + fr.bufCursor, u.data.data(), size);
+                const StagingAllocation src = AllocateStagingInternal(static_cast<UINT64>(u.data.size()), 16);
+                std::memcpy(src.cpu, u.data.data(), u.data.size());
 
                 TransitionResource(
                     cmdList_.Get(),
@@ -152,17 +442,15 @@
                 cmdList_->CopyBufferRegion(
                     dst.resource.Get(),
                     static_cast<UINT64>(u.dstOffsetBytes),
-                    fr.bufUpload.Get(),
-                    static_cast<UINT64>(fr.bufCursor),
-                    static_cast<UINT64>(size));
+                    src.resource,
+                    src.offset,
+                    static_cast<UINT64>(u.data.size()));
 
                 TransitionResource(
                     cmdList_.Get(),
                     dst.resource.Get(),
                     dst.state,
                     D3D12_RESOURCE_STATE_GENERIC_READ);
-
-                fr.bufCursor += aligned;
             }
 
             pendingBufferUpdates_.clear();
@@ -182,10 +470,21 @@
 
             // Wait until GPU is done with this frame resource, then recycle deferred objects/indices.
             WaitForFence(fr.fenceValue);
-            fr.ReleaseDeferred(freeSrv_, freeRTV_, freeDSV_);
+            ReadTimestampZones(fr);
+            fr.ReleaseDeferred(freeRTV_, freeDSV_);
+            if (submitIndex_ > kFramesInFlight)
+            {
+                // Frames up to submitIndex_ - kFramesInFlight (this slot's previous use) have completed.
+                ReclaimSrvIndices(submitIndex_ - kFramesInFlight);
+            }
 
             ThrowIfFailed(fr.cmdAlloc->Reset(), "DX12: cmdAlloc reset failed");
             ThrowIfFailed(cmdList_->Reset(fr.cmdAlloc.Get(), nullptr), "DX12: cmdList reset failed");
+            // The direct queue joins every compute segment before the frame fence, so it is idle too.
+            if (fr.computeCmdAlloc)
+            {
+                ThrowIfFailed(fr.computeCmdAlloc->Reset(), "DX12: compute cmdAlloc reset failed");
+            }
 
             fr.ResetForRecording();
         }
@@ -197,14 +496,22 @@
             ID3D12CommandList* lists[] = { cmdList_.Get() };
             NativeQueue()->ExecuteCommandLists(1, lists);
 
-            const UINT64 v = ++fenceValue_;
-            ThrowIfFailed(NativeQueue()->Signal(fence_.Get(), v), "DX12: Signal failed");
+            const UINT64 v = SignalQueue("DX12: Signal failed");
             frames_[activeFrameIndex_].fenceValue = v;
         }
 
         void FlushGPU()
         {
-            const UINT64 v = ++fenceValue_;
-            ThrowIfFailed(NativeQueue()->Signal(fence_.Get(), v), "DX12: Signal failed");
+            if (copyQueue_)
+            {
+                WaitForFenceValue(copyFence_.Get(), SignalCopyQueue());
+            }
+            if (computeQueue_)
+            {
+                WaitForFenceValue(computeFence_.Get(), computeFenceValue_);
+            }
+
+            const UINT64 v = SignalQueue("DX12: Signal failed");
             WaitForFence(v);
+            staging_.Reclaim();
         }
@@ -0,0 +1,256 @@
+        // ---------------- GenerateMips (compute) ----------------
+        // CS_GenerateMips (shaders/GenerateMips_dx12.hlsl) builds up to 12 levels per dispatch.
+        // Root signature layout:
+        //  [0]      8 root constants (b0)
+        //  [1..13]  UAV(u0..u12) - 1-descriptor tables: relative mips 0..12 of the pass
+        //  [14]     UAV(u13) - root UAV: per-slice group counters
+        static constexpr UINT kMipGenMaxLevelsPerPass = 12;
+        static constexpr UINT kMipGenTileTexels = 64;           // source texels per group side
+        static constexpr UINT kMipGenMaxHandOffTexels = 4096;   // larger sources can't hand mip 6 to one group
+        static constexpr UINT kMipGenMaxSlices = 6;
+
+        // RGBA8 only: the UAVs are typed unorm float4 (sRGB data is converted by the shader).
+        static DXGI_FORMAT MipGenUAVFormat_(DXGI_FORMAT resourceFormat) noexcept
+        {
+            switch (resourceFormat)
+            {
+            case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+            case DXGI_FORMAT_R8G8B8A8_UNORM:
+                return DXGI_FORMAT_R8G8B8A8_UNORM;
+            default:
+                return DXGI_FORMAT_UNKNOWN;
+            }
+        }
+
+        void EnsureMipGenPipeline_()
+        {
+            if (mipGenPso_)
+            {
+                return;
+            }
+
+            static constexpr std::string_view kEntry = "CS_GenerateMips";
+            const std::string source = FILE_UTILS::ReadAllText(corefs::ResolveAsset("shaders\\GenerateMips_dx12.hlsl"));
+            std::string errors;
+            ComPtr<ID3DBlob> code = GetOrCompileShaderBytecode_(
+                ShaderBytecodeKey_(ShaderStage::Compute, ShaderModel::SM5_1, kEntry, source),
+                [&] { return CompileFXCShader_(ShaderStage::Compute, kEntry, source, errors); });
+            if (!code)
+            {
+                throw std::runtime_error("DX12: GenerateMips shader compile failed: " + errors);
+            }
+
+            std::array<D3D12_DESCRIPTOR_RANGE1, kMipGenMaxLevelsPerPass + 1> ranges{};
+            std::array<D3D12_ROOT_PARAMETER1, 1 + (kMipGenMaxLevelsPerPass + 1) + 1> rootParams{};
+
+            rootParams[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+            rootParams[0].Constants.ShaderRegister = 0;
+            rootParams[0].Constants.RegisterSpace = 0;
+            rootParams[0].Constants.Num32BitValues = 8;
+            rootParams[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+            for (UINT i = 0; i < static_cast<UINT>(ranges.size()); ++i)
+            {
+                // The views are written right before the dispatch and levels past the pass are never read.
+                ranges[i].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+                ranges[i].NumDescriptors = 1;
+                ranges[i].BaseShaderRegister = i;
+                ranges[i].RegisterSpace = 0;
+                ranges[i].Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE | D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE;
+                ranges[i].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+                D3D12_ROOT_PARAMETER1& p = rootParams[1 + i];
+                p.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+                p.DescriptorTable.NumDescriptorRanges = 1;
+                p.DescriptorTable.pDescriptorRanges = &ranges[i];
+                p.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+            }
+
+            D3D12_ROOT_PARAMETER1& counters = rootParams.back();
+            counters.ParameterType = D3D12_ROOT_PARAMETER_TYPE_UAV;
+            counters.Descriptor.ShaderRegister = kMipGenMaxLevelsPerPass + 1;
+            counters.Descriptor.RegisterSpace = 0;
+            counters.Descriptor.Flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE;
+            counters.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+            D3D12_VERSIONED_ROOT_SIGNATURE_DESC ver{};
+            ver.Version = D3D_ROOT_SIGNATURE_VERSION_1_1;
+            ver.Desc_1_1.NumParameters = static_cast<UINT>(rootParams.size());
+            ver.Desc_1_1.pParameters = rootParams.data();
+            ver.Desc_1_1.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+            ComPtr<ID3DBlob> serialized;
+            ComPtr<ID3DBlob> error;
+            if (FAILED(D3D12SerializeVersionedRootSignature(&ver, serialized.GetAddressOf(), error.GetAddressOf())))
+            {
+                std::string msg = "DX12: D3D12SerializeVersionedRootSignature (GenerateMips) failed";
+                if (error)
+                {
+                    msg += ": ";
+                    msg += static_cast<const char*>(error->GetBufferPointer());
+                }
+                throw std::runtime_error(msg);
+            }
+
+            ComPtr<ID3D12RootSignature> rootSig;
+            ThrowIfFailed(NativeDevice()->CreateRootSignature(
+                0,
+                serialized->GetBufferPointer(),
+                serialized->GetBufferSize(),
+                IID_PPV_ARGS(rootSig.ReleaseAndGetAddressOf())),
+                "DX12: CreateRootSignature (GenerateMips) failed");
+
+            D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineDesc{};
+            pipelineDesc.pRootSignature = rootSig.Get();
+            pipelineDesc.CS = { code->GetBufferPointer(), code->GetBufferSize() };
+            ComPtr<ID3D12PipelineState> pso;
+            ThrowIfFailed(NativeDevice()->CreateComputePipelineState(&pipelineDesc, IID_PPV_ARGS(&pso)),
+                "DX12: CreateComputePipelineState (GenerateMips) failed");
+
+            // Committed buffers start zeroed; buffers promote from COMMON to UNORDERED_ACCESS on first use.
+            D3D12_HEAP_PROPERTIES heapProps{};
+            heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+            D3D12_RESOURCE_DESC bufferDesc{};
+            bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+            bufferDesc.Width = sizeof(std::uint32_t) * kMipGenMaxSlices;
+            bufferDesc.Height = 1;
+            bufferDesc.DepthOrArraySize = 1;
+            bufferDesc.MipLevels = 1;
+            bufferDesc.SampleDesc.Count = 1;
+            bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+            bufferDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
+            ComPtr<ID3D12Resource> counterBuffer;
+            ThrowIfFailed(NativeDevice()->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &bufferDesc,
+                D3D12_RESOURCE_STATE_COMMON,
+                nullptr,
+                IID_PPV_ARGS(&counterBuffer)),
+                "DX12: Create GenerateMips counter buffer failed");
+
+            mipGenRootSig_ = std::move(rootSig);
+            mipGenCounters_ = std::move(counterBuffer);
+            mipGenPso_ = std::move(pso);
+        }
+
+        // Records the mip build of `entry` on cmdList_ and leaves it in a shader-read state. Returns the
+        // number of dispatches (0: not an RGBA8 texture with mips and UAV access). Changes the compute
+        // root signature and pipeline behind the submission's bound-state cache.
+        std::uint32_t RecordGenerateMips_(TextureEntry& entry, bool normalMap)
+        {
+            if (!entry.resource)
+            {
+                return 0;
+            }
+
+            const D3D12_RESOURCE_DESC desc = entry.resource->GetDesc();
+            const DXGI_FORMAT uavFormat = MipGenUAVFormat_(desc.Format);
+            if (desc.MipLevels < 2 || desc.DepthOrArraySize > kMipGenMaxSlices || uavFormat == DXGI_FORMAT_UNKNOWN
+                || (desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) == 0)
+            {
+                return 0;
+            }
+
+            EnsureMipGenPipeline_();
+
+            const UINT mips = desc.MipLevels;
+            const UINT slices = desc.DepthOrArraySize;
+
+            // One Texture2DArray UAV per mip. The slots are released right away: like any freed slot they
+            // are only reused once the GPU finished this frame.
+            std::array<D3D12_GPU_DESCRIPTOR_HANDLE, D3D12_REQ_MIP_LEVELS> uavs{};
+            for (UINT mip = 0; mip < mips; ++mip)
+            {
+                const UINT idx = AllocateSrvIndex();
+
+                D3D12_CPU_DESCRIPTOR_HANDLE cpu = srvHeap_->GetCPUDescriptorHandleForHeapStart();
+                cpu.ptr += static_cast<SIZE_T>(idx) * srvInc_;
+                uavs[mip] = srvHeap_->GetGPUDescriptorHandleForHeapStart();
+                uavs[mip].ptr += static_cast<UINT64>(idx) * static_cast<UINT64>(srvInc_);
+
+                D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc{};
+                uavDesc.Format = uavFormat;
+                uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
+                uavDesc.Texture2DArray.MipSlice = mip;
+                uavDesc.Texture2DArray.FirstArraySlice = 0;
+                uavDesc.Texture2DArray.ArraySize = slices;
+                uavDesc.Texture2DArray.PlaneSlice = 0;
+                NativeDevice()->CreateUnorderedAccessView(entry.resource.Get(), nullptr, &uavDesc, cpu);
+
+                FreeSrvIndex(idx);
+            }
+
+            TransitionResource(cmdList_.Get(), entry.resource.Get(), entry.state, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+            cmdList_->SetComputeRootSignature(mipGenRootSig_.Get());
+            cmdList_->SetPipelineState(mipGenPso_.Get());
+            cmdList_->SetComputeRootUnorderedAccessView(1 + kMipGenMaxLevelsPerPass + 1, mipGenCounters_->GetGPUVirtualAddress());
+
+            const std::uint32_t flags = normalMap ? 2u
+                : (entry.srvFormat == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) ? 1u
+                : 0u;
+
+            std::uint32_t dispatches = 0;
+            for (UINT srcMip = 0; srcMip + 1 < mips;)
+            {
+                const UINT srcW = std::max(1u, static_cast<UINT>(desc.Width >> srcMip));
+                const UINT srcH = std::max(1u, desc.Height >> srcMip);
+
+                UINT count = std::min(kMipGenMaxLevelsPerPass, mips - 1 - srcMip);
+                if (std::max(srcW, srcH) > kMipGenMaxHandOffTexels)
+                {
+                    count = std::min(count, 6u);
+                }
+
+                const UINT groupsX = (srcW + kMipGenTileTexels - 1) / kMipGenTileTexels;
+                const UINT groupsY = (srcH + kMipGenTileTexels - 1) / kMipGenTileTexels;
+                const std::array<std::uint32_t, 8> constants{ srcW, srcH, count, flags, groupsX * groupsY, 0u, 0u, 0u };
+                cmdList_->SetComputeRoot32BitConstants(0, static_cast<UINT>(constants.size()), constants.data(), 0);
+
+                // Levels past the pass point at its source: declared by the shader, never accessed.
+                for (UINT level = 0; level <= kMipGenMaxLevelsPerPass; ++level)
+                {
+                    cmdList_->SetComputeRootDescriptorTable(1 + level, uavs[(level <= count) ? srcMip + level : srcMip]);
+                }
+
+                cmdList_->Dispatch(groupsX, groupsY, slices);
+                ++dispatches;
+
+                // The next pass reads this one's last level.
+                D3D12_RESOURCE_BARRIER uavBarrier{};
+                uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+                uavBarrier.UAV.pResource = nullptr;
+                cmdList_->ResourceBarrier(1, &uavBarrier);
+
+                srcMip += count;
+            }
+
+            TransitionResource(cmdList_.Get(), entry.resource.Get(), entry.state,
+                D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            return dispatches;
+        }
+
+        // QueueGenerateMips requests whose copy has completed, recorded at the start of a submission.
+        // Requests for textures destroyed in the meantime are dropped.
+        std::uint32_t FlushPendingMipGenerations()
+        {
+            std::uint32_t dispatches = 0;
+            std::erase_if(pendingMipGenerations_, [&](const PendingMipGeneration& pending)
+                {
+                    auto it = textures_.find(pending.texture.id);
+                    if (it == textures_.end())
+                    {
+                        return true;
+                    }
+                    if (pending.copyFenceValue != 0 && !IsCopyFenceComplete(pending.copyFenceValue))
+                    {
+                        return false;
+                    }
+                    dispatches += RecordGenerateMips_(it->second, pending.normalMap);
+                    return true;
+                });
+            return dispatches;
+        }
@@ -0,0 +1,730 @@
+        // ---------------- Graphics PSOs: keys, building, on-disk pipeline library, warm-up ----------------
+        // Graphics PSOs are built lazily per (pipeline, layout, GraphicsState, render-target formats) the
+        // first time a draw needs them. psoCache_ is keyed by handle ids (valid for this run only); the
+        // ID3D12PipelineLibrary is keyed by the shader bytecode and state content, so it survives restarts.
+        // The warm-up list records which variants were built, by pipeline debug name, so the next session
+        // can rebuild them in the background right after the renderer has created its pipelines.
+
+        static constexpr std::uint32_t kPipelineWarmKeysMagic = 0x4B575350u; // "PSWK"
+        static constexpr std::uint32_t kPipelineWarmKeysVersion = 1u;
+        static constexpr std::size_t kMaxPipelineWarmKeys = 4096;
+
+        static std::uint64_t PackBits_(std::uint64_t packedValue, std::uint32_t& bitOffset, std::uint64_t value, std::uint32_t width)
+        {
+            const std::uint64_t mask = (width >= 64u) ? ~0ull : ((1ull << width) - 1ull);
+            packedValue |= (value & mask) << bitOffset;
+            bitOffset += width;
+            return packedValue;
+        }
+
+        static std::uint64_t PackStencilFaceState_(std::uint64_t packedValue, std::uint32_t& bitOffset, const StencilFaceState& face)
+        {
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(face.failOp), 3);
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(face.depthFailOp), 3);
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(face.passOp), 3);
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(face.compareOp), 3);
+            return packedValue;
+        }
+
+        static std::uint64_t PackGraphicsStateKey_(const GraphicsState& state)
+        {
+            std::uint64_t packedValue = 0;
+            std::uint32_t bitOffset = 0;
+
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(state.rasterizer.cullMode), 2);
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(state.rasterizer.frontFace), 1);
+            packedValue = PackBits_(packedValue, bitOffset, state.depth.testEnable ? 1u : 0u, 1);
+            packedValue = PackBits_(packedValue, bitOffset, state.depth.writeEnable ? 1u : 0u, 1);
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(state.depth.depthCompareOp), 3);
+            packedValue = PackBits_(packedValue, bitOffset, state.blend.enable ? 1u : 0u, 1);
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(state.blend.mode), 2);
+            packedValue = PackBits_(packedValue, bitOffset, state.depth.stencil.enable ? 1u : 0u, 1);
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(state.depth.stencil.readMask), 8);
+            packedValue = PackBits_(packedValue, bitOffset, static_cast<std::uint32_t>(state.depth.stencil.writeMask), 8);
+            packedValue = PackStencilFaceState_(packedValue, bitOffset, state.depth.stencil.front);
+            packedValue = PackStencilFaceState_(packedValue, bitOffset, state.depth.stencil.back);
+            return packedValue;
+        }
+
+        // FNV-1a, one byte at a time.
+        static std::uint64_t HashPsoKeyPart_(std::uint64_t hash, std::uint64_t value)
+        {
+            constexpr std::uint64_t kPrime = 1099511628211ull;
+            for (int i = 0; i < 8; ++i)
+            {
+                const std::uint8_t byte = static_cast<std::uint8_t>((value >> (i * 8)) & 0xffu);
+                hash ^= byte;
+                hash *= kPrime;
+            }
+            return hash;
+        }
+
+        static std::uint64_t HashPsoBytes_(std::uint64_t hash, const void* data, std::size_t size)
+        {
+            constexpr std::uint64_t kPrime = 1099511628211ull;
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= kPrime;
+            }
+            return hash;
+        }
+
+        static std::uint64_t HashInputLayout_(const InputLayoutEntry& layout)
+        {
+            std::uint64_t hash = 1469598103934665603ull;
+            for (const D3D12_INPUT_ELEMENT_DESC& e : layout.elems)
+            {
+                hash = HashPsoBytes_(hash, e.SemanticName, std::strlen(e.SemanticName));
+                hash = HashPsoKeyPart_(hash, e.SemanticIndex);
+                hash = HashPsoKeyPart_(hash, static_cast<std::uint64_t>(e.Format));
+                hash = HashPsoKeyPart_(hash, e.InputSlot);
+                hash = HashPsoKeyPart_(hash, e.AlignedByteOffset);
+                hash = HashPsoKeyPart_(hash, static_cast<std::uint64_t>(e.InputSlotClass));
+                hash = HashPsoKeyPart_(hash, e.InstanceDataStepRate);
+            }
+            return hash;
+        }
+
+        // PSO cache key MUST include: shaders, state, layout, and render-target formats.
+        static std::uint64_t GraphicsPsoRuntimeKey_(
+            PipelineHandle pipelineHandle,
+            InputLayoutHandle layout,
+            const GraphicsState& state,
+            UINT numRT,
+            const std::array<DXGI_FORMAT, 8>& rtvFormats,
+            DXGI_FORMAT dsvFormat)
+        {
+            std::uint64_t key = 1469598103934665603ull; // FNV-1a offset basis
+            key = HashPsoKeyPart_(key, static_cast<std::uint64_t>(pipelineHandle.id));
+            key = HashPsoKeyPart_(key, static_cast<std::uint64_t>(layout.id));
+            key = HashPsoKeyPart_(key, PackGraphicsStateKey_(state));
+            key = HashPsoKeyPart_(key, static_cast<std::uint64_t>(numRT));
+            key = HashPsoKeyPart_(key, static_cast<std::uint64_t>(dsvFormat));
+            for (const DXGI_FORMAT format : rtvFormats)
+            {
+                key = HashPsoKeyPart_(key, static_cast<std::uint64_t>(format));
+            }
+            return key;
+        }
+
+        static std::string BuildMissingShaderMessage_(const PipelineEntry& pipelineRecord, PipelineHandle pipelineHandle, UINT numRenderTargets, const char* shaderStage)
+        {
+            std::string msg = "DX12: shader handle not found (";
+            msg += shaderStage;
+            msg += ", pipeline='";
+            msg += pipelineRecord.debugName;
+            msg += "', pipe=";
+            msg += std::to_string(pipelineHandle.id);
+            msg += ", vs=";
+            msg += std::to_string(pipelineRecord.vs.id);
+            msg += ", ps=";
+            msg += std::to_string(pipelineRecord.ps.id);
+            msg += ", numRT=";
+            msg += std::to_string(numRenderTargets);
+            msg += ")";
+            return msg;
+        }
+
+        static std::wstring PipelineLibraryName_(std::uint64_t contentKey)
+        {
+            static constexpr wchar_t kHex[] = L"0123456789abcdef";
+            std::wstring name = L"pso_";
+            for (int shift = 60; shift >= 0; shift -= 4)
+            {
+                name.push_back(kHex[(contentKey >> shift) & 0xFu]);
+            }
+            return name;
+        }
+
+        // Copies everything a graphics PSO build needs out of the handle maps (render thread only).
+        GraphicsPsoBuild ResolveGraphicsPso_(
+            PipelineHandle pipelineHandle,
+            InputLayoutHandle layout,
+            const GraphicsState& state,
+            UINT numRT,
+            const std::array<DXGI_FORMAT, 8>& rtvFormats,
+            DXGI_FORMAT dsvFormat) const
+        {
+            auto pit = pipelines_.find(pipelineHandle.id);
+            if (pit == pipelines_.end())
+            {
+                throw std::runtime_error("DX12: pipeline handle not found");
+            }
+
+            GraphicsPsoBuild build{};
+            if (pit->second.ms)
+            {
+                // Mesh pipeline: the amplification/mesh shaders produce the geometry, there is no input layout.
+                auto msIt = shaders_.find(pit->second.ms.id);
+                if (msIt == shaders_.end())
+                {
+                    throw std::runtime_error(BuildMissingShaderMessage_(pit->second, pipelineHandle, numRT, "ms"));
+                }
+                build.ms = msIt->second.blob;
+                if (pit->second.as)
+                {
+                    auto asIt = shaders_.find(pit->second.as.id);
+                    if (asIt == shaders_.end())
+                    {
+                        throw std::runtime_error(BuildMissingShaderMessage_(pit->second, pipelineHandle, numRT, "as"));
+                    }
+                    build.as = asIt->second.blob;
+                }
+            }
+            else
+            {
+                auto vsIt = shaders_.find(pit->second.vs.id);
+                if (vsIt == shaders_.end())
+                {
+                    throw std::runtime_error(BuildMissingShaderMessage_(pit->second, pipelineHandle, numRT, "vs"));
+                }
+                auto layIt = layouts_.find(layout.id);
+                if (layIt == layouts_.end())
+                {
+                    throw std::runtime_error("DX12: input layout handle not found");
+                }
+
+                build.vs = vsIt->second.blob;
+                build.semanticStorage.reserve(layIt->second.elems.size());
+                build.elems = layIt->second.elems;
+                for (D3D12_INPUT_ELEMENT_DESC& e : build.elems)
+                {
+                    build.semanticStorage.emplace_back(e.SemanticName);
+                    e.SemanticName = build.semanticStorage.back().c_str();
+                }
+                build.layoutHash = HashInputLayout_(layIt->second);
+            }
+
+            // Depth-only passes (NumRenderTargets == 0) can omit a pixel shader.
+            if (numRT > 0)
+            {
+                auto psIt = shaders_.find(pit->second.ps.id);
+                if (psIt == shaders_.end())
+                {
+                    throw std::runtime_error(BuildMissingShaderMessage_(pit->second, pipelineHandle, numRT, "ps"));
+                }
+                build.ps = psIt->second.blob;
+            }
+
+            build.runtimeKey = GraphicsPsoRuntimeKey_(pipelineHandle, layout, state, numRT, rtvFormats, dsvFormat);
+            build.pipelineId = pipelineHandle.id;
+            build.debugName = pit->second.debugName;
+            build.state = state;
+            build.topologyType = pit->second.topologyType;
+            build.viewInstanceCount = pit->second.viewInstanceCount;
+            build.numRT = numRT;
+            build.rtvFormats = rtvFormats;
+            build.dsvFormat = dsvFormat;
+
+            std::uint64_t contentKey = 1469598103934665603ull;
+            for (const ComPtr<ID3DBlob>& blob : { build.vs, build.as, build.ms, build.ps })
+            {
+                if (blob)
+                {
+                    contentKey = HashPsoBytes_(contentKey, blob->GetBufferPointer(), blob->GetBufferSize());
+                }
+            }
+            contentKey = HashPsoKeyPart_(contentKey, build.layoutHash);
+            contentKey = HashPsoKeyPart_(contentKey, PackGraphicsStateKey_(state));
+            contentKey = HashPsoKeyPart_(contentKey, static_cast<std::uint64_t>(build.topologyType));
+            contentKey = HashPsoKeyPart_(contentKey, build.viewInstanceCount);
+            contentKey = HashPsoKeyPart_(contentKey, numRT);
+            contentKey = HashPsoKeyPart_(contentKey, static_cast<std::uint64_t>(dsvFormat));
+            for (const DXGI_FORMAT format : rtvFormats)
+            {
+                contentKey = HashPsoKeyPart_(contentKey, static_cast<std::uint64_t>(format));
+            }
+            build.contentKey = contentKey;
+            return build;
+        }
+
+        // Creates (or loads from the pipeline library) one graphics PSO. Touches no handle maps, so the
+        // warm-up thread runs it too. Returns null when an optional feature (view instancing, mesh shaders)
+        // is unavailable.
+        ComPtr<ID3D12PipelineState> BuildGraphicsPso_(const GraphicsPsoBuild& build)
+        {
+            const GraphicsState& state = build.state;
+
+            D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc{};
+            pipelineDesc.pRootSignature = rootSig_.Get();
+
+            if (build.vs)
+            {
+                pipelineDesc.VS = { build.vs->GetBufferPointer(), build.vs->GetBufferSize() };
+            }
+            if (build.ps)
+            {
+                pipelineDesc.PS = { build.ps->GetBufferPointer(), build.ps->GetBufferSize() };
+            }
+            else
+            {
+                pipelineDesc.PS = {};
+            }
+
+            pipelineDesc.BlendState = CD3D12_BLEND_DESC(D3D12_DEFAULT);
+            pipelineDesc.SampleMask = UINT_MAX;
+
+            // Blend
+            if (state.blend.enable)
+            {
+                D3D12_BLEND_DESC blendDesc = CD3D12_BLEND_DESC(D3D12_DEFAULT);
+                blendDesc.AlphaToCoverageEnable = FALSE;
+                blendDesc.IndependentBlendEnable = FALSE;
+
+                D3D12_RENDER_TARGET_BLEND_DESC renderTartget{};
+                renderTartget.BlendEnable = TRUE;
+                renderTartget.LogicOpEnable = FALSE;
+                renderTartget.BlendOp = D3D12_BLEND_OP_ADD;
+                renderTartget.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+                renderTartget.LogicOp = D3D12_LOGIC_OP_NOOP;
+                renderTartget.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+
+                if (state.blend.mode == BlendMode::Additive)
+                {
+                    renderTartget.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+                    renderTartget.DestBlend = D3D12_BLEND_ONE;
+                    renderTartget.SrcBlendAlpha = D3D12_BLEND_ONE;
+                    renderTartget.DestBlendAlpha = D3D12_BLEND_ONE;
+                }
+                else
+                {
+                    renderTartget.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+                    renderTartget.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+                    renderTartget.SrcBlendAlpha = D3D12_BLEND_ONE;
+                    renderTartget.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+                }
+
+                for (UINT i = 0; i < 8; ++i)
+                {
+                    blendDesc.RenderTarget[i] = renderTartget;
+                }
+
+                if (state.blend.mode == BlendMode::WeightedOit)
+                {
+                    // Accumulation: plain sum. Coverage: c' = a + c * (1 - a).
+                    blendDesc.IndependentBlendEnable = TRUE;
+                    blendDesc.RenderTarget[0].SrcBlend = D3D12_BLEND_ONE;
+                    blendDesc.RenderTarget[0].DestBlend = D3D12_BLEND_ONE;
+                    blendDesc.RenderTarget[0].SrcBlendAlpha = D3D12_BLEND_ONE;
+                    blendDesc.RenderTarget[0].DestBlendAlpha = D3D12_BLEND_ONE;
+                    blendDesc.RenderTarget[1].SrcBlend = D3D12_BLEND_ONE;
+                    blendDesc.RenderTarget[1].DestBlend = D3D12_BLEND_INV_SRC_COLOR;
+                    blendDesc.RenderTarget[1].SrcBlendAlpha = D3D12_BLEND_ONE;
+                    blendDesc.RenderTarget[1].DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+                }
+
+                pipelineDesc.BlendState = blendDesc;
+            }
+
+            // Rasterizer from current state
+            pipelineDesc.RasterizerState = CD3D12_RASTERIZER_DESC(D3D12_DEFAULT);
+            pipelineDesc.RasterizerState.CullMode = ToD3DCull(state.rasterizer.cullMode);
+            pipelineDesc.RasterizerState.FrontCounterClockwise = (state.rasterizer.frontFace == FrontFace::CounterClockwise) ? TRUE : FALSE;
+
+            // Depth / Stencil
+            pipelineDesc.DepthStencilState = CD3D12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+            pipelineDesc.DepthStencilState.DepthEnable = state.depth.testEnable ? TRUE : FALSE;
+            pipelineDesc.DepthStencilState.DepthWriteMask = state.depth.writeEnable ? D3D12_DEPTH_WRITE_MASK_ALL : D3D12_DEPTH_WRITE_MASK_ZERO;
+            pipelineDesc.DepthStencilState.DepthFunc = ToD3DCompare(state.depth.depthCompareOp);
+            pipelineDesc.DepthStencilState.StencilEnable = state.depth.stencil.enable ? TRUE : FALSE;
+            pipelineDesc.DepthStencilState.StencilReadMask = state.depth.stencil.readMask;
+            pipelineDesc.DepthStencilState.StencilWriteMask = state.depth.stencil.writeMask;
+            pipelineDesc.DepthStencilState.FrontFace.StencilFailOp = ToD3DStencilOp(state.depth.stencil.front.failOp);
+            pipelineDesc.DepthStencilState.FrontFace.StencilDepthFailOp = ToD3DStencilOp(state.depth.stencil.front.depthFailOp);
+            pipelineDesc.DepthStencilState.FrontFace.StencilPassOp = ToD3DStencilOp(state.depth.stencil.front.passOp);
+            pipelineDesc.DepthStencilState.FrontFace.StencilFunc = ToD3DCompare(state.depth.stencil.front.compareOp);
+            pipelineDesc.DepthStencilState.BackFace.StencilFailOp = ToD3DStencilOp(state.depth.stencil.back.failOp);
+            pipelineDesc.DepthStencilState.BackFace.StencilDepthFailOp = ToD3DStencilOp(state.depth.stencil.back.depthFailOp);
+            pipelineDesc.DepthStencilState.BackFace.StencilPassOp = ToD3DStencilOp(state.depth.stencil.back.passOp);
+            pipelineDesc.DepthStencilState.BackFace.StencilFunc = ToD3DCompare(state.depth.stencil.back.compareOp);
+
+            pipelineDesc.InputLayout = { build.elems.data(), static_cast<UINT>(build.elems.size()) };
+            pipelineDesc.PrimitiveTopologyType = ToD3DTopologyType(build.topologyType);
+
+            pipelineDesc.NumRenderTargets = build.numRT;
+            for (UINT i = 0; i < build.numRT; ++i)
+            {
+                pipelineDesc.RTVFormats[i] = build.rtvFormats[i];
+            }
+            pipelineDesc.DSVFormat = build.dsvFormat;
+
+            pipelineDesc.SampleDesc.Count = 1;
+
+            const std::wstring libraryName = PipelineLibraryName_(build.contentKey);
+            ComPtr<ID3D12PipelineState> pso;
+
+            // Stream subobjects (view instancing and mesh pipelines have no D3D12_GRAPHICS_PIPELINE_STATE_DESC form).
+            using SO_RootSig = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE, ID3D12RootSignature*>;
+            using SO_VS = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VS, D3D12_SHADER_BYTECODE>;
+            using SO_PS = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS, D3D12_SHADER_BYTECODE>;
+            using SO_Blend = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND, D3D12_BLEND_DESC>;
+            using SO_SampleMask = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK, UINT>;
+            using SO_Raster = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER, D3D12_RASTERIZER_DESC>;
+            using SO_Depth = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL, D3D12_DEPTH_STENCIL_DESC>;
+            using SO_Input = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_INPUT_LAYOUT, D3D12_INPUT_LAYOUT_DESC>;
+            using SO_Topo = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY, D3D12_PRIMITIVE_TOPOLOGY_TYPE>;
+            using SO_RTVFmts = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS, D3D12_RT_FORMAT_ARRAY>;
+            using SO_DSVFmt = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT, DXGI_FORMAT>;
+            using SO_SampleDesc = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC, DXGI_SAMPLE_DESC>;
+            using SO_ViewInst = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VIEW_INSTANCING, D3D12_VIEW_INSTANCING_DESC>;
+            using SO_AS = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS, D3D12_SHADER_BYTECODE>;
+            using SO_MS = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS, D3D12_SHADER_BYTECODE>;
+
+            // Each stream subobject must be pointer-aligned, and its size should be a multiple of sizeof(void*)
+            // so the next Type is correctly aligned in the byte stream.
+            static_assert(sizeof(SO_RootSig) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_VS) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_PS) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_Blend) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_SampleMask) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_Raster) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_Depth) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_Input) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_Topo) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_RTVFmts) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_DSVFmt) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_SampleDesc) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_ViewInst) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_AS) % sizeof(void*) == 0);
+            static_assert(sizeof(SO_MS) % sizeof(void*) == 0);
+
+            D3D12_RT_FORMAT_ARRAY rtFmts{};
+            rtFmts.NumRenderTargets = build.numRT;
+            for (UINT i = 0; i < build.numRT; ++i)
+            {
+                rtFmts.RTFormats[i] = build.rtvFormats[i];
+            }
+
+            if (build.ms)
+            {
+                if (!device2_ || !supportsMeshShaders_)
+                {
+                    // Mesh shaders are optional; the renderer keeps its vertex-shader path then.
+                    return nullptr;
+                }
+
+                // No input layout, no topology: the mesh shader declares its output primitives.
+                struct alignas(void*) MeshPSOStream
+                {
+                    SO_RootSig    rootSig;
+                    SO_AS         as;
+                    SO_MS         ms;
+                    SO_PS         ps;
+                    SO_Blend      blend;
+                    SO_SampleMask sampleMask;
+                    SO_Raster     raster;
+                    SO_Depth      depth;
+                    SO_RTVFmts    rtvFmts;
+                    SO_DSVFmt     dsvFmt;
+                    SO_SampleDesc sampleDesc;
+                } stream{};
+
+                stream.rootSig.data = rootSig_.Get();
+                if (build.as)
+                {
+                    stream.as.data = { build.as->GetBufferPointer(), build.as->GetBufferSize() };
+                }
+                stream.ms.data = { build.ms->GetBufferPointer(), build.ms->GetBufferSize() };
+                stream.ps.data = pipelineDesc.PS;
+                stream.blend.data = pipelineDesc.BlendState;
+                stream.sampleMask.data = pipelineDesc.SampleMask;
+                stream.raster.data = pipelineDesc.RasterizerState;
+                stream.depth.data = pipelineDesc.DepthStencilState;
+                stream.rtvFmts.data = rtFmts;
+                stream.dsvFmt.data = pipelineDesc.DSVFormat;
+                stream.sampleDesc.data = pipelineDesc.SampleDesc;
+
+                D3D12_PIPELINE_STATE_STREAM_DESC streamDesc{};
+                streamDesc.SizeInBytes = sizeof(stream);
+                streamDesc.pPipelineStateSubobjectStream = &stream;
+
+                if (pipelineLibrary1_)
+                {
+                    std::lock_guard lock(pipelineLibraryMutex_);
+                    pipelineLibrary1_->LoadPipeline(libraryName.c_str(), &streamDesc, IID_PPV_ARGS(&pso));
+                }
+                if (!pso)
+                {
+                    ThrowIfFailed(device2_->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&pso)),
+                        "DX12: CreatePipelineState (mesh pipeline) failed");
+                    StoreInPipelineLibrary_(libraryName, pso.Get());
+                }
+            }
+            else if (build.viewInstanceCount > 1)
+            {
+                if (!device2_)
+                {
+                    // View instancing is optional; fail softly so the renderer can fallback to 6-pass.
+                    return nullptr;
+                }
+                // Build PSO via Pipeline State Stream to enable View Instancing.
+
+                const std::uint32_t viewCount = build.viewInstanceCount;
+                std::array<D3D12_VIEW_INSTANCE_LOCATION, 8> locations{};
+                if (viewCount > locations.size())
+                {
+                    // View instancing is optional; fail softly so the renderer can fallback to 6-pass.
+                    return nullptr;
+                }
+                for (std::uint32_t i = 0; i < viewCount; ++i)
+                {
+                    locations[i].RenderTargetArrayIndex = i;
+                    locations[i].ViewportArrayIndex = 0;
+                }
+
+                D3D12_VIEW_INSTANCING_DESC viDesc{};
+                viDesc.ViewInstanceCount = viewCount;
+                viDesc.pViewInstanceLocations = locations.data();
+                viDesc.Flags = D3D12_VIEW_INSTANCING_FLAG_NONE;
+
+                struct alignas(void*) PSOStream
+                {
+                    SO_RootSig    rootSig;
+                    SO_VS         vs;
+                    SO_PS         ps;
+                    SO_Blend      blend;
+                    SO_SampleMask sampleMask;
+                    SO_Raster     raster;
+                    SO_Depth      depth;
+                    SO_Input      input;
+                    SO_Topo       topo;
+                    SO_RTVFmts    rtvFmts;
+                    SO_DSVFmt     dsvFmt;
+                    SO_SampleDesc sampleDesc;
+                    SO_ViewInst   viewInst;
+                } stream{};
+
+                stream.rootSig.data = rootSig_.Get();
+                stream.vs.data = pipelineDesc.VS;
+                stream.ps.data = pipelineDesc.PS;
+                stream.blend.data = pipelineDesc.BlendState;
+                stream.sampleMask.data = pipelineDesc.SampleMask;
+                stream.raster.data = pipelineDesc.RasterizerState;
+                stream.depth.data = pipelineDesc.DepthStencilState;
+                stream.input.data = pipelineDesc.InputLayout;
+                stream.topo.data = pipelineDesc.PrimitiveTopologyType;
+                stream.rtvFmts.data = rtFmts;
+                stream.dsvFmt.data = pipelineDesc.DSVFormat;
+                stream.sampleDesc.data = pipelineDesc.SampleDesc;
+                stream.viewInst.data = viDesc;
+
+                D3D12_PIPELINE_STATE_STREAM_DESC streamDesc{};
+                streamDesc.SizeInBytes = sizeof(stream);
+                streamDesc.pPipelineStateSubobjectStream = &stream;
+
+                if (pipelineLibrary1_)
+                {
+                    std::lock_guard lock(pipelineLibraryMutex_);
+                    pipelineLibrary1_->LoadPipeline(libraryName.c_str(), &streamDesc, IID_PPV_ARGS(&pso));
+                }
+                if (!pso)
+                {
+                    const HRESULT hr = device2_->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&pso));
+                    if (FAILED(hr))
+                    {
+                        // View instancing is optional; fail softly so the renderer can fallback to 6-pass.
+                        ThrowIfFailed(NativeDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pso)),
+                            "DX12: CreateGraphicsPipelineState failed");
+                    }
+                    else
+                    {
+                        StoreInPipelineLibrary_(libraryName, pso.Get());
+                    }
+                }
+            }
+            else
+            {
+                if (pipelineLibrary_)
+                {
+                    std::lock_guard lock(pipelineLibraryMutex_);
+                    pipelineLibrary_->LoadGraphicsPipeline(libraryName.c_str(), &pipelineDesc, IID_PPV_ARGS(&pso));
+                }
+                if (!pso)
+                {
+                    ThrowIfFailed(NativeDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pso)),
+                        "DX12: CreateGraphicsPipelineState failed");
+                    StoreInPipelineLibrary_(libraryName, pso.Get());
+                }
+            }
+
+            return pso;
+        }
+
+        void StoreInPipelineLibrary_(const std::wstring& libraryName, ID3D12PipelineState* pso)
+        {
+            if (!pipelineLibrary_ || !pso)
+            {
+                return;
+            }
+            // E_INVALIDARG when another thread stored the same content first; either copy is fine.
+            std::lock_guard lock(pipelineLibraryMutex_);
+            pipelineLibrary_->StorePipeline(libraryName.c_str(), pso);
+        }
+
+        // psoCache_ miss on the render thread: take a warmed PSO if the warm-up built it, else build now.
+        ID3D12PipelineState* GetOrBuildGraphicsPso_(const GraphicsPsoBuild& build)
+        {
+            ComPtr<ID3D12PipelineState> pso;
+            {
+                std::lock_guard lock(warmedPsoMutex_);
+                if (auto it = warmedPsos_.find(build.runtimeKey); it != warmedPsos_.end())
+                {
+                    pso = std::move(it->second);
+                    warmedPsos_.erase(it);
+                }
+            }
+            if (!pso)
+            {
+                pso = BuildGraphicsPso_(build);
+            }
+            if (!pso)
+            {
+                return nullptr;
+            }
+
+            if (usedWarmKeys_.insert(build.contentKey).second)
+            {
+                PipelineWarmKey warmKey{};
+                warmKey.pipelineName = build.debugName;
+                warmKey.layoutHash = build.layoutHash;
+                warmKey.state = build.state;
+                warmKey.numRT = build.numRT;
+                warmKey.rtvFormats = build.rtvFormats;
+                warmKey.dsvFormat = build.dsvFormat;
+                usedWarmKeysInOrder_.push_back(std::move(warmKey));
+            }
+
+            ID3D12PipelineState* raw = pso.Get();
+            psoCache_[build.runtimeKey] = std::move(pso);
+            psoKeysByPipeline_[build.pipelineId].push_back(build.runtimeKey);
+            return raw;
+        }
+
+        void JoinPipelineWarmup_() noexcept
+        {
+            if (pipelineWarmThread_.joinable())
+            {
+                pipelineWarmThread_.join();
+            }
+        }
+
+        static bool ReadPipelineCacheFile_(const std::filesystem::path& path, std::vector<std::byte>& out)
+        {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                return false;
+            }
+            const std::streamsize size = file.tellg();
+            if (size <= 0)
+            {
+                return false;
+            }
+            out.resize(static_cast<std::size_t>(size));
+            file.seekg(0);
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(out.data()), size));
+        }
+
+        // Writes next to the target and renames, so a crash mid-write never leaves a truncated cache.
+        static void WritePipelineCacheFile_(const std::filesystem::path& path, std::span<const std::byte> bytes)
+        {
+            std::filesystem::path tmp = path;
+            tmp += ".tmp";
+            {
+                std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+                if (!file)
+                {
+                    return;
+                }
+                file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+                if (!file)
+                {
+                    return;
+                }
+            }
+            std::error_code ec;
+            std::filesystem::rename(tmp, path, ec);
+        }
+
+        template <typename T>
+        static void AppendPod_(std::vector<std::byte>& out, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        static bool ReadPod_(std::span<const std::byte>& in, T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (in.size() < sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&value, in.data(), sizeof(T));
+            in = in.subspan(sizeof(T));
+            return true;
+        }
+
+        // Format: magic, version, sizeof(GraphicsState), count, then per key: name length + bytes,
+        // layout hash, GraphicsState bytes, numRT, 8 RTV formats, DSV format. Any mismatch drops the list.
+        static std::vector<PipelineWarmKey> ParsePipelineWarmKeys_(std::span<const std::byte> in)
+        {
+            std::uint32_t magic = 0;
+            std::uint32_t version = 0;
+            std::uint32_t stateBytes = 0;
+            std::uint32_t count = 0;
+            if (!ReadPod_(in, magic) || !ReadPod_(in, version) || !ReadPod_(in, stateBytes) || !ReadPod_(in, count)
+                || magic != kPipelineWarmKeysMagic || version != kPipelineWarmKeysVersion || stateBytes != sizeof(GraphicsState))
+            {
+                return {};
+            }
+
+            std::vector<PipelineWarmKey> keys;
+            keys.reserve(std::min<std::size_t>(count, kMaxPipelineWarmKeys));
+            for (std::uint32_t i = 0; i < count && keys.size() < kMaxPipelineWarmKeys; ++i)
+            {
+                PipelineWarmKey key{};
+                std::uint32_t nameLength = 0;
+                if (!ReadPod_(in, nameLength) || in.size() < nameLength)
+                {
+                    return {};
+                }
+                key.pipelineName.assign(reinterpret_cast<const char*>(in.data()), nameLength);
+                in = in.subspan(nameLength);
+
+                std::uint32_t numRT = 0;
+                if (!ReadPod_(in, key.layoutHash) || !ReadPod_(in, key.state) || !ReadPod_(in, numRT)
+                    || !ReadPod_(in, key.rtvFormats) || !ReadPod_(in, key.dsvFormat) || numRT > key.rtvFormats.size())
+                {
+                    return {};
+                }
+                key.numRT = numRT;
+                keys.push_back(std::move(key));
+            }
+            return keys;
+        }
+
+        static std::vector<std::byte> SerializePipelineWarmKeys_(std::span<const PipelineWarmKey> keys)
+        {
+            std::vector<std::byte> out;
+            AppendPod_(out, kPipelineWarmKeysMagic);
+            AppendPod_(out, kPipelineWarmKeysVersion);
+            AppendPod_(out, static_cast<std::uint32_t>(sizeof(GraphicsState)));
+            AppendPod_(out, static_cast<std::uint32_t>(keys.size()));
+            for (const PipelineWarmKey& key : keys)
+            {
+                AppendPod_(out, static_cast<std::uint32_t>(key.pipelineName.size()));
+                const auto* name = reinterpret_cast<const std::byte*>(key.pipelineName.data());
+                out.insert(out.end(), name, name + key.pipelineName.size());
+                AppendPod_(out, key.layoutHash);
+                AppendPod_(out, key.state);
+                AppendPod_(out, static_cast<std::uint32_t>(key.numRT));
+                AppendPod_(out, key.rtvFormats);
+                AppendPod_(out, key.dsvFormat);
+            }
+            return out;
+        }
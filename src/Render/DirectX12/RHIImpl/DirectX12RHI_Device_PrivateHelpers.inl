@@ -3,3 +3,6 @@
 #include "DirectX12RHI_Device_RootSignature.inl"
 #include "DirectX12RHI_Device_Descriptors.inl"
 #include "DirectX12RHI_Device_CapabilitiesAndDxc.inl"
+#include "DirectX12RHI_Device_PipelineLibrary.inl"
+#include "DirectX12RHI_Device_ShaderCache.inl"
+#include "DirectX12RHI_Device_MipGeneration.inl"
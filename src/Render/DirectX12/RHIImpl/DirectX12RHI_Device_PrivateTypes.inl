@@ -8,6 +8,13 @@
             // Track state for proper COPY_DEST transitions when uploading.
             D3D12_RESOURCE_STATES state{ D3D12_RESOURCE_STATE_COMMON };
 
+            // BufferUsageFlag::Stream: UPLOAD-heap memory mapped for the buffer's lifetime.
+            std::byte* mapped{ nullptr };
+
+            // GPU memory charged to memoryTag at creation (see ChargeGpuMemory).
+            memory::MemoryTag memoryTag{ memory::MemoryTag::Renderer };
+            std::uint64_t gpuBytes{ 0 };
+
             // Optional SRV for StructuredBuffer reads (t2 in the demo).
             bool hasSRV{ false };
             UINT srvIndex{ 0 };
@@ -42,6 +49,49 @@
             ShaderHandle ps{};
 			PrimitiveTopologyType topologyType{};
             std::uint32_t viewInstanceCount{ 1 };
+
+            // Compute pipelines (CreateComputePipeline) have no state-dependent variants,
+            // so the PSO is built up front instead of going through the graphics PSO cache.
+            ShaderHandle cs{};
+            ComPtr<ID3D12PipelineState> computePSO;
+
+            // Mesh pipelines (CreateMeshPipeline): vs is null, as is optional.
+            ShaderHandle as{};
+            ShaderHandle ms{};
+        };
+
+        // Everything one graphics PSO build needs, copied out of the handle maps so the build can run
+        // off the render thread (pipeline cache warm-up).
+        struct GraphicsPsoBuild
+        {
+            std::uint64_t runtimeKey{ 0 };   // psoCache_ key (handle ids, this run only)
+            std::uint64_t contentKey{ 0 };   // pipeline library key (bytecode + state, stable across runs)
+            std::uint64_t layoutHash{ 0 };
+            std::uint32_t pipelineId{ 0 };
+            std::string debugName;
+            ComPtr<ID3DBlob> vs;
+            ComPtr<ID3DBlob> ps;
+            ComPtr<ID3DBlob> as;
+            ComPtr<ID3DBlob> ms;             // set: mesh pipeline (no vs, no input layout)
+            std::vector<std::string> semanticStorage;
+            std::vector<D3D12_INPUT_ELEMENT_DESC> elems;
+            GraphicsState state{};
+            PrimitiveTopologyType topologyType{};
+            std::uint32_t viewInstanceCount{ 1 };
+            UINT numRT{ 0 };
+            std::array<DXGI_FORMAT, 8> rtvFormats{};
+            DXGI_FORMAT dsvFormat{ DXGI_FORMAT_UNKNOWN };
+        };
+
+        // A graphics PSO variant some session built, named by pipeline debug name and input layout content.
+        struct PipelineWarmKey
+        {
+            std::string pipelineName;
+            std::uint64_t layoutHash{ 0 };
+            GraphicsState state{};
+            UINT numRT{ 0 };
+            std::array<DXGI_FORMAT, 8> rtvFormats{};
+            DXGI_FORMAT dsvFormat{ DXGI_FORMAT_UNKNOWN };
         };
 
         struct TextureEntry
@@ -66,6 +116,13 @@
 
             D3D12_RESOURCE_STATES state{ D3D12_RESOURCE_STATE_COMMON };
 
+            // Mip levels the SRVs expose.
+            UINT mipLevels{ 1 };
+
+            // GPU memory charged to memoryTag at creation (see ChargeGpuMemory).
+            memory::MemoryTag memoryTag{ memory::MemoryTag::Renderer };
+            std::uint64_t gpuBytes{ 0 };
+
             bool hasSRV{ false };
             UINT srvIndex{ 0 };
             D3D12_CPU_DESCRIPTOR_HANDLE srvCpu{};
@@ -103,6 +160,13 @@
         };
 
 
+        struct PendingMipGeneration
+        {
+            TextureHandle texture{};
+            UINT64 copyFenceValue{ 0 }; // 0: uploaded on the direct queue
+            bool normalMap{ false };
+        };
+
         struct FramebufferEntry
         {
             static constexpr std::uint32_t kMaxColorAttachments = 8u;
@@ -119,24 +183,50 @@
 
         static constexpr std::uint32_t kFramesInFlight = 3;
         static constexpr UINT kPerFrameCBUploadBytes = 512u * 1024u;
-        static constexpr UINT kPerFrameBufUploadBytes = 8u * 1024u * 1024u; // 8 MB per frame buffer upload ring
-        static constexpr UINT kMaxSRVSlots = 20; // t0..t19 (room for PBR maps + env + bones)
+        static constexpr UINT64 kStagingRingBytes = 128ull * 1024ull * 1024ull; // shared upload ring (buffers + textures)
+        static constexpr UINT kMaxSRVSlots = 21; // t0..t20 (room for PBR maps + env + bones + light clusters)
+        static constexpr UINT kMaxComputeSRVSlots = 4; // compute t0..t3 (same slots as graphics binds)
+        static constexpr UINT kMaxUAVSlots = 4; // compute u0..u3 (root UAVs, buffers only)
         static constexpr UINT kSrvHeapNumDescriptors = 16384u; // CBV/SRV/UAV shader-visible heap size
+        // SRV heap layout (srvSlots_): 0=null tex, 1=null buffer, 2=ImGui font SRV, then the static range for
+        // render targets/depth/structured buffers, then pages for texture and bindless descriptors.
+        static constexpr UINT kSrvReservedSlots = 3u;
+        static constexpr UINT kSrvStaticSlots = 1024u;
+        static constexpr UINT kSrvPageSize = 256u;
+        static constexpr UINT kSrvMaxPages = (kSrvHeapNumDescriptors - kSrvReservedSlots - kSrvStaticSlots) / kSrvPageSize;
+        // Timestamp queries per frame resource (two per zone); zones past the budget are not timed.
+        static constexpr UINT kTimestampQueriesPerFrame = 512u;
+
+        struct TimestampZoneRecord
+        {
+            std::string name;
+            UINT beginQuery{ 0 }; // relative to the frame's range of the query heap
+            UINT endQuery{ 0 };
+            std::uint32_t depth{ 0 };
+        };
+
+        // A CommandReadbackTexture in flight: the rect lands in `buffer` (READBACK heap) with rows
+        // rowPitch bytes apart; fenceValue is the frame fence of its submission (0 while it records).
+        struct TextureReadbackRecord
+        {
+            TextureReadback result; // data filled once the fence passed
+            UINT rowPitch{ 0 };
+            UINT bytesPerTexel{ 0 };
+            ComPtr<ID3D12Resource> buffer;
+            UINT64 fenceValue{ 0 };
+        };
 
         struct FrameResource
         {
             ComPtr<ID3D12CommandAllocator> cmdAlloc;
+            // Async compute segments of the frame (null without a compute queue).
+            ComPtr<ID3D12CommandAllocator> computeCmdAlloc;
 
             // Small persistent upload buffer for per-draw constants.
             ComPtr<ID3D12Resource> cbUpload;
             std::byte* cbMapped{ nullptr };
             std::uint32_t cbCursor{ 0 };
 
-            // Per-frame upload buffer for dynamic DEFAULT buffers (lights/instances/etc).
-            ComPtr<ID3D12Resource> bufUpload;
-            std::byte* bufMapped{ nullptr };
-            std::uint32_t bufCursor{ 0 };
-
             // Fence value that marks when GPU finished using this frame resource.
             UINT64 fenceValue{ 0 };
 
@@ -144,29 +234,125 @@
             //  - keep resources alive until GPU is done with this frame
             //  - recycle descriptor indices only after the same fence is completed
             std::vector<ComPtr<ID3D12Resource>> deferredResources;
-            std::vector<UINT> deferredFreeSrv;
+            std::vector<ComPtr<ID3D12PipelineState>> deferredPipelines;
             std::vector<UINT> deferredFreeRtv;
             std::vector<UINT> deferredFreeDsv;
 
+            // Timestamp zones of the submission that used this frame resource; read back when it is recycled.
+            std::vector<TimestampZoneRecord> timestampZones;
+            UINT timestampQueries{ 0 };
+
             void ResetForRecording() noexcept
             {
                 cbCursor = 0;
-                bufCursor = 0;
+                timestampZones.clear();
+                timestampQueries = 0;
             }
 
             void ReleaseDeferred(
-                std::vector<UINT>& globalFreeSrv,
                 std::vector<UINT>& globalFreeRtv,
                 std::vector<UINT>& globalFreeDsv)
             {
                 deferredResources.clear();
+                deferredPipelines.clear();
 
-                globalFreeSrv.insert(globalFreeSrv.end(), deferredFreeSrv.begin(), deferredFreeSrv.end());
                 globalFreeRtv.insert(globalFreeRtv.end(), deferredFreeRtv.begin(), deferredFreeRtv.end());
                 globalFreeDsv.insert(globalFreeDsv.end(), deferredFreeDsv.begin(), deferredFreeDsv.end());
 
-                deferredFreeSrv.clear();
                 deferredFreeRtv.clear();
                 deferredFreeDsv.clear();
             }
         };
+
+        // Persistent, persistently mapped UPLOAD heap shared by every CPU->GPU copy (buffer
+        // updates, texture uploads). Allocation is a linear ring; everything allocated since the
+        // last Signal (direct or copy queue) is retired as one block once that fence value
+        // completes. Blocks are reclaimed strictly in order, so a slow copy block also holds back
+        // later direct blocks, which is conservative but keeps the ring contiguous. Requests
+        // larger than the whole ring get a dedicated upload buffer retired the same way.
+        struct StagingRing
+        {
+            struct Retirement
+            {
+                ID3D12Fence* fence{ nullptr };
+                UINT64 fenceValue{ 0 };
+                UINT64 bytes{ 0 };
+                std::vector<ComPtr<ID3D12Resource>> dedicated;
+            };
+
+            ComPtr<ID3D12Resource> resource;
+            std::byte* mapped{ nullptr };
+            UINT64 capacity{ 0 };
+            UINT64 head{ 0 };
+
+            // Bytes (including alignment/wrap padding) not yet retired, and the part of it
+            // allocated since the last Signal.
+            UINT64 used{ 0 };
+            UINT64 pendingBytes{ 0 };
+            std::vector<ComPtr<ID3D12Resource>> pendingDedicated;
+            std::deque<Retirement> inFlight;
+
+            std::optional<UINT64> TryAllocate(UINT64 size, UINT64 alignment) noexcept
+            {
+                UINT64 offset = (head + (alignment - 1)) & ~(alignment - 1);
+                if (offset + size > capacity)
+                {
+                    offset = 0; // wrap; the tail end of the ring is wasted until retired
+                }
+
+                const UINT64 consumed = (offset >= head) ? (offset - head + size) : (capacity - head + size);
+                if (used + consumed > capacity)
+                {
+                    return std::nullopt;
+                }
+
+                head = offset + size;
+                used += consumed;
+                pendingBytes += consumed;
+                return offset;
+            }
+
+            void Retire(ID3D12Fence* fence, UINT64 fenceValue)
+            {
+                if (pendingBytes == 0 && pendingDedicated.empty())
+                {
+                    return;
+                }
+
+                inFlight.push_back(Retirement{ fence, fenceValue, pendingBytes, std::move(pendingDedicated) });
+                pendingBytes = 0;
+                pendingDedicated.clear();
+            }
+
+            void Reclaim() noexcept
+            {
+                while (!inFlight.empty() && inFlight.front().fence->GetCompletedValue() >= inFlight.front().fenceValue)
+                {
+                    used -= inFlight.front().bytes;
+                    inFlight.pop_front();
+                }
+
+                if (used == 0)
+                {
+                    head = 0;
+                }
+            }
+        };
+
+        // Command recording for copies outside SubmitCommandList: one context on the direct
+        // queue (pre-first-frame buffer updates) and one on the copy queue (texture streaming).
+        // Allocators are pooled and reused once the fence of their last submission passed.
+        struct UploadAllocator
+        {
+            ComPtr<ID3D12CommandAllocator> alloc;
+            UINT64 fenceValue{ 0 };
+        };
+
+        struct UploadContext
+        {
+            D3D12_COMMAND_LIST_TYPE type{ D3D12_COMMAND_LIST_TYPE_DIRECT };
+            std::vector<UploadAllocator> allocators;
+            ComPtr<ID3D12GraphicsCommandList> list;
+            std::size_t allocatorIndex{ 0 };
+            std::uint32_t depth{ 0 };
+        };
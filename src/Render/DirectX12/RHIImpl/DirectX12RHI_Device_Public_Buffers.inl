@@ -7,8 +7,10 @@
             const UINT64 sz = static_cast<UINT64>(desc.sizeInBytes);
 
             // GPU-local buffer (DEFAULT heap). Updates happen via per-frame upload ring.
+            // Stream buffers (except UAV-capable ones) live in the UPLOAD heap instead and stay mapped.
+            const bool hostVisible = desc.usageFlag == BufferUsageFlag::Stream && desc.bindFlag != BufferBindFlag::StorageBuffer;
             D3D12_HEAP_PROPERTIES heapProps{};
-            heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+            heapProps.Type = hostVisible ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_DEFAULT;
 
             D3D12_RESOURCE_DESC resourceDesc{};
             resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
@@ -19,8 +21,13 @@
             resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
             resourceDesc.SampleDesc.Count = 1;
             resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+            if (desc.bindFlag == BufferBindFlag::StorageBuffer)
+            {
+                resourceDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+            }
 
-            const D3D12_RESOURCE_STATES initState = D3D12_RESOURCE_STATE_COMMON;
+            // UPLOAD-heap resources must stay in GENERIC_READ.
+            const D3D12_RESOURCE_STATES initState = hostVisible ? D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COMMON;
 
             ThrowIfFailed(NativeDevice()->CreateCommittedResource(
                 &heapProps,
@@ -33,11 +40,22 @@
 
             bufferEntry.state = initState;
 
-            if (desc.bindFlag == BufferBindFlag::StructuredBuffer)
+            if (hostVisible)
+            {
+                const D3D12_RANGE noRead{ 0, 0 };
+                void* mapped = nullptr;
+                ThrowIfFailed(bufferEntry.resource->Map(0, &noRead, &mapped), "DX12: Map Stream buffer failed");
+                bufferEntry.mapped = static_cast<std::byte*>(mapped);
+            }
+
+            if (desc.bindFlag == BufferBindFlag::StructuredBuffer ||
+                (desc.bindFlag == BufferBindFlag::StorageBuffer && desc.structuredStrideBytes != 0))
             {
                 AllocateStructuredBufferSRV(bufferEntry);
             }
 
+            ChargeGpuMemory(bufferEntry, memory::CurrentGpuMemoryTag());
+
             buffers_[handle.id] = std::move(bufferEntry);
             return handle;
         }
@@ -61,6 +79,16 @@
             if (end > entry.desc.sizeInBytes)
                 throw std::runtime_error("DX12: UpdateBuffer out of bounds");
 
+            ++deviceCounters_.bufferUpdates;
+            deviceCounters_.bufferUploadBytes += data.size();
+
+            // Mapped Stream buffer: the caller owns synchronization, write straight through.
+            if (entry.mapped)
+            {
+                std::memcpy(entry.mapped + offsetBytes, data.data(), data.size());
+                return;
+            }
+
             // If we haven't submitted anything yet, it's safe to do a blocking upload.
             if (!hasSubmitted_)
             {
@@ -75,6 +103,16 @@
             pendingBufferUpdates_.push_back(std::move(u));
         }
 
+        std::span<std::byte> MapBuffer(BufferHandle buffer) override
+        {
+            auto it = buffers_.find(buffer.id);
+            if (it == buffers_.end() || !it->second.mapped)
+            {
+                return {};
+            }
+            return { it->second.mapped, it->second.desc.sizeInBytes };
+        }
+
         void DestroyBuffer(BufferHandle buffer) noexcept override
         {
             if (buffer.id == 0)
@@ -90,6 +128,7 @@
 
             BufferEntry entry = std::move(it->second);
             buffers_.erase(it);
+            UnchargeGpuMemory(entry);
 
             // Remove pending updates for this buffer.
             if (!pendingBufferUpdates_.empty())
@@ -107,26 +146,12 @@
 
             if (entry.hasSRV && entry.srvIndex != 0)
             {
-                if (hasSubmitted_)
-                {
-                    CurrentFrame().deferredFreeSrv.push_back(entry.srvIndex);
-                }
-                else
-                {
-                    freeSrv_.push_back(entry.srvIndex);
-                }
+                FreeSrvIndex(entry.srvIndex);
             }
 
             if (entry.hasSRVArray && entry.srvIndexArray != 0)
             {
-                if (hasSubmitted_)
-                {
-                    CurrentFrame().deferredFreeSrv.push_back(entry.srvIndexArray);
-                }
-                else
-                {
-                    freeSrv_.push_back(entry.srvIndexArray);
-                }
+                FreeSrvIndex(entry.srvIndexArray);
             }
         }
 
@@ -9,6 +9,17 @@ void SubmitCommandList(CommandList&& commandList) override
     cmdList_->SetDescriptorHeaps(1, heaps);
 
     FlushPendingBufferUpdates();
+    const std::uint32_t uploadMipDispatches = FlushPendingMipGenerations();
+
+    // Async compute: while a segment is open cmdList_ is the compute list (the direct list is parked in
+    // computeCmdList_). segmentFenceValues[syncPoint] is the compute fence value of a closed segment.
+    bool onComputeQueue = false;
+    std::vector<UINT64> segmentFenceValues;
+    UINT64 joinedComputeValue = 0;
+
+    // Timestamp zones still open, as indices into CurrentFrame().timestampZones (kUntimedZone: not timed).
+    static constexpr std::size_t kUntimedZone = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> openTimestampZones;
 
     // State while parsing high-level commands
     GraphicsState curState{};
@@ -44,9 +55,21 @@ void SubmitCommandList(CommandList&& commandList) override
     std::array<std::byte, kMaxPerDrawConstantsBytes> perDrawBytes{};
     std::uint32_t perDrawSize = 0;
     std::uint32_t perDrawSlot = 0;
+    // Draws between two SetConstants with different bytes share one upload.
+    bool perDrawDirty = true;
+    D3D12_GPU_VIRTUAL_ADDRESS lastPerDrawVA = 0;
 
-    auto WriteCBAndBind = [&]()
+    SubmissionStats stats{};
+    stats.dispatches = uploadMipDispatches;
+
+    auto WriteCB = [&]() -> D3D12_GPU_VIRTUAL_ADDRESS
         {
+            if (!perDrawDirty && lastPerDrawVA != 0)
+            {
+                ++stats.constantUploadsFiltered;
+                return lastPerDrawVA;
+            }
+
             FrameResource& fr = CurrentFrame();
 
             const std::uint32_t used = (perDrawSize == 0) ? 1u : perDrawSize;
@@ -63,316 +86,465 @@ void SubmitCommandList(CommandList&& commandList) override
             }
 
             const D3D12_GPU_VIRTUAL_ADDRESS gpuVA = fr.cbUpload->GetGPUVirtualAddress() + fr.cbCursor;
-            cmdList_->SetGraphicsRootConstantBufferView(perDrawSlot, gpuVA);
-
             fr.cbCursor += cbSize;
+            perDrawDirty = false;
+            lastPerDrawVA = gpuVA;
+            return gpuVA;
         };
 
-#include "DirectX12RHI_Device_Public_CommandSubmission_TransitionAndSrvHelpers.inl"
-    UINT curNumRT = 0;
-    std::array<DXGI_FORMAT, 8> curRTVFormats{};
-    std::fill(curRTVFormats.begin(), curRTVFormats.end(), DXGI_FORMAT_UNKNOWN);
-    DXGI_FORMAT curDSVFormat = DXGI_FORMAT_UNKNOWN;
-    bool curPassIsSwapChain = false;
-    DX12SwapChain* curSwapChain = nullptr;
+    // Shadow of the native state bound on cmdList_, so draws only issue what changed since the previous
+    // one. Root parameters are keyed by index and hold a descriptor-table pointer or root view address
+    // (0 = unknown). Anything that resets or replaces cmdList_ must call InvalidateBoundState.
+    static constexpr UINT kMaxCachedRootParams = 1 + kMaxSRVSlots + 1;
+    struct BoundNativeState
+    {
+        ID3D12PipelineState* pso{ nullptr };
+        bool psoKnown{ false };
+        ID3D12RootSignature* graphicsRootSig{ nullptr };
+        ID3D12RootSignature* computeRootSig{ nullptr };
+        std::array<UINT64, kMaxCachedRootParams> graphicsRoot{};
+        std::array<UINT64, kMaxCachedRootParams> computeRoot{};
+        D3D_PRIMITIVE_TOPOLOGY topology{ D3D_PRIMITIVE_TOPOLOGY_UNDEFINED };
+        UINT numVB{ 0 };
+        std::array<D3D12_VERTEX_BUFFER_VIEW, kMaxVBSlots> vbv{};
+        bool hasIBV{ false };
+        D3D12_INDEX_BUFFER_VIEW ibv{};
+    };
+    BoundNativeState bound{};
+
+    auto InvalidateBoundState = [&]()
+        {
+            bound = BoundNativeState{};
+        };
 
-    auto TransitionTexture = [&](TextureHandle tex, D3D12_RESOURCE_STATES desired)
+    auto CountFiltered = [&](std::uint32_t& counter)
         {
-            if (!tex)
+            ++counter;
+            ++stats.stateCallsFiltered;
+        };
+
+    auto SetPipelineState = [&](ID3D12PipelineState* pso)
+        {
+            if (bound.psoKnown && bound.pso == pso)
             {
+                CountFiltered(stats.pipelineChangesFiltered);
                 return;
             }
+            cmdList_->SetPipelineState(pso);
+            bound.pso = pso;
+            bound.psoKnown = true;
+            ++stats.stateCallsIssued;
+        };
 
-            auto it = textures_.find(tex.id);
-            if (it == textures_.end())
+    // Changing the root signature invalidates every root argument of that pipeline type.
+    auto SetGraphicsRootSignature = [&](ID3D12RootSignature* rootSig)
+        {
+            if (bound.graphicsRootSig == rootSig)
             {
+                CountFiltered(stats.pipelineChangesFiltered);
                 return;
             }
+            cmdList_->SetGraphicsRootSignature(rootSig);
+            bound.graphicsRootSig = rootSig;
+            bound.graphicsRoot.fill(0);
+            ++stats.stateCallsIssued;
+        };
 
-            TransitionResource(
-                cmdList_.Get(),
-                it->second.resource.Get(),
-                it->second.state,
-                desired);
+    auto SetComputeRootSignature = [&](ID3D12RootSignature* rootSig)
+        {
+            if (bound.computeRootSig == rootSig)
+            {
+                CountFiltered(stats.pipelineChangesFiltered);
+                return;
+            }
+            cmdList_->SetComputeRootSignature(rootSig);
+            bound.computeRootSig = rootSig;
+            bound.computeRoot.fill(0);
+            ++stats.stateCallsIssued;
         };
 
-    auto TransitionBackBuffer = [&](DX12SwapChain& sc, D3D12_RESOURCE_STATES desired)
+    // Returns true when the root argument has to be issued (and records it as bound).
+    auto UpdateRootArgument = [&](std::array<UINT64, kMaxCachedRootParams>& cache, UINT param, UINT64 value) -> bool
         {
-            TransitionResource(
-                cmdList_.Get(),
-                sc.CurrentBackBuffer(),
-                sc.CurrentBackBufferState(),
-                desired);
+            if (param < cache.size() && value != 0 && cache[param] == value)
+            {
+                CountFiltered(stats.rootParamsFiltered);
+                return false;
+            }
+            if (param < cache.size())
+            {
+                cache[param] = value;
+            }
+            ++stats.stateCallsIssued;
+            return true;
+        };
+
+    auto SetGraphicsTable = [&](UINT param, D3D12_GPU_DESCRIPTOR_HANDLE table)
+        {
+            if (UpdateRootArgument(bound.graphicsRoot, param, table.ptr))
+            {
+                cmdList_->SetGraphicsRootDescriptorTable(param, table);
+            }
         };
 
-#include "DirectX12RHI_Device_Public_CommandSubmission_PSOHelpers.inl"
+    auto SetComputeTable = [&](UINT param, D3D12_GPU_DESCRIPTOR_HANDLE table)
+        {
+            if (UpdateRootArgument(bound.computeRoot, param, table.ptr))
+            {
+                cmdList_->SetComputeRootDescriptorTable(param, table);
+            }
+        };
 
-    auto EnsurePSO = [&](PipelineHandle pipelineHandle, InputLayoutHandle layout) -> ID3D12PipelineState*
+    auto SetComputeUAV = [&](UINT param, D3D12_GPU_VIRTUAL_ADDRESS address)
         {
-            // PSO cache key MUST include: shaders, state, layout, and render-target formats.
-            std::uint64_t key = 1469598103934665603ull; // FNV-1a offset basis
-            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(pipelineHandle.id));
-            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(layout.id));
-            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(PackGraphicsStateKey(curState)));
-            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(curNumRT));
-            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(curDSVFormat));
-            for (std::size_t i = 0; i < curRTVFormats.size(); ++i)
+            if (UpdateRootArgument(bound.computeRoot, param, address))
             {
-                key = HashPsoKeyPart(key, static_cast<std::uint64_t>(curRTVFormats[i]));
+                cmdList_->SetComputeRootUnorderedAccessView(param, address);
             }
+        };
 
-            if (auto it = psoCache_.find(key); it != psoCache_.end())
+    auto SetTopology = [&](D3D_PRIMITIVE_TOPOLOGY topology)
+        {
+            if (bound.topology == topology)
             {
-                return it->second.Get();
+                CountFiltered(stats.inputAssemblerFiltered);
+                return;
             }
+            cmdList_->IASetPrimitiveTopology(topology);
+            bound.topology = topology;
+            ++stats.stateCallsIssued;
+        };
 
-            auto pit = pipelines_.find(pipelineHandle.id);
-            if (pit == pipelines_.end())
+    auto SetVertexBuffers = [&](UINT numVB, const std::array<D3D12_VERTEX_BUFFER_VIEW, kMaxVBSlots>& vbv)
+        {
+            bool same = (numVB == bound.numVB);
+            for (UINT s = 0; same && s < numVB; ++s)
             {
-                throw std::runtime_error("DX12: pipeline handle not found");
+                same = vbv[s].BufferLocation == bound.vbv[s].BufferLocation
+                    && vbv[s].SizeInBytes == bound.vbv[s].SizeInBytes
+                    && vbv[s].StrideInBytes == bound.vbv[s].StrideInBytes;
             }
+            if (same && numVB != 0)
+            {
+                CountFiltered(stats.inputAssemblerFiltered);
+                return;
+            }
+            cmdList_->IASetVertexBuffers(0, numVB, vbv.data());
+            bound.numVB = numVB;
+            bound.vbv = vbv;
+            ++stats.stateCallsIssued;
+        };
 
-            auto vsIt = shaders_.find(pit->second.vs.id);
+    auto SetIndexBuffer = [&](const D3D12_INDEX_BUFFER_VIEW& ibv)
+        {
+            if (bound.hasIBV
+                && bound.ibv.BufferLocation == ibv.BufferLocation
+                && bound.ibv.SizeInBytes == ibv.SizeInBytes
+                && bound.ibv.Format == ibv.Format)
+            {
+                CountFiltered(stats.inputAssemblerFiltered);
+                return;
+            }
+            cmdList_->IASetIndexBuffer(&ibv);
+            bound.ibv = ibv;
+            bound.hasIBV = true;
+            ++stats.stateCallsIssued;
+        };
 
-            if (vsIt == shaders_.end())
+    auto WriteCBAndBind = [&]()
+        {
+            const D3D12_GPU_VIRTUAL_ADDRESS address = WriteCB();
+            if (UpdateRootArgument(bound.graphicsRoot, perDrawSlot, address))
             {
-                throw std::runtime_error(BuildMissingShaderMessage(pit->second, pipelineHandle, curNumRT, "vs"));
+                cmdList_->SetGraphicsRootConstantBufferView(perDrawSlot, address);
             }
+        };
 
-            // Depth-only passes (NumRenderTargets == 0) can omit a pixel shader.
-            const bool needsPS = (curNumRT > 0);
-            auto psIt = shaders_.end();
-            if (needsPS)
+    auto WriteCBAndBindCompute = [&]()
+        {
+            const D3D12_GPU_VIRTUAL_ADDRESS address = WriteCB();
+            if (UpdateRootArgument(bound.computeRoot, 0, address))
             {
-                psIt = shaders_.find(pit->second.ps.id);
-                if (psIt == shaders_.end())
-                {
-                    throw std::runtime_error(BuildMissingShaderMessage(pit->second, pipelineHandle, curNumRT, "ps"));
-                }
+                cmdList_->SetComputeRootConstantBufferView(0, address);
             }
+        };
 
-            auto layIt = layouts_.find(layout.id);
-            if (layIt == layouts_.end())
+    // Graphics SRV tables t0..t20 plus the bindless table, shared by every draw path.
+    auto BindGraphicsTables = [&]()
+        {
+            for (UINT i = 0; i < kMaxSRVSlots; ++i)
             {
-                throw std::runtime_error("DX12: input layout handle not found");
+                SetGraphicsTable(1 + i, boundTex[i]);
+            }
+
+            constexpr UINT kBindlessRootParam = 1 + kMaxSRVSlots;
+            SetGraphicsTable(kBindlessRootParam, srvHeap_->GetGPUDescriptorHandleForHeapStart());
+        };
+
+    // Compute bindings: textures bound to t0..t3 (so Dispatch can move them to a non-pixel SRV state)
+    // and root UAVs u0..u3.
+    std::array<TextureHandle, kMaxComputeSRVSlots> computeSrvTextures{};
+    std::array<BufferHandle, kMaxUAVSlots> uavBuffers{};
+
+#include "DirectX12RHI_Device_Public_CommandSubmission_TransitionAndSrvHelpers.inl"
+    UINT curNumRT = 0;
+    std::array<DXGI_FORMAT, 8> curRTVFormats{};
+    std::fill(curRTVFormats.begin(), curRTVFormats.end(), DXGI_FORMAT_UNKNOWN);
+    DXGI_FORMAT curDSVFormat = DXGI_FORMAT_UNKNOWN;
+    bool curPassIsSwapChain = false;
+    DX12SwapChain* curSwapChain = nullptr;
+
+    auto TransitionTexture = [&](TextureHandle tex, D3D12_RESOURCE_STATES desired)
+        {
+            if (!tex)
+            {
+                return;
+            }
+
+            auto it = textures_.find(tex.id);
+            if (it == textures_.end())
+            {
+                return;
             }
 
-            D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc{};
-            pipelineDesc.pRootSignature = rootSig_.Get();
+            // A batched ShaderRead barrier leaves textures readable by every stage, which covers a pixel-only read.
+            constexpr D3D12_RESOURCE_STATES kAnyShaderRead = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+            if (it->second.state == kAnyShaderRead && (desired & ~kAnyShaderRead) == 0)
+            {
+                return;
+            }
+            // Compute lists cannot leave graphics states; PrepareAsyncComputeResources already moved the
+            // segment's textures to kAnyShaderRead on the direct list.
+            if (onComputeQueue)
+            {
+                return;
+            }
+
+            TransitionResource(
+                cmdList_.Get(),
+                it->second.resource.Get(),
+                it->second.state,
+                desired);
+        };
+
+    // Buffers written by Dispatch stay in UNORDERED_ACCESS until something reads them. GENERIC_READ is
+    // illegal on the compute queue, so async compute reads use NON_PIXEL_SHADER_RESOURCE instead and the
+    // direct list widens that again on its next read.
+    auto TransitionBufferForRead = [&](BufferHandle buffer)
+        {
+            if (!buffer)
+            {
+                return;
+            }
 
-            pipelineDesc.VS = { vsIt->second.blob->GetBufferPointer(), vsIt->second.blob->GetBufferSize() };
-            if (needsPS)
+            auto it = buffers_.find(buffer.id);
+            if (it == buffers_.end())
             {
-                pipelineDesc.PS = { psIt->second.blob->GetBufferPointer(), psIt->second.blob->GetBufferSize() };
+                return;
             }
-            else
+            const D3D12_RESOURCE_STATES state = it->second.state;
+            if (state != D3D12_RESOURCE_STATE_UNORDERED_ACCESS && (onComputeQueue || state != D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE))
             {
-                pipelineDesc.PS = {};
+                return;
             }
 
-            pipelineDesc.BlendState = CD3D12_BLEND_DESC(D3D12_DEFAULT);
-            pipelineDesc.SampleMask = UINT_MAX;
+            TransitionResource(
+                cmdList_.Get(),
+                it->second.resource.Get(),
+                it->second.state,
+                onComputeQueue ? D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE : D3D12_RESOURCE_STATE_GENERIC_READ);
+        };
 
-            // Blend
-            if (curState.blend.enable)
+    // Records everything the segment after *segmentBegin binds into a compute-usable state on the
+    // direct list: sampled textures to a shader-read state, UAV buffers to UNORDERED_ACCESS. Buffers whose
+    // first use is a read are handled by TransitionBufferForRead on the compute list.
+    auto PrepareAsyncComputeResources = [&](CommandList::Iterator segmentBegin)
+        {
+            constexpr D3D12_RESOURCE_STATES kAnyShaderRead = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+            std::vector<std::uint32_t> seenBuffers;
+            for (auto it = std::next(segmentBegin); it != commandList.end(); ++it)
             {
-                D3D12_BLEND_DESC blendDesc = CD3D12_BLEND_DESC(D3D12_DEFAULT);
-                blendDesc.AlphaToCoverageEnable = FALSE;
-                blendDesc.IndependentBlendEnable = FALSE;
+                const CommandRecord segmentCommand = *it;
+                if (segmentCommand.Is<CommandEndAsyncCompute>())
+                {
+                    break;
+                }
 
-                D3D12_RENDER_TARGET_BLEND_DESC renderTartget{};
-                renderTartget.BlendEnable = TRUE;
-                renderTartget.LogicOpEnable = FALSE;
-                renderTartget.BlendOp = D3D12_BLEND_OP_ADD;
-                renderTartget.BlendOpAlpha = D3D12_BLEND_OP_ADD;
-                renderTartget.LogicOp = D3D12_LOGIC_OP_NOOP;
-                renderTartget.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+                TextureHandle texture{};
+                if (const auto* bind = segmentCommand.GetIf<CommnadBindTexture2D>())
+                {
+                    texture = bind->texture;
+                }
+                else if (const auto* bindCube = segmentCommand.GetIf<CommandBindTextureCube>())
+                {
+                    texture = bindCube->texture;
+                }
+                else if (const auto* bindArray = segmentCommand.GetIf<CommandBindTexture2DArray>())
+                {
+                    texture = bindArray->texture;
+                }
+                else if (const auto* bindDesc = segmentCommand.GetIf<CommandTextureDesc>(); bindDesc && bindDesc->texture != 0)
+                {
+                    texture = ResolveTextureHandleFromDesc(bindDesc->texture);
+                }
+                TransitionTexture(texture, kAnyShaderRead);
 
-                if (curState.blend.mode == BlendMode::Additive)
+                BufferHandle buffer{};
+                bool writes = false;
+                if (const auto* uav = segmentCommand.GetIf<CommandBindBufferUAV>())
+                {
+                    buffer = uav->buffer;
+                    writes = true;
+                }
+                else if (const auto* srv = segmentCommand.GetIf<CommandBindStructuredBufferSRV>())
                 {
-                    renderTartget.SrcBlend = D3D12_BLEND_SRC_ALPHA;
-                    renderTartget.DestBlend = D3D12_BLEND_ONE;
-                    renderTartget.SrcBlendAlpha = D3D12_BLEND_ONE;
-                    renderTartget.DestBlendAlpha = D3D12_BLEND_ONE;
+                    buffer = srv->buffer;
                 }
-                else
+                if (!buffer || std::ranges::find(seenBuffers, buffer.id) != seenBuffers.end())
                 {
-                    renderTartget.SrcBlend = D3D12_BLEND_SRC_ALPHA;
-                    renderTartget.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
-                    renderTartget.SrcBlendAlpha = D3D12_BLEND_ONE;
-                    renderTartget.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+                    continue;
                 }
+                seenBuffers.push_back(buffer.id);
 
-                for (UINT i = 0; i < 8; ++i)
+                auto it = buffers_.find(buffer.id);
+                if (writes && it != buffers_.end())
                 {
-                    blendDesc.RenderTarget[i] = renderTartget;
+                    TransitionResource(
+                        cmdList_.Get(),
+                        it->second.resource.Get(),
+                        it->second.state,
+                        D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
                 }
+            }
+        };
+
+    // Closes the direct list, submits it and reopens it on the frame's allocator, so commands recorded
+    // from here on can be ordered against the compute queue.
+    auto SubmitDirectListSoFar = [&]()
+        {
+            ThrowIfFailed(cmdList_->Close(), "DX12: cmdList close failed");
+            ID3D12CommandList* lists[] = { cmdList_.Get() };
+            NativeQueue()->ExecuteCommandLists(1, lists);
+            ThrowIfFailed(cmdList_->Reset(CurrentFrame().cmdAlloc.Get(), nullptr), "DX12: cmdList reset failed");
+            cmdList_->SetDescriptorHeaps(1, heaps);
+            InvalidateBoundState();
+        };
+
+    auto EndAsyncComputeSegment = [&](std::uint32_t syncPoint)
+        {
+            ThrowIfFailed(cmdList_->Close(), "DX12: compute cmdList close failed");
+            cmdList_.Swap(computeCmdList_);
+            onComputeQueue = false;
+            InvalidateBoundState();
+
+            ID3D12CommandList* lists[] = { computeCmdList_.Get() };
+            computeQueue_->ExecuteCommandLists(1, lists);
+            const UINT64 v = ++computeFenceValue_;
+            ThrowIfFailed(computeQueue_->Signal(computeFence_.Get(), v), "DX12: compute queue Signal failed");
 
-                pipelineDesc.BlendState = blendDesc;
+            if (segmentFenceValues.size() <= syncPoint)
+            {
+                segmentFenceValues.resize(static_cast<std::size_t>(syncPoint) + 1, 0);
             }
+            segmentFenceValues[syncPoint] = v;
+        };
 
-            // Rasterizer from current state
-            pipelineDesc.RasterizerState = CD3D12_RASTERIZER_DESC(D3D12_DEFAULT);
-            pipelineDesc.RasterizerState.CullMode = ToD3DCull(curState.rasterizer.cullMode);
-            pipelineDesc.RasterizerState.FrontCounterClockwise = (curState.rasterizer.frontFace == FrontFace::CounterClockwise) ? TRUE : FALSE;
+    auto TransitionBackBuffer = [&](DX12SwapChain& sc, D3D12_RESOURCE_STATES desired)
+        {
+            TransitionResource(
+                cmdList_.Get(),
+                sc.CurrentBackBuffer(),
+                sc.CurrentBackBufferState(),
+                desired);
+        };
 
-            // Depth / Stencil
-            pipelineDesc.DepthStencilState = CD3D12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
-            pipelineDesc.DepthStencilState.DepthEnable = curState.depth.testEnable ? TRUE : FALSE;
-            pipelineDesc.DepthStencilState.DepthWriteMask = curState.depth.writeEnable ? D3D12_DEPTH_WRITE_MASK_ALL : D3D12_DEPTH_WRITE_MASK_ZERO;
-            pipelineDesc.DepthStencilState.DepthFunc = ToD3DCompare(curState.depth.depthCompareOp);
-            pipelineDesc.DepthStencilState.StencilEnable = curState.depth.stencil.enable ? TRUE : FALSE;
-            pipelineDesc.DepthStencilState.StencilReadMask = curState.depth.stencil.readMask;
-            pipelineDesc.DepthStencilState.StencilWriteMask = curState.depth.stencil.writeMask;
-            pipelineDesc.DepthStencilState.FrontFace.StencilFailOp = ToD3DStencilOp(curState.depth.stencil.front.failOp);
-            pipelineDesc.DepthStencilState.FrontFace.StencilDepthFailOp = ToD3DStencilOp(curState.depth.stencil.front.depthFailOp);
-            pipelineDesc.DepthStencilState.FrontFace.StencilPassOp = ToD3DStencilOp(curState.depth.stencil.front.passOp);
-            pipelineDesc.DepthStencilState.FrontFace.StencilFunc = ToD3DCompare(curState.depth.stencil.front.compareOp);
-            pipelineDesc.DepthStencilState.BackFace.StencilFailOp = ToD3DStencilOp(curState.depth.stencil.back.failOp);
-            pipelineDesc.DepthStencilState.BackFace.StencilDepthFailOp = ToD3DStencilOp(curState.depth.stencil.back.depthFailOp);
-            pipelineDesc.DepthStencilState.BackFace.StencilPassOp = ToD3DStencilOp(curState.depth.stencil.back.passOp);
-            pipelineDesc.DepthStencilState.BackFace.StencilFunc = ToD3DCompare(curState.depth.stencil.back.compareOp);
+    auto EnsurePSO = [&](PipelineHandle pipelineHandle, InputLayoutHandle layout) -> ID3D12PipelineState*
+        {
+            const std::uint64_t key = GraphicsPsoRuntimeKey_(pipelineHandle, layout, curState, curNumRT, curRTVFormats, curDSVFormat);
+            if (auto it = psoCache_.find(key); it != psoCache_.end())
+            {
+                return it->second.Get();
+            }
+            return GetOrBuildGraphicsPso_(ResolveGraphicsPso_(pipelineHandle, layout, curState, curNumRT, curRTVFormats, curDSVFormat));
+        };
 
-            pipelineDesc.InputLayout = { layIt->second.elems.data(), static_cast<UINT>(layIt->second.elems.size()) };
-            pipelineDesc.PrimitiveTopologyType = ToD3DTopologyType(pit->second.topologyType);
+    // PSO, root signature, IA and root bindings shared by DrawIndexed and DrawIndexedIndirect.
+    auto BindIndexedDrawState = [&](IndexType indexType, std::uint32_t firstIndex)
+        {
+            // PSO + RootSig
+            SetPipelineState(EnsurePSO(curPipe, curLayout));
+            SetGraphicsRootSignature(rootSig_.Get());
 
-            pipelineDesc.NumRenderTargets = curNumRT;
-            for (UINT i = 0; i < curNumRT; ++i)
+            // IA bindings (slot0..slotN based on input layout)
+            auto layIt = layouts_.find(curLayout.id);
+            if (layIt == layouts_.end())
             {
-                pipelineDesc.RTVFormats[i] = curRTVFormats[i];
+                throw std::runtime_error("DX12: input layout handle not found");
             }
-            pipelineDesc.DSVFormat = curDSVFormat;
 
-            pipelineDesc.SampleDesc.Count = 1;
+            std::uint32_t maxSlot = 0;
+            for (const auto& e : layIt->second.elems)
+            {
+                maxSlot = std::max(maxSlot, static_cast<std::uint32_t>(e.InputSlot));
+            }
 
-            ComPtr<ID3D12PipelineState> pso;
+            const std::uint32_t numVB = layIt->second.elems.empty()
+                ? 0u
+                : (maxSlot + 1u);
+            if (numVB > kMaxVBSlots)
+            {
+                throw std::runtime_error("DX12: input layout uses more VB slots than supported");
+            }
 
-            if (pit->second.viewInstanceCount > 1)
+            std::array<D3D12_VERTEX_BUFFER_VIEW, kMaxVBSlots> vbv{};
+            for (std::uint32_t s = 0; s < numVB; ++s)
             {
-                if (!device2_)
-                {
-                    // View instancing is optional; fail softly so the renderer can fallback to 6-pass.
-                    return nullptr;
-                }
-                // Build PSO via Pipeline State Stream to enable View Instancing.
-
-                using SO_RootSig = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE, ID3D12RootSignature*>;
-                using SO_VS = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VS, D3D12_SHADER_BYTECODE>;
-                using SO_PS = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS, D3D12_SHADER_BYTECODE>;
-                using SO_Blend = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND, D3D12_BLEND_DESC>;
-                using SO_SampleMask = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK, UINT>;
-                using SO_Raster = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER, D3D12_RASTERIZER_DESC>;
-                using SO_Depth = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL, D3D12_DEPTH_STENCIL_DESC>;
-                using SO_Input = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_INPUT_LAYOUT, D3D12_INPUT_LAYOUT_DESC>;
-                using SO_Topo = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY, D3D12_PRIMITIVE_TOPOLOGY_TYPE>;
-                using SO_RTVFmts = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS, D3D12_RT_FORMAT_ARRAY>;
-                using SO_DSVFmt = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT, DXGI_FORMAT>;
-                using SO_SampleDesc = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC, DXGI_SAMPLE_DESC>;
-                using SO_ViewInst = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VIEW_INSTANCING, D3D12_VIEW_INSTANCING_DESC>;
-
-                // Each stream subobject must be pointer-aligned, and its size should be a multiple of sizeof(void*)
-                // so the next Type is correctly aligned in the byte stream.
-                static_assert(sizeof(SO_RootSig) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_VS) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_PS) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_Blend) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_SampleMask) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_Raster) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_Depth) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_Input) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_Topo) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_RTVFmts) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_DSVFmt) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_SampleDesc) % sizeof(void*) == 0);
-                static_assert(sizeof(SO_ViewInst) % sizeof(void*) == 0);
-
-                const std::uint32_t viewCount = pit->second.viewInstanceCount;
-                std::array<D3D12_VIEW_INSTANCE_LOCATION, 8> locations{};
-                if (viewCount > locations.size())
+                if (!vertexBuffers[s])
                 {
-                    // View instancing is optional; fail softly so the renderer can fallback to 6-pass.
-                    return nullptr;
+                    throw std::runtime_error("DX12: missing vertex buffer binding for required slot");
                 }
-                for (std::uint32_t i = 0; i < viewCount; ++i)
+                auto vbIt = buffers_.find(vertexBuffers[s].id);
+                if (vbIt == buffers_.end())
                 {
-                    locations[i].RenderTargetArrayIndex = i;
-                    locations[i].ViewportArrayIndex = 0;
+                    throw std::runtime_error("DX12: vertex buffer not found");
                 }
+                TransitionBufferForRead(vertexBuffers[s]);
 
-                D3D12_VIEW_INSTANCING_DESC viDesc{};
-                viDesc.ViewInstanceCount = viewCount;
-                viDesc.pViewInstanceLocations = locations.data();
-                viDesc.Flags = D3D12_VIEW_INSTANCING_FLAG_NONE;
+                const std::uint32_t off = vbOffsets[s];
+                vbv[s].BufferLocation = vbIt->second.resource->GetGPUVirtualAddress() + off;
+                vbv[s].SizeInBytes = (UINT)(vbIt->second.desc.sizeInBytes - off);
+                vbv[s].StrideInBytes = vbStrides[s];
+            }
+            SetVertexBuffers(numVB, vbv);
+            SetTopology(currentTopology);
 
-                D3D12_RT_FORMAT_ARRAY rtFmts{};
-                rtFmts.NumRenderTargets = curNumRT;
-                for (UINT i = 0; i < curNumRT; ++i)
+            if (indexBuffer)
+            {
+                auto ibIt = buffers_.find(indexBuffer.id);
+                if (ibIt == buffers_.end())
                 {
-                    rtFmts.RTFormats[i] = curRTVFormats[i];
+                    throw std::runtime_error("DX12: index buffer not found");
                 }
+                TransitionBufferForRead(indexBuffer);
 
-                struct alignas(void*) PSOStream
-                {
-                    SO_RootSig    rootSig;
-                    SO_VS         vs;
-                    SO_PS         ps;
-                    SO_Blend      blend;
-                    SO_SampleMask sampleMask;
-                    SO_Raster     raster;
-                    SO_Depth      depth;
-                    SO_Input      input;
-                    SO_Topo       topo;
-                    SO_RTVFmts    rtvFmts;
-                    SO_DSVFmt     dsvFmt;
-                    SO_SampleDesc sampleDesc;
-                    SO_ViewInst   viewInst;
-                } stream{};
-
-                stream.rootSig.data = rootSig_.Get();
-                stream.vs.data = pipelineDesc.VS;
-                stream.ps.data = pipelineDesc.PS;
-                stream.blend.data = pipelineDesc.BlendState;
-                stream.sampleMask.data = pipelineDesc.SampleMask;
-                stream.raster.data = pipelineDesc.RasterizerState;
-                stream.depth.data = pipelineDesc.DepthStencilState;
-                stream.input.data = pipelineDesc.InputLayout;
-                stream.topo.data = pipelineDesc.PrimitiveTopologyType;
-                stream.rtvFmts.data = rtFmts;
-                stream.dsvFmt.data = pipelineDesc.DSVFormat;
-                stream.sampleDesc.data = pipelineDesc.SampleDesc;
-                stream.viewInst.data = viDesc;
-
-                D3D12_PIPELINE_STATE_STREAM_DESC streamDesc{};
-                streamDesc.SizeInBytes = sizeof(stream);
-                streamDesc.pPipelineStateSubobjectStream = &stream;
-
-                const HRESULT hr = device2_->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&pso));
-                if (FAILED(hr))
-                {
-                    // View instancing is optional; fail softly so the renderer can fallback to 6-pass.
-                    ThrowIfFailed(NativeDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pso)),
-                        "DX12: CreateGraphicsPipelineState failed");
-                }
-            }
-            else
-            {
-                ThrowIfFailed(NativeDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pso)),
-                    "DX12: CreateGraphicsPipelineState failed");
-            }
+                D3D12_INDEX_BUFFER_VIEW ibv{};
+                ibv.BufferLocation = ibIt->second.resource->GetGPUVirtualAddress() + ibOffset
+                    + static_cast<UINT64>(firstIndex) * static_cast<UINT64>(IndexSizeBytes(indexType));
+                ibv.SizeInBytes = static_cast<UINT>(ibIt->second.desc.sizeInBytes - ibOffset);
+                ibv.Format = (indexType == IndexType::UINT16) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
 
-            if (!pso)
-            {
-                return nullptr;
+                SetIndexBuffer(ibv);
             }
 
-            psoCache_[key] = pso;
-            return pso.Get();
+            // Root bindings: CBV (0) + SRV tables (1..)
+            WriteCBAndBind();
+            BindGraphicsTables();
         };
 
     // Parse high-level commands and record native D3D12
-    for (auto& command : commandList.commands)
+    for (auto commandIt = commandList.begin(); commandIt != commandList.end(); ++commandIt)
     {
-        std::visit([&](auto&& cmd)
+        (*commandIt).Visit([&](auto&& cmd)
             {
                 using T = std::decay_t<decltype(cmd)>;
 
@@ -380,9 +552,46 @@ void SubmitCommandList(CommandList&& commandList) override
 #include "DirectX12RHI_Device_Public_CommandSubmission_StateAndBindingCommands.inl"                  
 #include "DirectX12RHI_Device_Public_CommandSubmission_DrawAndImGuiCommands.inl"                        
 
-            }, command);
+            });
+    }
+
+    if (onComputeQueue)
+    {
+        EndAsyncComputeSegment(static_cast<std::uint32_t>(segmentFenceValues.size()));
+    }
+    lastSubmissionStats_ = stats;
+
+    // Zones the stream left open end here; then every timestamp of the frame goes to the readback buffer.
+    if (timestampHeap_)
+    {
+        FrameResource& fr = CurrentFrame();
+        const UINT queryBase = activeFrameIndex_ * kTimestampQueriesPerFrame;
+        for (; !openTimestampZones.empty(); openTimestampZones.pop_back())
+        {
+            if (openTimestampZones.back() != kUntimedZone)
+            {
+                cmdList_->EndQuery(timestampHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, queryBase + fr.timestampZones[openTimestampZones.back()].endQuery);
+            }
+        }
+        if (fr.timestampQueries != 0)
+        {
+            cmdList_->ResolveQueryData(timestampHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, queryBase, fr.timestampQueries,
+                timestampReadback_.Get(), static_cast<UINT64>(queryBase) * sizeof(UINT64));
+        }
+    }
+
+    // The frame fence also has to cover the compute queue: join whatever the stream left unjoined.
+    if (computeQueue_ && computeFenceValue_ > joinedComputeValue && !segmentFenceValues.empty())
+    {
+        ThrowIfFailed(NativeQueue()->Wait(computeFence_.Get(), computeFenceValue_), "DX12: queue Wait failed");
     }
 
     // Close + execute + signal fence for the current frame resource
     EndFrame();
+
+    // The readbacks recorded by this submission complete with its frame fence.
+    for (auto it = textureReadbacks_.rbegin(); it != textureReadbacks_.rend() && it->fenceValue == 0; ++it)
+    {
+        it->fenceValue = CurrentFrame().fenceValue;
+    }
 }
\ No newline at end of file
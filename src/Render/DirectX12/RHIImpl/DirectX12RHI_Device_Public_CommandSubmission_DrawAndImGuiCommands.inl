@@ -1,85 +1,120 @@
                         else if constexpr (std::is_same_v<T, CommandDrawIndexed>)
                         {
-                            // PSO + RootSig
-                            ID3D12PipelineState* pso = EnsurePSO(curPipe, curLayout);
-                            cmdList_->SetPipelineState(pso);
-                            cmdList_->SetGraphicsRootSignature(rootSig_.Get());
-
-                            // IA bindings (slot0..slotN based on input layout)
-                            auto layIt = layouts_.find(curLayout.id);
-                            if (layIt == layouts_.end())
+                            BindIndexedDrawState(cmd.indexType, cmd.firstIndex);
+                            ++stats.draws;
+                            stats.instances += cmd.instanceCount;
+                            cmdList_->DrawIndexedInstanced(cmd.indexCount, cmd.instanceCount, 0, cmd.baseVertex, cmd.firstInstance);
+                        }
+                        else if constexpr (std::is_same_v<T, CommandDrawIndexedIndirect>)
+                        {
+                            if (!drawIndexedSignature_)
                             {
-                                throw std::runtime_error("DX12: input layout handle not found");
+                                throw std::runtime_error("DX12: DrawIndexedIndirect: command signature not available");
                             }
 
-                            std::uint32_t maxSlot = 0;
-                            for (const auto& e : layIt->second.elems)
+                            auto argsIt = buffers_.find(cmd.argsBuffer.id);
+                            if (argsIt == buffers_.end())
                             {
-                                maxSlot = std::max(maxSlot, static_cast<std::uint32_t>(e.InputSlot));
+                                throw std::runtime_error("DX12: DrawIndexedIndirect: argument buffer not found");
                             }
 
-                            const std::uint32_t numVB = layIt->second.elems.empty()
-                                ? 0u
-                                : (maxSlot + 1u);
-                            if (numVB > kMaxVBSlots)
-                            {
-                                throw std::runtime_error("DX12: input layout uses more VB slots than supported");
-                            }
+                            // Arguments carry their own firstIndex, so the IBV starts at ibOffset.
+                            BindIndexedDrawState(cmd.indexType, 0);
 
-                            std::array<D3D12_VERTEX_BUFFER_VIEW, kMaxVBSlots> vbv{};
-                            for (std::uint32_t s = 0; s < numVB; ++s)
+                            ID3D12Resource* countRes = nullptr;
+                            if (cmd.countBuffer)
                             {
-                                if (!vertexBuffers[s])
+                                auto countIt = buffers_.find(cmd.countBuffer.id);
+                                if (countIt == buffers_.end())
                                 {
-                                    throw std::runtime_error("DX12: missing vertex buffer binding for required slot");
-                                }
-                                auto vbIt = buffers_.find(vertexBuffers[s].id);
-                                if (vbIt == buffers_.end())
-                                {
-                                    throw std::runtime_error("DX12: vertex buffer not found");
+                                    throw std::runtime_error("DX12: DrawIndexedIndirect: count buffer not found");
                                 }
+                                countRes = countIt->second.resource.Get();
+                            }
+
+                            // GENERIC_READ includes INDIRECT_ARGUMENT.
+                            TransitionBufferForRead(cmd.argsBuffer);
+                            TransitionBufferForRead(cmd.countBuffer);
+                            ++stats.draws;
+                            cmdList_->ExecuteIndirect(
+                                drawIndexedSignature_.Get(),
+                                cmd.maxDrawCount,
+                                argsIt->second.resource.Get(),
+                                cmd.argsOffsetBytes,
+                                countRes,
+                                cmd.countOffsetBytes);
+                        }
+                        else if constexpr (std::is_same_v<T, CommandDispatch>)
+                        {
+                            auto pit = pipelines_.find(curPipe.id);
+                            if (pit == pipelines_.end() || !pit->second.computePSO)
+                            {
+                                throw std::runtime_error("DX12: Dispatch: bound pipeline is not a compute pipeline");
+                            }
 
-                                const std::uint32_t off = vbOffsets[s];
-                                vbv[s].BufferLocation = vbIt->second.resource->GetGPUVirtualAddress() + off;
-                                vbv[s].SizeInBytes = (UINT)(vbIt->second.desc.sizeInBytes - off);
-                                vbv[s].StrideInBytes = vbStrides[s];
+                            for (TextureHandle tex : computeSrvTextures)
+                            {
+                                TransitionTexture(tex, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
                             }
-                            cmdList_->IASetVertexBuffers(0, numVB, vbv.data());
-                            cmdList_->IASetPrimitiveTopology(currentTopology);
 
-                            if (indexBuffer)
+                            SetComputeRootSignature(computeRootSig_.Get());
+                            SetPipelineState(pit->second.computePSO.Get());
+
+                            // Root bindings: CBV (0) + SRV tables t0..t3 (1..4) + root UAVs u0..u3 (5..8)
+                            WriteCBAndBindCompute();
+                            for (UINT i = 0; i < kMaxComputeSRVSlots; ++i)
                             {
-                                auto ibIt = buffers_.find(indexBuffer.id);
-                                if (ibIt == buffers_.end())
+                                SetComputeTable(1 + i, boundTex[i]);
+                            }
+                            for (UINT i = 0; i < kMaxUAVSlots; ++i)
+                            {
+                                auto uavIt = buffers_.find(uavBuffers[i].id);
+                                if (uavBuffers[i] && uavIt != buffers_.end())
                                 {
-                                    throw std::runtime_error("DX12: index buffer not found");
+                                    SetComputeUAV(1 + kMaxComputeSRVSlots + i, uavIt->second.resource->GetGPUVirtualAddress());
                                 }
-                                D3D12_INDEX_BUFFER_VIEW ibv{};
-                                ibv.BufferLocation = ibIt->second.resource->GetGPUVirtualAddress() + ibOffset
-                                    + static_cast<UINT64>(cmd.firstIndex) * static_cast<UINT64>(IndexSizeBytes(cmd.indexType));
-                                ibv.SizeInBytes = static_cast<UINT>(ibIt->second.desc.sizeInBytes - ibOffset);
-                                ibv.Format = (cmd.indexType == IndexType::UINT16) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
-
-                                cmdList_->IASetIndexBuffer(&ibv);
                             }
 
-                            // Root bindings: CBV (0) + SRV table (1)
-                            WriteCBAndBind();
+                            ++stats.dispatches;
+                            cmdList_->Dispatch(cmd.groupCountX, cmd.groupCountY, cmd.groupCountZ);
 
-                            for (UINT i = 0; i < kMaxSRVSlots; ++i)
+                            // Dispatches in one list may feed each other (e.g. HiZ levels): order all UAV writes.
+                            D3D12_RESOURCE_BARRIER uavBarrier{};
+                            uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+                            uavBarrier.UAV.pResource = nullptr;
+                            cmdList_->ResourceBarrier(1, &uavBarrier);
+                        }
+                        else if constexpr (std::is_same_v<T, CommandDispatchMesh>)
+                        {
+                            auto pit = pipelines_.find(curPipe.id);
+                            if (pit == pipelines_.end() || !pit->second.ms)
+                            {
+                                throw std::runtime_error("DX12: DispatchMesh: bound pipeline is not a mesh pipeline");
+                            }
+                            // cmdList_ may be the async compute list's swap partner: query per dispatch.
+                            ComPtr<ID3D12GraphicsCommandList6> meshList;
+                            if (FAILED(cmdList_.As(&meshList)))
                             {
-                                cmdList_->SetGraphicsRootDescriptorTable(1 + i, boundTex[i]);
+                                throw std::runtime_error("DX12: DispatchMesh: ID3D12GraphicsCommandList6 not available");
                             }
 
-                            constexpr UINT kBindlessRootParam = 1 + kMaxSRVSlots;
-                            cmdList_->SetGraphicsRootDescriptorTable(kBindlessRootParam, srvHeap_->GetGPUDescriptorHandleForHeapStart());
-                            cmdList_->DrawIndexedInstanced(cmd.indexCount, cmd.instanceCount, 0, cmd.baseVertex, cmd.firstInstance);
+                            ID3D12PipelineState* pso = EnsurePSO(curPipe, InputLayoutHandle{});
+                            if (!pso)
+                            {
+                                throw std::runtime_error("DX12: DispatchMesh: mesh pipeline could not be built");
+                            }
+                            SetPipelineState(pso);
+                            SetGraphicsRootSignature(rootSig_.Get());
+
+                            WriteCBAndBind();
+                            BindGraphicsTables();
+                            ++stats.draws;
+                            meshList->DispatchMesh(cmd.groupCountX, cmd.groupCountY, cmd.groupCountZ);
                         }
                         else if constexpr (std::is_same_v<T, CommandDraw>)
                         {
-                            ID3D12PipelineState* pso = EnsurePSO(curPipe, curLayout);
-                            cmdList_->SetPipelineState(pso);
-                            cmdList_->SetGraphicsRootSignature(rootSig_.Get());
+                            SetPipelineState(EnsurePSO(curPipe, curLayout));
+                            SetGraphicsRootSignature(rootSig_.Get());
 
                             // IA bindings (slot0..slotN based on input layout)
                             auto layIt = layouts_.find(curLayout.id);
@@ -119,18 +154,13 @@
                                 vbv[s].SizeInBytes = (UINT)(vbIt->second.desc.sizeInBytes - off);
                                 vbv[s].StrideInBytes = vbStrides[s];
                             }
-                            cmdList_->IASetVertexBuffers(0, numVB, vbv.data());
-                            cmdList_->IASetPrimitiveTopology(currentTopology);
+                            SetVertexBuffers(numVB, vbv);
+                            SetTopology(currentTopology);
 
                             WriteCBAndBind();
-
-                            for (UINT i = 0; i < kMaxSRVSlots; ++i)
-                            {
-                                cmdList_->SetGraphicsRootDescriptorTable(1 + i, boundTex[i]);
-                            }
-
-                            constexpr UINT kBindlessRootParam = 1 + kMaxSRVSlots;
-                            cmdList_->SetGraphicsRootDescriptorTable(kBindlessRootParam, srvHeap_->GetGPUDescriptorHandleForHeapStart());
+                            BindGraphicsTables();
+                            ++stats.draws;
+                            stats.instances += cmd.instanceCount;
                             cmdList_->DrawInstanced(cmd.vertexCount, cmd.instanceCount, cmd.firstVertex, cmd.firstInstance);
                             }
                         else if constexpr (std::is_same_v<T, CommandDX12ImGuiRender>)
@@ -145,6 +175,8 @@
                             cmdList_->SetDescriptorHeaps(1, heaps);
 
                             ImGui_ImplDX12_RenderDrawData(reinterpret_cast<ImDrawData*>(const_cast<void*>(cmd.drawData)), cmdList_.Get());
+                            // ImGui binds its own pipeline, root signature and IA state.
+                            InvalidateBoundState();
                             }
                         else if constexpr (std::is_same_v<T, CommandBindTexture2DArray>)
                         {
@@ -159,8 +191,7 @@
                                 // Ensure an Array SRV exists for cube textures.
                                 if (!it->second.hasSRVArray)
                                 {
-                                    const auto desc = it->second.resource->GetDesc();
-                                    AllocateSRV_CubeAsArray(it->second, it->second.srvFormat, desc.MipLevels);
+                                    AllocateSRV_CubeAsArray(it->second, it->second.srvFormat, it->second.mipLevels);
                                 }
 
                                 TransitionTexture(cmd.texture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
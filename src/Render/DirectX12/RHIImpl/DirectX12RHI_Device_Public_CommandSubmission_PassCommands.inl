@@ -1,7 +1,19 @@
 if constexpr (std::is_same_v<T, CommandBeginPass>)
 {
+    if (onComputeQueue)
+    {
+        throw std::runtime_error("DX12: CommandBeginPass inside an async compute segment");
+    }
+
     const BeginPassDesc& pass = cmd.desc;
     const ClearDesc& c = pass.clearDesc;
+    D3D12_RECT clearRect{};
+    if (c.rect)
+    {
+        clearRect = D3D12_RECT{ c.rect->x, c.rect->y, c.rect->x + c.rect->width, c.rect->y + c.rect->height };
+    }
+    const UINT numClearRects = c.rect ? 1u : 0u;
+    const D3D12_RECT* clearRects = c.rect ? &clearRect : nullptr;
 
     std::array<D3D12_CPU_DESCRIPTOR_HANDLE, 8> rtvs{};
     UINT numRT = 0;
@@ -71,14 +83,14 @@ if constexpr (std::is_same_v<T, CommandBeginPass>)
         if (c.clearColor)
         {
             const float* col = c.color.data();
-            cmdList_->ClearRenderTargetView(rtvs[0], col, 0, nullptr);
+            cmdList_->ClearRenderTargetView(rtvs[0], col, numClearRects, clearRects);
         }
         const D3D12_CLEAR_FLAGS dsClearFlags =
             (c.clearDepth ? D3D12_CLEAR_FLAG_DEPTH : static_cast<D3D12_CLEAR_FLAGS>(0)) |
             (c.clearStencil ? D3D12_CLEAR_FLAG_STENCIL : static_cast<D3D12_CLEAR_FLAGS>(0));
         if (dsClearFlags != 0 && hasDSV)
         {
-            cmdList_->ClearDepthStencilView(dsv, dsClearFlags, c.depth, c.stencil, 0, nullptr);
+            cmdList_->ClearDepthStencilView(dsv, dsClearFlags, c.depth, c.stencil, numClearRects, clearRects);
         }
 
         curPassIsSwapChain = true;
@@ -234,7 +246,7 @@ if constexpr (std::is_same_v<T, CommandBeginPass>)
             const float* col = c.color.data();
             for (UINT i = 0; i < numRT; ++i)
             {
-                cmdList_->ClearRenderTargetView(rtvs[i], col, 0, nullptr);
+                cmdList_->ClearRenderTargetView(rtvs[i], col, numClearRects, clearRects);
             }
         }
 
@@ -243,7 +255,7 @@ if constexpr (std::is_same_v<T, CommandBeginPass>)
             (c.clearStencil ? D3D12_CLEAR_FLAG_STENCIL : static_cast<D3D12_CLEAR_FLAGS>(0));
         if (dsClearFlags != 0 && hasDSV)
         {
-            cmdList_->ClearDepthStencilView(dsv, dsClearFlags, c.depth, c.stencil, 0, nullptr);
+            cmdList_->ClearDepthStencilView(dsv, dsClearFlags, c.depth, c.stencil, numClearRects, clearRects);
         }
     }
 }
@@ -258,6 +270,214 @@ else if constexpr (std::is_same_v<T, CommandEndPass>)
         TransitionBackBuffer(*curSwapChain, D3D12_RESOURCE_STATE_PRESENT);
     }
 }
+else if constexpr (std::is_same_v<T, CommandTextureBarriers>)
+{
+    // One ResourceBarrier call for the whole batch; the per-bind transitions below then find
+    // the textures already in place.
+    std::vector<D3D12_RESOURCE_BARRIER> barriers;
+    barriers.reserve(cmd.barriers.size());
+    for (const TextureBarrier& b : cmd.barriers)
+    {
+        auto it = textures_.find(b.texture.id);
+        if (it == textures_.end())
+        {
+            continue;
+        }
+
+        const D3D12_RESOURCE_STATES desired = ToD3D12TextureState(b.state);
+        auto& te = it->second;
+        if (te.state == desired)
+        {
+            continue;
+        }
+
+        D3D12_RESOURCE_BARRIER barrier{};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barrier.Transition.pResource = te.resource.Get();
+        barrier.Transition.StateBefore = te.state;
+        barrier.Transition.StateAfter = desired;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        barriers.push_back(barrier);
+        te.state = desired;
+    }
+    if (!barriers.empty())
+    {
+        cmdList_->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+    }
+}
+else if constexpr (std::is_same_v<T, CommandCopyTexture>)
+{
+    if (onComputeQueue)
+    {
+        throw std::runtime_error("DX12: CommandCopyTexture inside an async compute segment");
+    }
+
+    auto srcIt = textures_.find(cmd.src.id);
+    auto dstIt = textures_.find(cmd.dst.id);
+    if (srcIt == textures_.end() || dstIt == textures_.end() || cmd.src.id == cmd.dst.id)
+    {
+        return;
+    }
+
+    auto& src = srcIt->second;
+    auto& dst = dstIt->second;
+    TransitionResource(cmdList_.Get(), src.resource.Get(), src.state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    TransitionResource(cmdList_.Get(), dst.resource.Get(), dst.state, D3D12_RESOURCE_STATE_COPY_DEST);
+    cmdList_->CopyResource(dst.resource.Get(), src.resource.Get());
+}
+else if constexpr (std::is_same_v<T, CommandReadbackTexture>)
+{
+    if (onComputeQueue)
+    {
+        throw std::runtime_error("DX12: CommandReadbackTexture inside an async compute segment");
+    }
+
+    auto it = textures_.find(cmd.texture.id);
+    if (it == textures_.end())
+    {
+        return;
+    }
+    auto& tex = it->second;
+    const UINT bytesPerTexel = BytesPerTexel(tex.format);
+    if (tex.type != TextureEntry::Type::Tex2D || bytesPerTexel == 0)
+    {
+        throw std::runtime_error("DX12: CommandReadbackTexture needs a 2D color texture");
+    }
+
+    const std::uint32_t x = std::min(cmd.x, tex.extent.width);
+    const std::uint32_t y = std::min(cmd.y, tex.extent.height);
+    const std::uint32_t width = std::min(cmd.width, tex.extent.width - x);
+    const std::uint32_t height = std::min(cmd.height, tex.extent.height - y);
+
+    TextureReadbackRecord record{};
+    record.result = TextureReadback{ cmd.requestId, x, y, width, height, {} };
+    record.bytesPerTexel = bytesPerTexel;
+    record.rowPitch = AlignUp(width * bytesPerTexel, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+    if (width != 0 && height != 0)
+    {
+        D3D12_HEAP_PROPERTIES heapProps{};
+        heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+        const CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(static_cast<UINT64>(record.rowPitch) * height);
+        ThrowIfFailed(NativeDevice()->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(&record.buffer)),
+            "DX12: Create texture readback buffer failed");
+
+        TransitionResource(cmdList_.Get(), tex.resource.Get(), tex.state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+        D3D12_TEXTURE_COPY_LOCATION dstLocation{};
+        dstLocation.pResource = record.buffer.Get();
+        dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        dstLocation.PlacedFootprint.Footprint.Format = tex.resourceFormat;
+        dstLocation.PlacedFootprint.Footprint.Width = width;
+        dstLocation.PlacedFootprint.Footprint.Height = height;
+        dstLocation.PlacedFootprint.Footprint.Depth = 1;
+        dstLocation.PlacedFootprint.Footprint.RowPitch = record.rowPitch;
+
+        D3D12_TEXTURE_COPY_LOCATION srcLocation{};
+        srcLocation.pResource = tex.resource.Get();
+        srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        srcLocation.SubresourceIndex = 0;
+
+        const D3D12_BOX box{ x, y, 0, x + width, y + height, 1 };
+        cmdList_->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, &box);
+    }
+    // An empty rect still completes (with no data), so callers never wait forever.
+    textureReadbacks_.push_back(std::move(record));
+}
+else if constexpr (std::is_same_v<T, CommandGenerateMips>)
+{
+    if (onComputeQueue)
+    {
+        throw std::runtime_error("DX12: CommandGenerateMips inside an async compute segment");
+    }
+
+    auto it = textures_.find(cmd.texture.id);
+    if (it == textures_.end())
+    {
+        return;
+    }
+
+    stats.dispatches += RecordGenerateMips_(it->second, cmd.normalMap);
+    InvalidateBoundState();
+}
+else if constexpr (std::is_same_v<T, CommandBeginAsyncCompute>)
+{
+    if (!computeQueue_ || onComputeQueue)
+    {
+        return;
+    }
+
+    PrepareAsyncComputeResources(commandIt);
+    // The segment waits for everything recorded on the direct list so far.
+    SubmitDirectListSoFar();
+    const UINT64 ready = SignalQueue("DX12: Signal failed");
+    ThrowIfFailed(computeQueue_->Wait(fence_.Get(), ready), "DX12: compute queue Wait failed");
+
+    ThrowIfFailed(computeCmdList_->Reset(CurrentFrame().computeCmdAlloc.Get(), nullptr), "DX12: compute cmdList reset failed");
+    computeCmdList_->SetDescriptorHeaps(1, heaps);
+    cmdList_.Swap(computeCmdList_);
+    onComputeQueue = true;
+    InvalidateBoundState();
+}
+else if constexpr (std::is_same_v<T, CommandEndAsyncCompute>)
+{
+    if (onComputeQueue)
+    {
+        EndAsyncComputeSegment(cmd.syncPoint);
+    }
+}
+else if constexpr (std::is_same_v<T, CommandWaitAsyncCompute>)
+{
+    if (onComputeQueue || cmd.syncPoint >= segmentFenceValues.size() || segmentFenceValues[cmd.syncPoint] <= joinedComputeValue)
+    {
+        return;
+    }
+
+    // A queue Wait only holds back work submitted after it.
+    SubmitDirectListSoFar();
+    joinedComputeValue = segmentFenceValues[cmd.syncPoint];
+    ThrowIfFailed(NativeQueue()->Wait(computeFence_.Get(), joinedComputeValue), "DX12: queue Wait failed");
+}
+else if constexpr (std::is_same_v<T, CommandBeginTimestampZone>)
+{
+    // Direct queue only: the compute queue may tick at another frequency.
+    FrameResource& fr = CurrentFrame();
+    if (!timestampHeap_ || onComputeQueue || fr.timestampQueries + 2 > kTimestampQueriesPerFrame)
+    {
+        openTimestampZones.push_back(kUntimedZone);
+        return;
+    }
+
+    const UINT query = fr.timestampQueries;
+    fr.timestampQueries += 2;
+    cmdList_->EndQuery(timestampHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, activeFrameIndex_ * kTimestampQueriesPerFrame + query);
+    fr.timestampZones.push_back(TimestampZoneRecord{ std::string(cmd.name), query, query + 1, static_cast<std::uint32_t>(openTimestampZones.size()) });
+    openTimestampZones.push_back(fr.timestampZones.size() - 1);
+}
+else if constexpr (std::is_same_v<T, CommandEndTimestampZone>)
+{
+    if (openTimestampZones.empty())
+    {
+        return;
+    }
+    const std::size_t zone = openTimestampZones.back();
+    openTimestampZones.pop_back();
+    if (zone == kUntimedZone)
+    {
+        return;
+    }
+
+    // A zone that began before an async segment and ends inside it ends on the parked direct list.
+    ID3D12GraphicsCommandList* directList = onComputeQueue ? computeCmdList_.Get() : cmdList_.Get();
+    directList->EndQuery(timestampHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP,
+        activeFrameIndex_ * kTimestampQueriesPerFrame + CurrentFrame().timestampZones[zone].endQuery);
+}
 else if constexpr (std::is_same_v<T, CommandSetViewport>)
 {
     D3D12_VIEWPORT viewport{};
@@ -275,4 +495,13 @@ else if constexpr (std::is_same_v<T, CommandSetViewport>)
     scissor.right = cmd.x + cmd.width;
     scissor.bottom = cmd.y + cmd.height;
     cmdList_->RSSetScissorRects(1, &scissor);
+}
+else if constexpr (std::is_same_v<T, CommandSetScissor>)
+{
+    D3D12_RECT scissor{};
+    scissor.left = cmd.x;
+    scissor.top = cmd.y;
+    scissor.right = cmd.x + std::max(cmd.width, 0);
+    scissor.bottom = cmd.y + std::max(cmd.height, 0);
+    cmdList_->RSSetScissorRects(1, &scissor);
 }
\ No newline at end of file
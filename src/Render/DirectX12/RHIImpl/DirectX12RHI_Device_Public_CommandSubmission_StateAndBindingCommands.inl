@@ -51,6 +51,10 @@
 
                                 TransitionTexture(cmd.texture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
                                 boundTex[cmd.slot] = GetTextureSRV(cmd.texture);
+                                if (cmd.slot < computeSrvTextures.size())
+                                {
+                                    computeSrvTextures[cmd.slot] = cmd.texture;
+                                }
                             }
                         }
                         else if constexpr (std::is_same_v<T, CommandBindTextureCube>)
@@ -70,6 +74,10 @@
 
                                 TransitionTexture(cmd.texture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
                                 boundTex[cmd.slot] = GetTextureSRV(cmd.texture);
+                                if (cmd.slot < computeSrvTextures.size())
+                                {
+                                    computeSrvTextures[cmd.slot] = cmd.texture;
+                                }
                             }
                         }
                         else if constexpr (std::is_same_v<T, CommandTextureDesc>)
@@ -81,6 +89,10 @@
                                 {
                                     // null SRV
                                     boundTex[cmd.slot] = srvHeap_->GetGPUDescriptorHandleForHeapStart();
+                                    if (cmd.slot < computeSrvTextures.size())
+                                    {
+                                        computeSrvTextures[cmd.slot] = {};
+                                    }
                                     return;
                                 }
 
@@ -90,6 +102,10 @@
                                 {
                                     TransitionTexture(handle, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
                                 }
+                                if (cmd.slot < computeSrvTextures.size())
+                                {
+                                    computeSrvTextures[cmd.slot] = handle;
+                                }
 
                                 // TextureDescIndex is a real SRV heap index.
                                 D3D12_GPU_DESCRIPTOR_HANDLE gpu = srvHeap_->GetGPUDescriptorHandleForHeapStart();
@@ -101,9 +117,38 @@
                         {
                             if (cmd.slot < boundTex.size())
                             {
+                                TransitionBufferForRead(cmd.buffer);
                                 boundTex[cmd.slot] = GetBufferSRV(cmd.buffer);
+                                if (cmd.slot < computeSrvTextures.size())
+                                {
+                                    computeSrvTextures[cmd.slot] = {};
+                                }
+                            }
+                            }
+                        else if constexpr (std::is_same_v<T, CommandBindBufferUAV>)
+                        {
+                            if (cmd.slot >= uavBuffers.size())
+                            {
+                                throw std::runtime_error("DX12: BindBufferUAV: slot out of range");
+                            }
+
+                            auto it = buffers_.find(cmd.buffer.id);
+                            if (it == buffers_.end())
+                            {
+                                throw std::runtime_error("DX12: BindBufferUAV: buffer not found");
                             }
+                            if (it->second.desc.bindFlag != BufferBindFlag::StorageBuffer)
+                            {
+                                throw std::runtime_error("DX12: BindBufferUAV: buffer was not created as a StorageBuffer");
                             }
+
+                            TransitionResource(
+                                cmdList_.Get(),
+                                it->second.resource.Get(),
+                                it->second.state,
+                                D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+                            uavBuffers[cmd.slot] = cmd.buffer;
+                        }
                         else if constexpr (std::is_same_v<T, CommandSetUniformInt> ||
                             std::is_same_v<T, CommandUniformFloat4> ||
                             std::is_same_v<T, CommandUniformMat4>)
@@ -114,13 +159,15 @@
                         else if constexpr (std::is_same_v<T, CommandSetConstants>)
                         {
                             perDrawSlot = cmd.slot;
-                            perDrawSize = cmd.size;
-                            if (perDrawSize > kMaxPerDrawConstantsBytes)
-                            {
-                                perDrawSize = kMaxPerDrawConstantsBytes;
-                            }
-                            if (perDrawSize != 0)
+                            const std::uint32_t size = static_cast<std::uint32_t>(std::min<std::size_t>(cmd.data.size(), kMaxPerDrawConstantsBytes));
+                            // Re-recording the same bytes keeps the previous upload.
+                            if (size != perDrawSize || (size != 0 && std::memcmp(perDrawBytes.data(), cmd.data.data(), size) != 0))
                             {
-                                std::memcpy(perDrawBytes.data(), cmd.data.data(), perDrawSize);
+                                perDrawSize = size;
+                                if (perDrawSize != 0)
+                                {
+                                    std::memcpy(perDrawBytes.data(), cmd.data.data(), perDrawSize);
+                                }
+                                perDrawDirty = true;
                             }
                         }
\ No newline at end of file
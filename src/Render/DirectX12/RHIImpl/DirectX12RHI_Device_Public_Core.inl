@@ -42,26 +42,6 @@
                 ThrowIfFailed(frames_[i].cbUpload->Map(0, nullptr, &mapped),
                     "DX12: Map per-frame constant upload buffer failed");
 
-                // Per-frame buffer upload ring (persistently mapped).
-                D3D12_RESOURCE_DESC bufDesc = resourceDesc;
-                bufDesc.Width = static_cast<UINT64>(kPerFrameBufUploadBytes);
-
-                ThrowIfFailed(NativeDevice()->CreateCommittedResource(
-                    &heapProps,
-                    D3D12_HEAP_FLAG_NONE,
-                    &bufDesc,
-                    D3D12_RESOURCE_STATE_GENERIC_READ,
-                    nullptr,
-                    IID_PPV_ARGS(&frames_[i].bufUpload)),
-                    "DX12: Create per-frame buffer upload ring failed");
-
-                void* bufMapped = nullptr;
-                ThrowIfFailed(frames_[i].bufUpload->Map(0, nullptr, &bufMapped),
-                    "DX12: Map per-frame buffer upload ring failed");
-
-                frames_[i].bufMapped = reinterpret_cast<std::byte*>(bufMapped);
-                frames_[i].bufCursor = 0;
-
                 frames_[i].cbMapped = reinterpret_cast<std::byte*>(mapped);
                 frames_[i].cbCursor = 0;
                 frames_[i].fenceValue = 0;
@@ -86,6 +66,11 @@
                 throw std::runtime_error("DX12: CreateEvent failed");
             }
 
+            CreateStagingRing();
+            CreateCopyQueue();
+            CreateComputeQueue();
+            CreateTimestampQueries();
+
             // SRV heap (shader visible)
             {
                 D3D12_DESCRIPTOR_HEAP_DESC heapDesc{};
@@ -123,15 +108,19 @@
                     NativeDevice()->CreateShaderResourceView(nullptr, &nullBuf, cpu);
                 }
 
-                nextSrvIndex_ = 3; // 0=null tex, 1=null buffer, 2=ImGui font SRV
-                freeSrv_.clear();
+                srvSlots_ = DescriptorSlotAllocator(kSrvReservedSlots, kSrvStaticSlots, kSrvPageSize, kSrvMaxPages);
             }
 
             CreateRootSignature();
+            CreateComputeRootSignature();
+            CreateCommandSignatures();
         }
 
         ~DX12Device() override
         {
+            // The warm-up thread creates PSOs against this device.
+            JoinPipelineWarmup_();
+
             // Make sure GPU is idle before we release resources referenced by the queue.
             try
             {
@@ -153,18 +142,19 @@
                     fr.cbMapped = nullptr;
                 }
 
-                if (fr.bufUpload)
-                {
-                    fr.bufUpload->Unmap(0, nullptr);
-                    fr.bufMapped = nullptr;
-                }
 
                 fr.deferredResources.clear();
-                fr.deferredFreeSrv.clear();
+                fr.deferredPipelines.clear();
                 fr.deferredFreeRtv.clear();
                 fr.deferredFreeDsv.clear();
             }
 
+            if (staging_.resource)
+            {
+                staging_.resource->Unmap(0, nullptr);
+                staging_.mapped = nullptr;
+            }
+
             if (fenceEvent_)
             {
                 CloseHandle(fenceEvent_);
@@ -182,8 +172,10 @@
                 throw std::runtime_error("DX12: ReplaceSampledTextureResource: texture handle not found");
             }
 
+            UnchargeGpuMemory(it->second);
             it->second.resource.Reset();
             it->second.resource.Attach(newRes); // takes ownership (AddRef already implied by Attach contract)
+            ChargeGpuMemory(it->second, memory::MemoryTag::Textures);
 
             // Keep the same descriptor slot if we already had an SRV; just rewrite it.
             if (it->second.hasSRV && it->second.srvIndex != 0)
@@ -218,6 +210,7 @@
                     static_cast<std::uint32_t>(resourceDesc.Height) };
                 it->second.resourceFormat = resourceDesc.Format;
                 it->second.srvFormat = fmt;
+                it->second.mipLevels = mipLevels;
                 it->second.state = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 
                 NativeDevice()->CreateShaderResourceView(it->second.resource.Get(), &srvDesc, cpu);
@@ -229,7 +222,8 @@
             }
         } /// DX12Device
 
-        TextureHandle RegisterSampledTexture(ID3D12Resource* res, DXGI_FORMAT fmt, UINT mipLevels)
+        TextureHandle RegisterSampledTexture(ID3D12Resource* res, DXGI_FORMAT fmt, UINT mipLevels,
+            D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
         {
             if (!res)
             {
@@ -247,17 +241,19 @@
 
             textureEntry.resourceFormat = resourceDesc.Format;
             textureEntry.srvFormat = fmt;
-            textureEntry.state = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+            textureEntry.state = initialState;
 
             textureEntry.resource = res;
 
             AllocateSRV(textureEntry, fmt, mipLevels);
+            ChargeGpuMemory(textureEntry, memory::MemoryTag::Textures);
 
             textures_[textureHandle.id] = std::move(textureEntry);
             return textureHandle;
         }
 
-        TextureHandle RegisterSampledTextureCube(ID3D12Resource* res, DXGI_FORMAT fmt, UINT mipLevels)
+        TextureHandle RegisterSampledTextureCube(ID3D12Resource* res, DXGI_FORMAT fmt, UINT mipLevels,
+            D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
         {
             if (!res)
             {
@@ -276,11 +272,12 @@
 
             textureEntry.resourceFormat = resourceDesc.Format;
             textureEntry.srvFormat = fmt;
-            textureEntry.state = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+            textureEntry.state = initialState;
 
             textureEntry.resource = res;
 
             AllocateSRV(textureEntry, fmt, mipLevels);
+            ChargeGpuMemory(textureEntry, memory::MemoryTag::Textures);
 
             textures_[textureHandle.id] = std::move(textureEntry);
             return textureHandle;
@@ -305,11 +302,96 @@
             return supportsSM6_1_;
         }
 
+        bool SupportsMeshShaders() const override
+        {
+            return supportsMeshShaders_;
+        }
+
         bool SupportsViewInstancing() const override
         {
             return supportsViewInstancing_;
         }
 
+        bool SupportsCompute() const override
+        {
+            return computeRootSig_ && drawIndexedSignature_;
+        }
+
+        bool SupportsAsyncCompute() const override
+        {
+            return SupportsCompute() && computeQueue_;
+        }
+
+        bool SupportsGenerateMips() const override
+        {
+            return SupportsCompute() && supportsTypedUAVLoadAdditionalFormats_;
+        }
+
+        SubmissionStats GetLastSubmissionStats() const override
+        {
+            return lastSubmissionStats_;
+        }
+
+        DeviceCounters GetDeviceCounters() const override
+        {
+            return deviceCounters_;
+        }
+
+        std::uint32_t GetFramesInFlight() const noexcept override
+        {
+            return kFramesInFlight;
+        }
+
+        bool SupportsTimestampQueries() const override
+        {
+            return static_cast<bool>(timestampHeap_);
+        }
+
+        bool SupportsBindlessTextures() const override
+        {
+            return true;
+        }
+
+        std::span<const GpuTimestampZone> GetLastGpuTimestampZones() const override
+        {
+            return lastGpuZones_;
+        }
+
+        bool SupportsTextureReadback() const override
+        {
+            return true;
+        }
+
+        void TakeCompletedTextureReadbacks(std::vector<TextureReadback>& out) override
+        {
+            const UINT64 completed = fence_->GetCompletedValue();
+            while (!textureReadbacks_.empty() && textureReadbacks_.front().fenceValue != 0 && textureReadbacks_.front().fenceValue <= completed)
+            {
+                TextureReadbackRecord& record = textureReadbacks_.front();
+                TextureReadback& result = out.emplace_back(std::move(record.result));
+                if (record.buffer)
+                {
+                    const std::size_t rowBytes = static_cast<std::size_t>(result.width) * record.bytesPerTexel;
+                    const D3D12_RANGE readRange{ 0, static_cast<SIZE_T>(record.rowPitch) * result.height };
+                    void* mapped = nullptr;
+                    ThrowIfFailed(record.buffer->Map(0, &readRange, &mapped), "DX12: Map texture readback failed");
+                    result.data.resize(rowBytes * result.height);
+                    for (std::uint32_t row = 0; row < result.height; ++row)
+                    {
+                        std::memcpy(result.data.data() + row * rowBytes, static_cast<const std::byte*>(mapped) + static_cast<std::size_t>(row) * record.rowPitch, rowBytes);
+                    }
+                    const D3D12_RANGE noWrite{ 0, 0 };
+                    record.buffer->Unmap(0, &noWrite);
+                }
+                textureReadbacks_.pop_front();
+            }
+        }
+
+        bool SupportsMultiDrawIndirect() const override
+        {
+            return static_cast<bool>(drawIndexedSignature_);
+        }
+
         bool SupportsVPAndRTArrayIndexFromAnyShader() const override
         {
             return supportsVPAndRTArrayIndexFromAnyShader_;
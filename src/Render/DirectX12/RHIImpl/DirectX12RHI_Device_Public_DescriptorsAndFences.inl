@@ -4,7 +4,7 @@
             // We allocate a slot in the shader-visible heap and write SRV there.
             // 0 is reserved for "null texture".
 
-            const UINT slot = AllocateSrvIndex(); // uses deferred-safe recycling
+            const UINT slot = AllocateSrvIndex(); // paged range; recycled only after the GPU is done with it
             const TextureDescIndex idx = static_cast<TextureDescIndex>(slot);
             UpdateTextureDescriptor(idx, texture);
             return idx;
@@ -60,14 +60,14 @@
             {
                 srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
                 srvDesc.TextureCube.MostDetailedMip = 0;
-                srvDesc.TextureCube.MipLevels = 1;
+                srvDesc.TextureCube.MipLevels = te.mipLevels;
                 srvDesc.TextureCube.ResourceMinLODClamp = 0.0f;
             }
             else
             {
                 srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
                 srvDesc.Texture2D.MostDetailedMip = 0;
-                srvDesc.Texture2D.MipLevels = 1;
+                srvDesc.Texture2D.MipLevels = te.mipLevels;
                 srvDesc.Texture2D.PlaneSlice = 0;
                 srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
             }
@@ -84,15 +84,14 @@
                 return;
             }
 
-            // Overwrite freed slot with null Texture2D SRV (slot 0).
-            D3D12_CPU_DESCRIPTOR_HANDLE dst = srvHeap_->GetCPUDescriptorHandleForHeapStart();
-            dst.ptr += static_cast<SIZE_T>(index) * srvInc_;
-
-            D3D12_CPU_DESCRIPTOR_HANDLE src = srvHeap_->GetCPUDescriptorHandleForHeapStart(); // slot 0
-            NativeDevice()->CopyDescriptorsSimple(1, dst, src, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+            // Frames in flight may still sample the slot: it keeps its view until they retire, then
+            // ReclaimSrvIndices nulls and recycles it.
+            FreeSrvIndex(static_cast<UINT>(index));
+        }
 
-            // Recycle after GPU fence for safety.
-            CurrentFrame().deferredFreeSrv.push_back(static_cast<UINT>(index));
+        DescriptorSlotAllocator::Stats GetDescriptorHeapStats() const override
+        {
+            return srvSlots_.GetStats();
         }
 
         // ---------------- Fences (minimal impl) ----------------
@@ -140,3 +139,77 @@
         {
             return srvInc_;
         }
+
+        // ---------------- Staging / out-of-frame uploads ----------------
+        struct StagingAllocation
+        {
+            ID3D12Resource* resource{ nullptr };
+            UINT64 offset{ 0 };
+            std::byte* cpu{ nullptr };
+        };
+
+        // Sub-allocates from the shared staging ring. Valid until the next queue Signal's fence
+        // completes, i.e. record the copy before calling SubmitUploadCommands / the next frame.
+        StagingAllocation AllocateStaging(UINT64 sizeInBytes, UINT64 alignment)
+        {
+            return AllocateStagingInternal(sizeInBytes, alignment);
+        }
+
+        // Direct-queue list for copies outside SubmitCommandList (nests; the outermost Submit executes).
+        ID3D12GraphicsCommandList* BeginUploadCommands()
+        {
+            return BeginUploadContext(directUpload_);
+        }
+
+        // Returns the fence value that marks completion (0 for nested calls). Never blocks.
+        UINT64 SubmitUploadCommands()
+        {
+            return SubmitUploadContext(directUpload_);
+        }
+
+        void AbortUploadCommands() noexcept
+        {
+            AbortUploadContext(directUpload_);
+        }
+
+        // Copy-queue list for texture streaming. Copy lists cannot transition to shader-read
+        // states: record into resources created in COMMON and let the direct queue promote
+        // them once IsCopyFenceComplete reports the batch as done.
+        bool HasCopyQueue() const noexcept
+        {
+            return copyQueue_ != nullptr;
+        }
+
+        ID3D12GraphicsCommandList* BeginCopyCommands()
+        {
+            return BeginUploadContext(copyUpload_);
+        }
+
+        UINT64 SubmitCopyCommands()
+        {
+            return SubmitUploadContext(copyUpload_);
+        }
+
+        void AbortCopyCommands() noexcept
+        {
+            AbortUploadContext(copyUpload_);
+        }
+
+        bool IsCopyFenceComplete(UINT64 value) const
+        {
+            return !copyFence_ || copyFence_->GetCompletedValue() >= value;
+        }
+
+        // Upload-time mip build (DX12TextureUploader): `texture` got only mip 0. The build is recorded at
+        // the start of the first submission after copy fence `copyFenceValue` completed (0: mip 0 went
+        // through the direct queue). Needs SupportsGenerateMips.
+        void QueueGenerateMips(TextureHandle texture, UINT64 copyFenceValue, bool normalMap)
+        {
+            pendingMipGenerations_.push_back(PendingMipGeneration{ texture, copyFenceValue, normalMap });
+        }
+
+        bool IsMipGenerationPending(TextureHandle texture) const noexcept
+        {
+            return std::ranges::any_of(pendingMipGenerations_,
+                [&](const PendingMipGeneration& pending) { return pending.texture.id == texture.id; });
+        }
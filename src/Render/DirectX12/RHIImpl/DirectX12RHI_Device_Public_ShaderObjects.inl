@@ -44,52 +44,112 @@
             shaderEntry.stage = stage;
             shaderEntry.name = std::string(debugName);
 
-            const char* target = (stage == ShaderStage::Vertex) ? "vs_5_1" : "ps_5_1";
+            std::string errors;
+            ComPtr<ID3DBlob> code = GetOrCompileShaderBytecode_(
+                ShaderBytecodeKey_(stage, ShaderModel::SM5_1, debugName, sourceOrBytecode),
+                [&] { return CompileFXCShader_(stage, debugName, sourceOrBytecode, errors); });
+            if (!code)
+            {
+                throw std::runtime_error("DX12: shader compile failed: " + errors);
+            }
 
-            ComPtr<ID3DBlob> code;
-            ComPtr<ID3DBlob> errors;
+            shaderEntry.blob = code;
+            shaders_[handle.id] = std::move(shaderEntry);
+            return handle;
+        }
+
+        // Hot reload: recompiles `shader` in place. Graphics pipelines using it drop their PSO variants, which
+        // rebuild on next use; compute pipelines are rebuilt now. Replaced PSOs are released with the frame.
+        bool ReloadShader(ShaderHandle shader, std::string_view sourceOrBytecode, ShaderModel shaderModel) override
+        {
+            auto it = shaders_.find(shader.id);
+            if (it == shaders_.end())
+            {
+                return false;
+            }
+            ShaderEntry& shaderEntry = it->second;
 
-            UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
-#if defined(_DEBUG)
-            flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+            std::string errors;
+            ComPtr<ID3DBlob> code;
+            const std::uint64_t key = ShaderBytecodeKey_(shaderEntry.stage, shaderModel, shaderEntry.name, sourceOrBytecode);
+            if (shaderModel == ShaderModel::SM5_1)
+            {
+                code = GetOrCompileShaderBytecode_(key,
+                    [&] { return CompileFXCShader_(shaderEntry.stage, shaderEntry.name, sourceOrBytecode, errors); });
+            }
+            else
+            {
+#if CORE_DX12_HAS_DXC
+                if (!supportsSM6_1_)
+                {
+                    return false;
+                }
+                code = GetOrCompileShaderBytecode_(key,
+                    [&] { return CompileDXCShader_(shaderEntry.stage, shaderEntry.name, sourceOrBytecode, errors, nullptr, nullptr); });
 #else
-            flags |= D3DCOMPILE_OPTIMIZATION_LEVEL3;
+                return false;
 #endif
+            }
+            if (!code)
+            {
+                throw std::runtime_error("DX12: shader reload failed (shader='" + shaderEntry.name + "'): " + errors);
+            }
+            if (code.Get() == shaderEntry.blob.Get())
+            {
+                return true;
+            }
 
-            auto TryCompile = [&](const char* entry) -> bool
+            // Warmed-up variants were built from the old bytecode.
+            JoinPipelineWarmup_();
+            {
+                std::lock_guard lock(warmedPsoMutex_);
+                warmedPsos_.clear();
+            }
+
+            auto Retire = [this](ComPtr<ID3D12PipelineState>&& pso)
                 {
-                    code.Reset();
-                    errors.Reset();
-
-                    HRESULT hr = D3DCompile(
-                        sourceOrBytecode.data(),
-                        sourceOrBytecode.size(),
-                        shaderEntry.name.c_str(),
-                        nullptr, nullptr,
-                        entry, target,
-                        flags, 0,
-                        &code, &errors);
-
-                    return SUCCEEDED(hr);
+                    if (pso && hasSubmitted_)
+                    {
+                        CurrentFrame().deferredPipelines.push_back(std::move(pso));
+                    }
                 };
 
-            if (!TryCompile(shaderEntry.name.c_str()))
+            for (auto& [id, pipelineEntry] : pipelines_)
             {
-                const char* fallback = (stage == ShaderStage::Vertex) ? "VSMain" : "PSMain";
-                if (!TryCompile(fallback))
+                if (pipelineEntry.computePSO && pipelineEntry.cs.id == shader.id)
                 {
-                    std::string err = "DX12: shader compile failed: ";
-                    if (errors)
+                    D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineDesc{};
+                    pipelineDesc.pRootSignature = computeRootSig_.Get();
+                    pipelineDesc.CS = { code->GetBufferPointer(), code->GetBufferSize() };
+
+                    ComPtr<ID3D12PipelineState> pso;
+                    ThrowIfFailed(NativeDevice()->CreateComputePipelineState(&pipelineDesc, IID_PPV_ARGS(&pso)),
+                        "DX12: CreateComputePipelineState failed");
+                    Retire(std::move(pipelineEntry.computePSO));
+                    pipelineEntry.computePSO = std::move(pso);
+                }
+                else if (pipelineEntry.vs.id == shader.id || pipelineEntry.ps.id == shader.id
+                    || pipelineEntry.as.id == shader.id || pipelineEntry.ms.id == shader.id)
+                {
+                    auto keysIt = psoKeysByPipeline_.find(id);
+                    if (keysIt == psoKeysByPipeline_.end())
                     {
-                        err += std::string((const char*)errors->GetBufferPointer(), errors->GetBufferSize());
+                        continue;
                     }
-                    throw std::runtime_error(err);
+                    for (const std::uint64_t runtimeKey : keysIt->second)
+                    {
+                        if (auto psoIt = psoCache_.find(runtimeKey); psoIt != psoCache_.end())
+                        {
+                            Retire(std::move(psoIt->second));
+                            psoCache_.erase(psoIt);
+                        }
+                    }
+                    psoKeysByPipeline_.erase(keysIt);
                 }
             }
 
-            shaderEntry.blob = code;
-            shaders_[handle.id] = std::move(shaderEntry);
-            return handle;
+            shaderEntry.blob = std::move(code);
+            return true;
         }
 
         void DestroyShader(ShaderHandle shader) noexcept override
@@ -99,7 +159,13 @@
 
         void DestroyPipeline(PipelineHandle pso) noexcept override
         {
+            auto it = pipelines_.find(pso.id);
+            if (it != pipelines_.end() && it->second.computePSO && hasSubmitted_)
+            {
+                CurrentFrame().deferredPipelines.push_back(std::move(it->second.computePSO));
+            }
             pipelines_.erase(pso.id);
+            psoKeysByPipeline_.erase(pso.id);
             // TODO: PSO cache entries - it can be cleared indpendtly - but right here it is ok
         }
 
@@ -14,37 +14,20 @@
                 msg += "')";
                 throw std::runtime_error(msg);
             }
-
-            const wchar_t* target = (stage == ShaderStage::Vertex) ? L"vs_6_1" : L"ps_6_1";
-
-            std::string lastErr{};
-            auto TryCompile = [&](std::string_view entry) -> ComPtr<ID3DBlob>
-                {
-                    ComPtr<ID3DBlob> out;
-                    std::string err;
-                    if (!CompileDXC_(sourceOrBytecode, target, entry, debugName, out, &err))
-                    {
-                        if (!err.empty())
-                        {
-                            lastErr = std::move(err);
-                        }
-                        return {};
-                    }
-                    lastErr.clear();
-                    return out;
-                };
-
-            ComPtr<ID3DBlob> code = TryCompile(std::string_view(debugName));
-            if (!code)
-            {
-                code = TryCompile("main");
-            }
-            if (!code)
+            const bool meshStage = (stage == ShaderStage::Amplification) || (stage == ShaderStage::Mesh);
+            if ((meshStage || shaderModel == ShaderModel::SM6_5) && !supportsMeshShaders_)
             {
-                const char* fallback = (stage == ShaderStage::Vertex) ? "VSMain" : "PSMain";
-                code = TryCompile(fallback);
+                std::string msg = "DX12: SM6.5 shader requested, but mesh shaders are unavailable (shader='";
+                msg += std::string(debugName);
+                msg += "')";
+                throw std::runtime_error(msg);
             }
 
+            std::string lastErr{};
+            ComPtr<ID3DBlob> code = GetOrCompileShaderBytecode_(
+                ShaderBytecodeKey_(stage, shaderModel, debugName, sourceOrBytecode),
+                [&] { return CompileDXCShader_(stage, debugName, sourceOrBytecode, lastErr, nullptr, nullptr); });
+
             if (!code)
             {
                 std::string msg = "DX12: SM6.1 shader compile failed (shader='";
@@ -75,6 +58,49 @@
 #endif
         }
 
+        // Compiles into the bytecode cache without creating a handle, so a later CreateShader/CreateShaderEx
+        // with the same arguments is a lookup. Safe to call from several threads at once.
+        bool PrecompileShader(ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode, ShaderModel shaderModel) override
+        {
+            std::string errors;
+            if (shaderModel == ShaderModel::SM5_1)
+            {
+                return GetOrCompileShaderBytecode_(
+                    ShaderBytecodeKey_(stage, ShaderModel::SM5_1, debugName, sourceOrBytecode),
+                    [&] { return CompileFXCShader_(stage, debugName, sourceOrBytecode, errors); }) != nullptr;
+            }
+
+#if CORE_DX12_HAS_DXC
+            // supportsSM6_1_ implies EnsureDXC_ succeeded during DetectCapabilities_.
+            if (!supportsSM6_1_)
+            {
+                return false;
+            }
+            if ((stage == ShaderStage::Amplification || stage == ShaderStage::Mesh || shaderModel == ShaderModel::SM6_5) && !supportsMeshShaders_)
+            {
+                return false;
+            }
+            return GetOrCompileShaderBytecode_(
+                ShaderBytecodeKey_(stage, shaderModel, debugName, sourceOrBytecode),
+                [&]() -> ComPtr<ID3DBlob>
+                {
+                    // One compiler per call: IDxcCompiler3 is not free-threaded.
+                    ComPtr<IDxcUtils> utils;
+                    ComPtr<IDxcCompiler3> compiler;
+                    ComPtr<IDxcIncludeHandler> includeHandler;
+                    if (FAILED(dxcCreateInstance_(CLSID_DxcUtils, IID_PPV_ARGS(&utils)))
+                        || FAILED(dxcCreateInstance_(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler)))
+                        || FAILED(utils->CreateDefaultIncludeHandler(&includeHandler)))
+                    {
+                        return {};
+                    }
+                    return CompileDXCShader_(stage, debugName, sourceOrBytecode, errors, compiler.Get(), includeHandler.Get());
+                }) != nullptr;
+#else
+            return false;
+#endif
+        }
+
         PipelineHandle CreatePipelineEx(std::string_view debugName, ShaderHandle vertexShader, ShaderHandle pixelShader, PrimitiveTopologyType topologyType, std::uint32_t viewInstanceCount) override
         {
             if (viewInstanceCount > 1)
@@ -128,3 +154,245 @@
             return CreatePipelineEx(debugName, vertexShader, pixelShader, topologyType, 1);
         }
 
+        PipelineHandle CreateComputePipeline(std::string_view debugName, ShaderHandle computeShader) override
+        {
+            auto csIt = shaders_.find(computeShader.id);
+            if (!computeShader || csIt == shaders_.end() || csIt->second.stage != ShaderStage::Compute)
+            {
+                std::string msg = "DX12: CreateComputePipeline: compute shader handle not found (pipeline='";
+                msg += std::string(debugName);
+                msg += "')";
+                throw std::runtime_error(msg);
+            }
+
+            D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineDesc{};
+            pipelineDesc.pRootSignature = computeRootSig_.Get();
+            pipelineDesc.CS = { csIt->second.blob->GetBufferPointer(), csIt->second.blob->GetBufferSize() };
+
+            PipelineEntry pipelineEntry{};
+            pipelineEntry.debugName = std::string(debugName);
+            pipelineEntry.cs = computeShader;
+            ThrowIfFailed(NativeDevice()->CreateComputePipelineState(&pipelineDesc, IID_PPV_ARGS(&pipelineEntry.computePSO)),
+                "DX12: CreateComputePipelineState failed");
+
+            PipelineHandle handle{ ++nextPsoId_ };
+            pipelines_[handle.id] = std::move(pipelineEntry);
+            return handle;
+        }
+
+        PipelineHandle CreateMeshPipeline(std::string_view debugName, ShaderHandle amplificationShader, ShaderHandle meshShader, ShaderHandle pixelShader) override
+        {
+            if (!supportsMeshShaders_)
+            {
+                return {};
+            }
+
+            auto CheckStage = [&](ShaderHandle shader, ShaderStage stage, const char* what)
+                {
+                    auto it = shaders_.find(shader.id);
+                    if (it == shaders_.end() || it->second.stage != stage)
+                    {
+                        std::string msg = "DX12: CreateMeshPipeline: ";
+                        msg += what;
+                        msg += " shader handle not found (pipeline='";
+                        msg += std::string(debugName);
+                        msg += "', id=";
+                        msg += std::to_string(shader.id);
+                        msg += ")";
+                        throw std::runtime_error(msg);
+                    }
+                };
+            CheckStage(meshShader, ShaderStage::Mesh, "mesh");
+            if (amplificationShader)
+            {
+                CheckStage(amplificationShader, ShaderStage::Amplification, "amplification");
+            }
+            if (pixelShader)
+            {
+                CheckStage(pixelShader, ShaderStage::Pixel, "pixel");
+            }
+
+            PipelineHandle handle{ ++nextPsoId_ };
+            PipelineEntry pipelineEntry{};
+            pipelineEntry.debugName = std::string(debugName);
+            pipelineEntry.as = amplificationShader;
+            pipelineEntry.ms = meshShader;
+            pipelineEntry.ps = pixelShader;
+            pipelineEntry.topologyType = PrimitiveTopologyType::Triangle;
+            pipelines_[handle.id] = std::move(pipelineEntry);
+            return handle;
+        }
+
+
+        // ---------------- Pipeline cache ----------------
+        void LoadPipelineCache(std::string_view directory) override
+        {
+            JoinPipelineWarmup_();
+            pipelineCacheDir_ = std::filesystem::path(std::string(directory));
+
+            // A library from another driver/adapter (or a damaged file) is rejected; start empty then.
+            pipelineLibrary_.Reset();
+            pipelineLibrary1_.Reset();
+            pipelineLibraryBlob_.clear();
+            ComPtr<ID3D12Device1> device1;
+            if (SUCCEEDED(core_.device.As(&device1)))
+            {
+                if (ReadPipelineCacheFile_(pipelineCacheDir_ / "dx12_pipelines.bin", pipelineLibraryBlob_)
+                    && FAILED(device1->CreatePipelineLibrary(pipelineLibraryBlob_.data(), pipelineLibraryBlob_.size(), IID_PPV_ARGS(&pipelineLibrary_))))
+                {
+                    pipelineLibrary_.Reset();
+                    pipelineLibraryBlob_.clear();
+                }
+                if (!pipelineLibrary_ && FAILED(device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&pipelineLibrary_))))
+                {
+                    pipelineLibrary_.Reset();
+                }
+                if (pipelineLibrary_)
+                {
+                    pipelineLibrary_.As(&pipelineLibrary1_);
+                }
+            }
+
+            std::vector<std::byte> keys;
+            loadedWarmKeys_.clear();
+            if (ReadPipelineCacheFile_(pipelineCacheDir_ / "dx12_pipelines.keys", keys))
+            {
+                loadedWarmKeys_ = ParsePipelineWarmKeys_(keys);
+            }
+        }
+
+        // Rebuilds the recorded variants whose pipeline (by debug name) and input layout (by content)
+        // exist now on a background thread; draws that need one before it is done build it themselves.
+        void WarmPipelineCache() override
+        {
+            JoinPipelineWarmup_();
+
+            std::unordered_map<std::string_view, PipelineHandle> pipelineByName;
+            for (const auto& [id, entry] : pipelines_)
+            {
+                if (!entry.computePSO)
+                {
+                    pipelineByName.emplace(entry.debugName, PipelineHandle{ id });
+                }
+            }
+            std::unordered_map<std::uint64_t, InputLayoutHandle> layoutByHash;
+            for (const auto& [id, entry] : layouts_)
+            {
+                layoutByHash.emplace(HashInputLayout_(entry), InputLayoutHandle{ id });
+            }
+
+            std::vector<GraphicsPsoBuild> builds;
+            for (const PipelineWarmKey& warmKey : loadedWarmKeys_)
+            {
+                const auto pipelineIt = pipelineByName.find(warmKey.pipelineName);
+                if (pipelineIt == pipelineByName.end())
+                {
+                    continue;
+                }
+                // Mesh pipelines have no input layout (recorded as layoutHash 0).
+                InputLayoutHandle layout{};
+                if (!pipelines_.at(pipelineIt->second.id).ms)
+                {
+                    const auto layoutIt = layoutByHash.find(warmKey.layoutHash);
+                    if (layoutIt == layoutByHash.end())
+                    {
+                        continue;
+                    }
+                    layout = layoutIt->second;
+                }
+                if (psoCache_.contains(GraphicsPsoRuntimeKey_(pipelineIt->second, layout, warmKey.state, warmKey.numRT, warmKey.rtvFormats, warmKey.dsvFormat)))
+                {
+                    continue;
+                }
+                try
+                {
+                    builds.push_back(ResolveGraphicsPso_(pipelineIt->second, layout, warmKey.state, warmKey.numRT, warmKey.rtvFormats, warmKey.dsvFormat));
+                }
+                catch (const std::exception&)
+                {
+                    // Shaders changed shape since the key was recorded; the variant is rebuilt on demand.
+                }
+            }
+            if (builds.empty())
+            {
+                return;
+            }
+
+            pipelineWarmThread_ = std::thread([this, builds = std::move(builds)]()
+                {
+                    for (const GraphicsPsoBuild& build : builds)
+                    {
+                        ComPtr<ID3D12PipelineState> pso;
+                        try
+                        {
+                            pso = BuildGraphicsPso_(build);
+                        }
+                        catch (const std::exception&)
+                        {
+                            continue;
+                        }
+                        if (pso)
+                        {
+                            std::lock_guard lock(warmedPsoMutex_);
+                            warmedPsos_.emplace(build.runtimeKey, std::move(pso));
+                        }
+                    }
+                });
+        }
+
+        // Writes the pipeline library and the warm-up list: this session's variants first, then the
+        // recorded ones it did not reach, capped at kMaxPipelineWarmKeys.
+        void SavePipelineCache() override
+        {
+            JoinPipelineWarmup_();
+            if (pipelineCacheDir_.empty())
+            {
+                return;
+            }
+
+            std::error_code ec;
+            std::filesystem::create_directories(pipelineCacheDir_, ec);
+
+            if (pipelineLibrary_)
+            {
+                std::vector<std::byte> blob(pipelineLibrary_->GetSerializedSize());
+                if (!blob.empty() && SUCCEEDED(pipelineLibrary_->Serialize(blob.data(), blob.size())))
+                {
+                    WritePipelineCacheFile_(pipelineCacheDir_ / "dx12_pipelines.bin", blob);
+                }
+            }
+
+            std::vector<PipelineWarmKey> keys = usedWarmKeysInOrder_;
+            std::unordered_set<std::string> seen;
+            auto Identity = [](const PipelineWarmKey& key)
+                {
+                    std::string id = key.pipelineName;
+                    const auto* bytes = reinterpret_cast<const char*>(&key.layoutHash);
+                    id.append(bytes, sizeof(key.layoutHash));
+                    id.append(reinterpret_cast<const char*>(&key.state), sizeof(key.state));
+                    id.append(reinterpret_cast<const char*>(&key.numRT), sizeof(key.numRT));
+                    id.append(reinterpret_cast<const char*>(key.rtvFormats.data()), sizeof(key.rtvFormats));
+                    id.append(reinterpret_cast<const char*>(&key.dsvFormat), sizeof(key.dsvFormat));
+                    return id;
+                };
+            for (const PipelineWarmKey& key : keys)
+            {
+                seen.insert(Identity(key));
+            }
+            for (const PipelineWarmKey& key : loadedWarmKeys_)
+            {
+                if (keys.size() >= kMaxPipelineWarmKeys)
+                {
+                    break;
+                }
+                if (seen.insert(Identity(key)).second)
+                {
+                    keys.push_back(key);
+                }
+            }
+            if (keys.size() > kMaxPipelineWarmKeys)
+            {
+                keys.resize(kMaxPipelineWarmKeys);
+            }
+            WritePipelineCacheFile_(pipelineCacheDir_ / "dx12_pipelines.keys", SerializePipelineWarmKeys_(keys));
+        }
@@ -76,7 +76,7 @@
                 // SRV for sampling (shadow maps)
                 if (srvFmt != DXGI_FORMAT_UNKNOWN)
                 {
-                    AllocateSRV(textureEntry, srvFmt, 1);
+                    AllocateSRV(textureEntry, srvFmt, 1, true);
                 }
             }
             else
@@ -105,9 +105,11 @@
                 textureEntry.rtv = AllocateRTV(textureEntry.resource.Get(), dxFmt, textureEntry.rtvIndex);
                 textureEntry.hasRTV = true;
 
-                AllocateSRV(textureEntry, dxFmt, 1);
+                AllocateSRV(textureEntry, dxFmt, 1, true);
             }
 
+            ChargeGpuMemory(textureEntry, memory::CurrentGpuMemoryTag());
+
             textures_[textureHandle.id] = std::move(textureEntry);
             return textureHandle;
         }
@@ -129,8 +131,8 @@
             resourceDesc.Height = extent.height;
             resourceDesc.DepthOrArraySize = 6; // cubemap faces
             resourceDesc.MipLevels = 1;
-            // Mip chain: reflections benefit from prefiltered mip levels (roughness->LOD).
-            // Keep point-shadow cubes at 1 mip to save memory.
+            // Mip chain: reflections benefit from prefiltered mip levels (roughness->LOD), built with
+            // GenerateMips; without it only mip 0 is exposed. Keep point-shadow cubes at 1 mip to save memory.
             auto CalcMipLevels = [](std::uint32_t w, std::uint32_t h) -> UINT
                 {
                     const std::uint32_t m = (w > h) ? w : h;
@@ -192,7 +194,7 @@
                 // Optional SRV for sampling (not required for point shadows in this engine, but useful for future features).
                 if (srvFmt != DXGI_FORMAT_UNKNOWN)
                 {
-                    AllocateSRV(textureEntry, srvFmt, 1);
+                    AllocateSRV(textureEntry, srvFmt, 1, true);
                 }
             }
             else
@@ -200,8 +202,14 @@
                 // Color cubemap (currently used for point light shadows: R32_FLOAT distance map).
                 const DXGI_FORMAT dxFmt = ToDXGIFormat(format);
 
+                const bool generateMips = (mipLevels > 1u) && SupportsGenerateMips();
+
                 resourceDesc.Format = dxFmt;
                 resourceDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+                if (generateMips)
+                {
+                    resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+                }
 
                 D3D12_CLEAR_VALUE clearValue{};
                 clearValue.Format = dxFmt;
@@ -239,9 +247,11 @@
                 textureEntry.rtvAllFaces = AllocateRTVTexture2DArray(textureEntry.resource.Get(), dxFmt, 0, 6, textureEntry.rtvIndexAllFaces);
                 textureEntry.hasRTVAllFaces = true;
 
-                AllocateSRV(textureEntry, dxFmt, 1);
+                AllocateSRV(textureEntry, dxFmt, generateMips ? mipLevels : 1u, true);
             }
 
+            ChargeGpuMemory(textureEntry, memory::CurrentGpuMemoryTag());
+
             textures_[textureHandle.id] = std::move(textureEntry);
             return textureHandle;
         }
@@ -261,6 +271,7 @@
 
             TextureEntry entry = std::move(it->second);
             textures_.erase(it);
+            UnchargeGpuMemory(entry);
 
             // Keep the resource alive until GPU finishes the frame that referenced it.
             if (entry.resource)
@@ -268,15 +279,15 @@
                 CurrentFrame().deferredResources.push_back(std::move(entry.resource));
             }
 
-            // Recycle SRV index after the frame fence is completed (see BeginFrame()).
+            // Recycle SRV index after the GPU is done with this frame (see BeginFrame()).
             if (entry.hasSRV && entry.srvIndex != 0)
             {
-                CurrentFrame().deferredFreeSrv.push_back(entry.srvIndex);
+                FreeSrvIndex(entry.srvIndex);
             }
             // If we also created a cube-as-array SRV, recycle it too.
             if (entry.hasSRVArray && entry.srvIndexArray != 0)
             {
-                CurrentFrame().deferredFreeSrv.push_back(entry.srvIndexArray);
+                FreeSrvIndex(entry.srvIndexArray);
             }
             if (entry.hasRTV)
             {
@@ -13,7 +13,7 @@ void CreateRootSignature()
     //  t0      - albedo (Texture2D)
     //  t1      - directional shadow map (Texture2D<float>)
     //  t2      - lights (StructuredBuffer<GPULight>)
-    //  t3..t6  - spot shadow maps [0..3] (Texture2D<float>)
+    //  t3      - spot shadow atlas (Texture2D<float>; t4..t6 unused)
     //  t7..t10 - point distance cubemaps [0..3] (TextureCube<float>)
     //  t11     - shadow metadata (StructuredBuffer<ShadowDataSB>)
     //
@@ -26,6 +26,7 @@ void CreateRootSignature()
     //  t17 env cube (TextureCube)
     //  t18 env cube alias as Texture2DArray<float4> (same resource, 6 slices)
     //  t19 bone palette (StructuredBuffer<float4x4>) for GPU skinning in vertex shaders
+    //  t20 clustered light lists (StructuredBuffer<uint>, LightClusterBuilder layout)
     //
     // Bindless SRV array for SM6 shaders lives in space1:
     //  Texture2D gBindlessTex[] : register(t0, space1);
@@ -204,3 +205,100 @@ void CreateRootSignature()
         IID_PPV_ARGS(rootSig_.ReleaseAndGetAddressOf())),
         "DX12: CreateRootSignature failed");
 }
+
+void CreateComputeRootSignature()
+{
+    // Compute root signature layout:
+    //  [0]                         CBV(b0)  - dispatch constants (SetConstants)
+    //  [1..kMaxComputeSRVSlots]    SRV(t0..t3) - 1-descriptor tables fed by the regular bind commands
+    //  [1+kMaxComputeSRVSlots..]   UAV(u0..u3) - root UAVs (StorageBuffer only, no descriptors needed)
+    std::array<D3D12_DESCRIPTOR_RANGE1, kMaxComputeSRVSlots> ranges{};
+    for (UINT i = 0; i < kMaxComputeSRVSlots; ++i)
+    {
+        ranges[i].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        ranges[i].NumDescriptors = 1;
+        ranges[i].BaseShaderRegister = i;
+        ranges[i].RegisterSpace = 0;
+        ranges[i].Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE;
+        ranges[i].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+    }
+
+    std::array<D3D12_ROOT_PARAMETER1, 1 + kMaxComputeSRVSlots + kMaxUAVSlots> rootParams{};
+
+    rootParams[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+    rootParams[0].Descriptor.ShaderRegister = 0;
+    rootParams[0].Descriptor.RegisterSpace = 0;
+    rootParams[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+    for (UINT i = 0; i < kMaxComputeSRVSlots; ++i)
+    {
+        rootParams[1 + i].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        rootParams[1 + i].DescriptorTable.NumDescriptorRanges = 1;
+        rootParams[1 + i].DescriptorTable.pDescriptorRanges = &ranges[i];
+        rootParams[1 + i].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+    }
+
+    for (UINT i = 0; i < kMaxUAVSlots; ++i)
+    {
+        D3D12_ROOT_PARAMETER1& p = rootParams[1 + kMaxComputeSRVSlots + i];
+        p.ParameterType = D3D12_ROOT_PARAMETER_TYPE_UAV;
+        p.Descriptor.ShaderRegister = i;
+        p.Descriptor.RegisterSpace = 0;
+        p.Descriptor.Flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE;
+        p.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+    }
+
+    D3D12_ROOT_SIGNATURE_DESC1 rootSigDesc{};
+    rootSigDesc.NumParameters = static_cast<UINT>(rootParams.size());
+    rootSigDesc.pParameters = rootParams.data();
+    rootSigDesc.NumStaticSamplers = 0;
+    rootSigDesc.pStaticSamplers = nullptr;
+    rootSigDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+    D3D12_VERSIONED_ROOT_SIGNATURE_DESC ver{};
+    ver.Version = D3D_ROOT_SIGNATURE_VERSION_1_1;
+    ver.Desc_1_1 = rootSigDesc;
+
+    ComPtr<ID3DBlob> serialized;
+    ComPtr<ID3DBlob> error;
+
+    HRESULT hr = D3D12SerializeVersionedRootSignature(
+        &ver,
+        serialized.GetAddressOf(),
+        error.GetAddressOf());
+
+    if (FAILED(hr))
+    {
+        std::string msg = "DX12: D3D12SerializeVersionedRootSignature (compute) failed";
+        if (error)
+        {
+            msg += ": ";
+            msg += static_cast<const char*>(error->GetBufferPointer());
+        }
+        throw std::runtime_error(msg);
+    }
+
+    ThrowIfFailed(NativeDevice()->CreateRootSignature(
+        0,
+        serialized->GetBufferPointer(),
+        serialized->GetBufferSize(),
+        IID_PPV_ARGS(computeRootSig_.ReleaseAndGetAddressOf())),
+        "DX12: CreateRootSignature (compute) failed");
+}
+
+void CreateCommandSignatures()
+{
+    // Plain DrawIndexed records (rhi::DrawIndexedIndirectArgs): no root arguments change per draw,
+    // so no root signature is needed.
+    D3D12_INDIRECT_ARGUMENT_DESC arg{};
+    arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+    D3D12_COMMAND_SIGNATURE_DESC desc{};
+    desc.ByteStride = static_cast<UINT>(sizeof(DrawIndexedIndirectArgs));
+    desc.NumArgumentDescs = 1;
+    desc.pArgumentDescs = &arg;
+    desc.NodeMask = 0;
+
+    ThrowIfFailed(NativeDevice()->CreateCommandSignature(&desc, nullptr, IID_PPV_ARGS(drawIndexedSignature_.ReleaseAndGetAddressOf())),
+        "DX12: CreateCommandSignature (DrawIndexed) failed");
+}
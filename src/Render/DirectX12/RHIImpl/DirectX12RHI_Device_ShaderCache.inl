@@ -0,0 +1,223 @@
+        // ---------------- Shader bytecode cache ----------------
+        // Keyed by everything that changes the compiler output: stage, shader model, entry name, the
+        // final source text (the caller has already expanded includes and applied defines) and the
+        // debug/release flags. Entries live in memory for the session and in <cache dir>/shaders.
+        static constexpr std::uint32_t kShaderBytecodeMagic = 0x43535844u; // 'DXSC'
+        static constexpr std::uint32_t kShaderBytecodeVersion = 1u;
+
+        struct ShaderBytecodeHeader
+        {
+            std::uint32_t magic{ kShaderBytecodeMagic };
+            std::uint32_t version{ kShaderBytecodeVersion };
+            std::uint64_t key{ 0 };
+            std::uint64_t sizeBytes{ 0 };
+            std::uint64_t contentHash{ 0 };
+        };
+
+        static std::uint64_t ShaderBytecodeKey_(ShaderStage stage, ShaderModel shaderModel, std::string_view debugName, std::string_view source)
+        {
+            std::uint64_t key = 1469598103934665603ull;
+            key = HashPsoKeyPart_(key, kShaderBytecodeVersion);
+            key = HashPsoKeyPart_(key, static_cast<std::uint64_t>(stage));
+            key = HashPsoKeyPart_(key, static_cast<std::uint64_t>(shaderModel));
+#if defined(_DEBUG)
+            key = HashPsoKeyPart_(key, 1u);
+#else
+            key = HashPsoKeyPart_(key, 0u);
+#endif
+            key = HashPsoKeyPart_(key, debugName.size());
+            key = HashPsoBytes_(key, debugName.data(), debugName.size());
+            key = HashPsoKeyPart_(key, source.size());
+            key = HashPsoBytes_(key, source.data(), source.size());
+            return key;
+        }
+
+        std::filesystem::path ShaderBytecodePath_(std::uint64_t key) const
+        {
+            char name[32]{};
+            std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+            return pipelineCacheDir_ / "shaders" / name;
+        }
+
+        ComPtr<ID3DBlob> LoadShaderBytecode_(std::uint64_t key) const
+        {
+            if (pipelineCacheDir_.empty())
+            {
+                return {};
+            }
+
+            std::vector<std::byte> bytes;
+            if (!ReadPipelineCacheFile_(ShaderBytecodePath_(key), bytes))
+            {
+                return {};
+            }
+            std::span<const std::byte> in(bytes);
+            ShaderBytecodeHeader header{};
+            if (!ReadPod_(in, header)
+                || header.magic != kShaderBytecodeMagic || header.version != kShaderBytecodeVersion
+                || header.key != key || header.sizeBytes != in.size() || header.sizeBytes == 0
+                || header.contentHash != HashPsoBytes_(1469598103934665603ull, in.data(), in.size()))
+            {
+                return {};
+            }
+
+            ComPtr<ID3DBlob> blob;
+            if (FAILED(D3DCreateBlob(in.size(), &blob)) || !blob)
+            {
+                return {};
+            }
+            std::memcpy(blob->GetBufferPointer(), in.data(), in.size());
+            return blob;
+        }
+
+        void StoreShaderBytecode_(std::uint64_t key, ID3DBlob* code) const
+        {
+            if (pipelineCacheDir_.empty() || !code)
+            {
+                return;
+            }
+
+            ShaderBytecodeHeader header{};
+            header.key = key;
+            header.sizeBytes = code->GetBufferSize();
+            header.contentHash = HashPsoBytes_(1469598103934665603ull, code->GetBufferPointer(), code->GetBufferSize());
+
+            std::vector<std::byte> out;
+            out.reserve(sizeof(header) + code->GetBufferSize());
+            AppendPod_(out, header);
+            const auto* data = static_cast<const std::byte*>(code->GetBufferPointer());
+            out.insert(out.end(), data, data + code->GetBufferSize());
+
+            std::error_code ec;
+            std::filesystem::create_directories(pipelineCacheDir_ / "shaders", ec);
+            WritePipelineCacheFile_(ShaderBytecodePath_(key), out);
+        }
+
+        // Thread-safe: memory, then disk, then `compile()` (returns null on failure). Two threads missing the
+        // same key both compile; the first result inserted wins.
+        template <typename CompileFn>
+        ComPtr<ID3DBlob> GetOrCompileShaderBytecode_(std::uint64_t key, CompileFn&& compile)
+        {
+            {
+                std::lock_guard lock(shaderBytecodeMutex_);
+                if (auto it = shaderBytecode_.find(key); it != shaderBytecode_.end())
+                {
+                    return it->second;
+                }
+            }
+
+            ComPtr<ID3DBlob> code = LoadShaderBytecode_(key);
+            if (!code)
+            {
+                code = compile();
+                if (!code)
+                {
+                    return {};
+                }
+                StoreShaderBytecode_(key, code.Get());
+            }
+
+            std::lock_guard lock(shaderBytecodeMutex_);
+            return shaderBytecode_.emplace(key, std::move(code)).first->second;
+        }
+
+        static const char* DefaultShaderEntry_(ShaderStage stage)
+        {
+            return (stage == ShaderStage::Vertex) ? "VSMain"
+                : (stage == ShaderStage::Compute) ? "CSMain"
+                : (stage == ShaderStage::Amplification) ? "ASMain"
+                : (stage == ShaderStage::Mesh) ? "MSMain"
+                : "PSMain";
+        }
+
+        // SM5.1 via FXC (D3DCompile is thread-safe). Tries the debug name, then the stage's default entry.
+        static ComPtr<ID3DBlob> CompileFXCShader_(ShaderStage stage, std::string_view debugName, std::string_view source, std::string& outErrors)
+        {
+            const char* target = (stage == ShaderStage::Vertex) ? "vs_5_1"
+                : (stage == ShaderStage::Compute) ? "cs_5_1"
+                : "ps_5_1";
+
+            UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
+#if defined(_DEBUG)
+            flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+            flags |= D3DCOMPILE_OPTIMIZATION_LEVEL3;
+#endif
+
+            const std::string name(debugName);
+            ComPtr<ID3DBlob> code;
+            ComPtr<ID3DBlob> errors;
+            auto TryCompile = [&](const char* entry) -> bool
+                {
+                    code.Reset();
+                    errors.Reset();
+
+                    HRESULT hr = D3DCompile(
+                        source.data(),
+                        source.size(),
+                        name.c_str(),
+                        nullptr, nullptr,
+                        entry, target,
+                        flags, 0,
+                        &code, &errors);
+
+                    return SUCCEEDED(hr);
+                };
+
+            if (!TryCompile(name.c_str()) && !TryCompile(DefaultShaderEntry_(stage)))
+            {
+                if (errors)
+                {
+                    outErrors.assign(static_cast<const char*>(errors->GetBufferPointer()), errors->GetBufferSize());
+                }
+                return {};
+            }
+            return code;
+        }
+
+#if CORE_DX12_HAS_DXC
+        // SM6.1 via DXC (amplification/mesh stages: SM6.5). Tries the debug name, "main", then the stage's
+        // default entry. `compiler` and `includeHandler` are not free-threaded: callers off the render thread
+        // pass their own.
+        ComPtr<ID3DBlob> CompileDXCShader_(
+            ShaderStage stage,
+            std::string_view debugName,
+            std::string_view source,
+            std::string& outErrors,
+            IDxcCompiler3* compiler,
+            IDxcIncludeHandler* includeHandler) noexcept
+        {
+            const wchar_t* target = (stage == ShaderStage::Vertex) ? L"vs_6_1"
+                : (stage == ShaderStage::Compute) ? L"cs_6_1"
+                : (stage == ShaderStage::Amplification) ? L"as_6_5"
+                : (stage == ShaderStage::Mesh) ? L"ms_6_5"
+                : L"ps_6_1";
+
+            auto TryCompile = [&](std::string_view entry) -> ComPtr<ID3DBlob>
+                {
+                    ComPtr<ID3DBlob> out;
+                    std::string err;
+                    if (!CompileDXC_(source, target, entry, debugName, out, &err, compiler, includeHandler))
+                    {
+                        if (!err.empty())
+                        {
+                            outErrors = std::move(err);
+                        }
+                        return {};
+                    }
+                    outErrors.clear();
+                    return out;
+                };
+
+            ComPtr<ID3DBlob> code = TryCompile(debugName);
+            if (!code)
+            {
+                code = TryCompile("main");
+            }
+            if (!code)
+            {
+                code = TryCompile(DefaultShaderEntry_(stage));
+            }
+            return code;
+        }
+#endif
@@ -7,6 +7,8 @@ D3D_SHADER_MODEL highestShaderModel_{ D3D_SHADER_MODEL_5_1 };
 bool supportsViewInstancing_{ false };
 bool supportsVPAndRTArrayIndexFromAnyShader_{ false };
 bool supportsSM6_1_{ false };
+bool supportsMeshShaders_{ false };
+bool supportsTypedUAVLoadAdditionalFormats_{ false };
 
 #if CORE_DX12_HAS_DXC
 HMODULE dxcModule_{ nullptr };
@@ -24,6 +26,8 @@ std::uint32_t activeFrameIndex_{ 0 };
 // Submission tracking (decoupled from any particular swapchain)
 std::uint64_t submitIndex_{ 0 };
 bool hasSubmitted_{ false };
+SubmissionStats lastSubmissionStats_{};
+DeviceCounters deviceCounters_{};
 
 ComPtr<ID3D12GraphicsCommandList> cmdList_;
 
@@ -31,8 +35,46 @@ ComPtr<ID3D12Fence> fence_;
 HANDLE fenceEvent_{ nullptr };
 UINT64 fenceValue_{ 0 };
 
+// Dedicated copy queue for texture streaming (null if creation failed: uploads then use the direct queue).
+ComPtr<ID3D12CommandQueue> copyQueue_;
+ComPtr<ID3D12Fence> copyFence_;
+UINT64 copyFenceValue_{ 0 };
+
+// Async compute queue for BeginAsyncCompute..EndAsyncCompute segments (null if creation failed: the
+// segments are then recorded on the direct list in stream order). The list is reset per segment.
+ComPtr<ID3D12CommandQueue> computeQueue_;
+ComPtr<ID3D12Fence> computeFence_;
+UINT64 computeFenceValue_{ 0 };
+ComPtr<ID3D12GraphicsCommandList> computeCmdList_;
+
+// Timestamp queries: kFramesInFlight ranges of kTimestampQueriesPerFrame, resolved into the readback
+// buffer at the end of each frame (null if creation failed: zones are then ignored).
+ComPtr<ID3D12QueryHeap> timestampHeap_;
+ComPtr<ID3D12Resource> timestampReadback_;
+UINT64 timestampFrequency_{ 0 };
+std::vector<GpuTimestampZone> lastGpuZones_;
+
+// CommandReadbackTexture copies, oldest first (see TakeCompletedTextureReadbacks).
+std::deque<TextureReadbackRecord> textureReadbacks_;
+
+// Shared staging memory + the command lists used for copies recorded outside a frame.
+StagingRing staging_{};
+UploadContext directUpload_{ D3D12_COMMAND_LIST_TYPE_DIRECT };
+UploadContext copyUpload_{ D3D12_COMMAND_LIST_TYPE_COPY };
+
 // Shared root signature
 ComPtr<ID3D12RootSignature> rootSig_;
+// Compute root signature + ExecuteIndirect command signature (DrawIndexed arguments only)
+ComPtr<ID3D12RootSignature> computeRootSig_;
+ComPtr<ID3D12CommandSignature> drawIndexedSignature_;
+
+// GenerateMips pipeline, created on first use. mipGenCounters_ holds the shader's per-slice group
+// counters; the shader leaves them at zero.
+ComPtr<ID3D12RootSignature> mipGenRootSig_;
+ComPtr<ID3D12PipelineState> mipGenPso_;
+ComPtr<ID3D12Resource> mipGenCounters_;
+// QueueGenerateMips requests, recorded at the start of the first submission after their copy finished.
+std::vector<PendingMipGeneration> pendingMipGenerations_;
 
 // SRV heap (shader visible)
 ComPtr<ID3D12DescriptorHeap> srvHeap_;
@@ -40,8 +82,7 @@ UINT srvInc_{ 0 };
 
 #include "DirectX12RHI_ImGui_Private.inl"
 
-UINT nextSrvIndex_{ 1 };
-std::vector<UINT> freeSrv_;
+DescriptorSlotAllocator srvSlots_{};
 
 // RTV/DSV heaps for transient textures (swapchain has its own RTV/DSV)
 ComPtr<ID3D12DescriptorHeap> rtvHeap_;
@@ -76,4 +117,27 @@ std::unordered_map<std::uint32_t, bool> fences_;
 
 std::vector<PendingBufferUpdate> pendingBufferUpdates_;
 
-std::unordered_map<std::uint64_t, ComPtr<ID3D12PipelineState>> psoCache_;
\ No newline at end of file
+std::unordered_map<std::uint64_t, ComPtr<ID3D12PipelineState>> psoCache_;
+// psoCache_ keys per pipeline id, so a reloaded shader only drops the variants of pipelines using it.
+std::unordered_map<std::uint32_t, std::vector<std::uint64_t>> psoKeysByPipeline_;
+
+// Compiled shader bytecode by ShaderBytecodeKey_ (CreateShader/CreateShaderEx and PrecompileShader).
+std::mutex shaderBytecodeMutex_;
+std::unordered_map<std::uint64_t, ComPtr<ID3DBlob>> shaderBytecode_;
+
+// On-disk pipeline cache (LoadPipelineCache). The library reads from pipelineLibraryBlob_ for as long
+// as it lives, so the blob is never touched after creation. Load/Store on the library are serialized.
+std::filesystem::path pipelineCacheDir_;
+std::vector<std::byte> pipelineLibraryBlob_;
+ComPtr<ID3D12PipelineLibrary> pipelineLibrary_;
+ComPtr<ID3D12PipelineLibrary1> pipelineLibrary1_;
+std::mutex pipelineLibraryMutex_;
+
+// Warm-up: the variants the previous session recorded, PSOs the warm-up thread finished (moved into
+// psoCache_ on first use) and the variants this session used, in first-use order.
+std::vector<PipelineWarmKey> loadedWarmKeys_;
+std::thread pipelineWarmThread_;
+std::mutex warmedPsoMutex_;
+std::unordered_map<std::uint64_t, ComPtr<ID3D12PipelineState>> warmedPsos_;
+std::unordered_set<std::uint64_t> usedWarmKeys_;
+std::vector<PipelineWarmKey> usedWarmKeysInOrder_;
\ No newline at end of file
@@ -15,6 +15,7 @@ public:
     TextureHandle GetDepthTexture() const override;
     void Present() override;
     void Resize(Extent2D newExtent) override;
+    void WaitForNextFrame() override;
 
     std::uint32_t FrameIndex() const noexcept { return static_cast<std::uint32_t>(currBackBuffer_); }
 
@@ -50,6 +51,8 @@ public:
     void EnsureSizeUpToDate();
 
 private:
+    UINT SwapChainFlags() const noexcept;
+
     DX12Device& device_;
     DX12SwapChainDesc chainSwapDesc_;
 
@@ -64,4 +67,9 @@ private:
     Format depthFormat_{ Format::D24_UNORM_S8_UINT };
 
     std::vector<D3D12_RESOURCE_STATES> backBufferStates_;
+
+    // Low-latency mode: the frame latency waitable object is waited on once per Present.
+    HANDLE frameLatencyWaitable_{ nullptr };
+    std::atomic<std::uint32_t> pendingFrameWaits_{ 1 };
+    bool tearingSupported_{ false };
 };
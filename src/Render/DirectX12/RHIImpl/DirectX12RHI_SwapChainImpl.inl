@@ -10,6 +10,13 @@ DX12SwapChain::DX12SwapChain(DX12Device& owner, DX12SwapChainDesc desc)
     ComPtr<IDXGIFactory6> factory;
     ThrowIfFailed(CreateDXGIFactory2(0, IID_PPV_ARGS(&factory)), "DX12: CreateDXGIFactory2 failed");
 
+    if (chainSwapDesc_.base.allowTearing)
+    {
+        BOOL allowTearing = FALSE;
+        tearingSupported_ = SUCCEEDED(factory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing)))
+            && allowTearing == TRUE;
+    }
+
     DXGI_SWAP_CHAIN_DESC1 swapChainDesc{};
     swapChainDesc.Width = chainSwapDesc_.base.extent.width;
     swapChainDesc.Height = chainSwapDesc_.base.extent.height;
@@ -21,6 +28,7 @@ DX12SwapChain::DX12SwapChain(DX12Device& owner, DX12SwapChainDesc desc)
     swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
     swapChainDesc.Scaling = DXGI_SCALING_STRETCH;
     swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
+    swapChainDesc.Flags = SwapChainFlags();
 
     ComPtr<IDXGISwapChain1> swapChain1;
     ThrowIfFailed(factory->CreateSwapChainForHwnd(
@@ -34,6 +42,13 @@ DX12SwapChain::DX12SwapChain(DX12Device& owner, DX12SwapChainDesc desc)
     ThrowIfFailed(swapChain1.As(&swapChain_), "DX12: swapchain As IDXGISwapChain4 failed");
     ThrowIfFailed(factory->MakeWindowAssociation(chainSwapDesc_.hwnd, DXGI_MWA_NO_ALT_ENTER), "DX12: MakeWindowAssociation failed");
 
+    if (chainSwapDesc_.base.lowLatency)
+    {
+        ThrowIfFailed(swapChain_->SetMaximumFrameLatency(std::max(1u, chainSwapDesc_.base.maxFrameLatency)),
+            "DX12: SetMaximumFrameLatency failed");
+        frameLatencyWaitable_ = swapChain_->GetFrameLatencyWaitableObject();
+    }
+
     // RTV heap for backbuffers
     {
         D3D12_DESCRIPTOR_HEAP_DESC heapDesc{};
@@ -85,6 +100,11 @@ TextureHandle DX12SwapChain::GetDepthTexture() const
 
 DX12SwapChain::~DX12SwapChain()
 {
+    if (frameLatencyWaitable_)
+    {
+        CloseHandle(frameLatencyWaitable_);
+        frameLatencyWaitable_ = nullptr;
+    }
     device_.DestroyTexture(depthTexture_);
     depthTexture_ = TextureHandle{};
 }
@@ -122,7 +142,7 @@ void DX12SwapChain::Resize(Extent2D newExtent)
         static_cast<UINT>(newExtent.width),
         static_cast<UINT>(newExtent.height),
         bbFormat_,
-        0),
+        SwapChainFlags()),
         "DX12: ResizeBuffers failed");
 
     // Recreate RTVs.
@@ -153,8 +173,46 @@ void DX12SwapChain::EnsureSizeUpToDate()
 void DX12SwapChain::Present()
 {
     const UINT syncInterval = chainSwapDesc_.base.vsync ? 1u : 0u;
-    ThrowIfFailed(swapChain_->Present(syncInterval, 0), "DX12: Present failed");
+    // Tearing is only allowed for sync interval 0 (and not in exclusive fullscreen, which is never used here).
+    const UINT presentFlags = (syncInterval == 0u && tearingSupported_) ? DXGI_PRESENT_ALLOW_TEARING : 0u;
+    ThrowIfFailed(swapChain_->Present(syncInterval, presentFlags), "DX12: Present failed");
     currBackBuffer_ = swapChain_->GetCurrentBackBufferIndex();
+    pendingFrameWaits_.fetch_add(1, std::memory_order_release);
+}
+
+void DX12SwapChain::WaitForNextFrame()
+{
+    if (!frameLatencyWaitable_)
+    {
+        return;
+    }
+
+    // One wait per Present: frames that were skipped (minimized window) or not presented yet (pipelined
+    // frames) must not wait on a semaphore no Present will release.
+    std::uint32_t pending = pendingFrameWaits_.load(std::memory_order_acquire);
+    while (pending > 0u)
+    {
+        if (pendingFrameWaits_.compare_exchange_weak(pending, pending - 1u, std::memory_order_acq_rel))
+        {
+            profiling::ScopedZone zone{ "SwapChain::WaitForNextFrame" };
+            WaitForSingleObjectEx(frameLatencyWaitable_, 1000, TRUE);
+            return;
+        }
+    }
+}
+
+UINT DX12SwapChain::SwapChainFlags() const noexcept
+{
+    UINT flags = 0u;
+    if (chainSwapDesc_.base.lowLatency)
+    {
+        flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+    }
+    if (tearingSupported_)
+    {
+        flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+    }
+    return flags;
 }
 
 // Public factory functions
@@ -59,6 +59,19 @@
 			});
 		psoMainSkinned_[idx] = psoCache_.GetOrCreate(psoName + "_Skinned", vsSkinned, psSkinned);
 
+		// Weighted blended OIT variant: same VS, PS writes accumulation + coverage (SV_Target0/1).
+		{
+			auto oitDefs = defs;
+			oitDefs.push_back("CORE_WEIGHTED_OIT=1");
+			const auto psOit = shaderLibrary_.GetOrCreateShader(ShaderKey{
+				.stage = rhi::ShaderStage::Pixel,
+				.name = "PSMain",
+				.filePath = shaderPath.string(),
+				.defines = oitDefs
+				});
+			psoMainOit_[idx] = psoCache_.GetOrCreate(psoName + "_Oit", vs, psOit);
+		}
+
 		// Planar reflection variant: same shader but with CORE_PLANAR_CLIP enabled (VS outputs SV_ClipDistance0).
 		{
 			auto planarDefs = defs;
@@ -165,6 +178,8 @@
 	transparentState_.depth.writeEnable = false;
 	transparentState_.blend.enable = true;
 	transparentState_.rasterizer.cullMode = rhi::CullMode::None;
+	weightedOitState_ = transparentState_;
+	weightedOitState_.blend.mode = rhi::BlendMode::WeightedOit;
 
 
 	particleState_ = transparentState_;
@@ -327,8 +342,10 @@
 			const auto bloomCompositePath = corefs::ResolveAsset("shaders\\BloomComposite_dx12.hlsl");
 			const auto toneMapPath = corefs::ResolveAsset("shaders\\ToneMap_dx12.hlsl");
 			const auto fxaaPath = corefs::ResolveAsset("shaders\\FXAA_dx12.hlsl");
+			const auto upscalePath = corefs::ResolveAsset("shaders\\Upscale_dx12.hlsl");
 			const auto copyPath = corefs::ResolveAsset("shaders\\CopyToSwapChain_dx12.hlsl");
 			const auto planarCompPath = corefs::ResolveAsset("shaders\\PlanarComposite_dx12.hlsl");
+			const auto oitCompositePath = corefs::ResolveAsset("shaders\\WeightedOitComposite_dx12.hlsl");
 			const auto particlePath = corefs::ResolveAsset("shaders\\Particles_dx12.hlsl");
 
 			const auto vsG = shaderLibrary_.GetOrCreateShader(ShaderKey{
@@ -347,6 +364,27 @@
 				});
 			psoDeferredGBuffer_ = psoCache_.GetOrCreate("PSO_Deferred_GBuffer", vsG, psG);
 
+			// Meshlet variant (settings_.enableMeshShaders): same pixel shader, geometry from AS/MS.
+			if (device_.SupportsMeshShaders())
+			{
+				const auto gbufMeshletPath = corefs::ResolveAsset("shaders\\DeferredGBufferMeshlet_dx12.hlsl");
+				const auto asG = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Amplification,
+					.name = "AS_GBufferMeshlet",
+					.filePath = gbufMeshletPath.string(),
+					.defines = {},
+					.shaderModel = rhi::ShaderModel::SM6_5
+					});
+				const auto msG = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Mesh,
+					.name = "MS_GBufferMeshlet",
+					.filePath = gbufMeshletPath.string(),
+					.defines = {},
+					.shaderModel = rhi::ShaderModel::SM6_5
+					});
+				psoDeferredGBufferMeshlet_ = psoCache_.GetOrCreateMesh("PSO_Deferred_GBuffer_Meshlet", asG, msG, psG);
+			}
+
 			const auto vsGSkinned = shaderLibrary_.GetOrCreateShader(ShaderKey{
 				.stage = rhi::ShaderStage::Vertex,
 				.name = "VS_GBuffer",
@@ -418,6 +456,73 @@
 
 				psoSSAOForward_ = psoCache_.GetOrCreate("PSO_SSAO_Forward", vsSSAOForward, psSSAOForward);
 			}
+			// Compact G-buffer layout (settings_.compactGBuffer): the same writers, SSAO and resolve compiled
+			// with GBUFFER_COMPACT (GBufferCompact_dx12.hlsli).
+			{
+				const std::vector<std::string> defs = { "GBUFFER_COMPACT=1" };
+
+				const auto psGCompact = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Pixel,
+					.name = "PS_GBuffer",
+					.filePath = gbufPath.string(),
+					.defines = defs,
+					.shaderModel = rhi::ShaderModel::SM6_1
+					});
+				psoDeferredGBufferCompact_ = psoCache_.GetOrCreate("PSO_Deferred_GBuffer_Compact", vsG, psGCompact);
+				if (psoDeferredGBufferMeshlet_)
+				{
+					const auto gbufMeshletPath = corefs::ResolveAsset("shaders\\DeferredGBufferMeshlet_dx12.hlsl");
+					const auto asG = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Amplification,
+						.name = "AS_GBufferMeshlet",
+						.filePath = gbufMeshletPath.string(),
+						.defines = {},
+						.shaderModel = rhi::ShaderModel::SM6_5
+						});
+					const auto msG = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Mesh,
+						.name = "MS_GBufferMeshlet",
+						.filePath = gbufMeshletPath.string(),
+						.defines = {},
+						.shaderModel = rhi::ShaderModel::SM6_5
+						});
+					psoDeferredGBufferMeshletCompact_ = psoCache_.GetOrCreateMesh("PSO_Deferred_GBuffer_Meshlet_Compact", asG, msG, psGCompact);
+				}
+
+				const auto psGSkinnedCompact = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Pixel,
+					.name = "PS_GBuffer",
+					.filePath = gbufSkinnedPath.string(),
+					.defines = defs,
+					.shaderModel = rhi::ShaderModel::SM6_1
+					});
+				psoDeferredGBufferSkinnedCompact_ = psoCache_.GetOrCreate("PSO_Deferred_GBuffer_Skinned_Compact", vsGSkinned, psGSkinnedCompact);
+
+				const auto psFSCompact = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Pixel,
+					.name = "PS_DeferredLighting",
+					.filePath = lightPath.string(),
+					.defines = defs,
+					.shaderModel = rhi::ShaderModel::SM6_1
+					});
+				psoDeferredLightingCompact_ = psoCache_.GetOrCreate("PSO_Deferred_Lighting_Compact", vsFS, psFSCompact);
+
+				const auto vsSSAOCompact = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Vertex,
+					.name = "VS_Fullscreen",
+					.filePath = ssaoPath.string(),
+					.defines = defs,
+					.shaderModel = rhi::ShaderModel::SM6_1
+					});
+				const auto psSSAOCompact = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Pixel,
+					.name = "PS_SSAO",
+					.filePath = ssaoPath.string(),
+					.defines = defs,
+					.shaderModel = rhi::ShaderModel::SM6_1
+					});
+				psoSSAOCompact_ = psoCache_.GetOrCreate("PSO_SSAO_Compact", vsSSAOCompact, psSSAOCompact);
+			}
 			{
 				const auto vsB = shaderLibrary_.GetOrCreateShader(ShaderKey{
 					.stage = rhi::ShaderStage::Vertex,
@@ -559,7 +664,24 @@
 					});
 				psoFXAA_ = psoCache_.GetOrCreate("PSO_FXAA", vsFXAA, psFXAA);
 			}
-			// Billboard particles: procedural + textured variant.
+			{
+				const auto vsUpscale = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Vertex,
+					.name = "VS_Fullscreen",
+					.filePath = upscalePath.string(),
+					.defines = {},
+					.shaderModel = rhi::ShaderModel::SM6_1
+					});
+				const auto psUpscale = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Pixel,
+					.name = "PS_Upscale",
+					.filePath = upscalePath.string(),
+					.defines = {},
+					.shaderModel = rhi::ShaderModel::SM6_1
+					});
+				psoUpscale_ = psoCache_.GetOrCreate("PSO_Upscale", vsUpscale, psUpscale);
+			}
+			// Billboard particles: CPU instances + GPU particle pool.
 			{
 				const auto vsParticles = shaderLibrary_.GetOrCreateShader(ShaderKey{
 					.stage = rhi::ShaderStage::Vertex,
@@ -577,22 +699,23 @@
 					});
 				psoParticles_ = psoCache_.GetOrCreate("PSO_Particles", vsParticles, psParticles);
 
-				const std::vector<std::string> texturedDefs = { "PARTICLE_TEXTURED=1" };
-				const auto vsParticlesTextured = shaderLibrary_.GetOrCreateShader(ShaderKey{
+				// GPU particle pool: indirect draw of the sorted live slots (see GpuParticles_dx12.hlsl).
+				const std::vector<std::string> gpuDefs = { "PARTICLE_GPU=1" };
+				const auto vsParticlesGpu = shaderLibrary_.GetOrCreateShader(ShaderKey{
 					.stage = rhi::ShaderStage::Vertex,
-					.name = "VSMain",
+					.name = "VSMainGpu",
 					.filePath = particlePath.string(),
-					.defines = texturedDefs,
+					.defines = gpuDefs,
 					.shaderModel = rhi::ShaderModel::SM6_1
 					});
-				const auto psParticlesTextured = shaderLibrary_.GetOrCreateShader(ShaderKey{
+				const auto psParticlesGpu = shaderLibrary_.GetOrCreateShader(ShaderKey{
 					.stage = rhi::ShaderStage::Pixel,
-					.name = "PSMain",
+					.name = "PSMainGpu",
 					.filePath = particlePath.string(),
-					.defines = texturedDefs,
+					.defines = gpuDefs,
 					.shaderModel = rhi::ShaderModel::SM6_1
 					});
-				psoParticlesTextured_ = psoCache_.GetOrCreate("PSO_Particles_Textured", vsParticlesTextured, psParticlesTextured);
+				psoParticlesGpu_ = psoCache_.GetOrCreate("PSO_Particles_Gpu", vsParticlesGpu, psParticlesGpu);
 			}
 
 			// Copy scene color to swapchain (fullscreen blit).
@@ -647,6 +770,12 @@
 				copyToSwapChainState_ = deferredLightingState_;
 			}
 
+			// Dynamic resolution upscale: the pixel shader also writes the upsampled scene depth.
+			upscaleState_ = deferredLightingState_;
+			upscaleState_.depth.testEnable = true;
+			upscaleState_.depth.writeEnable = true;
+			upscaleState_.depth.depthCompareOp = rhi::CompareOp::Always;
+
 			// Planar composite (mask+color -> SceneColor), fullscreen alpha blend.
 			{
 				const auto vsPC = shaderLibrary_.GetOrCreateShader(ShaderKey{
@@ -675,5 +804,24 @@
 				planarCompositeState_.depth.stencil.front.compareOp = rhi::CompareOp::Equal;
 				planarCompositeState_.depth.stencil.back = planarCompositeState_.depth.stencil.front;
 			}
+
+			// Weighted blended OIT resolve (accum+coverage -> SceneColor), fullscreen alpha blend.
+			{
+				const auto vsOit = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Vertex,
+					.name = "VS_Fullscreen",
+					.filePath = oitCompositePath.string(),
+					.defines = {}
+					});
+				const auto psOit = shaderLibrary_.GetOrCreateShader(ShaderKey{
+					.stage = rhi::ShaderStage::Pixel,
+					.name = "PS_WeightedOitComposite",
+					.filePath = oitCompositePath.string(),
+					.defines = {}
+					});
+				psoWeightedOitComposite_ = psoCache_.GetOrCreate("PSO_WeightedOitComposite", vsOit, psOit);
+				weightedOitCompositeState_ = deferredLightingState_;
+				weightedOitCompositeState_.blend.enable = true;
+			}
 		}
 }
@@ -20,6 +20,27 @@
 
 				psoShadow_ = psoCache_.GetOrCreate("PSO_Shadow", vsShadow, psShadow);
 
+				// Meshlet variant for the directional cascades (settings_.enableMeshShaders), depth-only: no pixel shader.
+				if (device_.SupportsMeshShaders())
+				{
+					const std::filesystem::path shadowMeshletPath = corefs::ResolveAsset("shaders\\ShadowDepthMeshlet_dx12.hlsl");
+					const auto asShadow = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Amplification,
+						.name = "AS_ShadowMeshlet",
+						.filePath = shadowMeshletPath.string(),
+						.defines = {},
+						.shaderModel = rhi::ShaderModel::SM6_5
+						});
+					const auto msShadow = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Mesh,
+						.name = "MS_ShadowMeshlet",
+						.filePath = shadowMeshletPath.string(),
+						.defines = {},
+						.shaderModel = rhi::ShaderModel::SM6_5
+						});
+					psoShadowMeshlet_ = psoCache_.GetOrCreateMesh("PSO_Shadow_Meshlet", asShadow, msShadow, {});
+				}
+
 				const auto vsShadowSkinned = shaderLibrary_.GetOrCreateShader(ShaderKey{
 					.stage = rhi::ShaderStage::Vertex,
 					.name = "VS_Shadow",
@@ -34,6 +55,40 @@
 					});
 				psoShadowSkinned_ = psoCache_.GetOrCreate("PSO_Shadow_Skinned", vsShadowSkinned, psShadowSkinned);
 
+				// Editor object-ID buffer (RequestObjectIdPick), only drawn on frames that pick.
+				if (device_.SupportsTextureReadback())
+				{
+					const std::filesystem::path objectIdPath = corefs::ResolveAsset("shaders\\ObjectId_dx12.hlsl");
+					const std::filesystem::path objectIdSkinnedPath = corefs::ResolveAsset("shaders\\ObjectIdSkinned_dx12.hlsl");
+					const auto vsObjectId = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Vertex,
+						.name = "VS_ObjectId",
+						.filePath = objectIdPath.string(),
+						.defines = {}
+						});
+					const auto psObjectId = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Pixel,
+						.name = "PS_ObjectId",
+						.filePath = objectIdPath.string(),
+						.defines = {}
+						});
+					psoObjectId_ = psoCache_.GetOrCreate("PSO_ObjectId", vsObjectId, psObjectId);
+
+					const auto vsObjectIdSkinned = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Vertex,
+						.name = "VS_ObjectId",
+						.filePath = objectIdSkinnedPath.string(),
+						.defines = {}
+						});
+					const auto psObjectIdSkinned = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Pixel,
+						.name = "PS_ObjectId",
+						.filePath = objectIdSkinnedPath.string(),
+						.defines = {}
+						});
+					psoObjectIdSkinned_ = psoCache_.GetOrCreate("PSO_ObjectId_Skinned", vsObjectIdSkinned, psObjectIdSkinned);
+				}
+
 				shadowState_.depth.testEnable = true;
 				shadowState_.depth.writeEnable = true;
 				shadowState_.depth.depthCompareOp = rhi::CompareOp::LessEqual;
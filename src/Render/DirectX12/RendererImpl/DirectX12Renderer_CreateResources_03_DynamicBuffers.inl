@@ -12,6 +12,24 @@
 					lightsBuffer_ = device_.CreateBuffer(ld);
 				}
 
+				// Clustered light lists (t20): header + cluster table + light indices (LightClusterBuilder layout).
+				{
+					rhi::BufferDesc cd{};
+					cd.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					cd.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					cd.sizeInBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t) * LightClusterBuilder::BufferWords(lightClusters_.Grid(), lightClusters_.MaxIndices()));
+					cd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t));
+					cd.debugName = "LightClustersSB";
+					lightClustersBuffer_ = device_.CreateBuffer(cd);
+
+					// Same slot for passes rendered from other cameras: the header says "not clustered".
+					const auto header = LightClusterBuilder::DisabledHeader();
+					cd.sizeInBytes = static_cast<std::uint32_t>(sizeof(header));
+					cd.debugName = "LightClustersOffSB";
+					lightClustersOffBuffer_ = device_.CreateBuffer(cd);
+					device_.UpdateBuffer(lightClustersOffBuffer_, std::as_bytes(std::span{ header }));
+				}
+
 
 				// Shadow metadata structured buffer (t11) — holds spot VP rows + indices/bias, and point pos/range + indices/bias.
 				{
@@ -46,12 +64,14 @@
 					skinPaletteBuffer_ = device_.CreateBuffer(bd);
 				}
 
-				// Per-instance model matrices VB (slot1)
+				// Per-instance model matrices VB (slot1). Structured so the GPU culling pass can read it (t1),
+				// writable so CS_InstanceGather can expand the frame's instance refs into it.
 				{
 					rhi::BufferDesc id{};
-					id.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+					id.bindFlag = rhi::BufferBindFlag::StorageBuffer;
 					id.usageFlag = rhi::BufferUsageFlag::Dynamic;
 					id.sizeInBytes = instanceBufferSizeBytes_;
+					id.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(InstanceData));
 					id.debugName = "InstanceVB";
 					instanceBuffer_ = device_.CreateBuffer(id);
 				}
@@ -76,6 +96,228 @@
 					particleInstanceBuffer_ = device_.CreateBuffer(pd);
 				}
 
+				// GPU culling (compute): HiZ build + per-instance cull writing compacted instances and indirect args.
+				// The HiZ buffer itself depends on the swapchain size and is created in EnsureHiZBuffer.
+				if (device_.SupportsCompute())
+				{
+					const auto hiZPath = corefs::ResolveAsset("shaders\\HiZBuild_dx12.hlsl");
+					const auto cullPath = corefs::ResolveAsset("shaders\\GpuCull_dx12.hlsl");
+					const auto csHiZ = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Compute,
+						.name = "CS_HiZBuild",
+						.filePath = hiZPath.string(),
+						.defines = {}
+						});
+					const auto csCull = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Compute,
+						.name = "CS_GpuCull",
+						.filePath = cullPath.string(),
+						.defines = {}
+						});
+					if (csHiZ && csCull)
+					{
+						psoHiZBuild_ = device_.CreateComputePipeline("PSO_HiZBuild", csHiZ);
+						psoGpuCull_ = device_.CreateComputePipeline("PSO_GpuCull", csCull);
+					}
+
+					rhi::BufferDesc cd{};
+					cd.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					cd.usageFlag = rhi::BufferUsageFlag::Default;
+					cd.sizeInBytes = instanceBufferSizeBytes_;
+					cd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(InstanceData));
+					cd.debugName = "GpuCulledInstanceVB";
+					gpuCulledInstanceBuffer_ = device_.CreateBuffer(cd);
+
+					rhi::BufferDesc ad{};
+					ad.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					ad.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					ad.sizeInBytes = static_cast<std::uint32_t>(sizeof(rhi::DrawIndexedIndirectArgs) * kMaxGpuCullBatches);
+					ad.debugName = "GpuCullArgs";
+					gpuCullArgsBuffer_ = device_.CreateBuffer(ad);
+
+					rhi::BufferDesc bd{};
+					bd.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					bd.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					bd.sizeInBytes = static_cast<std::uint32_t>(sizeof(GpuCullBatchData) * kMaxGpuCullBatches);
+					bd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(GpuCullBatchData));
+					bd.debugName = "GpuCullBatchesSB";
+					gpuCullBatchBuffer_ = device_.CreateBuffer(bd);
+
+					rhi::BufferDesc ib{};
+					ib.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					ib.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					ib.sizeInBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t) * MaxGpuCullInstances());
+					ib.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t));
+					ib.debugName = "GpuCullInstanceBatchSB";
+					gpuCullInstanceBatchBuffer_ = device_.CreateBuffer(ib);
+				}
+
+				// GPU particle pool (compute): emit / simulate / bitonic sort, drawn with one indirect draw.
+				if (device_.SupportsCompute())
+				{
+					const auto particlesPath = corefs::ResolveAsset("shaders\\GpuParticles_dx12.hlsl");
+					auto CreateParticleKernel = [this, &particlesPath](std::string_view entry) -> rhi::PipelineHandle
+						{
+							const auto cs = shaderLibrary_.GetOrCreateShader(ShaderKey{
+								.stage = rhi::ShaderStage::Compute,
+								.name = std::string(entry),
+								.filePath = particlesPath.string(),
+								.defines = {}
+								});
+							return cs ? device_.CreateComputePipeline(std::string("PSO_") + std::string(entry), cs) : rhi::PipelineHandle{};
+						};
+					psoParticleInit_ = CreateParticleKernel("CS_ParticleInit");
+					psoParticleEmit_ = CreateParticleKernel("CS_ParticleEmit");
+					psoParticleBeginSimulate_ = CreateParticleKernel("CS_ParticleBeginSimulate");
+					psoParticleSimulate_ = CreateParticleKernel("CS_ParticleSimulate");
+					psoParticleSortLocal_ = CreateParticleKernel("CS_ParticleSortLocal");
+					psoParticleSortMerge_ = CreateParticleKernel("CS_ParticleSortMerge");
+					psoParticleSortStep_ = CreateParticleKernel("CS_ParticleSortStep");
+
+					rhi::BufferDesc pd{};
+					pd.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					pd.usageFlag = rhi::BufferUsageFlag::Default;
+					pd.sizeInBytes = static_cast<std::uint32_t>(sizeof(GpuParticleData) * kGpuParticlePoolSize);
+					pd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(GpuParticleData));
+					pd.debugName = "GpuParticlePool";
+					gpuParticleBuffer_ = device_.CreateBuffer(pd);
+
+					rhi::BufferDesc dd{};
+					dd.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					dd.usageFlag = rhi::BufferUsageFlag::Default;
+					dd.sizeInBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t) * kGpuParticlePoolSize);
+					dd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t));
+					dd.debugName = "GpuParticleDeadList";
+					gpuParticleDeadListBuffer_ = device_.CreateBuffer(dd);
+
+					rhi::BufferDesc sd{};
+					sd.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					sd.usageFlag = rhi::BufferUsageFlag::Default;
+					sd.sizeInBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t) * 2u * kGpuParticlePoolSize);
+					sd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t) * 2u);
+					sd.debugName = "GpuParticleSortList";
+					gpuParticleSortBuffer_ = device_.CreateBuffer(sd);
+
+					rhi::BufferDesc cd{};
+					cd.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					cd.usageFlag = rhi::BufferUsageFlag::Default;
+					cd.sizeInBytes = kGpuParticleCountersSizeBytes;
+					cd.debugName = "GpuParticleCounters";
+					gpuParticleCountersBuffer_ = device_.CreateBuffer(cd);
+
+					rhi::BufferDesc ed{};
+					ed.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					ed.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					ed.sizeInBytes = static_cast<std::uint32_t>(sizeof(GpuParticleEmitterData) * kMaxGpuParticleEmitters);
+					ed.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(GpuParticleEmitterData));
+					ed.debugName = "GpuParticleEmittersSB";
+					gpuParticleEmitterBuffer_ = device_.CreateBuffer(ed);
+
+					rhi::BufferDesc rd{};
+					rd.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					rd.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					rd.sizeInBytes = static_cast<std::uint32_t>(sizeof(GpuParticleSpawnRange) * kMaxGpuParticleEmitters);
+					rd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(GpuParticleSpawnRange));
+					rd.debugName = "GpuParticleSpawnRangesSB";
+					gpuParticleSpawnBuffer_ = device_.CreateBuffer(rd);
+				}
+
+				// Compute skinning pre-pass: skinned draws are skinned once per frame into a shared vertex cache.
+				if (device_.SupportsCompute())
+				{
+					const auto skinningPath = corefs::ResolveAsset("shaders\\SkinningCompute_dx12.hlsl");
+					const auto cs = shaderLibrary_.GetOrCreateShader(ShaderKey{
+						.stage = rhi::ShaderStage::Compute,
+						.name = "CS_SkinVertices",
+						.filePath = skinningPath.string(),
+						.defines = {}
+						});
+					psoSkinVertices_ = cs ? device_.CreateComputePipeline("PSO_SkinVertices", cs) : rhi::PipelineHandle{};
+
+					rhi::BufferDesc vd{};
+					vd.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					vd.usageFlag = rhi::BufferUsageFlag::Default;
+					vd.sizeInBytes = static_cast<std::uint32_t>(sizeof(SkinnedVertexDesc) * kSkinnedVertexCacheCapacity);
+					vd.structuredStrideBytes = skinnedStrideVDBytes;
+					vd.debugName = "SkinnedVertexCache";
+					skinnedVertexBuffer_ = device_.CreateBuffer(vd);
+				}
+
+				// Persistent instance transforms: per draw item slots updated in place, expanded per frame.
+				if (device_.SupportsCompute())
+				{
+					const auto transformsPath = corefs::ResolveAsset("shaders\\InstanceTransforms_dx12.hlsl");
+					auto CreateTransformKernel = [this, &transformsPath](std::string_view entry) -> rhi::PipelineHandle
+						{
+							const auto cs = shaderLibrary_.GetOrCreateShader(ShaderKey{
+								.stage = rhi::ShaderStage::Compute,
+								.name = std::string(entry),
+								.filePath = transformsPath.string(),
+								.defines = {}
+								});
+							return cs ? device_.CreateComputePipeline(std::string("PSO_") + std::string(entry), cs) : rhi::PipelineHandle{};
+						};
+					psoInstanceScatter_ = CreateTransformKernel("CS_InstanceScatter");
+					psoInstanceGather_ = CreateTransformKernel("CS_InstanceGather");
+
+					rhi::BufferDesc td{};
+					td.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					td.usageFlag = rhi::BufferUsageFlag::Default;
+					td.sizeInBytes = static_cast<std::uint32_t>(sizeof(InstanceData) * kMaxInstanceTransforms);
+					td.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(InstanceData));
+					td.debugName = "InstanceTransforms";
+					instanceTransformBuffer_ = device_.CreateBuffer(td);
+
+					rhi::BufferDesc ud{};
+					ud.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					ud.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					ud.sizeInBytes = static_cast<std::uint32_t>(sizeof(InstanceTransformUpdate) * kMaxInstanceTransformUpdates);
+					ud.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(InstanceTransformUpdate));
+					ud.debugName = "InstanceTransformUpdatesSB";
+					instanceTransformUpdateBuffer_ = device_.CreateBuffer(ud);
+
+					rhi::BufferDesc rd{};
+					rd.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					rd.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					rd.sizeInBytes = static_cast<std::uint32_t>(sizeof(InstanceRef) * MaxGpuCullInstances());
+					rd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(InstanceRef));
+					rd.debugName = "InstanceRefsSB";
+					instanceRefBuffer_ = device_.CreateBuffer(rd);
+				}
+
+				if (psoObjectId_)
+				{
+					rhi::BufferDesc od{};
+					od.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					od.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					od.sizeInBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t) * MaxGpuCullInstances());
+					od.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t));
+					od.debugName = "ObjectIdsSB";
+					objectIdBuffer_ = device_.CreateBuffer(od);
+				}
+
+				if (psoDeferredGBuffer_)
+				{
+					// The material table itself (materialTableBuffer_) is sized by EnsureMaterialTableBuffer.
+					rhi::BufferDesc md{};
+					md.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					md.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					md.sizeInBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t) * MaxGpuCullInstances());
+					md.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t));
+					md.debugName = "InstanceMaterialsSB";
+					instanceMaterialBuffer_ = device_.CreateBuffer(md);
+				}
+
+				if (device_.SupportsMultiDrawIndirect())
+				{
+					rhi::BufferDesc sd{};
+					sd.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+					sd.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					sd.sizeInBytes = static_cast<std::uint32_t>(sizeof(rhi::DrawIndexedIndirectArgs) * kMaxShadowIndirectDraws);
+					sd.debugName = "ShadowIndirectArgs";
+					shadowIndirectArgsBuffer_ = device_.CreateBuffer(sd);
+				}
+
 				// Persistent reflection capture cubemap.
 				// The texture is (re)created based on current RendererSettings (resolution).
 				EnsureReflectionCaptureResources();
@@ -1,4 +1,5 @@
 			renderGraph::RenderGraph graph;
+			graph.SetJobScheduler(settings_.enableParallelPassRecording ? jobScheduler_ : nullptr);
 
 			// -------------------------------------------------------------------------
 			// IMPORTANT (DX12): UpdateBuffer() is flushed at the beginning of SubmitCommandList().
@@ -8,23 +9,67 @@
 			// --- camera (used for fallback lights too) ---
 			const mathUtils::Vec3 camPos = scene.camera.position;
 
-			// Upload lights once per frame (t2 StructuredBuffer SRV)
-			const std::uint32_t lightCount = UploadLights(scene, camPos);
+			// ---------------- Deferred path (DX12) ----------------
+			const bool canDeferred =
+				settings_.enableDeferred &&
+				device_.GetBackend() == rhi::Backend::DirectX12 &&
+				psoDeferredGBuffer_ &&
+				instanceMaterialBuffer_ &&
+				psoDeferredLighting_ &&
+				fullscreenLayout_ &&
+				swapChain.GetDepthTexture();
+
+			// Weighted blended OIT: transparent items are batched like opaque ones (no distance sort) and
+			// resolved by a fullscreen composite in the forward / deferred transparent passes.
+			const bool weightedOit =
+				settings_.enableWeightedBlendedOit &&
+				device_.GetBackend() == rhi::Backend::DirectX12 &&
+				psoMainOit_[0] &&
+				psoWeightedOitComposite_ &&
+				fullscreenLayout_;
+
+			// Dynamic resolution (deferred only): the scene renders at renderExtent and is upscaled on present
+			// (RenderFrame_04_MainPass_01c). The scale follows the GPU time of the last finished frame; its
+			// timestamp zones are relative to the first one, so the latest end is the frame's span.
+			float gpuFrameMs = 0.0f;
+			for (const rhi::GpuTimestampZone& zone : device_.GetLastGpuTimestampZones())
+			{
+				gpuFrameMs = std::max(gpuFrameMs, static_cast<float>(zone.endMs));
+			}
+			const bool dynamicResolution = canDeferred && settings_.enableDynamicResolution && psoUpscale_;
+			float renderScale = 1.0f;
+			if (dynamicResolution)
+			{
+				renderScale = dynamicResolution_.Update(gpuFrameMs, DynamicResolutionParams{
+					.targetGpuMs = settings_.dynamicResolutionTargetMs,
+					.minScale = settings_.dynamicResolutionMinScale,
+					.maxScale = settings_.dynamicResolutionMaxScale });
+			}
+			else
+			{
+				dynamicResolution_.Reset();
+			}
+			const rhi::Extent2D renderExtent = ScaledExtent(swapChain.GetDesc().extent, renderScale);
+			const bool renderScaled =
+				renderExtent.width != swapChain.GetDesc().extent.width ||
+				renderExtent.height != swapChain.GetDesc().extent.height;
+			frameStats_.renderScale = renderScale;
+			frameStats_.gpuFrameMs = gpuFrameMs;
+
+			// Upload lights once per frame (t2 StructuredBuffer SRV) and their clusters (t20), built for the
+			// size the main view is rendered at.
+			const std::uint32_t lightCount = UploadLights(scene, camPos, renderExtent);
+			// Reflection captures and planar mirrors see the scene from another camera: they skip the
+			// clusters and loop the first lights only.
+			const std::uint32_t unclusteredLightCount = std::min(lightCount, kMaxUnclusteredLights);
 
 			// ---------------- Directional CSM (atlas) ----------------
 			// 3 cascades packed into a single D32 atlas:
 			//   atlas = (tileSize * cascadeCount) x tileSize.
 			// The shader selects the cascade and remaps UVs into the atlas.
-			constexpr std::uint32_t kMaxDirCascades = 3;
 			constexpr std::uint32_t dirTileSize = 2048; // user request
 			const std::uint32_t dirCascadeCount = std::clamp(settings_.dirShadowCascadeCount, 1u, kMaxDirCascades);
 			const rhi::Extent2D shadowExtent{ dirTileSize * dirCascadeCount, dirTileSize };
-			const auto shadowRG = graph.CreateTexture(renderGraph::RGTextureDesc{
-				.extent = shadowExtent,
-				.format = rhi::Format::D32_FLOAT,
-				.usage = renderGraph::ResourceUsage::DepthStencil,
-				.debugName = "DirShadowAtlas"
-				});
 
 			// Choose first directional light (or a default).
 			mathUtils::Vec3 lightDir = mathUtils::Normalize(mathUtils::Vec3(-0.4f, -1.0f, -0.3f)); // FROM light towards scene
@@ -51,6 +96,14 @@
 			const mathUtils::Mat4 cameraViewProj = cameraProj * cameraView;
 			const mathUtils::Frustum cameraFrustum = mathUtils::ExtractFrustumRH_ZO(cameraViewProj);
 			const bool doFrustumCulling = settings_.enableFrustumCulling;
+			// GPU culling takes over the opaque forward batches (RenderFrame_03a); transparent and mirror items stay on the CPU.
+			const bool gpuCullMain = doFrustumCulling && settings_.enableGpuCulling && !settings_.enableDeferred &&
+				psoGpuCull_ && psoHiZBuild_ && gpuCulledInstanceBuffer_ &&
+				scene.drawItems.size() <= MaxGpuCullInstances();
+			// Forward depth prepass (RenderFrame_03): the main keys of DrawItemPrep::PrepassOccluder items, or of every
+			// item when depthPrepassComplete - only then may the main pass skip its depth writes.
+			const bool doDepthPrepass = settings_.enableDepthPrepass && !settings_.enableDeferred;
+			const bool depthPrepassComplete = doDepthPrepass && settings_.depthPrepassMinScreenSize <= 0.0f;
 
 			// Limit how far we render directional shadows to keep resolution usable.
 			const float shadowFar = std::min(scene.camera.farZ, settings_.dirShadowDistance);
@@ -175,12 +228,181 @@
 				dirCascadeVP[c] = lightProj * lightView;
 			}
 
+			// Amortized schedule: cascade 0 renders every frame, the far cascades take turns every
+			// dirShadowFarCascadeInterval frames. The atlas then persists and a cascade that is not due keeps its
+			// tile and the matrix it was rendered with. A new atlas or light direction renders every cascade.
+			const std::uint32_t farCascadeInterval = std::max(1u, settings_.dirShadowFarCascadeInterval);
+			const bool amortizeCascades = (farCascadeInterval > 1u) && (dirCascadeCount > 1u);
+			std::array<bool, kMaxDirCascades> dirCascadeDue{};
+			dirCascadeDue.fill(true);
+			renderGraph::RGTextureHandle shadowRG{};
+			if (amortizeCascades && EnsureCascadeScheduleAtlas(shadowExtent))
+			{
+				CascadeScheduleState& schedule = dirCascadeSchedule_;
+				if (mathUtils::Dot(schedule.lightDir, lightDir) < 0.9999f)
+				{
+					schedule.rendered.fill(false);
+					schedule.lightDir = lightDir;
+				}
+
+				const std::uint64_t frame = schedule.frame++;
+				for (std::uint32_t c = 1; c < dirCascadeCount; ++c)
+				{
+					dirCascadeDue[c] = !schedule.rendered[c] || (frame % farCascadeInterval) == ((c - 1u) % farCascadeInterval);
+				}
+				for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+				{
+					if (dirCascadeDue[c])
+					{
+						schedule.viewProj[c] = dirCascadeVP[c];
+						schedule.rendered[c] = true;
+					}
+					else
+					{
+						dirCascadeVP[c] = schedule.viewProj[c];
+					}
+				}
+
+				shadowRG = graph.ImportTexture(schedule.atlas, renderGraph::RGTextureDesc{
+					.extent = shadowExtent,
+					.format = rhi::Format::D32_FLOAT,
+					.usage = renderGraph::ResourceUsage::DepthStencil,
+					.debugName = "DirShadowAtlasPersistent"
+					});
+			}
+			else
+			{
+				ReleaseCascadeScheduleAtlas();
+				shadowRG = graph.CreateTexture(renderGraph::RGTextureDesc{
+					.extent = shadowExtent,
+					.format = rhi::Format::D32_FLOAT,
+					.usage = renderGraph::ResourceUsage::DepthStencil,
+					.debugName = "DirShadowAtlas"
+					});
+			}
+			const bool persistentDirAtlas = amortizeCascades && static_cast<bool>(dirCascadeSchedule_.atlas);
+
+			// Light-space boxes of the cascades (ortho frusta) for per-cascade caster culling.
+			const bool cascadeCasterCulling = settings_.enableCascadeCasterCulling;
+			std::array<mathUtils::Frustum, kMaxDirCascades> dirCascadeFrustums{};
+			for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+			{
+				dirCascadeFrustums[c] = mathUtils::ExtractFrustumRH_ZO(dirCascadeVP[c]);
+			}
+
+			// Point lights that get a layered (single pass) cubemap shadow, in the order the shadow passes pick
+			// them, with the frusta of their faces for per-face caster culling.
+			constexpr float pointShadowNearZ = 0.01f;
+			const bool buildLayeredPointShadow = (psoPointShadowLayered_ && !disablePointShadowLayered_) &&
+				device_.SupportsShaderModel6() && device_.SupportsVPAndRTArrayIndexFromAnyShader();
+			const bool pointShadowFaceCulling = settings_.enablePointShadowFaceCulling;
+			std::uint32_t layeredPointShadowCount = 0;
+			std::array<std::array<mathUtils::Frustum, kPointShadowFaces>, kMaxPointShadows> layeredPointShadowFaceFrustums{};
+			if (buildLayeredPointShadow)
+			{
+				const std::size_t shadowLightCount = std::min<std::size_t>(scene.lights.size(), kMaxLights);
+				for (std::size_t lightIndex = 0; lightIndex < shadowLightCount && layeredPointShadowCount < kMaxPointShadows; ++lightIndex)
+				{
+					const auto& light = scene.lights[lightIndex];
+					if (light.type != LightType::Point)
+					{
+						continue;
+					}
+					const mathUtils::Mat4 proj90 =
+						mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(90.0f), 1.0f, pointShadowNearZ, std::max(1.0f, light.range));
+					for (std::uint32_t face = 0; face < kPointShadowFaces; ++face)
+					{
+						layeredPointShadowFaceFrustums[layeredPointShadowCount][face] =
+							mathUtils::ExtractFrustumRH_ZO(proj90 * CubeFaceViewRH(light.position, static_cast<int>(face)));
+					}
+					++layeredPointShadowCount;
+				}
+			}
+
 			// For legacy constant-buffer field (kept for compatibility with older shaders).
 			const mathUtils::Mat4 dirLightViewProj = dirCascadeVP[0];
 
+			// Spot shadows: the spot lights whose cone is in view, the kMaxSpotShadows with the largest screen
+			// coverage, each with an atlas tile sized by that coverage (ShadowAtlas.cppm). Lights that get no tile
+			// stay unshadowed. The light frusta cull the casters per spot (DrawItemPrep::spotShadowMask).
 			std::vector<SpotShadowRec> spotShadows;
-			std::vector<PointShadowRec> pointShadows;
+			std::array<mathUtils::Frustum, kMaxSpotShadows> spotShadowFrustums{};
 			spotShadows.reserve(kMaxSpotShadows);
+			const std::uint32_t spotAtlasSize = std::max(settings_.spotShadowAtlasSize, 256u);
+			{
+				struct SpotShadowCandidate
+				{
+					std::uint32_t lightIndex{ 0 };
+					float coverage{ 0.0f };
+				};
+				std::vector<SpotShadowCandidate> candidates;
+				const std::size_t shadowLightCount = std::min<std::size_t>(scene.lights.size(), kMaxLights);
+				const float fovY = mathUtils::DegToRad(scene.camera.fovYDeg);
+				for (std::size_t lightIndex = 0; lightIndex < shadowLightCount; ++lightIndex)
+				{
+					const auto& light = scene.lights[lightIndex];
+					if (light.type != LightType::Spot)
+					{
+						continue;
+					}
+					const mathUtils::Vec4 sphere = rendern::SpotLightBoundingSphere(light.position, light.direction,
+						std::max(1.0f, light.range), light.outerHalfAngleDeg);
+					const mathUtils::Vec3 center(sphere.x, sphere.y, sphere.z);
+					if (doFrustumCulling && !mathUtils::IntersectsSphere(cameraFrustum, center, sphere.w))
+					{
+						continue;
+					}
+					candidates.push_back(SpotShadowCandidate{
+						static_cast<std::uint32_t>(lightIndex), rendern::MeshLodScreenSize(center, sphere.w, camPos, fovY) });
+				}
+				std::stable_sort(candidates.begin(), candidates.end(), [](const SpotShadowCandidate& a, const SpotShadowCandidate& b)
+					{
+						return a.coverage > b.coverage;
+					});
+				if (candidates.size() > kMaxSpotShadows)
+				{
+					candidates.resize(kMaxSpotShadows);
+				}
+
+				std::array<std::uint32_t, kMaxSpotShadows> tileSizes{};
+				for (std::size_t i = 0; i < candidates.size(); ++i)
+				{
+					tileSizes[i] = rendern::SpotShadowTileSize(candidates[i].coverage,
+						std::min(settings_.spotShadowMaxTileSize, spotAtlasSize), settings_.spotShadowMinTileSize);
+				}
+				std::array<ShadowAtlasTile, kMaxSpotShadows> tiles{};
+				rendern::PackShadowAtlas(std::span<const std::uint32_t>(tileSizes.data(), candidates.size()),
+					spotAtlasSize, settings_.spotShadowMinTileSize, std::span<ShadowAtlasTile>(tiles.data(), candidates.size()));
+
+				for (std::size_t i = 0; i < candidates.size(); ++i)
+				{
+					if (!tiles[i].Valid())
+					{
+						continue;
+					}
+					const auto& light = scene.lights[candidates[i].lightIndex];
+					const mathUtils::Vec3 lightDirLocal = mathUtils::Normalize(light.direction);
+					const mathUtils::Vec3 upVector = (std::abs(mathUtils::Dot(lightDirLocal, mathUtils::Vec3(0, 1, 0))) > 0.99f)
+						? mathUtils::Vec3(0, 0, 1)
+						: mathUtils::Vec3(0, 1, 0);
+					const mathUtils::Mat4 lightView = mathUtils::LookAt(light.position, light.position + lightDirLocal, upVector);
+
+					const float outerHalf = std::max(1.0f, light.outerHalfAngleDeg);
+					const float farZ = std::max(1.0f, light.range);
+					const float nearZ = std::max(0.5f, farZ * 0.02f);
+					const mathUtils::Mat4 lightProj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(outerHalf * 2.0f), 1.0f, nearZ, farZ);
+
+					SpotShadowRec rec{};
+					rec.viewProj = lightProj * lightView;
+					rec.tile = tiles[i];
+					rec.lightIndex = candidates[i].lightIndex;
+					spotShadowFrustums[spotShadows.size()] = mathUtils::ExtractFrustumRH_ZO(rec.viewProj);
+					spotShadows.push_back(rec);
+				}
+			}
+			const std::uint32_t spotShadowCount = static_cast<std::uint32_t>(spotShadows.size());
+
+			std::vector<PointShadowRec> pointShadows;
 			pointShadows.reserve(kMaxPointShadows);
 
 
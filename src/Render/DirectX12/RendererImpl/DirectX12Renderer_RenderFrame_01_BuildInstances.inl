@@ -1,3 +1,4 @@
 #include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_ShadowAndLayeredShadow.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_MainTransparentReflectionPacking.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_SortAndBatch.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_FinalizeAndUpload.inl"
\ No newline at end of file
@@ -11,7 +11,15 @@ const std::uint32_t planarMirrorBase = transparentBase + static_cast<std::uint32
 
 const std::uint32_t transparentEnd =
 planarMirrorBase + static_cast<std::uint32_t>(planarMirrorInstances.size());
-const std::uint32_t layeredShadowBase = AlignUpU32(transparentEnd, 6u);
+std::array<std::uint32_t, kMaxDirCascades> cascadeShadowBase{};
+std::uint32_t cascadeShadowEnd = transparentEnd;
+for (std::uint32_t c = 0; c < kMaxDirCascades; ++c)
+{
+	cascadeShadowBase[c] = cascadeShadowEnd;
+	cascadeShadowEnd += static_cast<std::uint32_t>(cascadeShadowInstances[c].size());
+}
+const std::uint32_t spotShadowBase = cascadeShadowEnd;
+const std::uint32_t layeredShadowBase = spotShadowBase + static_cast<std::uint32_t>(spotShadowInstances.size());
 const std::uint32_t layeredReflectionBase =
 AlignUpU32(layeredShadowBase + static_cast<std::uint32_t>(shadowInstancesLayered.size()), 6u);
 
@@ -23,13 +31,34 @@ for (auto& mbatch : mainBatches)
 {
 	mbatch.instanceOffset += mainBase;
 }
+for (auto& pbatch : prepassBatches)
+{
+	pbatch.instanceOffset += mainBase;
+}
 for (auto& cbatch : captureMainBatchesNoCull)
 {
 	cbatch.instanceOffset += captureMainBase;
 }
-for (auto& lbatch : shadowBatchesLayered)
+for (std::uint32_t c = 0; c < kMaxDirCascades; ++c)
+{
+	for (auto& cbatch : cascadeShadowBatches[c])
+	{
+		cbatch.instanceOffset += cascadeShadowBase[c];
+	}
+}
+for (auto& batches : spotShadowBatches)
 {
-	lbatch.instanceOffset += layeredShadowBase;
+	for (auto& sbatch : batches)
+	{
+		sbatch.instanceOffset += spotShadowBase;
+	}
+}
+for (auto& batches : pointShadowBatchesLayered)
+{
+	for (auto& lbatch : batches)
+	{
+		lbatch.instanceOffset += layeredShadowBase;
+	}
 }
 for (auto& rbatch : reflectionBatchesLayered)
 {
@@ -40,6 +69,7 @@ for (auto& mirrorDraw : planarMirrorDraws)
 	mirrorDraw.instanceOffset = planarMirrorBase + mirrorDraw.instanceOffset;
 }
 
+// transparentTmp is already far -> near (draw key order), or in batch order with weighted blended OIT.
 transparentDrawsScratch_.clear();
 transparentDrawsScratch_.reserve(transparentTmp.size());
 auto& transparentDraws = transparentDrawsScratch_;
@@ -50,45 +80,39 @@ for (const auto& transparentInst : transparentTmp)
 	transparentDraw.material = transparentInst.material;
 	transparentDraw.materialHandle = transparentInst.materialHandle;
 	transparentDraw.instanceOffset = transparentBase + transparentInst.localInstanceOffset;
+	transparentDraw.instanceCount = transparentInst.instanceCount;
 	transparentDraw.dist2 = transparentInst.dist2;
 	transparentDraws.push_back(transparentDraw);
 }
 
-std::sort(transparentDraws.begin(), transparentDraws.end(),
-	[](const TransparentDraw& first, const TransparentDraw& second)
-	{
-		return first.dist2 > second.dist2; // far -> near
-	});
-
-combinedInstancesScratch_.clear();
-auto& combinedInstances = combinedInstancesScratch_;
+std::pmr::vector<InstanceRef> combinedInstanceRefs{ &frameArena_ };
 const std::uint32_t finalCount =
 layeredReflectionBase + static_cast<std::uint32_t>(reflectionInstancesLayered.size());
 
-combinedInstances.clear();
-combinedInstances.reserve(finalCount);
+combinedInstanceRefs.reserve(finalCount);
 
 // 1) normal groups
-combinedInstances.insert(combinedInstances.end(), shadowInstances.begin(), shadowInstances.end());
-combinedInstances.insert(combinedInstances.end(), mainInstances.begin(), mainInstances.end());
-combinedInstances.insert(combinedInstances.end(), captureMainInstancesNoCull.begin(), captureMainInstancesNoCull.end());
-combinedInstances.insert(combinedInstances.end(), transparentInstances.begin(), transparentInstances.end());
-combinedInstances.insert(combinedInstances.end(), planarMirrorInstances.begin(), planarMirrorInstances.end());
-
-// 2) pad up to layeredShadowBase (between transparent/planar-mirror and layered shadow)
-if (combinedInstances.size() < layeredShadowBase)
-	combinedInstances.resize(layeredShadowBase);
-
-// 3) layered shadow
-combinedInstances.insert(combinedInstances.end(),
+combinedInstanceRefs.insert(combinedInstanceRefs.end(), shadowInstances.begin(), shadowInstances.end());
+combinedInstanceRefs.insert(combinedInstanceRefs.end(), mainInstances.begin(), mainInstances.end());
+combinedInstanceRefs.insert(combinedInstanceRefs.end(), captureMainInstancesNoCull.begin(), captureMainInstancesNoCull.end());
+combinedInstanceRefs.insert(combinedInstanceRefs.end(), transparentInstances.begin(), transparentInstances.end());
+combinedInstanceRefs.insert(combinedInstanceRefs.end(), planarMirrorInstances.begin(), planarMirrorInstances.end());
+for (const auto& cascadeInstances : cascadeShadowInstances)
+{
+	combinedInstanceRefs.insert(combinedInstanceRefs.end(), cascadeInstances.begin(), cascadeInstances.end());
+}
+combinedInstanceRefs.insert(combinedInstanceRefs.end(), spotShadowInstances.begin(), spotShadowInstances.end());
+
+// 2) layered shadow (right after the per-cascade and spot shadow groups)
+combinedInstanceRefs.insert(combinedInstanceRefs.end(),
 	shadowInstancesLayered.begin(), shadowInstancesLayered.end());
 
-// 4) pad up to layeredReflectionBase (between layered shadow and layered reflection)
-if (combinedInstances.size() < layeredReflectionBase)
-	combinedInstances.resize(layeredReflectionBase);
+// 3) pad up to layeredReflectionBase (between layered shadow and layered reflection)
+if (combinedInstanceRefs.size() < layeredReflectionBase)
+	combinedInstanceRefs.resize(layeredReflectionBase, kNoInstanceRef);
 
-// 5) layered reflection
-combinedInstances.insert(combinedInstances.end(),
+// 4) layered reflection
+combinedInstanceRefs.insert(combinedInstanceRefs.end(),
 	reflectionInstancesLayered.begin(), reflectionInstancesLayered.end());
 
 assert(shadowBase == 0u);
@@ -96,21 +120,170 @@ assert(mainBase == shadowInstances.size());
 assert(captureMainBase == shadowInstances.size() + mainInstances.size());
 assert(transparentBase == captureMainBase + captureMainInstancesNoCull.size());
 assert(planarMirrorBase == transparentBase + transparentInstances.size());
-assert(layeredShadowBase >= planarMirrorBase + planarMirrorInstances.size());
+assert(cascadeShadowBase[0] == planarMirrorBase + planarMirrorInstances.size());
+assert(spotShadowBase == cascadeShadowEnd);
+assert(layeredShadowBase == spotShadowBase + spotShadowInstances.size());
 assert(layeredReflectionBase >= layeredShadowBase + shadowInstancesLayered.size());
-assert(combinedInstances.size() == finalCount);
+assert(combinedInstanceRefs.size() == finalCount);
+
+// Model matrix behind an entry of the combined list (CPU-side tests of a batch's instances).
+auto CombinedInstanceModel = [&combinedInstanceRefs, &drawItemModels](std::uint32_t instanceIndex) -> const mathUtils::Mat4&
+	{
+		return drawItemModels[combinedInstanceRefs[instanceIndex] & kInstanceRefSlotMask];
+	};
 
 const std::uint32_t instStride = static_cast<std::uint32_t>(sizeof(InstanceData));
 std::uint32_t particleCount = 0u;
 
-if (!combinedInstances.empty())
+if (combinedInstanceRefs.size() > MaxGpuCullInstances())
+{
+	throw std::runtime_error("DX12Renderer: instance buffer overflow (increase instanceBufferSizeBytes_)");
+}
+if (gpuInstanceTransforms)
+{
+	// The refs go up as they are; InstanceTransforms expands them into instanceBuffer_.
+	device_.UpdateBuffer(instanceRefBuffer_, std::as_bytes(std::span{ combinedInstanceRefs }));
+}
+else if (!combinedInstanceRefs.empty())
+{
+	combinedInstancesScratch_.resize(combinedInstanceRefs.size());
+	for (std::size_t instanceIndex = 0; instanceIndex < combinedInstanceRefs.size(); ++instanceIndex)
+	{
+		const InstanceRef ref = combinedInstanceRefs[instanceIndex];
+		InstanceData& inst = combinedInstancesScratch_[instanceIndex];
+		if (ref == kNoInstanceRef)
+		{
+			inst = InstanceData{};
+			continue;
+		}
+		const std::uint32_t slot = ref & kInstanceRefSlotMask;
+		inst = InstanceRows(drawItemModels[slot], scene.drawItems[slot].mesh->GetResource());
+		if (const std::uint32_t facePlusOne = ref >> kInstanceRefFaceShift; facePlusOne != 0u)
+		{
+			inst.i0.w = static_cast<float>(facePlusOne - 1u);
+		}
+	}
+	device_.UpdateBuffer(instanceBuffer_, std::as_bytes(std::span{ combinedInstancesScratch_ }));
+}
+
+// Deferred material table: entry 0 = items without a material, entry h = the material with handle id h.
+// Materials are edited in place (there is no revision to compare), so the table is packed every frame and
+// only uploaded when it differs from the last upload. The main instances get their entry next to them.
+if (canDeferred)
 {
-	const std::size_t bytes = combinedInstances.size() * sizeof(InstanceData);
-	if (bytes > instanceBufferSizeBytes_)
+	const auto materials = scene.GetMaterials();
+	materialTableScratch_.clear();
+	materialTableScratch_.reserve(materials.size() + 1u);
+	materialTableScratch_.push_back(PackMaterialGpu(ItemMaterialParams(MaterialHandle{}), MaterialPerm::None, EnvSource::Skybox));
+	for (const Material& material : materials)
+	{
+		materialTableScratch_.push_back(PackMaterialGpu(material.params, EffectivePerm(material), material.envSource));
+	}
+	const bool tableRecreated = EnsureMaterialTableBuffer(static_cast<std::uint32_t>(materialTableScratch_.size()));
+	if (tableRecreated || materialTableScratch_ != materialTableUploaded_)
 	{
-		throw std::runtime_error("DX12Renderer: instance buffer overflow (increase instanceBufferSizeBytes_)");
+		device_.UpdateBuffer(materialTableBuffer_, std::as_bytes(std::span{ materialTableScratch_ }));
+		materialTableUploaded_.swap(materialTableScratch_);
+	}
+
+	if (!mainInstances.empty())
+	{
+		std::pmr::vector<std::uint32_t> instanceMaterials(mainInstances.size(), 0u, &frameArena_);
+		for (std::size_t instanceIndex = 0; instanceIndex < mainInstances.size(); ++instanceIndex)
+		{
+			const std::uint32_t materialId = scene.drawItems[mainInstances[instanceIndex] & kInstanceRefSlotMask].material.id;
+			instanceMaterials[instanceIndex] = materialId <= materials.size() ? materialId : 0u;
+		}
+		device_.UpdateBuffer(instanceMaterialBuffer_, std::as_bytes(std::span{ instanceMaterials }), sizeof(std::uint32_t) * mainBase);
 	}
-	device_.UpdateBuffer(instanceBuffer_, std::as_bytes(std::span{ combinedInstances }));
+}
+
+// Changed transforms: scattered into their slots by InstanceTransforms, or (level load, first frame)
+// all slots in one upload when there are more than the update buffer holds.
+std::uint32_t instanceTransformUpdateCount = 0u;
+if (gpuInstanceTransforms && !dirtyTransformSlots.empty())
+{
+	if (dirtyTransformSlots.size() > kMaxInstanceTransformUpdates)
+	{
+		device_.UpdateBuffer(instanceTransformBuffer_, std::as_bytes(std::span{ instanceTransformResident_ }));
+	}
+	else
+	{
+		instanceTransformUpdatesScratch_.clear();
+		for (const std::uint32_t slot : dirtyTransformSlots)
+		{
+			InstanceTransformUpdate update{};
+			update.slot[0] = slot;
+			update.rows = instanceTransformResident_[slot];
+			instanceTransformUpdatesScratch_.push_back(update);
+		}
+		device_.UpdateBuffer(instanceTransformUpdateBuffer_, std::as_bytes(std::span{ instanceTransformUpdatesScratch_ }));
+		instanceTransformUpdateCount = static_cast<std::uint32_t>(instanceTransformUpdatesScratch_.size());
+	}
+}
+
+// Shadow and pre-depth passes draw from one argument buffer: a record per shadow batch
+// (shadowBatches, every layered point shadow's batches, every cascade's and spot's batches, then the prepass batches), uploaded
+// once and shared by every pass of the frame.
+std::uint32_t shadowArgsBase = kNoShadowIndirectArgs;
+std::uint32_t prepassArgsBase = kNoShadowIndirectArgs;
+std::array<std::uint32_t, kMaxPointShadows> pointShadowArgsBase{};
+pointShadowArgsBase.fill(kNoShadowIndirectArgs);
+std::array<std::uint32_t, kMaxDirCascades> cascadeShadowArgsBase{};
+cascadeShadowArgsBase.fill(kNoShadowIndirectArgs);
+std::array<std::uint32_t, kMaxSpotShadows> spotShadowArgsBase{};
+spotShadowArgsBase.fill(kNoShadowIndirectArgs);
+std::size_t shadowArgsCount = shadowBatches.size() + prepassBatches.size();
+for (const auto& batches : pointShadowBatchesLayered)
+{
+	shadowArgsCount += batches.size();
+}
+for (const auto& batches : cascadeShadowBatches)
+{
+	shadowArgsCount += batches.size();
+}
+for (const auto& batches : spotShadowBatches)
+{
+	shadowArgsCount += batches.size();
+}
+if (shadowIndirectArgsBuffer_ && shadowArgsCount != 0 && shadowArgsCount <= kMaxShadowIndirectDraws)
+{
+	std::pmr::vector<rhi::DrawIndexedIndirectArgs> shadowArgs{ &frameArena_ };
+	shadowArgs.reserve(shadowArgsCount);
+	auto AppendShadowArgs = [&shadowArgs](std::span<const ShadowBatch> batches)
+		{
+			for (const ShadowBatch& batch : batches)
+			{
+				rhi::DrawIndexedIndirectArgs args{};
+				args.indexCount = batch.mesh ? batch.mesh->indexCount : 0u;
+				args.instanceCount = batch.instanceCount;
+				args.firstIndex = batch.mesh ? batch.mesh->firstIndex : 0u;
+				args.baseVertex = batch.mesh ? batch.mesh->baseVertex : 0;
+				args.firstInstance = batch.instanceOffset;
+				shadowArgs.push_back(args);
+			}
+		};
+	AppendShadowArgs(shadowBatches);
+	for (std::uint32_t p = 0; p < kMaxPointShadows; ++p)
+	{
+		pointShadowArgsBase[p] = static_cast<std::uint32_t>(shadowArgs.size());
+		AppendShadowArgs(pointShadowBatchesLayered[p]);
+	}
+	for (std::uint32_t c = 0; c < kMaxDirCascades; ++c)
+	{
+		cascadeShadowArgsBase[c] = static_cast<std::uint32_t>(shadowArgs.size());
+		AppendShadowArgs(cascadeShadowBatches[c]);
+	}
+	for (std::uint32_t spot = 0; spot < kMaxSpotShadows; ++spot)
+	{
+		spotShadowArgsBase[spot] = static_cast<std::uint32_t>(shadowArgs.size());
+		AppendShadowArgs(spotShadowBatches[spot]);
+	}
+	prepassArgsBase = static_cast<std::uint32_t>(shadowArgs.size());
+	AppendShadowArgs(prepassBatches);
+
+	shadowArgsBase = 0u;
+	device_.UpdateBuffer(shadowIndirectArgsBuffer_, std::as_bytes(std::span{ shadowArgs }));
 }
 
 if (!skinnedPaletteMatrices.empty())
@@ -123,50 +296,36 @@ if (!skinnedPaletteMatrices.empty())
 	device_.UpdateBuffer(skinPaletteBuffer_, std::as_bytes(std::span{ skinnedPaletteMatrices }));
 }
 
-particleBatches_.clear();
-std::vector<std::pair<rhi::TextureDescIndex, ParticleInstanceData>> particlePacked;
-particlePacked.reserve(std::min<std::size_t>(scene.particles.size(), static_cast<std::size_t>(kMaxParticles)));
+// Every billboard goes into one instanced draw: the texture is a per-instance bindless index and the
+// flipbook frame a per-instance UV rect, so emitters need neither sorting nor batching (additive blend).
+std::pmr::vector<ParticleInstanceData> particleInstances{ &frameArena_ };
+particleInstances.reserve(std::min<std::size_t>(scene.particles.size(), static_cast<std::size_t>(kMaxParticles)));
 for (const Particle& particle : scene.particles)
 {
 	if (!particle.alive || particle.size <= 0.0f || particle.color.w <= 0.0f)
 	{
 		continue;
 	}
-	if (particlePacked.size() >= static_cast<std::size_t>(kMaxParticles))
+	if (particleInstances.size() >= static_cast<std::size_t>(kMaxParticles))
 	{
 		break;
 	}
 
-	ParticleInstanceData gpu{};
-	gpu.centerSize = mathUtils::Vec4(particle.position, particle.size);
-	gpu.color = particle.color;
-	gpu.params0 = mathUtils::Vec4(particle.rotationRad, 0.0f, 0.0f, 0.0f);
-
 	rhi::TextureDescIndex textureDescIndex = 0;
+	mathUtils::Vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
 	if (particle.ownerEmitter >= 0 && static_cast<std::size_t>(particle.ownerEmitter) < scene.particleEmitters.size())
 	{
-		textureDescIndex = scene.particleEmitters[static_cast<std::size_t>(particle.ownerEmitter)].textureDescIndex;
-	}
-	particlePacked.emplace_back(textureDescIndex, gpu);
-}
-
-std::sort(particlePacked.begin(), particlePacked.end(),
-	[](const auto& a, const auto& b)
-	{
-		return a.first < b.first;
-	});
-
-std::vector<ParticleInstanceData> particleInstances;
-particleInstances.reserve(particlePacked.size());
-for (const auto& entry : particlePacked)
-{
-	if (particleBatches_.empty() || particleBatches_.back().textureDescIndex != entry.first)
-	{
-		particleBatches_.push_back(ParticleDrawBatch{ .textureDescIndex = entry.first, .instanceOffset = static_cast<std::uint32_t>(particleInstances.size()), .instanceCount = 0u });
+		const ParticleEmitter& emitter = scene.particleEmitters[static_cast<std::size_t>(particle.ownerEmitter)];
+		textureDescIndex = emitter.textureDescIndex;
+		uvRect = ParticleFrameUvRect(emitter, particle.age, particle.lifetime);
 	}
 
-	particleInstances.push_back(entry.second);
-	++particleBatches_.back().instanceCount;
+	ParticleInstanceData gpu{};
+	gpu.centerSize = mathUtils::Vec4(particle.position, particle.size);
+	gpu.color = particle.color;
+	gpu.params0 = mathUtils::Vec4(particle.rotationRad, AsFloatBits(textureDescIndex), 0.0f, 0.0f);
+	gpu.params1 = uvRect;
+	particleInstances.push_back(gpu);
 }
 
 particleCount = static_cast<std::uint32_t>(particleInstances.size());
@@ -184,6 +343,23 @@ if (settings_.debugPrintDrawCalls)
 			<< " (instances main: " << mainInstances.size()
 			<< ", shadow: " << shadowInstances.size() << ")"
 			<< " | DepthPrepass: " << (settings_.enableDepthPrepass ? "ON" : "OFF")
-			<< " (draw calls: " << shadowBatches.size() << ")\n";
+			<< " (draw calls: " << shadowBatches.size() << ")";
+		if (cascadeCasterCulling)
+		{
+			std::cout << " | CSM cascade draw calls:";
+			for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+			{
+				std::cout << ' ' << cascadeShadowBatches[c].size();
+			}
+		}
+		if (spotShadowCount != 0)
+		{
+			std::cout << " | Spot shadow draw calls:";
+			for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
+			{
+				std::cout << ' ' << spotShadowBatches[spot].size();
+			}
+		}
+		std::cout << "\n";
 	}
 }
\ No newline at end of file
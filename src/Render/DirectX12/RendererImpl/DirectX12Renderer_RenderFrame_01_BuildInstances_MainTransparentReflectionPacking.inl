@@ -1,22 +1,13 @@
-std::unordered_map<BatchKey, BatchTemp, hashUtils::BatchKeyHash, BatchKeyEq> mainTmp;
-mainTmp.reserve(scene.drawItems.size());
-
-std::vector<InstanceData> transparentInstances;
-transparentInstances.reserve(scene.drawItems.size());
-
-std::vector<TransparentTemp> transparentTmp;
-transparentTmp.reserve(scene.drawItems.size());
-
-std::vector<InstanceData> planarMirrorInstances;
+std::pmr::vector<InstanceRef> planarMirrorInstances{ &frameArena_ };
 planarMirrorInstances.reserve(std::min<std::size_t>(scene.drawItems.size(), static_cast<std::size_t>(settings_.planarReflectionMaxMirrors)));
 
-std::vector<PlanarMirrorDraw> planarMirrorDraws;
+std::pmr::vector<PlanarMirrorDraw> planarMirrorDraws{ &frameArena_ };
 planarMirrorDraws.reserve(std::min<std::size_t>(scene.drawItems.size(), static_cast<std::size_t>(settings_.planarReflectionMaxMirrors)));
 
 std::vector<SkinnedOpaqueDraw> skinnedOpaqueDraws;
 skinnedOpaqueDraws.reserve(scene.GetSkinnedDrawItems().size());
 
-std::vector<mathUtils::Mat4> skinnedPaletteMatrices;
+std::pmr::vector<mathUtils::Mat4> skinnedPaletteMatrices{ &frameArena_ };
 
 // ---------------- Reflection probe assignment (multi-probe) ----------------
 drawItemReflectionProbeIndices_.assign(scene.drawItems.size(), -1);
@@ -51,167 +42,256 @@ for (std::size_t i = 0; i < scene.drawItems.size(); ++i)
 
 EnsureReflectionProbeResources(reflectiveOwnerDrawItems_.size());
 
-// ---- Main packing: opaque (batched) + transparent (sorted per-item) ----
-// NOTE: mainTmp is camera-culled (IsVisible), but reflection capture must NOT depend on the camera.
-// We therefore build an additional "no-cull" packing for reflection capture / cube atlas.
-const bool buildCaptureNoCull = settings_.enableReflectionCapture || settings_.ShowCubeAtlas || settings_.enablePlanarReflections;
-std::unordered_map<BatchKey, BatchTemp, hashUtils::BatchKeyHash, BatchKeyEq> captureTmp;
-if (buildCaptureNoCull)
-{
-	captureTmp.reserve(scene.drawItems.size());
-}
-for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++drawItemIndex)
+// ---- Residency usage: what any pass draws this frame ----
+// Camera and shadow views are marked by the classification workers (DrawItemPrep::Used); capture adds
+// every candidate within the far plane of a probe, as the capture pass draws them unculled. Materials
+// are deduped; LevelInstance maps them to their textures.
+drawnMaterials_.clear();
+drawnMaterialMask_.assign(scene.GetMaterials().size(), 0u);
+auto MarkDrawnMaterial = [this](MaterialHandle material)
+	{
+		if (material.id == 0 || material.id > drawnMaterialMask_.size())
+			return;
+
+		std::uint8_t& seen = drawnMaterialMask_[material.id - 1u];
+		if (seen == 0u)
+		{
+			seen = 1u;
+			drawnMaterials_.push_back(material);
+		}
+	};
+
+std::vector<mathUtils::Vec3> captureProbePositions;
+if (settings_.enableReflectionCapture && psoReflectionCapture_)
 {
-	const auto& item = scene.drawItems[drawItemIndex];
-	const rendern::MeshRHI* mesh = item.mesh ? &item.mesh->GetResource() : nullptr;
-	if (!mesh || mesh->indexCount == 0)
+	captureProbePositions.reserve(reflectiveOwnerDrawItems_.size());
+	for (const int ownerDrawItem : reflectiveOwnerDrawItems_)
 	{
-		continue;
+		const mathUtils::Mat4& model = drawItemModels[static_cast<std::size_t>(ownerDrawItem)];
+		captureProbePositions.emplace_back(model[3].x, model[3].y, model[3].z);
 	}
+}
+const float captureReach = std::max(std::max(0.001f, settings_.reflectionCaptureNearZ) + 0.01f, settings_.reflectionCaptureFarZ);
+auto InCaptureReach = [this, &captureProbePositions, captureReach](std::size_t drawItemIndex)
+	{
+		if (drawItemSpheres_.IsNeverCulled(drawItemIndex))
+		{
+			return !captureProbePositions.empty();
+		}
+		const mathUtils::Vec4 sphere = drawItemSpheres_.Get(drawItemIndex);
+		const float reach = captureReach + sphere.w;
+		for (const mathUtils::Vec3& probePos : captureProbePositions)
+		{
+			const mathUtils::Vec3 d = mathUtils::Vec3(sphere.x, sphere.y, sphere.z) - probePos;
+			if (mathUtils::Dot(d, d) <= reach * reach)
+			{
+				return true;
+			}
+		}
+		return false;
+	};
 
-	const mathUtils::Mat4 model = item.transform.ToMatrix();
-	// Camera visibility is used only for MAIN/transparent lists.
-	// Reflection capture uses a separate no-cull packing (captureTmp).
-	const bool visibleInMain = IsVisible(item.mesh.get(), model, cameraFrustum, doFrustumCulling);
+// ---- Material states: the material part of BatchKey, interned once per material handle ----
+// Handles with identical parameters share a state and therefore a batch.
+materialStateIds_.clear();
+std::pmr::vector<std::uint32_t> materialStateOfHandle(scene.GetMaterials().size() + 1u, kNoMaterialState, &frameArena_);
+auto MaterialStateId = [this, &materialStateOfHandle](MaterialHandle handle, const MaterialParams& params, MaterialPerm perm, std::uint32_t envSource) -> std::uint32_t
+	{
+		std::uint32_t* cached = handle.id < materialStateOfHandle.size() ? &materialStateOfHandle[handle.id] : nullptr;
+		if (cached && *cached != kNoMaterialState)
+		{
+			return *cached;
+		}
 
-	BatchKey key{};
-	key.mesh = mesh;
+		BatchKey key{};
+		key.permBits = static_cast<std::uint32_t>(perm);
+		key.envSource = envSource;
+
+		// IMPORTANT: the state must include material parameters,
+		// otherwise different materials get incorrectly merged.
+		key.albedoDescIndex = params.albedoDescIndex;
+		key.normalDescIndex = params.normalDescIndex;
+		key.metalnessDescIndex = params.metalnessDescIndex;
+		key.roughnessDescIndex = params.roughnessDescIndex;
+		key.aoDescIndex = params.aoDescIndex;
+		key.emissiveDescIndex = params.emissiveDescIndex;
+		key.specularDescIndex = params.specularDescIndex;
+		key.glossDescIndex = params.glossDescIndex;
+
+		key.baseColor = params.baseColor;
+		key.shadowBias = params.shadowBias; // texels
+
+		key.metallic = params.metallic;
+		key.roughness = params.roughness;
+		key.ao = params.ao;
+		key.emissiveStrength = params.emissiveStrength;
+
+		// Legacy
+		key.shininess = params.shininess;
+		key.specStrength = params.specStrength;
+
+		const auto [it, inserted] = materialStateIds_.try_emplace(key, static_cast<std::uint32_t>(materialStateIds_.size()));
+		assert(it->second < drawKey::kMaxMaterialStates);
+		if (cached)
+		{
+			*cached = it->second;
+		}
+		return it->second;
+	};
 
-	MaterialParams params{};
-	MaterialPerm perm = MaterialPerm::UseShadow;
-	std::uint32_t itemEnvSource = 0u;
-	if (item.material.id != 0)
+// ---- Ids, drawn materials and planar mirrors (render thread, item order) ----
+// Everything order-dependent: the id maps, the deduped material list and the capped mirror list.
+// Counts each chunk's keys on the way for the prefix sum below.
+const std::size_t buildChunkCount = jobs::ParallelForChunkCount(scene.drawItems.size(), kBuildInstancesGrain);
+std::pmr::vector<std::size_t> chunkKeyOffsets(buildChunkCount + 1u, 0u, &frameArena_);
+for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++drawItemIndex)
+{
+	const auto& item = scene.drawItems[drawItemIndex];
+	DrawItemPrep& prep = drawItemPrep[drawItemIndex];
+	if ((prep.flags & DrawItemPrep::TransformDirty) != 0u)
 	{
-		const auto& mat = scene.GetMaterial(item.material);
-		itemEnvSource = static_cast<std::uint32_t>(mat.envSource);
-		params = mat.params;
-		perm = EffectivePerm(mat);
+		prep.flags &= ~DrawItemPrep::TransformDirty;
+		dirtyTransformSlots.push_back(static_cast<std::uint32_t>(drawItemIndex));
+		instanceTransformValid_[drawItemIndex] = 1u;
 	}
-	else
+	// Frame stats: with gpuCullMain every item is visible here and the GPU culls the batches.
+	frameStats_.cullTested += item.mesh ? 1u : 0u;
+	if ((prep.flags & DrawItemPrep::Visible) != 0u)
 	{
-		params.baseColor = { 1,1,1,1 };
-		params.shininess = 32.0f;
-		params.specStrength = 0.2f;
-		params.shadowBias = 0.0f;
-		params.albedoDescIndex = 0;
-		perm = MaterialPerm::UseShadow;
+		++frameStats_.cullVisible;
 	}
-
-	key.permBits = static_cast<std::uint32_t>(perm);
-	key.envSource = itemEnvSource;
-	if (drawItemIndex < drawItemReflectionProbeIndices_.size())
+	if ((prep.flags & (DrawItemPrep::Used | DrawItemPrep::CaptureCandidate)) == DrawItemPrep::CaptureCandidate &&
+		InCaptureReach(drawItemIndex))
 	{
-		key.reflectionProbeIndex = drawItemReflectionProbeIndices_[drawItemIndex];
+		item.mesh->MarkUsed();
+		prep.flags |= DrawItemPrep::Used;
 	}
-
-	// IMPORTANT: BatchKey must include material parameters,
-	// otherwise different materials get incorrectly merged.
-	key.albedoDescIndex = params.albedoDescIndex;
-	key.normalDescIndex = params.normalDescIndex;
-	key.metalnessDescIndex = params.metalnessDescIndex;
-	key.roughnessDescIndex = params.roughnessDescIndex;
-	key.aoDescIndex = params.aoDescIndex;
-	key.emissiveDescIndex = params.emissiveDescIndex;
-	key.specularDescIndex = params.specularDescIndex;
-	key.glossDescIndex = params.glossDescIndex;
-
-	key.baseColor = params.baseColor;
-	key.shadowBias = params.shadowBias; // texels
-
-	key.metallic = params.metallic;
-	key.roughness = params.roughness;
-	key.ao = params.ao;
-	key.emissiveStrength = params.emissiveStrength;
-
-	// Legacy
-	key.shininess = params.shininess;
-	key.specStrength = params.specStrength;
-
-	// Instance (ROWS)
-	const bool isTransparent = HasFlag(perm, MaterialPerm::Transparent) || (params.baseColor.w < 0.999f);
-	const bool isPlanarMirror = HasFlag(perm, MaterialPerm::PlanarMirror);
-	InstanceData inst{};
-	inst.i0 = model[0];
-	inst.i1 = model[1];
-	inst.i2 = model[2];
-	inst.i3 = model[3];
-
-	// Reflection-capture packing is NO-CULL: add before camera-cull so capture does not depend on the editor camera
-	if (buildCaptureNoCull && !isTransparent)
+	if ((prep.flags & DrawItemPrep::Used) != 0u)
 	{
-		auto& bucket = captureTmp[key];
-		if (bucket.inst.empty())
-		{
-			bucket.materialHandle = item.material;
-			bucket.material = params;
-			bucket.reflectionProbeIndex = key.reflectionProbeIndex;
-		}
-		bucket.inst.push_back(inst);
+		MarkDrawnMaterial(item.material);
 	}
-
-	// Main pass: camera-culled.
-	if (!visibleInMain)
+	constexpr std::uint32_t kDrawFlags = DrawItemPrep::ShadowKey | DrawItemPrep::CaptureKey | DrawItemPrep::MainKey |
+		DrawItemPrep::TransparentKey | DrawItemPrep::PlanarMirror;
+	if ((prep.flags & kDrawFlags) == 0u)
 	{
 		continue;
 	}
 
-	if (isTransparent)
+	// Every level is its own MeshRHI view, so each level batches separately.
+	const rendern::MeshRHI* mesh = &item.mesh->GetResource();
+	if ((prep.flags & (DrawItemPrep::MainKey | DrawItemPrep::TransparentKey | DrawItemPrep::PlanarMirror)) != 0u)
 	{
-		mathUtils::Vec3 sortPos = item.transform.position;
-		const auto& b = item.mesh->GetBounds();
-		if (b.sphereRadius > 0.0f)
-		{
-			const mathUtils::Vec4 wc4 = model * mathUtils::Vec4(b.sphereCenter, 1.0f);
-			sortPos = mathUtils::Vec3(wc4.x, wc4.y, wc4.z);
-		}
-		else
-		{
-			sortPos = mathUtils::Vec3(model[3].x, model[3].y, model[3].z);
-		}
-
-		const mathUtils::Vec3 deltaToCamera = sortPos - camPos;
-		const float dist2 = mathUtils::Dot(deltaToCamera, deltaToCamera);
-		const std::uint32_t localOff = static_cast<std::uint32_t>(transparentInstances.size());
-		transparentInstances.push_back(inst);
-		transparentTmp.push_back(TransparentTemp{ mesh, params, item.material, localOff, dist2 });
-
-		continue;
+		prep.meshId = DrawMeshId(&item.mesh->GetLodResource(prep.lod));
+	}
+	if ((prep.flags & DrawItemPrep::ShadowKey) != 0u)
+	{
+		prep.shadowMeshId = DrawMeshId(&item.mesh->GetLodResource(prep.shadowLod));
+	}
+	if ((prep.flags & DrawItemPrep::CaptureKey) != 0u)
+	{
+		prep.captureMeshId = DrawMeshId(mesh);
 	}
 
-	if (settings_.enablePlanarReflections && isPlanarMirror && !isTransparent &&
-		planarMirrorDraws.size() < static_cast<std::size_t>(settings_.planarReflectionMaxMirrors))
+	// With weighted blended OIT transparent keys carry the material state too.
+	const std::uint32_t materialKeyFlags = DrawItemPrep::CaptureKey | DrawItemPrep::MainKey | DrawItemPrep::PlanarMirror |
+		(weightedOit ? static_cast<std::uint32_t>(DrawItemPrep::TransparentKey) : 0u);
+	if ((prep.flags & materialKeyFlags) != 0u)
 	{
-		PlanarMirrorDraw mirror{};
-		mirror.mesh = mesh;
-		mirror.material = params;
-		mirror.materialHandle = item.material;
-		mirror.instanceOffset = static_cast<std::uint32_t>(planarMirrorInstances.size());
-
-		const mathUtils::Vec3 worldX = mathUtils::TransformVector(model, mathUtils::Vec3(1.0f, 0.0f, 0.0f));
-		const mathUtils::Vec3 worldY = mathUtils::TransformVector(model, mathUtils::Vec3(0.0f, 1.0f, 0.0f));
-		mirror.planePoint = mathUtils::TransformPoint(model, mathUtils::Vec3(0.0f, 0.0f, 0.0f));
-		mirror.planeNormal = mathUtils::Cross(worldX, worldY);
-
-		if (mathUtils::Length(mirror.planeNormal) > 0.0001f)
+		const MaterialParams params = ItemMaterialParams(item.material);
+		const MaterialPerm perm = static_cast<MaterialPerm>(prep.perm);
+		const std::uint32_t itemEnvSource = item.material.id != 0 ? static_cast<std::uint32_t>(scene.GetMaterial(item.material).envSource) : 0u;
+		prep.materialState = MaterialStateId(item.material, params, perm, itemEnvSource);
+
+		// Mirrors past the cap are drawn as regular opaque items.
+		if ((prep.flags & DrawItemPrep::PlanarMirror) != 0u)
 		{
-			mirror.planeNormal = mathUtils::Normalize(mirror.planeNormal);
-			planarMirrorInstances.push_back(inst);
-			planarMirrorDraws.push_back(mirror);
+			prep.flags &= ~DrawItemPrep::PlanarMirror;
+			if (planarMirrorDraws.size() >= static_cast<std::size_t>(settings_.planarReflectionMaxMirrors))
+			{
+				prep.flags |= DrawItemPrep::MainKey;
+			}
+			else
+			{
+				const mathUtils::Mat4& model = drawItemModels[drawItemIndex];
+				PlanarMirrorDraw mirror{};
+				mirror.mesh = mesh;
+				mirror.material = params;
+				mirror.materialHandle = item.material;
+				mirror.instanceOffset = static_cast<std::uint32_t>(planarMirrorInstances.size());
+
+				const mathUtils::Vec3 worldX = mathUtils::TransformVector(model, mathUtils::Vec3(1.0f, 0.0f, 0.0f));
+				const mathUtils::Vec3 worldY = mathUtils::TransformVector(model, mathUtils::Vec3(0.0f, 1.0f, 0.0f));
+				mirror.planePoint = mathUtils::TransformPoint(model, mathUtils::Vec3(0.0f, 0.0f, 0.0f));
+				mirror.planeNormal = mathUtils::Cross(worldX, worldY);
+
+				const auto& bounds = item.mesh->GetBounds();
+				if (bounds.sphereRadius > 0.0f)
+				{
+					const float maxScale = std::max({ mathUtils::Length(worldX), mathUtils::Length(worldY),
+						mathUtils::Length(mathUtils::TransformVector(model, mathUtils::Vec3(0.0f, 0.0f, 1.0f))) });
+					mirror.boundsSphere = mathUtils::Vec4(mathUtils::TransformPoint(model, bounds.sphereCenter), bounds.sphereRadius * maxScale);
+				}
+
+				if (mathUtils::Length(mirror.planeNormal) > 0.0001f)
+				{
+					mirror.planeNormal = mathUtils::Normalize(mirror.planeNormal);
+					planarMirrorInstances.push_back(MakeInstanceRef(static_cast<std::uint32_t>(drawItemIndex)));
+					planarMirrorDraws.push_back(mirror);
+				}
+			}
 		}
-
-		continue;
 	}
 
-	auto& bucket = mainTmp[key];
-	if (bucket.inst.empty())
-	{
-		bucket.materialHandle = item.material;
-		bucket.material = params; // representative material for this batch
-		bucket.reflectionProbeIndex = key.reflectionProbeIndex;
-	}
-	bucket.inst.push_back(inst);
+	const std::uint32_t keyFlags = prep.flags & (DrawItemPrep::ShadowKey | DrawItemPrep::CaptureKey | DrawItemPrep::MainKey | DrawItemPrep::TransparentKey);
+	chunkKeyOffsets[drawItemIndex / kBuildInstancesGrain + 1u] += static_cast<std::size_t>(std::popcount(keyFlags));
+}
+for (std::size_t chunk = 0; chunk < buildChunkCount; ++chunk)
+{
+	chunkKeyOffsets[chunk + 1u] += chunkKeyOffsets[chunk];
 }
 
+// ---- Keys (parallel): every chunk fills its own [offset, nextOffset) range ----
+std::pmr::vector<DrawSortEntry> drawKeys(chunkKeyOffsets.back(), &frameArena_);
+jobs::ParallelFor(buildScheduler, scene.drawItems.size(), kBuildInstancesGrain, [&](std::size_t begin, std::size_t end)
+	{
+		std::size_t out = chunkKeyOffsets[begin / kBuildInstancesGrain];
+		for (std::size_t drawItemIndex = begin; drawItemIndex < end; ++drawItemIndex)
+		{
+			const DrawItemPrep& prep = drawItemPrep[drawItemIndex];
+			const std::uint32_t drawItemIndex32 = static_cast<std::uint32_t>(drawItemIndex);
+			const int reflectionProbeIndex = drawItemIndex < drawItemReflectionProbeIndices_.size() ? drawItemReflectionProbeIndices_[drawItemIndex] : -1;
+
+			if ((prep.flags & DrawItemPrep::ShadowKey) != 0u)
+			{
+				const std::uint32_t shadowBits = (prep.flags & DrawItemPrep::StaticShadow) != 0u ? drawKey::kStaticShadowBits : 0u;
+				drawKeys[out++] = DrawSortEntry{ drawKey::Opaque(DrawPass::Shadow, shadowBits, 0u, -1, prep.shadowMeshId), drawItemIndex32 };
+			}
+			if ((prep.flags & DrawItemPrep::CaptureKey) != 0u)
+			{
+				drawKeys[out++] = DrawSortEntry{
+					drawKey::Opaque(DrawPass::CaptureNoCull, prep.perm, prep.materialState, reflectionProbeIndex, prep.captureMeshId),
+					drawItemIndex32 };
+			}
+			if ((prep.flags & DrawItemPrep::TransparentKey) != 0u)
+			{
+				drawKeys[out++] = DrawSortEntry{
+					weightedOit
+						? drawKey::TransparentBatched(prep.perm, prep.materialState, prep.meshId)
+						: drawKey::Transparent(prep.dist2),
+					drawItemIndex32 };
+			}
+			if ((prep.flags & DrawItemPrep::MainKey) != 0u)
+			{
+				// Deferred: the G-buffer reads the material table, so a mesh's batches are kept together.
+				drawKeys[out++] = DrawSortEntry{
+					canDeferred
+						? drawKey::OpaqueMeshMajor(DrawPass::Main, prep.materialState, reflectionProbeIndex, prep.meshId)
+						: drawKey::Opaque(DrawPass::Main, prep.perm, prep.materialState, reflectionProbeIndex, prep.meshId),
+					drawItemIndex32 };
+			}
+		}
+	});
+
 for (std::size_t skinnedDrawIndex = 0; skinnedDrawIndex < scene.GetSkinnedDrawItems().size(); ++skinnedDrawIndex)
 {
 	const SkinnedDrawItem& item = scene.GetSkinnedDrawItems()[skinnedDrawIndex];
@@ -224,10 +304,13 @@ for (std::size_t skinnedDrawIndex = 0; skinnedDrawIndex < scene.GetSkinnedDrawIt
 		continue;
 	}
 	const mathUtils::Mat4 model = item.transform.ToMatrix();
+	++frameStats_.cullTested;
 	if (!IsVisible(item.asset.get(), model, cameraFrustum, doFrustumCulling))
 	{
 		continue;
 	}
+	++frameStats_.cullVisible;
+	MarkDrawnMaterial(item.material);
 	MaterialParams params{};
 	MaterialPerm perm = MaterialPerm::UseShadow;
 	if (item.material.id != 0)
@@ -256,111 +339,22 @@ for (std::size_t skinnedDrawIndex = 0; skinnedDrawIndex < scene.GetSkinnedDrawIt
 	draw.paletteOffset = static_cast<std::uint32_t>(skinnedPaletteMatrices.size());
 	draw.boneCount = static_cast<std::uint32_t>(item.animator.skinMatrices.size());
 	draw.sourceSkinnedDrawIndex = static_cast<int>(skinnedDrawIndex);
-	for (const mathUtils::Mat4& skin : item.animator.skinMatrices)
-	{
-		skinnedPaletteMatrices.push_back(item.asset->mesh.skinningSkeletonToMeshSpace * skin);
-	}
+	skinnedPaletteMatrices.resize(skinnedPaletteMatrices.size() + draw.boneCount);
 	skinnedOpaqueDraws.push_back(draw);
 }
 
-std::vector<InstanceData> mainInstances;
-mainInstances.reserve(scene.drawItems.size());
-
-std::vector<Batch> mainBatches;
-mainBatches.reserve(mainTmp.size());
-
-for (auto& [key, bt] : mainTmp)
-{
-	if (bt.inst.empty())
+// Palette ranges are reserved above; every character then writes its bones straight into its range.
+jobs::ParallelFor(buildScheduler, skinnedOpaqueDraws.size(), 1, [&](std::size_t begin, std::size_t end)
 	{
-		continue;
-	}
-
-	Batch batch{};
-	batch.mesh = key.mesh;
-	batch.materialHandle = bt.materialHandle;
-	batch.material = bt.material;
-	batch.instanceOffset = static_cast<std::uint32_t>(mainInstances.size());
-	batch.instanceCount = static_cast<std::uint32_t>(bt.inst.size());
-
-	batch.reflectionProbeIndex = bt.reflectionProbeIndex;
-
-	mainInstances.insert(mainInstances.end(), bt.inst.begin(), bt.inst.end());
-	mainBatches.push_back(batch);
-}
-
-// ---- Reflection-capture no-cull packing (opaque) ----
-std::vector<InstanceData> captureMainInstancesNoCull;
-std::vector<Batch> captureMainBatchesNoCull;
-
-if (buildCaptureNoCull && !captureTmp.empty())
-{
-	captureMainInstancesNoCull.reserve(scene.drawItems.size());
-	captureMainBatchesNoCull.reserve(captureTmp.size());
-
-	for (auto& [key, bt] : captureTmp)
-	{
-		if (bt.inst.empty())
-			continue;
-
-		Batch batch{};
-		batch.mesh = key.mesh;
-		batch.materialHandle = bt.materialHandle;
-		batch.material = bt.material;
-		batch.instanceOffset = static_cast<std::uint32_t>(captureMainInstancesNoCull.size());
-		batch.instanceCount = static_cast<std::uint32_t>(bt.inst.size());
-		batch.reflectionProbeIndex = bt.reflectionProbeIndex;
-
-		captureMainInstancesNoCull.insert(captureMainInstancesNoCull.end(), bt.inst.begin(), bt.inst.end());
-		captureMainBatchesNoCull.push_back(batch);
-	}
-}
-
-// ---- Optional: layered reflection-capture packing (duplicate MAIN instances x6 for cubemap slices) ----
-// Layered reflection capture uses SV_RenderTargetArrayIndex in VS and assumes each original instance
-// is duplicated 6 times in order (faces 0..5).
-std::vector<InstanceData> reflectionInstancesLayered;
-std::vector<Batch> reflectionBatchesLayered;
-
-const bool buildLayeredReflectionCapture =
-(psoReflectionCaptureLayered_ && !disableReflectionCaptureLayered_) &&
-device_.SupportsShaderModel6() && device_.SupportsVPAndRTArrayIndexFromAnyShader();
-
-if (buildLayeredReflectionCapture && !captureMainBatchesNoCull.empty())
-{
-	constexpr std::uint32_t kFaces = 6u;
-
-	// reserve roughly
-	std::size_t totalMainInst = 0;
-	for (const Batch& b : captureMainBatchesNoCull)
-	{
-		totalMainInst += b.instanceCount;
-	}
-
-	reflectionInstancesLayered.reserve(totalMainInst * kFaces);
-	reflectionBatchesLayered.reserve(captureMainBatchesNoCull.size());
-
-	for (const Batch& b : captureMainBatchesNoCull)
-	{
-		if (!b.mesh || b.instanceCount == 0)
-			continue;
-
-		Batch lb = b;
-		lb.instanceOffset = static_cast<std::uint32_t>(reflectionInstancesLayered.size());
-		lb.instanceCount = b.instanceCount * kFaces;
-
-		const std::uint32_t begin = b.instanceOffset;
-		const std::uint32_t end = begin + b.instanceCount;
-
-		for (std::uint32_t i = begin; i < end; ++i)
+		for (std::size_t drawIndex = begin; drawIndex < end; ++drawIndex)
 		{
-			const InstanceData& inst = captureMainInstancesNoCull[i];
-			for (std::uint32_t face = 0; face < kFaces; ++face)
+			const SkinnedOpaqueDraw& draw = skinnedOpaqueDraws[drawIndex];
+			const SkinnedDrawItem& item = scene.GetSkinnedDrawItems()[static_cast<std::size_t>(draw.sourceSkinnedDrawIndex)];
+			const mathUtils::Mat4& skeletonToMesh = item.asset->mesh.skinningSkeletonToMeshSpace;
+			mathUtils::Mat4* palette = skinnedPaletteMatrices.data() + draw.paletteOffset;
+			for (std::uint32_t bone = 0; bone < draw.boneCount; ++bone)
 			{
-				reflectionInstancesLayered.push_back(inst);
+				palette[bone] = skeletonToMesh * item.animator.skinMatrices[bone];
 			}
 		}
-
-		reflectionBatchesLayered.push_back(lb);
-	}
-}
\ No newline at end of file
+	});
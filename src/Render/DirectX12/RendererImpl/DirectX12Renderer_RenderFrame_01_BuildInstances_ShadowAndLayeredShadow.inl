@@ -1,128 +1,402 @@
 // ---------------- Build instance draw lists (ONE upload) ----------------
-// We build two packings:
-//   1) Shadow packing: per-mesh batching (used by directional/spot/point shadow passes)
-//   2) Main packing: per-(mesh+material params) batching (used by MainPass)
+// Every draw of every pass gets a 64-bit key (see drawKey in CommonDX12Structs):
+//   1) Shadow: per-mesh batching (used by directional/spot/point shadow passes; with cascade caster
+//      culling each CSM cascade gets a copy with only the casters inside its light-space box, and each
+//      layered point shadow gets one instance per cubemap face a caster touches)
+//   2) Main / capture no-cull: per-(pipeline + material state + probe + mesh) batching
+//   3) Transparent: per-item, back to front (weighted blended OIT: batched like 2, without the probe)
+// One stable radix sort over all keys leaves each batch as a contiguous run (SortAndBatch).
 //
-// Then we concatenate them into a single instanceBuffer_ update.
-// ---- Shadow packing (per mesh) ----
-std::unordered_map<const rendern::MeshRHI*, std::vector<InstanceData>> shadowTmp;
-shadowTmp.reserve(scene.drawItems.size());
+// The per-item work (model matrix, culling, material classification) runs in kBuildInstancesGrain
+// chunks on jobScheduler_; ids are interned in item order on this thread, then every chunk writes
+// its keys at a prefix-sum offset, so the key list is the same with or without workers.
+//
+// The instance lists hold InstanceRefs (draw item slot + face), concatenated into one list in FinalizeAndUpload.
+// With enableGpuInstanceTransforms the matrices themselves stay resident on the GPU (only changed slots are
+// uploaded) and InstanceTransforms expands the refs into instanceBuffer_; otherwise they are expanded here.
+// Scratch containers allocate from frameArena_ (reset at the start of RenderFrame).
+jobs::Scheduler* const buildScheduler = settings_.enableParallelInstancePacking ? jobScheduler_ : nullptr;
 
-for (const auto& item : scene.drawItems)
-{
-	const rendern::MeshRHI* mesh = item.mesh ? &item.mesh->GetResource() : nullptr;
-	if (!mesh || mesh->indexCount == 0)
-	{
-		continue;
-	}
-	const mathUtils::Mat4 model = item.transform.ToMatrix();
-	// IMPORTANT: exclude alpha-blended objects from shadow casting
-	MaterialParams params{};
-	MaterialPerm perm = MaterialPerm::UseShadow;
-	std::uint32_t itemEnvSource = 0u;
+// Model matrices, computed once and shared by every pass.
+std::pmr::vector<mathUtils::Mat4> drawItemModels{ &frameArena_ };
+drawItemModels.resize(scene.drawItems.size());
 
-	if (item.material.id != 0)
+// Dense per-frame mesh ids in item order, so batching only depends on the scene.
+drawMeshIds_.clear();
+auto DrawMeshId = [this](const rendern::MeshRHI* mesh) -> std::uint32_t
 	{
-		const auto& mat = scene.GetMaterial(item.material);
-		itemEnvSource = static_cast<std::uint32_t>(mat.envSource);
-		params = mat.params;
-		perm = EffectivePerm(mat);
-	}
-	else
+		const auto [it, inserted] = drawMeshIds_.try_emplace(mesh, static_cast<std::uint32_t>(drawMeshIds_.size()));
+		assert(it->second < drawKey::kMaxMeshes);
+		return it->second;
+	};
+
+// Parameters a draw item renders with (defaults when it has no material).
+auto ItemMaterialParams = [&scene](MaterialHandle material) -> MaterialParams
 	{
+		if (material.id != 0)
+		{
+			return scene.GetMaterial(material).params;
+		}
+		MaterialParams params{};
 		params.baseColor = { 1,1,1,1 };
 		params.shininess = 32.0f;
 		params.specStrength = 0.2f;
 		params.shadowBias = 0.0f;
 		params.albedoDescIndex = 0;
-		perm = MaterialPerm::UseShadow;
-	}
+		return params;
+	};
 
-	const bool isTransparent = HasFlag(perm, MaterialPerm::Transparent) || (params.baseColor.w < 0.999f);
-	const bool isPlanarMirror = HasFlag(perm, MaterialPerm::PlanarMirror);
-	if (isTransparent || isPlanarMirror)
+// Compact-vertex meshes get their position dequantization folded into the rows.
+auto InstanceRows = [](const mathUtils::Mat4& model, const rendern::MeshRHI& mesh) -> InstanceData
 	{
-		continue;
-	}
+		const mathUtils::Mat4 rows = rendern::MeshVertexTransform(model, mesh);
+		InstanceData inst{};
+		inst.i0 = rows[0];
+		inst.i1 = rows[1];
+		inst.i2 = rows[2];
+		inst.i3 = rows[3];
+		return inst;
+	};
 
-	InstanceData inst{};
-	inst.i0 = model[0];
-	inst.i1 = model[1];
-	inst.i2 = model[2];
-	inst.i3 = model[3];
-
-	shadowTmp[mesh].push_back(inst);
+// Persistent instance transforms: every item's rows are compared with its resident slot below; the
+// changed slots (TransformDirty) are collected in item order and uploaded in FinalizeAndUpload.
+const bool gpuInstanceTransforms = settings_.enableGpuInstanceTransforms &&
+	psoInstanceScatter_ && psoInstanceGather_ && instanceTransformBuffer_ && instanceTransformUpdateBuffer_ && instanceRefBuffer_ &&
+	scene.drawItems.size() <= kMaxInstanceTransforms;
+if (gpuInstanceTransforms)
+{
+	instanceTransformResident_.resize(scene.drawItems.size());
+	instanceTransformValid_.resize(scene.drawItems.size(), 0u);
 }
+else
+{
+	// The GPU copy goes stale while the CPU expansion is used; re-upload everything when switching back.
+	instanceTransformValid_.clear();
+}
+std::pmr::vector<std::uint32_t> dirtyTransformSlots{ &frameArena_ };
 
-std::vector<InstanceData> shadowInstances;
-std::vector<ShadowBatch> shadowBatches;
-shadowInstances.reserve(scene.drawItems.size());
-shadowBatches.reserve(shadowTmp.size());
+// ---- Frustum culling ----
+// Models and world bounding spheres (drawItemSpheres_, one stream per component) come first, in parallel.
+// Then every frustum of the frame fills one visibility bitmask slot in a single call: a query of the
+// culling BVH (refit with the items whose sphere moved), or without the BVH one batched
+// mathUtils::CullSpheres pass over all items. Both run IntersectsSphere's test per item, so the result
+// matches IsVisible. Items without bounds are never culled; they stay outside the BVH.
+const bool bvhCulling = settings_.enableBvhCulling;
+drawItemSpheres_.Resize(scene.drawItems.size());
+jobs::ParallelFor(buildScheduler, scene.drawItems.size(), kBuildInstancesGrain, [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t drawItemIndex = begin; drawItemIndex < end; ++drawItemIndex)
+		{
+			const auto& item = scene.drawItems[drawItemIndex];
+			if (!item.mesh)
+			{
+				drawItemSpheres_.SetNeverCulled(drawItemIndex);
+				continue;
+			}
+			const mathUtils::Mat4 model = item.transform.ToMatrix();
+			drawItemModels[drawItemIndex] = model;
+			const auto& b = item.mesh->GetBounds();
+			drawItemSpheres_.Set(drawItemIndex, b.sphereCenter, b.sphereRadius, model);
+		}
+	});
 
+if (bvhCulling)
 {
-	std::vector<const rendern::MeshRHI*> meshes;
-	meshes.reserve(shadowTmp.size());
-	for (auto& [shadowMesh, _] : shadowTmp)
+	// Refit (sequential): insert / move / drop the leaves whose sphere changed.
+	for (std::size_t i = scene.drawItems.size(); i < cullBvhProxy_.size(); ++i)
 	{
-		meshes.push_back(shadowMesh);
+		cullBvh_.Remove(cullBvhProxy_[i]);
 	}
-	std::sort(meshes.begin(), meshes.end());
-
-	for (const rendern::MeshRHI* mesh : meshes)
+	cullBvhProxy_.resize(scene.drawItems.size(), rendern::SceneBvh::kNullProxy);
+	cullBvhSphere_.resize(scene.drawItems.size(), mathUtils::Vec4(0.0f, 0.0f, 0.0f, 0.0f));
+	for (std::size_t i = 0; i < scene.drawItems.size(); ++i)
 	{
-		auto& vec = shadowTmp[mesh];
-		if (!mesh || vec.empty())
+		rendern::SceneBvh::ProxyId& proxy = cullBvhProxy_[i];
+		if (drawItemSpheres_.IsNeverCulled(i))
 		{
+			if (proxy != rendern::SceneBvh::kNullProxy)
+			{
+				cullBvh_.Remove(proxy);
+				proxy = rendern::SceneBvh::kNullProxy;
+			}
 			continue;
 		}
-
-		ShadowBatch shadowBatch{};
-		shadowBatch.mesh = mesh;
-		shadowBatch.instanceOffset = static_cast<std::uint32_t>(shadowInstances.size());
-		shadowBatch.instanceCount = static_cast<std::uint32_t>(vec.size());
-
-		shadowInstances.insert(shadowInstances.end(), vec.begin(), vec.end());
-		shadowBatches.push_back(shadowBatch);
+		const mathUtils::Vec4 sphere = drawItemSpheres_.Get(i);
+		if (proxy != rendern::SceneBvh::kNullProxy && cullBvhSphere_[i] == sphere)
+		{
+			continue;
+		}
+		cullBvhSphere_[i] = sphere;
+		const rendern::BvhAabb box = rendern::SphereAabb(mathUtils::Vec3(sphere.x, sphere.y, sphere.z), sphere.w);
+		if (proxy == rendern::SceneBvh::kNullProxy)
+		{
+			proxy = cullBvh_.Insert(box, static_cast<std::uint32_t>(i));
+		}
+		else
+		{
+			cullBvh_.Update(proxy, box);
+		}
 	}
+	cullBvh_.RebuildIfDegraded();
 }
-
-// ---- Optional: layered point-shadow packing (duplicate instances x6 for cubemap slices) ----
-// Layered point shadow renders into a Texture2DArray(6) in a single pass and uses
-// SV_RenderTargetArrayIndex in VS. The shader assumes instance data is duplicated 6 times:
-// for each original instance we emit faces 0..5 in order.
-std::vector<InstanceData> shadowInstancesLayered;
-std::vector<ShadowBatch> shadowBatchesLayered;
-const bool buildLayeredPointShadow = (psoPointShadowLayered_ && !disablePointShadowLayered_) &&
-device_.SupportsShaderModel6() && device_.SupportsVPAndRTArrayIndexFromAnyShader();
-if (buildLayeredPointShadow && !shadowBatches.empty())
+else
 {
-	constexpr std::uint32_t kPointShadowFaces = 6u;
-	shadowInstancesLayered.reserve(static_cast<std::size_t>(shadowInstances.size()) * kPointShadowFaces);
-	shadowBatchesLayered.reserve(shadowBatches.size());
+	cullBvh_.Clear();
+	cullBvhProxy_.clear();
+	cullBvhSphere_.clear();
+}
 
-	for (const ShadowBatch& sb : shadowBatches)
+// Visibility bitmask slots: the camera, the CSM cascades, the layered point shadow faces, then the spot shadows.
+constexpr std::uint32_t kCullSlotCamera = 0;
+constexpr std::uint32_t kCullSlotFirstCascade = 1;
+constexpr std::uint32_t kCullSlotFirstPointFace = kCullSlotFirstCascade + kMaxDirCascades;
+constexpr std::uint32_t kCullSlotFirstSpot = kCullSlotFirstPointFace + kMaxPointShadows * kPointShadowFaces;
+constexpr std::uint32_t kCullSlotCount = kCullSlotFirstSpot + kMaxSpotShadows;
+const std::size_t cullWords = mathUtils::CullMaskWordCount(scene.drawItems.size());
+std::pmr::vector<std::uint32_t> cullBits{ &frameArena_ };
+cullBits.resize(kCullSlotCount * cullWords, 0u);
+auto CullSlotBits = [&](std::uint32_t slot) -> std::span<std::uint32_t>
+	{
+		return std::span<std::uint32_t>(cullBits).subspan(slot * cullWords, cullWords);
+	};
+auto CullSlot = [&](const mathUtils::Frustum& frustum, std::uint32_t slot)
 	{
-		if (!sb.mesh || sb.instanceCount == 0)
+		const std::span<std::uint32_t> bits = CullSlotBits(slot);
+		if (!bvhCulling)
 		{
-			continue;
+			drawItemSpheres_.Cull(frustum, bits);
+			return;
 		}
+		cullBvh_.QueryFrustum(frustum, [&](rendern::SceneBvh::ProxyId, std::uint32_t drawItemIndex)
+			{
+				const mathUtils::Vec4 sphere = drawItemSpheres_.Get(drawItemIndex);
+				if (mathUtils::IntersectsSphere(frustum, mathUtils::Vec3(sphere.x, sphere.y, sphere.z), sphere.w))
+				{
+					bits[drawItemIndex >> 5] |= 1u << (drawItemIndex & 31);
+				}
+			});
+	};
+if (doFrustumCulling)
+{
+	CullSlot(cameraFrustum, kCullSlotCamera);
+}
+if (cascadeCasterCulling)
+{
+	for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+	{
+		if (dirCascadeDue[c])
+		{
+			CullSlot(dirCascadeFrustums[c], kCullSlotFirstCascade + c);
+		}
+	}
+}
+if (pointShadowFaceCulling)
+{
+	for (std::uint32_t p = 0; p < layeredPointShadowCount; ++p)
+	{
+		for (std::uint32_t face = 0; face < kPointShadowFaces; ++face)
+		{
+			CullSlot(layeredPointShadowFaceFrustums[p][face], kCullSlotFirstPointFace + p * kPointShadowFaces + face);
+		}
+	}
+}
+for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
+{
+	CullSlot(spotShadowFrustums[spot], kCullSlotFirstSpot + spot);
+}
 
-		ShadowBatch lb{};
-		lb.mesh = sb.mesh;
-		lb.instanceOffset = static_cast<std::uint32_t>(shadowInstancesLayered.size());
-		lb.instanceCount = sb.instanceCount * kPointShadowFaces;
-
-		const std::uint32_t begin = sb.instanceOffset;
-		const std::uint32_t end = begin + sb.instanceCount;
-		for (std::uint32_t i = begin; i < end; ++i)
+// ---- Per-item classification (parallel) ----
+// Workers only read the scene and write the slots of their own items (MarkUsed is an atomic flag).
+// NOTE: main keys are camera-culled (IsVisible), but reflection capture must NOT depend on the camera.
+// We therefore emit additional "no-cull" keys for reflection capture / cube atlas.
+const bool buildCaptureNoCull = settings_.enableReflectionCapture || settings_.ShowCubeAtlas || settings_.enablePlanarReflections;
+// Static casters get their own shadow batches, drawn into the cached static shadow depth (RenderFrame_02).
+const bool shadowCaching = settings_.enableShadowCaching;
+// Point shadows without the layered path (VI / per-face passes) draw every caster for each face.
+const bool unculledPointShadows = !buildLayeredPointShadow &&
+	std::any_of(scene.lights.begin(), scene.lights.end(), [](const Light& light) { return light.type == LightType::Point; });
+// Mesh levels of detail: picked once per item from its camera screen size; shadows add their own bias.
+const bool meshLods = settings_.enableMeshLods;
+const float meshLodFovY = mathUtils::DegToRad(scene.camera.fovYDeg);
+std::pmr::vector<DrawItemPrep> drawItemPrep{ &frameArena_ };
+drawItemPrep.resize(scene.drawItems.size());
+jobs::ParallelFor(buildScheduler, scene.drawItems.size(), kBuildInstancesGrain, [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t drawItemIndex = begin; drawItemIndex < end; ++drawItemIndex)
 		{
-			const InstanceData& inst = shadowInstances[i];
-			for (std::uint32_t face = 0; face < kPointShadowFaces; ++face)
+			const auto& item = scene.drawItems[drawItemIndex];
+			if (!item.mesh)
 			{
-				shadowInstancesLayered.push_back(inst);
+				continue;
 			}
-		}
+			DrawItemPrep& prep = drawItemPrep[drawItemIndex];
+			const mathUtils::Mat4& model = drawItemModels[drawItemIndex];
+			auto InCullSlot = [&](std::uint32_t slot)
+				{
+					return drawItemSpheres_.IsNeverCulled(drawItemIndex) || mathUtils::TestCullMaskBit(CullSlotBits(slot), drawItemIndex);
+				};
 
-		shadowBatchesLayered.push_back(lb);
-	}
-}
\ No newline at end of file
+			if (gpuInstanceTransforms)
+			{
+				const InstanceData rows = InstanceRows(model, item.mesh->GetResource());
+				if (instanceTransformValid_[drawItemIndex] == 0u ||
+					std::memcmp(&instanceTransformResident_[drawItemIndex], &rows, sizeof(InstanceData)) != 0)
+				{
+					instanceTransformResident_[drawItemIndex] = rows;
+					prep.flags |= DrawItemPrep::TransformDirty;
+				}
+			}
+
+			// Camera visibility is used only for MAIN/transparent lists.
+			// With gpuCullMain every item counts as visible here (residency marks stay conservative);
+			// the opaque batches are culled by the compute pass, the per-item lists below re-test.
+			const bool visibleInMain = !(doFrustumCulling && !gpuCullMain) || InCullSlot(kCullSlotCamera);
+			if (visibleInMain)
+			{
+				prep.flags |= DrawItemPrep::Visible;
+			}
+
+			MaterialPerm perm = MaterialPerm::UseShadow;
+			float alpha = 1.0f;
+			if (item.material.id != 0)
+			{
+				const auto& mat = scene.GetMaterial(item.material);
+				perm = EffectivePerm(mat);
+				alpha = mat.params.baseColor.w;
+			}
+			prep.perm = static_cast<std::uint32_t>(perm);
+
+			// IMPORTANT: exclude alpha-blended objects from shadow casting
+			const bool isTransparent = HasFlag(perm, MaterialPerm::Transparent) || (alpha < 0.999f);
+			const bool isPlanarMirror = HasFlag(perm, MaterialPerm::PlanarMirror);
+			const bool castsShadow = !isTransparent && !isPlanarMirror;
+			if (castsShadow)
+			{
+				if (cascadeCasterCulling)
+				{
+					for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+					{
+						if (dirCascadeDue[c] && InCullSlot(kCullSlotFirstCascade + c))
+						{
+							prep.shadowCascadeMask |= 1u << c;
+						}
+					}
+				}
+				for (std::uint32_t p = 0; p < layeredPointShadowCount; ++p)
+				{
+					for (std::uint32_t face = 0; face < kPointShadowFaces; ++face)
+					{
+						const std::uint32_t faceBit = 1u << (p * kPointShadowFaces + face);
+						if (!pointShadowFaceCulling || InCullSlot(kCullSlotFirstPointFace + p * kPointShadowFaces + face))
+						{
+							prep.pointShadowFaceMask |= faceBit;
+						}
+					}
+				}
+				for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
+				{
+					if (InCullSlot(kCullSlotFirstSpot + spot))
+					{
+						prep.spotShadowMask |= 1u << spot;
+					}
+				}
+			}
+			if (buildCaptureNoCull && !isTransparent)
+			{
+				prep.flags |= DrawItemPrep::CaptureCandidate;
+			}
+
+			// Residency: what any pass draws this frame, not only the camera. Casters inside a shadow view are
+			// drawn off screen too (passes without caster culling draw all of them); capture reach is tested
+			// in item order, once the probes are known. Marked before the "not uploaded" skip so an evicted
+			// mesh that comes back into use gets restored.
+			const bool drawnInShadow = castsShadow && (!cascadeCasterCulling || unculledPointShadows ||
+				prep.shadowCascadeMask != 0u || prep.pointShadowFaceMask != 0u || prep.spotShadowMask != 0u);
+			if (visibleInMain || drawnInShadow)
+			{
+				item.mesh->MarkUsed();
+				prep.flags |= DrawItemPrep::Used;
+			}
+
+			if (item.mesh->GetResource().indexCount == 0)
+			{
+				continue;
+			}
+
+			const std::uint32_t lodCount = meshLods ? item.mesh->GetLodCount() : 1u;
+			if (lodCount > 1u && !drawItemSpheres_.IsNeverCulled(drawItemIndex))
+			{
+				const mathUtils::Vec4 sphere = drawItemSpheres_.Get(drawItemIndex);
+				const float screenSize = rendern::MeshLodScreenSize(mathUtils::Vec3(sphere.x, sphere.y, sphere.z), sphere.w, camPos, meshLodFovY);
+				prep.lod = rendern::SelectMeshLod(screenSize, settings_.meshLodScreenSize, lodCount, settings_.meshLodBias);
+				prep.shadowLod = rendern::SelectMeshLod(screenSize, settings_.meshLodScreenSize, lodCount, settings_.shadowMeshLodBias);
+			}
+
+			if (castsShadow)
+			{
+				prep.flags |= DrawItemPrep::ShadowKey;
+				if (shadowCaching && item.isStatic)
+				{
+					prep.flags |= DrawItemPrep::StaticShadow;
+				}
+			}
+
+			// Reflection-capture keys are NO-CULL: decided before camera-cull so capture does not depend on the editor camera
+			if ((prep.flags & DrawItemPrep::CaptureCandidate) != 0u)
+			{
+				prep.flags |= DrawItemPrep::CaptureKey;
+			}
+
+			// Main pass: camera-culled.
+			if (!visibleInMain)
+			{
+				continue;
+			}
+			if (gpuCullMain && (isTransparent || isPlanarMirror) && doFrustumCulling && !InCullSlot(kCullSlotCamera))
+			{
+				continue;
+			}
+
+			if (isTransparent)
+			{
+				// Weighted blended OIT needs no draw order, so no sort distance either.
+				if (!weightedOit)
+				{
+					mathUtils::Vec3 sortPos = item.transform.position;
+					const auto& b = item.mesh->GetBounds();
+					if (b.sphereRadius > 0.0f)
+					{
+						const mathUtils::Vec4 wc4 = model * mathUtils::Vec4(b.sphereCenter, 1.0f);
+						sortPos = mathUtils::Vec3(wc4.x, wc4.y, wc4.z);
+					}
+					else
+					{
+						sortPos = mathUtils::Vec3(model[3].x, model[3].y, model[3].z);
+					}
+
+					const mathUtils::Vec3 deltaToCamera = sortPos - camPos;
+					prep.dist2 = mathUtils::Dot(deltaToCamera, deltaToCamera);
+				}
+				prep.flags |= DrawItemPrep::TransparentKey;
+				continue;
+			}
+
+			prep.flags |= (settings_.enablePlanarReflections && isPlanarMirror) ? DrawItemPrep::PlanarMirror : DrawItemPrep::MainKey;
+
+			// Partial depth prepass: large occluders only. Never-culled items have no sphere and stay in.
+			if (doDepthPrepass && !depthPrepassComplete && (prep.flags & DrawItemPrep::MainKey) != 0u)
+			{
+				bool occluder = drawItemSpheres_.IsNeverCulled(drawItemIndex);
+				if (!occluder)
+				{
+					const mathUtils::Vec4 sphere = drawItemSpheres_.Get(drawItemIndex);
+					occluder = rendern::MeshLodScreenSize(mathUtils::Vec3(sphere.x, sphere.y, sphere.z), sphere.w, camPos, meshLodFovY) >=
+						settings_.depthPrepassMinScreenSize;
+				}
+				if (occluder)
+				{
+					prep.flags |= DrawItemPrep::PrepassOccluder;
+				}
+			}
+		}
+	});
@@ -0,0 +1,294 @@
+// ---- One radix sort over every pass's keys; batches are the runs of equal keys ----
+{
+	std::pmr::vector<DrawSortEntry> sortScratch(drawKeys.size(), &frameArena_);
+	algorithms::RadixSort64(std::span{ drawKeys }, std::span{ sortScratch },
+		[](const DrawSortEntry& entry) noexcept { return entry.key; });
+}
+
+std::pmr::vector<InstanceRef> shadowInstances{ &frameArena_ };
+std::vector<ShadowBatch> shadowBatches;
+// Static caster batches sort last: shadowBatches[staticShadowBatchBegin..] (kStaticShadowBits keys).
+// staticShadowHash covers their meshes and transforms, so a cached static shadow map can tell when it went stale.
+std::size_t staticShadowBatchBegin = 0;
+bool haveStaticShadowBatchBegin = false;
+std::size_t staticShadowHash = 0;
+// Cascade caster culling: per cascade, the shadow batches filtered by DrawItemPrep::shadowCascadeMask
+// (same order, so the static tail starts at cascadeStaticShadowBatchBegin[c]).
+std::array<std::pmr::vector<InstanceRef>, kMaxDirCascades> cascadeShadowInstances{
+	std::pmr::vector<InstanceRef>{ &frameArena_ },
+	std::pmr::vector<InstanceRef>{ &frameArena_ },
+	std::pmr::vector<InstanceRef>{ &frameArena_ } };
+std::array<std::vector<ShadowBatch>, kMaxDirCascades> cascadeShadowBatches;
+std::array<std::size_t, kMaxDirCascades> cascadeStaticShadowBatchBegin{};
+// Layered point shadows: per light, one instance for every cubemap face a caster touches
+// (DrawItemPrep::pointShadowFaceMask). The ref's face ends up in i0.w, which the layered VS renders into;
+// column 0 of an affine model has w = 0, so the VS restores it.
+std::pmr::vector<InstanceRef> shadowInstancesLayered{ &frameArena_ };
+std::array<std::vector<ShadowBatch>, kMaxPointShadows> pointShadowBatchesLayered;
+// Spot shadows: per spot, the shadow batches filtered by DrawItemPrep::spotShadowMask, all in one
+// instance list (static tail from spotStaticShadowBatchBegin[s]).
+std::pmr::vector<InstanceRef> spotShadowInstances{ &frameArena_ };
+std::array<std::vector<ShadowBatch>, kMaxSpotShadows> spotShadowBatches;
+std::array<std::size_t, kMaxSpotShadows> spotStaticShadowBatchBegin{};
+std::pmr::vector<InstanceRef> mainInstances{ &frameArena_ };
+std::vector<Batch> mainBatches;
+// Forward depth prepass: per main batch, its leading instances that are prepass occluders (the run is
+// partitioned occluders first), so the prepass draws sub-ranges of mainInstances and needs none of its own.
+std::vector<ShadowBatch> prepassBatches;
+std::pmr::vector<InstanceRef> captureMainInstancesNoCull{ &frameArena_ };
+std::vector<Batch> captureMainBatchesNoCull;
+std::pmr::vector<InstanceRef> transparentInstances{ &frameArena_ };
+std::pmr::vector<TransparentTemp> transparentTmp{ &frameArena_ };
+shadowInstances.reserve(scene.drawItems.size());
+mainInstances.reserve(scene.drawItems.size());
+if (buildCaptureNoCull)
+{
+	captureMainInstancesNoCull.reserve(scene.drawItems.size());
+}
+
+for (std::size_t runBegin = 0; runBegin < drawKeys.size();)
+{
+	const std::uint64_t key = drawKeys[runBegin].key;
+	const DrawPass pass = drawKey::PassOf(key);
+
+	// Sorted transparent keys order the pass (far -> near) and every item is its own draw;
+	// with weighted blended OIT they batch like opaque keys.
+	std::size_t runEnd = runBegin + 1;
+	if (pass != DrawPass::Transparent || weightedOit)
+	{
+		while (runEnd < drawKeys.size() && drawKeys[runEnd].key == key)
+		{
+			++runEnd;
+		}
+	}
+
+	const std::uint32_t firstItemIndex = drawKeys[runBegin].drawItemIndex;
+	const DrawItem& firstItem = scene.drawItems[firstItemIndex];
+	// The key's mesh id is the level's view, so the whole run draws the first item's level.
+	const DrawItemPrep& firstPrep = drawItemPrep[firstItemIndex];
+	const std::uint32_t lod = (pass == DrawPass::Shadow) ? firstPrep.shadowLod : (pass == DrawPass::CaptureNoCull ? 0u : firstPrep.lod);
+	const rendern::MeshRHI* mesh = &firstItem.mesh->GetLodResource(lod);
+	const std::uint32_t runCount = static_cast<std::uint32_t>(runEnd - runBegin);
+
+	std::pmr::vector<InstanceRef>* instances = nullptr;
+	switch (pass)
+	{
+	case DrawPass::Shadow:
+	{
+		const bool staticCasters = drawKey::PipelineOf(key) == drawKey::kStaticShadowBits;
+		if (staticCasters && !haveStaticShadowBatchBegin)
+		{
+			staticShadowBatchBegin = shadowBatches.size();
+			for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+			{
+				cascadeStaticShadowBatchBegin[c] = cascadeShadowBatches[c].size();
+			}
+			for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
+			{
+				spotStaticShadowBatchBegin[spot] = spotShadowBatches[spot].size();
+			}
+			haveStaticShadowBatchBegin = true;
+		}
+
+		if (cascadeCasterCulling)
+		{
+			for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+			{
+				std::pmr::vector<InstanceRef>& cascadeInstances = cascadeShadowInstances[c];
+				ShadowBatch cascadeBatch{};
+				cascadeBatch.mesh = mesh;
+				cascadeBatch.instanceOffset = static_cast<std::uint32_t>(cascadeInstances.size());
+				for (std::size_t entryIndex = runBegin; entryIndex < runEnd; ++entryIndex)
+				{
+					const std::uint32_t drawItemIndex = drawKeys[entryIndex].drawItemIndex;
+					if ((drawItemPrep[drawItemIndex].shadowCascadeMask & (1u << c)) != 0u)
+					{
+						cascadeInstances.push_back(MakeInstanceRef(drawItemIndex));
+					}
+				}
+				cascadeBatch.instanceCount = static_cast<std::uint32_t>(cascadeInstances.size()) - cascadeBatch.instanceOffset;
+				if (cascadeBatch.instanceCount != 0u)
+				{
+					cascadeShadowBatches[c].push_back(cascadeBatch);
+				}
+			}
+		}
+
+		for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
+		{
+			ShadowBatch spotBatch{};
+			spotBatch.mesh = mesh;
+			spotBatch.instanceOffset = static_cast<std::uint32_t>(spotShadowInstances.size());
+			for (std::size_t entryIndex = runBegin; entryIndex < runEnd; ++entryIndex)
+			{
+				const std::uint32_t drawItemIndex = drawKeys[entryIndex].drawItemIndex;
+				if ((drawItemPrep[drawItemIndex].spotShadowMask & (1u << spot)) != 0u)
+				{
+					spotShadowInstances.push_back(MakeInstanceRef(drawItemIndex));
+				}
+			}
+			spotBatch.instanceCount = static_cast<std::uint32_t>(spotShadowInstances.size()) - spotBatch.instanceOffset;
+			if (spotBatch.instanceCount != 0u)
+			{
+				spotShadowBatches[spot].push_back(spotBatch);
+			}
+		}
+
+		for (std::uint32_t p = 0; p < layeredPointShadowCount; ++p)
+		{
+			ShadowBatch layeredBatch{};
+			layeredBatch.mesh = mesh;
+			layeredBatch.instanceOffset = static_cast<std::uint32_t>(shadowInstancesLayered.size());
+			for (std::size_t entryIndex = runBegin; entryIndex < runEnd; ++entryIndex)
+			{
+				const std::uint32_t drawItemIndex = drawKeys[entryIndex].drawItemIndex;
+				const std::uint32_t faceMask = drawItemPrep[drawItemIndex].pointShadowFaceMask >> (p * kPointShadowFaces);
+				for (std::uint32_t face = 0; face < kPointShadowFaces; ++face)
+				{
+					if ((faceMask & (1u << face)) != 0u)
+					{
+						shadowInstancesLayered.push_back(MakeInstanceRef(drawItemIndex, face + 1u));
+					}
+				}
+			}
+			layeredBatch.instanceCount = static_cast<std::uint32_t>(shadowInstancesLayered.size()) - layeredBatch.instanceOffset;
+			if (layeredBatch.instanceCount != 0u)
+			{
+				pointShadowBatchesLayered[p].push_back(layeredBatch);
+			}
+		}
+
+		ShadowBatch shadowBatch{};
+		shadowBatch.mesh = mesh;
+		shadowBatch.instanceOffset = static_cast<std::uint32_t>(shadowInstances.size());
+		shadowBatch.instanceCount = runCount;
+		shadowBatches.push_back(shadowBatch);
+		instances = &shadowInstances;
+
+		if (staticCasters)
+		{
+			hashUtils::HashCombine(staticShadowHash, std::hash<const void*>{}(mesh));
+			for (std::size_t entryIndex = runBegin; entryIndex < runEnd; ++entryIndex)
+			{
+				const mathUtils::Mat4& model = drawItemModels[drawKeys[entryIndex].drawItemIndex];
+				const float* values = mathUtils::ValuePtr(model);
+				for (int valueIndex = 0; valueIndex < 16; ++valueIndex)
+				{
+					hashUtils::HashCombine(staticShadowHash, std::bit_cast<std::uint32_t>(values[valueIndex]));
+				}
+			}
+		}
+		break;
+	}
+	case DrawPass::Main:
+	case DrawPass::CaptureNoCull:
+	{
+		instances = (pass == DrawPass::Main) ? &mainInstances : &captureMainInstancesNoCull;
+		std::vector<Batch>& batches = (pass == DrawPass::Main) ? mainBatches : captureMainBatchesNoCull;
+
+		// The first item's material represents the batch (same state by construction).
+		Batch batch{};
+		batch.mesh = mesh;
+		batch.materialHandle = firstItem.material;
+		batch.material = ItemMaterialParams(firstItem.material);
+		batch.instanceOffset = static_cast<std::uint32_t>(instances->size());
+		batch.instanceCount = runCount;
+		batch.reflectionProbeIndex = firstItemIndex < drawItemReflectionProbeIndices_.size() ? drawItemReflectionProbeIndices_[firstItemIndex] : -1;
+		const auto& b = firstItem.mesh->GetBounds();
+		batch.boundsSphere = mathUtils::Vec4(b.sphereCenter, b.sphereRadius);
+		batches.push_back(batch);
+
+		if (pass == DrawPass::Main && doDepthPrepass)
+		{
+			const auto occludersEnd = depthPrepassComplete
+				? drawKeys.begin() + static_cast<std::ptrdiff_t>(runEnd)
+				: std::partition(drawKeys.begin() + static_cast<std::ptrdiff_t>(runBegin), drawKeys.begin() + static_cast<std::ptrdiff_t>(runEnd),
+					[&drawItemPrep](const DrawSortEntry& entry)
+					{
+						return (drawItemPrep[entry.drawItemIndex].flags & DrawItemPrep::PrepassOccluder) != 0u;
+					});
+			const std::uint32_t occluderCount = static_cast<std::uint32_t>(occludersEnd - (drawKeys.begin() + static_cast<std::ptrdiff_t>(runBegin)));
+			if (occluderCount != 0u)
+			{
+				prepassBatches.push_back(ShadowBatch{ mesh, batch.instanceOffset, occluderCount });
+			}
+		}
+		break;
+	}
+	case DrawPass::Transparent:
+	{
+		const std::uint32_t localOff = static_cast<std::uint32_t>(transparentInstances.size());
+		const float dist2 = weightedOit ? 0.0f : drawKey::TransparentDist2(key);
+		transparentTmp.push_back(TransparentTemp{ mesh, ItemMaterialParams(firstItem.material), firstItem.material, localOff, runCount, dist2 });
+		instances = &transparentInstances;
+		break;
+	}
+	}
+
+	for (std::size_t entryIndex = runBegin; entryIndex < runEnd; ++entryIndex)
+	{
+		instances->push_back(MakeInstanceRef(drawKeys[entryIndex].drawItemIndex));
+	}
+	runBegin = runEnd;
+}
+if (!haveStaticShadowBatchBegin)
+{
+	staticShadowBatchBegin = shadowBatches.size();
+	for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+	{
+		cascadeStaticShadowBatchBegin[c] = cascadeShadowBatches[c].size();
+	}
+	for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
+	{
+		spotStaticShadowBatchBegin[spot] = spotShadowBatches[spot].size();
+	}
+}
+
+// ---- Optional: layered reflection-capture packing (duplicate MAIN instances x6 for cubemap slices) ----
+// Layered reflection capture uses SV_RenderTargetArrayIndex in VS and assumes each original instance
+// is duplicated 6 times in order (faces 0..5).
+std::pmr::vector<InstanceRef> reflectionInstancesLayered{ &frameArena_ };
+std::vector<Batch> reflectionBatchesLayered;
+
+const bool buildLayeredReflectionCapture =
+(psoReflectionCaptureLayered_ && !disableReflectionCaptureLayered_) &&
+device_.SupportsShaderModel6() && device_.SupportsVPAndRTArrayIndexFromAnyShader();
+
+if (buildLayeredReflectionCapture && !captureMainBatchesNoCull.empty())
+{
+	constexpr std::uint32_t kFaces = 6u;
+
+	// reserve roughly
+	std::size_t totalMainInst = 0;
+	for (const Batch& b : captureMainBatchesNoCull)
+	{
+		totalMainInst += b.instanceCount;
+	}
+
+	reflectionInstancesLayered.reserve(totalMainInst * kFaces);
+	reflectionBatchesLayered.reserve(captureMainBatchesNoCull.size());
+
+	for (const Batch& b : captureMainBatchesNoCull)
+	{
+		if (!b.mesh || b.instanceCount == 0)
+			continue;
+
+		Batch lb = b;
+		lb.instanceOffset = static_cast<std::uint32_t>(reflectionInstancesLayered.size());
+		lb.instanceCount = b.instanceCount * kFaces;
+
+		const std::uint32_t begin = b.instanceOffset;
+		const std::uint32_t end = begin + b.instanceCount;
+
+		for (std::uint32_t i = begin; i < end; ++i)
+		{
+			const InstanceRef inst = captureMainInstancesNoCull[i];
+			for (std::uint32_t face = 0; face < kFaces; ++face)
+			{
+				reflectionInstancesLayered.push_back(inst);
+			}
+		}
+
+		reflectionBatchesLayered.push_back(lb);
+	}
+}
@@ -0,0 +1,54 @@
+// ---------------- Compute skinning pre-pass ----------------
+// Every skinned draw that fits into the skinned vertex cache is skinned once here; the depth, shadow,
+// reflection and main passes then draw its cache slice with boneCount 0 (BindSkinnedDrawVertices /
+// SkinningConstantsFor) instead of re-skinning it in every vertex shader. Draws past the cache capacity
+// keep vertex-shader skinning. Runs on the graphics queue: nearly every later pass reads the cache.
+if (settings_.enableComputeSkinning && psoSkinVertices_ && skinnedVertexBuffer_ && !skinnedOpaqueDraws.empty())
+{
+	struct SkinningDispatch
+	{
+		rhi::BufferHandle bindPose{};
+		SkinningComputeConstants constants{};
+	};
+	std::vector<SkinningDispatch> skinningDispatches;
+	skinningDispatches.reserve(skinnedOpaqueDraws.size());
+
+	std::uint32_t cachedVertexCount = 0;
+	for (SkinnedOpaqueDraw& draw : skinnedOpaqueDraws)
+	{
+		if (!draw.mesh || draw.boneCount == 0 || draw.mesh->vertexCount == 0 ||
+			draw.mesh->vertexCount > kSkinnedVertexCacheCapacity - cachedVertexCount)
+		{
+			continue;
+		}
+
+		draw.cachedVertexOffset = cachedVertexCount;
+		SkinningDispatch dispatch{};
+		dispatch.bindPose = draw.mesh->vertexBuffer;
+		dispatch.constants.uSkinning = { draw.mesh->vertexCount, cachedVertexCount, draw.paletteOffset, draw.boneCount };
+		skinningDispatches.push_back(dispatch);
+		cachedVertexCount += draw.mesh->vertexCount;
+	}
+
+	if (!skinningDispatches.empty())
+	{
+		graph.AddComputePass("ComputeSkinning", [this, skinningDispatches = std::move(skinningDispatches)](renderGraph::PassContext& ctx)
+			{
+				ctx.commandList.BindPipeline(psoSkinVertices_);
+				ctx.commandList.BindStructuredBufferSRV(0, skinPaletteBuffer_);
+				ctx.commandList.BindBufferUAV(0, skinnedVertexBuffer_);
+				for (const SkinningDispatch& dispatch : skinningDispatches)
+				{
+					ctx.commandList.BindStructuredBufferSRV(1, dispatch.bindPose);
+					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &dispatch.constants, 1 }));
+					ctx.commandList.Dispatch((dispatch.constants.uSkinning[0] + 63u) / 64u);
+				}
+
+				// Back to the defaults the graphics passes expect: null SRVs at t0/t1.
+				ctx.commandList.BindTextureDesc(0, 0);
+				ctx.commandList.BindTextureDesc(1, 0);
+			}, {}, {
+				renderGraph::Read(skinPaletteBuffer_),
+				renderGraph::Write(skinnedVertexBuffer_) });
+	}
+}
@@ -0,0 +1,48 @@
+// ---------------- Persistent instance transforms (compute) ----------------
+// instanceTransformBuffer_ keeps every draw item's InstanceData across frames; FinalizeAndUpload only
+// uploaded the slots whose model changed. The scatter writes those into their slots, then the gather
+// expands this frame's instance refs into instanceBuffer_, which every pass draws from (VB slot1) and the
+// GPU culling pass reads. Both run on the graphics queue ahead of every pass that draws instances.
+if (gpuInstanceTransforms)
+{
+	if (instanceTransformUpdateCount != 0u)
+	{
+		InstanceTransformConstants scatterConstants{};
+		scatterConstants.uCounts = { instanceTransformUpdateCount, 0u, 0u, 0u };
+		graph.AddComputePass("InstanceTransformScatter", [this, scatterConstants](renderGraph::PassContext& ctx)
+			{
+				ctx.commandList.BindPipeline(psoInstanceScatter_);
+				ctx.commandList.BindStructuredBufferSRV(0, instanceTransformUpdateBuffer_);
+				ctx.commandList.BindBufferUAV(0, instanceTransformBuffer_);
+				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &scatterConstants, 1 }));
+				ctx.commandList.Dispatch((scatterConstants.uCounts[0] + 63u) / 64u);
+
+				// Back to the defaults the graphics passes expect: null SRV at t0.
+				ctx.commandList.BindTextureDesc(0, 0);
+			}, {}, {
+				renderGraph::Read(instanceTransformUpdateBuffer_),
+				renderGraph::Write(instanceTransformBuffer_) });
+	}
+
+	if (!combinedInstanceRefs.empty())
+	{
+		InstanceTransformConstants gatherConstants{};
+		gatherConstants.uCounts = { static_cast<std::uint32_t>(combinedInstanceRefs.size()), 0u, 0u, 0u };
+		graph.AddComputePass("InstanceTransformGather", [this, gatherConstants](renderGraph::PassContext& ctx)
+			{
+				ctx.commandList.BindPipeline(psoInstanceGather_);
+				ctx.commandList.BindStructuredBufferSRV(0, instanceTransformBuffer_);
+				ctx.commandList.BindStructuredBufferSRV(1, instanceRefBuffer_);
+				ctx.commandList.BindBufferUAV(0, instanceBuffer_);
+				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &gatherConstants, 1 }));
+				ctx.commandList.Dispatch((gatherConstants.uCounts[0] + 63u) / 64u);
+
+				// Back to the defaults the graphics passes expect: null SRVs at t0/t1.
+				ctx.commandList.BindTextureDesc(0, 0);
+				ctx.commandList.BindTextureDesc(1, 0);
+			}, {}, {
+				renderGraph::Read(instanceTransformBuffer_),
+				renderGraph::Read(instanceRefBuffer_),
+				renderGraph::Write(instanceBuffer_) });
+	}
+}
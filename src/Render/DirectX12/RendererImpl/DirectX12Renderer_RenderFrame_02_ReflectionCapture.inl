@@ -1,6 +1,7 @@
 // ---------------- ReflectionCapture pass (cubemap) ----------------
 // Per-object reflection probes.
 // Each reflective object gets its own probe cubemap and excludes itself from its own capture.
+// Recapture is time-sliced: only the faces the probe manager schedules this frame are rendered.
 
 if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwnerDrawItems_.empty())
 {
@@ -52,48 +53,137 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 	const std::uint32_t skyboxDesc = scene.skyboxDescIndex;
 	const bool haveSkybox = (skyboxDesc != 0);
 
-	for (std::size_t probeIndex = 0; probeIndex < reflectiveOwnerDrawItems_.size(); ++probeIndex)
+	// World bounding sphere (xyz, radius) of a draw item; radius 0 when the mesh has no bounds.
+	auto DrawItemWorldSphere = [&scene, &drawItemModels](std::size_t drawItemIndex) -> mathUtils::Vec4
 	{
-		if (probeIndex >= reflectionProbes_.size())
+		const DrawItem& di = scene.drawItems[drawItemIndex];
+		const mathUtils::Mat4& model = drawItemModels[drawItemIndex];
+		if (!di.mesh)
 		{
-			break;
+			return mathUtils::Vec4(model[3].x, model[3].y, model[3].z, 0.0f);
 		}
+		const auto& b = di.mesh->GetBounds();
+		const mathUtils::Vec4 wc4 = model * mathUtils::Vec4(b.sphereCenter, 1.0f);
+		const float maxScale = std::max({
+			mathUtils::Length(mathUtils::Vec3(model[0].x, model[0].y, model[0].z)),
+			mathUtils::Length(mathUtils::Vec3(model[1].x, model[1].y, model[1].z)),
+			mathUtils::Length(mathUtils::Vec3(model[2].x, model[2].y, model[2].z)) });
+		return mathUtils::Vec4(wc4.x, wc4.y, wc4.z, std::max(0.0f, b.sphereRadius) * maxScale);
+	};
 
+	// What a static probe sees: every item (but its owner) within the capture far plane.
+	auto ProbeNeighbourhoodHash = [&](int ownerDrawItem, const mathUtils::Vec3& capturePos) -> std::size_t
+	{
+		std::size_t hash = 0;
+		for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++drawItemIndex)
+		{
+			const DrawItem& di = scene.drawItems[drawItemIndex];
+			if (static_cast<int>(drawItemIndex) == ownerDrawItem || !di.mesh)
+			{
+				continue;
+			}
+			const mathUtils::Vec4 sphere = DrawItemWorldSphere(drawItemIndex);
+			const mathUtils::Vec3 d = mathUtils::Vec3(sphere.x, sphere.y, sphere.z) - capturePos;
+			const float reach = farZ + sphere.w;
+			if (mathUtils::Dot(d, d) > reach * reach)
+			{
+				continue;
+			}
+
+			hashUtils::HashCombine(hash, std::hash<const void*>{}(di.mesh.get()));
+			hashUtils::HashCombine(hash, static_cast<std::size_t>(di.material.id));
+			const float* values = mathUtils::ValuePtr(drawItemModels[drawItemIndex]);
+			for (int valueIndex = 0; valueIndex < 16; ++valueIndex)
+			{
+				hashUtils::HashCombine(hash, std::bit_cast<std::uint32_t>(values[valueIndex]));
+			}
+		}
+		return hash;
+	};
+
+	// ---- Probe manager: which faces are stale, and which of them fit this frame's budget ----
+	// A probe goes stale when it moves; a static probe also when its neighbourhood changes, a dynamic one
+	// again as soon as its previous refresh completed (reflectionCaptureUpdateEveryFrame).
+	// reflectionCaptureFaceBudget faces are captured per frame, by ReflectionProbePriority.
+	const std::size_t probeCount = std::min(reflectiveOwnerDrawItems_.size(), reflectionProbes_.size());
+	const float cameraFovY = mathUtils::DegToRad(scene.camera.fovYDeg);
+	std::vector<ReflectionProbeRequest> probeRequests(probeCount);
+	for (std::size_t probeIndex = 0; probeIndex < probeCount; ++probeIndex)
+	{
 		ReflectionProbeRuntime& probe = reflectionProbes_[probeIndex];
 		const int ownerDrawItem = reflectiveOwnerDrawItems_[probeIndex];
 
 		probe.ownerDrawItem = ownerDrawItem;
 		probe.capturePos = GetDrawItemWorldPos(ownerDrawItem);
 
-		if (!probe.hasLastPos)
+		bool moved = !probe.hasLastPos;
+		if (!moved)
 		{
-			probe.dirty = true;
+			const mathUtils::Vec3 d = probe.capturePos - probe.lastPos;
+			moved = mathUtils::Dot(d, d) > 1.0e-6f;
 		}
-		else
+		if (moved)
 		{
-			const mathUtils::Vec3 d = probe.capturePos - probe.lastPos;
-			const float dist2 = mathUtils::Dot(d, d);
-			if (dist2 > 1.0e-6f)
+			probe.staleFaces = kAllReflectionProbeFaces;
+		}
+
+		const bool validOwner = ownerDrawItem >= 0 && static_cast<std::size_t>(ownerDrawItem) < scene.drawItems.size();
+		probe.isStatic = validOwner && scene.drawItems[static_cast<std::size_t>(ownerDrawItem)].isStatic;
+		if (probe.isStatic)
+		{
+			const std::size_t neighbourhoodHash = ProbeNeighbourhoodHash(ownerDrawItem, probe.capturePos);
+			if (neighbourhoodHash != probe.neighbourhoodHash)
 			{
-				probe.dirty = true;
+				probe.neighbourhoodHash = neighbourhoodHash;
+				probe.staleFaces = kAllReflectionProbeFaces;
 			}
 		}
+		else if (settings_.reflectionCaptureUpdateEveryFrame && probe.staleFaces == 0)
+		{
+			probe.staleFaces = kAllReflectionProbeFaces;
+		}
 
 		if (!probe.cube || !probe.depthCube || probe.cubeDescIndex == 0)
 		{
 			continue;
 		}
 
-		const bool doUpdate = settings_.reflectionCaptureUpdateEveryFrame || probe.dirty;
-		if (!doUpdate)
+		const mathUtils::Vec4 ownerSphere = validOwner
+			? DrawItemWorldSphere(static_cast<std::size_t>(ownerDrawItem))
+			: mathUtils::Vec4(probe.capturePos, 0.0f);
+		ReflectionProbeRequest& request = probeRequests[probeIndex];
+		request.staleFaces = probe.staleFaces;
+		request.neverCaptured = !probe.captured;
+		request.priority = ReflectionProbePriority(camPos, cameraFovY,
+			mathUtils::Vec3(ownerSphere.x, ownerSphere.y, ownerSphere.z), ownerSphere.w, probe.framesWaiting);
+	}
+
+	std::vector<std::uint8_t> probeCaptureFaces(probeCount);
+	ScheduleReflectionProbeFaces(probeRequests, settings_.reflectionCaptureFaceBudget, probeCaptureFaces);
+
+	for (std::size_t probeIndex = 0; probeIndex < probeCount; ++probeIndex)
+	{
+		ReflectionProbeRuntime& probe = reflectionProbes_[probeIndex];
+		const std::uint8_t captureFaces = probeCaptureFaces[probeIndex];
+
+		probe.staleFaces = static_cast<std::uint8_t>(probe.staleFaces & ~captureFaces);
+		probe.framesWaiting = (probe.staleFaces == 0) ? 0u : probe.framesWaiting + 1u;
+		if (captureFaces == 0)
 		{
 			continue;
 		}
+		if (probe.staleFaces == 0)
+		{
+			probe.captured = true;
+		}
 
-		probe.dirty = false;
 		probe.hasLastPos = true;
 		probe.lastPos = probe.capturePos;
 
+		// Layered / view-instanced capture renders all six faces in one pass; a partial update goes face by face.
+		const bool allFaces = captureFaces == kAllReflectionProbeFaces;
+		auto CaptureFace = [captureFaces](int face) { return (captureFaces & (1u << face)) != 0u; };
+
 		const auto cubeRG = graph.ImportTexture(probe.cube, renderGraph::RGTextureDesc{
 			.extent = reflectionCubeExtent_,
 			.format = rhi::Format::RGBA8_UNORM,
@@ -145,12 +235,18 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 			renderedSkybox = true;
 			for (int face = 0; face < 6; ++face)
 			{
+				if (!CaptureFace(face))
+				{
+					continue;
+				}
+
 				renderGraph::PassAttachments att{};
 				att.useSwapChainBackbuffer = false;
 				att.colors = { cubeRG };
 				att.colorCubeFace = static_cast<std::uint32_t>(face);
 				att.depth = depthTmp;
 				att.clearDesc = clearColorDepth;
+				att.parallelRecord = true;
 
 				mathUtils::Mat4 view = CubeFaceViewRH(probe.capturePos, face);
 				view[3] = mathUtils::Vec4(0, 0, 0, 1);
@@ -173,18 +269,18 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 						ctx.commandList.BindTextureDesc(0, skyboxDesc);
 
 						ctx.commandList.BindInputLayout(skyboxMesh_.layout);
-						ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, 0);
-						ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, 0);
+						ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, skyboxMesh_.vertexOffsetBytes);
+						ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, skyboxMesh_.indexOffsetBytes);
 
 						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &skyboxConstants, 1 }));
-						ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, 0, 0);
+						ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, skyboxMesh_.firstIndex, skyboxMesh_.baseVertex);
 					});
 			}
 		}
 
 		const rhi::ClearDesc meshClear = renderedSkybox ? clearDepthOnly : clearColorDepth;
 
-		if (canUseLayered && !captureReflectionBatchesLayered.empty())
+		if (allFaces && canUseLayered && !captureReflectionBatchesLayered.empty())
 		{
 			renderGraph::PassAttachments att{};
 			att.useSwapChainBackbuffer = false;
@@ -192,6 +288,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 			att.colorCubeAllFaces = true;
 			att.depth = depthCubeRG;
 			att.clearDesc = meshClear;
+			att.parallelRecord = true;
 
 			ReflectionCaptureConstants base{};
 			for (int face = 0; face < 6; ++face)
@@ -202,7 +299,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 			}
 
 			base.uCapturePosAmbient = { probe.capturePos.x, probe.capturePos.y, probe.capturePos.z, 0.22f };
-			base.uParams = { static_cast<float>(lightCount), 0.0f, 0.0f, 0.0f };
+			base.uParams = { static_cast<float>(unclusteredLightCount), 0.0f, 0.0f, 0.0f };
 
 			const std::string passName = "ReflectionProbe_" + std::to_string(probeIndex) + "_Layered";
 			graph.AddPass(passName, std::move(att),
@@ -234,16 +331,16 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 						c.uParams[1] = AsFloatBits(flags);
 
 						ctx.commandList.BindInputLayout(b.mesh->layoutInstanced);
-						ctx.commandList.BindVertexBuffer(0, b.mesh->vertexBuffer, b.mesh->vertexStrideBytes, 0);
+						ctx.commandList.BindVertexBuffer(0, b.mesh->vertexBuffer, b.mesh->vertexStrideBytes, b.mesh->vertexOffsetBytes);
 						ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, b.instanceOffset * instStride);
-						ctx.commandList.BindIndexBuffer(b.mesh->indexBuffer, b.mesh->indexType, 0);
+						ctx.commandList.BindIndexBuffer(b.mesh->indexBuffer, b.mesh->indexType, b.mesh->indexOffsetBytes);
 
 						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
-						ctx.commandList.DrawIndexed(b.mesh->indexCount, b.mesh->indexType, 0, 0, b.instanceCount, 0);
+						ctx.commandList.DrawIndexed(b.mesh->indexCount, b.mesh->indexType, b.mesh->firstIndex, b.mesh->baseVertex, b.instanceCount, 0);
 					}
 				});
 		}
-		else if (canUseVI)
+		else if (allFaces && canUseVI)
 		{
 			renderGraph::PassAttachments att{};
 			att.useSwapChainBackbuffer = false;
@@ -251,6 +348,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 			att.colorCubeAllFaces = true;
 			att.depth = depthCubeRG;
 			att.clearDesc = meshClear;
+			att.parallelRecord = true;
 
 			ReflectionCaptureConstants base{};
 			for (int face = 0; face < 6; ++face)
@@ -261,7 +359,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 			}
 
 			base.uCapturePosAmbient = { probe.capturePos.x, probe.capturePos.y, probe.capturePos.z, 0.22f };
-			base.uParams = { static_cast<float>(lightCount), 0.0f, 0.0f, 0.0f };
+			base.uParams = { static_cast<float>(unclusteredLightCount), 0.0f, 0.0f, 0.0f };
 
 			const std::string passName = "ReflectionProbe_" + std::to_string(probeIndex) + "_VI";
 			graph.AddPass(passName, std::move(att),
@@ -293,12 +391,12 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 						c.uParams[1] = AsFloatBits(flags);
 
 						ctx.commandList.BindInputLayout(b.mesh->layoutInstanced);
-						ctx.commandList.BindVertexBuffer(0, b.mesh->vertexBuffer, b.mesh->vertexStrideBytes, 0);
+						ctx.commandList.BindVertexBuffer(0, b.mesh->vertexBuffer, b.mesh->vertexStrideBytes, b.mesh->vertexOffsetBytes);
 						ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, b.instanceOffset * instStride);
-						ctx.commandList.BindIndexBuffer(b.mesh->indexBuffer, b.mesh->indexType, 0);
+						ctx.commandList.BindIndexBuffer(b.mesh->indexBuffer, b.mesh->indexType, b.mesh->indexOffsetBytes);
 
 						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
-						ctx.commandList.DrawIndexed(b.mesh->indexCount, b.mesh->indexType, 0, 0, b.instanceCount, 0);
+						ctx.commandList.DrawIndexed(b.mesh->indexCount, b.mesh->indexType, b.mesh->firstIndex, b.mesh->baseVertex, b.instanceCount, 0);
 					}
 				});
 		}
@@ -306,12 +404,18 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 		{
 			for (int face = 0; face < 6; ++face)
 			{
+				if (!CaptureFace(face))
+				{
+					continue;
+				}
+
 				renderGraph::PassAttachments att{};
 				att.useSwapChainBackbuffer = false;
 				att.colors = { cubeRG };
 				att.colorCubeFace = static_cast<std::uint32_t>(face);
 				att.depth = depthTmp;
 				att.clearDesc = meshClear;
+				att.parallelRecord = true;
 
 				const mathUtils::Mat4 view = CubeFaceViewRH(probe.capturePos, face);
 				const mathUtils::Mat4 vp = proj90 * view;
@@ -320,13 +424,13 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 				ReflectionCaptureFaceConstants base{};
 				std::memcpy(base.uViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
 				base.uCapturePosAmbient = { probe.capturePos.x, probe.capturePos.y, probe.capturePos.z, 0.22f };
-				base.uParams = { static_cast<float>(lightCount), 0.0f, 0.0f, 0.0f };
+				base.uParams = { static_cast<float>(unclusteredLightCount), 0.0f, 0.0f, 0.0f };
 
 				const std::string passName =
 					"ReflectionProbe_" + std::to_string(probeIndex) + "_Face_" + std::to_string(face);
 
 				graph.AddPass(passName, std::move(att),
-					[this, base, skinnedOpaqueDraws, instStride, captureMainBatches, probeCapturePos = probe.capturePos, viewProj = vp, lightCount](renderGraph::PassContext& ctx) mutable
+					[this, base, skinnedOpaqueDraws, instStride, captureMainBatches, probeCapturePos = probe.capturePos, viewProj = vp, unclusteredLightCount](renderGraph::PassContext& ctx) mutable
 					{
 						ctx.commandList.SetViewport(0, 0, (int)ctx.passExtent.width, (int)ctx.passExtent.height);
 						ctx.commandList.SetState(state_);
@@ -354,12 +458,12 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 							c.uParams[1] = AsFloatBits(flags);
 
 							ctx.commandList.BindInputLayout(b.mesh->layoutInstanced);
-							ctx.commandList.BindVertexBuffer(0, b.mesh->vertexBuffer, b.mesh->vertexStrideBytes, 0);
+							ctx.commandList.BindVertexBuffer(0, b.mesh->vertexBuffer, b.mesh->vertexStrideBytes, b.mesh->vertexOffsetBytes);
 							ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, b.instanceOffset * instStride);
-							ctx.commandList.BindIndexBuffer(b.mesh->indexBuffer, b.mesh->indexType, 0);
+							ctx.commandList.BindIndexBuffer(b.mesh->indexBuffer, b.mesh->indexType, b.mesh->indexOffsetBytes);
 
 							ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
-							ctx.commandList.DrawIndexed(b.mesh->indexCount, b.mesh->indexType, 0, 0, b.instanceCount, 0);
+							ctx.commandList.DrawIndexed(b.mesh->indexCount, b.mesh->indexType, b.mesh->firstIndex, b.mesh->baseVertex, b.instanceCount, 0);
 						}
 
 						if (psoReflectionCaptureSkinned_ && skinPaletteBuffer_)
@@ -387,20 +491,29 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 								std::memcpy(c.uViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
 								c.uCapturePosAmbient = { probeCapturePos.x, probeCapturePos.y, probeCapturePos.z, 0.22f };
 								c.uBaseColor = { draw.material.baseColor.x, draw.material.baseColor.y, draw.material.baseColor.z, draw.material.baseColor.w };
-								c.uParams = { static_cast<float>(lightCount), AsFloatBits(flags), 0.0f, 0.0f };
+								c.uParams = { static_cast<float>(unclusteredLightCount), AsFloatBits(flags), 0.0f, 0.0f };
 								const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
 								std::memcpy(c.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
-								c.uSkinning = { static_cast<float>(draw.paletteOffset), static_cast<float>(draw.boneCount), 0.0f, 0.0f };
+								c.uSkinning = SkinningConstantsFor(draw);
 
-								ctx.commandList.BindInputLayout(draw.mesh->layout);
-								ctx.commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, 0);
-								ctx.commandList.BindIndexBuffer(draw.mesh->indexBuffer, draw.mesh->indexType, 0);
+								BindSkinnedDrawVertices(ctx.commandList, draw);
 								ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
-								ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, 0, 0);
+								ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, draw.mesh->firstIndex, draw.mesh->baseVertex);
 							}
 						}
 					});
 			}
 		}
+
+		// Roughness-based sampling reads the mip chain: rebuild it from the faces just captured.
+		if (device_.SupportsGenerateMips())
+		{
+			graph.AddComputePass("ReflectionProbe_" + std::to_string(probeIndex) + "_Mips",
+				[cubeRG](renderGraph::PassContext& ctx)
+				{
+					ctx.commandList.GenerateMips(ctx.resources.GetTexture(cubeRG));
+				},
+				{ renderGraph::Write(cubeRG, renderGraph::ResourceUsage::Storage) });
+		}
 	}
 }
@@ -19,12 +19,10 @@
 					std::memcpy(constants.uLightViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
 					const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
 					std::memcpy(constants.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
-					constants.uSkinning = { static_cast<float>(draw.paletteOffset), static_cast<float>(draw.boneCount), 0.0f, 0.0f };
-					commandList.BindInputLayout(draw.mesh->layout);
-					commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, 0);
-					commandList.BindIndexBuffer(draw.mesh->indexBuffer, draw.mesh->indexType, 0);
+					constants.uSkinning = SkinningConstantsFor(draw);
+					BindSkinnedDrawVertices(commandList, draw);
 					commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-					commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, 0, 0);
+					commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, draw.mesh->firstIndex, draw.mesh->baseVertex);
 				}
 			};
 
@@ -51,136 +49,294 @@
 					constants.uMisc = { 0.0f, 0.0f, 0.0f, 0.0f };
 					const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
 					std::memcpy(constants.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
-					constants.uSkinning = { static_cast<float>(draw.paletteOffset), static_cast<float>(draw.boneCount), 0.0f, 0.0f };
-					commandList.BindInputLayout(draw.mesh->layout);
-					commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, 0);
-					commandList.BindIndexBuffer(draw.mesh->indexBuffer, draw.mesh->indexType, 0);
+					constants.uSkinning = SkinningConstantsFor(draw);
+					BindSkinnedDrawVertices(commandList, draw);
 					commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-					commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, 0, 0);
+					commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, draw.mesh->firstIndex, draw.mesh->baseVertex);
 				}
 			};
 
+			// ---------------- Static shadow caching ----------------
+			// The directional and spot atlases can start as a copy of a persistent depth that holds only the
+			// static casters (shadowBatches[staticShadowBatchBegin..]); the per-frame passes then draw the
+			// dynamic casters on top. A cache is re-rendered when its light view-projections, its tiles or
+			// staticShadowHash change. Cascades follow the camera, so a moving camera refreshes the directional
+			// cache each frame; spot tiles change size only when a light's screen coverage crosses a power of two.
+			// Point cubemaps are not cached.
+			if (!settings_.enableShadowCaching)
+			{
+				ReleaseShadowCacheTexture(dirShadowCache_);
+				ReleaseShadowCacheTexture(spotShadowCache_);
+			}
+			const bool cacheStaticShadows = settings_.enableShadowCaching && staticShadowBatchBegin < shadowBatches.size();
+
+			// Splits a batch list at its static tail (argsBase: record of batches[0], see DrawInstancedShadowBatches).
+			auto SplitShadowDraws = [](const std::vector<ShadowBatch>& batches, std::size_t staticBegin, std::uint32_t argsBase,
+				ShadowDrawList& dynamicDraws, ShadowDrawList& staticDraws)
+			{
+				dynamicDraws.batches.assign(batches.begin(), batches.begin() + staticBegin);
+				dynamicDraws.argsBase = argsBase;
+				staticDraws.batches.assign(batches.begin() + staticBegin, batches.end());
+				staticDraws.argsBase = (argsBase == kNoShadowIndirectArgs) ? kNoShadowIndirectArgs : argsBase + static_cast<std::uint32_t>(staticBegin);
+			};
+
+			const ShadowDrawList allShadowDraws{ shadowBatches, shadowArgsBase };
+			ShadowDrawList dynamicShadowDraws{};
+			ShadowDrawList staticShadowDraws{};
+			SplitShadowDraws(shadowBatches, staticShadowBatchBegin, shadowArgsBase, dynamicShadowDraws, staticShadowDraws);
+
+			// What each cascade draws: its culled batches (enableCascadeCasterCulling) or the shared ones.
+			std::array<ShadowDrawList, kMaxDirCascades> cascadeAllDraws{};
+			std::array<ShadowDrawList, kMaxDirCascades> cascadeDynamicDraws{};
+			std::array<ShadowDrawList, kMaxDirCascades> cascadeStaticDraws{};
+			for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+			{
+				if (cascadeCasterCulling)
+				{
+					cascadeAllDraws[c] = ShadowDrawList{ cascadeShadowBatches[c], cascadeShadowArgsBase[c] };
+					SplitShadowDraws(cascadeShadowBatches[c], cascadeStaticShadowBatchBegin[c], cascadeShadowArgsBase[c],
+						cascadeDynamicDraws[c], cascadeStaticDraws[c]);
+				}
+				else
+				{
+					cascadeAllDraws[c] = allShadowDraws;
+					cascadeDynamicDraws[c] = dynamicShadowDraws;
+					cascadeStaticDraws[c] = staticShadowDraws;
+				}
+			}
+
+			// Seeds `target` with the static casters of `cache`, re-rendering them first if the cache is stale.
+			// staticDraws[i] is drawn with viewProjs[i] into the viewport of tiles[i].
+			// Returns false if there is nothing cached to copy: the caller draws every caster into a cleared target.
+			auto SeedFromShadowCache = [&](ShadowCacheEntry& cache, renderGraph::RGTextureHandle target, const rhi::Extent2D& extent,
+				std::span<const mathUtils::Mat4> viewProjs, std::span<const ShadowDrawList> staticDraws, std::span<const ShadowAtlasTile> tiles,
+				const std::string& name) -> bool
+			{
+				if (!cacheStaticShadows || viewProjs.size() > cache.viewProj.size() || staticDraws.size() != viewProjs.size() ||
+					tiles.size() != viewProjs.size() || !EnsureShadowCacheTexture(cache, extent))
+				{
+					return false;
+				}
+
+				bool stale = !cache.valid || cache.staticHash != staticShadowHash || cache.viewCount != viewProjs.size();
+				for (std::size_t i = 0; i < viewProjs.size() && !stale; ++i)
+				{
+					stale = std::memcmp(mathUtils::ValuePtr(cache.viewProj[i]), mathUtils::ValuePtr(viewProjs[i]), sizeof(float) * 16) != 0 ||
+						cache.tiles[i].x != tiles[i].x || cache.tiles[i].y != tiles[i].y || cache.tiles[i].size != tiles[i].size;
+				}
+
+				const auto cacheRG = graph.ImportTexture(cache.depth, renderGraph::RGTextureDesc{
+					.extent = extent,
+					.format = rhi::Format::D32_FLOAT,
+					.usage = renderGraph::ResourceUsage::DepthStencil,
+					.debugName = "StaticShadowCache"
+					});
+
+				if (stale)
+				{
+					std::array<SingleMatrixPassConstants, kMaxShadowCacheViews> cacheConstants{};
+					std::array<ShadowDrawList, kMaxShadowCacheViews> cacheDraws{};
+					for (std::size_t i = 0; i < viewProjs.size(); ++i)
+					{
+						const mathUtils::Mat4 vpT = mathUtils::Transpose(viewProjs[i]);
+						std::memcpy(cacheConstants[i].uLightViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
+						cache.viewProj[i] = viewProjs[i];
+						cache.tiles[i] = tiles[i];
+						cacheDraws[i] = staticDraws[i];
+					}
+					cache.viewCount = viewProjs.size();
+					cache.staticHash = staticShadowHash;
+					cache.valid = true;
+
+					rhi::ClearDesc clear{};
+					clear.clearColor = false;
+					clear.clearDepth = true;
+					clear.depth = 1.0f;
+
+					renderGraph::PassAttachments att{};
+					att.useSwapChainBackbuffer = false;
+					att.depth = cacheRG;
+					att.clearDesc = clear;
+					att.parallelRecord = true;
+
+					graph.AddPass(name + "_StaticCache", std::move(att),
+						[this, cacheConstants, cacheDraws, viewCount = viewProjs.size(), cacheTiles = cache.tiles, instStride](renderGraph::PassContext& ctx) mutable
+						{
+							ctx.commandList.SetState(shadowState_);
+							ctx.commandList.BindPipeline(psoShadow_);
+							for (std::size_t i = 0; i < viewCount; ++i)
+							{
+								const ShadowAtlasTile& tile = cacheTiles[i];
+								ctx.commandList.SetViewport(static_cast<int>(tile.x), static_cast<int>(tile.y), static_cast<int>(tile.size), static_cast<int>(tile.size));
+								ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &cacheConstants[i], 1 }));
+								this->DrawInstancedShadowBatches(ctx.commandList, cacheDraws[i].batches, instStride, cacheDraws[i].argsBase);
+							}
+						});
+				}
+
+				graph.AddComputePass(name + "_CopyStatic",
+					[cacheRG, target](renderGraph::PassContext& ctx)
+					{
+						ctx.commandList.CopyTexture(ctx.resources.GetTexture(cacheRG), ctx.resources.GetTexture(target));
+					},
+					{ renderGraph::Read(cacheRG, renderGraph::ResourceUsage::CopySource), renderGraph::Write(target, renderGraph::ResourceUsage::CopyDest) });
+				return true;
+			};
+
 			// ---------------- Create shadow passes (all reuse shadowBatches) ----------------
-			// Directional CSM atlas (depth-only). We clear the whole atlas once, then render each cascade
-			// into its own 2048x2048 viewport tile.
+			// Directional CSM atlas (depth-only). We clear the whole atlas once (or copy the static cache into
+			// it), then render each cascade into its own 2048x2048 viewport tile. The persistent atlas of the
+			// amortized schedule instead clears and redraws only the tiles of the cascades that are due.
+			std::array<ShadowAtlasTile, kMaxDirCascades> dirCascadeTiles{};
+			for (std::uint32_t c = 0; c < dirCascadeCount; ++c)
+			{
+				dirCascadeTiles[c] = ShadowAtlasTile{ .x = c * dirTileSize, .y = 0, .size = dirTileSize };
+			}
+			const bool dirSeeded = !persistentDirAtlas && SeedFromShadowCache(dirShadowCache_, shadowRG, shadowExtent,
+				std::span<const mathUtils::Mat4>(dirCascadeVP.data(), dirCascadeCount),
+				std::span<const ShadowDrawList>(cascadeStaticDraws.data(), dirCascadeCount),
+				std::span<const ShadowAtlasTile>(dirCascadeTiles.data(), dirCascadeCount), "DirShadow");
 			for (std::uint32_t cascade = 0; cascade < dirCascadeCount; ++cascade)
 			{
+				if (!dirCascadeDue[cascade])
+				{
+					continue;
+				}
+
+				const int vpX = static_cast<int>(cascade * dirTileSize);
+				const int vpY = 0;
+				const int vpW = static_cast<int>(dirTileSize);
+				const int vpH = static_cast<int>(dirTileSize);
+
 				rhi::ClearDesc clear{};
 				clear.clearColor = false;
-				clear.clearDepth = (cascade == 0u);
+				clear.clearDepth = persistentDirAtlas || ((cascade == 0u) && !dirSeeded);
 				clear.depth = 1.0f;
+				if (persistentDirAtlas)
+				{
+					clear.rect = rhi::ClearRect{ .x = vpX, .y = vpY, .width = vpW, .height = vpH };
+				}
 
 				renderGraph::PassAttachments att{};
 				att.useSwapChainBackbuffer = false;
 				att.depth = shadowRG;
 				att.clearDesc = clear;
+				att.parallelRecord = true;
 
 				SingleMatrixPassConstants shadowPassConstants{};
 
 				const mathUtils::Mat4 vpT = mathUtils::Transpose(dirCascadeVP[cascade]);
 				std::memcpy(shadowPassConstants.uLightViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
 
-				const int vpX = static_cast<int>(cascade * dirTileSize);
-				const int vpY = 0;
-				const int vpW = static_cast<int>(dirTileSize);
-				const int vpH = static_cast<int>(dirTileSize);
+				const ShadowDrawList& cascadeDraws = dirSeeded ? cascadeDynamicDraws[cascade] : cascadeAllDraws[cascade];
 
 				const char* passName = (cascade == 0u) ? "DirShadow_C0" : (cascade == 1u) ? "DirShadow_C1" : "DirShadow_C2";
 				graph.AddPass(passName, std::move(att),
-					[this, DrawSkinnedShadowPass, shadowPassConstants, shadowBatches, skinnedOpaqueDraws, instStride, vpX, vpY, vpW, vpH, cascadeVP = dirCascadeVP[cascade]](renderGraph::PassContext& ctx) mutable
+					[this, DrawSkinnedShadowPass, shadowPassConstants, cascadeDraws, skinnedOpaqueDraws, instStride, vpX, vpY, vpW, vpH, cascadeVP = dirCascadeVP[cascade]](renderGraph::PassContext& ctx) mutable
 					{
 						ctx.commandList.SetViewport(vpX, vpY, vpW, vpH);
 
 						ctx.commandList.SetState(shadowState_);
+						this->DispatchMeshletShadowBatches(ctx.commandList, cascadeDraws.batches, cascadeVP);
 						ctx.commandList.BindPipeline(psoShadow_);
 
 						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &shadowPassConstants, 1 }));
 
-						this->DrawInstancedShadowBatches(ctx.commandList, shadowBatches, instStride);
+						this->DrawInstancedShadowBatches(ctx.commandList, cascadeDraws.batches, instStride, cascadeDraws.argsBase, psoShadowMeshlet_);
 						DrawSkinnedShadowPass(ctx.commandList, cascadeVP, skinnedOpaqueDraws);
 
 					});
 			}
 
-			// Collect up to kMaxSpotShadows / kMaxPointShadows from scene.lights (index aligns with UploadLights()).
-			for (std::uint32_t lightIndex = 0; lightIndex < static_cast<std::uint32_t>(scene.lights.size()); ++lightIndex)
+			// Spot shadow atlas (spotShadows, picked and packed in RenderFrame_00): one depth texture and one pass,
+			// each light drawing its culled casters into the viewport of its tile. Seeded from the static cache
+			// like the directional atlas.
+			renderGraph::RGTextureHandle spotShadowAtlasRG{};
+			const rhi::Extent2D spotAtlasExtent{ spotAtlasSize, spotAtlasSize };
+			if (!spotShadows.empty())
 			{
-				if (lightIndex >= kMaxLights)
+				spotShadowAtlasRG = graph.CreateTexture(renderGraph::RGTextureDesc{
+					.extent = spotAtlasExtent,
+					.format = rhi::Format::D32_FLOAT,
+					.usage = renderGraph::ResourceUsage::DepthStencil,
+					.debugName = "SpotShadowAtlas"
+					});
+
+				std::array<mathUtils::Mat4, kMaxSpotShadows> spotViewProjs{};
+				std::array<ShadowAtlasTile, kMaxSpotShadows> spotTiles{};
+				std::array<ShadowDrawList, kMaxSpotShadows> spotAllDraws{};
+				std::array<ShadowDrawList, kMaxSpotShadows> spotDynamicDraws{};
+				std::array<ShadowDrawList, kMaxSpotShadows> spotStaticDraws{};
+				for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
 				{
-					break;
+					spotViewProjs[spot] = spotShadows[spot].viewProj;
+					spotTiles[spot] = spotShadows[spot].tile;
+					spotAllDraws[spot] = ShadowDrawList{ spotShadowBatches[spot], spotShadowArgsBase[spot] };
+					SplitShadowDraws(spotShadowBatches[spot], spotStaticShadowBatchBegin[spot], spotShadowArgsBase[spot],
+						spotDynamicDraws[spot], spotStaticDraws[spot]);
 				}
 
-				const auto& light = scene.lights[lightIndex];
+				const bool spotSeeded = SeedFromShadowCache(spotShadowCache_, spotShadowAtlasRG, spotAtlasExtent,
+					std::span<const mathUtils::Mat4>(spotViewProjs.data(), spotShadowCount),
+					std::span<const ShadowDrawList>(spotStaticDraws.data(), spotShadowCount),
+					std::span<const ShadowAtlasTile>(spotTiles.data(), spotShadowCount), "SpotShadow");
+				const std::array<ShadowDrawList, kMaxSpotShadows>& spotDraws = spotSeeded ? spotDynamicDraws : spotAllDraws;
 
-				if (light.type == LightType::Spot && spotShadows.size() < kMaxSpotShadows)
+				std::array<SingleMatrixPassConstants, kMaxSpotShadows> spotPassConstants{};
+				for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
 				{
-					const rhi::Extent2D ext{ 1024, 1024 };
-					const auto rg = graph.CreateTexture(renderGraph::RGTextureDesc{
-						.extent = ext,
-						.format = rhi::Format::D32_FLOAT,
-						.usage = renderGraph::ResourceUsage::DepthStencil,
-						.debugName = "SpotShadowMap"
-						});
-
-					mathUtils::Vec3 lightDirLocal = mathUtils::Normalize(light.direction);
-					mathUtils::Vec3 upVector = (std::abs(mathUtils::Dot(lightDirLocal, mathUtils::Vec3(0, 1, 0))) > 0.99f)
-						? mathUtils::Vec3(0, 0, 1)
-						: mathUtils::Vec3(0, 1, 0);
-
-					mathUtils::Mat4 lightView = mathUtils::LookAt(light.position, light.position + lightDirLocal, upVector);
-
-					const float outerHalf = std::max(1.0f, light.outerHalfAngleDeg);
-					const float farZ = std::max(1.0f, light.range);
-					const float nearZ = std::max(0.5f, farZ * 0.02f);
-					const mathUtils::Mat4 lightProj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(outerHalf * 2.0f), 1.0f, nearZ, farZ);
-					const mathUtils::Mat4 lightViewProj = lightProj * lightView;
-
-					SpotShadowRec rec{};
-					rec.tex = rg;
-					rec.viewProj = lightViewProj;
-					rec.lightIndex = lightIndex;
-					spotShadows.push_back(rec);
-
-					rhi::ClearDesc clear{};
-					clear.clearColor = false;
-					clear.clearDepth = true;
-					clear.depth = 1.0f;
-
-					renderGraph::PassAttachments att{};
-					att.useSwapChainBackbuffer = false;
-					att.depth = rg;
-					att.clearDesc = clear;
+					const mathUtils::Mat4 lightViewProjTranspose = mathUtils::Transpose(spotViewProjs[spot]);
+					std::memcpy(spotPassConstants[spot].uLightViewProj.data(), mathUtils::ValuePtr(lightViewProjTranspose), sizeof(float) * 16);
+				}
 
-					const std::string passName = "SpotShadowPass_" + std::to_string(static_cast<int>(spotShadows.size() - 1));
+				rhi::ClearDesc clear{};
+				clear.clearColor = false;
+				clear.clearDepth = !spotSeeded;
+				clear.depth = 1.0f;
 
-					SingleMatrixPassConstants spotPassConstants{};
-					const mathUtils::Mat4 lightViewProjTranspose = mathUtils::Transpose(lightViewProj);
-					std::memcpy(spotPassConstants.uLightViewProj.data(), mathUtils::ValuePtr(lightViewProjTranspose), sizeof(float) * 16);
+				renderGraph::PassAttachments att{};
+				att.useSwapChainBackbuffer = false;
+				att.depth = spotShadowAtlasRG;
+				att.clearDesc = clear;
+				att.parallelRecord = true;
 
-					graph.AddPass(passName, std::move(att),
-						[this, DrawSkinnedShadowPass, spotPassConstants, shadowBatches, skinnedOpaqueDraws, instStride, lightViewProj](renderGraph::PassContext& ctx) mutable
+				graph.AddPass("SpotShadowAtlas", std::move(att),
+					[this, DrawSkinnedShadowPass, spotPassConstants, spotDraws, spotViewProjs, spotTiles, spotShadowCount, skinnedOpaqueDraws, instStride](renderGraph::PassContext& ctx) mutable
+					{
+						ctx.commandList.SetState(shadowState_);
+						for (std::uint32_t spot = 0; spot < spotShadowCount; ++spot)
 						{
-							ctx.commandList.SetViewport(0, 0,
-								static_cast<int>(ctx.passExtent.width),
-								static_cast<int>(ctx.passExtent.height));
+							const ShadowAtlasTile& tile = spotTiles[spot];
+							ctx.commandList.SetViewport(static_cast<int>(tile.x), static_cast<int>(tile.y), static_cast<int>(tile.size), static_cast<int>(tile.size));
 
-							ctx.commandList.SetState(shadowState_);
 							ctx.commandList.BindPipeline(psoShadow_);
+							ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &spotPassConstants[spot], 1 }));
 
-							ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &spotPassConstants, 1 }));
-
-							this->DrawInstancedShadowBatches(ctx.commandList, shadowBatches, instStride);
-							DrawSkinnedShadowPass(ctx.commandList, lightViewProj, skinnedOpaqueDraws);
+							this->DrawInstancedShadowBatches(ctx.commandList, spotDraws[spot].batches, instStride, spotDraws[spot].argsBase);
+							DrawSkinnedShadowPass(ctx.commandList, spotViewProjs[spot], skinnedOpaqueDraws);
+						}
+					});
+			}
 
-						});
+			// Collect up to kMaxPointShadows from scene.lights (index aligns with UploadLights()).
+			for (std::uint32_t lightIndex = 0; lightIndex < static_cast<std::uint32_t>(scene.lights.size()); ++lightIndex)
+			{
+				if (lightIndex >= kMaxLights)
+				{
+					break;
 				}
-				else if (light.type == LightType::Point && pointShadows.size() < kMaxPointShadows)
+
+				const auto& light = scene.lights[lightIndex];
+
+				if (light.type == LightType::Point && pointShadows.size() < kMaxPointShadows)
 				{
 					// Point shadows use a cubemap R32_FLOAT distance map (color) + depth for rasterization.
 					// Prefer layered one-pass (SV_RenderTargetArrayIndex). If unavailable, try VI (SV_ViewID).
 					// Otherwise we fall back to 6 separate passes (face-by-face).
 					const bool haveSkinnedShadowDraws = !skinnedOpaqueDraws.empty();
+					const std::size_t pointShadowSlot = pointShadows.size();
 					bool useLayered =
+						(pointShadowSlot < layeredPointShadowCount) &&
 						(!disablePointShadowLayered_) &&
 						static_cast<bool>(psoPointShadowLayered_) &&
 						device_.SupportsVPAndRTArrayIndexFromAnyShader() && !haveSkinnedShadowDraws;
@@ -226,8 +382,7 @@
 					rec.lightIndex = lightIndex;
 					pointShadows.push_back(rec);
 
-					const float pointNearZ = 0.01f;
-					const mathUtils::Mat4 proj90 = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(90.0f), 1.0f, pointNearZ, rec.range);
+					const mathUtils::Mat4 proj90 = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(90.0f), 1.0f, pointShadowNearZ, rec.range);
 
 					if (useLayered)
 					{
@@ -244,6 +399,7 @@
 						att.colorCubeAllFaces = true;
 						att.depth = depth;
 						att.clearDesc = clear;
+						att.parallelRecord = true;
 
 						const std::string passName =
 							"PointShadowPassLayered_" + std::to_string(static_cast<int>(pointShadows.size() - 1));
@@ -261,8 +417,11 @@
 						pointShadowConstants.uLightPosRange = { rec.pos.x, rec.pos.y, rec.pos.z, rec.range };
 						pointShadowConstants.uMisc = { 0, 0, 0, 0 };
 
+						// Only the (caster, face) pairs that passed this light's per-face culling.
+						const ShadowDrawList layeredDraws{ pointShadowBatchesLayered[pointShadowSlot], pointShadowArgsBase[pointShadowSlot] };
+
 						graph.AddPass(passName, std::move(att),
-							[this, pointShadowConstants, shadowBatchesLayered, instStride](renderGraph::PassContext& ctx) mutable
+							[this, pointShadowConstants, layeredDraws, instStride](renderGraph::PassContext& ctx) mutable
 							{
 								ctx.commandList.SetViewport(0, 0,
 									static_cast<int>(ctx.passExtent.width),
@@ -270,7 +429,7 @@
 								ctx.commandList.SetState(pointShadowState_);
 								ctx.commandList.BindPipeline(psoPointShadowLayered_);
 								ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &pointShadowConstants, 1 }));
-								this->DrawInstancedShadowBatches(ctx.commandList, shadowBatchesLayered, instStride);
+								this->DrawInstancedShadowBatches(ctx.commandList, layeredDraws.batches, instStride, layeredDraws.argsBase);
 							});
 
 					}
@@ -289,6 +448,7 @@
 						att.colorCubeAllFaces = true;
 						att.depth = depth;
 						att.clearDesc = clear;
+						att.parallelRecord = true;
 
 						const std::string passName =
 							"PointShadowPassVI_" + std::to_string(static_cast<int>(pointShadows.size() - 1));
@@ -306,7 +466,7 @@
 						pointShadowConstants.uMisc = { 0, 0, 0, 0 };
 
 						graph.AddPass(passName, std::move(att),
-							[this, pointShadowConstants, shadowBatches, instStride](renderGraph::PassContext& ctx) mutable
+							[this, pointShadowConstants, shadowBatches, instStride, shadowArgsBase](renderGraph::PassContext& ctx) mutable
 							{
 								ctx.commandList.SetViewport(0, 0,
 									static_cast<int>(ctx.passExtent.width),
@@ -317,7 +477,7 @@
 
 								ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &pointShadowConstants, 1 }));
 
-								this->DrawInstancedShadowBatches(ctx.commandList, shadowBatches, instStride);
+								this->DrawInstancedShadowBatches(ctx.commandList, shadowBatches, instStride, shadowArgsBase);
 
 							});
 					}
@@ -341,6 +501,7 @@
 							att.colorCubeFace = static_cast<std::uint32_t>(face);
 							att.depth = depth;
 							att.clearDesc = clear;
+							att.parallelRecord = true;
 
 							const std::string passName =
 								"PointShadowPass_" + std::to_string(static_cast<int>(pointShadows.size() - 1)) +
@@ -355,7 +516,7 @@
 
 
 							graph.AddPass(passName, std::move(att),
-								[this, DrawSkinnedPointShadowFacePass, pointShadowConstants, shadowBatches, skinnedOpaqueDraws, instStride, faceViewProj, lightPos = rec.pos, lightRange = rec.range](renderGraph::PassContext& ctx) mutable
+								[this, DrawSkinnedPointShadowFacePass, pointShadowConstants, shadowBatches, skinnedOpaqueDraws, instStride, shadowArgsBase, faceViewProj, lightPos = rec.pos, lightRange = rec.range](renderGraph::PassContext& ctx) mutable
 								{
 									ctx.commandList.SetViewport(0, 0,
 										static_cast<int>(ctx.passExtent.width),
@@ -366,7 +527,7 @@
 
 									ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &pointShadowConstants, 1 }));
 
-									this->DrawInstancedShadowBatches(ctx.commandList, shadowBatches, instStride);
+									this->DrawInstancedShadowBatches(ctx.commandList, shadowBatches, instStride, shadowArgsBase);
 									DrawSkinnedPointShadowFacePass(ctx.commandList, faceViewProj, lightPos, lightRange, skinnedOpaqueDraws);
 
 								});
@@ -407,6 +568,7 @@
 					sd.dirInfo = mathUtils::Vec4(invAtlasW, invAtlasH, invTile, static_cast<float>(dirCascadeCount));
 				}
 
+				const float invSpotAtlas = 1.0f / static_cast<float>(spotAtlasSize);
 				for (std::size_t spotShadowIndex = 0; spotShadowIndex < spotShadows.size(); ++spotShadowIndex)
 				{
 					const auto& spotShadow = spotShadows[spotShadowIndex];
@@ -419,6 +581,13 @@
 					sd.spotVPRows[spotShadowIndex * 4 + 3] = vp[3];
 
 					sd.spotInfo[spotShadowIndex] = mathUtils::Vec4(AsFloatBits(spotShadow.lightIndex), 0, 0.0f, 0);
+
+					const ShadowAtlasTile& tile = spotShadow.tile;
+					sd.spotAtlasRect[spotShadowIndex] = mathUtils::Vec4(
+						static_cast<float>(tile.x) * invSpotAtlas,
+						static_cast<float>(tile.y) * invSpotAtlas,
+						static_cast<float>(tile.size) * invSpotAtlas,
+						1.0f / static_cast<float>(tile.size));
 				}
 
 				for (std::size_t pointShadowIndex = 0; pointShadowIndex < pointShadows.size(); ++pointShadowIndex)
@@ -431,3 +600,17 @@
 				device_.UpdateBuffer(shadowDataBuffer_, std::as_bytes(std::span{ &sd, 1 }));
 			}
 
+
+			// Passes that sample the shadow maps declare them, so the graph keeps the shadow passes alive.
+			auto ReadShadowMaps = [shadowRG, spotShadowAtlasRG, &spotShadows, &pointShadows](std::vector<renderGraph::RGTextureAccess>& textures)
+			{
+				textures.push_back(renderGraph::Read(shadowRG));
+				if (!spotShadows.empty())
+				{
+					textures.push_back(renderGraph::Read(spotShadowAtlasRG));
+				}
+				for (const PointShadowRec& pointShadow : pointShadows)
+				{
+					textures.push_back(renderGraph::Read(pointShadow.cube));
+				}
+			};
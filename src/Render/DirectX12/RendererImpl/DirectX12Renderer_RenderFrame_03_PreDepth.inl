@@ -1,5 +1,6 @@
 // ---------------- Optional depth pre-pass (swapchain depth) ----------------
-const bool doDepthPrepass = settings_.enableDepthPrepass && !settings_.enableDeferred;
+// Draws the camera-visible occluders (prepassBatches, see depthPrepassMinScreenSize) through the depth-only
+// vertex streams; its depth is what the HiZ pyramid of the GPU culling pass is built from (RenderFrame_03a).
 if (doDepthPrepass && psoShadow_)
 {
 	// We use the existing depth-only shadow shader (writes SV_Depth, no color outputs).
@@ -10,7 +11,7 @@ if (doDepthPrepass && psoShadow_)
 	preClear.depth = 1.0f;
 
 	graph.AddSwapChainPass("PreDepthPass", preClear,
-		[this, &scene, shadowBatches, skinnedOpaqueDraws, instStride](renderGraph::PassContext& ctx) mutable
+		[this, &scene, &prepassBatches, skinnedOpaqueDraws, instStride, prepassArgsBase](renderGraph::PassContext& ctx) mutable
 		{
 			const auto extent = ctx.passExtent;
 			ctx.commandList.SetViewport(0, 0,
@@ -28,7 +29,7 @@ if (doDepthPrepass && psoShadow_)
 			std::memcpy(c.uLightViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
 			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
 
-			this->DrawInstancedShadowBatches(ctx.commandList, shadowBatches, instStride);
+			this->DrawInstancedShadowBatches(ctx.commandList, prepassBatches, instStride, prepassArgsBase);
 
 			if (psoShadowSkinned_ && skinPaletteBuffer_)
 			{
@@ -45,13 +46,135 @@ if (doDepthPrepass && psoShadow_)
 					std::memcpy(skinnedConstants.uLightViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
 					const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
 					std::memcpy(skinnedConstants.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
-					skinnedConstants.uSkinning = { static_cast<float>(draw.paletteOffset), static_cast<float>(draw.boneCount), 0.0f, 0.0f };
-					ctx.commandList.BindInputLayout(draw.mesh->layout);
-					ctx.commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, 0);
-					ctx.commandList.BindIndexBuffer(draw.mesh->indexBuffer, draw.mesh->indexType, 0);
+					skinnedConstants.uSkinning = SkinningConstantsFor(draw);
+					BindSkinnedDrawVertices(ctx.commandList, draw);
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &skinnedConstants, 1 }));
-					ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, 0, 0);
+					ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, draw.mesh->firstIndex, draw.mesh->baseVertex);
 				}
 			}
 		});
-}
\ No newline at end of file
+}
+// ---------------- Editor object-ID buffer (frames with RequestObjectIdPick requests only) ----------------
+// The camera-visible opaque batches, the transparent draws and the skinned draws write their object ID
+// (ObjectIdForDrawItem / ObjectIdForSkinnedDrawItem) into an R32_UINT target with its own depth; then every
+// request reads its rect back (rhi::CommandReadbackTexture), which TakeObjectIdPick hands out once the
+// GPU is done with the frame. Kept out of the swap chain pre-depth pass above: that one only runs in
+// forward mode with enableDepthPrepass, picking has to work with any settings.
+if (!objectIdPickRequests_.empty() && SupportsObjectIdPicking())
+{
+	std::pmr::vector<std::uint32_t> instanceObjectIds(combinedInstanceRefs.size(), kObjectIdNone, &frameArena_);
+	for (std::size_t instanceIndex = 0; instanceIndex < combinedInstanceRefs.size(); ++instanceIndex)
+	{
+		const InstanceRef ref = combinedInstanceRefs[instanceIndex];
+		if (ref != kNoInstanceRef)
+		{
+			instanceObjectIds[instanceIndex] = ObjectIdForDrawItem(ref & kInstanceRefSlotMask);
+		}
+	}
+	if (!instanceObjectIds.empty())
+	{
+		device_.UpdateBuffer(objectIdBuffer_, std::as_bytes(std::span{ instanceObjectIds }));
+	}
+
+	const rhi::Extent2D objectIdExtent = swapChain.GetDesc().extent;
+	const auto objectIds = graph.CreateTexture(renderGraph::RGTextureDesc{
+		.extent = objectIdExtent,
+		.format = rhi::Format::R32_UINT,
+		.usage = renderGraph::ResourceUsage::RenderTarget,
+		.debugName = "ObjectIds"
+		});
+	const auto objectIdDepth = graph.CreateTexture(renderGraph::RGTextureDesc{
+		.extent = objectIdExtent,
+		.format = rhi::Format::D32_FLOAT,
+		.usage = renderGraph::ResourceUsage::DepthStencil,
+		.debugName = "ObjectIdDepth"
+		});
+
+	renderGraph::PassAttachments att{};
+	att.useSwapChainBackbuffer = false;
+	att.colors = { objectIds };
+	att.depth = objectIdDepth;
+	att.clearDesc.clearColor = true;
+	att.clearDesc.clearDepth = true;
+	att.clearDesc.color = { 0.0f, 0.0f, 0.0f, 0.0f }; // kObjectIdNone
+	att.clearDesc.depth = 1.0f;
+
+	graph.AddPass("ObjectIdPass", std::move(att),
+		[this, &scene, &mainBatches, &transparentDraws, &skinnedOpaqueDraws, instStride](renderGraph::PassContext& ctx)
+		{
+			const auto extent = ctx.passExtent;
+			ctx.commandList.SetViewport(0, 0,
+				static_cast<int>(extent.width),
+				static_cast<int>(extent.height));
+			ctx.commandList.SetState(preDepthState_);
+
+			const FrameCameraData camera = BuildFrameCameraData(scene, extent);
+			const mathUtils::Mat4 vpT = mathUtils::Transpose(camera.viewProj);
+
+			ctx.commandList.BindPipeline(psoObjectId_);
+			ctx.commandList.BindStructuredBufferSRV(0, objectIdBuffer_);
+			ObjectIdPassConstants constants{};
+			std::memcpy(constants.uViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
+
+			auto DrawInstances = [&](const rendern::MeshRHI& mesh, std::uint32_t instanceOffset, std::uint32_t instanceCount)
+				{
+					constants.uObject = { instanceOffset, 0u, 0u, 0u };
+					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
+					ctx.commandList.BindInputLayout(mesh.layoutInstanced);
+					ctx.commandList.BindVertexBuffer(0, mesh.vertexBuffer, mesh.vertexStrideBytes, mesh.vertexOffsetBytes);
+					ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, instanceOffset * instStride);
+					ctx.commandList.BindIndexBuffer(mesh.indexBuffer, mesh.indexType, mesh.indexOffsetBytes);
+					ctx.commandList.DrawIndexed(mesh.indexCount, mesh.indexType, mesh.firstIndex, mesh.baseVertex, instanceCount, 0);
+				};
+			for (const Batch& batch : mainBatches)
+			{
+				if (batch.mesh && batch.instanceCount != 0)
+				{
+					DrawInstances(*batch.mesh, batch.instanceOffset, batch.instanceCount);
+				}
+			}
+			// Transparent surfaces are picked like opaque ones: the closest surface wins.
+			for (const TransparentDraw& draw : transparentDraws)
+			{
+				if (draw.mesh)
+				{
+					DrawInstances(*draw.mesh, draw.instanceOffset, draw.instanceCount);
+				}
+			}
+
+			if (psoObjectIdSkinned_ && skinPaletteBuffer_)
+			{
+				ctx.commandList.BindPipeline(psoObjectIdSkinned_);
+				ctx.commandList.BindStructuredBufferSRV(19, skinPaletteBuffer_);
+				for (const SkinnedOpaqueDraw& draw : skinnedOpaqueDraws)
+				{
+					if (!draw.mesh || draw.boneCount == 0 || draw.sourceSkinnedDrawIndex < 0)
+					{
+						continue;
+					}
+
+					SkinnedObjectIdPassConstants skinnedConstants{};
+					std::memcpy(skinnedConstants.uViewProj.data(), mathUtils::ValuePtr(vpT), sizeof(float) * 16);
+					const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
+					std::memcpy(skinnedConstants.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
+					skinnedConstants.uSkinning = SkinningConstantsFor(draw);
+					skinnedConstants.uObject = { ObjectIdForSkinnedDrawItem(static_cast<std::size_t>(draw.sourceSkinnedDrawIndex)), 0u, 0u, 0u };
+					BindSkinnedDrawVertices(ctx.commandList, draw);
+					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &skinnedConstants, 1 }));
+					ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, draw.mesh->firstIndex, draw.mesh->baseVertex);
+				}
+			}
+		});
+
+	// Read-only use of the IDs: the graph keeps the pass (and so the ID pass) and moves them to CopySource.
+	graph.AddComputePass("ObjectIdReadback",
+		[this, objectIds, requests = std::exchange(objectIdPickRequests_, {})](renderGraph::PassContext& ctx)
+		{
+			const rhi::TextureHandle texture = ctx.resources.GetTexture(objectIds);
+			for (const auto& [requestId, request] : requests)
+			{
+				ctx.commandList.ReadbackTexture(texture, request.x, request.y, request.width, request.height, requestId);
+			}
+		},
+		{ renderGraph::Read(objectIds, renderGraph::ResourceUsage::CopySource) });
+}
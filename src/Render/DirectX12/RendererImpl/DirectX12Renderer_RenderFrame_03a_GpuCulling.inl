@@ -0,0 +1,132 @@
+// ---------------- GPU culling of the forward opaque batches (compute) ----------------
+// The CPU only packs mainBatches (no per-item test when gpuCullMain). One thread per main instance
+// tests the frustum and, when the depth prepass ran, a HiZ pyramid built from its depth (the large occluders
+// only, so the pyramid is conservative and needs no depth pass of its own); survivors
+// are compacted per batch into gpuCulledInstanceBuffer_ and counted into the batch's indirect args.
+// Batches past kMaxGpuCullBatches keep the regular (unculled) draw.
+// Both passes go on the async compute queue when enabled; they are declared ahead of the shadow and
+// reflection passes so those overlap them, and the forward opaque pass joins them through its buffer reads.
+std::uint32_t gpuCullBatchCount = 0;
+if (gpuCullMain && !mainBatches.empty())
+{
+	gpuCullBatchCount = static_cast<std::uint32_t>(std::min<std::size_t>(mainBatches.size(), kMaxGpuCullBatches));
+
+	std::vector<rhi::DrawIndexedIndirectArgs> gpuCullArgs(gpuCullBatchCount);
+	std::vector<GpuCullBatchData> gpuCullBatches(gpuCullBatchCount);
+	std::vector<std::uint32_t> gpuCullInstanceBatch;
+	gpuCullInstanceBatch.reserve(mainInstances.size());
+	for (std::uint32_t batchIndex = 0; batchIndex < gpuCullBatchCount; ++batchIndex)
+	{
+		const Batch& batch = mainBatches[batchIndex];
+		gpuCullArgs[batchIndex].indexCount = batch.mesh ? batch.mesh->indexCount : 0u;
+		gpuCullArgs[batchIndex].instanceCount = 0u;
+		gpuCullArgs[batchIndex].firstIndex = batch.mesh ? batch.mesh->firstIndex : 0u;
+		gpuCullArgs[batchIndex].baseVertex = batch.mesh ? batch.mesh->baseVertex : 0;
+
+		GpuCullBatchData& data = gpuCullBatches[batchIndex];
+		// The instance rows map from the vertex buffer's space (quantized for compact meshes).
+		data.sphere = batch.mesh ? rendern::MeshVertexSpaceSphere(batch.boundsSphere, *batch.mesh) : batch.boundsSphere;
+		data.outputOffset = batch.instanceOffset - mainBase;
+		data.instanceCount = batch.instanceCount;
+		gpuCullInstanceBatch.insert(gpuCullInstanceBatch.end(), batch.instanceCount, batchIndex);
+	}
+
+	device_.UpdateBuffer(gpuCullArgsBuffer_, std::as_bytes(std::span{ gpuCullArgs }));
+	device_.UpdateBuffer(gpuCullBatchBuffer_, std::as_bytes(std::span{ gpuCullBatches }));
+	device_.UpdateBuffer(gpuCullInstanceBatchBuffer_, std::as_bytes(std::span{ gpuCullInstanceBatch }));
+
+	const rhi::TextureHandle sceneDepth = swapChain.GetDepthTexture();
+	const bool gpuOcclusion = doDepthPrepass && psoShadow_ && sceneDepth;
+	if (gpuOcclusion)
+	{
+		EnsureHiZBuffer(scDesc.extent);
+
+		const auto hiZDepthRG = graph.ImportTexture(sceneDepth, renderGraph::RGTextureDesc{
+			.extent = scDesc.extent,
+			.format = rhi::Format::D24_UNORM_S8_UINT,
+			.usage = renderGraph::ResourceUsage::Sampled,
+			.debugName = "SwapChainDepth_Imported_HiZ"
+			});
+
+		graph.AddComputePass("HiZBuild", [this, sceneDepth](renderGraph::PassContext& ctx)
+			{
+				ctx.commandList.BindPipeline(psoHiZBuild_);
+				ctx.commandList.BindTexture2D(0, sceneDepth);
+				ctx.commandList.BindBufferUAV(0, hiZBuffer_);
+
+				for (std::uint32_t level = 0; level < hiZLevelCount_; ++level)
+				{
+					HiZBuildConstants c{};
+					if (level == 0)
+					{
+						c.uSrc = { 0u, hiZExtent_.width, hiZExtent_.height, 1u };
+					}
+					else
+					{
+						c.uSrc = hiZLevels_[level - 1];
+					}
+					c.uDst = hiZLevels_[level];
+					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
+					ctx.commandList.Dispatch((c.uDst[1] + 7u) / 8u, (c.uDst[2] + 7u) / 8u);
+				}
+
+				// Leave t0 as the null SRV for the graphics passes that follow.
+				ctx.commandList.BindTextureDesc(0, 0);
+			}, { renderGraph::Read(hiZDepthRG) }, { renderGraph::Write(hiZBuffer_) }, settings_.enableAsyncCompute);
+	}
+
+	GpuCullConstants cullConstants{};
+	const mathUtils::Mat4 cullViewProjT = mathUtils::Transpose(cameraViewProj);
+	std::memcpy(cullConstants.uViewProj.data(), mathUtils::ValuePtr(cullViewProjT), sizeof(float) * 16);
+	for (std::size_t planeIndex = 0; planeIndex < 6; ++planeIndex)
+	{
+		const mathUtils::Plane& plane = cameraFrustum.planes[planeIndex];
+		cullConstants.uPlanes[planeIndex * 4 + 0] = plane.norm.x;
+		cullConstants.uPlanes[planeIndex * 4 + 1] = plane.norm.y;
+		cullConstants.uPlanes[planeIndex * 4 + 2] = plane.norm.z;
+		cullConstants.uPlanes[planeIndex * 4 + 3] = plane.dist;
+	}
+	const std::uint32_t gpuCullInstanceCount = static_cast<std::uint32_t>(gpuCullInstanceBatch.size());
+	cullConstants.uCounts = { gpuCullInstanceCount, gpuOcclusion ? 1u : 0u, gpuOcclusion ? hiZLevelCount_ : 0u, mainBase };
+	cullConstants.uDepthSize = {
+		static_cast<float>(scDesc.extent.width),
+		static_cast<float>(scDesc.extent.height),
+		scDesc.extent.width ? 1.0f / static_cast<float>(scDesc.extent.width) : 0.0f,
+		scDesc.extent.height ? 1.0f / static_cast<float>(scDesc.extent.height) : 0.0f };
+	for (std::uint32_t level = 0; level < hiZLevelCount_; ++level)
+	{
+		std::memcpy(&cullConstants.uHiZLevels[level * 4], hiZLevels_[level].data(), sizeof(std::uint32_t) * 4);
+	}
+
+	std::vector<renderGraph::RGBufferAccess> cullBuffers = {
+		renderGraph::Read(instanceBuffer_),
+		renderGraph::Read(gpuCullBatchBuffer_),
+		renderGraph::Read(gpuCullInstanceBatchBuffer_),
+		renderGraph::Write(gpuCulledInstanceBuffer_),
+		renderGraph::Write(gpuCullArgsBuffer_) };
+	if (gpuOcclusion)
+	{
+		cullBuffers.push_back(renderGraph::Read(hiZBuffer_));
+	}
+	graph.AddComputePass("GpuCull", [this, cullConstants, gpuCullInstanceCount, gpuOcclusion](renderGraph::PassContext& ctx)
+		{
+			ctx.commandList.BindPipeline(psoGpuCull_);
+			if (gpuOcclusion)
+			{
+				ctx.commandList.BindStructuredBufferSRV(0, hiZBuffer_);
+			}
+			ctx.commandList.BindStructuredBufferSRV(1, instanceBuffer_);
+			ctx.commandList.BindStructuredBufferSRV(2, gpuCullBatchBuffer_);
+			ctx.commandList.BindStructuredBufferSRV(3, gpuCullInstanceBatchBuffer_);
+			ctx.commandList.BindBufferUAV(0, gpuCulledInstanceBuffer_);
+			ctx.commandList.BindBufferUAV(1, gpuCullArgsBuffer_);
+			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &cullConstants, 1 }));
+			ctx.commandList.Dispatch((gpuCullInstanceCount + 63u) / 64u);
+
+			// Back to the defaults the graphics passes expect: null texture SRVs, null buffer SRV at t2.
+			ctx.commandList.BindTextureDesc(0, 0);
+			ctx.commandList.BindTextureDesc(1, 0);
+			ctx.commandList.BindStructuredBufferSRV(2, {});
+			ctx.commandList.BindTextureDesc(3, 0);
+		}, {}, std::move(cullBuffers), settings_.enableAsyncCompute);
+}
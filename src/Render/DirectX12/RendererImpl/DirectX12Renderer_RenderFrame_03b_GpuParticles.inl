@@ -0,0 +1,152 @@
+// ---------------- GPU particles (compute) ----------------
+// With scene.simulateParticlesOnGpu the scene's emitters only advance their spawnSequence. Every frame the
+// sequence numbers added since the last frame are spawned into the GPU pool (same random streams as
+// Scene::EmitParticleFromEmitter), then the pool is simulated, bitonic-sorted back to front and drawn by the
+// main passes with one indirect draw (DrawGpuParticles). A restarted emitter (spawnSequence went back) gets
+// a new generation, which kills its old particles; a shrinking emitter list clears the pool.
+bool drawGpuParticles = false;
+if (!scene.simulateParticlesOnGpu)
+{
+	gpuParticlePoolReset_ = true;
+}
+else if (psoParticleInit_ && psoParticleEmit_ && psoParticleBeginSimulate_ && psoParticleSimulate_ &&
+	psoParticleSortLocal_ && psoParticleSortMerge_ && psoParticleSortStep_ && psoParticlesGpu_ && gpuParticleBuffer_)
+{
+	const std::uint32_t emitterCount = static_cast<std::uint32_t>(
+		std::min<std::size_t>(scene.particleEmitters.size(), kMaxGpuParticleEmitters));
+
+	if (gpuParticleEmitters_.size() > emitterCount)
+	{
+		gpuParticlePoolReset_ = true;
+	}
+	if (gpuParticlePoolReset_)
+	{
+		// Start from the emitters' current sequence: what was spawned before lived on the CPU (or is gone).
+		gpuParticleEmitters_.clear();
+		for (std::uint32_t i = 0; i < emitterCount; ++i)
+		{
+			gpuParticleEmitters_.push_back(GpuParticleEmitterState{ .spawnedSequence = scene.particleEmitters[i].spawnSequence });
+		}
+	}
+	gpuParticleEmitters_.resize(emitterCount);
+
+	std::vector<GpuParticleEmitterData> emitterData(emitterCount);
+	std::vector<GpuParticleSpawnRange> spawnRanges;
+	std::uint32_t spawnCount = 0;
+	for (std::uint32_t i = 0; i < emitterCount; ++i)
+	{
+		const ParticleEmitter& emitter = scene.particleEmitters[i];
+		GpuParticleEmitterState& state = gpuParticleEmitters_[i];
+		if (emitter.spawnSequence < state.spawnedSequence)
+		{
+			++state.generation;
+			state.spawnedSequence = 0;
+		}
+
+		// More new particles than the emitter (or the pool) can hold: keep the newest.
+		std::uint32_t newCount = emitter.spawnSequence - state.spawnedSequence;
+		if (emitter.maxParticles > 0u)
+		{
+			newCount = std::min(newCount, emitter.maxParticles);
+		}
+		newCount = std::min(newCount, kGpuParticlePoolSize - spawnCount);
+		if (newCount > 0u)
+		{
+			spawnRanges.push_back(GpuParticleSpawnRange{
+				.emitterIndex = i,
+				.firstSequence = emitter.spawnSequence - newCount,
+				.count = newCount,
+				.firstSpawn = spawnCount });
+			spawnCount += newCount;
+		}
+		state.spawnedSequence = emitter.spawnSequence;
+
+		GpuParticleEmitterData& data = emitterData[i];
+		data.positionLifetimeMin = mathUtils::Vec4(emitter.position, emitter.lifetimeMin);
+		data.jitterLifetimeMax = mathUtils::Vec4(emitter.positionJitter, emitter.lifetimeMax);
+		data.velocityMinSizeMin = mathUtils::Vec4(emitter.velocityMin, emitter.sizeMin);
+		data.velocityMaxSizeMax = mathUtils::Vec4(emitter.velocityMax, emitter.sizeMax);
+		data.colorBegin = emitter.colorBegin;
+		data.colorEnd = emitter.colorEnd;
+		data.sizeBeginEnd = mathUtils::Vec4(emitter.sizeBegin, emitter.sizeEnd, 0.0f, 0.0f);
+		data.params = { emitter.textureDescIndex, emitter.maxParticles, state.generation, 0u };
+		data.uvRect = emitter.uvRect;
+		data.flipbook = ParticleFlipbookParams(emitter);
+	}
+
+	if (emitterCount > 0u)
+	{
+		device_.UpdateBuffer(gpuParticleEmitterBuffer_, std::as_bytes(std::span{ emitterData }));
+	}
+	if (!spawnRanges.empty())
+	{
+		device_.UpdateBuffer(gpuParticleSpawnBuffer_, std::as_bytes(std::span{ spawnRanges }));
+	}
+
+	const mathUtils::Vec3 particleCamForward = mathUtils::Normalize(scene.camera.target - scene.camera.position);
+	GpuParticleConstants particleConstants{};
+	particleConstants.uCameraPosDt = {
+		scene.camera.position.x, scene.camera.position.y, scene.camera.position.z, scene.particleDeltaSeconds };
+	particleConstants.uCameraForward = { particleCamForward.x, particleCamForward.y, particleCamForward.z, 0.0f };
+	particleConstants.uCounts = { static_cast<std::uint32_t>(spawnRanges.size()), spawnCount, emitterCount, kGpuParticlePoolSize };
+	particleConstants.uParams = { 0u, 0u, particleMesh_.indexCount, 0u };
+
+	const bool resetPool = std::exchange(gpuParticlePoolReset_, false);
+	graph.AddComputePass("GpuParticles", [this, particleConstants, resetPool](renderGraph::PassContext& ctx)
+		{
+			GpuParticleConstants c = particleConstants;
+			auto Run = [&ctx, &c](rhi::PipelineHandle pso, std::uint32_t groupCount)
+				{
+					ctx.commandList.BindPipeline(pso);
+					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
+					ctx.commandList.Dispatch(groupCount);
+				};
+
+			ctx.commandList.BindStructuredBufferSRV(0, gpuParticleEmitterBuffer_);
+			ctx.commandList.BindStructuredBufferSRV(1, gpuParticleSpawnBuffer_);
+			ctx.commandList.BindBufferUAV(0, gpuParticleBuffer_);
+			ctx.commandList.BindBufferUAV(1, gpuParticleDeadListBuffer_);
+			ctx.commandList.BindBufferUAV(2, gpuParticleCountersBuffer_);
+			ctx.commandList.BindBufferUAV(3, gpuParticleSortBuffer_);
+
+			if (resetPool)
+			{
+				Run(psoParticleInit_, kGpuParticlePoolSize / 64u);
+			}
+			if (c.uCounts[1] > 0u)
+			{
+				Run(psoParticleEmit_, (c.uCounts[1] + 63u) / 64u);
+			}
+			Run(psoParticleBeginSimulate_, kMaxGpuParticleEmitters / 64u);
+			Run(psoParticleSimulate_, kGpuParticlePoolSize / 64u);
+
+			// Bitonic sort: blocks sorted in groupshared memory, then every larger stage as global steps
+			// down to the block size plus one groupshared merge.
+			constexpr std::uint32_t sortGroups = kGpuParticlePoolSize / kGpuParticleSortBlock;
+			Run(psoParticleSortLocal_, sortGroups);
+			for (std::uint32_t k = kGpuParticleSortBlock * 2u; k <= kGpuParticlePoolSize; k <<= 1u)
+			{
+				for (std::uint32_t j = k >> 1u; j >= kGpuParticleSortBlock; j >>= 1u)
+				{
+					c.uParams[0] = k;
+					c.uParams[1] = j;
+					Run(psoParticleSortStep_, kGpuParticlePoolSize / 2u / 256u);
+				}
+				c.uParams[0] = k;
+				c.uParams[1] = kGpuParticleSortBlock / 2u;
+				Run(psoParticleSortMerge_, sortGroups);
+			}
+
+			// Back to the defaults the graphics passes expect: null SRVs at t0/t1.
+			ctx.commandList.BindTextureDesc(0, 0);
+			ctx.commandList.BindTextureDesc(1, 0);
+		}, {}, {
+			renderGraph::Read(gpuParticleEmitterBuffer_),
+			renderGraph::Read(gpuParticleSpawnBuffer_),
+			renderGraph::Write(gpuParticleBuffer_),
+			renderGraph::Write(gpuParticleDeadListBuffer_),
+			renderGraph::Write(gpuParticleCountersBuffer_),
+			renderGraph::Write(gpuParticleSortBuffer_) }, settings_.enableAsyncCompute);
+
+	drawGpuParticles = true;
+}
@@ -1,12 +1,3 @@
-// ---------------- Deferred path (DX12) ----------------
-const bool canDeferred =
-settings_.enableDeferred &&
-device_.GetBackend() == rhi::Backend::DirectX12 &&
-psoDeferredGBuffer_ &&
-psoDeferredLighting_ &&
-fullscreenLayout_ &&
-swapChain.GetDepthTexture();
-
 std::uint32_t activeReflectionProbeCount = 0u;
 
 struct EditorSelectionLists
@@ -74,7 +65,7 @@ auto BuildEditorSelectionLists = [&]() -> EditorSelectionLists
 			EditorSelectionDraw sel{};
 			sel.mesh = mesh;
 
-			const mathUtils::Mat4 model = di.transform.ToMatrix();
+			const mathUtils::Mat4 model = rendern::MeshVertexTransform(di.transform.ToMatrix(), *mesh);
 			sel.instance.i0 = model[0];
 			sel.instance.i1 = model[1];
 			sel.instance.i2 = model[2];
@@ -197,16 +188,12 @@ auto ComputeForwardGBufferReflectionMeta = [&](MaterialHandle materialHandle, in
 		return result;
 	};
 
-auto ComputeDeferredGBufferReflectionMeta = [&](MaterialHandle materialHandle, int reflectionProbeIndex, const std::vector<int>& deferredProbeRemap, std::uint32_t activeProbeCount)
+// (envSource, normalized compact probe index) of a probe for the G-buffer; (0, 0) = skybox. The material
+// table path applies the material's env source in the shader, the skinned draws through the wrapper below.
+auto ComputeDeferredGBufferProbeMeta = [&](int reflectionProbeIndex, const std::vector<int>& deferredProbeRemap, std::uint32_t activeProbeCount)
 	{
 		std::pair<float, float> result{ 0.0f, 0.0f };
-		if (!settings_.enableReflectionCapture || materialHandle.id == 0 || reflectionProbeIndex < 0 || activeProbeCount == 0u || static_cast<std::size_t>(reflectionProbeIndex) >= deferredProbeRemap.size())
-		{
-			return result;
-		}
-
-		const auto& mat = scene.GetMaterial(materialHandle);
-		if (mat.envSource != EnvSource::ReflectionCapture)
+		if (!settings_.enableReflectionCapture || reflectionProbeIndex < 0 || activeProbeCount == 0u || static_cast<std::size_t>(reflectionProbeIndex) >= deferredProbeRemap.size())
 		{
 			return result;
 		}
@@ -222,6 +209,15 @@ auto ComputeDeferredGBufferReflectionMeta = [&](MaterialHandle materialHandle, i
 		return result;
 	};
 
+auto ComputeDeferredGBufferReflectionMeta = [&](MaterialHandle materialHandle, int reflectionProbeIndex, const std::vector<int>& deferredProbeRemap, std::uint32_t activeProbeCount)
+	{
+		if (materialHandle.id == 0 || scene.GetMaterial(materialHandle).envSource != EnvSource::ReflectionCapture)
+		{
+			return std::pair<float, float>{ 0.0f, 0.0f };
+		}
+		return ComputeDeferredGBufferProbeMeta(reflectionProbeIndex, deferredProbeRemap, activeProbeCount);
+	};
+
 auto MakeEditorSelectionConstants = [&](const mathUtils::Mat4& viewProj,
 	const mathUtils::Mat4& dirLightViewProj,
 	const mathUtils::Vec3& camPosLocal,
@@ -269,16 +265,16 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 		auto BindEditorSelectionGeometry = [&](const rendern::MeshRHI& mesh)
 			{
 				ctx.commandList.BindInputLayout(mesh.layoutInstanced);
-				ctx.commandList.BindVertexBuffer(0, mesh.vertexBuffer, mesh.vertexStrideBytes, 0);
+				ctx.commandList.BindVertexBuffer(0, mesh.vertexBuffer, mesh.vertexStrideBytes, mesh.vertexOffsetBytes);
 				ctx.commandList.BindVertexBuffer(1, highlightInstanceBuffer_, instStride, 0);
-				ctx.commandList.BindIndexBuffer(mesh.indexBuffer, mesh.indexType, 0);
+				ctx.commandList.BindIndexBuffer(mesh.indexBuffer, mesh.indexType, mesh.indexOffsetBytes);
 			};
 
 		auto BindEditorSelectionSkinnedGeometry = [&](const rendern::SkinnedMeshRHI& mesh)
 			{
 				ctx.commandList.BindInputLayout(mesh.layout);
-				ctx.commandList.BindVertexBuffer(0, mesh.vertexBuffer, mesh.vertexStrideBytes, 0);
-				ctx.commandList.BindIndexBuffer(mesh.indexBuffer, mesh.indexType, 0);
+				ctx.commandList.BindVertexBuffer(0, mesh.vertexBuffer, mesh.vertexStrideBytes, mesh.vertexOffsetBytes);
+				ctx.commandList.BindIndexBuffer(mesh.indexBuffer, mesh.indexType, mesh.indexOffsetBytes);
 				ctx.commandList.BindStructuredBufferSRV(19, skinPaletteBuffer_);
 			};
 
@@ -353,7 +349,7 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 						s.paletteOffset,
 						s.boneCount);
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &markConstants, 1 }));
-					ctx.commandList.DrawIndexed(s.skinnedMesh->indexCount, s.skinnedMesh->indexType, 0, 0);
+					ctx.commandList.DrawIndexed(s.skinnedMesh->indexCount, s.skinnedMesh->indexType, s.skinnedMesh->firstIndex, s.skinnedMesh->baseVertex);
 				}
 				else
 				{
@@ -364,7 +360,7 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 						camFLocal,
 						mathUtils::Vec4(1.0f, 1.0f, 1.0f, 0.0f));
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &markConstants, 1 }));
-					ctx.commandList.DrawIndexed(s.mesh->indexCount, s.mesh->indexType, 0, 0, 1, startInstance);
+					ctx.commandList.DrawIndexed(s.mesh->indexCount, s.mesh->indexType, s.mesh->firstIndex, s.mesh->baseVertex, 1, startInstance);
 				}
 
 				ctx.commandList.SetState(outlineState_);
@@ -390,7 +386,7 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 						0.0f
 					};
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &outlineConstants, 1 }));
-					ctx.commandList.DrawIndexed(s.skinnedMesh->indexCount, s.skinnedMesh->indexType, 0, 0);
+					ctx.commandList.DrawIndexed(s.skinnedMesh->indexCount, s.skinnedMesh->indexType, s.skinnedMesh->firstIndex, s.skinnedMesh->baseVertex);
 				}
 				else
 				{
@@ -409,7 +405,7 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 						0.0f
 					};
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &outlineConstants, 1 }));
-					ctx.commandList.DrawIndexed(s.mesh->indexCount, s.mesh->indexType, 0, 0, 1, startInstance);
+					ctx.commandList.DrawIndexed(s.mesh->indexCount, s.mesh->indexType, s.mesh->firstIndex, s.mesh->baseVertex, 1, startInstance);
 				}
 
 				ctx.commandList.SetState(outlineMarkState_);
@@ -427,7 +423,7 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 						s.paletteOffset,
 						s.boneCount);
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &clearMarkConstants, 1 }));
-					ctx.commandList.DrawIndexed(s.skinnedMesh->indexCount, s.skinnedMesh->indexType, 0, 0);
+					ctx.commandList.DrawIndexed(s.skinnedMesh->indexCount, s.skinnedMesh->indexType, s.skinnedMesh->firstIndex, s.skinnedMesh->baseVertex);
 				}
 				else
 				{
@@ -438,7 +434,7 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 						camFLocal,
 						mathUtils::Vec4(1.0f, 1.0f, 1.0f, 0.0f));
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &clearMarkConstants, 1 }));
-					ctx.commandList.DrawIndexed(s.mesh->indexCount, s.mesh->indexType, 0, 0, 1, startInstance);
+					ctx.commandList.DrawIndexed(s.mesh->indexCount, s.mesh->indexType, s.mesh->firstIndex, s.mesh->baseVertex, 1, startInstance);
 				}
 				ctx.commandList.SetStencilRef(0u);
 			}
@@ -458,7 +454,7 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 					s.paletteOffset,
 					s.boneCount);
 				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &highlightConstants, 1 }));
-				ctx.commandList.DrawIndexed(s.skinnedMesh->indexCount, s.skinnedMesh->indexType, 0, 0);
+				ctx.commandList.DrawIndexed(s.skinnedMesh->indexCount, s.skinnedMesh->indexType, s.skinnedMesh->firstIndex, s.skinnedMesh->baseVertex);
 			}
 			else
 			{
@@ -469,10 +465,11 @@ auto DrawEditorSelectionGroup = [&](renderGraph::PassContext& ctx,
 					camFLocal,
 					highlightColor);
 				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &highlightConstants, 1 }));
-				ctx.commandList.DrawIndexed(s.mesh->indexCount, s.mesh->indexType, 0, 0, 1, startInstance);
+				ctx.commandList.DrawIndexed(s.mesh->indexCount, s.mesh->indexType, s.mesh->firstIndex, s.mesh->baseVertex, 1, startInstance);
 			}
 			ctx.commandList.SetState(restoreState);
 		}
 	};
 #include "DirectX12Renderer_RenderFrame_04_SharedMaterialEnvHelpers.inl"
-#include "DirectX12Renderer_RenderFrame_04_SharedPerBatchConstantsHelpers.inl"
\ No newline at end of file
+#include "DirectX12Renderer_RenderFrame_04_SharedPerBatchConstantsHelpers.inl"
+#include "DirectX12Renderer_RenderFrame_04_SharedTransparentHelpers.inl"
\ No newline at end of file
@@ -1,5 +1,5 @@
 {
-	const FrameCameraData frameCamera = BuildFrameCameraData(scene, scDesc.extent);
+	const FrameCameraData frameCamera = BuildFrameCameraData(scene, renderExtent);
 	const mathUtils::Mat4& proj = frameCamera.proj;
 	const mathUtils::Mat4& view = frameCamera.view;
 	const mathUtils::Mat4& viewProj = frameCamera.viewProj;
@@ -73,42 +73,66 @@
 	};
 
 	// Import swapchain depth as an external RenderGraph texture so offscreen passes can use it.
-	const auto depthRG = graph.ImportTexture(
-		swapChain.GetDepthTexture(),
-		renderGraph::RGTextureDesc{
-			.extent = scDesc.extent,
+	// At a dynamic resolution scale below 1 the scene gets its own depth; the upscale writes it back.
+	const auto depthRG = renderScaled
+		? graph.CreateTexture(renderGraph::RGTextureDesc{
+			.extent = renderExtent,
 			.format = rhi::Format::D24_UNORM_S8_UINT,
 			.usage = renderGraph::ResourceUsage::DepthStencil,
-			.debugName = "SwapChainDepth_Imported"
-		});
+			.debugName = "SceneDepth_Scaled"
+			})
+		: graph.ImportTexture(
+			swapChain.GetDepthTexture(),
+			renderGraph::RGTextureDesc{
+				.extent = scDesc.extent,
+				.format = rhi::Format::D24_UNORM_S8_UINT,
+				.usage = renderGraph::ResourceUsage::DepthStencil,
+				.debugName = "SwapChainDepth_Imported"
+			});
+
+	// Compact layout (GBufferCompact_dx12.hlsli): 3 targets / 12 bytes per pixel instead of 4 / 16. Only used
+	// when every GBUFFER_COMPACT pipeline of the frame was built.
+	const bool compactGBuffer =
+		settings_.compactGBuffer &&
+		psoDeferredGBufferCompact_ &&
+		psoDeferredGBufferSkinnedCompact_ &&
+		psoDeferredLightingCompact_ &&
+		psoSSAOCompact_;
+	const rhi::PipelineHandle gbufferPso = compactGBuffer ? psoDeferredGBufferCompact_ : psoDeferredGBuffer_;
+	const rhi::PipelineHandle gbufferSkinnedPso = compactGBuffer ? psoDeferredGBufferSkinnedCompact_ : psoDeferredGBufferSkinned_;
+	const rhi::PipelineHandle gbufferMeshletPso = compactGBuffer ? psoDeferredGBufferMeshletCompact_ : psoDeferredGBufferMeshlet_;
 
 	const auto gbuf0 = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
-		.format = rhi::Format::RGBA8_UNORM,
+		.extent = renderExtent,
+		.format = compactGBuffer ? rhi::Format::RGBA8_UNORM_SRGB : rhi::Format::RGBA8_UNORM,
 		.usage = renderGraph::ResourceUsage::RenderTarget,
-		.debugName = "GBuffer0_AlbedoRough"
+		.debugName = compactGBuffer ? "GBuffer0_AlbedoEnvSel" : "GBuffer0_AlbedoRough"
 		});
 	const auto gbuf1 = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
-		.format = rhi::Format::RGBA8_UNORM,
+		.extent = renderExtent,
+		.format = compactGBuffer ? rhi::Format::RG16_UNORM : rhi::Format::RGBA8_UNORM,
 		.usage = renderGraph::ResourceUsage::RenderTarget,
-		.debugName = "GBuffer1_NormalMetal"
+		.debugName = compactGBuffer ? "GBuffer1_OctNormal" : "GBuffer1_NormalMetal"
 		});
 	const auto gbuf2 = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
+		.extent = renderExtent,
 		.format = rhi::Format::RGBA8_UNORM,
 		.usage = renderGraph::ResourceUsage::RenderTarget,
-		.debugName = "GBuffer2_EmissiveAO"
-		});
-	const auto gbuf3 = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
-		.format = rhi::Format::RGBA8_UNORM,
-		.usage = renderGraph::ResourceUsage::RenderTarget,
-		.debugName = "GBuffer3_EnvSel"
+		.debugName = compactGBuffer ? "GBuffer2_RoughMetalAOEmissive" : "GBuffer2_EmissiveAO"
 		});
+	std::optional<renderGraph::RGTexture> gbuf3;
+	if (!compactGBuffer)
+	{
+		gbuf3 = graph.CreateTexture(renderGraph::RGTextureDesc{
+			.extent = renderExtent,
+			.format = rhi::Format::RGBA8_UNORM,
+			.usage = renderGraph::ResourceUsage::RenderTarget,
+			.debugName = "GBuffer3_EnvSel"
+			});
+	}
 	const auto sceneColorFormat = settings_.enableHDR ? rhi::Format::RGBA16_FLOAT : rhi::Format::RGBA8_UNORM;
 	const auto sceneColor = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
+		.extent = renderExtent,
 		.format = sceneColorFormat,
 		.usage = renderGraph::ResourceUsage::RenderTarget,
 		.debugName = "SceneColor_Lit"
@@ -120,7 +144,11 @@
 	{
 		renderGraph::PassAttachments att{};
 		att.useSwapChainBackbuffer = false;
-		att.colors = { gbuf0, gbuf1, gbuf2, gbuf3 };
+		att.colors = { gbuf0, gbuf1, gbuf2 };
+		if (gbuf3)
+		{
+			att.colors.push_back(*gbuf3);
+		}
 		att.depth = depthRG;
 
 		att.clearDesc.clearColor = true;
@@ -138,15 +166,15 @@
 			mainBatches,
 			skinnedOpaqueDraws,
 			instStride,
-			gbuf0,
-			gbuf1,
-			gbuf2,
-			gbuf3,
+			gbufferPso,
+			gbufferSkinnedPso,
+			gbufferMeshletPso,
 			activeReflectionProbeCount,
 			selectionOpaque,
 			selectionTransparent,
 			selectionInstances,
 			DrawEditorSelectionGroup,
+			ComputeDeferredGBufferProbeMeta,
 			ComputeDeferredGBufferReflectionMeta,
 			deferredReflectionProbeRemap](renderGraph::PassContext& ctx)
 		{
@@ -157,126 +185,92 @@
 				static_cast<int>(extent.height));
 
 			ctx.commandList.SetState(state_);
-			ctx.commandList.BindPipeline(psoDeferredGBuffer_);
+			ctx.commandList.BindPipeline(gbufferPso);
 
 			const FrameCameraData camera = BuildFrameCameraData(scene, extent);
 			const mathUtils::Mat4& viewProj = camera.viewProj;
 			const mathUtils::Vec3& camPosLocal = camera.camPos;
 			const mathUtils::Vec3& camFLocal = camera.camForward;
 
-			// Flags must match shader.
-			constexpr std::uint32_t kFlagUseTex = 1u << 0;
-			constexpr std::uint32_t kFlagUseNormal = 1u << 2;
-			constexpr std::uint32_t kFlagUseMetalTex = 1u << 3;
-			constexpr std::uint32_t kFlagUseRoughTex = 1u << 4;
-			constexpr std::uint32_t kFlagUseAOTex = 1u << 5;
-			constexpr std::uint32_t kFlagUseEmissiveTex = 1u << 6;
-
-			for (const Batch& batch : mainBatches)
+			// Meshes with meshlets (UsesMeshlets) go through the amplification/mesh shader pipeline.
+			MeshletGBufferConstants meshletConstants{};
+			if (gbufferMeshletPso)
 			{
-				if (!batch.mesh || batch.instanceCount == 0)
+				SetMeshletCullPlanes(meshletConstants.uPlanes, mathUtils::ExtractFrustumRH_ZO(viewProj));
+			}
+			rhi::PipelineHandle boundPipeline = gbufferPso;
+
+			// Materials come from the table through each instance's entry (GBufferMaterials_dx12.hlsli), so the
+			// batches of one mesh and probe - adjacent and contiguous with OpaqueMeshMajor keys - are one draw.
+			ctx.commandList.BindStructuredBufferSRV(7, materialTableBuffer_);
+			ctx.commandList.BindStructuredBufferSRV(8, instanceMaterialBuffer_);
+
+			PerBatchConstants batchConstants{};
+			const mathUtils::Mat4 viewProjT = mathUtils::Transpose(viewProj);
+			const mathUtils::Mat4 dirVP_T = mathUtils::Transpose(dirLightViewProj);
+			std::memcpy(batchConstants.uViewProj.data(), mathUtils::ValuePtr(viewProjT), sizeof(float) * 16);
+			std::memcpy(batchConstants.uLightViewProj.data(), mathUtils::ValuePtr(dirVP_T), sizeof(float) * 16);
+			batchConstants.uCameraAmbient = { camPosLocal.x, camPosLocal.y, camPosLocal.z, 0.0f };
+			batchConstants.uCameraForward = { camFLocal.x, camFLocal.y, camFLocal.z, 0.0f };
+			batchConstants.uCounts = {
+				static_cast<float>(lightCount),
+				0.0f,
+				0.0f,
+				static_cast<float>(activeReflectionProbeCount)
+			};
+
+			for (std::size_t batchIndex = 0; batchIndex < mainBatches.size();)
+			{
+				const Batch& batch = mainBatches[batchIndex];
+				std::uint32_t instanceCount = batch.instanceCount;
+				std::size_t runEnd = batchIndex + 1;
+				while (runEnd < mainBatches.size() &&
+					mainBatches[runEnd].mesh == batch.mesh &&
+					mainBatches[runEnd].reflectionProbeIndex == batch.reflectionProbeIndex &&
+					mainBatches[runEnd].instanceOffset == batch.instanceOffset + instanceCount)
 				{
-					continue;
+					instanceCount += mainBatches[runEnd].instanceCount;
+					++runEnd;
 				}
-
-				MaterialPerm perm = MaterialPerm::None;
-				if (batch.materialHandle.id != 0)
+				batchIndex = runEnd;
+				if (!batch.mesh || instanceCount == 0)
 				{
-					perm = EffectivePerm(scene.GetMaterial(batch.materialHandle));
+					continue;
 				}
-				else
+
+				const auto [envSourceForGBuffer, probeIdxNForGBuffer] = ComputeDeferredGBufferProbeMeta(
+					batch.reflectionProbeIndex,
+					deferredReflectionProbeRemap,
+					activeReflectionProbeCount);
+				batchConstants.uEnvProbeBoxMin = { 0.0f, 0.0f, 0.0f, envSourceForGBuffer };
+				batchConstants.uEnvProbeBoxMax = { 0.0f, 0.0f, 0.0f, probeIdxNForGBuffer };
+				batchConstants.uTexIndices1 = { 0.0f, 0.0f, AsFloatBits(batch.instanceOffset), 0.0f };
+
+				if (UsesMeshlets(*batch.mesh, gbufferMeshletPso))
 				{
-					if (batch.material.albedoDescIndex != 0)
+					if (boundPipeline != gbufferMeshletPso)
 					{
-						perm = perm | MaterialPerm::UseTex;
+						ctx.commandList.BindPipeline(gbufferMeshletPso);
+						boundPipeline = gbufferMeshletPso;
 					}
+					meshletConstants.batch = batchConstants;
+					DispatchMeshlets(ctx.commandList, *batch.mesh, batch.instanceOffset, instanceCount, meshletConstants);
+					continue;
 				}
-
-				std::uint32_t flags = 0u;
-				if (HasFlag(perm, MaterialPerm::UseTex) && batch.material.albedoDescIndex != 0)
-				{
-					flags |= kFlagUseTex;
-				}
-				if (batch.material.normalDescIndex != 0)
-				{
-					flags |= kFlagUseNormal;
-				}
-				if (batch.material.metalnessDescIndex != 0)
-				{
-					flags |= kFlagUseMetalTex;
-				}
-				if (batch.material.roughnessDescIndex != 0)
-				{
-					flags |= kFlagUseRoughTex;
-				}
-				if (batch.material.aoDescIndex != 0)
-				{
-					flags |= kFlagUseAOTex;
-				}
-				if (batch.material.emissiveDescIndex != 0)
+				if (boundPipeline != gbufferPso)
 				{
-					flags |= kFlagUseEmissiveTex;
+					ctx.commandList.BindPipeline(gbufferPso);
+					boundPipeline = gbufferPso;
 				}
 
-				const auto [envSourceForGBuffer, probeIdxNForGBuffer] = ComputeDeferredGBufferReflectionMeta(
-					batch.materialHandle,
-					batch.reflectionProbeIndex,
-					deferredReflectionProbeRemap,
-					activeReflectionProbeCount);
-
-				// Material textures via descriptors (same slots as forward).
-				ctx.commandList.BindTextureDesc(0, batch.material.albedoDescIndex);
-				ctx.commandList.BindTextureDesc(12, batch.material.normalDescIndex);
-				ctx.commandList.BindTextureDesc(13, batch.material.metalnessDescIndex);
-				ctx.commandList.BindTextureDesc(14, batch.material.roughnessDescIndex);
-				ctx.commandList.BindTextureDesc(15, batch.material.aoDescIndex);
-				ctx.commandList.BindTextureDesc(16, batch.material.emissiveDescIndex);
-
-				PerBatchConstants constants{};
-				const mathUtils::Mat4 viewProjT = mathUtils::Transpose(viewProj);
-				const mathUtils::Mat4 dirVP_T = mathUtils::Transpose(dirLightViewProj);
-				std::memcpy(constants.uViewProj.data(), mathUtils::ValuePtr(viewProjT), sizeof(float) * 16);
-				std::memcpy(constants.uLightViewProj.data(), mathUtils::ValuePtr(dirVP_T), sizeof(float) * 16);
-
-				constants.uCameraAmbient = { camPosLocal.x, camPosLocal.y, camPosLocal.z, 0.0f };
-				constants.uCameraForward = { camFLocal.x, camFLocal.y, camFLocal.z, 0.0f };
-				constants.uBaseColor = { batch.material.baseColor.x, batch.material.baseColor.y, batch.material.baseColor.z, batch.material.baseColor.w };
-
-				constants.uMaterialFlags = { 0.0f, 0.0f, 0.0f, AsFloatBits(flags) };
-				constants.uPbrParams = { batch.material.metallic, batch.material.roughness, batch.material.ao, batch.material.emissiveStrength };
-				constants.uCounts = {
-					static_cast<float>(lightCount),
-					0.0f,
-					0.0f,
-					static_cast<float>(activeReflectionProbeCount)
-				};
-				constants.uShadowBias = { 0.0f, 0.0f, 0.0f, 0.0f };
-				constants.uEnvProbeBoxMin = { 0.0f, 0.0f, 0.0f, envSourceForGBuffer };
-				constants.uEnvProbeBoxMax = { 0.0f, 0.0f, 0.0f, probeIdxNForGBuffer };
-
-
-				// Bindless indices for DeferredGBuffer_dx12.hlsl (space1 SRV heap).
-				constants.uTexIndices0 = {
-					static_cast<float>(batch.material.albedoDescIndex),
-					static_cast<float>(batch.material.normalDescIndex),
-					static_cast<float>(batch.material.metalnessDescIndex),
-					static_cast<float>(batch.material.roughnessDescIndex)
-				};
-				constants.uTexIndices1 = {
-					static_cast<float>(batch.material.aoDescIndex),
-					static_cast<float>(batch.material.emissiveDescIndex),
-					0.0f,
-					0.0f
-				};
-
 				// IA (instanced)
 				ctx.commandList.BindInputLayout(batch.mesh->layoutInstanced);
-				ctx.commandList.BindVertexBuffer(0, batch.mesh->vertexBuffer, batch.mesh->vertexStrideBytes, 0);
+				ctx.commandList.BindVertexBuffer(0, batch.mesh->vertexBuffer, batch.mesh->vertexStrideBytes, batch.mesh->vertexOffsetBytes);
 				ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, batch.instanceOffset * instStride);
-				ctx.commandList.BindIndexBuffer(batch.mesh->indexBuffer, batch.mesh->indexType, 0);
+				ctx.commandList.BindIndexBuffer(batch.mesh->indexBuffer, batch.mesh->indexType, batch.mesh->indexOffsetBytes);
 
-				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-				ctx.commandList.DrawIndexed(batch.mesh->indexCount, batch.mesh->indexType, 0, 0, batch.instanceCount, 0);
+				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &batchConstants, 1 }));
+				ctx.commandList.DrawIndexed(batch.mesh->indexCount, batch.mesh->indexType, batch.mesh->firstIndex, batch.mesh->baseVertex, instanceCount, 0);
 			}
 
 			for (const SkinnedOpaqueDraw& draw : skinnedOpaqueDraws)
@@ -299,27 +293,27 @@
 				std::uint32_t flags = 0u;
 				if (HasFlag(perm, MaterialPerm::UseTex) && draw.material.albedoDescIndex != 0)
 				{
-					flags |= kFlagUseTex;
+					flags |= kGBufferFlagUseTex;
 				}
 				if (draw.material.normalDescIndex != 0)
 				{
-					flags |= kFlagUseNormal;
+					flags |= kGBufferFlagUseNormal;
 				}
 				if (draw.material.metalnessDescIndex != 0)
 				{
-					flags |= kFlagUseMetalTex;
+					flags |= kGBufferFlagUseMetalTex;
 				}
 				if (draw.material.roughnessDescIndex != 0)
 				{
-					flags |= kFlagUseRoughTex;
+					flags |= kGBufferFlagUseRoughTex;
 				}
 				if (draw.material.aoDescIndex != 0)
 				{
-					flags |= kFlagUseAOTex;
+					flags |= kGBufferFlagUseAOTex;
 				}
 				if (draw.material.emissiveDescIndex != 0)
 				{
-					flags |= kFlagUseEmissiveTex;
+					flags |= kGBufferFlagUseEmissiveTex;
 				}
 
 				const auto [envSourceForGBuffer, probeIdxNForGBuffer] = ComputeDeferredGBufferReflectionMeta(
@@ -328,7 +322,7 @@
 					deferredReflectionProbeRemap,
 					activeReflectionProbeCount);
 
-				ctx.commandList.BindPipeline(psoDeferredGBufferSkinned_);
+				ctx.commandList.BindPipeline(gbufferSkinnedPso);
 				ctx.commandList.BindTextureDesc(0, draw.material.albedoDescIndex);
 				ctx.commandList.BindTextureDesc(12, draw.material.normalDescIndex);
 				ctx.commandList.BindTextureDesc(13, draw.material.metalnessDescIndex);
@@ -338,8 +332,6 @@
 				ctx.commandList.BindStructuredBufferSRV(19, skinPaletteBuffer_);
 
 				SkinnedPerDrawConstants constants{};
-				const mathUtils::Mat4 viewProjT = mathUtils::Transpose(viewProj);
-				const mathUtils::Mat4 dirVP_T = mathUtils::Transpose(dirLightViewProj);
 				std::memcpy(constants.uViewProj.data(), mathUtils::ValuePtr(viewProjT), sizeof(float) * 16);
 				std::memcpy(constants.uLightViewProj.data(), mathUtils::ValuePtr(dirVP_T), sizeof(float) * 16);
 				constants.uCameraAmbient = { camPosLocal.x, camPosLocal.y, camPosLocal.z, 0.0f };
@@ -370,31 +362,24 @@
 				};
 				const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
 				std::memcpy(constants.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
-				constants.uSkinning = {
-					static_cast<float>(draw.paletteOffset),
-					static_cast<float>(draw.boneCount),
-					0.0f,
-					0.0f
-				};
+				constants.uSkinning = SkinningConstantsFor(draw);
 
-				ctx.commandList.BindInputLayout(draw.mesh->layout);
-				ctx.commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, 0);
-				ctx.commandList.BindIndexBuffer(draw.mesh->indexBuffer, draw.mesh->indexType, 0);
+				BindSkinnedDrawVertices(ctx.commandList, draw);
 				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-				ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, 0, 0);
+				ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, draw.mesh->firstIndex, draw.mesh->baseVertex);
 			}
 		});
 	}
 
 	// --- SSAO (v1): fullscreen AO from depth+normal, then depth-aware blur ---
 	const auto ssaoRaw = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
+		.extent = renderExtent,
 		.format = rhi::Format::R32_FLOAT,
 		.usage = renderGraph::ResourceUsage::RenderTarget,
 		.debugName = "SSAO_Raw"
 		});
 	const auto ssaoBlur = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
+		.extent = renderExtent,
 		.format = rhi::Format::R32_FLOAT,
 		.usage = renderGraph::ResourceUsage::RenderTarget,
 		.debugName = "SSAO_Blur"
@@ -410,9 +395,10 @@
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
 		att.clearDesc.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		att.textures = { renderGraph::Read(gbuf1), renderGraph::Read(depthRG) };
 
 		graph.AddPass("SSAO", std::move(att),
-			[this, &scene, depthRG, gbuf1, ssaoRaw](renderGraph::PassContext& ctx)
+			[this, &scene, depthRG, gbuf1, ssaoRaw, compactGBuffer](renderGraph::PassContext& ctx)
 			{
 				const auto extent = ctx.passExtent;
 				ctx.commandList.SetViewport(0, 0,
@@ -437,7 +423,7 @@
 				};
 
 				ctx.commandList.SetState(deferredLightingState_);
-				ctx.commandList.BindPipeline(psoSSAO_);
+				ctx.commandList.BindPipeline(compactGBuffer ? psoSSAOCompact_ : psoSSAO_);
 				ctx.commandList.BindInputLayout(fullscreenLayout_);
 				ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
 
@@ -458,6 +444,7 @@
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
 		att.clearDesc.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		att.textures = { renderGraph::Read(ssaoRaw), renderGraph::Read(depthRG) };
 
 		graph.AddPass("SSAOBlur", std::move(att),
 			[this, depthRG, ssaoRaw, ssaoBlur](renderGraph::PassContext& ctx)
@@ -499,9 +486,17 @@
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
 		att.clearDesc.color = { 0.0f, 0.0f, 0.0f, 1.0f };
+		att.textures = {
+			renderGraph::Read(gbuf0), renderGraph::Read(gbuf1), renderGraph::Read(gbuf2),
+			renderGraph::Read(depthRG), renderGraph::Read(ssaoBlur) };
+		if (gbuf3)
+		{
+			att.textures.push_back(renderGraph::Read(*gbuf3));
+		}
+		ReadShadowMaps(att.textures);
 
 		graph.AddPass("DeferredLighting", std::move(att),
-			[this, &scene, gbuf0, gbuf1, gbuf2, gbuf3, depthRG, shadowRG, spotShadows, pointShadows, deferredConstants, ssaoBlur, activeReflectionProbeCount](renderGraph::PassContext& ctx)
+			[this, &scene, gbuf0, gbuf1, gbuf2, gbuf3, depthRG, shadowRG, spotShadows, spotShadowAtlasRG, pointShadows, deferredConstants, ssaoBlur, activeReflectionProbeCount, compactGBuffer](renderGraph::PassContext& ctx)
 			{
 				const auto extent = ctx.passExtent;
 
@@ -510,7 +505,7 @@
 					static_cast<int>(extent.height));
 
 				ctx.commandList.SetState(deferredLightingState_);
-				ctx.commandList.BindPipeline(psoDeferredLighting_);
+				ctx.commandList.BindPipeline(compactGBuffer ? psoDeferredLightingCompact_ : psoDeferredLighting_);
 				ctx.commandList.BindInputLayout(fullscreenLayout_);
 				ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
 
@@ -519,15 +514,17 @@
 				ctx.commandList.BindTexture2D(1, ctx.resources.GetTexture(gbuf1)); // t1
 				ctx.commandList.BindTexture2D(2, ctx.resources.GetTexture(gbuf2)); // t2
 				ctx.commandList.BindTexture2D(3, ctx.resources.GetTexture(depthRG)); // t3
-				ctx.commandList.BindTexture2D(4, ctx.resources.GetTexture(gbuf3)); // t4 env selector
+				if (gbuf3)
+				{
+					ctx.commandList.BindTexture2D(4, ctx.resources.GetTexture(*gbuf3)); // t4 env selector (compact: gbuf0.a)
+				}
 				ctx.commandList.BindTexture2D(5, ctx.resources.GetTexture(shadowRG)); // t5 dir CSM
 				ctx.commandList.BindStructuredBufferSRV(6, shadowDataBuffer_); // t6 shadow metadata
 
-				// Spot shadow maps (t7..t10)
-				for (std::size_t spotShadowIndex = 0; spotShadowIndex < spotShadows.size(); ++spotShadowIndex)
+				// Spot shadow atlas (t7)
+				if (!spotShadows.empty())
 				{
-					const auto tex = ctx.resources.GetTexture(spotShadows[spotShadowIndex].tex);
-					ctx.commandList.BindTexture2D(7 + static_cast<std::uint32_t>(spotShadowIndex), tex);
+					ctx.commandList.BindTexture2D(7, ctx.resources.GetTexture(spotShadowAtlasRG));
 				}
 				// Point shadow cubemaps (t11..t14)
 				for (std::size_t pointShadowIndex = 0; pointShadowIndex < pointShadows.size(); ++pointShadowIndex)
@@ -539,8 +536,9 @@
 				// Env cubemaps for IBL (t15 skybox, t17 reflection capture)
 				ctx.commandList.BindTextureDesc(15, scene.skyboxDescIndex);
 
-				// Lights (t16) and SSAO (t18); t19 = full reflection cube-array
+				// Lights (t16), their cluster lists (t20) and SSAO (t18); t19 = full reflection cube-array
 				ctx.commandList.BindStructuredBufferSRV(16, lightsBuffer_);
+				ctx.commandList.BindStructuredBufferSRV(20, lightClustersBuffer_);
 				ctx.commandList.BindTexture2D(18, ctx.resources.GetTexture(ssaoBlur));
 
 				if (activeReflectionProbeCount > 0u)
@@ -35,11 +35,11 @@
 				ctx.commandList.BindTextureDesc(0, scene.skyboxDescIndex);
 
 				ctx.commandList.BindInputLayout(skyboxMesh_.layout);
-				ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, 0);
-				ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, 0);
+				ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, skyboxMesh_.vertexOffsetBytes);
+				ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, skyboxMesh_.indexOffsetBytes);
 
 				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &skyboxConstants, 1 }));
-				ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, 0, 0);
+				ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, skyboxMesh_.firstIndex, skyboxMesh_.baseVertex);
 			}
 		});
 	}
@@ -51,7 +51,7 @@
 if (settings_.enableFog && psoFog_)
 {
 	const auto sceneColorFog = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
+		.extent = renderExtent,
 		.format = sceneColorFormat,
 		.usage = renderGraph::ResourceUsage::RenderTarget,
 		.debugName = "SceneColor_Fog"
@@ -78,6 +78,7 @@ if (settings_.enableFog && psoFog_)
 	att.clearDesc.clearStencil = false;
 
 	const auto sceneColorIn = sceneColorAfterFog;
+	att.textures = { renderGraph::Read(sceneColorIn), renderGraph::Read(depthRG) };
 	graph.AddPass("DeferredFog", std::move(att),
 		[this, depthRG, sceneColorIn, sceneColorFog, c](renderGraph::PassContext& ctx)
 		{
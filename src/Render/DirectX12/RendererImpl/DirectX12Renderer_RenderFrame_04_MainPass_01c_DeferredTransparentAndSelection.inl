@@ -44,7 +44,11 @@ if (!selectionOpaque.empty())
 		});
 }
 // --- Transparent forward pass over deferred SceneColor ---
-if (!transparentDraws.empty())
+if (weightedOit && !transparentDraws.empty())
+{
+	AddWeightedOitPasses(sceneColorAfterFog, depthRG, renderExtent, activeReflectionProbeCount);
+}
+else if (!transparentDraws.empty())
 {
 	renderGraph::PassAttachments att{};
 	att.useSwapChainBackbuffer = false;
@@ -54,23 +58,12 @@ if (!transparentDraws.empty())
 	att.clearDesc.clearColor = false;
 	att.clearDesc.clearDepth = false;
 	att.clearDesc.clearStencil = false;
+	ReadShadowMaps(att.textures);
 
 	graph.AddPass("DeferredTransparent", std::move(att),
 		[this, &scene,
-		shadowRG,
-		dirLightViewProj,
-		lightCount,
-		spotShadows,
-		pointShadows,
-		transparentDraws,
 		activeReflectionProbeCount,
-		BindMainPassMaterialTextures,
-		ResolveTransparentEnvBinding,
-		ResolveMainPassMaterialPerm,
-		BuildMainPassMaterialFlags,
-		FillPerBatchViewLightingConstants,
-		ResetPerBatchEnvProbeBox,
-		instStride](renderGraph::PassContext& ctx)
+		RecordTransparentDraws](renderGraph::PassContext& ctx)
 	{
 		const auto extent = ctx.passExtent;
 
@@ -78,107 +71,11 @@ if (!transparentDraws.empty())
 			static_cast<int>(extent.width),
 			static_cast<int>(extent.height));
 
-		ctx.commandList.SetState(transparentState_);
-
-		const float aspect = extent.height
-			? (static_cast<float>(extent.width) / static_cast<float>(extent.height))
-			: 1.0f;
-
-		const mathUtils::Mat4 proj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(scene.camera.fovYDeg), aspect, scene.camera.nearZ, scene.camera.farZ);
-		const mathUtils::Mat4 view = mathUtils::LookAt(scene.camera.position, scene.camera.target, scene.camera.up);
-		const mathUtils::Mat4 viewProj = proj * view;
-
-		const mathUtils::Vec3 camPosLocal = scene.camera.position;
-		const mathUtils::Vec3 camFLocal = mathUtils::Normalize(scene.camera.target - scene.camera.position);
-
-		// Bind dir shadow map at t1.
-		{
-			const auto shadowTex = ctx.resources.GetTexture(shadowRG);
-			if (shadowTex)
-			{
-				ctx.commandList.BindTexture2D(1, shadowTex);
-			}
-		}
-
-		// Bind Spot shadow maps at t3..t6 and Point shadow cubemaps at t7..t10.
-		for (std::size_t spotShadowIndex = 0; spotShadowIndex < spotShadows.size(); ++spotShadowIndex)
-		{
-			const auto tex = ctx.resources.GetTexture(spotShadows[spotShadowIndex].tex);
-			ctx.commandList.BindTexture2D(3 + static_cast<std::uint32_t>(spotShadowIndex), tex);
-		}
-		for (std::size_t pointShadowIndex = 0; pointShadowIndex < pointShadows.size(); ++pointShadowIndex)
-		{
-			const auto tex = ctx.resources.GetTexture(pointShadows[pointShadowIndex].cube);
-			ctx.commandList.BindTexture2DArray(7 + static_cast<std::uint32_t>(pointShadowIndex), tex);
-		}
-
-		// Bind shadow metadata SB at t11
-		ctx.commandList.BindStructuredBufferSRV(11, shadowDataBuffer_);
-
-		// Bind lights (t2 StructuredBuffer SRV)
-		ctx.commandList.BindStructuredBufferSRV(2, lightsBuffer_);
-
-		for (const TransparentDraw& batchTransparent : transparentDraws)
-		{
-			if (!batchTransparent.mesh)
-			{
-				continue;
-			}
-
-			const MaterialPerm perm = ResolveMainPassMaterialPerm(
-				batchTransparent.material,
-				batchTransparent.materialHandle);
-			const bool useTex = HasFlag(perm, MaterialPerm::UseTex);
-			const bool useShadow = HasFlag(perm, MaterialPerm::UseShadow);
-			const ResolvedMaterialEnvBinding env = ResolveTransparentEnvBinding(batchTransparent.materialHandle);
-
-			ctx.commandList.BindPipeline(MainPipelineFor(perm));
-			BindMainPassMaterialTextures(ctx.commandList, batchTransparent.material, env);
-
-			const std::uint32_t flags = BuildMainPassMaterialFlags(
-				batchTransparent.material,
-				useTex,
-				useShadow,
-				env);
-
-			PerBatchConstants constants{};
-			FillPerBatchViewLightingConstants(constants, viewProj, dirLightViewProj, camPosLocal, camFLocal);
-			constants.uBaseColor = { batchTransparent.material.baseColor.x, batchTransparent.material.baseColor.y, batchTransparent.material.baseColor.z, batchTransparent.material.baseColor.w };
-
-			const float materialBiasTexels = batchTransparent.material.shadowBias;
-			constants.uMaterialFlags = { 0.0f, 0.0f, materialBiasTexels, AsFloatBits(flags) };
-
-			constants.uPbrParams = { batchTransparent.material.metallic, batchTransparent.material.roughness, batchTransparent.material.ao, batchTransparent.material.emissiveStrength };
-
-			constants.uCounts = {
-				static_cast<float>(lightCount),
-				static_cast<float>(spotShadows.size()),
-				static_cast<float>(pointShadows.size()),
-				static_cast<float>(activeReflectionProbeCount)
-			};
-
-			constants.uShadowBias = {
-				settings_.dirShadowBaseBiasTexels,
-				settings_.spotShadowBaseBiasTexels,
-				settings_.pointShadowBaseBiasTexels,
-				settings_.shadowSlopeScaleTexels
-			};
-			ResetPerBatchEnvProbeBox(constants);
-
-			ctx.commandList.BindInputLayout(batchTransparent.mesh->layoutInstanced);
-			ctx.commandList.BindVertexBuffer(0, batchTransparent.mesh->vertexBuffer, batchTransparent.mesh->vertexStrideBytes, 0);
-			ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, batchTransparent.instanceOffset * instStride);
-			ctx.commandList.BindIndexBuffer(batchTransparent.mesh->indexBuffer, batchTransparent.mesh->indexType, 0);
-
-			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-
-			// IMPORTANT: transparent = one object per draw (instanceCount = 1)
-			ctx.commandList.DrawIndexed(batchTransparent.mesh->indexCount, batchTransparent.mesh->indexType, 0, 0, 1, 0);
-		}
+		RecordTransparentDraws(ctx, BuildFrameCameraData(scene, extent), activeReflectionProbeCount);
 	});
 }
 // --- Additive particles over deferred SceneColor ---
-if (particleCount > 0u)
+if (particleCount > 0u || drawGpuParticles)
 {
 	renderGraph::PassAttachments att{};
 	att.useSwapChainBackbuffer = false;
@@ -187,9 +84,17 @@ if (particleCount > 0u)
 	att.clearDesc.clearColor = false;
 	att.clearDesc.clearDepth = false;
 	att.clearDesc.clearStencil = false;
+	if (drawGpuParticles)
+	{
+		att.buffers = {
+			renderGraph::Read(gpuParticleBuffer_),
+			renderGraph::Read(gpuParticleSortBuffer_),
+			renderGraph::Read(gpuParticleCountersBuffer_),
+			renderGraph::Read(gpuParticleEmitterBuffer_) };
+	}
 
 	graph.AddPass("DeferredParticles", std::move(att),
-		[this, &scene, particleCount](renderGraph::PassContext& ctx)
+		[this, &scene, particleCount, drawGpuParticles](renderGraph::PassContext& ctx)
 		{
 			const auto extent = ctx.passExtent;
 			ctx.commandList.SetViewport(0, 0,
@@ -197,7 +102,14 @@ if (particleCount > 0u)
 				static_cast<int>(extent.height));
 
 			const FrameCameraData camera = BuildFrameCameraData(scene, extent);
-			DrawParticleBillboards(ctx.commandList, scene, camera, particleCount);
+			if (particleCount > 0u)
+			{
+				DrawParticleBillboards(ctx.commandList, scene, camera, particleCount);
+			}
+			if (drawGpuParticles)
+			{
+				DrawGpuParticles(ctx.commandList, scene, camera);
+			}
 		});
 }
 // --- Editor selection (transparent) over deferred SceneColor ---
@@ -252,8 +164,8 @@ if (settings_.enableHDR && settings_.enableBloom &&
 	psoBloomExtract_ && psoBloomBlur_ && psoBloomComposite_)
 {
 	rhi::Extent2D bloomExtent{
-		std::max(1u, scDesc.extent.width / 2u),
-		std::max(1u, scDesc.extent.height / 2u)
+		std::max(1u, renderExtent.width / 2u),
+		std::max(1u, renderExtent.height / 2u)
 	};
 
 	const auto bloomExtract = graph.CreateTexture(renderGraph::RGTextureDesc{
@@ -278,7 +190,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		});
 
 	const auto sceneColorBloom = graph.CreateTexture(renderGraph::RGTextureDesc{
-		.extent = scDesc.extent,
+		.extent = renderExtent,
 		.format = sceneColorFormat,
 		.usage = renderGraph::ResourceUsage::RenderTarget,
 		.debugName = "DeferredSceneColor_Bloom"
@@ -287,8 +199,8 @@ if (settings_.enableHDR && settings_.enableBloom &&
 	{
 		BloomExtractConstants c{};
 		c.uInvSourceSize = {
-			scDesc.extent.width ? (1.0f / static_cast<float>(scDesc.extent.width)) : 0.0f,
-			scDesc.extent.height ? (1.0f / static_cast<float>(scDesc.extent.height)) : 0.0f,
+			renderExtent.width ? (1.0f / static_cast<float>(renderExtent.width)) : 0.0f,
+			renderExtent.height ? (1.0f / static_cast<float>(renderExtent.height)) : 0.0f,
 			0.0f, 0.0f
 		};
 		c.uParams = {
@@ -304,6 +216,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.textures = { renderGraph::Read(finalSceneColor) };
 
 		graph.AddPass("DeferredBloomExtract", std::move(att),
 			[this, finalSceneColor, c](renderGraph::PassContext& ctx)
@@ -335,6 +248,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.textures = { renderGraph::Read(bloomExtract) };
 
 		graph.AddPass("DeferredBloomBlurX", std::move(att),
 			[this, bloomExtract, c](renderGraph::PassContext& ctx)
@@ -366,6 +280,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.textures = { renderGraph::Read(bloomBlurX) };
 
 		graph.AddPass("DeferredBloomBlurY", std::move(att),
 			[this, bloomBlurX, c](renderGraph::PassContext& ctx)
@@ -392,6 +307,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.textures = { renderGraph::Read(finalSceneColor), renderGraph::Read(bloomBlurY) };
 
 		graph.AddPass("DeferredBloomComposite", std::move(att),
 			[this, finalSceneColor, bloomBlurY, c](renderGraph::PassContext& ctx)
@@ -413,6 +329,8 @@ if (settings_.enableHDR && settings_.enableBloom &&
 }
 
 // --- Present: tonemap/copy SceneColor to swapchain ---
+// Scaled (dynamic resolution): tonemap and FXAA stay at the render size, then PSO_Upscale resamples the LDR
+// image to the swapchain and writes the scene depth back for the debug passes.
 {
 	rhi::ClearDesc clear{};
 	clear.clearColor = false;
@@ -421,62 +339,119 @@ if (settings_.enableHDR && settings_.enableBloom &&
 
 	const bool fxaaEnabled = settings_.antiAliasingMode == 1u && psoFXAA_ && fullscreenLayout_;
 
+	auto DrawToneMapped = [this](renderGraph::PassContext& ctx, renderGraph::RGTexture source)
+		{
+			const auto extent = ctx.passExtent;
 
-	if (fxaaEnabled)
-	{
-		const auto presentLdr = graph.CreateTexture(renderGraph::RGTextureDesc{
-			.extent = scDesc.extent,
-			.format = rhi::Format::RGBA8_UNORM,
-			.usage = renderGraph::ResourceUsage::RenderTarget,
-			.debugName = "DeferredPresentLdr"
-			});
+			ctx.commandList.SetViewport(0, 0,
+				static_cast<int>(extent.width),
+				static_cast<int>(extent.height));
 
-		renderGraph::PassAttachments att{};
-		att.useSwapChainBackbuffer = false;
-		att.colors = { presentLdr };
-		att.clearDesc.clearColor = false;
-		att.clearDesc.clearDepth = false;
-		att.clearDesc.clearStencil = false;
+			ctx.commandList.SetState(copyToSwapChainState_);
+			ctx.commandList.BindInputLayout(fullscreenLayout_);
+			ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
 
+			if (psoToneMap_)
+			{
+				ToneMapConstants c{};
+				c.uParams = {
+					settings_.hdrExposure,
+					static_cast<float>(settings_.toneMapMode),
+					2.2f,
+					settings_.enableHDR ? 1.0f : 0.0f
+				};
 
-		graph.AddPass("DeferredPresentLdr", std::move(att),
-			[this, finalSceneColor](renderGraph::PassContext& ctx)
+				ctx.commandList.BindPipeline(psoToneMap_);
+				ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(source));
+				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
+				ctx.commandList.Draw(3, 0);
+			}
+			else
 			{
-				const auto extent = ctx.passExtent;
+				ctx.commandList.BindPipeline(psoCopyToSwapChain_);
+				ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(source));
+				ctx.commandList.Draw(3, 0);
+			}
+		};
 
-				ctx.commandList.SetViewport(0, 0,
-					static_cast<int>(extent.width),
-					static_cast<int>(extent.height));
+	// Source and target have the same size.
+	auto DrawFXAA = [this](renderGraph::PassContext& ctx, renderGraph::RGTexture source)
+		{
+			const auto extent = ctx.passExtent;
 
-				ctx.commandList.SetState(copyToSwapChainState_);
-				ctx.commandList.BindInputLayout(fullscreenLayout_);
-				ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
+			ctx.commandList.SetViewport(0, 0,
+				static_cast<int>(extent.width),
+				static_cast<int>(extent.height));
 
-				if (psoToneMap_)
-				{
-					ToneMapConstants c{};
-					c.uParams = {
-						settings_.hdrExposure,
-						static_cast<float>(settings_.toneMapMode),
-						2.2f,
-						settings_.enableHDR ? 1.0f : 0.0f
-					};
-
-					ctx.commandList.BindPipeline(psoToneMap_);
-					ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(finalSceneColor));
-					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
-					ctx.commandList.Draw(3, 0);
-				}
-				else
+			ctx.commandList.SetState(copyToSwapChainState_);
+			ctx.commandList.BindInputLayout(fullscreenLayout_);
+			ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
+
+			FXAAConstants c{};
+			c.uInvSourceSize = {
+				extent.width ? (1.0f / static_cast<float>(extent.width)) : 0.0f,
+				extent.height ? (1.0f / static_cast<float>(extent.height)) : 0.0f,
+				static_cast<float>(extent.width),
+				static_cast<float>(extent.height)
+			};
+
+			c.uParams = {
+				settings_.fxaaSubpix,
+				settings_.fxaaEdgeThreshold,
+				settings_.fxaaEdgeThresholdMin,
+				0.0f
+			};
+
+			ctx.commandList.BindPipeline(psoFXAA_);
+			ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(source));
+			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
+			ctx.commandList.Draw(3, 0);
+		};
+
+	auto AddLdrPass = [&](std::string_view name, std::string debugName, renderGraph::RGTexture source, auto draw)
+		{
+			const auto target = graph.CreateTexture(renderGraph::RGTextureDesc{
+				.extent = renderExtent,
+				.format = rhi::Format::RGBA8_UNORM,
+				.usage = renderGraph::ResourceUsage::RenderTarget,
+				.debugName = std::move(debugName)
+				});
+
+			renderGraph::PassAttachments att{};
+			att.useSwapChainBackbuffer = false;
+			att.colors = { target };
+			att.clearDesc.clearColor = false;
+			att.clearDesc.clearDepth = false;
+			att.clearDesc.clearStencil = false;
+			att.textures = { renderGraph::Read(source) };
+
+			graph.AddPass(name, std::move(att),
+				[draw, source](renderGraph::PassContext& ctx)
 				{
-					ctx.commandList.BindPipeline(psoCopyToSwapChain_);
-					ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(finalSceneColor));
-					ctx.commandList.Draw(3, 0);
-				}
-			});
+					draw(ctx, source);
+				});
+			return target;
+		};
 
-		graph.AddSwapChainPass("DeferredPresentFXAA", clear,
-			[this, presentLdr](renderGraph::PassContext& ctx)
+	if (renderScaled)
+	{
+		auto presentLdr = AddLdrPass("DeferredPresentLdr", "DeferredPresentLdr", finalSceneColor, DrawToneMapped);
+		if (fxaaEnabled)
+		{
+			presentLdr = AddLdrPass("DeferredPresentFXAA", "DeferredPresentLdr_FXAA", presentLdr, DrawFXAA);
+		}
+
+		UpscaleConstants c{};
+		c.uSourceSize = {
+			static_cast<float>(renderExtent.width),
+			static_cast<float>(renderExtent.height),
+			1.0f / static_cast<float>(renderExtent.width),
+			1.0f / static_cast<float>(renderExtent.height)
+		};
+		c.uParams = { settings_.dynamicResolutionSharpness, 0.0f, 0.0f, 0.0f };
+
+		graph.AddSwapChainPass("DeferredPresentUpscale", clear,
+			[this, presentLdr, depthRG, c](renderGraph::PassContext& ctx)
 			{
 				const auto extent = ctx.passExtent;
 
@@ -484,68 +459,35 @@ if (settings_.enableHDR && settings_.enableBloom &&
 					static_cast<int>(extent.width),
 					static_cast<int>(extent.height));
 
-				ctx.commandList.SetState(copyToSwapChainState_);
+				ctx.commandList.SetState(upscaleState_);
+				ctx.commandList.BindPipeline(psoUpscale_);
 				ctx.commandList.BindInputLayout(fullscreenLayout_);
 				ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
 
-				FXAAConstants c{};
-				c.uInvSourceSize = {
-					extent.width ? (1.0f / static_cast<float>(extent.width)) : 0.0f,
-					extent.height ? (1.0f / static_cast<float>(extent.height)) : 0.0f,
-					static_cast<float>(extent.width),
-					static_cast<float>(extent.height)
-				};
-
-				c.uParams = {
-					settings_.fxaaSubpix,
-					settings_.fxaaEdgeThreshold,
-					settings_.fxaaEdgeThresholdMin,
-					0.0f
-				};
-
-				ctx.commandList.BindPipeline(psoFXAA_);
+				// t0 = scaled LDR image, t1 = scaled scene depth
 				ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(presentLdr));
+				ctx.commandList.BindTexture2D(1, ctx.resources.GetTexture(depthRG));
 				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
 				ctx.commandList.Draw(3, 0);
-			});
+			}, true, { renderGraph::Read(presentLdr), renderGraph::Read(depthRG) });
+	}
+	else if (fxaaEnabled)
+	{
+		const auto presentLdr = AddLdrPass("DeferredPresentLdr", "DeferredPresentLdr", finalSceneColor, DrawToneMapped);
+
+		graph.AddSwapChainPass("DeferredPresentFXAA", clear,
+			[presentLdr, DrawFXAA](renderGraph::PassContext& ctx)
+			{
+				DrawFXAA(ctx, presentLdr);
+			}, true, { renderGraph::Read(presentLdr) });
 	}
 	else
 	{
 		graph.AddSwapChainPass("DeferredPresent", clear,
-			[this, finalSceneColor](renderGraph::PassContext& ctx)
+			[finalSceneColor, DrawToneMapped](renderGraph::PassContext& ctx)
 			{
-				const auto extent = ctx.passExtent;
-
-				ctx.commandList.SetViewport(0, 0,
-					static_cast<int>(extent.width),
-					static_cast<int>(extent.height));
-
-				ctx.commandList.SetState(copyToSwapChainState_);
-				ctx.commandList.BindInputLayout(fullscreenLayout_);
-				ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
-
-				if (psoToneMap_)
-				{
-					ToneMapConstants c{};
-					c.uParams = {
-						settings_.hdrExposure,
-						static_cast<float>(settings_.toneMapMode),
-						2.2f,
-						settings_.enableHDR ? 1.0f : 0.0f
-					};
-
-					ctx.commandList.BindPipeline(psoToneMap_);
-					ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(finalSceneColor));
-					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
-					ctx.commandList.Draw(3, 0);
-				}
-				else
-				{
-					ctx.commandList.BindPipeline(psoCopyToSwapChain_);
-					ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(finalSceneColor));
-					ctx.commandList.Draw(3, 0);
-				}
-			});
+				DrawToneMapped(ctx, finalSceneColor);
+			}, true, { renderGraph::Read(finalSceneColor) });
 	}
 	// --- ImGui overlay (optional) ---
 	if (imguiDrawData)
@@ -50,6 +50,7 @@ if (canForwardSSAO)
 	renderGraph::PassAttachments att{};
 	att.useSwapChainBackbuffer = false;
 	att.colors = { ssaoRaw };
+	att.textures = { renderGraph::Read(depthRG) };
 	att.clearDesc.clearColor = true;
 	att.clearDesc.color = { 1.0f, 1.0f, 1.0f, 1.0f };
 
@@ -88,6 +89,7 @@ if (canForwardSSAO)
 	renderGraph::PassAttachments blurAtt{};
 	blurAtt.useSwapChainBackbuffer = false;
 	blurAtt.colors = { forwardSSAOBlur };
+	blurAtt.textures = { renderGraph::Read(ssaoRaw), renderGraph::Read(depthRG) };
 	blurAtt.clearDesc.clearColor = true;
 	blurAtt.clearDesc.color = { 1.0f, 1.0f, 1.0f, 1.0f };
 
@@ -129,6 +131,18 @@ mainAtt.useSwapChainBackbuffer = false;
 mainAtt.colors = { forwardSceneColor };
 mainAtt.depth = depthRG;
 mainAtt.clearDesc = clearDesc;
+ReadShadowMaps(mainAtt.textures);
+if (gpuCullBatchCount > 0)
+{
+	mainAtt.buffers = { renderGraph::Read(gpuCulledInstanceBuffer_), renderGraph::Read(gpuCullArgsBuffer_) };
+}
+if (drawGpuParticles)
+{
+	mainAtt.buffers.push_back(renderGraph::Read(gpuParticleBuffer_));
+	mainAtt.buffers.push_back(renderGraph::Read(gpuParticleSortBuffer_));
+	mainAtt.buffers.push_back(renderGraph::Read(gpuParticleCountersBuffer_));
+	mainAtt.buffers.push_back(renderGraph::Read(gpuParticleEmitterBuffer_));
+}
 
 graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	this,
@@ -137,8 +151,11 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	dirLightViewProj,
 	lightCount,
 	spotShadows,
+	spotShadowAtlasRG,
 	pointShadows,
 	mainBatches,
+	gpuCullBatchCount,
+	mainBase,
 	skinnedOpaqueDraws,
 	instStride,
 	activeReflectionProbeCount,
@@ -147,7 +164,7 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	BindMainPassMaterialTextures,
 	BuildMainPassMaterialFlags,
 	ComputeForwardGBufferReflectionMeta,
-	doDepthPrepass](renderGraph::PassContext& ctx)
+	depthPrepassComplete](renderGraph::PassContext& ctx)
 {
 	const auto extent = ctx.passExtent;
 
@@ -155,8 +172,8 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 		static_cast<int>(extent.width),
 		static_cast<int>(extent.height));
 
-	// If we ran a depth prepass, keep depth read-only in the main pass.
-	ctx.commandList.SetState(doDepthPrepass ? mainAfterPreDepthState_ : state_);
+	// If the depth prepass drew every opaque item, keep depth read-only in the main pass.
+	ctx.commandList.SetState(depthPrepassComplete ? mainAfterPreDepthState_ : state_);
 
 	const FrameCameraData camera = BuildFrameCameraData(scene, extent);
 	const mathUtils::Mat4& proj = camera.proj;
@@ -183,13 +200,13 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 			ctx.commandList.BindTextureDesc(0, scene.skyboxDescIndex);
 
 			ctx.commandList.BindInputLayout(skyboxMesh_.layout);
-			ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, 0);
-			ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, 0);
+			ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, skyboxMesh_.vertexOffsetBytes);
+			ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, skyboxMesh_.indexOffsetBytes);
 
 			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &skyboxConstants, 1 }));
-			ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, 0, 0);
+			ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, skyboxMesh_.firstIndex, skyboxMesh_.baseVertex);
 
-			ctx.commandList.SetState(doDepthPrepass ? mainAfterPreDepthState_ : state_);
+			ctx.commandList.SetState(depthPrepassComplete ? mainAfterPreDepthState_ : state_);
 		}
 	}
 
@@ -199,11 +216,10 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 		ctx.commandList.BindTexture2D(1, shadowTex);
 	}
 
-	// Bind Spot shadow maps at t3..t6 and Point shadow cubemaps at t7..t10.
-	for (std::size_t spotShadowIndex = 0; spotShadowIndex < spotShadows.size(); ++spotShadowIndex)
+	// Bind the spot shadow atlas at t3 and Point shadow cubemaps at t7..t10.
+	if (!spotShadows.empty())
 	{
-		const auto tex = ctx.resources.GetTexture(spotShadows[spotShadowIndex].tex);
-		ctx.commandList.BindTexture2D(3 + static_cast<std::uint32_t>(spotShadowIndex), tex);
+		ctx.commandList.BindTexture2D(3, ctx.resources.GetTexture(spotShadowAtlasRG));
 	}
 	for (std::size_t pointShadowIndex = 0; pointShadowIndex < pointShadows.size(); ++pointShadowIndex)
 	{
@@ -214,11 +230,13 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	// Bind shadow metadata SB at t11
 	ctx.commandList.BindStructuredBufferSRV(11, shadowDataBuffer_);
 
-	// Bind lights (t2 StructuredBuffer SRV)
+	// Bind lights (t2 StructuredBuffer SRV) and their cluster lists (t20)
 	ctx.commandList.BindStructuredBufferSRV(2, lightsBuffer_);
+	ctx.commandList.BindStructuredBufferSRV(20, lightClustersBuffer_);
 
-	for (const Batch& batch : mainBatches)
+	for (std::size_t batchIndex = 0; batchIndex < mainBatches.size(); ++batchIndex)
 	{
+		const Batch& batch = mainBatches[batchIndex];
 		if (!batch.mesh || batch.instanceCount == 0)
 		{
 			continue;
@@ -280,12 +298,24 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 
 		// IA (instanced)
 		ctx.commandList.BindInputLayout(batch.mesh->layoutInstanced);
-		ctx.commandList.BindVertexBuffer(0, batch.mesh->vertexBuffer, batch.mesh->vertexStrideBytes, 0);
-		ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, batch.instanceOffset * instStride);
-		ctx.commandList.BindIndexBuffer(batch.mesh->indexBuffer, batch.mesh->indexType, 0);
-
+		ctx.commandList.BindVertexBuffer(0, batch.mesh->vertexBuffer, batch.mesh->vertexStrideBytes, batch.mesh->vertexOffsetBytes);
+		ctx.commandList.BindIndexBuffer(batch.mesh->indexBuffer, batch.mesh->indexType, batch.mesh->indexOffsetBytes);
 		ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-		ctx.commandList.DrawIndexed(batch.mesh->indexCount, batch.mesh->indexType, 0, 0, batch.instanceCount, 0);
+
+		if (batchIndex < gpuCullBatchCount)
+		{
+			// Survivors of the GPU culling pass; the instance count comes from the argument buffer.
+			const std::uint32_t culledOffset = batch.instanceOffset - mainBase;
+			ctx.commandList.BindVertexBuffer(1, gpuCulledInstanceBuffer_, instStride, culledOffset * instStride);
+			ctx.commandList.DrawIndexedIndirect(
+				gpuCullArgsBuffer_,
+				static_cast<std::uint32_t>(batchIndex * sizeof(rhi::DrawIndexedIndirectArgs)),
+				batch.mesh->indexType);
+			continue;
+		}
+
+		ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, batch.instanceOffset * instStride);
+		ctx.commandList.DrawIndexed(batch.mesh->indexCount, batch.mesh->indexType, batch.mesh->firstIndex, batch.mesh->baseVertex, batch.instanceCount, 0);
 	}
 
 	for (const SkinnedOpaqueDraw& draw : skinnedOpaqueDraws)
@@ -344,13 +374,11 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 		constants.uEnvProbeBoxMax = { 0.0f, 0.0f, 0.0f, probeIdxNForGBuffer };
 		const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
 		std::memcpy(constants.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
-		constants.uSkinning = { static_cast<float>(draw.paletteOffset), static_cast<float>(draw.boneCount), 0.0f, 0.0f };
+		constants.uSkinning = SkinningConstantsFor(draw);
 
-		ctx.commandList.BindInputLayout(draw.mesh->layout);
-		ctx.commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, 0);
-		ctx.commandList.BindIndexBuffer(draw.mesh->indexBuffer, draw.mesh->indexType, 0);
+		BindSkinnedDrawVertices(ctx.commandList, draw);
 		ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-		ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, 0, 0);
+		ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, draw.mesh->firstIndex, draw.mesh->baseVertex);
 	}
 	});
 
@@ -361,6 +389,13 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	const auto sceneColor = forwardSceneColor;
 #include "RendererImpl/DirectX12Renderer_RenderFrame_04b_PlanarReflections_MaskRT.inl"
 
+	// Weighted blended OIT resolves the transparent batches into ForwardSceneColor ahead of the pass below,
+	// which then only adds particles and the editor selection.
+	if (weightedOit && !transparentDraws.empty())
+	{
+		AddWeightedOitPasses(forwardSceneColor, depthRG, scDesc.extent, 0u);
+	}
+
 	renderGraph::PassAttachments transparentAtt{};
 	transparentAtt.useSwapChainBackbuffer = false;
 	transparentAtt.colors = { forwardSceneColor };
@@ -368,30 +403,22 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	transparentAtt.clearDesc.clearColor = false;
 	transparentAtt.clearDesc.clearDepth = false;
 	transparentAtt.clearDesc.clearStencil = false;
+	ReadShadowMaps(transparentAtt.textures);
 
 	graph.AddPass("ForwardTransparentPass", std::move(transparentAtt), [
 		this,
 		&scene,
-		shadowRG,
 		dirLightViewProj,
-		lightCount,
-		spotShadows,
-		pointShadows,
-		instStride,
-		transparentDraws,
+		weightedOit,
 		selectionOpaque,
 		selectionOpaqueStart,
 		selectionTransparent,
 		selectionTransparentStart,
 		DrawEditorSelectionGroup,
-		ResolveMainPassMaterialPerm,
-		ResolveTransparentEnvBinding,
-		BindMainPassMaterialTextures,
-		BuildMainPassMaterialFlags,
-		FillPerBatchViewLightingConstants,
-		ResetPerBatchEnvProbeBox,
+		RecordTransparentDraws,
 		particleCount,
-		doDepthPrepass](renderGraph::PassContext& ctx)
+		drawGpuParticles,
+		depthPrepassComplete](renderGraph::PassContext& ctx)
 	{
 		const auto extent = ctx.passExtent;
 
@@ -404,31 +431,13 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 		const mathUtils::Vec3& camPosLocal = camera.camPos;
 		const mathUtils::Vec3& camFLocal = camera.camForward;
 
-		// Rebind lighting/shadow resources for transparent draws.
-		{
-			const auto shadowTex = ctx.resources.GetTexture(shadowRG);
-			ctx.commandList.BindTexture2D(1, shadowTex);
-		}
-		for (std::size_t spotShadowIndex = 0; spotShadowIndex < spotShadows.size(); ++spotShadowIndex)
-		{
-			const auto tex = ctx.resources.GetTexture(spotShadows[spotShadowIndex].tex);
-			ctx.commandList.BindTexture2D(3 + static_cast<std::uint32_t>(spotShadowIndex), tex);
-		}
-		for (std::size_t pointShadowIndex = 0; pointShadowIndex < pointShadows.size(); ++pointShadowIndex)
-		{
-			const auto tex = ctx.resources.GetTexture(pointShadows[pointShadowIndex].cube);
-			ctx.commandList.BindTexture2DArray(7 + static_cast<std::uint32_t>(pointShadowIndex), tex);
-		}
-		ctx.commandList.BindStructuredBufferSRV(11, shadowDataBuffer_);
-		ctx.commandList.BindStructuredBufferSRV(2, lightsBuffer_);
-
 	// If selected objects are opaque, draw outline/highlight BEFORE transparent objects
 	// so transparent surfaces still blend on top.
 	if (!selectionOpaque.empty())
 	{
 		DrawEditorSelectionGroup(
 			ctx,
-			doDepthPrepass ? mainAfterPreDepthState_ : state_,
+			depthPrepassComplete ? mainAfterPreDepthState_ : state_,
 			mathUtils::Vec4(1.0f, 0.95f, 0.25f, 0.35f),
 			viewProj,
 			dirLightViewProj,
@@ -439,72 +448,18 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 			selectionOpaqueStart);
 	}
 
-	if (!transparentDraws.empty())
+	if (!weightedOit)
 	{
-		ctx.commandList.SetState(transparentState_);
-
-		for (const TransparentDraw& batchTransparent : transparentDraws)
-		{
-			if (!batchTransparent.mesh)
-			{
-				continue;
-			}
-
-			const MaterialPerm perm = ResolveMainPassMaterialPerm(
-				batchTransparent.material,
-				batchTransparent.materialHandle);
-			const bool useTex = HasFlag(perm, MaterialPerm::UseTex);
-			const bool useShadow = HasFlag(perm, MaterialPerm::UseShadow);
-			const ResolvedMaterialEnvBinding env = ResolveTransparentEnvBinding(batchTransparent.materialHandle);
-
-			ctx.commandList.BindPipeline(MainPipelineFor(perm));
-			BindMainPassMaterialTextures(ctx.commandList, batchTransparent.material, env);
-
-			const std::uint32_t flags = BuildMainPassMaterialFlags(
-				batchTransparent.material,
-				useTex,
-				useShadow,
-				env);
-
-			PerBatchConstants constants{};
-			FillPerBatchViewLightingConstants(constants, viewProj, dirLightViewProj, camPosLocal, camFLocal);
-			constants.uBaseColor = { batchTransparent.material.baseColor.x, batchTransparent.material.baseColor.y, batchTransparent.material.baseColor.z, batchTransparent.material.baseColor.w };
-
-			const float materialBiasTexels = batchTransparent.material.shadowBias;
-			constants.uMaterialFlags = { 0.0f, 0.0f, materialBiasTexels, AsFloatBits(flags) };
-
-			constants.uPbrParams = { batchTransparent.material.metallic, batchTransparent.material.roughness, batchTransparent.material.ao, batchTransparent.material.emissiveStrength };
-
-			constants.uCounts = {
-				static_cast<float>(lightCount),
-				static_cast<float>(spotShadows.size()),
-				static_cast<float>(pointShadows.size()),
-				0.0f
-			};
-
-			constants.uShadowBias = {
-				settings_.dirShadowBaseBiasTexels,
-				settings_.spotShadowBaseBiasTexels,
-				settings_.pointShadowBaseBiasTexels,
-				settings_.shadowSlopeScaleTexels
-			};
-			ResetPerBatchEnvProbeBox(constants);
-
-			ctx.commandList.BindInputLayout(batchTransparent.mesh->layoutInstanced);
-			ctx.commandList.BindVertexBuffer(0, batchTransparent.mesh->vertexBuffer, batchTransparent.mesh->vertexStrideBytes, 0);
-			ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, batchTransparent.instanceOffset * instStride);
-			ctx.commandList.BindIndexBuffer(batchTransparent.mesh->indexBuffer, batchTransparent.mesh->indexType, 0);
-
-			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-
-			// IMPORTANT: transparent = one object per draw (instanceCount = 1)
-			ctx.commandList.DrawIndexed(batchTransparent.mesh->indexCount, batchTransparent.mesh->indexType, 0, 0, 1, 0);
-		}
+		RecordTransparentDraws(ctx, camera, 0u);
 	}
 	if (particleCount > 0u)
 	{
 		DrawParticleBillboards(ctx.commandList, scene, camera, particleCount);
 	}
+	if (drawGpuParticles)
+	{
+		DrawGpuParticles(ctx.commandList, scene, camera);
+	}
 
 	// If selected objects are transparent, render outline/highlight AFTER the transparent pass
 	// so it stays visible on top of their own translucency.
@@ -512,7 +467,7 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	{
 		DrawEditorSelectionGroup(
 			ctx,
-			doDepthPrepass ? mainAfterPreDepthState_ : state_,
+			depthPrepassComplete ? mainAfterPreDepthState_ : state_,
 			mathUtils::Vec4(1.0f, 0.95f, 0.25f, 0.35f),
 			viewProj,
 			dirLightViewProj,
@@ -542,6 +497,7 @@ if (canForwardSSAO)
 	aoAtt.clearDesc.clearStencil = false;
 
 	const auto sceneColorIn = forwardSceneColorAfterPost;
+	aoAtt.textures = { renderGraph::Read(sceneColorIn), renderGraph::Read(forwardSSAOBlur) };
 	graph.AddPass("ForwardSSAOComposite", std::move(aoAtt),
 		[this, sceneColorIn, forwardSSAOBlur](renderGraph::PassContext& ctx)
 		{
@@ -585,6 +541,7 @@ if (settings_.enableFog && psoFog_)
 	fogAtt.clearDesc.clearStencil = false;
 
 	const auto sceneColorIn = forwardSceneColorAfterPost;
+	fogAtt.textures = { renderGraph::Read(sceneColorIn), renderGraph::Read(depthRG) };
 	graph.AddPass("ForwardFog", std::move(fogAtt),
 		[this, depthRG, sceneColorIn, c](renderGraph::PassContext& ctx)
 		{
@@ -658,6 +615,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		renderGraph::PassAttachments att{};
 		att.useSwapChainBackbuffer = false;
 		att.colors = { bloomExtract };
+		att.textures = { renderGraph::Read(finalSceneColor) };
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
@@ -689,6 +647,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		renderGraph::PassAttachments att{};
 		att.useSwapChainBackbuffer = false;
 		att.colors = { bloomBlurX };
+		att.textures = { renderGraph::Read(bloomExtract) };
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
@@ -720,6 +679,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		renderGraph::PassAttachments att{};
 		att.useSwapChainBackbuffer = false;
 		att.colors = { bloomBlurY };
+		att.textures = { renderGraph::Read(bloomBlurX) };
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
@@ -746,6 +706,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		renderGraph::PassAttachments att{};
 		att.useSwapChainBackbuffer = false;
 		att.colors = { sceneColorBloom };
+		att.textures = { renderGraph::Read(finalSceneColor), renderGraph::Read(bloomBlurY) };
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
@@ -789,6 +750,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		renderGraph::PassAttachments att{};
 		att.useSwapChainBackbuffer = false;
 		att.colors = { presentLdr };
+		att.textures = { renderGraph::Read(finalSceneColor) };
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
@@ -850,7 +812,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 				ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(presentLdr));
 				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &c, 1 }));
 				ctx.commandList.Draw(3, 0);
-			});
+			}, true, { renderGraph::Read(presentLdr) });
 	}
 	else
 	{
@@ -883,7 +845,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 					ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(finalSceneColor));
 					ctx.commandList.Draw(3, 0);
 				}
-			});
+			}, true, { renderGraph::Read(finalSceneColor) });
 	}
 
 	if (imguiDrawData)
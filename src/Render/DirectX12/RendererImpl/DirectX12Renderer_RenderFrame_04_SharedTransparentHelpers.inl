@@ -0,0 +1,153 @@
+// Transparent draws of the forward and deferred paths. Sorted: one item per draw, far to near, blended
+// straight into SceneColor. Weighted blended OIT: one draw per batch into the accumulation + coverage
+// targets (MainOitPipelineFor, weightedOitState_), resolved over SceneColor by AddWeightedOitPasses.
+auto RecordTransparentDraws = [&](renderGraph::PassContext& ctx, const FrameCameraData& camera, std::uint32_t reflectionProbeCount)
+	{
+		if (transparentDraws.empty())
+		{
+			return;
+		}
+
+		// Lighting / shadow resources of the main shader.
+		{
+			const auto shadowTex = ctx.resources.GetTexture(shadowRG);
+			if (shadowTex)
+			{
+				ctx.commandList.BindTexture2D(1, shadowTex);
+			}
+		}
+		if (!spotShadows.empty())
+		{
+			ctx.commandList.BindTexture2D(3, ctx.resources.GetTexture(spotShadowAtlasRG));
+		}
+		for (std::size_t pointShadowIndex = 0; pointShadowIndex < pointShadows.size(); ++pointShadowIndex)
+		{
+			const auto tex = ctx.resources.GetTexture(pointShadows[pointShadowIndex].cube);
+			ctx.commandList.BindTexture2DArray(7 + static_cast<std::uint32_t>(pointShadowIndex), tex);
+		}
+		ctx.commandList.BindStructuredBufferSRV(11, shadowDataBuffer_);
+		ctx.commandList.BindStructuredBufferSRV(2, lightsBuffer_);
+		ctx.commandList.BindStructuredBufferSRV(20, lightClustersBuffer_);
+
+		ctx.commandList.SetState(weightedOit ? weightedOitState_ : transparentState_);
+
+		for (const TransparentDraw& batchTransparent : transparentDraws)
+		{
+			if (!batchTransparent.mesh || batchTransparent.instanceCount == 0)
+			{
+				continue;
+			}
+
+			const MaterialPerm perm = ResolveMainPassMaterialPerm(
+				batchTransparent.material,
+				batchTransparent.materialHandle);
+			const bool useTex = HasFlag(perm, MaterialPerm::UseTex);
+			const bool useShadow = HasFlag(perm, MaterialPerm::UseShadow);
+			const ResolvedMaterialEnvBinding env = ResolveTransparentEnvBinding(batchTransparent.materialHandle);
+
+			ctx.commandList.BindPipeline(weightedOit ? MainOitPipelineFor(perm) : MainPipelineFor(perm));
+			BindMainPassMaterialTextures(ctx.commandList, batchTransparent.material, env);
+
+			const std::uint32_t flags = BuildMainPassMaterialFlags(
+				batchTransparent.material,
+				useTex,
+				useShadow,
+				env);
+
+			PerBatchConstants constants{};
+			FillPerBatchViewLightingConstants(constants, camera.viewProj, dirLightViewProj, camera.camPos, camera.camForward);
+			constants.uBaseColor = { batchTransparent.material.baseColor.x, batchTransparent.material.baseColor.y, batchTransparent.material.baseColor.z, batchTransparent.material.baseColor.w };
+
+			const float materialBiasTexels = batchTransparent.material.shadowBias;
+			constants.uMaterialFlags = { 0.0f, 0.0f, materialBiasTexels, AsFloatBits(flags) };
+
+			constants.uPbrParams = { batchTransparent.material.metallic, batchTransparent.material.roughness, batchTransparent.material.ao, batchTransparent.material.emissiveStrength };
+
+			constants.uCounts = {
+				static_cast<float>(lightCount),
+				static_cast<float>(spotShadows.size()),
+				static_cast<float>(pointShadows.size()),
+				static_cast<float>(reflectionProbeCount)
+			};
+
+			constants.uShadowBias = {
+				settings_.dirShadowBaseBiasTexels,
+				settings_.spotShadowBaseBiasTexels,
+				settings_.pointShadowBaseBiasTexels,
+				settings_.shadowSlopeScaleTexels
+			};
+			ResetPerBatchEnvProbeBox(constants);
+
+			ctx.commandList.BindInputLayout(batchTransparent.mesh->layoutInstanced);
+			ctx.commandList.BindVertexBuffer(0, batchTransparent.mesh->vertexBuffer, batchTransparent.mesh->vertexStrideBytes, batchTransparent.mesh->vertexOffsetBytes);
+			ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, batchTransparent.instanceOffset * instStride);
+			ctx.commandList.BindIndexBuffer(batchTransparent.mesh->indexBuffer, batchTransparent.mesh->indexType, batchTransparent.mesh->indexOffsetBytes);
+
+			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
+
+			// Sorted: one object per draw (instanceCount = 1). OIT: the whole batch.
+			ctx.commandList.DrawIndexed(batchTransparent.mesh->indexCount, batchTransparent.mesh->indexType, batchTransparent.mesh->firstIndex, batchTransparent.mesh->baseVertex, batchTransparent.instanceCount, 0);
+		}
+	};
+
+// Weighted blended OIT: accumulate every transparent batch (depth-tested against the opaque depth, no
+// depth writes), then blend the resolved layers over sceneColorTarget.
+auto AddWeightedOitPasses = [&](renderGraph::RGTextureHandle sceneColorTarget, renderGraph::RGTextureHandle depth,
+	const rhi::Extent2D& extent, std::uint32_t reflectionProbeCount)
+	{
+		const auto oitAccum = graph.CreateTexture(renderGraph::RGTextureDesc{
+			.extent = extent,
+			.format = rhi::Format::RGBA16_FLOAT,
+			.usage = renderGraph::ResourceUsage::RenderTarget,
+			.debugName = "OitAccum"
+			});
+		const auto oitCoverage = graph.CreateTexture(renderGraph::RGTextureDesc{
+			.extent = extent,
+			.format = rhi::Format::R32_FLOAT,
+			.usage = renderGraph::ResourceUsage::RenderTarget,
+			.debugName = "OitCoverage"
+			});
+
+		{
+			renderGraph::PassAttachments att{};
+			att.useSwapChainBackbuffer = false;
+			att.colors = { oitAccum, oitCoverage };
+			att.depth = depth;
+			// Both targets start at zero: no accumulated color, no coverage.
+			att.clearDesc.clearColor = true;
+			att.clearDesc.color = { 0.0f, 0.0f, 0.0f, 0.0f };
+			att.clearDesc.clearDepth = false;
+			att.clearDesc.clearStencil = false;
+			ReadShadowMaps(att.textures);
+
+			graph.AddPass("TransparentOitAccumulate", std::move(att),
+				[this, &scene, RecordTransparentDraws, reflectionProbeCount](renderGraph::PassContext& ctx)
+				{
+					const auto extent = ctx.passExtent;
+					ctx.commandList.SetViewport(0, 0, static_cast<int>(extent.width), static_cast<int>(extent.height));
+					RecordTransparentDraws(ctx, BuildFrameCameraData(scene, extent), reflectionProbeCount);
+				});
+		}
+
+		renderGraph::PassAttachments att{};
+		att.useSwapChainBackbuffer = false;
+		att.colors = { sceneColorTarget };
+		att.clearDesc.clearColor = false;
+		att.clearDesc.clearDepth = false;
+		att.clearDesc.clearStencil = false;
+		att.textures = { renderGraph::Read(oitAccum), renderGraph::Read(oitCoverage) };
+
+		graph.AddPass("TransparentOitComposite", std::move(att),
+			[this, oitAccum, oitCoverage](renderGraph::PassContext& ctx)
+			{
+				const auto extent = ctx.passExtent;
+				ctx.commandList.SetViewport(0, 0, static_cast<int>(extent.width), static_cast<int>(extent.height));
+				ctx.commandList.SetState(weightedOitCompositeState_);
+				ctx.commandList.BindPipeline(psoWeightedOitComposite_);
+				ctx.commandList.BindInputLayout(fullscreenLayout_);
+				ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::TriangleList);
+				ctx.commandList.BindTexture2D(0, ctx.resources.GetTexture(oitAccum));
+				ctx.commandList.BindTexture2D(1, ctx.resources.GetTexture(oitCoverage));
+				ctx.commandList.Draw(3);
+			});
+	};
@@ -33,10 +33,10 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 		ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &maskConstants, 1 }));
 
 		ctx.commandList.BindInputLayout(mirror.mesh->layoutInstanced);
-		ctx.commandList.BindVertexBuffer(0, mirror.mesh->vertexBuffer, mirror.mesh->vertexStrideBytes, 0);
+		ctx.commandList.BindVertexBuffer(0, mirror.mesh->vertexBuffer, mirror.mesh->vertexStrideBytes, mirror.mesh->vertexOffsetBytes);
 		ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, mirror.instanceOffset * instStride);
-		ctx.commandList.BindIndexBuffer(mirror.mesh->indexBuffer, mirror.mesh->indexType, 0);
-		ctx.commandList.DrawIndexed(mirror.mesh->indexCount, mirror.mesh->indexType, 0, 0, 1, 0);
+		ctx.commandList.BindIndexBuffer(mirror.mesh->indexBuffer, mirror.mesh->indexType, mirror.mesh->indexOffsetBytes);
+		ctx.commandList.DrawIndexed(mirror.mesh->indexCount, mirror.mesh->indexType, mirror.mesh->firstIndex, mirror.mesh->baseVertex, 1, 0);
 
 		// ---------------- (2) Reflected scene: reflected camera, stencil-gated ----------------
 		const mathUtils::Mat4 reflectW = mathUtils::MakeReflectionMatrix(planeN, planeD);
@@ -97,10 +97,10 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 			ctx.commandList.BindPipeline(psoSkybox_);
 			ctx.commandList.BindTextureDesc(0, scene.skyboxDescIndex);
 			ctx.commandList.BindInputLayout(skyboxMesh_.layout);
-			ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, 0);
-			ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, 0);
+			ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, skyboxMesh_.vertexOffsetBytes);
+			ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, skyboxMesh_.indexOffsetBytes);
 			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &skyConsts, 1 }));
-			ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, 0, 0);
+			ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, skyboxMesh_.firstIndex, skyboxMesh_.baseVertex);
 
 			// Restore reflected mesh state.
 			ctx.commandList.SetState(planarReflectedState_);
@@ -155,17 +155,17 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 			}
 
 			ctx.commandList.BindInputLayout(batch.mesh->layoutInstanced);
-			ctx.commandList.BindVertexBuffer(0, batch.mesh->vertexBuffer, batch.mesh->vertexStrideBytes, 0);
+			ctx.commandList.BindVertexBuffer(0, batch.mesh->vertexBuffer, batch.mesh->vertexStrideBytes, batch.mesh->vertexOffsetBytes);
 			ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, batch.instanceOffset * instStride);
-			ctx.commandList.BindIndexBuffer(batch.mesh->indexBuffer, batch.mesh->indexType, 0);
+			ctx.commandList.BindIndexBuffer(batch.mesh->indexBuffer, batch.mesh->indexType, batch.mesh->indexOffsetBytes);
 			ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-			ctx.commandList.DrawIndexed(batch.mesh->indexCount, batch.mesh->indexType, 0, 0, batch.instanceCount, 0);
+			ctx.commandList.DrawIndexed(batch.mesh->indexCount, batch.mesh->indexType, batch.mesh->firstIndex, batch.mesh->baseVertex, batch.instanceCount, 0);
 		}
 
 		++mirrorIndex;
 	}
 
 	// Restore state for the following passes (transparent / imgui).
-	ctx.commandList.SetState(doDepthPrepass ? mainAfterPreDepthState_ : state_);
+	ctx.commandList.SetState(depthPrepassComplete ? mainAfterPreDepthState_ : state_);
 	ctx.commandList.SetStencilRef(0);
 }
\ No newline at end of file
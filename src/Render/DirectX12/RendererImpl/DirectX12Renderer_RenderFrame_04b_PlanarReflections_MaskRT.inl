@@ -2,12 +2,45 @@
 // It composites reflections into `sceneColor` before final Present to swapchain.
 // We render a per-mirror screen-space mask into an offscreen RT, render the reflected scene
 // into an offscreen color+depth, then alpha-blend it into the swapchain using the mask.
+// The reflected scene renders at planarReflectionRenderScale, scissored to the mirror's screen rect, and
+// only draws the instances inside the reflected frustum: its near plane is the mirror plane (oblique
+// projection) and its sides go through the mirror's screen rect.
 
 if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 {
-	const auto extent = scDesc.extent;
+	const auto extent = renderExtent;
 	const std::uint32_t maxMirrors = std::max(1u, settings_.planarReflectionMaxMirrors);
 
+	const float planarAspect = extent.height ? (static_cast<float>(extent.width) / static_cast<float>(extent.height)) : 1.0f;
+	const mathUtils::Mat4 planarProj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(scene.camera.fovYDeg), planarAspect, scene.camera.nearZ, scene.camera.farZ);
+	const mathUtils::Mat4 planarView = mathUtils::LookAt(scene.camera.position, scene.camera.target, scene.camera.up);
+	const mathUtils::Mat4 planarViewProj = planarProj * planarView;
+
+	const float reflScale = std::clamp(settings_.planarReflectionRenderScale, 0.25f, 1.0f);
+	const rhi::Extent2D reflExtent{
+		std::max(1u, static_cast<std::uint32_t>(static_cast<float>(extent.width) * reflScale + 0.5f)),
+		std::max(1u, static_cast<std::uint32_t>(static_cast<float>(extent.height) * reflScale + 0.5f)) };
+
+	const auto& planarSourceBatches = !captureMainBatchesNoCull.empty() ? captureMainBatchesNoCull : mainBatches;
+
+	struct PixelRect
+	{
+		int x{ 0 };
+		int y{ 0 };
+		int width{ 0 };
+		int height{ 0 };
+	};
+	auto NdcRectToPixels = [](const mathUtils::NdcRect& r, const rhi::Extent2D& e) -> PixelRect
+		{
+			const float w = static_cast<float>(e.width);
+			const float h = static_cast<float>(e.height);
+			const int x0 = static_cast<int>(std::floor((r.x0 * 0.5f + 0.5f) * w));
+			const int x1 = static_cast<int>(std::ceil((r.x1 * 0.5f + 0.5f) * w));
+			const int y0 = static_cast<int>(std::floor((0.5f - r.y1 * 0.5f) * h)); // NDC y up, pixels down
+			const int y1 = static_cast<int>(std::ceil((0.5f - r.y0 * 0.5f) * h));
+			return PixelRect{ x0, y0, x1 - x0, y1 - y0 };
+		};
+
 	std::uint32_t mirrorIndex = 0u;
 	for (const PlanarMirrorDraw& mirror : planarMirrorDraws)
 	{
@@ -30,6 +63,63 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 			}
 		}
 
+		// Nothing outside the mirror's screen rect can show up in its reflection.
+		const mathUtils::NdcRect mirrorRect = (mirror.boundsSphere.w > 0.0f)
+			? mathUtils::ProjectSphereNdcRect(planarViewProj,
+				mathUtils::Vec3(mirror.boundsSphere.x, mirror.boundsSphere.y, mirror.boundsSphere.z), mirror.boundsSphere.w)
+			: mathUtils::NdcRect{};
+		if (mirrorRect.Empty())
+		{
+			continue;
+		}
+		const PixelRect reflScissor = NdcRectToPixels(mirrorRect, reflExtent);
+		const PixelRect compositeScissor = NdcRectToPixels(mirrorRect, extent);
+
+		// Reflected frustum: the reflected camera with the mirror plane as its (oblique) near plane and
+		// its sides through the mirror rect. The oblique projection tilts the far plane, so keep the regular one.
+		const mathUtils::Mat4 reflectW = mathUtils::MakeReflectionMatrix(planeN, planeD);
+		const mathUtils::Mat4 viewRefl = planarView * reflectW;
+		const mathUtils::Vec4 clipPlaneView = mathUtils::Transpose(mathUtils::Inverse(viewRefl)) * mathUtils::Vec4(planeN, planeD);
+		const mathUtils::Mat4 obliqueProj = mathUtils::PerspectiveRH_ZO_Oblique(planarProj, clipPlaneView);
+		mathUtils::Frustum reflFrustum = mathUtils::ExtractFrustumRH_ZO(obliqueProj * viewRefl, mirrorRect);
+		reflFrustum.planes[static_cast<std::uint32_t>(mathUtils::FrustumPlane::Far)] =
+			mathUtils::ExtractFrustumRH_ZO(planarProj * viewRefl).planes[static_cast<std::uint32_t>(mathUtils::FrustumPlane::Far)];
+
+		// Reflected draw list: the runs of each batch's instances that intersect the reflected frustum.
+		std::vector<Batch> reflectedBatches;
+		reflectedBatches.reserve(planarSourceBatches.size());
+		for (const Batch& batch : planarSourceBatches)
+		{
+			if (!batch.mesh || batch.instanceCount == 0)
+			{
+				continue;
+			}
+
+			const mathUtils::Vec3 localCenter{ batch.boundsSphere.x, batch.boundsSphere.y, batch.boundsSphere.z };
+			Batch run = batch;
+			run.instanceCount = 0;
+			for (std::uint32_t i = 0; i < batch.instanceCount; ++i)
+			{
+				if (IsVisibleSphere(localCenter, batch.boundsSphere.w, CombinedInstanceModel(batch.instanceOffset + i), reflFrustum, true))
+				{
+					if (run.instanceCount == 0)
+					{
+						run.instanceOffset = batch.instanceOffset + i;
+					}
+					++run.instanceCount;
+				}
+				else if (run.instanceCount != 0)
+				{
+					reflectedBatches.push_back(run);
+					run.instanceCount = 0;
+				}
+			}
+			if (run.instanceCount != 0)
+			{
+				reflectedBatches.push_back(run);
+			}
+		}
+
 		const auto maskTex = graph.CreateTexture(renderGraph::RGTextureDesc{
 			.extent = extent,
 			.format = rhi::Format::RGBA8_UNORM,
@@ -38,14 +128,14 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 			});
 
 		const auto reflColor = graph.CreateTexture(renderGraph::RGTextureDesc{
-			.extent = extent,
+			.extent = reflExtent,
 			.format = sceneColorFormat,
 			.usage = renderGraph::ResourceUsage::RenderTarget,
 			.debugName = std::string("PlanarReflColor_") + std::to_string(mirrorIndex)
 			});
 
 		const auto reflDepth = graph.CreateTexture(renderGraph::RGTextureDesc{
-			.extent = extent,
+			.extent = reflExtent,
 			.format = rhi::Format::D24_UNORM_S8_UINT,
 			.usage = renderGraph::ResourceUsage::DepthStencil,
 			.debugName = std::string("PlanarReflDepth_") + std::to_string(mirrorIndex)
@@ -130,11 +220,11 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 					constants.uEnvProbeBoxMax = { 0.0f, 0.0f, 0.0f, 0.0f };
 
 					ctx.commandList.BindInputLayout(mirror.mesh->layoutInstanced);
-					ctx.commandList.BindVertexBuffer(0, mirror.mesh->vertexBuffer, mirror.mesh->vertexStrideBytes, 0);
+					ctx.commandList.BindVertexBuffer(0, mirror.mesh->vertexBuffer, mirror.mesh->vertexStrideBytes, mirror.mesh->vertexOffsetBytes);
 					ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, mirror.instanceOffset * instStride);
-					ctx.commandList.BindIndexBuffer(mirror.mesh->indexBuffer, mirror.mesh->indexType, 0);
+					ctx.commandList.BindIndexBuffer(mirror.mesh->indexBuffer, mirror.mesh->indexType, mirror.mesh->indexOffsetBytes);
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-					ctx.commandList.DrawIndexed(mirror.mesh->indexCount, mirror.mesh->indexType, 0, 0, 1, 0);
+					ctx.commandList.DrawIndexed(mirror.mesh->indexCount, mirror.mesh->indexType, mirror.mesh->firstIndex, mirror.mesh->baseVertex, 1, 0);
 				});
 		}
 
@@ -150,22 +240,20 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 			att.clearDesc.depth = 1.0f;
 			att.clearDesc.clearStencil = true;
 			att.clearDesc.stencil = 0;
+			ReadShadowMaps(att.textures);
 
 			graph.AddPass(std::string("PlanarReflScene_") + std::to_string(mirrorIndex), std::move(att),
-				[this, &scene, ResolveMainPassMaterialPerm, ResolveOpaqueEnvBinding, BindMainPassMaterialTextures, BuildMainPassMaterialFlags, shadowRG, dirLightViewProj, lightCount, spotShadows, pointShadows, mainBatches, captureMainBatchesNoCull, skinnedOpaqueDraws, instStride, planeN, planeD](renderGraph::PassContext& ctx)
+				[this, &scene, ResolveMainPassMaterialPerm, ResolveOpaqueEnvBinding, BindMainPassMaterialTextures, BuildMainPassMaterialFlags, shadowRG, dirLightViewProj, unclusteredLightCount, spotShadows, spotShadowAtlasRG, pointShadows, reflectedBatches, skinnedOpaqueDraws, instStride, planeN, planeD, planarProj, planarViewProj, reflectW, reflScissor](renderGraph::PassContext& ctx)
 				{
 					const auto e = ctx.passExtent;
 					ctx.commandList.SetViewport(0, 0, static_cast<int>(e.width), static_cast<int>(e.height));
+					ctx.commandList.SetScissor(reflScissor.x, reflScissor.y, reflScissor.width, reflScissor.height);
 
-					const float aspect = e.height ? (static_cast<float>(e.width) / static_cast<float>(e.height)) : 1.0f;
-					const mathUtils::Mat4 proj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(scene.camera.fovYDeg), aspect, scene.camera.nearZ, scene.camera.farZ);
-					const mathUtils::Mat4 view = mathUtils::LookAt(scene.camera.position, scene.camera.target, scene.camera.up);
-					const mathUtils::Mat4 viewProj = proj * view;
+					const mathUtils::Mat4& proj = planarProj;
 					const mathUtils::Vec3 camPosLocal = scene.camera.position;
 					const mathUtils::Vec3 camFLocal = mathUtils::Normalize(scene.camera.target - scene.camera.position);
 
-					const mathUtils::Mat4 reflectW = mathUtils::MakeReflectionMatrix(planeN, planeD);
-					const mathUtils::Mat4 viewProjReflT = mathUtils::Transpose(viewProj * reflectW);
+					const mathUtils::Mat4 viewProjReflT = mathUtils::Transpose(planarViewProj * reflectW);
 
 					ctx.commandList.SetStencilRef(0u);
 					ctx.commandList.SetState(planarReflectedState_);
@@ -200,10 +288,10 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 						ctx.commandList.BindPipeline(psoSkybox_);
 						ctx.commandList.BindTextureDesc(0, scene.skyboxDescIndex);
 						ctx.commandList.BindInputLayout(skyboxMesh_.layout);
-						ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, 0);
-						ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, 0);
+						ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, skyboxMesh_.vertexOffsetBytes);
+						ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, skyboxMesh_.indexOffsetBytes);
 						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &sky, 1 }));
-						ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, 0, 0, 1, 0);
+						ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, skyboxMesh_.firstIndex, skyboxMesh_.baseVertex, 1, 0);
 
 						// Restore for reflected meshes
 						ctx.commandList.SetState(planarReflectedState_);
@@ -211,9 +299,9 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 
 					// Bind shadows + lights like in the forward main pass.
 					ctx.commandList.BindTexture2D(1, ctx.resources.GetTexture(shadowRG));
-					for (std::size_t spotShadowIndex = 0; spotShadowIndex < spotShadows.size(); ++spotShadowIndex)
+					if (!spotShadows.empty())
 					{
-						ctx.commandList.BindTexture2D(3 + static_cast<std::uint32_t>(spotShadowIndex), ctx.resources.GetTexture(spotShadows[spotShadowIndex].tex));
+						ctx.commandList.BindTexture2D(3, ctx.resources.GetTexture(spotShadowAtlasRG));
 					}
 					for (std::size_t pointShadowIndex = 0; pointShadowIndex < pointShadows.size(); ++pointShadowIndex)
 					{
@@ -221,8 +309,8 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 					}
 					ctx.commandList.BindStructuredBufferSRV(11, shadowDataBuffer_);
 					ctx.commandList.BindStructuredBufferSRV(2, lightsBuffer_);
-
-					const auto& planarBatches = !captureMainBatchesNoCull.empty() ? captureMainBatchesNoCull : mainBatches;
+					// Mirrored camera: the main camera's clusters don't apply.
+					ctx.commandList.BindStructuredBufferSRV(20, lightClustersOffBuffer_);
 
 					constexpr std::uint32_t kFlagUseTex = 1u << 0;
 					constexpr std::uint32_t kFlagUseShadow = 1u << 1;
@@ -235,7 +323,7 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 					constexpr std::uint32_t kFlagEnvFlipZ = 1u << 8;
 					constexpr std::uint32_t kFlagEnvForceMip0 = 1u << 9;
 
-					for (const Batch& batch : planarBatches)
+					for (const Batch& batch : reflectedBatches)
 					{
 						if (!batch.mesh || batch.instanceCount == 0)
 						{
@@ -331,7 +419,7 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 						constants.uMaterialFlags = { planeN.x, planeN.y, materialBiasTexels, AsFloatBits(flags) };
 
 						constants.uPbrParams = { batch.material.metallic, batch.material.roughness, batch.material.ao, batch.material.emissiveStrength };
-						constants.uCounts = { float(lightCount), float(spotShadows.size()), float(pointShadows.size()), (planeD - 0.05f) };
+						constants.uCounts = { float(unclusteredLightCount), float(spotShadows.size()), float(pointShadows.size()), (planeD - 0.05f) };
 						constants.uShadowBias = { settings_.dirShadowBaseBiasTexels, settings_.spotShadowBaseBiasTexels, settings_.pointShadowBaseBiasTexels, settings_.shadowSlopeScaleTexels };
 						constants.uEnvProbeBoxMin = { 0.0f, 0.0f, 0.0f, 0.0f };
 						constants.uEnvProbeBoxMax = { 0.0f, 0.0f, 0.0f, 0.0f };
@@ -345,11 +433,11 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 						}
 
 						ctx.commandList.BindInputLayout(batch.mesh->layoutInstanced);
-						ctx.commandList.BindVertexBuffer(0, batch.mesh->vertexBuffer, batch.mesh->vertexStrideBytes, 0);
+						ctx.commandList.BindVertexBuffer(0, batch.mesh->vertexBuffer, batch.mesh->vertexStrideBytes, batch.mesh->vertexOffsetBytes);
 						ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, batch.instanceOffset * instStride);
-						ctx.commandList.BindIndexBuffer(batch.mesh->indexBuffer, batch.mesh->indexType, 0);
+						ctx.commandList.BindIndexBuffer(batch.mesh->indexBuffer, batch.mesh->indexType, batch.mesh->indexOffsetBytes);
 						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-						ctx.commandList.DrawIndexed(batch.mesh->indexCount, batch.mesh->indexType, 0, 0, batch.instanceCount, 0);
+						ctx.commandList.DrawIndexed(batch.mesh->indexCount, batch.mesh->indexType, batch.mesh->firstIndex, batch.mesh->baseVertex, batch.instanceCount, 0);
 					}
 
 					for (const SkinnedOpaqueDraw& draw : skinnedOpaqueDraws)
@@ -392,19 +480,17 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 						const float materialBiasTexels = draw.material.shadowBias;
 						constants.uMaterialFlags = { planeN.x, planeN.y, materialBiasTexels, AsFloatBits(flags) };
 						constants.uPbrParams = { draw.material.metallic, draw.material.roughness, draw.material.ao, draw.material.emissiveStrength };
-						constants.uCounts = { float(lightCount), float(spotShadows.size()), float(pointShadows.size()), (planeD - 0.05f) };
+						constants.uCounts = { float(unclusteredLightCount), float(spotShadows.size()), float(pointShadows.size()), (planeD - 0.05f) };
 						constants.uShadowBias = { settings_.dirShadowBaseBiasTexels, settings_.spotShadowBaseBiasTexels, settings_.pointShadowBaseBiasTexels, settings_.shadowSlopeScaleTexels };
 						constants.uEnvProbeBoxMin = { 0.0f, 0.0f, 0.0f, 0.0f };
 						constants.uEnvProbeBoxMax = { 0.0f, 0.0f, 0.0f, 0.0f };
 						const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
 						std::memcpy(constants.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
-						constants.uSkinning = { static_cast<float>(draw.paletteOffset), static_cast<float>(draw.boneCount), 0.0f, 0.0f };
+						constants.uSkinning = SkinningConstantsFor(draw);
 
-						ctx.commandList.BindInputLayout(draw.mesh->layout);
-						ctx.commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, 0);
-						ctx.commandList.BindIndexBuffer(draw.mesh->indexBuffer, draw.mesh->indexType, 0);
+						BindSkinnedDrawVertices(ctx.commandList, draw);
 						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-						ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, 0, 0);
+						ctx.commandList.DrawIndexed(draw.mesh->indexCount, draw.mesh->indexType, draw.mesh->firstIndex, draw.mesh->baseVertex);
 					}
 				});
 		}
@@ -418,12 +504,14 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 			att.clearDesc.clearColor = false;
 			att.clearDesc.clearDepth = false;
 			att.clearDesc.clearStencil = false;
+			att.textures = { renderGraph::Read(maskTex), renderGraph::Read(reflColor) };
 
 			graph.AddPass(std::string("PlanarComposite_") + std::to_string(mirrorIndex), std::move(att),
-				[this, maskTex, reflColor](renderGraph::PassContext& ctx)
+				[this, maskTex, reflColor, compositeScissor](renderGraph::PassContext& ctx)
 				{
 					const auto e = ctx.passExtent;
 					ctx.commandList.SetViewport(0, 0, static_cast<int>(e.width), static_cast<int>(e.height));
+					ctx.commandList.SetScissor(compositeScissor.x, compositeScissor.y, compositeScissor.width, compositeScissor.height);
 					ctx.commandList.SetStencilRef(0x01u);
 
 					ctx.commandList.SetState(planarCompositeState_);
@@ -475,11 +563,11 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 					constants.uEnvProbeBoxMax = { 0.0f, 0.0f, 0.0f, 0.0f };
 
 					ctx.commandList.BindInputLayout(mirror.mesh->layoutInstanced);
-					ctx.commandList.BindVertexBuffer(0, mirror.mesh->vertexBuffer, mirror.mesh->vertexStrideBytes, 0);
+					ctx.commandList.BindVertexBuffer(0, mirror.mesh->vertexBuffer, mirror.mesh->vertexStrideBytes, mirror.mesh->vertexOffsetBytes);
 					ctx.commandList.BindVertexBuffer(1, instanceBuffer_, instStride, mirror.instanceOffset * instStride);
-					ctx.commandList.BindIndexBuffer(mirror.mesh->indexBuffer, mirror.mesh->indexType, 0);
+					ctx.commandList.BindIndexBuffer(mirror.mesh->indexBuffer, mirror.mesh->indexType, mirror.mesh->indexOffsetBytes);
 					ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
-					ctx.commandList.DrawIndexed(mirror.mesh->indexCount, mirror.mesh->indexType, 0, 0, 1, 0);
+					ctx.commandList.DrawIndexed(mirror.mesh->indexCount, mirror.mesh->indexType, mirror.mesh->firstIndex, mirror.mesh->baseVertex, 1, 0);
 				});
 		}
 
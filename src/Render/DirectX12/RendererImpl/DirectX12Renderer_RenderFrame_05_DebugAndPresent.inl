@@ -113,54 +113,6 @@ auto AddPlaneLabel = [&](const mathUtils::Vec3& centerW, std::string_view label,
 			outlinePx);
 	};
 
-auto AddAabbLines = [&](const mathUtils::Vec3& bmin,
-	const mathUtils::Vec3& bmax,
-	std::uint32_t rgba)
-	{
-		const mathUtils::Vec3 p000(bmin.x, bmin.y, bmin.z);
-		const mathUtils::Vec3 p100(bmax.x, bmin.y, bmin.z);
-		const mathUtils::Vec3 p110(bmax.x, bmax.y, bmin.z);
-		const mathUtils::Vec3 p010(bmin.x, bmax.y, bmin.z);
-
-		const mathUtils::Vec3 p001(bmin.x, bmin.y, bmax.z);
-		const mathUtils::Vec3 p101(bmax.x, bmin.y, bmax.z);
-		const mathUtils::Vec3 p111(bmax.x, bmax.y, bmax.z);
-		const mathUtils::Vec3 p011(bmin.x, bmax.y, bmax.z);
-
-		debugList.AddLine(p000, p100, rgba);
-		debugList.AddLine(p100, p110, rgba);
-		debugList.AddLine(p110, p010, rgba);
-		debugList.AddLine(p010, p000, rgba);
-
-		debugList.AddLine(p001, p101, rgba);
-		debugList.AddLine(p101, p111, rgba);
-		debugList.AddLine(p111, p011, rgba);
-		debugList.AddLine(p011, p001, rgba);
-
-		debugList.AddLine(p000, p001, rgba);
-		debugList.AddLine(p100, p101, rgba);
-		debugList.AddLine(p110, p111, rgba);
-		debugList.AddLine(p010, p011, rgba);
-	};
-
-auto AddProbeCenterMarker = [&](const mathUtils::Vec3& p, float s, std::uint32_t rgba)
-	{
-		debugList.AddLine(
-			mathUtils::Vec3(p.x - s, p.y, p.z),
-			mathUtils::Vec3(p.x + s, p.y, p.z),
-			rgba);
-
-		debugList.AddLine(
-			mathUtils::Vec3(p.x, p.y - s, p.z),
-			mathUtils::Vec3(p.x, p.y + s, p.z),
-			rgba);
-
-		debugList.AddLine(
-			mathUtils::Vec3(p.x, p.y, p.z - s),
-			mathUtils::Vec3(p.x, p.y, p.z + s),
-			rgba);
-	};
-
 auto ResolveGizmoAxisColor = [&](GizmoAxis activeAxis, GizmoAxis hoveredAxis, GizmoAxis axis, std::uint32_t baseColor) -> std::uint32_t
 	{
 		if (activeAxis == axis)
@@ -215,8 +167,8 @@ if (settings_.enableReflectionCapture)
 		const std::uint32_t boxColor = validProbe ? 0xFF00FFFFu : 0xFF0000FFu;   // cyan / red
 		const std::uint32_t centerColor = 0xFFFFFF00u;                            // yellow
 
-		AddAabbLines(bmin, bmax, boxColor);
-		AddProbeCenterMarker(probe.capturePos, markerSize, centerColor);
+		debugList.AddAabb(bmin, bmax, boxColor);
+		debugList.AddAxis(probe.capturePos, markerSize, centerColor);
 	}
 }
 
@@ -255,10 +207,10 @@ if (settings_.drawLightGizmos)
 			debugList.AddLine(p - mathUtils::Vec3(0.0f, halfSize, 0.0f), p + mathUtils::Vec3(0.0f, halfSize, 0.0f), colPoint);
 			debugList.AddLine(p - mathUtils::Vec3(0.0f, 0.0f, halfSize), p + mathUtils::Vec3(0.0f, 0.0f, halfSize), colPoint);
 
-			debugList.AddWireSphere(p, halfSize, colPoint, 16);
+			debugList.AddSphere(p, halfSize, colPoint);
 			if (selectedLight)
 			{
-				debugList.AddWireSphere(p, halfSize * 1.35f, debugDraw::PackRGBA8(255, 255, 0, 255), 20);
+				debugList.AddSphere(p, halfSize * 1.35f, debugDraw::PackRGBA8(255, 255, 0, 255));
 			}
 			break;
 		}
@@ -270,7 +222,7 @@ if (settings_.drawLightGizmos)
 			debugList.AddWireCone(p, dir, arrowLen, outerRad, colSpot, 24);
 			if (selectedLight)
 			{
-				debugList.AddWireSphere(p, halfSize * 0.65f, debugDraw::PackRGBA8(255, 255, 0, 255), 16);
+				debugList.AddSphere(p, halfSize * 0.65f, debugDraw::PackRGBA8(255, 255, 0, 255));
 			}
 
 			break;
@@ -300,7 +252,7 @@ if (!scene.particleEmitters.empty())
 		const mathUtils::Vec3 jitter = emitter.positionJitter;
 		if (mathUtils::Length(jitter) > 1e-4f)
 		{
-			AddAabbLines(p - jitter, p + jitter, colMain);
+			debugList.AddAabb(p - jitter, p + jitter, colMain);
 		}
 
 		mathUtils::Vec3 dir = emitter.velocityMin + emitter.velocityMax;
@@ -312,14 +264,7 @@ if (!scene.particleEmitters.empty())
 			debugList.AddArrow(p, p + dir * arrowLen, colDir, 0.18f, 0.10f, true);
 		}
 
-		int aliveCount = 0;
-		for (const Particle& particle : scene.particles)
-		{
-			if (particle.alive && particle.ownerEmitter == static_cast<int>(i))
-			{
-				++aliveCount;
-			}
-		}
+		const int aliveCount = static_cast<int>(scene.particles.CountOwnedBy(static_cast<int>(i)));
 
 		mathUtils::Vec2 pPx{};
 		if (ProjectWorldToScreenPx(p, pPx))
@@ -771,7 +716,7 @@ if (scene.editorDrawSelectedSkinnedSkeleton || scene.editorDrawSelectedSkinnedBo
 				: item.asset->mesh.bounds.bindPoseBounds;
 			mathUtils::Vec3 wmin{}, wmax{};
 			TransformAabbToWorld(bounds.aabbMin, bounds.aabbMax, model, wmin, wmax);
-			AddAabbLines(wmin, wmax, boundsColor);
+			debugList.AddAabb(wmin, wmax, boundsColor);
 		}
 
 		if (scene.editorDrawSelectedSkinnedSkeleton &&
@@ -789,7 +734,7 @@ if (scene.editorDrawSelectedSkinnedSkeleton || scene.editorDrawSelectedSkinnedBo
 				}
 				else
 				{
-					debugList.AddAxesCross(bonePos, 0.03f, skeletonColor, true);
+					debugList.AddAxis(bonePos, 0.03f, skeletonColor, true);
 				}
 			}
 		}
@@ -958,7 +903,7 @@ if (settings_.ShowCubeAtlas)
 
 				// Restore full viewport for any following swapchain passes.
 				ctx.commandList.SetViewport(0, 0, static_cast<int>(W), static_cast<int>(H));
-			});
+			}, true, { renderGraph::Read(cubeRG) });
 	}
 }
 
@@ -1029,7 +974,7 @@ if (!textList.Empty())
 }
 
 debugDrawRenderer_.Upload(debugList);
-if (debugList.VertexCount() > 0)
+if (!debugList.Empty())
 {
 	rhi::ClearDesc clear{};
 	clear.clearColor = false;
@@ -1056,5 +1001,17 @@ if (!textList.Empty())
 		});
 }
 
-graph.Execute(device_, swapChain);
-swapChain.Present();
\ No newline at end of file
+graph.Execute(device_, swapChain, transientPool_, &frameStats_);
+
+const rhi::DeviceCounters deviceCounters = device_.GetDeviceCounters();
+frameStats_.bufferUpdates = static_cast<std::uint32_t>(deviceCounters.bufferUpdates - lastDeviceCounters_.bufferUpdates);
+frameStats_.bufferUploadBytes = deviceCounters.bufferUploadBytes - lastDeviceCounters_.bufferUploadBytes;
+frameStats_.descriptorAllocations = static_cast<std::uint32_t>(deviceCounters.descriptorAllocations - lastDeviceCounters_.descriptorAllocations);
+lastDeviceCounters_ = deviceCounters;
+++frameStats_.frameIndex;
+
+swapChain.Present();
+if (scene.inputSampleTime != std::chrono::steady_clock::time_point{})
+{
+	frameStats_.inputToPresentMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - scene.inputSampleTime).count();
+}
\ No newline at end of file
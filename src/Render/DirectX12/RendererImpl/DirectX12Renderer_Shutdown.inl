@@ -1,3 +1,4 @@
+transientPool_.Clear(device_);
 if (fullscreenLayout_.id != 0)
 {
 	device_.DestroyInputLayout(fullscreenLayout_);
@@ -19,14 +20,145 @@ if (particleInstanceBuffer_)
 {
 	device_.DestroyBuffer(particleInstanceBuffer_);
 }
+if (gpuCulledInstanceBuffer_)
+{
+	device_.DestroyBuffer(gpuCulledInstanceBuffer_);
+	gpuCulledInstanceBuffer_ = {};
+}
+if (gpuCullArgsBuffer_)
+{
+	device_.DestroyBuffer(gpuCullArgsBuffer_);
+	gpuCullArgsBuffer_ = {};
+}
+if (gpuCullBatchBuffer_)
+{
+	device_.DestroyBuffer(gpuCullBatchBuffer_);
+	gpuCullBatchBuffer_ = {};
+}
+if (gpuCullInstanceBatchBuffer_)
+{
+	device_.DestroyBuffer(gpuCullInstanceBatchBuffer_);
+	gpuCullInstanceBatchBuffer_ = {};
+}
+if (shadowIndirectArgsBuffer_)
+{
+	device_.DestroyBuffer(shadowIndirectArgsBuffer_);
+	shadowIndirectArgsBuffer_ = {};
+}
+if (hiZBuffer_)
+{
+	device_.DestroyBuffer(hiZBuffer_);
+	hiZBuffer_ = {};
+}
+hiZExtent_ = {};
+if (psoHiZBuild_)
+{
+	device_.DestroyPipeline(psoHiZBuild_);
+	psoHiZBuild_ = {};
+}
+if (psoGpuCull_)
+{
+	device_.DestroyPipeline(psoGpuCull_);
+	psoGpuCull_ = {};
+}
+if (gpuParticleBuffer_)
+{
+	device_.DestroyBuffer(gpuParticleBuffer_);
+	gpuParticleBuffer_ = {};
+}
+if (gpuParticleDeadListBuffer_)
+{
+	device_.DestroyBuffer(gpuParticleDeadListBuffer_);
+	gpuParticleDeadListBuffer_ = {};
+}
+if (gpuParticleSortBuffer_)
+{
+	device_.DestroyBuffer(gpuParticleSortBuffer_);
+	gpuParticleSortBuffer_ = {};
+}
+if (gpuParticleCountersBuffer_)
+{
+	device_.DestroyBuffer(gpuParticleCountersBuffer_);
+	gpuParticleCountersBuffer_ = {};
+}
+if (gpuParticleEmitterBuffer_)
+{
+	device_.DestroyBuffer(gpuParticleEmitterBuffer_);
+	gpuParticleEmitterBuffer_ = {};
+}
+if (gpuParticleSpawnBuffer_)
+{
+	device_.DestroyBuffer(gpuParticleSpawnBuffer_);
+	gpuParticleSpawnBuffer_ = {};
+}
+for (rhi::PipelineHandle* pso : { &psoParticleInit_, &psoParticleEmit_, &psoParticleBeginSimulate_, &psoParticleSimulate_,
+	&psoParticleSortLocal_, &psoParticleSortMerge_, &psoParticleSortStep_ })
+{
+	if (*pso)
+	{
+		device_.DestroyPipeline(*pso);
+		*pso = {};
+	}
+}
+materialTableCapacity_ = 0;
+materialTableUploaded_.clear();
+materialTableScratch_.clear();
+objectIdPickRequests_.clear();
+objectIdReadbacks_.clear();
+gpuParticleEmitters_.clear();
+gpuParticlePoolReset_ = true;
+if (skinnedVertexBuffer_)
+{
+	device_.DestroyBuffer(skinnedVertexBuffer_);
+	skinnedVertexBuffer_ = {};
+}
+if (psoSkinVertices_)
+{
+	device_.DestroyPipeline(psoSkinVertices_);
+	psoSkinVertices_ = {};
+}
+for (rhi::BufferHandle* buffer : { &instanceTransformBuffer_, &instanceTransformUpdateBuffer_, &instanceRefBuffer_, &objectIdBuffer_,
+	&materialTableBuffer_, &instanceMaterialBuffer_ })
+{
+	if (*buffer)
+	{
+		device_.DestroyBuffer(*buffer);
+		*buffer = {};
+	}
+}
+for (rhi::PipelineHandle* pso : { &psoInstanceScatter_, &psoInstanceGather_ })
+{
+	if (*pso)
+	{
+		device_.DestroyPipeline(*pso);
+		*pso = {};
+	}
+}
+instanceTransformResident_.clear();
+instanceTransformValid_.clear();
+drawItemSpheres_.Resize(0);
+cullBvh_.Clear();
+cullBvhProxy_.clear();
+cullBvhSphere_.clear();
 if (lightsBuffer_)
 {
 	device_.DestroyBuffer(lightsBuffer_);
 }
+if (lightClustersBuffer_)
+{
+	device_.DestroyBuffer(lightClustersBuffer_);
+}
+if (lightClustersOffBuffer_)
+{
+	device_.DestroyBuffer(lightClustersOffBuffer_);
+}
 if (shadowDataBuffer_)
 {
 	device_.DestroyBuffer(shadowDataBuffer_);
 }
+ReleaseShadowCacheTexture(dirShadowCache_);
+ReleaseCascadeScheduleAtlas();
+ReleaseShadowCacheTexture(spotShadowCache_);
 
 if (reflectionCubeDescIndex_ != 0)
 {
@@ -57,5 +189,7 @@ DestroyMesh(device_, skyboxMesh_);
 DestroyMesh(device_, particleMesh_);
 debugDrawRenderer_.Shutdown();
 debugTextRenderer_.Shutdown();
+SaveShaderKeyManifest(PipelineCacheDir() / "shader_keys.txt", shaderLibrary_.CreatedKeys());
+device_.SavePipelineCache();
 psoCache_.ClearCache();
 shaderLibrary_.ClearCache();
\ No newline at end of file
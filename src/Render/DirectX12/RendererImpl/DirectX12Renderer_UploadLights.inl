@@ -1,9 +1,12 @@
+			const bool clustered = settings_.enableClusteredLighting;
+			const std::uint32_t maxLights = clustered ? kMaxLights : kMaxUnclusteredLights;
+
 			std::vector<GPULight> gpu;
-			gpu.reserve(std::min<std::size_t>(scene.lights.size(), kMaxLights));
+			gpu.reserve(std::min<std::size_t>(scene.lights.size(), maxLights));
 
 			for (const auto& light : scene.lights)
 			{
-				if (gpu.size() >= kMaxLights)
+				if (gpu.size() >= maxLights)
 				{
 					break;
 				}
@@ -50,4 +53,44 @@
 			}
 
 			device_.UpdateBuffer(lightsBuffer_, std::as_bytes(std::span{ gpu }));
+
+			// Clustered lists for the main camera (t20). Point/spot lights are bounded by their range sphere;
+			// directional lights reach every cluster.
+			if (clustered)
+			{
+				lightClusterBounds_.clear();
+				for (const GPULight& gpuLight : gpu)
+				{
+					LightClusterBounds bounds{};
+					const auto type = static_cast<LightType>(static_cast<std::uint32_t>(gpuLight.p0[3]));
+					if (type == LightType::Point || type == LightType::Spot)
+					{
+						bounds.center = { gpuLight.p0[0], gpuLight.p0[1], gpuLight.p0[2] };
+						bounds.radius = std::max(gpuLight.p2[3], 1e-3f);
+					}
+					lightClusterBounds_.push_back(bounds);
+				}
+
+				const float aspect = (viewport.height > 0)
+					? (static_cast<float>(viewport.width) / static_cast<float>(viewport.height))
+					: 1.0f;
+				LightClusterView view{};
+				view.position = scene.camera.position;
+				view.forward = scene.camera.target - scene.camera.position;
+				view.up = scene.camera.up;
+				view.fovYRad = mathUtils::DegToRad(scene.camera.fovYDeg);
+				view.aspect = aspect;
+				view.nearZ = scene.camera.nearZ;
+				view.farZ = scene.camera.farZ;
+				view.viewportWidth = viewport.width;
+				view.viewportHeight = viewport.height;
+				lightClusters_.Build(view, lightClusterBounds_, jobScheduler_);
+				device_.UpdateBuffer(lightClustersBuffer_, std::as_bytes(lightClusters_.Words()));
+			}
+			else
+			{
+				const auto header = LightClusterBuilder::DisabledHeader();
+				device_.UpdateBuffer(lightClustersBuffer_, std::as_bytes(std::span{ header }));
+			}
+
 			return static_cast<std::uint32_t>(gpu.size());
@@ -0,0 +1,113 @@
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+export module core:dynamic_resolution;
+
+import :rhi;
+
+// Dynamic resolution: picks the fraction of the output size the scene is rendered at from the measured GPU
+// frame time against a budget.
+//
+// The pixel work of a frame is treated as proportional to scale^2, so the scale that would hit the budget is
+// scale * sqrt(budget / gpuTime). The measured time is smoothed, the scale moves in fixed steps (every level
+// maps to one set of transient targets) and waits a few frames after each change, because the timestamps
+// read back lag the submitted frame. A frame far over budget drops the scale right away.
+
+export namespace rendern
+{
+	struct DynamicResolutionParams
+	{
+		float targetGpuMs{ 16.0f };
+		float minScale{ 0.5f };
+		float maxScale{ 1.0f };
+	};
+
+	class DynamicResolutionController
+	{
+	public:
+		static constexpr float kScaleStep = 0.05f;
+		static constexpr float kMinScaleLimit = 0.25f;
+		static constexpr float kSmoothing = 0.2f;      // weight of the newest sample in the moving average
+		static constexpr float kGrowHeadroom = 0.85f;  // grow only below this fraction of the budget
+		static constexpr float kOverrunRatio = 1.3f;   // above this fraction the raw sample drops at once
+		static constexpr std::uint32_t kMaxGrowSteps = 2;
+		static constexpr std::uint32_t kCooldownFrames = 8;
+
+		// Feeds the GPU time of the last finished frame and returns the scale for the next one.
+		// gpuFrameMs <= 0 (no timestamps) keeps the current scale, clamped to the new limits.
+		float Update(float gpuFrameMs, const DynamicResolutionParams& params) noexcept
+		{
+			const float minScale = std::clamp(params.minScale, kMinScaleLimit, 1.0f);
+			const float maxScale = std::clamp(params.maxScale, minScale, 1.0f);
+			scale_ = std::clamp(scale_, minScale, maxScale);
+			if (!(gpuFrameMs > 0.0f) || !(params.targetGpuMs > 0.0f))
+			{
+				return scale_;
+			}
+
+			smoothedMs_ = (smoothedMs_ > 0.0f) ? std::lerp(smoothedMs_, gpuFrameMs, kSmoothing) : gpuFrameMs;
+
+			const bool overrun = gpuFrameMs > params.targetGpuMs * kOverrunRatio;
+			if (cooldown_ > 0u && !overrun)
+			{
+				--cooldown_;
+				return scale_;
+			}
+
+			const float measuredMs = overrun ? gpuFrameMs : smoothedMs_;
+			const float ideal = scale_ * std::sqrt(params.targetGpuMs / measuredMs);
+
+			float next = scale_;
+			if (measuredMs > params.targetGpuMs)
+			{
+				next = std::min(QuantizeDown(ideal), scale_ - kScaleStep);
+			}
+			else if (measuredMs < params.targetGpuMs * kGrowHeadroom)
+			{
+				next = std::min(QuantizeDown(ideal), scale_ + kScaleStep * static_cast<float>(kMaxGrowSteps));
+			}
+			next = std::clamp(next, minScale, maxScale);
+
+			if (std::abs(next - scale_) > kScaleStep * 0.5f)
+			{
+				// The average still holds times of the old size: predict it for the new one.
+				smoothedMs_ *= (next * next) / (scale_ * scale_);
+				scale_ = next;
+				cooldown_ = kCooldownFrames;
+			}
+			return scale_;
+		}
+
+		void Reset(float scale = 1.0f) noexcept
+		{
+			scale_ = std::clamp(scale, kMinScaleLimit, 1.0f);
+			smoothedMs_ = 0.0f;
+			cooldown_ = 0u;
+		}
+
+		float Scale() const noexcept { return scale_; }
+		float SmoothedGpuMs() const noexcept { return smoothedMs_; }
+
+	private:
+		static float QuantizeDown(float scale) noexcept
+		{
+			return std::floor(scale / kScaleStep + 1.0e-3f) * kScaleStep;
+		}
+
+		float scale_{ 1.0f };
+		float smoothedMs_{ 0.0f };
+		std::uint32_t cooldown_{ 0 };
+	};
+
+	// Render size for `scale` of `extent`, at least 1x1.
+	[[nodiscard]] rhi::Extent2D ScaledExtent(rhi::Extent2D extent, float scale) noexcept
+	{
+		const float s = std::clamp(scale, 0.0f, 1.0f);
+		return rhi::Extent2D{
+			std::max(1u, static_cast<std::uint32_t>(static_cast<float>(extent.width) * s + 0.5f)),
+			std::max(1u, static_cast<std::uint32_t>(static_cast<float>(extent.height) * s + 0.5f)) };
+	}
+}
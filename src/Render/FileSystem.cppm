@@ -1,5 +1,27 @@
 module;
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -10,6 +32,8 @@ module;
 
 export module core:file_system;
 
+import :pack_file;
+
 export namespace FILE_UTILS
 {
 	namespace fs = std::filesystem;
@@ -25,8 +49,31 @@ export namespace FILE_UTILS
 		std::vector<std::byte> data;
 	};
 
+	struct FileStat
+	{
+		std::uint64_t bytes{ 0 };
+		fs::file_time_type writeTime{};
+	};
+
+	// A file served from a mounted pack: `bytes` stays valid while `owner` is held (the archive
+	// mapping for stored entries, the decompressed buffer for LZ4 ones).
+	struct PackedFile
+	{
+		std::span<const std::byte> bytes;
+		std::shared_ptr<const void> owner;
+	};
+
+	// Mounted-pack lookups used by every read below; defined after the mount table.
+	std::optional<PackedFile> OpenPackedFile(const fs::path& path);
+	std::optional<FileStat> StatPackedFile(const fs::path& path);
+
 	std::string ReadAllText(const fs::path& path)
 	{
+		if (const std::optional<PackedFile> packed = OpenPackedFile(path))
+		{
+			return std::string(reinterpret_cast<const char*>(packed->bytes.data()), packed->bytes.size());
+		}
+
 		std::ifstream file(path, std::ios::binary | std::ios::in);
 		if (!file)
 		{
@@ -50,6 +97,12 @@ export namespace FILE_UTILS
 	{
 		BinaryFile outputFile;
 
+		if (const std::optional<PackedFile> packed = OpenPackedFile(path))
+		{
+			outputFile.data.assign(packed->bytes.begin(), packed->bytes.end());
+			return outputFile;
+		}
+
 		std::ifstream file(path, std::ios::binary);
 		if (!file)
 		{
@@ -68,6 +121,300 @@ export namespace FILE_UTILS
 
 		return outputFile;
 	}
+
+	// Read-only view of a whole file mapped into the address space. Pages are faulted in on
+	// first touch, so callers that only need part of a large file (or copy it straight into an
+	// upload) skip the read into an intermediate buffer. Empty files map to an empty span.
+	// Files in a mounted pack view the archive mapping (or their decompressed bytes).
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(const fs::path& path)
+		{
+			if (std::optional<PackedFile> packed = OpenPackedFile(path))
+			{
+				data_ = packed->bytes.data();
+				size_ = packed->bytes.size();
+				packed_ = std::move(packed->owner);
+				return;
+			}
+			MapFromDisk_(path);
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile()
+		{
+			Close();
+		}
+
+		// Maps the file on disk even if a mounted pack has an entry for it (the packs themselves).
+		struct DiskOnlyTag {};
+		MappedFile(const fs::path& path, DiskOnlyTag)
+		{
+			MapFromDisk_(path);
+		}
+
+		std::span<const std::byte> Bytes() const noexcept { return { data_, size_ }; }
+		std::size_t Size() const noexcept { return size_; }
+
+	private:
+		void MapFromDisk_(const fs::path& path)
+		{
+#if defined(_WIN32)
+			file_ = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file_ == INVALID_HANDLE_VALUE)
+			{
+				throw std::runtime_error("Failed to open file for mapping: " + path.string());
+			}
+
+			LARGE_INTEGER size{};
+			if (!::GetFileSizeEx(file_, &size))
+			{
+				Close();
+				throw std::runtime_error("Failed to query file size: " + path.string());
+			}
+			size_ = static_cast<std::size_t>(size.QuadPart);
+			if (size_ == 0)
+			{
+				return;
+			}
+
+			mapping_ = ::CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping_ != nullptr)
+			{
+				data_ = static_cast<const std::byte*>(::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+			}
+#else
+			fd_ = ::open(path.c_str(), O_RDONLY);
+			if (fd_ < 0)
+			{
+				throw std::runtime_error("Failed to open file for mapping: " + path.string());
+			}
+
+			struct stat st{};
+			if (::fstat(fd_, &st) != 0)
+			{
+				Close();
+				throw std::runtime_error("Failed to query file size: " + path.string());
+			}
+			size_ = static_cast<std::size_t>(st.st_size);
+			if (size_ == 0)
+			{
+				return;
+			}
+
+			void* view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+			if (view != MAP_FAILED)
+			{
+				data_ = static_cast<const std::byte*>(view);
+			}
+#endif
+			if (data_ == nullptr)
+			{
+				Close();
+				throw std::runtime_error("Failed to map file: " + path.string());
+			}
+		}
+
+		void Close() noexcept
+		{
+			if (packed_)
+			{
+				packed_.reset();
+				data_ = nullptr;
+				return;
+			}
+#if defined(_WIN32)
+			if (data_ != nullptr)
+			{
+				::UnmapViewOfFile(data_);
+			}
+			if (mapping_ != nullptr)
+			{
+				::CloseHandle(mapping_);
+			}
+			if (file_ != INVALID_HANDLE_VALUE)
+			{
+				::CloseHandle(file_);
+			}
+			mapping_ = nullptr;
+			file_ = INVALID_HANDLE_VALUE;
+#else
+			if (data_ != nullptr)
+			{
+				::munmap(const_cast<std::byte*>(data_), size_);
+			}
+			if (fd_ >= 0)
+			{
+				::close(fd_);
+			}
+			fd_ = -1;
+#endif
+			data_ = nullptr;
+		}
+
+		const std::byte* data_{ nullptr };
+		std::size_t size_{ 0 };
+		std::shared_ptr<const void> packed_{};
+#if defined(_WIN32)
+		HANDLE file_{ INVALID_HANDLE_VALUE };
+		HANDLE mapping_{ nullptr };
+#else
+		int fd_{ -1 };
+#endif
+	};
+
+	// Mounted packs, searched newest first so a later (patch) pack overrides earlier ones.
+	// Entries are looked up by their path relative to the pack's mount root.
+	struct PackMount_
+	{
+		fs::path packPath;
+		fs::path root;
+		std::shared_ptr<const corefs::PackArchive> archive;
+	};
+
+	struct PackMountTable_
+	{
+		std::shared_mutex mutex;
+		std::vector<PackMount_> mounts;
+		std::atomic<bool> any{ false };
+	};
+
+	PackMountTable_& PackMounts_()
+	{
+		static PackMountTable_ table;
+		return table;
+	}
+
+	fs::path AbsoluteNormal_(const fs::path& path)
+	{
+		std::error_code ec;
+		const fs::path abs = fs::absolute(path, ec);
+		return (ec ? path : abs).lexically_normal();
+	}
+
+	// Mount order is kept; mounting the same pack again replaces it. Throws if the pack cannot be
+	// mapped or is malformed.
+	void MountPack(const fs::path& packPath, const fs::path& mountRoot)
+	{
+		auto file = std::make_shared<const MappedFile>(packPath, MappedFile::DiskOnlyTag{});
+		const std::span<const std::byte> bytes = file->Bytes();
+		auto archive = std::make_shared<const corefs::PackArchive>(bytes, std::move(file));
+
+		PackMountTable_& table = PackMounts_();
+		const fs::path key = AbsoluteNormal_(packPath);
+		std::unique_lock lock(table.mutex);
+		std::erase_if(table.mounts, [&key](const PackMount_& mount) { return mount.packPath == key; });
+		table.mounts.push_back(PackMount_{ key, AbsoluteNormal_(mountRoot), std::move(archive) });
+		table.any.store(true, std::memory_order_release);
+	}
+
+	// Open views (MappedFile, PackedFile) keep the unmounted archive alive until released.
+	bool UnmountPack(const fs::path& packPath)
+	{
+		PackMountTable_& table = PackMounts_();
+		const fs::path key = AbsoluteNormal_(packPath);
+		std::unique_lock lock(table.mutex);
+		const std::size_t removed = std::erase_if(table.mounts, [&key](const PackMount_& mount) { return mount.packPath == key; });
+		table.any.store(!table.mounts.empty(), std::memory_order_release);
+		return removed != 0;
+	}
+
+	void UnmountAllPacks()
+	{
+		PackMountTable_& table = PackMounts_();
+		std::unique_lock lock(table.mutex);
+		table.mounts.clear();
+		table.any.store(false, std::memory_order_release);
+	}
+
+	// Newest mount holding `path`; without mounted packs this is one atomic load.
+	std::optional<std::pair<std::shared_ptr<const corefs::PackArchive>, const corefs::PackEntry*>> FindPackEntry_(const fs::path& path)
+	{
+		PackMountTable_& table = PackMounts_();
+		if (!table.any.load(std::memory_order_acquire))
+		{
+			return std::nullopt;
+		}
+
+		const fs::path abs = AbsoluteNormal_(path);
+		std::shared_lock lock(table.mutex);
+		for (auto it = table.mounts.rbegin(); it != table.mounts.rend(); ++it)
+		{
+			const fs::path rel = abs.lexically_relative(it->root);
+			if (rel.empty() || *rel.begin() == "..")
+			{
+				continue;
+			}
+			if (const corefs::PackEntry* entry = it->archive->Find(corefs::NormalizePackPath(rel.generic_string())))
+			{
+				return std::make_pair(it->archive, entry);
+			}
+		}
+		return std::nullopt;
+	}
+
+	std::optional<PackedFile> OpenPackedFile(const fs::path& path)
+	{
+		auto found = FindPackEntry_(path);
+		if (!found)
+		{
+			return std::nullopt;
+		}
+
+		auto& [archive, entry] = *found;
+		if (entry->compression == corefs::PackCompression::None)
+		{
+			return PackedFile{ archive->StoredBytes(*entry), std::move(archive) };
+		}
+		auto bytes = std::make_shared<const std::vector<std::byte>>(archive->Extract(*entry));
+		const std::span<const std::byte> view = *bytes;
+		return PackedFile{ view, std::move(bytes) };
+	}
+
+	std::optional<FileStat> StatPackedFile(const fs::path& path)
+	{
+		const auto found = FindPackEntry_(path);
+		if (!found)
+		{
+			return std::nullopt;
+		}
+		const corefs::PackEntry& entry = *found->second;
+		return FileStat{ entry.bytes, fs::file_time_type(fs::file_time_type::duration(entry.writeTime)) };
+	}
+
+	// Regular file on disk or in a mounted pack.
+	bool AssetFileExists(const fs::path& path)
+	{
+		if (FindPackEntry_(path))
+		{
+			return true;
+		}
+		std::error_code ec;
+		return fs::is_regular_file(path, ec);
+	}
+
+	std::optional<FileStat> StatAssetFile(const fs::path& path)
+	{
+		if (std::optional<FileStat> packed = StatPackedFile(path))
+		{
+			return packed;
+		}
+		std::error_code ec;
+		const std::uint64_t bytes = fs::file_size(path, ec);
+		if (ec)
+		{
+			return std::nullopt;
+		}
+		const fs::file_time_type writeTime = fs::last_write_time(path, ec);
+		if (ec)
+		{
+			return std::nullopt;
+		}
+		return FileStat{ bytes, writeTime };
+	}
 }
 
 export namespace corefs
@@ -86,7 +433,7 @@ export namespace corefs
 		for (int i = 0; i < 10; ++i)
 		{
 			fs::path candidate = curretnPath / "assets";
-			if (fs::exists(candidate) && fs::is_directory(candidate))
+			if ((fs::exists(candidate) && fs::is_directory(candidate)) || fs::is_regular_file(curretnPath / "assets.pak"))
 			{
 				cached = candidate;
 				return cached;
@@ -110,4 +457,41 @@ export namespace corefs
 		}
 		return FindAssetRoot() / relative;
 	}
-}
\ No newline at end of file
+
+	// Root of machine-generated artifacts (cooked meshes, ...). Lives under the asset root so it
+	// travels with the content it was built from. Safe to delete in development (meshes re-cook on
+	// load); shipping builds get it from ResourceCooker.
+	fs::path CookedCacheRoot()
+	{
+		return FindAssetRoot() / ".cooked";
+	}
+
+	// Mounts the shipping packs next to the asset root ("assets.pak", then "assets_*.pak" by
+	// name, so patches override the base) at the asset root. Returns the number mounted.
+	std::size_t MountAssetPacks()
+	{
+		const fs::path root = fs::absolute(FindAssetRoot());
+		std::vector<fs::path> packs;
+		std::error_code ec;
+		for (const fs::directory_entry& entry : fs::directory_iterator(root.parent_path(), ec))
+		{
+			const std::string name = entry.path().filename().string();
+			if (entry.is_regular_file() && entry.path().extension() == ".pak" && (name == "assets.pak" || name.starts_with("assets_")))
+			{
+				packs.push_back(entry.path());
+			}
+		}
+		std::sort(packs.begin(), packs.end(), [](const fs::path& a, const fs::path& b)
+			{
+				const bool baseA = a.filename() == "assets.pak";
+				const bool baseB = b.filename() == "assets.pak";
+				return baseA != baseB ? baseA : a.filename() < b.filename();
+			});
+
+		for (const fs::path& pack : packs)
+		{
+			MountPack(pack, root);
+		}
+		return packs.size();
+	}
+}
@@ -1,6 +1,16 @@
 module;
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 export module core:render_gpu_memory;
 
@@ -51,4 +61,609 @@ export namespace renderer
 	private:
 		rhi::IRHIDevice& device_;
 	};
-}
\ No newline at end of file
+
+	// Two-level segregated fit (TLSF) allocator over the byte range [0, capacity).
+	// Sizes are rounded up to `granularity`, so every offset it hands out is a multiple of it.
+	// Free ranges sit in 32 x 16 size-class lists (power-of-two first level, 16 linear steps each);
+	// Allocate and Free are O(1), and freed ranges merge with free physical neighbours immediately.
+	class TlsfRangeAllocator
+	{
+	public:
+		static constexpr std::uint64_t kInvalidOffset = ~0ull;
+
+		explicit TlsfRangeAllocator(std::uint64_t capacityBytes, std::uint32_t granularityBytes = 256)
+			: granularity_(std::max<std::uint32_t>(granularityBytes, 1u))
+			, capacityUnits_(static_cast<std::uint32_t>(std::min<std::uint64_t>(capacityBytes / granularity_, kMaxUnits)))
+		{
+			for (auto& row : heads_)
+			{
+				std::fill(std::begin(row), std::end(row), kNone);
+			}
+			if (capacityUnits_ != 0)
+			{
+				const std::uint32_t node = NewNode(Block{ .offset = 0, .size = capacityUnits_ });
+				InsertFree(node);
+			}
+		}
+
+		std::uint64_t CapacityBytes() const noexcept { return std::uint64_t(capacityUnits_) * granularity_; }
+		std::uint64_t UsedBytes() const noexcept { return std::uint64_t(usedUnits_) * granularity_; }
+		std::uint64_t FreeBytes() const noexcept { return CapacityBytes() - UsedBytes(); }
+		std::uint32_t AllocationCount() const noexcept { return static_cast<std::uint32_t>(live_.size()); }
+		std::uint32_t Granularity() const noexcept { return granularity_; }
+
+		// Returns kInvalidOffset when no free range is large enough.
+		std::uint64_t Allocate(std::uint64_t sizeBytes)
+		{
+			const std::uint64_t units64 = std::max<std::uint64_t>((sizeBytes + granularity_ - 1) / granularity_, 1);
+			if (units64 > capacityUnits_)
+			{
+				return kInvalidOffset;
+			}
+			const std::uint32_t units = static_cast<std::uint32_t>(units64);
+
+			const std::uint32_t node = FindFree(units);
+			if (node == kNone)
+			{
+				return kInvalidOffset;
+			}
+			RemoveFree(node);
+
+			if (blocks_[node].size > units)
+			{
+				const std::uint32_t rest = NewNode(Block{
+					.offset = blocks_[node].offset + units,
+					.size = blocks_[node].size - units,
+					.prevPhys = node,
+					.nextPhys = blocks_[node].nextPhys });
+				if (blocks_[rest].nextPhys != kNone)
+				{
+					blocks_[blocks_[rest].nextPhys].prevPhys = rest;
+				}
+				blocks_[node].nextPhys = rest;
+				blocks_[node].size = units;
+				InsertFree(rest);
+			}
+
+			blocks_[node].free = false;
+			usedUnits_ += units;
+			live_.emplace(blocks_[node].offset, node);
+			return std::uint64_t(blocks_[node].offset) * granularity_;
+		}
+
+		// Returns false for offsets that are not live allocations.
+		bool Free(std::uint64_t offsetBytes)
+		{
+			const auto it = live_.find(static_cast<std::uint32_t>(offsetBytes / granularity_));
+			if (offsetBytes % granularity_ != 0 || it == live_.end())
+			{
+				return false;
+			}
+			std::uint32_t node = it->second;
+			live_.erase(it);
+			usedUnits_ -= blocks_[node].size;
+			blocks_[node].free = true;
+
+			const std::uint32_t next = blocks_[node].nextPhys;
+			if (next != kNone && blocks_[next].free)
+			{
+				RemoveFree(next);
+				Absorb(node, next);
+			}
+			const std::uint32_t prev = blocks_[node].prevPhys;
+			if (prev != kNone && blocks_[prev].free)
+			{
+				RemoveFree(prev);
+				Absorb(prev, node);
+				node = prev;
+			}
+			InsertFree(node);
+			return true;
+		}
+
+		std::uint64_t LargestFreeBytes() const noexcept
+		{
+			if (flBitmap_ == 0)
+			{
+				return 0;
+			}
+			// Every range in the highest non-empty class is at least as large as any range below it.
+			const std::uint32_t fl = 31u - static_cast<std::uint32_t>(std::countl_zero(flBitmap_));
+			const std::uint32_t sl = 31u - static_cast<std::uint32_t>(std::countl_zero(slBitmap_[fl]));
+			std::uint32_t largest = 0;
+			for (std::uint32_t node = heads_[fl][sl]; node != kNone; node = blocks_[node].nextFree)
+			{
+				largest = std::max(largest, blocks_[node].size);
+			}
+			return std::uint64_t(largest) * granularity_;
+		}
+
+		// fn(offsetBytes, sizeBytes) for every live allocation, in offset order.
+		template <typename Fn>
+		void ForEachAllocation(Fn&& fn) const
+		{
+			std::vector<std::uint32_t> nodes;
+			nodes.reserve(live_.size());
+			for (const auto& [offset, node] : live_)
+			{
+				nodes.push_back(node);
+			}
+			std::sort(nodes.begin(), nodes.end(), [this](std::uint32_t a, std::uint32_t b) { return blocks_[a].offset < blocks_[b].offset; });
+			for (const std::uint32_t node : nodes)
+			{
+				fn(std::uint64_t(blocks_[node].offset) * granularity_, std::uint64_t(blocks_[node].size) * granularity_);
+			}
+		}
+
+	private:
+		static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+		static constexpr std::uint32_t kSlBits = 4;
+		static constexpr std::uint32_t kSlCount = 1u << kSlBits;
+		static constexpr std::uint32_t kFlCount = 32;
+		static constexpr std::uint64_t kMaxUnits = 1ull << 31;
+
+		// Offsets and sizes are in granularity units.
+		struct Block
+		{
+			std::uint32_t offset{ 0 };
+			std::uint32_t size{ 0 };
+			std::uint32_t prevPhys{ kNone };
+			std::uint32_t nextPhys{ kNone };
+			std::uint32_t prevFree{ kNone };
+			std::uint32_t nextFree{ kNone };
+			bool free{ true };
+		};
+
+		static void MapInsert(std::uint32_t units, std::uint32_t& fl, std::uint32_t& sl) noexcept
+		{
+			if (units < kSlCount)
+			{
+				fl = 0;
+				sl = units;
+				return;
+			}
+			const std::uint32_t msb = static_cast<std::uint32_t>(std::bit_width(units)) - 1u;
+			fl = msb - kSlBits + 1u;
+			sl = (units >> (msb - kSlBits)) ^ kSlCount;
+		}
+
+		// Rounds up to the next class boundary so any range in the found class fits.
+		static void MapSearch(std::uint32_t units, std::uint32_t& fl, std::uint32_t& sl) noexcept
+		{
+			if (units >= kSlCount)
+			{
+				const std::uint32_t msb = static_cast<std::uint32_t>(std::bit_width(units)) - 1u;
+				units += (1u << (msb - kSlBits)) - 1u;
+			}
+			MapInsert(units, fl, sl);
+		}
+
+		std::uint32_t FindFree(std::uint32_t units) const noexcept
+		{
+			std::uint32_t fl = 0;
+			std::uint32_t sl = 0;
+			MapSearch(units, fl, sl);
+			if (fl >= kFlCount)
+			{
+				return kNone;
+			}
+
+			std::uint32_t slMap = sl < kSlCount ? (slBitmap_[fl] & (~0u << sl)) : 0u;
+			if (slMap == 0)
+			{
+				const std::uint32_t flMap = fl + 1 < kFlCount ? (flBitmap_ & (~0u << (fl + 1))) : 0u;
+				if (flMap == 0)
+				{
+					return kNone;
+				}
+				fl = static_cast<std::uint32_t>(std::countr_zero(flMap));
+				slMap = slBitmap_[fl];
+			}
+			sl = static_cast<std::uint32_t>(std::countr_zero(slMap));
+			return heads_[fl][sl];
+		}
+
+		void InsertFree(std::uint32_t node) noexcept
+		{
+			std::uint32_t fl = 0;
+			std::uint32_t sl = 0;
+			MapInsert(blocks_[node].size, fl, sl);
+			Block& block = blocks_[node];
+			block.free = true;
+			block.prevFree = kNone;
+			block.nextFree = heads_[fl][sl];
+			if (block.nextFree != kNone)
+			{
+				blocks_[block.nextFree].prevFree = node;
+			}
+			heads_[fl][sl] = node;
+			flBitmap_ |= 1u << fl;
+			slBitmap_[fl] |= 1u << sl;
+		}
+
+		void RemoveFree(std::uint32_t node) noexcept
+		{
+			std::uint32_t fl = 0;
+			std::uint32_t sl = 0;
+			MapInsert(blocks_[node].size, fl, sl);
+			const Block& block = blocks_[node];
+			if (block.prevFree != kNone)
+			{
+				blocks_[block.prevFree].nextFree = block.nextFree;
+			}
+			else
+			{
+				heads_[fl][sl] = block.nextFree;
+			}
+			if (block.nextFree != kNone)
+			{
+				blocks_[block.nextFree].prevFree = block.prevFree;
+			}
+			if (heads_[fl][sl] == kNone)
+			{
+				slBitmap_[fl] &= ~(1u << sl);
+				if (slBitmap_[fl] == 0)
+				{
+					flBitmap_ &= ~(1u << fl);
+				}
+			}
+		}
+
+		// `second` must directly follow `first`; both are out of the free lists.
+		void Absorb(std::uint32_t first, std::uint32_t second) noexcept
+		{
+			blocks_[first].size += blocks_[second].size;
+			blocks_[first].nextPhys = blocks_[second].nextPhys;
+			if (blocks_[first].nextPhys != kNone)
+			{
+				blocks_[blocks_[first].nextPhys].prevPhys = first;
+			}
+			freeNodes_.push_back(second);
+		}
+
+		std::uint32_t NewNode(const Block& block)
+		{
+			if (!freeNodes_.empty())
+			{
+				const std::uint32_t node = freeNodes_.back();
+				freeNodes_.pop_back();
+				blocks_[node] = block;
+				return node;
+			}
+			blocks_.push_back(block);
+			return static_cast<std::uint32_t>(blocks_.size() - 1);
+		}
+
+		std::uint32_t granularity_{ 256 };
+		std::uint32_t capacityUnits_{ 0 };
+		std::uint32_t usedUnits_{ 0 };
+		std::uint32_t flBitmap_{ 0 };
+		std::uint32_t slBitmap_[kFlCount]{};
+		std::uint32_t heads_[kFlCount][kSlCount]{};
+		std::vector<Block> blocks_;
+		std::vector<std::uint32_t> freeNodes_;
+		std::unordered_map<std::uint32_t, std::uint32_t> live_; // offset (units) -> node
+	};
+
+	// Sub-allocates static vertex and index buffers out of large pooled buffers, one pool per
+	// (bind flag, usage) pair. The RHI has no placed resources, so a pool block is one big committed
+	// buffer and an allocation is a TLSF range inside it: callers bind `buffer` at `offsetBytes`.
+	// Requests above `dedicatedThresholdBytes`, and buffers that need a view of their own (structured,
+	// storage, constant, Stream), still get a dedicated buffer.
+	//
+	// Freed ranges are queued until GetFramesInFlight() EndFrame() calls have passed, so frames the GPU
+	// may still be drawing never see their bytes reused. Empty blocks are released in EndFrame, except
+	// the last block of each pool.
+	//
+	// Not thread-safe: use it from the device-owner thread, like the device itself.
+	class PooledGPUMemoryAllocator final : public IGPUMemoryAllocator
+	{
+	public:
+		struct Settings
+		{
+			std::uint64_t blockSizeBytes{ 64ull << 20 };
+			std::uint64_t dedicatedThresholdBytes{ 16ull << 20 };
+			std::uint32_t granularityBytes{ 256 };
+		};
+
+		struct Stats
+		{
+			std::uint32_t blocks{ 0 };
+			std::uint64_t blockBytes{ 0 };      // reserved in pool blocks
+			std::uint64_t usedBytes{ 0 };       // live pooled ranges (pending frees included)
+			std::uint32_t allocations{ 0 };
+			std::uint32_t dedicatedBuffers{ 0 };
+			std::uint64_t dedicatedBytes{ 0 };
+			std::uint32_t pendingFrees{ 0 };    // freed, waiting for the GPU
+			float fragmentation{ 0.0f };        // 1 - largest free range / free bytes (0 = contiguous)
+		};
+
+		// One live range to relocate: the caller uploads the contents into `to`, repoints its references,
+		// then hands the moves back to EndDefragmentation (or FreeBuffer(to) to abandon one).
+		struct DefragmentationMove
+		{
+			BufferAllocation from{};
+			BufferAllocation to{};
+		};
+
+		explicit PooledGPUMemoryAllocator(rhi::IRHIDevice& device)
+			: PooledGPUMemoryAllocator(device, Settings{})
+		{
+		}
+
+		PooledGPUMemoryAllocator(rhi::IRHIDevice& device, Settings settings)
+			: device_(device)
+			, settings_(settings)
+		{
+			settings_.granularityBytes = std::max<std::uint32_t>(settings_.granularityBytes, 4u);
+			settings_.blockSizeBytes = std::max<std::uint64_t>(settings_.blockSizeBytes, settings_.granularityBytes);
+			settings_.dedicatedThresholdBytes = std::min(settings_.dedicatedThresholdBytes, settings_.blockSizeBytes);
+		}
+
+		~PooledGPUMemoryAllocator() override
+		{
+			for (const std::unique_ptr<Block>& block : blocks_)
+			{
+				device_.DestroyBuffer(block->buffer);
+			}
+		}
+
+		PooledGPUMemoryAllocator(const PooledGPUMemoryAllocator&) = delete;
+		PooledGPUMemoryAllocator& operator=(const PooledGPUMemoryAllocator&) = delete;
+
+		BufferAllocation AllocateBuffer(const rhi::BufferDesc& desc) override
+		{
+			if (!IsPoolable(desc) || desc.sizeInBytes > settings_.dedicatedThresholdBytes)
+			{
+				const rhi::BufferHandle buffer = device_.CreateBuffer(desc);
+				dedicated_[buffer.id] = desc.sizeInBytes;
+				return BufferAllocation{ .buffer = buffer, .offsetBytes = 0, .sizeInBytes = desc.sizeInBytes };
+			}
+
+			const PoolKey key = KeyOf(desc);
+			for (const std::unique_ptr<Block>& block : blocks_)
+			{
+				if (block->key == key)
+				{
+					if (const auto allocation = TryAllocate(*block, desc.sizeInBytes))
+					{
+						return *allocation;
+					}
+				}
+			}
+
+			Block& block = CreateBlock(desc);
+			const auto allocation = TryAllocate(block, desc.sizeInBytes);
+			return *allocation;
+		}
+
+		// Pooled ranges are identified by (buffer, offsetBytes).
+		void FreeBuffer(const BufferAllocation& allocation) noexcept override
+		{
+			if (!allocation.buffer)
+			{
+				return;
+			}
+			if (!blockByBuffer_.contains(allocation.buffer.id))
+			{
+				dedicated_.erase(allocation.buffer.id);
+				device_.DestroyBuffer(allocation.buffer);
+				return;
+			}
+			pending_.push_back(PendingFree{ frame_ + device_.GetFramesInFlight(), allocation.buffer, allocation.offsetBytes });
+		}
+
+		// Call once per rendered frame, after it has been submitted.
+		void EndFrame()
+		{
+			++frame_;
+			bool freedAny = false;
+			while (!pending_.empty() && pending_.front().retireAfter <= frame_)
+			{
+				const PendingFree free = pending_.front();
+				pending_.pop_front();
+				if (const auto it = blockByBuffer_.find(free.buffer.id); it != blockByBuffer_.end())
+				{
+					it->second->ranges.Free(free.offsetBytes);
+					freedAny = true;
+				}
+			}
+			if (freedAny)
+			{
+				ReleaseEmptyBlocks();
+			}
+		}
+
+		// Plans moves that empty the least-used block of a pool with more than one block, up to
+		// `maxBytes` of data. The destination ranges are allocated already.
+		std::vector<DefragmentationMove> BeginDefragmentation(std::uint64_t maxBytes)
+		{
+			std::vector<DefragmentationMove> moves;
+
+			Block* source = nullptr;
+			for (const std::unique_ptr<Block>& block : blocks_)
+			{
+				if (block->ranges.AllocationCount() == 0 || CountBlocks(block->key) < 2)
+				{
+					continue;
+				}
+				if (!source || block->ranges.UsedBytes() < source->ranges.UsedBytes())
+				{
+					source = block.get();
+				}
+			}
+			if (!source)
+			{
+				return moves;
+			}
+
+			std::uint64_t movedBytes = 0;
+			bool full = false;
+			source->ranges.ForEachAllocation([&](std::uint64_t offset, std::uint64_t size)
+				{
+					if (full || movedBytes + size > maxBytes || IsPendingFree(source->buffer, offset))
+					{
+						return;
+					}
+					for (const std::unique_ptr<Block>& block : blocks_)
+					{
+						if (block.get() == source || block->key != source->key)
+						{
+							continue;
+						}
+						if (const auto to = TryAllocate(*block, size))
+						{
+							moves.push_back(DefragmentationMove{
+								.from = BufferAllocation{ .buffer = source->buffer, .offsetBytes = offset, .sizeInBytes = size },
+								.to = *to });
+							movedBytes += size;
+							return;
+						}
+					}
+					full = true;
+				});
+			return moves;
+		}
+
+		// Retires the source ranges of moves the caller has completed.
+		void EndDefragmentation(std::span<const DefragmentationMove> moves) noexcept
+		{
+			for (const DefragmentationMove& move : moves)
+			{
+				FreeBuffer(move.from);
+			}
+		}
+
+		Stats GetStats() const
+		{
+			Stats stats{};
+			stats.blocks = static_cast<std::uint32_t>(blocks_.size());
+			stats.dedicatedBuffers = static_cast<std::uint32_t>(dedicated_.size());
+			stats.pendingFrees = static_cast<std::uint32_t>(pending_.size());
+			for (const auto& [id, size] : dedicated_)
+			{
+				stats.dedicatedBytes += size;
+			}
+
+			std::uint64_t freeBytes = 0;
+			std::uint64_t largestFree = 0;
+			for (const std::unique_ptr<Block>& block : blocks_)
+			{
+				stats.blockBytes += block->ranges.CapacityBytes();
+				stats.usedBytes += block->ranges.UsedBytes();
+				stats.allocations += block->ranges.AllocationCount();
+				freeBytes += block->ranges.FreeBytes();
+				largestFree = std::max(largestFree, block->ranges.LargestFreeBytes());
+			}
+			if (freeBytes > 0)
+			{
+				stats.fragmentation = 1.0f - static_cast<float>(largestFree) / static_cast<float>(freeBytes);
+			}
+			return stats;
+		}
+
+	private:
+		struct PoolKey
+		{
+			rhi::BufferBindFlag bindFlag{};
+			rhi::BufferUsageFlag usageFlag{};
+
+			bool operator==(const PoolKey&) const = default;
+		};
+
+		struct Block
+		{
+			PoolKey key{};
+			rhi::BufferHandle buffer{};
+			TlsfRangeAllocator ranges;
+		};
+
+		struct PendingFree
+		{
+			std::uint64_t retireAfter{ 0 };
+			rhi::BufferHandle buffer{};
+			std::size_t offsetBytes{ 0 };
+		};
+
+		static PoolKey KeyOf(const rhi::BufferDesc& desc) noexcept
+		{
+			return PoolKey{ desc.bindFlag, desc.usageFlag };
+		}
+
+		static bool IsPoolable(const rhi::BufferDesc& desc) noexcept
+		{
+			return (desc.bindFlag == rhi::BufferBindFlag::VertexBuffer || desc.bindFlag == rhi::BufferBindFlag::IndexBuffer) &&
+				desc.usageFlag != rhi::BufferUsageFlag::Stream &&
+				desc.structuredStrideBytes == 0;
+		}
+
+		std::optional<BufferAllocation> TryAllocate(Block& block, std::uint64_t sizeBytes)
+		{
+			const std::uint64_t offset = block.ranges.Allocate(sizeBytes);
+			if (offset == TlsfRangeAllocator::kInvalidOffset)
+			{
+				return std::nullopt;
+			}
+			return BufferAllocation{
+				.buffer = block.buffer,
+				.offsetBytes = static_cast<std::size_t>(offset),
+				.sizeInBytes = static_cast<std::size_t>(sizeBytes) };
+		}
+
+		Block& CreateBlock(const rhi::BufferDesc& desc)
+		{
+			rhi::BufferDesc blockDesc{};
+			blockDesc.bindFlag = desc.bindFlag;
+			blockDesc.usageFlag = desc.usageFlag;
+			blockDesc.sizeInBytes = static_cast<std::size_t>(settings_.blockSizeBytes);
+			blockDesc.debugName = std::string(desc.bindFlag == rhi::BufferBindFlag::IndexBuffer ? "GpuPool_IB_" : "GpuPool_VB_") +
+				std::to_string(nextBlockId_++);
+
+			auto block = std::make_unique<Block>(Block{
+				.key = KeyOf(desc),
+				.buffer = device_.CreateBuffer(blockDesc),
+				.ranges = TlsfRangeAllocator(settings_.blockSizeBytes, settings_.granularityBytes) });
+			Block& out = *block;
+			blockByBuffer_[out.buffer.id] = &out;
+			blocks_.push_back(std::move(block));
+			return out;
+		}
+
+		std::uint32_t CountBlocks(const PoolKey& key) const noexcept
+		{
+			return static_cast<std::uint32_t>(std::count_if(blocks_.begin(), blocks_.end(),
+				[&](const std::unique_ptr<Block>& block) { return block->key == key; }));
+		}
+
+		bool IsPendingFree(rhi::BufferHandle buffer, std::uint64_t offset) const noexcept
+		{
+			return std::any_of(pending_.begin(), pending_.end(),
+				[&](const PendingFree& free) { return free.buffer == buffer && free.offsetBytes == offset; });
+		}
+
+		void ReleaseEmptyBlocks()
+		{
+			for (std::size_t i = 0; i < blocks_.size();)
+			{
+				Block& block = *blocks_[i];
+				if (block.ranges.AllocationCount() != 0 || CountBlocks(block.key) < 2)
+				{
+					++i;
+					continue;
+				}
+				blockByBuffer_.erase(block.buffer.id);
+				device_.DestroyBuffer(block.buffer);
+				blocks_.erase(blocks_.begin() + static_cast<std::ptrdiff_t>(i));
+			}
+		}
+
+		rhi::IRHIDevice& device_;
+		Settings settings_{};
+		std::vector<std::unique_ptr<Block>> blocks_;
+		std::unordered_map<std::uint32_t, Block*> blockByBuffer_;
+		std::unordered_map<std::uint32_t, std::size_t> dedicated_; // buffer id -> size
+		std::deque<PendingFree> pending_;
+		std::uint64_t frame_{ 0 };
+		std::uint32_t nextBlockId_{ 0 };
+	};
+}
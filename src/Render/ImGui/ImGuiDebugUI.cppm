@@ -7,6 +7,13 @@ module;
 #include <algorithm>
 #include <cmath>
 #include <utility>
+#include <chrono>
+#include <future>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <deque>
+#include <iterator>
 
 #if defined(CORE_USE_DX12)
 #include <imgui.h>
@@ -24,10 +31,13 @@ import :camera_controller;
 import :math_utils;
 import :level;
 import :asset_manager;
+import :job_system;
 import :assimp_scene_loader;
 import :animator;
 import :animation_clip;
 import :animation_controller;
+import :profiler;
+import :memory_tracking;
 
 export namespace rendern::ui
 {
@@ -35,13 +45,14 @@ export namespace rendern::ui
     // before drawing individual panels/windows.
     void BeginDebugDockSpace();
 
-    void DrawRendererDebugUI(rendern::RendererSettings& rs, rendern::Scene& scene, rendern::CameraController& camCtl);
+    // `frameStats`: the renderer's counters of the last frame (Renderer::GetFrameStats), shown read-only.
+    void DrawRendererDebugUI(rendern::RendererSettings& rs, const rendern::RendererFrameStats& frameStats, rendern::Scene& scene, rendern::CameraController& camCtl);
 
     // Minimal Level Editor:
     // - add/remove objects (recursive delete)
     // - choose mesh/material
     // - edit transform (position/rotation/scale)
-    void DrawLevelEditorUI(rendern::LevelAsset& level, rendern::LevelInstance& levelInst, AssetManager& assets, rendern::Scene& scene, rendern::CameraController& camCtl);
+    void DrawLevelEditorUI(rendern::LevelAsset& level, rendern::LevelInstance& levelInst, AssetManager& assets, jobs::Scheduler& jobScheduler, rendern::Scene& scene, rendern::CameraController& camCtl);
 }
 
 // Implementation is split into .inl files for readability.
@@ -53,6 +64,7 @@ export namespace rendern::ui
 #include "ImGuiDebugUI_RendererCore.inl"
 #include "ImGuiDebugUI_Reflections.inl"
 #include "ImGuiDebugUI_Light.inl"
+#include "ImGuiDebugUI_Profiler.inl"
 #include "ImGuiDebugUI_RendererFacade.inl"
 #include "ImGuiDebugUI_Level.inl"
 
@@ -121,6 +133,7 @@ namespace rendern::ui
             ImGui::DockBuilderDockWindow("Renderer / Shadows", dockRightTop);
             ImGui::DockBuilderDockWindow("Reflections", dockRightBottomLeft);
             ImGui::DockBuilderDockWindow("Lights", dockRightBottomRight);
+            ImGui::DockBuilderDockWindow("Profiler", dockRightBottomRight);
 
             ImGui::DockBuilderFinish(dockId);
         }
@@ -139,6 +152,7 @@ namespace rendern::ui
 
     void DrawRendererDebugUI(
         rendern::RendererSettings& rs [[maybe_unused]],
+        const rendern::RendererFrameStats& frameStats [[maybe_unused]],
         rendern::Scene& scene [[maybe_unused]],
         rendern::CameraController& camCtl [[maybe_unused]])
     {
@@ -148,6 +162,7 @@ namespace rendern::ui
         rendern::LevelAsset& level [[maybe_unused]],
         rendern::LevelInstance& levelInst [[maybe_unused]],
         AssetManager& assets [[maybe_unused]],
+        jobs::Scheduler& jobScheduler [[maybe_unused]],
         rendern::Scene& scene [[maybe_unused]],
         rendern::CameraController& camCtl [[maybe_unused]])
     {
@@ -9,6 +9,7 @@ namespace rendern::ui
         rendern::LevelAsset& level,
         rendern::LevelInstance& levelInst,
         AssetManager& assets,
+        jobs::Scheduler& jobScheduler,
         rendern::Scene& scene,
         rendern::CameraController& camCtl)
     {
@@ -47,12 +48,11 @@ namespace rendern::ui
         }
 
         level_ui_detail::SyncSavePathWithSource(level, st);
-        level_ui_detail::DrawFilePanel(level, scene, st);
+        level_ui_detail::DrawFilePanel(level, scene, jobScheduler, st);
 
-        level_ui_detail::DerivedLists derived{};
-        level_ui_detail::BuildDerivedLists(level, derived);
+        const level_ui_detail::DerivedLists& derived = level_ui_detail::UpdateHierarchyCache(level, st.hierarchy);
 
-        level_ui_detail::DrawHierarchyPanel(level, derived, scene, st);
+        level_ui_detail::DrawHierarchyPanel(level, scene, st);
         ImGui::SameLine();
         level_ui_detail::DrawInspectorPanel(level, levelInst, assets, scene, camCtl, derived, st);
 
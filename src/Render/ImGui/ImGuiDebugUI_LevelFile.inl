@@ -1,20 +1,40 @@
 namespace rendern::ui::level_ui_detail
 {
+    // The asset is copied into a Background job, so a large level no longer stalls the editor frame.
     static void SaveLevelToPath(
         rendern::LevelAsset& level,
         rendern::Scene& scene,
+        jobs::Scheduler& jobScheduler,
         LevelEditorUIState& st,
         const std::string& path)
     {
-        try
+        if (st.pendingSave.valid())
         {
-            level.camera = scene.camera;
-            level.lights = scene.lights;
+            std::snprintf(st.saveStatusBuf, sizeof(st.saveStatusBuf), "Still saving: %s", st.pendingSavePath.c_str());
+            st.saveStatusIsError = false;
+            return;
+        }
+
+        level.camera = scene.camera;
+        level.lights = scene.lights;
+
+        st.pendingSave = rendern::SaveLevelAssetToJsonAsync(jobScheduler, path, level);
+        st.pendingSavePath = path;
+        std::snprintf(st.saveStatusBuf, sizeof(st.saveStatusBuf), "Saving: %s", path.c_str());
+        st.saveStatusIsError = false;
+    }
 
-            rendern::SaveLevelAssetToJson(path, level);
-            level.sourcePath = path;
-            st.cachedSourcePath = path;
-            std::snprintf(st.saveStatusBuf, sizeof(st.saveStatusBuf), "Saved: %s", path.c_str());
+    static void PollPendingSave(rendern::LevelAsset& level, LevelEditorUIState& st)
+    {
+        if (!st.pendingSave.valid() || st.pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        try
+        {
+            st.pendingSave.get();
+            level.sourcePath = st.pendingSavePath;
+            st.cachedSourcePath = st.pendingSavePath;
+            std::snprintf(st.saveStatusBuf, sizeof(st.saveStatusBuf), "Saved: %s", st.pendingSavePath.c_str());
             st.saveStatusIsError = false;
         }
         catch (const std::exception& e)
@@ -22,13 +42,18 @@ namespace rendern::ui::level_ui_detail
             std::snprintf(st.saveStatusBuf, sizeof(st.saveStatusBuf), "Save failed: %s", e.what());
             st.saveStatusIsError = true;
         }
+        st.pendingSave = {};
+        st.pendingSavePath.clear();
     }
 
     static void DrawFilePanel(
         rendern::LevelAsset& level,
         rendern::Scene& scene,
+        jobs::Scheduler& jobScheduler,
         LevelEditorUIState& st)
     {
+        PollPendingSave(level, st);
+
         if (!ImGui::CollapsingHeader("File", ImGuiTreeNodeFlags_DefaultOpen))
             return;
 
@@ -47,7 +72,7 @@ namespace rendern::ui::level_ui_detail
             const std::string usePath = !level.sourcePath.empty() ? level.sourcePath : pathStr;
             if (!usePath.empty())
             {
-                SaveLevelToPath(level, scene, st, usePath);
+                SaveLevelToPath(level, scene, jobScheduler, st, usePath);
             }
             else
             {
@@ -59,7 +84,7 @@ namespace rendern::ui::level_ui_detail
         {
             if (!pathStr.empty())
             {
-                SaveLevelToPath(level, scene, st, pathStr);
+                SaveLevelToPath(level, scene, jobScheduler, st, pathStr);
             }
             else
             {
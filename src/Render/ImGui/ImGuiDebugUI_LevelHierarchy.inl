@@ -13,21 +13,34 @@ namespace rendern::ui::level_ui_detail
 
     static void DrawHierarchyPanel(
         rendern::LevelAsset& level,
-        const DerivedLists& derived,
         rendern::Scene& scene,
         LevelEditorUIState& st)
     {
         ImGui::BeginChild("##Hierarchy", ImVec2(280.0f, 0.0f), true);
 
-        auto drawNode = [&](auto&& self, int idx) -> void
+        HierarchyCache& cache = st.hierarchy;
+        if (cache.rowsDirty)
+        {
+            RebuildHierarchyRows(cache);
+        }
+
+        const float indentStep = ImGui::GetStyle().IndentSpacing;
+        ImGuiListClipper nodeClipper;
+        nodeClipper.Begin(static_cast<int>(cache.rows.size()));
+        while (nodeClipper.Step())
+        {
+            for (int rowIndex = nodeClipper.DisplayStart; rowIndex < nodeClipper.DisplayEnd; ++rowIndex)
             {
+                const HierarchyRow& row = cache.rows[static_cast<std::size_t>(rowIndex)];
+                const int idx = row.node;
                 const auto& n = level.nodes[static_cast<std::size_t>(idx)];
 
                 ImGuiTreeNodeFlags flags =
                     ImGuiTreeNodeFlags_OpenOnArrow |
-                    ImGuiTreeNodeFlags_SpanFullWidth;
+                    ImGuiTreeNodeFlags_SpanFullWidth |
+                    ImGuiTreeNodeFlags_NoTreePushOnOpen;
 
-                if (derived.children[static_cast<std::size_t>(idx)].empty())
+                if (!row.hasChildren)
                     flags |= ImGuiTreeNodeFlags_Leaf;
 
                 if (scene.EditorIsNodeSelected(idx))
@@ -40,8 +53,17 @@ namespace rendern::ui::level_ui_detail
                 else
                     std::snprintf(label, sizeof(label), "%d: %s", idx, name);
 
+                const float indent = indentStep * static_cast<float>(row.depth);
+                if (indent > 0.0f)
+                    ImGui::Indent(indent);
+
+                std::uint8_t& expanded = cache.expanded[static_cast<std::size_t>(idx)];
+                ImGui::SetNextItemOpen(expanded != 0u);
                 const bool open = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<std::intptr_t>(idx)), flags, "%s", label);
 
+                if (indent > 0.0f)
+                    ImGui::Unindent(indent);
+
                 if (ImGui::IsItemClicked(ImGuiMouseButton_Left))
                 {
                     const bool ctrlDown = ImGui::GetIO().KeyCtrl;
@@ -57,68 +79,76 @@ namespace rendern::ui::level_ui_detail
                     st.selectedParticleEmitter = -1;
                 }
 
-                if (open)
+                // The rows are rebuilt next frame; this frame keeps iterating the current ones.
+                if (row.hasChildren && open != (expanded != 0u))
                 {
-                    for (int ch : derived.children[static_cast<std::size_t>(idx)])
-                        self(self, ch);
-                    ImGui::TreePop();
+                    expanded = open ? 1u : 0u;
+                    cache.rowsDirty = true;
                 }
-            };
-
-        for (int r : derived.roots)
-            drawNode(drawNode, r);
+            }
+        }
 
         ImGui::SeparatorText("Particle Emitters");
-        for (std::size_t i = 0; i < level.particleEmitters.size(); ++i)
+        ImGuiListClipper emitterClipper;
+        emitterClipper.Begin(static_cast<int>(level.particleEmitters.size()));
+        while (emitterClipper.Step())
         {
-            const rendern::ParticleEmitter& emitter = level.particleEmitters[i];
-            char label[256]{};
-            const char* name = emitter.name.empty() ? "<unnamed emitter>" : emitter.name.c_str();
-            std::snprintf(label, sizeof(label), "%d: %s%s", static_cast<int>(i), name, emitter.enabled ? "" : "  [disabled]");
-
-            if (ImGui::Selectable(label, scene.EditorIsParticleEmitterSelected(static_cast<int>(i))))
+            for (int i = emitterClipper.DisplayStart; i < emitterClipper.DisplayEnd; ++i)
             {
-                const bool ctrlDown = ImGui::GetIO().KeyCtrl;
-                if (ctrlDown)
-                {
-                    scene.EditorToggleSelectionParticleEmitter(static_cast<int>(i));
-                }
-                else
+                const rendern::ParticleEmitter& emitter = level.particleEmitters[static_cast<std::size_t>(i)];
+                char label[256]{};
+                const char* name = emitter.name.empty() ? "<unnamed emitter>" : emitter.name.c_str();
+                std::snprintf(label, sizeof(label), "%d: %s%s", i, name, emitter.enabled ? "" : "  [disabled]");
+
+                if (ImGui::Selectable(label, scene.EditorIsParticleEmitterSelected(i)))
                 {
-                    scene.EditorSetSelectionSingleParticleEmitter(static_cast<int>(i));
+                    const bool ctrlDown = ImGui::GetIO().KeyCtrl;
+                    if (ctrlDown)
+                    {
+                        scene.EditorToggleSelectionParticleEmitter(i);
+                    }
+                    else
+                    {
+                        scene.EditorSetSelectionSingleParticleEmitter(i);
+                    }
+                    st.selectedNode = -1;
+                    st.selectedParticleEmitter = scene.editorSelectedParticleEmitter;
                 }
-                st.selectedNode = -1;
-                st.selectedParticleEmitter = scene.editorSelectedParticleEmitter;
             }
         }
 
         ImGui::SeparatorText("Lights");
         scene.EditorSanitizeLightSelection(scene.lights.size());
-        for (std::size_t i = 0; i < scene.lights.size(); ++i)
+        ImGuiListClipper lightClipper;
+        lightClipper.Begin(static_cast<int>(scene.lights.size()));
+        while (lightClipper.Step())
         {
-            const rendern::Light& light = scene.lights[i];
-            char label[256]{};
-            std::snprintf(
-                label,
-                sizeof(label),
-                "%d: %s%s",
-                static_cast<int>(i),
-                LightTypeLabel(light.type),
-                light.intensity > 0.00001f ? "" : "  [disabled]");
-
-            if (ImGui::Selectable(label, scene.EditorIsLightSelected(static_cast<int>(i))))
+            for (int i = lightClipper.DisplayStart; i < lightClipper.DisplayEnd; ++i)
             {
-                const bool ctrlDown = ImGui::GetIO().KeyCtrl;
-                if (ctrlDown)
-                {
-                    scene.EditorToggleSelectionLight(static_cast<int>(i));
-                }
-                else
+                const rendern::Light& light = scene.lights[static_cast<std::size_t>(i)];
+                char label[256]{};
+                std::snprintf(
+                    label,
+                    sizeof(label),
+                    "%d: %s%s",
+                    i,
+                    LightTypeLabel(light.type),
+                    light.intensity > 0.00001f ? "" : "  [disabled]");
+
+                if (ImGui::Selectable(label, scene.EditorIsLightSelected(i)))
                 {
-                    scene.EditorSetLightSelectionSingle(static_cast<int>(i));
+                    const bool ctrlDown = ImGui::GetIO().KeyCtrl;
+                    if (ctrlDown)
+                    {
+                        scene.EditorToggleSelectionLight(i);
+                    }
+                    else
+                    {
+                        scene.EditorSetLightSelectionSingle(i);
+                    }
+                    st.selectedNode = -1;
+                    st.selectedParticleEmitter = -1;
                 }
-                st.selectedNode = -1;
-                st.selectedParticleEmitter = -1;
             }
         }
 
@@ -360,6 +360,31 @@ namespace rendern::ui::level_ui_detail
         }
     }
 
+    // Model submesh metadata for the inspector, re-read when the model changes and otherwise every
+    // kInspectorRefreshSeconds (picks up a re-exported file without parsing it every frame).
+    static const rendern::ImportedModelScene* GetModelMeta(ModelMetaCache& cache, const rendern::LevelModelDef& model)
+    {
+        const double now = ImGui::GetTime();
+        const bool sameModel = cache.loadedAt >= 0.0 && cache.path == model.path && cache.flipUVs == model.flipUVs;
+        if (!sameModel || now - cache.loadedAt >= kInspectorRefreshSeconds)
+        {
+            cache.path = model.path;
+            cache.flipUVs = model.flipUVs;
+            cache.loadedAt = now;
+            try
+            {
+                cache.meta = rendern::LoadAssimpScene(model.path, model.flipUVs);
+                cache.failed = false;
+            }
+            catch (...)
+            {
+                cache.meta = {};
+                cache.failed = true;
+            }
+        }
+        return cache.failed ? nullptr : &cache.meta;
+    }
+
     static void DrawNodeSelectionInspector(
         rendern::LevelAsset& level,
         rendern::LevelInstance& levelInst,
@@ -385,108 +410,34 @@ namespace rendern::ui::level_ui_detail
         if (ImGui::Checkbox("Visible", &vis))
             levelInst.SetNodeVisible(level, scene, assets, st.selectedNode, vis);
 
-        {
-            std::vector<std::string> items;
-            items.reserve(derived.meshIds.size() + 2);
-            items.push_back("(none)");
-            for (const auto& id : derived.meshIds) items.push_back(id);
-
-            if (!node.mesh.empty() && !level.meshes.contains(node.mesh))
-                items.push_back(std::string("<missing> ") + node.mesh);
+        bool isStatic = node.isStatic;
+        if (ImGui::Checkbox("Static (cached shadows)", &isStatic))
+            levelInst.SetNodeStatic(level, scene, st.selectedNode, isStatic);
 
-            int current = 0;
-            if (!node.mesh.empty())
-            {
-                for (std::size_t i = 1; i < items.size(); ++i)
-                {
-                    if (items[i] == node.mesh)
-                    {
-                        current = static_cast<int>(i);
-                        break;
-                    }
-                }
-            }
-
-            std::vector<const char*> citems;
-            citems.reserve(items.size());
-            for (auto& s : items) citems.push_back(s.c_str());
-
-            if (ImGui::Combo("Mesh", &current, citems.data(), static_cast<int>(citems.size())))
+        {
+            std::string selectedId;
+            if (DrawAssetIdCombo("Mesh", "(none)", derived.meshIds, node.mesh,
+                !node.mesh.empty() && !level.meshes.contains(node.mesh), selectedId))
             {
-                if (current == 0)
-                    levelInst.SetNodeMesh(level, scene, assets, st.selectedNode, "");
-                else
-                    levelInst.SetNodeMesh(level, scene, assets, st.selectedNode, items[static_cast<std::size_t>(current)]);
+                levelInst.SetNodeMesh(level, scene, assets, st.selectedNode, selectedId);
             }
         }
 
         {
-            std::vector<std::string> items;
-            items.reserve(derived.modelIds.size() + 2);
-            items.push_back("(none)");
-            for (const auto& id : derived.modelIds) items.push_back(id);
-
-            if (!node.model.empty() && !level.models.contains(node.model))
-                items.push_back(std::string("<missing> ") + node.model);
-
-            int current = 0;
-            if (!node.model.empty())
+            std::string selectedId;
+            if (DrawAssetIdCombo("Model", "(none)", derived.modelIds, node.model,
+                !node.model.empty() && !level.models.contains(node.model), selectedId))
             {
-                for (std::size_t i = 1; i < items.size(); ++i)
-                {
-                    if (items[i] == node.model)
-                    {
-                        current = static_cast<int>(i);
-                        break;
-                    }
-                }
-            }
-
-            std::vector<const char*> citems;
-            citems.reserve(items.size());
-            for (auto& s : items) citems.push_back(s.c_str());
-
-            if (ImGui::Combo("Model", &current, citems.data(), static_cast<int>(citems.size())))
-            {
-                if (current == 0)
-                    levelInst.SetNodeModel(level, scene, assets, st.selectedNode, "");
-                else
-                    levelInst.SetNodeModel(level, scene, assets, st.selectedNode, items[static_cast<std::size_t>(current)]);
+                levelInst.SetNodeModel(level, scene, assets, st.selectedNode, selectedId);
             }
         }
 
         {
-            std::vector<std::string> items;
-            items.reserve(derived.skinnedMeshIds.size() + 2);
-            items.push_back("(none)");
-            for (const auto& id : derived.skinnedMeshIds) items.push_back(id);
-
-            if (!node.skinnedMesh.empty() && !level.skinnedMeshes.contains(node.skinnedMesh))
-                items.push_back(std::string("<missing> ") + node.skinnedMesh);
-
-            int current = 0;
-            if (!node.skinnedMesh.empty())
-            {
-                for (std::size_t i = 1; i < items.size(); ++i)
-                {
-                    if (items[i] == node.skinnedMesh)
-                    {
-                        current = static_cast<int>(i);
-                        break;
-                    }
-                }
-            }
-
-            std::vector<const char*> citems;
-            citems.reserve(items.size());
-            for (auto& s : items) citems.push_back(s.c_str());
-
-            if (ImGui::Combo("Skinned Mesh", &current, citems.data(), static_cast<int>(citems.size())))
+            std::string selectedId;
+            if (DrawAssetIdCombo("Skinned Mesh", "(none)", derived.skinnedMeshIds, node.skinnedMesh,
+                !node.skinnedMesh.empty() && !level.skinnedMeshes.contains(node.skinnedMesh), selectedId))
             {
-                if (current == 0)
-                    levelInst.SetNodeSkinnedMesh(level, scene, assets, st.selectedNode, "");
-                else
-                    levelInst.SetNodeSkinnedMesh(level, scene, assets, st.selectedNode, items[static_cast<std::size_t>(current)]);
+                levelInst.SetNodeSkinnedMesh(level, scene, assets, st.selectedNode, selectedId);
             }
         }
 
@@ -500,48 +451,29 @@ namespace rendern::ui::level_ui_detail
                 if (itModel != level.models.end())
                 {
                     ImGui::TextDisabled("Model path: %s", itModel->second.path.c_str());
-                    try
+                    const rendern::ImportedModelScene* meta = GetModelMeta(st.modelMeta, itModel->second);
+                    if (meta != nullptr)
                     {
-                        const rendern::ImportedModelScene meta = rendern::LoadAssimpScene(itModel->second.path, itModel->second.flipUVs);
-                        ImGui::TextDisabled("Submeshes: %d", static_cast<int>(meta.submeshes.size()));
+                        ImGui::TextDisabled("Submeshes: %d", static_cast<int>(meta->submeshes.size()));
                         ImGui::SeparatorText("Material Overrides");
-                        for (const rendern::ImportedSubmeshInfo& sub : meta.submeshes)
+                        for (const rendern::ImportedSubmeshInfo& sub : meta->submeshes)
                         {
-                            std::vector<std::string> overrideItems;
-                            overrideItems.reserve(derived.materialIds.size() + 2);
-                            overrideItems.push_back("(default)");
-                            for (const auto& id : derived.materialIds) overrideItems.push_back(id);
-
-                            int overrideCurrent = 0;
+                            std::string overrideCurrent;
                             if (auto itOv = node.materialOverrides.find(sub.submeshIndex); itOv != node.materialOverrides.end())
-                            {
-                                for (std::size_t oi = 1; oi < overrideItems.size(); ++oi)
-                                {
-                                    if (overrideItems[oi] == itOv->second)
-                                    {
-                                        overrideCurrent = static_cast<int>(oi);
-                                        break;
-                                    }
-                                }
-                            }
-
-                            std::vector<const char*> overrideCItems;
-                            overrideCItems.reserve(overrideItems.size());
-                            for (auto& s : overrideItems) overrideCItems.push_back(s.c_str());
+                                overrideCurrent = itOv->second;
 
+                            std::string selectedId;
                             const std::string label = "Submesh " + std::to_string(sub.submeshIndex) + "##mat_override" + std::to_string(sub.submeshIndex);
-                            if (ImGui::Combo(label.c_str(), &overrideCurrent, overrideCItems.data(), static_cast<int>(overrideCItems.size())))
+                            if (DrawAssetIdCombo(label.c_str(), "(default)", derived.materialIds, overrideCurrent,
+                                !overrideCurrent.empty() && !level.materials.contains(overrideCurrent), selectedId))
                             {
-                                if (overrideCurrent == 0)
-                                    levelInst.SetNodeMaterialOverride(level, scene, assets, st.selectedNode, sub.submeshIndex, "");
-                                else
-                                    levelInst.SetNodeMaterialOverride(level, scene, assets, st.selectedNode, sub.submeshIndex, overrideItems[static_cast<std::size_t>(overrideCurrent)]);
+                                levelInst.SetNodeMaterialOverride(level, scene, assets, st.selectedNode, sub.submeshIndex, selectedId);
                             }
                             ImGui::SameLine();
                             ImGui::TextDisabled("%s", sub.name.c_str());
                         }
                     }
-                    catch (...)
+                    else
                     {
                         ImGui::TextDisabled("Failed to read model metadata.");
                     }
@@ -689,26 +621,35 @@ namespace rendern::ui::level_ui_detail
 
                             if (usingController)
                             {
-                                ImGui::Text("Controller state: %s", skinnedItem->controller.currentStateName.c_str());
+                                // Candidate strings are only built for ticks that follow this request.
+                                skinnedItem->controller.debugCaptureTransitions = true;
+
+                                const std::string currentStateName(GetAnimationControllerStateName(skinnedItem->controller));
+                                ImGui::Text("Controller state: %s", currentStateName.c_str());
                                 if (skinnedItem->controller.currentStateUsesBlend1D)
                                 {
+                                    const std::string blendParameterName(GetAnimationControllerBlendParameterName(skinnedItem->controller));
+                                    const std::string primaryClipName(
+                                        GetAnimationControllerClipName(skinnedItem->controller, skinnedItem->controller.blendPrimaryClipIndex));
+                                    const std::string secondaryClipName(
+                                        GetAnimationControllerClipName(skinnedItem->controller, skinnedItem->controller.blendSecondaryClipIndex));
                                     ImGui::TextDisabled(
                                         "Blend1D: %s = %.3f",
-                                        skinnedItem->controller.currentBlendParameterName.c_str(),
+                                        blendParameterName.c_str(),
                                         skinnedItem->controller.currentBlendParameterValue);
-                                    if (!skinnedItem->controller.currentBlendSecondaryClipName.empty())
+                                    if (!secondaryClipName.empty())
                                     {
                                         ImGui::TextDisabled(
                                             "State blend: %s -> %s (%.2f)",
-                                            skinnedItem->controller.currentBlendPrimaryClipName.c_str(),
-                                            skinnedItem->controller.currentBlendSecondaryClipName.c_str(),
+                                            primaryClipName.c_str(),
+                                            secondaryClipName.c_str(),
                                             skinnedItem->controller.blendSecondaryAlpha);
                                     }
-                                    else if (!skinnedItem->controller.currentBlendPrimaryClipName.empty())
+                                    else if (!primaryClipName.empty())
                                     {
                                         ImGui::TextDisabled(
                                             "State blend clip: %s",
-                                            skinnedItem->controller.currentBlendPrimaryClipName.c_str());
+                                            primaryClipName.c_str());
                                     }
                                 }
                                 if (skinnedItem->controller.transitionActive)
@@ -720,10 +661,11 @@ namespace rendern::ui::level_ui_detail
                                             0.0f,
                                             1.0f)
                                         : 1.0f;
+                                    const std::string sourceStateName(GetAnimationControllerTransitionSourceStateName(skinnedItem->controller));
                                     ImGui::TextDisabled(
                                         "Transition: %s -> %s (%.2f)",
-                                        skinnedItem->controller.transitionSourceStateName.c_str(),
-                                        skinnedItem->controller.currentStateName.c_str(),
+                                        sourceStateName.c_str(),
+                                        currentStateName.c_str(),
                                         blendAlpha);
                                 }
 
@@ -791,14 +733,10 @@ namespace rendern::ui::level_ui_detail
                                 {
                                     std::vector<const char*> stateItems;
                                     stateItems.reserve(controllerAsset.states.size());
-                                    int stateCurrent = 0;
+                                    int stateCurrent = std::max(0, skinnedItem->controller.currentStateIndex);
                                     for (std::size_t stateIndex = 0; stateIndex < controllerAsset.states.size(); ++stateIndex)
                                     {
                                         stateItems.push_back(controllerAsset.states[stateIndex].name.c_str());
-                                        if (controllerAsset.states[stateIndex].name == skinnedItem->controller.currentStateName)
-                                        {
-                                            stateCurrent = static_cast<int>(stateIndex);
-                                        }
                                     }
 
                                     if (ImGui::Combo("State override", &stateCurrent, stateItems.data(), static_cast<int>(stateItems.size())))
@@ -819,7 +757,7 @@ namespace rendern::ui::level_ui_detail
                                             FindAnimationParameter(skinnedItem->controller.parameters, paramDesc.name);
                                         if (runtimeParam == nullptr)
                                         {
-                                            skinnedItem->controller.parameters.values[paramDesc.name] = paramDesc.defaultValue;
+                                            SetAnimationParameterValue(skinnedItem->controller.parameters, paramDesc.name, paramDesc.defaultValue);
                                             runtimeParam = FindAnimationParameter(skinnedItem->controller.parameters, paramDesc.name);
                                         }
                                         if (runtimeParam == nullptr)
@@ -1102,37 +1040,11 @@ namespace rendern::ui::level_ui_detail
         }
 
         {
-            std::vector<std::string> items;
-            items.reserve(derived.materialIds.size() + 2);
-            items.push_back("(none)");
-            for (const auto& id : derived.materialIds) items.push_back(id);
-
-            if (!node.material.empty() && !level.materials.contains(node.material))
-                items.push_back(std::string("<missing> ") + node.material);
-
-            int current = 0;
-            if (!node.material.empty())
-            {
-                for (std::size_t i = 1; i < items.size(); ++i)
-                {
-                    if (items[i] == node.material)
-                    {
-                        current = static_cast<int>(i);
-                        break;
-                    }
-                }
-            }
-
-            std::vector<const char*> citems;
-            citems.reserve(items.size());
-            for (auto& s : items) citems.push_back(s.c_str());
-
-            if (ImGui::Combo("Material", &current, citems.data(), static_cast<int>(citems.size())))
+            std::string selectedId;
+            if (DrawAssetIdCombo("Material", "(none)", derived.materialIds, node.material,
+                !node.material.empty() && !level.materials.contains(node.material), selectedId))
             {
-                if (current == 0)
-                    levelInst.SetNodeMaterial(level, scene, st.selectedNode, "");
-                else
-                    levelInst.SetNodeMaterial(level, scene, st.selectedNode, items[static_cast<std::size_t>(current)]);
+                levelInst.SetNodeMaterial(level, scene, st.selectedNode, selectedId);
             }
         }
 
@@ -1151,7 +1063,7 @@ namespace rendern::ui::level_ui_detail
         }
 
         if (changed)
-            levelInst.MarkTransformsDirty();
+            levelInst.MarkNodeTransformDirty(st.selectedNode);
 
         ImGui::SeparatorText("Gizmo");
         int gizmoMode = static_cast<int>(scene.editorGizmoMode);
@@ -1344,6 +1256,26 @@ namespace rendern::ui::level_ui_detail
         changed |= ImGui::DragFloat("Duration", &emitter.duration, 0.05f, 0.0f, 100000.0f, "%.3f");
         changed |= ImGui::DragFloat("Start Delay", &emitter.startDelay, 0.05f, 0.0f, 100000.0f, "%.3f");
 
+        float uvRect[4] = { emitter.uvRect.x, emitter.uvRect.y, emitter.uvRect.z, emitter.uvRect.w };
+        if (ImGui::DragFloat4("UV Rect", uvRect, 0.005f, 0.0f, 1.0f, "%.3f"))
+        {
+            emitter.uvRect = mathUtils::Vec4(uvRect[0], uvRect[1], uvRect[2], uvRect[3]);
+            changed = true;
+        }
+
+        int flipbookGrid[2] = { static_cast<int>(emitter.flipbookColumns), static_cast<int>(emitter.flipbookRows) };
+        if (ImGui::DragInt2("Flipbook Cols/Rows", flipbookGrid, 0.1f, 1, 64))
+        {
+            emitter.flipbookColumns = static_cast<std::uint32_t>(std::max(1, flipbookGrid[0]));
+            emitter.flipbookRows = static_cast<std::uint32_t>(std::max(1, flipbookGrid[1]));
+            changed = true;
+        }
+        changed |= ImGui::DragFloat("Flipbook FPS", &emitter.flipbookFps, 0.1f, 0.0f, 240.0f, "%.1f");
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("0 plays the frames once over each particle's lifetime.");
+        }
+
         if (changed)
         {
             levelInst.RestartParticleEmitter(level, scene, st.selectedParticleEmitter);
@@ -1352,14 +1284,7 @@ namespace rendern::ui::level_ui_detail
         ImGui::SeparatorText("Runtime");
         if (const rendern::ParticleEmitter* runtimeEmitter = levelInst.GetRuntimeParticleEmitter(static_cast<const rendern::Scene&>(scene), st.selectedParticleEmitter))
         {
-            int aliveCount = 0;
-            for (const rendern::Particle& particle : scene.particles)
-            {
-                if (particle.alive && particle.ownerEmitter == st.selectedParticleEmitter)
-                {
-                    ++aliveCount;
-                }
-            }
+            const int aliveCount = static_cast<int>(scene.particles.CountOwnedBy(st.selectedParticleEmitter));
 
             ImGui::Text("Alive particles: %d", aliveCount);
             ImGui::Text("Elapsed: %.3f", runtimeEmitter->elapsed);
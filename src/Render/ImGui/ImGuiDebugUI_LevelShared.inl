@@ -1,5 +1,48 @@
 namespace rendern::ui::level_ui_detail
 {
+    struct DerivedLists
+    {
+        std::vector<std::vector<int>> children;
+        std::vector<int> roots;
+        std::vector<std::string> meshIds;
+        std::vector<std::string> modelIds;
+        std::vector<std::string> skinnedMeshIds;
+        std::vector<std::string> materialIds;
+    };
+
+    struct HierarchyRow
+    {
+        int node = -1;
+        int depth = 0;
+        bool hasChildren = false;
+    };
+
+    // Derived lists and the flattened hierarchy rows survive across frames: the lists are rebuilt when the
+    // structure hash (node count, alive flags, parents, asset id counts) changes, the rows when that
+    // happens or a node is expanded / collapsed. The panel then only draws the rows the clipper shows.
+    struct HierarchyCache
+    {
+        DerivedLists derived;
+        std::uint64_t structureHash = 0;
+        bool valid = false;
+        std::vector<std::uint8_t> expanded; // per node index
+        std::vector<HierarchyRow> rows;
+        bool rowsDirty = true;
+    };
+
+    // Inspector data that is expensive to derive (model files read from disk), refreshed when its key
+    // changes and otherwise at most every kInspectorRefreshSeconds.
+    constexpr double kInspectorRefreshSeconds = 1.0;
+
+    struct ModelMetaCache
+    {
+        std::string path;
+        bool flipUVs = false;
+        bool failed = false;
+        double loadedAt = -1.0;
+        rendern::ImportedModelScene meta{};
+    };
+
     struct LevelEditorUIState
     {
         int selectedNode = -1;
@@ -18,16 +61,13 @@ namespace rendern::ui::level_ui_detail
         char saveStatusBuf[512]{};
         std::string cachedSourcePath;
         bool saveStatusIsError = false;
-    };
 
-    struct DerivedLists
-    {
-        std::vector<std::vector<int>> children;
-        std::vector<int> roots;
-        std::vector<std::string> meshIds;
-        std::vector<std::string> modelIds;
-        std::vector<std::string> skinnedMeshIds;
-        std::vector<std::string> materialIds;
+        // In-flight background save (see SaveLevelAssetToJsonAsync); polled once per frame.
+        std::shared_future<void> pendingSave;
+        std::string pendingSavePath;
+
+        HierarchyCache hierarchy;
+        ModelMetaCache modelMeta;
     };
 
     static LevelEditorUIState& GetState()
@@ -102,6 +142,119 @@ namespace rendern::ui::level_ui_detail
         std::sort(out.materialIds.begin(), out.materialIds.end());
     }
 
+    static std::uint64_t ComputeLevelStructureHash(const rendern::LevelAsset& level) noexcept
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto Mix = [&hash](std::uint64_t value) noexcept
+            {
+                hash ^= value;
+                hash *= 1099511628211ull;
+            };
+
+        Mix(level.nodes.size());
+        for (const rendern::LevelNode& n : level.nodes)
+        {
+            Mix((static_cast<std::uint64_t>(static_cast<std::uint32_t>(n.parent)) << 1) | (n.alive ? 1ull : 0ull));
+        }
+        Mix(level.meshes.size());
+        Mix(level.models.size());
+        Mix(level.skinnedMeshes.size());
+        Mix(level.materials.size());
+        Mix(std::hash<std::string>{}(level.sourcePath));
+        return hash;
+    }
+
+    // Rebuilds the derived lists only when the level structure changed since the last call.
+    static const DerivedLists& UpdateHierarchyCache(const rendern::LevelAsset& level, HierarchyCache& cache)
+    {
+        const std::uint64_t hash = ComputeLevelStructureHash(level);
+        if (!cache.valid || hash != cache.structureHash)
+        {
+            BuildDerivedLists(level, cache.derived);
+            cache.structureHash = hash;
+            cache.valid = true;
+            cache.rowsDirty = true;
+            cache.expanded.resize(level.nodes.size(), 0u);
+        }
+        return cache.derived;
+    }
+
+    // Depth-first rows of the expanded part of the tree (collapsed subtrees are skipped entirely).
+    static void RebuildHierarchyRows(HierarchyCache& cache)
+    {
+        cache.rows.clear();
+        std::vector<HierarchyRow> stack;
+        for (auto it = cache.derived.roots.rbegin(); it != cache.derived.roots.rend(); ++it)
+        {
+            stack.push_back(HierarchyRow{ .node = *it, .depth = 0 });
+        }
+
+        while (!stack.empty())
+        {
+            HierarchyRow row = stack.back();
+            stack.pop_back();
+
+            const std::vector<int>& children = cache.derived.children[static_cast<std::size_t>(row.node)];
+            row.hasChildren = !children.empty();
+            cache.rows.push_back(row);
+
+            if (row.hasChildren && cache.expanded[static_cast<std::size_t>(row.node)] != 0u)
+            {
+                for (auto it = children.rbegin(); it != children.rend(); ++it)
+                {
+                    stack.push_back(HierarchyRow{ .node = *it, .depth = row.depth + 1 });
+                }
+            }
+        }
+        cache.rowsDirty = false;
+    }
+
+    // Combo over sorted asset ids; only the visible entries of the open list are submitted.
+    static bool DrawAssetIdCombo(
+        const char* label,
+        const char* noneLabel,
+        const std::vector<std::string>& ids,
+        const std::string& current,
+        bool currentMissing,
+        std::string& outSelected)
+    {
+        const std::string preview = current.empty()
+            ? std::string(noneLabel)
+            : (currentMissing ? std::string("<missing> ") + current : current);
+
+        bool changed = false;
+        if (ImGui::BeginCombo(label, preview.c_str()))
+        {
+            if (ImGui::Selectable(noneLabel, current.empty()))
+            {
+                outSelected.clear();
+                changed = true;
+            }
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(ids.size()));
+            while (clipper.Step())
+            {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+                {
+                    const std::string& id = ids[static_cast<std::size_t>(i)];
+                    const bool selected = id == current;
+                    if (ImGui::Selectable(id.c_str(), selected))
+                    {
+                        outSelected = id;
+                        changed = true;
+                    }
+                    if (selected)
+                    {
+                        ImGui::SetItemDefaultFocus();
+                    }
+                }
+            }
+            ImGui::EndCombo();
+        }
+        return changed;
+    }
+
     static std::string SanitizeId(std::string s)
     {
         if (s.empty())
@@ -0,0 +1,205 @@
+namespace rendern::ui
+{
+    struct ProfilerUIState
+    {
+        bool followLatest = true;
+        int selectedFrame = 0; // index into the profiler history
+        float zoom = 1.0f;
+        char exportPath[260] = "profile_trace.json";
+        std::string exportStatus;
+    };
+
+    static ProfilerUIState& GetProfilerState()
+    {
+        static ProfilerUIState s{};
+        return s;
+    }
+
+    static ImU32 ZoneColor(std::string_view name)
+    {
+        // Stable color per zone name.
+        std::uint32_t h = 2166136261u;
+        for (const char c : name)
+        {
+            h = (h ^ static_cast<std::uint8_t>(c)) * 16777619u;
+        }
+        const float hue = static_cast<float>(h % 360u) / 360.0f;
+        float r = 0.0f;
+        float g = 0.0f;
+        float b = 0.0f;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.55f, 0.85f, r, g, b);
+        return ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+    }
+
+    // One timeline row: zones stacked by depth, x = time since the row's origin.
+    static void DrawZoneBar(ImDrawList* drawList, const ImVec2& rowMin, float pixelsPerMs, float laneHeight,
+        std::string_view name, double beginMs, double endMs, std::uint32_t depth)
+    {
+        const ImVec2 min(rowMin.x + static_cast<float>(beginMs) * pixelsPerMs, rowMin.y + static_cast<float>(depth) * laneHeight);
+        const ImVec2 max(std::max(min.x + 1.0f, rowMin.x + static_cast<float>(endMs) * pixelsPerMs), min.y + laneHeight - 1.0f);
+        drawList->AddRectFilled(min, max, ZoneColor(name));
+
+        const ImVec2 textSize = ImGui::CalcTextSize(name.data(), name.data() + name.size());
+        if (textSize.x + 4.0f < max.x - min.x)
+        {
+            drawList->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32(20, 20, 20, 255), name.data(), name.data() + name.size());
+        }
+
+        if (ImGui::IsMouseHoveringRect(min, max))
+        {
+            ImGui::SetTooltip("%.*s\n%.3f ms", static_cast<int>(name.size()), name.data(), endMs - beginMs);
+        }
+    }
+
+    static void DrawProfilerTimeline(const profiling::FrameCapture& frame, float zoom)
+    {
+        const float laneHeight = ImGui::GetTextLineHeight() + 2.0f;
+        const float labelWidth = 120.0f;
+
+        double spanMs = frame.DurationMs();
+        for (const profiling::GpuZone& zone : frame.gpuZones)
+        {
+            spanMs = std::max(spanMs, zone.endMs);
+        }
+        spanMs = std::max(spanMs, 0.001);
+
+        ImGui::BeginChild("##ProfilerTimeline", ImVec2(0.0f, 0.0f), true, ImGuiWindowFlags_HorizontalScrollbar);
+        const float trackWidth = std::max(100.0f, (ImGui::GetContentRegionAvail().x - labelWidth) * zoom);
+        const float pixelsPerMs = trackWidth / static_cast<float>(spanMs);
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        auto Row = [&](const char* label, std::uint32_t lanes, auto&& drawZones)
+            {
+                const ImVec2 cursor = ImGui::GetCursorScreenPos();
+                const float height = static_cast<float>(std::max(lanes, 1u)) * laneHeight;
+                drawList->AddText(cursor, ImGui::GetColorU32(ImGuiCol_Text), label);
+                const ImVec2 rowMin(cursor.x + labelWidth, cursor.y);
+                drawList->AddRectFilled(rowMin, ImVec2(rowMin.x + trackWidth, rowMin.y + height), ImGui::GetColorU32(ImGuiCol_FrameBg));
+                drawZones(rowMin);
+                ImGui::Dummy(ImVec2(labelWidth + trackWidth, height + 4.0f));
+            };
+
+        for (const profiling::ThreadCapture& thread : frame.threads)
+        {
+            std::uint32_t lanes = 0;
+            for (const profiling::ZoneEvent& zone : thread.zones)
+            {
+                lanes = std::max(lanes, zone.depth + 1);
+            }
+            const std::string label = thread.name.empty() ? "Thread " + std::to_string(thread.threadIndex) : thread.name;
+            Row(label.c_str(), lanes, [&](const ImVec2& rowMin)
+                {
+                    for (const profiling::ZoneEvent& zone : thread.zones)
+                    {
+                        DrawZoneBar(drawList, rowMin, pixelsPerMs, laneHeight, zone.name ? zone.name : "?",
+                            static_cast<double>(zone.beginNs - frame.beginNs) * 1e-6,
+                            static_cast<double>(zone.endNs - frame.beginNs) * 1e-6,
+                            zone.depth);
+                    }
+                });
+        }
+
+        if (!frame.gpuZones.empty())
+        {
+            std::uint32_t lanes = 0;
+            for (const profiling::GpuZone& zone : frame.gpuZones)
+            {
+                lanes = std::max(lanes, zone.depth + 1);
+            }
+            Row("GPU", lanes, [&](const ImVec2& rowMin)
+                {
+                    for (const profiling::GpuZone& zone : frame.gpuZones)
+                    {
+                        DrawZoneBar(drawList, rowMin, pixelsPerMs, laneHeight, zone.name, zone.beginMs, zone.endMs, zone.depth);
+                    }
+                });
+        }
+
+        ImGui::EndChild();
+    }
+
+    static void DrawProfilerWindow()
+    {
+        ImGui::Begin("Profiler");
+
+        profiling::Profiler& profiler = profiling::Profiler::Get();
+        ProfilerUIState& st = GetProfilerState();
+
+        bool capturing = profiler.IsEnabled();
+        if (ImGui::Checkbox("Capture", &capturing))
+        {
+            profiler.SetEnabled(capturing);
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Follow latest", &st.followLatest);
+        ImGui::SameLine();
+        if (ImGui::Button("Clear"))
+        {
+            profiler.ClearHistory();
+        }
+
+        ImGui::InputText("Trace file", st.exportPath, sizeof(st.exportPath));
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome trace"))
+        {
+            st.exportStatus = profiler.WriteChromeTrace(st.exportPath)
+                ? "Wrote " + std::to_string(profiler.GetHistory().size()) + " frames to " + st.exportPath
+                : std::string("Failed to write ") + st.exportPath;
+        }
+        if (!st.exportStatus.empty())
+        {
+            ImGui::TextDisabled("%s", st.exportStatus.c_str());
+        }
+
+        const std::deque<profiling::FrameCapture>& history = profiler.GetHistory();
+        if (history.empty())
+        {
+            ImGui::TextDisabled("No frames captured.");
+            ImGui::End();
+            return;
+        }
+
+        const int lastFrame = static_cast<int>(history.size()) - 1;
+        if (st.followLatest)
+        {
+            st.selectedFrame = lastFrame;
+        }
+        st.selectedFrame = std::clamp(st.selectedFrame, 0, lastFrame);
+
+        // Frame time graph; clicking a bar selects that frame.
+        float frameTimes[profiling::Profiler::kDefaultHistoryFrames]{};
+        const int plotCount = std::min(static_cast<int>(history.size()), static_cast<int>(std::size(frameTimes)));
+        const int plotFirst = static_cast<int>(history.size()) - plotCount;
+        float maxMs = 1.0f;
+        for (int i = 0; i < plotCount; ++i)
+        {
+            frameTimes[i] = static_cast<float>(history[static_cast<std::size_t>(plotFirst + i)].DurationMs());
+            maxMs = std::max(maxMs, frameTimes[i]);
+        }
+        ImGui::PlotHistogram("##FrameTimes", frameTimes, plotCount, 0, "Frame ms", 0.0f, maxMs * 1.1f, ImVec2(-1.0f, 60.0f));
+        if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left) && plotCount > 0)
+        {
+            const float t = (ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / std::max(1.0f, ImGui::GetItemRectSize().x);
+            st.selectedFrame = plotFirst + std::clamp(static_cast<int>(t * static_cast<float>(plotCount)), 0, plotCount - 1);
+            st.followLatest = false;
+        }
+
+        if (ImGui::SliderInt("Frame", &st.selectedFrame, 0, lastFrame))
+        {
+            st.followLatest = false;
+        }
+        ImGui::SliderFloat("Zoom", &st.zoom, 1.0f, 32.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+
+        const profiling::FrameCapture& frame = history[static_cast<std::size_t>(st.selectedFrame)];
+        ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(frame.frameIndex), frame.DurationMs());
+        if (frame.droppedZones != 0)
+        {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "(%u zones dropped)", frame.droppedZones);
+        }
+
+        DrawProfilerTimeline(frame, st.zoom);
+
+        ImGui::End();
+    }
+}
@@ -8,6 +8,12 @@ namespace rendern::ui
 
         ImGui::BeginDisabled(!rs.enableReflectionCapture);
         ImGui::Checkbox("Update every frame", &rs.reflectionCaptureUpdateEveryFrame);
+        int faceBudget = static_cast<int>(rs.reflectionCaptureFaceBudget);
+        if (ImGui::InputInt("Faces per frame (0 = all)", &faceBudget))
+        {
+            faceBudget = std::clamp(faceBudget, 0, 96);
+            rs.reflectionCaptureFaceBudget = static_cast<std::uint32_t>(faceBudget);
+        }
         ImGui::Checkbox("Follow selected object", &rs.reflectionCaptureFollowSelectedObject);
 
         // Capture owner is separate from the current editor selection.
@@ -53,6 +59,13 @@ namespace rendern::ui
             rs.reflectionCaptureFarZ = rs.reflectionCaptureNearZ;
 
         ImGui::EndDisabled();
+
+        ImGui::Separator();
+        ImGui::Checkbox("Planar reflections", &rs.enablePlanarReflections);
+        ImGui::BeginDisabled(!rs.enablePlanarReflections);
+        ImGui::SliderFloat("Planar render scale", &rs.planarReflectionRenderScale, 0.25f, 1.0f, "%.2f");
+        ImGui::EndDisabled();
+
         ImGui::End();
     }
 }
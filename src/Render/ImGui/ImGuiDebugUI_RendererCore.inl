@@ -299,18 +299,198 @@ namespace rendern::ui
         ImGui::EndDisabled();
     }
 
+    static void DrawFrameStatsSection(const rendern::RendererFrameStats& stats)
+    {
+        if (!ImGui::CollapsingHeader("Frame stats", ImGuiTreeNodeFlags_DefaultOpen))
+            return;
+
+        ImGui::Text("Frame %llu", static_cast<unsigned long long>(stats.frameIndex));
+        ImGui::Text("Draws: %u (indirect %u)  Dispatches: %u", stats.drawCalls, stats.indirectDraws, stats.dispatches);
+        ImGui::Text("Instances: %llu  Triangles: %llu",
+            static_cast<unsigned long long>(stats.instances), static_cast<unsigned long long>(stats.triangles));
+        ImGui::Text("PSO binds: %u  Barriers: %u", stats.pipelineBinds, stats.barriers);
+        ImGui::Text("UpdateBuffer: %u calls, %.1f KB", stats.bufferUpdates, static_cast<double>(stats.bufferUploadBytes) / 1024.0);
+        ImGui::Text("Descriptor allocations: %u", stats.descriptorAllocations);
+        ImGui::Text("Transient textures: %u (new %u), new framebuffers: %u",
+            stats.transientTextures, stats.transientTexturesCreated, stats.transientFramebuffersCreated);
+        ImGui::Text("Graph passes: %u (culled %u)", static_cast<unsigned>(stats.passes.size()), stats.graphPassesCulled);
+        ImGui::Text("Camera culling: %u tested, %u visible, %u culled",
+            stats.cullTested, stats.cullVisible, stats.cullTested - std::min(stats.cullVisible, stats.cullTested));
+        ImGui::Text("Render scale: %.2f  GPU frame: %.2f ms", stats.renderScale, stats.gpuFrameMs);
+        ImGui::Text("Input to present: %.2f ms", stats.inputToPresentMs);
+
+        if (ImGui::TreeNode("Per pass"))
+        {
+            constexpr ImGuiTableFlags kFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+            if (ImGui::BeginTable("##RendererPassStats", 7, kFlags))
+            {
+                ImGui::TableSetupColumn("Pass");
+                ImGui::TableSetupColumn("Draws");
+                ImGui::TableSetupColumn("Instances");
+                ImGui::TableSetupColumn("Triangles");
+                ImGui::TableSetupColumn("Dispatches");
+                ImGui::TableSetupColumn("PSO binds");
+                ImGui::TableSetupColumn("Barriers");
+                ImGui::TableHeadersRow();
+
+                for (const rendern::RendererPassStats& pass : stats.passes)
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(pass.name.c_str());
+                    ImGui::TableNextColumn();
+                    if (pass.indirectDraws > 0)
+                        ImGui::Text("%u (%u ind.)", pass.drawCalls, pass.indirectDraws);
+                    else
+                        ImGui::Text("%u", pass.drawCalls);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(pass.instances));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(pass.triangles));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", pass.dispatches);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", pass.pipelineBinds);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", pass.barriers);
+                }
+                ImGui::EndTable();
+            }
+            ImGui::TreePop();
+        }
+
+        ImGui::Separator();
+    }
+
+    static void DrawMemoryBudgetBar(std::uint64_t bytes, std::uint64_t budget)
+    {
+        const double mib = static_cast<double>(bytes) / (1024.0 * 1024.0);
+        const float fraction = (budget > 0) ? static_cast<float>(static_cast<double>(bytes) / static_cast<double>(budget)) : 0.0f;
+        char overlay[48];
+        std::snprintf(overlay, sizeof(overlay), "%.1f / %.0f MB", mib, static_cast<double>(budget) / (1024.0 * 1024.0));
+        if (fraction > 1.0f)
+            ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.85f, 0.25f, 0.2f, 1.0f));
+        ImGui::ProgressBar(std::min(fraction, 1.0f), ImVec2(-1.0f, 0.0f), overlay);
+        if (fraction > 1.0f)
+            ImGui::PopStyleColor();
+    }
+
+    static void DrawMemorySection()
+    {
+        if (!ImGui::CollapsingHeader("Memory"))
+            return;
+
+        constexpr double kMiB = 1024.0 * 1024.0;
+        constexpr ImGuiTableFlags kFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+        if (ImGui::BeginTable("##MemoryTags", 5, kFlags))
+        {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("CPU", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("CPU level peak");
+            ImGui::TableSetupColumn("GPU", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("GPU level peak");
+            ImGui::TableHeadersRow();
+
+            for (std::size_t i = 0; i < memory::kMemoryTagCount; ++i)
+            {
+                const memory::MemoryTag tag = static_cast<memory::MemoryTag>(i);
+                const memory::MemoryTagStats stats = memory::GetMemoryTagStats(tag);
+                const memory::MemoryBudget budget = memory::DefaultMemoryBudget(tag);
+                const std::string_view name = memory::MemoryTagName(tag);
+
+                ImGui::PushID(static_cast<int>(i));
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(name.data(), name.data() + name.size());
+                ImGui::TableNextColumn();
+                DrawMemoryBudgetBar(stats.cpuBytes, budget.cpuBytes);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f MB", static_cast<double>(stats.cpuLevelPeakBytes) / kMiB);
+                ImGui::TableNextColumn();
+                DrawMemoryBudgetBar(stats.gpuBytes, budget.gpuBytes);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f MB", static_cast<double>(stats.gpuLevelPeakBytes) / kMiB);
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::Button("Reset level peaks"))
+            memory::ResetLevelMemoryPeaks();
+
+        ImGui::Separator();
+    }
+
     static void DrawRendererCoreWindow(
         rendern::RendererSettings& rs,
+        const rendern::RendererFrameStats& frameStats,
         rendern::Scene& scene,
         rendern::CameraController& camCtl)
     {
         ImGui::Begin("Renderer / Shadows");
 
         ImGui::Checkbox("Depth prepass", &rs.enableDepthPrepass);
+        if (rs.enableDepthPrepass)
+        {
+            ImGui::SliderFloat("Prepass occluder size", &rs.depthPrepassMinScreenSize, 0.0f, 0.5f, "%.2f");
+        }
         ImGui::Checkbox("Deferred (experimental)", &rs.enableDeferred);
+        if (rs.enableDeferred)
+        {
+            ImGui::Checkbox("Compact G-buffer", &rs.compactGBuffer);
+            ImGui::Checkbox("Dynamic resolution", &rs.enableDynamicResolution);
+            if (rs.enableDynamicResolution)
+            {
+                ImGui::SliderFloat("GPU budget (ms)", &rs.dynamicResolutionTargetMs, 4.0f, 50.0f, "%.1f");
+                ImGui::SliderFloat("Min scale", &rs.dynamicResolutionMinScale, 0.25f, 1.0f, "%.2f");
+                ImGui::SliderFloat("Max scale", &rs.dynamicResolutionMaxScale, 0.25f, 1.0f, "%.2f");
+                ImGui::SliderFloat("Upscale sharpness", &rs.dynamicResolutionSharpness, 0.0f, 1.0f, "%.2f");
+            }
+        }
         ImGui::Checkbox("Frustum culling", &rs.enableFrustumCulling);
+        ImGui::Checkbox("BVH culling", &rs.enableBvhCulling);
+        ImGui::Checkbox("Mesh LODs", &rs.enableMeshLods);
+        if (rs.enableMeshLods)
+        {
+            ImGui::SliderFloat("LOD 1 screen size", &rs.meshLodScreenSize, 0.01f, 1.0f, "%.2f");
+            ImGui::SliderInt("LOD bias", &rs.meshLodBias, -3, 3);
+            ImGui::SliderInt("Shadow LOD bias", &rs.shadowMeshLodBias, -3, 3);
+        }
+        ImGui::Checkbox("GPU culling (compute)", &rs.enableGpuCulling);
+        ImGui::Checkbox("Mesh shaders (meshlets)", &rs.enableMeshShaders);
+        ImGui::Checkbox("GPU particles (compute)", &rs.enableGpuParticles);
+        ImGui::Checkbox("Compute skinning", &rs.enableComputeSkinning);
+        ImGui::Checkbox("GPU instance transforms", &rs.enableGpuInstanceTransforms);
+        ImGui::Checkbox("Parallel instance packing", &rs.enableParallelInstancePacking);
+        ImGui::Checkbox("Parallel pass recording", &rs.enableParallelPassRecording);
+        ImGui::Checkbox("Async compute", &rs.enableAsyncCompute);
+        ImGui::Checkbox("Clustered lighting", &rs.enableClusteredLighting);
+        ImGui::Checkbox("Order-independent transparency", &rs.enableWeightedBlendedOit);
+        ImGui::Checkbox("Static shadow caching", &rs.enableShadowCaching);
+        ImGui::Checkbox("Cascade caster culling", &rs.enableCascadeCasterCulling);
+        int farCascadeInterval = static_cast<int>(rs.dirShadowFarCascadeInterval);
+        if (ImGui::InputInt("Far cascade update interval", &farCascadeInterval))
+        {
+            farCascadeInterval = std::clamp(farCascadeInterval, 1, 8);
+            rs.dirShadowFarCascadeInterval = static_cast<std::uint32_t>(farCascadeInterval);
+        }
+        ImGui::Checkbox("Point shadow face culling", &rs.enablePointShadowFaceCulling);
+        // Spot shadow atlas and tile sizes are powers of two: the sliders pick the exponent.
+        auto SliderPow2 = [](const char* label, std::uint32_t& value, int minLog2, int maxLog2)
+            {
+                int log2Value = static_cast<int>(std::log2(static_cast<float>(std::max(value, 1u))));
+                if (ImGui::SliderInt(label, &log2Value, minLog2, maxLog2, "2^%d"))
+                {
+                    value = 1u << log2Value;
+                }
+            };
+        SliderPow2("Spot shadow atlas", rs.spotShadowAtlasSize, 11, 13);
+        SliderPow2("Spot shadow max tile", rs.spotShadowMaxTileSize, 8, 12);
+        SliderPow2("Spot shadow min tile", rs.spotShadowMinTileSize, 6, 10);
         ImGui::Checkbox("Debug print draw calls", &rs.debugPrintDrawCalls);
 
+        DrawFrameStatsSection(frameStats);
+        DrawMemorySection();
         DrawSSAOSection(rs);
         DrawFogSection(rs);
         DrawAntiAliasingSection(rs);
@@ -2,11 +2,13 @@ namespace rendern::ui
 {
     void DrawRendererDebugUI(
         rendern::RendererSettings& rs,
+        const rendern::RendererFrameStats& frameStats,
         rendern::Scene& scene,
         rendern::CameraController& camCtl)
     {
-        DrawRendererCoreWindow(rs, scene, camCtl);
+        DrawRendererCoreWindow(rs, frameStats, scene, camCtl);
         DrawReflectionsWindow(rs, scene);
         DrawLightsWindow(scene);
+        DrawProfilerWindow();
     }
 }
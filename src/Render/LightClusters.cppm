@@ -0,0 +1,393 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+export module core:light_clusters;
+
+import :math_utils;
+import :job_system;
+
+// Froxel light binning for clustered shading.
+//
+// The camera frustum is split into grid.x * grid.y screen tiles and grid.z depth slices spaced
+// exponentially between near and far. Every point/spot light is bounded by a sphere and added to the
+// list of each cluster it overlaps; lights without a finite range (directional) go to one global list
+// that every pixel walks. The result is a single uint array, uploaded as a structured buffer:
+//
+//   [0 .. kHeaderWords)            header (kHeader* word indices, mirrored by the HLSL helpers)
+//   [kHeaderWords .. +2*clusters)  per-cluster (offset, count), cluster = (z * grid.y + y) * grid.x + x
+//   [...]                          global light indices, then the per-cluster light indices
+//
+// Offsets are absolute word indices into the same array and lists keep the input (light index) order,
+// so shaders can keep using the light index for shadow slot lookups.
+
+export namespace rendern
+{
+	struct LightClusterGrid
+	{
+		std::uint32_t x{ 16 };
+		std::uint32_t y{ 9 };
+		std::uint32_t z{ 24 };
+	};
+
+	// Camera the clusters are built for. Tile rows count from the top of the viewport, like SV_Position.
+	struct LightClusterView
+	{
+		mathUtils::Vec3 position{};
+		mathUtils::Vec3 forward{ 0.0f, 0.0f, -1.0f };
+		mathUtils::Vec3 up{ 0.0f, 1.0f, 0.0f };
+		float fovYRad{ 1.0f };
+		float aspect{ 1.0f };
+		float nearZ{ 0.1f };
+		float farZ{ 100.0f };
+		std::uint32_t viewportWidth{ 1 };
+		std::uint32_t viewportHeight{ 1 };
+	};
+
+	// Bounding sphere of one light. A non-finite radius marks a light that reaches every cluster.
+	struct LightClusterBounds
+	{
+		mathUtils::Vec3 center{};
+		float radius{ std::numeric_limits<float>::infinity() };
+	};
+
+	class LightClusterBuilder
+	{
+	public:
+		static constexpr std::uint32_t kHeaderWords = 16;
+		static constexpr std::uint32_t kHeaderGridX = 0;
+		static constexpr std::uint32_t kHeaderGridY = 1;
+		static constexpr std::uint32_t kHeaderGridZ = 2;
+		static constexpr std::uint32_t kHeaderGlobalCount = 3;
+		static constexpr std::uint32_t kHeaderTilesPerPixelX = 4; // asfloat
+		static constexpr std::uint32_t kHeaderTilesPerPixelY = 5; // asfloat
+		static constexpr std::uint32_t kHeaderSliceScale = 6;     // asfloat: slice = log(viewZ) * scale + bias
+		static constexpr std::uint32_t kHeaderSliceBias = 7;      // asfloat
+		static constexpr std::uint32_t kHeaderCameraPos = 8;      // asfloat x3
+		static constexpr std::uint32_t kHeaderGlobalOffset = 11;
+		static constexpr std::uint32_t kHeaderCameraForward = 12; // asfloat x3
+		static constexpr std::uint32_t kHeaderEnabled = 15;       // 0: shaders loop every light instead
+
+		struct Stats
+		{
+			std::uint32_t clusterCount{ 0 };
+			std::uint32_t globalLights{ 0 };
+			std::uint32_t indexCount{ 0 };       // global + per-cluster indices written
+			std::uint32_t maxClusterLights{ 0 }; // longest per-cluster list (global lights excluded)
+			bool overflowed{ false };            // some cluster lists were cut to fit maxIndices
+		};
+
+		// `maxIndices` bounds the light index lists (global and per-cluster) so the buffer size is fixed.
+		explicit LightClusterBuilder(LightClusterGrid grid = {}, std::uint32_t maxIndices = 256u * 1024u)
+			: grid_(SanitizeGrid_(grid))
+			, maxIndices_(maxIndices)
+		{
+			const auto header = DisabledHeader();
+			words_.reserve(BufferWords(grid_, maxIndices_));
+			words_.assign(header.begin(), header.end());
+		}
+
+		[[nodiscard]] static constexpr std::size_t BufferWords(LightClusterGrid grid, std::uint32_t maxIndices) noexcept
+		{
+			return kHeaderWords + 2ull * grid.x * grid.y * grid.z + maxIndices;
+		}
+
+		// A header with kHeaderEnabled cleared, for passes rendered from another camera.
+		[[nodiscard]] static std::array<std::uint32_t, kHeaderWords> DisabledHeader() noexcept
+		{
+			std::array<std::uint32_t, kHeaderWords> header{};
+			header[kHeaderGridX] = 1;
+			header[kHeaderGridY] = 1;
+			header[kHeaderGridZ] = 1;
+			header[kHeaderGlobalOffset] = kHeaderWords;
+			return header;
+		}
+
+		[[nodiscard]] LightClusterGrid Grid() const noexcept { return grid_; }
+		[[nodiscard]] std::uint32_t MaxIndices() const noexcept { return maxIndices_; }
+
+		// Rebuilds the lists for `view`. Depth slices are binned in parallel on `scheduler` (if any);
+		// the output does not depend on how the work was split.
+		void Build(const LightClusterView& view, std::span<const LightClusterBounds> lights, jobs::Scheduler* scheduler = nullptr)
+		{
+			const std::uint32_t tilesPerSlice = grid_.x * grid_.y;
+			const std::uint32_t clusterCount = tilesPerSlice * grid_.z;
+
+			stats_ = {};
+			stats_.clusterCount = clusterCount;
+
+			const mathUtils::Vec3 forward = mathUtils::Normalize(view.forward);
+			const mathUtils::Vec3 right = mathUtils::Normalize(mathUtils::Cross(forward, view.up));
+			const mathUtils::Vec3 up = mathUtils::Cross(right, forward);
+
+			nearZ_ = std::max(view.nearZ, 1e-4f);
+			farZ_ = std::max(view.farZ, nearZ_ * 1.001f);
+			tanHalfY_ = std::tan(std::max(view.fovYRad, 1e-3f) * 0.5f);
+			tanHalfX_ = tanHalfY_ * std::max(view.aspect, 1e-3f);
+			const float sliceScale = static_cast<float>(grid_.z) / std::log(farZ_ / nearZ_);
+			const float sliceBias = -std::log(nearZ_) * sliceScale;
+
+			words_.assign(kHeaderWords + 2ull * clusterCount, 0u);
+			words_[kHeaderGridX] = grid_.x;
+			words_[kHeaderGridY] = grid_.y;
+			words_[kHeaderGridZ] = grid_.z;
+			words_[kHeaderTilesPerPixelX] = std::bit_cast<std::uint32_t>(static_cast<float>(grid_.x) / static_cast<float>(std::max(view.viewportWidth, 1u)));
+			words_[kHeaderTilesPerPixelY] = std::bit_cast<std::uint32_t>(static_cast<float>(grid_.y) / static_cast<float>(std::max(view.viewportHeight, 1u)));
+			words_[kHeaderSliceScale] = std::bit_cast<std::uint32_t>(sliceScale);
+			words_[kHeaderSliceBias] = std::bit_cast<std::uint32_t>(sliceBias);
+			words_[kHeaderCameraPos + 0] = std::bit_cast<std::uint32_t>(view.position.x);
+			words_[kHeaderCameraPos + 1] = std::bit_cast<std::uint32_t>(view.position.y);
+			words_[kHeaderCameraPos + 2] = std::bit_cast<std::uint32_t>(view.position.z);
+			words_[kHeaderCameraForward + 0] = std::bit_cast<std::uint32_t>(forward.x);
+			words_[kHeaderCameraForward + 1] = std::bit_cast<std::uint32_t>(forward.y);
+			words_[kHeaderCameraForward + 2] = std::bit_cast<std::uint32_t>(forward.z);
+			words_[kHeaderEnabled] = 1u;
+
+			// Split the input: global lights, and view-space spheres that touch [near, far].
+			globalLights_.clear();
+			viewLights_.clear();
+			for (std::size_t i = 0; i < lights.size(); ++i)
+			{
+				const LightClusterBounds& light = lights[i];
+				const auto lightIndex = static_cast<std::uint32_t>(i);
+				if (!std::isfinite(light.radius))
+				{
+					globalLights_.push_back(lightIndex);
+					continue;
+				}
+
+				const mathUtils::Vec3 rel = light.center - view.position;
+				ViewSphere_ sphere{};
+				sphere.x = mathUtils::Dot(rel, right);
+				sphere.y = mathUtils::Dot(rel, up);
+				sphere.z = mathUtils::Dot(rel, forward);
+				sphere.r = std::max(light.radius, 0.0f);
+				sphere.index = lightIndex;
+				if (sphere.z + sphere.r < nearZ_ || sphere.z - sphere.r > farZ_)
+				{
+					continue;
+				}
+				viewLights_.push_back(sphere);
+			}
+
+			// Bin every depth slice into its own scratch (slices never share clusters).
+			slices_.resize(grid_.z);
+			jobs::ParallelFor(scheduler, grid_.z, 1, [this](std::size_t begin, std::size_t end)
+				{
+					for (std::size_t slice = begin; slice < end; ++slice)
+					{
+						BinSlice_(static_cast<std::uint32_t>(slice));
+					}
+				});
+
+			// Merge in cluster order: global list first, then each cluster's list.
+			std::uint32_t budget = maxIndices_;
+			const auto globalCount = std::min<std::uint32_t>(static_cast<std::uint32_t>(globalLights_.size()), budget);
+			stats_.overflowed = globalCount < globalLights_.size();
+			words_[kHeaderGlobalOffset] = static_cast<std::uint32_t>(words_.size());
+			words_[kHeaderGlobalCount] = globalCount;
+			words_.insert(words_.end(), globalLights_.begin(), globalLights_.begin() + globalCount);
+			budget -= globalCount;
+			stats_.globalLights = globalCount;
+
+			for (std::uint32_t slice = 0; slice < grid_.z; ++slice)
+			{
+				const SliceScratch_& scratch = slices_[slice];
+				for (std::uint32_t tile = 0; tile < tilesPerSlice; ++tile)
+				{
+					const std::uint32_t first = scratch.offsets[tile];
+					const std::uint32_t available = scratch.offsets[tile + 1] - first;
+					const std::uint32_t count = std::min(available, budget);
+					stats_.overflowed = stats_.overflowed || count < available;
+					stats_.maxClusterLights = std::max(stats_.maxClusterLights, count);
+
+					const std::size_t cluster = static_cast<std::size_t>(slice) * tilesPerSlice + tile;
+					words_[kHeaderWords + cluster * 2 + 0] = static_cast<std::uint32_t>(words_.size());
+					words_[kHeaderWords + cluster * 2 + 1] = count;
+					words_.insert(words_.end(), scratch.lights.begin() + first, scratch.lights.begin() + first + count);
+					budget -= count;
+				}
+			}
+			stats_.indexCount = maxIndices_ - budget;
+		}
+
+		// Header, cluster table and lists; upload as a StructuredBuffer<uint>.
+		[[nodiscard]] std::span<const std::uint32_t> Words() const noexcept { return words_; }
+		[[nodiscard]] const Stats& GetStats() const noexcept { return stats_; }
+
+		[[nodiscard]] std::span<const std::uint32_t> GlobalLights() const noexcept
+		{
+			return ListAt_(words_[kHeaderGlobalOffset], words_[kHeaderGlobalCount]);
+		}
+
+		// Lights binned into cluster (x, y, z); global lights are not repeated here.
+		[[nodiscard]] std::span<const std::uint32_t> ClusterLights(std::uint32_t x, std::uint32_t y, std::uint32_t z) const noexcept
+		{
+			if (words_[kHeaderEnabled] == 0u || x >= grid_.x || y >= grid_.y || z >= grid_.z)
+			{
+				return {};
+			}
+			const std::size_t cluster = (static_cast<std::size_t>(z) * grid_.y + y) * grid_.x + x;
+			return ListAt_(words_[kHeaderWords + cluster * 2 + 0], words_[kHeaderWords + cluster * 2 + 1]);
+		}
+
+		// View depth where slice `slice` starts (slice grid.z ends at far).
+		[[nodiscard]] float SliceNearDepth(std::uint32_t slice) const noexcept
+		{
+			return nearZ_ * std::pow(farZ_ / nearZ_, static_cast<float>(slice) / static_cast<float>(grid_.z));
+		}
+
+	private:
+		struct ViewSphere_
+		{
+			float x{ 0.0f };
+			float y{ 0.0f };
+			float z{ 0.0f };
+			float r{ 0.0f };
+			std::uint32_t index{ 0 };
+		};
+
+		// Per depth slice: (tile, light) hits in light order, then the lights grouped per tile.
+		struct SliceScratch_
+		{
+			std::vector<std::uint32_t> hits;
+			std::vector<std::uint32_t> offsets;
+			std::vector<std::uint32_t> cursor;
+			std::vector<std::uint32_t> lights;
+		};
+
+		static LightClusterGrid SanitizeGrid_(LightClusterGrid grid) noexcept
+		{
+			grid.x = std::max(grid.x, 1u);
+			grid.y = std::max(grid.y, 1u);
+			grid.z = std::max(grid.z, 1u);
+			return grid;
+		}
+
+		std::span<const std::uint32_t> ListAt_(std::uint32_t offset, std::uint32_t count) const noexcept
+		{
+			if (offset > words_.size() || count > words_.size() - offset)
+			{
+				return {};
+			}
+			return std::span<const std::uint32_t>(words_).subspan(offset, count);
+		}
+
+		// Conservative [first, last] tile range covering view-space [lo, hi] over depths [z0, z1].
+		static bool TileRange_(float lo, float hi, float z0, float z1, float tanHalf, std::uint32_t tiles, std::uint32_t& first, std::uint32_t& last) noexcept
+		{
+			const float ndcLo = std::min(lo / z0, lo / z1) / tanHalf;
+			const float ndcHi = std::max(hi / z0, hi / z1) / tanHalf;
+			if (ndcHi < -1.0f || ndcLo > 1.0f)
+			{
+				return false;
+			}
+			const float scale = static_cast<float>(tiles) * 0.5f;
+			first = static_cast<std::uint32_t>(std::clamp((ndcLo + 1.0f) * scale, 0.0f, static_cast<float>(tiles - 1)));
+			last = static_cast<std::uint32_t>(std::clamp((ndcHi + 1.0f) * scale, 0.0f, static_cast<float>(tiles - 1)));
+			return true;
+		}
+
+		static float AxisDistance_(float v, float lo, float hi) noexcept
+		{
+			return (v < lo) ? (lo - v) : ((v > hi) ? (v - hi) : 0.0f);
+		}
+
+		void BinSlice_(std::uint32_t slice)
+		{
+			SliceScratch_& scratch = slices_[slice];
+			scratch.hits.clear();
+
+			const std::uint32_t tilesPerSlice = grid_.x * grid_.y;
+			const float z0 = SliceNearDepth(slice);
+			const float z1 = SliceNearDepth(slice + 1);
+
+			for (const ViewSphere_& light : viewLights_)
+			{
+				if (light.z + light.r < z0 || light.z - light.r > z1)
+				{
+					continue;
+				}
+
+				// Screen-space tile bounds of the sphere's box clipped to this slice.
+				const float lz0 = std::max(light.z - light.r, z0);
+				const float lz1 = std::min(light.z + light.r, z1);
+				std::uint32_t tx0 = 0, tx1 = 0, ty0 = 0, ty1 = 0;
+				if (!TileRange_(light.x - light.r, light.x + light.r, lz0, lz1, tanHalfX_, grid_.x, tx0, tx1) ||
+					!TileRange_(light.y - light.r, light.y + light.r, lz0, lz1, tanHalfY_, grid_.y, ty0, ty1))
+				{
+					continue;
+				}
+				// TileRange_ counts rows bottom-up; clusters count them from the top.
+				const std::uint32_t rowFirst = grid_.y - 1 - ty1;
+				const std::uint32_t rowLast = grid_.y - 1 - ty0;
+
+				const float r2 = light.r * light.r;
+				const float dz = AxisDistance_(light.z, z0, z1);
+				for (std::uint32_t row = rowFirst; row <= rowLast; ++row)
+				{
+					// View-space box of the cluster: the tile's frustum segment between z0 and z1.
+					const float ny1 = 1.0f - 2.0f * static_cast<float>(row) / static_cast<float>(grid_.y);
+					const float ny0 = 1.0f - 2.0f * static_cast<float>(row + 1) / static_cast<float>(grid_.y);
+					const float yLo = std::min(ny0 * tanHalfY_ * z0, ny0 * tanHalfY_ * z1);
+					const float yHi = std::max(ny1 * tanHalfY_ * z0, ny1 * tanHalfY_ * z1);
+					const float dy = AxisDistance_(light.y, yLo, yHi);
+
+					for (std::uint32_t column = tx0; column <= tx1; ++column)
+					{
+						const float nx0 = 2.0f * static_cast<float>(column) / static_cast<float>(grid_.x) - 1.0f;
+						const float nx1 = 2.0f * static_cast<float>(column + 1) / static_cast<float>(grid_.x) - 1.0f;
+						const float xLo = std::min(nx0 * tanHalfX_ * z0, nx0 * tanHalfX_ * z1);
+						const float xHi = std::max(nx1 * tanHalfX_ * z0, nx1 * tanHalfX_ * z1);
+						const float dx = AxisDistance_(light.x, xLo, xHi);
+
+						if (dx * dx + dy * dy + dz * dz <= r2)
+						{
+							scratch.hits.push_back(row * grid_.x + column);
+							scratch.hits.push_back(light.index);
+						}
+					}
+				}
+			}
+
+			// Stable counting sort of the hits by tile.
+			scratch.offsets.assign(tilesPerSlice + 1, 0u);
+			for (std::size_t hit = 0; hit < scratch.hits.size(); hit += 2)
+			{
+				++scratch.offsets[scratch.hits[hit] + 1];
+			}
+			for (std::uint32_t tile = 0; tile < tilesPerSlice; ++tile)
+			{
+				scratch.offsets[tile + 1] += scratch.offsets[tile];
+			}
+			scratch.lights.resize(scratch.hits.size() / 2);
+			scratch.cursor.assign(scratch.offsets.begin(), scratch.offsets.end() - 1);
+			for (std::size_t hit = 0; hit < scratch.hits.size(); hit += 2)
+			{
+				scratch.lights[scratch.cursor[scratch.hits[hit]]++] = scratch.hits[hit + 1];
+			}
+		}
+
+		LightClusterGrid grid_{};
+		std::uint32_t maxIndices_{ 0 };
+
+		float nearZ_{ 0.1f };
+		float farZ_{ 100.0f };
+		float tanHalfX_{ 1.0f };
+		float tanHalfY_{ 1.0f };
+
+		std::vector<std::uint32_t> words_;
+		std::vector<std::uint32_t> globalLights_;
+		std::vector<ViewSphere_> viewLights_;
+		std::vector<SliceScratch_> slices_;
+		Stats stats_{};
+	};
+}
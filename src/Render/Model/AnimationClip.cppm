@@ -1,14 +1,19 @@
 module;
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 export module core:animation_clip;
 
 import :math_utils;
+import :hash_utils;
 
 export namespace rendern
 {
@@ -30,6 +35,39 @@ export namespace rendern
 		mathUtils::Vec3 value{ 1.0f, 1.0f, 1.0f };
 	};
 
+	// Evenly spaced key times (baked / mocap tracks): the key index is computed from the time instead of
+	// searched. invStepTicks == 0 means the track is not uniform; keyCount guards against keys edited
+	// after BuildUniformKeyTiming ran.
+	struct UniformKeyTiming
+	{
+		float firstTicks{ 0.0f };
+		float invStepTicks{ 0.0f };
+		std::uint32_t keyCount{ 0u };
+	};
+
+	// One key of a compressed track: the time as a 16-bit fraction of the clip duration plus three 16-bit
+	// value words. 8 bytes, against 16 for a float translation/scale key and 32 for a rotation key.
+	struct PackedKey
+	{
+		std::uint16_t time{ 0u };
+		std::array<std::uint16_t, 3> value{};
+	};
+
+	// Translation/scale, each component range-reduced to rangeMin + value * rangeStep.
+	// A constant track is a single key.
+	struct PackedVec3Track
+	{
+		mathUtils::Vec3 rangeMin{ 0.0f, 0.0f, 0.0f };
+		mathUtils::Vec3 rangeStep{ 0.0f, 0.0f, 0.0f };
+		std::vector<PackedKey> keys;
+	};
+
+	// Rotation as smallest-three quaternions (PackQuatSmallestThree).
+	struct PackedRotationTrack
+	{
+		std::vector<PackedKey> keys;
+	};
+
 	struct BoneAnimationChannel
 	{
 		int boneIndex{ -1 };
@@ -37,6 +75,15 @@ export namespace rendern
 		std::vector<TranslationKey> translationKeys;
 		std::vector<RotationKey> rotationKeys;
 		std::vector<ScaleKey> scaleKeys;
+
+		UniformKeyTiming translationTiming{};
+		UniformKeyTiming rotationTiming{};
+		UniformKeyTiming scaleTiming{};
+
+		// Filled by CompressAnimationClip, which empties the float key vectors of the same track.
+		PackedVec3Track packedTranslation{};
+		PackedRotationTrack packedRotation{};
+		PackedVec3Track packedScale{};
 	};
 
 	struct AnimationClip
@@ -46,8 +93,31 @@ export namespace rendern
 		float ticksPerSecond{ 25.0f };
 		bool looping{ true };
 		std::vector<BoneAnimationChannel> channels;
+
+		// HashClipChannelLayout at the last RebuildClipChannelLayoutHash (0: not built). Keys the
+		// clip/skeleton binding tables (AnimationBindingCache).
+		std::uint64_t channelLayoutHash{ 0 };
 	};
 
+	// Channel targets (bone index, bone name) in channel order: clips with equal hashes bind the same
+	// way to any skeleton, whatever their keys.
+	[[nodiscard]] inline std::uint64_t HashClipChannelLayout(const AnimationClip& clip) noexcept
+	{
+		std::uint64_t hash = hashUtils::Mix64(clip.channels.size() ^ 0x636c6970ull);
+		for (const BoneAnimationChannel& channel : clip.channels)
+		{
+			hash = hashUtils::Mix64(hash ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(channel.boneIndex)));
+			hash = hashUtils::Mix64(hash ^ hashUtils::Fnv1a64(channel.boneName));
+		}
+		return hash;
+	}
+
+	// Call again after retargeting or reordering channels.
+	inline void RebuildClipChannelLayoutHash(AnimationClip& clip) noexcept
+	{
+		clip.channelLayoutHash = HashClipChannelLayout(clip);
+	}
+
 	[[nodiscard]] inline mathUtils::Vec4 NormalizeQuat(const mathUtils::Vec4& q) noexcept
 	{
 		const float len2 = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
@@ -86,26 +156,78 @@ export namespace rendern
 			a.w + (bb.w - a.w) * t));
 	}
 
+	// Smallest three: the largest component is dropped (and made positive by flipping the sign of q), the
+	// other three lie in [-1/sqrt(2), 1/sqrt(2)] and get 15 bits each. The index of the dropped component
+	// goes into the top bits of the first two words.
+	[[nodiscard]] inline std::array<std::uint16_t, 3> PackQuatSmallestThree(const mathUtils::Vec4& qIn) noexcept
+	{
+		constexpr float kRange = 0.70710678f;
+		constexpr float kMaxValue = 32767.0f;
+
+		mathUtils::Vec4 q = NormalizeQuat(qIn);
+		std::size_t largest = 0;
+		for (std::size_t i = 1; i < 4; ++i)
+		{
+			if (std::abs(q[i]) > std::abs(q[largest]))
+			{
+				largest = i;
+			}
+		}
+		if (q[largest] < 0.0f)
+		{
+			q = q * -1.0f;
+		}
+
+		std::array<std::uint16_t, 3> out{};
+		std::size_t word = 0;
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+			{
+				continue;
+			}
+			const float unit = std::clamp((q[i] + kRange) / (2.0f * kRange), 0.0f, 1.0f);
+			out[word++] = static_cast<std::uint16_t>(std::lround(unit * kMaxValue));
+		}
+		out[0] = static_cast<std::uint16_t>(out[0] | ((largest & 1u) << 15));
+		out[1] = static_cast<std::uint16_t>(out[1] | ((largest >> 1) << 15));
+		return out;
+	}
+
+	[[nodiscard]] inline mathUtils::Vec4 UnpackQuatSmallestThree(const std::array<std::uint16_t, 3>& packed) noexcept
+	{
+		constexpr float kRange = 0.70710678f;
+		constexpr float kScale = 2.0f * kRange / 32767.0f;
+
+		const std::size_t largest = static_cast<std::size_t>((packed[0] >> 15) | ((packed[1] >> 15) << 1));
+		mathUtils::Vec4 q{ 0.0f, 0.0f, 0.0f, 0.0f };
+		float sumSq = 0.0f;
+		std::size_t word = 0;
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+			{
+				continue;
+			}
+			const float c = static_cast<float>(packed[word++] & 0x7FFFu) * kScale - kRange;
+			q[i] = c;
+			sumSq += c * c;
+		}
+		q[largest] = std::sqrt(std::max(1.0f - sumSq, 0.0f));
+		return q;
+	}
+
+	[[nodiscard]] inline mathUtils::Vec3 UnpackVec3Key(const PackedVec3Track& track, const PackedKey& key) noexcept
+	{
+		return mathUtils::Vec3(
+			track.rangeMin.x + track.rangeStep.x * static_cast<float>(key.value[0]),
+			track.rangeMin.y + track.rangeStep.y * static_cast<float>(key.value[1]),
+			track.rangeMin.z + track.rangeStep.z * static_cast<float>(key.value[2]));
+	}
+
 	[[nodiscard]] inline mathUtils::Mat4 QuatToMat4(const mathUtils::Vec4& qIn) noexcept
 	{
-		const mathUtils::Vec4 q = NormalizeQuat(qIn);
-
-		const float xx = q.x * q.x;
-		const float yy = q.y * q.y;
-		const float zz = q.z * q.z;
-		const float xy = q.x * q.y;
-		const float xz = q.x * q.z;
-		const float yz = q.y * q.z;
-		const float wx = q.w * q.x;
-		const float wy = q.w * q.y;
-		const float wz = q.w * q.z;
-
-		mathUtils::Mat4 m(1.0f);
-		m[0] = mathUtils::Vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f);
-		m[1] = mathUtils::Vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f);
-		m[2] = mathUtils::Vec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f);
-		m[3] = mathUtils::Vec4(0.0f, 0.0f, 0.0f, 1.0f);
-		return m;
+		return mathUtils::QuatToMat4(NormalizeQuat(qIn));
 	}
 
 	[[nodiscard]] inline mathUtils::Mat4 ComposeTRS(
@@ -113,7 +235,7 @@ export namespace rendern
 		const mathUtils::Vec4& rotation,
 		const mathUtils::Vec3& scale) noexcept
 	{
-		mathUtils::Mat4 m = QuatToMat4(rotation);
+		mathUtils::Mat4 m = rendern::QuatToMat4(rotation);
 		m[0] = m[0] * scale.x;
 		m[1] = m[1] * scale.y;
 		m[2] = m[2] * scale.z;
@@ -242,49 +364,155 @@ export namespace rendern
 		return std::clamp(timeSeconds, 0.0f, durationSeconds);
 	}
 
+	[[nodiscard]] constexpr float KeyTimeOf(const TranslationKey& key) noexcept { return key.timeTicks; }
+	[[nodiscard]] constexpr float KeyTimeOf(const RotationKey& key) noexcept { return key.timeTicks; }
+	[[nodiscard]] constexpr float KeyTimeOf(const ScaleKey& key) noexcept { return key.timeTicks; }
+	// Packed keys are searched in packed time units (ToPackedKeyTime).
+	[[nodiscard]] constexpr float KeyTimeOf(const PackedKey& key) noexcept { return static_cast<float>(key.time); }
+
+	inline constexpr float kPackedKeyTimeMax = 65535.0f;
+
+	[[nodiscard]] inline float ToPackedKeyTime(float timeTicks, float durationTicks) noexcept
+	{
+		return (durationTicks > 0.0f) ? std::clamp(timeTicks / durationTicks, 0.0f, 1.0f) * kPackedKeyTimeMax : 0.0f;
+	}
+
+	template <typename KeyT>
+	[[nodiscard]] inline UniformKeyTiming DetectUniformKeyTiming(const std::vector<KeyT>& keys) noexcept
+	{
+		if (keys.size() < 3)
+		{
+			return {};
+		}
+
+		const float first = keys.front().timeTicks;
+		const float step = (keys.back().timeTicks - first) / static_cast<float>(keys.size() - 1);
+		if (!(step > 1e-6f))
+		{
+			return {};
+		}
+
+		const float tolerance = step * 1e-3f;
+		for (std::size_t i = 1; i + 1 < keys.size(); ++i)
+		{
+			if (std::abs(keys[i].timeTicks - (first + step * static_cast<float>(i))) > tolerance)
+			{
+				return {};
+			}
+		}
+
+		return UniformKeyTiming{ .firstTicks = first, .invStepTicks = 1.0f / step, .keyCount = static_cast<std::uint32_t>(keys.size()) };
+	}
+
+	// Call after the keys of a clip are loaded or changed.
+	inline void BuildUniformKeyTiming(AnimationClip& clip) noexcept
+	{
+		for (BoneAnimationChannel& channel : clip.channels)
+		{
+			channel.translationTiming = DetectUniformKeyTiming(channel.translationKeys);
+			channel.rotationTiming = DetectUniformKeyTiming(channel.rotationKeys);
+			channel.scaleTiming = DetectUniformKeyTiming(channel.scaleKeys);
+		}
+	}
+
+	// Index i of the key pair with keys[i].timeTicks <= timeTicks < keys[i + 1].timeTicks, for
+	// keys.front().timeTicks < timeTicks < keys.back().timeTicks. Uniform tracks compute it directly.
+	// Otherwise the cursor (the pair found last time) is tried first, then the pair after it, which
+	// covers forward playback; anything else (seeks, loop wrap) falls back to a binary search.
+	template <typename KeyT>
+	[[nodiscard]] inline std::size_t FindKeyPair(
+		const std::vector<KeyT>& keys,
+		float timeTicks,
+		const UniformKeyTiming& timing,
+		std::uint32_t& cursor) noexcept
+	{
+		const std::size_t lastPair = keys.size() - 2;
+
+		if (timing.invStepTicks > 0.0f && timing.keyCount == keys.size())
+		{
+			std::size_t i = static_cast<std::size_t>(std::max((timeTicks - timing.firstTicks) * timing.invStepTicks, 0.0f));
+			i = std::min(i, lastPair);
+			// Rounding can land one pair off.
+			if (i > 0 && timeTicks < KeyTimeOf(keys[i]))
+			{
+				--i;
+			}
+			else if (i < lastPair && timeTicks >= KeyTimeOf(keys[i + 1]))
+			{
+				++i;
+			}
+			cursor = static_cast<std::uint32_t>(i);
+			return i;
+		}
+
+		const std::size_t c = cursor;
+		if (c <= lastPair && KeyTimeOf(keys[c]) <= timeTicks)
+		{
+			if (timeTicks < KeyTimeOf(keys[c + 1]))
+			{
+				return c;
+			}
+			if (c < lastPair && timeTicks < KeyTimeOf(keys[c + 2]))
+			{
+				cursor = static_cast<std::uint32_t>(c + 1);
+				return c + 1;
+			}
+		}
+
+		const auto upper = std::upper_bound(keys.begin(), keys.end(), timeTicks,
+			[](float t, const KeyT& key) noexcept { return t < KeyTimeOf(key); });
+		const std::size_t i = std::min(static_cast<std::size_t>(std::max<std::ptrdiff_t>(upper - keys.begin() - 1, 0)), lastPair);
+		cursor = static_cast<std::uint32_t>(i);
+		return i;
+	}
+
 	template <typename KeyT, typename ValueT, typename AccessFn>
 	[[nodiscard]] inline ValueT SampleKeys(
 		const std::vector<KeyT>& keys,
 		float timeTicks,
 		const ValueT& fallback,
-		AccessFn&& access)
+		AccessFn&& access,
+		const UniformKeyTiming& timing,
+		std::uint32_t& cursor)
 	{
 		if (keys.empty())
 		{
 			return fallback;
 		}
-		if (keys.size() == 1 || timeTicks <= keys.front().timeTicks)
+		if (keys.size() == 1 || timeTicks <= KeyTimeOf(keys.front()))
 		{
 			return access(keys.front());
 		}
-		if (timeTicks >= keys.back().timeTicks)
+		if (timeTicks >= KeyTimeOf(keys.back()))
 		{
 			return access(keys.back());
 		}
 
-		for (std::size_t i = 0; i + 1 < keys.size(); ++i)
-		{
-			const KeyT& a = keys[i];
-			const KeyT& b = keys[i + 1];
-			if (timeTicks < a.timeTicks || timeTicks > b.timeTicks)
-			{
-				continue;
-			}
-
-			const float dt = b.timeTicks - a.timeTicks;
-			const float t = (dt > 1e-8f) ? ((timeTicks - a.timeTicks) / dt) : 0.0f;
+		const std::size_t i = FindKeyPair(keys, timeTicks, timing, cursor);
+		const KeyT& a = keys[i];
+		const KeyT& b = keys[i + 1];
+		const float dt = KeyTimeOf(b) - KeyTimeOf(a);
+		const float t = (dt > 1e-8f) ? std::clamp((timeTicks - KeyTimeOf(a)) / dt, 0.0f, 1.0f) : 0.0f;
 
-			if constexpr (std::is_same_v<ValueT, mathUtils::Vec4>)
-			{
-				return NlerpQuat(access(a), access(b), t);
-			}
-			else
-			{
-				return mathUtils::Lerp(access(a), access(b), t);
-			}
+		if constexpr (std::is_same_v<ValueT, mathUtils::Vec4>)
+		{
+			return NlerpQuat(access(a), access(b), t);
+		}
+		else
+		{
+			return mathUtils::Lerp(access(a), access(b), t);
 		}
+	}
 
-		return access(keys.back());
+	template <typename KeyT, typename ValueT, typename AccessFn>
+	[[nodiscard]] inline ValueT SampleKeys(
+		const std::vector<KeyT>& keys,
+		float timeTicks,
+		const ValueT& fallback,
+		AccessFn&& access)
+	{
+		std::uint32_t cursor = 0u;
+		return SampleKeys<KeyT, ValueT>(keys, timeTicks, fallback, std::forward<AccessFn>(access), UniformKeyTiming{}, cursor);
 	}
 
 	[[nodiscard]] inline mathUtils::Vec3 SampleTranslationKeys(
@@ -299,6 +527,22 @@ export namespace rendern
 			[](const TranslationKey& key) noexcept { return key.value; });
 	}
 
+	[[nodiscard]] inline mathUtils::Vec3 SampleTranslationKeys(
+		const std::vector<TranslationKey>& keys,
+		float timeTicks,
+		const mathUtils::Vec3& fallback,
+		const UniformKeyTiming& timing,
+		std::uint32_t& cursor)
+	{
+		return SampleKeys<TranslationKey, mathUtils::Vec3>(
+			keys,
+			timeTicks,
+			fallback,
+			[](const TranslationKey& key) noexcept { return key.value; },
+			timing,
+			cursor);
+	}
+
 	[[nodiscard]] inline mathUtils::Vec4 SampleRotationKeys(
 		const std::vector<RotationKey>& keys,
 		float timeTicks,
@@ -311,6 +555,22 @@ export namespace rendern
 			[](const RotationKey& key) noexcept { return key.value; });
 	}
 
+	[[nodiscard]] inline mathUtils::Vec4 SampleRotationKeys(
+		const std::vector<RotationKey>& keys,
+		float timeTicks,
+		const mathUtils::Vec4& fallback,
+		const UniformKeyTiming& timing,
+		std::uint32_t& cursor)
+	{
+		return SampleKeys<RotationKey, mathUtils::Vec4>(
+			keys,
+			timeTicks,
+			fallback,
+			[](const RotationKey& key) noexcept { return key.value; },
+			timing,
+			cursor);
+	}
+
 	[[nodiscard]] inline mathUtils::Vec3 SampleScaleKeys(
 		const std::vector<ScaleKey>& keys,
 		float timeTicks,
@@ -322,4 +582,83 @@ export namespace rendern
 			fallback,
 			[](const ScaleKey& key) noexcept { return key.value; });
 	}
-}
\ No newline at end of file
+
+	[[nodiscard]] inline mathUtils::Vec3 SampleScaleKeys(
+		const std::vector<ScaleKey>& keys,
+		float timeTicks,
+		const mathUtils::Vec3& fallback,
+		const UniformKeyTiming& timing,
+		std::uint32_t& cursor)
+	{
+		return SampleKeys<ScaleKey, mathUtils::Vec3>(
+			keys,
+			timeTicks,
+			fallback,
+			[](const ScaleKey& key) noexcept { return key.value; },
+			timing,
+			cursor);
+	}
+
+	// Channel samplers: the packed track when the clip was compressed, the float keys otherwise.
+	[[nodiscard]] inline mathUtils::Vec3 SampleChannelTranslation(
+		const BoneAnimationChannel& channel,
+		float timeTicks,
+		float durationTicks,
+		const mathUtils::Vec3& fallback,
+		std::uint32_t& cursor)
+	{
+		if (channel.packedTranslation.keys.empty())
+		{
+			return SampleTranslationKeys(channel.translationKeys, timeTicks, fallback, channel.translationTiming, cursor);
+		}
+		const PackedVec3Track& track = channel.packedTranslation;
+		return SampleKeys<PackedKey, mathUtils::Vec3>(
+			track.keys,
+			ToPackedKeyTime(timeTicks, durationTicks),
+			fallback,
+			[&track](const PackedKey& key) noexcept { return UnpackVec3Key(track, key); },
+			UniformKeyTiming{},
+			cursor);
+	}
+
+	[[nodiscard]] inline mathUtils::Vec4 SampleChannelRotation(
+		const BoneAnimationChannel& channel,
+		float timeTicks,
+		float durationTicks,
+		const mathUtils::Vec4& fallback,
+		std::uint32_t& cursor)
+	{
+		if (channel.packedRotation.keys.empty())
+		{
+			return SampleRotationKeys(channel.rotationKeys, timeTicks, fallback, channel.rotationTiming, cursor);
+		}
+		return SampleKeys<PackedKey, mathUtils::Vec4>(
+			channel.packedRotation.keys,
+			ToPackedKeyTime(timeTicks, durationTicks),
+			fallback,
+			[](const PackedKey& key) noexcept { return UnpackQuatSmallestThree(key.value); },
+			UniformKeyTiming{},
+			cursor);
+	}
+
+	[[nodiscard]] inline mathUtils::Vec3 SampleChannelScale(
+		const BoneAnimationChannel& channel,
+		float timeTicks,
+		float durationTicks,
+		const mathUtils::Vec3& fallback,
+		std::uint32_t& cursor)
+	{
+		if (channel.packedScale.keys.empty())
+		{
+			return SampleScaleKeys(channel.scaleKeys, timeTicks, fallback, channel.scaleTiming, cursor);
+		}
+		const PackedVec3Track& track = channel.packedScale;
+		return SampleKeys<PackedKey, mathUtils::Vec3>(
+			track.keys,
+			ToPackedKeyTime(timeTicks, durationTicks),
+			fallback,
+			[&track](const PackedKey& key) noexcept { return UnpackVec3Key(track, key); },
+			UniformKeyTiming{},
+			cursor);
+	}
+}
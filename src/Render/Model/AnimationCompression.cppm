@@ -0,0 +1,226 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+export module core:animation_compression;
+
+import :animation_clip;
+import :math_utils;
+
+// Compressed animation clips: every track is first reduced to the keys that linear interpolation
+// (nlerp for rotations) cannot reproduce within a tolerance, tracks that never leave the tolerance of
+// their first key collapse to one key, and the surviving keys are quantized into PackedKeys (16-bit
+// time, range-reduced 16-bit translation/scale, smallest-three rotation). The sampler decodes packed
+// keys directly (SampleChannelTranslation/Rotation/Scale), so compression is a load-time step.
+
+export namespace rendern
+{
+	struct AnimationCompressionSettings
+	{
+		float translationTolerance{ 1e-3f };      // model units
+		float rotationToleranceRadians{ 1e-3f };
+		float scaleTolerance{ 1e-3f };
+	};
+
+	namespace detail
+	{
+		// Longest run of keys one interpolated segment may replace; bounds the O(n^2) reduction.
+		inline constexpr std::size_t kMaxReducedRun = 256;
+
+		[[nodiscard]] inline bool Vec3WithinTolerance(const mathUtils::Vec3& a, const mathUtils::Vec3& b, float tolerance) noexcept
+		{
+			return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance;
+		}
+
+		[[nodiscard]] inline bool QuatWithinTolerance(const mathUtils::Vec4& a, const mathUtils::Vec4& b, float cosHalfTolerance) noexcept
+		{
+			return std::abs(DotQuat(NormalizeQuat(a), NormalizeQuat(b))) >= cosHalfTolerance;
+		}
+
+		// Indices of the keys to keep: always the first and last, plus every key the segment between its
+		// kept neighbours would miss by more than the tolerance. Single key when the whole track is constant.
+		template <typename KeyT, typename InterpolateFn, typename WithinFn>
+		[[nodiscard]] std::vector<std::size_t> ReduceKeys(
+			const std::vector<KeyT>& keys,
+			InterpolateFn&& interpolate,
+			WithinFn&& within)
+		{
+			std::vector<std::size_t> kept;
+			if (keys.empty())
+			{
+				return kept;
+			}
+
+			kept.push_back(0);
+			const bool constant = std::all_of(keys.begin(), keys.end(),
+				[&](const KeyT& key) { return within(key.value, keys.front().value); });
+			if (constant)
+			{
+				return kept;
+			}
+
+			std::size_t anchor = 0;
+			for (std::size_t next = 2; next < keys.size(); ++next)
+			{
+				const KeyT& a = keys[anchor];
+				const KeyT& b = keys[next];
+				const float span = b.timeTicks - a.timeTicks;
+
+				bool fits = (next - anchor) <= kMaxReducedRun && span > 1e-8f;
+				for (std::size_t k = anchor + 1; fits && k < next; ++k)
+				{
+					const float t = (keys[k].timeTicks - a.timeTicks) / span;
+					fits = within(interpolate(a.value, b.value, t), keys[k].value);
+				}
+
+				if (!fits)
+				{
+					anchor = next - 1;
+					kept.push_back(anchor);
+				}
+			}
+			kept.push_back(keys.size() - 1);
+			return kept;
+		}
+
+		[[nodiscard]] inline std::uint16_t PackKeyTime(float timeTicks, float durationTicks) noexcept
+		{
+			return static_cast<std::uint16_t>(std::lround(ToPackedKeyTime(timeTicks, durationTicks)));
+		}
+
+		// Appends unless the key lands on the packed time of the previous one (keys closer than
+		// duration / 65535); the later key wins then.
+		inline void AppendPackedKey(std::vector<PackedKey>& keys, const PackedKey& key)
+		{
+			if (!keys.empty() && keys.back().time == key.time)
+			{
+				keys.back() = key;
+				return;
+			}
+			keys.push_back(key);
+		}
+
+		template <typename KeyT>
+		[[nodiscard]] PackedVec3Track PackVec3Track(
+			const std::vector<KeyT>& keys,
+			const std::vector<std::size_t>& kept,
+			float durationTicks)
+		{
+			PackedVec3Track track{};
+			if (kept.empty())
+			{
+				return track;
+			}
+
+			mathUtils::Vec3 lo = keys[kept.front()].value;
+			mathUtils::Vec3 hi = lo;
+			for (const std::size_t index : kept)
+			{
+				for (std::size_t c = 0; c < 3; ++c)
+				{
+					lo[c] = std::min(lo[c], keys[index].value[c]);
+					hi[c] = std::max(hi[c], keys[index].value[c]);
+				}
+			}
+
+			track.rangeMin = lo;
+			for (std::size_t c = 0; c < 3; ++c)
+			{
+				track.rangeStep[c] = (hi[c] - lo[c]) / 65535.0f;
+			}
+
+			track.keys.reserve(kept.size());
+			for (const std::size_t index : kept)
+			{
+				PackedKey packed{};
+				packed.time = PackKeyTime(keys[index].timeTicks, durationTicks);
+				for (std::size_t c = 0; c < 3; ++c)
+				{
+					const float unit = (track.rangeStep[c] > 0.0f) ? (keys[index].value[c] - lo[c]) / track.rangeStep[c] : 0.0f;
+					packed.value[c] = static_cast<std::uint16_t>(std::clamp(std::lround(unit), 0l, 65535l));
+				}
+				AppendPackedKey(track.keys, packed);
+			}
+			return track;
+		}
+	}
+
+	// Replaces the float keys of every track with a packed track. Tracks without keys stay empty (the
+	// sampler keeps the bind pose for them). Clips already compressed are left alone.
+	inline void CompressAnimationClip(AnimationClip& clip, const AnimationCompressionSettings& settings = {})
+	{
+		const float cosHalfRotationTolerance = std::cos(0.5f * settings.rotationToleranceRadians);
+		const auto lerp3 = [](const mathUtils::Vec3& a, const mathUtils::Vec3& b, float t) { return mathUtils::Lerp(a, b, t); };
+
+		for (BoneAnimationChannel& channel : clip.channels)
+		{
+			if (!channel.translationKeys.empty())
+			{
+				const std::vector<std::size_t> kept = detail::ReduceKeys(channel.translationKeys, lerp3,
+					[&](const mathUtils::Vec3& a, const mathUtils::Vec3& b)
+					{
+						return detail::Vec3WithinTolerance(a, b, settings.translationTolerance);
+					});
+				channel.packedTranslation = detail::PackVec3Track(channel.translationKeys, kept, clip.durationTicks);
+				channel.translationKeys = {};
+				channel.translationTiming = {};
+			}
+
+			if (!channel.scaleKeys.empty())
+			{
+				const std::vector<std::size_t> kept = detail::ReduceKeys(channel.scaleKeys, lerp3,
+					[&](const mathUtils::Vec3& a, const mathUtils::Vec3& b)
+					{
+						return detail::Vec3WithinTolerance(a, b, settings.scaleTolerance);
+					});
+				channel.packedScale = detail::PackVec3Track(channel.scaleKeys, kept, clip.durationTicks);
+				channel.scaleKeys = {};
+				channel.scaleTiming = {};
+			}
+
+			if (!channel.rotationKeys.empty())
+			{
+				const std::vector<std::size_t> kept = detail::ReduceKeys(channel.rotationKeys,
+					[](const mathUtils::Vec4& a, const mathUtils::Vec4& b, float t) { return NlerpQuat(a, b, t); },
+					[&](const mathUtils::Vec4& a, const mathUtils::Vec4& b)
+					{
+						return detail::QuatWithinTolerance(a, b, cosHalfRotationTolerance);
+					});
+
+				PackedRotationTrack track{};
+				track.keys.reserve(kept.size());
+				for (const std::size_t index : kept)
+				{
+					const RotationKey& key = channel.rotationKeys[index];
+					detail::AppendPackedKey(track.keys, PackedKey{
+						.time = detail::PackKeyTime(key.timeTicks, clip.durationTicks),
+						.value = PackQuatSmallestThree(key.value) });
+				}
+				channel.packedRotation = std::move(track);
+				channel.rotationKeys = {};
+				channel.rotationTiming = {};
+			}
+		}
+	}
+
+	// Heap bytes held by the key data of a clip (float and packed tracks), for memory stats.
+	[[nodiscard]] inline std::size_t AnimationClipKeyBytes(const AnimationClip& clip) noexcept
+	{
+		std::size_t bytes = 0;
+		for (const BoneAnimationChannel& channel : clip.channels)
+		{
+			bytes += channel.translationKeys.capacity() * sizeof(TranslationKey);
+			bytes += channel.rotationKeys.capacity() * sizeof(RotationKey);
+			bytes += channel.scaleKeys.capacity() * sizeof(ScaleKey);
+			bytes += channel.packedTranslation.keys.capacity() * sizeof(PackedKey);
+			bytes += channel.packedRotation.keys.capacity() * sizeof(PackedKey);
+			bytes += channel.packedScale.keys.capacity() * sizeof(PackedKey);
+		}
+		return bytes;
+	}
+}
@@ -398,6 +398,7 @@ namespace
             clip.channels.push_back(std::move(dst));
         }
 
+        rendern::BuildUniformKeyTiming(clip);
         return clip;
     }
 
@@ -452,9 +453,10 @@ namespace
 
             const std::size_t boneIndex = static_cast<std::size_t>(channel.boneIndex);
             BindTRS sampled = bindTrs[boneIndex];
-            sampled.translation = rendern::SampleTranslationKeys(channel.translationKeys, timeTicks, sampled.translation);
-            sampled.rotation = rendern::SampleRotationKeys(channel.rotationKeys, timeTicks, sampled.rotation);
-            sampled.scale = rendern::SampleScaleKeys(channel.scaleKeys, timeTicks, sampled.scale);
+            std::uint32_t cursor = 0u;
+            sampled.translation = rendern::SampleTranslationKeys(channel.translationKeys, timeTicks, sampled.translation, channel.translationTiming, cursor);
+            sampled.rotation = rendern::SampleRotationKeys(channel.rotationKeys, timeTicks, sampled.rotation, channel.rotationTiming, cursor);
+            sampled.scale = rendern::SampleScaleKeys(channel.scaleKeys, timeTicks, sampled.scale, channel.scaleTiming, cursor);
             localPose[boneIndex] = rendern::ComposeTRS(sampled.translation, sampled.rotation, sampled.scale);
         }
 
@@ -0,0 +1,238 @@
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+export module core:cooked_animation;
+
+import :animation_clip;
+import :cooked_mesh;
+import :file_system;
+
+// Cooked animation clips (.cclip): every clip imported from one source file, serialized as
+// length-prefixed records with the key arrays stored as raw blobs. Bone indices are kept as
+// imported, so a .cclip is only meaningful for the skeleton of the source it came from;
+// bone names travel along for rebinding against another skeleton.
+
+export namespace rendern
+{
+	inline constexpr std::uint32_t kCookedClipsMagic = 0x504C4343u; // "CCLP"
+	inline constexpr std::uint32_t kCookedClipsVersion = 1u;
+
+	static_assert(std::is_trivially_copyable_v<TranslationKey>);
+	static_assert(std::is_trivially_copyable_v<RotationKey>);
+	static_assert(std::is_trivially_copyable_v<ScaleKey>);
+
+	struct CookedClipsHeader
+	{
+		std::uint32_t magic{ kCookedClipsMagic };
+		std::uint32_t version{ kCookedClipsVersion };
+		std::uint64_t cookKey{ 0 };
+		std::uint64_t clipCount{ 0 };
+	};
+
+	std::filesystem::path CookedClipsPath(std::uint64_t cookKey)
+	{
+		return corefs::CookedCacheRoot() / "clips" / (CookKeyHex(cookKey) + ".cclip");
+	}
+
+	// Same temp-file + rename scheme as WriteCookedMesh. Only float keys are cooked: compress clips after
+	// loading them, not before writing.
+	void WriteCookedClips(const std::filesystem::path& path, std::uint64_t cookKey, std::span<const AnimationClip> clips)
+	{
+		for (const AnimationClip& clip : clips)
+		{
+			for (const BoneAnimationChannel& channel : clip.channels)
+			{
+				if (!channel.packedTranslation.keys.empty() || !channel.packedRotation.keys.empty() || !channel.packedScale.keys.empty())
+				{
+					throw std::runtime_error("Cannot cook compressed animation clip: " + clip.name);
+				}
+			}
+		}
+
+		std::filesystem::create_directories(path.parent_path());
+		std::filesystem::path tmpPath = path;
+		tmpPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+		{
+			std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+			if (!out)
+			{
+				throw std::runtime_error("Failed to create cooked clips: " + tmpPath.string());
+			}
+
+			const auto Write = [&out](const void* data, std::size_t size)
+				{
+					out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+				};
+			const auto WriteU64 = [&Write](std::uint64_t v) { Write(&v, sizeof(v)); };
+			const auto WriteString = [&](const std::string& s)
+				{
+					WriteU64(s.size());
+					Write(s.data(), s.size());
+				};
+			const auto WriteKeys = [&](const auto& keys)
+				{
+					WriteU64(keys.size());
+					Write(keys.data(), keys.size() * sizeof(keys[0]));
+				};
+
+			CookedClipsHeader header{};
+			header.cookKey = cookKey;
+			header.clipCount = clips.size();
+			Write(&header, sizeof(header));
+
+			for (const AnimationClip& clip : clips)
+			{
+				WriteString(clip.name);
+				Write(&clip.durationTicks, sizeof(clip.durationTicks));
+				Write(&clip.ticksPerSecond, sizeof(clip.ticksPerSecond));
+				const std::uint32_t looping = clip.looping ? 1u : 0u;
+				Write(&looping, sizeof(looping));
+
+				WriteU64(clip.channels.size());
+				for (const BoneAnimationChannel& channel : clip.channels)
+				{
+					const std::int32_t boneIndex = channel.boneIndex;
+					Write(&boneIndex, sizeof(boneIndex));
+					WriteString(channel.boneName);
+					WriteKeys(channel.translationKeys);
+					WriteKeys(channel.rotationKeys);
+					WriteKeys(channel.scaleKeys);
+				}
+			}
+
+			if (!out)
+			{
+				out.close();
+				std::error_code ec;
+				std::filesystem::remove(tmpPath, ec);
+				throw std::runtime_error("Failed to write cooked clips: " + tmpPath.string());
+			}
+		}
+
+		std::filesystem::rename(tmpPath, path);
+	}
+
+	// Returns nullopt if the file is missing, stale or malformed.
+	std::optional<std::vector<AnimationClip>> ReadCookedClips(const std::filesystem::path& path, std::optional<std::uint64_t> expectedCookKey)
+	{
+		std::error_code ec;
+		if (!std::filesystem::is_regular_file(path, ec))
+		{
+			return std::nullopt;
+		}
+
+		std::optional<corefs::MappedFile> file;
+		try
+		{
+			file.emplace(path);
+		}
+		catch (const std::exception&)
+		{
+			return std::nullopt;
+		}
+
+		const std::span<const std::byte> bytes = file->Bytes();
+		std::size_t offset = 0;
+		const auto Read = [&](void* dst, std::size_t size)
+			{
+				if (bytes.size() - offset < size)
+				{
+					return false;
+				}
+				if (size == 0)
+				{
+					return true;
+				}
+				std::memcpy(dst, bytes.data() + offset, size);
+				offset += size;
+				return true;
+			};
+		const auto ReadU64 = [&](std::uint64_t& v) { return Read(&v, sizeof(v)); };
+		const auto ReadString = [&](std::string& s)
+			{
+				std::uint64_t size = 0;
+				if (!ReadU64(size) || size > bytes.size() - offset)
+				{
+					return false;
+				}
+				s.resize(static_cast<std::size_t>(size));
+				return Read(s.data(), s.size());
+			};
+		const auto ReadKeys = [&](auto& keys)
+			{
+				std::uint64_t count = 0;
+				if (!ReadU64(count) || count > (bytes.size() - offset) / sizeof(keys[0]))
+				{
+					return false;
+				}
+				keys.resize(static_cast<std::size_t>(count));
+				return Read(keys.data(), keys.size() * sizeof(keys[0]));
+			};
+
+		CookedClipsHeader header{};
+		if (!Read(&header, sizeof(header)) ||
+			header.magic != kCookedClipsMagic ||
+			header.version != kCookedClipsVersion ||
+			(expectedCookKey && header.cookKey != *expectedCookKey))
+		{
+			return std::nullopt;
+		}
+
+		std::vector<AnimationClip> clips;
+		for (std::uint64_t c = 0; c < header.clipCount; ++c)
+		{
+			AnimationClip clip{};
+			std::uint32_t looping = 0;
+			std::uint64_t channelCount = 0;
+			if (!ReadString(clip.name) ||
+				!Read(&clip.durationTicks, sizeof(clip.durationTicks)) ||
+				!Read(&clip.ticksPerSecond, sizeof(clip.ticksPerSecond)) ||
+				!Read(&looping, sizeof(looping)) ||
+				!ReadU64(channelCount))
+			{
+				return std::nullopt;
+			}
+			clip.looping = looping != 0u;
+
+			for (std::uint64_t i = 0; i < channelCount; ++i)
+			{
+				BoneAnimationChannel channel{};
+				std::int32_t boneIndex = -1;
+				if (!Read(&boneIndex, sizeof(boneIndex)) ||
+					!ReadString(channel.boneName) ||
+					!ReadKeys(channel.translationKeys) ||
+					!ReadKeys(channel.rotationKeys) ||
+					!ReadKeys(channel.scaleKeys))
+				{
+					return std::nullopt;
+				}
+				channel.boneIndex = boneIndex;
+				clip.channels.push_back(std::move(channel));
+			}
+			BuildUniformKeyTiming(clip);
+			RebuildClipChannelLayoutHash(clip);
+			clips.push_back(std::move(clip));
+		}
+
+		if (offset != bytes.size())
+		{
+			return std::nullopt;
+		}
+		return clips;
+	}
+}
@@ -0,0 +1,268 @@
+module;
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+export module core:cooked_mesh;
+
+import :mesh;
+import :file_system;
+import :hash_utils;
+
+// Cooked binary mesh (.cmesh): a fixed header followed by the vertex and index blobs laid out
+// exactly like MeshCPU (VertexDesc with baked tangents, uint32 indices; with levels of detail the
+// index blob holds every level and the header their ranges), already in OptimizeMesh order. Loading maps the file
+// and hands spans into the mapping to the upload, so neither OBJ/FBX parsing nor tangent
+// generation runs once a mesh has been cooked.
+//
+// Files live in a content-addressed cache: the name is the cook key (source bytes + import
+// settings + format version), and the header repeats it so a truncated or foreign file is
+// rejected instead of uploaded.
+
+export namespace rendern
+{
+	inline constexpr std::uint32_t kCookedMeshMagic = 0x48534D43u; // "CMSH"
+	inline constexpr std::uint32_t kCookedMeshVersion = 3u;
+	inline constexpr std::uint64_t kCookedMeshBlobAlignment = 16u;
+
+	static_assert(std::endian::native == std::endian::little, ".cmesh blobs are stored in host (little-endian) order");
+	static_assert(std::is_trivially_copyable_v<VertexDesc>);
+
+	// Local-space bounds (same meaning as rendern::MeshBounds, stored as plain floats).
+	struct CookedMeshBounds
+	{
+		float aabbMin[3]{};
+		float aabbMax[3]{};
+		float sphereCenter[3]{};
+		float sphereRadius{ 0.0f };
+	};
+
+	struct CookedMeshHeader
+	{
+		std::uint32_t magic{ kCookedMeshMagic };
+		std::uint32_t version{ kCookedMeshVersion };
+		std::uint32_t headerBytes{ sizeof(CookedMeshHeader) };
+		std::uint32_t vertexStrideBytes{ strideVDBytes };
+
+		std::uint64_t cookKey{ 0 };
+
+		std::uint64_t vertexCount{ 0 };
+		std::uint64_t vertexOffset{ 0 };
+		std::uint64_t indexCount{ 0 };
+		std::uint64_t indexOffset{ 0 };
+
+		CookedMeshBounds bounds{};
+
+		// MeshCPU::lods; 0 = the whole index blob is the only level.
+		std::uint32_t lodCount{ 0 };
+		MeshLod lods[kMaxMeshLods]{};
+	};
+
+	static_assert(std::is_trivially_copyable_v<CookedMeshHeader>);
+
+	// FNV-1a: stable across runs and platforms (unlike std::hash), which on-disk keys need.
+	inline constexpr std::uint64_t kCookKeySeed = hashUtils::kFnv1a64Offset;
+
+	constexpr std::uint64_t HashCookBytes(std::span<const std::byte> bytes, std::uint64_t seed = kCookKeySeed) noexcept
+	{
+		return hashUtils::Fnv1a64(bytes, seed);
+	}
+
+	// Validated view into a mapped .cmesh. Copies share the mapping.
+	class CookedMesh
+	{
+	public:
+		CookedMesh(std::shared_ptr<const corefs::MappedFile> file, const CookedMeshHeader& header)
+			: file_(std::move(file))
+			, header_(header)
+		{
+			const std::byte* base = file_->Bytes().data();
+			if (header_.vertexCount != 0)
+			{
+				vertices_ = { reinterpret_cast<const VertexDesc*>(base + header_.vertexOffset), static_cast<std::size_t>(header_.vertexCount) };
+			}
+			if (header_.indexCount != 0)
+			{
+				indices_ = { reinterpret_cast<const std::uint32_t*>(base + header_.indexOffset), static_cast<std::size_t>(header_.indexCount) };
+			}
+		}
+
+		std::span<const VertexDesc> Vertices() const noexcept { return vertices_; }
+		std::span<const std::uint32_t> Indices() const noexcept { return indices_; }
+		std::span<const MeshLod> Lods() const noexcept { return { header_.lods, header_.lodCount }; }
+		std::uint64_t CookKey() const noexcept { return header_.cookKey; }
+
+		const CookedMeshBounds& Bounds() const noexcept { return header_.bounds; }
+
+	private:
+		std::shared_ptr<const corefs::MappedFile> file_;
+		CookedMeshHeader header_{};
+		std::span<const VertexDesc> vertices_{};
+		std::span<const std::uint32_t> indices_{};
+	};
+
+	// Cook key of a source file. Hashes the whole file (through a mapping), then mixes in the
+	// import settings blob and the format version, so changing any of them re-cooks.
+	std::uint64_t ComputeMeshCookKey(const std::filesystem::path& source, std::span<const std::byte> settings)
+	{
+		const corefs::MappedFile file(source);
+		std::uint64_t key = HashCookBytes(file.Bytes());
+		key = HashCookBytes(settings, key);
+
+		const std::uint32_t version = kCookedMeshVersion;
+		return HashCookBytes(std::as_bytes(std::span(&version, 1)), key);
+	}
+
+	// Fixed-width lowercase hex; artifact file names and manifest keys share it.
+	std::string CookKeyHex(std::uint64_t cookKey)
+	{
+		static constexpr char kHex[] = "0123456789abcdef";
+		std::string name(16, '0');
+		for (int i = 15; i >= 0; --i)
+		{
+			name[static_cast<std::size_t>(i)] = kHex[cookKey & 0xFu];
+			cookKey >>= 4;
+		}
+		return name;
+	}
+
+	std::filesystem::path CookedMeshPath(std::uint64_t cookKey)
+	{
+		return corefs::CookedCacheRoot() / "meshes" / (CookKeyHex(cookKey) + ".cmesh");
+	}
+
+	// Returns nullopt if the file is missing, stale (different key) or malformed. Without an
+	// expected key any well-formed file is accepted (the manifest already vouched for it).
+	std::optional<CookedMesh> OpenCookedMesh(const std::filesystem::path& path, std::optional<std::uint64_t> expectedCookKey)
+	{
+		std::error_code ec;
+		if (!std::filesystem::is_regular_file(path, ec))
+		{
+			return std::nullopt;
+		}
+
+		std::shared_ptr<const corefs::MappedFile> file;
+		try
+		{
+			file = std::make_shared<const corefs::MappedFile>(path);
+		}
+		catch (const std::exception&)
+		{
+			return std::nullopt;
+		}
+
+		const std::span<const std::byte> bytes = file->Bytes();
+		if (bytes.size() < sizeof(CookedMeshHeader))
+		{
+			return std::nullopt;
+		}
+
+		CookedMeshHeader header{};
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		if (header.magic != kCookedMeshMagic ||
+			header.version != kCookedMeshVersion ||
+			header.headerBytes != sizeof(CookedMeshHeader) ||
+			header.vertexStrideBytes != strideVDBytes ||
+			(expectedCookKey && header.cookKey != *expectedCookKey))
+		{
+			return std::nullopt;
+		}
+
+		const auto blobFits = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t elementBytes)
+			{
+				if (count == 0)
+				{
+					return true;
+				}
+				if (offset % kCookedMeshBlobAlignment != 0 || offset > bytes.size())
+				{
+					return false;
+				}
+				return count <= (bytes.size() - offset) / elementBytes;
+			};
+
+		if (!blobFits(header.vertexOffset, header.vertexCount, sizeof(VertexDesc)) ||
+			!blobFits(header.indexOffset, header.indexCount, sizeof(std::uint32_t)))
+		{
+			return std::nullopt;
+		}
+
+		if (header.lodCount > kMaxMeshLods)
+		{
+			return std::nullopt;
+		}
+		for (std::uint32_t lod = 0; lod < header.lodCount; ++lod)
+		{
+			const MeshLod& range = header.lods[lod];
+			if (range.indexCount == 0 || range.firstIndex > header.indexCount || range.indexCount > header.indexCount - range.firstIndex)
+			{
+				return std::nullopt;
+			}
+		}
+
+		return CookedMesh(std::move(file), header);
+	}
+
+	// Writes to a temporary file and renames it into place, so a concurrent reader (or a crash
+	// mid-write) never observes a partial .cmesh.
+	void WriteCookedMesh(const std::filesystem::path& path, std::uint64_t cookKey, const MeshCPU& cpu, const CookedMeshBounds& bounds)
+	{
+		const auto AlignUp = [](std::uint64_t v) { return (v + kCookedMeshBlobAlignment - 1) & ~(kCookedMeshBlobAlignment - 1); };
+
+		CookedMeshHeader header{};
+		header.cookKey = cookKey;
+		header.vertexCount = cpu.vertices.size();
+		header.vertexOffset = AlignUp(sizeof(CookedMeshHeader));
+		header.indexCount = cpu.indices.size();
+		header.indexOffset = AlignUp(header.vertexOffset + header.vertexCount * sizeof(VertexDesc));
+		header.bounds = bounds;
+		header.lodCount = static_cast<std::uint32_t>(std::min<std::size_t>(cpu.lods.size(), kMaxMeshLods));
+		std::copy_n(cpu.lods.begin(), header.lodCount, header.lods);
+
+		std::filesystem::create_directories(path.parent_path());
+		// Per-thread temp name: two entries importing the same source may cook concurrently.
+		std::filesystem::path tmpPath = path;
+		tmpPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+		{
+			std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+			if (!out)
+			{
+				throw std::runtime_error("Failed to create cooked mesh: " + tmpPath.string());
+			}
+
+			const auto WriteAt = [&out](std::uint64_t offset, const void* data, std::size_t size)
+				{
+					out.seekp(static_cast<std::streamoff>(offset));
+					out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+				};
+
+			WriteAt(0, &header, sizeof(header));
+			WriteAt(header.vertexOffset, cpu.vertices.data(), cpu.vertices.size() * sizeof(VertexDesc));
+			WriteAt(header.indexOffset, cpu.indices.data(), cpu.indices.size() * sizeof(std::uint32_t));
+			if (!out)
+			{
+				out.close();
+				std::error_code ec;
+				std::filesystem::remove(tmpPath, ec);
+				throw std::runtime_error("Failed to write cooked mesh: " + tmpPath.string());
+			}
+		}
+
+		std::filesystem::rename(tmpPath, path);
+	}
+}
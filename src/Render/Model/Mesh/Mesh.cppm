@@ -1,14 +1,18 @@
 module;
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <vector>
 #include <string>
 #include <span>
 #include <cmath>
+#include <deque>
 
 export module core:mesh;
 
 import :rhi;
+import :render_gpu_memory;
 import :math_utils;
 
 export namespace rendern
@@ -24,12 +28,61 @@ export namespace rendern
 
 	constexpr std::uint32_t strideVDBytes = static_cast<std::uint32_t>(sizeof(VertexDesc));
 
+	// Optional static-mesh vertex format (see EncodeVertexCompact): 20 bytes instead of 48.
+	//   p:    UNORM16 position inside the mesh's quantization box (one scale for all axes, so
+	//         the dequantization is a uniform scale + translation and normals need no fix-up);
+	//         pw holds the tangent sign (0: -1, 0x8000: +1). Full VertexDesc positions read w = 1,
+	//         which is how shaders tell the formats apart.
+	//   n, t: octahedral unit vectors, SNORM16.
+	//   u, v: half floats.
+	struct VertexCompact
+	{
+		std::uint16_t px, py, pz, pw;
+		std::int16_t nx, ny;
+		std::uint16_t u, v;
+		std::int16_t tx, ty;
+	};
+
+	constexpr std::uint32_t strideVCBytes = static_cast<std::uint32_t>(sizeof(VertexCompact));
+	static_assert(strideVCBytes == 20u);
+
+	// Depth-only vertex streams (MeshRHI::depthVertexBuffer): just the position of each vertex, in the
+	// same order as the full stream, for the pre-depth and shadow passes.
+	struct VertexPosition
+	{
+		float px, py, pz;
+	};
+
+	// VertexCompact's position, w included (the shaders' format test reads it).
+	struct VertexPositionCompact
+	{
+		std::uint16_t px, py, pz, pw;
+	};
+
+	constexpr std::uint32_t strideVPBytes = static_cast<std::uint32_t>(sizeof(VertexPosition));
+	constexpr std::uint32_t strideVPCBytes = static_cast<std::uint32_t>(sizeof(VertexPositionCompact));
+	static_assert(strideVPBytes == 12u && strideVPCBytes == 8u);
+
+	inline constexpr std::uint32_t kMaxMeshLods = 4;
+
+	// One level of detail: a range of the mesh's indices. Every level indexes the same vertices.
+	struct MeshLod
+	{
+		std::uint32_t firstIndex{ 0 };
+		std::uint32_t indexCount{ 0 };
+	};
+
 	struct MeshCPU
 	{
 		std::vector<VertexDesc> vertices;
+		// With lods, every level's triangles back to back (level 0 first).
 		std::vector<std::uint32_t> indices;
+		// Empty: `indices` is the only level (see GenerateMeshLods).
+		std::vector<MeshLod> lods;
 	};
 
+	class GeometryPool;
+
 	struct MeshRHI
 	{
 		rhi::BufferHandle vertexBuffer;
@@ -42,6 +95,40 @@ export namespace rendern
 		std::uint32_t vertexStrideBytes{ sizeof(VertexDesc) };
 		std::uint32_t indexCount{ 0 };
 		rhi::IndexType indexType{ rhi::IndexType::UINT32 };
+
+		// Set when the buffers were sub-allocated: vertexBuffer/indexBuffer are then shared pool
+		// buffers, bound at these offsets, and DestroyMesh hands the ranges back to `allocator`.
+		std::uint32_t vertexOffsetBytes{ 0 };
+		std::uint32_t indexOffsetBytes{ 0 };
+		renderer::IGPUMemoryAllocator* allocator{ nullptr };
+
+		// Set when the mesh is a range of a GeometryPool: the buffers and layouts are the pool's,
+		// and draws pass firstIndex/baseVertex instead of binding at an offset.
+		std::uint32_t firstIndex{ 0 };
+		std::int32_t baseVertex{ 0 };
+		GeometryPool* geometryPool{ nullptr };
+
+		// VertexCompact meshes (positionScale > 0): local position = positionOffset + positionScale * stored.
+		mathUtils::Vec3 positionOffset{ 0.0f, 0.0f, 0.0f };
+		float positionScale{ 0.0f };
+
+		// Depth-only stream: positions alone (VertexPosition / VertexPositionCompact), indexed like the
+		// vertex buffer (pool meshes: the pool's stream, same baseVertex). The pre-depth and shadow passes
+		// bind it with layoutDepthInstanced; empty (OpenGL) means they fetch the full vertices.
+		rhi::BufferHandle depthVertexBuffer;
+		rhi::InputLayoutHandle layoutDepthInstanced;
+		std::uint32_t depthVertexStrideBytes{ 0 };
+		std::uint32_t depthVertexOffsetBytes{ 0 };
+
+		// Mesh-shader path (UploadMeshlets): structured buffers of their own, since pooled vertex
+		// buffers cannot be bound as SRVs. meshletVertexBuffer holds VertexDesc positions in the same
+		// space as the vertex buffer (quantized for VertexCompact meshes). firstMeshlet/meshletCount
+		// select the level of detail this view draws.
+		rhi::BufferHandle meshletVertexBuffer;
+		rhi::BufferHandle meshletBuffer;
+		rhi::BufferHandle meshletDataBuffer;
+		std::uint32_t firstMeshlet{ 0 };
+		std::uint32_t meshletCount{ 0 };
 	};
 
 	inline rhi::InputLayoutHandle CreateVertexDescLayout(rhi::IRHIDevice& device, std::string_view name = "VertexDecs")
@@ -78,6 +165,269 @@ export namespace rendern
 		return device.CreateInputLayout(desc);
 	}
 
+	// Same semantics as CreateVertexDescLayout over VertexCompact; the shaders decode NORMAL/TANGENT.
+	inline rhi::InputLayoutHandle CreateVertexCompactLayout(rhi::IRHIDevice& device, std::string_view name = "VertexCompact")
+	{
+		rhi::InputLayoutDesc desc{};
+		desc.debugName = std::string(name);
+		desc.strideBytes = strideVCBytes;
+		desc.attributes = {
+			rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Position, .semanticIndex = 0, .format = rhi::VertexFormat::R16G16B16A16_UNORM, .offsetBytes = 0, .normalized = true},
+			rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Normal,	.semanticIndex = 0, .format = rhi::VertexFormat::R16G16_SNORM, .offsetBytes = 8, .normalized = true},
+			rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord, .semanticIndex = 0, .format = rhi::VertexFormat::R16G16_FLOAT, .offsetBytes = 12},
+			rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Tangent,  .semanticIndex = 0, .format = rhi::VertexFormat::R16G16_SNORM, .offsetBytes = 16, .normalized = true},
+		};
+		return device.CreateInputLayout(desc);
+	}
+
+	inline rhi::InputLayoutHandle CreateVertexCompactLayoutInstanced(rhi::IRHIDevice& device, std::string_view name = "VertexCompactInstanced")
+	{
+		rhi::InputLayoutDesc desc{};
+		desc.debugName = std::string(name);
+		desc.strideBytes = strideVCBytes; // slot0 stride
+		desc.attributes = {
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Position,.semanticIndex = 0,.format = rhi::VertexFormat::R16G16B16A16_UNORM,.inputSlot = 0,.offsetBytes = 0,.normalized = true},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Normal,  .semanticIndex = 0,.format = rhi::VertexFormat::R16G16_SNORM,.inputSlot = 0,.offsetBytes = 8,.normalized = true},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 0,.format = rhi::VertexFormat::R16G16_FLOAT,.inputSlot = 0,.offsetBytes = 12},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Tangent, .semanticIndex = 0,.format = rhi::VertexFormat::R16G16_SNORM,.inputSlot = 0,.offsetBytes = 16,.normalized = true},
+
+		// Instance matrix columns in slot1: TEXCOORD1..4
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 1,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 0},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 2,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 16},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 3,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 32},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 4,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 48},
+		};
+		return device.CreateInputLayout(desc);
+	}
+
+	// POSITION in slot0 (R32G32B32_FLOAT, or VertexCompact's R16G16B16A16_UNORM) + the instance rows of
+	// the other instanced layouts in slot1. Depth-only shaders read nothing else.
+	inline rhi::InputLayoutHandle CreateDepthVertexLayoutInstanced(rhi::IRHIDevice& device, bool compact, std::string_view name = "DepthVertexInstanced")
+	{
+		rhi::InputLayoutDesc desc{};
+		desc.debugName = std::string(name);
+		desc.strideBytes = compact ? strideVPCBytes : strideVPBytes; // slot0 stride
+		desc.attributes = {
+		compact
+			? rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Position,.semanticIndex = 0,.format = rhi::VertexFormat::R16G16B16A16_UNORM,.inputSlot = 0,.offsetBytes = 0,.normalized = true}
+			: rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::Position,.semanticIndex = 0,.format = rhi::VertexFormat::R32G32B32_FLOAT,.inputSlot = 0,.offsetBytes = 0},
+
+		// Instance matrix columns in slot1: TEXCOORD1..4
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 1,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 0},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 2,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 16},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 3,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 32},
+		rhi::VertexAttributeDesc{.semantic = rhi::VertexSemantic::TexCoord,.semanticIndex = 4,.format = rhi::VertexFormat::R32G32B32A32_FLOAT,.inputSlot = 1,.offsetBytes = 48},
+		};
+		return device.CreateInputLayout(desc);
+	}
+
+	// The OpenGL depth passes draw the full vertex stream, so meshes there get no depth-only stream.
+	inline bool UsesDepthVertexStream(const rhi::IRHIDevice& device) noexcept
+	{
+		return device.GetBackend() != rhi::Backend::OpenGL;
+	}
+
+	inline std::vector<VertexPosition> ExtractVertexPositions(std::span<const VertexDesc> vertices)
+	{
+		std::vector<VertexPosition> out;
+		out.reserve(vertices.size());
+		for (const VertexDesc& v : vertices)
+		{
+			out.push_back(VertexPosition{ v.px, v.py, v.pz });
+		}
+		return out;
+	}
+
+	inline std::vector<VertexPositionCompact> ExtractVertexPositions(std::span<const VertexCompact> vertices)
+	{
+		std::vector<VertexPositionCompact> out;
+		out.reserve(vertices.size());
+		for (const VertexCompact& v : vertices)
+		{
+			out.push_back(VertexPositionCompact{ v.px, v.py, v.pz, v.pw });
+		}
+		return out;
+	}
+
+	// IEEE half from float, round to nearest even (overflow becomes infinity).
+	inline std::uint16_t FloatToHalf(float value) noexcept
+	{
+		const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+		const std::uint32_t sign = (bits >> 16) & 0x8000u;
+		const std::uint32_t absBits = bits & 0x7FFFFFFFu;
+		if (absBits >= 0x7F800000u)
+		{
+			return static_cast<std::uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x200u : 0u));
+		}
+		if (absBits >= 0x477FF000u)
+		{
+			return static_cast<std::uint16_t>(sign | 0x7C00u);
+		}
+		if (absBits < 0x38800000u)
+		{
+			// Subnormal half: units of 2^-24.
+			const float units = std::bit_cast<float>(absBits) * 16777216.0f;
+			return static_cast<std::uint16_t>(sign | static_cast<std::uint32_t>(std::nearbyint(units)));
+		}
+		std::uint32_t half = (absBits - 0x38000000u) >> 13;
+		const std::uint32_t rest = absBits & 0x1FFFu;
+		if (rest > 0x1000u || (rest == 0x1000u && (half & 1u) != 0u))
+		{
+			++half;
+		}
+		return static_cast<std::uint16_t>(sign | half);
+	}
+
+	inline float HalfToFloat(std::uint16_t half) noexcept
+	{
+		const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+		const std::uint32_t exponent = (half >> 10) & 0x1Fu;
+		const std::uint32_t mantissa = half & 0x3FFu;
+		if (exponent == 0u)
+		{
+			const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+			return sign != 0u ? -magnitude : magnitude;
+		}
+		if (exponent == 0x1Fu)
+		{
+			return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+		}
+		return std::bit_cast<float>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+	}
+
+	inline std::int16_t ToSnorm16(float value) noexcept
+	{
+		return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+	}
+
+	inline float FromSnorm16(std::int16_t value) noexcept
+	{
+		return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+	}
+
+	// Unit vector -> octahedron folded onto [-1, 1]^2 (and back).
+	inline mathUtils::Vec2 OctahedralEncode(const mathUtils::Vec3& n) noexcept
+	{
+		const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+		if (l1 <= 0.0f)
+		{
+			return mathUtils::Vec2(0.0f, 0.0f);
+		}
+		float x = n.x / l1;
+		float y = n.y / l1;
+		if (n.z < 0.0f)
+		{
+			const float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			const float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = fx;
+			y = fy;
+		}
+		return mathUtils::Vec2(x, y);
+	}
+
+	inline mathUtils::Vec3 OctahedralDecode(const mathUtils::Vec2& e) noexcept
+	{
+		mathUtils::Vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+		const float t = std::max(-n.z, 0.0f);
+		n.x += (n.x >= 0.0f) ? -t : t;
+		n.y += (n.y >= 0.0f) ? -t : t;
+		return mathUtils::Normalize(n);
+	}
+
+	// Box the positions are quantized into: `offset` is the min corner, `scale` the largest extent.
+	struct VertexQuantization
+	{
+		mathUtils::Vec3 offset{ 0.0f, 0.0f, 0.0f };
+		float scale{ 1.0f };
+	};
+
+	inline VertexQuantization MakeVertexQuantization(const mathUtils::Vec3& boundsMin, const mathUtils::Vec3& boundsMax) noexcept
+	{
+		const float extent = std::max({ boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z });
+		return VertexQuantization{ .offset = boundsMin, .scale = extent > 0.0f ? extent : 1.0f };
+	}
+
+	// Positions outside the box (stale bounds) are clamped onto it.
+	inline VertexCompact EncodeVertexCompact(const VertexDesc& v, const VertexQuantization& q) noexcept
+	{
+		auto Unorm16 = [](float value) noexcept
+			{
+				return static_cast<std::uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+			};
+		const float invScale = 1.0f / q.scale;
+		const mathUtils::Vec2 n = OctahedralEncode(mathUtils::Vec3(v.nx, v.ny, v.nz));
+		const mathUtils::Vec2 t = OctahedralEncode(mathUtils::Vec3(v.tx, v.ty, v.tz));
+
+		VertexCompact out{};
+		out.px = Unorm16((v.px - q.offset.x) * invScale);
+		out.py = Unorm16((v.py - q.offset.y) * invScale);
+		out.pz = Unorm16((v.pz - q.offset.z) * invScale);
+		out.pw = v.tw < 0.0f ? 0u : 0x8000u;
+		out.nx = ToSnorm16(n.x);
+		out.ny = ToSnorm16(n.y);
+		out.u = FloatToHalf(v.u);
+		out.v = FloatToHalf(v.v);
+		out.tx = ToSnorm16(t.x);
+		out.ty = ToSnorm16(t.y);
+		return out;
+	}
+
+	// What the vertex shader reconstructs (tools and tests).
+	inline VertexDesc DecodeVertexCompact(const VertexCompact& v, const VertexQuantization& q) noexcept
+	{
+		const mathUtils::Vec3 n = OctahedralDecode(mathUtils::Vec2(FromSnorm16(v.nx), FromSnorm16(v.ny)));
+		const mathUtils::Vec3 t = OctahedralDecode(mathUtils::Vec2(FromSnorm16(v.tx), FromSnorm16(v.ty)));
+		const float s = q.scale / 65535.0f;
+
+		VertexDesc out{};
+		out.px = q.offset.x + s * static_cast<float>(v.px);
+		out.py = q.offset.y + s * static_cast<float>(v.py);
+		out.pz = q.offset.z + s * static_cast<float>(v.pz);
+		out.nx = n.x; out.ny = n.y; out.nz = n.z;
+		out.u = HalfToFloat(v.u);
+		out.v = HalfToFloat(v.v);
+		out.tx = t.x; out.ty = t.y; out.tz = t.z;
+		out.tw = v.pw != 0u ? 1.0f : -1.0f;
+		return out;
+	}
+
+	inline std::vector<VertexCompact> EncodeVerticesCompact(std::span<const VertexDesc> vertices, const VertexQuantization& q)
+	{
+		std::vector<VertexCompact> out;
+		out.reserve(vertices.size());
+		for (const VertexDesc& v : vertices)
+		{
+			out.push_back(EncodeVertexCompact(v, q));
+		}
+		return out;
+	}
+
+	// Instance transform of a draw of `mesh`: folds a compact mesh's dequantization into `model`.
+	inline mathUtils::Mat4 MeshVertexTransform(const mathUtils::Mat4& model, const MeshRHI& mesh) noexcept
+	{
+		if (mesh.positionScale <= 0.0f)
+		{
+			return model;
+		}
+		const float s = mesh.positionScale;
+		return mathUtils::Scale(mathUtils::Translate(model, mesh.positionOffset), mathUtils::Vec3(s, s, s));
+	}
+
+	// A local-space bounding sphere in the space MeshVertexTransform maps from.
+	inline mathUtils::Vec4 MeshVertexSpaceSphere(const mathUtils::Vec4& sphere, const MeshRHI& mesh) noexcept
+	{
+		if (mesh.positionScale <= 0.0f)
+		{
+			return sphere;
+		}
+		const float invScale = 1.0f / mesh.positionScale;
+		return mathUtils::Vec4(
+			(sphere.x - mesh.positionOffset.x) * invScale,
+			(sphere.y - mesh.positionOffset.y) * invScale,
+			(sphere.z - mesh.positionOffset.z) * invScale,
+			sphere.w * invScale);
+	}
+
 
 	inline mathUtils::Vec3 BuildFallbackTangent(const mathUtils::Vec3& normal) noexcept
 	{
@@ -177,14 +527,70 @@ export namespace rendern
 	}
 
 
-	inline MeshRHI UploadMesh(rhi::IRHIDevice& device, const MeshCPU& cpu, std::string_view debugName = "Mesh")
+	// Without an allocator every buffer is a committed resource of its own.
+	inline renderer::BufferAllocation AllocateMeshBuffer(
+		rhi::IRHIDevice& device,
+		renderer::IGPUMemoryAllocator* allocator,
+		const rhi::BufferDesc& desc)
+	{
+		if (allocator)
+		{
+			return allocator->AllocateBuffer(desc);
+		}
+		return renderer::BufferAllocation{ .buffer = device.CreateBuffer(desc), .offsetBytes = 0, .sizeInBytes = desc.sizeInBytes };
+	}
+
+	inline void FreeMeshBuffer(
+		rhi::IRHIDevice& device,
+		renderer::IGPUMemoryAllocator* allocator,
+		rhi::BufferHandle buffer,
+		std::uint32_t offsetBytes) noexcept
+	{
+		if (allocator)
+		{
+			allocator->FreeBuffer(renderer::BufferAllocation{ .buffer = buffer, .offsetBytes = offsetBytes, .sizeInBytes = 0 });
+		}
+		else
+		{
+			device.DestroyBuffer(buffer);
+		}
+	}
+
+	// Fills mesh's depth-only stream from `positions` (mesh.allocator sub-allocates it like the other buffers).
+	template <typename Position>
+	void UploadDepthVertices(rhi::IRHIDevice& device, MeshRHI& mesh, std::span<const Position> positions, bool compact, std::string_view debugName)
+	{
+		rhi::BufferDesc depthVertexBuffer{};
+		depthVertexBuffer.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+		depthVertexBuffer.usageFlag = rhi::BufferUsageFlag::Static;
+		depthVertexBuffer.sizeInBytes = positions.size_bytes();
+		depthVertexBuffer.debugName = std::string(debugName) + "_DepthVB";
+
+		const renderer::BufferAllocation allocation = AllocateMeshBuffer(device, mesh.allocator, depthVertexBuffer);
+		mesh.depthVertexBuffer = allocation.buffer;
+		mesh.depthVertexOffsetBytes = static_cast<std::uint32_t>(allocation.offsetBytes);
+		mesh.depthVertexStrideBytes = static_cast<std::uint32_t>(sizeof(Position));
+		mesh.layoutDepthInstanced = CreateDepthVertexLayoutInstanced(device, compact, std::string(debugName) + "_DepthInstanced");
+		if (!positions.empty())
+		{
+			device.UpdateBuffer(mesh.depthVertexBuffer, std::as_bytes(positions), allocation.offsetBytes);
+		}
+	}
+
+	// Span overload: the data may live outside a MeshCPU (e.g. a mapped cooked mesh).
+	inline MeshRHI UploadMesh(rhi::IRHIDevice& device,
+		std::span<const VertexDesc> vertices,
+		std::span<const std::uint32_t> indices,
+		std::string_view debugName = "Mesh",
+		renderer::IGPUMemoryAllocator* allocator = nullptr)
 	{
 		MeshRHI outMeshRHI;
+		outMeshRHI.allocator = allocator;
 		outMeshRHI.vertexStrideBytes = strideVDBytes;
-		outMeshRHI.indexCount = static_cast<std::uint32_t>(cpu.indices.size());
+		outMeshRHI.indexCount = static_cast<std::uint32_t>(indices.size());
 
 		outMeshRHI.layout = CreateVertexDescLayout(device, debugName);
-		if (device.GetBackend() == rhi::Backend::DirectX12)
+		if (device.GetBackend() == rhi::Backend::DirectX12 || device.GetBackend() == rhi::Backend::OpenGL)
 		{
 			outMeshRHI.layoutInstanced = CreateVertexDescLayoutInstanced(device, std::string(debugName) + "_Instanced");
 		}
@@ -198,13 +604,15 @@ export namespace rendern
 			rhi::BufferDesc vertexBuffer{};
 			vertexBuffer.bindFlag = rhi::BufferBindFlag::VertexBuffer;
 			vertexBuffer.usageFlag = rhi::BufferUsageFlag::Static;
-			vertexBuffer.sizeInBytes = cpu.vertices.size() * sizeof(VertexDesc);
+			vertexBuffer.sizeInBytes = vertices.size() * sizeof(VertexDesc);
 			vertexBuffer.debugName = std::string(debugName) + "_VB";
 
-			outMeshRHI.vertexBuffer = device.CreateBuffer(vertexBuffer);
-			if (!cpu.vertices.empty())
+			const renderer::BufferAllocation allocation = AllocateMeshBuffer(device, allocator, vertexBuffer);
+			outMeshRHI.vertexBuffer = allocation.buffer;
+			outMeshRHI.vertexOffsetBytes = static_cast<std::uint32_t>(allocation.offsetBytes);
+			if (!vertices.empty())
 			{
-				device.UpdateBuffer(outMeshRHI.vertexBuffer, std::as_bytes(std::span(cpu.vertices)));
+				device.UpdateBuffer(outMeshRHI.vertexBuffer, std::as_bytes(vertices), allocation.offsetBytes);
 			}
 		}
 
@@ -213,28 +621,319 @@ export namespace rendern
 			rhi::BufferDesc indexBuffer{};
 			indexBuffer.bindFlag = rhi::BufferBindFlag::IndexBuffer;
 			indexBuffer.usageFlag = rhi::BufferUsageFlag::Static;
-			indexBuffer.sizeInBytes = cpu.indices.size() * sizeof(std::uint32_t);
+			indexBuffer.sizeInBytes = indices.size() * sizeof(std::uint32_t);
 			indexBuffer.debugName = std::string(debugName) + "_IB";
 
-			outMeshRHI.indexBuffer = device.CreateBuffer(indexBuffer);
-			if (!cpu.indices.empty())
+			const renderer::BufferAllocation allocation = AllocateMeshBuffer(device, allocator, indexBuffer);
+			outMeshRHI.indexBuffer = allocation.buffer;
+			outMeshRHI.indexOffsetBytes = static_cast<std::uint32_t>(allocation.offsetBytes);
+			if (!indices.empty())
 			{
-				device.UpdateBuffer(outMeshRHI.indexBuffer, std::as_bytes(std::span(cpu.indices)));
+				device.UpdateBuffer(outMeshRHI.indexBuffer, std::as_bytes(indices), allocation.offsetBytes);
 			}
 		}
 
+		if (UsesDepthVertexStream(device))
+		{
+			const std::vector<VertexPosition> positions = ExtractVertexPositions(vertices);
+			UploadDepthVertices(device, outMeshRHI, std::span<const VertexPosition>{ positions }, false, debugName);
+		}
+
 		return outMeshRHI;
 	}
 
+	inline MeshRHI UploadMesh(
+		rhi::IRHIDevice& device,
+		const MeshCPU& cpu,
+		std::string_view debugName = "Mesh",
+		renderer::IGPUMemoryAllocator* allocator = nullptr)
+	{
+		return UploadMesh(device, std::span<const VertexDesc>(cpu.vertices), std::span<const std::uint32_t>(cpu.indices), debugName, allocator);
+	}
+
+	// UploadMesh with VertexCompact vertices quantized into `q` (DX12 shaders decode them). The
+	// instance transform of every draw must go through MeshVertexTransform.
+	inline MeshRHI UploadMeshCompact(rhi::IRHIDevice& device,
+		std::span<const VertexDesc> vertices,
+		std::span<const std::uint32_t> indices,
+		const VertexQuantization& q,
+		std::string_view debugName = "Mesh",
+		renderer::IGPUMemoryAllocator* allocator = nullptr)
+	{
+		const std::vector<VertexCompact> compact = EncodeVerticesCompact(vertices, q);
+
+		MeshRHI outMeshRHI;
+		outMeshRHI.allocator = allocator;
+		outMeshRHI.vertexStrideBytes = strideVCBytes;
+		outMeshRHI.indexCount = static_cast<std::uint32_t>(indices.size());
+		outMeshRHI.positionOffset = q.offset;
+		outMeshRHI.positionScale = q.scale;
+
+		outMeshRHI.layout = CreateVertexCompactLayout(device, debugName);
+		outMeshRHI.layoutInstanced = CreateVertexCompactLayoutInstanced(device, std::string(debugName) + "_Instanced");
+
+		{
+			rhi::BufferDesc vertexBuffer{};
+			vertexBuffer.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+			vertexBuffer.usageFlag = rhi::BufferUsageFlag::Static;
+			vertexBuffer.sizeInBytes = compact.size() * sizeof(VertexCompact);
+			vertexBuffer.debugName = std::string(debugName) + "_VB";
+
+			const renderer::BufferAllocation allocation = AllocateMeshBuffer(device, allocator, vertexBuffer);
+			outMeshRHI.vertexBuffer = allocation.buffer;
+			outMeshRHI.vertexOffsetBytes = static_cast<std::uint32_t>(allocation.offsetBytes);
+			if (!compact.empty())
+			{
+				device.UpdateBuffer(outMeshRHI.vertexBuffer, std::as_bytes(std::span{ compact }), allocation.offsetBytes);
+			}
+		}
+
+		{
+			rhi::BufferDesc indexBuffer{};
+			indexBuffer.bindFlag = rhi::BufferBindFlag::IndexBuffer;
+			indexBuffer.usageFlag = rhi::BufferUsageFlag::Static;
+			indexBuffer.sizeInBytes = indices.size() * sizeof(std::uint32_t);
+			indexBuffer.debugName = std::string(debugName) + "_IB";
+
+			const renderer::BufferAllocation allocation = AllocateMeshBuffer(device, allocator, indexBuffer);
+			outMeshRHI.indexBuffer = allocation.buffer;
+			outMeshRHI.indexOffsetBytes = static_cast<std::uint32_t>(allocation.offsetBytes);
+			if (!indices.empty())
+			{
+				device.UpdateBuffer(outMeshRHI.indexBuffer, std::as_bytes(indices), allocation.offsetBytes);
+			}
+		}
+
+		if (UsesDepthVertexStream(device))
+		{
+			const std::vector<VertexPositionCompact> positions = ExtractVertexPositions(std::span{ compact });
+			UploadDepthVertices(device, outMeshRHI, std::span<const VertexPositionCompact>{ positions }, true, debugName);
+		}
+
+		return outMeshRHI;
+	}
+
+	// One vertex and one index buffer shared by every static VertexDesc mesh uploaded through it.
+	// A mesh is a range inside them (baseVertex/firstIndex), and all pool meshes share the same
+	// buffers and input layouts, so consecutive draws of different meshes need no rebinding and
+	// can go out as one multi-draw indirect call.
+	// Depth-only positions live in a third buffer indexed by the same baseVertex (no allocator of its own).
+	// The buffers do not grow: Upload returns an empty MeshRHI once a range does not fit, and the
+	// caller falls back to UploadMesh. Freed ranges are reused after GetFramesInFlight() EndFrame() calls.
+	// Device-owner thread only.
+	class GeometryPool
+	{
+	public:
+		struct Stats
+		{
+			std::uint64_t vertexCapacityBytes{ 0 };
+			std::uint64_t vertexUsedBytes{ 0 };
+			std::uint64_t indexCapacityBytes{ 0 };
+			std::uint64_t indexUsedBytes{ 0 };
+			std::uint32_t meshes{ 0 };
+			std::uint32_t pendingFrees{ 0 };
+		};
+
+		explicit GeometryPool(
+			rhi::IRHIDevice& device,
+			std::uint64_t vertexCapacityBytes = 128ull << 20,
+			std::uint64_t indexCapacityBytes = 64ull << 20)
+			: device_(device)
+			, vertexRanges_(vertexCapacityBytes, strideVDBytes)
+			, indexRanges_(indexCapacityBytes, static_cast<std::uint32_t>(sizeof(std::uint32_t)))
+		{
+			layout_ = CreateVertexDescLayout(device_, "GeometryPool");
+			if (device_.GetBackend() == rhi::Backend::DirectX12 || device_.GetBackend() == rhi::Backend::OpenGL)
+			{
+				layoutInstanced_ = CreateVertexDescLayoutInstanced(device_, "GeometryPool_Instanced");
+			}
+			else
+			{
+				layoutInstanced_ = layout_;
+			}
+
+			rhi::BufferDesc vertexBuffer{};
+			vertexBuffer.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+			vertexBuffer.usageFlag = rhi::BufferUsageFlag::Static;
+			vertexBuffer.sizeInBytes = static_cast<std::size_t>(vertexRanges_.CapacityBytes());
+			vertexBuffer.debugName = "GeometryPool_VB";
+			vertexBuffer_ = device_.CreateBuffer(vertexBuffer);
+
+			rhi::BufferDesc indexBuffer{};
+			indexBuffer.bindFlag = rhi::BufferBindFlag::IndexBuffer;
+			indexBuffer.usageFlag = rhi::BufferUsageFlag::Static;
+			indexBuffer.sizeInBytes = static_cast<std::size_t>(indexRanges_.CapacityBytes());
+			indexBuffer.debugName = "GeometryPool_IB";
+			indexBuffer_ = device_.CreateBuffer(indexBuffer);
+
+			if (UsesDepthVertexStream(device_))
+			{
+				rhi::BufferDesc depthVertexBuffer{};
+				depthVertexBuffer.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+				depthVertexBuffer.usageFlag = rhi::BufferUsageFlag::Static;
+				depthVertexBuffer.sizeInBytes = static_cast<std::size_t>(vertexRanges_.CapacityBytes() / strideVDBytes * strideVPBytes);
+				depthVertexBuffer.debugName = "GeometryPool_DepthVB";
+				depthVertexBuffer_ = device_.CreateBuffer(depthVertexBuffer);
+				layoutDepthInstanced_ = CreateDepthVertexLayoutInstanced(device_, false, "GeometryPool_DepthInstanced");
+			}
+		}
+
+		~GeometryPool()
+		{
+			if (depthVertexBuffer_)
+			{
+				device_.DestroyBuffer(depthVertexBuffer_);
+				device_.DestroyInputLayout(layoutDepthInstanced_);
+			}
+			device_.DestroyBuffer(indexBuffer_);
+			device_.DestroyBuffer(vertexBuffer_);
+			if (layoutInstanced_.id != layout_.id)
+			{
+				device_.DestroyInputLayout(layoutInstanced_);
+			}
+			device_.DestroyInputLayout(layout_);
+		}
+
+		GeometryPool(const GeometryPool&) = delete;
+		GeometryPool& operator=(const GeometryPool&) = delete;
+
+		MeshRHI Upload(std::span<const VertexDesc> vertices, std::span<const std::uint32_t> indices)
+		{
+			const std::uint64_t vertexOffset = vertexRanges_.Allocate(vertices.size_bytes());
+			if (vertexOffset == renderer::TlsfRangeAllocator::kInvalidOffset)
+			{
+				return {};
+			}
+			const std::uint64_t indexOffset = indexRanges_.Allocate(indices.size_bytes());
+			if (indexOffset == renderer::TlsfRangeAllocator::kInvalidOffset)
+			{
+				vertexRanges_.Free(vertexOffset);
+				return {};
+			}
+
+			if (!vertices.empty())
+			{
+				device_.UpdateBuffer(vertexBuffer_, std::as_bytes(vertices), static_cast<std::size_t>(vertexOffset));
+			}
+			if (!indices.empty())
+			{
+				device_.UpdateBuffer(indexBuffer_, std::as_bytes(indices), static_cast<std::size_t>(indexOffset));
+			}
+			const std::uint64_t depthVertexOffset = vertexOffset / strideVDBytes * strideVPBytes;
+			if (depthVertexBuffer_ && !vertices.empty())
+			{
+				const std::vector<VertexPosition> positions = ExtractVertexPositions(vertices);
+				device_.UpdateBuffer(depthVertexBuffer_, std::as_bytes(std::span{ positions }), static_cast<std::size_t>(depthVertexOffset));
+			}
+
+			MeshRHI mesh{};
+			mesh.vertexBuffer = vertexBuffer_;
+			mesh.indexBuffer = indexBuffer_;
+			mesh.layout = layout_;
+			mesh.layoutInstanced = layoutInstanced_;
+			mesh.vertexStrideBytes = strideVDBytes;
+			mesh.indexCount = static_cast<std::uint32_t>(indices.size());
+			mesh.firstIndex = static_cast<std::uint32_t>(indexOffset / sizeof(std::uint32_t));
+			mesh.baseVertex = static_cast<std::int32_t>(vertexOffset / strideVDBytes);
+			mesh.geometryPool = this;
+			if (depthVertexBuffer_)
+			{
+				// Bound at offset 0 like the vertex buffer: baseVertex selects the range.
+				mesh.depthVertexBuffer = depthVertexBuffer_;
+				mesh.layoutDepthInstanced = layoutDepthInstanced_;
+				mesh.depthVertexStrideBytes = strideVPBytes;
+			}
+			return mesh;
+		}
+
+		void Free(const MeshRHI& mesh) noexcept
+		{
+			pending_.push_back(PendingFree{
+				frame_ + device_.GetFramesInFlight(),
+				std::uint64_t(mesh.baseVertex) * strideVDBytes,
+				std::uint64_t(mesh.firstIndex) * sizeof(std::uint32_t) });
+		}
+
+		// Call once per rendered frame, after it has been submitted.
+		void EndFrame()
+		{
+			++frame_;
+			while (!pending_.empty() && pending_.front().retireAfter <= frame_)
+			{
+				vertexRanges_.Free(pending_.front().vertexOffsetBytes);
+				indexRanges_.Free(pending_.front().indexOffsetBytes);
+				pending_.pop_front();
+			}
+		}
+
+		rhi::BufferHandle GetVertexBuffer() const noexcept { return vertexBuffer_; }
+		rhi::BufferHandle GetIndexBuffer() const noexcept { return indexBuffer_; }
+		rhi::BufferHandle GetDepthVertexBuffer() const noexcept { return depthVertexBuffer_; }
+
+		Stats GetStats() const noexcept
+		{
+			Stats stats{};
+			stats.vertexCapacityBytes = vertexRanges_.CapacityBytes();
+			stats.vertexUsedBytes = vertexRanges_.UsedBytes();
+			stats.indexCapacityBytes = indexRanges_.CapacityBytes();
+			stats.indexUsedBytes = indexRanges_.UsedBytes();
+			stats.meshes = vertexRanges_.AllocationCount();
+			stats.pendingFrees = static_cast<std::uint32_t>(pending_.size());
+			return stats;
+		}
+
+	private:
+		struct PendingFree
+		{
+			std::uint64_t retireAfter{ 0 };
+			std::uint64_t vertexOffsetBytes{ 0 };
+			std::uint64_t indexOffsetBytes{ 0 };
+		};
+
+		rhi::IRHIDevice& device_;
+		renderer::TlsfRangeAllocator vertexRanges_;
+		renderer::TlsfRangeAllocator indexRanges_;
+		rhi::BufferHandle vertexBuffer_{};
+		rhi::BufferHandle indexBuffer_{};
+		rhi::BufferHandle depthVertexBuffer_{};
+		rhi::InputLayoutHandle layout_{};
+		rhi::InputLayoutHandle layoutInstanced_{};
+		rhi::InputLayoutHandle layoutDepthInstanced_{};
+		std::deque<PendingFree> pending_;
+		std::uint64_t frame_{ 0 };
+	};
+
 	inline void DestroyMesh(rhi::IRHIDevice& device, MeshRHI& mesh) noexcept
 	{
+		for (rhi::BufferHandle* buffer : { &mesh.meshletVertexBuffer, &mesh.meshletBuffer, &mesh.meshletDataBuffer })
+		{
+			if (*buffer)
+			{
+				device.DestroyBuffer(*buffer);
+				*buffer = {};
+			}
+		}
+		if (mesh.geometryPool)
+		{
+			mesh.geometryPool->Free(mesh);
+			mesh = {};
+			return;
+		}
 		if (mesh.indexBuffer)
 		{
-			device.DestroyBuffer(mesh.indexBuffer);
+			FreeMeshBuffer(device, mesh.allocator, mesh.indexBuffer, mesh.indexOffsetBytes);
 		}
 		if (mesh.vertexBuffer)
 		{
-			device.DestroyBuffer(mesh.vertexBuffer);
+			FreeMeshBuffer(device, mesh.allocator, mesh.vertexBuffer, mesh.vertexOffsetBytes);
+		}
+		if (mesh.depthVertexBuffer)
+		{
+			FreeMeshBuffer(device, mesh.allocator, mesh.depthVertexBuffer, mesh.depthVertexOffsetBytes);
+		}
+		if (mesh.layoutDepthInstanced)
+		{
+			device.DestroyInputLayout(mesh.layoutDepthInstanced);
 		}
 		if (mesh.layoutInstanced && mesh.layoutInstanced.id != mesh.layout.id)
 		{
@@ -0,0 +1,503 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+export module core:mesh_lod;
+
+import :mesh;
+import :math_utils;
+
+// Mesh levels of detail.
+//   Generation (import / cook time): GenerateMeshLods simplifies level 0 into up to kMaxMeshLods - 1
+//   coarser levels by quadric-error edge collapse. Collapses only move a vertex onto an existing one, so
+//   every level is an index list over the same vertices; the lists are stored back to back in
+//   MeshCPU::indices (and the cooked .cmesh) with MeshCPU::lods describing the ranges.
+//   Selection (draw time): SelectMeshLod picks a level from the bounding sphere's on-screen size.
+
+export namespace rendern
+{
+	struct MeshLodGenerationSettings
+	{
+		std::uint32_t maxLods{ kMaxMeshLods };
+		// Each level aims for this fraction of the previous level's triangles.
+		float triangleRatio{ 0.5f };
+		// Largest collapse error, as a distance relative to the mesh's bounding radius.
+		float maxError{ 0.05f };
+		// Levels stop once the previous one has fewer triangles than this.
+		std::uint32_t minTriangles{ 64 };
+	};
+
+	namespace meshLodDetail
+	{
+		// Symmetric 4x4 error quadric: xx xy xz xw yy yz yw zz zw ww.
+		struct Quadric
+		{
+			std::array<double, 10> m{};
+
+			void AddPlane(double a, double b, double c, double d, double weight) noexcept
+			{
+				m[0] += weight * a * a; m[1] += weight * a * b; m[2] += weight * a * c; m[3] += weight * a * d;
+				m[4] += weight * b * b; m[5] += weight * b * c; m[6] += weight * b * d;
+				m[7] += weight * c * c; m[8] += weight * c * d;
+				m[9] += weight * d * d;
+			}
+
+			void Add(const Quadric& other) noexcept
+			{
+				for (std::size_t i = 0; i < m.size(); ++i)
+				{
+					m[i] += other.m[i];
+				}
+			}
+
+			double Error(const mathUtils::Vec3& p) const noexcept
+			{
+				const double x = p.x, y = p.y, z = p.z;
+				const double e = m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x
+					+ m[4] * y * y + 2.0 * m[5] * y * z + 2.0 * m[6] * y
+					+ m[7] * z * z + 2.0 * m[8] * z
+					+ m[9];
+				return std::max(e, 0.0);
+			}
+		};
+
+		struct PositionKey
+		{
+			std::uint32_t x, y, z;
+			bool operator==(const PositionKey&) const noexcept = default;
+		};
+
+		struct PositionKeyHash
+		{
+			std::size_t operator()(const PositionKey& k) const noexcept
+			{
+				std::uint64_t h = k.x;
+				h = h * 0x9E3779B97F4A7C15ull ^ k.y;
+				h = h * 0x9E3779B97F4A7C15ull ^ k.z;
+				return static_cast<std::size_t>(h ^ (h >> 29));
+			}
+		};
+
+		inline std::uint64_t EdgeKey(std::uint32_t a, std::uint32_t b) noexcept
+		{
+			return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+		}
+
+		inline mathUtils::Vec3 Position(const VertexDesc& v) noexcept
+		{
+			return mathUtils::Vec3(v.px, v.py, v.pz);
+		}
+	}
+
+	// Quadric-error edge collapse of an indexed triangle list down to about `targetIndexCount` indices.
+	// Vertices sharing a position collapse together (attribute seams do not crack); a corner whose
+	// position moved takes the vertex at the new position whose normal is closest to its own. Collapses
+	// costing more than maxError (a distance) or flipping a triangle are skipped, so the result can stay
+	// above the target. Returns indices into `vertices`.
+	std::vector<std::uint32_t> SimplifyMeshIndices(
+		std::span<const VertexDesc> vertices,
+		std::span<const std::uint32_t> indices,
+		std::size_t targetIndexCount,
+		float maxError)
+	{
+		using namespace meshLodDetail;
+
+		// ---- Positions: one id per distinct position ----
+		std::vector<std::uint32_t> positionOf(vertices.size());
+		std::vector<mathUtils::Vec3> positions;
+		{
+			std::unordered_map<PositionKey, std::uint32_t, PositionKeyHash> ids;
+			ids.reserve(vertices.size());
+			for (std::size_t v = 0; v < vertices.size(); ++v)
+			{
+				const PositionKey key{ std::bit_cast<std::uint32_t>(vertices[v].px), std::bit_cast<std::uint32_t>(vertices[v].py), std::bit_cast<std::uint32_t>(vertices[v].pz) };
+				const auto [it, inserted] = ids.try_emplace(key, static_cast<std::uint32_t>(positions.size()));
+				if (inserted)
+				{
+					positions.push_back(Position(vertices[v]));
+				}
+				positionOf[v] = it->second;
+			}
+		}
+		const std::uint32_t positionCount = static_cast<std::uint32_t>(positions.size());
+
+		// ---- Triangles over positions; `source` keeps each one's original corners ----
+		std::vector<std::uint32_t> tris;
+		std::vector<std::uint32_t> source;
+		tris.reserve(indices.size());
+		source.reserve(indices.size() / 3);
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size())
+			{
+				continue;
+			}
+			const std::uint32_t a = positionOf[indices[i]];
+			const std::uint32_t b = positionOf[indices[i + 1]];
+			const std::uint32_t c = positionOf[indices[i + 2]];
+			if (a == b || b == c || a == c)
+			{
+				continue;
+			}
+			tris.insert(tris.end(), { a, b, c });
+			source.push_back(static_cast<std::uint32_t>(i));
+		}
+
+		// ---- Quadrics: area-weighted triangle planes, plus steep planes along open borders ----
+		std::vector<Quadric> quadrics(positionCount);
+		{
+			std::unordered_map<std::uint64_t, std::uint32_t> edgeUses;
+			edgeUses.reserve(tris.size());
+			for (std::size_t t = 0; t < tris.size(); t += 3)
+			{
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					++edgeUses[EdgeKey(tris[t + k], tris[t + (k + 1) % 3])];
+				}
+			}
+
+			constexpr double kBorderWeight = 10.0;
+			for (std::size_t t = 0; t < tris.size(); t += 3)
+			{
+				const mathUtils::Vec3& p0 = positions[tris[t]];
+				const mathUtils::Vec3 cross = mathUtils::Cross(positions[tris[t + 1]] - p0, positions[tris[t + 2]] - p0);
+				const float doubleArea = mathUtils::Length(cross);
+				if (doubleArea <= 0.0f)
+				{
+					continue;
+				}
+				const mathUtils::Vec3 n = cross / doubleArea;
+				Quadric plane{};
+				plane.AddPlane(n.x, n.y, n.z, -mathUtils::Dot(n, p0), 0.5 * doubleArea);
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					quadrics[tris[t + k]].Add(plane);
+				}
+
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					const std::uint32_t a = tris[t + k];
+					const std::uint32_t b = tris[t + (k + 1) % 3];
+					if (edgeUses[EdgeKey(a, b)] != 1u)
+					{
+						continue;
+					}
+					const mathUtils::Vec3 edge = positions[b] - positions[a];
+					const float edgeLength = mathUtils::Length(edge);
+					if (edgeLength <= 0.0f)
+					{
+						continue;
+					}
+					const mathUtils::Vec3 borderNormal = mathUtils::Normalize(mathUtils::Cross(edge, n));
+					Quadric border{};
+					border.AddPlane(borderNormal.x, borderNormal.y, borderNormal.z, -mathUtils::Dot(borderNormal, positions[a]),
+						kBorderWeight * edgeLength * edgeLength);
+					quadrics[a].Add(border);
+					quadrics[b].Add(border);
+				}
+			}
+		}
+
+		// ---- Collapse passes: cheapest edges first, each vertex at most once per pass ----
+		std::vector<std::uint32_t> collapsedInto(positionCount);
+		std::iota(collapsedInto.begin(), collapsedInto.end(), 0u);
+
+		const double maxErrorSq = static_cast<double>(maxError) * static_cast<double>(maxError);
+		const std::size_t targetTriangles = targetIndexCount / 3;
+
+		struct Collapse
+		{
+			double cost;
+			std::uint32_t from;
+			std::uint32_t to;
+		};
+		std::vector<std::uint64_t> edges;
+		std::vector<Collapse> collapses;
+		std::vector<std::uint32_t> adjacencyOffsets;
+		std::vector<std::uint32_t> adjacency;
+		std::vector<std::uint8_t> touched;
+
+		for (int pass = 0; pass < 64 && tris.size() / 3 > targetTriangles; ++pass)
+		{
+			// Vertex -> triangles.
+			adjacencyOffsets.assign(positionCount + 1u, 0u);
+			for (const std::uint32_t v : tris)
+			{
+				++adjacencyOffsets[v + 1u];
+			}
+			std::partial_sum(adjacencyOffsets.begin(), adjacencyOffsets.end(), adjacencyOffsets.begin());
+			adjacency.resize(tris.size());
+			{
+				std::vector<std::uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (std::size_t i = 0; i < tris.size(); ++i)
+				{
+					adjacency[fill[tris[i]]++] = static_cast<std::uint32_t>(i / 3);
+				}
+			}
+
+			// Candidate collapses: every edge once, towards its cheaper end.
+			edges.clear();
+			for (std::size_t t = 0; t < tris.size(); t += 3)
+			{
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					edges.push_back(EdgeKey(tris[t + k], tris[t + (k + 1) % 3]));
+				}
+			}
+			std::sort(edges.begin(), edges.end());
+			edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+			collapses.clear();
+			for (const std::uint64_t edge : edges)
+			{
+				const std::uint32_t a = static_cast<std::uint32_t>(edge >> 32);
+				const std::uint32_t b = static_cast<std::uint32_t>(edge);
+				Quadric q = quadrics[a];
+				q.Add(quadrics[b]);
+				const double costToB = q.Error(positions[b]);
+				const double costToA = q.Error(positions[a]);
+				collapses.push_back(costToB <= costToA ? Collapse{ costToB, a, b } : Collapse{ costToA, b, a });
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& l, const Collapse& r)
+				{
+					return l.cost != r.cost ? l.cost < r.cost : (l.from != r.from ? l.from < r.from : l.to < r.to);
+				});
+
+			touched.assign(positionCount, 0u);
+			std::size_t triangles = tris.size() / 3;
+			bool collapsedAny = false;
+			for (const Collapse& collapse : collapses)
+			{
+				if (triangles <= targetTriangles || collapse.cost > maxErrorSq)
+				{
+					break;
+				}
+				if (touched[collapse.from] != 0u || touched[collapse.to] != 0u)
+				{
+					continue;
+				}
+
+				// Reject collapses that flip (or flatten) a surviving triangle around `from`.
+				const mathUtils::Vec3& target = positions[collapse.to];
+				bool flips = false;
+				std::size_t removed = 0;
+				for (std::uint32_t i = adjacencyOffsets[collapse.from]; i < adjacencyOffsets[collapse.from + 1u] && !flips; ++i)
+				{
+					const std::uint32_t t = adjacency[i] * 3u;
+					std::array<std::uint32_t, 3> corner{};
+					for (std::size_t k = 0; k < 3; ++k)
+					{
+						std::uint32_t v = tris[t + k];
+						while (collapsedInto[v] != v)
+						{
+							v = collapsedInto[v];
+						}
+						corner[k] = v;
+					}
+					if (corner[0] == corner[1] || corner[1] == corner[2] || corner[0] == corner[2])
+					{
+						continue;
+					}
+					if (corner[0] == collapse.to || corner[1] == collapse.to || corner[2] == collapse.to)
+					{
+						++removed;
+						continue;
+					}
+					std::array<mathUtils::Vec3, 3> moved{ positions[corner[0]], positions[corner[1]], positions[corner[2]] };
+					const mathUtils::Vec3 before = mathUtils::Cross(moved[1] - moved[0], moved[2] - moved[0]);
+					for (std::size_t k = 0; k < 3; ++k)
+					{
+						if (corner[k] == collapse.from)
+						{
+							moved[k] = target;
+						}
+					}
+					const mathUtils::Vec3 after = mathUtils::Cross(moved[1] - moved[0], moved[2] - moved[0]);
+					flips = mathUtils::Dot(before, after) <= 0.25f * mathUtils::Length(before) * mathUtils::Length(after);
+				}
+				if (flips)
+				{
+					continue;
+				}
+
+				collapsedInto[collapse.from] = collapse.to;
+				quadrics[collapse.to].Add(quadrics[collapse.from]);
+				touched[collapse.from] = 1u;
+				touched[collapse.to] = 1u;
+				triangles -= std::min(triangles, removed);
+				collapsedAny = true;
+			}
+			if (!collapsedAny)
+			{
+				break;
+			}
+
+			// Resolve the corners and drop the triangles that collapsed.
+			std::size_t out = 0;
+			for (std::size_t t = 0; t < tris.size(); t += 3)
+			{
+				std::array<std::uint32_t, 3> corner{};
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					std::uint32_t v = tris[t + k];
+					while (collapsedInto[v] != v)
+					{
+						v = collapsedInto[v];
+					}
+					corner[k] = v;
+				}
+				if (corner[0] == corner[1] || corner[1] == corner[2] || corner[0] == corner[2])
+				{
+					continue;
+				}
+				std::copy(corner.begin(), corner.end(), tris.begin() + static_cast<std::ptrdiff_t>(out));
+				source[out / 3] = source[t / 3];
+				out += 3;
+			}
+			tris.resize(out);
+			source.resize(out / 3);
+		}
+
+		// ---- Back to vertices: keep a corner's own vertex, else the best-matching one at its new position ----
+		std::vector<std::uint32_t> groupOffsets(positionCount + 1u, 0u);
+		for (const std::uint32_t p : positionOf)
+		{
+			++groupOffsets[p + 1u];
+		}
+		std::partial_sum(groupOffsets.begin(), groupOffsets.end(), groupOffsets.begin());
+		std::vector<std::uint32_t> groups(vertices.size());
+		{
+			std::vector<std::uint32_t> fill(groupOffsets.begin(), groupOffsets.end() - 1);
+			for (std::size_t v = 0; v < vertices.size(); ++v)
+			{
+				groups[fill[positionOf[v]]++] = static_cast<std::uint32_t>(v);
+			}
+		}
+
+		std::vector<std::uint32_t> result;
+		result.reserve(tris.size());
+		for (std::size_t t = 0; t < tris.size(); t += 3)
+		{
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				const std::uint32_t original = indices[source[t / 3] + k];
+				const std::uint32_t position = tris[t + k];
+				if (positionOf[original] == position)
+				{
+					result.push_back(original);
+					continue;
+				}
+
+				const VertexDesc& from = vertices[original];
+				std::uint32_t best = groups[groupOffsets[position]];
+				float bestScore = -2.0f;
+				for (std::uint32_t i = groupOffsets[position]; i < groupOffsets[position + 1u]; ++i)
+				{
+					const VertexDesc& candidate = vertices[groups[i]];
+					const float score = from.nx * candidate.nx + from.ny * candidate.ny + from.nz * candidate.nz;
+					if (score > bestScore)
+					{
+						bestScore = score;
+						best = groups[i];
+					}
+				}
+				result.push_back(best);
+			}
+		}
+		return result;
+	}
+
+	// Appends the coarser levels of cpu's triangles to cpu.indices and fills cpu.lods. Each level is
+	// simplified from the previous one; generation stops at settings.maxLods or once a level no longer
+	// shrinks by at least a tenth. A mesh that gets no coarser level keeps cpu.lods empty.
+	void GenerateMeshLods(MeshCPU& cpu, const MeshLodGenerationSettings& settings = {})
+	{
+		cpu.lods.clear();
+		if (cpu.vertices.empty() || cpu.indices.size() < 3)
+		{
+			return;
+		}
+
+		mathUtils::Vec3 boundsMin = meshLodDetail::Position(cpu.vertices.front());
+		mathUtils::Vec3 boundsMax = boundsMin;
+		for (const VertexDesc& v : cpu.vertices)
+		{
+			boundsMin = mathUtils::MinVec3(boundsMin, meshLodDetail::Position(v));
+			boundsMax = mathUtils::MaxVec3(boundsMax, meshLodDetail::Position(v));
+		}
+		const float radius = 0.5f * mathUtils::Length(boundsMax - boundsMin);
+		const float maxError = settings.maxError * radius;
+
+		const std::uint32_t maxLods = std::clamp(settings.maxLods, 1u, kMaxMeshLods);
+		std::vector<MeshLod> lods{ MeshLod{ 0u, static_cast<std::uint32_t>(cpu.indices.size()) } };
+		while (lods.size() < maxLods)
+		{
+			const MeshLod previous = lods.back();
+			if (previous.indexCount / 3u < settings.minTriangles)
+			{
+				break;
+			}
+
+			const std::span<const std::uint32_t> previousIndices(cpu.indices.data() + previous.firstIndex, previous.indexCount);
+			const std::size_t target = static_cast<std::size_t>(static_cast<float>(previous.indexCount / 3u) * settings.triangleRatio) * 3u;
+			std::vector<std::uint32_t> simplified = SimplifyMeshIndices(cpu.vertices, previousIndices, target, maxError);
+			if (simplified.empty() || simplified.size() * 10u > static_cast<std::size_t>(previous.indexCount) * 9u)
+			{
+				break;
+			}
+
+			lods.push_back(MeshLod{ static_cast<std::uint32_t>(cpu.indices.size()), static_cast<std::uint32_t>(simplified.size()) });
+			cpu.indices.insert(cpu.indices.end(), simplified.begin(), simplified.end());
+		}
+
+		if (lods.size() > 1)
+		{
+			cpu.lods = std::move(lods);
+		}
+	}
+
+	// Bounding sphere diameter over the viewport height at its distance (1 = fills the view), the
+	// measure AnimationLodScreenSize uses too.
+	[[nodiscard]] inline float MeshLodScreenSize(
+		const mathUtils::Vec3& sphereCenter,
+		float sphereRadius,
+		const mathUtils::Vec3& cameraPosition,
+		float fovYRadians) noexcept
+	{
+		const float distance = mathUtils::Length(sphereCenter - cameraPosition);
+		if (distance <= sphereRadius)
+		{
+			return 1.0f;
+		}
+		const float halfHeight = distance * std::tan(0.5f * fovYRadians);
+		return (halfHeight > 0.0f) ? sphereRadius / halfHeight : 1.0f;
+	}
+
+	// Level 1 applies below lod1ScreenSize, and every further level at half the previous size. `bias`
+	// shifts the choice towards coarser (positive) or finer (negative) levels; the result is clamped
+	// to [0, lodCount).
+	[[nodiscard]] inline std::uint32_t SelectMeshLod(float screenSize, float lod1ScreenSize, std::uint32_t lodCount, int bias) noexcept
+	{
+		if (lodCount <= 1u)
+		{
+			return 0u;
+		}
+		std::uint32_t lod = 0u;
+		float threshold = lod1ScreenSize;
+		while (lod + 1u < lodCount && screenSize < threshold)
+		{
+			++lod;
+			threshold *= 0.5f;
+		}
+		return static_cast<std::uint32_t>(std::clamp(static_cast<int>(lod) + bias, 0, static_cast<int>(lodCount) - 1));
+	}
+}
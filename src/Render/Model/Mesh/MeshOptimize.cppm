@@ -0,0 +1,335 @@
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+export module core:mesh_optimize;
+
+import :mesh;
+import :math_utils;
+
+// Import-time index and vertex ordering (OptimizeMesh), run after GenerateMeshLods:
+//   1. Vertex cache: every level's triangles are reordered with Tipsify (Sander, Nehab, Barczak 2007),
+//      fanning around the vertex that keeps the most recent vertices in a FIFO post-transform cache.
+//   2. Overdraw: the reordered list is cut where the cache was cold anyway, and the pieces are sorted
+//      so outward-facing, outer pieces draw first (they tend to occlude the rest of the mesh).
+//   3. Vertex fetch: vertices are renumbered in first-use order over all levels, so the vertex
+//      buffer is read front to back; vertices no level references are dropped.
+
+export namespace rendern
+{
+	struct MeshOptimizeSettings
+	{
+		// FIFO post-transform cache size Tipsify optimizes for.
+		std::uint32_t cacheSize{ 16 };
+		// Overdraw pieces start only where a triangle misses on all three vertices and the current
+		// piece has at least this many triangles.
+		std::uint32_t minClusterTriangles{ 32 };
+		bool optimizeOverdraw{ true };
+	};
+
+	// Average cache miss ratio (transformed vertices per triangle) of `indices` with a FIFO cache.
+	float AnalyzeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount, std::uint32_t cacheSize = 16)
+	{
+		if (indices.size() < 3)
+		{
+			return 0.0f;
+		}
+		std::vector<std::uint32_t> entered(vertexCount, 0u);
+		std::uint32_t clock = cacheSize + 1u;
+		std::size_t misses = 0;
+		for (const std::uint32_t index : indices)
+		{
+			if (index >= vertexCount)
+			{
+				continue;
+			}
+			if (clock - entered[index] > cacheSize)
+			{
+				entered[index] = clock++;
+				++misses;
+			}
+		}
+		return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+	}
+
+	// Tipsify: returns `indices` reordered (same triangles, same winding).
+	std::vector<std::uint32_t> OptimizeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount, std::uint32_t cacheSize = 16)
+	{
+		const std::size_t triangleCount = indices.size() / 3;
+		for (const std::uint32_t index : indices)
+		{
+			if (index >= vertexCount)
+			{
+				return std::vector<std::uint32_t>(indices.begin(), indices.end());
+			}
+		}
+
+		// Vertex -> triangles (CSR); a degenerate triangle appears once per corner.
+		std::vector<std::uint32_t> live(vertexCount, 0u);
+		for (std::size_t i = 0; i < triangleCount * 3; ++i)
+		{
+			++live[indices[i]];
+		}
+		std::vector<std::uint32_t> adjacencyBegin(vertexCount + 1, 0u);
+		for (std::size_t v = 0; v < vertexCount; ++v)
+		{
+			adjacencyBegin[v + 1] = adjacencyBegin[v] + live[v];
+		}
+		std::vector<std::uint32_t> adjacency(triangleCount * 3);
+		{
+			std::vector<std::uint32_t> cursor(adjacencyBegin.begin(), adjacencyBegin.end() - 1);
+			for (std::size_t i = 0; i < triangleCount * 3; ++i)
+			{
+				adjacency[cursor[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+			}
+		}
+
+		std::vector<std::uint32_t> out;
+		out.reserve(triangleCount * 3);
+		std::vector<std::uint8_t> emitted(triangleCount, 0u);
+		std::vector<std::uint32_t> entered(vertexCount, 0u);
+		std::vector<std::uint32_t> deadEnd;
+		std::vector<std::uint32_t> candidates;
+		std::uint32_t clock = cacheSize + 1u;
+		std::size_t scan = 0;
+
+		constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+		auto NextLiveVertex = [&]() -> std::uint32_t
+			{
+				while (!deadEnd.empty())
+				{
+					const std::uint32_t v = deadEnd.back();
+					deadEnd.pop_back();
+					if (live[v] > 0u)
+					{
+						return v;
+					}
+				}
+				while (scan < vertexCount)
+				{
+					if (live[scan] > 0u)
+					{
+						return static_cast<std::uint32_t>(scan);
+					}
+					++scan;
+				}
+				return kNone;
+			};
+
+		std::uint32_t fan = NextLiveVertex();
+		while (fan != kNone)
+		{
+			candidates.clear();
+			for (std::uint32_t a = adjacencyBegin[fan]; a < adjacencyBegin[fan + 1]; ++a)
+			{
+				const std::uint32_t triangle = adjacency[a];
+				if (emitted[triangle] != 0u)
+				{
+					continue;
+				}
+				emitted[triangle] = 1u;
+				for (std::uint32_t corner = 0; corner < 3; ++corner)
+				{
+					const std::uint32_t v = indices[triangle * 3 + corner];
+					out.push_back(v);
+					deadEnd.push_back(v);
+					candidates.push_back(v);
+					--live[v];
+					if (clock - entered[v] > cacheSize)
+					{
+						entered[v] = clock++;
+					}
+				}
+			}
+
+			// The candidate still in the cache after fanning around it (2 entries per live triangle)
+			// that entered it earliest; none such: restart from the dead-end stack or a scan.
+			std::uint32_t best = kNone;
+			std::uint32_t bestAge = 0;
+			for (const std::uint32_t v : candidates)
+			{
+				if (live[v] == 0u)
+				{
+					continue;
+				}
+				const std::uint32_t age = clock - entered[v];
+				if (age + 2u * live[v] <= cacheSize && age > bestAge)
+				{
+					bestAge = age;
+					best = v;
+				}
+			}
+			fan = (best != kNone) ? best : NextLiveVertex();
+		}
+		return out;
+	}
+
+	// Keeps each piece's triangle order; see the module comment.
+	std::vector<std::uint32_t> OptimizeOverdraw(
+		std::span<const std::uint32_t> indices,
+		std::span<const VertexDesc> vertices,
+		std::uint32_t cacheSize = 16,
+		std::uint32_t minClusterTriangles = 32)
+	{
+		const std::size_t triangleCount = indices.size() / 3;
+		std::vector<std::uint32_t> out(indices.begin(), indices.begin() + triangleCount * 3);
+		for (const std::uint32_t index : out)
+		{
+			if (index >= vertices.size())
+			{
+				return out;
+			}
+		}
+
+		// Piece starts: cold triangles (all three corners missed the FIFO cache).
+		std::vector<std::uint32_t> clusterStart;
+		{
+			std::vector<std::uint32_t> entered(vertices.size(), 0u);
+			std::uint32_t clock = cacheSize + 1u;
+			std::uint32_t lastStart = 0;
+			for (std::uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				std::uint32_t misses = 0;
+				for (std::uint32_t corner = 0; corner < 3; ++corner)
+				{
+					const std::uint32_t v = out[triangle * 3 + corner];
+					if (clock - entered[v] > cacheSize)
+					{
+						entered[v] = clock++;
+						++misses;
+					}
+				}
+				if (triangle == 0 || (misses == 3u && triangle - lastStart >= minClusterTriangles))
+				{
+					clusterStart.push_back(triangle);
+					lastStart = triangle;
+				}
+			}
+		}
+		const std::size_t clusterCount = clusterStart.size();
+		if (clusterCount < 2)
+		{
+			return out;
+		}
+		clusterStart.push_back(static_cast<std::uint32_t>(triangleCount));
+
+		auto Position = [&](std::uint32_t index)
+			{
+				const VertexDesc& v = vertices[index];
+				return mathUtils::Vec3(v.px, v.py, v.pz);
+			};
+
+		// Area-weighted centroid and normal of every piece, and of the whole list.
+		std::vector<mathUtils::Vec3> centroid(clusterCount, mathUtils::Vec3(0.0f, 0.0f, 0.0f));
+		std::vector<mathUtils::Vec3> normal(clusterCount, mathUtils::Vec3(0.0f, 0.0f, 0.0f));
+		mathUtils::Vec3 meshCentroid(0.0f, 0.0f, 0.0f);
+		float meshArea = 0.0f;
+		for (std::size_t c = 0; c < clusterCount; ++c)
+		{
+			float area = 0.0f;
+			for (std::uint32_t triangle = clusterStart[c]; triangle < clusterStart[c + 1]; ++triangle)
+			{
+				const mathUtils::Vec3 p0 = Position(out[triangle * 3 + 0]);
+				const mathUtils::Vec3 p1 = Position(out[triangle * 3 + 1]);
+				const mathUtils::Vec3 p2 = Position(out[triangle * 3 + 2]);
+				const mathUtils::Vec3 n = mathUtils::Cross(p1 - p0, p2 - p0);
+				const float a = mathUtils::Length(n);
+				centroid[c] = centroid[c] + (p0 + p1 + p2) * (a / 3.0f);
+				normal[c] = normal[c] + n;
+				area += a;
+			}
+			meshCentroid = meshCentroid + centroid[c];
+			meshArea += area;
+			centroid[c] = (area > 0.0f) ? centroid[c] / area : Position(out[clusterStart[c] * 3]);
+			const float normalLength = mathUtils::Length(normal[c]);
+			normal[c] = (normalLength > 0.0f) ? normal[c] / normalLength : mathUtils::Vec3(0.0f, 0.0f, 0.0f);
+		}
+		if (meshArea > 0.0f)
+		{
+			meshCentroid = meshCentroid / meshArea;
+		}
+
+		std::vector<float> occlusion(clusterCount);
+		for (std::size_t c = 0; c < clusterCount; ++c)
+		{
+			occlusion[c] = mathUtils::Dot(centroid[c] - meshCentroid, normal[c]);
+		}
+		std::vector<std::uint32_t> order(clusterCount);
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b)
+			{
+				return occlusion[a] > occlusion[b];
+			});
+
+		std::vector<std::uint32_t> sorted;
+		sorted.reserve(out.size());
+		for (const std::uint32_t c : order)
+		{
+			sorted.insert(sorted.end(), out.begin() + clusterStart[c] * 3, out.begin() + clusterStart[c + 1] * 3);
+		}
+		return sorted;
+	}
+
+	// Renumbers cpu.vertices in first-use order of cpu.indices (all levels); unreferenced vertices go.
+	void OptimizeVertexFetch(MeshCPU& cpu)
+	{
+		constexpr std::uint32_t kUnused = std::numeric_limits<std::uint32_t>::max();
+		std::vector<std::uint32_t> remap(cpu.vertices.size(), kUnused);
+		std::vector<VertexDesc> vertices;
+		vertices.reserve(cpu.vertices.size());
+		for (const std::uint32_t index : cpu.indices)
+		{
+			if (index >= cpu.vertices.size())
+			{
+				return;
+			}
+		}
+		for (std::uint32_t& index : cpu.indices)
+		{
+			if (remap[index] == kUnused)
+			{
+				remap[index] = static_cast<std::uint32_t>(vertices.size());
+				vertices.push_back(cpu.vertices[index]);
+			}
+			index = remap[index];
+		}
+		cpu.vertices = std::move(vertices);
+	}
+
+	void OptimizeMesh(MeshCPU& cpu, const MeshOptimizeSettings& settings = {})
+	{
+		if (cpu.vertices.empty() || cpu.indices.size() < 3)
+		{
+			return;
+		}
+
+		const std::vector<MeshLod> levels = cpu.lods.empty()
+			? std::vector<MeshLod>{ MeshLod{ 0, static_cast<std::uint32_t>(cpu.indices.size()) } }
+			: cpu.lods;
+		for (const MeshLod& level : levels)
+		{
+			if (level.firstIndex + level.indexCount > cpu.indices.size())
+			{
+				return;
+			}
+		}
+
+		for (const MeshLod& level : levels)
+		{
+			const std::span<std::uint32_t> range(cpu.indices.data() + level.firstIndex, level.indexCount - level.indexCount % 3u);
+			std::vector<std::uint32_t> reordered = OptimizeVertexCache(range, cpu.vertices.size(), settings.cacheSize);
+			if (settings.optimizeOverdraw)
+			{
+				reordered = OptimizeOverdraw(reordered, cpu.vertices, settings.cacheSize, settings.minClusterTriangles);
+			}
+			std::copy(reordered.begin(), reordered.end(), range.begin());
+		}
+		OptimizeVertexFetch(cpu);
+	}
+}
@@ -0,0 +1,304 @@
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+export module core:meshlet;
+
+import :rhi;
+import :mesh;
+import :math_utils;
+
+// Meshlets for the mesh-shader path (BuildMeshlets), built at import after OptimizeMesh:
+//   - every level of detail is cut into meshlets of at most kMeshletMaxVertices vertices and
+//     kMeshletMaxTriangles triangles, walking its (cache-ordered) triangles front to back;
+//   - each meshlet gets a bounding sphere for frustum culling and a normal cone for back-face
+//     culling of the whole meshlet (MeshletConeCulled; the shaders mirror it in Meshlet_dx12.hlsli).
+
+export namespace rendern
+{
+	inline constexpr std::uint32_t kMeshletMaxVertices = 64;
+	inline constexpr std::uint32_t kMeshletMaxTriangles = 124;
+
+	// GPU record (StructuredBuffer<Meshlet> in Meshlet_dx12.hlsli).
+	struct Meshlet
+	{
+		// MeshletData::data[vertexOffset..]: vertexCount mesh vertex indices.
+		std::uint32_t vertexOffset{ 0 };
+		// MeshletData::data[triangleOffset..]: triangleCount triangles, three 8-bit local vertex
+		// indices each (bits 0-7, 8-15, 16-23).
+		std::uint32_t triangleOffset{ 0 };
+		std::uint32_t vertexCount{ 0 };
+		std::uint32_t triangleCount{ 0 };
+
+		mathUtils::Vec3 center{ 0.0f, 0.0f, 0.0f };
+		float radius{ 0.0f };
+
+		// Every triangle normal is within acos(sqrt(1 - coneCutoff^2)) of coneAxis;
+		// coneCutoff >= 1 when the normals spread too far to cull on.
+		mathUtils::Vec3 coneAxis{ 0.0f, 0.0f, 1.0f };
+		float coneCutoff{ 1.0f };
+	};
+	static_assert(sizeof(Meshlet) == 48);
+
+	// The meshlets of one level of detail.
+	struct MeshletRange
+	{
+		std::uint32_t firstMeshlet{ 0 };
+		std::uint32_t meshletCount{ 0 };
+	};
+
+	struct MeshletData
+	{
+		std::vector<Meshlet> meshlets;
+		std::vector<std::uint32_t> data;
+		// One range per MeshCPU level (a single one when the mesh has no lods).
+		std::vector<MeshletRange> lods;
+	};
+
+	inline std::uint32_t PackMeshletTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c) noexcept
+	{
+		return (a & 0xFFu) | ((b & 0xFFu) << 8) | ((c & 0xFFu) << 16);
+	}
+
+	inline std::uint32_t MeshletTriangleCorner(std::uint32_t packed, std::uint32_t corner) noexcept
+	{
+		return (packed >> (corner * 8u)) & 0xFFu;
+	}
+
+	// Bounding sphere and normal cone of `meshlet` from its vertices and triangles in data.
+	void ComputeMeshletBounds(Meshlet& meshlet, std::span<const std::uint32_t> data, std::span<const VertexDesc> vertices)
+	{
+		auto Position = [&](std::uint32_t local)
+			{
+				const VertexDesc& v = vertices[data[meshlet.vertexOffset + local]];
+				return mathUtils::Vec3(v.px, v.py, v.pz);
+			};
+
+		constexpr float kMax = std::numeric_limits<float>::max();
+		mathUtils::Vec3 boxMin(kMax, kMax, kMax);
+		mathUtils::Vec3 boxMax(-kMax, -kMax, -kMax);
+		for (std::uint32_t i = 0; i < meshlet.vertexCount; ++i)
+		{
+			const mathUtils::Vec3 p = Position(i);
+			boxMin = mathUtils::Vec3(std::min(boxMin.x, p.x), std::min(boxMin.y, p.y), std::min(boxMin.z, p.z));
+			boxMax = mathUtils::Vec3(std::max(boxMax.x, p.x), std::max(boxMax.y, p.y), std::max(boxMax.z, p.z));
+		}
+		meshlet.center = (boxMin + boxMax) * 0.5f;
+		meshlet.radius = 0.0f;
+		for (std::uint32_t i = 0; i < meshlet.vertexCount; ++i)
+		{
+			meshlet.radius = std::max(meshlet.radius, mathUtils::Length(Position(i) - meshlet.center));
+		}
+
+		std::vector<mathUtils::Vec3> normals;
+		normals.reserve(meshlet.triangleCount);
+		mathUtils::Vec3 axis(0.0f, 0.0f, 0.0f);
+		for (std::uint32_t t = 0; t < meshlet.triangleCount; ++t)
+		{
+			const std::uint32_t packed = data[meshlet.triangleOffset + t];
+			const mathUtils::Vec3 p0 = Position(MeshletTriangleCorner(packed, 0));
+			const mathUtils::Vec3 n = mathUtils::Cross(Position(MeshletTriangleCorner(packed, 1)) - p0, Position(MeshletTriangleCorner(packed, 2)) - p0);
+			const float length = mathUtils::Length(n);
+			if (length > 0.0f)
+			{
+				normals.push_back(n / length);
+				axis = axis + normals.back();
+			}
+		}
+
+		meshlet.coneAxis = mathUtils::Vec3(0.0f, 0.0f, 1.0f);
+		meshlet.coneCutoff = 1.0f;
+		const float axisLength = mathUtils::Length(axis);
+		if (normals.empty() || axisLength <= 0.0f)
+		{
+			return;
+		}
+		axis = axis / axisLength;
+		float minDot = 1.0f;
+		for (const mathUtils::Vec3& n : normals)
+		{
+			minDot = std::min(minDot, mathUtils::Dot(n, axis));
+		}
+		meshlet.coneAxis = axis;
+		// Cones wider than ~84 degrees (half angle) almost never cull; keep them as "never".
+		if (minDot > 0.1f)
+		{
+			meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+		}
+	}
+
+	// Appends the meshlets of one index range to `out` and returns their range.
+	MeshletRange AppendMeshlets(
+		MeshletData& out,
+		std::span<const VertexDesc> vertices,
+		std::span<const std::uint32_t> indices,
+		std::uint32_t maxVertices = kMeshletMaxVertices,
+		std::uint32_t maxTriangles = kMeshletMaxTriangles)
+	{
+		maxVertices = std::clamp(maxVertices, 3u, 256u);
+		maxTriangles = std::max(maxTriangles, 1u);
+
+		MeshletRange range{ static_cast<std::uint32_t>(out.meshlets.size()), 0u };
+		for (const std::uint32_t index : indices)
+		{
+			if (index >= vertices.size())
+			{
+				return range;
+			}
+		}
+
+		constexpr std::uint32_t kNotLocal = std::numeric_limits<std::uint32_t>::max();
+		std::vector<std::uint32_t> local(vertices.size(), kNotLocal);
+		std::vector<std::uint32_t> meshletVertices;
+		std::vector<std::uint32_t> meshletTriangles;
+		meshletVertices.reserve(maxVertices);
+		meshletTriangles.reserve(maxTriangles);
+
+		auto Flush = [&]()
+			{
+				if (meshletTriangles.empty())
+				{
+					return;
+				}
+				Meshlet meshlet{};
+				meshlet.vertexOffset = static_cast<std::uint32_t>(out.data.size());
+				meshlet.vertexCount = static_cast<std::uint32_t>(meshletVertices.size());
+				out.data.insert(out.data.end(), meshletVertices.begin(), meshletVertices.end());
+				meshlet.triangleOffset = static_cast<std::uint32_t>(out.data.size());
+				meshlet.triangleCount = static_cast<std::uint32_t>(meshletTriangles.size());
+				out.data.insert(out.data.end(), meshletTriangles.begin(), meshletTriangles.end());
+				ComputeMeshletBounds(meshlet, out.data, vertices);
+				out.meshlets.push_back(meshlet);
+				++range.meshletCount;
+
+				for (const std::uint32_t v : meshletVertices)
+				{
+					local[v] = kNotLocal;
+				}
+				meshletVertices.clear();
+				meshletTriangles.clear();
+			};
+
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const std::uint32_t corners[3] = { indices[i], indices[i + 1], indices[i + 2] };
+			std::uint32_t added = 0;
+			for (std::uint32_t c = 0; c < 3; ++c)
+			{
+				const bool repeated = (c > 0 && corners[c] == corners[0]) || (c > 1 && corners[c] == corners[1]);
+				if (local[corners[c]] == kNotLocal && !repeated)
+				{
+					++added;
+				}
+			}
+			if (meshletVertices.size() + added > maxVertices || meshletTriangles.size() + 1 > maxTriangles)
+			{
+				Flush();
+			}
+
+			std::uint32_t localCorners[3]{};
+			for (std::uint32_t c = 0; c < 3; ++c)
+			{
+				std::uint32_t& slot = local[corners[c]];
+				if (slot == kNotLocal)
+				{
+					slot = static_cast<std::uint32_t>(meshletVertices.size());
+					meshletVertices.push_back(corners[c]);
+				}
+				localCorners[c] = slot;
+			}
+			meshletTriangles.push_back(PackMeshletTriangle(localCorners[0], localCorners[1], localCorners[2]));
+		}
+		Flush();
+		return range;
+	}
+
+	// Meshlets of every level of detail (`lods` as in MeshCPU::lods; empty: one level over all indices).
+	MeshletData BuildMeshlets(
+		std::span<const VertexDesc> vertices,
+		std::span<const std::uint32_t> indices,
+		std::span<const MeshLod> lods = {},
+		std::uint32_t maxVertices = kMeshletMaxVertices,
+		std::uint32_t maxTriangles = kMeshletMaxTriangles)
+	{
+		MeshletData out{};
+		const MeshLod whole{ 0, static_cast<std::uint32_t>(indices.size()) };
+		const std::span<const MeshLod> levels = lods.empty() ? std::span<const MeshLod>(&whole, 1) : lods;
+		for (const MeshLod& level : levels)
+		{
+			if (level.firstIndex > indices.size() || level.indexCount > indices.size() - level.firstIndex)
+			{
+				return MeshletData{};
+			}
+			out.lods.push_back(AppendMeshlets(out, vertices, indices.subspan(level.firstIndex, level.indexCount), maxVertices, maxTriangles));
+		}
+		return out;
+	}
+
+	// True when every triangle of the meshlet faces away from `cameraPosition` (same space as the meshlet).
+	inline bool MeshletConeCulled(const Meshlet& meshlet, const mathUtils::Vec3& cameraPosition) noexcept
+	{
+		const mathUtils::Vec3 toCenter = meshlet.center - cameraPosition;
+		return mathUtils::Dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * mathUtils::Length(toCenter) + meshlet.radius;
+	}
+
+	// Creates mesh.meshlet*Buffer for `data` (built from `vertices`). Positions and bounds go into the
+	// space of mesh's vertex buffer (quantized for VertexCompact meshes), so the instance rows built with
+	// MeshVertexTransform place meshlets like the vertex-shader path places vertices.
+	inline void UploadMeshlets(
+		rhi::IRHIDevice& device,
+		MeshRHI& mesh,
+		std::span<const VertexDesc> vertices,
+		const MeshletData& data,
+		std::string_view debugName = "Mesh")
+	{
+		if (data.meshlets.empty() || vertices.empty())
+		{
+			return;
+		}
+
+		std::vector<VertexDesc> meshletVertices(vertices.begin(), vertices.end());
+		std::vector<Meshlet> meshlets = data.meshlets;
+		if (mesh.positionScale > 0.0f)
+		{
+			const float invScale = 1.0f / mesh.positionScale;
+			for (VertexDesc& v : meshletVertices)
+			{
+				v.px = (v.px - mesh.positionOffset.x) * invScale;
+				v.py = (v.py - mesh.positionOffset.y) * invScale;
+				v.pz = (v.pz - mesh.positionOffset.z) * invScale;
+			}
+			for (Meshlet& meshlet : meshlets)
+			{
+				meshlet.center = (meshlet.center - mesh.positionOffset) * invScale;
+				meshlet.radius *= invScale;
+			}
+		}
+
+		auto Create = [&](std::span<const std::byte> bytes, std::uint32_t stride, std::string_view suffix)
+			{
+				rhi::BufferDesc desc{};
+				desc.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+				desc.usageFlag = rhi::BufferUsageFlag::Static;
+				desc.sizeInBytes = bytes.size();
+				desc.structuredStrideBytes = stride;
+				desc.debugName = std::string(debugName) + std::string(suffix);
+				const rhi::BufferHandle buffer = device.CreateBuffer(desc);
+				device.UpdateBuffer(buffer, bytes);
+				return buffer;
+			};
+		mesh.meshletVertexBuffer = Create(std::as_bytes(std::span{ meshletVertices }), strideVDBytes, "_MeshletVB");
+		mesh.meshletBuffer = Create(std::as_bytes(std::span{ meshlets }), static_cast<std::uint32_t>(sizeof(Meshlet)), "_Meshlets");
+		mesh.meshletDataBuffer = Create(std::as_bytes(std::span{ data.data }), static_cast<std::uint32_t>(sizeof(std::uint32_t)), "_MeshletData");
+		mesh.firstMeshlet = 0;
+		mesh.meshletCount = static_cast<std::uint32_t>(data.meshlets.size());
+	}
+}
@@ -1,11 +1,21 @@
 ﻿module;
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <filesystem>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -13,6 +23,8 @@ export module core:obj_loader;
 
 import :mesh;
 import :file_system;
+import :flat_hash_map;
+import :hash_utils;
 
 struct Key
 {
@@ -75,20 +87,335 @@ inline void ParseFaceToken(std::string_view token, int& v, int& vt, int& vn)
 	}
 }
 
-export namespace rendern
+// Fast path (ParseObj) works on the raw text (usually a mapped file): numbers go through std::from_chars on
+// the text itself and nothing is allocated per line or token. Large inputs are split on line
+// boundaries and the chunks are parsed on their own threads; the merge then resolves indices and
+// dedups corners in file order, so the result does not depend on the chunking.
+
+// Face corner as parsed from one chunk. Positive OBJ indices are already absolute (0-based);
+// negative ones are relative to the chunk's own counts (bit i of `relative`) until the merge adds
+// the counts of the chunks before it. -1 = not present.
+struct ObjCorner
+{
+	std::int32_t index[3]{ -1, -1, -1 }; // v, vt, vn
+	std::uint8_t relative{ 0 };
+};
+
+struct ObjChunk
+{
+	std::vector<float> positions;
+	std::vector<float> normals;
+	std::vector<float> uvs;
+	std::vector<ObjCorner> corners;
+	std::vector<std::uint32_t> faceSizes; // corners per face, >= 3
+};
+
+// Dedup keys: (v, vt + 1, vn + 1) packed into 64 bits when the counts allow it (nearly always),
+// the three indices otherwise.
+struct ObjPackedKeyHash
+{
+	std::size_t operator()(std::uint64_t key) const noexcept
+	{
+		return static_cast<std::size_t>(hashUtils::Mix64(key));
+	}
+};
+
+struct ObjWideKeyHash
+{
+	std::size_t operator()(const Key& k) const noexcept
+	{
+		const std::uint64_t lo = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(k.v)) << 32) | static_cast<std::uint32_t>(k.vt);
+		return static_cast<std::size_t>(hashUtils::Mix64(lo ^ hashUtils::Mix64(static_cast<std::uint32_t>(k.vn))));
+	}
+};
+
+inline bool IsObjSpace(char c) noexcept
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char* SkipObjSpaces(const char* p, const char* end) noexcept
+{
+	while (p < end && IsObjSpace(*p))
+	{
+		++p;
+	}
+	return p;
+}
+
+// Missing or malformed numbers read as 0 (the stream-based reference leaves them unset).
+inline float ParseObjFloat(const char*& p, const char* end) noexcept
+{
+	p = SkipObjSpaces(p, end);
+	if (p < end && *p == '+')
+	{
+		++p;
+	}
+	float value = 0.0f;
+	const auto [ptr, ec] = std::from_chars(p, end, value);
+	if (ec == std::errc::result_out_of_range)
+	{
+		value = 0.0f;
+	}
+	p = ptr;
+	while (p < end && !IsObjSpace(*p))
+	{
+		++p;
+	}
+	return value;
+}
+
+inline std::int32_t ResolveObjIndex(std::string_view part, std::size_t localCount, std::uint8_t bit, std::uint8_t& relative)
 {
-	inline MeshCPU LoadObj(const std::filesystem::path& pathIn)
+	if (part.empty())
 	{
-		namespace fs = std::filesystem;
+		return -1;
+	}
+	const char* first = part.data();
+	if (*first == '+')
+	{
+		++first;
+	}
+	std::int32_t raw = 0;
+	const auto [ptr, ec] = std::from_chars(first, part.data() + part.size(), raw);
+	if (ec != std::errc{})
+	{
+		throw std::runtime_error("OBJ: malformed face index '" + std::string(part) + "'");
+	}
+	if (raw > 0)
+	{
+		return raw - 1;
+	}
+	if (raw < 0)
+	{
+		relative |= bit;
+		return static_cast<std::int32_t>(localCount) + raw;
+	}
+	return -1;
+}
+
+inline void ParseObjFace(const char* p, const char* end, ObjChunk& chunk)
+{
+	const std::size_t firstCorner = chunk.corners.size();
+	while (true)
+	{
+		p = SkipObjSpaces(p, end);
+		if (p == end)
+		{
+			break;
+		}
+		const char* tokenEnd = p;
+		while (tokenEnd < end && !IsObjSpace(*tokenEnd))
+		{
+			++tokenEnd;
+		}
+
+		// v, v/vt, v//vn, v/vt/vn
+		std::string_view parts[3]{};
+		std::size_t partCount = 0;
+		const char* partBegin = p;
+		for (const char* c = p; ; ++c)
+		{
+			if (c == tokenEnd || *c == '/')
+			{
+				if (partCount < 3)
+				{
+					parts[partCount++] = std::string_view(partBegin, static_cast<std::size_t>(c - partBegin));
+				}
+				if (c == tokenEnd)
+				{
+					break;
+				}
+				partBegin = c + 1;
+			}
+		}
+
+		ObjCorner corner{};
+		corner.index[0] = ResolveObjIndex(parts[0], chunk.positions.size() / 3, 1u, corner.relative);
+		corner.index[1] = ResolveObjIndex(parts[1], chunk.uvs.size() / 2, 2u, corner.relative);
+		corner.index[2] = ResolveObjIndex(parts[2], chunk.normals.size() / 3, 4u, corner.relative);
+		chunk.corners.push_back(corner);
+		p = tokenEnd;
+	}
+
+	const std::size_t cornerCount = chunk.corners.size() - firstCorner;
+	if (cornerCount < 3)
+	{
+		chunk.corners.resize(firstCorner);
+		return;
+	}
+	chunk.faceSizes.push_back(static_cast<std::uint32_t>(cornerCount));
+}
+
+inline void ParseObjLine(const char* p, const char* end, ObjChunk& chunk)
+{
+	p = SkipObjSpaces(p, end);
+	const char* tagEnd = p;
+	while (tagEnd < end && !IsObjSpace(*tagEnd))
+	{
+		++tagEnd;
+	}
+	const std::string_view tag(p, static_cast<std::size_t>(tagEnd - p));
+	p = tagEnd;
+
+	if (tag == "v")
+	{
+		const float x = ParseObjFloat(p, end);
+		const float y = ParseObjFloat(p, end);
+		const float z = ParseObjFloat(p, end);
+		chunk.positions.insert(chunk.positions.end(), { x, y, z });
+	}
+	else if (tag == "vn")
+	{
+		const float x = ParseObjFloat(p, end);
+		const float y = ParseObjFloat(p, end);
+		const float z = ParseObjFloat(p, end);
+		chunk.normals.insert(chunk.normals.end(), { x, y, z });
+	}
+	else if (tag == "vt")
+	{
+		const float u = ParseObjFloat(p, end);
+		const float v = ParseObjFloat(p, end);
+		chunk.uvs.insert(chunk.uvs.end(), { u, v });
+	}
+	else if (tag == "f")
+	{
+		ParseObjFace(p, end, chunk);
+	}
+}
+
+inline ObjChunk ParseObjChunk(std::string_view text)
+{
+	ObjChunk chunk{};
+	const char* p = text.data();
+	const char* const end = p + text.size();
+	while (p < end)
+	{
+		const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+		if (lineEnd == nullptr)
+		{
+			lineEnd = end;
+		}
+		ParseObjLine(p, lineEnd, chunk);
+		p = (lineEnd == end) ? end : lineEnd + 1;
+	}
+	return chunk;
+}
+
+// Roughly equal pieces of `text`, each ending after a '\n' (the last one at the end of the text).
+inline std::vector<std::string_view> SplitObjText(std::string_view text, std::size_t chunkCount)
+{
+	std::vector<std::string_view> chunks;
+	chunks.reserve(chunkCount);
+	std::size_t begin = 0;
+	for (std::size_t i = 1; i <= chunkCount && begin < text.size(); ++i)
+	{
+		std::size_t end = text.size();
+		if (i < chunkCount)
+		{
+			const std::size_t newline = text.find('\n', std::max(begin, text.size() * i / chunkCount));
+			end = (newline == std::string_view::npos) ? text.size() : newline + 1;
+		}
+		chunks.push_back(text.substr(begin, end - begin));
+		begin = end;
+	}
+	return chunks;
+}
+
+template <class Map, class MakeKey>
+void EmitObjFaces(
+	std::span<const ObjChunk> chunks,
+	std::span<const std::array<std::size_t, 3>> bases,
+	const std::vector<float>& pos,
+	const std::vector<float>& uv,
+	const std::vector<float>& nor,
+	rendern::MeshCPU& mesh,
+	MakeKey makeKey)
+{
+	const std::size_t counts[3]{ pos.size() / 3, uv.size() / 2, nor.size() / 3 };
+
+	Map dedup;
+	dedup.reserve(counts[0]);
 
-		fs::path path = pathIn;
-		if (!path.is_absolute())
+	std::vector<std::uint32_t> face;
+	for (std::size_t c = 0; c < chunks.size(); ++c)
+	{
+		const ObjChunk& chunk = chunks[c];
+		std::size_t corner = 0;
+		for (const std::uint32_t faceSize : chunk.faceSizes)
 		{
-			path = corefs::ResolveAsset(path);
+			face.clear();
+			for (std::uint32_t k = 0; k < faceSize; ++k, ++corner)
+			{
+				const ObjCorner& parsed = chunk.corners[corner];
+				std::int64_t index[3]{};
+				for (std::size_t a = 0; a < 3; ++a)
+				{
+					index[a] = parsed.index[a];
+					if ((parsed.relative >> a) & 1u)
+					{
+						index[a] += static_cast<std::int64_t>(bases[c][a]);
+					}
+					else if (index[a] < 0)
+					{
+						continue;
+					}
+					if (index[a] < 0 || index[a] >= static_cast<std::int64_t>(counts[a]))
+					{
+						throw std::runtime_error("OBJ face references a missing vertex");
+					}
+				}
+				if (index[0] < 0)
+				{
+					throw std::runtime_error("OBJ face corner without a position");
+				}
+
+				const Key key{ static_cast<int>(index[0]), static_cast<int>(index[1]), static_cast<int>(index[2]) };
+				const auto [it, inserted] = dedup.try_emplace(makeKey(key), static_cast<std::uint32_t>(mesh.vertices.size()));
+				if (inserted)
+				{
+					rendern::VertexDesc vertexDesc{};
+					vertexDesc.px = pos[key.v * 3 + 0];
+					vertexDesc.py = pos[key.v * 3 + 1];
+					vertexDesc.pz = pos[key.v * 3 + 2];
+					vertexDesc.nz = 1.0f;
+					if (key.vn >= 0)
+					{
+						vertexDesc.nx = nor[key.vn * 3 + 0];
+						vertexDesc.ny = nor[key.vn * 3 + 1];
+						vertexDesc.nz = nor[key.vn * 3 + 2];
+					}
+					if (key.vt >= 0)
+					{
+						vertexDesc.u = uv[key.vt * 2 + 0];
+						vertexDesc.v = uv[key.vt * 2 + 1];
+					}
+					mesh.vertices.push_back(vertexDesc);
+				}
+				face.push_back(it->second);
+			}
+
+			// fan triangulation: (0, i, i+1)
+			for (std::size_t i = 1; i + 1 < face.size(); ++i)
+			{
+				mesh.indices.insert(mesh.indices.end(), { face[0], face[i], face[i + 1] });
+			}
 		}
+	}
+}
 
-		const auto txt = FILE_UTILS::ReadAllText(path);
+export namespace rendern
+{
+	struct ObjParseOptions
+	{
+		std::uint32_t maxThreads{ 0 };        // 0: std::thread::hardware_concurrency()
+		std::size_t minChunkBytes{ 1u << 20 }; // text below this per thread parses on the calling thread
+	};
 
+	// Reference parser (std::istringstream per line, std::string per token). Kept as the
+	// behavioural baseline for ParseObj; not used for loading. No tangents.
+	inline MeshCPU ParseObjReference(std::string_view text)
+	{
 		std::vector<float> pos;
 		std::vector<float> nor;
 		std::vector<float> uv;
@@ -96,7 +423,7 @@ export namespace rendern
 		MeshCPU mesh;
 		std::unordered_map<Key, std::uint32_t, KeyHash> dedup;
 
-		std::istringstream ss(txt);
+		std::istringstream ss{ std::string(text) };
 		std::string line;
 
 		while (std::getline(ss, line))
@@ -210,6 +537,125 @@ export namespace rendern
 			}
 		}
 
+		return mesh;
+	}
+
+	// Same vertices and indices as ParseObjReference for well-formed input; malformed or
+	// out-of-range face indices throw instead of being read blindly. No tangents.
+	inline MeshCPU ParseObj(std::string_view text, const ObjParseOptions& options = {})
+	{
+		std::size_t chunkCount = 1;
+		if (options.minChunkBytes > 0 && text.size() >= 2 * options.minChunkBytes)
+		{
+			const std::size_t threads = (options.maxThreads != 0) ? options.maxThreads : std::max(1u, std::thread::hardware_concurrency());
+			chunkCount = std::clamp<std::size_t>(text.size() / options.minChunkBytes, 1, threads);
+		}
+
+		const std::vector<std::string_view> pieces = SplitObjText(text, chunkCount);
+		std::vector<ObjChunk> chunks(pieces.size());
+		{
+			std::vector<std::exception_ptr> errors(pieces.size());
+			std::vector<std::jthread> workers;
+			workers.reserve(pieces.size());
+			for (std::size_t i = 1; i < pieces.size(); ++i)
+			{
+				workers.emplace_back([&, i]
+					{
+						try
+						{
+							chunks[i] = ParseObjChunk(pieces[i]);
+						}
+						catch (...)
+						{
+							errors[i] = std::current_exception();
+						}
+					});
+			}
+			if (!pieces.empty())
+			{
+				try
+				{
+					chunks[0] = ParseObjChunk(pieces[0]);
+				}
+				catch (...)
+				{
+					errors[0] = std::current_exception();
+				}
+			}
+			workers.clear(); // joins
+
+			for (const std::exception_ptr& error : errors)
+			{
+				if (error)
+				{
+					std::rethrow_exception(error);
+				}
+			}
+		}
+
+		// Merge the attribute streams; each chunk's relative indices start at its base.
+		std::vector<std::array<std::size_t, 3>> bases(chunks.size());
+		std::vector<float> pos;
+		std::vector<float> uv;
+		std::vector<float> nor;
+		std::size_t triangleCount = 0;
+		{
+			std::array<std::size_t, 3> floats{};
+			for (const ObjChunk& chunk : chunks)
+			{
+				floats[0] += chunk.positions.size();
+				floats[1] += chunk.uvs.size();
+				floats[2] += chunk.normals.size();
+				for (const std::uint32_t faceSize : chunk.faceSizes)
+				{
+					triangleCount += faceSize - 2;
+				}
+			}
+			pos.reserve(floats[0]);
+			uv.reserve(floats[1]);
+			nor.reserve(floats[2]);
+		}
+		for (std::size_t c = 0; c < chunks.size(); ++c)
+		{
+			bases[c] = { pos.size() / 3, uv.size() / 2, nor.size() / 3 };
+			pos.insert(pos.end(), chunks[c].positions.begin(), chunks[c].positions.end());
+			uv.insert(uv.end(), chunks[c].uvs.begin(), chunks[c].uvs.end());
+			nor.insert(nor.end(), chunks[c].normals.begin(), chunks[c].normals.end());
+		}
+
+		MeshCPU mesh;
+		mesh.vertices.reserve(pos.size() / 3);
+		mesh.indices.reserve(triangleCount * 3);
+
+		const int vBits = std::bit_width(pos.size() / 3);
+		const int vtBits = std::bit_width(uv.size() / 2 + 1);
+		const int vnBits = std::bit_width(nor.size() / 3 + 1);
+		if (vBits + vtBits + vnBits <= 64)
+		{
+			EmitObjFaces<containers::FlatHashMap<std::uint64_t, std::uint32_t, ObjPackedKeyHash>>(chunks, bases, pos, uv, nor, mesh,
+				[vBits, vtBits](const Key& key)
+				{
+					return static_cast<std::uint64_t>(key.v)
+						| (static_cast<std::uint64_t>(key.vt + 1) << vBits)
+						| (static_cast<std::uint64_t>(key.vn + 1) << (vBits + vtBits));
+				});
+		}
+		else
+		{
+			EmitObjFaces<containers::FlatHashMap<Key, std::uint32_t, ObjWideKeyHash>>(chunks, bases, pos, uv, nor, mesh,
+				[](const Key& key) { return key; });
+		}
+		return mesh;
+	}
+
+	inline MeshCPU LoadObj(const std::filesystem::path& pathIn, const ObjParseOptions& options = {})
+	{
+		const std::filesystem::path path = pathIn.is_absolute() ? pathIn : corefs::ResolveAsset(pathIn);
+
+		const corefs::MappedFile file(path);
+		const std::span<const std::byte> bytes = file.Bytes();
+		MeshCPU mesh = ParseObj(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()), options);
+
 		if (mesh.vertices.empty() || mesh.indices.empty())
 		{
 			throw std::runtime_error("OBJ is empty or unsupported: " + path.string());
@@ -218,4 +664,20 @@ export namespace rendern
 		ComputeTangents(mesh);
 		return mesh;
 	}
-}
\ No newline at end of file
+
+	// LoadObj through ParseObjReference.
+	inline MeshCPU LoadObjReference(const std::filesystem::path& pathIn)
+	{
+		const std::filesystem::path path = pathIn.is_absolute() ? pathIn : corefs::ResolveAsset(pathIn);
+
+		MeshCPU mesh = ParseObjReference(FILE_UTILS::ReadAllText(path));
+
+		if (mesh.vertices.empty() || mesh.indices.empty())
+		{
+			throw std::runtime_error("OBJ is empty or unsupported: " + path.string());
+		}
+
+		ComputeTangents(mesh);
+		return mesh;
+	}
+}
@@ -1,14 +1,17 @@
 module;
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <optional>
 
 export module core:skeleton;
 
 import :math_utils;
+import :hash_utils;
 
 export namespace rendern
 {
@@ -24,27 +27,69 @@ export namespace rendern
 	{
 		std::vector<SkeletonBone> bones;
 		std::uint32_t rootBoneIndex{ 0 };
+
+		// Filled by RebuildBoneNameLookup. Bone name hashes (Fnv1a64) sorted with their bone index; keyed by
+		// hash rather than std::string so the exported module never instantiates a string-keyed map.
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> boneNameLookup;
+		// HashSkeletonLayout at the last RebuildBoneNameLookup (0: not built).
+		std::uint64_t layoutHash{ 0 };
 	};
 
+	// Bone names and hierarchy: clips imported against skeletons with equal hashes bind to the
+	// same bone indices, so they can be shared between them.
+	[[nodiscard]] inline std::uint64_t HashSkeletonLayout(const Skeleton& skeleton) noexcept
+	{
+		std::uint64_t hash = hashUtils::Mix64(skeleton.bones.size());
+		for (const SkeletonBone& bone : skeleton.bones)
+		{
+			hash = hashUtils::Mix64(hash ^ hashUtils::Fnv1a64(bone.name));
+			hash = hashUtils::Mix64(hash ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(bone.parentIndex)));
+		}
+		return hash;
+	}
+
+	// Call again after editing bone names or parents: a lookup that no longer matches the bone count is
+	// ignored, but renamed bones would be missed.
 	inline void RebuildBoneNameLookup(Skeleton& skeleton)
 	{
-		// No-op for now.
-		//
-		// We originally cached a std::unordered_map<std::string, uint32_t> here,
-		// but MSVC modules currently trips over std::string equality during the
-		// map's comparator instantiation in this exported module. A linear search is
-		// perfectly acceptable for MVP skeletal animation and keeps the module
-		// compileable. We keep the function so later patches can restore an
-		// acceleration structure without touching call sites.
+		skeleton.boneNameLookup.clear();
+		skeleton.boneNameLookup.reserve(skeleton.bones.size());
+		for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(skeleton.bones.size()); ++i)
+		{
+			skeleton.boneNameLookup.emplace_back(hashUtils::Fnv1a64(skeleton.bones[i].name), i);
+		}
+		// Stable: duplicate names resolve to the first bone, like the linear search.
+		std::stable_sort(skeleton.boneNameLookup.begin(), skeleton.boneNameLookup.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+		skeleton.layoutHash = HashSkeletonLayout(skeleton);
 	}
 
 	[[nodiscard]] inline std::optional<std::uint32_t> FindBoneIndex(const Skeleton& skeleton, std::string_view boneName)
 	{
+		const auto NameEquals = [boneName](const std::string& candidate) noexcept
+			{
+				return candidate.size() == boneName.size()
+					&& std::char_traits<char>::compare(candidate.data(), boneName.data(), boneName.size()) == 0;
+			};
+
+		if (skeleton.boneNameLookup.size() == skeleton.bones.size() && !skeleton.bones.empty())
+		{
+			const std::uint64_t hash = hashUtils::Fnv1a64(boneName);
+			auto it = std::lower_bound(skeleton.boneNameLookup.begin(), skeleton.boneNameLookup.end(), hash,
+				[](const auto& entry, std::uint64_t value) { return entry.first < value; });
+			for (; it != skeleton.boneNameLookup.end() && it->first == hash; ++it)
+			{
+				if (it->second < skeleton.bones.size() && NameEquals(skeleton.bones[it->second].name))
+				{
+					return it->second;
+				}
+			}
+			return std::nullopt;
+		}
+
 		for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(skeleton.bones.size()); ++i)
 		{
-			const std::string& candidate = skeleton.bones[i].name;
-			if (candidate.size() == boneName.size()
-				&& std::char_traits<char>::compare(candidate.data(), boneName.data(), boneName.size()) == 0)
+			if (NameEquals(skeleton.bones[i].name))
 			{
 				return i;
 			}
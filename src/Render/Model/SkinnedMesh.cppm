@@ -11,6 +11,8 @@ module;
 export module core:skinned_mesh;
 
 import :rhi;
+import :render_gpu_memory;
+import :mesh;
 import :math_utils;
 import :animation_clip;
 import :skeleton;
@@ -86,8 +88,18 @@ export namespace rendern
 		rhi::BufferHandle indexBuffer{};
 		rhi::InputLayoutHandle layout{};
 		std::uint32_t vertexStrideBytes{ skinnedStrideVDBytes };
+		std::uint32_t vertexCount{ 0 };
 		std::uint32_t indexCount{ 0 };
 		rhi::IndexType indexType{ rhi::IndexType::UINT32 };
+
+		// Same contract as MeshRHI. The vertex buffer stays dedicated (offset 0) when compute
+		// skinning reads it as a structured buffer.
+		std::uint32_t vertexOffsetBytes{ 0 };
+		std::uint32_t indexOffsetBytes{ 0 };
+		renderer::IGPUMemoryAllocator* allocator{ nullptr };
+		// Skinned meshes are never GeometryPool ranges; kept so draw code treats both mesh kinds alike.
+		std::uint32_t firstIndex{ 0 };
+		std::int32_t baseVertex{ 0 };
 	};
 
 	struct ExternalAnimationSourceInfo
@@ -300,10 +312,13 @@ export namespace rendern
 	inline SkinnedMeshRHI UploadSkinnedMesh(
 		rhi::IRHIDevice& device,
 		const SkinnedMeshCPU& cpu,
-		std::string_view debugName = "SkinnedMesh")
+		std::string_view debugName = "SkinnedMesh",
+		renderer::IGPUMemoryAllocator* allocator = nullptr)
 	{
 		SkinnedMeshRHI out{};
+		out.allocator = allocator;
 		out.vertexStrideBytes = skinnedStrideVDBytes;
+		out.vertexCount = static_cast<std::uint32_t>(cpu.vertices.size());
 		out.indexCount = static_cast<std::uint32_t>(cpu.indices.size());
 		out.layout = CreateSkinnedVertexDescLayout(device, debugName);
 
@@ -311,11 +326,19 @@ export namespace rendern
 		vb.bindFlag = rhi::BufferBindFlag::VertexBuffer;
 		vb.usageFlag = rhi::BufferUsageFlag::Static;
 		vb.sizeInBytes = cpu.vertices.size() * sizeof(SkinnedVertexDesc);
+		if (device.SupportsCompute())
+		{
+			// Also read by the compute skinning pre-pass as a structured buffer.
+			vb.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+			vb.structuredStrideBytes = skinnedStrideVDBytes;
+		}
 		vb.debugName = std::string(debugName) + "_VB";
-		out.vertexBuffer = device.CreateBuffer(vb);
+		const renderer::BufferAllocation vbAllocation = AllocateMeshBuffer(device, allocator, vb);
+		out.vertexBuffer = vbAllocation.buffer;
+		out.vertexOffsetBytes = static_cast<std::uint32_t>(vbAllocation.offsetBytes);
 		if (!cpu.vertices.empty())
 		{
-			device.UpdateBuffer(out.vertexBuffer, std::as_bytes(std::span(cpu.vertices)));
+			device.UpdateBuffer(out.vertexBuffer, std::as_bytes(std::span(cpu.vertices)), vbAllocation.offsetBytes);
 		}
 
 		rhi::BufferDesc ib{};
@@ -323,10 +346,12 @@ export namespace rendern
 		ib.usageFlag = rhi::BufferUsageFlag::Static;
 		ib.sizeInBytes = cpu.indices.size() * sizeof(std::uint32_t);
 		ib.debugName = std::string(debugName) + "_IB";
-		out.indexBuffer = device.CreateBuffer(ib);
+		const renderer::BufferAllocation ibAllocation = AllocateMeshBuffer(device, allocator, ib);
+		out.indexBuffer = ibAllocation.buffer;
+		out.indexOffsetBytes = static_cast<std::uint32_t>(ibAllocation.offsetBytes);
 		if (!cpu.indices.empty())
 		{
-			device.UpdateBuffer(out.indexBuffer, std::as_bytes(std::span(cpu.indices)));
+			device.UpdateBuffer(out.indexBuffer, std::as_bytes(std::span(cpu.indices)), ibAllocation.offsetBytes);
 		}
 
 		return out;
@@ -336,11 +361,11 @@ export namespace rendern
 	{
 		if (mesh.indexBuffer)
 		{
-			device.DestroyBuffer(mesh.indexBuffer);
+			FreeMeshBuffer(device, mesh.allocator, mesh.indexBuffer, mesh.indexOffsetBytes);
 		}
 		if (mesh.vertexBuffer)
 		{
-			device.DestroyBuffer(mesh.vertexBuffer);
+			FreeMeshBuffer(device, mesh.allocator, mesh.vertexBuffer, mesh.vertexOffsetBytes);
 		}
 		if (mesh.layout)
 		{
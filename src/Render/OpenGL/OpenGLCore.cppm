@@ -43,6 +43,58 @@ namespace
 		}
 	}
 
+	// 0 for uncompressed formats.
+	static GLenum ToGLCompressedFormat(TextureFormat format, bool srgb)
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1:
+			return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		case TextureFormat::BC3:
+			return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case TextureFormat::BC5:
+			return GL_COMPRESSED_RG_RGTC2;
+		case TextureFormat::BC7:
+			return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+		default:
+			return 0;
+		}
+	}
+
+	static bool IsUploadableFormat(const TextureCPUData& cpuData)
+	{
+		return IsBlockCompressed(cpuData.format) || (cpuData.format == TextureFormat::RGBA && cpuData.channels == 4);
+	}
+
+	// One mip of one face: BC blocks go through glCompressedTexImage2D untouched.
+	static void UploadTextureLevel(GLenum target, GLint mip, const TextureCPUData& cpuData, const TextureMipLevel& ml, bool srgb)
+	{
+		if (IsBlockCompressed(cpuData.format))
+		{
+			glCompressedTexImage2D(
+				target,
+				mip,
+				ToGLCompressedFormat(cpuData.format, srgb),
+				static_cast<GLsizei>(ml.width),
+				static_cast<GLsizei>(ml.height),
+				0,
+				static_cast<GLsizei>(ml.pixels.size()),
+				ml.pixels.data());
+			return;
+		}
+
+		glTexImage2D(
+			target,
+			mip,
+			ToGLInternalFormat(TextureFormat::RGBA, srgb),
+			static_cast<GLsizei>(ml.width),
+			static_cast<GLsizei>(ml.height),
+			0,
+			ToGLExternalFormat(TextureFormat::RGBA),
+			GL_UNSIGNED_BYTE,
+			ml.pixels.data());
+	}
+
 	static void SetDefaultTextureParameters(bool generateMips)
 	{
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -101,7 +153,7 @@ export namespace rendern
 					return std::nullopt;
 				}
 
-				if (cpuData.format != TextureFormat::RGBA || cpuData.channels != 4)
+				if (!IsUploadableFormat(cpuData))
 				{
 					return std::nullopt;
 				}
@@ -139,25 +191,12 @@ export namespace rendern
 
 				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-				const GLenum externalFormat = ToGLExternalFormat(TextureFormat::RGBA);
-				const GLenum internalFormat = ToGLInternalFormat(TextureFormat::RGBA, properties.srgb);
-
 				for (GLuint face = 0; face < 6; ++face)
 				{
 					const auto& fm = cpuData.cubeMips[face];
 					for (std::size_t mip = 0; mip < mipLevels; ++mip)
 					{
-						const auto& ml = fm[mip];
-						glTexImage2D(
-							GL_TEXTURE_CUBE_MAP_POSITIVE_X + face,
-							static_cast<GLint>(mip),
-							internalFormat,
-							static_cast<GLsizei>(ml.width),
-							static_cast<GLsizei>(ml.height),
-							0,
-							externalFormat,
-							GL_UNSIGNED_BYTE,
-							ml.pixels.data());
+						UploadTextureLevel(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, static_cast<GLint>(mip), cpuData, fm[mip], properties.srgb);
 					}
 				}
 
@@ -179,7 +218,7 @@ export namespace rendern
 				return std::nullopt;
 			}
 
-			if (cpuData.format != TextureFormat::RGBA || cpuData.channels != 4)
+			if (!IsUploadableFormat(cpuData))
 			{
 				return std::nullopt;
 			}
@@ -199,22 +238,9 @@ export namespace rendern
 
 			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-			const GLenum externalFormat = ToGLExternalFormat(TextureFormat::RGBA);
-			const GLenum internalFormat = ToGLInternalFormat(TextureFormat::RGBA, properties.srgb);
-
 			for (std::size_t mip = 0; mip < mipLevels; ++mip)
 			{
-				const auto& ml = cpuData.mips[mip];
-				glTexImage2D(
-					GL_TEXTURE_2D,
-					static_cast<GLint>(mip),
-					internalFormat,
-					static_cast<GLsizei>(ml.width),
-					static_cast<GLsizei>(ml.height),
-					0,
-					externalFormat,
-					GL_UNSIGNED_BYTE,
-					ml.pixels.data());
+				UploadTextureLevel(GL_TEXTURE_2D, static_cast<GLint>(mip), cpuData, cpuData.mips[mip], properties.srgb);
 			}
 
 			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
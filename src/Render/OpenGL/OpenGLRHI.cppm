@@ -6,8 +6,10 @@ module;
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <span>
 #include <stdexcept>
 #include <string>
@@ -96,7 +98,8 @@ namespace
 		case rhi::VertexSemantic::Normal:
 			return 1;
 		case rhi::VertexSemantic::TexCoord:
-			return 2 + static_cast<std::uint32_t>(semIndex) * 4u;
+			// TEXCOORD0 -> 2, TEXCOORD1..9 -> 7..15 (instance data uses TEXCOORD1..4).
+			return semIndex == 0 ? 2u : 6u + static_cast<std::uint32_t>(semIndex);
 		case rhi::VertexSemantic::Color:
 			return 3;
 		case rhi::VertexSemantic::Tangent:
@@ -121,10 +124,16 @@ namespace
 		{
 		case rhi::Format::RGBA8_UNORM:
 			return GL_RGBA8;
+		case rhi::Format::RGBA8_UNORM_SRGB:
+			return GL_SRGB8_ALPHA8;
 		case rhi::Format::RGBA16_FLOAT:
 			return GL_RGBA16F;
 		case rhi::Format::R32_FLOAT:
 			return GL_R32F;
+		case rhi::Format::R32_UINT:
+			return GL_R32UI;
+		case rhi::Format::RG16_UNORM:
+			return GL_RG16;
 		case rhi::Format::BGRA8_UNORM:
 			return GL_RGBA8;
 		case rhi::Format::D32_FLOAT:
@@ -141,12 +150,17 @@ namespace
 		switch (format)
 		{
 		case rhi::Format::RGBA8_UNORM:
+		case rhi::Format::RGBA8_UNORM_SRGB:
 		case rhi::Format::RGBA16_FLOAT:
 			return GL_RGBA;
 		case rhi::Format::BGRA8_UNORM:
 			return GL_BGRA;
 		case rhi::Format::R32_FLOAT:
 			return GL_RED;
+		case rhi::Format::R32_UINT:
+			return GL_RED_INTEGER;
+		case rhi::Format::RG16_UNORM:
+			return GL_RG;
 		case rhi::Format::D32_FLOAT:
 			return GL_DEPTH_COMPONENT;
 		case rhi::Format::D24_UNORM_S8_UINT:
@@ -161,12 +175,17 @@ namespace
 		switch (format)
 		{
 		case rhi::Format::RGBA8_UNORM:
+		case rhi::Format::RGBA8_UNORM_SRGB:
 		case rhi::Format::BGRA8_UNORM:
 			return GL_UNSIGNED_BYTE;
+		case rhi::Format::RG16_UNORM:
+			return GL_UNSIGNED_SHORT;
 		case rhi::Format::RGBA16_FLOAT:
 		case rhi::Format::R32_FLOAT:
 		case rhi::Format::D32_FLOAT:
 			return GL_FLOAT;
+		case rhi::Format::R32_UINT:
+			return GL_UNSIGNED_INT;
 		case rhi::Format::D24_UNORM_S8_UINT:
 			return GL_UNSIGNED_INT_24_8;
 		default:
@@ -257,6 +276,7 @@ namespace
 		case rhi::BufferBindFlag::UniformBuffer:
 			return GL_UNIFORM_BUFFER;
 		case rhi::BufferBindFlag::StructuredBuffer:
+		case rhi::BufferBindFlag::StorageBuffer:
 			return GL_SHADER_STORAGE_BUFFER;
 		default:
 			return GL_ARRAY_BUFFER;
@@ -330,8 +350,12 @@ namespace
 		std::uint32_t strideBytes{};
 		std::vector<GLAttrib> attribs;
 		std::string debugName;
+		bool perInstance{ false }; // has slot 1 (per-instance) attributes
 	};
 
+	// Slot 0 is per-vertex, slot 1 per-instance (divisor 1), as in the DX12 backend.
+	constexpr std::uint32_t kMaxVertexSlots = 2;
+
 	static GLenum ToGLShaderStage(rhi::ShaderStage stage)
 	{
 		switch (stage)
@@ -393,6 +417,14 @@ namespace
 			outComponents = 4;
 			outType = GL_UNSIGNED_INT;
 			break;
+		case rhi::VertexFormat::R16G16_SNORM:
+			outComponents = 2;
+			outType = GL_SHORT;
+			break;
+		case rhi::VertexFormat::R16G16_FLOAT:
+			outComponents = 2;
+			outType = GL_HALF_FLOAT;
+			break;
 		default:
 			outComponents = 4;
 			outType = GL_FLOAT;
@@ -406,6 +438,9 @@ namespace
 		std::uint32_t vbId{};
 		std::uint32_t vbOffset{};
 		std::uint32_t vbStride{};
+		std::uint32_t instVbId{};
+		std::uint32_t instVbOffset{};
+		std::uint32_t instVbStride{};
 		std::uint32_t ibId{};
 		std::uint32_t ibOffset{};
 		rhi::IndexType indexType{ rhi::IndexType::UINT16 };
@@ -416,6 +451,9 @@ namespace
 				&& a.vbId == b.vbId
 				&& a.vbOffset == b.vbOffset
 				&& a.vbStride == b.vbStride
+				&& a.instVbId == b.instVbId
+				&& a.instVbOffset == b.instVbOffset
+				&& a.instVbStride == b.instVbStride
 				&& a.ibId == b.ibId
 				&& a.ibOffset == b.ibOffset
 				&& a.indexType == b.indexType;
@@ -435,6 +473,9 @@ namespace
 			mix(key.vbId);
 			mix(key.vbOffset);
 			mix(key.vbStride);
+			mix(key.instVbId);
+			mix(key.instVbOffset);
+			mix(key.instVbStride);
 			mix(key.ibId);
 			mix(key.ibOffset);
 			mix(static_cast<std::uint32_t>(key.indexType));
@@ -448,6 +489,38 @@ namespace
 		bool signaled{ false };
 	};
 
+	// Timestamp zones of one submission: zone i writes queries[2 * i] and queries[2 * i + 1].
+	struct GLTimestampFrame
+	{
+		struct Zone
+		{
+			std::string name;
+			std::uint32_t depth{ 0 };
+		};
+
+		std::vector<GLuint> queries;
+		std::vector<Zone> zones;
+	};
+
+	// Persistently mapped, coherent upload ring (GL 4.4 / ARB_buffer_storage). Positions are running byte
+	// counts (ring offset = position % capacity): [tail, head) may still be read by the GPU. Each
+	// submission ends with a fence tagged with the head at that point; once it signals, tail moves there.
+	struct GLStreamRing
+	{
+		struct Retire
+		{
+			GLsync sync{ nullptr };
+			std::uint64_t head{ 0 };
+		};
+
+		GLuint buffer{ 0 };
+		std::byte* mapped{ nullptr };
+		std::uint64_t capacity{ 0 };
+		std::uint64_t head{ 0 };
+		std::uint64_t tail{ 0 };
+		std::deque<Retire> pending;
+	};
+
 	struct VertexBufferState
 	{
 		rhi::BufferHandle buffer{};
@@ -539,12 +612,59 @@ namespace rhi
 				name_ += " | ";
 				name_ += reinterpret_cast<const char*>(version);
 			}
+
+			// GL 4.3 / ARB_multi_draw_indirect; the count variant needs 4.6 / ARB_indirect_parameters.
+			hasMultiDrawIndirect_ = glMultiDrawElementsIndirect != nullptr;
+			hasMultiDrawIndirectCount_ = glMultiDrawElementsIndirectCountARB != nullptr;
+			// GL 3.3 / ARB_timer_query.
+			hasTimestampQueries_ = glQueryCounter != nullptr && glGetQueryObjectui64v != nullptr;
+			// GL 4.4 / ARB_buffer_storage: persistent mapped streaming. Without it, uploads fall back to
+			// glBufferSubData and per-draw constants to an orphaned uniform buffer.
+			hasBufferStorage_ = glBufferStorage != nullptr;
+			// GL 4.2 / ARB_base_instance: instanced draws starting at firstInstance.
+			hasBaseInstance_ = glDrawElementsInstancedBaseVertexBaseInstance != nullptr && glDrawArraysInstancedBaseInstance != nullptr;
+			// ARB_bindless_texture: TextureDescIndex -> resident handle table the shaders index.
+			hasBindlessTextures_ = glGetTextureHandleARB != nullptr
+				&& glMakeTextureHandleResidentARB != nullptr
+				&& glMakeTextureHandleNonResidentARB != nullptr;
+
+			GLint uboAlignment = 0;
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uboAlignment);
+			uniformOffsetAlignment_ = static_cast<std::size_t>(std::max(uboAlignment, 1));
+
+			if (hasBufferStorage_)
+			{
+				CreateStreamRing();
+			}
 		}
 
 		~GLDevice()
 		{
 			InvalidateVaoCache();
 
+			for (GLStreamRing::Retire& retire : streamRing_.pending)
+			{
+				glDeleteSync(retire.sync);
+			}
+			streamRing_.pending.clear();
+			if (streamRing_.buffer != 0)
+			{
+				// Deleting a buffer also unmaps it.
+				glDeleteBuffers(1, &streamRing_.buffer);
+			}
+			if (constantsFallbackBuffer_ != 0)
+			{
+				glDeleteBuffers(1, &constantsFallbackBuffer_);
+			}
+			if (bindlessTable_.id != 0)
+			{
+				DestroyBuffer(bindlessTable_);
+			}
+			for (const auto& [handle, _] : residentTextureHandles_)
+			{
+				glMakeTextureHandleNonResidentARB(handle);
+			}
+
 			for (auto& [_, fence] : fences_)
 			{
 				if (fence.sync)
@@ -553,6 +673,14 @@ namespace rhi
 				}
 			}
 			fences_.clear();
+
+			for (GLTimestampFrame& frame : timestampFrames_)
+			{
+				if (!frame.queries.empty())
+				{
+					glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+				}
+			}
 		}
 
 		Backend GetBackend() const noexcept override
@@ -560,6 +688,41 @@ namespace rhi
 			return Backend::OpenGL;
 		}
 
+		bool SupportsMultiDrawIndirect() const override
+		{
+			return hasMultiDrawIndirect_;
+		}
+
+		bool SupportsTimestampQueries() const override
+		{
+			return hasTimestampQueries_;
+		}
+
+		bool SupportsBindlessTextures() const override
+		{
+			return hasBindlessTextures_;
+		}
+
+		SubmissionStats GetLastSubmissionStats() const override
+		{
+			return lastSubmissionStats_;
+		}
+
+		std::span<const GpuTimestampZone> GetLastGpuTimestampZones() const override
+		{
+			return lastGpuZones_;
+		}
+
+		DeviceCounters GetDeviceCounters() const override
+		{
+			return deviceCounters_;
+		}
+
+		std::uint32_t GetFramesInFlight() const noexcept override
+		{
+			return hasBufferStorage_ ? kStreamFramesInFlight : 1u;
+		}
+
 		std::string_view GetName() const override
 		{
 			return name_;
@@ -637,6 +800,12 @@ void DestroyTexture(TextureHandle texture) noexcept override
 			GLuint textureId = static_cast<GLuint>(texture.id);
 			if (textureId != 0)
 			{
+				// Deleting the texture deletes its bindless handle along with it.
+				if (auto it = textureHandles_.find(textureId); it != textureHandles_.end())
+				{
+					residentTextureHandles_.erase(it->second);
+					textureHandles_.erase(it);
+				}
 				glDeleteTextures(1, &textureId);
 			}
 		}
@@ -722,7 +891,21 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			bufferTargets_[bufferId] = target;
 
 			glBindBuffer(target, bufferId);
-			glBufferData(target, static_cast<GLsizeiptr>(desc.sizeInBytes), nullptr, BufferUsageFor(desc.usageFlag));
+			if (desc.usageFlag == BufferUsageFlag::Stream && hasBufferStorage_ && desc.sizeInBytes != 0)
+			{
+				// Immutable storage mapped for the buffer's lifetime; MapBuffer hands out the mapping.
+				constexpr GLbitfield kFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+				const GLsizeiptr size = static_cast<GLsizeiptr>(desc.sizeInBytes);
+				glBufferStorage(target, size, nullptr, kFlags);
+				if (void* mapped = glMapBufferRange(target, 0, size, kFlags))
+				{
+					mappedBuffers_[bufferId] = std::span<std::byte>(static_cast<std::byte*>(mapped), desc.sizeInBytes);
+				}
+			}
+			else
+			{
+				glBufferData(target, static_cast<GLsizeiptr>(desc.sizeInBytes), nullptr, BufferUsageFor(desc.usageFlag));
+			}
 			glBindBuffer(target, 0);
 
 			InvalidateVaoCache();
@@ -737,12 +920,51 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 				return;
 			}
 
+			++deviceCounters_.bufferUpdates;
+			deviceCounters_.bufferUploadBytes += data.size();
+
+			if (auto it = mappedBuffers_.find(bufferId); it != mappedBuffers_.end())
+			{
+				if (offsetBytes + data.size() > it->second.size())
+				{
+					throw std::runtime_error("OpenGLRHI: UpdateBuffer out of bounds");
+				}
+				std::memcpy(it->second.data() + offsetBytes, data.data(), data.size());
+				return;
+			}
+
+			// Stage through the ring and copy on the GPU: glBufferSubData into a buffer the GPU may still
+			// be reading makes the driver wait for it (or shadow-copy the whole buffer).
+			if (const std::optional<std::uint64_t> staged = WriteStream(data, 4))
+			{
+				glBindBuffer(GL_COPY_READ_BUFFER, streamRing_.buffer);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, bufferId);
+				glCopyBufferSubData(
+					GL_COPY_READ_BUFFER,
+					GL_COPY_WRITE_BUFFER,
+					static_cast<GLintptr>(*staged),
+					static_cast<GLintptr>(offsetBytes),
+					static_cast<GLsizeiptr>(data.size()));
+				glBindBuffer(GL_COPY_READ_BUFFER, 0);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+				return;
+			}
+
 			const GLenum target = BufferTargetForId(bufferId);
 			glBindBuffer(target, bufferId);
 			glBufferSubData(target, static_cast<GLintptr>(offsetBytes), static_cast<GLsizeiptr>(data.size()), data.data());
 			glBindBuffer(target, 0);
 		}
 
+		std::span<std::byte> MapBuffer(BufferHandle buffer) override
+		{
+			if (auto it = mappedBuffers_.find(static_cast<GLuint>(buffer.id)); it != mappedBuffers_.end())
+			{
+				return it->second;
+			}
+			return {};
+		}
+
 		void DestroyBuffer(BufferHandle buffer) noexcept override
 		{
 			GLuint bufferId = static_cast<GLuint>(buffer.id);
@@ -750,6 +972,7 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			{
 				glDeleteBuffers(1, &bufferId);
 				bufferTargets_.erase(bufferId);
+				mappedBuffers_.erase(bufferId);
 			}
 			InvalidateVaoCache();
 		}
@@ -763,9 +986,9 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 
 			for (const auto& attribute : desc.attributes)
 			{
-				if (attribute.inputSlot != 0)
+				if (attribute.inputSlot >= kMaxVertexSlots)
 				{
-					throw std::runtime_error("OpenGLRHI: multiple vertex input slots are not supported yet (inputSlot != 0).");
+					throw std::runtime_error("OpenGLRHI: vertex input slot out of range (slot 0 per-vertex, slot 1 per-instance).");
 				}
 
 				GLint comps = 0;
@@ -782,6 +1005,7 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 				out.inputSlot = attribute.inputSlot;
 
 				glLayout.attribs.push_back(out);
+				glLayout.perInstance = glLayout.perInstance || attribute.inputSlot != 0;
 			}
 
 			const std::uint32_t layoutId = static_cast<std::uint32_t>(inputLayouts_.size()) + 1u;
@@ -866,32 +1090,55 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			if (programId != 0)
 			{
 				glDeleteProgram(programId);
+				uniformLocationCache_.erase(programId);
 			}
 		}
 
 		// ---------------- Command submission ----------------
 		void SubmitCommandList(CommandList&& commandList) override
 		{
-			for (const auto& command : commandList.commands)
+			if (hasBufferStorage_)
+			{
+				// Keep at most kStreamFramesInFlight submissions queued: mapped Stream buffers rely on it.
+				while (streamRing_.pending.size() >= kStreamFramesInFlight)
+				{
+					RetireOldestStream();
+				}
+			}
+
+			if (hasBindlessTextures_)
 			{
-				std::visit([this](auto&& cmd) { ExecuteOnce(cmd); }, command);
+				FlushBindlessTable();
+			}
+
+			lastSubmissionStats_ = {};
+			BeginTimestampFrame();
+			commandList.ForEach([this](const auto& cmd) { ExecuteOnce(cmd); });
+			EndTimestampFrame();
+
+			if (hasBufferStorage_)
+			{
+				FenceStream();
 			}
 		}
 
 		// ---------------- Texture descriptors ----------------
 		TextureDescIndex AllocateTextureDesctiptor(TextureHandle texture) override
 		{
+			++deviceCounters_.descriptorAllocations;
 			if (!freeTextureDescIndices_.empty())
 			{
 				const TextureDescIndex index = freeTextureDescIndices_.back();
 				freeTextureDescIndices_.pop_back();
 				textureDescriptions_[index] = texture;
+				SetBindlessHandle(index, texture);
 				return index;
 
 			}
 
 			const TextureDescIndex index = static_cast<TextureDescIndex>(textureDescriptions_.size());
 			textureDescriptions_.push_back(texture);
+			SetBindlessHandle(index, texture);
 			return index;
 		}
 
@@ -907,6 +1154,7 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 				textureDescriptions_.resize(vecIndex + 1);
 			}
 			textureDescriptions_[vecIndex] = texture;
+			SetBindlessHandle(index, texture);
 		}
 
 		void FreeTextureDescriptor(TextureDescIndex index) noexcept override
@@ -919,6 +1167,7 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			if (vecIndex < textureDescriptions_.size())
 			{
 				textureDescriptions_[vecIndex] = TextureHandle{};
+				SetBindlessHandle(index, TextureHandle{});
 				freeTextureDescIndices_.push_back(index);
 			}
 		}
@@ -1085,6 +1334,160 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			return nullptr;
 		}
 
+		// -------- Stream ring --------
+		void CreateStreamRing()
+		{
+			constexpr GLbitfield kFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			glGenBuffers(1, &streamRing_.buffer);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, streamRing_.buffer);
+			glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(kStreamRingBytes), nullptr, kFlags);
+			streamRing_.mapped = static_cast<std::byte*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(kStreamRingBytes), kFlags));
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+			if (!streamRing_.mapped)
+			{
+				glDeleteBuffers(1, &streamRing_.buffer);
+				streamRing_.buffer = 0;
+				return;
+			}
+			streamRing_.capacity = kStreamRingBytes;
+		}
+
+		// Copies `data` into the ring and returns its offset in streamRing_.buffer. Blocks on the oldest
+		// submissions while they still read the space it needs. std::nullopt when the ring is unavailable
+		// or smaller than the request.
+		std::optional<std::uint64_t> WriteStream(std::span<const std::byte> data, std::size_t alignment)
+		{
+			GLStreamRing& ring = streamRing_;
+			if (!ring.mapped || data.size() > ring.capacity)
+			{
+				return std::nullopt;
+			}
+
+			const std::uint64_t align = static_cast<std::uint64_t>(alignment);
+			std::uint64_t start = (ring.head + align - 1) / align * align;
+			if (start % ring.capacity + data.size() > ring.capacity)
+			{
+				// Doesn't fit before the end of the buffer: skip to the start of the next lap.
+				start = (start / ring.capacity + 1) * ring.capacity;
+			}
+			const std::uint64_t end = start + data.size();
+
+			while (end - ring.tail > ring.capacity)
+			{
+				if (ring.pending.empty())
+				{
+					// Everything in flight was written for commands that are not fenced yet.
+					FenceStream();
+				}
+				RetireOldestStream();
+			}
+
+			const std::uint64_t offset = start % ring.capacity;
+			std::memcpy(ring.mapped + offset, data.data(), data.size());
+			ring.head = end;
+			return offset;
+		}
+
+		void FenceStream()
+		{
+			GLStreamRing& ring = streamRing_;
+			ring.pending.push_back(GLStreamRing::Retire{ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), ring.head });
+		}
+
+		void RetireOldestStream()
+		{
+			GLStreamRing& ring = streamRing_;
+			GLStreamRing::Retire& retire = ring.pending.front();
+			GLenum status = GL_TIMEOUT_EXPIRED;
+			while (status == GL_TIMEOUT_EXPIRED)
+			{
+				status = glClientWaitSync(retire.sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000ull);
+			}
+			glDeleteSync(retire.sync);
+			ring.tail = retire.head;
+			ring.pending.pop_front();
+		}
+
+		// -------- Bindless textures --------
+		// Points table entry `index` at `texture`'s resident handle (0 for none). A handle stays resident
+		// while any entry uses it; handles of textures the table no longer references are made non-resident.
+		void SetBindlessHandle(TextureDescIndex index, TextureHandle texture) noexcept
+		{
+			if (!hasBindlessTextures_)
+			{
+				return;
+			}
+
+			const std::size_t idx = static_cast<std::size_t>(index);
+			if (idx >= bindlessHandles_.size())
+			{
+				bindlessHandles_.resize(idx + 1, 0);
+			}
+
+			GLuint64 handle = 0;
+			if (texture.id != 0)
+			{
+				const GLuint textureId = static_cast<GLuint>(texture.id);
+				auto [it, inserted] = textureHandles_.try_emplace(textureId, 0);
+				if (inserted)
+				{
+					// Freezes the texture's sampling state; descriptors are allocated once the texture is filled.
+					it->second = glGetTextureHandleARB(textureId);
+				}
+				handle = it->second;
+				if (handle != 0 && residentTextureHandles_[handle]++ == 0)
+				{
+					glMakeTextureHandleResidentARB(handle);
+				}
+			}
+
+			if (const GLuint64 old = bindlessHandles_[idx]; old != 0)
+			{
+				if (auto it = residentTextureHandles_.find(old); it != residentTextureHandles_.end() && --it->second == 0)
+				{
+					glMakeTextureHandleNonResidentARB(old);
+					residentTextureHandles_.erase(it);
+				}
+			}
+
+			bindlessHandles_[idx] = handle;
+			bindlessTableDirty_ = true;
+		}
+
+		// Uploads the handle table if it changed and binds it to kBindlessTableBinding (std430 uvec2[]).
+		void FlushBindlessTable()
+		{
+			if (bindlessTableDirty_ && !bindlessHandles_.empty())
+			{
+				const std::size_t bytes = bindlessHandles_.size() * sizeof(GLuint64);
+				if (bytes > bindlessTableBytes_)
+				{
+					if (bindlessTable_.id != 0)
+					{
+						DestroyBuffer(bindlessTable_);
+					}
+					bindlessTableBytes_ = std::max<std::size_t>(bytes * 2, 4096);
+
+					BufferDesc desc{};
+					desc.bindFlag = BufferBindFlag::StructuredBuffer;
+					desc.usageFlag = BufferUsageFlag::Dynamic;
+					desc.sizeInBytes = bindlessTableBytes_;
+					desc.structuredStrideBytes = sizeof(GLuint64);
+					desc.debugName = "GLBindlessTextureTable";
+					bindlessTable_ = CreateBuffer(desc);
+				}
+				UpdateBuffer(bindlessTable_, std::as_bytes(std::span{ bindlessHandles_ }), 0);
+				bindlessTableDirty_ = false;
+			}
+
+			if (bindlessTable_.id != 0)
+			{
+				glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindlessTableBinding, static_cast<GLuint>(bindlessTable_.id));
+			}
+		}
+
 		void InvalidateVaoCache()
 		{
 			for (auto& [_, vao] : vaoCache_)
@@ -1100,7 +1503,6 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 
 		GLuint GetOrCreateVAO(bool requireIndexBuffer)
 		{
-			// Currently: support only slot 0.
 			if (currentLayout_.id == 0)
 			{
 				throw std::runtime_error("OpenGLRHI: Draw called without InputLayout bound.");
@@ -1119,6 +1521,10 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			{
 				throw std::runtime_error("OpenGLRHI: invalid InputLayout handle.");
 			}
+			if (layout->perInstance && vertexBuffer_[1].buffer.id == 0)
+			{
+				throw std::runtime_error("OpenGLRHI: instanced InputLayout drawn without a slot 1 VertexBuffer.");
+			}
 
 			const GLuint vbId = static_cast<GLuint>(vertexBuffer_[0].buffer.id);
 			const GLuint ibId = static_cast<GLuint>(indexBuffer_.buffer.id);
@@ -1128,6 +1534,12 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			key.vbId = vbId;
 			key.vbOffset = vertexBuffer_[0].offsetBytes;
 			key.vbStride = (vertexBuffer_[0].strideBytes != 0) ? vertexBuffer_[0].strideBytes : layout->strideBytes;
+			if (layout->perInstance)
+			{
+				key.instVbId = vertexBuffer_[1].buffer.id;
+				key.instVbOffset = vertexBuffer_[1].offsetBytes;
+				key.instVbStride = vertexBuffer_[1].strideBytes;
+			}
 			key.ibId = requireIndexBuffer ? ibId : 0u;
 			key.ibOffset = requireIndexBuffer ? indexBuffer_.offsetBytes : 0u;
 			key.indexType = indexBuffer_.indexType;
@@ -1141,20 +1553,22 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			glGenVertexArrays(1, &vao);
 			glBindVertexArray(vao);
 
-			glBindBuffer(GL_ARRAY_BUFFER, vbId);
 			if (requireIndexBuffer)
 			{
 				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibId);
 			}
 
-			const GLsizei stride = static_cast<GLsizei>(key.vbStride);
-
 			for (const auto& attribute : layout->attribs)
 			{
+				const bool instanced = attribute.inputSlot != 0;
 				const GLuint loc = attribute.location;
+				glBindBuffer(GL_ARRAY_BUFFER, instanced ? key.instVbId : key.vbId);
 				glEnableVertexAttribArray(loc);
+				glVertexAttribDivisor(loc, instanced ? 1u : 0u);
 
-				const std::uintptr_t ptrOffset = static_cast<std::uintptr_t>(key.vbOffset) + static_cast<std::uintptr_t>(attribute.offsetBytes);
+				const GLsizei stride = static_cast<GLsizei>(instanced ? key.instVbStride : key.vbStride);
+				const std::uintptr_t ptrOffset = static_cast<std::uintptr_t>(instanced ? key.instVbOffset : key.vbOffset)
+					+ static_cast<std::uintptr_t>(attribute.offsetBytes);
 				if (attribute.integerInput == GL_TRUE)
 				{
 					glVertexAttribIPointer(
@@ -1177,6 +1591,7 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			}
 
 			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 			vaoCache_.emplace(key, vao);
 			return vao;
@@ -1234,6 +1649,11 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 				{
 					glBlendFunc(GL_SRC_ALPHA, GL_ONE);
 				}
+				else if (state.blend.mode == BlendMode::WeightedOit)
+				{
+					glBlendFunci(0, GL_ONE, GL_ONE);
+					glBlendFunci(1, GL_ONE, GL_ONE_MINUS_SRC_COLOR);
+				}
 				else
 				{
 					glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -1246,7 +1666,7 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			}
 		}
 
-		GLint GetUniformLocationCached(const std::string& name)
+		GLint GetUniformLocationCached(std::string_view name)
 		{
 			if (currentProgram_ == 0)
 			{
@@ -1254,49 +1674,50 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			}
 
 			auto& uCache = uniformLocationCache_[currentProgram_];
-			if (auto it = uCache.find(name); it != uCache.end())
+			std::string key(name);
+			if (auto it = uCache.find(key); it != uCache.end())
 			{
 				return it->second;
 			}
 
-			GLint loc = glGetUniformLocation(currentProgram_, name.c_str());
-			uCache.emplace(name, loc);
+			const GLint loc = glGetUniformLocation(currentProgram_, key.c_str());
+			uCache.emplace(std::move(key), loc);
 			return loc;
 		}
 
-		void SetUniformIntImpl(const std::string& name, int value)
+		void SetUniformIntImpl(std::string_view name, int value)
 		{
 			if (currentProgram_ == 0)
 			{
 				return;
 			}
-			GLint location = glGetUniformLocation(currentProgram_, name.c_str());
+			const GLint location = GetUniformLocationCached(name);
 			if (location != -1)
 			{
 				glUniform1i(location, value);
 			}
 		}
 
-		void SetUniformFloat4Impl(const std::string& name, const std::array<float, 4>& value)
+		void SetUniformFloat4Impl(std::string_view name, const std::array<float, 4>& value)
 		{
 			if (currentProgram_ == 0)
 			{
 				return;
 			}
-			GLint location = glGetUniformLocation(currentProgram_, name.c_str());
+			const GLint location = GetUniformLocationCached(name);
 			if (location != -1)
 			{
 				glUniform4f(location, value[0], value[1], value[2], value[3]);
 			}
 		}
 
-		void SetUniformMat4Impl(const std::string& name, const std::array<float, 16>& value)
+		void SetUniformMat4Impl(std::string_view name, const std::array<float, 16>& value)
 		{
 			if (currentProgram_ == 0)
 			{
 				return;
 			}
-			GLint location = glGetUniformLocation(currentProgram_, name.c_str());
+			const GLint location = GetUniformLocationCached(name);
 			if (location != -1)
 			{
 				glUniformMatrix4fv(location, 1, GL_FALSE, value.data());
@@ -1331,7 +1752,17 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			}
 			if (clearMask != 0)
 			{
+				const auto& rect = cmd.desc.clearDesc.rect;
+				if (rect)
+				{
+					glEnable(GL_SCISSOR_TEST);
+					glScissor(rect->x, rect->y, rect->width, rect->height);
+				}
 				glClear(clearMask);
+				if (rect)
+				{
+					glDisable(GL_SCISSOR_TEST);
+				}
 			}
 		}
 
@@ -1340,6 +1771,13 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 		void ExecuteOnce(const CommandSetViewport& cmd)
 		{
 			glViewport(cmd.x, cmd.y, cmd.width, cmd.height);
+			glDisable(GL_SCISSOR_TEST);
+		}
+
+		void ExecuteOnce(const CommandSetScissor& cmd)
+		{
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(cmd.x, cmd.y, std::max(cmd.width, 0), std::max(cmd.height, 0));
 		}
 
 		void ExecuteOnce(const CommandSetState& cmd)
@@ -1374,13 +1812,13 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 
 		void ExecuteOnce(const rhi::CommandBindVertexBuffer& cmd)
 		{
-			if (cmd.slot != 0)
+			if (cmd.slot >= kMaxVertexSlots)
 			{
-				throw std::runtime_error("OpenGLRHI: only vertex buffer slot 0 is supported right now.");
+				throw std::runtime_error("OpenGLRHI: vertex buffer slot out of range (max 2 slots).");
 			}
-			vertexBuffer_[0].buffer = cmd.buffer;
-			vertexBuffer_[0].strideBytes = cmd.strideBytes;
-			vertexBuffer_[0].offsetBytes = cmd.offsetBytes;
+			vertexBuffer_[cmd.slot].buffer = cmd.buffer;
+			vertexBuffer_[cmd.slot].strideBytes = cmd.strideBytes;
+			vertexBuffer_[cmd.slot].offsetBytes = cmd.offsetBytes;
 		}
 
 		void ExecuteOnce(const rhi::CommandBindIndexBuffer& cmd)
@@ -1429,10 +1867,34 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			SetUniformMat4Impl(cmd.name, cmd.value);
 		}
 
-		void ExecuteOnce(const CommandSetConstants& /*cmd*/)
+		// The bytes back the uniform block at binding point `slot` (std140 layout). #version 330 shaders
+		// cannot choose a binding, so their blocks stay at binding 0 and read slot 0.
+		void ExecuteOnce(const CommandSetConstants& cmd)
 		{
-			// OpenGL backend currently uses the name-based uniform path.
-			// The constant-block command is primarily for DX12 (root CBV update).
+			if (cmd.data.empty())
+			{
+				return;
+			}
+
+			if (const std::optional<std::uint64_t> offset = WriteStream(cmd.data, uniformOffsetAlignment_))
+			{
+				glBindBufferRange(
+					GL_UNIFORM_BUFFER,
+					cmd.slot,
+					streamRing_.buffer,
+					static_cast<GLintptr>(*offset),
+					static_cast<GLsizeiptr>(cmd.data.size()));
+				return;
+			}
+
+			// No buffer storage: orphan a small buffer per draw so the driver never waits on the previous contents.
+			if (constantsFallbackBuffer_ == 0)
+			{
+				glGenBuffers(1, &constantsFallbackBuffer_);
+			}
+			glBindBuffer(GL_UNIFORM_BUFFER, constantsFallbackBuffer_);
+			glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(cmd.data.size()), cmd.data.data(), GL_STREAM_DRAW);
+			glBindBufferBase(GL_UNIFORM_BUFFER, cmd.slot, constantsFallbackBuffer_);
 		}
 
 		void ExecuteOnce(const CommandDrawIndexed& cmd)
@@ -1448,7 +1910,35 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			const std::uintptr_t start = static_cast<std::uintptr_t>(indexBuffer_.offsetBytes)
 				+ static_cast<std::uintptr_t>(cmd.firstIndex) * static_cast<std::uintptr_t>(IndexSizeBytes(cmd.indexType));
 
-			if (cmd.baseVertex != 0)
+			++lastSubmissionStats_.draws;
+			lastSubmissionStats_.instances += cmd.instanceCount;
+
+			if (cmd.instanceCount != 1 || cmd.firstInstance != 0)
+			{
+				RequireBaseInstance(cmd.firstInstance);
+				if (cmd.firstInstance != 0)
+				{
+					glDrawElementsInstancedBaseVertexBaseInstance(
+						currentTopology_,
+						static_cast<GLsizei>(cmd.indexCount),
+						indexType,
+						reinterpret_cast<const void*>(start),
+						static_cast<GLsizei>(cmd.instanceCount),
+						cmd.baseVertex,
+						cmd.firstInstance);
+				}
+				else
+				{
+					glDrawElementsInstancedBaseVertex(
+						currentTopology_,
+						static_cast<GLsizei>(cmd.indexCount),
+						indexType,
+						reinterpret_cast<const void*>(start),
+						static_cast<GLsizei>(cmd.instanceCount),
+						cmd.baseVertex);
+				}
+			}
+			else if (cmd.baseVertex != 0)
 			{
 				glDrawElementsBaseVertex(
 					currentTopology_,
@@ -1476,7 +1966,39 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 				boundVao_ = vao;
 			}
 
-			glDrawArrays(currentTopology_, static_cast<GLint>(cmd.firstVertex), static_cast<GLsizei>(cmd.vertexCount));
+			++lastSubmissionStats_.draws;
+			lastSubmissionStats_.instances += cmd.instanceCount;
+
+			if (cmd.firstInstance != 0)
+			{
+				RequireBaseInstance(cmd.firstInstance);
+				glDrawArraysInstancedBaseInstance(
+					currentTopology_,
+					static_cast<GLint>(cmd.firstVertex),
+					static_cast<GLsizei>(cmd.vertexCount),
+					static_cast<GLsizei>(cmd.instanceCount),
+					cmd.firstInstance);
+			}
+			else if (cmd.instanceCount != 1)
+			{
+				glDrawArraysInstanced(
+					currentTopology_,
+					static_cast<GLint>(cmd.firstVertex),
+					static_cast<GLsizei>(cmd.vertexCount),
+					static_cast<GLsizei>(cmd.instanceCount));
+			}
+			else
+			{
+				glDrawArrays(currentTopology_, static_cast<GLint>(cmd.firstVertex), static_cast<GLsizei>(cmd.vertexCount));
+			}
+		}
+
+		void RequireBaseInstance(std::uint32_t firstInstance) const
+		{
+			if (firstInstance != 0 && !hasBaseInstance_)
+			{
+				throw std::runtime_error("OpenGLRHI: firstInstance != 0 requires GL 4.2 (ARB_base_instance).");
+			}
 		}
 
 		void ExecuteOnce(const CommandBindTexture2DArray& cmd)
@@ -1507,18 +2029,244 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			// DX12-only command. Other backends intentionally ignore it.
 		}
 
+		void ExecuteOnce(const CommandBindBufferUAV& /*cmd*/)
+		{
+			// Compute is not exposed by the OpenGL backend (SupportsCompute() == false).
+		}
+
+		void ExecuteOnce(const CommandDispatch& /*cmd*/)
+		{
+		}
+
+		void ExecuteOnce(const CommandDispatchMesh& /*cmd*/)
+		{
+			// Mesh shaders are not exposed by the OpenGL backend (SupportsMeshShaders() == false).
+		}
+
+		void ExecuteOnce(const CommandTextureBarriers& /*cmd*/)
+		{
+			// GL tracks hazards itself.
+		}
+
+		void ExecuteOnce(const CommandCopyTexture& cmd)
+		{
+			// Textures this backend creates are GL_TEXTURE_2D.
+			if (!glCopyImageSubData)
+			{
+				throw std::runtime_error("OpenGLRHI: CopyTexture requires GL 4.3 (ARB_copy_image).");
+			}
+
+			GLint width = 0;
+			GLint height = 0;
+			glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(cmd.src.id));
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+			glBindTexture(GL_TEXTURE_2D, 0);
+
+			glCopyImageSubData(
+				static_cast<GLuint>(cmd.src.id), GL_TEXTURE_2D, 0, 0, 0, 0,
+				static_cast<GLuint>(cmd.dst.id), GL_TEXTURE_2D, 0, 0, 0, 0,
+				width, height, 1);
+		}
+
+		void ExecuteOnce(const CommandReadbackTexture& /*cmd*/)
+		{
+			// Not exposed by the OpenGL backend (SupportsTextureReadback() == false).
+		}
+
+		void ExecuteOnce(const CommandGenerateMips& /*cmd*/)
+		{
+			// Not exposed by the OpenGL backend (SupportsGenerateMips() == false).
+		}
+
+		void ExecuteOnce(const CommandBeginAsyncCompute& /*cmd*/)
+		{
+			// Single queue: async compute segments run in stream order.
+		}
+
+		void ExecuteOnce(const CommandEndAsyncCompute& /*cmd*/)
+		{
+		}
+
+		void ExecuteOnce(const CommandWaitAsyncCompute& /*cmd*/)
+		{
+		}
+
+		void ExecuteOnce(const CommandBeginTimestampZone& cmd)
+		{
+			if (!hasTimestampQueries_)
+			{
+				return;
+			}
+			GLTimestampFrame& frame = timestampFrames_[timestampFrame_];
+			const std::size_t query = frame.zones.size() * 2;
+			if (frame.queries.size() < query + 2)
+			{
+				std::array<GLuint, 2> ids{};
+				glGenQueries(2, ids.data());
+				frame.queries.insert(frame.queries.end(), ids.begin(), ids.end());
+			}
+			glQueryCounter(frame.queries[query], GL_TIMESTAMP);
+			frame.zones.push_back(GLTimestampFrame::Zone{ std::string(cmd.name), static_cast<std::uint32_t>(openTimestampZones_.size()) });
+			openTimestampZones_.push_back(frame.zones.size() - 1);
+		}
+
+		void ExecuteOnce(const CommandEndTimestampZone& /*cmd*/)
+		{
+			if (openTimestampZones_.empty())
+			{
+				return;
+			}
+			const GLTimestampFrame& frame = timestampFrames_[timestampFrame_];
+			glQueryCounter(frame.queries[openTimestampZones_.back() * 2 + 1], GL_TIMESTAMP);
+			openTimestampZones_.pop_back();
+		}
+
+		// Reads the zones of the oldest submission slot if the GPU is done with them, then reuses the slot.
+		// Results that are not back yet are dropped rather than waited for.
+		void BeginTimestampFrame()
+		{
+			if (!hasTimestampQueries_)
+			{
+				return;
+			}
+			timestampFrame_ = (timestampFrame_ + 1) % kTimestampFrames;
+			GLTimestampFrame& frame = timestampFrames_[timestampFrame_];
+			if (!frame.zones.empty())
+			{
+				const std::size_t used = frame.zones.size() * 2;
+				GLint available = 0;
+				glGetQueryObjectiv(frame.queries[used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+				if (available)
+				{
+					std::vector<GLuint64> ns(used);
+					for (std::size_t i = 0; i < used; ++i)
+					{
+						glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &ns[i]);
+					}
+					GLuint64 origin = ns[0];
+					for (std::size_t i = 0; i < used; i += 2)
+					{
+						origin = std::min(origin, ns[i]);
+					}
+
+					lastGpuZones_.clear();
+					lastGpuZones_.reserve(frame.zones.size());
+					for (std::size_t i = 0; i < frame.zones.size(); ++i)
+					{
+						GpuTimestampZone& out = lastGpuZones_.emplace_back();
+						out.name = std::move(frame.zones[i].name);
+						out.beginMs = static_cast<double>(ns[i * 2] - origin) * 1e-6;
+						out.endMs = static_cast<double>(std::max(ns[i * 2 + 1], ns[i * 2]) - origin) * 1e-6;
+						out.depth = frame.zones[i].depth;
+					}
+				}
+			}
+			frame.zones.clear();
+		}
+
+		void EndTimestampFrame()
+		{
+			while (!openTimestampZones_.empty())
+			{
+				ExecuteOnce(CommandEndTimestampZone{});
+			}
+		}
+
+		void ExecuteOnce(const CommandDrawIndexedIndirect& cmd)
+		{
+			if (!hasMultiDrawIndirect_)
+			{
+				throw std::runtime_error("OpenGLRHI: DrawIndexedIndirect requires GL 4.3 (ARB_multi_draw_indirect).");
+			}
+			// DrawElementsIndirectCommand::firstIndex is relative to the start of the element buffer.
+			if (indexBuffer_.offsetBytes != 0)
+			{
+				throw std::runtime_error("OpenGLRHI: DrawIndexedIndirect requires an index buffer bound at offset 0.");
+			}
+
+			const GLuint vao = GetOrCreateVAO(true);
+			if (boundVao_ != vao)
+			{
+				glBindVertexArray(vao);
+				boundVao_ = vao;
+			}
+
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, static_cast<GLuint>(cmd.argsBuffer.id));
+			const void* indirect = reinterpret_cast<const void*>(static_cast<std::uintptr_t>(cmd.argsOffsetBytes));
+			constexpr GLsizei stride = static_cast<GLsizei>(sizeof(DrawIndexedIndirectArgs));
+
+			if (cmd.countBuffer && hasMultiDrawIndirectCount_)
+			{
+				glBindBuffer(GL_PARAMETER_BUFFER_ARB, static_cast<GLuint>(cmd.countBuffer.id));
+				glMultiDrawElementsIndirectCountARB(
+					currentTopology_,
+					ToGLIndexType(cmd.indexType),
+					indirect,
+					static_cast<GLintptr>(cmd.countOffsetBytes),
+					static_cast<GLsizei>(cmd.maxDrawCount),
+					stride);
+				glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+			}
+			else
+			{
+				// Without ARB_indirect_parameters every record is drawn; unused ones must have instanceCount 0.
+				glMultiDrawElementsIndirect(
+					currentTopology_,
+					ToGLIndexType(cmd.indexType),
+					indirect,
+					static_cast<GLsizei>(cmd.maxDrawCount),
+					stride);
+			}
+
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		}
+
 		//---------------------------------------------------------------------//
 		GLDeviceDesc desc_{};
 		std::string name_;
 
 		// Buffer targets: buffer id -> GL target
 		std::unordered_map<GLuint, GLenum> bufferTargets_{};
+		// Persistently mapped BufferUsageFlag::Stream buffers: buffer id -> mapping
+		std::unordered_map<GLuint, std::span<std::byte>> mappedBuffers_{};
+
+		// Upload ring for UpdateBuffer staging and per-draw constants (SetConstants).
+		static constexpr std::uint64_t kStreamRingBytes = 16ull * 1024ull * 1024ull;
+		static constexpr std::uint32_t kStreamFramesInFlight = 3;
+		bool hasBufferStorage_{ false };
+		GLStreamRing streamRing_{};
+		std::size_t uniformOffsetAlignment_{ 256 };
+		GLuint constantsFallbackBuffer_{ 0 };
+		bool hasMultiDrawIndirect_{ false };
+		bool hasMultiDrawIndirectCount_{ false };
+		bool hasBaseInstance_{ false };
+		SubmissionStats lastSubmissionStats_{};
+
+		// Bindless textures: TextureDescIndex -> resident handle, mirrored into bindlessTable_ (SSBO).
+		static constexpr GLuint kBindlessTableBinding = 0;
+		bool hasBindlessTextures_{ false };
+		std::vector<GLuint64> bindlessHandles_{ 0 };
+		bool bindlessTableDirty_{ false };
+		BufferHandle bindlessTable_{};
+		std::size_t bindlessTableBytes_{ 0 };
+		std::unordered_map<GLuint, GLuint64> textureHandles_{};          // texture id -> handle
+		std::unordered_map<GLuint64, std::uint32_t> residentTextureHandles_{}; // handle -> table entries using it
+
+		// Timestamp zones: one slot per submission in flight, read back when the slot comes round again.
+		static constexpr std::uint32_t kTimestampFrames = 3;
+		bool hasTimestampQueries_{ false };
+		std::array<GLTimestampFrame, kTimestampFrames> timestampFrames_{};
+		std::uint32_t timestampFrame_{ 0 };
+		std::vector<std::size_t> openTimestampZones_;
+		std::vector<GpuTimestampZone> lastGpuZones_;
 		// Input layouts (1-based handle id -> vector[id-1])
 		std::vector<GLInputLayout> inputLayouts_{};
 
 		// Descriptor indices (0 invalid)
 		std::vector<TextureHandle> textureDescriptions_{ TextureHandle{} };
 		std::vector<TextureDescIndex> freeTextureDescIndices_;
+		DeviceCounters deviceCounters_{};
 
 		// Fence storage
 		std::uint32_t nextFenceId_{ 0 };
@@ -1535,7 +2283,7 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 
 		// Current bindings for VAO build
 		rhi::InputLayoutHandle currentLayout_{};
-		std::array<VertexBufferState, 1> vertexBuffer_{};
+		std::array<VertexBufferState, kMaxVertexSlots> vertexBuffer_{};
 		struct {
 			rhi::BufferHandle buffer{};
 			rhi::IndexType indexType{ rhi::IndexType::UINT16 };
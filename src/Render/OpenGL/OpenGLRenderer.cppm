@@ -7,10 +7,14 @@ module;
 #include <array>
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
+#include <span>
 #include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 export module core:renderer_mesh_gl;
 
@@ -43,9 +47,16 @@ export namespace rendern
 			settings_ = settings;
 		}
 
+		const RendererFrameStats& GetFrameStats() const noexcept
+		{
+			return frameStats_;
+		}
+
 		void RenderFrame(rhi::IRHISwapChain& swapChain, const Scene& scene)
 		{
 			renderGraph::RenderGraph graph;
+			frameStats_.cullTested = 0;
+			frameStats_.cullVisible = 0;
 
 			rhi::ClearDesc clearDesc{};
 			clearDesc.clearColor = true;
@@ -107,37 +118,41 @@ export namespace rendern
 
 						glm::mat4 vp = proj * viewNoTrans;
 
-						std::array<float, 16> vpArr{};
-						std::memcpy(vpArr.data(), glm::value_ptr(vp), sizeof(float) * 16);
+						SkyboxConstants skyConstants{};
+						std::memcpy(skyConstants.uVP.data(), glm::value_ptr(vp), sizeof(float) * 16);
 
 						ctx.commandList.SetState(skyboxState_);
 						ctx.commandList.BindPipeline(psoSkybox_);
 
 						ctx.commandList.BindInputLayout(skyboxMesh_.layout);
-						ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, 0);
-						ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, 0);
+						ctx.commandList.BindVertexBuffer(0, skyboxMesh_.vertexBuffer, skyboxMesh_.vertexStrideBytes, skyboxMesh_.vertexOffsetBytes);
+						ctx.commandList.BindIndexBuffer(skyboxMesh_.indexBuffer, skyboxMesh_.indexType, skyboxMesh_.indexOffsetBytes);
 
-						ctx.commandList.SetUniformMat4("uVP", vpArr);
+						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &skyConstants, 1 }));
 
 						if (scene.skyboxDescIndex != 0)
 						{
 							ctx.commandList.BindTextureDesc(0, scene.skyboxDescIndex); // slot t0
 						}
-						ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, 0, 0);
+						ctx.commandList.DrawIndexed(skyboxMesh_.indexCount, skyboxMesh_.indexType, skyboxMesh_.firstIndex, skyboxMesh_.baseVertex);
 
 						ctx.commandList.SetState(state_);
 					}
 
 					constexpr std::uint32_t kEditorOutlineStencilRef = 0x80u;
+					const glm::mat4 viewProj = proj * view;
+					const bool bindless = device_.SupportsBindlessTextures();
 
-					auto DrawOne = [&](const MeshRHI& mesh, const glm::mat4& model, const MaterialParams& mat)
+					// One instanced draw per batch; instances come from the slot 1 stream (instanceBuffer_).
+					auto DrawInstances = [&](const MeshRHI& mesh, const MaterialParams& mat, std::uint32_t firstInstance, std::uint32_t instanceCount)
 						{
-							ctx.commandList.BindInputLayout(mesh.layout);
-							ctx.commandList.BindVertexBuffer(0, mesh.vertexBuffer, mesh.vertexStrideBytes, 0);
+							ctx.commandList.BindInputLayout(mesh.layoutInstanced);
+							ctx.commandList.BindVertexBuffer(0, mesh.vertexBuffer, mesh.vertexStrideBytes, mesh.vertexOffsetBytes);
+							ctx.commandList.BindVertexBuffer(1, instanceBuffer_, static_cast<std::uint32_t>(sizeof(GLInstanceData)), 0);
 
 							const bool hasIndices = (mesh.indexBuffer.id != 0) && (mesh.indexCount != 0);
 							if (hasIndices)
-								ctx.commandList.BindIndexBuffer(mesh.indexBuffer, mesh.indexType, 0);
+								ctx.commandList.BindIndexBuffer(mesh.indexBuffer, mesh.indexType, mesh.indexOffsetBytes);
 
 							const bool useTex = (mat.albedoDescIndex != 0);
 
@@ -145,33 +160,24 @@ export namespace rendern
 							// as a runtime fallback if the shader uses it.
 							ctx.commandList.BindPipeline(useTex ? psoTex_ : psoNoTex_);
 
-							// Uniforms (name-based path; typical for GL)
-							ctx.commandList.SetUniformInt("uTex", 0);
-							ctx.commandList.SetUniformFloat4("uColor", { mat.baseColor.x, mat.baseColor.y, mat.baseColor.z, mat.baseColor.w });
-
-							const glm::mat4 mvp = proj * view * model;
-
-							std::array<float, 16> mvpArr{};
-							std::memcpy(mvpArr.data(), glm::value_ptr(mvp), sizeof(float) * 16);
-							ctx.commandList.SetUniformMat4("uMVP", mvpArr);
+							BatchConstants constants{};
+							std::memcpy(constants.uViewProj.data(), glm::value_ptr(viewProj), sizeof(float) * 16);
+							constants.uColor = { mat.baseColor.x, mat.baseColor.y, mat.baseColor.z, mat.baseColor.w };
+							constants.uUseTex = useTex ? 1 : 0;
+							constants.uAlbedoIndex = mat.albedoDescIndex;
+							ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
 
-							if (useTex)
+							if (useTex && !bindless)
 							{
 								ctx.commandList.BindTextureDesc(0, mat.albedoDescIndex);
-								ctx.commandList.SetUniformInt("uUseTex", 1);
-							}
-							else
-							{
-								ctx.commandList.SetUniformInt("uUseTex", 0);
 							}
 
 							if (hasIndices)
-								ctx.commandList.DrawIndexed(mesh.indexCount, mesh.indexType, 0, 0);
+								ctx.commandList.DrawIndexed(mesh.indexCount, mesh.indexType, mesh.firstIndex, mesh.baseVertex, instanceCount, firstInstance);
 							else
-								ctx.commandList.Draw(static_cast<std::uint32_t>(cpuFallbackVertexCount_), 0);
+								ctx.commandList.Draw(static_cast<std::uint32_t>(cpuFallbackVertexCount_), 0, instanceCount, firstInstance);
 						};
 
-					bool drewAny = false;
 					std::vector<bool> selectedDrawItemMask(scene.drawItems.size(), false);
 					for (const int di : scene.editorSelectedDrawItems)
 					{
@@ -181,6 +187,8 @@ export namespace rendern
 						}
 					}
 
+					// ---- Cull, then sort so that items sharing mesh and material are adjacent ----
+					drawEntries_.clear();
 					for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++drawItemIndex)
 					{
 						const auto& item = scene.drawItems[drawItemIndex];
@@ -192,77 +200,171 @@ export namespace rendern
 						if (mesh.vertexBuffer.id == 0 || mesh.indexCount == 0)
 							continue;
 
-						MaterialParams mat{};
-						if (item.material.id != 0)
-						{
-							mat = scene.GetMaterial(item.material).params;
-						}
-						else
-						{
-							mat.baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-						}
-
 						const mathUtils::Mat4 modelMu = item.transform.ToMatrix();
+						++frameStats_.cullTested;
 						if (!IsVisible(item.mesh.get(), modelMu, cameraFrustum, doFrustumCulling))
 						{
 							continue;
 						}
-						const glm::mat4 model = ToGlmMat4(modelMu);
-						DrawOne(mesh, model, mat);
+						++frameStats_.cullVisible;
 
-						// Editor selection outline + highlight.
-						if (selectedDrawItemMask[drawItemIndex])
+						const bool textured = item.material.id != 0 && scene.GetMaterial(item.material).params.albedoDescIndex != 0;
+						drawEntries_.push_back(DrawEntry{ textured, &mesh, item.material.id, static_cast<std::uint32_t>(drawItemIndex), ToGlmMat4(modelMu) });
+					}
+					std::sort(drawEntries_.begin(), drawEntries_.end(), [](const DrawEntry& a, const DrawEntry& b)
 						{
-							MaterialParams mark = mat;
-							mark.baseColor = { 1.0f, 1.0f, 1.0f, 0.0f };
-							mark.albedoDescIndex = 0;
+							return std::tie(a.textured, a.mesh, a.materialId) < std::tie(b.textured, b.mesh, b.materialId);
+						});
 
-							ctx.commandList.SetStencilRef(kEditorOutlineStencilRef);
-							ctx.commandList.SetState(outlineMarkState_);
-							DrawOne(mesh, model, mark);
-
-							const auto& bounds = item.mesh->GetBounds();
-							float outlineScale = 1.03f;
-							if (bounds.sphereRadius > 0.0f)
+					auto MaterialOf = [&scene](std::uint32_t materialId)
+						{
+							MaterialParams mat{};
+							if (materialId != 0)
+							{
+								mat = scene.GetMaterial(MaterialHandle{ materialId }).params;
+							}
+							else
 							{
-								outlineScale = std::clamp(1.0f + 0.08f / bounds.sphereRadius, 1.02f, 1.08f);
+								mat.baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
 							}
-							const glm::mat4 outlineModel = model * glm::scale(glm::mat4(1.0f), glm::vec3(outlineScale));
-
-							MaterialParams outline = mat;
-							outline.baseColor = { 1.0f, 0.72f, 0.10f, 0.95f };
-							outline.albedoDescIndex = 0;
-							ctx.commandList.SetState(outlineState_);
-							DrawOne(mesh, outlineModel, outline);
-
-							MaterialParams hi = mat;
-							hi.baseColor = { 1.0f, 0.95f, 0.25f, 0.35f };
-							hi.albedoDescIndex = 0; // force solid color
-							ctx.commandList.SetState(highlightState_);
-							DrawOne(mesh, model, hi);
-
-							ctx.commandList.SetStencilRef(0u);
-							ctx.commandList.SetState(state_);
+							return mat;
+						};
+
+					// ---- Pack instances: batches are the runs of equal (mesh, material) ----
+					instances_.clear();
+					batches_.clear();
+					auto PushInstance = [this](const glm::mat4& model)
+						{
+							GLInstanceData& instance = instances_.emplace_back();
+							std::memcpy(instance.model.data(), glm::value_ptr(model), sizeof(float) * 16);
+							return static_cast<std::uint32_t>(instances_.size() - 1);
+						};
+
+					for (std::size_t runBegin = 0; runBegin < drawEntries_.size();)
+					{
+						const DrawEntry& first = drawEntries_[runBegin];
+						std::size_t runEnd = runBegin + 1;
+						while (runEnd < drawEntries_.size()
+							&& drawEntries_[runEnd].mesh == first.mesh
+							&& drawEntries_[runEnd].materialId == first.materialId)
+						{
+							++runEnd;
+						}
+
+						const std::uint32_t firstInstance = static_cast<std::uint32_t>(instances_.size());
+						for (std::size_t i = runBegin; i < runEnd; ++i)
+						{
+							PushInstance(drawEntries_[i].model);
+						}
+						batches_.push_back(Batch{ first.mesh, MaterialOf(first.materialId), firstInstance, static_cast<std::uint32_t>(runEnd - runBegin) });
+						runBegin = runEnd;
+					}
+
+					// Editor selection: the item itself (stencil mark + highlight) and its scaled-up outline.
+					struct SelectionDraw
+					{
+						const DrawEntry* entry{};
+						std::uint32_t instance{};
+						std::uint32_t outlineInstance{};
+					};
+					std::vector<SelectionDraw> selectionDraws;
+					for (const DrawEntry& entry : drawEntries_)
+					{
+						if (!selectedDrawItemMask[entry.drawItemIndex])
+						{
+							continue;
+						}
+
+						const auto& bounds = scene.drawItems[entry.drawItemIndex].mesh->GetBounds();
+						float outlineScale = 1.03f;
+						if (bounds.sphereRadius > 0.0f)
+						{
+							outlineScale = std::clamp(1.0f + 0.08f / bounds.sphereRadius, 1.02f, 1.08f);
 						}
-						drewAny = true;
+						const glm::mat4 outlineModel = entry.model * glm::scale(glm::mat4(1.0f), glm::vec3(outlineScale));
+
+						SelectionDraw& draw = selectionDraws.emplace_back();
+						draw.entry = &entry;
+						draw.instance = PushInstance(entry.model);
+						draw.outlineInstance = PushInstance(outlineModel);
 					}
 
 					// If the scene has no draw items or everything is still pending, draw fallback.
+					const bool drewAny = !drawEntries_.empty();
+					std::uint32_t fallbackInstance = 0;
+					if (!drewAny)
+					{
+						fallbackInstance = PushInstance(glm::rotate(glm::mat4(1.0f), TimeSeconds() * 0.8f, glm::vec3(0, 1, 0)));
+					}
+
+					UploadInstances();
+
+					for (const Batch& batch : batches_)
+					{
+						DrawInstances(*batch.mesh, batch.material, batch.firstInstance, batch.instanceCount);
+					}
+
+					for (const SelectionDraw& draw : selectionDraws)
+					{
+						const MeshRHI& mesh = *draw.entry->mesh;
+						const MaterialParams mat = MaterialOf(draw.entry->materialId);
+
+						MaterialParams mark = mat;
+						mark.baseColor = { 1.0f, 1.0f, 1.0f, 0.0f };
+						mark.albedoDescIndex = 0;
+
+						ctx.commandList.SetStencilRef(kEditorOutlineStencilRef);
+						ctx.commandList.SetState(outlineMarkState_);
+						DrawInstances(mesh, mark, draw.instance, 1);
+
+						MaterialParams outline = mat;
+						outline.baseColor = { 1.0f, 0.72f, 0.10f, 0.95f };
+						outline.albedoDescIndex = 0;
+						ctx.commandList.SetState(outlineState_);
+						DrawInstances(mesh, outline, draw.outlineInstance, 1);
+
+						MaterialParams hi = mat;
+						hi.baseColor = { 1.0f, 0.95f, 0.25f, 0.35f };
+						hi.albedoDescIndex = 0; // force solid color
+						ctx.commandList.SetState(highlightState_);
+						DrawInstances(mesh, hi, draw.instance, 1);
+
+						ctx.commandList.SetStencilRef(0u);
+						ctx.commandList.SetState(state_);
+					}
+
 					if (!drewAny)
 					{
-						const glm::mat4 model = glm::rotate(glm::mat4(1.0f), TimeSeconds() * 0.8f, glm::vec3(0, 1, 0));
 						MaterialParams mat{};
 						mat.baseColor = { 0.2f, 0.3f, 0.7f, 1.0f };
-						DrawOne(mesh_, model, mat);
+						DrawInstances(mesh_, mat, fallbackInstance, 1);
 					}
 				});
 
-			graph.Execute(device_, swapChain);
+			graph.Execute(device_, swapChain, &frameStats_);
+
+			const rhi::DeviceCounters counters = device_.GetDeviceCounters();
+			frameStats_.bufferUpdates = static_cast<std::uint32_t>(counters.bufferUpdates - lastDeviceCounters_.bufferUpdates);
+			frameStats_.bufferUploadBytes = counters.bufferUploadBytes - lastDeviceCounters_.bufferUploadBytes;
+			frameStats_.descriptorAllocations = static_cast<std::uint32_t>(counters.descriptorAllocations - lastDeviceCounters_.descriptorAllocations);
+			lastDeviceCounters_ = counters;
+			++frameStats_.frameIndex;
+
 			swapChain.Present();
+			if (scene.inputSampleTime != std::chrono::steady_clock::time_point{})
+			{
+				frameStats_.inputToPresentMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - scene.inputSampleTime).count();
+			}
 		}
 
 		void Shutdown()
 		{
+			if (instanceBuffer_)
+			{
+				device_.DestroyBuffer(instanceBuffer_);
+				instanceBuffer_ = {};
+				instanceBufferBytes_ = 0;
+			}
 			DestroyMesh(device_, skyboxMesh_);
 			DestroyMesh(device_, mesh_);
 			psoCache_.ClearCache();
@@ -270,6 +372,47 @@ export namespace rendern
 		}
 
 	private:
+		// std140 mirror of the PerBatch uniform block in VS.vert / FS.frag.
+		struct alignas(16) BatchConstants
+		{
+			std::array<float, 16> uViewProj{};
+			std::array<float, 4> uColor{};
+			std::int32_t uUseTex{ 0 };
+			std::uint32_t uAlbedoIndex{ 0 }; // TextureDescIndex, sampled directly with bindless textures
+			std::array<std::int32_t, 2> pad{};
+		};
+		static_assert(sizeof(BatchConstants) == 96);
+
+		// Vertex slot 1 (TEXCOORD1..4): the model matrix, column-major like InstanceData on DX12.
+		struct GLInstanceData
+		{
+			std::array<float, 16> model{};
+		};
+		static_assert(sizeof(GLInstanceData) == 64);
+
+		struct DrawEntry
+		{
+			bool textured{ false }; // sorts first so the two pipeline permutations each bind once
+			const MeshRHI* mesh{};
+			std::uint32_t materialId{ 0 };
+			std::uint32_t drawItemIndex{ 0 };
+			glm::mat4 model{ 1.0f };
+		};
+
+		struct Batch
+		{
+			const MeshRHI* mesh{};
+			MaterialParams material{};
+			std::uint32_t firstInstance{ 0 };
+			std::uint32_t instanceCount{ 0 };
+		};
+
+		// std140 mirror of the PerDraw uniform block in SkyboxVS.vert.
+		struct alignas(16) SkyboxConstants
+		{
+			std::array<float, 16> uVP{};
+		};
+
 		static float TimeSeconds()
 		{
 			using clock = std::chrono::steady_clock;
@@ -278,6 +421,32 @@ export namespace rendern
 			return std::chrono::duration<float>(now - start).count();
 		}
 
+		void UploadInstances()
+		{
+			if (instances_.empty())
+			{
+				return;
+			}
+
+			const std::size_t bytes = instances_.size() * sizeof(GLInstanceData);
+			if (bytes > instanceBufferBytes_)
+			{
+				if (instanceBuffer_)
+				{
+					device_.DestroyBuffer(instanceBuffer_);
+				}
+				instanceBufferBytes_ = std::max<std::size_t>(bytes + bytes / 2, sizeof(GLInstanceData) * 1024u);
+
+				rhi::BufferDesc desc{};
+				desc.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+				desc.usageFlag = rhi::BufferUsageFlag::Dynamic;
+				desc.sizeInBytes = instanceBufferBytes_;
+				desc.debugName = "GLInstanceVB";
+				instanceBuffer_ = device_.CreateBuffer(desc);
+			}
+			device_.UpdateBuffer(instanceBuffer_, std::as_bytes(std::span{ instances_ }), 0);
+		}
+
 		void CreateFallbackResources()
 		{
 			MeshCPU cpu{};
@@ -292,6 +461,15 @@ export namespace rendern
 			cpuFallbackVertexCount_ = cpu.vertices.size();
 			mesh_ = UploadMesh(device_, cpu, "FallbackMesh_GL");
 
+			// BINDLESS=1: FS.frag samples TextureDescIndex through the device's handle table.
+			std::vector<std::string> meshDefines;
+			if (device_.SupportsBindlessTextures())
+			{
+				meshDefines.push_back("BINDLESS=1");
+			}
+			std::vector<std::string> meshTexDefines = meshDefines;
+			meshTexDefines.push_back("USE_TEX=1");
+
 			// Use existing shader names in assets/shaders/
 			std::filesystem::path vertexShaderPath = corefs::ResolveAsset("shaders\\VS.vert");
 			std::filesystem::path pixelShaderPath = corefs::ResolveAsset("shaders\\FS.frag");
@@ -300,14 +478,14 @@ export namespace rendern
 				.stage = rhi::ShaderStage::Vertex,
 				.name = "VS_Mesh",
 				.filePath = vertexShaderPath.string(),
-				.defines = {}
+				.defines = meshDefines
 				});
 
 			const auto pixelShader = shaderLibrary_.GetOrCreateShader(ShaderKey{
 				.stage = rhi::ShaderStage::Pixel,
 				.name = "PS_Mesh",
 				.filePath = pixelShaderPath.string(),
-				.defines = {}
+				.defines = meshDefines
 				});
 
 			// Permutation: USE_TEX=1
@@ -315,13 +493,13 @@ export namespace rendern
 				.stage = rhi::ShaderStage::Vertex,
 				.name = "VS_Mesh",
 				.filePath = vertexShaderPath.string(),
-				.defines = { "USE_TEX=1" }
+				.defines = meshTexDefines
 				});
 			const auto pixelShaderTex = shaderLibrary_.GetOrCreateShader(ShaderKey{
 				.stage = rhi::ShaderStage::Pixel,
 				.name = "PS_Mesh",
 				.filePath = pixelShaderPath.string(),
-				.defines = { "USE_TEX=1" }
+				.defines = meshTexDefines
 				});
 
 			psoTex_ = psoCache_.GetOrCreate("PSO_Mesh_Tex", vertexShaderTex, pixelShaderTex);
@@ -422,5 +600,15 @@ export namespace rendern
 		rhi::GraphicsState skyboxState_{};
 
 		std::size_t cpuFallbackVertexCount_{ 0 };
+
+		// Per-frame instance packing (scratch kept across frames).
+		std::vector<DrawEntry> drawEntries_;
+		std::vector<Batch> batches_;
+		std::vector<GLInstanceData> instances_;
+		rhi::BufferHandle instanceBuffer_{};
+		std::size_t instanceBufferBytes_{ 0 };
+
+		RendererFrameStats frameStats_{};
+		rhi::DeviceCounters lastDeviceCounters_{};
 	};
 } // namespace rendern
\ No newline at end of file
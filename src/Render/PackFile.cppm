@@ -0,0 +1,349 @@
+module;
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+export module core:pack_file;
+
+// Pack file: many asset files in one archive that is memory mapped once instead of opening every
+// loose file. Layout (little endian):
+//
+//   PackHeader
+//   entry data, stored entries aligned to PackHeader::alignment, LZ4 entries to 16 bytes
+//   PackEntry[entryCount], sorted by path
+//   path strings (not null terminated)
+//
+// Paths are asset-root relative, '/' separated and ASCII lower case (NormalizePackPath), so
+// "Shaders\\Foo.hlsl" and "shaders/foo.hlsl" name the same entry. Stored (uncompressed) entries
+// are aligned for mapping: their bytes are served straight out of the archive mapping.
+
+export namespace corefs
+{
+	inline constexpr std::uint32_t kPackMagic = 0x4B415043u; // "CPAK"
+	inline constexpr std::uint32_t kPackVersion = 1u;
+
+	enum class PackCompression : std::uint32_t
+	{
+		None = 0,
+		LZ4 = 1
+	};
+
+	struct PackHeader
+	{
+		std::uint32_t magic{ kPackMagic };
+		std::uint32_t version{ kPackVersion };
+		std::uint32_t entryCount{ 0 };
+		std::uint32_t alignment{ 0 };
+		std::uint64_t tocOffset{ 0 };
+		std::uint64_t stringsOffset{ 0 };
+		std::uint64_t stringsBytes{ 0 };
+	};
+
+	struct PackEntry
+	{
+		std::uint32_t pathOffset{ 0 };
+		std::uint32_t pathBytes{ 0 };
+		PackCompression compression{ PackCompression::None };
+		std::uint32_t reserved{ 0 };
+		std::uint64_t offset{ 0 };
+		std::uint64_t storedBytes{ 0 };
+		std::uint64_t bytes{ 0 };
+		// std::filesystem::file_time_type ticks of the source, so cooked-asset stamps still match.
+		std::int64_t writeTime{ 0 };
+	};
+
+	static_assert(sizeof(PackHeader) == 40);
+	static_assert(sizeof(PackEntry) == 48);
+
+	std::string NormalizePackPath(std::string_view path)
+	{
+		std::string generic(path);
+		std::replace(generic.begin(), generic.end(), '\\', '/');
+		std::string normal = std::filesystem::path(generic).lexically_normal().generic_string();
+		for (char& c : normal)
+		{
+			c = static_cast<char>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c);
+		}
+		return normal == "." ? std::string{} : normal;
+	}
+
+	// Read-only view of a mapped pack. `owner` keeps the mapping alive; entry views and
+	// PackArchive itself stay valid while any shared_ptr to it exists.
+	class PackArchive
+	{
+	public:
+		// Throws on a malformed archive (bad magic/version, out-of-range or unsorted entries).
+		PackArchive(std::span<const std::byte> bytes, std::shared_ptr<const void> owner)
+			: bytes_(bytes)
+			, owner_(std::move(owner))
+		{
+			if (bytes_.size() < sizeof(PackHeader))
+			{
+				throw std::runtime_error("Pack file too small");
+			}
+			std::memcpy(&header_, bytes_.data(), sizeof(header_));
+			if (header_.magic != kPackMagic || header_.version != kPackVersion)
+			{
+				throw std::runtime_error("Not a pack file (bad magic or version)");
+			}
+
+			const std::uint64_t tocBytes = static_cast<std::uint64_t>(header_.entryCount) * sizeof(PackEntry);
+			if (!InRange_(header_.tocOffset, tocBytes) || !InRange_(header_.stringsOffset, header_.stringsBytes))
+			{
+				throw std::runtime_error("Pack table of contents out of range");
+			}
+
+			entries_.resize(header_.entryCount);
+			if (!entries_.empty())
+			{
+				std::memcpy(entries_.data(), bytes_.data() + header_.tocOffset, static_cast<std::size_t>(tocBytes));
+			}
+			strings_ = std::string_view(reinterpret_cast<const char*>(bytes_.data() + header_.stringsOffset),
+				static_cast<std::size_t>(header_.stringsBytes));
+
+			for (std::size_t i = 0; i < entries_.size(); ++i)
+			{
+				const PackEntry& entry = entries_[i];
+				const bool knownCompression = entry.compression == PackCompression::None || entry.compression == PackCompression::LZ4;
+				if (!knownCompression || !InRange_(entry.offset, entry.storedBytes) ||
+					static_cast<std::uint64_t>(entry.pathOffset) + entry.pathBytes > strings_.size() ||
+					(entry.compression == PackCompression::None && entry.storedBytes != entry.bytes))
+				{
+					throw std::runtime_error("Pack entry out of range");
+				}
+				if (i > 0 && !(PathOf(entries_[i - 1]) < PathOf(entry)))
+				{
+					throw std::runtime_error("Pack table of contents is not sorted");
+				}
+			}
+		}
+
+		PackArchive(const PackArchive&) = delete;
+		PackArchive& operator=(const PackArchive&) = delete;
+
+		// `path` must already be normalized (NormalizePackPath).
+		const PackEntry* Find(std::string_view path) const noexcept
+		{
+			const auto it = std::lower_bound(entries_.begin(), entries_.end(), path, [this](const PackEntry& entry, std::string_view key)
+				{
+					return PathOf(entry) < key;
+				});
+			return (it != entries_.end() && PathOf(*it) == path) ? &*it : nullptr;
+		}
+
+		std::string_view PathOf(const PackEntry& entry) const noexcept
+		{
+			return strings_.substr(entry.pathOffset, entry.pathBytes);
+		}
+
+		// Bytes as stored in the archive (compressed for LZ4 entries).
+		std::span<const std::byte> StoredBytes(const PackEntry& entry) const noexcept
+		{
+			return bytes_.subspan(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.storedBytes));
+		}
+
+		std::vector<std::byte> Extract(const PackEntry& entry) const
+		{
+			const std::span<const std::byte> stored = StoredBytes(entry);
+			if (entry.compression == PackCompression::None)
+			{
+				return std::vector<std::byte>(stored.begin(), stored.end());
+			}
+
+			std::vector<std::byte> out(static_cast<std::size_t>(entry.bytes));
+			const int written = LZ4_decompress_safe(
+				reinterpret_cast<const char*>(stored.data()),
+				reinterpret_cast<char*>(out.data()),
+				static_cast<int>(stored.size()),
+				static_cast<int>(out.size()));
+			if (written < 0 || static_cast<std::uint64_t>(written) != entry.bytes)
+			{
+				throw std::runtime_error("Corrupt pack entry: " + std::string(PathOf(entry)));
+			}
+			return out;
+		}
+
+		std::span<const PackEntry> Entries() const noexcept { return entries_; }
+		const PackHeader& Header() const noexcept { return header_; }
+
+	private:
+		bool InRange_(std::uint64_t offset, std::uint64_t size) const noexcept
+		{
+			return offset <= bytes_.size() && size <= bytes_.size() - offset;
+		}
+
+		std::span<const std::byte> bytes_{};
+		std::shared_ptr<const void> owner_{};
+		PackHeader header_{};
+		std::vector<PackEntry> entries_{};
+		std::string_view strings_{};
+	};
+
+	struct PackWriteOptions
+	{
+		// Alignment of stored entries; 4096 keeps mapped views page aligned.
+		std::uint32_t alignment{ 4096 };
+		bool compress{ true };
+		// LZ4 is kept only if it saves at least this fraction; otherwise the entry is stored.
+		double minSavings{ 0.1 };
+		int compressionLevel{ LZ4HC_CLEVEL_DEFAULT };
+	};
+
+	// Streams entries into a new pack; the table of contents is written by Finish. Entries are
+	// written in Add order (callers group files that load together), the TOC is sorted.
+	class PackWriter
+	{
+	public:
+		PackWriter(const std::filesystem::path& path, PackWriteOptions options = {})
+			: path_(path)
+			, options_(options)
+			, out_(path, std::ios::binary | std::ios::trunc)
+		{
+			if (!out_)
+			{
+				throw std::runtime_error("Failed to create pack file: " + path.string());
+			}
+			if (options_.alignment == 0 || (options_.alignment & (options_.alignment - 1)) != 0)
+			{
+				throw std::runtime_error("Pack alignment must be a power of two");
+			}
+			const PackHeader placeholder{};
+			Write_(&placeholder, sizeof(placeholder));
+		}
+
+		PackWriter(const PackWriter&) = delete;
+		PackWriter& operator=(const PackWriter&) = delete;
+
+		// Returns false (and adds nothing) for a path already in the pack.
+		bool Add(std::string_view path, std::span<const std::byte> bytes, std::int64_t writeTime = 0)
+		{
+			std::string normalized = NormalizePackPath(path);
+			if (normalized.empty() || !paths_.insert(normalized).second)
+			{
+				return false;
+			}
+
+			PackEntry entry{};
+			entry.bytes = bytes.size();
+			entry.writeTime = writeTime;
+
+			std::vector<char> compressed;
+			if (options_.compress && !bytes.empty() && bytes.size() <= static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE))
+			{
+				compressed.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(bytes.size()))));
+				const int size = LZ4_compress_HC(
+					reinterpret_cast<const char*>(bytes.data()),
+					compressed.data(),
+					static_cast<int>(bytes.size()),
+					static_cast<int>(compressed.size()),
+					options_.compressionLevel);
+				const double limit = static_cast<double>(bytes.size()) * (1.0 - options_.minSavings);
+				compressed.resize((size > 0 && static_cast<double>(size) <= limit) ? static_cast<std::size_t>(size) : 0u);
+			}
+
+			if (!compressed.empty())
+			{
+				entry.compression = PackCompression::LZ4;
+				entry.storedBytes = compressed.size();
+				entry.offset = Pad_(16);
+				Write_(compressed.data(), compressed.size());
+			}
+			else
+			{
+				entry.compression = PackCompression::None;
+				entry.storedBytes = bytes.size();
+				entry.offset = Pad_(options_.alignment);
+				Write_(bytes.data(), bytes.size());
+			}
+
+			pending_.push_back(Pending_{ std::move(normalized), entry });
+			return true;
+		}
+
+		void Finish()
+		{
+			std::sort(pending_.begin(), pending_.end(), [](const Pending_& a, const Pending_& b) { return a.path < b.path; });
+
+			std::string strings;
+			std::vector<PackEntry> toc;
+			toc.reserve(pending_.size());
+			for (Pending_& p : pending_)
+			{
+				p.entry.pathOffset = static_cast<std::uint32_t>(strings.size());
+				p.entry.pathBytes = static_cast<std::uint32_t>(p.path.size());
+				strings += p.path;
+				toc.push_back(p.entry);
+			}
+
+			PackHeader header{};
+			header.entryCount = static_cast<std::uint32_t>(toc.size());
+			header.alignment = options_.alignment;
+			header.tocOffset = Pad_(alignof(PackEntry));
+			Write_(toc.data(), toc.size() * sizeof(PackEntry));
+			header.stringsOffset = offset_;
+			header.stringsBytes = strings.size();
+			Write_(strings.data(), strings.size());
+
+			out_.seekp(0);
+			out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			out_.close();
+			if (!out_)
+			{
+				throw std::runtime_error("Failed to write pack file: " + path_.string());
+			}
+		}
+
+		std::size_t EntryCount() const noexcept { return pending_.size(); }
+
+	private:
+		struct Pending_
+		{
+			std::string path;
+			PackEntry entry;
+		};
+
+		void Write_(const void* data, std::size_t size)
+		{
+			out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+			if (!out_)
+			{
+				throw std::runtime_error("Failed to write pack file: " + path_.string());
+			}
+			offset_ += size;
+		}
+
+		std::uint64_t Pad_(std::uint64_t alignment)
+		{
+			static constexpr char kZeros[64]{};
+			std::uint64_t padding = (alignment - offset_ % alignment) % alignment;
+			while (padding != 0)
+			{
+				const std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(padding, sizeof(kZeros)));
+				Write_(kZeros, chunk);
+				padding -= chunk;
+			}
+			return offset_;
+		}
+
+		std::filesystem::path path_;
+		PackWriteOptions options_;
+		std::ofstream out_;
+		std::uint64_t offset_{ 0 };
+		std::vector<Pending_> pending_{};
+		std::unordered_set<std::string> paths_{};
+	};
+}
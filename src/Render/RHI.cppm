@@ -10,7 +10,15 @@ module;
 #include <span>
 #include <unordered_map>
 #include <cstring>
+#include <iterator>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <bit>
 
 export module core:rhi;
 
@@ -52,9 +60,12 @@ export namespace rhi
 	{
 		Unknown,
 		RGBA8_UNORM,
+		RGBA8_UNORM_SRGB,
 		RGBA16_FLOAT,
 		BGRA8_UNORM,
 		R32_FLOAT,
+		R32_UINT,
+		RG16_UNORM,
 		D32_FLOAT,
 		D24_UNORM_S8_UINT
 	};
@@ -83,7 +94,10 @@ export namespace rhi
 		IndexBuffer,
 		ConstantBuffer,
 		UniformBuffer,
-		StructuredBuffer
+		StructuredBuffer,
+		// StructuredBuffer that compute shaders also write (UAV). Still usable as vertex/index data,
+		// SRV (when structuredStrideBytes != 0) and indirect draw arguments.
+		StorageBuffer
 	};
 
 	enum class BufferUsageFlag : std::uint8_t
@@ -91,6 +105,8 @@ export namespace rhi
 		Default,
 		Static,
 		Dynamic,
+		// Rewritten by the CPU every frame. Where the backend supports it the buffer lives in
+		// host-visible memory that MapBuffer exposes and the GPU reads in place (no staging copy).
 		Stream
 	};
 
@@ -126,7 +142,9 @@ export namespace rhi
 		R8G8B8A8_UNORM,
 		R16G16B16A16_UINT,
 		R16G16B16A16_UNORM,
-		R32G32B32A32_UINT
+		R32G32B32A32_UINT,
+		R16G16_SNORM,
+		R16G16_FLOAT
 	};
 
 	enum class VertexSemantic : std::uint8_t
@@ -158,13 +176,17 @@ export namespace rhi
 		Vertex,
 		Pixel, // Fragment
 		Geometry,
-		Compute
+		Compute,
+		// Mesh-shader pipelines (CreateMeshPipeline, SM6_5).
+		Amplification,
+		Mesh
 	};
 
 	enum class ShaderModel : std::uint8_t
 	{
 		SM5_1,
-		SM6_1
+		SM6_1,
+		SM6_5
 	};
 
 	// Vulkan/DX12 backends can map these indices into global descriptor tables.
@@ -182,6 +204,12 @@ export namespace rhi
 		Extent2D extent{};
 		Format backbufferFormat{ Format::BGRA8_UNORM };
 		bool vsync{ true };
+		// Low latency: at most maxFrameLatency frames are queued for presentation and WaitForNextFrame
+		// blocks until the swap chain takes another one.
+		bool lowLatency{ false };
+		std::uint32_t maxFrameLatency{ 1 };
+		// Presents without vsync may tear (variable refresh rate displays in a window). Ignored when unsupported.
+		bool allowTearing{ false };
 	};
 
 	struct BufferDesc
@@ -237,7 +265,10 @@ export namespace rhi
 	enum class BlendMode : std::uint8_t
 	{
 		Alpha = 0,
-		Additive
+		Additive,
+		// Weighted blended OIT: target 0 sums premultiplied color and weight (One, One), target 1 builds
+		// coverage 1 - prod(1 - alpha) from zero (One, InvSrcColor).
+		WeightedOit
 	};
 
 	struct BlendState
@@ -253,6 +284,14 @@ export namespace rhi
 		BlendState blend{};
 	};
 
+	struct ClearRect
+	{
+		int x{ 0 };
+		int y{ 0 };
+		int width{ 0 };
+		int height{ 0 };
+	};
+
 	struct ClearDesc
 	{
 		bool clearColor{ true };
@@ -261,6 +300,8 @@ export namespace rhi
 		std::array<float, 4> color{ 0.0f, 0.0f, 0.0f, 1.0f };
 		float depth{ 1.0f };
 		std::uint8_t stencil{ 0 };
+		// If set, only this rect of the attachments is cleared (e.g. one tile of a shadow atlas).
+		std::optional<ClearRect> rect{};
 	};
 
 	class IRHISwapChain;
@@ -298,6 +339,15 @@ export namespace rhi
 		int width{ 0 };
 		int height{ 0 };
 	};
+	// Rasterizes only inside this render-target pixel rectangle (top-left origin, like ClearRect) until
+	// the next SetViewport, which resets the scissor to the viewport.
+	struct CommandSetScissor
+	{
+		int x{ 0 };
+		int y{ 0 };
+		int width{ 0 };
+		int height{ 0 };
+	};
 	struct CommandSetState
 	{
 		GraphicsState state{};
@@ -352,19 +402,20 @@ export namespace rhi
 		BufferHandle buffer{};
 	};
 
+	// Uniform names point into the command list's storage and are null-terminated.
 	struct CommandSetUniformInt
 	{
-		std::string name{};
+		std::string_view name{};
 		int value{ 0 };
 	};
 	struct CommandUniformFloat4
 	{
-		std::string name{};
+		std::string_view name{};
 		std::array<float, 4> value{};
 	};
 	struct CommandUniformMat4
 	{
-		std::string name{};
+		std::string_view name{};
 		std::array<float, 16> value{};
 	};
 
@@ -374,8 +425,7 @@ export namespace rhi
 	struct CommandSetConstants
 	{
 		std::uint32_t slot{ 0 };   // backend-defined slot (DX12 root parameter index)
-		std::uint32_t size{ 0 };   // bytes used in `data`
-		std::array<std::byte, 512> data{};
+		std::span<const std::byte> data{};  // stored inline in the command list, at most 512 bytes
 	};
 
 	// DX12-only: render Dear ImGui draw data into the current render target.
@@ -407,6 +457,447 @@ export namespace rhi
 		TextureHandle texture{};
 	};
 
+	// Compute: StorageBuffer bound to u<slot> for the next Dispatch.
+	struct CommandBindBufferUAV
+	{
+		std::uint32_t slot{ 0 };
+		BufferHandle buffer{};
+	};
+	// Runs the bound compute pipeline (BindPipeline with a CreateComputePipeline handle).
+	// Compute SRVs use the regular texture / structured-buffer slots t0..t3.
+	// Writes are visible to every later command (the backend adds a UAV barrier).
+	struct CommandDispatch
+	{
+		std::uint32_t groupCountX{ 1 };
+		std::uint32_t groupCountY{ 1 };
+		std::uint32_t groupCountZ{ 1 };
+	};
+	// Runs the bound mesh pipeline (CreateMeshPipeline): groupCountX/Y/Z amplification groups, or mesh
+	// groups when the pipeline has no amplification shader. There is no input assembler: shaders fetch
+	// their geometry through the structured-buffer slots and share the graphics root bindings.
+	struct CommandDispatchMesh
+	{
+		std::uint32_t groupCountX{ 1 };
+		std::uint32_t groupCountY{ 1 };
+		std::uint32_t groupCountZ{ 1 };
+	};
+	// DrawIndexed with its arguments read from a GPU buffer: maxDrawCount tightly packed
+	// DrawIndexedIndirectArgs records starting at argsOffsetBytes, all sharing the bound state,
+	// vertex and index buffers (firstInstance offsets the per-instance vertex fetch).
+	// With countBuffer set the draw count is min(maxDrawCount, uint32 at countOffsetBytes).
+	struct CommandDrawIndexedIndirect
+	{
+		BufferHandle argsBuffer{};
+		std::uint32_t argsOffsetBytes{ 0 };
+		IndexType indexType{ IndexType::UINT16 };
+		std::uint32_t maxDrawCount{ 1 };
+		BufferHandle countBuffer{};
+		std::uint32_t countOffsetBytes{ 0 };
+	};
+
+	// States a texture is moved into by an explicit barrier batch.
+	enum class TextureState : std::uint8_t
+	{
+		RenderTarget,
+		DepthWrite,
+		ShaderRead,       // pixel and non-pixel shader reads
+		UnorderedAccess,
+		CopySource,
+		CopyDest
+	};
+
+	struct TextureBarrier
+	{
+		TextureHandle texture{};
+		TextureState state{ TextureState::ShaderRead };
+	};
+
+	// Moves every listed texture into its state with one barrier call; textures already there are skipped.
+	// Backends that transition implicitly on bind/BeginPass keep doing so, this only batches them up front.
+	struct CommandTextureBarriers
+	{
+		std::span<const TextureBarrier> barriers{};  // stored inline in the command list
+	};
+
+	// Copies every subresource of `src` into `dst` (same extent, format and type). Both are moved into the
+	// copy states first; like BeginPass it is graphics-queue only.
+	struct CommandCopyTexture
+	{
+		TextureHandle src{};
+		TextureHandle dst{};
+	};
+
+	// Copies the texels [x, x + width) x [y, y + height) of mip 0 of a 2D color texture (clamped to its extent)
+	// to CPU memory. The data arrives a few frames later through IRHIDevice::TakeCompletedTextureReadbacks,
+	// tagged with `requestId`. Graphics-queue only; backends without SupportsTextureReadback ignore it.
+	struct CommandReadbackTexture
+	{
+		TextureHandle texture{};
+		std::uint32_t x{ 0 };
+		std::uint32_t y{ 0 };
+		std::uint32_t width{ 1 };
+		std::uint32_t height{ 1 };
+		std::uint64_t requestId{ 0 };
+	};
+
+	// Rebuilds mips 1..N of every array slice (cube face) of `texture` from mip 0 with a 2x2 box filter;
+	// normal maps are renormalized per level. Graphics-queue only; the texture ends up in ShaderRead.
+	// Backends without SupportsGenerateMips ignore it.
+	struct CommandGenerateMips
+	{
+		TextureHandle texture{};
+		bool normalMap{ false };
+	};
+
+	// Async compute segment. The commands up to the matching CommandEndAsyncCompute are compute work only
+	// (compute bindings, SetConstants, Dispatch) and may run on a second queue, overlapping the graphics
+	// work recorded after the segment. The segment starts once all graphics work recorded before it is done.
+	struct CommandBeginAsyncCompute
+	{
+	};
+	// Closes the open segment and names it `syncPoint` for CommandWaitAsyncCompute.
+	struct CommandEndAsyncCompute
+	{
+		std::uint32_t syncPoint{ 0 };
+	};
+	// Graphics work recorded after this waits for segment `syncPoint` (and every segment before it).
+	// Backends without SupportsAsyncCompute ignore all three commands: the stream order is already a valid
+	// serial order.
+	struct CommandWaitAsyncCompute
+	{
+		std::uint32_t syncPoint{ 0 };
+	};
+
+	// GPU timing zone. Backends with SupportsTimestampQueries write a timestamp at both ends; zones nest and
+	// close within the same command list. Zones inside an async compute segment are not timed.
+	struct CommandBeginTimestampZone
+	{
+		std::string_view name{};  // stored inline in the command list
+	};
+	struct CommandEndTimestampZone
+	{
+	};
+
+	// One resolved timestamp zone; times are relative to the first zone of its submission.
+	struct GpuTimestampZone
+	{
+		std::string name;
+		double beginMs{ 0.0 };
+		double endMs{ 0.0 };
+		std::uint32_t depth{ 0 };
+	};
+
+	// One finished CommandReadbackTexture: the clamped rect, rows tightly packed in the texture's format.
+	struct TextureReadback
+	{
+		std::uint64_t requestId{ 0 };
+		std::uint32_t x{ 0 };
+		std::uint32_t y{ 0 };
+		std::uint32_t width{ 0 };
+		std::uint32_t height{ 0 };
+		std::vector<std::byte> data;
+	};
+
+	// Layout of one indirect indexed draw (D3D12_DRAW_INDEXED_ARGUMENTS / DrawElementsIndirectCommand).
+	struct DrawIndexedIndirectArgs
+	{
+		std::uint32_t indexCount{ 0 };
+		std::uint32_t instanceCount{ 0 };
+		std::uint32_t firstIndex{ 0 };
+		std::int32_t baseVertex{ 0 };
+		std::uint32_t firstInstance{ 0 };
+	};
+	static_assert(sizeof(DrawIndexedIndirectArgs) == 20);
+
+	// Native state changes a backend issued and skipped for one SubmitCommandList because the value
+	// was already bound (pipeline, root signature, IA, descriptor tables, root views, constants).
+	struct SubmissionStats
+	{
+		std::uint32_t draws{ 0 };
+		std::uint32_t instances{ 0 };                // instances of direct draws (indirect draws don't know theirs)
+		std::uint32_t dispatches{ 0 };
+		std::uint32_t stateCallsIssued{ 0 };
+		std::uint32_t stateCallsFiltered{ 0 };
+		std::uint32_t pipelineChangesFiltered{ 0 };  // PSO and root signature
+		std::uint32_t rootParamsFiltered{ 0 };       // descriptor tables and root CBV/UAV addresses
+		std::uint32_t inputAssemblerFiltered{ 0 };   // vertex/index buffers and topology
+		std::uint32_t constantUploadsFiltered{ 0 };  // draws that reused the previous constant buffer
+	};
+
+	// Running totals since the device was created; callers diff two reads for a per-frame figure.
+	struct DeviceCounters
+	{
+		std::uint64_t bufferUpdates{ 0 };
+		std::uint64_t bufferUploadBytes{ 0 };       // bytes passed to UpdateBuffer
+		std::uint64_t descriptorAllocations{ 0 };   // shader-visible descriptor slots handed out
+	};
+
+	// Slot allocator for a bindless descriptor heap. Slot indices never move:
+	//  - [0, reservedCount) are fixed by the backend (null views etc.) and never handed out.
+	//  - [reservedCount, reservedCount + staticCount) is a static range for renderer-owned views (render
+	//    targets, depth buffers, structured buffers) so they don't interleave with streamed textures.
+	//    When it is full, AllocateStatic falls back to the paged range.
+	//  - Above it, slots come from pages of `pageSize` that are committed on first need, up to `maxPages`.
+	//    The lowest free slot is handed out first, which keeps live indices dense.
+	// Free() queues the slot with the frame (or fence) value that may still reference it; Reclaim(completed)
+	// makes it reusable once the GPU is past that value.
+	class DescriptorSlotAllocator
+	{
+	public:
+		struct Stats
+		{
+			std::uint32_t staticCapacity{ 0 };
+			std::uint32_t staticUsed{ 0 };
+			std::uint32_t committedPages{ 0 };
+			std::uint32_t maxPages{ 0 };
+			std::uint32_t pagedCapacity{ 0 };  // committed pages * page size
+			std::uint32_t pagedUsed{ 0 };
+			std::uint32_t pendingFrees{ 0 };   // freed, waiting for the GPU
+			float occupancy{ 0.0f };           // pagedUsed / pagedCapacity
+			float fragmentation{ 0.0f };       // 1 - largest free run / free slots in committed pages (0 = contiguous)
+		};
+
+		static constexpr std::uint32_t kInvalidSlot = 0xFFFFFFFFu;
+
+		DescriptorSlotAllocator() = default;
+		DescriptorSlotAllocator(std::uint32_t reservedCount, std::uint32_t staticCount, std::uint32_t pageSize, std::uint32_t maxPages)
+			: reservedCount_(reservedCount)
+			, staticCount_(staticCount)
+			, pageSize_(std::max<std::uint32_t>(64u, (pageSize + 63u) & ~63u))
+			, maxPages_(maxPages)
+		{
+			// Every slot is queued at most once, so Free never allocates.
+			staticUsedBits_.assign((staticCount_ + 63u) / 64u, 0ull);
+			freeStatic_.reserve(staticCount_);
+			retiring_.assign((Capacity() - reservedCount_ + 63u) / 64u, 0ull);
+			pending_.reserve(Capacity() - reservedCount_);
+		}
+
+		std::uint32_t Capacity() const noexcept
+		{
+			return PagedBase() + maxPages_ * pageSize_;
+		}
+
+		bool IsStatic(std::uint32_t slot) const noexcept
+		{
+			return slot >= reservedCount_ && slot < PagedBase();
+		}
+
+		// Returns kInvalidSlot when every committed and committable slot is in use.
+		std::uint32_t AllocateStatic()
+		{
+			if (!freeStatic_.empty())
+			{
+				const std::uint32_t slot = freeStatic_.back();
+				freeStatic_.pop_back();
+				MarkStatic(slot, true);
+				return slot;
+			}
+			if (nextStatic_ < staticCount_)
+			{
+				const std::uint32_t slot = reservedCount_ + nextStatic_++;
+				MarkStatic(slot, true);
+				return slot;
+			}
+			return Allocate();
+		}
+
+		std::uint32_t Allocate()
+		{
+			for (std::uint32_t page = 0; page < pageFree_.size(); ++page)
+			{
+				if (pageFree_[page] != 0)
+				{
+					return TakeFromPage(page);
+				}
+			}
+			if (pageFree_.size() >= maxPages_)
+			{
+				return kInvalidSlot;
+			}
+			pageFree_.push_back(pageSize_);
+			used_.resize(used_.size() + pageSize_ / 64u, 0ull);
+			return TakeFromPage(static_cast<std::uint32_t>(pageFree_.size() - 1));
+		}
+
+		// `retireAfter` is the frame/fence value the slot may still be referenced by (0 frees it now);
+		// it must not decrease between calls. Frees of slots that are not allocated, or already waiting
+		// to retire, are ignored.
+		void Free(std::uint32_t slot, std::uint64_t retireAfter) noexcept
+		{
+			if (slot < reservedCount_ || slot >= Capacity() || !IsAllocated(slot) || IsRetiring(slot))
+			{
+				return;
+			}
+			if (retireAfter == 0 || retireAfter <= completed_)
+			{
+				Release(slot);
+				return;
+			}
+			retiring_[(slot - reservedCount_) / 64u] |= 1ull << ((slot - reservedCount_) % 64u);
+			pending_.push_back(PendingFree{ retireAfter, slot });
+		}
+
+		// Makes every slot freed at or before `completed` reusable. `onReclaimed(slot)` runs for each one
+		// (e.g. to overwrite the stale view); values must not decrease between calls.
+		template <typename OnReclaimed>
+		void Reclaim(std::uint64_t completed, OnReclaimed&& onReclaimed)
+		{
+			completed_ = std::max(completed_, completed);
+			std::size_t retired = 0;
+			for (; retired < pending_.size() && pending_[retired].retireAfter <= completed_; ++retired)
+			{
+				const std::uint32_t slot = pending_[retired].slot;
+				retiring_[(slot - reservedCount_) / 64u] &= ~(1ull << ((slot - reservedCount_) % 64u));
+				onReclaimed(slot);
+				Release(slot);
+			}
+			pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(retired));
+		}
+
+		void Reclaim(std::uint64_t completed)
+		{
+			Reclaim(completed, [](std::uint32_t) {});
+		}
+
+		Stats GetStats() const
+		{
+			Stats stats{};
+			stats.staticCapacity = staticCount_;
+			stats.staticUsed = staticUsed_;
+			stats.committedPages = static_cast<std::uint32_t>(pageFree_.size());
+			stats.maxPages = maxPages_;
+			stats.pagedCapacity = stats.committedPages * pageSize_;
+			stats.pendingFrees = static_cast<std::uint32_t>(pending_.size());
+
+			std::uint32_t freeSlots = 0;
+			for (const std::uint32_t pageFree : pageFree_)
+			{
+				freeSlots += pageFree;
+			}
+			stats.pagedUsed = stats.pagedCapacity - freeSlots;
+			if (stats.pagedCapacity > 0)
+			{
+				stats.occupancy = static_cast<float>(stats.pagedUsed) / static_cast<float>(stats.pagedCapacity);
+			}
+
+			std::uint32_t largestRun = 0;
+			std::uint32_t run = 0;
+			for (const std::uint64_t word : used_)
+			{
+				for (std::uint32_t bit = 0; bit < 64u; ++bit)
+				{
+					run = ((word >> bit) & 1ull) ? 0u : run + 1u;
+					largestRun = std::max(largestRun, run);
+				}
+			}
+			if (freeSlots > 0)
+			{
+				stats.fragmentation = 1.0f - static_cast<float>(largestRun) / static_cast<float>(freeSlots);
+			}
+			return stats;
+		}
+
+	private:
+		struct PendingFree
+		{
+			std::uint64_t retireAfter{ 0 };
+			std::uint32_t slot{ 0 };
+		};
+
+		std::uint32_t PagedBase() const noexcept
+		{
+			return reservedCount_ + staticCount_;
+		}
+
+		bool IsAllocated(std::uint32_t slot) const noexcept
+		{
+			if (IsStatic(slot))
+			{
+				const std::uint32_t index = slot - reservedCount_;
+				return (staticUsedBits_[index / 64u] & (1ull << (index % 64u))) != 0;
+			}
+			const std::uint32_t index = slot - PagedBase();
+			return index / 64u < used_.size() && (used_[index / 64u] & (1ull << (index % 64u))) != 0;
+		}
+
+		bool IsRetiring(std::uint32_t slot) const noexcept
+		{
+			const std::uint32_t index = slot - reservedCount_;
+			return (retiring_[index / 64u] & (1ull << (index % 64u))) != 0;
+		}
+
+		void MarkStatic(std::uint32_t slot, bool used) noexcept
+		{
+			const std::uint32_t index = slot - reservedCount_;
+			const std::uint64_t mask = 1ull << (index % 64u);
+			if (used)
+			{
+				staticUsedBits_[index / 64u] |= mask;
+				++staticUsed_;
+			}
+			else
+			{
+				staticUsedBits_[index / 64u] &= ~mask;
+				--staticUsed_;
+			}
+		}
+
+		std::uint32_t TakeFromPage(std::uint32_t page)
+		{
+			const std::uint32_t wordsPerPage = pageSize_ / 64u;
+			for (std::uint32_t w = page * wordsPerPage; w < (page + 1u) * wordsPerPage; ++w)
+			{
+				if (used_[w] != ~0ull)
+				{
+					const std::uint32_t bit = static_cast<std::uint32_t>(std::countr_one(used_[w]));
+					used_[w] |= 1ull << bit;
+					--pageFree_[page];
+					return PagedBase() + w * 64u + bit;
+				}
+			}
+			return kInvalidSlot;
+		}
+
+		void Release(std::uint32_t slot) noexcept
+		{
+			if (IsStatic(slot))
+			{
+				if (IsAllocated(slot))
+				{
+					MarkStatic(slot, false);
+					freeStatic_.push_back(slot); // reserved for every static slot
+				}
+				return;
+			}
+			const std::uint32_t index = slot - PagedBase();
+			const std::uint32_t word = index / 64u;
+			const std::uint64_t mask = 1ull << (index % 64u);
+			if (word < used_.size() && (used_[word] & mask) != 0)
+			{
+				used_[word] &= ~mask;
+				++pageFree_[index / pageSize_];
+			}
+		}
+
+		std::uint32_t reservedCount_{ 0 };
+		std::uint32_t staticCount_{ 0 };
+		std::uint32_t pageSize_{ 64 };
+		std::uint32_t maxPages_{ 0 };
+
+		std::uint32_t nextStatic_{ 0 };
+		std::uint32_t staticUsed_{ 0 };
+		std::vector<std::uint32_t> freeStatic_;
+		std::vector<std::uint64_t> staticUsedBits_; // one bit per static slot
+
+		std::vector<std::uint32_t> pageFree_;  // free slots per committed page
+		std::vector<std::uint64_t> used_;      // one bit per committed paged slot
+
+		std::vector<std::uint64_t> retiring_;  // one bit per non-reserved slot queued in pending_
+		std::vector<PendingFree> pending_;     // ordered by retireAfter; reserved for every slot
+		std::uint64_t completed_{ 0 };
+	};
+
 	using Command = std::variant <
 		CommandBeginPass,
 		CommandEndPass,
@@ -429,75 +920,352 @@ export namespace rhi
 		CommandDX12ImGuiRender,
 		CommandDrawIndexed,
 		CommandDraw,
-		CommandBindTexture2DArray > ;
+		CommandBindTexture2DArray,
+		CommandBindBufferUAV,
+		CommandDispatch,
+		CommandDispatchMesh,
+		CommandDrawIndexedIndirect,
+		CommandTextureBarriers,
+		CommandCopyTexture,
+		CommandReadbackTexture,
+		CommandGenerateMips,
+		CommandSetScissor,
+		CommandBeginAsyncCompute,
+		CommandEndAsyncCompute,
+		CommandWaitAsyncCompute,
+		CommandBeginTimestampZone,
+		CommandEndTimestampZone > ;
+
+	// Tag of a packed command record: the index of its type in Command.
+	template <typename T, typename Variant>
+	struct CommandTypeIndex;
+	template <typename T, typename... Ts>
+	struct CommandTypeIndex<T, std::variant<Ts...>>
+	{
+		static constexpr std::size_t value = []
+			{
+				std::size_t index = 0;
+				(void)((std::is_same_v<T, Ts> ? true : (++index, false)) || ...);
+				return index;
+			}();
+		static_assert(value < sizeof...(Ts), "not a command type");
+	};
 
-	struct CommandList
+	template <typename Variant>
+	struct AllCommandsTriviallyCopyable;
+	template <typename... Ts>
+	struct AllCommandsTriviallyCopyable<std::variant<Ts...>>
 	{
-		std::vector<Command> commands;
+		static constexpr bool value = (std::is_trivially_copyable_v<Ts> && ...);
+	};
+	static_assert(AllCommandsTriviallyCopyable<Command>::value, "commands are stored as raw bytes");
+
+	template <typename T>
+	inline constexpr std::uint16_t kCommandType = static_cast<std::uint16_t>(CommandTypeIndex<T, Command>::value);
+
+	// One record of a CommandList: its type tag and a pointer to the command.
+	class CommandRecord
+	{
+	public:
+		CommandRecord(std::uint16_t type, const std::byte* payload) noexcept
+			: type_(type)
+			, payload_(payload)
+		{
+		}
+
+		std::uint16_t Type() const noexcept { return type_; }
+
+		template <typename T>
+		bool Is() const noexcept
+		{
+			return type_ == kCommandType<T>;
+		}
+
+		template <typename T>
+		const T* GetIf() const noexcept
+		{
+			return Is<T>() ? std::launder(reinterpret_cast<const T*>(payload_)) : nullptr;
+		}
+
+		// Calls visitor(const T&) with the command.
+		template <typename Visitor>
+		void Visit(Visitor&& visitor) const
+		{
+			Visit_(visitor, std::make_index_sequence<std::variant_size_v<Command>>{});
+		}
+
+	private:
+		template <typename Visitor, std::size_t... I>
+		void Visit_(Visitor& visitor, std::index_sequence<I...>) const
+		{
+			(void)((type_ == I
+				? (visitor(*std::launder(reinterpret_cast<const std::variant_alternative_t<I, Command>*>(payload_))), true)
+				: false) || ...);
+		}
+
+		std::uint16_t type_{ 0 };
+		const std::byte* payload_{ nullptr };
+	};
+
+	// Commands packed back to back as tagged, variable-size records in chunks of kChunkBytes: a record is
+	// an 8-byte header plus its command (SetConstants, barrier batches and uniform names keep their payload
+	// inline after it), instead of a slot as wide as the largest command. Chunks never move, so payload
+	// spans stay valid when lists are moved or appended. Reset() keeps the chunks for the next recording,
+	// and lists that die hand their chunks to a shared pool that new lists draw from, so a steady frame
+	// records without allocating.
+	class CommandList
+	{
+		struct Chunk_
+		{
+			std::unique_ptr<std::byte[]> data;
+			std::size_t size{ 0 };
+			std::size_t used{ 0 };
+		};
+
+		struct RecordHeader_
+		{
+			std::uint16_t type{ 0 };
+			std::uint16_t reserved{ 0 };
+			std::uint32_t sizeBytes{ 0 };  // header + command + inline payload, padded to kRecordAlignment
+		};
+
+		static constexpr std::size_t kRecordAlignment = 8;
+		static constexpr std::size_t kHeaderBytes = sizeof(RecordHeader_);
+		static constexpr std::size_t kMaxPooledChunks = 64;
+		static_assert(kHeaderBytes % kRecordAlignment == 0);
+
+		static RecordHeader_ Header_(const std::byte* record) noexcept
+		{
+			RecordHeader_ header;
+			std::memcpy(&header, record, sizeof(header));
+			return header;
+		}
+
+	public:
+		static constexpr std::size_t kChunkBytes = 64 * 1024;
+
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = CommandRecord;
+			using difference_type = std::ptrdiff_t;
+
+			Iterator() = default;
+
+			CommandRecord operator*() const noexcept
+			{
+				const std::byte* record = chunks_[chunk_].data.get() + offset_;
+				return CommandRecord(Header_(record).type, record + kHeaderBytes);
+			}
+
+			Iterator& operator++() noexcept
+			{
+				offset_ += Header_(chunks_[chunk_].data.get() + offset_).sizeBytes;
+				SkipExhausted_();
+				return *this;
+			}
+
+			Iterator operator++(int) noexcept
+			{
+				Iterator prev = *this;
+				++*this;
+				return prev;
+			}
+
+			friend bool operator==(const Iterator& a, const Iterator& b) noexcept
+			{
+				return a.chunk_ == b.chunk_ && a.offset_ == b.offset_;
+			}
+
+		private:
+			friend class CommandList;
+
+			Iterator(const std::vector<Chunk_>* chunks, std::size_t chunk) noexcept
+				: chunks_(chunks->data())
+				, chunkCount_(chunks->size())
+				, chunk_(chunk)
+			{
+				SkipExhausted_();
+			}
+
+			void SkipExhausted_() noexcept
+			{
+				while (chunk_ < chunkCount_ && offset_ >= chunks_[chunk_].used)
+				{
+					++chunk_;
+					offset_ = 0;
+				}
+			}
+
+			const Chunk_* chunks_{ nullptr };
+			std::size_t chunkCount_{ 0 };
+			std::size_t chunk_{ 0 };
+			std::size_t offset_{ 0 };
+		};
+
+		CommandList() = default;
+		CommandList(const CommandList&) = delete;
+		CommandList& operator=(const CommandList&) = delete;
+
+		CommandList(CommandList&& other) noexcept
+			: chunks_(std::move(other.chunks_))
+			, current_(std::exchange(other.current_, 0))
+			, count_(std::exchange(other.count_, 0))
+		{
+			other.chunks_.clear();
+		}
+
+		CommandList& operator=(CommandList&& other) noexcept
+		{
+			if (this != &other)
+			{
+				ReleaseChunks_();
+				chunks_ = std::move(other.chunks_);
+				other.chunks_.clear();
+				current_ = std::exchange(other.current_, 0);
+				count_ = std::exchange(other.count_, 0);
+			}
+			return *this;
+		}
+
+		~CommandList()
+		{
+			ReleaseChunks_();
+		}
+
+		Iterator begin() const noexcept { return Iterator(&chunks_, 0); }
+		Iterator end() const noexcept { return Iterator(&chunks_, chunks_.size()); }
+
+		std::size_t Size() const noexcept { return count_; }
+		bool Empty() const noexcept { return count_ == 0; }
+
+		// Calls visitor(const T&) for every command in recording order.
+		template <typename Visitor>
+		void ForEach(Visitor&& visitor) const
+		{
+			for (const CommandRecord record : *this)
+			{
+				record.Visit(visitor);
+			}
+		}
+
+		// Drops the commands and keeps the chunks for the next recording.
+		void Reset() noexcept
+		{
+			for (Chunk_& chunk : chunks_)
+			{
+				chunk.used = 0;
+			}
+			current_ = 0;
+			count_ = 0;
+		}
+
+		// Moves other's commands to the end of this list (lists recorded separately, submitted as one).
+		// Whole chunks change hands; nothing is copied.
+		void Append(CommandList&& other)
+		{
+			if (other.count_ == 0)
+			{
+				return;
+			}
+
+			std::vector<Chunk_> moved;
+			std::size_t keep = 0;
+			for (Chunk_& chunk : other.chunks_)
+			{
+				if (chunk.used != 0)
+				{
+					moved.push_back(std::move(chunk));
+				}
+				else
+				{
+					other.chunks_[keep++] = std::move(chunk);
+				}
+			}
+			other.chunks_.resize(keep);
+			for (Chunk_& chunk : other.chunks_)
+			{
+				chunk.used = 0;
+			}
+
+			const std::size_t insertAt = chunks_.empty() ? 0 : current_ + 1;
+			chunks_.insert(chunks_.begin() + static_cast<std::ptrdiff_t>(insertAt), std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end()));
+			current_ = insertAt + moved.size() - 1;
+			count_ += std::exchange(other.count_, 0);
+			other.current_ = 0;
+		}
 
 		void BeginPass(const BeginPassDesc& desc)
 		{
-			commands.emplace_back(CommandBeginPass{ desc });
+			Record_(CommandBeginPass{ desc });
 		}
 		void EndPass()
 		{
-			commands.emplace_back(CommandEndPass{});
+			Record_(CommandEndPass{});
 		}
 		void SetViewport(int x, int y, int width, int height)
 		{
-			commands.emplace_back(CommandSetViewport{ x, y, width, height });
+			Record_(CommandSetViewport{ x, y, width, height });
+		}
+		void SetScissor(int x, int y, int width, int height)
+		{
+			Record_(CommandSetScissor{ x, y, width, height });
 		}
 		void SetState(const GraphicsState& state)
 		{
-			commands.emplace_back(CommandSetState{ state });
+			Record_(CommandSetState{ state });
 		}
 		void SetStencilRef(std::uint32_t ref)
 		{
-			commands.emplace_back(CommandSetStencilRef{ ref });
+			Record_(CommandSetStencilRef{ ref });
 		}
 		void SetPrimitiveTopology(PrimitiveTopology topology)
 		{
-			commands.emplace_back(CommandSetPrimitiveTopology{ topology });
+			Record_(CommandSetPrimitiveTopology{ topology });
 		}
 		void BindPipeline(PipelineHandle pso)
 		{
-			commands.emplace_back(CommandBindPipeline{ pso });
+			Record_(CommandBindPipeline{ pso });
 		}
 		void BindInputLayout(InputLayoutHandle layout)
 		{
-			commands.emplace_back(CommandBindInputLayout{ layout });
+			Record_(CommandBindInputLayout{ layout });
 		}
 		void BindVertexBuffer(std::uint32_t slot, BufferHandle buffer, std::uint32_t strideBytes = 0, std::uint32_t offsetBytes = 0)
 		{
-			commands.emplace_back(CommandBindVertexBuffer{ slot, buffer, strideBytes, offsetBytes });
+			Record_(CommandBindVertexBuffer{ slot, buffer, strideBytes, offsetBytes });
 		}
 		void BindIndexBuffer(BufferHandle buffer, IndexType indexType, std::uint32_t offsetBytes = 0)
 		{
-			commands.emplace_back(CommandBindIndexBuffer{ buffer, indexType, offsetBytes });
+			Record_(CommandBindIndexBuffer{ buffer, indexType, offsetBytes });
 		}
 		void BindTexture2D(std::uint32_t slot, TextureHandle texture)
 		{
-			commands.emplace_back(CommnadBindTexture2D{ slot, texture });
+			Record_(CommnadBindTexture2D{ slot, texture });
 		}
 		void BindTextureCube(std::uint32_t slot, TextureHandle texture)
 		{
-			commands.emplace_back(CommandBindTextureCube{ slot, texture });
+			Record_(CommandBindTextureCube{ slot, texture });
 		}
 		void BindTextureDesc(std::uint32_t slot, TextureDescIndex textureIndex)
 		{
-			commands.emplace_back(CommandTextureDesc{ slot, textureIndex });
+			Record_(CommandTextureDesc{ slot, textureIndex });
 		}
-		void SetUniformInt(std::string name, int value)
+		void SetUniformInt(std::string_view name, int value)
 		{
-			commands.emplace_back(CommandSetUniformInt{ std::move(name), value });
+			CommandSetUniformInt& cmd = Record_(CommandSetUniformInt{ {}, value }, name.size() + 1);
+			cmd.name = CopyName_(cmd, name);
 		}
-		void SetUniformFloat4(std::string name, std::array<float, 4> value)
+		void SetUniformFloat4(std::string_view name, std::array<float, 4> value)
 		{
-			commands.emplace_back(CommandUniformFloat4{ std::string(name), value });
+			CommandUniformFloat4& cmd = Record_(CommandUniformFloat4{ {}, value }, name.size() + 1);
+			cmd.name = CopyName_(cmd, name);
 		}
 		void SetUniformMat4(std::string_view name, const std::array<float, 16>& v)
 		{
-			commands.emplace_back(CommandUniformMat4{ std::string(name), v });
+			CommandUniformMat4& cmd = Record_(CommandUniformMat4{ {}, v }, name.size() + 1);
+			cmd.name = CopyName_(cmd, name);
 		}
 		void SetConstants(std::uint32_t slot, std::span<const std::byte> bytes)
 		{
@@ -506,12 +1274,11 @@ export namespace rhi
 				throw std::runtime_error("CommandList::SetConstants: payload too large (max 512 bytes)");
 			}
 
-			CommandSetConstants cmd{};
-			cmd.slot = slot;
-			cmd.size = static_cast<std::uint32_t>(bytes.size());
+			CommandSetConstants& cmd = Record_(CommandSetConstants{ slot, {} }, bytes.size());
+			std::byte* data = TrailingBytes_(cmd);
 			if (!bytes.empty())
-				std::memcpy(cmd.data.data(), bytes.data(), bytes.size());
-			commands.emplace_back(std::move(cmd));
+				std::memcpy(data, bytes.data(), bytes.size());
+			cmd.data = std::span<const std::byte>(data, bytes.size());
 		}
 		void DrawIndexed(
 			std::uint32_t indexCount,
@@ -521,7 +1288,7 @@ export namespace rhi
 			uint32_t instanceCount = 1,
 			uint32_t firstInstance = 0)
 		{
-			commands.emplace_back(CommandDrawIndexed{ indexCount, indexType, firstIndex, baseVertex, instanceCount, firstInstance });
+			Record_(CommandDrawIndexed{ indexCount, indexType, firstIndex, baseVertex, instanceCount, firstInstance });
 		}
 		void Draw(
 			std::uint32_t vertexCount,
@@ -529,20 +1296,205 @@ export namespace rhi
 			uint32_t instanceCount = 1,
 			uint32_t firstInstance = 0)
 		{
-			commands.emplace_back(CommandDraw{ vertexCount, firstVertex, instanceCount, firstInstance });
+			Record_(CommandDraw{ vertexCount, firstVertex, instanceCount, firstInstance });
 		}
 		void BindStructuredBufferSRV(std::uint32_t slot, BufferHandle buffer)
 		{
-			commands.emplace_back(CommandBindStructuredBufferSRV{ slot, buffer });
+			Record_(CommandBindStructuredBufferSRV{ slot, buffer });
 		}
 		void DX12ImGuiRender(const void* drawData)
 		{
-			commands.emplace_back(CommandDX12ImGuiRender{ drawData });
+			Record_(CommandDX12ImGuiRender{ drawData });
 		}
 		void BindTexture2DArray(std::uint32_t slot, TextureHandle texture)
 		{
-			commands.emplace_back(CommandBindTexture2DArray{ slot, texture });
+			Record_(CommandBindTexture2DArray{ slot, texture });
+		}
+		void BindBufferUAV(std::uint32_t slot, BufferHandle buffer)
+		{
+			Record_(CommandBindBufferUAV{ slot, buffer });
+		}
+		void Dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY = 1, std::uint32_t groupCountZ = 1)
+		{
+			Record_(CommandDispatch{ groupCountX, groupCountY, groupCountZ });
+		}
+		void DispatchMesh(std::uint32_t groupCountX, std::uint32_t groupCountY = 1, std::uint32_t groupCountZ = 1)
+		{
+			Record_(CommandDispatchMesh{ groupCountX, groupCountY, groupCountZ });
+		}
+		void DrawIndexedIndirect(
+			BufferHandle argsBuffer,
+			std::uint32_t argsOffsetBytes,
+			IndexType indexType,
+			std::uint32_t maxDrawCount = 1,
+			BufferHandle countBuffer = {},
+			std::uint32_t countOffsetBytes = 0)
+		{
+			Record_(CommandDrawIndexedIndirect{ argsBuffer, argsOffsetBytes, indexType, maxDrawCount, countBuffer, countOffsetBytes });
+		}
+		void TextureBarriers(std::span<const TextureBarrier> barriers)
+		{
+			CommandTextureBarriers& cmd = Record_(CommandTextureBarriers{}, barriers.size_bytes());
+			TextureBarrier* copy = reinterpret_cast<TextureBarrier*>(TrailingBytes_(cmd));
+			std::ranges::copy(barriers, copy);
+			cmd.barriers = std::span<const TextureBarrier>(copy, barriers.size());
+		}
+		void CopyTexture(TextureHandle src, TextureHandle dst)
+		{
+			Record_(CommandCopyTexture{ src, dst });
+		}
+		void ReadbackTexture(TextureHandle texture, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height, std::uint64_t requestId)
+		{
+			Record_(CommandReadbackTexture{ texture, x, y, width, height, requestId });
+		}
+		void GenerateMips(TextureHandle texture, bool normalMap = false)
+		{
+			Record_(CommandGenerateMips{ texture, normalMap });
+		}
+		void BeginAsyncCompute()
+		{
+			Record_(CommandBeginAsyncCompute{});
+		}
+		void EndAsyncCompute(std::uint32_t syncPoint)
+		{
+			Record_(CommandEndAsyncCompute{ syncPoint });
 		}
+		void WaitAsyncCompute(std::uint32_t syncPoint)
+		{
+			Record_(CommandWaitAsyncCompute{ syncPoint });
+		}
+		void BeginTimestampZone(std::string_view name)
+		{
+			CommandBeginTimestampZone& cmd = Record_(CommandBeginTimestampZone{}, name.size() + 1);
+			cmd.name = CopyName_(cmd, name);
+		}
+		void EndTimestampZone()
+		{
+			Record_(CommandEndTimestampZone{});
+		}
+
+	private:
+		// Appends a record for `command` with `trailingBytes` of payload space after it.
+		template <typename T>
+		T& Record_(const T& command, std::size_t trailingBytes = 0)
+		{
+			static_assert(alignof(T) <= kRecordAlignment);
+			const std::size_t recordBytes = (kHeaderBytes + sizeof(T) + trailingBytes + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+			std::byte* record = Allocate_(recordBytes);
+
+			const RecordHeader_ header{ kCommandType<T>, 0, static_cast<std::uint32_t>(recordBytes) };
+			std::memcpy(record, &header, sizeof(header));
+			++count_;
+			return *::new (record + kHeaderBytes) T(command);
+		}
+
+		template <typename T>
+		static std::byte* TrailingBytes_(T& command) noexcept
+		{
+			return reinterpret_cast<std::byte*>(&command) + sizeof(T);
+		}
+
+		// Uniform names are stored null-terminated so backends can pass name.data() to C APIs.
+		template <typename T>
+		static std::string_view CopyName_(T& command, std::string_view name) noexcept
+		{
+			char* text = reinterpret_cast<char*>(TrailingBytes_(command));
+			std::memcpy(text, name.data(), name.size());
+			text[name.size()] = '\0';
+			return std::string_view(text, name.size());
+		}
+
+		std::byte* Allocate_(std::size_t bytes)
+		{
+			if (chunks_.empty() || chunks_[current_].size - chunks_[current_].used < bytes)
+			{
+				NextChunk_(bytes);
+			}
+			Chunk_& chunk = chunks_[current_];
+			std::byte* p = chunk.data.get() + chunk.used;
+			chunk.used += bytes;
+			return p;
+		}
+
+		void NextChunk_(std::size_t bytes)
+		{
+			// Spare chunks left by Reset() come first; one too small for an oversized record stays empty.
+			while (!chunks_.empty() && current_ + 1 < chunks_.size())
+			{
+				++current_;
+				if (chunks_[current_].used == 0 && chunks_[current_].size >= bytes)
+				{
+					return;
+				}
+			}
+
+			Chunk_ chunk{};
+			chunk.size = std::max(kChunkBytes, bytes);
+			if (chunk.size == kChunkBytes)
+			{
+				chunk.data = AcquirePooledChunk_();
+			}
+			if (!chunk.data)
+			{
+				chunk.data = std::make_unique_for_overwrite<std::byte[]>(chunk.size);
+			}
+			chunks_.push_back(std::move(chunk));
+			current_ = chunks_.size() - 1;
+		}
+
+		static std::mutex& PoolMutex_() noexcept
+		{
+			static std::mutex mutex;
+			return mutex;
+		}
+
+		static std::vector<std::unique_ptr<std::byte[]>>& Pool_() noexcept
+		{
+			static std::vector<std::unique_ptr<std::byte[]>> pool;
+			return pool;
+		}
+
+		static std::unique_ptr<std::byte[]> AcquirePooledChunk_()
+		{
+			std::lock_guard lock(PoolMutex_());
+			std::vector<std::unique_ptr<std::byte[]>>& pool = Pool_();
+			if (pool.empty())
+			{
+				return {};
+			}
+			std::unique_ptr<std::byte[]> chunk = std::move(pool.back());
+			pool.pop_back();
+			return chunk;
+		}
+
+		void ReleaseChunks_() noexcept
+		{
+			if (chunks_.empty())
+			{
+				return;
+			}
+			try
+			{
+				std::lock_guard lock(PoolMutex_());
+				std::vector<std::unique_ptr<std::byte[]>>& pool = Pool_();
+				for (Chunk_& chunk : chunks_)
+				{
+					if (chunk.size == kChunkBytes && pool.size() < kMaxPooledChunks)
+					{
+						pool.push_back(std::move(chunk.data));
+					}
+				}
+			}
+			catch (...)
+			{
+				// The chunks are simply freed.
+			}
+			chunks_.clear();
+		}
+
+		std::vector<Chunk_> chunks_;
+		std::size_t current_{ 0 };
+		std::size_t count_{ 0 };
 	};
 
 	// ------------------------ RHI interfaces ------------------------ //
@@ -556,6 +1508,8 @@ export namespace rhi
 		virtual TextureHandle GetDepthTexture() const = 0;
 		virtual void Present() = 0;
 		virtual void Resize(Extent2D newExtent) = 0;
+		// Low-latency mode: call before sampling input for the next frame. Default is no-op.
+		virtual void WaitForNextFrame() {}
 	};
 
 	class IRHIDevice
@@ -606,6 +1560,12 @@ export namespace rhi
 		virtual BufferHandle CreateBuffer(const BufferDesc& desc) = 0;
 		virtual void UpdateBuffer(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) = 0;
 		virtual void DestroyBuffer(BufferHandle buffer) noexcept = 0;
+		// Persistent CPU mapping of a BufferUsageFlag::Stream buffer, valid until DestroyBuffer. Empty when
+		// the backend keeps the buffer in device memory (write it with UpdateBuffer instead). Writes are
+		// not synchronized: bytes the GPU may still read belong to one of the last GetFramesInFlight()
+		// submissions and must not be overwritten.
+		virtual std::span<std::byte> MapBuffer([[maybe_unused]] BufferHandle buffer) { return {}; }
+		virtual std::uint32_t GetFramesInFlight() const noexcept { return 1; }
 
 		// Input layouts (API-neutral)
 		virtual InputLayoutHandle CreateInputLayout(const InputLayoutDesc& desc) = 0;
@@ -613,12 +1573,17 @@ export namespace rhi
 
 		// Shaders and Pipelines
 		virtual bool SupportsShaderModel6() const { return false; }
+		// Amplification/mesh shaders (SM6_5), CreateMeshPipeline and DispatchMesh.
+		virtual bool SupportsMeshShaders() const { return false; }
 		virtual bool SupportsViewInstancing() const { return false; }
 
 		// Whether the device can set SV_RenderTargetArrayIndex / SV_ViewportArrayIndex from any shader feeding rasterizer.
 		// This is required for "layered rendering" into Texture2DArray render targets from VS/DS/GS.
 		virtual bool SupportsVPAndRTArrayIndexFromAnyShader() const { return false; }
 
+		// DrawIndexedIndirect with maxDrawCount > 1 (one API call for many records).
+		virtual bool SupportsMultiDrawIndirect() const { return false; }
+
 		virtual ShaderHandle CreateShader(ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode) = 0;
 		virtual ShaderHandle CreateShaderEx(ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode, ShaderModel shaderModel)
 		{
@@ -628,6 +1593,27 @@ export namespace rhi
 			}
 			return {};
 		}
+		// Optional, thread-safe: compiles exactly what CreateShaderEx would into the backend's bytecode cache
+		// so that the later CreateShaderEx is a lookup. False when unsupported or on failure (CreateShaderEx
+		// then compiles again and reports the error).
+		virtual bool PrecompileShader(
+			[[maybe_unused]] ShaderStage stage,
+			[[maybe_unused]] std::string_view debugName,
+			[[maybe_unused]] std::string_view sourceOrBytecode,
+			[[maybe_unused]] ShaderModel shaderModel)
+		{
+			return false;
+		}
+		// Optional (hot reload): recompiles `shader` from new source, keeping the handle. Pipelines using it
+		// switch to the new code from the next submission. False when unsupported; throws on compile errors
+		// like CreateShaderEx, leaving the old code in place.
+		virtual bool ReloadShader(
+			[[maybe_unused]] ShaderHandle shader,
+			[[maybe_unused]] std::string_view sourceOrBytecode,
+			[[maybe_unused]] ShaderModel shaderModel)
+		{
+			return false;
+		}
 		virtual void DestroyShader(ShaderHandle shader) noexcept = 0;
 
 		virtual PipelineHandle CreatePipeline(std::string_view debugName, ShaderHandle vertexShader, ShaderHandle pixelShader, PrimitiveTopologyType topologyType = PrimitiveTopologyType::Triangle) = 0;
@@ -640,15 +1626,62 @@ export namespace rhi
 		{
 			return CreatePipeline(debugName, vertexShader, pixelShader, topologyType);
 		}
+		// Graphics pipeline without an input assembler; `amplificationShader` may be null. Like CreatePipeline
+		// the variants follow SetState and the render targets. {} when SupportsMeshShaders is false.
+		virtual PipelineHandle CreateMeshPipeline(
+			[[maybe_unused]] std::string_view debugName,
+			[[maybe_unused]] ShaderHandle amplificationShader,
+			[[maybe_unused]] ShaderHandle meshShader,
+			[[maybe_unused]] ShaderHandle pixelShader)
+		{
+			return {};
+		}
 		virtual void DestroyPipeline(PipelineHandle pso) noexcept = 0;
 
+		// Compute (optional): StorageBuffer UAVs, Dispatch and DrawIndexedIndirect.
+		// Backends without it return {} and the renderer keeps its CPU paths.
+		virtual bool SupportsCompute() const { return false; }
+		// A second queue for BeginAsyncCompute..EndAsyncCompute segments (implies SupportsCompute).
+		virtual bool SupportsAsyncCompute() const { return false; }
+		// CommandGenerateMips (RGBA8 textures created with a mip chain, e.g. color cubes).
+		virtual bool SupportsGenerateMips() const { return false; }
+		virtual PipelineHandle CreateComputePipeline([[maybe_unused]] std::string_view debugName, [[maybe_unused]] ShaderHandle computeShader)
+		{
+			return {};
+		}
+
+		// Pipeline cache (optional). Backends that compile pipeline variants lazily persist them under
+		// `directory` between runs. WarmPipelineCache is called once the renderer has created its pipelines
+		// and rebuilds the variants earlier sessions used in the background; SavePipelineCache at shutdown.
+		// Compiled shader bytecode is cached under the same directory.
+		virtual void LoadPipelineCache([[maybe_unused]] std::string_view directory) {}
+		virtual void WarmPipelineCache() {}
+		virtual void SavePipelineCache() {}
+
 		// Submission
 		virtual void SubmitCommandList(CommandList&& commandList) = 0;
+		// Counters of the most recent SubmitCommandList; backends without state filtering return {}.
+		virtual SubmissionStats GetLastSubmissionStats() const { return {}; }
+		// Upload and descriptor traffic (all zero when the backend doesn't count it).
+		virtual DeviceCounters GetDeviceCounters() const { return {}; }
+		// GPU timestamp zones (optional). The zones of the most recent submission whose results are back,
+		// which is a few frames behind the one being recorded; submissions without zones don't replace them.
+		virtual bool SupportsTimestampQueries() const { return false; }
+		virtual std::span<const GpuTimestampZone> GetLastGpuTimestampZones() const { return {}; }
+		// Texture readback (optional): appends the CommandReadbackTexture results whose submissions the GPU
+		// has finished to `out`, in submission order; each is handed out once.
+		virtual bool SupportsTextureReadback() const { return false; }
+		virtual void TakeCompletedTextureReadbacks([[maybe_unused]] std::vector<TextureReadback>& out) {}
 
 		// Bindless-style descriptor indices
+		// True when shaders can sample a TextureDescIndex directly (DX12 descriptor heap, GL
+		// ARB_bindless_texture); otherwise bind it to a slot with BindTextureDesc before the draw.
+		virtual bool SupportsBindlessTextures() const { return false; }
 		virtual TextureDescIndex AllocateTextureDesctiptor(TextureHandle texture) = 0;
 		virtual void UpdateTextureDescriptor(TextureDescIndex index, TextureHandle texture) = 0;
 		virtual void FreeTextureDescriptor(TextureDescIndex index) noexcept = 0;
+		// Occupancy of the backend's descriptor heap (all zero when it doesn't track one).
+		virtual DescriptorSlotAllocator::Stats GetDescriptorHeapStats() const { return {}; }
 
 		// Synchronization
 		virtual FenceHandle CreateFence(bool signaled = false) = 0;
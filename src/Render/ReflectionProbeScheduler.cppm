@@ -0,0 +1,90 @@
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+export module core:reflection_probe_scheduler;
+
+import :math_utils;
+
+// Time-sliced reflection probe recapture.
+//
+// Every probe keeps a mask of cubemap faces that need to be captured again (moved probe, changed
+// neighbourhood, or a dynamic probe starting its next refresh). Each frame a budget of faces is handed
+// out: probes that were never captured first, then by descending priority, lowest face index first.
+// A probe that does not get all its faces keeps the rest for the next frame, and its waiting time
+// raises its priority, so small or distant probes are delayed but not starved.
+
+export namespace rendern
+{
+	constexpr std::uint32_t kReflectionProbeFaces = 6;
+	constexpr std::uint8_t kAllReflectionProbeFaces = 0x3Fu;
+
+	struct ReflectionProbeRequest
+	{
+		std::uint8_t staleFaces{ 0 }; // bit f: face f needs recapture
+		bool neverCaptured{ false };  // holds no valid image yet: scheduled before everything else
+		float priority{ 0.0f };       // see ReflectionProbePriority
+	};
+
+	// Approximate screen coverage of the probe owner's bounding sphere (fraction of the view height,
+	// squared) seen from the camera, scaled up by the number of frames the probe has been waiting.
+	// Farther and smaller probes get less; a camera inside the sphere counts as full coverage.
+	[[nodiscard]] float ReflectionProbePriority(const mathUtils::Vec3& cameraPos, float fovYRad,
+		const mathUtils::Vec3& probeCenter, float probeRadius, std::uint32_t framesWaiting) noexcept
+	{
+		const mathUtils::Vec3 d = probeCenter - cameraPos;
+		const float dist = std::sqrt(mathUtils::Dot(d, d));
+		const float radius = std::max(probeRadius, 1.0e-3f);
+		float coverage = 1.0f;
+		if (dist > radius)
+		{
+			const float halfHeight = dist * std::tan(std::max(fovYRad, 1.0e-3f) * 0.5f);
+			coverage = std::min(1.0f, (radius * radius) / (halfHeight * halfHeight));
+		}
+		return coverage * static_cast<float>(1u + framesWaiting);
+	}
+
+	// Picks the faces to capture this frame: outFaces[i] is a subset of probes[i].staleFaces, and the
+	// total number of set bits is at most faceBudget (0 = no limit). Returns the number of faces picked.
+	std::uint32_t ScheduleReflectionProbeFaces(std::span<const ReflectionProbeRequest> probes,
+		std::uint32_t faceBudget, std::span<std::uint8_t> outFaces)
+	{
+		std::fill(outFaces.begin(), outFaces.end(), std::uint8_t{ 0 });
+
+		std::vector<std::size_t> order(std::min(probes.size(), outFaces.size()));
+		std::iota(order.begin(), order.end(), std::size_t{ 0 });
+		std::stable_sort(order.begin(), order.end(), [probes](std::size_t a, std::size_t b)
+			{
+				if (probes[a].neverCaptured != probes[b].neverCaptured)
+				{
+					return probes[a].neverCaptured;
+				}
+				return probes[a].priority > probes[b].priority;
+			});
+
+		std::uint32_t picked = 0;
+		for (const std::size_t probeIndex : order)
+		{
+			const std::uint8_t stale = probes[probeIndex].staleFaces & kAllReflectionProbeFaces;
+			for (std::uint32_t face = 0; face < kReflectionProbeFaces; ++face)
+			{
+				if (faceBudget != 0 && picked >= faceBudget)
+				{
+					return picked;
+				}
+				if ((stale & (1u << face)) != 0u)
+				{
+					outFaces[probeIndex] |= static_cast<std::uint8_t>(1u << face);
+					++picked;
+				}
+			}
+		}
+		return picked;
+	}
+}
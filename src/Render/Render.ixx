@@ -5,13 +5,20 @@ export import :render_core;
 export import :render_graph;
 export import :render_bindless;
 export import :render_gpu_memory;
+export import :light_clusters;
+export import :reflection_probe_scheduler;
+export import :shadow_atlas;
+export import :dynamic_resolution;
 export import :render_renderer;
+export import :particle_pool;
 export import :scene;
+export import :scene_bvh;
 export import :visibility;
 export import :level;
 export import :level_ecs;
 export import :picking;
 export import :camera_controller;
+export import :camera_path;
 export import :scene_bridge;
 export import :editor_gizmo;
 export import :editor_rotate_gizmo;
@@ -19,11 +26,23 @@ export import :editor_scale_gizmo;
 export import :shader_system;
 export import :sync;
 export import :shader_files;
+export import :texture_mip_chain;
 export import :texture_decoder_stb;
+export import :texture_decoder_dds;
+export import :pack_file;
 export import :file_system;
+export import :async_file_io;
 export import :mesh;
+export import :mesh_lod;
+export import :mesh_optimize;
+export import :meshlet;
+export import :cooked_mesh;
 export import :skeleton;
 export import :animation_clip;
+export import :animation_compression;
+export import :cooked_animation;
+export import :assimp_loader;
 export import :animator;
 export import :animation_controller;
+export import :animation_lod;
 export import :skinned_mesh;
\ No newline at end of file
@@ -13,6 +13,15 @@ module;
 #include <condition_variable>
 #include <deque>
 #include <atomic>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string_view>
 
 export module core:render_core;
 
@@ -21,6 +30,7 @@ import :rhi;
 import :shader_files;
 import :file_system;
 import :hash_utils;
+import :job_system;
 
 export namespace rendern
 {
@@ -71,8 +81,23 @@ export namespace rendern
 	class ShaderLibrary
 	{
 	public:
+		// Final source text of a key plus every file it was expanded from (hot reload watches those).
+		struct PreparedShader
+		{
+			std::string text;
+			std::vector<std::filesystem::path> dependencies;
+		};
+
 		explicit ShaderLibrary(rhi::IRHIDevice& device) : device_(device) {}
 
+		~ShaderLibrary()
+		{
+			EnableHotReload(false);
+		}
+
+		ShaderLibrary(const ShaderLibrary&) = delete;
+		ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
 		rhi::ShaderHandle GetOrCreateShader(const ShaderKey& key)
 		{
 			if (auto it = shaderCache_.find(key); it != shaderCache_.end())
@@ -80,6 +105,151 @@ export namespace rendern
 				return it->second;
 			}
 
+			PreparedShader prepared;
+			if (auto it = preparedSources_.find(key); it != preparedSources_.end())
+			{
+				prepared = std::move(it->second);
+				preparedSources_.erase(it);
+			}
+			else
+			{
+				prepared = PrepareSource(key);
+			}
+
+			rhi::ShaderHandle shader = device_.CreateShaderEx(key.stage, key.name, prepared.text, key.shaderModel);
+			if (!shader)
+			{
+				return {};
+			}
+			shaderCache_.emplace(key, shader);
+			createdKeys_.push_back(key);
+			WatchDependencies(key, prepared.dependencies);
+			return shader;
+		}
+
+		// Loads and compiles `keys` on the job system ahead of GetOrCreateShader, which then only creates
+		// handles from the device's bytecode cache. Keys that fail here are left to GetOrCreateShader,
+		// which reports the error where it always has.
+		void PrecompileShaders(std::span<const ShaderKey> keys, jobs::Scheduler* scheduler)
+		{
+			std::vector<const ShaderKey*> pending;
+			pending.reserve(keys.size());
+			for (const ShaderKey& key : keys)
+			{
+				if (!shaderCache_.contains(key) && !preparedSources_.contains(key))
+				{
+					pending.push_back(&key);
+				}
+			}
+
+			std::vector<std::optional<PreparedShader>> sources(pending.size());
+			jobs::ParallelFor(scheduler, pending.size(), 1, [&](std::size_t begin, std::size_t end)
+				{
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						const ShaderKey& key = *pending[i];
+						try
+						{
+							PreparedShader prepared = PrepareSource(key);
+							device_.PrecompileShader(key.stage, key.name, prepared.text, key.shaderModel);
+							sources[i] = std::move(prepared);
+						}
+						catch (const std::exception&)
+						{
+							// Missing file or bad #include; GetOrCreateShader will throw it again.
+						}
+					}
+				});
+
+			for (std::size_t i = 0; i < pending.size(); ++i)
+			{
+				if (sources[i])
+				{
+					preparedSources_.emplace(*pending[i], std::move(*sources[i]));
+				}
+			}
+		}
+
+		// Shaders created so far, in creation order (the next session's PrecompileShaders input).
+		const std::vector<ShaderKey>& CreatedKeys() const noexcept
+		{
+			return createdKeys_;
+		}
+
+		// Hot reload: a background thread polls the files every created shader was expanded from and, when
+		// one changes, rebuilds the source of the shaders depending on it and precompiles them. The swap
+		// itself happens in ApplyHotReloads, which the renderer calls at a frame boundary.
+		void EnableHotReload(bool enable)
+		{
+			if (enable == hotReloadThread_.joinable())
+			{
+				return;
+			}
+			if (enable)
+			{
+				hotReloadThread_ = std::jthread([this](std::stop_token stopToken) { HotReloadLoop(stopToken); });
+			}
+			else
+			{
+				hotReloadThread_.request_stop();
+				hotReloadWake_.notify_all();
+				hotReloadThread_.join();
+			}
+		}
+
+		// Render thread. Swaps in the shaders the watcher finished; returns how many were replaced.
+		// A shader that fails to compile keeps its previous code (the error goes to stderr).
+		std::uint32_t ApplyHotReloads()
+		{
+			std::vector<std::pair<ShaderKey, PreparedShader>> ready;
+			{
+				std::lock_guard lock(hotReloadMutex_);
+				ready.swap(readyReloads_);
+			}
+
+			std::uint32_t reloaded = 0;
+			for (auto& [key, prepared] : ready)
+			{
+				const auto it = shaderCache_.find(key);
+				if (it == shaderCache_.end())
+				{
+					continue;
+				}
+				try
+				{
+					if (device_.ReloadShader(it->second, prepared.text, key.shaderModel))
+					{
+						++reloaded;
+					}
+				}
+				catch (const std::exception& e)
+				{
+					std::cerr << "Shader reload failed (" << key.filePath << ", " << key.name << "): " << e.what() << "\n";
+				}
+				// A fixed #include list (or a broken one) is what the next edit has to be compared against.
+				WatchDependencies(key, prepared.dependencies);
+			}
+			return reloaded;
+		}
+
+		void ClearCache()
+		{
+			EnableHotReload(false);
+			for (const auto& [key, shader] : shaderCache_)
+			{
+				device_.DestroyShader(shader);
+			}
+			shaderCache_.clear();
+			preparedSources_.clear();
+
+			std::lock_guard lock(hotReloadMutex_);
+			watchedDependencies_.clear();
+			watchedFileTimes_.clear();
+			readyReloads_.clear();
+		}
+
+		static PreparedShader PrepareSource(const ShaderKey& key)
+		{
 			const std::filesystem::path path = std::filesystem::path(key.filePath);
 
 			auto IsGLSL = [](std::filesystem::path p) -> bool
@@ -89,43 +259,215 @@ export namespace rendern
 					return ext == ".vert" || ext == ".frag" || ext == ".glsl";
 				};
 
-			FILE_UTILS::TextFile textSource;
-			std::string finalText;
-
+			PreparedShader prepared;
 			if (IsGLSL(path))
 			{
-				textSource = LoadGLSLWithIncludes(path);
-				finalText = AppplyDefinesToGLSL(textSource.text, key.defines);
+				FILE_UTILS::TextFile textSource = LoadGLSLWithIncludes(path);
+				prepared.text = AppplyDefinesToGLSL(textSource.text, key.defines);
+				prepared.dependencies = std::move(textSource.dpendencies);
 			}
 			else
 			{
-				textSource = LoadTextFileWithIncludes(path);
-				finalText = ApplyDefinesToHLSL(textSource.text, key.defines);
+				FILE_UTILS::TextFile textSource = LoadTextFileWithIncludes(path);
+				prepared.text = ApplyDefinesToHLSL(textSource.text, key.defines);
+				prepared.dependencies = std::move(textSource.dpendencies);
 			}
+			return prepared;
+		}
 
-			rhi::ShaderHandle shader = device_.CreateShaderEx(key.stage, key.name, finalText, key.shaderModel);
-			if (!shader)
+	private:
+		static std::optional<std::filesystem::file_time_type> FileTime(const std::filesystem::path& path)
+		{
+			std::error_code ec;
+			const auto time = std::filesystem::last_write_time(path, ec);
+			if (ec)
 			{
-				return {};
+				return std::nullopt;
 			}
-			shaderCache_.emplace(key, shader);
-			return shader;
+			return time;
 		}
 
-		void ClearCache()
+		void WatchDependencies(const ShaderKey& key, std::span<const std::filesystem::path> dependencies)
 		{
-			for (const auto& [key, shader] : shaderCache_)
+			std::lock_guard lock(hotReloadMutex_);
+			watchedDependencies_[key].assign(dependencies.begin(), dependencies.end());
+			for (const std::filesystem::path& file : dependencies)
 			{
-				device_.DestroyShader(shader);
+				if (!watchedFileTimes_.contains(file))
+				{
+					if (const auto time = FileTime(file))
+					{
+						watchedFileTimes_.emplace(file, *time);
+					}
+				}
+			}
+		}
+
+		void HotReloadLoop(std::stop_token stopToken)
+		{
+			using namespace std::chrono_literals;
+
+			std::vector<std::pair<std::filesystem::path, std::filesystem::file_time_type>> files;
+			std::vector<std::filesystem::path> changed;
+			std::vector<ShaderKey> affected;
+			for (;;)
+			{
+				{
+					std::unique_lock lock(hotReloadMutex_);
+					hotReloadWake_.wait_for(lock, stopToken, 250ms, [] { return false; });
+					if (stopToken.stop_requested())
+					{
+						return;
+					}
+					files.assign(watchedFileTimes_.begin(), watchedFileTimes_.end());
+				}
+
+				// Editors often save by replacing the file: a path that is missing right now is retried next poll.
+				changed.clear();
+				for (const auto& [file, knownTime] : files)
+				{
+					if (const auto time = FileTime(file); time && *time != knownTime)
+					{
+						changed.push_back(file);
+					}
+				}
+				if (changed.empty())
+				{
+					continue;
+				}
+
+				affected.clear();
+				{
+					std::lock_guard lock(hotReloadMutex_);
+					for (const std::filesystem::path& file : changed)
+					{
+						if (const auto time = FileTime(file))
+						{
+							watchedFileTimes_[file] = *time;
+						}
+					}
+					for (const auto& [key, dependencies] : watchedDependencies_)
+					{
+						const bool dependsOnChange = std::ranges::any_of(dependencies, [&](const std::filesystem::path& file)
+							{
+								return std::ranges::find(changed, file) != changed.end();
+							});
+						if (dependsOnChange)
+						{
+							affected.push_back(key);
+						}
+					}
+				}
+
+				for (const ShaderKey& key : affected)
+				{
+					if (stopToken.stop_requested())
+					{
+						return;
+					}
+					try
+					{
+						PreparedShader prepared = PrepareSource(key);
+						device_.PrecompileShader(key.stage, key.name, prepared.text, key.shaderModel);
+						std::lock_guard lock(hotReloadMutex_);
+						std::erase_if(readyReloads_, [&](const auto& entry) { return entry.first == key; });
+						readyReloads_.emplace_back(key, std::move(prepared));
+					}
+					catch (const std::exception& e)
+					{
+						std::cerr << "Shader reload failed (" << key.filePath << "): " << e.what() << "\n";
+					}
+				}
 			}
-			shaderCache_.clear();
 		}
 
-	private:
 		rhi::IRHIDevice& device_;
 		std::unordered_map<ShaderKey, rhi::ShaderHandle, ShaderKeyHash> shaderCache_;
+		std::unordered_map<ShaderKey, PreparedShader, ShaderKeyHash> preparedSources_;
+		std::vector<ShaderKey> createdKeys_;
+
+		// Hot reload state shared with the watcher thread.
+		std::mutex hotReloadMutex_;
+		std::condition_variable_any hotReloadWake_;
+		std::unordered_map<ShaderKey, std::vector<std::filesystem::path>, ShaderKeyHash> watchedDependencies_;
+		std::unordered_map<std::filesystem::path, std::filesystem::file_time_type> watchedFileTimes_;
+		std::vector<std::pair<ShaderKey, PreparedShader>> readyReloads_;
+		std::jthread hotReloadThread_;
 	};
 
+	// Shader key manifest: one key per line, tab-separated (stage, shader model, name, file path, defines...).
+	// A missing file, another version or a malformed line yields an empty list.
+	inline constexpr std::string_view kShaderKeyManifestHeader = "shader_keys 1";
+
+	std::vector<ShaderKey> LoadShaderKeyManifest(const std::filesystem::path& path)
+	{
+		std::ifstream file(path);
+		std::string line;
+		if (!file || !std::getline(file, line) || line != kShaderKeyManifestHeader)
+		{
+			return {};
+		}
+
+		std::vector<ShaderKey> keys;
+		while (std::getline(file, line))
+		{
+			std::vector<std::string> fields;
+			std::size_t start = 0;
+			for (;;)
+			{
+				const std::size_t tab = line.find('\t', start);
+				fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+				if (tab == std::string::npos)
+				{
+					break;
+				}
+				start = tab + 1;
+			}
+			if (fields.size() < 4 || fields[0].size() != 1 || fields[1].size() != 1)
+			{
+				return {};
+			}
+
+			ShaderKey key{};
+			const int stage = fields[0][0] - '0';
+			const int shaderModel = fields[1][0] - '0';
+			if (stage < 0 || stage > static_cast<int>(rhi::ShaderStage::Mesh)
+				|| shaderModel < 0 || shaderModel > static_cast<int>(rhi::ShaderModel::SM6_5))
+			{
+				return {};
+			}
+			key.stage = static_cast<rhi::ShaderStage>(stage);
+			key.shaderModel = static_cast<rhi::ShaderModel>(shaderModel);
+			key.name = std::move(fields[2]);
+			key.filePath = std::move(fields[3]);
+			key.defines.assign(std::make_move_iterator(fields.begin() + 4), std::make_move_iterator(fields.end()));
+			keys.push_back(std::move(key));
+		}
+		return keys;
+	}
+
+	void SaveShaderKeyManifest(const std::filesystem::path& path, std::span<const ShaderKey> keys)
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			return;
+		}
+		file << kShaderKeyManifestHeader << '\n';
+		for (const ShaderKey& key : keys)
+		{
+			file << static_cast<int>(key.stage) << '\t' << static_cast<int>(key.shaderModel) << '\t' << key.name << '\t' << key.filePath;
+			for (const std::string& define : key.defines)
+			{
+				file << '\t' << define;
+			}
+			file << '\n';
+		}
+	}
+
 	class PSOCache
 	{
 	public:
@@ -154,6 +496,29 @@ export namespace rendern
 			return pipeline;
 		}
 
+		// Amplification (optional) + mesh + pixel (optional) pipeline; {} without mesh shader support.
+		rhi::PipelineHandle GetOrCreateMesh(
+			std::string_view name,
+			rhi::ShaderHandle amplificationShader,
+			rhi::ShaderHandle meshShader,
+			rhi::ShaderHandle fragmentShader)
+		{
+			const std::string key = std::string(name) + "_as" + std::to_string(amplificationShader.id) + "_ms" + std::to_string(meshShader.id) + "_" + std::to_string(fragmentShader.id);
+
+			if (auto it = psoCache_.find(key); it != psoCache_.end())
+			{
+				return it->second;
+			}
+
+			rhi::PipelineHandle pipeline = device_.CreateMeshPipeline(name, amplificationShader, meshShader, fragmentShader);
+			if (!pipeline)
+			{
+				return {};
+			}
+			psoCache_.emplace(key, pipeline);
+			return pipeline;
+		}
+
 		void ClearCache()
 		{
 			for (const auto& [key, pipeline] : psoCache_)
@@ -180,6 +545,8 @@ export namespace rendern
 	class JobSystemImmediate final : public IJobSystem
 	{
 	public:
+		using IJobSystem::Enqueue;
+
 		void Enqueue(std::function<void()> job) override
 		{
 			job();
@@ -220,10 +587,15 @@ export namespace rendern
 		}
 
 		void Enqueue(std::function<void()> job) override
+		{
+			Enqueue(std::move(job), jobs::JobPriority::Visible, {});
+		}
+
+		void Enqueue(std::function<void()> job, jobs::JobPriority priority, jobs::CancellationToken cancellation) override
 		{
 			{
 				std::scoped_lock lock(mutex_);
-				queue_.push_back(std::move(job));
+				queues_[static_cast<std::size_t>(priority)].push_back(QueuedJob{ std::move(job), std::move(cancellation) });
 			}
 			cv_.notify_one();
 		}
@@ -231,36 +603,64 @@ export namespace rendern
 		void WaitIdle() override
 		{
 			std::unique_lock lock(mutex_);
-			idleCv_.wait(lock, [this] { return queue_.empty() && active_ == 0; });
+			idleCv_.wait(lock, [this] { return QueuesEmpty() && active_ == 0; });
 		}
 
 	private:
+		struct QueuedJob
+		{
+			std::function<void()> job;
+			jobs::CancellationToken cancellation;
+		};
+
+		bool QueuesEmpty() const noexcept
+		{
+			for (const auto& queue : queues_)
+			{
+				if (!queue.empty())
+					return false;
+			}
+			return true;
+		}
+
 		void Worker(std::stop_token st)
 		{
 			while (!st.stop_requested())
 			{
-				std::function<void()> job;
+				QueuedJob job;
 				{
 					std::unique_lock lock(mutex_);
-					cv_.wait(lock, [this, &st] { return st.stop_requested() || stopping_ || !queue_.empty(); });
+					cv_.wait(lock, [this, &st] { return st.stop_requested() || stopping_ || !QueuesEmpty(); });
 					if (st.stop_requested())
 						break;
-					if ((stopping_ || st.stop_requested()) && queue_.empty())
+					if ((stopping_ || st.stop_requested()) && QueuesEmpty())
 						break;
-					if (queue_.empty())
+					if (QueuesEmpty())
 						continue;
-					job = std::move(queue_.front());
-					queue_.pop_front();
+
+					// Highest priority class first.
+					for (auto& queue : queues_)
+					{
+						if (!queue.empty())
+						{
+							job = std::move(queue.front());
+							queue.pop_front();
+							break;
+						}
+					}
 					++active_;
 				}
 
-				try { job(); }
-				catch (...) { /* swallow */ }
+				if (!job.cancellation.IsCancelled())
+				{
+					try { job.job(); }
+					catch (...) { /* swallow */ }
+				}
 
 				{
 					std::scoped_lock lock(mutex_);
 					--active_;
-					if (queue_.empty() && active_ == 0)
+					if (QueuesEmpty() && active_ == 0)
 						idleCv_.notify_all();
 				}
 			}
@@ -269,12 +669,44 @@ export namespace rendern
 		std::mutex mutex_;
 		std::condition_variable cv_;
 		std::condition_variable idleCv_;
-		std::deque<std::function<void()>> queue_;
+		std::array<std::deque<QueuedJob>, jobs::kJobPriorityCount> queues_;
 		std::vector<std::jthread> workers_;
 		std::size_t active_ = 0;
 		bool stopping_ = false;
 	};
 
+	// Work-stealing implementation of IJobSystem (see jobs::Scheduler).
+	// Producers don't share a lock, so decode throughput keeps scaling past a handful of workers.
+	class JobSystemWorkStealing final : public IJobSystem
+	{
+	public:
+		explicit JobSystemWorkStealing(std::uint32_t workerCount = 1)
+			: scheduler_(workerCount)
+		{
+		}
+
+		void Enqueue(std::function<void()> job) override
+		{
+			scheduler_.Schedule(jobs::JobFunction(std::move(job)));
+		}
+
+		void Enqueue(std::function<void()> job, jobs::JobPriority priority, jobs::CancellationToken cancellation) override
+		{
+			scheduler_.Schedule(jobs::JobFunction(std::move(job)), {}, jobs::JobOptions{ priority, std::move(cancellation) });
+		}
+
+		void WaitIdle() override
+		{
+			scheduler_.WaitIdle();
+		}
+
+		// Direct access for callers that want handles, fan-out/join or allocation-free jobs.
+		jobs::Scheduler& GetScheduler() noexcept { return scheduler_; }
+
+	private:
+		jobs::Scheduler scheduler_;
+	};
+
 	class NullTextureUploader final : public ITextureUploader
 	{
 	public:
@@ -1,15 +1,23 @@
 module;
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <span>
 #include <functional>
+#include <utility>
 #include <vector>
+#include <memory_resource>
 
 export module core:render_graph;
 
 import :rhi;
+import :job_system;
+import :profiler;
+import :memory_tracking;
+import :renderer_settings;
 
 export namespace renderGraph
 {
@@ -19,7 +27,9 @@ export namespace renderGraph
 		RenderTarget,
 		DepthStencil,
 		Sampled,
-		Storage
+		Storage,
+		CopySource,
+		CopyDest
 	};
 
 
@@ -46,6 +56,49 @@ struct RGTextureDesc
 
 	using RGTextureHandle = RGTexture;
 
+	enum class RGAccess : std::uint8_t
+	{
+		Read,
+		Write,
+		ReadWrite
+	};
+
+	// One graph texture a pass touches and the state it needs it in.
+	struct RGTextureAccess
+	{
+		RGTexture texture{};
+		RGAccess access{ RGAccess::Read };
+		ResourceUsage usage{ ResourceUsage::Sampled };
+	};
+
+	constexpr RGTextureAccess Read(RGTexture texture, ResourceUsage usage = ResourceUsage::Sampled) noexcept
+	{
+		return RGTextureAccess{ texture, RGAccess::Read, usage };
+	}
+
+	constexpr RGTextureAccess Write(RGTexture texture, ResourceUsage usage = ResourceUsage::Storage) noexcept
+	{
+		return RGTextureAccess{ texture, RGAccess::Write, usage };
+	}
+
+	// A buffer a pass touches. The graph neither creates nor transitions buffers: the declarations only
+	// order async compute passes against the graphics passes that use the same buffers.
+	struct RGBufferAccess
+	{
+		rhi::BufferHandle buffer{};
+		RGAccess access{ RGAccess::Read };
+	};
+
+	constexpr RGBufferAccess Read(rhi::BufferHandle buffer) noexcept
+	{
+		return RGBufferAccess{ buffer, RGAccess::Read };
+	}
+
+	constexpr RGBufferAccess Write(rhi::BufferHandle buffer) noexcept
+	{
+		return RGBufferAccess{ buffer, RGAccess::Write };
+	}
+
 	struct PassAttachments
 	{
 		bool useSwapChainBackbuffer{ false };
@@ -61,6 +114,241 @@ struct RGTextureDesc
 		// If true, color cubemap is rendered as all faces (array layers) in a single pass (e.g. DX12 view-instancing).
 		bool colorCubeAllFaces{ false };
 		rhi::ClearDesc clearDesc{};
+
+		// Compute-only pass: no framebuffer and no BeginPass/EndPass; passExtent is the swapchain extent.
+		bool computeOnly{ false };
+
+		// Graph textures the callback uses besides colors/depth (e.g. sampled inputs). Colors and the bound
+		// depth are implicit writes, and also reads of the previous contents unless the pass clears them whole.
+		// Every graph texture a callback fetches from PassContext::resources must be listed somewhere,
+		// otherwise the pass that produces it may be culled.
+		std::vector<RGTextureAccess> textures;
+		std::vector<RGBufferAccess> buffers;
+
+		// Compute-only pass that may run on the async compute queue, overlapping the graphics passes around
+		// it up to the first one that uses what it touches (see Compile). Its callback may only record
+		// compute work. Everything it uses must be declared, here and on the graphics passes that consume it.
+		bool asyncCompute{ false };
+
+		// The callback only records into ctx.commandList and reads state no other pass changes while the graph
+		// executes, so consecutive passes with this set may be recorded concurrently (see SetJobScheduler).
+		bool parallelRecord{ false };
+
+		// Keep the pass even if nothing reads what it writes (it writes buffers or other untracked state).
+		// Passes that declare no texture writes at all are always kept.
+		bool sideEffects{ false };
+	};
+
+	constexpr std::uint32_t kNoPass = 0xFFFFFFFFu;
+
+	// A transition the graph issues before a pass.
+	struct RGBarrier
+	{
+		RGTexture texture{};
+		rhi::TextureState state{ rhi::TextureState::ShaderRead };
+	};
+
+	// Result of RenderGraph::Compile: the passes that survive culling, in submission order, and the
+	// barriers that go in front of each of them (barriers[barrierOffsets[i] .. barrierOffsets[i + 1])).
+	struct CompiledGraph
+	{
+		std::vector<std::uint32_t> passes;
+		std::vector<std::uint32_t> barrierOffsets;
+		std::vector<RGBarrier> barriers;
+		// Per graph texture: 0 when every pass that declares it was culled (it is not created).
+		std::vector<std::uint8_t> textureUsed;
+		// Per graph texture: first and last index into `passes` that touches it, kNoPass if none does.
+		// A used texture no pass declares is treated as alive for the whole frame.
+		std::vector<std::uint32_t> firstUse;
+		std::vector<std::uint32_t> lastUse;
+		// Per compiled pass: the async compute segment it runs in, and the segment the graphics queue waits
+		// for in front of it; kNoPass for none. Segments are numbered in submission order.
+		std::vector<std::uint32_t> asyncSegment;
+		std::vector<std::uint32_t> waitForSegment;
+		std::uint32_t asyncSegmentCount{ 0 };
+		std::uint32_t culledPassCount{ 0 };
+	};
+
+	// Physical textures and framebuffers for the transient textures of a graph, kept across frames.
+	// Execute assigns every transient texture a pooled texture of the same extent/format/type that is
+	// free for its lifetime, so textures whose lifetimes do not overlap share one allocation, and a
+	// steady frame allocates nothing. Entries left unused for kMaxIdleFrames frames are destroyed.
+	class TransientResourcePool
+	{
+	public:
+		static constexpr std::uint64_t kMaxIdleFrames = 8;
+
+		TransientResourcePool() = default;
+		TransientResourcePool(const TransientResourcePool&) = delete;
+		TransientResourcePool& operator=(const TransientResourcePool&) = delete;
+
+		void BeginFrame() noexcept
+		{
+			++frame_;
+			for (PooledTexture& texture : textures_)
+			{
+				texture.busy = false;
+			}
+		}
+
+		rhi::TextureHandle AcquireTexture(rhi::IRHIDevice& device, const rhi::Extent2D& extent, rhi::Format format, bool cube)
+		{
+			for (PooledTexture& texture : textures_)
+			{
+				if (!texture.busy && texture.cube == cube && texture.format == format
+					&& texture.extent.width == extent.width && texture.extent.height == extent.height)
+				{
+					texture.busy = true;
+					texture.lastUsedFrame = frame_;
+					return texture.handle;
+				}
+			}
+
+			PooledTexture texture{};
+			texture.handle = cube ? device.CreateTextureCube(extent, format) : device.CreateTexture2D(extent, format);
+			texture.extent = extent;
+			texture.format = format;
+			texture.cube = cube;
+			texture.busy = true;
+			texture.lastUsedFrame = frame_;
+			textures_.push_back(texture);
+			++createdTextureCount_;
+			return texture.handle;
+		}
+
+		// The texture may be handed out again to a pass later in this frame.
+		void ReleaseTexture(rhi::TextureHandle handle) noexcept
+		{
+			for (PooledTexture& texture : textures_)
+			{
+				if (texture.handle == handle)
+				{
+					texture.busy = false;
+					return;
+				}
+			}
+		}
+
+		// cubeFace < 0 is a regular MRT framebuffer; cubeAllFaces takes colors[0] as a cube.
+		rhi::FrameBufferHandle AcquireFramebuffer(rhi::IRHIDevice& device, std::span<const rhi::TextureHandle> colors, rhi::TextureHandle depth, int cubeFace, bool cubeAllFaces)
+		{
+			for (PooledFramebuffer& frameBuffer : framebuffers_)
+			{
+				if (frameBuffer.depth == depth && frameBuffer.cubeFace == cubeFace && frameBuffer.cubeAllFaces == cubeAllFaces
+					&& std::ranges::equal(frameBuffer.colors, colors))
+				{
+					frameBuffer.lastUsedFrame = frame_;
+					return frameBuffer.handle;
+				}
+			}
+
+			PooledFramebuffer frameBuffer{};
+			if (cubeAllFaces)
+			{
+				frameBuffer.handle = device.CreateFramebufferCube(colors[0], depth);
+			}
+			else if (cubeFace >= 0)
+			{
+				frameBuffer.handle = device.CreateFramebufferCubeFace(colors[0], static_cast<std::uint32_t>(cubeFace), depth);
+			}
+			else
+			{
+				frameBuffer.handle = device.CreateFramebufferMRT(colors, depth);
+			}
+			frameBuffer.colors.assign(colors.begin(), colors.end());
+			frameBuffer.depth = depth;
+			frameBuffer.cubeFace = cubeFace;
+			frameBuffer.cubeAllFaces = cubeAllFaces;
+			frameBuffer.lastUsedFrame = frame_;
+			framebuffers_.push_back(std::move(frameBuffer));
+			++createdFramebufferCount_;
+			return framebuffers_.back().handle;
+		}
+
+		// Destroys what has been idle too long. Framebuffers can also name imported textures, which may be
+		// recreated under a new handle (e.g. on resize); those entries simply stop matching and age out.
+		void EndFrame(rhi::IRHIDevice& device)
+		{
+			std::erase_if(textures_, [&](const PooledTexture& texture)
+				{
+					if (frame_ - texture.lastUsedFrame <= kMaxIdleFrames)
+					{
+						return false;
+					}
+					std::erase_if(framebuffers_, [&](const PooledFramebuffer& frameBuffer)
+						{
+							if (!frameBuffer.References(texture.handle))
+							{
+								return false;
+							}
+							device.DestroyFramebuffer(frameBuffer.handle);
+							return true;
+						});
+					device.DestroyTexture(texture.handle);
+					return true;
+				});
+			std::erase_if(framebuffers_, [&](const PooledFramebuffer& frameBuffer)
+				{
+					if (frame_ - frameBuffer.lastUsedFrame <= kMaxIdleFrames)
+					{
+						return false;
+					}
+					device.DestroyFramebuffer(frameBuffer.handle);
+					return true;
+				});
+		}
+
+		void Clear(rhi::IRHIDevice& device) noexcept
+		{
+			for (const PooledFramebuffer& frameBuffer : framebuffers_)
+			{
+				device.DestroyFramebuffer(frameBuffer.handle);
+			}
+			for (const PooledTexture& texture : textures_)
+			{
+				device.DestroyTexture(texture.handle);
+			}
+			framebuffers_.clear();
+			textures_.clear();
+		}
+
+		std::size_t TextureCount() const noexcept { return textures_.size(); }
+		std::size_t FramebufferCount() const noexcept { return framebuffers_.size(); }
+		// Textures created over the pool's lifetime; stays flat once the frame shape is steady.
+		std::uint64_t CreatedTextureCount() const noexcept { return createdTextureCount_; }
+		std::uint64_t CreatedFramebufferCount() const noexcept { return createdFramebufferCount_; }
+
+	private:
+		struct PooledTexture
+		{
+			rhi::TextureHandle handle{};
+			rhi::Extent2D extent{ 0, 0 };
+			rhi::Format format{ rhi::Format::Unknown };
+			bool cube{ false };
+			bool busy{ false };
+			std::uint64_t lastUsedFrame{ 0 };
+		};
+
+		struct PooledFramebuffer
+		{
+			rhi::FrameBufferHandle handle{};
+			std::vector<rhi::TextureHandle> colors;
+			rhi::TextureHandle depth{};
+			int cubeFace{ -1 };
+			bool cubeAllFaces{ false };
+			std::uint64_t lastUsedFrame{ 0 };
+
+			bool References(rhi::TextureHandle texture) const noexcept
+			{
+				return depth == texture || std::ranges::find(colors, texture) != colors.end();
+			}
+		};
+
+		std::vector<PooledTexture> textures_;
+		std::vector<PooledFramebuffer> framebuffers_;
+		std::uint64_t frame_{ 0 };
+		std::uint64_t createdTextureCount_{ 0 };
+		std::uint64_t createdFramebufferCount_{ 0 };
 	};
 
 	class RenderGraphResources
@@ -123,127 +411,652 @@ struct RGTextureDesc
 			passes_.emplace_back(PassNode{.name = std::string(name), .attachments = std::move(attachments), .execute = std::move(callback) });
 		}
 
-		void AddSwapChainPass(std::string_view name, rhi::ClearDesc clearDesc, PassCallback callback, bool bindDepthStencil = true)
+		void AddSwapChainPass(std::string_view name, rhi::ClearDesc clearDesc, PassCallback callback, bool bindDepthStencil = true, std::vector<RGTextureAccess> textures = {})
 		{
 			PassAttachments attachments{};
 			attachments.useSwapChainBackbuffer = true;
 			attachments.bindDepthStencil = bindDepthStencil;
 			attachments.clearDesc = clearDesc;
+			attachments.textures = std::move(textures);
+			passes_.emplace_back(PassNode{ .name = std::string(name), .attachments = std::move(attachments), .execute = std::move(callback) });
+		}
+
+		void AddComputePass(std::string_view name, PassCallback callback, std::vector<RGTextureAccess> textures = {}, std::vector<RGBufferAccess> buffers = {}, bool asyncCompute = false)
+		{
+			PassAttachments attachments{};
+			attachments.computeOnly = true;
+			attachments.textures = std::move(textures);
+			attachments.buffers = std::move(buffers);
+			attachments.asyncCompute = asyncCompute;
 			passes_.emplace_back(PassNode{ .name = std::string(name), .attachments = std::move(attachments), .execute = std::move(callback) });
 		}
 
+		// Workers for recording parallelRecord passes (not owned). nullptr records everything on the calling thread.
+		void SetJobScheduler(jobs::Scheduler* scheduler) noexcept
+		{
+			scheduler_ = scheduler;
+		}
+
 		void Reset()
 		{
 			passes_.clear();
 			textures_.clear();
 		}
 
-		void Execute(rhi::IRHIDevice& device, rhi::IRHISwapChain& swapChain)
+		// Builds the dependency DAG from the declared accesses and culls every pass whose writes all go
+		// to transient textures that no surviving pass reads. Roots are swapchain passes, passes that write
+		// an imported texture, sideEffects passes and passes without declared writes. Surviving passes keep
+		// their insertion order (it is a valid topological order: a read depends on the last earlier write).
+		// Barriers are only emitted where a texture's required state changes.
+		//
+		// With asyncCompute, consecutive asyncCompute passes form segments for the compute queue (a pass that
+		// needs barriers starts a new segment: barriers are recorded on the graphics queue ahead of it). The
+		// graphics queue joins a segment in front of the first later graphics pass that touches a texture or
+		// buffer of the segment with either side writing; a segment that declares nothing is joined by the
+		// next graphics pass.
+		CompiledGraph Compile(bool asyncCompute = false) const
 		{
-			std::vector<rhi::TextureHandle> allocatedTextures;
-			allocatedTextures.reserve(textures_.size());
-			std::vector<std::uint8_t> owned;
-			owned.reserve(textures_.size());
-			for (const auto& texDesc : textures_)
+			const std::size_t passCount = passes_.size();
+			std::vector<std::vector<RGTextureAccess>> accesses(passCount);
+			std::vector<std::uint8_t> alive(passCount, 0);
+			for (std::size_t passIndex = 0; passIndex < passCount; ++passIndex)
 			{
-				if (texDesc.externalTexture)
+				accesses[passIndex] = CollectAccesses(passes_[passIndex].attachments);
+
+				const PassAttachments& att = passes_[passIndex].attachments;
+				bool writesAny = false;
+				bool writesImported = false;
+				for (const RGTextureAccess& a : accesses[passIndex])
 				{
-					allocatedTextures.push_back(texDesc.externalTexture);
-					owned.push_back(0);
-					continue;
+					if (a.access != RGAccess::Read && a.texture.id < textures_.size())
+					{
+						writesAny = true;
+						writesImported = writesImported || static_cast<bool>(textures_[a.texture.id].externalTexture);
+					}
+				}
+				if (att.useSwapChainBackbuffer || att.sideEffects || !writesAny || writesImported)
+				{
+					alive[passIndex] = 1;
 				}
+			}
 
-				rhi::TextureHandle texture = (texDesc.type == TextureType::Cube)
-					? device.CreateTextureCube(texDesc.extent, texDesc.format)
-					: device.CreateTexture2D(texDesc.extent, texDesc.format);
-				allocatedTextures.push_back(texture);
-				owned.push_back(1);
+			// Producer edges: every read depends on the last earlier writer of that texture.
+			std::vector<std::uint32_t> lastWriter(textures_.size(), kNoPass);
+			std::vector<std::vector<std::uint32_t>> producers(passCount);
+			for (std::size_t passIndex = 0; passIndex < passCount; ++passIndex)
+			{
+				for (const RGTextureAccess& a : accesses[passIndex])
+				{
+					if (a.access != RGAccess::Write && a.texture.id < textures_.size() && lastWriter[a.texture.id] != kNoPass)
+					{
+						producers[passIndex].push_back(lastWriter[a.texture.id]);
+					}
+				}
+				for (const RGTextureAccess& a : accesses[passIndex])
+				{
+					if (a.access != RGAccess::Read && a.texture.id < textures_.size())
+					{
+						lastWriter[a.texture.id] = static_cast<std::uint32_t>(passIndex);
+					}
+				}
 			}
 
-			RenderGraphResources resources(allocatedTextures);
-			rhi::CommandList commandList;
+			// Producers always precede their consumers, so one backwards sweep reaches every live pass.
+			for (std::size_t passIndex = passCount; passIndex-- > 0;)
+			{
+				if (alive[passIndex] != 0)
+				{
+					for (const std::uint32_t producer : producers[passIndex])
+					{
+						alive[producer] = 1;
+					}
+				}
+			}
 
-			std::vector<rhi::FrameBufferHandle> transientFramebuffers;
-			transientFramebuffers.reserve(passes_.size());
+			CompiledGraph compiled;
+			compiled.passes.reserve(passCount);
+			compiled.barrierOffsets.reserve(passCount + 1);
+			compiled.textureUsed.assign(textures_.size(), 1);
+			compiled.firstUse.assign(textures_.size(), kNoPass);
+			compiled.lastUse.assign(textures_.size(), kNoPass);
 
-			for (auto& pass : passes_)
+			// A texture nobody declares is kept (its user may simply not have declared it).
+			std::vector<std::uint8_t> declared(textures_.size(), 0);
+			std::vector<std::uint8_t> declaredByLive(textures_.size(), 0);
+			std::vector<std::uint8_t> stateKnown(textures_.size(), 0);
+			std::vector<rhi::TextureState> state(textures_.size(), rhi::TextureState::ShaderRead);
+			for (std::size_t passIndex = 0; passIndex < passCount; ++passIndex)
 			{
-				rhi::FrameBufferHandle frameBuffer{};
-				rhi::Extent2D passExtent{ 0, 0 };
-
-				if (pass.attachments.useSwapChainBackbuffer)
+				for (const RGTextureAccess& a : accesses[passIndex])
 				{
-					frameBuffer = swapChain.GetCurrentBackBuffer();
-					passExtent = swapChain.GetDesc().extent;
+					if (a.texture.id < textures_.size())
+					{
+						declared[a.texture.id] = 1;
+						declaredByLive[a.texture.id] |= alive[passIndex];
+					}
 				}
-				else
+				if (alive[passIndex] == 0)
 				{
-					std::vector<rhi::TextureHandle> colors;
-					colors.reserve(pass.attachments.colors.size());
+					++compiled.culledPassCount;
+					continue;
+				}
+
+				const std::uint32_t compiledIndex = static_cast<std::uint32_t>(compiled.passes.size());
+				compiled.passes.push_back(static_cast<std::uint32_t>(passIndex));
+				compiled.barrierOffsets.push_back(static_cast<std::uint32_t>(compiled.barriers.size()));
+				for (const RGTextureAccess& a : accesses[passIndex])
+				{
+					if (a.texture.id < textures_.size())
+					{
+						std::uint32_t& first = compiled.firstUse[a.texture.id];
+						first = std::min(first, compiledIndex);
+						compiled.lastUse[a.texture.id] = compiledIndex;
+					}
 
-					for (const auto& c : pass.attachments.colors)
+					const std::optional<rhi::TextureState> required = RequiredState(a.usage);
+					if (!required || a.texture.id >= textures_.size())
+					{
+						continue;
+					}
+					if (stateKnown[a.texture.id] != 0 && state[a.texture.id] == *required)
 					{
-						colors.push_back(resources.GetTexture(c));
+						continue;
 					}
+					stateKnown[a.texture.id] = 1;
+					state[a.texture.id] = *required;
+					compiled.barriers.push_back(RGBarrier{ a.texture, *required });
+				}
+			}
+			compiled.barrierOffsets.push_back(static_cast<std::uint32_t>(compiled.barriers.size()));
+
+			for (std::size_t textureIndex = 0; textureIndex < textures_.size(); ++textureIndex)
+			{
+				if (declared[textureIndex] != 0 && declaredByLive[textureIndex] == 0)
+				{
+					compiled.textureUsed[textureIndex] = 0;
+				}
+				else if (declared[textureIndex] == 0 && !compiled.passes.empty())
+				{
+					compiled.firstUse[textureIndex] = 0;
+					compiled.lastUse[textureIndex] = static_cast<std::uint32_t>(compiled.passes.size() - 1);
+				}
+			}
+
+			compiled.asyncSegment.assign(compiled.passes.size(), kNoPass);
+			compiled.waitForSegment.assign(compiled.passes.size(), kNoPass);
+			if (asyncCompute)
+			{
+				// Imported textures are compared by handle: the same texture may be imported more than once.
+				struct ResourceUse
+				{
+					std::uint64_t key{ 0 };
+					bool writes{ false };
+				};
+				auto UsesOf = [&](std::uint32_t passIndex)
+					{
+						std::vector<ResourceUse> uses;
+						for (const RGTextureAccess& a : accesses[passIndex])
+						{
+							if (a.texture.id < textures_.size())
+							{
+								const rhi::TextureHandle external = textures_[a.texture.id].externalTexture;
+								const std::uint64_t key = external ? ((1ull << 32) | external.id) : a.texture.id;
+								uses.push_back(ResourceUse{ key, a.access != RGAccess::Read });
+							}
+						}
+						for (const RGBufferAccess& a : passes_[passIndex].attachments.buffers)
+						{
+							uses.push_back(ResourceUse{ (2ull << 32) | a.buffer.id, a.access != RGAccess::Read });
+						}
+						return uses;
+					};
 
-					const auto depth = pass.attachments.depth ? resources.GetTexture(*pass.attachments.depth) : rhi::TextureHandle();
+				std::vector<std::vector<ResourceUse>> segmentUses;
+				std::uint32_t firstUnjoined = 0;
+				for (std::uint32_t compiledIndex = 0; compiledIndex < compiled.passes.size(); ++compiledIndex)
+				{
+					const std::uint32_t passIndex = compiled.passes[compiledIndex];
+					const PassAttachments& att = passes_[passIndex].attachments;
+					std::vector<ResourceUse> uses = UsesOf(passIndex);
+					if (att.asyncCompute && att.computeOnly)
+					{
+						const bool needsBarriers = compiled.barrierOffsets[compiledIndex] != compiled.barrierOffsets[compiledIndex + 1];
+						if (compiledIndex == 0 || compiled.asyncSegment[compiledIndex - 1] == kNoPass || needsBarriers)
+						{
+							segmentUses.emplace_back();
+						}
+						compiled.asyncSegment[compiledIndex] = static_cast<std::uint32_t>(segmentUses.size() - 1);
+						segmentUses.back().insert(segmentUses.back().end(), uses.begin(), uses.end());
+						continue;
+					}
 
-					if (!pass.attachments.colors.empty())
+					// Waiting for a segment covers every segment before it (the compute queue runs them in order).
+					for (std::uint32_t segment = firstUnjoined; segment < segmentUses.size(); ++segment)
 					{
-						passExtent = textures_[pass.attachments.colors.front().id].extent;
+						const bool conflicts = segmentUses[segment].empty() || std::ranges::any_of(uses, [&](const ResourceUse& use)
+							{
+								return std::ranges::any_of(segmentUses[segment], [&](const ResourceUse& segmentUse)
+									{
+										return segmentUse.key == use.key && (segmentUse.writes || use.writes);
+									});
+							});
+						if (conflicts)
+						{
+							compiled.waitForSegment[compiledIndex] = segment;
+						}
 					}
-					else if (pass.attachments.depth)
+					if (compiled.waitForSegment[compiledIndex] != kNoPass)
 					{
-						passExtent = textures_[pass.attachments.depth->id].extent;
+						firstUnjoined = compiled.waitForSegment[compiledIndex] + 1;
 					}
+				}
+				compiled.asyncSegmentCount = static_cast<std::uint32_t>(segmentUses.size());
 
-					// Cubemap rendering is only supported for a single color attachment.
-					if (pass.attachments.colorCubeAllFaces && colors.size() == 1 && colors[0].id != 0)
+				// The conflict check above compares graph ids, but the pool may alias two transient textures onto
+				// one physical texture. An async segment keeps running until the graphics queue joins it, so its
+				// textures stay alive up to the joining pass (the end of the graph when nothing joins it).
+				const std::uint32_t lastPass = static_cast<std::uint32_t>(compiled.passes.size() - 1);
+				std::vector<std::uint32_t> joinedAt(segmentUses.size(), lastPass);
+				std::uint32_t joined = 0;
+				for (std::uint32_t compiledIndex = 0; compiledIndex < compiled.passes.size(); ++compiledIndex)
+				{
+					const std::uint32_t segment = compiled.waitForSegment[compiledIndex];
+					for (; segment != kNoPass && joined <= segment; ++joined)
 					{
-						frameBuffer = device.CreateFramebufferCube(colors[0], depth);
+						joinedAt[joined] = compiledIndex;
 					}
-					else if (pass.attachments.colorCubeFace && colors.size() == 1 && colors[0].id != 0)
+				}
+				for (std::uint32_t compiledIndex = 0; compiledIndex < compiled.passes.size(); ++compiledIndex)
+				{
+					const std::uint32_t segment = compiled.asyncSegment[compiledIndex];
+					if (segment == kNoPass)
 					{
-						frameBuffer = device.CreateFramebufferCubeFace(colors[0], *pass.attachments.colorCubeFace, depth);
+						continue;
 					}
-					else
+					for (const RGTextureAccess& a : accesses[compiled.passes[compiledIndex]])
 					{
-						frameBuffer = device.CreateFramebufferMRT(colors, depth);
+						if (a.texture.id < textures_.size() && compiled.textureUsed[a.texture.id] != 0)
+						{
+							std::uint32_t& last = compiled.lastUse[a.texture.id];
+							last = std::max(last, joinedAt[segment]);
+						}
 					}
-					transientFramebuffers.push_back(frameBuffer);
 				}
+			}
+			return compiled;
+		}
 
-				rhi::BeginPassDesc begin{};
-				begin.frameBuffer = frameBuffer;
-				begin.extent = passExtent;
+		// One-shot execution: transient textures and framebuffers are created for this graph and destroyed after it.
+		void Execute(rhi::IRHIDevice& device, rhi::IRHISwapChain& swapChain, rendern::RendererFrameStats* stats = nullptr)
+		{
+			TransientResourcePool pool;
+			Execute(device, swapChain, pool, stats);
+			pool.Clear(device);
+		}
+
+		// With `stats`, fills its passes, the pass totals and the graph/transient counters (the rest of
+		// the frame stats are left alone).
+		void Execute(rhi::IRHIDevice& device, rhi::IRHISwapChain& swapChain, TransientResourcePool& pool, rendern::RendererFrameStats* stats = nullptr)
+		{
+			profiling::ScopedZone executeZone{ "RenderGraph::Execute" };
+			const CompiledGraph compiled = Compile(device.SupportsAsyncCompute());
+			pool.BeginFrame();
+			const std::uint64_t texturesCreatedBefore = pool.CreatedTextureCount();
+			const std::uint64_t framebuffersCreatedBefore = pool.CreatedFramebufferCount();
+			std::uint32_t transientTextures = 0;
+
+			// Walk the lifetimes in pass order: a texture takes a pooled texture at its first pass and hands it
+			// back after its last one, so a later texture with the same desc can alias it.
+			std::vector<rhi::TextureHandle> allocatedTextures(textures_.size());
+			std::vector<std::vector<std::uint32_t>> startAt(compiled.passes.size());
+			std::vector<std::vector<std::uint32_t>> endAt(compiled.passes.size());
+			for (std::uint32_t textureIndex = 0; textureIndex < textures_.size(); ++textureIndex)
+			{
+				const auto& texDesc = textures_[textureIndex];
+				if (texDesc.externalTexture)
+				{
+					allocatedTextures[textureIndex] = texDesc.externalTexture;
+					continue;
+				}
+				if (compiled.textureUsed[textureIndex] == 0 || compiled.firstUse[textureIndex] == kNoPass)
+				{
+					continue;
+				}
+				startAt[compiled.firstUse[textureIndex]].push_back(textureIndex);
+				endAt[compiled.lastUse[textureIndex]].push_back(textureIndex);
+			}
+			for (std::size_t compiledIndex = 0; compiledIndex < compiled.passes.size(); ++compiledIndex)
+			{
+				for (const std::uint32_t textureIndex : startAt[compiledIndex])
+				{
+					const auto& texDesc = textures_[textureIndex];
+					allocatedTextures[textureIndex] = pool.AcquireTexture(device, texDesc.extent, texDesc.format, texDesc.type == TextureType::Cube);
+					++transientTextures;
+				}
+				for (const std::uint32_t textureIndex : endAt[compiledIndex])
+				{
+					pool.ReleaseTexture(allocatedTextures[textureIndex]);
+				}
+			}
+
+			RenderGraphResources resources(allocatedTextures);
+
+			// Framebuffers and extents are resolved up front so recording only touches the pass's own list.
+			std::vector<rhi::BeginPassDesc> begins(compiled.passes.size());
+			for (std::size_t compiledIndex = 0; compiledIndex < compiled.passes.size(); ++compiledIndex)
+			{
+				const auto& pass = passes_[compiled.passes[compiledIndex]];
+				rhi::BeginPassDesc& begin = begins[compiledIndex];
 				begin.clearDesc = pass.attachments.clearDesc;
-				begin.swapChain = pass.attachments.useSwapChainBackbuffer ? &swapChain : nullptr;
 				begin.bindDepthStencil = pass.attachments.bindDepthStencil;
 
-				commandList.BeginPass(begin);
+				if (pass.attachments.computeOnly || pass.attachments.useSwapChainBackbuffer)
+				{
+					begin.frameBuffer = pass.attachments.computeOnly ? rhi::FrameBufferHandle{} : swapChain.GetCurrentBackBuffer();
+					begin.extent = swapChain.GetDesc().extent;
+					begin.swapChain = pass.attachments.computeOnly ? nullptr : &swapChain;
+					continue;
+				}
+
+				std::vector<rhi::TextureHandle> colors;
+				colors.reserve(pass.attachments.colors.size());
+
+				for (const auto& c : pass.attachments.colors)
+				{
+					colors.push_back(resources.GetTexture(c));
+				}
 
-				PassContext ctx{ device, swapChain, commandList, resources, passExtent };
-				pass.execute(ctx);
+				const auto depth = pass.attachments.depth ? resources.GetTexture(*pass.attachments.depth) : rhi::TextureHandle();
 
-				commandList.EndPass();
+				if (!pass.attachments.colors.empty())
+				{
+					begin.extent = textures_[pass.attachments.colors.front().id].extent;
+				}
+				else if (pass.attachments.depth)
+				{
+					begin.extent = textures_[pass.attachments.depth->id].extent;
+				}
+
+				// Cubemap rendering is only supported for a single color attachment.
+				const bool singleColor = colors.size() == 1 && colors[0].id != 0;
+				const bool cubeAllFaces = pass.attachments.colorCubeAllFaces && singleColor;
+				const int cubeFace = (!cubeAllFaces && pass.attachments.colorCubeFace && singleColor)
+					? static_cast<int>(*pass.attachments.colorCubeFace)
+					: -1;
+				begin.frameBuffer = pool.AcquireFramebuffer(device, colors, depth, cubeFace, cubeAllFaces);
+			}
+
+			// One GPU timestamp zone per pass, named after it, for the profiler.
+			const bool timestampZones = device.SupportsTimestampQueries();
+			auto RecordPass = [&](std::size_t compiledIndex, rhi::CommandList& commandList)
+				{
+					auto& pass = passes_[compiled.passes[compiledIndex]];
+					profiling::ScopedZone zone{ profiling::Profiler::Get().IsEnabled() ? profiling::InternZoneName(pass.name) : nullptr };
+
+					if (compiled.waitForSegment[compiledIndex] != kNoPass)
+					{
+						commandList.WaitAsyncCompute(compiled.waitForSegment[compiledIndex]);
+					}
+
+					// Async passes overlap graphics work, so a GPU zone around one would time the queue, not the pass.
+					const std::uint32_t segment = compiled.asyncSegment[compiledIndex];
+					const bool timed = timestampZones && segment == kNoPass;
+					if (timed)
+					{
+						commandList.BeginTimestampZone(pass.name);
+					}
+
+					// All transitions of the pass in one batch, ahead of BeginPass.
+					std::vector<rhi::TextureBarrier> barriers;
+					for (std::uint32_t b = compiled.barrierOffsets[compiledIndex]; b < compiled.barrierOffsets[compiledIndex + 1]; ++b)
+					{
+						const RGBarrier& barrier = compiled.barriers[b];
+						if (const rhi::TextureHandle texture = resources.GetTexture(barrier.texture))
+						{
+							barriers.push_back(rhi::TextureBarrier{ texture, barrier.state });
+						}
+					}
+					if (!barriers.empty())
+					{
+						commandList.TextureBarriers(barriers);
+					}
+
+					// Async passes are compute-only; their barriers above stay on the graphics queue.
+					if (segment != kNoPass && (compiledIndex == 0 || compiled.asyncSegment[compiledIndex - 1] != segment))
+					{
+						commandList.BeginAsyncCompute();
+					}
+
+					PassContext ctx{ device, swapChain, commandList, resources, begins[compiledIndex].extent };
+					if (pass.attachments.computeOnly)
+					{
+						pass.execute(ctx);
+						if (segment != kNoPass && (compiledIndex + 1 == compiled.passes.size() || compiled.asyncSegment[compiledIndex + 1] != segment))
+						{
+							commandList.EndAsyncCompute(segment);
+						}
+					}
+					else
+					{
+						commandList.BeginPass(begins[compiledIndex]);
+						pass.execute(ctx);
+						commandList.EndPass();
+					}
+
+					if (timed)
+					{
+						commandList.EndTimestampZone();
+					}
+				};
+
+			rhi::CommandList commandList;
+			std::vector<rhi::CommandList> parallelLists;
+			// [first, last) command of each pass in commandList, for the stats.
+			std::vector<std::pair<std::size_t, std::size_t>> commandRanges(stats ? compiled.passes.size() : 0);
+			std::size_t compiledIndex = 0;
+			while (compiledIndex < compiled.passes.size())
+			{
+				// A run of consecutive parallelRecord passes is recorded on the scheduler, one list per pass,
+				// and spliced back in graph order, so the submitted stream is the same as a serial recording.
+				std::size_t runEnd = compiledIndex;
+				while (scheduler_ && runEnd < compiled.passes.size() && passes_[compiled.passes[runEnd]].attachments.parallelRecord)
+				{
+					++runEnd;
+				}
+				if (runEnd - compiledIndex < 2)
+				{
+					const std::size_t first = commandList.Size();
+					RecordPass(compiledIndex, commandList);
+					if (stats)
+					{
+						commandRanges[compiledIndex] = { first, commandList.Size() };
+					}
+					++compiledIndex;
+					continue;
+				}
+
+				const std::size_t runBegin = compiledIndex;
+				parallelLists.clear();
+				parallelLists.resize(runEnd - runBegin);
+				jobs::ParallelFor(scheduler_, runEnd - runBegin, 1, [&](std::size_t begin, std::size_t end)
+					{
+						for (std::size_t i = begin; i < end; ++i)
+						{
+							RecordPass(runBegin + i, parallelLists[i]);
+						}
+					});
+				for (std::size_t i = 0; i < parallelLists.size(); ++i)
+				{
+					const std::size_t first = commandList.Size();
+					commandList.Append(std::move(parallelLists[i]));
+					if (stats)
+					{
+						commandRanges[runBegin + i] = { first, commandList.Size() };
+					}
+				}
+				compiledIndex = runEnd;
+			}
+
+			if (stats)
+			{
+				CountPassCommands(compiled, commandList, commandRanges, *stats);
+				stats->graphPassesCulled = compiled.culledPassCount;
+				stats->transientTextures = transientTextures;
+				stats->transientTexturesCreated = static_cast<std::uint32_t>(pool.CreatedTextureCount() - texturesCreatedBefore);
+				stats->transientFramebuffersCreated = static_cast<std::uint32_t>(pool.CreatedFramebufferCount() - framebuffersCreatedBefore);
 			}
 
 			device.SubmitCommandList(std::move(commandList));
+			pool.EndFrame(device);
+		}
+	private:
+		// One walk over the frame's commands, attributing each to the pass whose range holds it.
+		void CountPassCommands(
+			const CompiledGraph& compiled,
+			const rhi::CommandList& commandList,
+			std::span<const std::pair<std::size_t, std::size_t>> commandRanges,
+			rendern::RendererFrameStats& stats) const
+		{
+			// Reuse the previous frame's entries so steady frames keep their name strings.
+			stats.passes.resize(compiled.passes.size());
+			for (std::size_t compiledIndex = 0; compiledIndex < compiled.passes.size(); ++compiledIndex)
+			{
+				rendern::RendererPassStats& pass = stats.passes[compiledIndex];
+				pass.name.assign(passes_[compiled.passes[compiledIndex]].name);
+				pass.drawCalls = 0;
+				pass.indirectDraws = 0;
+				pass.dispatches = 0;
+				pass.instances = 0;
+				pass.triangles = 0;
+				pass.pipelineBinds = 0;
+				pass.barriers = 0;
+			}
+
+			std::size_t pass = 0;
+			std::size_t commandIndex = 0;
+			rhi::PrimitiveTopology topology = rhi::PrimitiveTopology::TriangleList;
+			for (const rhi::CommandRecord record : commandList)
+			{
+				while (pass < commandRanges.size() && commandIndex >= commandRanges[pass].second)
+				{
+					++pass;
+				}
+				++commandIndex;
+				if (pass == commandRanges.size())
+				{
+					break;
+				}
+				rendern::RendererPassStats& out = stats.passes[pass];
 
-			for (auto frameBuffer : transientFramebuffers)
+				if (const auto* draw = record.GetIf<rhi::CommandDrawIndexed>())
+				{
+					++out.drawCalls;
+					out.instances += draw->instanceCount;
+					if (topology == rhi::PrimitiveTopology::TriangleList)
+					{
+						out.triangles += std::uint64_t{ draw->indexCount / 3u } * draw->instanceCount;
+					}
+				}
+				else if (const auto* draw = record.GetIf<rhi::CommandDraw>())
+				{
+					++out.drawCalls;
+					out.instances += draw->instanceCount;
+					if (topology == rhi::PrimitiveTopology::TriangleList)
+					{
+						out.triangles += std::uint64_t{ draw->vertexCount / 3u } * draw->instanceCount;
+					}
+				}
+				else if (record.Is<rhi::CommandDrawIndexedIndirect>())
+				{
+					++out.drawCalls;
+					++out.indirectDraws;
+				}
+				else if (record.Is<rhi::CommandDispatch>() || record.Is<rhi::CommandGenerateMips>())
+				{
+					++out.dispatches;
+				}
+				else if (record.Is<rhi::CommandDispatchMesh>())
+				{
+					++out.drawCalls;
+				}
+				else if (record.Is<rhi::CommandBindPipeline>())
+				{
+					++out.pipelineBinds;
+				}
+				else if (const auto* barriers = record.GetIf<rhi::CommandTextureBarriers>())
+				{
+					out.barriers += static_cast<std::uint32_t>(barriers->barriers.size());
+				}
+				else if (const auto* setTopology = record.GetIf<rhi::CommandSetPrimitiveTopology>())
+				{
+					topology = setTopology->topology;
+				}
+			}
+
+			stats.drawCalls = 0;
+			stats.indirectDraws = 0;
+			stats.dispatches = 0;
+			stats.instances = 0;
+			stats.triangles = 0;
+			stats.pipelineBinds = 0;
+			stats.barriers = 0;
+			for (const rendern::RendererPassStats& passStats : stats.passes)
 			{
-				device.DestroyFramebuffer(frameBuffer);
+				stats.drawCalls += passStats.drawCalls;
+				stats.indirectDraws += passStats.indirectDraws;
+				stats.dispatches += passStats.dispatches;
+				stats.instances += passStats.instances;
+				stats.triangles += passStats.triangles;
+				stats.pipelineBinds += passStats.pipelineBinds;
+				stats.barriers += passStats.barriers;
 			}
-			for (std::size_t i = 0; i < allocatedTextures.size(); ++i)
+		}
+
+		static std::vector<RGTextureAccess> CollectAccesses(const PassAttachments& att)
+		{
+			std::vector<RGTextureAccess> accesses;
+			accesses.reserve(att.colors.size() + 1 + att.textures.size());
+			if (!att.useSwapChainBackbuffer && !att.computeOnly)
 			{
-				if (owned[i] != 0)
+				// A clear limited to a rect keeps the rest of the previous contents.
+				const bool clearsAll = !att.clearDesc.rect;
+				const RGAccess colorAccess = (att.clearDesc.clearColor && clearsAll) ? RGAccess::Write : RGAccess::ReadWrite;
+				for (const RGTexture& color : att.colors)
+				{
+					accesses.push_back(RGTextureAccess{ color, colorAccess, ResourceUsage::RenderTarget });
+				}
+				if (att.depth && att.bindDepthStencil)
 				{
-					device.DestroyTexture(allocatedTextures[i]);
+					const RGAccess depthAccess = (att.clearDesc.clearDepth && clearsAll) ? RGAccess::Write : RGAccess::ReadWrite;
+					accesses.push_back(RGTextureAccess{ *att.depth, depthAccess, ResourceUsage::DepthStencil });
+				}
+				else if (att.depth)
+				{
+					// Only part of the framebuffer (and its extent), not bound: keep its contents alive.
+					accesses.push_back(RGTextureAccess{ *att.depth, RGAccess::Read, ResourceUsage::Unknown });
 				}
 			}
+			accesses.insert(accesses.end(), att.textures.begin(), att.textures.end());
+			return accesses;
 		}
-	private:
-		std::vector<PassNode> passes_;
-		std::vector<RGTextureDesc> textures_;
+
+		static std::optional<rhi::TextureState> RequiredState(ResourceUsage usage) noexcept
+		{
+			switch (usage)
+			{
+			case ResourceUsage::RenderTarget: return rhi::TextureState::RenderTarget;
+			case ResourceUsage::DepthStencil: return rhi::TextureState::DepthWrite;
+			case ResourceUsage::Sampled: return rhi::TextureState::ShaderRead;
+			case ResourceUsage::Storage: return rhi::TextureState::UnorderedAccess;
+			case ResourceUsage::CopySource: return rhi::TextureState::CopySource;
+			case ResourceUsage::CopyDest: return rhi::TextureState::CopyDest;
+			default: return std::nullopt;
+			}
+		}
+
+		// Graph declarations are charged to the renderer's memory budget.
+		std::pmr::vector<PassNode> passes_{ memory::TrackingResource(memory::MemoryTag::Renderer) };
+		std::pmr::vector<RGTextureDesc> textures_{ memory::TrackingResource(memory::MemoryTag::Renderer) };
+		jobs::Scheduler* scheduler_{ nullptr };
 	};
 }
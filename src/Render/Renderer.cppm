@@ -1,6 +1,8 @@
 module;
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <utility>
 
 export module core:render_renderer;
@@ -10,7 +12,9 @@ export module core:render_renderer;
 export import :renderer_settings;
 
 import :rhi;
+import :render_gpu_memory;
 import :scene;
+import :job_system;
 
 #if defined(CORE_USE_GL)
 import :renderer_mesh_gl;
@@ -33,6 +37,22 @@ namespace rendern
             virtual void RenderFrame(rhi::IRHISwapChain& swapChain, const Scene& scene, const void* imguiDrawData) = 0;
             virtual void SetSettings(const RendererSettings& settings) = 0;
             virtual void Shutdown() = 0;
+            virtual const RendererFrameStats& GetFrameStats() const = 0;
+
+            // Optional workers for render-side fan-out; backends that do not use them ignore it.
+            virtual void SetJobScheduler(jobs::Scheduler*) {}
+
+            // Sub-allocator for meshes the renderer uploads itself; backends without such meshes ignore it.
+            virtual void SetMeshAllocator(renderer::IGPUMemoryAllocator*) {}
+
+            // Residency feedback: backends that mark used meshes and report drawn materials.
+            virtual bool SupportsResidencyFeedback() const { return false; }
+            virtual std::span<const MaterialHandle> GetDrawnMaterials() const { return {}; }
+
+            // Object-ID picking: backends that draw an ID buffer for requested rects and read it back.
+            virtual bool SupportsObjectIdPicking() const { return false; }
+            virtual std::uint64_t RequestObjectIdPick(const ObjectIdPickRequest&) { return 0; }
+            virtual bool TakeObjectIdPick(ObjectIdPickResult&) { return false; }
         };
 
         class NullRendererImpl final : public IRendererImpl
@@ -44,6 +64,13 @@ namespace rendern
             }
             void SetSettings(const RendererSettings&) override {}
             void Shutdown() override {}
+            const RendererFrameStats& GetFrameStats() const override
+            {
+                return stats_;
+            }
+
+        private:
+            RendererFrameStats stats_{};
         };
 
         #if defined(CORE_USE_GL)
@@ -68,6 +95,11 @@ namespace rendern
                 impl_.Shutdown();
             }
 
+            const RendererFrameStats& GetFrameStats() const override
+            {
+                return impl_.GetFrameStats();
+            }
+
         private:
             GLMeshRenderer impl_;
         };
@@ -77,8 +109,8 @@ namespace rendern
         class DX12RendererImpl final : public IRendererImpl
         {
         public:
-            DX12RendererImpl(rhi::IRHIDevice& device, RendererSettings settings)
-                : impl_(device, std::move(settings))
+            DX12RendererImpl(rhi::IRHIDevice& device, RendererSettings settings, jobs::Scheduler* scheduler)
+                : impl_(device, std::move(settings), scheduler)
             {}
 
             void RenderFrame(rhi::IRHISwapChain& swapChain, const Scene& scene, const void* imguiDrawData) override
@@ -96,6 +128,46 @@ namespace rendern
                 impl_.Shutdown();
             }
 
+            const RendererFrameStats& GetFrameStats() const override
+            {
+                return impl_.GetFrameStats();
+            }
+
+            void SetJobScheduler(jobs::Scheduler* scheduler) override
+            {
+                impl_.SetJobScheduler(scheduler);
+            }
+
+            void SetMeshAllocator(renderer::IGPUMemoryAllocator* allocator) override
+            {
+                impl_.SetMeshAllocator(allocator);
+            }
+
+            bool SupportsResidencyFeedback() const override
+            {
+                return true;
+            }
+
+            std::span<const MaterialHandle> GetDrawnMaterials() const override
+            {
+                return impl_.GetDrawnMaterials();
+            }
+
+            bool SupportsObjectIdPicking() const override
+            {
+                return impl_.SupportsObjectIdPicking();
+            }
+
+            std::uint64_t RequestObjectIdPick(const ObjectIdPickRequest& request) override
+            {
+                return impl_.RequestObjectIdPick(request);
+            }
+
+            bool TakeObjectIdPick(ObjectIdPickResult& out) override
+            {
+                return impl_.TakeObjectIdPick(out);
+            }
+
         private:
             DX12Renderer impl_;
         };
@@ -109,7 +181,8 @@ namespace rendern
     export class Renderer
     {
     public:
-        Renderer(rhi::IRHIDevice& device, RendererSettings settings = {})
+        // `scheduler` (optional) is used from construction on, e.g. to compile startup shaders in parallel.
+        Renderer(rhi::IRHIDevice& device, RendererSettings settings = {}, jobs::Scheduler* scheduler = nullptr)
             : device_(device)
         {
             switch (device_.GetBackend())
@@ -125,7 +198,7 @@ namespace rendern
 
             case rhi::Backend::DirectX12:
 #if defined(CORE_USE_DX12)
-                impl_ = std::make_unique<detail::DX12RendererImpl>(device_, std::move(settings));
+                impl_ = std::make_unique<detail::DX12RendererImpl>(device_, std::move(settings), scheduler);
                 break;
 #else
                 impl_ = std::make_unique<detail::NullRendererImpl>();
@@ -138,6 +211,21 @@ namespace rendern
             }
         }
 
+        // Startup: compiles the shaders the next renderer on `device` will ask for, from any thread.
+        // Optional; constructing the renderer afterwards skips the compiles that finished.
+        static void PrecompileStartupShaders(rhi::IRHIDevice& device, jobs::Scheduler* scheduler)
+        {
+#if defined(CORE_USE_DX12)
+            if (device.GetBackend() == rhi::Backend::DirectX12)
+            {
+                DX12Renderer::PrecompileStartupShaders(device, scheduler);
+            }
+#else
+            (void)device;
+            (void)scheduler;
+#endif
+        }
+
         void RenderFrame(rhi::IRHISwapChain& swapChain, const Scene& scene, const void* imguiDrawData = nullptr)
         {
             impl_->RenderFrame(swapChain, scene, imguiDrawData);
@@ -153,6 +241,54 @@ namespace rendern
             impl_->Shutdown();
         }
 
+        // Counters of the last rendered frame; the reference stays valid for the renderer's lifetime.
+        const RendererFrameStats& GetFrameStats() const
+        {
+            return impl_->GetFrameStats();
+        }
+
+        // The scheduler must outlive the renderer (or be reset to nullptr first).
+        void SetJobScheduler(jobs::Scheduler* scheduler)
+        {
+            impl_->SetJobScheduler(scheduler);
+        }
+
+        // The allocator must outlive the renderer: meshes uploaded through it are freed on Shutdown.
+        void SetMeshAllocator(renderer::IGPUMemoryAllocator* allocator)
+        {
+            impl_->SetMeshAllocator(allocator);
+        }
+
+        // Without feedback nothing is ever marked used, so residency must stay disabled.
+        bool SupportsResidencyFeedback() const
+        {
+            return impl_->SupportsResidencyFeedback();
+        }
+
+        std::span<const MaterialHandle> GetDrawnMaterials() const
+        {
+            return impl_->GetDrawnMaterials();
+        }
+
+        // Object-ID picking. RequestObjectIdPick queues a rect for the next RenderFrame, which then draws the
+        // ID buffer and reads the rect back; TakeObjectIdPick hands out finished results (oldest first) a
+        // frame or two later. Returns the request's id, 0 when unsupported. Not to be called while a
+        // RenderFrame is running on another thread.
+        bool SupportsObjectIdPicking() const
+        {
+            return impl_->SupportsObjectIdPicking();
+        }
+
+        std::uint64_t RequestObjectIdPick(const ObjectIdPickRequest& request)
+        {
+            return impl_->RequestObjectIdPick(request);
+        }
+
+        bool TakeObjectIdPick(ObjectIdPickResult& out)
+        {
+            return impl_->TakeObjectIdPick(out);
+        }
+
     private:
         rhi::IRHIDevice& device_;
         std::unique_ptr<detail::IRendererImpl> impl_;
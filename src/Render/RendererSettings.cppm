@@ -1,8 +1,11 @@
 module;
 
 #include <filesystem>
+#include <cstddef>
 #include <cstdint>
 #include <array>
+#include <string>
+#include <vector>
 
 // Shared, backend-agnostic renderer settings.
 export module core:renderer_settings;
@@ -20,9 +23,83 @@ export namespace rendern
 		float dirShadowDistance{ 200.0f };
 		std::uint32_t dirShadowCascadeCount{ 3 };
 		float dirShadowSplitLambda{ 0.7f };
+		// DX12: test every caster's bounding sphere against each cascade's light-space box, so a cascade only
+		// draws the casters it can see.
+		bool enableCascadeCasterCulling{ true };
+		// DX12: the far cascades (1..) re-render every N frames, taking turns, and otherwise keep their last
+		// tile and matrix. 1 = every cascade every frame. Above 1 the directional atlas skips the static cache.
+		std::uint32_t dirShadowFarCascadeInterval{ 1 };
+		// DX12: layered point shadows only render a caster into the cubemap faces its bounding sphere touches.
+		bool enablePointShadowFaceCulling{ true };
+		// DX12: spot shadows share one square depth atlas. Every shadowed spot light in view gets a tile sized
+		// by its screen coverage, from spotShadowMaxTileSize down to spotShadowMinTileSize (powers of two).
+		// The atlas size caps the spot shadow memory (2048: 16 MB, as much as four 1024 maps).
+		std::uint32_t spotShadowAtlasSize{ 2048 };
+		std::uint32_t spotShadowMaxTileSize{ 1024 };
+		std::uint32_t spotShadowMinTileSize{ 128 };
 		bool enableDepthPrepass{ false };
+		// Forward depth prepass occluders: only items whose bounding sphere spans at least this fraction of the
+		// viewport height go into the prepass; the main pass then keeps writing depth. 0: every opaque item
+		// (the main pass reads depth only).
+		float depthPrepassMinScreenSize{ 0.1f };
 		bool enableDeferred{ false }; // DX12-only (currently): GBuffer + fullscreen resolve
+		// DX12 deferred: three G-buffer targets (12 bytes/pixel instead of 16) - sRGB albedo + env selector,
+		// octahedral normal in RG16, roughness/metalness/AO + emissive scale in RGBA8. Emissive is stored as a
+		// multiple of albedo, so emissive colors that differ from the albedo's hue are approximated.
+		bool compactGBuffer{ false };
+		// DX12 deferred: the scene is rendered at a fraction of the swap chain size, picked each frame from the
+		// measured GPU frame time against dynamicResolutionTargetMs, and upscaled (bicubic + sharpen) on present.
+		// Needs GPU timestamp queries; without them the scale stays where it is.
+		bool enableDynamicResolution{ false };
+		float dynamicResolutionTargetMs{ 16.0f };
+		float dynamicResolutionMinScale{ 0.5f };
+		float dynamicResolutionMaxScale{ 1.0f };
+		float dynamicResolutionSharpness{ 0.25f }; // 0 = plain bicubic upscale
 		bool enableFrustumCulling{ true };
+		// DX12: CPU camera / cascade / point face culling walks a BVH over the draw items' bounding spheres
+		// (refit with the moved items) instead of testing every item against every frustum.
+		bool enableBvhCulling{ true };
+		// DX12: draw items use their mesh's simplified levels (MeshLod.cppm), picked from the bounding sphere's
+		// diameter over the viewport height: level 1 below meshLodScreenSize, each further level at half that.
+		// The biases add levels (negative: finer); shadow casters are picked with their own bias.
+		bool enableMeshLods{ true };
+		float meshLodScreenSize{ 0.3f };
+		int meshLodBias{ 0 };
+		int shadowMeshLodBias{ 1 };
+		// DX12 forward path: frustum (+ HiZ occlusion with the depth prepass) culling of opaque batches in a compute pass.
+		bool enableGpuCulling{ false };
+		// DX12 with mesh shader support: the deferred G-buffer and directional cascade passes draw meshes with
+		// meshlets (Meshlet.cppm); an amplification shader drops meshlets outside the frustum or, in the G-buffer,
+		// facing away from the camera. Meshes without meshlets keep the vertex-shader path.
+		bool enableMeshShaders{ true };
+		// DX12: emitter particles live in a GPU pool (compute emit/simulate/sort, one indirect draw) instead of
+		// being simulated and sorted on the CPU. Particles added directly to Scene::particles stay on the CPU.
+		bool enableGpuParticles{ true };
+		// DX12: skinned draws are skinned once per frame by a compute pre-pass and drawn from the skinned vertex
+		// cache by every later pass, instead of being re-skinned in each pass's vertex shader.
+		bool enableComputeSkinning{ true };
+		// DX12: draw item transforms stay in a persistent GPU buffer and only the changed ones are uploaded; the
+		// passes' instance lists are index lists expanded by a compute pass instead of uploaded matrices.
+		bool enableGpuInstanceTransforms{ true };
+		// DX12: split the per-draw-item work of instance packing across the job system (when the app provides one).
+		bool enableParallelInstancePacking{ true };
+		// DX12: record runs of independent render graph passes (shadow maps, reflection capture faces) on the job system.
+		bool enableParallelPassRecording{ true };
+		// DX12: run the GPU culling passes (HiZ build + cull) on the async compute queue, overlapping shadow
+		// and reflection rendering (when the device has one).
+		bool enableAsyncCompute{ true };
+		// DX12: watch the shader sources and swap edited shaders (and only the PSOs using them) in at the next frame.
+		bool enableShaderHotReload{ true };
+		// DX12: bin point/spot lights into camera froxels so the main lighting passes only walk the lights
+		// touching each pixel. Off: every pixel loops the first 64 lights.
+		bool enableClusteredLighting{ true };
+		// DX12: keep the static casters of the directional and spot shadow maps in persistent depth, re-rendered
+		// only when the light view or the static geometry changes; each frame copies it and adds the dynamic casters.
+		bool enableShadowCaching{ true };
+		// DX12: transparent surfaces use weighted blended order-independent transparency (accumulation +
+		// coverage targets, composited over the scene) instead of a back-to-front sort, so they are batched
+		// and instanced like opaque draws. Approximate where many layers of similar depth overlap.
+		bool enableWeightedBlendedOit{ false };
 		bool debugPrintDrawCalls{ false }; // prints MainPass draw-call count (DX12) once per ~60 frames
 
 		// SSAO (DX12 deferred path). Applied as a multiplicative factor to AO/ambient.
@@ -59,6 +136,8 @@ export namespace rendern
 		// Reflection capture (cubemap). Currently used by DX12 backend.
 		bool enableReflectionCapture{ true };
 		bool reflectionCaptureUpdateEveryFrame{ true };
+		// DX12: cube faces recaptured per frame across all probes, most important first (0 = no limit).
+		std::uint32_t reflectionCaptureFaceBudget{ 6 };
 		bool reflectionCaptureFollowSelectedObject{ false };
 		std::uint32_t reflectionCaptureResolution{ 1024 }; // cube face size (px)
 		float reflectionCaptureNearZ{ 0.05f };
@@ -71,6 +150,8 @@ export namespace rendern
 		// Planar reflections (DX12 MVP): mark mirror materials with MaterialPerm::PlanarMirror.
 		bool enablePlanarReflections{ true };
 		std::uint32_t planarReflectionMaxMirrors{ 5 };
+		// Resolution of the reflected scene relative to the screen (0.25 .. 1); it is upsampled when composited.
+		float planarReflectionRenderScale{ 1.0f };
 
 		bool drawLightGizmos{ false };
 		bool debugDrawDepthTest{ true };
@@ -106,4 +187,94 @@ export namespace rendern
 		float reflectionCaptureFovPadDeg{ 0.0f };
 		std::filesystem::path modelPath = std::filesystem::path("models") / "cube.obj";
 	};
+
+	// Work one render graph pass recorded, counted from its commands. Indirect draws don't know their
+	// instance and triangle counts; triangles only count triangle-list draws.
+	struct RendererPassStats
+	{
+		std::string name;
+		std::uint32_t drawCalls{ 0 };       // direct and indirect
+		std::uint32_t indirectDraws{ 0 };
+		std::uint32_t dispatches{ 0 };
+		std::uint64_t instances{ 0 };
+		std::uint64_t triangles{ 0 };
+		std::uint32_t pipelineBinds{ 0 };
+		std::uint32_t barriers{ 0 };        // textures in TextureBarriers batches (graph and pass barriers)
+	};
+
+	// Counters of the last rendered frame (Renderer::GetFrameStats). The pass totals are the sums over
+	// `passes`; work recorded outside the render graph (ImGui, immediate uploads) is not included.
+	struct RendererFrameStats
+	{
+		std::uint64_t frameIndex{ 0 };
+		std::vector<RendererPassStats> passes;
+
+		std::uint32_t drawCalls{ 0 };
+		std::uint32_t indirectDraws{ 0 };
+		std::uint32_t dispatches{ 0 };
+		std::uint64_t instances{ 0 };
+		std::uint64_t triangles{ 0 };
+		std::uint32_t pipelineBinds{ 0 };
+		std::uint32_t barriers{ 0 };
+
+		std::uint32_t graphPassesCulled{ 0 };           // passes the render graph dropped as unused
+		std::uint32_t transientTextures{ 0 };           // transient textures placed in the pool this frame
+		std::uint32_t transientTexturesCreated{ 0 };    // of those, new allocations (0 once the pool is warm)
+		std::uint32_t transientFramebuffersCreated{ 0 };
+
+		std::uint32_t bufferUpdates{ 0 };               // IRHIDevice::UpdateBuffer calls since the previous frame
+		std::uint64_t bufferUploadBytes{ 0 };
+		std::uint32_t descriptorAllocations{ 0 };
+
+		std::uint32_t cullTested{ 0 };                  // draw items tested against the camera frustum
+		std::uint32_t cullVisible{ 0 };                 // of those, kept for the main view
+
+		float renderScale{ 1.0f };                      // dynamic resolution: scene size / swap chain size
+		float gpuFrameMs{ 0.0f };                       // GPU time of the last finished frame fed to the scale
+
+		float inputToPresentMs{ 0.0f };                 // Scene::inputSampleTime to the return of Present (CPU side)
+	};
+
+	// Object-ID picking (Renderer::RequestObjectIdPick). Every pixel of the ID buffer holds kObjectIdNone or
+	// the ID of the closest opaque or transparent draw item / skinned draw item covering it.
+	constexpr std::uint32_t kObjectIdNone = 0u;
+	constexpr std::uint32_t kObjectIdSkinnedBit = 0x80000000u;
+
+	constexpr std::uint32_t ObjectIdForDrawItem(std::size_t drawItemIndex) noexcept
+	{
+		return static_cast<std::uint32_t>(drawItemIndex + 1u) & ~kObjectIdSkinnedBit;
+	}
+
+	constexpr std::uint32_t ObjectIdForSkinnedDrawItem(std::size_t skinnedDrawIndex) noexcept
+	{
+		return (static_cast<std::uint32_t>(skinnedDrawIndex + 1u) & ~kObjectIdSkinnedBit) | kObjectIdSkinnedBit;
+	}
+
+	// Index into Scene::drawItems (or Scene::skinnedDrawItems when `skinned` is set) behind an object ID, -1 for none.
+	constexpr int DrawIndexFromObjectId(std::uint32_t objectId, bool& skinned) noexcept
+	{
+		skinned = (objectId & kObjectIdSkinnedBit) != 0u;
+		const std::uint32_t index = objectId & ~kObjectIdSkinnedBit;
+		return (index == 0u) ? -1 : static_cast<int>(index - 1u);
+	}
+
+	// A swap chain pixel rect to read back from the ID buffer (a single pixel for a click, larger for a marquee).
+	struct ObjectIdPickRequest
+	{
+		std::uint32_t x{ 0 };
+		std::uint32_t y{ 0 };
+		std::uint32_t width{ 1 };
+		std::uint32_t height{ 1 };
+	};
+
+	// The IDs under a request's rect (clamped to the swap chain), row-major.
+	struct ObjectIdPickResult
+	{
+		std::uint64_t requestId{ 0 };
+		std::uint32_t x{ 0 };
+		std::uint32_t y{ 0 };
+		std::uint32_t width{ 0 };
+		std::uint32_t height{ 0 };
+		std::vector<std::uint32_t> ids;
+	};
 }
@@ -0,0 +1,228 @@
+module;
+
+#include <cmath>
+
+export module core:camera_path;
+
+import std;
+
+import :scene;
+import :math_utils;
+import :file_system;
+
+export namespace rendern
+{
+    struct CameraPathKey
+    {
+        float timeSeconds{ 0.0f };
+        mathUtils::Vec3 position{ 0.0f, 0.0f, 0.0f };
+        mathUtils::Vec3 target{ 0.0f, 0.0f, -1.0f };
+    };
+
+    // Camera fly-through: position and target follow a Catmull-Rom spline through the keys
+    // (keys sorted by time, the spline is clamped at both ends).
+    //
+    // Text format, one key per line: "time px py pz tx ty tz". Blank lines and lines starting
+    // with '#' are ignored.
+    struct CameraPath
+    {
+        std::vector<CameraPathKey> keys;
+
+        [[nodiscard]] bool Empty() const noexcept { return keys.empty(); }
+        [[nodiscard]] float DurationSeconds() const noexcept { return keys.empty() ? 0.0f : keys.back().timeSeconds; }
+    };
+
+    namespace detail
+    {
+        // Cubic Hermite with Catmull-Rom tangents scaled to non-uniform key spacing.
+        inline mathUtils::Vec3 CatmullRom(
+            const mathUtils::Vec3& p0, const mathUtils::Vec3& p1, const mathUtils::Vec3& p2, const mathUtils::Vec3& p3,
+            float t0, float t1, float t2, float t3, float u) noexcept
+        {
+            const float span = t2 - t1;
+            const mathUtils::Vec3 m1 = (t2 > t0) ? (p2 - p0) * (span / (t2 - t0)) : (p2 - p1);
+            const mathUtils::Vec3 m2 = (t3 > t1) ? (p3 - p1) * (span / (t3 - t1)) : (p2 - p1);
+
+            const float u2 = u * u;
+            const float u3 = u2 * u;
+            return p1 * (2.0f * u3 - 3.0f * u2 + 1.0f)
+                + m1 * (u3 - 2.0f * u2 + u)
+                + p2 * (-2.0f * u3 + 3.0f * u2)
+                + m2 * (u3 - u2);
+        }
+    }
+
+    // Samples the path at timeSeconds (clamped to the first/last key).
+    [[nodiscard]] inline CameraPathKey EvaluateCameraPath(const CameraPath& path, float timeSeconds) noexcept
+    {
+        if (path.keys.empty())
+        {
+            return CameraPathKey{ .timeSeconds = timeSeconds };
+        }
+
+        const std::vector<CameraPathKey>& keys = path.keys;
+        if (keys.size() == 1 || timeSeconds <= keys.front().timeSeconds)
+        {
+            CameraPathKey key = keys.front();
+            key.timeSeconds = timeSeconds;
+            return key;
+        }
+        if (timeSeconds >= keys.back().timeSeconds)
+        {
+            CameraPathKey key = keys.back();
+            key.timeSeconds = timeSeconds;
+            return key;
+        }
+
+        const auto next = std::upper_bound(keys.begin(), keys.end(), timeSeconds,
+            [](float t, const CameraPathKey& key) { return t < key.timeSeconds; });
+        const std::size_t i2 = static_cast<std::size_t>(next - keys.begin());
+        const std::size_t i1 = i2 - 1;
+        const std::size_t i0 = (i1 > 0) ? i1 - 1 : i1;
+        const std::size_t i3 = (i2 + 1 < keys.size()) ? i2 + 1 : i2;
+
+        const CameraPathKey& k0 = keys[i0];
+        const CameraPathKey& k1 = keys[i1];
+        const CameraPathKey& k2 = keys[i2];
+        const CameraPathKey& k3 = keys[i3];
+
+        const float span = k2.timeSeconds - k1.timeSeconds;
+        const float u = (span > 0.0f) ? (timeSeconds - k1.timeSeconds) / span : 0.0f;
+
+        CameraPathKey out{};
+        out.timeSeconds = timeSeconds;
+        out.position = detail::CatmullRom(k0.position, k1.position, k2.position, k3.position,
+            k0.timeSeconds, k1.timeSeconds, k2.timeSeconds, k3.timeSeconds, u);
+        out.target = detail::CatmullRom(k0.target, k1.target, k2.target, k3.target,
+            k0.timeSeconds, k1.timeSeconds, k2.timeSeconds, k3.timeSeconds, u);
+        return out;
+    }
+
+    inline void ApplyCameraPath(const CameraPath& path, float timeSeconds, Camera& camera) noexcept
+    {
+        if (path.keys.empty())
+        {
+            return;
+        }
+
+        const CameraPathKey key = EvaluateCameraPath(path, timeSeconds);
+        camera.position = key.position;
+        camera.target = key.target;
+    }
+
+    // Closed circle around `center` looking at it; used when no recorded path is given.
+    [[nodiscard]] inline CameraPath MakeOrbitCameraPath(
+        const mathUtils::Vec3& center,
+        float radius,
+        float height,
+        float durationSeconds,
+        std::uint32_t keyCount = 16)
+    {
+        keyCount = std::max(keyCount, 4u);
+
+        CameraPath path{};
+        path.keys.reserve(keyCount + 1);
+        for (std::uint32_t i = 0; i <= keyCount; ++i)
+        {
+            const float a = static_cast<float>(i) / static_cast<float>(keyCount);
+            const float angle = a * 2.0f * std::numbers::pi_v<float>;
+
+            CameraPathKey key{};
+            key.timeSeconds = a * durationSeconds;
+            key.position = center + mathUtils::Vec3(std::sin(angle) * radius, height, std::cos(angle) * radius);
+            key.target = center;
+            path.keys.push_back(key);
+        }
+        return path;
+    }
+
+    // Relative paths are tried against the working directory first, then the asset root.
+    [[nodiscard]] inline CameraPath LoadCameraPath(const std::filesystem::path& pathIn)
+    {
+        std::filesystem::path path = pathIn;
+        if (path.is_relative() && !std::filesystem::exists(path))
+        {
+            path = corefs::ResolveAsset(path);
+        }
+
+        std::ifstream in(path);
+        if (!in)
+        {
+            throw std::runtime_error("CameraPath: can't open " + path.string());
+        }
+
+        CameraPath out{};
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(in, line))
+        {
+            ++lineNumber;
+            const std::size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+            {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            CameraPathKey key{};
+            if (!(fields >> key.timeSeconds
+                >> key.position.x >> key.position.y >> key.position.z
+                >> key.target.x >> key.target.y >> key.target.z))
+            {
+                throw std::runtime_error("CameraPath: bad key at " + path.string() + ":" + std::to_string(lineNumber));
+            }
+            if (!out.keys.empty() && key.timeSeconds < out.keys.back().timeSeconds)
+            {
+                throw std::runtime_error("CameraPath: key times go backwards at " + path.string() + ":" + std::to_string(lineNumber));
+            }
+            out.keys.push_back(key);
+        }
+
+        return out;
+    }
+
+    inline void SaveCameraPath(const std::filesystem::path& path, const CameraPath& cameraPath)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("CameraPath: can't write " + path.string());
+        }
+
+        out << "# time px py pz tx ty tz\n";
+        out << std::setprecision(7);
+        for (const CameraPathKey& key : cameraPath.keys)
+        {
+            out << key.timeSeconds << ' '
+                << key.position.x << ' ' << key.position.y << ' ' << key.position.z << ' '
+                << key.target.x << ' ' << key.target.y << ' ' << key.target.z << '\n';
+        }
+    }
+
+    // Samples a live camera into a CameraPath, at most one key per interval.
+    class CameraPathRecorder
+    {
+    public:
+        explicit CameraPathRecorder(float intervalSeconds = 0.25f) noexcept
+            : intervalSeconds_(intervalSeconds)
+        {
+        }
+
+        void Record(float deltaSeconds, const Camera& camera)
+        {
+            timeSeconds_ += deltaSeconds;
+            if (!path_.keys.empty() && timeSeconds_ - path_.keys.back().timeSeconds < intervalSeconds_)
+            {
+                return;
+            }
+            path_.keys.push_back(CameraPathKey{ timeSeconds_, camera.position, camera.target });
+        }
+
+        [[nodiscard]] const CameraPath& GetPath() const noexcept { return path_; }
+
+    private:
+        CameraPath path_{};
+        float intervalSeconds_{ 0.25f };
+        float timeSeconds_{ 0.0f };
+    };
+}
@@ -2,36 +2,55 @@ module;
 
 #include <string>
 #include <string_view>
+#include <span>
+#include <future>
+#include <chrono>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <optional>
 #include <array>
 #include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <stdexcept>
 #include <filesystem>
 #include <algorithm>
 #include <fstream>
-#include <sstream>
-#include <iomanip>
 #include <limits>
 #include <cmath>
 #include <cassert>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 
 export module core:level;
 import :scene; 
 import :level_ecs; 
+import :scene_bvh;
 import :asset_manager; 
 import :resource_manager; 
+import :job_system;
+import :profiler;
+import :memory_tracking;
 import :render_bindless; 
 import :file_system; 
+import :cooked_mesh;
+import :cooked_assets;
 import :math_utils;
 import :assimp_scene_loader;
 import :assimp_loader;
 import :animator;
 import :animation_controller;
 import :animation_clip;
+import :animation_compression;
+import :skeleton;
 
 // ------------------------------------------------------------
 // LevelAsset / LevelInstance
@@ -40,6 +59,12 @@ import :animation_clip;
 export namespace rendern
 {
 #include "SceneImpl/Level_AssetTypes.inl"
+#include "SceneImpl/Level_CellStreamer.inl"
+
+	// Declared ahead of LevelInstance: cell streaming issues its own prefetches.
+	[[nodiscard]] LevelPrefetchManifest BuildLevelPrefetchManifest(const LevelAsset& asset, std::span<const mathUtils::Mat4> nodeWorld, const mathUtils::Vec3& viewPosition);
+	LevelPrefetch IssueLevelPrefetch(AssetManager& assets, const LevelAsset& asset, const LevelPrefetchManifest& manifest);
+	LevelPrefetch IssueLevelPrefetch(AssetManager& assets, const LevelAsset& asset, std::span<const LevelPrefetchRequest> requests);
 
 	class LevelInstance
 	{
@@ -57,14 +82,24 @@ export namespace rendern
 	};
 
 	[[nodiscard]] LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath);
+	// Binary snapshot of a parsed level (see Level_Snapshot.inl). LoadLevelAsset reads the snapshot when its
+	// source stamps still match and otherwise parses the JSON and refreshes the snapshot.
+	[[nodiscard]] LevelAsset LoadLevelAsset(std::string_view levelRelativePath);
+	[[nodiscard]] std::filesystem::path LevelSnapshotPath(std::string_view levelPath);
+	void SaveLevelSnapshot(const std::filesystem::path& path, const LevelAsset& level, std::span<const CookedFileStamp> sources);
+	[[nodiscard]] std::optional<LevelAsset> ReadLevelSnapshot(const std::filesystem::path& path, bool checkSources);
 	[[nodiscard]] LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable& bindless, const LevelAsset& asset, const mathUtils::Mat4& root);
 	void SaveLevelAssetToJson(std::string_view levelRelativeOrAbsPath, const LevelAsset& level);
+	// Serializes a copy of `level` on a Background job; the future carries any save error.
+	[[nodiscard]] std::shared_future<void> SaveLevelAssetToJsonAsync(jobs::Scheduler& scheduler, std::string levelRelativeOrAbsPath, LevelAsset level);
 }
 
 namespace rendern
 {
 #include "SceneImpl/Level_LoadJson.inl"
+#include "SceneImpl/Level_PrefetchManifest.inl"
 #include "SceneImpl/Level_InstantiateRuntime.inl"
 #include "SceneImpl/Level_SaveJson.inl"
+#include "SceneImpl/Level_Snapshot.inl"
 }
 
@@ -7,6 +7,7 @@ module;
 #include <cstddef>
 #include <concepts>
 #include <functional>
+#include <type_traits>
 #include <utility>
 
 export module core:level_ecs;
@@ -52,6 +53,7 @@ export namespace rendern
     {
         bool alive{ true };
         bool visible{ true };
+        bool isStatic{ false };
     };
 
     template <class Fn>
@@ -123,54 +125,63 @@ export namespace rendern
         bool TryGetFlags(EntityHandle entity, Flags& out) const noexcept;
         bool TryGetRenderable(EntityHandle entity, Renderable& out) const noexcept;
 
+        // Both walk owned EnTT groups in the implementation unit: node components (and Renderable for
+        // renderable nodes) are packed in matching order, so traversal is linear and allocation-free.
+        // The visitor is reached through one plain function pointer per entity.
         template <class Fn>
             requires LevelNodeVisitor<Fn>
         void ForEachNode(Fn&& fn) const
         {
-            const std::vector<EntityHandle> entities = GatherNodeEntities();
-            for (const EntityHandle entity : entities)
-            {
-                const LevelNodeId* nodeId = TryGetLevelNodeIdPtr(entity);
-                const ParentIndex* parent = TryGetParentIndexPtr(entity);
-                const LocalTransform* local = TryGetLocalTransformPtr(entity);
-                const WorldTransform* world = TryGetWorldTransformPtr(entity);
-                const Flags* flags = TryGetFlagsPtr(entity);
-
-                if (!nodeId || !parent || !local || !world || !flags)
+            VisitNodes(ErasedVisitor(fn), [](void* context,
+                EntityHandle entity,
+                const LevelNodeId& nodeId,
+                const ParentIndex& parent,
+                const LocalTransform& local,
+                const WorldTransform& world,
+                const Flags& flags)
                 {
-                    continue;
-                }
-
-                std::invoke(std::forward<Fn>(fn), entity, *nodeId, *parent, *local, *world, *flags);
-            }
+                    std::invoke(*static_cast<std::remove_reference_t<Fn>*>(context), entity, nodeId, parent, local, world, flags);
+                });
         }
 
         template <class Fn>
             requires RenderableVisitor<Fn>
         void ForEachRenderable(Fn&& fn) const
         {
-            const std::vector<EntityHandle> entities = GatherRenderableEntities();
-            for (const EntityHandle entity : entities)
-            {
-                const LevelNodeId* nodeId = TryGetLevelNodeIdPtr(entity);
-                const WorldTransform* world = TryGetWorldTransformPtr(entity);
-                const Renderable* renderable = TryGetRenderablePtr(entity);
-                const Flags* flags = TryGetFlagsPtr(entity);
-
-                if (!nodeId || !world || !renderable || !flags)
+            VisitRenderables(ErasedVisitor(fn), [](void* context,
+                EntityHandle entity,
+                const LevelNodeId& nodeId,
+                const WorldTransform& world,
+                const Renderable& renderable,
+                const Flags& flags)
                 {
-                    continue;
-                }
-
-                std::invoke(std::forward<Fn>(fn), entity, *nodeId, *world, *renderable, *flags);
-            }
+                    std::invoke(*static_cast<std::remove_reference_t<Fn>*>(context), entity, nodeId, world, renderable, flags);
+                });
         }
 
     private:
         struct Impl;
         std::unique_ptr<Impl> impl_{};
 
-        std::vector<EntityHandle> GatherNodeEntities() const;
-        std::vector<EntityHandle> GatherRenderableEntities() const;
+        using NodeVisitThunk = void (*)(void*, EntityHandle,
+            const LevelNodeId&,
+            const ParentIndex&,
+            const LocalTransform&,
+            const WorldTransform&,
+            const Flags&);
+        using RenderableVisitThunk = void (*)(void*, EntityHandle,
+            const LevelNodeId&,
+            const WorldTransform&,
+            const Renderable&,
+            const Flags&);
+
+        template <class Fn>
+        [[nodiscard]] static void* ErasedVisitor(Fn& fn) noexcept
+        {
+            return const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+        }
+
+        void VisitNodes(void* context, NodeVisitThunk thunk) const;
+        void VisitRenderables(void* context, RenderableVisitThunk thunk) const;
     };
 }
\ No newline at end of file
@@ -13,9 +13,19 @@ namespace rendern
 {
 	using namespace EnTT_helpers;
 
+    // Owned groups: a node's five components sit at the same index of their storages, and the nested
+    // renderable group keeps renderable nodes packed at the front of that range with Renderable alongside.
+    // Nothing may registry.sort() these components.
+    using LevelNodeGroup = decltype(std::declval<entt::registry&>().group<
+        LevelNodeId, ParentIndex, LocalTransform, WorldTransform, Flags>());
+    using LevelRenderableGroup = decltype(std::declval<entt::registry&>().group<
+        LevelNodeId, ParentIndex, LocalTransform, WorldTransform, Flags, Renderable>());
+
     struct LevelWorld::Impl
     {
         entt::registry registry{};
+        LevelNodeGroup nodes{ registry.group<LevelNodeId, ParentIndex, LocalTransform, WorldTransform, Flags>() };
+        LevelRenderableGroup renderables{ registry.group<LevelNodeId, ParentIndex, LocalTransform, WorldTransform, Flags, Renderable>() };
     };
 
     LevelWorld::LevelWorld()
@@ -206,31 +216,19 @@ namespace rendern
         return false;
     }
 
-    std::vector<EntityHandle> LevelWorld::GatherNodeEntities() const
+    void LevelWorld::VisitNodes(void* const context, const NodeVisitThunk thunk) const
     {
-        std::vector<EntityHandle> result;
-        const auto view = impl_->registry.view<LevelNodeId, ParentIndex, LocalTransform, WorldTransform, Flags>();
-        result.reserve(impl_->registry.storage<LevelNodeId>().size());
-
-        for (const entt::entity e : view)
+        for (const auto [e, nodeId, parent, local, world, flags] : impl_->nodes.each())
         {
-            result.push_back(FromEnTT(e));
+            thunk(context, FromEnTT(e), nodeId, parent, local, world, flags);
         }
-
-        return result;
     }
 
-    std::vector<EntityHandle> LevelWorld::GatherRenderableEntities() const
+    void LevelWorld::VisitRenderables(void* const context, const RenderableVisitThunk thunk) const
     {
-        std::vector<EntityHandle> result;
-        const auto view = impl_->registry.view<LevelNodeId, WorldTransform, Renderable, Flags>();
-        result.reserve(impl_->registry.storage<Renderable>().size());
-
-        for (const entt::entity e : view)
+        for (const auto [e, nodeId, parent, local, world, flags, renderable] : impl_->renderables.each())
         {
-            result.push_back(FromEnTT(e));
+            thunk(context, FromEnTT(e), nodeId, world, renderable, flags);
         }
-
-        return result;
     }
 }
\ No newline at end of file
@@ -0,0 +1,413 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <span>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CORE_PARTICLE_SIMD_AVX 1
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CORE_PARTICLE_SIMD_SSE2 1
+#endif
+
+export module core:particle_pool;
+
+import :math_utils;
+import :job_system;
+
+// CPU particles as structure-of-arrays.
+//
+// Every particle attribute is one float stream (32-byte aligned), so the per-frame update is a straight
+// pass over contiguous arrays: 8 particles per step with AVX, 4 with SSE2, a scalar loop for the tail
+// and for targets without either. The update only flags dead particles; they are removed afterwards by
+// swap-remove (last particle moves into the hole), so the pool stays dense but does not keep its order.
+// Large pools split the update across the job system in fixed chunks.
+
+export namespace rendern
+{
+	struct Particle
+	{
+		mathUtils::Vec3 position{ 0.0f, 0.0f, 0.0f };
+		mathUtils::Vec3 velocity{ 0.0f, 0.0f, 0.0f };
+		mathUtils::Vec4 color{ 1.0f, 0.6f, 0.2f, 1.0f };
+		mathUtils::Vec4 colorBegin{ 1.0f, 0.6f, 0.2f, 1.0f };
+		mathUtils::Vec4 colorEnd{ 1.0f, 0.6f, 0.2f, 1.0f };
+		float size{ 0.15f };
+		float sizeBegin{ 0.15f };
+		float sizeEnd{ 0.15f };
+		float lifetime{ 1.0f };
+		float age{ 0.0f };
+		float rotationRad{ 0.0f };
+		bool alive{ true };
+		int ownerEmitter{ -1 };
+	};
+
+	enum class ParticleStream : std::uint32_t
+	{
+		PositionX, PositionY, PositionZ,
+		VelocityX, VelocityY, VelocityZ,
+		ColorR, ColorG, ColorB, ColorA,
+		ColorBeginR, ColorBeginG, ColorBeginB, ColorBeginA,
+		ColorEndR, ColorEndG, ColorEndB, ColorEndA,
+		Size, SizeBegin, SizeEnd,
+		Lifetime, Age, Rotation,
+		Count
+	};
+
+	template <typename T>
+	struct SimdAlignedAllocator
+	{
+		using value_type = T;
+		static constexpr std::align_val_t kAlignment{ 32 };
+
+		SimdAlignedAllocator() noexcept = default;
+		template <typename U>
+		SimdAlignedAllocator(const SimdAlignedAllocator<U>&) noexcept {}
+
+		T* allocate(std::size_t n)
+		{
+			return static_cast<T*>(::operator new(n * sizeof(T), kAlignment));
+		}
+		void deallocate(T* p, std::size_t) noexcept
+		{
+			::operator delete(p, kAlignment);
+		}
+
+		template <typename U>
+		friend bool operator==(const SimdAlignedAllocator&, const SimdAlignedAllocator<U>&) noexcept { return true; }
+	};
+
+	class ParticlePool
+	{
+	public:
+		// Particles per job in Update; a multiple of the SIMD width so every chunk but the last is full steps.
+		static constexpr std::size_t kUpdateGrain = 16384;
+
+		class ConstIterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = Particle;
+			using difference_type = std::ptrdiff_t;
+
+			ConstIterator() noexcept = default;
+			ConstIterator(const ParticlePool* pool, std::size_t index) noexcept : pool_(pool), index_(index) {}
+
+			Particle operator*() const { return pool_->Get(index_); }
+			ConstIterator& operator++() noexcept { ++index_; return *this; }
+			ConstIterator operator++(int) noexcept { ConstIterator old = *this; ++index_; return old; }
+			friend bool operator==(const ConstIterator& a, const ConstIterator& b) noexcept { return a.index_ == b.index_; }
+
+		private:
+			const ParticlePool* pool_{ nullptr };
+			std::size_t index_{ 0 };
+		};
+
+		[[nodiscard]] std::size_t size() const noexcept { return owners_.size(); }
+		[[nodiscard]] bool empty() const noexcept { return owners_.empty(); }
+		[[nodiscard]] ConstIterator begin() const noexcept { return ConstIterator(this, 0); }
+		[[nodiscard]] ConstIterator end() const noexcept { return ConstIterator(this, size()); }
+
+		void clear() noexcept
+		{
+			for (Floats& stream : streams_)
+			{
+				stream.clear();
+			}
+			owners_.clear();
+			ownerCounts_.clear();
+		}
+
+		void reserve(std::size_t count)
+		{
+			for (Floats& stream : streams_)
+			{
+				stream.reserve(count);
+			}
+			owners_.reserve(count);
+		}
+
+		// Dead particles (alive == false) are not stored.
+		void Add(const Particle& particle)
+		{
+			if (!particle.alive)
+			{
+				return;
+			}
+
+			const float values[kStreamCount] = {
+				particle.position.x, particle.position.y, particle.position.z,
+				particle.velocity.x, particle.velocity.y, particle.velocity.z,
+				particle.color.x, particle.color.y, particle.color.z, particle.color.w,
+				particle.colorBegin.x, particle.colorBegin.y, particle.colorBegin.z, particle.colorBegin.w,
+				particle.colorEnd.x, particle.colorEnd.y, particle.colorEnd.z, particle.colorEnd.w,
+				particle.size, particle.sizeBegin, particle.sizeEnd,
+				particle.lifetime, particle.age, particle.rotationRad };
+			for (std::size_t s = 0; s < kStreamCount; ++s)
+			{
+				streams_[s].push_back(values[s]);
+			}
+			owners_.push_back(particle.ownerEmitter);
+			if (particle.ownerEmitter >= 0)
+			{
+				const std::size_t owner = static_cast<std::size_t>(particle.ownerEmitter);
+				if (owner >= ownerCounts_.size())
+				{
+					ownerCounts_.resize(owner + 1, 0u);
+				}
+				++ownerCounts_[owner];
+			}
+		}
+
+		[[nodiscard]] Particle Get(std::size_t index) const
+		{
+			auto at = [this, index](ParticleStream s) { return streams_[static_cast<std::size_t>(s)][index]; };
+
+			Particle particle{};
+			particle.position = { at(ParticleStream::PositionX), at(ParticleStream::PositionY), at(ParticleStream::PositionZ) };
+			particle.velocity = { at(ParticleStream::VelocityX), at(ParticleStream::VelocityY), at(ParticleStream::VelocityZ) };
+			particle.color = { at(ParticleStream::ColorR), at(ParticleStream::ColorG), at(ParticleStream::ColorB), at(ParticleStream::ColorA) };
+			particle.colorBegin = { at(ParticleStream::ColorBeginR), at(ParticleStream::ColorBeginG), at(ParticleStream::ColorBeginB), at(ParticleStream::ColorBeginA) };
+			particle.colorEnd = { at(ParticleStream::ColorEndR), at(ParticleStream::ColorEndG), at(ParticleStream::ColorEndB), at(ParticleStream::ColorEndA) };
+			particle.size = at(ParticleStream::Size);
+			particle.sizeBegin = at(ParticleStream::SizeBegin);
+			particle.sizeEnd = at(ParticleStream::SizeEnd);
+			particle.lifetime = at(ParticleStream::Lifetime);
+			particle.age = at(ParticleStream::Age);
+			particle.rotationRad = at(ParticleStream::Rotation);
+			particle.alive = true;
+			particle.ownerEmitter = owners_[index];
+			return particle;
+		}
+
+		[[nodiscard]] std::span<const float> Stream(ParticleStream stream) const noexcept
+		{
+			return streams_[static_cast<std::size_t>(stream)];
+		}
+
+		[[nodiscard]] std::span<const int> Owners() const noexcept
+		{
+			return owners_;
+		}
+
+		[[nodiscard]] std::uint32_t CountOwnedBy(int emitterIndex) const noexcept
+		{
+			if (emitterIndex < 0 || static_cast<std::size_t>(emitterIndex) >= ownerCounts_.size())
+			{
+				return 0u;
+			}
+			return ownerCounts_[static_cast<std::size_t>(emitterIndex)];
+		}
+
+		void RemoveOwnedBy(int emitterIndex)
+		{
+			if (CountOwnedBy(emitterIndex) == 0u)
+			{
+				return;
+			}
+			for (std::size_t i = size(); i-- > 0;)
+			{
+				if (owners_[i] == emitterIndex)
+				{
+					SwapRemove_(i);
+				}
+			}
+		}
+
+		// Ages and moves every particle by dt, interpolates color and size over its life, then removes the ones
+		// that expired or faded out (size or alpha <= 0). Particles with lifetime <= 0 never expire.
+		void Update(float dt, jobs::Scheduler* scheduler = nullptr)
+		{
+			const std::size_t count = size();
+			if (count == 0)
+			{
+				return;
+			}
+
+			killScratch_.assign(count, 0u);
+			std::array<float*, kStreamCount> streams{};
+			for (std::size_t s = 0; s < kStreamCount; ++s)
+			{
+				streams[s] = streams_[s].data();
+			}
+			std::uint8_t* kill = killScratch_.data();
+			jobs::ParallelFor(scheduler, count, kUpdateGrain, [&streams, kill, dt](std::size_t begin, std::size_t end)
+				{
+					UpdateParticleRange(streams, kill, begin, end, dt);
+				});
+
+			// Back to front: whatever moves into slot i comes from a slot that was already checked.
+			for (std::size_t i = count; i-- > 0;)
+			{
+				if (kill[i] != 0u)
+				{
+					SwapRemove_(i);
+				}
+			}
+		}
+
+	private:
+		static constexpr std::size_t kStreamCount = static_cast<std::size_t>(ParticleStream::Count);
+		using Floats = std::vector<float, SimdAlignedAllocator<float>>;
+		using Streams = std::array<float*, kStreamCount>;
+
+		void SwapRemove_(std::size_t index)
+		{
+			const int owner = owners_[index];
+			if (owner >= 0 && static_cast<std::size_t>(owner) < ownerCounts_.size())
+			{
+				--ownerCounts_[static_cast<std::size_t>(owner)];
+			}
+
+			const std::size_t last = size() - 1;
+			for (Floats& stream : streams_)
+			{
+				stream[index] = stream[last];
+				stream.pop_back();
+			}
+			owners_[index] = owners_[last];
+			owners_.pop_back();
+		}
+
+		static void UpdateParticleRange(const Streams& s, std::uint8_t* kill, std::size_t begin, std::size_t end, float dt)
+		{
+			auto stream = [&s](ParticleStream id) { return s[static_cast<std::size_t>(id)]; };
+			float* const px = stream(ParticleStream::PositionX);
+			float* const py = stream(ParticleStream::PositionY);
+			float* const pz = stream(ParticleStream::PositionZ);
+			const float* const vx = stream(ParticleStream::VelocityX);
+			const float* const vy = stream(ParticleStream::VelocityY);
+			const float* const vz = stream(ParticleStream::VelocityZ);
+			float* const age = stream(ParticleStream::Age);
+			const float* const lifetime = stream(ParticleStream::Lifetime);
+			float* const size = stream(ParticleStream::Size);
+			const float* const sizeBegin = stream(ParticleStream::SizeBegin);
+			const float* const sizeEnd = stream(ParticleStream::SizeEnd);
+
+			constexpr std::size_t kColorChannels = 4;
+			float* color[kColorChannels]{};
+			const float* colorBegin[kColorChannels]{};
+			const float* colorEnd[kColorChannels]{};
+			for (std::size_t c = 0; c < kColorChannels; ++c)
+			{
+				color[c] = s[static_cast<std::size_t>(ParticleStream::ColorR) + c];
+				colorBegin[c] = s[static_cast<std::size_t>(ParticleStream::ColorBeginR) + c];
+				colorEnd[c] = s[static_cast<std::size_t>(ParticleStream::ColorEndR) + c];
+			}
+
+			std::size_t i = begin;
+#if defined(CORE_PARTICLE_SIMD_AVX)
+			const __m256 vdt = _mm256_set1_ps(dt);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.0f);
+			for (; i + 8 <= end; i += 8)
+			{
+				const __m256 a = _mm256_add_ps(_mm256_loadu_ps(age + i), vdt);
+				_mm256_storeu_ps(age + i, a);
+				_mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt)));
+				_mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt)));
+				_mm256_storeu_ps(pz + i, _mm256_add_ps(_mm256_loadu_ps(pz + i), _mm256_mul_ps(_mm256_loadu_ps(vz + i), vdt)));
+
+				const __m256 life = _mm256_loadu_ps(lifetime + i);
+				const __m256 finite = _mm256_cmp_ps(life, zero, _CMP_GT_OQ);
+				const __m256 t = _mm256_blendv_ps(one, _mm256_min_ps(_mm256_max_ps(_mm256_div_ps(a, life), zero), one), finite);
+
+				__m256 alpha = zero;
+				for (std::size_t c = 0; c < kColorChannels; ++c)
+				{
+					const __m256 c0 = _mm256_loadu_ps(colorBegin[c] + i);
+					const __m256 v = _mm256_add_ps(c0, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(colorEnd[c] + i), c0), t));
+					_mm256_storeu_ps(color[c] + i, v);
+					if (c == kColorChannels - 1)
+					{
+						alpha = v;
+					}
+				}
+				const __m256 s0 = _mm256_loadu_ps(sizeBegin + i);
+				const __m256 sz = _mm256_add_ps(s0, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(sizeEnd + i), s0), t));
+				_mm256_storeu_ps(size + i, sz);
+
+				const __m256 dead = _mm256_or_ps(
+					_mm256_and_ps(finite, _mm256_cmp_ps(a, life, _CMP_GE_OQ)),
+					_mm256_or_ps(_mm256_cmp_ps(sz, zero, _CMP_LE_OQ), _mm256_cmp_ps(alpha, zero, _CMP_LE_OQ)));
+				const int mask = _mm256_movemask_ps(dead);
+				for (std::size_t lane = 0; lane < 8; ++lane)
+				{
+					kill[i + lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+				}
+			}
+#elif defined(CORE_PARTICLE_SIMD_SSE2)
+			const __m128 vdt = _mm_set1_ps(dt);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			for (; i + 4 <= end; i += 4)
+			{
+				const __m128 a = _mm_add_ps(_mm_loadu_ps(age + i), vdt);
+				_mm_storeu_ps(age + i, a);
+				_mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(_mm_loadu_ps(vx + i), vdt)));
+				_mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(_mm_loadu_ps(vy + i), vdt)));
+				_mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(_mm_loadu_ps(vz + i), vdt)));
+
+				const __m128 life = _mm_loadu_ps(lifetime + i);
+				const __m128 finite = _mm_cmpgt_ps(life, zero);
+				const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_div_ps(a, life), zero), one);
+				const __m128 t = _mm_or_ps(_mm_and_ps(finite, clamped), _mm_andnot_ps(finite, one));
+
+				__m128 alpha = zero;
+				for (std::size_t c = 0; c < kColorChannels; ++c)
+				{
+					const __m128 c0 = _mm_loadu_ps(colorBegin[c] + i);
+					const __m128 v = _mm_add_ps(c0, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(colorEnd[c] + i), c0), t));
+					_mm_storeu_ps(color[c] + i, v);
+					if (c == kColorChannels - 1)
+					{
+						alpha = v;
+					}
+				}
+				const __m128 s0 = _mm_loadu_ps(sizeBegin + i);
+				const __m128 sz = _mm_add_ps(s0, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(sizeEnd + i), s0), t));
+				_mm_storeu_ps(size + i, sz);
+
+				const __m128 dead = _mm_or_ps(
+					_mm_and_ps(finite, _mm_cmpge_ps(a, life)),
+					_mm_or_ps(_mm_cmple_ps(sz, zero), _mm_cmple_ps(alpha, zero)));
+				const int mask = _mm_movemask_ps(dead);
+				for (std::size_t lane = 0; lane < 4; ++lane)
+				{
+					kill[i + lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+				}
+			}
+#endif
+			for (; i < end; ++i)
+			{
+				age[i] += dt;
+				px[i] += vx[i] * dt;
+				py[i] += vy[i] * dt;
+				pz[i] += vz[i] * dt;
+
+				const bool finite = lifetime[i] > 0.0f;
+				const float t = finite ? std::clamp(age[i] / lifetime[i], 0.0f, 1.0f) : 1.0f;
+				for (std::size_t c = 0; c < kColorChannels; ++c)
+				{
+					color[c][i] = mathUtils::Lerp(colorBegin[c][i], colorEnd[c][i], t);
+				}
+				size[i] = mathUtils::Lerp(sizeBegin[i], sizeEnd[i], t);
+
+				const bool expired = finite && age[i] >= lifetime[i];
+				kill[i] = static_cast<std::uint8_t>(expired || size[i] <= 0.0f || color[3][i] <= 0.0f);
+			}
+		}
+
+		std::array<Floats, kStreamCount> streams_{};
+		std::vector<int> owners_;
+		std::vector<std::uint32_t> ownerCounts_; // live particles per emitter index
+		std::vector<std::uint8_t> killScratch_;
+	};
+}
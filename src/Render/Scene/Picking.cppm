@@ -2,6 +2,7 @@ module;
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <utility>
 
@@ -10,34 +11,13 @@ export module core:picking;
 import :scene;
 import :level;
 import :level_ecs;
+import :scene_bvh;
 import :math_utils;
 import :geometry;
+import :renderer_settings;
 
 namespace
 {
-    static void TransformAABB(const mathUtils::Vec3& bmin, const mathUtils::Vec3& bmax, const mathUtils::Mat4& m,
-        mathUtils::Vec3& outMin, mathUtils::Vec3& outMax) noexcept
-    {
-        const mathUtils::Vec3 c[8] =
-        {
-            { bmin.x, bmin.y, bmin.z }, { bmax.x, bmin.y, bmin.z }, { bmin.x, bmax.y, bmin.z }, { bmax.x, bmax.y, bmin.z },
-            { bmin.x, bmin.y, bmax.z }, { bmax.x, bmin.y, bmax.z }, { bmin.x, bmax.y, bmax.z }, { bmax.x, bmax.y, bmax.z },
-        };
-
-        mathUtils::Vec3 wmin{ std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
-        mathUtils::Vec3 wmax{ -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
-
-        for (const auto& p : c)
-        {
-            const mathUtils::Vec3 wp = mathUtils::TransformPoint(m, p);
-            wmin = mathUtils::MinVec3(wmin, wp);
-            wmax = mathUtils::MaxVec3(wmax, wp);
-        }
-
-        outMin = wmin;
-        outMax = wmax;
-    }
-
     static bool IntersectRayAABB(const geometry::Ray& ray, const mathUtils::Vec3& bmin, const mathUtils::Vec3& bmax, float& outT) noexcept
     {
         float tmin = 0.0f;
@@ -107,6 +87,75 @@ namespace
         outT = t;
         return true;
     }
+
+    // Particle emitters and point/spot lights (not in the picking BVH nor the renderer's ID buffer):
+    // ray vs. pick sphere, replacing the best hit so far when closer.
+    static void PickEmittersAndLights(
+        const rendern::Scene& scene,
+        rendern::LevelInstance& levelInst,
+        const geometry::Ray& ray,
+        float& bestT,
+        int& bestNode,
+        int& bestEmitter,
+        int& bestLight) noexcept
+    {
+        for (std::size_t emitterIndex = 0; emitterIndex < levelInst.GetParticleEmitterCount(); ++emitterIndex)
+        {
+            const rendern::ParticleEmitter* emitter = levelInst.GetRuntimeParticleEmitter(scene, static_cast<int>(emitterIndex));
+            if (!emitter || !emitter->enabled)
+            {
+                continue;
+            }
+
+            const float jitterRadius = std::max(std::max(std::abs(emitter->positionJitter.x), std::abs(emitter->positionJitter.y)), std::abs(emitter->positionJitter.z));
+            const float velocityExtent = std::max(std::max(
+                std::max(std::abs(emitter->velocityMin.x), std::abs(emitter->velocityMax.x)),
+                std::max(std::abs(emitter->velocityMin.y), std::abs(emitter->velocityMax.y))),
+                std::max(std::abs(emitter->velocityMin.z), std::abs(emitter->velocityMax.z)));
+            const float maxLifetime = std::max(emitter->lifetimeMin, emitter->lifetimeMax);
+            const float radius = std::max(0.35f, jitterRadius + velocityExtent * std::max(0.25f, maxLifetime) + std::max(emitter->sizeBegin, emitter->sizeEnd));
+
+            float t = 0.0f;
+            if (!IntersectRaySphere(ray, emitter->position, radius, t))
+            {
+                continue;
+            }
+
+            if (t < bestT)
+            {
+                bestT = t;
+                bestNode = -1;
+                bestEmitter = static_cast<int>(emitterIndex);
+                bestLight = -1;
+            }
+        }
+
+        for (std::size_t lightIndex = 0; lightIndex < scene.lights.size(); ++lightIndex)
+        {
+            const rendern::Light& light = scene.lights[lightIndex];
+            if (light.type != rendern::LightType::Point && light.type != rendern::LightType::Spot)
+            {
+                continue;
+            }
+
+            const float distToCamera = mathUtils::Length(scene.camera.position - light.position);
+            const float pickRadius = std::clamp(distToCamera * 0.04f, 0.15f, 1.5f);
+
+            float t = 0.0f;
+            if (!IntersectRaySphere(ray, light.position, pickRadius, t))
+            {
+                continue;
+            }
+
+            if (t < bestT)
+            {
+                bestT = t;
+                bestNode = -1;
+                bestEmitter = -1;
+                bestLight = static_cast<int>(lightIndex);
+            }
+        }
+    }
 }
 
 export namespace rendern
@@ -150,7 +199,7 @@ export namespace rendern
 
     PickResult PickEditorObjectUnderScreenPoint(
         const rendern::Scene& scene,
-        const rendern::LevelInstance& levelInst,
+        rendern::LevelInstance& levelInst,
         float mouseX,
         float mouseY,
         float viewportW,
@@ -167,116 +216,84 @@ export namespace rendern
         int bestEmitter = -1;
         int bestLight = -1;
 
+        // Renderables: closest hit through the picking BVH (leaf boxes are the world AABBs of the meshes).
+        const SceneBvh& bvh = levelInst.RefreshPickBvh(scene);
         const LevelWorld& ecs = levelInst.GetLevelWorld();
-        ecs.ForEachRenderable([&](EntityHandle,
-            const LevelNodeId& nodeId,
-            const WorldTransform& world,
-            const Renderable& renderable,
-            const Flags& flags)
+        bestT = bvh.RayCast(ray.origin, ray.dir, bestT, [&](SceneBvh::ProxyId proxy, std::uint32_t nodeIndex, float maxT)
             {
-                if (!flags.alive || !flags.visible)
+                const EntityHandle entity = levelInst.GetNodeEntity(static_cast<int>(nodeIndex));
+                const Flags* flags = (entity != kNullEntity) ? ecs.TryGetFlagsPtr(entity) : nullptr;
+                if (!flags || !flags->alive || !flags->visible)
                 {
-                    return;
-                }
-
-                mathUtils::Vec3 wmin{}, wmax{};
-                if (renderable.isSkinned)
-                {
-                    const SkinnedDrawItem* skinned = levelInst.GetSkinnedDrawItem(scene, renderable.skinnedDrawIndex);
-                    if (!skinned || !skinned->asset)
-                    {
-                        return;
-                    }
-
-                    const auto& bounds =
-                        (skinned->asset->mesh.bounds.maxAnimatedBounds.sphereRadius > 0.0f)
-                        ? skinned->asset->mesh.bounds.maxAnimatedBounds
-                        : skinned->asset->mesh.bounds.bindPoseBounds;
-                    TransformAABB(bounds.aabbMin, bounds.aabbMax, world.world, wmin, wmax);
-                }
-                else
-                {
-                    if (!renderable.mesh)
-                    {
-                        return;
-                    }
-
-                    const auto& meshBounds = renderable.mesh->GetBounds();
-                    TransformAABB(meshBounds.aabbMin, meshBounds.aabbMax, world.world, wmin, wmax);
+                    return maxT;
                 }
 
+                const BvhAabb& box = bvh.GetBounds(proxy);
                 float t = 0.0f;
-                if (!IntersectRayAABB(ray, wmin, wmax, t))
+                if (!IntersectRayAABB(ray, box.min, box.max, t) || t >= maxT)
                 {
-                    return;
+                    return maxT;
                 }
 
-                if (t < bestT)
-                {
-                    bestT = t;
-                    bestNode = nodeId.index;
-                    bestEmitter = -1;
-                    bestLight = -1;
-                }
+                bestNode = static_cast<int>(nodeIndex);
+                return t;
             });
 
-        for (std::size_t emitterIndex = 0; emitterIndex < levelInst.GetParticleEmitterCount(); ++emitterIndex)
-        {
-            const ParticleEmitter* emitter = levelInst.GetRuntimeParticleEmitter(scene, static_cast<int>(emitterIndex));
-            if (!emitter || !emitter->enabled)
-            {
-                continue;
-            }
+        PickEmittersAndLights(scene, levelInst, ray, bestT, bestNode, bestEmitter, bestLight);
 
-            const float jitterRadius = std::max(std::max(std::abs(emitter->positionJitter.x), std::abs(emitter->positionJitter.y)), std::abs(emitter->positionJitter.z));
-            const float velocityExtent = std::max(std::max(
-                std::max(std::abs(emitter->velocityMin.x), std::abs(emitter->velocityMax.x)),
-                std::max(std::abs(emitter->velocityMin.y), std::abs(emitter->velocityMax.y))),
-                std::max(std::abs(emitter->velocityMin.z), std::abs(emitter->velocityMax.z)));
-            const float maxLifetime = std::max(emitter->lifetimeMin, emitter->lifetimeMax);
-            const float radius = std::max(0.35f, jitterRadius + velocityExtent * std::max(0.25f, maxLifetime) + std::max(emitter->sizeBegin, emitter->sizeEnd));
+        out.nodeIndex = bestNode;
+        out.particleEmitterIndex = bestEmitter;
+        out.lightIndex = bestLight;
+        out.t = bestT;
+        return out;
+    }
 
-            float t = 0.0f;
-            if (!IntersectRaySphere(ray, emitter->position, radius, t))
-            {
-                continue;
-            }
+    // Level node behind an ID of the renderer's object-ID buffer (Renderer::RequestObjectIdPick), -1 for none.
+    int NodeIndexFromObjectId(const rendern::LevelInstance& levelInst, std::uint32_t objectId) noexcept
+    {
+        bool skinned = false;
+        const int drawIndex = DrawIndexFromObjectId(objectId, skinned);
+        return skinned ? levelInst.GetNodeIndexFromSkinnedDrawIndex(drawIndex) : levelInst.GetNodeIndexFromDrawIndex(drawIndex);
+    }
 
-            if (t < bestT)
-            {
-                bestT = t;
-                bestNode = -1;
-                bestEmitter = static_cast<int>(emitterIndex);
-                bestLight = -1;
-            }
-        }
+    // PickEditorObjectUnderScreenPoint for a point whose ID buffer pixel is known: the renderable comes from
+    // the rasterized triangles instead of a BVH walk over bounds. Particle emitters and lights are not in the
+    // ID buffer and are still ray-tested; they win when closer than where the ray enters the node's bounds.
+    PickResult PickEditorObjectWithObjectId(
+        const rendern::Scene& scene,
+        rendern::LevelInstance& levelInst,
+        std::uint32_t objectId,
+        float mouseX,
+        float mouseY,
+        float viewportW,
+        float viewportH) noexcept
+    {
+        PickResult out{};
 
-        for (std::size_t lightIndex = 0; lightIndex < scene.lights.size(); ++lightIndex)
-        {
-            const Light& light = scene.lights[lightIndex];
-            if (light.type != LightType::Point && light.type != LightType::Spot)
-            {
-                continue;
-            }
+        const geometry::Ray ray = BuildMouseRay(scene, mouseX, mouseY, viewportW, viewportH);
+        out.rayOrigin = ray.origin;
+        out.rayDir = ray.dir;
 
-            const float distToCamera = mathUtils::Length(scene.camera.position - light.position);
-            const float pickRadius = std::clamp(distToCamera * 0.04f, 0.15f, 1.5f);
+        float bestT = std::numeric_limits<float>::infinity();
+        int bestNode = -1;
+        int bestEmitter = -1;
+        int bestLight = -1;
 
+        const int nodeIndex = NodeIndexFromObjectId(levelInst, objectId);
+        const EntityHandle entity = (nodeIndex >= 0) ? levelInst.GetNodeEntity(nodeIndex) : kNullEntity;
+        const Flags* flags = (entity != kNullEntity) ? levelInst.GetLevelWorld().TryGetFlagsPtr(entity) : nullptr;
+        if (flags && flags->alive && flags->visible)
+        {
+            bestNode = nodeIndex;
+            levelInst.RefreshPickBvh(scene);
+            BvhAabb box{};
             float t = 0.0f;
-            if (!IntersectRaySphere(ray, light.position, pickRadius, t))
-            {
-                continue;
-            }
-
-            if (t < bestT)
-            {
-                bestT = t;
-                bestNode = -1;
-                bestEmitter = -1;
-                bestLight = static_cast<int>(lightIndex);
-            }
+            // The hit is on the node, so without bounds to measure (still streaming) it stays in front.
+            bestT = (levelInst.TryGetNodePickBounds(nodeIndex, box) && IntersectRayAABB(ray, box.min, box.max, t)) ? t : 0.0f;
         }
 
+        PickEmittersAndLights(scene, levelInst, ray, bestT, bestNode, bestEmitter, bestLight);
+
         out.nodeIndex = bestNode;
         out.particleEmitterIndex = bestEmitter;
         out.lightIndex = bestLight;
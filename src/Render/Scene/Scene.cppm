@@ -7,6 +7,7 @@ module;
 #include <memory>
 #include <utility>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
 export module core:scene;
@@ -14,10 +15,13 @@ export module core:scene;
 import :rhi;
 import :resource_manager_mesh;
 import :math_utils;
+import :job_system;
+import :particle_pool;
 import :skinned_mesh;
 import :animation_clip;
 import :animator;
 import :animation_controller;
+import :animation_lod;
 import :EnTTHelpers;
 
 export namespace rendern
@@ -123,23 +127,6 @@ export namespace rendern
 		}
 	};
 
-	struct Particle
-	{
-		mathUtils::Vec3 position{ 0.0f, 0.0f, 0.0f };
-		mathUtils::Vec3 velocity{ 0.0f, 0.0f, 0.0f };
-		mathUtils::Vec4 color{ 1.0f, 0.6f, 0.2f, 1.0f };
-		mathUtils::Vec4 colorBegin{ 1.0f, 0.6f, 0.2f, 1.0f };
-		mathUtils::Vec4 colorEnd{ 1.0f, 0.6f, 0.2f, 1.0f };
-		float size{ 0.15f };
-		float sizeBegin{ 0.15f };
-		float sizeEnd{ 0.15f };
-		float lifetime{ 1.0f };
-		float age{ 0.0f };
-		float rotationRad{ 0.0f };
-		bool alive{ true };
-		int ownerEmitter{ -1 };
-	};
-
 	struct ParticleEmitter
 	{
 		std::string name;
@@ -165,6 +152,13 @@ export namespace rendern
 		float duration{ 0.0f };
 		float startDelay{ 0.0f };
 		std::uint32_t maxParticles{ 1024u };
+		// Region of the texture the emitter uses (u0, v0, width, height), so emitters can share one atlas.
+		// A flipbook splits that region into columns x rows frames, played row by row at flipbookFps, or
+		// once over each particle's lifetime when flipbookFps is 0.
+		mathUtils::Vec4 uvRect{ 0.0f, 0.0f, 1.0f, 1.0f };
+		std::uint32_t flipbookColumns{ 1u };
+		std::uint32_t flipbookRows{ 1u };
+		float flipbookFps{ 0.0f };
 
 		// Runtime-only state. Not serialized.
 		float elapsed{ 0.0f };
@@ -173,6 +167,52 @@ export namespace rendern
 		bool burstDone{ false };
 	};
 
+	// Flipbook grid of an emitter as the GPU particle pool gets it: (columns, rows, fps, 0), at least 1 x 1.
+	inline mathUtils::Vec4 ParticleFlipbookParams(const ParticleEmitter& emitter) noexcept
+	{
+		return mathUtils::Vec4(
+			static_cast<float>(std::max(emitter.flipbookColumns, 1u)),
+			static_cast<float>(std::max(emitter.flipbookRows, 1u)),
+			std::max(emitter.flipbookFps, 0.0f),
+			0.0f);
+	}
+
+	// UV sub-rectangle (u0, v0, width, height) of the flipbook frame shown at `age`. GpuParticleFrameUvRect
+	// (GpuParticleCommon_dx12.hlsli) is the same computation for the GPU pool; keep the two in step.
+	inline mathUtils::Vec4 ParticleFrameUvRect(const mathUtils::Vec4& uvRect, const mathUtils::Vec4& flipbook, float age, float lifetime) noexcept
+	{
+		const std::uint32_t columns = std::max(static_cast<std::uint32_t>(flipbook.x), 1u);
+		const std::uint32_t rows = std::max(static_cast<std::uint32_t>(flipbook.y), 1u);
+		const std::uint32_t frameCount = columns * rows;
+
+		std::uint32_t frame = 0u;
+		if (frameCount > 1u)
+		{
+			if (flipbook.z > 0.0f)
+			{
+				frame = static_cast<std::uint32_t>(std::fmod(std::max(age, 0.0f) * flipbook.z, static_cast<float>(frameCount)));
+			}
+			else if (lifetime > 0.0f && std::isfinite(lifetime))
+			{
+				frame = static_cast<std::uint32_t>(std::clamp(age / lifetime, 0.0f, 1.0f) * static_cast<float>(frameCount));
+			}
+			frame = std::min(frame, frameCount - 1u);
+		}
+
+		const float frameW = uvRect.z / static_cast<float>(columns);
+		const float frameH = uvRect.w / static_cast<float>(rows);
+		return mathUtils::Vec4(
+			uvRect.x + static_cast<float>(frame % columns) * frameW,
+			uvRect.y + static_cast<float>(frame / columns) * frameH,
+			frameW,
+			frameH);
+	}
+
+	inline mathUtils::Vec4 ParticleFrameUvRect(const ParticleEmitter& emitter, float age, float lifetime) noexcept
+	{
+		return ParticleFrameUvRect(emitter.uvRect, ParticleFlipbookParams(emitter), age, lifetime);
+	}
+
 	namespace detail
 	{
 		inline std::uint32_t NextParticleRand(std::uint32_t& state) noexcept
@@ -368,9 +408,11 @@ export namespace rendern
 		MeshHandle mesh{};
 		Transform transform{};
 		MaterialHandle material{};
+		// Set from LevelNode::isStatic: the item may be kept in cached shadow maps and reflection probes.
+		bool isStatic{ false };
 	};
 
-	using SkinnedHandle = std::shared_ptr<SkinnedAssetBundle>;
+	using SkinnedHandle = std::shared_ptr<const SkinnedAssetBundle>;
 
 	struct SkinnedDrawItem
 	{
@@ -379,6 +421,7 @@ export namespace rendern
 		MaterialHandle material{};
 		AnimatorState animator{};
 		AnimationControllerRuntime controller{};
+		AnimationLodState animationLod{};
 		bool autoplay{ true };
 		int activeClipIndex{ -1 };
 		bool debugForceBindPose{ false };
@@ -392,8 +435,21 @@ export namespace rendern
 		std::vector<DrawItem> drawItems;
 		std::vector<SkinnedDrawItem> skinnedDrawItems;
 		std::vector<Light> lights;
-		std::vector<Particle> particles;
+		ParticlePool particles;
 		std::vector<ParticleEmitter> particleEmitters;
+		// Emitters only advance spawnSequence; the renderer spawns and simulates those particles on the GPU
+		// (same random streams). Set by the app when the renderer has a GPU particle path.
+		bool simulateParticlesOnGpu{ false };
+		float particleDeltaSeconds{ 0.0f }; // dt of the last UpdateParticles
+
+		// Animation LOD of skinned items, picked in UpdateSkinned from the camera; viewAspect (set by the
+		// app) completes the camera frustum that decides which characters are offscreen.
+		AnimationLodSettings animationLod{};
+		float viewAspect{ 16.0f / 9.0f };
+
+		// When the app sampled the input this frame reacts to; renderers report the time to Present
+		// (RendererFrameStats::inputToPresentMs). Default-constructed = not measured.
+		std::chrono::steady_clock::time_point inputSampleTime{};
 
 		rhi::TextureDescIndex skyboxDescIndex{ 0 };
 
@@ -806,42 +862,99 @@ export namespace rendern
 			return skinnedDrawItems.back();
 		}
 
-		void UpdateSkinned(float dt)
+		// Characters only read their shared assets, so each one is a job of its own (inline without a scheduler).
+		void UpdateSkinned(float dt, jobs::Scheduler* scheduler = nullptr)
 		{
-			for (SkinnedDrawItem& item : skinnedDrawItems)
-			{
-				if (!item.asset)
+			const float fovY = mathUtils::DegToRad(camera.fovYDeg);
+			const mathUtils::Mat4 viewProj =
+				mathUtils::PerspectiveRH_ZO(fovY, viewAspect, camera.nearZ, camera.farZ) *
+				mathUtils::LookAt(camera.position, camera.target, camera.up);
+			const mathUtils::Frustum frustum = mathUtils::ExtractFrustumRH_ZO(viewProj);
+
+			constexpr std::size_t kSkinnedUpdateGrain = 1;
+			jobs::ParallelFor(scheduler, skinnedDrawItems.size(), kSkinnedUpdateGrain, [&](std::size_t begin, std::size_t end)
 				{
-					continue;
-				}
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						SkinnedDrawItem& item = skinnedDrawItems[i];
+						item.animationLod.stagger = static_cast<std::uint32_t>(i);
+						UpdateSkinnedItem(item, dt, SelectSkinnedItemLod(item, frustum, fovY), animationLod);
+					}
+				});
+		}
 
-				if (IsAnimationControllerUsingLegacyClipMode(item.controller) || item.controller.stateMachineAsset == nullptr)
-				{
-					SyncAnimationControllerLegacyClip(
-						item.controller,
-						item.asset->mesh.skeleton,
-						item.asset->clips,
-						item.activeClipIndex,
-						item.autoplay,
-						item.animator.looping,
-						item.animator.playRate,
-						item.animator.paused,
-						item.debugForceBindPose);
-				}
-				else
-				{
-					RefreshAnimationControllerRuntimeBindings(
-						item.controller,
-						item.asset->mesh.skeleton,
-						item.asset->clips,
-						item.asset->clipSourceAssetIds,
-						item.autoplay,
-						item.animator.paused,
-						item.debugForceBindPose);
-				}
+		// Bounds test against the camera like the renderer's culling; the screen size comes from the same sphere.
+		AnimationLodLevel SelectSkinnedItemLod(const SkinnedDrawItem& item, const mathUtils::Frustum& frustum, float fovYRadians) const
+		{
+			if (!animationLod.enabled || !item.asset)
+			{
+				return AnimationLodLevel::Full;
+			}
 
-				UpdateAnimationControllerRuntime(item.controller, item.animator, dt);
+			const SkinnedBounds& bounds =
+				(item.asset->mesh.bounds.maxAnimatedBounds.sphereRadius > 0.0f)
+				? item.asset->mesh.bounds.maxAnimatedBounds
+				: item.asset->mesh.bounds.bindPoseBounds;
+			if (bounds.sphereRadius <= 0.0f)
+			{
+				return AnimationLodLevel::Full;
 			}
+
+			const mathUtils::Mat4 model = item.transform.ToMatrix();
+			const mathUtils::Vec3 center = mathUtils::TransformPoint(model, bounds.sphereCenter);
+			const float maxScale = std::max({
+				mathUtils::Length(mathUtils::Vec3(model[0].x, model[0].y, model[0].z)),
+				mathUtils::Length(mathUtils::Vec3(model[1].x, model[1].y, model[1].z)),
+				mathUtils::Length(mathUtils::Vec3(model[2].x, model[2].y, model[2].z)) });
+			const float radius = bounds.sphereRadius * maxScale;
+
+			const bool visible = mathUtils::IntersectsSphere(frustum, center, radius);
+			return SelectAnimationLodLevel(animationLod, visible, AnimationLodScreenSize(center, radius, camera.position, fovYRadians));
+		}
+
+		static void UpdateSkinnedItem(
+			SkinnedDrawItem& item,
+			float dt,
+			AnimationLodLevel lodLevel = AnimationLodLevel::Full,
+			const AnimationLodSettings& lodSettings = {})
+		{
+			if (!item.asset)
+			{
+				return;
+			}
+
+			if (!BeginAnimationLodFrame(item.animationLod, lodLevel, lodSettings, dt))
+			{
+				StepAnimationLodWithoutEvaluation(item.controller, item.animator, item.animationLod, lodSettings);
+				return;
+			}
+
+			if (IsAnimationControllerUsingLegacyClipMode(item.controller) || item.controller.stateMachineAsset == nullptr)
+			{
+				SyncAnimationControllerLegacyClip(
+					item.controller,
+					item.asset->mesh.skeleton,
+					item.asset->clips,
+					item.activeClipIndex,
+					item.autoplay,
+					item.animator.looping,
+					item.animator.playRate,
+					item.animator.paused,
+					item.debugForceBindPose);
+			}
+			else
+			{
+				RefreshAnimationControllerRuntimeBindings(
+					item.controller,
+					item.asset->mesh.skeleton,
+					item.asset->clips,
+					item.asset->clipSourceAssetIds,
+					item.autoplay,
+					item.animator.paused,
+					item.debugForceBindPose);
+			}
+
+			EvaluateAnimationWithLod(item.controller, item.animator, item.animationLod, lodSettings);
 		}
 
 		const std::vector<SkinnedDrawItem>& GetSkinnedDrawItems() const noexcept
@@ -855,10 +968,9 @@ export namespace rendern
 			return lights.back();
 		}
 
-		Particle& AddParticle(const Particle& particle)
+		void AddParticle(const Particle& particle)
 		{
-			particles.push_back(particle);
-			return particles.back();
+			particles.Add(particle);
 		}
 
 		ParticleEmitter& AddParticleEmitter(const ParticleEmitter& emitter)
@@ -874,20 +986,15 @@ export namespace rendern
 
 		void EmitParticleFromEmitter(ParticleEmitter& emitter, int emitterIndex)
 		{
-			if (emitter.maxParticles > 0u)
+			if (simulateParticlesOnGpu)
 			{
-				std::uint32_t aliveOwned = 0u;
-				for (const Particle& existing : particles)
-				{
-					if (existing.alive && existing.ownerEmitter == emitterIndex)
-					{
-						++aliveOwned;
-					}
-				}
-				if (aliveOwned >= emitter.maxParticles)
-				{
-					return;
-				}
+				++emitter.spawnSequence;
+				return;
+			}
+
+			if (emitter.maxParticles > 0u && particles.CountOwnedBy(emitterIndex) >= emitter.maxParticles)
+			{
+				return;
 			}
 
 			std::uint32_t rng = (emitter.spawnSequence++ + 1u) * 747796405u + 2891336453u;
@@ -918,10 +1025,12 @@ export namespace rendern
 			particle.alive = true;
 			particle.ownerEmitter = emitterIndex;
 
-			particles.push_back(particle);
+			particles.Add(particle);
 		}
-		void UpdateParticles(float dt)
+		// The scheduler (optional) spreads large particle pools across worker threads.
+		void UpdateParticles(float dt, jobs::Scheduler* scheduler = nullptr)
 		{
+			particleDeltaSeconds = dt;
 			for (std::size_t emitterIndex = 0; emitterIndex < particleEmitters.size(); ++emitterIndex)
 			{
 				ParticleEmitter& emitter = particleEmitters[emitterIndex];
@@ -963,31 +1072,7 @@ export namespace rendern
 				}
 			}
 
-			for (Particle& particle : particles)
-			{
-				if (!particle.alive)
-				{
-					continue;
-				}
-
-				particle.age += dt;
-				particle.position = particle.position + particle.velocity * dt;
-				const float lifeT = (particle.lifetime > 0.0f) ? std::clamp(particle.age / particle.lifetime, 0.0f, 1.0f) : 1.0f;
-				particle.color = mathUtils::Lerp(particle.colorBegin, particle.colorEnd, lifeT);
-				particle.size = mathUtils::Lerp(particle.sizeBegin, particle.sizeEnd, lifeT);
-
-				if (particle.lifetime > 0.0f && particle.age >= particle.lifetime)
-				{
-					particle.alive = false;
-				}
-			}
-
-			particles.erase(
-				std::remove_if(particles.begin(), particles.end(), [](const Particle& particle)
-					{
-						return !particle.alive || particle.size <= 0.0f || particle.color.w <= 0.0f;
-					}),
-				particles.end());
+			particles.Update(dt, scheduler);
 		}
 
 		std::span<const Material> GetMaterials() const { return materials; }
@@ -999,8 +1084,8 @@ export namespace rendern
 		std::span<const Light> GetLights() const { return lights; }
 		std::span<Light> GetLights() { return lights; }
 
-		std::span<const Particle> GetParticles() const { return particles; }
-		std::span<Particle> GetParticles() { return particles; }
+		const ParticlePool& GetParticles() const { return particles; }
+		ParticlePool& GetParticles() { return particles; }
 
 		void RestartParticleEmitter(int emitterIndex)
 		{
@@ -1009,12 +1094,7 @@ export namespace rendern
 				return;
 			}
 
-			particles.erase(
-				std::remove_if(particles.begin(), particles.end(), [emitterIndex](const Particle& particle)
-					{
-						return particle.ownerEmitter == emitterIndex;
-					}),
-				particles.end());
+			particles.RemoveOwnedBy(emitterIndex);
 
 			ParticleEmitter& emitter = particleEmitters[static_cast<std::size_t>(emitterIndex)];
 			emitter.elapsed = 0.0f;
@@ -0,0 +1,625 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+export module core:scene_bvh;
+
+import :math_utils;
+
+// Dynamic bounding volume hierarchy over world-space AABBs.
+//
+// Leaves are proxies with stable ids (the index of their node in the pool), so owners keep the id next to
+// their object and move it with Update. Insert descends by the surface-area heuristic, Update refits the
+// ancestors exactly (no fattened boxes) and stops as soon as a parent box does not change. Incremental edits
+// slowly degrade the tree; RebuildIfDegraded compares the SAH cost with the cost after the last rebuild and
+// rebuilds the internal nodes top-down with binned SAH when it grew too much. Leaf ids survive rebuilds.
+//
+// Queries take a node test (any box the caller's test rejects is skipped with its whole subtree) and visit
+// the leaves that pass; the frustum and ray variants are thin wrappers. Leaf boxes are conservative bounds,
+// callers re-test their exact shape in the visitor.
+
+export namespace rendern
+{
+	struct BvhAabb
+	{
+		mathUtils::Vec3 min{ 0.0f, 0.0f, 0.0f };
+		mathUtils::Vec3 max{ 0.0f, 0.0f, 0.0f };
+	};
+
+	inline BvhAabb UnionAabb(const BvhAabb& a, const BvhAabb& b) noexcept
+	{
+		return { mathUtils::MinVec3(a.min, b.min), mathUtils::MaxVec3(a.max, b.max) };
+	}
+
+	inline float SurfaceArea(const BvhAabb& box) noexcept
+	{
+		const mathUtils::Vec3 e = box.max - box.min;
+		return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+	}
+
+	inline bool AabbEquals(const BvhAabb& a, const BvhAabb& b) noexcept
+	{
+		return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+			a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+	}
+
+	inline bool AabbOverlaps(const BvhAabb& a, const BvhAabb& b) noexcept
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+			a.min.y <= b.max.y && a.max.y >= b.min.y &&
+			a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	inline BvhAabb SphereAabb(const mathUtils::Vec3& center, float radius) noexcept
+	{
+		const mathUtils::Vec3 r{ radius, radius, radius };
+		return { center - r, center + r };
+	}
+
+	// AABB of a local box under an affine transform (center/extent form, exact for the transformed box).
+	inline BvhAabb TransformAabb(const mathUtils::Vec3& bmin, const mathUtils::Vec3& bmax, const mathUtils::Mat4& m) noexcept
+	{
+		const mathUtils::Vec3 c = (bmin + bmax) * 0.5f;
+		const mathUtils::Vec3 e = (bmax - bmin) * 0.5f;
+		const mathUtils::Vec3 wc = mathUtils::TransformPoint(m, c);
+		const mathUtils::Vec3 we{
+			std::abs(m[0].x) * e.x + std::abs(m[1].x) * e.y + std::abs(m[2].x) * e.z,
+			std::abs(m[0].y) * e.x + std::abs(m[1].y) * e.y + std::abs(m[2].y) * e.z,
+			std::abs(m[0].z) * e.x + std::abs(m[1].z) * e.y + std::abs(m[2].z) * e.z };
+		return { wc - we, wc + we };
+	}
+
+	inline bool IntersectsAabb(const mathUtils::Frustum& frustum, const BvhAabb& box) noexcept
+	{
+		return mathUtils::IntersectsAabb(frustum, box.min, box.max);
+	}
+
+	// Slab test against a precomputed inverse direction; outT is the entry distance (0 when the origin is inside).
+	inline bool IntersectRayAabb(const mathUtils::Vec3& origin, const mathUtils::Vec3& invDir, const BvhAabb& box, float maxT, float& outT) noexcept
+	{
+		float tmin = 0.0f;
+		float tmax = maxT;
+		const float o[3] = { origin.x, origin.y, origin.z };
+		const float inv[3] = { invDir.x, invDir.y, invDir.z };
+		const float mn[3] = { box.min.x, box.min.y, box.min.z };
+		const float mx[3] = { box.max.x, box.max.y, box.max.z };
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float t1 = (mn[axis] - o[axis]) * inv[axis];
+			float t2 = (mx[axis] - o[axis]) * inv[axis];
+			if (t1 > t2)
+			{
+				std::swap(t1, t2);
+			}
+			// NaN (0 * inf on a slab boundary) keeps the current interval.
+			tmin = (t1 > tmin) ? t1 : tmin;
+			tmax = (t2 < tmax) ? t2 : tmax;
+			if (tmin > tmax)
+			{
+				return false;
+			}
+		}
+		outT = tmin;
+		return true;
+	}
+
+	class SceneBvh
+	{
+	public:
+		using ProxyId = std::uint32_t;
+		static constexpr ProxyId kNullProxy = std::numeric_limits<std::uint32_t>::max();
+
+		ProxyId Insert(const BvhAabb& box, std::uint32_t userData)
+		{
+			const std::uint32_t leaf = AllocateNode_();
+			Node& node = nodes_[leaf];
+			node.box = box;
+			node.userData = userData;
+			InsertLeaf_(leaf);
+			++leafCount_;
+			++editsSinceCheck_;
+			return leaf;
+		}
+
+		void Remove(ProxyId proxy)
+		{
+			if (!IsValid(proxy))
+			{
+				return;
+			}
+			RemoveLeaf_(proxy);
+			FreeNode_(proxy);
+			--leafCount_;
+			++editsSinceCheck_;
+		}
+
+		// Moves a leaf: refits its ancestors until a box stops changing.
+		void Update(ProxyId proxy, const BvhAabb& box)
+		{
+			if (!IsValid(proxy) || AabbEquals(nodes_[proxy].box, box))
+			{
+				return;
+			}
+			nodes_[proxy].box = box;
+			Refit_(nodes_[proxy].parent);
+			++editsSinceCheck_;
+		}
+
+		bool IsValid(ProxyId proxy) const noexcept
+		{
+			return proxy < nodes_.size() && nodes_[proxy].height == 0 && nodes_[proxy].child[0] == kNullProxy && !nodes_[proxy].free;
+		}
+
+		std::uint32_t GetUserData(ProxyId proxy) const noexcept { return nodes_[proxy].userData; }
+		const BvhAabb& GetBounds(ProxyId proxy) const noexcept { return nodes_[proxy].box; }
+		std::size_t GetLeafCount() const noexcept { return leafCount_; }
+
+		void Clear() noexcept
+		{
+			nodes_.clear();
+			root_ = kNullProxy;
+			freeList_ = kNullProxy;
+			leafCount_ = 0;
+			editsSinceCheck_ = 0;
+			rebuildCost_ = 0.0f;
+		}
+
+		// Sum of the internal node areas relative to the root area (the SAH traversal cost up to constants).
+		float ComputeCost() const noexcept
+		{
+			if (root_ == kNullProxy)
+			{
+				return 0.0f;
+			}
+			const float rootArea = SurfaceArea(nodes_[root_].box);
+			if (rootArea <= 0.0f)
+			{
+				return 0.0f;
+			}
+			float sum = 0.0f;
+			for (const Node& node : nodes_)
+			{
+				if (!node.free && node.child[0] != kNullProxy)
+				{
+					sum += SurfaceArea(node.box);
+				}
+			}
+			return sum / rootArea;
+		}
+
+		// Rebuilds once the incremental edits made the tree more than maxCostRatio times as expensive as the
+		// last rebuild. The cost is only measured after a batch of edits proportional to the tree size.
+		bool RebuildIfDegraded(float maxCostRatio = 1.5f)
+		{
+			const std::size_t checkInterval = std::max<std::size_t>(64, leafCount_ / 16);
+			if (editsSinceCheck_ < checkInterval)
+			{
+				return false;
+			}
+			editsSinceCheck_ = 0;
+			const float cost = ComputeCost();
+			if (rebuildCost_ > 0.0f && cost <= rebuildCost_ * maxCostRatio)
+			{
+				return false;
+			}
+			Rebuild();
+			return true;
+		}
+
+		// Top-down binned SAH build of the internal nodes over the current leaves.
+		void Rebuild()
+		{
+			std::vector<std::uint32_t> leaves;
+			leaves.reserve(leafCount_);
+			for (std::uint32_t i = 0; i < nodes_.size(); ++i)
+			{
+				Node& node = nodes_[i];
+				if (node.free)
+				{
+					continue;
+				}
+				if (node.child[0] == kNullProxy)
+				{
+					leaves.push_back(i);
+				}
+				else
+				{
+					FreeNode_(i);
+				}
+			}
+
+			root_ = leaves.empty() ? kNullProxy : Build_(leaves, 0, leaves.size());
+			if (root_ != kNullProxy)
+			{
+				nodes_[root_].parent = kNullProxy;
+			}
+			editsSinceCheck_ = 0;
+			rebuildCost_ = ComputeCost();
+		}
+
+		// nodeTest(const BvhAabb&) -> bool prunes subtrees, visit(ProxyId, userData) sees the leaves that pass.
+		template <typename NodeTest, typename Visit>
+		void Query(NodeTest&& nodeTest, Visit&& visit) const
+		{
+			if (root_ == kNullProxy)
+			{
+				return;
+			}
+			std::vector<std::uint32_t> stack;
+			stack.reserve(64);
+			stack.push_back(root_);
+			while (!stack.empty())
+			{
+				const std::uint32_t index = stack.back();
+				stack.pop_back();
+				const Node& node = nodes_[index];
+				if (!nodeTest(node.box))
+				{
+					continue;
+				}
+				if (node.child[0] == kNullProxy)
+				{
+					visit(index, node.userData);
+					continue;
+				}
+				stack.push_back(node.child[1]);
+				stack.push_back(node.child[0]);
+			}
+		}
+
+		template <typename Visit>
+		void QueryFrustum(const mathUtils::Frustum& frustum, Visit&& visit) const
+		{
+			Query([&frustum](const BvhAabb& box) { return IntersectsAabb(frustum, box); }, std::forward<Visit>(visit));
+		}
+
+		template <typename Visit>
+		void QueryOverlap(const BvhAabb& bounds, Visit&& visit) const
+		{
+			Query([&bounds](const BvhAabb& box) { return AabbOverlaps(bounds, box); }, std::forward<Visit>(visit));
+		}
+
+		// Closest-hit traversal: visit(ProxyId, userData, maxT) -> float returns the exact hit distance of the
+		// leaf (anything >= maxT is a miss) and shrinks the search. Children are visited near to far.
+		// Returns the closest accepted distance (maxT when nothing was hit).
+		template <typename Visit>
+		float RayCast(const mathUtils::Vec3& origin, const mathUtils::Vec3& dir, float maxT, Visit&& visit) const
+		{
+			if (root_ == kNullProxy)
+			{
+				return maxT;
+			}
+			const float inf = std::numeric_limits<float>::infinity();
+			const mathUtils::Vec3 invDir{
+				dir.x != 0.0f ? 1.0f / dir.x : inf,
+				dir.y != 0.0f ? 1.0f / dir.y : inf,
+				dir.z != 0.0f ? 1.0f / dir.z : inf };
+
+			std::vector<std::uint32_t> stack;
+			stack.reserve(64);
+			float entryT = 0.0f;
+			if (!IntersectRayAabb(origin, invDir, nodes_[root_].box, maxT, entryT))
+			{
+				return maxT;
+			}
+			stack.push_back(root_);
+			while (!stack.empty())
+			{
+				const std::uint32_t index = stack.back();
+				stack.pop_back();
+				const Node& node = nodes_[index];
+				float t = 0.0f;
+				if (!IntersectRayAabb(origin, invDir, node.box, maxT, t))
+				{
+					continue;
+				}
+				if (node.child[0] == kNullProxy)
+				{
+					const float hitT = visit(index, node.userData, maxT);
+					if (hitT < maxT)
+					{
+						maxT = hitT;
+					}
+					continue;
+				}
+
+				float t0 = inf;
+				float t1 = inf;
+				const bool hit0 = IntersectRayAabb(origin, invDir, nodes_[node.child[0]].box, maxT, t0);
+				const bool hit1 = IntersectRayAabb(origin, invDir, nodes_[node.child[1]].box, maxT, t1);
+				if (hit0 && hit1)
+				{
+					const bool firstNear = t0 <= t1;
+					stack.push_back(firstNear ? node.child[1] : node.child[0]);
+					stack.push_back(firstNear ? node.child[0] : node.child[1]);
+				}
+				else if (hit0)
+				{
+					stack.push_back(node.child[0]);
+				}
+				else if (hit1)
+				{
+					stack.push_back(node.child[1]);
+				}
+			}
+			return maxT;
+		}
+
+	private:
+		struct Node
+		{
+			BvhAabb box{};
+			std::uint32_t parent{ kNullProxy }; // next free node while on the free list
+			std::array<std::uint32_t, 2> child{ kNullProxy, kNullProxy };
+			std::uint32_t userData{ 0 };
+			std::uint32_t height{ 0 };
+			bool free{ false };
+		};
+
+		static constexpr std::uint32_t kBuildBins = 16;
+
+		std::uint32_t AllocateNode_()
+		{
+			if (freeList_ != kNullProxy)
+			{
+				const std::uint32_t index = freeList_;
+				freeList_ = nodes_[index].parent;
+				nodes_[index] = Node{};
+				return index;
+			}
+			nodes_.push_back(Node{});
+			return static_cast<std::uint32_t>(nodes_.size() - 1);
+		}
+
+		void FreeNode_(std::uint32_t index) noexcept
+		{
+			Node& node = nodes_[index];
+			node = Node{};
+			node.free = true;
+			node.parent = freeList_;
+			freeList_ = index;
+		}
+
+		void InsertLeaf_(std::uint32_t leaf)
+		{
+			if (root_ == kNullProxy)
+			{
+				root_ = leaf;
+				nodes_[leaf].parent = kNullProxy;
+				return;
+			}
+
+			// Descend towards the sibling with the smallest SAH increase; stop when creating a new parent here
+			// is cheaper than pushing the leaf further down.
+			const BvhAabb leafBox = nodes_[leaf].box;
+			std::uint32_t index = root_;
+			while (nodes_[index].child[0] != kNullProxy)
+			{
+				const Node& node = nodes_[index];
+				const float area = SurfaceArea(node.box);
+				const float combinedArea = SurfaceArea(UnionAabb(node.box, leafBox));
+				const float cost = 2.0f * combinedArea;
+				const float inheritanceCost = 2.0f * (combinedArea - area);
+
+				float childCost[2]{};
+				for (int c = 0; c < 2; ++c)
+				{
+					const Node& child = nodes_[node.child[c]];
+					const float merged = SurfaceArea(UnionAabb(child.box, leafBox));
+					childCost[c] = (child.child[0] == kNullProxy)
+						? merged + inheritanceCost
+						: (merged - SurfaceArea(child.box)) + inheritanceCost;
+				}
+
+				if (cost < childCost[0] && cost < childCost[1])
+				{
+					break;
+				}
+				index = (childCost[0] <= childCost[1]) ? node.child[0] : node.child[1];
+			}
+
+			const std::uint32_t sibling = index;
+			const std::uint32_t oldParent = nodes_[sibling].parent;
+			const std::uint32_t newParent = AllocateNode_();
+			Node& parentNode = nodes_[newParent];
+			parentNode.parent = oldParent;
+			parentNode.box = UnionAabb(leafBox, nodes_[sibling].box);
+			parentNode.child = { sibling, leaf };
+			parentNode.height = nodes_[sibling].height + 1;
+			nodes_[sibling].parent = newParent;
+			nodes_[leaf].parent = newParent;
+
+			if (oldParent == kNullProxy)
+			{
+				root_ = newParent;
+			}
+			else
+			{
+				Node& op = nodes_[oldParent];
+				op.child[op.child[0] == sibling ? 0 : 1] = newParent;
+			}
+			Refit_(oldParent);
+		}
+
+		void RemoveLeaf_(std::uint32_t leaf)
+		{
+			if (leaf == root_)
+			{
+				root_ = kNullProxy;
+				return;
+			}
+
+			const std::uint32_t parent = nodes_[leaf].parent;
+			const std::uint32_t grandParent = nodes_[parent].parent;
+			const std::uint32_t sibling = nodes_[parent].child[0] == leaf ? nodes_[parent].child[1] : nodes_[parent].child[0];
+
+			if (grandParent == kNullProxy)
+			{
+				root_ = sibling;
+				nodes_[sibling].parent = kNullProxy;
+			}
+			else
+			{
+				Node& gp = nodes_[grandParent];
+				gp.child[gp.child[0] == parent ? 0 : 1] = sibling;
+				nodes_[sibling].parent = grandParent;
+			}
+			FreeNode_(parent);
+			Refit_(grandParent);
+		}
+
+		void Refit_(std::uint32_t index) noexcept
+		{
+			while (index != kNullProxy)
+			{
+				Node& node = nodes_[index];
+				const BvhAabb box = UnionAabb(nodes_[node.child[0]].box, nodes_[node.child[1]].box);
+				const std::uint32_t height = 1 + std::max(nodes_[node.child[0]].height, nodes_[node.child[1]].height);
+				if (AabbEquals(box, node.box) && height == node.height)
+				{
+					return;
+				}
+				node.box = box;
+				node.height = height;
+				index = node.parent;
+			}
+		}
+
+		static mathUtils::Vec3 Centroid_(const BvhAabb& box) noexcept
+		{
+			return (box.min + box.max) * 0.5f;
+		}
+
+		static float Axis_(const mathUtils::Vec3& v, int axis) noexcept
+		{
+			return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+		}
+
+		std::uint32_t Build_(std::vector<std::uint32_t>& leaves, std::size_t begin, std::size_t end)
+		{
+			if (end - begin == 1)
+			{
+				return leaves[begin];
+			}
+
+			BvhAabb bounds = nodes_[leaves[begin]].box;
+			mathUtils::Vec3 cmin = Centroid_(bounds);
+			mathUtils::Vec3 cmax = cmin;
+			for (std::size_t i = begin + 1; i < end; ++i)
+			{
+				const BvhAabb& box = nodes_[leaves[i]].box;
+				bounds = UnionAabb(bounds, box);
+				const mathUtils::Vec3 c = Centroid_(box);
+				cmin = mathUtils::MinVec3(cmin, c);
+				cmax = mathUtils::MaxVec3(cmax, c);
+			}
+
+			const mathUtils::Vec3 extent = cmax - cmin;
+			const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+			const float axisMin = Axis_(cmin, axis);
+			const float axisExtent = Axis_(extent, axis);
+
+			std::size_t mid = begin + (end - begin) / 2;
+			bool split = false;
+			if (axisExtent > 0.0f)
+			{
+				const float binScale = static_cast<float>(kBuildBins) / axisExtent;
+				auto BinOf = [&](std::uint32_t leaf) noexcept -> std::uint32_t
+					{
+						const float c = Axis_(Centroid_(nodes_[leaf].box), axis);
+						const auto bin = static_cast<std::uint32_t>((c - axisMin) * binScale);
+						return std::min(bin, kBuildBins - 1);
+					};
+
+				std::array<BvhAabb, kBuildBins> binBox{};
+				std::array<std::uint32_t, kBuildBins> binCount{};
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const std::uint32_t bin = BinOf(leaves[i]);
+					binBox[bin] = (binCount[bin] == 0) ? nodes_[leaves[i]].box : UnionAabb(binBox[bin], nodes_[leaves[i]].box);
+					++binCount[bin];
+				}
+
+				// Right-to-left sweep for the right side areas, then pick the cheapest plane left to right.
+				std::array<float, kBuildBins> rightArea{};
+				std::array<std::uint32_t, kBuildBins> rightCount{};
+				BvhAabb accum{};
+				std::uint32_t count = 0;
+				for (std::uint32_t b = kBuildBins - 1; b > 0; --b)
+				{
+					if (binCount[b] != 0)
+					{
+						accum = (count == 0) ? binBox[b] : UnionAabb(accum, binBox[b]);
+						count += binCount[b];
+					}
+					rightArea[b] = (count == 0) ? 0.0f : SurfaceArea(accum);
+					rightCount[b] = count;
+				}
+
+				float bestCost = std::numeric_limits<float>::infinity();
+				std::uint32_t bestPlane = 0;
+				count = 0;
+				for (std::uint32_t b = 0; b + 1 < kBuildBins; ++b)
+				{
+					if (binCount[b] != 0)
+					{
+						accum = (count == 0) ? binBox[b] : UnionAabb(accum, binBox[b]);
+						count += binCount[b];
+					}
+					if (count == 0 || rightCount[b + 1] == 0)
+					{
+						continue;
+					}
+					const float cost = static_cast<float>(count) * SurfaceArea(accum) +
+						static_cast<float>(rightCount[b + 1]) * rightArea[b + 1];
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						bestPlane = b + 1;
+					}
+				}
+
+				if (bestCost < std::numeric_limits<float>::infinity())
+				{
+					const auto it = std::partition(leaves.begin() + static_cast<std::ptrdiff_t>(begin), leaves.begin() + static_cast<std::ptrdiff_t>(end),
+						[&](std::uint32_t leaf) { return BinOf(leaf) < bestPlane; });
+					mid = static_cast<std::size_t>(it - leaves.begin());
+					split = mid > begin && mid < end;
+				}
+			}
+			if (!split)
+			{
+				// Coincident centroids: split by count so the depth stays logarithmic.
+				mid = begin + (end - begin) / 2;
+				std::nth_element(leaves.begin() + static_cast<std::ptrdiff_t>(begin), leaves.begin() + static_cast<std::ptrdiff_t>(mid),
+					leaves.begin() + static_cast<std::ptrdiff_t>(end),
+					[&](std::uint32_t a, std::uint32_t b) { return Axis_(Centroid_(nodes_[a].box), axis) < Axis_(Centroid_(nodes_[b].box), axis); });
+			}
+
+			const std::uint32_t index = AllocateNode_();
+			const std::uint32_t left = Build_(leaves, begin, mid);
+			const std::uint32_t right = Build_(leaves, mid, end);
+			Node& node = nodes_[index];
+			node.box = bounds;
+			node.child = { left, right };
+			node.height = 1 + std::max(nodes_[left].height, nodes_[right].height);
+			nodes_[left].parent = index;
+			nodes_[right].parent = index;
+			return index;
+		}
+
+		std::vector<Node> nodes_;
+		std::uint32_t root_{ kNullProxy };
+		std::uint32_t freeList_{ kNullProxy };
+		std::size_t leafCount_{ 0 };
+		std::size_t editsSinceCheck_{ 0 };
+		float rebuildCost_{ 0.0f };
+	};
+}
@@ -70,6 +70,8 @@ struct LevelNode
 
 	bool visible{ true };
 	bool alive{ true }; // editor/runtime tombstone (keeps indices stable)
+	bool isStatic{ false }; // never moved at runtime: its draws may be cached in shadow maps
+	bool alwaysLoaded{ false }; // kept out of the streaming cells (see LevelStreamingDef)
 
 	Transform transform{};
 
@@ -88,6 +90,18 @@ struct LevelNode
 	std::unordered_map<std::uint32_t, std::string> materialOverrides; // submeshIndex -> materialId
 };
 
+// World partition. Renderable nodes are grouped into square XZ cells by the world position of their
+// root ancestor, and only the cells around the camera are instantiated (see LevelCellStreamer).
+// Skinned and alwaysLoaded nodes are never partitioned.
+struct LevelStreamingDef
+{
+	float cellSize{ 64.0f };
+	float loadRadius{ 128.0f };   // cells closer than this are loaded...
+	float unloadRadius{ 192.0f }; // ...and stay loaded until they are farther than this
+	std::uint64_t memoryBudgetBytes{ 0 }; // source bytes of the resident cells, 0: unlimited
+	std::uint32_t maxNodeOpsPerFrame{ 64 }; // node instantiations + teardowns per frame
+};
+
 struct LevelAsset
 {
 	std::string name;
@@ -108,10 +122,45 @@ struct LevelAsset
 	std::vector<Light> lights;
 	std::vector<ParticleEmitter> particleEmitters;
 	std::optional<std::string> skyboxTexture; // textureId
+	std::optional<LevelStreamingDef> streaming;
 
 	std::vector<LevelNode> nodes;
 };
 
+// -----------------------------
+// Prefetch manifest
+// -----------------------------
+enum class LevelPrefetchKind : std::uint8_t
+{
+	Texture,
+	Mesh
+};
+
+struct LevelPrefetchRequest
+{
+	LevelPrefetchKind kind{ LevelPrefetchKind::Texture };
+	std::string id;     // textureId, meshId or "<modelId>#submesh=<n>"
+	MeshProperties mesh{}; // Mesh only
+
+	// Closest node using the asset, from the spawn camera (infinity: not placed in the level).
+	float viewDistance{ std::numeric_limits<float>::infinity() };
+	std::uint64_t sizeBytes{ 0 }; // source file size, 0 if unknown
+};
+
+// Every texture and mesh a level needs, in issue order: nearest first, smaller first within a
+// distance band (bands double in width), unplaced assets last.
+struct LevelPrefetchManifest
+{
+	std::vector<LevelPrefetchRequest> requests;
+	std::unordered_map<std::string, ImportedModelScene> modelScenes; // modelId -> submesh layout
+};
+
+struct LevelPrefetch
+{
+	std::unordered_map<std::string, MeshHandle> meshes; // request id -> handle
+	std::shared_future<void> ready;                     // every request left Loading
+};
+
 // -----------------------------
 // LevelInstance (runtime glue)
 // -----------------------------
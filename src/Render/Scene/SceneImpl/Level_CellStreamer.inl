@@ -0,0 +1,117 @@
+// -----------------------------
+// Streaming cells (world partition)
+// -----------------------------
+// Unloaded -> Loading (cell prefetch in flight) -> Loaded (nodes instantiated a few per frame)
+// -> Unloading (nodes torn down a few per frame) -> Unloaded. LevelInstance::UpdateCellStreaming
+// drives the transitions; LevelCellStreamer only decides which cells should be resident.
+enum class LevelCellState : std::uint8_t
+{
+	Unloaded,
+	Loading,
+	Loaded,
+	Unloading
+};
+
+struct LevelCell
+{
+	std::int32_t x{ 0 };
+	std::int32_t z{ 0 };
+	std::vector<int> nodes;                     // streamed nodes, parents before children
+	std::vector<LevelPrefetchRequest> requests; // meshes/textures only these nodes use, nearest first
+	std::uint64_t sizeBytes{ 0 };               // source bytes of the requests
+
+	LevelCellState state{ LevelCellState::Unloaded };
+	std::uint32_t residentNodes{ 0 }; // nodes[0, residentNodes) are instantiated
+	bool wanted{ false };
+	float distance{ std::numeric_limits<float>::infinity() }; // XZ distance from the view at the last update
+};
+
+class LevelCellStreamer
+{
+public:
+	void Reset(const LevelStreamingDef& settings, std::vector<LevelCell> cells)
+	{
+		settings_ = settings;
+		cells_ = std::move(cells);
+		order_.resize(cells_.size());
+		for (std::uint32_t i = 0; i < order_.size(); ++i)
+		{
+			order_[i] = i;
+		}
+		enabled_ = true;
+	}
+
+	[[nodiscard]] bool IsEnabled() const noexcept { return enabled_; }
+	[[nodiscard]] const LevelStreamingDef& GetSettings() const noexcept { return settings_; }
+	[[nodiscard]] std::span<LevelCell> GetCells() noexcept { return cells_; }
+	[[nodiscard]] std::span<const LevelCell> GetCells() const noexcept { return cells_; }
+
+	// Cell indices in UpdateWanted priority order (nearest first, resident cells favoured).
+	[[nodiscard]] std::span<const std::uint32_t> GetOrder() const noexcept { return order_; }
+
+	[[nodiscard]] static std::int32_t CellCoord(float v, float cellSize) noexcept
+	{
+		return static_cast<std::int32_t>(std::floor(v / cellSize));
+	}
+
+	// Source bytes of every cell that is not Unloaded.
+	[[nodiscard]] std::uint64_t GetResidentBytes() const noexcept
+	{
+		std::uint64_t bytes = 0;
+		for (const LevelCell& cell : cells_)
+		{
+			if (cell.state != LevelCellState::Unloaded)
+			{
+				bytes += cell.sizeBytes;
+			}
+		}
+		return bytes;
+	}
+
+	// Picks the cells to keep resident: cells inside loadRadius, plus resident cells still inside
+	// unloadRadius, nearest first until the memory budget is spent. Resident cells rank as if they
+	// were (unloadRadius - loadRadius) closer, so two cells at a similar distance don't trade places
+	// every frame when only one of them fits the budget.
+	void UpdateWanted(const mathUtils::Vec3& viewPosition)
+	{
+		const float size = settings_.cellSize;
+		const float band = std::max(0.0f, settings_.unloadRadius - settings_.loadRadius);
+		rank_.resize(cells_.size());
+		for (std::size_t i = 0; i < cells_.size(); ++i)
+		{
+			LevelCell& cell = cells_[i];
+			const float minX = static_cast<float>(cell.x) * size;
+			const float minZ = static_cast<float>(cell.z) * size;
+			const float dx = std::max({ minX - viewPosition.x, 0.0f, viewPosition.x - (minX + size) });
+			const float dz = std::max({ minZ - viewPosition.z, 0.0f, viewPosition.z - (minZ + size) });
+			cell.distance = std::sqrt(dx * dx + dz * dz);
+			rank_[i] = cell.state != LevelCellState::Unloaded ? cell.distance - band : cell.distance;
+		}
+
+		std::sort(order_.begin(), order_.end(), [this](std::uint32_t a, std::uint32_t b)
+			{
+				return rank_[a] != rank_[b] ? rank_[a] < rank_[b] : a < b;
+			});
+
+		const std::uint64_t budget = settings_.memoryBudgetBytes != 0 ? settings_.memoryBudgetBytes : std::numeric_limits<std::uint64_t>::max();
+		std::uint64_t committed = 0;
+		for (const std::uint32_t index : order_)
+		{
+			LevelCell& cell = cells_[index];
+			const bool resident = cell.state != LevelCellState::Unloaded;
+			const bool inRange = cell.distance <= settings_.loadRadius || (resident && cell.distance <= settings_.unloadRadius);
+			cell.wanted = inRange && cell.sizeBytes <= budget - committed;
+			if (cell.wanted)
+			{
+				committed += cell.sizeBytes;
+			}
+		}
+	}
+
+private:
+	LevelStreamingDef settings_{};
+	std::vector<LevelCell> cells_;
+	std::vector<std::uint32_t> order_;
+	std::vector<float> rank_;
+	bool enabled_{ false };
+};
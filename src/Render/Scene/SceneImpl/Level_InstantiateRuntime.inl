@@ -18,69 +18,21 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 	// Particle emitters
 	inst.RebuildParticleEmitters(scene, asset);
 
-	auto IsTextureUsedAsNormalMap = [&](std::string_view textureId) -> bool
-	{
-		for (const auto& [_, md] : asset.materials)
-		{
-			for (const auto& [slot, boundTextureId] : md.textureBindings)
-			{
-				if (boundTextureId == textureId && slot == "normal")
-				{
-					return true;
-				}
-			}
-		}
-		return false;
-	};
-
-	// Textures: request loads (descriptor indices are resolved later)
-	for (const auto& [id, td] : asset.textures)
-	{
-		if (td.kind == LevelTextureKind::Tex2D)
-		{
-			TextureProperties p = td.props;
-			p.isNormalMap = p.isNormalMap || IsTextureUsedAsNormalMap(id);
-			assets.LoadTextureAsync(id, std::move(p));
-		}
-		else
-		{
-			TextureProperties p = td.props;
-			if (td.cubeSource == LevelCubeSource::Cross)
-			{
-				p.cubeFromCross = true;
-				assets.LoadTextureAsync(id, std::move(p));
-			}
-			else if (td.cubeSource == LevelCubeSource::AutoFaces)
-			{
-				if (!td.preferBase.empty())
-				{
-					assets.LoadTextureCubeAsync(id, td.baseOrDir, td.preferBase, std::move(p));
-				}
-				else
-				{
-					assets.LoadTextureCubeAsync(id, td.baseOrDir, std::move(p));
-				}
-			}
-			else
-			{
-				assets.LoadTextureCubeAsync(id, td.facePaths, std::move(p));
-			}
-		}
-	}
+	// World matrices first: the prefetch manifest orders loads by distance to the spawn camera.
+	inst.transformsDirty_ = true;
+	inst.UpdateDirtyWorld_(asset, nullptr);
+	inst.transformsDirty_ = false;
 
-	// Meshes: request loads
-	std::unordered_map<std::string, MeshHandle> meshHandles;
-	meshHandles.reserve(asset.meshes.size());
-	for (const auto& [id, md] : asset.meshes)
+	// Textures + meshes: every load is requested here in one batch (descriptor indices are
+	// resolved later). With streaming cells, what only cell nodes use waits for UpdateCellStreaming.
+	LevelPrefetchManifest manifest = BuildLevelPrefetchManifest(asset, inst.world_, scene.camera.position);
+	if (asset.streaming)
 	{
-		MeshProperties p{};
-		p.filePath = md.path;
-		p.debugName = md.debugName;
-		p.flipUVs = md.flipUVs;
-		p.submeshIndex = md.submeshIndex;
-		p.bakeNodeTransforms = md.bakeNodeTransforms;
-		meshHandles.emplace(id, assets.LoadMeshAsync(id, std::move(p)));
+		const std::unordered_set<std::string> heldBack = inst.BuildStreamingCells_(asset, manifest);
+		std::erase_if(manifest.requests, [&](const LevelPrefetchRequest& request) { return heldBack.contains(request.id); });
 	}
+	LevelPrefetch prefetch = IssueLevelPrefetch(assets, asset, manifest);
+	inst.ready_ = prefetch.ready;
 
 	// Materials: create in Scene and collect pending texture bindings
 	std::unordered_map<std::string, MaterialHandle> materialHandles;
@@ -126,11 +78,6 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 	inst.skinnedDrawToNode_.clear();
 	inst.skinnedDrawToNode_.reserve(asset.nodes.size());
 
-	// Compute world matrices (handles arbitrary parent order)
-	inst.transformsDirty_ = true;
-	inst.RecomputeWorld_(asset);
-	inst.transformsDirty_ = false;
-
 	for (std::size_t i = 0; i < asset.nodes.size(); ++i)
 	{
 		const LevelNode& n = asset.nodes[i];
@@ -147,10 +94,14 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 		{
 			continue;
 		}
+		if (i < inst.nodeStreamedOut_.size() && inst.nodeStreamedOut_[i] != 0)
+		{
+			continue;
+		}
 
 		if (!n.skinnedMesh.empty())
 		{
-			const int skinnedDrawIndex = inst.MakeSkinnedDrawForNode_(asset, scene, static_cast<int>(i), n);
+			const int skinnedDrawIndex = inst.MakeSkinnedDrawForNode_(asset, scene, assets, static_cast<int>(i), n);
 			inst.nodeToSkinnedDraw_[i] = skinnedDrawIndex;
 			continue;
 		}
@@ -162,16 +113,11 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 			{
 				throw std::runtime_error("Level JSON: node references unknown modelId: " + n.model);
 			}
-			const ImportedModelScene meta = LoadAssimpScene(modelIt->second.path, modelIt->second.flipUVs);
+			const ImportedModelScene& meta = manifest.modelScenes.at(n.model);
 			for (const ImportedSubmeshInfo& sub : meta.submeshes)
 			{
-				MeshProperties p{};
-				p.filePath = modelIt->second.path;
-				p.debugName = modelIt->second.debugName.empty() ? sub.name : (modelIt->second.debugName + "_" + sub.name);
-				p.flipUVs = modelIt->second.flipUVs;
-				p.submeshIndex = sub.submeshIndex;
 				const std::string meshKey = n.model + "#submesh=" + std::to_string(sub.submeshIndex);
-				MeshHandle mh = assets.LoadMeshAsync(meshKey, std::move(p));
+				MeshHandle mh = prefetch.meshes.at(meshKey);
 
 				std::string materialId = n.material;
 				if (auto itOv = n.materialOverrides.find(sub.submeshIndex); itOv != n.materialOverrides.end())
@@ -193,6 +139,7 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 				item.material = mat;
 				item.transform.useMatrix = true;
 				item.transform.matrix = inst.world_[i];
+				item.isStatic = n.isStatic;
 				const int drawIndex = static_cast<int>(scene.drawItems.size());
 				scene.AddDraw(item);
 				inst.drawToNode_.push_back(static_cast<int>(i));
@@ -202,8 +149,8 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 			continue;
 		}
 
-		auto meshIt = meshHandles.find(n.mesh);
-		if (meshIt == meshHandles.end())
+		auto meshIt = prefetch.meshes.find(n.mesh);
+		if (meshIt == prefetch.meshes.end())
 		{
 			throw std::runtime_error("Level JSON: node references unknown meshId: " + n.mesh);
 		}
@@ -224,6 +171,7 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 		item.material = mat;
 		item.transform.useMatrix = true;
 		item.transform.matrix = inst.world_[i];
+		item.isStatic = n.isStatic;
 
 		const int drawIndex = static_cast<int>(scene.drawItems.size());
 		scene.AddDraw(item);
@@ -250,7 +198,7 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 		const EntityHandle e = inst.ecs_.CreateEntity();
 		inst.nodeToEntity_[i] = e;
 
-		inst.ecs_.EmplaceNodeData(e, static_cast<int>(i), n.parent, n.transform, inst.world_[i], Flags{ .alive = n.alive, .visible = n.visible });
+		inst.ecs_.EmplaceNodeData(e, static_cast<int>(i), n.parent, n.transform, inst.world_[i], Flags{ .alive = n.alive, .visible = n.visible, .isStatic = n.isStatic });
 
 		// Renderable is optional (node can be non-renderable)
 		const int drawIndex = inst.nodeToDraw_[i];
@@ -13,70 +13,141 @@ namespace
 	// -----------------------------
 	// Supports: object, array, string, number, bool, null.
 	// Enough for small engine config/level files without third-party deps.
+	//
+	// The DOM is read-only and owned by the JsonParser that built it: nodes and member arrays come from one
+	// monotonic arena, strings are views into the source text (only strings containing escapes are unescaped,
+	// into the arena) and objects are member arrays sorted by key. The source text must outlive the parser.
 
 	struct JsonValue;
-	using JsonObject = std::unordered_map<std::string, JsonValue>;
-	using JsonArray = std::vector<JsonValue>;
+	struct JsonMember;
+	using JsonArray = std::span<const JsonValue>;
 
-	struct JsonValue
+	class JsonObject
 	{
-		using Storage = std::variant<std::nullptr_t, bool, double, std::string, JsonArray, JsonObject>;
-		Storage v{};
+	public:
+		JsonObject() = default;
+		explicit JsonObject(std::span<const JsonMember> members) noexcept : members_(members) {}
 
-		bool IsNull()   const noexcept { return std::holds_alternative<std::nullptr_t>(v); }
-		bool IsBool()   const noexcept { return std::holds_alternative<bool>(v); }
-		bool IsNumber() const noexcept { return std::holds_alternative<double>(v); }
-		bool IsString() const noexcept { return std::holds_alternative<std::string>(v); }
-		bool IsArray()  const noexcept { return std::holds_alternative<JsonArray>(v); }
-		bool IsObject() const noexcept { return std::holds_alternative<JsonObject>(v); }
+		auto begin() const noexcept { return members_.begin(); }
+		auto end() const noexcept { return members_.end(); }
+		std::size_t size() const noexcept { return members_.size(); }
+		bool empty() const noexcept { return members_.empty(); }
 
-		const JsonObject& AsObject() const
-		{
-			if (!IsObject()) throw std::runtime_error("JSON: expected object");
-			return std::get<JsonObject>(v);
-		}
-		const JsonArray& AsArray() const
+		// Binary search over the sorted members.
+		const JsonValue* Find(std::string_view key) const noexcept;
+
+	private:
+		std::span<const JsonMember> members_{};
+	};
+
+	struct JsonValue
+	{
+		enum class Kind : std::uint8_t
+		{
+			Null,
+			Bool,
+			Number,
+			String,
+			Array,
+			Object
+		};
+
+		Kind kind{ Kind::Null };
+		bool boolean{};
+		std::uint32_t count{}; // string length, array size or member count
+		union
+		{
+			double number{};
+			const char* chars;
+			const JsonValue* items;
+			const JsonMember* members;
+		};
+
+		bool IsNull()   const noexcept { return kind == Kind::Null; }
+		bool IsBool()   const noexcept { return kind == Kind::Bool; }
+		bool IsNumber() const noexcept { return kind == Kind::Number; }
+		bool IsString() const noexcept { return kind == Kind::String; }
+		bool IsArray()  const noexcept { return kind == Kind::Array; }
+		bool IsObject() const noexcept { return kind == Kind::Object; }
+
+		JsonObject AsObject() const;
+		JsonArray AsArray() const
 		{
 			if (!IsArray()) throw std::runtime_error("JSON: expected array");
-			return std::get<JsonArray>(v);
+			return JsonArray(items, count);
 		}
-		const std::string& AsString() const
+		std::string_view AsString() const
 		{
 			if (!IsString()) throw std::runtime_error("JSON: expected string");
-			return std::get<std::string>(v);
+			return std::string_view(chars, count);
 		}
 		double AsNumber() const
 		{
 			if (!IsNumber()) throw std::runtime_error("JSON: expected number");
-			return std::get<double>(v);
+			return number;
 		}
 		bool AsBool() const
 		{
 			if (!IsBool()) throw std::runtime_error("JSON: expected bool");
-			return std::get<bool>(v);
+			return boolean;
 		}
 	};
 
+	struct JsonMember
+	{
+		std::string_view key;
+		JsonValue value;
+	};
+
+	inline const JsonValue* JsonObject::Find(std::string_view key) const noexcept
+	{
+		const auto it = std::lower_bound(members_.begin(), members_.end(), key,
+			[](const JsonMember& member, std::string_view k) { return member.key < k; });
+		return (it != members_.end() && it->key == key) ? &it->value : nullptr;
+	}
+
+	inline JsonObject JsonValue::AsObject() const
+	{
+		if (!IsObject()) throw std::runtime_error("JSON: expected object");
+		return JsonObject(std::span<const JsonMember>(members, count));
+	}
+
 	class JsonParser
 	{
 	public:
-		explicit JsonParser(std::string_view text) : text_(text) {}
+		explicit JsonParser(std::string_view text)
+			: text_(text)
+			, arena_(std::max<std::size_t>(text.size(), 1024), memory::TrackingResource(memory::MemoryTag::Level))
+			, valueStack_(memory::TrackingResource(memory::MemoryTag::Level))
+			, memberStack_(memory::TrackingResource(memory::MemoryTag::Level))
+		{
+		}
 
-		JsonValue Parse()
+		JsonParser(const JsonParser&) = delete;
+		JsonParser& operator=(const JsonParser&) = delete;
+
+		// The returned tree stays valid while this parser (and the source text) is alive.
+		const JsonValue& Parse()
 		{
 			SkipWs();
-			JsonValue out = ParseValue();
+			root_ = ParseValue();
 			SkipWs();
 			if (pos_ != text_.size())
 			{
 				Throw("unexpected trailing characters");
 			}
-			return out;
+			return root_;
 		}
 
 	private:
 		std::string_view text_;
 		std::size_t pos_{};
+		// Everything the parser allocates is charged to MemoryTag::Level.
+		std::pmr::monotonic_buffer_resource arena_;
+		// Children of the containers being parsed; each container moves its tail into the arena when it closes.
+		std::pmr::vector<JsonValue> valueStack_;
+		std::pmr::vector<JsonMember> memberStack_;
+		JsonValue root_{};
 
 		[[noreturn]] void Throw(std::string_view msg) const
 		{
@@ -131,6 +202,25 @@ namespace
 			return false;
 		}
 
+		template <typename T>
+		const T* CopyToArena(std::span<const T> items)
+		{
+			if (items.empty())
+			{
+				return nullptr;
+			}
+			T* out = static_cast<T*>(arena_.allocate(items.size_bytes(), alignof(T)));
+			std::uninitialized_copy(items.begin(), items.end(), out);
+			return out;
+		}
+
+		static JsonValue MakeScalar(JsonValue::Kind kind) noexcept
+		{
+			JsonValue v;
+			v.kind = kind;
+			return v;
+		}
+
 		JsonValue ParseValue()
 		{
 			SkipWs();
@@ -140,16 +230,20 @@ namespace
 			case '[': return ParseArray();
 			case '"':
 			{
-				JsonValue v; v.v = ParseString(); return v;
+				const std::string_view s = ParseString();
+				JsonValue v = MakeScalar(JsonValue::Kind::String);
+				v.chars = s.data();
+				v.count = static_cast<std::uint32_t>(s.size());
+				return v;
 			}
 			case 't':
-				if (Match("true")) { JsonValue v; v.v = true; return v; }
+				if (Match("true")) { JsonValue v = MakeScalar(JsonValue::Kind::Bool); v.boolean = true; return v; }
 				break;
 			case 'f':
-				if (Match("false")) { JsonValue v; v.v = false; return v; }
+				if (Match("false")) { return MakeScalar(JsonValue::Kind::Bool); }
 				break;
 			case 'n':
-				if (Match("null")) { JsonValue v; v.v = nullptr; return v; }
+				if (Match("null")) { return MakeScalar(JsonValue::Kind::Null); }
 				break;
 			default:
 				break;
@@ -158,7 +252,9 @@ namespace
 			// number
 			if (Peek() == '-' || (Peek() >= '0' && Peek() <= '9'))
 			{
-				JsonValue v; v.v = ParseNumber(); return v;
+				JsonValue v = MakeScalar(JsonValue::Kind::Number);
+				v.number = ParseNumber();
+				return v;
 			}
 
 			Throw("unexpected token");
@@ -167,59 +263,75 @@ namespace
 		JsonValue ParseObject()
 		{
 			Expect('{');
-			JsonObject obj;
+			const std::size_t first = memberStack_.size();
 			SkipWs();
 			if (Peek() == '}')
 			{
 				Get();
-				JsonValue v; v.v = std::move(obj); return v;
 			}
-
-			while (true)
+			else
 			{
-				SkipWs();
-				if (Peek() != '"') Throw("expected string key");
-				std::string key = ParseString();
-				Expect(':');
-				JsonValue value = ParseValue();
-				obj.emplace(std::move(key), std::move(value));
-				SkipWs();
-				const char c = Get();
-				if (c == '}') break;
-				if (c != ',') Throw("expected ',' or '}'");
+				while (true)
+				{
+					SkipWs();
+					if (Peek() != '"') Throw("expected string key");
+					const std::string_view key = ParseString();
+					Expect(':');
+					const JsonValue value = ParseValue();
+					memberStack_.push_back(JsonMember{ key, value });
+					SkipWs();
+					const char c = Get();
+					if (c == '}') break;
+					if (c != ',') Throw("expected ',' or '}'");
+				}
 			}
 
-			JsonValue v; v.v = std::move(obj); return v;
+			// Sort for binary-search lookups; for duplicate keys the first one wins.
+			const auto begin = memberStack_.begin() + static_cast<std::ptrdiff_t>(first);
+			std::stable_sort(begin, memberStack_.end(), [](const JsonMember& a, const JsonMember& b) { return a.key < b.key; });
+			const auto end = std::unique(begin, memberStack_.end(), [](const JsonMember& a, const JsonMember& b) { return a.key == b.key; });
+
+			JsonValue v = MakeScalar(JsonValue::Kind::Object);
+			v.count = static_cast<std::uint32_t>(end - begin);
+			v.members = CopyToArena(std::span<const JsonMember>(memberStack_.data() + first, v.count));
+			memberStack_.resize(first);
+			return v;
 		}
 
 		JsonValue ParseArray()
 		{
 			Expect('[');
-			JsonArray arr;
+			const std::size_t first = valueStack_.size();
 			SkipWs();
 			if (Peek() == ']')
 			{
 				Get();
-				JsonValue v; v.v = std::move(arr); return v;
 			}
-
-			while (true)
+			else
 			{
-				JsonValue value = ParseValue();
-				arr.push_back(std::move(value));
-				SkipWs();
-				const char c = Get();
-				if (c == ']') break;
-				if (c != ',') Throw("expected ',' or ']'");
+				while (true)
+				{
+					const JsonValue value = ParseValue();
+					valueStack_.push_back(value);
+					SkipWs();
+					const char c = Get();
+					if (c == ']') break;
+					if (c != ',') Throw("expected ',' or ']'");
+				}
 			}
 
-			JsonValue v; v.v = std::move(arr); return v;
+			JsonValue v = MakeScalar(JsonValue::Kind::Array);
+			v.count = static_cast<std::uint32_t>(valueStack_.size() - first);
+			v.items = CopyToArena(std::span<const JsonValue>(valueStack_.data() + first, v.count));
+			valueStack_.resize(first);
+			return v;
 		}
 
-		std::string ParseString()
+		std::string_view ParseString()
 		{
 			Expect('"');
-			std::string out;
+			const std::size_t start = pos_;
+			bool escaped = false;
 			while (true)
 			{
 				const char c = Get();
@@ -229,31 +341,52 @@ namespace
 				}
 				if (c == '\\')
 				{
-					const char e = Get();
-					switch (e)
+					escaped = true;
+					switch (Get())
 					{
-					case '"': out.push_back('"'); break;
-					case '\\': out.push_back('\\'); break;
-					case '/': out.push_back('/'); break;
-					case 'b': out.push_back('\b'); break;
-					case 'f': out.push_back('\f'); break;
-					case 'n': out.push_back('\n'); break;
-					case 'r': out.push_back('\r'); break;
-					case 't': out.push_back('\t'); break;
+					case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+						break;
 					case 'u':
-						// Minimal handling: consume 4 hex digits and emit '?' (UTF-16 not needed for our configs).
 						for (int i = 0; i < 4; ++i) { Get(); }
-						out.push_back('?');
 						break;
 					default:
 						Throw("invalid string escape");
 					}
-					continue;
 				}
+			}
 
-				out.push_back(c);
+			const std::string_view raw = text_.substr(start, pos_ - 1 - start);
+			return escaped ? Unescape(raw) : raw;
+		}
+
+		// Escapes were validated by ParseString; the unescaped text is never longer than the raw one.
+		std::string_view Unescape(std::string_view raw)
+		{
+			char* out = static_cast<char*>(arena_.allocate(raw.size(), 1));
+			std::size_t n = 0;
+			for (std::size_t i = 0; i < raw.size(); ++i)
+			{
+				if (raw[i] != '\\')
+				{
+					out[n++] = raw[i];
+					continue;
+				}
+				switch (raw[++i])
+				{
+				case 'b': out[n++] = '\b'; break;
+				case 'f': out[n++] = '\f'; break;
+				case 'n': out[n++] = '\n'; break;
+				case 'r': out[n++] = '\r'; break;
+				case 't': out[n++] = '\t'; break;
+				case 'u':
+					// Minimal handling: skip 4 hex digits and emit '?' (UTF-16 not needed for our configs).
+					i += 4;
+					out[n++] = '?';
+					break;
+				default: out[n++] = raw[i]; break; // '"', '\\', '/'
+				}
 			}
-			return out;
+			return std::string_view(out, n);
 		}
 
 		double ParseNumber()
@@ -283,10 +416,9 @@ namespace
 				while (Peek() >= '0' && Peek() <= '9') ++pos_;
 			}
 
-			const std::string tmp(text_.substr(start, pos_ - start));
-			char* endPtr = nullptr;
-			double v = std::strtod(tmp.c_str(), &endPtr);
-			if (endPtr == tmp.c_str())
+			double v = 0.0;
+			const auto [ptr, ec] = std::from_chars(text_.data() + start, text_.data() + pos_, v);
+			if (ec != std::errc{} || ptr == text_.data() + start)
 			{
 				Throw("invalid number");
 			}
@@ -299,11 +431,7 @@ namespace
 	// -----------------------------
 	const JsonValue* TryGet(const JsonObject& jsonObject, std::string_view key)
 	{
-		if (auto it = jsonObject.find(std::string(key)); it != jsonObject.end())
-		{
-			return &it->second;
-		}
-		return nullptr;
+		return jsonObject.Find(key);
 	}
 
 	const JsonValue& GetReq(const JsonObject& o, std::string_view key)
@@ -319,7 +447,7 @@ namespace
 	{
 		if (auto* v = TryGet(o, key))
 		{
-			if (v->IsString()) return v->AsString();
+			if (v->IsString()) return std::string(v->AsString());
 			throw std::runtime_error(std::string("Level JSON: expected string at '") + std::string(key) + "'");
 		}
 		return def;
@@ -399,7 +527,7 @@ namespace
 			throw std::runtime_error("Level JSON: materials." + std::string(materialId) + ".envSource must be a string");
 		}
 
-		const std::string s = ToLowerAscii(v.AsString());
+		const std::string s = ToLowerAscii(std::string(v.AsString()));
 		if (s == "skybox")
 		{
 			return rendern::EnvSource::Skybox;
@@ -427,7 +555,7 @@ namespace
 			{
 				throw std::runtime_error("Level JSON: material.flags entries must be strings");
 			}
-			const std::string& s = it.AsString();
+			const std::string s(it.AsString());
 			const std::string norm = ToLowerAscii(s);
 			if (norm == "useshadow" || norm == "use_shadow") flags |= rendern::MaterialPerm::UseShadow;
 			else if (norm == "transparent") flags |= rendern::MaterialPerm::Transparent;
@@ -457,7 +585,109 @@ namespace
 		return m;
 	}
 
-	void WriteJsonEscaped(std::ostream& os, std::string_view s)
+	// Buffered text sink for the level writer. Output collects in a per-thread chunk that is handed to the
+	// file whenever it fills, so a save never holds the whole document in memory. Numbers are formatted
+	// with std::to_chars; floats keep the fixed 6-digit form the writer has always produced.
+	class JsonFileWriter
+	{
+	public:
+		static constexpr std::size_t kChunkBytes = 64u * 1024u;
+
+		explicit JsonFileWriter(const std::filesystem::path& path)
+			: file_(path, std::ios::binary | std::ios::trunc)
+			, chunk_(ThreadChunk_())
+		{
+		}
+
+		JsonFileWriter(const JsonFileWriter&) = delete;
+		JsonFileWriter& operator=(const JsonFileWriter&) = delete;
+
+		[[nodiscard]] bool IsOpen() const noexcept { return file_.is_open(); }
+
+		JsonFileWriter& operator<<(char c)
+		{
+			if (used_ == chunk_.size())
+			{
+				Flush_();
+			}
+			chunk_[used_++] = c;
+			return *this;
+		}
+
+		JsonFileWriter& operator<<(std::string_view s)
+		{
+			Write_(s.data(), s.size());
+			return *this;
+		}
+
+		JsonFileWriter& operator<<(const char* s) { return *this << std::string_view(s); }
+		JsonFileWriter& operator<<(const std::string& s) { return *this << std::string_view(s); }
+
+		template <typename T>
+			requires std::is_integral_v<T> && (!std::is_same_v<T, bool>) && (!std::is_same_v<T, char>)
+		JsonFileWriter& operator<<(T v)
+		{
+			char buf[24];
+			const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), v);
+			Write_(buf, static_cast<std::size_t>(r.ptr - buf));
+			return *this;
+		}
+
+		JsonFileWriter& operator<<(float v)
+		{
+			// Largest finite float in fixed notation: sign + 39 digits + '.' + 6 decimals.
+			char buf[64];
+			const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::fixed, 6);
+			Write_(buf, static_cast<std::size_t>(r.ptr - buf));
+			return *this;
+		}
+
+		// Hands the buffered tail to the file; false if any write failed.
+		[[nodiscard]] bool Finish()
+		{
+			Flush_();
+			file_.flush();
+			return static_cast<bool>(file_);
+		}
+
+	private:
+		// One chunk per thread, reused across saves (the async save runs on a job worker).
+		static std::span<char> ThreadChunk_()
+		{
+			thread_local std::vector<char> chunk(kChunkBytes);
+			return chunk;
+		}
+
+		void Write_(const char* data, std::size_t size)
+		{
+			if (size > chunk_.size() - used_)
+			{
+				Flush_();
+				if (size >= chunk_.size())
+				{
+					file_.write(data, static_cast<std::streamsize>(size));
+					return;
+				}
+			}
+			std::memcpy(chunk_.data() + used_, data, size);
+			used_ += size;
+		}
+
+		void Flush_()
+		{
+			if (used_ != 0)
+			{
+				file_.write(chunk_.data(), static_cast<std::streamsize>(used_));
+				used_ = 0;
+			}
+		}
+
+		std::ofstream file_;
+		std::span<char> chunk_;
+		std::size_t used_{ 0 };
+	};
+
+	void WriteJsonEscaped(JsonFileWriter& os, std::string_view s)
 	{
 		os << '"';
 		for (char c : s)
@@ -487,17 +717,17 @@ namespace
 		os << '"';
 	}
 
-	void WriteJsonBool(std::ostream& os, bool v)
+	void WriteJsonBool(JsonFileWriter& os, bool v)
 	{
 		os << (v ? "true" : "false");
 	}
 
-	void WriteJsonFloat(std::ostream& os, float v)
+	void WriteJsonFloat(JsonFileWriter& os, float v)
 	{
 		os << (std::isfinite(v) ? v : 0.0f);
 	}
 
-	void WriteJsonVec3(std::ostream& os, const mathUtils::Vec3& v)
+	void WriteJsonVec3(JsonFileWriter& os, const mathUtils::Vec3& v)
 	{
 		os << '[';
 		WriteJsonFloat(os, v.x); os << ',';
@@ -506,7 +736,7 @@ namespace
 		os << ']';
 	}
 
-	void WriteJsonVec4(std::ostream& os, const mathUtils::Vec4& v)
+	void WriteJsonVec4(JsonFileWriter& os, const mathUtils::Vec4& v)
 	{
 		os << '[';
 		WriteJsonFloat(os, v.x); os << ',';
@@ -516,7 +746,7 @@ namespace
 		os << ']';
 	}
 
-	void WriteJsonMat4ColMajor16(std::ostream& os, const mathUtils::Mat4& m)
+	void WriteJsonMat4ColMajor16(JsonFileWriter& os, const mathUtils::Mat4& m)
 	{
 		os << '[';
 		for (int col = 0; col < 4; ++col)
@@ -5,7 +5,7 @@
 void SetRootTransform(const mathUtils::Mat4& root)
 {
 	root_ = root;
-	transformsDirty_ = true;
+	MarkTransformsDirty();
 }
 
 bool IsValidNodeIndex(const LevelAsset& asset, int nodeIndex) const noexcept
@@ -102,6 +102,63 @@ const LevelWorld& GetLevelWorld() const noexcept
 	return ecs_;
 }
 
+// Brings the picking BVH up to date with the renderables whose transform, mesh or lifetime changed since the
+// last call (leaves are keyed by node index, their boxes are the world AABBs picking tests against).
+const SceneBvh& RefreshPickBvh(const Scene& scene)
+{
+	if (pickBvhAllDirty_)
+	{
+		pickBvhAllDirty_ = false;
+		pickBvh_.Clear();
+		nodePickProxy_.assign(nodeToEntity_.size(), SceneBvh::kNullProxy);
+		pickBoundsDirty_.assign(nodeToEntity_.size(), 0);
+		pickDirtyNodes_.clear();
+		pickPendingNodes_.clear();
+		for (std::size_t i = 0; i < nodeToEntity_.size(); ++i)
+		{
+			pickDirtyNodes_.push_back(static_cast<int>(i));
+		}
+	}
+
+	std::vector<int> pending;
+	pending.swap(pickPendingNodes_);
+	for (const int nodeIndex : pending)
+	{
+		if (static_cast<std::size_t>(nodeIndex) >= pickBoundsDirty_.size() || pickBoundsDirty_[static_cast<std::size_t>(nodeIndex)] == 0)
+		{
+			pickDirtyNodes_.push_back(nodeIndex);
+		}
+	}
+
+	for (const int nodeIndex : pickDirtyNodes_)
+	{
+		if (static_cast<std::size_t>(nodeIndex) < pickBoundsDirty_.size())
+		{
+			pickBoundsDirty_[static_cast<std::size_t>(nodeIndex)] = 0;
+		}
+		if (!UpdatePickProxy_(scene, nodeIndex))
+		{
+			pickPendingNodes_.push_back(nodeIndex);
+		}
+	}
+	pickDirtyNodes_.clear();
+
+	pickBvh_.RebuildIfDegraded();
+	return pickBvh_;
+}
+
+// World AABB of the node's picking proxy as of the last RefreshPickBvh; false when it has none.
+bool TryGetNodePickBounds(int nodeIndex, BvhAabb& outBounds) const noexcept
+{
+	if (nodeIndex < 0 || static_cast<std::size_t>(nodeIndex) >= nodePickProxy_.size() ||
+		nodePickProxy_[static_cast<std::size_t>(nodeIndex)] == SceneBvh::kNullProxy)
+	{
+		return false;
+	}
+	outBounds = pickBvh_.GetBounds(nodePickProxy_[static_cast<std::size_t>(nodeIndex)]);
+	return true;
+}
+
 EntityHandle GetNodeEntity(int nodeIndex) const noexcept
 {
 	return GetEntityForNode_(nodeIndex);
@@ -303,7 +360,7 @@ int AddNode(LevelAsset& asset,
 	SyncEntityRenderableForNode_(asset, scene, newIndex);
 	SyncEditorRuntimeBindings(asset, scene);
 	ValidateRuntimeMappingsDebug(asset, scene);
-	transformsDirty_ = true;
+	MarkTransformsDirty();
 	return newIndex;
 }
 
@@ -574,7 +631,7 @@ int ImportModelSceneAsNodes(LevelAsset& asset,
 
 	SyncEditorRuntimeBindings(asset, scene);
 	ValidateRuntimeMappingsDebug(asset, scene);
-	transformsDirty_ = true;
+	MarkTransformsDirty();
 	return firstImportedNode;
 }
 
@@ -603,7 +660,7 @@ void DeleteSubtree(LevelAsset& asset, Scene& scene, int rootNodeIndex)
 
 	SyncEditorRuntimeBindings(asset, scene);
 	ValidateRuntimeMappingsDebug(asset, scene);
-	transformsDirty_ = true;
+	MarkTransformsDirty();
 }
 
 void SetNodeVisible(LevelAsset& asset, Scene& scene, AssetManager& assets, int nodeIndex, bool visible)
@@ -621,6 +678,28 @@ void SetNodeVisible(LevelAsset& asset, Scene& scene, AssetManager& assets, int n
 	ValidateRuntimeMappingsDebug(asset, scene);
 }
 
+void SetNodeStatic(LevelAsset& asset, Scene& scene, int nodeIndex, bool isStatic)
+{
+	if (!IsNodeAlive(asset, nodeIndex))
+		return;
+
+	const std::size_t i = static_cast<std::size_t>(nodeIndex);
+	asset.nodes[i].isStatic = isStatic;
+	if (i < nodeToDraws_.size())
+	{
+		for (const int di : nodeToDraws_[i])
+		{
+			if (di >= 0 && static_cast<std::size_t>(di) < scene.drawItems.size())
+			{
+				scene.drawItems[static_cast<std::size_t>(di)].isStatic = isStatic;
+			}
+		}
+	}
+
+	EnsureEntityForNode_(asset, nodeIndex);
+	SyncEntityRenderableForNode_(asset, scene, nodeIndex);
+}
+
 void SetNodeMesh(LevelAsset& asset, Scene& scene, AssetManager& assets, int nodeIndex, std::string_view meshId)
 {
 	if (!IsNodeAlive(asset, nodeIndex))
@@ -843,9 +922,54 @@ void SetNodeMaterial(LevelAsset& asset, Scene& scene, int nodeIndex, std::string
 	ValidateRuntimeMappingsDebug(asset, scene);
 }
 
+// Everything (hierarchy included) is recomputed by the next SyncTransformsIfDirty.
 void MarkTransformsDirty() noexcept
 {
 	transformsDirty_ = true;
+	worldOrderDirty_ = true;
+	allWorldDirty_ = true;
+}
+
+// Only this node's local transform changed: the next SyncTransformsIfDirty recomputes its subtree.
+void MarkNodeTransformDirty(int nodeIndex)
+{
+	if (nodeIndex < 0)
+	{
+		return;
+	}
+	const std::size_t i = static_cast<std::size_t>(nodeIndex);
+	if (worldNodeDirty_.size() <= i)
+	{
+		worldNodeDirty_.resize(i + 1, 0);
+	}
+	worldNodeDirty_[i] = 1;
+	transformsDirty_ = true;
+}
+
+// Batch form of MarkNodeTransformDirty (gameplay publishes every moved node at once).
+void MarkNodeTransformsDirty(std::span<const int> nodeIndices)
+{
+	int maxIndex = -1;
+	for (const int nodeIndex : nodeIndices)
+	{
+		maxIndex = std::max(maxIndex, nodeIndex);
+	}
+	if (maxIndex < 0)
+	{
+		return;
+	}
+	if (worldNodeDirty_.size() <= static_cast<std::size_t>(maxIndex))
+	{
+		worldNodeDirty_.resize(static_cast<std::size_t>(maxIndex) + 1, 0);
+	}
+	for (const int nodeIndex : nodeIndices)
+	{
+		if (nodeIndex >= 0)
+		{
+			worldNodeDirty_[static_cast<std::size_t>(nodeIndex)] = 1;
+		}
+	}
+	transformsDirty_ = true;
 }
 
 void SyncEditorRuntimeBindings(const LevelAsset& asset, Scene& scene) const noexcept
@@ -968,15 +1092,15 @@ void ValidateRuntimeMappingsDebug(const LevelAsset& asset, const Scene& scene) c
 #endif
 }
 
-// Recompute world transforms (with hierarchy) and push to Scene draw items.
-void SyncTransformsIfDirty(const LevelAsset& asset, Scene& scene)
+// Recompute the world transforms of dirty subtrees and push the changed ones to the Scene draw items and ECS.
+void SyncTransformsIfDirty(const LevelAsset& asset, Scene& scene, jobs::Scheduler* scheduler = nullptr)
 {
 	if (!transformsDirty_)
 		return;
 
-	RecomputeWorld_(asset);
+	UpdateDirtyWorld_(asset, scheduler);
 
-	// Push to Scene + ECS
+	// Push the changed nodes to Scene + ECS
 	const std::size_t ncount = asset.nodes.size();
 	if (nodeToDraw_.size() < ncount)
 		nodeToDraw_.resize(ncount, -1);
@@ -987,35 +1111,18 @@ void SyncTransformsIfDirty(const LevelAsset& asset, Scene& scene)
 	if (nodeToSkinnedDraw_.size() < ncount)
 		nodeToSkinnedDraw_.resize(ncount, -1);
 
-	for (std::size_t i = 0; i < ncount; ++i)
+	for (const int nodeIndex : changedWorldNodes_)
 	{
+		const std::size_t i = static_cast<std::size_t>(nodeIndex);
 		const LevelNode& n = asset.nodes[i];
-		if (!n.alive)
-		{
-			continue;
-		}
 
-		const EntityHandle e = EnsureEntityForNode_(asset, static_cast<int>(i));
+		const EntityHandle e = EnsureEntityForNode_(asset, nodeIndex);
 		if (e != kNullEntity)
 		{
-			ecs_.UpsertNodeData(e, static_cast<int>(i), n.parent, n.transform, world_[i], Flags{ .alive = n.alive, .visible = n.visible });
-		}
-
-		const auto& drawIndices = (i < nodeToDraws_.size()) ? nodeToDraws_[i] : std::vector<int>{};
-		const int skinnedDrawIndex = (i < nodeToSkinnedDraw_.size()) ? nodeToSkinnedDraw_[i] : -1;
-		if (drawIndices.empty())
-		{
-			if (skinnedDrawIndex >= 0 && static_cast<std::size_t>(skinnedDrawIndex) < scene.skinnedDrawItems.size())
-			{
-				SkinnedDrawItem& item = scene.skinnedDrawItems[static_cast<std::size_t>(skinnedDrawIndex)];
-				item.transform.useMatrix = true;
-				item.transform.matrix = world_[i];
-			}
-			SyncEntityRenderableForNode_(asset, scene, static_cast<int>(i));
-			continue;
+			ecs_.UpsertNodeData(e, nodeIndex, n.parent, n.transform, world_[i], Flags{ .alive = n.alive, .visible = n.visible, .isStatic = n.isStatic });
 		}
 
-		for (const int di : drawIndices)
+		for (const int di : nodeToDraws_[i])
 		{
 			if (di < 0 || static_cast<std::size_t>(di) >= scene.drawItems.size())
 			{
@@ -1024,8 +1131,10 @@ void SyncTransformsIfDirty(const LevelAsset& asset, Scene& scene)
 			DrawItem& item = scene.drawItems[static_cast<std::size_t>(di)];
 			item.transform.useMatrix = true;
 			item.transform.matrix = world_[i];
+			item.isStatic = n.isStatic;
 		}
 
+		const int skinnedDrawIndex = nodeToSkinnedDraw_[i];
 		if (skinnedDrawIndex >= 0 && static_cast<std::size_t>(skinnedDrawIndex) < scene.skinnedDrawItems.size())
 		{
 			SkinnedDrawItem& item = scene.skinnedDrawItems[static_cast<std::size_t>(skinnedDrawIndex)];
@@ -1033,7 +1142,7 @@ void SyncTransformsIfDirty(const LevelAsset& asset, Scene& scene)
 			item.transform.matrix = world_[i];
 		}
 
-		SyncEntityRenderableForNode_(asset, scene, static_cast<int>(i));
+		SyncEntityRenderableForNode_(asset, scene, nodeIndex);
 	}
 
 	SyncEditorRuntimeBindings(asset, scene);
@@ -20,11 +20,14 @@ rhi::TextureDescIndex GetOrCreateTextureDesc_(
 
 	if (auto it = textureDesc_.find(key); it != textureDesc_.end())
 	{
+		// No GPU texture (evicted, reloading): keep the descriptor for when it comes back but
+		// don't hand it out, it still points at the released texture.
 		const rhi::TextureHandle handle = TryGetTextureHandle_(rm, textureId);
-		if (handle)
+		if (!handle)
 		{
-			bindless.UpdateTexture(it->second, handle);
+			return 0;
 		}
+		bindless.UpdateTexture(it->second, handle);
 		return it->second;
 	}
 
@@ -101,7 +104,9 @@ const LevelAnimationDef& GetAnimationDef_(const LevelAsset& asset, const std::st
 	return it->second;
 }
 
-std::shared_ptr<SkinnedAssetBundle> GetOrLoadBaseSkinnedAssetBundle_(const LevelAsset& asset, const std::string& skinnedMeshId)
+// The source bundle itself (shared with every level using the same file), so nodes without
+// external animations also share one skinned mesh upload in the renderer.
+std::shared_ptr<const SkinnedAssetBundle> GetOrLoadBaseSkinnedAssetBundle_(const LevelAsset& asset, AssetManager& assets, const std::string& skinnedMeshId)
 {
 	if (auto it = baseSkinnedAssetCache_.find(skinnedMeshId); it != baseSkinnedAssetCache_.end())
 	{
@@ -109,12 +114,20 @@ std::shared_ptr<SkinnedAssetBundle> GetOrLoadBaseSkinnedAssetBundle_(const Level
 	}
 
 	const LevelSkinnedMeshDef& def = GetSkinnedMeshDef_(asset, skinnedMeshId);
-	AssimpSkinnedImportResult imported = LoadAssimpSkinnedAsset(def.path, def.flipUVs, def.submeshIndex);
-	auto bundle = std::make_shared<SkinnedAssetBundle>();
-	bundle->debugName = def.debugName;
-	bundle->mesh = std::move(imported.mesh);
-	bundle->clips = std::move(imported.clips);
-	bundle->clipSourceAssetIds.assign(bundle->clips.size(), std::string{});
+	SkinnedSourceProperties props{};
+	props.path = def.path;
+	props.debugName = def.debugName;
+	props.flipUVs = def.flipUVs;
+	props.submeshIndex = def.submeshIndex;
+	props.streamingPriority = jobs::JobPriority::Critical;
+	const std::string key = MakeSkinnedSourceKey(props);
+
+	std::shared_ptr<const SkinnedAssetBundle> bundle = assets.LoadSkinnedSourceSync(std::move(props))->Get();
+	if (!bundle)
+	{
+		throw std::runtime_error("Level: failed to import skinned mesh '" + def.path + "': "
+			+ std::string(assets.GetResourceManager().GetError<SkinnedSourceResource>(key)));
+	}
 	baseSkinnedAssetCache_.emplace(skinnedMeshId, bundle);
 	return bundle;
 }
@@ -163,9 +176,9 @@ std::shared_ptr<SkinnedAssetBundle> GetOrLoadBaseSkinnedAssetBundle_(const Level
 	return key;
 }
 
-std::shared_ptr<SkinnedAssetBundle> ResolveSkinnedAssetBundleForNode_(const LevelAsset& asset, const LevelNode& node)
+std::shared_ptr<const SkinnedAssetBundle> ResolveSkinnedAssetBundleForNode_(const LevelAsset& asset, AssetManager& assets, const LevelNode& node)
 {
-	auto baseBundle = GetOrLoadBaseSkinnedAssetBundle_(asset, node.skinnedMesh);
+	auto baseBundle = GetOrLoadBaseSkinnedAssetBundle_(asset, assets, node.skinnedMesh);
 	const std::vector<std::string> animationSourceIds = CollectRequiredAnimationSourceIds_(asset, node);
 	if (animationSourceIds.empty())
 	{
@@ -178,29 +191,39 @@ std::shared_ptr<SkinnedAssetBundle> ResolveSkinnedAssetBundleForNode_(const Leve
 		return it->second;
 	}
 
+	// Clip sets are imported (and compressed) once per file and skeleton layout; the node's
+	// bundle copies them next to the embedded clips.
+	const std::shared_ptr<const Skeleton> skeleton(baseBundle, &baseBundle->mesh.skeleton);
 	auto bundle = std::make_shared<SkinnedAssetBundle>(*baseBundle);
 	for (const std::string& animationId : animationSourceIds)
 	{
 		const LevelAnimationDef& def = GetAnimationDef_(asset, animationId);
-		AssimpAnimationImportResult imported = LoadAssimpAnimationClips(def.path, baseBundle->mesh.skeleton, def.flipUVs);
+		AnimationClipSetProperties props{};
+		props.path = def.path;
+		props.flipUVs = def.flipUVs;
+		props.skeleton = skeleton;
+		props.streamingPriority = jobs::JobPriority::Critical;
+		const std::string key = MakeAnimationClipSetKey(props);
+
+		const std::shared_ptr<const AssimpAnimationImportResult> imported = assets.LoadAnimationClipSetSync(std::move(props))->Get();
+		if (!imported)
+		{
+			throw std::runtime_error("Level: failed to import animation '" + def.path + "': "
+				+ std::string(assets.GetResourceManager().GetError<AnimationClipSetResource>(key)));
+		}
 
 		ExternalAnimationSourceInfo sourceInfo{};
 		sourceInfo.assetId = animationId;
 		sourceInfo.debugName = def.debugName;
-		sourceInfo.clipCount = imported.clips.size();
-		sourceInfo.sourceChannelCount = imported.sourceChannelCount;
-		sourceInfo.matchedChannelCount = imported.matchedChannelCount;
-		sourceInfo.ignoredChannelCount = imported.ignoredChannelCount;
-		sourceInfo.diagnosticMessage = imported.diagnosticMessage;
+		sourceInfo.clipCount = imported->clips.size();
+		sourceInfo.sourceChannelCount = imported->sourceChannelCount;
+		sourceInfo.matchedChannelCount = imported->matchedChannelCount;
+		sourceInfo.ignoredChannelCount = imported->ignoredChannelCount;
+		sourceInfo.diagnosticMessage = imported->diagnosticMessage;
 		bundle->externalAnimationSources.push_back(sourceInfo);
 
-		bundle->clips.reserve(bundle->clips.size() + imported.clips.size());
-		bundle->clipSourceAssetIds.reserve(bundle->clipSourceAssetIds.size() + imported.clips.size());
-		for (auto& clip : imported.clips)
-		{
-			bundle->clipSourceAssetIds.push_back(animationId);
-			bundle->clips.push_back(std::move(clip));
-		}
+		bundle->clips.insert(bundle->clips.end(), imported->clips.begin(), imported->clips.end());
+		bundle->clipSourceAssetIds.insert(bundle->clipSourceAssetIds.end(), imported->clips.size(), animationId);
 	}
 	resolvedSkinnedAssetCache_.emplace(cacheKey, bundle);
 	return bundle;
@@ -245,9 +268,9 @@ std::shared_ptr<SkinnedAssetBundle> ResolveSkinnedAssetBundleForNode_(const Leve
 	return -1;
 }
 
-int MakeSkinnedDrawForNode_(const LevelAsset& asset, Scene& scene, int nodeIndex, const LevelNode& node)
+int MakeSkinnedDrawForNode_(const LevelAsset& asset, Scene& scene, AssetManager& assets, int nodeIndex, const LevelNode& node)
 {
-	auto bundle = ResolveSkinnedAssetBundleForNode_(asset, node);
+	auto bundle = ResolveSkinnedAssetBundleForNode_(asset, assets, node);
 
 	SkinnedDrawItem item{};
 	item.asset = bundle;
@@ -329,7 +352,9 @@ int MakeSkinnedDrawForNode_(const LevelAsset& asset, Scene& scene, int nodeIndex
 std::vector<int> MakeDrawsForModelNode_(const LevelAsset& asset, Scene& scene, AssetManager& assets, int nodeIndex, const LevelNode& node)
 {
 	const LevelModelDef& md = GetModelDef_(asset, node.model);
-	const ImportedModelScene meta = LoadAssimpScene(md.path, md.flipUVs);
+	// Streamed cells reuse the layouts the prefetch manifest already read.
+	const auto cachedScene = cellModelScenes_.find(node.model);
+	const ImportedModelScene meta = cachedScene != cellModelScenes_.end() ? cachedScene->second : LoadAssimpScene(md.path, md.flipUVs);
 	std::vector<int> draws;
 	draws.reserve(meta.submeshes.size());
 	for (const ImportedSubmeshInfo& sub : meta.submeshes)
@@ -353,6 +378,7 @@ std::vector<int> MakeDrawsForModelNode_(const LevelAsset& asset, Scene& scene, A
 		item.material = EnsureMaterial(asset, scene, materialId);
 		item.transform.useMatrix = true;
 		item.transform.matrix = world_[static_cast<std::size_t>(nodeIndex)];
+		item.isStatic = node.isStatic;
 		const int drawIndex = static_cast<int>(scene.drawItems.size());
 		scene.AddDraw(item);
 		if (drawToNode_.size() < scene.drawItems.size())
@@ -428,7 +454,7 @@ EntityHandle EnsureEntityForNode_(const LevelAsset& asset, int nodeIndex)
 		world_.resize(asset.nodes.size(), mathUtils::Mat4(1.0f));
 	}
 
-	ecs_.UpsertNodeData(e, nodeIndex, node.parent, node.transform, world_[i], Flags{ .alive = node.alive, .visible = node.visible });
+	ecs_.UpsertNodeData(e, nodeIndex, node.parent, node.transform, world_[i], Flags{ .alive = node.alive, .visible = node.visible, .isStatic = node.isStatic });
 	return e;
 }
 
@@ -451,6 +477,7 @@ void DestroyEntityForNode_(int nodeIndex)
 		ecs_.DestroyEntity(e);
 	}
 	nodeToEntity_[i] = kNullEntity;
+	MarkPickBoundsDirty_(nodeIndex);
 }
 
 void SyncEntityRenderableForNode_(const LevelAsset& asset, Scene& scene, int nodeIndex)
@@ -460,6 +487,7 @@ void SyncEntityRenderableForNode_(const LevelAsset& asset, Scene& scene, int nod
 	{
 		return;
 	}
+	MarkPickBoundsDirty_(nodeIndex);
 
 	const int drawIndex = GetNodeDrawIndex(nodeIndex);
 	const int skinnedDrawIndex = GetNodeSkinnedDrawIndex(nodeIndex);
@@ -488,9 +516,101 @@ void SyncEntityRenderableForNode_(const LevelAsset& asset, Scene& scene, int nod
 		if (i < asset.nodes.size())
 		{
 			const LevelNode& node = asset.nodes[i];
-			ecs_.UpsertNodeData(e, nodeIndex, node.parent, node.transform, world_[i], Flags{ .alive = node.alive, .visible = node.visible });
+			ecs_.UpsertNodeData(e, nodeIndex, node.parent, node.transform, world_[i], Flags{ .alive = node.alive, .visible = node.visible, .isStatic = node.isStatic });
+		}
+	}
+}
+
+void MarkPickBoundsDirty_(int nodeIndex)
+{
+	if (nodeIndex < 0 || pickBvhAllDirty_)
+	{
+		return;
+	}
+	const std::size_t i = static_cast<std::size_t>(nodeIndex);
+	if (pickBoundsDirty_.size() <= i)
+	{
+		pickBoundsDirty_.resize(i + 1, 0);
+	}
+	if (pickBoundsDirty_[i] == 0)
+	{
+		pickBoundsDirty_[i] = 1;
+		pickDirtyNodes_.push_back(nodeIndex);
+	}
+}
+
+// Re-inserts, moves or drops the node's picking proxy. Returns false when the bounds are not known yet.
+bool UpdatePickProxy_(const Scene& scene, int nodeIndex)
+{
+	const std::size_t i = static_cast<std::size_t>(nodeIndex);
+	if (nodePickProxy_.size() <= i)
+	{
+		nodePickProxy_.resize(i + 1, SceneBvh::kNullProxy);
+	}
+	SceneBvh::ProxyId& proxy = nodePickProxy_[i];
+
+	auto DropProxy = [&]()
+		{
+			if (proxy != SceneBvh::kNullProxy)
+			{
+				pickBvh_.Remove(proxy);
+				proxy = SceneBvh::kNullProxy;
+			}
+		};
+
+	const EntityHandle e = GetEntityForNode_(nodeIndex);
+	const Renderable* renderable = (e != kNullEntity) ? ecs_.TryGetRenderablePtr(e) : nullptr;
+	const WorldTransform* world = (e != kNullEntity) ? ecs_.TryGetWorldTransformPtr(e) : nullptr;
+	if (!renderable || !world)
+	{
+		DropProxy();
+		return true;
+	}
+
+	mathUtils::Vec3 bmin{}, bmax{};
+	if (renderable->isSkinned)
+	{
+		const SkinnedDrawItem* skinned = GetSkinnedDrawItem(scene, renderable->skinnedDrawIndex);
+		if (!skinned || !skinned->asset)
+		{
+			DropProxy();
+			return true;
+		}
+		const auto& bounds =
+			(skinned->asset->mesh.bounds.maxAnimatedBounds.sphereRadius > 0.0f)
+			? skinned->asset->mesh.bounds.maxAnimatedBounds
+			: skinned->asset->mesh.bounds.bindPoseBounds;
+		bmin = bounds.aabbMin;
+		bmax = bounds.aabbMax;
+	}
+	else
+	{
+		if (!renderable->mesh)
+		{
+			DropProxy();
+			return true;
+		}
+		const auto& bounds = renderable->mesh->GetBounds();
+		if (bounds.sphereRadius <= 0.0f)
+		{
+			// Still streaming: RefreshPickBvh retries it.
+			DropProxy();
+			return false;
 		}
+		bmin = bounds.aabbMin;
+		bmax = bounds.aabbMax;
+	}
+
+	const BvhAabb box = TransformAabb(bmin, bmax, world->world);
+	if (proxy == SceneBvh::kNullProxy)
+	{
+		proxy = pickBvh_.Insert(box, static_cast<std::uint32_t>(nodeIndex));
 	}
+	else
+	{
+		pickBvh_.Update(proxy, box);
+	}
+	return true;
 }
 
 void EnsureDrawForNode_(const LevelAsset& asset, Scene& scene, AssetManager& assets, int nodeIndex)
@@ -507,7 +627,8 @@ void EnsureDrawForNode_(const LevelAsset& asset, Scene& scene, AssetManager& ass
 	}
 
 	const LevelNode& node = asset.nodes[i];
-	if (!node.alive || !node.visible || (node.mesh.empty() && node.model.empty() && node.skinnedMesh.empty()))
+	const bool streamedOut = i < nodeStreamedOut_.size() && nodeStreamedOut_[i] != 0;
+	if (!node.alive || !node.visible || streamedOut || (node.mesh.empty() && node.model.empty() && node.skinnedMesh.empty()))
 	{
 		DestroyDrawForNode_(scene, nodeIndex);
 		DestroySkinnedDrawForNode_(scene, nodeIndex);
@@ -536,7 +657,7 @@ void EnsureDrawForNode_(const LevelAsset& asset, Scene& scene, AssetManager& ass
 
 	if (!node.skinnedMesh.empty())
 	{
-		nodeToSkinnedDraw_[i] = MakeSkinnedDrawForNode_(asset, scene, nodeIndex, node);
+		nodeToSkinnedDraw_[i] = MakeSkinnedDrawForNode_(asset, scene, assets, nodeIndex, node);
 		return;
 	}
 
@@ -552,6 +673,7 @@ void EnsureDrawForNode_(const LevelAsset& asset, Scene& scene, AssetManager& ass
 	item.material = EnsureMaterial(asset, scene, node.material);
 	item.transform.useMatrix = true;
 	item.transform.matrix = world_[i];
+	item.isStatic = node.isStatic;
 
 	const int drawIndex = static_cast<int>(scene.drawItems.size());
 	scene.AddDraw(item);
@@ -673,6 +795,145 @@ void DestroyDrawForNode_(Scene& scene, int nodeIndex)
 	}
 }
 
+void StreamNodeIn_(const LevelAsset& asset, Scene& scene, AssetManager& assets, int nodeIndex)
+{
+	nodeStreamedOut_[static_cast<std::size_t>(nodeIndex)] = 0;
+	EnsureDrawForNode_(asset, scene, assets, nodeIndex);
+	SyncEntityRenderableForNode_(asset, scene, nodeIndex);
+}
+
+void StreamNodeOut_(const LevelAsset& asset, Scene& scene, int nodeIndex)
+{
+	nodeStreamedOut_[static_cast<std::size_t>(nodeIndex)] = 1;
+	DestroyDrawForNode_(scene, nodeIndex);
+	SyncEntityRenderableForNode_(asset, scene, nodeIndex);
+}
+
+// Prefetch ids (meshes, model submeshes, material textures) a renderable node draws with.
+void CollectNodePrefetchIds_(const LevelAsset& asset, const LevelNode& node, std::unordered_set<std::string>& ids) const
+{
+	if (!node.model.empty())
+	{
+		if (const auto sceneIt = cellModelScenes_.find(node.model); sceneIt != cellModelScenes_.end())
+		{
+			for (const ImportedSubmeshInfo& sub : sceneIt->second.submeshes)
+			{
+				ids.insert(node.model + "#submesh=" + std::to_string(sub.submeshIndex));
+			}
+		}
+	}
+	else if (!node.mesh.empty())
+	{
+		ids.insert(node.mesh);
+	}
+
+	auto addMaterial = [&](const std::string& materialId)
+		{
+			if (const auto it = asset.materials.find(materialId); it != asset.materials.end())
+			{
+				for (const auto& [_, textureId] : it->second.textureBindings)
+				{
+					ids.insert(textureId);
+				}
+			}
+		};
+	addMaterial(node.material);
+	for (const auto& [_, materialId] : node.materialOverrides)
+	{
+		addMaterial(materialId);
+	}
+}
+
+// Groups the renderable nodes into the level's streaming cells by the XZ position of their root
+// ancestor and marks them streamed out. Each cell gets the manifest requests only cell nodes use
+// (an asset shared by two cells is requested, and budgeted, by both). Returns the ids of those
+// requests: they are loaded with their cell instead of up front. Needs world_/worldOrder_.
+std::unordered_set<std::string> BuildStreamingCells_(const LevelAsset& asset, const LevelPrefetchManifest& manifest)
+{
+	const LevelStreamingDef& settings = *asset.streaming;
+	nodeStreamedOut_.assign(asset.nodes.size(), 0);
+	cellModelScenes_ = manifest.modelScenes;
+
+	std::vector<int> rootOf(asset.nodes.size(), -1);
+	std::unordered_map<std::uint64_t, std::uint32_t> cellIndex;
+	std::vector<LevelCell> cells;
+	std::vector<std::unordered_set<std::string>> cellIds;
+	std::unordered_set<std::string> residentIds;
+	for (const int nodeIndex : worldOrder_)
+	{
+		const std::size_t i = static_cast<std::size_t>(nodeIndex);
+		const int parent = worldParent_[i];
+		rootOf[i] = parent >= 0 ? rootOf[static_cast<std::size_t>(parent)] : nodeIndex;
+
+		const LevelNode& n = asset.nodes[i];
+		if (!n.visible || (n.mesh.empty() && n.model.empty() && n.skinnedMesh.empty()))
+		{
+			continue;
+		}
+
+		std::unordered_set<std::string>* ids = &residentIds;
+		if (n.skinnedMesh.empty() && !n.alwaysLoaded)
+		{
+			const mathUtils::Vec3 anchor = world_[static_cast<std::size_t>(rootOf[i])][3].xyz();
+			const std::int32_t cx = LevelCellStreamer::CellCoord(anchor.x, settings.cellSize);
+			const std::int32_t cz = LevelCellStreamer::CellCoord(anchor.z, settings.cellSize);
+			const std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cz);
+			const auto [it, inserted] = cellIndex.try_emplace(key, static_cast<std::uint32_t>(cells.size()));
+			if (inserted)
+			{
+				cells.push_back(LevelCell{ .x = cx, .z = cz });
+				cellIds.emplace_back();
+			}
+			cells[it->second].nodes.push_back(nodeIndex);
+			ids = &cellIds[it->second];
+			nodeStreamedOut_[i] = 1;
+		}
+		CollectNodePrefetchIds_(asset, n, *ids);
+	}
+
+	for (const ParticleEmitter& emitter : asset.particleEmitters)
+	{
+		residentIds.insert(emitter.textureId);
+	}
+	if (asset.skyboxTexture)
+	{
+		residentIds.insert(*asset.skyboxTexture);
+	}
+
+	std::unordered_map<std::string_view, std::size_t> requestIndex;
+	requestIndex.reserve(manifest.requests.size());
+	for (std::size_t r = 0; r < manifest.requests.size(); ++r)
+	{
+		requestIndex.emplace(manifest.requests[r].id, r);
+	}
+
+	std::unordered_set<std::string> heldBack;
+	std::vector<std::size_t> picked;
+	for (std::size_t c = 0; c < cells.size(); ++c)
+	{
+		picked.clear();
+		for (const std::string& id : cellIds[c])
+		{
+			const auto it = requestIndex.find(id);
+			if (it != requestIndex.end() && !residentIds.contains(id))
+			{
+				picked.push_back(it->second);
+				heldBack.insert(id);
+			}
+		}
+		std::sort(picked.begin(), picked.end()); // keep the manifest's nearest-first order
+		for (const std::size_t r : picked)
+		{
+			cells[c].requests.push_back(manifest.requests[r]);
+			cells[c].sizeBytes += manifest.requests[r].sizeBytes;
+		}
+	}
+
+	cellPrefetch_.assign(cells.size(), {});
+	cellStreamer_.Reset(settings, std::move(cells));
+	return heldBack;
+}
+
 std::vector<int> CollectSubtree_(const LevelAsset& asset, int rootNodeIndex) const
 {
 	std::vector<int> out;
@@ -747,19 +1008,7 @@ void RebuildParticleEmitters_(const LevelAsset& asset, Scene& scene)
 
 void RemoveParticlesOwnedByEmitter_(Scene& scene, int emitterIndex)
 {
-	for (Particle& particle : scene.particles)
-	{
-		if (particle.ownerEmitter == emitterIndex)
-		{
-			particle.alive = false;
-		}
-	}
-	scene.particles.erase(
-		std::remove_if(scene.particles.begin(), scene.particles.end(), [](const Particle& particle)
-			{
-				return !particle.alive;
-			}),
-		scene.particles.end());
+	scene.particles.RemoveOwnedBy(emitterIndex);
 }
 
 void ValidateRuntimeMappings_(const LevelAsset& asset, const Scene& scene) const noexcept
@@ -821,54 +1070,135 @@ void ValidateRuntimeMappings_(const LevelAsset& asset, const Scene& scene) const
 #endif
 }
 
-void RecomputeWorld_(const LevelAsset& asset)
+// Alive nodes sorted by depth (parents before children, node order within a depth) plus the
+// [begin, end) range of every depth in worldOrder_. Dead parents and cycles make a node a root.
+void RebuildWorldOrder_(const LevelAsset& asset)
 {
 	const std::size_t n = asset.nodes.size();
-	world_.resize(n, mathUtils::Mat4(1.0f));
+	worldParent_.assign(n, -1);
 
-	std::vector<std::uint8_t> state;
-	state.resize(n, 0); // 0=unvisited, 1=visiting, 2=done
+	std::vector<int> depth(n, 0);
+	std::vector<std::uint8_t> state(n, 0); // 0=unvisited, 1=visiting, 2=done
 
-	auto compute = [&](auto&& self, std::size_t i) -> const mathUtils::Mat4&
+	auto resolve = [&](auto&& self, std::size_t i) -> int
 		{
 			if (state[i] == 2)
-				return world_[i];
+				return depth[i];
 
 			if (state[i] == 1)
-			{
-				// cycle - treat as root
-				world_[i] = root_ * asset.nodes[i].transform.ToMatrix();
-				state[i] = 2;
-				return world_[i];
-			}
+				return -1; // cycle - the child that closes it becomes a root
 
 			state[i] = 1;
 
-			const LevelNode& node = asset.nodes[i];
-			if (!node.alive)
+			const int parent = asset.nodes[i].parent;
+			if (parent >= 0 && static_cast<std::size_t>(parent) < n && asset.nodes[static_cast<std::size_t>(parent)].alive)
 			{
-				world_[i] = mathUtils::Mat4(1.0f);
-				state[i] = 2;
-				return world_[i];
-			}
-
-			mathUtils::Mat4 parentWorld = root_;
-			if (node.parent >= 0)
-			{
-				const std::size_t p = static_cast<std::size_t>(node.parent);
-				if (p < n && asset.nodes[p].alive)
+				const int parentDepth = self(self, static_cast<std::size_t>(parent));
+				if (parentDepth >= 0)
 				{
-					parentWorld = self(self, p);
+					worldParent_[i] = parent;
+					depth[i] = parentDepth + 1;
 				}
 			}
 
-			world_[i] = parentWorld * node.transform.ToMatrix();
 			state[i] = 2;
-			return world_[i];
+			return depth[i];
 		};
 
+	int maxDepth = -1;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (asset.nodes[i].alive)
+		{
+			maxDepth = std::max(maxDepth, resolve(resolve, i));
+		}
+	}
+
+	worldLevelOffsets_.assign(static_cast<std::size_t>(maxDepth + 2), 0u);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (asset.nodes[i].alive)
+		{
+			++worldLevelOffsets_[static_cast<std::size_t>(depth[i]) + 1];
+		}
+	}
+	for (std::size_t level = 1; level < worldLevelOffsets_.size(); ++level)
+	{
+		worldLevelOffsets_[level] += worldLevelOffsets_[level - 1];
+	}
+
+	worldOrder_.resize(worldLevelOffsets_.back());
+	std::vector<std::uint32_t> cursor(worldLevelOffsets_.begin(), worldLevelOffsets_.end() - 1);
 	for (std::size_t i = 0; i < n; ++i)
 	{
-		compute(compute, i);
+		if (asset.nodes[i].alive)
+		{
+			worldOrder_[cursor[static_cast<std::size_t>(depth[i])]++] = static_cast<int>(i);
+		}
+	}
+}
+
+// Recomputes the world matrices of the dirty nodes and everything below them, one depth at a time so a
+// parent is final before its children read it (each depth is a ParallelFor; inline without a scheduler).
+// Leaves the rewritten nodes, in depth order, in changedWorldNodes_.
+void UpdateDirtyWorld_(const LevelAsset& asset, jobs::Scheduler* scheduler)
+{
+	const std::size_t n = asset.nodes.size();
+	if (worldOrderDirty_ || worldParent_.size() != n)
+	{
+		RebuildWorldOrder_(asset);
+		worldOrderDirty_ = false;
+		allWorldDirty_ = true;
+	}
+
+	world_.resize(n, mathUtils::Mat4(1.0f));
+	worldNodeDirty_.resize(n, 0);
+	if (allWorldDirty_)
+	{
+		std::fill(worldNodeDirty_.begin(), worldNodeDirty_.end(), std::uint8_t{ 1 });
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			if (!asset.nodes[i].alive)
+			{
+				world_[i] = mathUtils::Mat4(1.0f);
+			}
+		}
+		allWorldDirty_ = false;
+	}
+
+	constexpr std::size_t kWorldUpdateGrain = 256;
+	for (std::size_t level = 0; level + 1 < worldLevelOffsets_.size(); ++level)
+	{
+		const int* levelNodes = worldOrder_.data() + worldLevelOffsets_[level];
+		const std::size_t levelCount = worldLevelOffsets_[level + 1] - worldLevelOffsets_[level];
+		jobs::ParallelFor(scheduler, levelCount, kWorldUpdateGrain, [&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t k = begin; k < end; ++k)
+				{
+					const std::size_t i = static_cast<std::size_t>(levelNodes[k]);
+					const int parent = worldParent_[i];
+					if (parent >= 0 && worldNodeDirty_[static_cast<std::size_t>(parent)] != 0)
+					{
+						worldNodeDirty_[i] = 1;
+					}
+					if (worldNodeDirty_[i] == 0)
+					{
+						continue;
+					}
+
+					const mathUtils::Mat4& parentWorld = (parent >= 0) ? world_[static_cast<std::size_t>(parent)] : root_;
+					world_[i] = parentWorld * asset.nodes[i].transform.ToMatrix();
+				}
+			});
+	}
+
+	changedWorldNodes_.clear();
+	for (const int i : worldOrder_)
+	{
+		if (worldNodeDirty_[static_cast<std::size_t>(i)] != 0)
+		{
+			changedWorldNodes_.push_back(i);
+		}
 	}
+	std::fill(worldNodeDirty_.begin(), worldNodeDirty_.end(), std::uint8_t{ 0 });
 }
\ No newline at end of file
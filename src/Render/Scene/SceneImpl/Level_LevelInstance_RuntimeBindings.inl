@@ -43,6 +43,141 @@ bool TryParseMaterialTextureSlot_(std::string_view slotName, MaterialTextureSlot
 	return false;
 }
 
+// -----------------------------
+// Runtime: level readiness
+// -----------------------------
+// Ready once every texture and mesh of the prefetch manifest has left Loading (resolved by
+// AssetManager::ProcessUploads). Later loads (editor edits, mip streaming, residency reloads)
+// don't affect it.
+const std::shared_future<void>& ReadyFuture() const noexcept
+{
+	return ready_;
+}
+
+bool IsReady() const
+{
+	return !ready_.valid() || ready_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// -----------------------------
+// Runtime: cell streaming
+// -----------------------------
+// Loads the streaming cells around `viewPosition` and releases the ones left behind. Node
+// instantiation and teardown are spread over frames (LevelStreamingDef::maxNodeOpsPerFrame),
+// and meshes of released cells leave the AssetManager once no draw uses them. Textures are
+// left to the residency manager. No-op for levels without a "streaming" block.
+void UpdateCellStreaming(const LevelAsset& asset, Scene& scene, AssetManager& assets, const mathUtils::Vec3& viewPosition)
+{
+	if (!cellStreamer_.IsEnabled())
+	{
+		return;
+	}
+	profiling::ScopedZone zone{ "Level::UpdateCellStreaming" };
+
+	cellStreamer_.UpdateWanted(viewPosition);
+	const std::span<LevelCell> cells = cellStreamer_.GetCells();
+	const std::span<const std::uint32_t> order = cellStreamer_.GetOrder();
+
+	bool released = false;
+	for (const std::uint32_t index : order)
+	{
+		LevelCell& cell = cells[index];
+		LevelPrefetch& prefetch = cellPrefetch_[index];
+		switch (cell.state)
+		{
+		case LevelCellState::Unloaded:
+			if (cell.wanted)
+			{
+				prefetch = IssueLevelPrefetch(assets, asset, std::span<const LevelPrefetchRequest>(cell.requests));
+				cell.state = LevelCellState::Loading;
+			}
+			break;
+		case LevelCellState::Loading:
+			if (!cell.wanted)
+			{
+				prefetch = {};
+				cell.state = LevelCellState::Unloaded;
+				released = true;
+			}
+			else if (prefetch.ready.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			{
+				cell.state = LevelCellState::Loaded;
+			}
+			break;
+		case LevelCellState::Loaded:
+			if (!cell.wanted)
+			{
+				cell.state = LevelCellState::Unloading;
+			}
+			break;
+		case LevelCellState::Unloading:
+			if (cell.wanted)
+			{
+				cell.state = LevelCellState::Loaded;
+			}
+			break;
+		}
+	}
+
+	// Teardown first, farthest cells first, so memory is returned before new cells grow.
+	std::uint32_t ops = cellStreamer_.GetSettings().maxNodeOpsPerFrame;
+	bool changed = false;
+	for (auto it = order.rbegin(); it != order.rend() && ops != 0; ++it)
+	{
+		LevelCell& cell = cells[*it];
+		if (cell.state != LevelCellState::Unloading)
+		{
+			continue;
+		}
+		for (; cell.residentNodes != 0 && ops != 0; --ops)
+		{
+			--cell.residentNodes;
+			StreamNodeOut_(asset, scene, cell.nodes[cell.residentNodes]);
+			changed = true;
+		}
+		if (cell.residentNodes == 0)
+		{
+			cellPrefetch_[*it] = {};
+			cell.state = LevelCellState::Unloaded;
+			released = true;
+		}
+	}
+
+	for (auto it = order.begin(); it != order.end() && ops != 0; ++it)
+	{
+		LevelCell& cell = cells[*it];
+		if (cell.state != LevelCellState::Loaded || cell.residentNodes == cell.nodes.size())
+		{
+			continue;
+		}
+		for (; cell.residentNodes < cell.nodes.size() && ops != 0; --ops)
+		{
+			StreamNodeIn_(asset, scene, assets, cell.nodes[cell.residentNodes]);
+			++cell.residentNodes;
+			changed = true;
+		}
+		if (cell.residentNodes == cell.nodes.size())
+		{
+			cellPrefetch_[*it] = {}; // the draws hold the meshes from here on
+		}
+	}
+
+	if (changed)
+	{
+		SyncEditorRuntimeBindings(asset, scene);
+		ValidateRuntimeMappingsDebug(asset, scene);
+	}
+	if (released)
+	{
+		assets.UnloadUnusedMeshes();
+	}
+}
+
+const LevelCellStreamer& GetCellStreamer() const noexcept
+{
+	return cellStreamer_;
+}
+
 // -----------------------------
 // Runtime: descriptor management
 // -----------------------------
@@ -51,14 +186,10 @@ void ResolveTextureBindings(AssetManager& assets, BindlessTable& bindless, Scene
 	ResourceManager& rm = assets.GetResourceManager();
 
 
-	// Materials
+	// Materials (0 while a texture is not resident: the slot falls back to "no texture")
 	for (auto& pb : pendingBindings_)
 	{
-		rhi::TextureDescIndex idx = GetOrCreateTextureDesc_(rm, bindless, pb.textureId);
-		if (idx == 0)
-		{
-			continue;
-		}
+		const rhi::TextureDescIndex idx = GetOrCreateTextureDesc_(rm, bindless, pb.textureId);
 
 		Material& m = scene.GetMaterial(pb.material);
 		switch (pb.slot)
@@ -98,6 +229,115 @@ void ResolveTextureBindings(AssetManager& assets, BindlessTable& bindless, Scene
 	}
 }
 
+// Mip-streaming feedback: every texture bound to a material gets the largest on-screen size of
+// a draw using that material (projected bounding sphere, so a texture mapped once across the
+// surface). Particle textures are reported at viewport size.
+void ReportTextureStreamingFeedback(AssetManager& assets, const Scene& scene, float viewportHeightPixels)
+{
+	if (viewportHeightPixels <= 0.0f)
+	{
+		return;
+	}
+
+	const Camera& camera = scene.camera;
+	const float pixelsPerUnitAtUnitDistance =
+		viewportHeightPixels / (2.0f * std::tan(mathUtils::DegToRad(camera.fovYDeg) * 0.5f));
+
+	std::unordered_map<std::uint32_t, float> materialPixels;
+	const auto Accumulate = [&](MaterialHandle material, const mathUtils::Mat4& world, const mathUtils::Vec3& localCenter, float localRadius)
+		{
+			if (!material || localRadius <= 0.0f)
+			{
+				return;
+			}
+
+			const float maxScale = std::max({
+				mathUtils::Length(world[0].xyz()),
+				mathUtils::Length(world[1].xyz()),
+				mathUtils::Length(world[2].xyz()) });
+			const mathUtils::Vec3 center = (world * mathUtils::Vec4(localCenter, 1.0f)).xyz();
+			const float radius = localRadius * maxScale;
+			const float distance = mathUtils::Length(center - camera.position);
+
+			// Camera inside the sphere: as sharp as it gets.
+			const float pixels = (distance <= radius)
+				? std::numeric_limits<float>::max()
+				: 2.0f * radius * pixelsPerUnitAtUnitDistance / distance;
+
+			float& best = materialPixels[material.id];
+			best = std::max(best, pixels);
+		};
+
+	for (const DrawItem& item : scene.drawItems)
+	{
+		if (item.mesh)
+		{
+			const MeshBounds& bounds = item.mesh->GetBounds();
+			Accumulate(item.material, item.transform.ToMatrix(), bounds.sphereCenter, bounds.sphereRadius);
+		}
+	}
+
+	for (const SkinnedDrawItem& item : scene.skinnedDrawItems)
+	{
+		if (!item.asset)
+		{
+			continue;
+		}
+
+		const auto& bounds = item.asset->mesh.bounds.maxAnimatedBounds;
+		Accumulate(item.material, item.transform.ToMatrix(), bounds.sphereCenter, bounds.sphereRadius);
+	}
+
+	for (const PendingMaterialBinding& binding : pendingBindings_)
+	{
+		if (auto it = materialPixels.find(binding.material.id); it != materialPixels.end())
+		{
+			assets.ReportTextureScreenSize(binding.textureId, it->second);
+		}
+	}
+
+	for (const ParticleEmitter& emitter : scene.particleEmitters)
+	{
+		if (!emitter.textureId.empty())
+		{
+			assets.ReportTextureScreenSize(emitter.textureId, viewportHeightPixels);
+		}
+	}
+}
+
+// Residency feedback: textures of the materials the renderer drew this frame count as used.
+// Particle textures are always marked (emitters are not culled).
+void MarkTexturesUsed(AssetManager& assets, std::span<const MaterialHandle> drawnMaterials, const Scene& scene) const
+{
+	if (!drawnMaterials.empty())
+	{
+		std::vector<bool> drawn(scene.GetMaterials().size() + 1u, false);
+		for (const MaterialHandle material : drawnMaterials)
+		{
+			if (material.id < drawn.size())
+			{
+				drawn[material.id] = true;
+			}
+		}
+
+		for (const PendingMaterialBinding& binding : pendingBindings_)
+		{
+			if (binding.material.id < drawn.size() && drawn[binding.material.id])
+			{
+				assets.MarkTextureUsed(binding.textureId);
+			}
+		}
+	}
+
+	for (const ParticleEmitter& emitter : scene.particleEmitters)
+	{
+		if (!emitter.textureId.empty())
+		{
+			assets.MarkTextureUsed(emitter.textureId);
+		}
+	}
+}
+
 void FreeDescriptors(BindlessTable& bindless) noexcept
 {
 	for (auto& [_, idx] : textureDesc_)
@@ -2,6 +2,7 @@
 std::unordered_map<std::string, rhi::TextureDescIndex> textureDesc_;
 std::vector<PendingMaterialBinding> pendingBindings_;
 std::optional<std::string> skyboxTextureId_;
+std::shared_future<void> ready_{}; // prefetch manifest loads
 
 // Editor/runtime state
 mathUtils::Mat4 root_{ 1.0f };
@@ -11,12 +12,35 @@ std::vector<std::vector<int>> nodeToDraws_;
 std::vector<int> drawToNode_;
 std::vector<int> nodeToSkinnedDraw_;
 std::vector<int> skinnedDrawToNode_;
-std::unordered_map<std::string, std::shared_ptr<SkinnedAssetBundle>> baseSkinnedAssetCache_;
-std::unordered_map<std::string, std::shared_ptr<SkinnedAssetBundle>> resolvedSkinnedAssetCache_;
+std::unordered_map<std::string, std::shared_ptr<const SkinnedAssetBundle>> baseSkinnedAssetCache_;
+std::unordered_map<std::string, std::shared_ptr<const SkinnedAssetBundle>> resolvedSkinnedAssetCache_;
 std::vector<int> particleEmitterToSceneEmitter_;
 std::unordered_map<std::string, MaterialHandle> materialHandles_;
 bool transformsDirty_{ true };
 
+// Incremental world transforms (see UpdateDirtyWorld_)
+std::vector<int> worldOrder_;                  // alive nodes, parents before children
+std::vector<std::uint32_t> worldLevelOffsets_; // worldOrder_ range of each depth
+std::vector<int> worldParent_;                 // effective parent (-1 for roots, dead parents and cycles)
+std::vector<std::uint8_t> worldNodeDirty_;
+std::vector<int> changedWorldNodes_;
+bool worldOrderDirty_{ true };
+bool allWorldDirty_{ true };
+
+// Picking BVH over the world bounds of renderable nodes (see RefreshPickBvh)
+SceneBvh pickBvh_{};
+std::vector<SceneBvh::ProxyId> nodePickProxy_;
+std::vector<std::uint8_t> pickBoundsDirty_;
+std::vector<int> pickDirtyNodes_;
+std::vector<int> pickPendingNodes_; // renderables whose mesh bounds are not loaded yet
+bool pickBvhAllDirty_{ true };
+
+// Cell streaming (see UpdateCellStreaming); disabled unless the level has a "streaming" block
+LevelCellStreamer cellStreamer_{};
+std::vector<LevelPrefetch> cellPrefetch_;   // per cell, held until its nodes are instantiated
+std::vector<std::uint8_t> nodeStreamedOut_; // 1: the node's cell is not instantiated
+std::unordered_map<std::string, ImportedModelScene> cellModelScenes_; // modelId -> submesh layout
+
 // ECS runtime (hybrid phase)
 LevelWorld ecs_{};
 std::vector<EntityHandle> nodeToEntity_{};
\ No newline at end of file
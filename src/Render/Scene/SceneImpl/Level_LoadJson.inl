@@ -76,8 +76,9 @@ inline void MergeAnimationNotifyAssetIntoController_(
 		{
 			throw std::runtime_error(contextPrefix + ".states must be object");
 		}
-		for (const auto& [stateName, notifyListV] : statesV->AsObject())
+		for (const auto& [stateNameView, notifyListV] : statesV->AsObject())
 		{
+			const std::string stateName(stateNameView);
 			if (!notifyListV.IsArray())
 			{
 				throw std::runtime_error(contextPrefix + ".states." + stateName + " must be array");
@@ -99,8 +100,9 @@ inline void MergeAnimationNotifyAssetIntoController_(
 		{
 			throw std::runtime_error(contextPrefix + ".clips must be object");
 		}
-		for (const auto& [clipName, notifyListV] : clipsV->AsObject())
+		for (const auto& [clipNameView, notifyListV] : clipsV->AsObject())
 		{
+			const std::string clipName(clipNameView);
 			if (!notifyListV.IsArray())
 			{
 				throw std::runtime_error(contextPrefix + ".clips." + clipName + " must be array");
@@ -127,7 +129,7 @@ inline void LoadAndMergeExternalAnimationNotifyAsset_(AnimationControllerAsset&
 	const std::filesystem::path absPath = corefs::ResolveAsset(std::filesystem::path(def.notifyAssetPath));
 	const std::string text = FILE_UTILS::ReadAllText(absPath);
 	JsonParser parser(text);
-	JsonValue root = parser.Parse();
+	const JsonValue& root = parser.Parse();
 	if (!root.IsObject())
 	{
 		throw std::runtime_error("Animation notify JSON: root must be object");
@@ -145,7 +147,7 @@ inline void LoadAndMergeExternalAnimationEventBindingsAsset_(AnimationController
 	const std::filesystem::path absPath = corefs::ResolveAsset(std::filesystem::path(def.eventBindingsAssetPath));
 	const std::string text = FILE_UTILS::ReadAllText(absPath);
 	JsonParser parser(text);
-	JsonValue root = parser.Parse();
+	const JsonValue& root = parser.Parse();
 	if (!root.IsObject())
 	{
 		throw std::runtime_error("Animation event bindings JSON: root must be object");
@@ -173,8 +175,9 @@ inline void LoadAndMergeExternalAnimationEventBindingsAsset_(AnimationController
 	if (auto* paramsV = TryGet(cd, "parameters"))
 	{
 		const JsonObject& paramsO = paramsV->AsObject();
-		for (const auto& [paramName, paramV] : paramsO)
+		for (const auto& [paramNameView, paramV] : paramsO)
 		{
+			const std::string paramName(paramNameView);
 			const JsonObject& pd = paramV.AsObject();
 			AnimationParameterDesc paramDesc;
 			paramDesc.name = paramName;
@@ -206,8 +209,9 @@ inline void LoadAndMergeExternalAnimationEventBindingsAsset_(AnimationController
 	if (auto* statesV = TryGet(cd, "states"))
 	{
 		const JsonObject& statesO = statesV->AsObject();
-		for (const auto& [stateName, stateV] : statesO)
+		for (const auto& [stateNameView, stateV] : statesO)
 		{
+			const std::string stateName(stateNameView);
 			const JsonObject& sd = stateV.AsObject();
 			AnimationStateDesc stateDesc;
 			stateDesc.name = stateName;
@@ -227,7 +231,7 @@ inline void LoadAndMergeExternalAnimationEventBindingsAsset_(AnimationController
 					{
 						throw std::runtime_error(contextPrefix + ".states." + stateName + ".tags[] must be string");
 					}
-					stateDesc.tags.push_back(tagV.AsString());
+					stateDesc.tags.emplace_back(tagV.AsString());
 				}
 			}
 			if (auto* blendV = TryGet(sd, "blend1D"))
@@ -379,7 +383,7 @@ inline void LoadAndMergeExternalAnimationEventBindingsAsset_(AnimationController
 	const std::string text = FILE_UTILS::ReadAllText(absPath);
 
 	JsonParser parser(text);
-	JsonValue root = parser.Parse();
+	const JsonValue& root = parser.Parse();
 	if (!root.IsObject())
 	{
 		throw std::runtime_error("Animation controller JSON: root must be object");
@@ -400,7 +404,7 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	const std::string text = FILE_UTILS::ReadAllText(absPath);
 
 	JsonParser parser(text);
-	JsonValue root = parser.Parse();
+	const JsonValue& root = parser.Parse();
 	if (!root.IsObject())
 	{
 		throw std::runtime_error("Level JSON: root must be object");
@@ -415,8 +419,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	if (auto* meshesV = TryGet(jsonObject, "meshes"))
 	{
 		const JsonObject& meshesO = meshesV->AsObject();
-		for (const auto& [id, defV] : meshesO)
+		for (const auto& [idView, defV] : meshesO)
 		{
+			const std::string id(idView);
 			const JsonObject& md = defV.AsObject();
 			LevelMeshDef def;
 			def.path = GetStringOpt(md, "path");
@@ -443,8 +448,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	if (auto* modelsV = TryGet(jsonObject, "models"))
 	{
 		const JsonObject& modelsO = modelsV->AsObject();
-		for (const auto& [id, defV] : modelsO)
+		for (const auto& [idView, defV] : modelsO)
 		{
+			const std::string id(idView);
 			const JsonObject& md = defV.AsObject();
 			LevelModelDef def;
 			def.path = GetStringOpt(md, "path");
@@ -462,8 +468,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	if (auto* texV = TryGet(jsonObject, "textures"))
 	{
 		const JsonObject& texO = texV->AsObject();
-		for (const auto& [id, defV] : texO)
+		for (const auto& [idView, defV] : texO)
 		{
+			const std::string id(idView);
 			const JsonObject& td = defV.AsObject();
 			LevelTextureDef def;
 
@@ -547,8 +554,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	if (auto* animationsV = TryGet(jsonObject, "animations"))
 	{
 		const JsonObject& animationsO = animationsV->AsObject();
-		for (const auto& [id, defV] : animationsO)
+		for (const auto& [idView, defV] : animationsO)
 		{
+			const std::string id(idView);
 			const JsonObject& md = defV.AsObject();
 			LevelAnimationDef def;
 			def.path = GetStringOpt(md, "path");
@@ -566,8 +574,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	if (auto* controllerAssetsV = TryGet(jsonObject, "animationControllerAssets"))
 	{
 		const JsonObject& controllerAssetsO = controllerAssetsV->AsObject();
-		for (const auto& [id, defV] : controllerAssetsO)
+		for (const auto& [idView, defV] : controllerAssetsO)
 		{
+			const std::string id(idView);
 			const JsonObject& ad = defV.AsObject();
 			const std::string path = GetStringOpt(ad, "path");
 			if (path.empty())
@@ -583,8 +592,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	if (auto* controllersV = TryGet(jsonObject, "animationControllers"))
 	{
 		const JsonObject& controllersO = controllersV->AsObject();
-		for (const auto& [id, defV] : controllersO)
+		for (const auto& [idView, defV] : controllersO)
 		{
+			const std::string id(idView);
 			const JsonObject& cd = defV.AsObject();
 			out.animationControllers.insert_or_assign(
 				id,
@@ -596,8 +606,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	if (auto* skinnedV = TryGet(jsonObject, "skinnedMeshes"))
 	{
 		const JsonObject& skinnedO = skinnedV->AsObject();
-		for (const auto& [id, defV] : skinnedO)
+		for (const auto& [idView, defV] : skinnedO)
 		{
+			const std::string id(idView);
 			const JsonObject& md = defV.AsObject();
 			LevelSkinnedMeshDef def;
 			def.path = GetStringOpt(md, "path");
@@ -624,8 +635,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 	if (auto* matsV = TryGet(jsonObject, "materials"))
 	{
 		const JsonObject& matsO = matsV->AsObject();
-		for (const auto& [id, defV] : matsO)
+		for (const auto& [idView, defV] : matsO)
 		{
+			const std::string id(idView);
 			const JsonObject& md = defV.AsObject();
 			LevelMaterialDef def;
 
@@ -701,6 +713,23 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 		out.camera = cam;
 	}
 
+	// --- streaming cells ---
+	if (auto* streamingV = TryGet(jsonObject, "streaming"))
+	{
+		const JsonObject& sd = streamingV->AsObject();
+		LevelStreamingDef def;
+		def.cellSize = GetFloatOpt(sd, "cellSize", def.cellSize);
+		def.loadRadius = GetFloatOpt(sd, "loadRadius", def.loadRadius);
+		def.unloadRadius = std::max(def.loadRadius, GetFloatOpt(sd, "unloadRadius", def.unloadRadius));
+		def.memoryBudgetBytes = static_cast<std::uint64_t>(std::max(0.0f, GetFloatOpt(sd, "memoryBudgetMB", 0.0f)) * 1024.0f * 1024.0f);
+		def.maxNodeOpsPerFrame = static_cast<std::uint32_t>(std::max(1.0f, GetFloatOpt(sd, "maxNodeOpsPerFrame", static_cast<float>(def.maxNodeOpsPerFrame))));
+		if (!(def.cellSize > 0.0f))
+		{
+			throw std::runtime_error("Level JSON: streaming.cellSize must be positive");
+		}
+		out.streaming = def;
+	}
+
 	// --- lights ---
 	if (auto* lightsV = TryGet(jsonObject, "lights"))
 	{
@@ -812,6 +841,14 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 			emitter.duration = GetFloatOpt(ed, "duration", emitter.duration);
 			emitter.startDelay = GetFloatOpt(ed, "startDelay", emitter.startDelay);
 			emitter.maxParticles = static_cast<std::uint32_t>(std::max(0.0f, GetFloatOpt(ed, "maxParticles", static_cast<float>(emitter.maxParticles))));
+			if (auto* r = TryGet(ed, "uvRect"))
+			{
+				auto a = ReadFloatArray(*r, 4, "particleEmitters.uvRect");
+				emitter.uvRect = { a[0], a[1], a[2], a[3] };
+			}
+			emitter.flipbookColumns = static_cast<std::uint32_t>(std::max(1.0f, GetFloatOpt(ed, "flipbookColumns", static_cast<float>(emitter.flipbookColumns))));
+			emitter.flipbookRows = static_cast<std::uint32_t>(std::max(1.0f, GetFloatOpt(ed, "flipbookRows", static_cast<float>(emitter.flipbookRows))));
+			emitter.flipbookFps = std::max(0.0f, GetFloatOpt(ed, "flipbookFps", emitter.flipbookFps));
 			out.particleEmitters.push_back(std::move(emitter));
 		}
 	}
@@ -870,6 +907,8 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 			n.name = GetStringOpt(nd, "name");
 			n.parent = static_cast<int>(GetFloatOpt(nd, "parent", -1.0f));
 			n.visible = GetBoolOpt(nd, "visible", true);
+			n.isStatic = GetBoolOpt(nd, "static", false);
+			n.alwaysLoaded = GetBoolOpt(nd, "alwaysLoaded", false);
 			n.alive = GetBoolOpt(nd, "alive", true);
 			if (auto* delV = TryGet(nd, "deleted"))
 			{
@@ -897,8 +936,9 @@ LevelAsset LoadLevelAssetFromJson(std::string_view levelRelativePath)
 				{
 					throw std::runtime_error("Level JSON: node.materialOverrides must be object");
 				}
-				for (const auto& [submeshKey, materialValue] : overridesV->AsObject())
+				for (const auto& [keyView, materialValue] : overridesV->AsObject())
 				{
+					const std::string submeshKey(keyView);
 					if (!materialValue.IsString())
 					{
 						throw std::runtime_error("Level JSON: node.materialOverrides values must be strings");
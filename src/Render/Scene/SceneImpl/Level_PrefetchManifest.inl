@@ -0,0 +1,277 @@
+// ------------------------------------------------------------
+// Prefetch manifest: every texture/mesh load of a level, issued up front in one batch
+// ------------------------------------------------------------
+inline std::uint64_t PrefetchFileSize_(std::string_view path)
+{
+	if (path.empty())
+	{
+		return 0;
+	}
+	const std::optional<corefs::FileStat> stat = corefs::StatAssetFile(corefs::ResolveAsset(std::filesystem::path(std::string(path))));
+	return stat ? stat->bytes : 0;
+}
+
+// Distance bands double in width, so nearby assets are ordered finely and far ones by size.
+inline int PrefetchDistanceBand_(float distance) noexcept
+{
+	if (!std::isfinite(distance))
+	{
+		return std::numeric_limits<int>::max();
+	}
+	return static_cast<int>(std::floor(std::log2(1.0f + std::max(distance, 0.0f))));
+}
+
+inline void KeepCloser_(std::unordered_map<std::string, float>& distances, const std::string& id, float distance)
+{
+	auto [it, inserted] = distances.try_emplace(id, distance);
+	if (!inserted)
+	{
+		it->second = std::min(it->second, distance);
+	}
+}
+
+inline float DistanceOr_(const std::unordered_map<std::string, float>& distances, const std::string& id) noexcept
+{
+	const auto it = distances.find(id);
+	return it != distances.end() ? it->second : std::numeric_limits<float>::infinity();
+}
+
+inline bool IsTextureUsedAsNormalMap_(const LevelAsset& asset, std::string_view textureId)
+{
+	for (const auto& [_, md] : asset.materials)
+	{
+		for (const auto& [slot, boundTextureId] : md.textureBindings)
+		{
+			if (boundTextureId == textureId && slot == "normal")
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+inline void IssueTexturePrefetch_(AssetManager& assets, const LevelAsset& asset, const LevelPrefetchRequest& request)
+{
+	const LevelTextureDef& td = asset.textures.at(request.id);
+	TextureProperties p = td.props;
+	if (td.kind == LevelTextureKind::Tex2D)
+	{
+		p.isNormalMap = p.isNormalMap || IsTextureUsedAsNormalMap_(asset, request.id);
+		if (!std::isfinite(request.viewDistance))
+		{
+			p.streamingPriority = jobs::JobPriority::Prefetch;
+		}
+		assets.LoadTextureAsync(request.id, std::move(p));
+		return;
+	}
+
+	// Six large faces: don't let the skybox hold up the small textures in view.
+	p.streamingPriority = jobs::JobPriority::Background;
+	if (td.cubeSource == LevelCubeSource::Cross)
+	{
+		p.cubeFromCross = true;
+		assets.LoadTextureAsync(request.id, std::move(p));
+	}
+	else if (td.cubeSource == LevelCubeSource::AutoFaces)
+	{
+		if (!td.preferBase.empty())
+		{
+			assets.LoadTextureCubeAsync(request.id, td.baseOrDir, td.preferBase, std::move(p));
+		}
+		else
+		{
+			assets.LoadTextureCubeAsync(request.id, td.baseOrDir, std::move(p));
+		}
+	}
+	else
+	{
+		assets.LoadTextureCubeAsync(request.id, td.facePaths, std::move(p));
+	}
+}
+
+LevelPrefetchManifest BuildLevelPrefetchManifest(const LevelAsset& asset, std::span<const mathUtils::Mat4> nodeWorld, const mathUtils::Vec3& viewPosition)
+{
+	LevelPrefetchManifest manifest;
+
+	// Closest placement of every mesh and material. Unknown ids are left to InstantiateLevel,
+	// which reports them.
+	std::unordered_map<std::string, float> meshDistance;
+	std::unordered_map<std::string, float> materialDistance;
+	for (std::size_t i = 0; i < asset.nodes.size() && i < nodeWorld.size(); ++i)
+	{
+		const LevelNode& n = asset.nodes[i];
+		if (!n.alive || !n.visible || (n.mesh.empty() && n.model.empty() && n.skinnedMesh.empty()))
+		{
+			continue;
+		}
+
+		const float distance = mathUtils::Length(nodeWorld[i][3].xyz() - viewPosition);
+		if (!n.material.empty())
+		{
+			KeepCloser_(materialDistance, n.material, distance);
+		}
+		for (const auto& [_, materialId] : n.materialOverrides)
+		{
+			KeepCloser_(materialDistance, materialId, distance);
+		}
+
+		if (!n.skinnedMesh.empty())
+		{
+			continue;
+		}
+
+		if (!n.model.empty())
+		{
+			const auto modelIt = asset.models.find(n.model);
+			if (modelIt == asset.models.end())
+			{
+				continue;
+			}
+
+			auto sceneIt = manifest.modelScenes.find(n.model);
+			if (sceneIt == manifest.modelScenes.end())
+			{
+				sceneIt = manifest.modelScenes.emplace(n.model, LoadAssimpScene(modelIt->second.path, modelIt->second.flipUVs)).first;
+			}
+			for (const ImportedSubmeshInfo& sub : sceneIt->second.submeshes)
+			{
+				KeepCloser_(meshDistance, n.model + "#submesh=" + std::to_string(sub.submeshIndex), distance);
+			}
+			continue;
+		}
+
+		KeepCloser_(meshDistance, n.mesh, distance);
+	}
+
+	std::unordered_map<std::string, float> textureDistance;
+	for (const auto& [materialId, md] : asset.materials)
+	{
+		const float distance = DistanceOr_(materialDistance, materialId);
+		if (!std::isfinite(distance))
+		{
+			continue;
+		}
+		for (const auto& [_, textureId] : md.textureBindings)
+		{
+			KeepCloser_(textureDistance, textureId, distance);
+		}
+	}
+	for (const ParticleEmitter& emitter : asset.particleEmitters)
+	{
+		if (!emitter.textureId.empty())
+		{
+			KeepCloser_(textureDistance, emitter.textureId, mathUtils::Length(emitter.position - viewPosition));
+		}
+	}
+
+	manifest.requests.reserve(asset.textures.size() + asset.meshes.size() + meshDistance.size());
+	for (const auto& [id, td] : asset.textures)
+	{
+		LevelPrefetchRequest request{};
+		request.kind = LevelPrefetchKind::Texture;
+		request.id = id;
+		request.viewDistance = DistanceOr_(textureDistance, id);
+		if (td.kind == LevelTextureKind::Tex2D)
+		{
+			request.sizeBytes = PrefetchFileSize_(td.props.filePath.empty() ? std::string_view(id) : std::string_view(td.props.filePath));
+		}
+		else
+		{
+			for (const std::string& face : td.facePaths)
+			{
+				request.sizeBytes += PrefetchFileSize_(face);
+			}
+		}
+		manifest.requests.push_back(std::move(request));
+	}
+
+	for (const auto& [id, md] : asset.meshes)
+	{
+		LevelPrefetchRequest request{};
+		request.kind = LevelPrefetchKind::Mesh;
+		request.id = id;
+		request.mesh.filePath = md.path;
+		request.mesh.debugName = md.debugName;
+		request.mesh.flipUVs = md.flipUVs;
+		request.mesh.submeshIndex = md.submeshIndex;
+		request.mesh.bakeNodeTransforms = md.bakeNodeTransforms;
+		request.viewDistance = DistanceOr_(meshDistance, id);
+		request.sizeBytes = PrefetchFileSize_(md.path);
+		manifest.requests.push_back(std::move(request));
+	}
+
+	for (const auto& [modelId, meta] : manifest.modelScenes)
+	{
+		const LevelModelDef& model = asset.models.at(modelId);
+		// Submeshes share one source file: split its size so the model is not ranked as one huge asset.
+		const std::uint64_t modelBytes = PrefetchFileSize_(model.path);
+		const std::uint64_t submeshBytes = meta.submeshes.empty() ? 0 : modelBytes / meta.submeshes.size();
+		for (const ImportedSubmeshInfo& sub : meta.submeshes)
+		{
+			LevelPrefetchRequest request{};
+			request.kind = LevelPrefetchKind::Mesh;
+			request.id = modelId + "#submesh=" + std::to_string(sub.submeshIndex);
+			request.mesh.filePath = model.path;
+			request.mesh.debugName = model.debugName.empty() ? sub.name : (model.debugName + "_" + sub.name);
+			request.mesh.flipUVs = model.flipUVs;
+			request.mesh.submeshIndex = sub.submeshIndex;
+			request.viewDistance = DistanceOr_(meshDistance, request.id);
+			request.sizeBytes = submeshBytes;
+			manifest.requests.push_back(std::move(request));
+		}
+	}
+
+	std::sort(manifest.requests.begin(), manifest.requests.end(), [](const LevelPrefetchRequest& a, const LevelPrefetchRequest& b)
+		{
+			const int bandA = PrefetchDistanceBand_(a.viewDistance);
+			const int bandB = PrefetchDistanceBand_(b.viewDistance);
+			if (bandA != bandB)
+			{
+				return bandA < bandB;
+			}
+			if (a.sizeBytes != b.sizeBytes)
+			{
+				return a.sizeBytes < b.sizeBytes;
+			}
+			if (a.kind != b.kind)
+			{
+				return a.kind < b.kind;
+			}
+			return a.id < b.id;
+		});
+
+	return manifest;
+}
+
+LevelPrefetch IssueLevelPrefetch(AssetManager& assets, const LevelAsset& asset, const LevelPrefetchManifest& manifest)
+{
+	return IssueLevelPrefetch(assets, asset, std::span<const LevelPrefetchRequest>(manifest.requests));
+}
+
+LevelPrefetch IssueLevelPrefetch(AssetManager& assets, const LevelAsset& asset, std::span<const LevelPrefetchRequest> requests)
+{
+	LevelPrefetch prefetch;
+	AssetLoadSet loadSet;
+	for (const LevelPrefetchRequest& request : requests)
+	{
+		if (request.kind == LevelPrefetchKind::Mesh)
+		{
+			MeshProperties p = request.mesh;
+			if (!std::isfinite(request.viewDistance))
+			{
+				p.streamingPriority = jobs::JobPriority::Prefetch;
+			}
+			prefetch.meshes.emplace(request.id, assets.LoadMeshAsync(request.id, std::move(p)));
+			loadSet.meshes.push_back(request.id);
+		}
+		else
+		{
+			IssueTexturePrefetch_(assets, asset, request);
+			loadSet.textures.push_back(request.id);
+		}
+	}
+
+	prefetch.ready = assets.WhenLoaded(std::move(loadSet));
+	return prefetch;
+}
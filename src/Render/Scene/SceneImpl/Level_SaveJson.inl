@@ -27,7 +27,7 @@
 	}
 }
 
-void WriteAnimationParameterLiteral_(std::ostringstream& ss, const AnimationParameterValue& value)
+void WriteAnimationParameterLiteral_(JsonFileWriter& ss, const AnimationParameterValue& value)
 {
 	switch (value.type)
 	{
@@ -63,16 +63,16 @@ void SaveLevelAssetToJson(std::string_view levelRelativeOrAbsPath, const LevelAs
 	const fs::path absPath = corefs::ResolveAsset(fs::path(std::string(levelRelativeOrAbsPath)));
 	fs::create_directories(absPath.parent_path());
 
-	std::ofstream file(absPath, std::ios::binary | std::ios::trunc);
-	if (!file)
+	// Streamed into a temp file and renamed over the level, so a failed save leaves the old file intact.
+	fs::path tmpPath = absPath;
+	tmpPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+	JsonFileWriter ss(tmpPath);
+	if (!ss.IsOpen())
 	{
-		throw std::runtime_error("Level JSON: failed to open for write: " + absPath.string());
+		throw std::runtime_error("Level JSON: failed to open for write: " + tmpPath.string());
 	}
 
-	std::ostringstream ss;
-	ss.setf(std::ios::fixed);
-	ss << std::setprecision(6);
-
 	ss << "{\n";
 	ss << "  \"name\": ";
 	WriteJsonEscaped(ss, level.name);
@@ -662,6 +662,14 @@ void SaveLevelAssetToJson(std::string_view levelRelativeOrAbsPath, const LevelAs
 		WriteJsonFloat(ss, e.startDelay);
 		ss << ", \"maxParticles\": ";
 		ss << e.maxParticles;
+		ss << ", \"uvRect\": ";
+		WriteJsonVec4(ss, e.uvRect);
+		ss << ", \"flipbookColumns\": ";
+		ss << e.flipbookColumns;
+		ss << ", \"flipbookRows\": ";
+		ss << e.flipbookRows;
+		ss << ", \"flipbookFps\": ";
+		WriteJsonFloat(ss, e.flipbookFps);
 		ss << "}";
 	}
 	if (!level.particleEmitters.empty()) ss << "\n  ";
@@ -679,6 +687,21 @@ void SaveLevelAssetToJson(std::string_view levelRelativeOrAbsPath, const LevelAs
 	}
 	ss << ",\n";
 
+	if (level.streaming)
+	{
+		const LevelStreamingDef& sd = *level.streaming;
+		ss << "  \"streaming\": {\"cellSize\": ";
+		WriteJsonFloat(ss, sd.cellSize);
+		ss << ", \"loadRadius\": ";
+		WriteJsonFloat(ss, sd.loadRadius);
+		ss << ", \"unloadRadius\": ";
+		WriteJsonFloat(ss, sd.unloadRadius);
+		ss << ", \"memoryBudgetMB\": ";
+		WriteJsonFloat(ss, static_cast<float>(static_cast<double>(sd.memoryBudgetBytes) / (1024.0 * 1024.0)));
+		ss << ", \"maxNodeOpsPerFrame\": " << sd.maxNodeOpsPerFrame;
+		ss << "},\n";
+	}
+
 	// nodes (alive only)
 	ss << "  \"nodes\": [";
 	for (std::size_t ni = 0; ni < newToOld.size(); ++ni)
@@ -699,6 +722,16 @@ void SaveLevelAssetToJson(std::string_view levelRelativeOrAbsPath, const LevelAs
 		ss << ", \"parent\": " << parent;
 		ss << ", \"visible\": ";
 		WriteJsonBool(ss, n.visible);
+		if (n.isStatic)
+		{
+			ss << ", \"static\": ";
+			WriteJsonBool(ss, n.isStatic);
+		}
+		if (n.alwaysLoaded)
+		{
+			ss << ", \"alwaysLoaded\": ";
+			WriteJsonBool(ss, n.alwaysLoaded);
+		}
 
 		if (!n.model.empty())
 		{
@@ -794,11 +827,33 @@ void SaveLevelAssetToJson(std::string_view levelRelativeOrAbsPath, const LevelAs
 
 	ss << "}\n";
 
-	const std::string outText = ss.str();
-	file.write(outText.data(), static_cast<std::streamsize>(outText.size()));
-	file.flush();
-	if (!file)
+	if (!ss.Finish())
 	{
+		std::error_code ec;
+		fs::remove(tmpPath, ec);
 		throw std::runtime_error("Level JSON: failed to write: " + absPath.string());
 	}
+	fs::rename(tmpPath, absPath);
+}
+
+std::shared_future<void> SaveLevelAssetToJsonAsync(jobs::Scheduler& scheduler, std::string levelRelativeOrAbsPath, LevelAsset level)
+{
+	auto done = std::make_shared<std::promise<void>>();
+	std::shared_future<void> future = done->get_future().share();
+	scheduler.Schedule(
+		[done, path = std::move(levelRelativeOrAbsPath), level = std::move(level)]()
+		{
+			try
+			{
+				SaveLevelAssetToJson(path, level);
+				done->set_value();
+			}
+			catch (...)
+			{
+				done->set_exception(std::current_exception());
+			}
+		},
+		{},
+		jobs::JobOptions{ .priority = jobs::JobPriority::Background });
+	return future;
 }
\ No newline at end of file
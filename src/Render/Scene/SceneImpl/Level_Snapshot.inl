@@ -0,0 +1,524 @@
+// -----------------------------
+// Binary level snapshot (.clvl)
+// -----------------------------
+// A LevelAsset as LoadLevelAssetFromJson returns it, with external controller, notify and event binding
+// files already merged. Every field is written in a fixed order as a length-prefixed record. The blob has
+// no pointers or offsets, so it is position independent and is decoded straight out of one mapping.
+// The header is followed by the stamps of every JSON file the asset was built from. If any stamp no
+// longer matches, the snapshot is stale.
+// Bump kLevelSnapshotVersion whenever a serialized struct gains, loses or reorders a field.
+inline constexpr std::uint32_t kLevelSnapshotMagic = 0x4C564C43u; // "CLVL"
+inline constexpr std::uint32_t kLevelSnapshotVersion = 3u;
+
+struct LevelSnapshotHeader
+{
+	std::uint32_t magic{ kLevelSnapshotMagic };
+	std::uint32_t version{ kLevelSnapshotVersion };
+	std::uint64_t sourceCount{ 0 };
+};
+
+class LevelSnapshotWriter_
+{
+public:
+	static constexpr bool kReading = false;
+
+	void Bytes(const void* data, std::size_t size)
+	{
+		const std::byte* first = static_cast<const std::byte*>(data);
+		bytes.insert(bytes.end(), first, first + size);
+	}
+	bool Reserve(std::uint64_t) const noexcept { return true; }
+	bool Ok() const noexcept { return true; }
+
+	std::vector<std::byte> bytes;
+};
+
+class LevelSnapshotReader_
+{
+public:
+	static constexpr bool kReading = true;
+
+	explicit LevelSnapshotReader_(std::span<const std::byte> bytes) noexcept : bytes_(bytes) {}
+
+	void Bytes(void* data, std::size_t size)
+	{
+		if (!ok_ || bytes_.size() - offset_ < size)
+		{
+			ok_ = false;
+			return;
+		}
+		if (size != 0)
+		{
+			std::memcpy(data, bytes_.data() + offset_, size);
+			offset_ += size;
+		}
+	}
+
+	// Every serialized element takes at least one byte, so a count past the remaining bytes is corrupt
+	// (and is rejected before anything is allocated for it).
+	bool Reserve(std::uint64_t count) noexcept
+	{
+		ok_ = ok_ && count <= bytes_.size() - offset_;
+		return ok_;
+	}
+
+	bool Ok() const noexcept { return ok_; }
+	bool AtEnd() const noexcept { return offset_ == bytes_.size(); }
+
+private:
+	std::span<const std::byte> bytes_;
+	std::size_t offset_{ 0 };
+	bool ok_{ true };
+};
+
+// One Transfer per type, shared by the writer and the reader so the two field lists cannot drift apart.
+// Members of a class see each other regardless of declaration order, which the recursive overloads need.
+struct LevelSnapshotCodec_
+{
+	template <typename Ar, typename T>
+		requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+	static void Transfer(Ar& ar, T& value)
+	{
+		ar.Bytes(&value, sizeof(value));
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, bool& value)
+	{
+		std::uint8_t byte = value ? 1u : 0u;
+		ar.Bytes(&byte, sizeof(byte));
+		if constexpr (Ar::kReading)
+		{
+			value = byte != 0u;
+		}
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, std::string& s)
+	{
+		std::uint64_t size = s.size();
+		Transfer(ar, size);
+		if constexpr (Ar::kReading)
+		{
+			if (!ar.Reserve(size))
+			{
+				return;
+			}
+			s.resize(static_cast<std::size_t>(size));
+		}
+		ar.Bytes(s.data(), s.size());
+	}
+
+	template <typename Ar, typename T>
+	static void Transfer(Ar& ar, std::vector<T>& items)
+	{
+		std::uint64_t count = items.size();
+		Transfer(ar, count);
+		if constexpr (Ar::kReading)
+		{
+			if (!ar.Reserve(count))
+			{
+				return;
+			}
+			items.resize(static_cast<std::size_t>(count));
+		}
+		for (T& item : items)
+		{
+			Transfer(ar, item);
+		}
+	}
+
+	template <typename Ar, typename T, std::size_t N>
+	static void Transfer(Ar& ar, std::array<T, N>& items)
+	{
+		for (T& item : items)
+		{
+			Transfer(ar, item);
+		}
+	}
+
+	template <typename Ar, typename T>
+	static void Transfer(Ar& ar, std::optional<T>& value)
+	{
+		bool present = value.has_value();
+		Transfer(ar, present);
+		if constexpr (Ar::kReading)
+		{
+			value.reset();
+			if (present)
+			{
+				value.emplace();
+			}
+		}
+		if (value)
+		{
+			Transfer(ar, *value);
+		}
+	}
+
+	template <typename Ar, typename K, typename V>
+	static void Transfer(Ar& ar, std::unordered_map<K, V>& map)
+	{
+		std::uint64_t count = map.size();
+		Transfer(ar, count);
+		if constexpr (Ar::kReading)
+		{
+			map.clear();
+			if (!ar.Reserve(count))
+			{
+				return;
+			}
+			map.reserve(static_cast<std::size_t>(count));
+			for (std::uint64_t i = 0; i < count && ar.Ok(); ++i)
+			{
+				K key{};
+				V value{};
+				Transfer(ar, key);
+				Transfer(ar, value);
+				map.emplace(std::move(key), std::move(value));
+			}
+		}
+		else
+		{
+			// Key order, so the same asset always produces the same bytes.
+			std::vector<std::pair<const K, V>*> entries;
+			entries.reserve(map.size());
+			for (auto& entry : map)
+			{
+				entries.push_back(&entry);
+			}
+			std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+			for (auto* entry : entries)
+			{
+				Transfer(ar, const_cast<K&>(entry->first));
+				Transfer(ar, entry->second);
+			}
+		}
+	}
+
+	template <typename Ar, typename... T>
+	static void Fields(Ar& ar, T&... fields)
+	{
+		(Transfer(ar, fields), ...);
+	}
+
+	template <typename Ar> static void Transfer(Ar& ar, mathUtils::Vec3& v) { Fields(ar, v.x, v.y, v.z); }
+	template <typename Ar> static void Transfer(Ar& ar, mathUtils::Vec4& v) { Fields(ar, v.x, v.y, v.z, v.w); }
+	template <typename Ar> static void Transfer(Ar& ar, mathUtils::Mat4& m) { Fields(ar, m[0], m[1], m[2], m[3]); }
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, Transform& t)
+	{
+		Fields(ar, t.position, t.rotationDegrees, t.scale, t.useMatrix, t.matrix);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, Camera& c)
+	{
+		Fields(ar, c.position, c.target, c.up, c.fovYDeg, c.nearZ, c.farZ);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, Light& l)
+	{
+		Fields(ar, l.type, l.position, l.direction, l.color, l.intensity, l.range, l.innerHalfAngleDeg, l.outerHalfAngleDeg,
+			l.attConstant, l.attLinear, l.attQuadratic);
+	}
+
+	// Runtime state (descriptor index, elapsed time, spawn counters) is not part of the asset.
+	template <typename Ar>
+	static void Transfer(Ar& ar, ParticleEmitter& e)
+	{
+		Fields(ar, e.name, e.textureId, e.enabled, e.looping, e.position, e.positionJitter, e.velocityMin, e.velocityMax,
+			e.color, e.colorBegin, e.colorEnd, e.sizeMin, e.sizeMax, e.sizeBegin, e.sizeEnd, e.lifetimeMin, e.lifetimeMax,
+			e.spawnRate, e.burstCount, e.duration, e.startDelay, e.maxParticles, e.uvRect, e.flipbookColumns, e.flipbookRows,
+			e.flipbookFps);
+	}
+
+	// Descriptor indices are bound when the level is instantiated.
+	template <typename Ar>
+	static void Transfer(Ar& ar, Material& m)
+	{
+		MaterialParams& p = m.params;
+		Fields(ar, p.baseColor, p.shininess, p.specStrength, p.shadowBias, p.metallic, p.roughness, p.ao, p.emissiveStrength,
+			m.permFlags, m.envSource);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, TextureProperties& p)
+	{
+		Fields(ar, p.width, p.height, p.format, p.dimension, p.filePath, p.cubeFacePaths, p.srgb, p.generateMips, p.isNormalMap,
+			p.flipY, p.cubeFromCross, p.allowMipStreaming, p.streamingPriority);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelMeshDef& d)
+	{
+		Fields(ar, d.path, d.debugName, d.flipUVs, d.submeshIndex, d.bakeNodeTransforms);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelModelDef& d)
+	{
+		Fields(ar, d.path, d.debugName, d.flipUVs);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelSkinnedMeshDef& d)
+	{
+		Fields(ar, d.path, d.debugName, d.flipUVs, d.submeshIndex);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelAnimationDef& d)
+	{
+		Fields(ar, d.path, d.debugName, d.flipUVs);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelTextureDef& d)
+	{
+		Fields(ar, d.kind, d.props, d.cubeSource, d.baseOrDir, d.preferBase, d.facePaths);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelMaterialDef& d)
+	{
+		Fields(ar, d.material, d.textureBindings);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationParameterValue& v)
+	{
+		Fields(ar, v.type, v.boolValue, v.intValue, v.floatValue, v.triggerValue);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationParameterDesc& d)
+	{
+		Fields(ar, d.name, d.defaultValue);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationBlend1DPoint& p)
+	{
+		Fields(ar, p.clipName, p.value);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationNotifyDesc& d)
+	{
+		Fields(ar, d.id, d.timeNormalized, d.fireOnEnter);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationStateDesc& d)
+	{
+		Fields(ar, d.name, d.clipName, d.clipSourceAssetId, d.blendParameter, d.blend1D, d.notifies, d.tags, d.looping, d.playRate);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationConditionDesc& d)
+	{
+		Fields(ar, d.parameter, d.op, d.value);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationTransitionDesc& d)
+	{
+		Fields(ar, d.fromState, d.toState, d.hasExitTime, d.exitTimeNormalized, d.blendDurationSeconds, d.priority, d.conditions);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationEventBindingDesc& d)
+	{
+		Fields(ar, d.animationEventId, d.gameplayEventId);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, AnimationControllerAsset& a)
+	{
+		Fields(ar, a.id, a.defaultState, a.notifyAssetPath, a.eventBindingsAssetPath, a.parameters, a.states, a.transitions, a.eventBindings);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelNode& n)
+	{
+		Fields(ar, n.name, n.parent, n.visible, n.alive, n.isStatic, n.alwaysLoaded, n.transform, n.mesh, n.model, n.skinnedMesh, n.material,
+			n.animation, n.animationController, n.animationClip, n.animationInPlace, n.animationRootMotionBone, n.animationAutoplay,
+			n.animationLoop, n.animationPlayRate, n.materialOverrides);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelStreamingDef& d)
+	{
+		Fields(ar, d.cellSize, d.loadRadius, d.unloadRadius, d.memoryBudgetBytes, d.maxNodeOpsPerFrame);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, LevelAsset& a)
+	{
+		Fields(ar, a.name, a.sourcePath, a.meshes, a.models, a.skinnedMeshes, a.animations, a.animationControllers,
+			a.animationControllerAssetPaths, a.textures, a.materials, a.camera, a.lights, a.particleEmitters, a.skyboxTexture,
+			a.streaming, a.nodes);
+	}
+
+	template <typename Ar>
+	static void Transfer(Ar& ar, CookedFileStamp& s)
+	{
+		Fields(ar, s.path, s.bytes, s.writeTime);
+	}
+};
+
+// Stamps of the level file and every JSON file merged into it; nullopt if one of them is gone.
+std::optional<std::vector<CookedFileStamp>> StampLevelSnapshotSources_(const LevelAsset& level, std::string_view levelPath)
+{
+	std::vector<std::string> paths{ std::string(levelPath) };
+	for (const auto& [_, path] : level.animationControllerAssetPaths)
+	{
+		paths.push_back(path);
+	}
+	for (const auto& [_, controller] : level.animationControllers)
+	{
+		for (const std::string* path : { &controller.notifyAssetPath, &controller.eventBindingsAssetPath })
+		{
+			if (!path->empty())
+			{
+				paths.push_back(*path);
+			}
+		}
+	}
+	std::sort(paths.begin() + 1, paths.end());
+	paths.erase(std::unique(paths.begin() + 1, paths.end()), paths.end());
+
+	std::vector<CookedFileStamp> stamps;
+	stamps.reserve(paths.size());
+	for (const std::string& path : paths)
+	{
+		std::optional<CookedFileStamp> stamp = StampCookedInput(path);
+		if (!stamp)
+		{
+			return std::nullopt;
+		}
+		stamps.push_back(std::move(*stamp));
+	}
+	return stamps;
+}
+
+std::filesystem::path LevelSnapshotPath(std::string_view levelPath)
+{
+	const std::string key = NormalizeCookedAssetPath(std::filesystem::path(std::string(levelPath)));
+	const std::uint64_t hash = HashCookBytes(std::as_bytes(std::span(key.data(), key.size())));
+	return corefs::CookedCacheRoot() / "levels" / (CookKeyHex(hash) + ".clvl");
+}
+
+// Same temp-file + rename scheme as WriteCookedMesh.
+void SaveLevelSnapshot(const std::filesystem::path& path, const LevelAsset& level, std::span<const CookedFileStamp> sources)
+{
+	LevelSnapshotWriter_ writer;
+	LevelSnapshotHeader header{};
+	header.sourceCount = sources.size();
+	writer.Bytes(&header, sizeof(header));
+	for (const CookedFileStamp& source : sources)
+	{
+		LevelSnapshotCodec_::Transfer(writer, const_cast<CookedFileStamp&>(source));
+	}
+	LevelSnapshotCodec_::Transfer(writer, const_cast<LevelAsset&>(level));
+
+	std::filesystem::create_directories(path.parent_path());
+	std::filesystem::path tmpPath = path;
+	tmpPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+	{
+		std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			throw std::runtime_error("Failed to create level snapshot: " + tmpPath.string());
+		}
+		out.write(reinterpret_cast<const char*>(writer.bytes.data()), static_cast<std::streamsize>(writer.bytes.size()));
+		if (!out)
+		{
+			out.close();
+			std::error_code ec;
+			std::filesystem::remove(tmpPath, ec);
+			throw std::runtime_error("Failed to write level snapshot: " + tmpPath.string());
+		}
+	}
+	std::filesystem::rename(tmpPath, path);
+}
+
+std::optional<LevelAsset> ReadLevelSnapshot(const std::filesystem::path& path, bool checkSources)
+{
+	std::error_code ec;
+	if (!std::filesystem::is_regular_file(path, ec))
+	{
+		return std::nullopt;
+	}
+
+	std::optional<corefs::MappedFile> file;
+	try
+	{
+		file.emplace(path);
+	}
+	catch (const std::exception&)
+	{
+		return std::nullopt;
+	}
+
+	LevelSnapshotReader_ reader(file->Bytes());
+	LevelSnapshotHeader header{};
+	reader.Bytes(&header, sizeof(header));
+	if (!reader.Ok() || header.magic != kLevelSnapshotMagic || header.version != kLevelSnapshotVersion || !reader.Reserve(header.sourceCount))
+	{
+		return std::nullopt;
+	}
+
+	for (std::uint64_t i = 0; i < header.sourceCount; ++i)
+	{
+		CookedFileStamp recorded{};
+		LevelSnapshotCodec_::Transfer(reader, recorded);
+		if (!reader.Ok())
+		{
+			return std::nullopt;
+		}
+		if (checkSources)
+		{
+			const std::optional<CookedFileStamp> current = StampCookedInput(recorded.path);
+			if (!current || current->bytes != recorded.bytes || current->writeTime != recorded.writeTime)
+			{
+				return std::nullopt;
+			}
+		}
+	}
+
+	LevelAsset level;
+	LevelSnapshotCodec_::Transfer(reader, level);
+	if (!reader.Ok() || !reader.AtEnd())
+	{
+		return std::nullopt;
+	}
+	return level;
+}
+
+LevelAsset LoadLevelAsset(std::string_view levelRelativePath)
+{
+	const std::filesystem::path snapshotPath = LevelSnapshotPath(levelRelativePath);
+	if (std::optional<LevelAsset> snapshot = ReadLevelSnapshot(snapshotPath, true))
+	{
+		snapshot->sourcePath = std::string(levelRelativePath);
+		return std::move(*snapshot);
+	}
+
+	LevelAsset level = LoadLevelAssetFromJson(levelRelativePath);
+	if (const std::optional<std::vector<CookedFileStamp>> sources = StampLevelSnapshotSources_(level, levelRelativePath))
+	{
+		try
+		{
+			SaveLevelSnapshot(snapshotPath, level, *sources);
+		}
+		catch (...)
+		{
+			// Read-only asset tree or full disk: keep serving the fresh parse.
+		}
+	}
+	return level;
+}
@@ -17,6 +17,25 @@ import std;
 
 export namespace rendern
 {
+	// World-space bounding sphere (xyz = center, w = radius) of a local sphere under model; the radius is
+	// scaled by the largest axis scale, so it stays conservative under non-uniform scale.
+	[[nodiscard]] mathUtils::Vec4 WorldBoundingSphere(
+		const mathUtils::Vec3& sphereCenter,
+		float sphereRadius,
+		const mathUtils::Mat4& model)
+	{
+		const mathUtils::Vec4 wc4 = model * mathUtils::Vec4(sphereCenter, 1.0f);
+
+		const mathUtils::Vec3 c0{ model[0].x, model[0].y, model[0].z };
+		const mathUtils::Vec3 c1{ model[1].x, model[1].y, model[1].z };
+		const mathUtils::Vec3 c2{ model[2].x, model[2].y, model[2].z };
+		const float s0 = mathUtils::Length(c0);
+		const float s1 = mathUtils::Length(c1);
+		const float s2 = mathUtils::Length(c2);
+		const float maxScale = std::max(s0, std::max(s1, s2));
+		return { wc4.x, wc4.y, wc4.z, sphereRadius * maxScale };
+	}
+
 	[[nodiscard]] bool IsVisibleSphere(
 		const mathUtils::Vec3& sphereCenter,
 		float sphereRadius,
@@ -33,20 +52,61 @@ export namespace rendern
 			return true;
 		}
 
-		const mathUtils::Vec4 wc4 = model * mathUtils::Vec4(sphereCenter, 1.0f);
-		const mathUtils::Vec3 worldCenter{ wc4.x, wc4.y, wc4.z };
+		const mathUtils::Vec4 worldSphere = WorldBoundingSphere(sphereCenter, sphereRadius, model);
+		return mathUtils::IntersectsSphere(cameraFrustum, mathUtils::Vec3{ worldSphere.x, worldSphere.y, worldSphere.z }, worldSphere.w);
+	}
 
-		const mathUtils::Vec3 c0{ model[0].x, model[0].y, model[0].z };
-		const mathUtils::Vec3 c1{ model[1].x, model[1].y, model[1].z };
-		const mathUtils::Vec3 c2{ model[2].x, model[2].y, model[2].z };
-		const float s0 = mathUtils::Length(c0);
-		const float s1 = mathUtils::Length(c1);
-		const float s2 = mathUtils::Length(c2);
-		const float maxScale = std::max(s0, std::max(s1, s2));
-		const float worldRadius = sphereRadius * maxScale;
+	// World bounding spheres of an item list as separate streams, culled a whole frustum at a time with
+	// mathUtils::CullSpheres. Items without bounds get an infinite radius, so they pass every frustum, as in
+	// IsVisibleSphere. Set writes distinct slots, so workers may fill disjoint ranges in parallel.
+	struct WorldSphereStreams
+	{
+		std::vector<float> centerX;
+		std::vector<float> centerY;
+		std::vector<float> centerZ;
+		std::vector<float> radius;
 
-		return mathUtils::IntersectsSphere(cameraFrustum, worldCenter, worldRadius);
-	}
+		void Resize(std::size_t count)
+		{
+			centerX.resize(count);
+			centerY.resize(count);
+			centerZ.resize(count);
+			radius.resize(count);
+		}
+
+		std::size_t Size() const noexcept { return radius.size(); }
+
+		void Set(std::size_t i, const mathUtils::Vec3& sphereCenter, float sphereRadius, const mathUtils::Mat4& model) noexcept
+		{
+			if (sphereRadius <= 0.0f)
+			{
+				SetNeverCulled(i);
+				return;
+			}
+			const mathUtils::Vec4 worldSphere = WorldBoundingSphere(sphereCenter, sphereRadius, model);
+			centerX[i] = worldSphere.x;
+			centerY[i] = worldSphere.y;
+			centerZ[i] = worldSphere.z;
+			radius[i] = worldSphere.w;
+		}
+
+		void SetNeverCulled(std::size_t i) noexcept
+		{
+			centerX[i] = 0.0f;
+			centerY[i] = 0.0f;
+			centerZ[i] = 0.0f;
+			radius[i] = std::numeric_limits<float>::infinity();
+		}
+
+		bool IsNeverCulled(std::size_t i) const noexcept { return std::isinf(radius[i]); }
+		mathUtils::Vec4 Get(std::size_t i) const noexcept { return { centerX[i], centerY[i], centerZ[i], radius[i] }; }
+
+		// outVisibleMask holds mathUtils::CullMaskWordCount(Size()) words.
+		void Cull(const mathUtils::Frustum& frustum, std::span<std::uint32_t> outVisibleMask) const noexcept
+		{
+			mathUtils::CullSpheres(frustum, centerX, centerY, centerZ, radius, outVisibleMask);
+		}
+	};
 
 	bool IsVisible(
 		const rendern::MeshResource* meshRes,
@@ -0,0 +1,200 @@
+module;
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+export module core:shadow_atlas;
+
+import :math_utils;
+
+// Spot shadow atlas: one square depth texture shared by every shadowed spot light.
+//
+// Tiles are power-of-two squares handed out by a quadtree: a free node either becomes one tile or is
+// split into four children of half its size. The atlas is packed from scratch every frame, largest
+// request first, so the layout never fragments. The requested size follows the light's screen coverage,
+// so near and large lights get the big tiles; when the requests do not fit, tiles shrink down to the
+// minimum size, and a light that finds no room even then gets no shadow this frame.
+
+export namespace rendern
+{
+	struct ShadowAtlasTile
+	{
+		std::uint32_t x{ 0 };
+		std::uint32_t y{ 0 };
+		std::uint32_t size{ 0 }; // 0: no tile
+
+		[[nodiscard]] bool Valid() const noexcept { return size != 0; }
+	};
+
+	class ShadowAtlasAllocator
+	{
+	public:
+		ShadowAtlasAllocator(std::uint32_t atlasSize, std::uint32_t minTileSize)
+		{
+			Reset(atlasSize, minTileSize);
+		}
+
+		// Frees every tile. atlasSize and minTileSize are rounded down to powers of two.
+		void Reset(std::uint32_t atlasSize, std::uint32_t minTileSize)
+		{
+			atlasSize_ = std::bit_floor(std::max(atlasSize, 1u));
+			minTileSize_ = std::min(std::bit_floor(std::max(minTileSize, 1u)), atlasSize_);
+			nodes_.clear();
+			nodes_.push_back(Node{ .x = 0, .y = 0, .size = atlasSize_ });
+		}
+
+		// Tile of exactly `size` (rounded up to a power of two, clamped to [minTileSize, atlasSize]),
+		// or an invalid tile if no free node of that size is left.
+		[[nodiscard]] ShadowAtlasTile Allocate(std::uint32_t size)
+		{
+			const std::uint32_t tileSize = std::clamp(std::bit_ceil(std::max(size, 1u)), minTileSize_, atlasSize_);
+			return AllocateIn(0, tileSize);
+		}
+
+		[[nodiscard]] std::uint32_t AtlasSize() const noexcept { return atlasSize_; }
+		[[nodiscard]] std::uint32_t MinTileSize() const noexcept { return minTileSize_; }
+
+	private:
+		struct Node
+		{
+			std::uint32_t x{ 0 };
+			std::uint32_t y{ 0 };
+			std::uint32_t size{ 0 };
+			std::uint32_t firstChild{ 0 }; // 0: leaf (the root is never a child)
+			bool used{ false };
+		};
+
+		ShadowAtlasTile AllocateIn(std::size_t nodeIndex, std::uint32_t size)
+		{
+			if (nodes_[nodeIndex].used || nodes_[nodeIndex].size < size)
+			{
+				return {};
+			}
+			if (nodes_[nodeIndex].firstChild == 0)
+			{
+				const Node node = nodes_[nodeIndex];
+				if (node.size == size)
+				{
+					nodes_[nodeIndex].used = true;
+					return ShadowAtlasTile{ .x = node.x, .y = node.y, .size = node.size };
+				}
+
+				const std::uint32_t half = node.size / 2u;
+				nodes_[nodeIndex].firstChild = static_cast<std::uint32_t>(nodes_.size());
+				nodes_.push_back(Node{ .x = node.x, .y = node.y, .size = half });
+				nodes_.push_back(Node{ .x = node.x + half, .y = node.y, .size = half });
+				nodes_.push_back(Node{ .x = node.x, .y = node.y + half, .size = half });
+				nodes_.push_back(Node{ .x = node.x + half, .y = node.y + half, .size = half });
+			}
+
+			const std::size_t firstChild = nodes_[nodeIndex].firstChild;
+			for (std::size_t child = 0; child < 4; ++child)
+			{
+				const ShadowAtlasTile tile = AllocateIn(firstChild + child, size);
+				if (tile.Valid())
+				{
+					return tile;
+				}
+			}
+			return {};
+		}
+
+		std::uint32_t atlasSize_{ 0 };
+		std::uint32_t minTileSize_{ 0 };
+		std::vector<Node> nodes_;
+	};
+
+	// Sphere around a spot light's cone (apex at `position`, axis `direction`, length `range`).
+	// Narrow cones are centred on the axis so the sphere passes through the apex and the rim; cones wider
+	// than 90 degrees are bounded by their rim circle.
+	[[nodiscard]] mathUtils::Vec4 SpotLightBoundingSphere(const mathUtils::Vec3& position, const mathUtils::Vec3& direction,
+		float range, float outerHalfAngleDeg) noexcept
+	{
+		const mathUtils::Vec3 axis = mathUtils::Normalize(direction);
+		const float halfAngle = mathUtils::DegToRad(std::clamp(outerHalfAngleDeg, 1.0f, 89.0f));
+		const float cosHalf = std::cos(halfAngle);
+		if (halfAngle > 0.25f * mathUtils::Pi)
+		{
+			const mathUtils::Vec3 center = position + axis * (range * cosHalf);
+			return mathUtils::Vec4(center, range * std::sin(halfAngle));
+		}
+		const float radius = range / (2.0f * cosHalf);
+		const mathUtils::Vec3 center = position + axis * radius;
+		return mathUtils::Vec4(center, radius);
+	}
+
+	// Shadow tile size for a light whose bounding sphere spans `screenCoverage` of the view height
+	// (see MeshLodScreenSize; closer lights cover more): maxTileSize at full coverage, halved with the
+	// coverage, rounded up to a power of two and clamped to [minTileSize, maxTileSize].
+	[[nodiscard]] std::uint32_t SpotShadowTileSize(float screenCoverage, std::uint32_t maxTileSize, std::uint32_t minTileSize) noexcept
+	{
+		const std::uint32_t maxTile = std::bit_floor(std::max(maxTileSize, 1u));
+		const std::uint32_t minTile = std::min(std::bit_floor(std::max(minTileSize, 1u)), maxTile);
+		const float wanted = std::clamp(screenCoverage, 0.0f, 1.0f) * static_cast<float>(maxTile);
+		const std::uint32_t size = std::bit_ceil(static_cast<std::uint32_t>(std::max(wanted, 1.0f)));
+		return std::clamp(size, minTile, maxTile);
+	}
+
+	// Packs the requested tile sizes into one atlas. outTiles[i] is the tile of requestedSizes[i].
+	// Requests are placed largest first, ties in request order (pass them by priority). A request is
+	// halved while taking its size would leave too little area for a minimum tile per request still to
+	// come, so an overfull atlas shrinks the large tiles instead of starving the later lights; power-of-two
+	// squares placed largest first pack without gaps, so the area check is exact. Requests that find no
+	// room even at minTileSize get no tile. Returns the number of tiles placed.
+	std::uint32_t PackShadowAtlas(std::span<const std::uint32_t> requestedSizes, std::uint32_t atlasSize,
+		std::uint32_t minTileSize, std::span<ShadowAtlasTile> outTiles)
+	{
+		std::fill(outTiles.begin(), outTiles.end(), ShadowAtlasTile{});
+
+		std::vector<std::size_t> order(std::min(requestedSizes.size(), outTiles.size()));
+		std::iota(order.begin(), order.end(), std::size_t{ 0 });
+		std::stable_sort(order.begin(), order.end(), [requestedSizes](std::size_t a, std::size_t b)
+			{
+				return requestedSizes[a] > requestedSizes[b];
+			});
+
+		ShadowAtlasAllocator allocator(atlasSize, minTileSize);
+		const auto Area = [](std::uint32_t size) { return static_cast<std::uint64_t>(size) * size; };
+		const std::uint64_t atlasArea = Area(allocator.AtlasSize());
+		const std::uint64_t minArea = Area(allocator.MinTileSize());
+
+		std::uint64_t usedArea = 0;
+		std::uint32_t placed = 0;
+		for (std::size_t k = 0; k < order.size(); ++k)
+		{
+			const std::size_t requestIndex = order[k];
+			const std::uint64_t reservedArea = static_cast<std::uint64_t>(order.size() - k - 1) * minArea;
+
+			std::uint32_t size = std::clamp(std::bit_ceil(std::max(requestedSizes[requestIndex], 1u)),
+				allocator.MinTileSize(), allocator.AtlasSize());
+			while (size > allocator.MinTileSize() && usedArea + Area(size) + reservedArea > atlasArea)
+			{
+				size /= 2u;
+			}
+
+			for (;;)
+			{
+				const ShadowAtlasTile tile = allocator.Allocate(size);
+				if (tile.Valid())
+				{
+					outTiles[requestIndex] = tile;
+					usedArea += Area(tile.size);
+					++placed;
+					break;
+				}
+				if (size <= allocator.MinTileSize())
+				{
+					break;
+				}
+				size /= 2u;
+			}
+		}
+		return placed;
+	}
+}
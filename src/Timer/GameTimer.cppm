@@ -2,6 +2,7 @@ module;
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 
 export module core:gametimer_core;
@@ -67,6 +68,7 @@ export struct FixedStepResult
     int tickToSimulate{ 0 };
     std::int64_t firstTickindex{ 0 };
     double alpha{ 0.0 };
+    int droppedTicks{ 0 }; // due ticks beyond the catch-up cap, skipped instead of carried over
 };
 
 export class FixedStepScheduler
@@ -189,6 +191,20 @@ FixedStepResult FixedStepScheduler::Advance(double frameDeltaSec)
         ++tickIndex_;
     }
 
+    // A frame longer than the cap allows is not made up later: carrying the backlog over would
+    // make every following frame run the full cap (spiral of death).
+    if (accumulatedDeltaSec_ >= fixedDeltaSec_)
+    {
+        double dropped = std::floor(accumulatedDeltaSec_ / fixedDeltaSec_);
+        accumulatedDeltaSec_ = std::max(accumulatedDeltaSec_ - dropped * fixedDeltaSec_, 0.0);
+        if (accumulatedDeltaSec_ >= fixedDeltaSec_) // rounding of the division
+        {
+            accumulatedDeltaSec_ -= fixedDeltaSec_;
+            dropped += 1.0;
+        }
+        result.droppedTicks = static_cast<int>(dropped);
+    }
+
     result.tickToSimulate = tickCount;
     result.alpha = std::clamp(accumulatedDeltaSec_ / fixedDeltaSec_, 0.0, 1.0);
     return result;
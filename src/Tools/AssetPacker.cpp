@@ -0,0 +1,116 @@
+import core;
+import std;
+
+// Offline asset packer: writes every file under assets/ (cooked artifacts and the cooked
+// manifest included) into one pack that corefs::MountAssetPacks mounts at the asset root, so a
+// shipping build maps one file instead of opening thousands.
+//
+//   AssetPacker [--root <dir containing assets/>] [--out <pack>] [--store] [--alignment N]
+//
+// The default output is assets.pak next to assets/. Entries are compressed with LZ4 unless
+// --store is given or compression saves too little; stored entries are aligned to --alignment
+// (default 4096) so mapped views of them are page aligned.
+
+namespace assetPacker
+{
+    namespace fs = std::filesystem;
+
+    struct Options
+    {
+        fs::path root{};
+        fs::path out{};
+        corefs::PackWriteOptions write{};
+    };
+
+    std::optional<Options> ParseArgs(int argc, char** argv)
+    {
+        Options options{};
+        options.root = fs::current_path();
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            if (arg == "--store")
+            {
+                options.write.compress = false;
+            }
+            else if (arg == "--root" && i + 1 < argc)
+            {
+                options.root = fs::path(argv[++i]);
+            }
+            else if (arg == "--out" && i + 1 < argc)
+            {
+                options.out = fs::path(argv[++i]);
+            }
+            else if (arg == "--alignment" && i + 1 < argc)
+            {
+                options.write.alignment = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    namespace fs = std::filesystem;
+    using namespace assetPacker;
+
+    const std::optional<Options> options = ParseArgs(argc, argv);
+    if (!options)
+    {
+        std::cerr << "usage: AssetPacker [--root <dir containing assets/>] [--out <pack>] [--store] [--alignment N]\n";
+        return 1;
+    }
+
+    try
+    {
+        // corefs::FindAssetRoot searches upwards from the working directory.
+        fs::current_path(options->root);
+        const fs::path assetRoot = fs::absolute(corefs::FindAssetRoot());
+        if (!fs::is_directory(assetRoot))
+        {
+            std::cerr << "AssetPacker: no assets/ directory under " << options->root.string() << "\n";
+            return 1;
+        }
+        const fs::path out = options->out.empty() ? assetRoot.parent_path() / "assets.pak" : fs::absolute(options->out);
+
+        // Sorted, so files of one directory (a model and its textures) sit next to each other.
+        std::vector<fs::path> files;
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(assetRoot))
+        {
+            if (entry.is_regular_file() && entry.path().extension() != ".tmp")
+            {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        std::uint64_t rawBytes = 0;
+        corefs::PackWriter writer(out, options->write);
+        for (const fs::path& file : files)
+        {
+            const corefs::MappedFile mapped(file);
+            const std::int64_t writeTime = static_cast<std::int64_t>(fs::last_write_time(file).time_since_epoch().count());
+            if (!writer.Add(file.lexically_relative(assetRoot).generic_string(), mapped.Bytes(), writeTime))
+            {
+                std::cerr << "AssetPacker: skipped duplicate path " << file.string() << "\n";
+                continue;
+            }
+            rawBytes += mapped.Size();
+        }
+        writer.Finish();
+
+        std::cout << "AssetPacker: " << writer.EntryCount() << " files, "
+            << rawBytes << " bytes -> " << fs::file_size(out) << " bytes in " << out.string() << "\n";
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "AssetPacker: " << e.what() << "\n";
+        return 2;
+    }
+}
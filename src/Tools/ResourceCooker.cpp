@@ -0,0 +1,476 @@
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+import core;
+import std;
+
+// Offline asset cooker: walks assets/, converts every mesh, texture and skinned animation source
+// into its cooked artifact under assets/.cooked and records the result in the cooked manifest,
+// which AssetManager consults at load time.
+//
+//   ResourceCooker [--root <dir containing assets/>] [--force] [--jobs N]
+//
+// Sources whose stamps still match the manifest (and whose artifact exists) are skipped unless
+// --force is given. One record is written per source, cooked with the default import settings
+// (textures: sRGB + mips, normal/data maps detected by name), so a runtime load that asks for
+// other settings falls back to the source file.
+
+namespace resourceCooker
+{
+    namespace fs = std::filesystem;
+
+    inline constexpr std::uint32_t kCookedTextureVersion = 1u;
+
+    struct Options
+    {
+        fs::path root{};
+        bool force{ false };
+        std::uint32_t jobs{ 0 };
+    };
+
+    struct Totals
+    {
+        std::atomic<std::uint32_t> cooked{ 0 };
+        std::atomic<std::uint32_t> upToDate{ 0 };
+        std::atomic<std::uint32_t> failed{ 0 };
+    };
+
+    enum class SourceType : std::uint8_t
+    {
+        None,
+        Mesh,
+        Texture
+    };
+
+    std::string ToLower(std::string s)
+    {
+        for (char& c : s)
+        {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return s;
+    }
+
+    SourceType ClassifySource(const fs::path& path)
+    {
+        const std::string ext = ToLower(path.extension().string());
+        if (ext == ".obj" || ext == ".fbx" || ext == ".gltf" || ext == ".glb" || ext == ".dae" || ext == ".3ds")
+        {
+            return SourceType::Mesh;
+        }
+        if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp")
+        {
+            return SourceType::Texture;
+        }
+        return SourceType::None;
+    }
+
+    // Material JSON does not say how a texture will be sampled, so guess from the file name the
+    // way artists name them. A wrong guess only costs a cache miss at runtime.
+    TextureProperties GuessTextureProperties(const fs::path& path)
+    {
+        const std::string stem = ToLower(path.stem().string());
+        const auto Has = [&stem](std::string_view token) { return stem.find(token) != std::string::npos; };
+
+        TextureProperties props{};
+        props.dimension = TextureDimension::Tex2D;
+        props.generateMips = true;
+        props.isNormalMap = Has("normal") || Has("_nrm") || stem.ends_with("_n");
+        const bool isData = Has("rough") || Has("metal") || Has("_orm") || Has("_ao") || Has("height") || Has("mask");
+        props.srgb = !props.isNormalMap && !isData;
+        return props;
+    }
+
+    std::uint64_t HashFile(const fs::path& abs, std::uint64_t seed)
+    {
+        const corefs::MappedFile file(abs);
+        return rendern::HashCookBytes(file.Bytes(), seed);
+    }
+
+    std::uint64_t MixKey(std::uint64_t key, std::uint64_t value)
+    {
+        return rendern::HashCookBytes(std::as_bytes(std::span(&value, 1)), key);
+    }
+
+    // ---------------------------------------------------------------------------------------
+    // DDS output (legacy header: DXT1 / DXT5 FourCC, or 32-bit RGBA masks)
+    // ---------------------------------------------------------------------------------------
+
+    constexpr std::uint32_t FourCC(char a, char b, char c, char d) noexcept
+    {
+        return static_cast<std::uint32_t>(static_cast<unsigned char>(a))
+            | (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8)
+            | (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16)
+            | (static_cast<std::uint32_t>(static_cast<unsigned char>(d)) << 24);
+    }
+
+    std::vector<unsigned char> EncodeBlocks(const TextureMipLevel& level, TextureFormat format)
+    {
+        const std::uint32_t blocksX = (level.width + 3u) / 4u;
+        const std::uint32_t blocksY = (level.height + 3u) / 4u;
+        const std::size_t blockBytes = (format == TextureFormat::BC1) ? 8u : 16u;
+        const int alphaMode = (format == TextureFormat::BC3) ? 1 : 0;
+
+        std::vector<unsigned char> out(static_cast<std::size_t>(blocksX) * blocksY * blockBytes);
+        std::array<unsigned char, 64> block{};
+        for (std::uint32_t by = 0; by < blocksY; ++by)
+        {
+            for (std::uint32_t bx = 0; bx < blocksX; ++bx)
+            {
+                // Mips below 4x4 replicate their edge texels into the padding.
+                for (std::uint32_t y = 0; y < 4u; ++y)
+                {
+                    const std::uint32_t sy = std::min(by * 4u + y, level.height - 1u);
+                    for (std::uint32_t x = 0; x < 4u; ++x)
+                    {
+                        const std::uint32_t sx = std::min(bx * 4u + x, level.width - 1u);
+                        const unsigned char* src = level.pixels.data() + (static_cast<std::size_t>(sy) * level.width + sx) * 4u;
+                        std::memcpy(block.data() + (y * 4u + x) * 4u, src, 4u);
+                    }
+                }
+                unsigned char* dst = out.data() + (static_cast<std::size_t>(by) * blocksX + bx) * blockBytes;
+                stb_compress_dxt_block(dst, block.data(), alphaMode, STB_DXT_HIGHQUAL);
+            }
+        }
+        return out;
+    }
+
+    void WriteDds(const fs::path& path, const TextureCPUData& cpu, TextureFormat format)
+    {
+        std::array<std::uint32_t, 31> header{};
+        header[0] = 124u;                                   // dwSize
+        header[1] = 0x1u | 0x2u | 0x4u | 0x1000u | 0x20000u; // CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT
+        header[2] = cpu.height;
+        header[3] = cpu.width;
+        header[4] = static_cast<std::uint32_t>(TextureMipBytes(format, cpu.width, cpu.height));
+        header[6] = static_cast<std::uint32_t>(cpu.mips.size());
+        header[18] = 32u;                                   // ddspf.dwSize
+        if (IsBlockCompressed(format))
+        {
+            header[1] |= 0x80000u;                          // LINEARSIZE
+            header[19] = 0x4u;                              // DDPF_FOURCC
+            header[20] = (format == TextureFormat::BC1) ? FourCC('D', 'X', 'T', '1') : FourCC('D', 'X', 'T', '5');
+        }
+        else
+        {
+            header[1] |= 0x8u;                              // PITCH
+            header[4] = static_cast<std::uint32_t>(TextureRowPitchBytes(format, cpu.width));
+            header[19] = 0x40u | 0x1u;                      // DDPF_RGB | DDPF_ALPHAPIXELS
+            header[21] = 32u;
+            header[22] = 0x000000FFu;
+            header[23] = 0x0000FF00u;
+            header[24] = 0x00FF0000u;
+            header[25] = 0xFF000000u;
+        }
+        header[26] = 0x1000u | 0x8u | 0x400000u;            // TEXTURE | COMPLEX | MIPMAP
+
+        fs::create_directories(path.parent_path());
+        fs::path tmpPath = path;
+        tmpPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+            const std::uint32_t magic = FourCC('D', 'D', 'S', ' ');
+            out.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+            out.write(reinterpret_cast<const char*>(header.data()), sizeof(header));
+            for (const TextureMipLevel& level : cpu.mips)
+            {
+                if (IsBlockCompressed(format))
+                {
+                    const std::vector<unsigned char> blocks = EncodeBlocks(level, format);
+                    out.write(reinterpret_cast<const char*>(blocks.data()), static_cast<std::streamsize>(blocks.size()));
+                }
+                else
+                {
+                    out.write(reinterpret_cast<const char*>(level.pixels.data()), static_cast<std::streamsize>(level.pixels.size()));
+                }
+            }
+            if (!out)
+            {
+                throw std::runtime_error("Failed to write cooked texture: " + tmpPath.string());
+            }
+        }
+        fs::rename(tmpPath, path);
+    }
+
+    // ---------------------------------------------------------------------------------------
+    // Per-source cooking
+    // ---------------------------------------------------------------------------------------
+
+    class Cooker
+    {
+    public:
+        explicit Cooker(const Options& options)
+            : options_(options)
+            , manifest_(CookedAssetManifest::Load(CookedAssetManifest::DefaultPath()))
+        {
+        }
+
+        void CookSource(const fs::path& abs, SourceType type)
+        {
+            const std::string rel = NormalizeCookedAssetPath(abs);
+            try
+            {
+                if (type == SourceType::Mesh)
+                {
+                    CookMeshSource_(abs, rel);
+                }
+                else
+                {
+                    CookTextureSource_(abs, rel);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                totals_.failed.fetch_add(1, std::memory_order_relaxed);
+                Log_("FAILED " + rel + ": " + e.what());
+            }
+        }
+
+        bool SaveManifest()
+        {
+            std::scoped_lock lock(mutex_);
+            return manifest_.Save(CookedAssetManifest::DefaultPath());
+        }
+
+        const Totals& GetTotals() const noexcept { return totals_; }
+
+    private:
+        // True (and counted) when the manifest already holds a current artifact for this input.
+        bool IsUpToDate_(CookedAssetKind kind, const std::string& rel, std::uint64_t settingsKey)
+        {
+            if (options_.force)
+            {
+                return false;
+            }
+
+            std::scoped_lock lock(mutex_);
+            const CookedAssetRecord* record = manifest_.Find(kind, rel, settingsKey);
+            if (record == nullptr)
+            {
+                return false;
+            }
+            const std::optional<CookedFileStamp> now = StampCookedInput(rel);
+            if (!now || now->bytes != record->source.bytes || now->writeTime != record->source.writeTime ||
+                !CookedAssetManifest::IsCurrent(*record) ||
+                !fs::is_regular_file(corefs::CookedCacheRoot() / record->artifact))
+            {
+                return false;
+            }
+            totals_.upToDate.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        void Record_(CookedAssetKind kind, const std::string& rel, std::uint64_t settingsKey, std::uint64_t cookKey, const fs::path& artifact)
+        {
+            std::optional<CookedFileStamp> source = StampCookedInput(rel);
+            if (!source)
+            {
+                throw std::runtime_error("source vanished while cooking");
+            }
+
+            CookedAssetRecord record{};
+            record.kind = kind;
+            record.settingsKey = settingsKey;
+            record.cookKey = cookKey;
+            record.artifact = artifact.lexically_relative(corefs::CookedCacheRoot()).generic_string();
+            record.source = std::move(*source);
+
+            {
+                std::scoped_lock lock(mutex_);
+                manifest_.Upsert(std::move(record));
+            }
+            totals_.cooked.fetch_add(1, std::memory_order_relaxed);
+            Log_("cooked " + rel + " -> " + artifact.filename().string());
+        }
+
+        void CookMeshSource_(const fs::path& abs, const std::string& rel)
+        {
+            const rendern::MeshProperties props{};
+            const std::uint64_t settingsKey = rendern::MeshCookSettingsKey(props);
+            if (!IsUpToDate_(CookedAssetKind::Mesh, rel, settingsKey))
+            {
+                const rendern::CookedMeshArtifact artifact = rendern::CookMesh(abs, props);
+                Record_(CookedAssetKind::Mesh, rel, settingsKey, artifact.cookKey, artifact.path);
+            }
+
+            // Skinned sources also carry their clips. Static meshes (no bones) throw here.
+            if (ToLower(abs.extension().string()) == ".obj" || IsUpToDate_(CookedAssetKind::AnimationClips, rel, 0))
+            {
+                return;
+            }
+
+            std::vector<rendern::AnimationClip> clips;
+            try
+            {
+                clips = rendern::LoadAssimpSkinnedAsset(abs, props.flipUVs).clips;
+            }
+            catch (const std::exception&)
+            {
+                return;
+            }
+            if (clips.empty())
+            {
+                return;
+            }
+
+            const std::uint64_t cookKey = MixKey(HashFile(abs, rendern::kCookKeySeed), rendern::kCookedClipsVersion);
+            const fs::path path = rendern::CookedClipsPath(cookKey);
+            rendern::WriteCookedClips(path, cookKey, clips);
+            Record_(CookedAssetKind::AnimationClips, rel, 0, cookKey, path);
+        }
+
+        void CookTextureSource_(const fs::path& abs, const std::string& rel)
+        {
+            const TextureProperties props = GuessTextureProperties(abs);
+            const std::uint64_t settingsKey = TextureCookSettingsKey(props);
+            if (IsUpToDate_(CookedAssetKind::Texture, rel, settingsKey))
+            {
+                return;
+            }
+
+            const std::uint64_t cookKey = MixKey(MixKey(HashFile(abs, rendern::kCookKeySeed), settingsKey), kCookedTextureVersion);
+            const fs::path path = corefs::CookedCacheRoot() / "textures" / (rendern::CookKeyHex(cookKey) + ".dds");
+
+            if (!fs::is_regular_file(path))
+            {
+                StbTextureDecoder decoder{};
+                std::optional<TextureCPUData> cpu = decoder.Decode(props, abs.string());
+                if (!cpu || cpu->mips.empty())
+                {
+                    throw std::runtime_error("decode produced no pixels");
+                }
+
+                // BC needs a block-aligned top level (see DdsTextureDecoder); odd sizes stay RGBA8
+                // but still skip stb and mip generation at runtime.
+                TextureFormat format = TextureFormat::RGBA;
+                if (cpu->width % 4u == 0u && cpu->height % 4u == 0u)
+                {
+                    const std::vector<unsigned char>& top = cpu->mips.front().pixels;
+                    bool hasAlpha = false;
+                    for (std::size_t i = 3; i < top.size(); i += 4)
+                    {
+                        if (top[i] != 255u)
+                        {
+                            hasAlpha = true;
+                            break;
+                        }
+                    }
+                    format = hasAlpha ? TextureFormat::BC3 : TextureFormat::BC1;
+                }
+                WriteDds(path, *cpu, format);
+            }
+
+            Record_(CookedAssetKind::Texture, rel, settingsKey, cookKey, path);
+        }
+
+        void Log_(const std::string& line)
+        {
+            std::scoped_lock lock(logMutex_);
+            std::cout << line << '\n';
+        }
+
+        const Options& options_;
+        std::mutex mutex_{};
+        std::mutex logMutex_{};
+        CookedAssetManifest manifest_{};
+        Totals totals_{};
+    };
+
+    std::optional<Options> ParseArgs(int argc, char** argv)
+    {
+        Options options{};
+        options.root = fs::current_path();
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            if (arg == "--force")
+            {
+                options.force = true;
+            }
+            else if (arg == "--root" && i + 1 < argc)
+            {
+                options.root = fs::path(argv[++i]);
+            }
+            else if (arg == "--jobs" && i + 1 < argc)
+            {
+                options.jobs = static_cast<std::uint32_t>(std::max(0, std::atoi(argv[++i])));
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    namespace fs = std::filesystem;
+    using namespace resourceCooker;
+
+    const std::optional<Options> options = ParseArgs(argc, argv);
+    if (!options)
+    {
+        std::cerr << "usage: ResourceCooker [--root <dir containing assets/>] [--force] [--jobs N]\n";
+        return 1;
+    }
+
+    try
+    {
+        // corefs::FindAssetRoot searches upwards from the working directory.
+        fs::current_path(options->root);
+        const fs::path assetRoot = fs::absolute(corefs::FindAssetRoot());
+        const fs::path cookedRoot = fs::absolute(corefs::CookedCacheRoot());
+        if (!fs::is_directory(assetRoot))
+        {
+            std::cerr << "ResourceCooker: no assets/ directory under " << options->root.string() << "\n";
+            return 1;
+        }
+
+        std::vector<std::pair<fs::path, SourceType>> sources;
+        for (auto it = fs::recursive_directory_iterator(assetRoot); it != fs::recursive_directory_iterator(); ++it)
+        {
+            if (it->is_directory() && it->path() == cookedRoot)
+            {
+                it.disable_recursion_pending();
+                continue;
+            }
+            if (const SourceType type = ClassifySource(it->path()); it->is_regular_file() && type != SourceType::None)
+            {
+                sources.emplace_back(it->path(), type);
+            }
+        }
+
+        const std::uint32_t workers = options->jobs != 0
+            ? options->jobs
+            : std::max(1u, std::thread::hardware_concurrency());
+
+        Cooker cooker(*options);
+        {
+            jobs::Scheduler scheduler(workers);
+            for (const auto& [path, type] : sources)
+            {
+                scheduler.Schedule([&cooker, path, type]() { cooker.CookSource(path, type); });
+            }
+            scheduler.WaitIdle();
+        }
+
+        if (!cooker.SaveManifest())
+        {
+            std::cerr << "ResourceCooker: failed to write " << CookedAssetManifest::DefaultPath().string() << "\n";
+            return 2;
+        }
+
+        const Totals& totals = cooker.GetTotals();
+        std::cout << "ResourceCooker: " << totals.cooked.load() << " cooked, "
+            << totals.upToDate.load() << " up to date, "
+            << totals.failed.load() << " failed\n";
+        return totals.failed.load() == 0 ? 0 : 2;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ResourceCooker: " << e.what() << "\n";
+        return 2;
+    }
+}
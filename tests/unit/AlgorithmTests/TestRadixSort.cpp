@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+import core;
+
+namespace
+{
+	struct KeyedValue
+	{
+		std::uint64_t key{ 0 };
+		std::uint32_t order{ 0 };
+	};
+
+	std::uint64_t KeyOf(const KeyedValue& value) noexcept
+	{
+		return value.key;
+	}
+}
+
+TEST(RadixSort, MatchesStableSort)
+{
+	std::mt19937_64 rng(1234);
+	std::vector<KeyedValue> values(5000);
+	for (std::uint32_t i = 0; i < values.size(); ++i)
+	{
+		// Few distinct keys spread over all bytes, so both stability and every pass are exercised.
+		values[i] = KeyedValue{ (rng() % 64u) * 0x0101010101010101ull, i };
+	}
+
+	std::vector<KeyedValue> expected = values;
+	std::stable_sort(expected.begin(), expected.end(), [](const KeyedValue& a, const KeyedValue& b) { return a.key < b.key; });
+
+	std::vector<KeyedValue> scratch(values.size());
+	algorithms::RadixSort64(std::span{ values }, std::span{ scratch }, KeyOf);
+
+	for (std::size_t i = 0; i < values.size(); ++i)
+	{
+		EXPECT_EQ(values[i].key, expected[i].key);
+		EXPECT_EQ(values[i].order, expected[i].order);
+	}
+}
+
+TEST(RadixSort, HighByteOnlyKeys)
+{
+	std::vector<KeyedValue> values{ { 3ull << 61, 0 }, { 1ull << 61, 1 }, { 0ull, 2 }, { 1ull << 61, 3 } };
+	std::vector<KeyedValue> scratch(values.size());
+	algorithms::RadixSort64(std::span{ values }, std::span{ scratch }, KeyOf);
+
+	EXPECT_EQ(values[0].order, 2u);
+	EXPECT_EQ(values[1].order, 1u);
+	EXPECT_EQ(values[2].order, 3u);
+	EXPECT_EQ(values[3].order, 0u);
+}
+
+TEST(RadixSort, RejectsShortScratch)
+{
+	std::vector<KeyedValue> values(4);
+	std::vector<KeyedValue> scratch(3);
+	EXPECT_THROW(algorithms::RadixSort64(std::span{ values }, std::span{ scratch }, KeyOf), std::invalid_argument);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+import core;
+
+using namespace rendern;
+
+namespace
+{
+	// Idle -> Action when "hasActionRequest", Action -> Idle when "speed" drops below 0.5.
+	GameplayGraphAsset MakeTwoStateGraph()
+	{
+		GameplayGraphStateDesc idle{ .name = "Idle" };
+		idle.transitions.push_back(GameplayGraphTransitionDesc{
+			.toState = "Action",
+			.conditions = { GameplayGraphConditionDesc{ .name = "Bool True", .parameter = "hasActionRequest" } } });
+
+		GameplayGraphStateDesc action{ .name = "Action" };
+		action.onEnter.push_back(GameplayGraphTaskDesc{ .name = "BeginActionState" });
+		action.onUpdate.push_back(GameplayGraphTaskDesc{ .name = "UnknownTask" });
+		action.transitions.push_back(GameplayGraphTransitionDesc{
+			.toState = "Idle",
+			.conditions = { GameplayGraphConditionDesc{ .name = "FloatLess", .parameter = "speed", .threshold = 0.5f } } });
+
+		GameplayGraphLayerDesc layer{ .name = "Base", .defaultState = "Idle" };
+		layer.states = { idle, action };
+
+		GameplayGraphAsset asset{};
+		asset.layers.push_back(layer);
+		return asset;
+	}
+}
+
+TEST(GameplayGraphProgram, CompileAssignsSlotsAndIndices)
+{
+	constexpr std::array<std::string_view, 2> declared{ "speed", "currentAction" };
+	const GameplayGraphProgram program = CompileGameplayGraph(MakeTwoStateGraph(), declared);
+
+	ASSERT_EQ(program.parameterNames.size(), 3u);
+	EXPECT_EQ(program.FindParameter("hasActionRequest"), 0);
+	EXPECT_EQ(program.FindParameter("speed"), 1);
+	EXPECT_EQ(program.FindParameter("currentAction"), 2);
+	EXPECT_EQ(program.FindParameter("missing"), -1);
+
+	ASSERT_EQ(program.layers.size(), 1u);
+	EXPECT_EQ(program.layers[0].defaultState, 0);
+	ASSERT_EQ(program.states.size(), 2u);
+	ASSERT_EQ(program.transitions.size(), 2u);
+	EXPECT_EQ(program.transitions[0].toState, 1);
+	EXPECT_EQ(program.transitions[1].toState, 0);
+	ASSERT_EQ(program.conditions.size(), 2u);
+	EXPECT_EQ(program.conditions[0].op, GameplayGraphConditionOp::BoolTrue);
+	EXPECT_EQ(program.conditions[1].op, GameplayGraphConditionOp::FloatLess);
+
+	// The unknown task is dropped.
+	ASSERT_EQ(program.tasks.size(), 1u);
+	EXPECT_EQ(program.states[1].onEnter.count, 1u);
+	EXPECT_EQ(program.states[1].onUpdate.count, 0u);
+}
+
+TEST(GameplayGraphProgram, TickFollowsTransitionsAndRunsTasks)
+{
+	const GameplayGraphProgram program = CompileGameplayGraph(MakeTwoStateGraph());
+	std::vector<GameplayGraphSlot> slots(program.parameterNames.size());
+	GameplayGraphLayerRuntimeState layer{ .activeStateIndex = program.layers[0].defaultState };
+	int beginCount = 0;
+	auto RunTask = [&](GameplayGraphTaskOp task) { beginCount += (task == GameplayGraphTaskOp::BeginActionState) ? 1 : 0; };
+
+	TickGameplayGraphLayer(program, 0, layer, slots, 0.25f, RunTask);
+	EXPECT_EQ(layer.activeStateIndex, 0);
+	EXPECT_FLOAT_EQ(layer.stateTime, 0.25f);
+
+	SetGameplayGraphSlotBool(slots, program.FindParameter("hasActionRequest"), true);
+	SetGameplayGraphSlotFloat(slots, program.FindParameter("speed"), 2.0f);
+	TickGameplayGraphLayer(program, 0, layer, slots, 0.25f, RunTask);
+	EXPECT_EQ(layer.activeStateIndex, 1);
+	EXPECT_EQ(layer.previousStateIndex, 0);
+	EXPECT_FLOAT_EQ(layer.stateTime, 0.0f);
+	EXPECT_EQ(beginCount, 1);
+
+	TickGameplayGraphLayer(program, 0, layer, slots, 0.25f, RunTask);
+	EXPECT_EQ(layer.activeStateIndex, 1);
+	EXPECT_EQ(beginCount, 1);
+
+	// An int slot reads as float for the FloatLess condition.
+	SetGameplayGraphSlotInt(slots, program.FindParameter("speed"), 0);
+	TickGameplayGraphLayer(program, 0, layer, slots, 0.25f, RunTask);
+	EXPECT_EQ(layer.activeStateIndex, 0);
+}
+
+TEST(GameplayGraphProgram, UnknownConditionAndTargetState)
+{
+	GameplayGraphAsset asset = MakeTwoStateGraph();
+	asset.layers[0].states[0].transitions[0].conditions[0].name = "NotACondition";
+	asset.layers[0].states[0].transitions.push_back(GameplayGraphTransitionDesc{
+		.toState = "Missing",
+		.conditions = { GameplayGraphConditionDesc{ .name = "BoolFalse", .parameter = "hasActionRequest" } } });
+
+	const GameplayGraphProgram program = CompileGameplayGraph(asset);
+	EXPECT_EQ(program.FindParameter("hasActionRequest"), 0);
+	std::vector<GameplayGraphSlot> slots(program.parameterNames.size());
+	SetGameplayGraphSlotBool(slots, 0, true);
+	GameplayGraphLayerRuntimeState layer{ .activeStateIndex = 0 };
+	auto RunTask = [](GameplayGraphTaskOp) {};
+
+	// The unknown condition never passes.
+	TickGameplayGraphLayer(program, 0, layer, slots, 0.1f, RunTask);
+	EXPECT_EQ(layer.activeStateIndex, 0);
+
+	// A transition to a missing state leaves the layer without a state; the next tick restarts at the default.
+	SetGameplayGraphSlotBool(slots, 0, false);
+	TickGameplayGraphLayer(program, 0, layer, slots, 0.1f, RunTask);
+	EXPECT_EQ(layer.activeStateIndex, -1);
+	EXPECT_TRUE(layer.enterPending);
+	SetGameplayGraphSlotBool(slots, 0, true);
+	TickGameplayGraphLayer(program, 0, layer, slots, 0.1f, RunTask);
+	EXPECT_EQ(layer.activeStateIndex, 0);
+}
+
+TEST(GameplayGraphProgram, FrameStateClearsTriggerSlots)
+{
+	GameplayGraphInstance instance{};
+	instance.slots.resize(2);
+	SetGameplayGraphSlotTrigger(instance.slots, 0);
+	SetGameplayGraphSlotBool(instance.slots, 1, true);
+	SetGameplayGraphSlotBool(instance.slots, 5, true); // out of range: ignored
+
+	ClearGameplayGraphFrameState(instance);
+	EXPECT_FALSE(GetGameplayGraphSlotBool(instance.slots[0]));
+	EXPECT_TRUE(GetGameplayGraphSlotBool(instance.slots[1]));
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+import core;
+
+using namespace rendern;
+
+namespace
+{
+	GameplaySystemDesc MakeSystem(GameplayAccess reads, GameplayAccess writes, std::vector<int>* log = nullptr, int id = 0, std::mutex* logMutex = nullptr)
+	{
+		GameplaySystemDesc desc{};
+		desc.reads = reads;
+		desc.writes = writes;
+		desc.run = [log, id, logMutex](const GameplaySystemContext&)
+			{
+				if (log != nullptr)
+				{
+					std::scoped_lock lock(*logMutex);
+					log->push_back(id);
+				}
+			};
+		return desc;
+	}
+}
+
+TEST(GameplaySystemScheduler, GroupsSystemsWithoutConflictsIntoWaves)
+{
+	GameplaySystemScheduler systems;
+	systems.AddSystem(MakeSystem(GameplayAccess::InputIntent, GameplayAccess::CharacterCommand));                  // 0
+	systems.AddSystem(MakeSystem(GameplayAccess::CharacterCommand, GameplayAccess::Action));                       // 1: reads 0
+	systems.AddSystem(MakeSystem(GameplayAccess::FollowCamera, GameplayAccess::SceneCamera));                      // 2: independent
+	systems.AddSystem(MakeSystem(GameplayAccess::CharacterCommand, GameplayAccess::Action));                       // 3: writes like 1
+	systems.AddSystem(MakeSystem(GameplayAccess::CharacterCommand | GameplayAccess::Transform, GameplayAccess::None)); // 4: reads only
+
+	const std::vector<std::vector<std::uint32_t>> expected{ { 0, 2 }, { 1, 4 }, { 3 } };
+	EXPECT_EQ(systems.GetWaves(), expected);
+}
+
+TEST(GameplaySystemScheduler, ConflictingSystemsKeepRegistrationOrder)
+{
+	jobs::Scheduler scheduler(4);
+	GameplayWorld world;
+	GameplayUpdateContext ctx{};
+	ctx.scheduler = &scheduler;
+
+	std::mutex logMutex;
+	std::vector<int> log;
+	GameplaySystemScheduler systems;
+	systems.AddSystem(MakeSystem(GameplayAccess::None, GameplayAccess::Transform, &log, 0, &logMutex));
+	systems.AddSystem(MakeSystem(GameplayAccess::Transform, GameplayAccess::Locomotion, &log, 1, &logMutex));
+	systems.AddSystem(MakeSystem(GameplayAccess::Locomotion, GameplayAccess::LevelRuntime, &log, 2, &logMutex));
+	systems.AddSystem(MakeSystem(GameplayAccess::All, GameplayAccess::All, &log, 3, &logMutex));
+
+	for (int frame = 0; frame < 50; ++frame)
+	{
+		log.clear();
+		systems.Run(world, {}, ctx);
+		EXPECT_EQ(log, (std::vector<int>{ 0, 1, 2, 3 }));
+	}
+}
+
+TEST(GameplaySystemScheduler, EntitySystemsSeeEveryEntityOnceAndEarlierWrites)
+{
+	jobs::Scheduler scheduler(4);
+	GameplayWorld world;
+	std::vector<EntityHandle> entities;
+	for (int i = 0; i < 1000; ++i)
+	{
+		const EntityHandle entity = world.CreateEntity();
+		world.AddTransform(entity, {});
+		world.AddLocomotion(entity, {});
+		entities.push_back(entity);
+	}
+
+	GameplayUpdateContext ctx{};
+	ctx.scheduler = &scheduler;
+
+	GameplaySystemScheduler systems;
+	GameplaySystemDesc move{};
+	move.reads = GameplayAccess::None;
+	move.writes = GameplayAccess::Transform;
+	move.entityGrain = 16;
+	move.run = [](const GameplaySystemContext& sys)
+		{
+			sys.ForEachEntity([&](const EntityHandle entity) { sys.world.TryGetTransform(entity)->position.x += 1.0f; });
+		};
+	systems.AddSystem(move);
+
+	GameplaySystemDesc copy{};
+	copy.reads = GameplayAccess::Transform;
+	copy.writes = GameplayAccess::Locomotion;
+	copy.entityGrain = 16;
+	copy.run = [](const GameplaySystemContext& sys)
+		{
+			sys.ForEachEntity([&](const EntityHandle entity)
+				{
+					sys.world.TryGetLocomotion(entity)->planarSpeed = sys.world.TryGetTransform(entity)->position.x;
+				});
+		};
+	systems.AddSystem(copy);
+
+	constexpr int kFrames = 20;
+	for (int frame = 0; frame < kFrames; ++frame)
+	{
+		systems.Run(world, entities, ctx);
+	}
+
+	for (const EntityHandle entity : entities)
+	{
+		EXPECT_EQ(world.TryGetTransform(entity)->position.x, static_cast<float>(kFrames));
+		EXPECT_EQ(world.TryGetLocomotion(entity)->planarSpeed, static_cast<float>(kFrames));
+	}
+}
+
+TEST(GameplaySystemScheduler, RunsInlineWithoutAScheduler)
+{
+	GameplayWorld world;
+	std::vector<EntityHandle> entities{ world.CreateEntity(), world.CreateEntity(), world.CreateEntity() };
+
+	std::atomic<int> visits{ 0 };
+	GameplaySystemScheduler systems;
+	GameplaySystemDesc count{};
+	count.entityGrain = 1;
+	count.run = [&visits](const GameplaySystemContext& sys)
+		{
+			sys.ForEachEntity([&](EntityHandle) { visits.fetch_add(1); });
+		};
+	systems.AddSystem(count);
+
+	systems.Run(world, entities, GameplayUpdateContext{});
+	EXPECT_EQ(visits.load(), 3);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+import core;
+
+using namespace rendern;
+
+TEST(GameplayWorld, AddAndSetTransformAreTracked)
+{
+	GameplayWorld world;
+	const EntityHandle a = world.CreateEntity();
+	const EntityHandle b = world.CreateEntity();
+	world.AddTransform(a, {});
+	world.AddTransform(b, {});
+
+	std::vector<EntityHandle> changed;
+	world.ConsumeChangedTransforms(changed);
+	EXPECT_EQ(changed, (std::vector<EntityHandle>{ a, b }));
+
+	changed.clear();
+	world.ConsumeChangedTransforms(changed);
+	EXPECT_TRUE(changed.empty());
+
+	world.SetTransform(b, GameplayTransformComponent{ .position = { 1.0f, 0.0f, 0.0f } });
+	world.ConsumeChangedTransforms(changed);
+	EXPECT_EQ(changed, (std::vector<EntityHandle>{ b }));
+}
+
+TEST(GameplayWorld, MarkTransformChangedFromManyThreadsKeepsEachEntityOnce)
+{
+	GameplayWorld world;
+	std::vector<EntityHandle> entities;
+	for (int i = 0; i < 512; ++i)
+	{
+		entities.push_back(world.CreateEntity());
+		world.AddTransform(entities.back(), {});
+	}
+	std::vector<EntityHandle> changed;
+	world.ConsumeChangedTransforms(changed);
+	changed.clear();
+
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < 4; ++t)
+		{
+			threads.emplace_back([&world, &entities]
+				{
+					for (const EntityHandle entity : entities)
+					{
+						world.MarkTransformChanged(entity);
+					}
+				});
+		}
+	}
+
+	world.ConsumeChangedTransforms(changed);
+	std::sort(changed.begin(), changed.end());
+	std::vector<EntityHandle> expected = entities;
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(changed, expected);
+}
+
+TEST(GameplayWorld, RemovedTransformsAreNotReported)
+{
+	GameplayWorld world;
+	const EntityHandle kept = world.CreateEntity();
+	const EntityHandle removed = world.CreateEntity();
+	const EntityHandle destroyed = world.CreateEntity();
+	const EntityHandle withoutTransform = world.CreateEntity();
+	world.AddTransform(kept, {});
+	world.AddTransform(removed, {});
+	world.AddTransform(destroyed, {});
+
+	world.RemoveTransform(removed);
+	world.DestroyEntity(destroyed);
+	world.MarkTransformChanged(withoutTransform);
+
+	std::vector<EntityHandle> changed;
+	world.ConsumeChangedTransforms(changed);
+	EXPECT_EQ(changed, (std::vector<EntityHandle>{ kept }));
+}
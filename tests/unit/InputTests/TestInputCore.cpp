@@ -77,3 +77,35 @@ TEST(InputCore, CaptureAndShiftAreStored)
     EXPECT_TRUE(s.capture.captureKeyboard);
     EXPECT_FALSE(s.capture.captureMouse);
 }
+
+TEST(InputCore, AccumulatedFramesKeepEdgesUntilCleared)
+{
+    InputCore core;
+
+    std::array<std::uint8_t, 256> keys{};
+    MouseInput mouse{};
+    mouse.lookDx = 3;
+
+    InputState pending{};
+
+    // Frame 1: space pressed; frame 2: held, W pressed. Nothing consumed in between.
+    keys[0x20] = 1;
+    core.NewFrame({}, true, keys, mouse, false, 0);
+    AccumulateInputFrame(pending, core.State());
+
+    keys[static_cast<std::uint8_t>('W')] = 1;
+    mouse.lookDx = 4;
+    core.NewFrame({}, true, keys, mouse, false, 0);
+    AccumulateInputFrame(pending, core.State());
+
+    EXPECT_TRUE(pending.KeyPressed(0x20));
+    EXPECT_TRUE(pending.KeyPressed('W'));
+    EXPECT_TRUE(pending.KeyDown(0x20));
+    EXPECT_EQ(pending.mouse.lookDx, 7);
+
+    ClearInputEdges(pending);
+    EXPECT_FALSE(pending.KeyPressed(0x20));
+    EXPECT_FALSE(pending.KeyPressed('W'));
+    EXPECT_TRUE(pending.KeyDown('W'));
+    EXPECT_EQ(pending.mouse.lookDx, 0);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+import core;
+
+using namespace rendern;
+
+namespace
+{
+    const InputClock::time_point kT0{ std::chrono::seconds(100) };
+
+    InputEvent Key(InputEventKind kind, char key, int ms)
+    {
+        return InputEvent{ .time = kT0 + std::chrono::milliseconds(ms), .kind = kind, .key = static_cast<std::uint8_t>(key) };
+    }
+}
+
+TEST(InputEventRing, DrainsInOrderAndDropsWhenFull)
+{
+    InputEventRing ring;
+    std::vector<InputEvent> out;
+
+    for (std::size_t i = 0; i < InputEventRing::kCapacity; ++i)
+    {
+        ASSERT_TRUE(ring.Push(InputEvent{ .kind = InputEventKind::MouseMove, .dx = static_cast<std::int32_t>(i) }));
+    }
+    EXPECT_FALSE(ring.Push(InputEvent{}));
+    EXPECT_EQ(ring.DroppedCount(), 1u);
+
+    EXPECT_EQ(ring.Drain(out), InputEventRing::kCapacity);
+    ASSERT_EQ(out.size(), InputEventRing::kCapacity);
+    EXPECT_EQ(out.front().dx, 0);
+    EXPECT_EQ(out.back().dx, static_cast<std::int32_t>(InputEventRing::kCapacity - 1));
+
+    // Room again after the drain; indices keep running past the capacity.
+    out.clear();
+    EXPECT_TRUE(ring.Push(InputEvent{ .kind = InputEventKind::MouseWheel, .dx = 120 }));
+    EXPECT_EQ(ring.Drain(out), 1u);
+    EXPECT_EQ(out.front().kind, InputEventKind::MouseWheel);
+    EXPECT_EQ(ring.Drain(out), 0u);
+}
+
+TEST(InputEventRing, ProducerThreadEventsArriveComplete)
+{
+    InputEventRing ring;
+    constexpr int kEvents = 100000;
+
+    std::thread producer([&ring]
+        {
+            for (int i = 0; i < kEvents;)
+            {
+                if (ring.Push(InputEvent{ .kind = InputEventKind::MouseMove, .dx = i }))
+                {
+                    ++i;
+                }
+            }
+        });
+
+    std::vector<InputEvent> out;
+    out.reserve(kEvents);
+    while (out.size() < static_cast<std::size_t>(kEvents))
+    {
+        ring.Drain(out);
+    }
+    producer.join();
+
+    for (int i = 0; i < kEvents; ++i)
+    {
+        ASSERT_EQ(out[static_cast<std::size_t>(i)].dx, i);
+    }
+}
+
+TEST(InputCore, EventsWithinOneFrameKeepBothEdgesAndTiming)
+{
+    InputCore core;
+
+    // 100 ms frame: W tapped from 20 to 30 ms, D pressed at 75 ms and still held.
+    const std::vector<InputEvent> events{
+        Key(InputEventKind::KeyDown, 'W', 20),
+        Key(InputEventKind::KeyDown, 'W', 25), // auto-repeat
+        Key(InputEventKind::KeyUp, 'W', 30),
+        Key(InputEventKind::KeyDown, 'D', 75) };
+    core.NewFrameFromEvents({}, true, events, false, kT0, kT0 + std::chrono::milliseconds(100));
+
+    const InputState& s = core.State();
+    EXPECT_TRUE(s.KeyPressed('W'));
+    EXPECT_TRUE(s.KeyReleased('W'));
+    EXPECT_FALSE(s.KeyDown('W'));
+    EXPECT_NEAR(s.KeyDownFraction('W'), 0.10f, 1e-4f);
+
+    EXPECT_TRUE(s.KeyPressed('D'));
+    EXPECT_TRUE(s.KeyDown('D'));
+    EXPECT_NEAR(s.KeyDownFraction('D'), 0.25f, 1e-4f);
+    EXPECT_NEAR(s.sampleSeconds, 0.1f, 1e-6f);
+
+    // Next frame: D held throughout, released at the very end.
+    core.NewFrameFromEvents({}, true, std::vector<InputEvent>{ Key(InputEventKind::KeyUp, 'D', 200) }, false,
+        kT0 + std::chrono::milliseconds(100), kT0 + std::chrono::milliseconds(200));
+    EXPECT_FALSE(core.State().KeyPressed('D'));
+    EXPECT_TRUE(core.State().KeyReleased('D'));
+    EXPECT_NEAR(core.State().KeyDownFraction('D'), 1.0f, 1e-4f);
+}
+
+TEST(InputCore, EventMouseAndWheel)
+{
+    InputCore core;
+
+    const std::vector<InputEvent> events{
+        InputEvent{ .time = kT0, .kind = InputEventKind::MouseMove, .dx = 3, .dy = -1 },
+        InputEvent{ .time = kT0, .kind = InputEventKind::MouseMove, .dx = 2, .dy = 4 },
+        InputEvent{ .time = kT0, .kind = InputEventKind::MouseWheel, .dx = 180 },
+        InputEvent{ .time = kT0, .kind = InputEventKind::KeyDown, .key = 0x02 },
+        InputEvent{ .time = kT0, .kind = InputEventKind::KeyDown, .key = 0x10 } };
+
+    core.NewFrameFromEvents({}, true, events, true, kT0, kT0 + std::chrono::milliseconds(10));
+    EXPECT_EQ(core.State().mouse.lookDx, 5);
+    EXPECT_EQ(core.State().mouse.lookDy, 3);
+    EXPECT_EQ(core.State().mouse.wheelSteps, 1);
+    EXPECT_TRUE(core.State().mouse.rmbDown);
+    EXPECT_TRUE(core.State().shiftDown);
+
+    // Motion outside look mode is not a look delta; the wheel remainder carries over.
+    core.NewFrameFromEvents({}, true, events, false, kT0, kT0 + std::chrono::milliseconds(10));
+    EXPECT_EQ(core.State().mouse.lookDx, 0);
+    EXPECT_EQ(core.State().mouse.wheelSteps, 2);
+}
+
+TEST(InputCore, AccumulatedFractionsAverageOverFrameLength)
+{
+    InputCore core;
+    InputState pending{};
+
+    // 30 ms frame with W held throughout, then a 10 ms frame with W released at its start.
+    core.NewFrameFromEvents({}, true, std::vector<InputEvent>{ Key(InputEventKind::KeyDown, 'W', 0) }, false,
+        kT0, kT0 + std::chrono::milliseconds(30));
+    AccumulateInputFrame(pending, core.State());
+    core.NewFrameFromEvents({}, true, std::vector<InputEvent>{ Key(InputEventKind::KeyUp, 'W', 30) }, false,
+        kT0 + std::chrono::milliseconds(30), kT0 + std::chrono::milliseconds(40));
+    AccumulateInputFrame(pending, core.State());
+
+    EXPECT_NEAR(pending.KeyDownFraction('W'), 0.75f, 1e-4f);
+    EXPECT_TRUE(pending.KeyPressed('W'));
+    EXPECT_TRUE(pending.KeyReleased('W'));
+
+    ClearInputEdges(pending);
+    core.NewFrameFromEvents({}, true, std::vector<InputEvent>{}, false,
+        kT0 + std::chrono::milliseconds(40), kT0 + std::chrono::milliseconds(50));
+    AccumulateInputFrame(pending, core.State());
+    EXPECT_NEAR(pending.KeyDownFraction('W'), 0.0f, 1e-4f);
+}
+
+TEST(InputCore, PolledFramesReportLevelsAsFractions)
+{
+    InputCore core;
+    std::array<std::uint8_t, 256> keys{};
+    keys[static_cast<std::uint8_t>('W')] = 1;
+    core.NewFrame({}, true, keys, MouseInput{}, false, 0);
+
+    EXPECT_FLOAT_EQ(core.State().KeyDownFraction('W'), 1.0f);
+    EXPECT_FLOAT_EQ(core.State().KeyDownFraction('S'), 0.0f);
+
+    // Hand-filled states (tests, replays) count as polled.
+    InputState manual{};
+    manual.keyDown[static_cast<std::uint8_t>('S')] = 1;
+    EXPECT_FLOAT_EQ(manual.KeyDownFraction('S'), 1.0f);
+}
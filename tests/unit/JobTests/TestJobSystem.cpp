@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+import core;
+
+TEST(JobSystem, AllEnqueuedJobsRun)
+{
+	jobs::Scheduler scheduler(4);
+	std::atomic<int> counter{ 0 };
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		scheduler.Schedule([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+	}
+	scheduler.WaitIdle();
+
+	EXPECT_EQ(counter.load(), 10000);
+}
+
+TEST(JobSystem, ExternalWaitIdleWakesWhenTinyJobsFinish)
+{
+	jobs::Scheduler scheduler(4);
+	std::atomic<int> counter{ 0 };
+	std::atomic<bool> stop{ false };
+
+	// A second non-worker thread keeps entering WaitIdle while jobs retire, so some calls land between a
+	// finishing job's waiter check and its live-count decrement. A missed wakeup hangs the test.
+	std::thread waiter([&scheduler, &stop]
+		{
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				scheduler.WaitIdle();
+			}
+		});
+
+	constexpr int kRounds = 20000;
+	for (int i = 0; i < kRounds; ++i)
+	{
+		scheduler.Schedule([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+		scheduler.WaitIdle();
+	}
+	stop.store(true, std::memory_order_relaxed);
+	waiter.join();
+
+	EXPECT_EQ(counter.load(), kRounds);
+}
+
+TEST(JobSystem, ParentWaitsForChildren)
+{
+	jobs::Scheduler scheduler(4);
+	std::atomic<int> leaves{ 0 };
+
+	const jobs::JobHandle root = scheduler.CreateJob([] {});
+	for (int i = 0; i < 16; ++i)
+	{
+		scheduler.Schedule([&scheduler, &leaves]
+			{
+				// Nested fan-out from inside a job.
+				const jobs::JobHandle group = scheduler.CreateJob([] {});
+				for (int k = 0; k < 8; ++k)
+				{
+					scheduler.Schedule([&leaves] { leaves.fetch_add(1, std::memory_order_relaxed); }, group);
+				}
+				scheduler.Run(group);
+				scheduler.Wait(group);
+			}, root);
+	}
+
+	EXPECT_FALSE(scheduler.IsDone(root));
+	scheduler.Run(root);
+	scheduler.Wait(root);
+
+	EXPECT_TRUE(scheduler.IsDone(root));
+	EXPECT_EQ(leaves.load(), 16 * 8);
+}
+
+TEST(JobSystem, JobFunctionStoresSmallCallablesInline)
+{
+	struct Small { int* value; void operator()() { ++*value; } };
+	struct Large { char payload[256]; int* value; void operator()() { ++*value; } };
+
+	static_assert(jobs::JobFunction::kFitsInline<Small>);
+	static_assert(jobs::JobFunction::kFitsInline<std::function<void()>>);
+	static_assert(!jobs::JobFunction::kFitsInline<Large>);
+
+	int value = 0;
+	jobs::JobFunction small(Small{ &value });
+	jobs::JobFunction large(Large{ {}, &value });
+
+	jobs::JobFunction movedSmall(std::move(small));
+	jobs::JobFunction movedLarge(std::move(large));
+	EXPECT_FALSE(small);
+	EXPECT_FALSE(large);
+
+	movedSmall();
+	movedLarge();
+	EXPECT_EQ(value, 2);
+}
+
+TEST(JobSystem, ParallelForCoversEveryIndexOnceInFixedChunks)
+{
+	jobs::Scheduler scheduler(4);
+	constexpr std::size_t kCount = 10007;
+	constexpr std::size_t kGrain = 64;
+
+	std::vector<std::atomic<int>> hits(kCount);
+	const std::size_t chunkCount = jobs::ParallelForChunkCount(kCount, kGrain);
+	std::vector<std::size_t> chunkBegins(chunkCount, kCount);
+	jobs::ParallelFor(&scheduler, kCount, kGrain, [&](std::size_t begin, std::size_t end)
+		{
+			chunkBegins[begin / kGrain] = begin;
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				hits[i].fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		ASSERT_EQ(hits[i].load(), 1) << "index " << i;
+	}
+	for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+	{
+		EXPECT_EQ(chunkBegins[chunk], chunk * kGrain);
+	}
+
+	// Without a scheduler the same chunks run inline, in order.
+	std::vector<std::size_t> inlineBegins;
+	jobs::ParallelFor(nullptr, kCount, kGrain, [&](std::size_t begin, std::size_t) { inlineBegins.push_back(begin); });
+	ASSERT_EQ(inlineBegins.size(), chunkCount);
+	EXPECT_EQ(inlineBegins.back(), (chunkCount - 1) * kGrain);
+	EXPECT_EQ(jobs::ParallelForChunkCount(0, kGrain), 0u);
+}
+
+TEST(JobSystem, WorkStealingAdapterImplementsIJobSystem)
+{
+	rendern::JobSystemWorkStealing jobSystem(2);
+	IJobSystem& jobsInterface = jobSystem;
+
+	std::atomic<int> counter{ 0 };
+	for (int i = 0; i < 256; ++i)
+	{
+		jobsInterface.Enqueue([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+	}
+	jobsInterface.WaitIdle();
+
+	EXPECT_EQ(counter.load(), 256);
+}
+
+TEST(JobSystem, MpscQueueKeepsPerProducerOrder)
+{
+	constexpr int kProducers = 4;
+	constexpr int kPerProducer = 5000;
+
+	jobs::MpscQueue<int> queue;
+	std::vector<std::thread> producers;
+	for (int p = 0; p < kProducers; ++p)
+	{
+		producers.emplace_back([&queue, p]
+			{
+				for (int i = 0; i < kPerProducer; ++i)
+				{
+					queue.Push(p * kPerProducer + i);
+				}
+			});
+	}
+
+	std::vector<int> lastSeen(kProducers, -1);
+	int popped = 0;
+	while (popped < kProducers * kPerProducer)
+	{
+		if (std::optional<int> value = queue.TryPop())
+		{
+			const int producer = *value / kPerProducer;
+			const int sequence = *value % kPerProducer;
+			EXPECT_GT(sequence, lastSeen[producer]);
+			lastSeen[producer] = sequence;
+			++popped;
+		}
+	}
+
+	for (std::thread& producer : producers)
+	{
+		producer.join();
+	}
+
+	EXPECT_FALSE(queue.TryPop().has_value());
+	EXPECT_EQ(queue.SizeApprox(), 0u);
+}
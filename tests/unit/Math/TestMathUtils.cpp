@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
 #include "MathTestHelper.h"
 
 using namespace MathTestHelper;
@@ -261,4 +265,126 @@ TEST(MathUtils, Mat4Inverse)
 
 	ExpectIdentityNear(matrix * inv);
 	ExpectIdentityNear(inv * matrix);
-}
\ No newline at end of file
+}
+TEST(MathUtils, ProjectSphereNdcRect)
+{
+	const Mat4 viewProj = PerspectiveRH_ZO(DegToRad(90.0f), 1.0f, 0.1f, 100.0f) *
+		LookAtRH(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+
+	// The near face of the bounding cube (z = -9) is the widest: +-1/9 in NDC.
+	const NdcRect centered = ProjectSphereNdcRect(viewProj, Vec3(0.0f, 0.0f, -10.0f), 1.0f);
+	EXPECT_NEAR(centered.x0, -1.0f / 9.0f, kEpsVec);
+	EXPECT_NEAR(centered.x1, 1.0f / 9.0f, kEpsVec);
+	EXPECT_NEAR(centered.y0, -1.0f / 9.0f, kEpsVec);
+	EXPECT_NEAR(centered.y1, 1.0f / 9.0f, kEpsVec);
+
+	EXPECT_TRUE(ProjectSphereNdcRect(viewProj, Vec3(50.0f, 0.0f, -10.0f), 1.0f).Empty());
+
+	// Reaching behind the eye: conservatively the whole screen.
+	const NdcRect around = ProjectSphereNdcRect(viewProj, Vec3(0.0f, 0.0f, -0.5f), 1.0f);
+	EXPECT_FLOAT_EQ(around.x0, -1.0f);
+	EXPECT_FLOAT_EQ(around.x1, 1.0f);
+	EXPECT_FLOAT_EQ(around.y0, -1.0f);
+	EXPECT_FLOAT_EQ(around.y1, 1.0f);
+}
+
+TEST(MathUtils, FrustumRestrictedToNdcRect)
+{
+	const Mat4 viewProj = PerspectiveRH_ZO(DegToRad(90.0f), 1.0f, 0.1f, 100.0f) *
+		LookAtRH(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+
+	const Frustum full = ExtractFrustumRH_ZO(viewProj);
+	const Frustum rightHalf = ExtractFrustumRH_ZO(viewProj, NdcRect{ 0.0f, -1.0f, 1.0f, 1.0f });
+
+	EXPECT_TRUE(IntersectsSphere(full, Vec3(-3.0f, 0.0f, -10.0f), 1.0f));
+	EXPECT_FALSE(IntersectsSphere(rightHalf, Vec3(-3.0f, 0.0f, -10.0f), 1.0f));
+	EXPECT_TRUE(IntersectsSphere(rightHalf, Vec3(3.0f, 0.0f, -10.0f), 1.0f));
+	EXPECT_TRUE(IntersectsSphere(rightHalf, Vec3(-0.5f, 0.0f, -10.0f), 1.0f)); // straddles x = 0
+	EXPECT_FALSE(IntersectsSphere(rightHalf, Vec3(3.0f, 0.0f, -200.0f), 1.0f)); // far plane is kept
+}
+
+TEST(MathUtils, BatchCullingMatchesScalar)
+{
+	const Mat4 viewProj = PerspectiveRH_ZO(DegToRad(60.0f), 1.5f, 0.1f, 50.0f) *
+		LookAtRH(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+	const Frustum frustum = ExtractFrustumRH_ZO(viewProj);
+
+	// 37 elements: full SIMD steps plus a scalar tail, spread inside, across and outside every plane.
+	constexpr std::size_t kCount = 37;
+	std::vector<float> cx, cy, cz, r, minX, minY, minZ, maxX, maxY, maxZ;
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		const float f = static_cast<float>(i);
+		cx.push_back(std::sin(f * 1.7f) * 40.0f);
+		cy.push_back(std::cos(f * 2.3f) * 25.0f);
+		cz.push_back(-std::fmod(f * 7.0f, 70.0f) + 5.0f);
+		r.push_back(0.5f + std::fmod(f, 4.0f));
+		minX.push_back(cx.back() - r.back());
+		minY.push_back(cy.back() - r.back() * 0.5f);
+		minZ.push_back(cz.back() - r.back());
+		maxX.push_back(cx.back() + r.back());
+		maxY.push_back(cy.back() + r.back() * 0.5f);
+		maxZ.push_back(cz.back() + r.back());
+	}
+
+	std::vector<std::uint32_t> sphereMask(CullMaskWordCount(kCount), 0xFFFFFFFFu);
+	std::vector<std::uint32_t> boxMask(CullMaskWordCount(kCount), 0xFFFFFFFFu);
+	CullSpheres(frustum, cx, cy, cz, r, sphereMask);
+	CullAabbs(frustum, minX, minY, minZ, maxX, maxY, maxZ, boxMask);
+
+	std::size_t visibleSpheres = 0;
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		const bool sphereVisible = IntersectsSphere(frustum, Vec3(cx[i], cy[i], cz[i]), r[i]);
+		const bool boxVisible = IntersectsAabb(frustum, Vec3(minX[i], minY[i], minZ[i]), Vec3(maxX[i], maxY[i], maxZ[i]));
+		EXPECT_EQ(TestCullMaskBit(sphereMask, i), sphereVisible) << i;
+		EXPECT_EQ(TestCullMaskBit(boxMask, i), boxVisible) << i;
+		visibleSpheres += sphereVisible ? 1 : 0;
+	}
+	EXPECT_GT(visibleSpheres, 0u);
+	EXPECT_LT(visibleSpheres, kCount);
+	EXPECT_EQ(sphereMask.back() >> (kCount % 32), 0u); // bits past the count are cleared
+
+	std::vector<std::uint32_t> indices(kCount);
+	const std::size_t compacted = CompactCullMask(sphereMask, kCount, indices);
+	ASSERT_EQ(compacted, visibleSpheres);
+	for (std::size_t k = 0; k < compacted; ++k)
+	{
+		EXPECT_TRUE(TestCullMaskBit(sphereMask, indices[k]));
+		if (k > 0)
+		{
+			EXPECT_LT(indices[k - 1], indices[k]);
+		}
+	}
+}
+
+TEST(MathUtils, SimdMatchesScalarReference)
+{
+	// Whichever backend the build selected must agree with the scalar reference paths.
+	const Mat4 a = Translate(Mat4(1.0f), Vec3(3.0f, -2.0f, 7.5f)) * Rotate(Mat4(1.0f), 0.7f, Vec3(0.3f, 0.8f, -0.5f)) *
+		Scale(Mat4(1.0f), Vec3(1.5f, 0.25f, 2.0f));
+	const Mat4 b = PerspectiveRH_ZO(DegToRad(70.0f), 1.7f, 0.1f, 250.0f) *
+		LookAtRH(Vec3(4.0f, 3.0f, 9.0f), Vec3(0.0f, 1.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+
+	ExpectMat4Near(a * b, scalar::Mul(a, b), 1e-5f);
+	ExpectMat4Near(b * a, scalar::Mul(b, a), 1e-5f);
+
+	const Vec4 v(1.25f, -4.0f, 0.5f, 1.0f);
+	ExpectVec4Near(a * v, scalar::Mul(a, v), 1e-5f);
+	ExpectVec3Near(TransformPoint(a, Vec3(v.x, v.y, v.z)), Vec3(scalar::Mul(a, v).x, scalar::Mul(a, v).y, scalar::Mul(a, v).z), 1e-5f);
+
+	ExpectMat4Near(Inverse(a), scalar::Inverse(a), 1e-5f);
+	const Mat4 view = LookAtRH(Vec3(4.0f, 3.0f, 9.0f), Vec3(0.0f, 1.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+	ExpectMat4Near(Inverse(view), scalar::Inverse(view), 1e-5f);
+	ExpectIdentityNear(b * Inverse(b));
+	ExpectIdentityNear(a * Inverse(a));
+	ExpectIdentityNear(Inverse(Scale(Mat4(1.0f), Vec3(1.0f, 0.0f, 1.0f)))); // singular: identity fallback
+
+	for (const Vec4& q : { Vec4(0.0f, 0.0f, 0.0f, 1.0f), Vec4(0.5f, -0.5f, 0.5f, 0.5f), Vec4(0.1825742f, 0.3651484f, 0.5477226f, 0.7302967f) })
+	{
+		const Mat4 m = QuatToMat4(q);
+		ExpectMat4Near(m, scalar::QuatToMat4(q), 1e-6f);
+		EXPECT_FLOAT_EQ(m[3].w, 1.0f);
+		EXPECT_FLOAT_EQ(m[0].w, 0.0f);
+	}
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+import core;
+
+TEST(FrameArena, AllocationsAreAlignedAndDisjoint)
+{
+	memory::FrameArena arena(4096);
+
+	void* a = arena.allocate(3, 1);
+	void* b = arena.allocate(16, 64);
+	void* c = arena.allocate(8, 8);
+
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64u, 0u);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(c) % 8u, 0u);
+	EXPECT_GE(static_cast<std::byte*>(b), static_cast<std::byte*>(a) + 3);
+	EXPECT_GE(static_cast<std::byte*>(c), static_cast<std::byte*>(b) + 16);
+}
+
+TEST(FrameArena, ResetReusesTheSameMemory)
+{
+	memory::FrameArena arena(4096);
+
+	void* first = arena.allocate(128, 16);
+	arena.Reset();
+	void* second = arena.allocate(128, 16);
+
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(arena.PeakBytes(), 128u);
+}
+
+TEST(FrameArena, OverflowCoalescesIntoOneBlockOnReset)
+{
+	memory::FrameArena arena(4096);
+	{
+		std::pmr::vector<std::uint32_t> values{ &arena };
+		for (std::uint32_t i = 0; i < 10000; ++i)
+		{
+			values.push_back(i);
+		}
+		EXPECT_EQ(values[9999], 9999u);
+	}
+	const std::size_t capacity = arena.Capacity();
+	EXPECT_GT(capacity, 4096u);
+
+	arena.Reset();
+	EXPECT_EQ(arena.Capacity(), capacity);
+	EXPECT_EQ(arena.UsedBytes(), 0u);
+
+	// The whole previous frame now fits in the first block.
+	void* p = arena.allocate(arena.PeakBytes() / 2, 16);
+	EXPECT_NE(p, nullptr);
+	EXPECT_EQ(arena.Capacity(), capacity);
+}
+
+TEST(FrameArena, NestedPmrContainersAllocateFromTheArena)
+{
+	memory::FrameArena arena(4096);
+	std::pmr::unordered_map<int, std::pmr::vector<float>> buckets{ &arena };
+	buckets[7].push_back(1.0f);
+
+	EXPECT_EQ(buckets[7].get_allocator().resource(), &arena);
+	EXPECT_GT(arena.UsedBytes(), 0u);
+}
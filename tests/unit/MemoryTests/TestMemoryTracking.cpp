@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+import core;
+
+using memory::MemoryTag;
+
+// Counters are process-wide, so the tests compare against a snapshot taken at their start.
+
+TEST(MemoryTracking, TrackingResourceChargesItsTag)
+{
+	const memory::MemoryTagStats before = memory::GetMemoryTagStats(MemoryTag::Level);
+	const memory::MemoryTagStats otherBefore = memory::GetMemoryTagStats(MemoryTag::Meshes);
+	{
+		std::pmr::vector<std::uint32_t> values{ memory::TrackingResource(MemoryTag::Level) };
+		values.reserve(256);
+
+		const memory::MemoryTagStats during = memory::GetMemoryTagStats(MemoryTag::Level);
+		EXPECT_EQ(during.cpuBytes, before.cpuBytes + 256 * sizeof(std::uint32_t));
+		EXPECT_EQ(during.cpuAllocations, before.cpuAllocations + 1);
+		EXPECT_GE(during.cpuPeakBytes, during.cpuBytes);
+	}
+
+	const memory::MemoryTagStats after = memory::GetMemoryTagStats(MemoryTag::Level);
+	EXPECT_EQ(after.cpuBytes, before.cpuBytes);
+	EXPECT_EQ(after.cpuAllocations, before.cpuAllocations);
+	EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Meshes).cpuBytes, otherBefore.cpuBytes);
+}
+
+TEST(MemoryTracking, UpstreamResourceIsUsed)
+{
+	std::byte buffer[1024];
+	std::pmr::monotonic_buffer_resource upstream(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+	memory::TrackingMemoryResource tracking(MemoryTag::Renderer, &upstream);
+
+	const std::uint64_t before = memory::GetMemoryTagStats(MemoryTag::Renderer).cpuBytes;
+	void* p = tracking.allocate(64, 16);
+	EXPECT_GE(static_cast<std::byte*>(p), buffer);
+	EXPECT_LT(static_cast<std::byte*>(p), buffer + sizeof(buffer));
+	EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Renderer).cpuBytes, before + 64);
+
+	tracking.deallocate(p, 64, 16);
+	EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Renderer).cpuBytes, before);
+}
+
+TEST(MemoryTracking, LevelPeakRestartsAtCurrentUsage)
+{
+	memory::TrackedBytes held(MemoryTag::Animation);
+	held.Set(4096);
+
+	{
+		memory::TrackedBytes spike(MemoryTag::Animation);
+		spike.Set(1 << 20);
+	}
+	const memory::MemoryTagStats beforeReset = memory::GetMemoryTagStats(MemoryTag::Animation);
+	EXPECT_GE(beforeReset.cpuLevelPeakBytes, beforeReset.cpuBytes + (1 << 20));
+
+	memory::ResetLevelMemoryPeaks();
+	const memory::MemoryTagStats afterReset = memory::GetMemoryTagStats(MemoryTag::Animation);
+	EXPECT_EQ(afterReset.cpuLevelPeakBytes, afterReset.cpuBytes);
+	EXPECT_GE(afterReset.cpuPeakBytes, beforeReset.cpuLevelPeakBytes);
+
+	held.Set(8192);
+	EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Animation).cpuLevelPeakBytes, afterReset.cpuBytes + 4096);
+}
+
+TEST(MemoryTracking, TrackedBytesCopiesChargeAndMovesTransfer)
+{
+	const std::uint64_t before = memory::GetMemoryTagStats(MemoryTag::Animation).cpuBytes;
+	{
+		memory::TrackedBytes a(MemoryTag::Animation);
+		a.Set(100);
+
+		memory::TrackedBytes copy = a;
+		EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Animation).cpuBytes, before + 200);
+
+		memory::TrackedBytes moved = std::move(copy);
+		EXPECT_EQ(copy.Bytes(), 0u);
+		EXPECT_EQ(moved.Bytes(), 100u);
+		EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Animation).cpuBytes, before + 200);
+
+		a.Set(40);
+		EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Animation).cpuBytes, before + 140);
+	}
+	EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Animation).cpuBytes, before);
+}
+
+TEST(MemoryTracking, ScopedGpuTagNestsAndRestores)
+{
+	EXPECT_EQ(memory::CurrentGpuMemoryTag(), MemoryTag::Renderer);
+	{
+		const memory::ScopedGpuMemoryTag meshes(MemoryTag::Meshes);
+		EXPECT_EQ(memory::CurrentGpuMemoryTag(), MemoryTag::Meshes);
+		{
+			const memory::ScopedGpuMemoryTag textures(MemoryTag::Textures);
+			EXPECT_EQ(memory::CurrentGpuMemoryTag(), MemoryTag::Textures);
+		}
+		EXPECT_EQ(memory::CurrentGpuMemoryTag(), MemoryTag::Meshes);
+	}
+	EXPECT_EQ(memory::CurrentGpuMemoryTag(), MemoryTag::Renderer);
+
+	const memory::MemoryTagStats before = memory::GetMemoryTagStats(MemoryTag::Textures);
+	memory::TrackGpuAlloc(MemoryTag::Textures, 1 << 16);
+	EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Textures).gpuBytes, before.gpuBytes + (1 << 16));
+	EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Textures).gpuAllocations, before.gpuAllocations + 1);
+	memory::TrackGpuFree(MemoryTag::Textures, 1 << 16);
+	EXPECT_EQ(memory::GetMemoryTagStats(MemoryTag::Textures).gpuBytes, before.gpuBytes);
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+import core;
+
+namespace
+{
+	// The profiler is process-wide: drop whatever earlier tests left in the rings and the history.
+	void StartCleanCapture()
+	{
+		profiling::Profiler& profiler = profiling::Profiler::Get();
+		profiler.SetEnabled(true);
+		profiler.EndFrame();
+		profiler.ClearHistory();
+	}
+
+	const profiling::ThreadCapture* FindThread(const profiling::FrameCapture& frame, const std::string& name)
+	{
+		const auto it = std::find_if(frame.threads.begin(), frame.threads.end(),
+			[&](const profiling::ThreadCapture& thread) { return thread.name == name; });
+		return it != frame.threads.end() ? &*it : nullptr;
+	}
+}
+
+TEST(Profiler, NestedZonesKeepDepthAndOrder)
+{
+	StartCleanCapture();
+	profiling::Profiler& profiler = profiling::Profiler::Get();
+	profiling::SetThreadName("Test main");
+
+	profiler.BeginFrame();
+	{
+		profiling::ScopedZone outer{ "Outer" };
+		{
+			profiling::ScopedZone inner{ "Inner" };
+		}
+		profiling::ScopedZone second{ "Second" };
+	}
+	profiler.EndFrame();
+
+	ASSERT_EQ(profiler.GetHistory().size(), 1u);
+	const profiling::FrameCapture& frame = profiler.GetHistory().back();
+	const profiling::ThreadCapture* thread = FindThread(frame, "Test main");
+	ASSERT_NE(thread, nullptr);
+	ASSERT_EQ(thread->zones.size(), 3u);
+
+	// Zones are recorded as they close: children first.
+	EXPECT_STREQ(thread->zones[0].name, "Inner");
+	EXPECT_STREQ(thread->zones[1].name, "Second");
+	EXPECT_STREQ(thread->zones[2].name, "Outer");
+	EXPECT_EQ(thread->zones[0].depth, 1u);
+	EXPECT_EQ(thread->zones[1].depth, 1u);
+	EXPECT_EQ(thread->zones[2].depth, 0u);
+
+	const profiling::ZoneEvent& outer = thread->zones[2];
+	for (const profiling::ZoneEvent& child : { thread->zones[0], thread->zones[1] })
+	{
+		EXPECT_GE(child.beginNs, outer.beginNs);
+		EXPECT_LE(child.endNs, outer.endNs);
+	}
+	EXPECT_GE(outer.beginNs, frame.beginNs);
+	EXPECT_LE(outer.endNs, frame.endNs);
+}
+
+TEST(Profiler, EachThreadGetsItsOwnTrack)
+{
+	StartCleanCapture();
+	profiling::Profiler& profiler = profiling::Profiler::Get();
+
+	profiler.BeginFrame();
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([t]()
+			{
+				profiling::SetThreadName("Worker " + std::to_string(t));
+				for (int i = 0; i < 100; ++i)
+				{
+					profiling::ScopedZone zone{ "Work" };
+				}
+			});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	profiler.EndFrame();
+
+	ASSERT_EQ(profiler.GetHistory().size(), 1u);
+	const profiling::FrameCapture& frame = profiler.GetHistory().back();
+	for (int t = 0; t < 4; ++t)
+	{
+		const profiling::ThreadCapture* thread = FindThread(frame, "Worker " + std::to_string(t));
+		ASSERT_NE(thread, nullptr);
+		EXPECT_EQ(thread->zones.size(), 100u);
+	}
+	EXPECT_EQ(frame.droppedZones, 0u);
+}
+
+TEST(Profiler, DisabledProfilerRecordsNothing)
+{
+	StartCleanCapture();
+	profiling::Profiler& profiler = profiling::Profiler::Get();
+	profiler.SetEnabled(false);
+
+	profiler.BeginFrame();
+	{
+		profiling::ScopedZone zone{ "Hidden" };
+	}
+	profiler.EndFrame();
+	profiler.SetEnabled(true);
+
+	EXPECT_TRUE(profiler.GetHistory().empty());
+}
+
+TEST(Profiler, ChromeTraceHasCpuAndGpuEvents)
+{
+	StartCleanCapture();
+	profiling::Profiler& profiler = profiling::Profiler::Get();
+	profiling::SetThreadName("Trace \"main\"");
+
+	profiler.BeginFrame();
+	{
+		profiling::ScopedZone zone{ profiling::InternZoneName(std::string("Pass_") + "Shadow") };
+	}
+	profiler.SubmitGpuZones({ profiling::GpuZone{ "MainPass", 0.25, 1.5, 0 } });
+	profiler.EndFrame();
+
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "profiler_trace_test.json";
+	ASSERT_TRUE(profiler.WriteChromeTrace(path));
+
+	std::ifstream in(path, std::ios::binary);
+	const std::string text{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+	in.close();
+	std::filesystem::remove(path);
+
+	EXPECT_EQ(text.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+	EXPECT_NE(text.find("\"name\":\"Pass_Shadow\",\"cat\":\"cpu\",\"ph\":\"X\""), std::string::npos);
+	EXPECT_NE(text.find("\"name\":\"MainPass\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":2"), std::string::npos);
+	EXPECT_NE(text.find("\"dur\":1250.000"), std::string::npos);
+	EXPECT_NE(text.find("Trace \\\"main\\\""), std::string::npos);
+	EXPECT_EQ(text.substr(text.size() - 4), "\n]}\n");
+}
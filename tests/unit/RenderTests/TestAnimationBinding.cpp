@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rendern::Skeleton MakeSkeleton()
+	{
+		rendern::Skeleton skeleton{};
+		skeleton.bones.push_back(rendern::SkeletonBone{ .name = "root", .parentIndex = -1 });
+		skeleton.bones.push_back(rendern::SkeletonBone{ .name = "spine", .parentIndex = 0 });
+		skeleton.bones.push_back(rendern::SkeletonBone{ .name = "head", .parentIndex = 1 });
+		skeleton.bones.push_back(rendern::SkeletonBone{ .name = "arm", .parentIndex = 1 });
+		rendern::RebuildBoneNameLookup(skeleton);
+		return skeleton;
+	}
+
+	// Channels bound by name only (boneIndex -1), like a clip imported from another file.
+	rendern::AnimationClip MakeClip(const std::vector<std::string>& boneNames)
+	{
+		rendern::AnimationClip clip{};
+		clip.durationTicks = 10.0f;
+		clip.ticksPerSecond = 1.0f;
+		for (const std::string& name : boneNames)
+		{
+			rendern::BoneAnimationChannel channel{};
+			channel.boneName = name;
+			channel.translationKeys = {
+				rendern::TranslationKey{ .timeTicks = 0.0f, .value = { 0.0f, 0.0f, 0.0f } },
+				rendern::TranslationKey{ .timeTicks = 10.0f, .value = { 10.0f, 0.0f, 0.0f } } };
+			clip.channels.push_back(channel);
+		}
+		rendern::RebuildClipChannelLayoutHash(clip);
+		return clip;
+	}
+}
+
+TEST(SkeletonBoneLookup, FindsBonesByName)
+{
+	rendern::Skeleton skeleton = MakeSkeleton();
+	ASSERT_EQ(skeleton.boneNameLookup.size(), skeleton.bones.size());
+	EXPECT_NE(skeleton.layoutHash, 0u);
+
+	EXPECT_EQ(rendern::FindBoneIndex(skeleton, "root"), 0u);
+	EXPECT_EQ(rendern::FindBoneIndex(skeleton, "head"), 2u);
+	EXPECT_EQ(rendern::FindBoneIndex(skeleton, "arm"), 3u);
+	EXPECT_FALSE(rendern::FindBoneIndex(skeleton, "tail").has_value());
+	EXPECT_FALSE(rendern::FindBoneIndex(skeleton, "").has_value());
+
+	// Duplicate names resolve to the first bone.
+	skeleton.bones.push_back(rendern::SkeletonBone{ .name = "spine", .parentIndex = 0 });
+	rendern::RebuildBoneNameLookup(skeleton);
+	EXPECT_EQ(rendern::FindBoneIndex(skeleton, "spine"), 1u);
+}
+
+TEST(SkeletonBoneLookup, BonesAddedAfterTheRebuildAreStillFound)
+{
+	rendern::Skeleton skeleton = MakeSkeleton();
+	skeleton.bones.push_back(rendern::SkeletonBone{ .name = "tail", .parentIndex = 0 });
+
+	EXPECT_EQ(rendern::FindBoneIndex(skeleton, "tail"), 4u);
+	EXPECT_EQ(rendern::FindBoneIndex(skeleton, "head"), 2u);
+}
+
+TEST(AnimationBindingCache, ResolvesChannelsByNameAndDepth)
+{
+	const rendern::Skeleton skeleton = MakeSkeleton();
+	const rendern::AnimationClip clip = MakeClip({ "arm", "missing", "root" });
+
+	rendern::AnimationBindingCache cache;
+	const auto binding = cache.Get(skeleton, &clip);
+	ASSERT_NE(binding, nullptr);
+	EXPECT_EQ(binding->boneCount, 4u);
+	EXPECT_EQ(binding->channelCount, 3u);
+	EXPECT_EQ(binding->channelIndexByBone, (std::vector<int>{ 2, -1, -1, 0 }));
+	EXPECT_EQ(binding->boneDepths, (std::vector<std::uint16_t>{ 0u, 1u, 2u, 2u }));
+}
+
+TEST(AnimationBindingCache, EqualLayoutsShareOneTable)
+{
+	const rendern::Skeleton skeletonA = MakeSkeleton();
+	const rendern::Skeleton skeletonB = MakeSkeleton();
+	const rendern::AnimationClip walk = MakeClip({ "root", "spine" });
+	rendern::AnimationClip walkCopy = MakeClip({ "root", "spine" });
+	walkCopy.name = "walk (other file)";
+	const rendern::AnimationClip wave = MakeClip({ "arm" });
+
+	rendern::AnimationBindingCache cache;
+	const auto first = cache.Get(skeletonA, &walk);
+	EXPECT_EQ(cache.Get(skeletonA, &walk), first);
+	EXPECT_EQ(cache.Get(skeletonB, &walkCopy), first);
+	EXPECT_EQ(cache.Size(), 1u);
+
+	EXPECT_NE(cache.Get(skeletonA, &wave), first);
+	EXPECT_NE(cache.Get(skeletonA, nullptr), first);
+	EXPECT_EQ(cache.Size(), 3u);
+
+	// Entries handed out stay valid after a clear.
+	cache.Clear();
+	EXPECT_EQ(cache.Size(), 0u);
+	EXPECT_EQ(first->channelIndexByBone[1], 1);
+}
+
+TEST(AnimationBindingCache, ClipsWithoutAStoredHashBindTheSameWay)
+{
+	const rendern::Skeleton skeleton = MakeSkeleton();
+	const rendern::AnimationClip hashed = MakeClip({ "head" });
+	rendern::AnimationClip unhashed = MakeClip({ "head" });
+	unhashed.channelLayoutHash = 0;
+
+	rendern::AnimationBindingCache cache;
+	EXPECT_EQ(cache.Get(skeleton, &unhashed), cache.Get(skeleton, &hashed));
+}
+
+TEST(AnimationBindingCache, EditedClipIsNotServedAStaleTable)
+{
+	const rendern::Skeleton skeleton = MakeSkeleton();
+	rendern::AnimationClip clip = MakeClip({ "head" });
+
+	rendern::AnimationBindingCache cache;
+	EXPECT_EQ(cache.Get(skeleton, &clip)->channelIndexByBone[2], 0);
+
+	// A channel added without refreshing the stored hash.
+	clip.channels.push_back(clip.channels.front());
+	clip.channels.back().boneName = "arm";
+	const auto binding = cache.Get(skeleton, &clip);
+	EXPECT_EQ(binding->channelCount, 2u);
+	EXPECT_EQ(binding->channelIndexByBone[3], 1);
+}
+
+TEST(AnimationBindingCache, SwitchingClipsReusesTablesAndPoseStorage)
+{
+	const rendern::Skeleton skeleton = MakeSkeleton();
+	const rendern::AnimationClip walk = MakeClip({ "root", "spine" });
+	const rendern::AnimationClip wave = MakeClip({ "arm" });
+
+	rendern::AnimatorState animator{};
+	rendern::InitializeAnimator(animator, &skeleton, &walk);
+	rendern::EvaluateAnimator(animator);
+	const rendern::ClipSkeletonBinding* walkBinding = animator.binding.get();
+	ASSERT_NE(walkBinding, nullptr);
+
+	rendern::SetAnimatorClip(animator, &wave);
+	rendern::EvaluateAnimator(animator);
+	const rendern::ClipSkeletonBinding* waveBinding = animator.binding.get();
+	const rendern::LocalBoneTransform* pose = animator.localPose.data();
+	const rendern::BoneKeyCursor* cursors = animator.keyCursors.data();
+	const mathUtils::Mat4* skin = animator.skinMatrices.data();
+
+	for (int i = 0; i < 5; ++i)
+	{
+		rendern::SetAnimatorClip(animator, (i % 2 == 0) ? &walk : &wave);
+		EXPECT_EQ(animator.binding.get(), (i % 2 == 0) ? walkBinding : waveBinding);
+		rendern::AdvanceAnimator(animator, 2.5f);
+		rendern::EvaluateAnimator(animator);
+		EXPECT_EQ(animator.localPose.data(), pose);
+		EXPECT_EQ(animator.keyCursors.data(), cursors);
+		EXPECT_EQ(animator.skinMatrices.data(), skin);
+	}
+
+	// The last switch was to walk: the root slides, the arm keeps its bind pose.
+	EXPECT_FLOAT_EQ(animator.localPose[0].translation.x, 2.5f);
+	EXPECT_FLOAT_EQ(animator.localPose[3].translation.x, 0.0f);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+import core;
+
+namespace
+{
+	constexpr int kKeyCount = 121;
+	constexpr float kDurationTicks = 120.0f;
+
+	mathUtils::Vec4 YawQuat(float radians)
+	{
+		return mathUtils::Vec4(0.0f, std::sin(0.5f * radians), 0.0f, std::cos(0.5f * radians));
+	}
+
+	// 121 keys per track: a straight-line translation, a constant scale and a wobbling rotation.
+	rendern::AnimationClip MakeClip()
+	{
+		rendern::AnimationClip clip{};
+		clip.durationTicks = kDurationTicks;
+		clip.ticksPerSecond = 30.0f;
+
+		rendern::BoneAnimationChannel channel{};
+		channel.boneIndex = 0;
+		for (int i = 0; i < kKeyCount; ++i)
+		{
+			const float t = static_cast<float>(i);
+			channel.translationKeys.push_back(rendern::TranslationKey{ .timeTicks = t, .value = { t * 0.5f, 2.0f, -t * 0.25f } });
+			channel.rotationKeys.push_back(rendern::RotationKey{ .timeTicks = t, .value = YawQuat(std::sin(t * 0.1f)) });
+			channel.scaleKeys.push_back(rendern::ScaleKey{ .timeTicks = t, .value = { 1.0f, 1.0f, 1.0f } });
+		}
+		clip.channels.push_back(channel);
+		return clip;
+	}
+}
+
+TEST(AnimationCompression, SmallestThreeRoundTrips)
+{
+	const std::array<mathUtils::Vec4, 4> quats = {
+		YawQuat(0.3f),
+		rendern::NormalizeQuat(mathUtils::Vec4(-0.7f, 0.1f, 0.2f, 0.3f)),
+		rendern::NormalizeQuat(mathUtils::Vec4(0.1f, -0.2f, 0.9f, -0.1f)),
+		mathUtils::Vec4(0.0f, 0.0f, 0.0f, -1.0f) };
+
+	for (const mathUtils::Vec4& q : quats)
+	{
+		const mathUtils::Vec4 decoded = rendern::UnpackQuatSmallestThree(rendern::PackQuatSmallestThree(q));
+		EXPECT_GT(std::abs(rendern::DotQuat(q, decoded)), 0.99999f);
+	}
+}
+
+TEST(AnimationCompression, ReducesKeysAndCollapsesConstantTracks)
+{
+	rendern::AnimationClip clip = MakeClip();
+	const std::size_t uncompressedBytes = rendern::AnimationClipKeyBytes(clip);
+
+	rendern::CompressAnimationClip(clip);
+
+	const rendern::BoneAnimationChannel& channel = clip.channels[0];
+	EXPECT_TRUE(channel.translationKeys.empty());
+	EXPECT_TRUE(channel.rotationKeys.empty());
+	EXPECT_TRUE(channel.scaleKeys.empty());
+	EXPECT_EQ(channel.packedTranslation.keys.size(), 2u);
+	EXPECT_EQ(channel.packedScale.keys.size(), 1u);
+	EXPECT_LT(channel.packedRotation.keys.size(), static_cast<std::size_t>(kKeyCount));
+
+	EXPECT_GE(uncompressedBytes, rendern::AnimationClipKeyBytes(clip) * 5u);
+}
+
+TEST(AnimationCompression, SamplerDecodesWithinTolerance)
+{
+	const rendern::AnimationClip original = MakeClip();
+	rendern::AnimationClip compressed = original;
+	rendern::CompressAnimationClip(compressed);
+
+	const rendern::BoneAnimationChannel& source = original.channels[0];
+	const rendern::BoneAnimationChannel& packed = compressed.channels[0];
+	std::uint32_t translationCursor = 0u;
+	std::uint32_t rotationCursor = 0u;
+	std::uint32_t scaleCursor = 0u;
+	for (float t = 0.0f; t <= kDurationTicks; t += 0.37f)
+	{
+		const mathUtils::Vec3 fallback3{ 0.0f, 0.0f, 0.0f };
+		const mathUtils::Vec4 fallbackQ{ 0.0f, 0.0f, 0.0f, 1.0f };
+		const mathUtils::Vec3 expectedT = rendern::SampleTranslationKeys(source.translationKeys, t, fallback3);
+		const mathUtils::Vec4 expectedR = rendern::SampleRotationKeys(source.rotationKeys, t, fallbackQ);
+
+		const mathUtils::Vec3 actualT = rendern::SampleChannelTranslation(packed, t, kDurationTicks, fallback3, translationCursor);
+		const mathUtils::Vec4 actualR = rendern::SampleChannelRotation(packed, t, kDurationTicks, fallbackQ, rotationCursor);
+		const mathUtils::Vec3 actualS = rendern::SampleChannelScale(packed, t, kDurationTicks, fallback3, scaleCursor);
+
+		EXPECT_NEAR(actualT.x, expectedT.x, 5e-3f) << t;
+		EXPECT_NEAR(actualT.y, expectedT.y, 5e-3f) << t;
+		EXPECT_NEAR(actualT.z, expectedT.z, 5e-3f) << t;
+		EXPECT_GT(std::abs(rendern::DotQuat(actualR, expectedR)), std::cos(0.5f * 3e-3f)) << t;
+		EXPECT_NEAR(actualS.x, 1.0f, 1e-4f) << t;
+		EXPECT_NEAR(actualS.z, 1.0f, 1e-4f) << t;
+	}
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rendern::AnimationClip MakeClip(const char* name)
+	{
+		rendern::AnimationClip clip{};
+		clip.name = name;
+		clip.durationTicks = 1.0f;
+		clip.ticksPerSecond = 1.0f;
+		rendern::BoneAnimationChannel channel{};
+		channel.boneIndex = 0;
+		channel.translationKeys = { rendern::TranslationKey{ .timeTicks = 0.0f, .value = { 0.0f, 0.0f, 0.0f } } };
+		clip.channels.push_back(channel);
+		return clip;
+	}
+
+	rendern::AnimationParameterValue FloatValue(float value)
+	{
+		rendern::AnimationParameterValue out{};
+		out.type = rendern::AnimationParameterType::Float;
+		out.floatValue = value;
+		return out;
+	}
+
+	// Idle <-> Run on Speed, any state -> Idle on the Stop trigger.
+	struct ControllerFixture
+	{
+		rendern::Skeleton skeleton{};
+		std::vector<rendern::AnimationClip> clips;
+		std::vector<std::string> clipSourceAssetIds;
+		rendern::AnimationControllerAsset asset{};
+		rendern::AnimationControllerRuntime runtime{};
+		rendern::AnimatorState animator{};
+
+		ControllerFixture()
+		{
+			skeleton.bones.push_back(rendern::SkeletonBone{ .name = "root", .parentIndex = -1 });
+			clips = { MakeClip("Idle"), MakeClip("Run") };
+
+			asset.id = "test";
+			asset.defaultState = "Idle";
+			asset.parameters.push_back(rendern::AnimationParameterDesc{ .name = "Speed", .defaultValue = FloatValue(0.0f) });
+			rendern::AnimationParameterDesc stop{ .name = "Stop" };
+			stop.defaultValue.type = rendern::AnimationParameterType::Trigger;
+			asset.parameters.push_back(stop);
+
+			rendern::AnimationStateDesc idle{ .name = "Idle", .clipName = "Idle" };
+			idle.notifies.push_back(rendern::AnimationNotifyDesc{ .id = "Foot_Step", .timeNormalized = 0.0f, .fireOnEnter = true });
+			asset.states.push_back(idle);
+			asset.states.push_back(rendern::AnimationStateDesc{ .name = "Run", .clipName = "Run" });
+
+			rendern::AnimationTransitionDesc toRun{ .fromState = "Idle", .toState = "Run", .blendDurationSeconds = 0.0f };
+			toRun.conditions.push_back(rendern::AnimationConditionDesc{
+				.parameter = "Speed", .op = rendern::AnimationConditionOp::Greater, .value = FloatValue(0.5f) });
+			asset.transitions.push_back(toRun);
+
+			rendern::AnimationTransitionDesc toIdle{ .fromState = "*", .toState = "Idle", .blendDurationSeconds = 0.0f };
+			toIdle.conditions.push_back(rendern::AnimationConditionDesc{
+				.parameter = "Stop", .op = rendern::AnimationConditionOp::Triggered });
+			asset.transitions.push_back(toIdle);
+
+			asset.eventBindings.push_back(rendern::AnimationEventBindingDesc{ .animationEventId = "footstep", .gameplayEventId = "Step" });
+			asset.eventBindings.push_back(rendern::AnimationEventBindingDesc{ .animationEventId = "Jump", .gameplayEventId = "Leap" });
+
+			runtime.rootMotionMode = rendern::AnimationRootMotionMode::Allow;
+			rendern::BindAnimationControllerStateMachine(runtime, skeleton, clips, clipSourceAssetIds, asset, true, false, false);
+		}
+
+		void Tick()
+		{
+			rendern::UpdateAnimationControllerRuntime(runtime, animator, 0.1f);
+		}
+	};
+}
+
+TEST(AnimationController, CompilesNamesToIndices)
+{
+	ControllerFixture f;
+	const rendern::CompiledAnimationController& compiled = f.runtime.compiled;
+
+	EXPECT_EQ(compiled.asset, &f.asset);
+	EXPECT_EQ(compiled.defaultStateIndex, 0);
+	ASSERT_EQ(f.runtime.parameters.names.size(), 2u);
+	EXPECT_EQ(rendern::FindAnimationParameterSlot(f.runtime.parameters, "Speed"), 0);
+	EXPECT_EQ(rendern::FindAnimationParameterSlot(f.runtime.parameters, "Stop"), 1);
+
+	ASSERT_EQ(compiled.transitions.size(), 2u);
+	EXPECT_EQ(compiled.transitions[0].toStateIndex, 1);
+	EXPECT_TRUE(compiled.transitions[1].consumesTriggers);
+	ASSERT_EQ(compiled.conditions.size(), 2u);
+	EXPECT_EQ(compiled.conditions[0].parameterSlot, 0);
+	EXPECT_EQ(compiled.conditions[1].parameterSlot, 1);
+
+	// Idle leaves through both transitions, Run only through the wildcard one.
+	ASSERT_EQ(compiled.states.size(), 2u);
+	EXPECT_EQ(compiled.states[0].transitionCount, 2u);
+	EXPECT_EQ(compiled.states[1].transitionCount, 1u);
+	EXPECT_EQ(compiled.stateTransitions[compiled.states[1].firstTransition], 1u);
+}
+
+TEST(AnimationController, TransitionsOnSlotParameters)
+{
+	ControllerFixture f;
+	f.Tick();
+	EXPECT_EQ(rendern::GetAnimationControllerStateName(f.runtime), "Idle");
+
+	rendern::SetAnimationParameter(f.runtime.parameters, "Speed", 1.0f);
+	f.Tick();
+	EXPECT_EQ(f.runtime.currentStateIndex, 1);
+	EXPECT_EQ(rendern::GetAnimationControllerStateName(f.runtime), "Run");
+
+	rendern::FireAnimationTriggerAt(f.runtime.parameters, rendern::FindAnimationParameterSlot(f.runtime.parameters, "Stop"));
+	f.Tick();
+	EXPECT_EQ(rendern::GetAnimationControllerStateName(f.runtime), "Idle");
+	EXPECT_FALSE(rendern::FindAnimationParameter(f.runtime.parameters, "Stop")->triggerValue);
+
+	rendern::RequestAnimationControllerState(f.runtime, "Run");
+	EXPECT_EQ(f.runtime.requestedStateIndex, 1);
+	rendern::RequestAnimationControllerState(f.runtime, "Missing");
+	EXPECT_EQ(f.runtime.requestedStateIndex, -1);
+}
+
+TEST(AnimationController, UndeclaredConditionParameterReadsAsMissing)
+{
+	ControllerFixture f;
+	f.asset.transitions[0].conditions[0].parameter = "Velocity";
+	f.asset.transitions[0].conditions[0].op = rendern::AnimationConditionOp::IfFalse;
+	f.runtime = {};
+	f.runtime.rootMotionMode = rendern::AnimationRootMotionMode::Allow;
+	rendern::BindAnimationControllerStateMachine(f.runtime, f.skeleton, f.clips, f.clipSourceAssetIds, f.asset, true, false, false);
+
+	EXPECT_EQ(rendern::FindAnimationParameter(f.runtime.parameters, "Velocity"), nullptr);
+	f.Tick();
+	EXPECT_EQ(f.runtime.currentStateIndex, 0);
+
+	rendern::SetAnimationParameter(f.runtime.parameters, "Velocity", false);
+	f.Tick();
+	EXPECT_EQ(f.runtime.currentStateIndex, 1);
+}
+
+TEST(AnimationController, DebugCandidatesOnlyWhenRequested)
+{
+	ControllerFixture f;
+	f.Tick();
+	EXPECT_TRUE(f.runtime.debugTransitionCandidates.empty());
+
+	f.runtime.debugCaptureTransitions = true;
+	f.Tick();
+	EXPECT_FALSE(f.runtime.debugCaptureTransitions);
+	ASSERT_EQ(f.runtime.debugTransitionCandidates.size(), 2u);
+	EXPECT_EQ(f.runtime.debugTransitionCandidates[0], "Idle -> Run [condition failed: Speed]");
+	EXPECT_EQ(f.runtime.debugTransitionCandidates[1], "* -> Idle [condition failed: Stop]");
+
+	f.Tick();
+	EXPECT_TRUE(f.runtime.debugTransitionCandidates.empty());
+}
+
+TEST(AnimationController, NotifyEventsCarryCompiledBindings)
+{
+	ControllerFixture f;
+	f.Tick();
+
+	const std::vector<rendern::AnimationNotifyEvent> events = rendern::ConsumeAnimationControllerNotifyEvents(f.runtime);
+	ASSERT_EQ(events.size(), 1u);
+	EXPECT_EQ(events[0].stateIndex, 0);
+	EXPECT_EQ(events[0].notifyIndex, 0);
+
+	// "Foot_Step" and "footstep" share the canonical form; "Jump" does not match.
+	const auto bindings = rendern::GetAnimationNotifyEventBindings(f.runtime, events[0]);
+	ASSERT_EQ(bindings.size(), 1u);
+	EXPECT_EQ(f.asset.eventBindings[bindings[0]].gameplayEventId, "Step");
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+import core;
+
+namespace
+{
+	// Root and child both slide along x over a 10 second clip.
+	struct LodFixture
+	{
+		rendern::Skeleton skeleton{};
+		std::vector<rendern::AnimationClip> clips;
+		rendern::AnimationControllerRuntime runtime{};
+		rendern::AnimatorState animator{};
+
+		LodFixture()
+		{
+			skeleton.bones.push_back(rendern::SkeletonBone{ .name = "root", .parentIndex = -1 });
+			skeleton.bones.push_back(rendern::SkeletonBone{ .name = "child", .parentIndex = 0 });
+
+			rendern::AnimationClip clip{};
+			clip.durationTicks = 10.0f;
+			clip.ticksPerSecond = 1.0f;
+			for (int bone = 0; bone < 2; ++bone)
+			{
+				rendern::BoneAnimationChannel channel{};
+				channel.boneIndex = bone;
+				channel.translationKeys = {
+					rendern::TranslationKey{ .timeTicks = 0.0f, .value = { 0.0f, 0.0f, 0.0f } },
+					rendern::TranslationKey{ .timeTicks = 10.0f, .value = { 10.0f, 0.0f, 0.0f } } };
+				clip.channels.push_back(channel);
+			}
+			clips.push_back(clip);
+
+			rendern::SyncAnimationControllerLegacyClip(runtime, skeleton, clips, 0, true, true, 1.0f, false, false);
+			runtime.rootMotionMode = rendern::AnimationRootMotionMode::Allow;
+		}
+
+		// One Scene::UpdateSkinnedItem step; true when the controller ran.
+		bool Step(rendern::AnimationLodState& lod, rendern::AnimationLodLevel level, float dt, const rendern::AnimationLodSettings& settings = {})
+		{
+			if (!rendern::BeginAnimationLodFrame(lod, level, settings, dt))
+			{
+				rendern::StepAnimationLodWithoutEvaluation(runtime, animator, lod, settings);
+				return false;
+			}
+			rendern::EvaluateAnimationWithLod(runtime, animator, lod, settings);
+			return true;
+		}
+	};
+}
+
+TEST(AnimationLod, SelectsLevelFromScreenSize)
+{
+	const rendern::AnimationLodSettings settings{};
+	const mathUtils::Vec3 camera{ 0.0f, 0.0f, 0.0f };
+	const float fovY = mathUtils::DegToRad(90.0f);
+
+	// tan(45 deg) = 1: the screen size is radius / distance.
+	EXPECT_NEAR(rendern::AnimationLodScreenSize({ 0.0f, 0.0f, -10.0f }, 1.0f, camera, fovY), 0.1f, 1e-5f);
+	EXPECT_FLOAT_EQ(rendern::AnimationLodScreenSize({ 0.0f, 0.0f, -0.5f }, 1.0f, camera, fovY), 1.0f);
+
+	EXPECT_EQ(rendern::SelectAnimationLodLevel(settings, true, 0.5f), rendern::AnimationLodLevel::Full);
+	EXPECT_EQ(rendern::SelectAnimationLodLevel(settings, true, 0.1f), rendern::AnimationLodLevel::Reduced);
+	EXPECT_EQ(rendern::SelectAnimationLodLevel(settings, true, 0.01f), rendern::AnimationLodLevel::Low);
+	EXPECT_EQ(rendern::SelectAnimationLodLevel(settings, false, 0.5f), rendern::AnimationLodLevel::Offscreen);
+
+	rendern::AnimationLodSettings disabled{};
+	disabled.enabled = false;
+	EXPECT_EQ(rendern::SelectAnimationLodLevel(disabled, false, 0.01f), rendern::AnimationLodLevel::Full);
+}
+
+TEST(AnimationLod, ThrottledUpdatesCatchUpTime)
+{
+	LodFixture f;
+	rendern::AnimationLodState lod{};
+
+	int evaluations = 0;
+	for (int frame = 0; frame < 8; ++frame)
+	{
+		evaluations += f.Step(lod, rendern::AnimationLodLevel::Low, 0.25f) ? 1 : 0;
+	}
+
+	// The first frame (no pose yet), then every 4th.
+	EXPECT_EQ(evaluations, 3);
+	EXPECT_FLOAT_EQ(f.animator.timeSeconds, 2.0f);
+	EXPECT_NEAR(f.animator.localPose[0].translation.x, 2.0f, 1e-4f);
+}
+
+TEST(AnimationLod, ReducedInterpolatesBetweenEvaluatedPoses)
+{
+	LodFixture f;
+	rendern::AnimationLodState lod{};
+
+	ASSERT_TRUE(f.Step(lod, rendern::AnimationLodLevel::Reduced, 1.0f));  // pose at t = 1
+	ASSERT_TRUE(f.Step(lod, rendern::AnimationLodLevel::Reduced, 1.0f));  // pose at t = 2, shows t = 1
+	EXPECT_NEAR(f.animator.localPose[0].translation.x, 1.0f, 1e-4f);
+
+	ASSERT_FALSE(f.Step(lod, rendern::AnimationLodLevel::Reduced, 1.0f));
+	EXPECT_NEAR(f.animator.localPose[0].translation.x, 1.5f, 1e-4f);
+	EXPECT_NEAR(f.animator.globalMatrices[0][3].x, 1.5f, 1e-4f);
+}
+
+TEST(AnimationLod, OffscreenAdvancesTimeOnly)
+{
+	LodFixture f;
+	rendern::AnimationLodState lod{};
+
+	ASSERT_TRUE(f.Step(lod, rendern::AnimationLodLevel::Full, 1.0f));
+	const float poseX = f.animator.localPose[0].translation.x;
+
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		EXPECT_FALSE(f.Step(lod, rendern::AnimationLodLevel::Offscreen, 1.0f));
+	}
+	EXPECT_FLOAT_EQ(f.animator.timeSeconds, 4.0f);
+	EXPECT_FLOAT_EQ(f.animator.localPose[0].translation.x, poseX);
+
+	// Back in view: evaluated at once.
+	EXPECT_TRUE(f.Step(lod, rendern::AnimationLodLevel::Low, 1.0f));
+	EXPECT_NEAR(f.animator.localPose[0].translation.x, 5.0f, 1e-4f);
+}
+
+TEST(AnimationLod, LowFreezesDeepBones)
+{
+	LodFixture f;
+	rendern::AnimationLodState lod{};
+	rendern::AnimationLodSettings settings{};
+	settings.lowMaxBoneDepth = 0;
+
+	ASSERT_TRUE(f.Step(lod, rendern::AnimationLodLevel::Full, 1.0f, settings));
+	EXPECT_NEAR(f.animator.localPose[1].translation.x, 1.0f, 1e-4f);
+
+	// Frames 2-4: the Low interval comes round on frame 4.
+	int evaluations = 0;
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		evaluations += f.Step(lod, rendern::AnimationLodLevel::Low, 1.0f, settings) ? 1 : 0;
+	}
+	EXPECT_EQ(evaluations, 1);
+	EXPECT_NEAR(f.animator.localPose[0].translation.x, 4.0f, 1e-4f);
+	EXPECT_NEAR(f.animator.localPose[1].translation.x, 1.0f, 1e-4f);
+}
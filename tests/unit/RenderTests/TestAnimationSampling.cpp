@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+import core;
+
+namespace
+{
+	std::vector<rendern::TranslationKey> MakeKeys(const std::vector<float>& times)
+	{
+		std::vector<rendern::TranslationKey> keys;
+		for (float t : times)
+		{
+			// x follows t*t so every pair has a different slope.
+			keys.push_back(rendern::TranslationKey{ .timeTicks = t, .value = { t * t, t, 0.0f } });
+		}
+		return keys;
+	}
+
+	// Reference: linear scan for the pair, like the sampler did before cursors.
+	float Uncached(const std::vector<rendern::TranslationKey>& keys, float timeTicks)
+	{
+		if (timeTicks <= keys.front().timeTicks)
+		{
+			return keys.front().value.x;
+		}
+		for (std::size_t i = 0; i + 1 < keys.size(); ++i)
+		{
+			const rendern::TranslationKey& a = keys[i];
+			const rendern::TranslationKey& b = keys[i + 1];
+			if (timeTicks >= a.timeTicks && timeTicks <= b.timeTicks)
+			{
+				return a.value.x + (b.value.x - a.value.x) * (timeTicks - a.timeTicks) / (b.timeTicks - a.timeTicks);
+			}
+		}
+		return keys.back().value.x;
+	}
+}
+
+TEST(AnimationSampling, DetectsUniformKeyTiming)
+{
+	const rendern::UniformKeyTiming uniform = rendern::DetectUniformKeyTiming(MakeKeys({ 2.0f, 2.5f, 3.0f, 3.5f, 4.0f }));
+	EXPECT_FLOAT_EQ(uniform.firstTicks, 2.0f);
+	EXPECT_FLOAT_EQ(uniform.invStepTicks, 2.0f);
+	EXPECT_EQ(uniform.keyCount, 5u);
+
+	EXPECT_EQ(rendern::DetectUniformKeyTiming(MakeKeys({ 0.0f, 1.0f, 3.0f, 4.0f })).invStepTicks, 0.0f);
+	EXPECT_EQ(rendern::DetectUniformKeyTiming(MakeKeys({ 0.0f, 1.0f })).invStepTicks, 0.0f);
+}
+
+TEST(AnimationSampling, CursorMatchesUncachedForwardAndSeeking)
+{
+	const std::vector<rendern::TranslationKey> keys = MakeKeys({ 0.0f, 0.5f, 2.0f, 2.25f, 4.0f, 7.0f, 7.5f, 10.0f });
+	std::uint32_t cursor = 0u;
+
+	// Forward playback, then a loop wrap and a seek into the middle.
+	std::vector<float> times;
+	for (float t = -1.0f; t <= 11.0f; t += 0.1f)
+	{
+		times.push_back(t);
+	}
+	times.insert(times.end(), { 0.3f, 6.0f, 2.0f, 2.1f, 9.9f, 0.0f, 10.0f });
+
+	for (float t : times)
+	{
+		const float cached = rendern::SampleTranslationKeys(keys, t, mathUtils::Vec3(0.0f, 0.0f, 0.0f), rendern::UniformKeyTiming{}, cursor).x;
+		EXPECT_NEAR(cached, Uncached(keys, t), 1e-4f) << t;
+		EXPECT_LT(cursor, keys.size() - 1);
+	}
+}
+
+TEST(AnimationSampling, UniformTimingMatchesUncached)
+{
+	std::vector<float> times;
+	for (int i = 0; i < 61; ++i)
+	{
+		times.push_back(static_cast<float>(i) / 30.0f);
+	}
+	const std::vector<rendern::TranslationKey> keys = MakeKeys(times);
+	const rendern::UniformKeyTiming timing = rendern::DetectUniformKeyTiming(keys);
+	ASSERT_GT(timing.invStepTicks, 0.0f);
+
+	std::uint32_t cursor = 0u;
+	for (float t = -0.1f; t <= 2.1f; t += 0.013f)
+	{
+		const float cached = rendern::SampleTranslationKeys(keys, t, mathUtils::Vec3(0.0f, 0.0f, 0.0f), timing, cursor).x;
+		EXPECT_NEAR(cached, Uncached(keys, t), 1e-4f) << t;
+	}
+
+	// Timing built for other keys is ignored.
+	std::vector<rendern::TranslationKey> edited = keys;
+	edited.pop_back();
+	EXPECT_NEAR(
+		rendern::SampleTranslationKeys(edited, 1.01f, mathUtils::Vec3(0.0f, 0.0f, 0.0f), timing, cursor).x,
+		Uncached(edited, 1.01f),
+		1e-4f);
+}
+
+TEST(AnimationSampling, AnimatorKeepsPerBoneCursors)
+{
+	rendern::Skeleton skeleton{};
+	skeleton.bones.push_back(rendern::SkeletonBone{ .name = "root", .parentIndex = -1 });
+
+	rendern::AnimationClip clip{};
+	clip.durationTicks = 10.0f;
+	clip.ticksPerSecond = 1.0f;
+	rendern::BoneAnimationChannel channel{};
+	channel.boneIndex = 0;
+	channel.translationKeys = MakeKeys({ 0.0f, 1.0f, 2.0f, 5.0f, 10.0f });
+	clip.channels.push_back(channel);
+	rendern::BuildUniformKeyTiming(clip);
+
+	rendern::AnimatorState animator{};
+	rendern::InitializeAnimator(animator, &skeleton, &clip);
+	ASSERT_EQ(animator.keyCursors.size(), 1u);
+
+	animator.timeSeconds = 6.0f;
+	rendern::EvaluateAnimatorLocalPose(animator);
+	EXPECT_EQ(animator.keyCursors[0].translation, 3u);
+	EXPECT_NEAR(animator.localPose[0].translation.x, Uncached(clip.channels[0].translationKeys, 6.0f), 1e-4f);
+}
+
+TEST(AnimationSampling, AnimatorMatricesFollowHierarchy)
+{
+	rendern::Skeleton skeleton{};
+	skeleton.bones.push_back(rendern::SkeletonBone{ .name = "root", .parentIndex = -1 });
+	skeleton.bones.push_back(rendern::SkeletonBone{
+		.name = "child",
+		.parentIndex = 0,
+		.inverseBindMatrix = mathUtils::Translate(mathUtils::Mat4(1.0f), mathUtils::Vec3(0.0f, -2.0f, 0.0f)),
+		.bindLocalTransform = mathUtils::Translate(mathUtils::Mat4(1.0f), mathUtils::Vec3(0.0f, 2.0f, 0.0f)) });
+
+	rendern::AnimationClip clip{};
+	clip.durationTicks = 1.0f;
+	clip.ticksPerSecond = 1.0f;
+	rendern::BoneAnimationChannel channel{};
+	channel.boneIndex = 0;
+	channel.translationKeys = { rendern::TranslationKey{ .timeTicks = 0.0f, .value = { 1.0f, 0.0f, 0.0f } } };
+	clip.channels.push_back(channel);
+
+	rendern::AnimatorState animator{};
+	rendern::InitializeAnimator(animator, &skeleton, &clip);
+	rendern::EvaluateAnimator(animator);
+
+	ASSERT_EQ(animator.globalMatrices.size(), 2u);
+	const mathUtils::Vec3 childPos = mathUtils::TransformPoint(animator.globalMatrices[1], mathUtils::Vec3(0.0f, 0.0f, 0.0f));
+	EXPECT_FLOAT_EQ(childPos.x, 1.0f);
+	EXPECT_FLOAT_EQ(childPos.y, 2.0f);
+
+	// The child skin matrix only carries the root's offset.
+	const mathUtils::Vec3 skinned = mathUtils::TransformPoint(animator.skinMatrices[1], mathUtils::Vec3(0.0f, 2.0f, 0.0f));
+	EXPECT_FLOAT_EQ(skinned.x, 1.0f);
+	EXPECT_FLOAT_EQ(skinned.y, 2.0f);
+}
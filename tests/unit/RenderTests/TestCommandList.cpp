@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+import core;
+
+namespace
+{
+	std::array<std::byte, 16> Bytes(std::uint8_t seed)
+	{
+		std::array<std::byte, 16> bytes{};
+		for (std::size_t i = 0; i < bytes.size(); ++i)
+		{
+			bytes[i] = static_cast<std::byte>(seed + i);
+		}
+		return bytes;
+	}
+}
+
+TEST(CommandList, RecordsVariableSizeCommandsInOrder)
+{
+	rhi::CommandList list;
+	list.SetViewport(1, 2, 3, 4);
+	const auto constants = Bytes(10);
+	list.SetConstants(2, constants);
+	const std::array<rhi::TextureBarrier, 2> barriers{ {
+		{ rhi::TextureHandle{ 5 }, rhi::TextureState::RenderTarget },
+		{ rhi::TextureHandle{ 6 }, rhi::TextureState::ShaderRead } } };
+	list.TextureBarriers(barriers);
+	list.SetUniformInt("uTint", 7);
+	list.DrawIndexed(36, rhi::IndexType::UINT32);
+
+	ASSERT_EQ(list.Size(), 5u);
+	std::vector<std::uint16_t> types;
+	list.ForEach([&](const auto& cmd)
+		{
+			using T = std::decay_t<decltype(cmd)>;
+			types.push_back(rhi::kCommandType<T>);
+			if constexpr (std::is_same_v<T, rhi::CommandSetViewport>)
+			{
+				EXPECT_EQ(cmd.width, 3);
+			}
+			else if constexpr (std::is_same_v<T, rhi::CommandSetConstants>)
+			{
+				EXPECT_EQ(cmd.slot, 2u);
+				ASSERT_EQ(cmd.data.size(), constants.size());
+				EXPECT_TRUE(std::ranges::equal(cmd.data, constants));
+			}
+			else if constexpr (std::is_same_v<T, rhi::CommandTextureBarriers>)
+			{
+				ASSERT_EQ(cmd.barriers.size(), 2u);
+				EXPECT_EQ(cmd.barriers[1].texture, rhi::TextureHandle{ 6 });
+				EXPECT_EQ(cmd.barriers[1].state, rhi::TextureState::ShaderRead);
+			}
+			else if constexpr (std::is_same_v<T, rhi::CommandSetUniformInt>)
+			{
+				EXPECT_EQ(cmd.name, std::string_view("uTint"));
+				EXPECT_EQ(cmd.name.data()[cmd.name.size()], '\0');
+				EXPECT_EQ(cmd.value, 7);
+			}
+			else if constexpr (std::is_same_v<T, rhi::CommandDrawIndexed>)
+			{
+				EXPECT_EQ(cmd.indexCount, 36u);
+			}
+		});
+	EXPECT_EQ(types, (std::vector<std::uint16_t>{
+		rhi::kCommandType<rhi::CommandSetViewport>,
+		rhi::kCommandType<rhi::CommandSetConstants>,
+		rhi::kCommandType<rhi::CommandTextureBarriers>,
+		rhi::kCommandType<rhi::CommandSetUniformInt>,
+		rhi::kCommandType<rhi::CommandDrawIndexed> }));
+}
+
+TEST(CommandList, PayloadsSurviveChunkBoundariesMovesAndAppend)
+{
+	constexpr std::uint32_t kCount = 2000; // well past one chunk
+	rhi::CommandList first;
+	rhi::CommandList second;
+	for (std::uint32_t i = 0; i < kCount; ++i)
+	{
+		const auto bytes = Bytes(static_cast<std::uint8_t>(i));
+		(i < kCount / 2 ? first : second).SetConstants(i, bytes);
+	}
+	// Barrier batch larger than a whole chunk.
+	const std::vector<rhi::TextureBarrier> many(rhi::CommandList::kChunkBytes / sizeof(rhi::TextureBarrier) + 1, rhi::TextureBarrier{ rhi::TextureHandle{ 3 } });
+	second.TextureBarriers(many);
+
+	rhi::CommandList merged = std::move(first);
+	merged.Append(std::move(second));
+	EXPECT_TRUE(second.Empty());
+	ASSERT_EQ(merged.Size(), kCount + 1);
+
+	std::uint32_t next = 0;
+	std::size_t barrierCount = 0;
+	merged.ForEach([&](const auto& cmd)
+		{
+			using T = std::decay_t<decltype(cmd)>;
+			if constexpr (std::is_same_v<T, rhi::CommandSetConstants>)
+			{
+				EXPECT_EQ(cmd.slot, next);
+				EXPECT_TRUE(std::ranges::equal(cmd.data, Bytes(static_cast<std::uint8_t>(next))));
+				++next;
+			}
+			else if constexpr (std::is_same_v<T, rhi::CommandTextureBarriers>)
+			{
+				barrierCount = cmd.barriers.size();
+			}
+		});
+	EXPECT_EQ(next, kCount);
+	EXPECT_EQ(barrierCount, many.size());
+}
+
+TEST(CommandList, ResetRecordsIntoTheSameStorage)
+{
+	rhi::CommandList list;
+	const auto bytes = Bytes(1);
+	list.SetConstants(0, bytes);
+	const std::byte* firstRecording = (*list.begin()).GetIf<rhi::CommandSetConstants>()->data.data();
+
+	list.Reset();
+	EXPECT_TRUE(list.Empty());
+	EXPECT_EQ(list.begin(), list.end());
+
+	list.SetConstants(0, bytes);
+	ASSERT_EQ(list.Size(), 1u);
+	EXPECT_EQ((*list.begin()).GetIf<rhi::CommandSetConstants>()->data.data(), firstRecording);
+}
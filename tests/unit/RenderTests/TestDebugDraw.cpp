@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+import core;
+
+using rendern::debugDraw::DebugDrawList;
+using rendern::debugDraw::DebugShape;
+using rendern::debugDraw::DebugShapeInstance;
+using rendern::debugDraw::DebugShapeVertex;
+
+namespace
+{
+	// What VS_DebugShapes does with one unit mesh vertex.
+	mathUtils::Vec3 Place(const DebugShapeInstance& instance, const DebugShapeVertex& v)
+	{
+		const float axisLen = mathUtils::Length(instance.axisY);
+		const mathUtils::Vec3 capDir = axisLen > 0.0f ? instance.axisY / axisLen : mathUtils::Vec3(0.0f, 0.0f, 0.0f);
+		return instance.center
+			+ instance.axisX * v.pos.x
+			+ instance.axisY * v.pos.y
+			+ instance.axisZ * v.pos.z
+			+ capDir * (v.capSide * instance.capsuleHalfLength);
+	}
+
+	std::vector<mathUtils::Vec3> Expand(DebugShape shape, const DebugShapeInstance& instance)
+	{
+		std::vector<mathUtils::Vec3> out;
+		for (const DebugShapeVertex& v : rendern::debugDraw::BuildUnitShapeLines(shape))
+		{
+			out.push_back(Place(instance, v));
+		}
+		return out;
+	}
+
+	const DebugShapeInstance& Only(const DebugDrawList& list, DebugShape shape, bool overlay = false)
+	{
+		const auto& shapes = overlay ? list.overlayShapeInstances : list.shapeInstances;
+		return shapes[static_cast<std::size_t>(shape)].front();
+	}
+}
+
+TEST(DebugDraw, UnitShapesAreLineListsInsideTheUnitVolume)
+{
+	for (std::size_t i = 0; i < rendern::debugDraw::kDebugShapeCount; ++i)
+	{
+		const DebugShape shape = static_cast<DebugShape>(i);
+		const std::vector<DebugShapeVertex> lines = rendern::debugDraw::BuildUnitShapeLines(shape);
+		ASSERT_FALSE(lines.empty());
+		EXPECT_EQ(lines.size() % 2, 0u);
+
+		for (const DebugShapeVertex& v : lines)
+		{
+			EXPECT_LE(std::abs(v.pos.x), 1.0f + 1e-5f);
+			EXPECT_LE(std::abs(v.pos.y), 1.0f + 1e-5f);
+			EXPECT_LE(std::abs(v.pos.z), 1.0f + 1e-5f);
+			if (shape == DebugShape::Capsule)
+			{
+				EXPECT_EQ(std::abs(v.capSide), 1.0f);
+				// Each half only bulges away from the other.
+				EXPECT_GE(v.pos.y * v.capSide, -1e-5f);
+			}
+			else
+			{
+				EXPECT_EQ(v.capSide, 0.0f);
+			}
+		}
+	}
+	EXPECT_EQ(rendern::debugDraw::BuildUnitShapeLines(DebugShape::Box).size(), 24u);
+	EXPECT_EQ(rendern::debugDraw::BuildUnitShapeLines(DebugShape::Axis).size(), 6u);
+}
+
+TEST(DebugDraw, ShapesAreStoredAsOneInstanceEach)
+{
+	DebugDrawList list;
+	EXPECT_TRUE(list.Empty());
+
+	list.AddAabb({ -1.0f, 0.0f, 2.0f }, { 3.0f, 2.0f, 4.0f }, 0xff0000ffu);
+	list.AddSphere({ 0.0f, 1.0f, 0.0f }, 0.5f, 0xff00ff00u);
+	list.AddAxis({ 1.0f, 1.0f, 1.0f }, 0.25f, 0xffff0000u, true);
+	list.AddSphere({ 0.0f, 0.0f, 0.0f }, 0.0f, 0xffffffffu); // degenerate: dropped
+
+	EXPECT_FALSE(list.Empty());
+	EXPECT_EQ(list.VertexCount(), 0u);
+	EXPECT_EQ(list.ShapeInstanceCount(), 3u);
+	EXPECT_EQ(list.overlayShapeInstances[static_cast<std::size_t>(DebugShape::Axis)].size(), 1u);
+
+	const std::vector<mathUtils::Vec3> box = Expand(DebugShape::Box, Only(list, DebugShape::Box));
+	mathUtils::Vec3 bmin = box.front();
+	mathUtils::Vec3 bmax = box.front();
+	for (const mathUtils::Vec3& p : box)
+	{
+		bmin = mathUtils::MinVec3(bmin, p);
+		bmax = mathUtils::MaxVec3(bmax, p);
+	}
+	EXPECT_NEAR(bmin.x, -1.0f, 1e-5f);
+	EXPECT_NEAR(bmin.z, 2.0f, 1e-5f);
+	EXPECT_NEAR(bmax.x, 3.0f, 1e-5f);
+	EXPECT_NEAR(bmax.y, 2.0f, 1e-5f);
+
+	for (const mathUtils::Vec3& p : Expand(DebugShape::Sphere, Only(list, DebugShape::Sphere)))
+	{
+		EXPECT_NEAR(mathUtils::Length(p - mathUtils::Vec3(0.0f, 1.0f, 0.0f)), 0.5f, 1e-5f);
+	}
+
+	list.Clear();
+	EXPECT_TRUE(list.Empty());
+}
+
+TEST(DebugDraw, CapsuleSpansItsSegmentPlusRadius)
+{
+	const mathUtils::Vec3 a{ 1.0f, 0.0f, 0.0f };
+	const mathUtils::Vec3 b{ 1.0f, 0.0f, 4.0f };
+	const float radius = 0.5f;
+
+	DebugDrawList list;
+	list.AddCapsule(a, b, radius, 0xffffffffu);
+	ASSERT_EQ(list.ShapeInstanceCount(), 1u);
+
+	float minZ = 1e9f;
+	float maxZ = -1e9f;
+	for (const mathUtils::Vec3& p : Expand(DebugShape::Capsule, Only(list, DebugShape::Capsule)))
+	{
+		minZ = std::min(minZ, p.z);
+		maxZ = std::max(maxZ, p.z);
+
+		// Every vertex is `radius` away from the segment.
+		const float t = std::clamp(p.z, a.z, b.z);
+		EXPECT_NEAR(mathUtils::Length(p - mathUtils::Vec3(a.x, a.y, t)), radius, 1e-4f);
+	}
+	EXPECT_NEAR(minZ, a.z - radius, 1e-4f);
+	EXPECT_NEAR(maxZ, b.z + radius, 1e-4f);
+}
+
+TEST(DebugText, LayoutSkipsBlanksAndIsCachedByString)
+{
+	const std::vector<rendern::debugText::GlyphPlacement> glyphs = rendern::debugText::LayoutText("A B\nCD");
+	ASSERT_EQ(glyphs.size(), 4u);
+	EXPECT_EQ(glyphs[1].ch, 'B');
+	EXPECT_EQ(glyphs[1].column, 2u);
+	EXPECT_EQ(glyphs[3].column, 1u);
+	EXPECT_EQ(glyphs[3].line, 1u);
+
+	rendern::debugText::TextLayoutCache cache;
+	const auto* first = &cache.Get("FPS: 60");
+	cache.EndFrame();
+	EXPECT_EQ(&cache.Get("FPS: 60"), first);
+	EXPECT_EQ(cache.Get("other").size(), 5u);
+	EXPECT_EQ(cache.Misses(), 2u);
+	EXPECT_EQ(cache.Hits(), 1u);
+
+	// Unused entries age out.
+	for (int frame = 0; frame < 4; ++frame)
+	{
+		cache.Get("other");
+		cache.EndFrame(2);
+	}
+	EXPECT_EQ(cache.Size(), 1u);
+}
+
+TEST(DebugText, GlyphAtlasHoldsTheFontBitmaps)
+{
+	const std::vector<std::uint32_t> bits = rendern::debugText::BuildGlyphAtlasBits();
+	auto Texel = [&](std::uint32_t x, std::uint32_t y)
+		{
+			const std::uint32_t bit = y * rendern::debugText::kGlyphAtlasWidth + x;
+			return ((bits[bit / 32] >> (bit % 32)) & 1u) != 0;
+		};
+
+	const std::array<std::uint16_t, 4> rect = rendern::debugText::GlyphAtlasRect('T');
+	EXPECT_EQ(rect[2], 5u);
+	EXPECT_EQ(rect[3], 7u);
+	const rendern::debugText::Glyph5x7& glyph = rendern::debugText::GetGlyph('T');
+	for (std::uint32_t row = 0; row < 7; ++row)
+	{
+		for (std::uint32_t col = 0; col < 5; ++col)
+		{
+			EXPECT_EQ(Texel(rect[0] + col, rect[1] + row), (glyph.row[row] & (1u << (4 - col))) != 0);
+		}
+	}
+
+	// Characters outside the atlas fall back to '?'.
+	EXPECT_EQ(rendern::debugText::GlyphAtlasRect('\x01'), rendern::debugText::GlyphAtlasRect('?'));
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+import core;
+
+using rhi::DescriptorSlotAllocator;
+
+TEST(DescriptorSlotAllocator, KeepsReservedStaticAndPagedRangesApart)
+{
+	DescriptorSlotAllocator slots(3, 4, 64, 2);
+	EXPECT_EQ(slots.Capacity(), 3u + 4u + 128u);
+
+	for (std::uint32_t i = 0; i < 4; ++i)
+	{
+		const std::uint32_t slot = slots.AllocateStatic();
+		EXPECT_EQ(slot, 3u + i);
+		EXPECT_TRUE(slots.IsStatic(slot));
+	}
+	// The static range is full: further static requests spill into the paged range.
+	EXPECT_EQ(slots.AllocateStatic(), 7u);
+	EXPECT_FALSE(slots.IsStatic(7u));
+	EXPECT_EQ(slots.Allocate(), 8u);
+
+	const auto stats = slots.GetStats();
+	EXPECT_EQ(stats.staticUsed, 4u);
+	EXPECT_EQ(stats.committedPages, 1u);
+	EXPECT_EQ(stats.pagedUsed, 2u);
+}
+
+TEST(DescriptorSlotAllocator, CommitsPagesOnDemandWithoutMovingLiveSlots)
+{
+	DescriptorSlotAllocator slots(1, 0, 64, 3);
+
+	std::vector<std::uint32_t> live;
+	for (std::uint32_t i = 0; i < 64; ++i)
+	{
+		live.push_back(slots.Allocate());
+	}
+	EXPECT_EQ(slots.GetStats().committedPages, 1u);
+	EXPECT_FLOAT_EQ(slots.GetStats().occupancy, 1.0f);
+
+	// Growing commits the next page above the live slots.
+	EXPECT_EQ(slots.Allocate(), 65u);
+	EXPECT_EQ(slots.GetStats().committedPages, 2u);
+	for (std::uint32_t i = 0; i < live.size(); ++i)
+	{
+		EXPECT_EQ(live[i], 1u + i);
+	}
+
+	// Exhaustion is reported rather than wrapping.
+	while (slots.Allocate() != DescriptorSlotAllocator::kInvalidSlot)
+	{
+	}
+	EXPECT_EQ(slots.GetStats().committedPages, 3u);
+	EXPECT_EQ(slots.GetStats().pagedUsed, 192u);
+}
+
+TEST(DescriptorSlotAllocator, DefersFreesUntilTheirFrameRetires)
+{
+	DescriptorSlotAllocator slots(1, 0, 64, 1);
+	const std::uint32_t a = slots.Allocate();
+	const std::uint32_t b = slots.Allocate();
+	EXPECT_EQ(a, 1u);
+	EXPECT_EQ(b, 2u);
+
+	slots.Free(a, 10);
+	EXPECT_EQ(slots.GetStats().pendingFrees, 1u);
+	// Still referenced by frame 10: the next allocation must not reuse it.
+	EXPECT_EQ(slots.Allocate(), 3u);
+
+	std::vector<std::uint32_t> reclaimed;
+	slots.Reclaim(9, [&](std::uint32_t slot) { reclaimed.push_back(slot); });
+	EXPECT_TRUE(reclaimed.empty());
+	slots.Reclaim(10, [&](std::uint32_t slot) { reclaimed.push_back(slot); });
+	ASSERT_EQ(reclaimed.size(), 1u);
+	EXPECT_EQ(reclaimed[0], a);
+	EXPECT_EQ(slots.GetStats().pendingFrees, 0u);
+
+	// Lowest free slot first.
+	EXPECT_EQ(slots.Allocate(), a);
+
+	// Frees at or before the completed value (or with 0) are immediate.
+	slots.Free(b, 0);
+	EXPECT_EQ(slots.Allocate(), b);
+}
+
+TEST(DescriptorSlotAllocator, ReportsFragmentationOfFreeSpace)
+{
+	DescriptorSlotAllocator slots(0, 0, 64, 1);
+	std::vector<std::uint32_t> live;
+	for (std::uint32_t i = 0; i < 64; ++i)
+	{
+		live.push_back(slots.Allocate());
+	}
+	EXPECT_FLOAT_EQ(slots.GetStats().fragmentation, 0.0f);
+
+	// Every other slot free: the largest run is one slot out of 32 free ones.
+	for (std::uint32_t i = 0; i < 64; i += 2)
+	{
+		slots.Free(live[i], 0);
+	}
+	const auto stats = slots.GetStats();
+	EXPECT_EQ(stats.pagedUsed, 32u);
+	EXPECT_FLOAT_EQ(stats.occupancy, 0.5f);
+	EXPECT_FLOAT_EQ(stats.fragmentation, 1.0f - 1.0f / 32.0f);
+}
+
+TEST(DescriptorSlotAllocator, IgnoresRepeatedAndStrayFrees)
+{
+	DescriptorSlotAllocator slots(1, 4, 64, 1);
+	const std::uint32_t a = slots.AllocateStatic();
+	const std::uint32_t b = slots.AllocateStatic();
+
+	// A second free of a static slot must not hand it out twice.
+	slots.Free(a, 0);
+	slots.Free(a, 0);
+	EXPECT_EQ(slots.GetStats().staticUsed, 1u);
+	const std::uint32_t first = slots.AllocateStatic();
+	const std::uint32_t second = slots.AllocateStatic();
+	EXPECT_EQ(first, a);
+	EXPECT_NE(second, a);
+	EXPECT_EQ(slots.GetStats().staticUsed, 3u);
+
+	// Deferred frees queue a slot once; never-allocated slots are ignored.
+	slots.Free(b, 5);
+	slots.Free(b, 6);
+	slots.Free(4u, 5);
+	slots.Free(20u, 5);
+	EXPECT_EQ(slots.GetStats().pendingFrees, 1u);
+
+	std::vector<std::uint32_t> reclaimed;
+	slots.Reclaim(6, [&](std::uint32_t slot) { reclaimed.push_back(slot); });
+	EXPECT_EQ(reclaimed, (std::vector<std::uint32_t>{ b }));
+	EXPECT_EQ(slots.GetStats().staticUsed, 2u);
+}
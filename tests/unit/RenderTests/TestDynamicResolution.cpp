@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+import core;
+
+using rendern::DynamicResolutionController;
+using rendern::DynamicResolutionParams;
+
+namespace
+{
+	constexpr DynamicResolutionParams kParams{ .targetGpuMs = 10.0f, .minScale = 0.5f, .maxScale = 1.0f };
+
+	// Simulated GPU cost: fixed part plus pixel work proportional to scale^2.
+	float SimulatedGpuMs(float scale, float fullResPixelMs, float fixedMs = 1.0f)
+	{
+		return fixedMs + fullResPixelMs * scale * scale;
+	}
+}
+
+TEST(DynamicResolution, StaysAtFullScaleUnderBudget)
+{
+	DynamicResolutionController controller;
+	for (int frame = 0; frame < 100; ++frame)
+	{
+		EXPECT_FLOAT_EQ(controller.Update(6.0f, kParams), 1.0f);
+	}
+}
+
+TEST(DynamicResolution, ConvergesBelowBudgetWhenOverloaded)
+{
+	DynamicResolutionController controller;
+	float scale = 1.0f;
+	for (int frame = 0; frame < 300; ++frame)
+	{
+		scale = controller.Update(SimulatedGpuMs(scale, 14.0f), kParams);
+	}
+	EXPECT_LT(scale, 1.0f);
+	EXPECT_GE(scale, kParams.minScale);
+	EXPECT_LE(SimulatedGpuMs(scale, 14.0f), kParams.targetGpuMs);
+	// Not more than a couple of steps below what the budget allows.
+	EXPECT_GT(SimulatedGpuMs(scale + 3.0f * DynamicResolutionController::kScaleStep, 14.0f), kParams.targetGpuMs);
+}
+
+TEST(DynamicResolution, SettlesWithoutOscillating)
+{
+	DynamicResolutionController controller;
+	float scale = 1.0f;
+	for (int frame = 0; frame < 200; ++frame)
+	{
+		scale = controller.Update(SimulatedGpuMs(scale, 14.0f), kParams);
+	}
+	std::uint32_t changes = 0;
+	for (int frame = 0; frame < 200; ++frame)
+	{
+		const float next = controller.Update(SimulatedGpuMs(scale, 14.0f), kParams);
+		changes += (next != scale) ? 1u : 0u;
+		scale = next;
+	}
+	EXPECT_EQ(changes, 0u);
+}
+
+TEST(DynamicResolution, RecoversWhenLoadDrops)
+{
+	DynamicResolutionController controller;
+	float scale = 1.0f;
+	for (int frame = 0; frame < 200; ++frame)
+	{
+		scale = controller.Update(SimulatedGpuMs(scale, 30.0f), kParams);
+	}
+	EXPECT_FLOAT_EQ(scale, kParams.minScale);
+
+	for (int frame = 0; frame < 300; ++frame)
+	{
+		scale = controller.Update(SimulatedGpuMs(scale, 5.0f), kParams);
+	}
+	EXPECT_FLOAT_EQ(scale, 1.0f);
+}
+
+TEST(DynamicResolution, LargeOverrunDropsDuringCooldown)
+{
+	DynamicResolutionController controller;
+	// One step down starts the cooldown.
+	const float afterFirst = controller.Update(11.0f, kParams);
+	ASSERT_LT(afterFirst, 1.0f);
+
+	// A spike far over budget does not wait for the cooldown.
+	const float afterSpike = controller.Update(25.0f, kParams);
+	EXPECT_LT(afterSpike, afterFirst);
+}
+
+TEST(DynamicResolution, NoTimingKeepsScaleAndHonorsLimits)
+{
+	DynamicResolutionController controller;
+	controller.Reset(0.7f);
+	EXPECT_FLOAT_EQ(controller.Update(0.0f, kParams), 0.7f);
+
+	const DynamicResolutionParams narrow{ .targetGpuMs = 10.0f, .minScale = 0.8f, .maxScale = 0.9f };
+	EXPECT_FLOAT_EQ(controller.Update(0.0f, narrow), 0.8f);
+}
+
+TEST(DynamicResolution, ScaledExtentRoundsAndNeverReachesZero)
+{
+	const rhi::Extent2D full{ 1920u, 1080u };
+	const rhi::Extent2D half = rendern::ScaledExtent(full, 0.5f);
+	EXPECT_EQ(half.width, 960u);
+	EXPECT_EQ(half.height, 540u);
+
+	const rhi::Extent2D same = rendern::ScaledExtent(full, 1.0f);
+	EXPECT_EQ(same.width, full.width);
+	EXPECT_EQ(same.height, full.height);
+
+	const rhi::Extent2D tiny = rendern::ScaledExtent(rhi::Extent2D{ 1u, 1u }, 0.25f);
+	EXPECT_EQ(tiny.width, 1u);
+	EXPECT_EQ(tiny.height, 1u);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+import core;
+
+using rendern::GeometryPool;
+using rendern::MeshRHI;
+using rendern::VertexDesc;
+
+namespace
+{
+	std::vector<VertexDesc> Vertices(std::size_t count)
+	{
+		return std::vector<VertexDesc>(count, VertexDesc{});
+	}
+
+	std::vector<std::uint32_t> Indices(std::size_t count)
+	{
+		return std::vector<std::uint32_t>(count, 0u);
+	}
+}
+
+TEST(GeometryPool, MeshesAreRangesOfSharedBuffersAndLayouts)
+{
+	const auto device = rhi::CreateNullDevice();
+	GeometryPool pool(*device, 1024 * rendern::strideVDBytes, 4096 * sizeof(std::uint32_t));
+
+	const auto v0 = Vertices(24);
+	const auto i0 = Indices(36);
+	const auto v1 = Vertices(100);
+	const auto i1 = Indices(300);
+	MeshRHI a = pool.Upload(v0, i0);
+	MeshRHI b = pool.Upload(v1, i1);
+
+	ASSERT_TRUE(a.vertexBuffer);
+	ASSERT_TRUE(b.vertexBuffer);
+	EXPECT_EQ(a.vertexBuffer, b.vertexBuffer);
+	EXPECT_EQ(a.indexBuffer, b.indexBuffer);
+	EXPECT_EQ(a.layoutInstanced, b.layoutInstanced);
+	EXPECT_EQ(a.vertexOffsetBytes, 0u);
+	EXPECT_EQ(a.indexCount, 36u);
+	EXPECT_EQ(b.indexCount, 300u);
+
+	// Disjoint vertex and index ranges.
+	EXPECT_TRUE(a.baseVertex + 24 <= b.baseVertex || b.baseVertex + 100 <= a.baseVertex);
+	EXPECT_TRUE(a.firstIndex + 36 <= b.firstIndex || b.firstIndex + 300 <= a.firstIndex);
+
+	const GeometryPool::Stats stats = pool.GetStats();
+	EXPECT_EQ(stats.meshes, 2u);
+	EXPECT_EQ(stats.vertexUsedBytes, 124u * rendern::strideVDBytes);
+	EXPECT_EQ(stats.indexUsedBytes, 336u * sizeof(std::uint32_t));
+
+	rendern::DestroyMesh(*device, a);
+	rendern::DestroyMesh(*device, b);
+	EXPECT_FALSE(a.vertexBuffer);
+	EXPECT_EQ(pool.GetStats().pendingFrees, 2u);
+	pool.EndFrame();
+	EXPECT_EQ(pool.GetStats().meshes, 0u);
+	EXPECT_EQ(pool.GetStats().indexUsedBytes, 0u);
+}
+
+TEST(GeometryPool, ReturnsAnEmptyMeshWhenFull)
+{
+	const auto device = rhi::CreateNullDevice();
+	GeometryPool pool(*device, 64 * rendern::strideVDBytes, 64 * sizeof(std::uint32_t));
+
+	const auto vertices = Vertices(48);
+	const auto indices = Indices(48);
+	MeshRHI first = pool.Upload(vertices, indices);
+	ASSERT_TRUE(first.vertexBuffer);
+
+	// Vertices would fit, indices do not: nothing stays allocated.
+	EXPECT_FALSE(pool.Upload(Vertices(8), indices).vertexBuffer);
+	EXPECT_EQ(pool.GetStats().meshes, 1u);
+
+	// A freed range is only reused once its frames retired.
+	rendern::DestroyMesh(*device, first);
+	EXPECT_FALSE(pool.Upload(vertices, indices).vertexBuffer);
+	pool.EndFrame();
+	EXPECT_TRUE(pool.Upload(vertices, indices).vertexBuffer);
+}
+
+TEST(GeometryPool, DepthOnlyPositionsShareTheBaseVertex)
+{
+	const auto device = rhi::CreateNullDevice();
+	GeometryPool pool(*device, 1024 * rendern::strideVDBytes, 4096 * sizeof(std::uint32_t));
+
+	MeshRHI a = pool.Upload(Vertices(24), Indices(36));
+	MeshRHI b = pool.Upload(Vertices(100), Indices(300));
+
+	ASSERT_TRUE(a.depthVertexBuffer);
+	EXPECT_EQ(a.depthVertexBuffer, pool.GetDepthVertexBuffer());
+	EXPECT_EQ(a.depthVertexBuffer, b.depthVertexBuffer);
+	EXPECT_EQ(a.layoutDepthInstanced, b.layoutDepthInstanced);
+	EXPECT_NE(a.layoutDepthInstanced, a.layoutInstanced);
+	EXPECT_EQ(a.depthVertexStrideBytes, rendern::strideVPBytes);
+	// Bound at offset 0: baseVertex indexes both streams.
+	EXPECT_EQ(a.depthVertexOffsetBytes, 0u);
+	EXPECT_EQ(b.depthVertexOffsetBytes, 0u);
+
+	rendern::DestroyMesh(*device, a);
+	rendern::DestroyMesh(*device, b);
+	EXPECT_FALSE(a.depthVertexBuffer);
+}
+
+TEST(DepthVertexStream, UploadedMeshesGetAPositionOnlyStream)
+{
+	const auto device = rhi::CreateNullDevice();
+	const auto vertices = Vertices(8);
+	const auto indices = Indices(36);
+
+	MeshRHI full = rendern::UploadMesh(*device, std::span<const VertexDesc>(vertices), std::span<const std::uint32_t>(indices));
+	EXPECT_TRUE(full.depthVertexBuffer);
+	EXPECT_TRUE(full.layoutDepthInstanced);
+	EXPECT_EQ(full.depthVertexStrideBytes, rendern::strideVPBytes);
+
+	MeshRHI compact = rendern::UploadMeshCompact(*device, std::span<const VertexDesc>(vertices), std::span<const std::uint32_t>(indices),
+		rendern::VertexQuantization{});
+	EXPECT_TRUE(compact.depthVertexBuffer);
+	EXPECT_EQ(compact.depthVertexStrideBytes, rendern::strideVPCBytes);
+
+	rendern::DestroyMesh(*device, full);
+	rendern::DestroyMesh(*device, compact);
+	EXPECT_FALSE(full.depthVertexBuffer);
+	EXPECT_FALSE(compact.layoutDepthInstanced);
+}
+
+TEST(DepthVertexStream, PositionsKeepVertexOrderAndTheCompactMarker)
+{
+	std::vector<VertexDesc> vertices(3, VertexDesc{});
+	vertices[1].px = 1.0f;
+	vertices[2].py = 2.0f;
+	vertices[2].tw = 1.0f;
+	vertices[1].tw = -1.0f;
+
+	const auto positions = rendern::ExtractVertexPositions(std::span<const VertexDesc>(vertices));
+	ASSERT_EQ(positions.size(), 3u);
+	EXPECT_EQ(positions[1].px, 1.0f);
+	EXPECT_EQ(positions[2].py, 2.0f);
+
+	const rendern::VertexQuantization q = rendern::MakeVertexQuantization(
+		mathUtils::Vec3(0.0f, 0.0f, 0.0f), mathUtils::Vec3(2.0f, 2.0f, 2.0f));
+	const auto compact = rendern::EncodeVerticesCompact(vertices, q);
+	const auto compactPositions = rendern::ExtractVertexPositions(std::span<const rendern::VertexCompact>(compact));
+	ASSERT_EQ(compactPositions.size(), 3u);
+	for (std::size_t i = 0; i < compact.size(); ++i)
+	{
+		EXPECT_EQ(compactPositions[i].px, compact[i].px);
+		EXPECT_EQ(compactPositions[i].py, compact[i].py);
+		EXPECT_EQ(compactPositions[i].pz, compact[i].pz);
+		// w is the tangent sign the shaders' IsCompactVertex test reads.
+		EXPECT_EQ(compactPositions[i].pw, compact[i].pw);
+	}
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+import core;
+
+using renderer::PooledGPUMemoryAllocator;
+using renderer::TlsfRangeAllocator;
+
+namespace
+{
+	rhi::BufferDesc StaticVertexBuffer(std::size_t sizeInBytes)
+	{
+		rhi::BufferDesc desc{};
+		desc.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+		desc.usageFlag = rhi::BufferUsageFlag::Static;
+		desc.sizeInBytes = sizeInBytes;
+		return desc;
+	}
+}
+
+TEST(TlsfRangeAllocator, HandsOutAlignedDisjointRanges)
+{
+	TlsfRangeAllocator ranges(64 * 1024, 256);
+
+	const std::uint64_t a = ranges.Allocate(100);
+	const std::uint64_t b = ranges.Allocate(256);
+	const std::uint64_t c = ranges.Allocate(1000);
+	ASSERT_NE(a, TlsfRangeAllocator::kInvalidOffset);
+	ASSERT_NE(b, TlsfRangeAllocator::kInvalidOffset);
+	ASSERT_NE(c, TlsfRangeAllocator::kInvalidOffset);
+
+	EXPECT_EQ(a % 256, 0u);
+	EXPECT_EQ(b % 256, 0u);
+	EXPECT_EQ(c % 256, 0u);
+	EXPECT_TRUE(a + 256 <= b || b + 256 <= a);
+	EXPECT_TRUE(b + 256 <= c || c + 1024 <= b);
+	EXPECT_EQ(ranges.UsedBytes(), 256u + 256u + 1024u);
+	EXPECT_EQ(ranges.AllocationCount(), 3u);
+
+	// Too large for what is left.
+	EXPECT_EQ(ranges.Allocate(64 * 1024), TlsfRangeAllocator::kInvalidOffset);
+	EXPECT_FALSE(ranges.Free(a + 1));
+}
+
+TEST(TlsfRangeAllocator, FreedNeighboursMergeBackIntoOneRange)
+{
+	TlsfRangeAllocator ranges(16 * 1024, 256);
+
+	std::vector<std::uint64_t> offsets;
+	for (int i = 0; i < 64; ++i)
+	{
+		offsets.push_back(ranges.Allocate(256));
+	}
+	EXPECT_EQ(ranges.FreeBytes(), 0u);
+	EXPECT_EQ(ranges.Allocate(1), TlsfRangeAllocator::kInvalidOffset);
+
+	// Every other range: free space is plentiful but split into 256-byte holes.
+	for (std::size_t i = 0; i < offsets.size(); i += 2)
+	{
+		EXPECT_TRUE(ranges.Free(offsets[i]));
+	}
+	EXPECT_EQ(ranges.FreeBytes(), 8u * 1024u);
+	EXPECT_EQ(ranges.LargestFreeBytes(), 256u);
+	EXPECT_EQ(ranges.Allocate(512), TlsfRangeAllocator::kInvalidOffset);
+
+	for (std::size_t i = 1; i < offsets.size(); i += 2)
+	{
+		EXPECT_TRUE(ranges.Free(offsets[i]));
+	}
+	EXPECT_EQ(ranges.AllocationCount(), 0u);
+	EXPECT_EQ(ranges.LargestFreeBytes(), 16u * 1024u);
+	EXPECT_EQ(ranges.Allocate(16 * 1024), 0u);
+}
+
+TEST(PooledGPUMemoryAllocator, SubAllocatesSmallBuffersFromOneBlock)
+{
+	const auto device = rhi::CreateNullDevice();
+	PooledGPUMemoryAllocator allocator(*device, { .blockSizeBytes = 1 << 20, .dedicatedThresholdBytes = 256 * 1024 });
+
+	const renderer::BufferAllocation a = allocator.AllocateBuffer(StaticVertexBuffer(1000));
+	const renderer::BufferAllocation b = allocator.AllocateBuffer(StaticVertexBuffer(4000));
+	EXPECT_EQ(a.buffer, b.buffer);
+	EXPECT_NE(a.offsetBytes, b.offsetBytes);
+
+	// Index buffers use their own pool; big and structured buffers stay dedicated.
+	rhi::BufferDesc indexDesc = StaticVertexBuffer(600);
+	indexDesc.bindFlag = rhi::BufferBindFlag::IndexBuffer;
+	const renderer::BufferAllocation indices = allocator.AllocateBuffer(indexDesc);
+	EXPECT_NE(indices.buffer, a.buffer);
+
+	const renderer::BufferAllocation big = allocator.AllocateBuffer(StaticVertexBuffer(512 * 1024));
+	rhi::BufferDesc storageDesc = StaticVertexBuffer(1024);
+	storageDesc.bindFlag = rhi::BufferBindFlag::StorageBuffer;
+	storageDesc.structuredStrideBytes = 16;
+	const renderer::BufferAllocation storage = allocator.AllocateBuffer(storageDesc);
+	EXPECT_EQ(big.offsetBytes, 0u);
+	EXPECT_EQ(storage.offsetBytes, 0u);
+
+	const PooledGPUMemoryAllocator::Stats stats = allocator.GetStats();
+	EXPECT_EQ(stats.blocks, 2u);
+	EXPECT_EQ(stats.allocations, 3u);
+	EXPECT_EQ(stats.dedicatedBuffers, 2u);
+	EXPECT_EQ(stats.dedicatedBytes, 512u * 1024u + 1024u);
+
+	allocator.FreeBuffer(big);
+	allocator.FreeBuffer(storage);
+	EXPECT_EQ(allocator.GetStats().dedicatedBuffers, 0u);
+}
+
+TEST(PooledGPUMemoryAllocator, ReusesRangesOnlyAfterTheirFramesRetire)
+{
+	const auto device = rhi::CreateNullDevice();
+	PooledGPUMemoryAllocator allocator(*device, { .blockSizeBytes = 4096, .dedicatedThresholdBytes = 4096 });
+
+	const renderer::BufferAllocation a = allocator.AllocateBuffer(StaticVertexBuffer(4096));
+	allocator.FreeBuffer(a);
+	EXPECT_EQ(allocator.GetStats().pendingFrees, 1u);
+
+	// The range is still reserved for in-flight frames: this one needs a second block.
+	const renderer::BufferAllocation b = allocator.AllocateBuffer(StaticVertexBuffer(4096));
+	EXPECT_NE(b.buffer, a.buffer);
+	EXPECT_EQ(allocator.GetStats().blocks, 2u);
+
+	// Once retired, the now empty block is released (each pool keeps at least one).
+	allocator.EndFrame();
+	EXPECT_EQ(allocator.GetStats().pendingFrees, 0u);
+	EXPECT_EQ(allocator.GetStats().blocks, 1u);
+	EXPECT_EQ(allocator.GetStats().usedBytes, 4096u);
+}
+
+TEST(PooledGPUMemoryAllocator, DefragmentationEmptiesTheLeastUsedBlock)
+{
+	const auto device = rhi::CreateNullDevice();
+	PooledGPUMemoryAllocator allocator(*device, { .blockSizeBytes = 4096, .dedicatedThresholdBytes = 4096 });
+
+	std::vector<renderer::BufferAllocation> live;
+	for (int i = 0; i < 32; ++i)
+	{
+		live.push_back(allocator.AllocateBuffer(StaticVertexBuffer(256)));
+	}
+	ASSERT_EQ(allocator.GetStats().blocks, 2u);
+
+	// Leave 4 ranges in the first block and 12 in the second.
+	for (int i = 0; i < 32; ++i)
+	{
+		if ((i < 16 && i >= 4) || (i >= 16 && i < 20))
+		{
+			allocator.FreeBuffer(live[i]);
+		}
+	}
+	allocator.EndFrame();
+	EXPECT_EQ(allocator.GetStats().allocations, 16u);
+
+	const std::vector<PooledGPUMemoryAllocator::DefragmentationMove> moves = allocator.BeginDefragmentation(1 << 20);
+	ASSERT_EQ(moves.size(), 4u);
+	for (const PooledGPUMemoryAllocator::DefragmentationMove& move : moves)
+	{
+		EXPECT_EQ(move.from.buffer, live[0].buffer);
+		EXPECT_EQ(move.to.buffer, live[16].buffer);
+		EXPECT_EQ(move.to.sizeInBytes, move.from.sizeInBytes);
+	}
+	// A zero byte budget plans nothing.
+	const std::vector<PooledGPUMemoryAllocator::DefragmentationMove> none = allocator.BeginDefragmentation(0);
+	EXPECT_TRUE(none.empty());
+
+	allocator.EndDefragmentation(moves);
+	allocator.EndFrame();
+
+	const PooledGPUMemoryAllocator::Stats stats = allocator.GetStats();
+	EXPECT_EQ(stats.blocks, 1u);
+	EXPECT_EQ(stats.allocations, 16u);
+	EXPECT_FLOAT_EQ(stats.fragmentation, 0.0f);
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+import core;
+
+using rendern::LightClusterBounds;
+using rendern::LightClusterBuilder;
+using rendern::LightClusterView;
+
+namespace
+{
+	constexpr float kInf = std::numeric_limits<float>::infinity();
+
+	LightClusterView MakeView()
+	{
+		LightClusterView view{};
+		view.position = { 0.0f, 0.0f, 0.0f };
+		view.forward = { 0.0f, 0.0f, -1.0f };
+		view.up = { 0.0f, 1.0f, 0.0f };
+		view.fovYRad = mathUtils::DegToRad(90.0f);
+		view.aspect = 16.0f / 9.0f;
+		view.nearZ = 0.1f;
+		view.farZ = 100.0f;
+		view.viewportWidth = 1600;
+		view.viewportHeight = 900;
+		return view;
+	}
+
+	float HeaderFloat(const LightClusterBuilder& clusters, std::uint32_t word)
+	{
+		return std::bit_cast<float>(clusters.Words()[word]);
+	}
+
+	// The cluster lookup the lighting shaders do for a view-space point in front of the camera.
+	bool ClusterOf(const LightClusterBuilder& clusters, const LightClusterView& view, float x, float y, float viewZ,
+		std::uint32_t& cx, std::uint32_t& cy, std::uint32_t& cz)
+	{
+		const float tanY = std::tan(view.fovYRad * 0.5f);
+		const float ndcX = x / (viewZ * tanY * view.aspect);
+		const float ndcY = y / (viewZ * tanY);
+		if (std::abs(ndcX) >= 1.0f || std::abs(ndcY) >= 1.0f || viewZ <= view.nearZ || viewZ >= view.farZ)
+		{
+			return false;
+		}
+		const auto grid = clusters.Grid();
+		const float pixelX = (ndcX * 0.5f + 0.5f) * static_cast<float>(view.viewportWidth);
+		const float pixelY = (0.5f - ndcY * 0.5f) * static_cast<float>(view.viewportHeight);
+		cx = std::min(static_cast<std::uint32_t>(pixelX * HeaderFloat(clusters, LightClusterBuilder::kHeaderTilesPerPixelX)), grid.x - 1);
+		cy = std::min(static_cast<std::uint32_t>(pixelY * HeaderFloat(clusters, LightClusterBuilder::kHeaderTilesPerPixelY)), grid.y - 1);
+		const float slice = std::log(viewZ) * HeaderFloat(clusters, LightClusterBuilder::kHeaderSliceScale)
+			+ HeaderFloat(clusters, LightClusterBuilder::kHeaderSliceBias);
+		cz = static_cast<std::uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(grid.z - 1)));
+		return true;
+	}
+
+	std::vector<LightClusterBounds> MakeLights(std::uint32_t count)
+	{
+		std::uint32_t state = 12345u;
+		auto next = [&]()
+			{
+				state = state * 1664525u + 1013904223u;
+				return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+			};
+
+		std::vector<LightClusterBounds> lights;
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			LightClusterBounds light{};
+			light.center = { next() * 60.0f - 30.0f, next() * 30.0f - 15.0f, -next() * 80.0f + 5.0f };
+			light.radius = 0.5f + next() * 6.0f;
+			lights.push_back(light);
+		}
+		return lights;
+	}
+}
+
+TEST(LightClusters, DirectionalLightsGoToTheGlobalList)
+{
+	LightClusterBuilder clusters;
+	const std::vector<LightClusterBounds> lights = {
+		{ { 0.0f, 0.0f, 0.0f }, kInf },
+		{ { 0.0f, 0.0f, -10.0f }, 1.0f },
+		{ { 0.0f, 0.0f, 0.0f }, kInf },
+	};
+	clusters.Build(MakeView(), lights);
+
+	EXPECT_EQ(clusters.Words()[LightClusterBuilder::kHeaderEnabled], 1u);
+	const auto global = clusters.GlobalLights();
+	ASSERT_EQ(global.size(), 2u);
+	EXPECT_EQ(global[0], 0u);
+	EXPECT_EQ(global[1], 2u);
+
+	// 10 units away is slice 24 * log(10 / 0.1) / log(100 / 0.1) = 16, in the centre row.
+	const auto centre = clusters.ClusterLights(8, 4, 16);
+	ASSERT_EQ(centre.size(), 1u);
+	EXPECT_EQ(centre[0], 1u);
+	EXPECT_TRUE(clusters.ClusterLights(0, 0, 16).empty());
+	EXPECT_TRUE(clusters.ClusterLights(8, 4, 0).empty());
+	EXPECT_EQ(clusters.GetStats().globalLights, 2u);
+	EXPECT_FALSE(clusters.GetStats().overflowed);
+}
+
+TEST(LightClusters, SkipsLightsOutsideTheFrustum)
+{
+	LightClusterBuilder clusters;
+	const std::vector<LightClusterBounds> lights = {
+		{ { 0.0f, 0.0f, 10.0f }, 1.0f },    // behind the camera
+		{ { 0.0f, 0.0f, -150.0f }, 10.0f }, // past far
+		{ { 200.0f, 0.0f, -10.0f }, 1.0f }, // far to the right
+	};
+	clusters.Build(MakeView(), lights);
+
+	EXPECT_EQ(clusters.GetStats().indexCount, 0u);
+	EXPECT_TRUE(clusters.GlobalLights().empty());
+}
+
+TEST(LightClusters, EveryPointInsideALightFindsItInItsCluster)
+{
+	const LightClusterView view = MakeView();
+	const std::vector<LightClusterBounds> lights = MakeLights(300);
+	LightClusterBuilder clusters;
+	clusters.Build(view, lights);
+
+	std::uint32_t checked = 0;
+	for (std::uint32_t lightIndex = 0; lightIndex < lights.size(); ++lightIndex)
+	{
+		const LightClusterBounds& light = lights[lightIndex];
+		for (int dx = -2; dx <= 2; ++dx)
+		{
+			for (int dy = -2; dy <= 2; ++dy)
+			{
+				for (int dz = -2; dz <= 2; ++dz)
+				{
+					if (dx * dx + dy * dy + dz * dz > 4)
+					{
+						continue;
+					}
+					const float scale = light.radius * 0.49f;
+					const float x = light.center.x + dx * scale;
+					const float y = light.center.y + dy * scale;
+					const float viewZ = -(light.center.z + dz * scale);
+
+					std::uint32_t cx = 0, cy = 0, cz = 0;
+					if (!ClusterOf(clusters, view, x, y, viewZ, cx, cy, cz))
+					{
+						continue;
+					}
+					const auto list = clusters.ClusterLights(cx, cy, cz);
+					EXPECT_TRUE(std::find(list.begin(), list.end(), lightIndex) != list.end())
+						<< "light " << lightIndex << " missing from cluster " << cx << "," << cy << "," << cz;
+					++checked;
+				}
+			}
+		}
+	}
+	EXPECT_GT(checked, 1000u);
+	EXPECT_GT(clusters.GetStats().maxClusterLights, 0u);
+}
+
+TEST(LightClusters, ParallelBuildMatchesSerialAndKeepsLightOrder)
+{
+	const LightClusterView view = MakeView();
+	const std::vector<LightClusterBounds> lights = MakeLights(500);
+
+	LightClusterBuilder serial;
+	serial.Build(view, lights);
+
+	jobs::Scheduler scheduler(4);
+	LightClusterBuilder parallel;
+	parallel.Build(view, lights, &scheduler);
+
+	ASSERT_EQ(serial.Words().size(), parallel.Words().size());
+	EXPECT_TRUE(std::equal(serial.Words().begin(), serial.Words().end(), parallel.Words().begin()));
+
+	const auto grid = serial.Grid();
+	for (std::uint32_t z = 0; z < grid.z; ++z)
+	{
+		for (std::uint32_t y = 0; y < grid.y; ++y)
+		{
+			for (std::uint32_t x = 0; x < grid.x; ++x)
+			{
+				const auto list = serial.ClusterLights(x, y, z);
+				EXPECT_TRUE(std::is_sorted(list.begin(), list.end()));
+			}
+		}
+	}
+}
+
+TEST(LightClusters, CutsListsToTheIndexBudget)
+{
+	LightClusterBuilder clusters({}, 8);
+	clusters.Build(MakeView(), MakeLights(100));
+
+	EXPECT_TRUE(clusters.GetStats().overflowed);
+	EXPECT_EQ(clusters.GetStats().indexCount, 8u);
+	EXPECT_LE(clusters.Words().size(), LightClusterBuilder::BufferWords(clusters.Grid(), 8));
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+import core;
+
+using rendern::MeshCPU;
+using rendern::MeshLod;
+using rendern::VertexDesc;
+
+namespace
+{
+	VertexDesc Vertex(float x, float y, float z, float nx, float ny, float nz)
+	{
+		return VertexDesc{ x, y, z, nx, ny, nz, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+	}
+
+	// Unit UV sphere, outward winding (counter-clockwise seen from outside).
+	MeshCPU MakeSphere(std::uint32_t rings, std::uint32_t segments)
+	{
+		MeshCPU cpu{};
+		for (std::uint32_t r = 0; r <= rings; ++r)
+		{
+			const float theta = std::numbers::pi_v<float> * static_cast<float>(r) / static_cast<float>(rings);
+			for (std::uint32_t s = 0; s <= segments; ++s)
+			{
+				// The seam column repeats the first one's positions (a UV seam).
+				const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s % segments) / static_cast<float>(segments);
+				const float x = std::sin(theta) * std::cos(phi);
+				const float y = std::cos(theta);
+				const float z = std::sin(theta) * std::sin(phi);
+				cpu.vertices.push_back(Vertex(x, y, z, x, y, z));
+			}
+		}
+		for (std::uint32_t r = 0; r < rings; ++r)
+		{
+			for (std::uint32_t s = 0; s < segments; ++s)
+			{
+				const std::uint32_t a = r * (segments + 1) + s;
+				const std::uint32_t b = a + segments + 1;
+				if (r != 0)
+				{
+					cpu.indices.insert(cpu.indices.end(), { a, a + 1, b });
+				}
+				if (r + 1 != rings)
+				{
+					cpu.indices.insert(cpu.indices.end(), { a + 1, b + 1, b });
+				}
+			}
+		}
+		return cpu;
+	}
+
+	mathUtils::Vec3 Position(const VertexDesc& v)
+	{
+		return mathUtils::Vec3(v.px, v.py, v.pz);
+	}
+}
+
+TEST(MeshLod, GeneratesSmallerLevelsOverTheSameVertices)
+{
+	MeshCPU cpu = MakeSphere(32, 64);
+	const std::size_t vertexCount = cpu.vertices.size();
+	const std::size_t fullIndexCount = cpu.indices.size();
+
+	rendern::GenerateMeshLods(cpu);
+	ASSERT_GE(cpu.lods.size(), 3u);
+	ASSERT_LE(cpu.lods.size(), rendern::kMaxMeshLods);
+	EXPECT_EQ(cpu.vertices.size(), vertexCount);
+
+	EXPECT_EQ(cpu.lods[0].firstIndex, 0u);
+	EXPECT_EQ(cpu.lods[0].indexCount, fullIndexCount);
+	std::uint32_t expectedFirst = 0;
+	for (std::size_t lod = 0; lod < cpu.lods.size(); ++lod)
+	{
+		const MeshLod& range = cpu.lods[lod];
+		EXPECT_EQ(range.firstIndex, expectedFirst);
+		EXPECT_EQ(range.indexCount % 3u, 0u);
+		expectedFirst += range.indexCount;
+		if (lod != 0)
+		{
+			// Roughly halves every level.
+			EXPECT_LT(range.indexCount, cpu.lods[lod - 1].indexCount * 3u / 4u);
+		}
+
+		for (std::uint32_t i = range.firstIndex; i < range.firstIndex + range.indexCount; i += 3)
+		{
+			ASSERT_LT(cpu.indices[i], vertexCount);
+			ASSERT_LT(cpu.indices[i + 1], vertexCount);
+			ASSERT_LT(cpu.indices[i + 2], vertexCount);
+
+			// Still a closed convex shell facing outwards.
+			const mathUtils::Vec3 p0 = Position(cpu.vertices[cpu.indices[i]]);
+			const mathUtils::Vec3 p1 = Position(cpu.vertices[cpu.indices[i + 1]]);
+			const mathUtils::Vec3 p2 = Position(cpu.vertices[cpu.indices[i + 2]]);
+			const mathUtils::Vec3 normal = mathUtils::Cross(p1 - p0, p2 - p0);
+			EXPECT_GT(mathUtils::Dot(normal, p0 + p1 + p2), 0.0f);
+		}
+	}
+	EXPECT_EQ(expectedFirst, cpu.indices.size());
+}
+
+TEST(MeshLod, SmallMeshesKeepASingleLevel)
+{
+	MeshCPU cpu = MakeSphere(4, 8);
+	const std::vector<std::uint32_t> indices = cpu.indices;
+
+	rendern::GenerateMeshLods(cpu);
+	EXPECT_TRUE(cpu.lods.empty());
+	EXPECT_EQ(cpu.indices, indices);
+}
+
+TEST(MeshLod, FlatGridCollapsesButKeepsItsOutline)
+{
+	// 16x16 quads on z = 0: the interior simplifies for free, the open border is expensive.
+	MeshCPU cpu{};
+	constexpr std::uint32_t kSide = 17;
+	for (std::uint32_t y = 0; y < kSide; ++y)
+	{
+		for (std::uint32_t x = 0; x < kSide; ++x)
+		{
+			cpu.vertices.push_back(Vertex(static_cast<float>(x), static_cast<float>(y), 0.0f, 0.0f, 0.0f, 1.0f));
+		}
+	}
+	for (std::uint32_t y = 0; y + 1 < kSide; ++y)
+	{
+		for (std::uint32_t x = 0; x + 1 < kSide; ++x)
+		{
+			const std::uint32_t a = y * kSide + x;
+			cpu.indices.insert(cpu.indices.end(), { a, a + 1, a + kSide + 1, a, a + kSide + 1, a + kSide });
+		}
+	}
+
+	const std::vector<std::uint32_t> simplified = rendern::SimplifyMeshIndices(cpu.vertices, cpu.indices, 60, 0.01f);
+	EXPECT_LE(simplified.size(), 120u);
+
+	float area = 0.0f;
+	for (std::size_t i = 0; i < simplified.size(); i += 3)
+	{
+		const mathUtils::Vec3 p0 = Position(cpu.vertices[simplified[i]]);
+		const mathUtils::Vec3 normal = mathUtils::Cross(Position(cpu.vertices[simplified[i + 1]]) - p0, Position(cpu.vertices[simplified[i + 2]]) - p0);
+		EXPECT_GT(normal.z, 0.0f);
+		area += 0.5f * normal.z;
+	}
+	EXPECT_NEAR(area, 256.0f, 1e-3f);
+}
+
+TEST(MeshLod, SelectsLevelsByScreenSizeWithBias)
+{
+	EXPECT_EQ(rendern::SelectMeshLod(0.5f, 0.3f, 4, 0), 0u);
+	EXPECT_EQ(rendern::SelectMeshLod(0.2f, 0.3f, 4, 0), 1u);
+	EXPECT_EQ(rendern::SelectMeshLod(0.1f, 0.3f, 4, 0), 2u);
+	EXPECT_EQ(rendern::SelectMeshLod(0.01f, 0.3f, 4, 0), 3u);
+	EXPECT_EQ(rendern::SelectMeshLod(0.01f, 0.3f, 2, 0), 1u);
+	EXPECT_EQ(rendern::SelectMeshLod(0.01f, 0.3f, 1, 0), 0u);
+
+	// Shadow-style bias: one level coarser, clamped to the coarsest.
+	EXPECT_EQ(rendern::SelectMeshLod(0.5f, 0.3f, 4, 1), 1u);
+	EXPECT_EQ(rendern::SelectMeshLod(0.01f, 0.3f, 4, 1), 3u);
+	EXPECT_EQ(rendern::SelectMeshLod(0.2f, 0.3f, 4, -2), 0u);
+
+	// Inside the sphere it fills the view; farther away it shrinks with distance.
+	const mathUtils::Vec3 origin(0.0f, 0.0f, 0.0f);
+	EXPECT_EQ(rendern::MeshLodScreenSize(origin, 1.0f, mathUtils::Vec3(0.5f, 0.0f, 0.0f), 1.0f), 1.0f);
+	const float near = rendern::MeshLodScreenSize(origin, 1.0f, mathUtils::Vec3(10.0f, 0.0f, 0.0f), 1.0f);
+	const float far = rendern::MeshLodScreenSize(origin, 1.0f, mathUtils::Vec3(20.0f, 0.0f, 0.0f), 1.0f);
+	EXPECT_NEAR(near, 2.0f * far, 1e-5f);
+}
+
+TEST(MeshLod, MeshResourceExposesEachLevelAsAView)
+{
+	rendern::MeshResource resource{};
+	rendern::MeshRHI gpu{};
+	gpu.firstIndex = 300;
+	gpu.indexCount = 180;
+	const std::vector<MeshLod> lods{ { 0, 120 }, { 120, 45 }, { 165, 15 } };
+	resource.ReplaceResource(std::move(gpu), lods);
+
+	ASSERT_EQ(resource.GetLodCount(), 3u);
+	EXPECT_EQ(resource.GetResource().indexCount, 120u);
+	EXPECT_EQ(resource.GetLodResource(1).firstIndex, 420u);
+	EXPECT_EQ(resource.GetLodResource(1).indexCount, 45u);
+	EXPECT_EQ(&resource.GetLodResource(7), &resource.GetLodResource(2));
+
+	// The previous resource comes back whole, with all its levels' indices.
+	const rendern::MeshRHI old = resource.ReplaceResource(rendern::MeshRHI{});
+	EXPECT_EQ(old.indexCount, 180u);
+	EXPECT_EQ(resource.GetLodCount(), 1u);
+	EXPECT_EQ(resource.GetLodResource(2).indexCount, 0u);
+
+	// A table that does not fit the index buffer is ignored.
+	rendern::MeshRHI small{};
+	small.indexCount = 30;
+	resource.ReplaceResource(std::move(small), lods);
+	EXPECT_EQ(resource.GetLodCount(), 1u);
+	EXPECT_EQ(resource.GetResource().indexCount, 30u);
+}
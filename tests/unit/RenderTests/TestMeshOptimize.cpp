@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <vector>
+
+import core;
+
+using rendern::MeshCPU;
+using rendern::MeshLod;
+using rendern::VertexCompact;
+using rendern::VertexDesc;
+
+namespace
+{
+	// side x side quads on z = 0, triangles shuffled (source order of a badly exported mesh).
+	MeshCPU MakeShuffledGrid(std::uint32_t side)
+	{
+		MeshCPU cpu{};
+		for (std::uint32_t y = 0; y <= side; ++y)
+		{
+			for (std::uint32_t x = 0; x <= side; ++x)
+			{
+				cpu.vertices.push_back(VertexDesc{ static_cast<float>(x), static_cast<float>(y), 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f });
+			}
+		}
+		std::vector<std::array<std::uint32_t, 3>> triangles;
+		for (std::uint32_t y = 0; y < side; ++y)
+		{
+			for (std::uint32_t x = 0; x < side; ++x)
+			{
+				const std::uint32_t a = y * (side + 1) + x;
+				triangles.push_back({ a, a + 1, a + side + 2 });
+				triangles.push_back({ a, a + side + 2, a + side + 1 });
+			}
+		}
+		std::mt19937 rng(7u);
+		std::shuffle(triangles.begin(), triangles.end(), rng);
+		for (const auto& t : triangles)
+		{
+			cpu.indices.insert(cpu.indices.end(), t.begin(), t.end());
+		}
+		return cpu;
+	}
+
+	// Triangles as position triples, rotated to a canonical first corner (winding kept) and sorted.
+	std::vector<std::array<float, 9>> TriangleSet(const MeshCPU& cpu, std::uint32_t first, std::uint32_t count)
+	{
+		std::vector<std::array<float, 9>> out;
+		for (std::uint32_t i = first; i < first + count; i += 3)
+		{
+			std::array<std::array<float, 3>, 3> corners{};
+			for (std::uint32_t c = 0; c < 3; ++c)
+			{
+				const VertexDesc& v = cpu.vertices[cpu.indices[i + c]];
+				corners[c] = { v.px, v.py, v.pz };
+			}
+			std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+			out.push_back({ corners[0][0], corners[0][1], corners[0][2], corners[1][0], corners[1][1], corners[1][2], corners[2][0], corners[2][1], corners[2][2] });
+		}
+		std::sort(out.begin(), out.end());
+		return out;
+	}
+}
+
+TEST(MeshOptimize, VertexCacheOrderKeepsTrianglesAndCutsMisses)
+{
+	MeshCPU cpu = MakeShuffledGrid(32);
+	const float before = rendern::AnalyzeVertexCache(cpu.indices, cpu.vertices.size());
+
+	const std::vector<std::uint32_t> reordered = rendern::OptimizeVertexCache(cpu.indices, cpu.vertices.size());
+	ASSERT_EQ(reordered.size(), cpu.indices.size());
+	const float after = rendern::AnalyzeVertexCache(reordered, cpu.vertices.size());
+	EXPECT_GT(before, 1.5f);
+	EXPECT_LT(after, 0.8f);
+
+	const auto expected = TriangleSet(cpu, 0, static_cast<std::uint32_t>(cpu.indices.size()));
+	cpu.indices = reordered;
+	EXPECT_EQ(TriangleSet(cpu, 0, static_cast<std::uint32_t>(cpu.indices.size())), expected);
+}
+
+TEST(MeshOptimize, OverdrawOrderStaysCloseToTheCacheOrder)
+{
+	MeshCPU cpu{};
+	// Unit sphere, outward winding.
+	constexpr std::uint32_t kRings = 48;
+	constexpr std::uint32_t kSegments = 96;
+	for (std::uint32_t r = 0; r <= kRings; ++r)
+	{
+		const float theta = std::numbers::pi_v<float> * static_cast<float>(r) / static_cast<float>(kRings);
+		for (std::uint32_t s = 0; s <= kSegments; ++s)
+		{
+			const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s) / static_cast<float>(kSegments);
+			const float x = std::sin(theta) * std::cos(phi);
+			const float y = std::cos(theta);
+			const float z = std::sin(theta) * std::sin(phi);
+			cpu.vertices.push_back(VertexDesc{ x, y, z, x, y, z, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f });
+		}
+	}
+	for (std::uint32_t r = 0; r < kRings; ++r)
+	{
+		for (std::uint32_t s = 0; s < kSegments; ++s)
+		{
+			const std::uint32_t a = r * (kSegments + 1) + s;
+			const std::uint32_t b = a + kSegments + 1;
+			cpu.indices.insert(cpu.indices.end(), { a, a + 1, b, a + 1, b + 1, b });
+		}
+	}
+
+	const std::vector<std::uint32_t> cacheOrder = rendern::OptimizeVertexCache(cpu.indices, cpu.vertices.size());
+	const std::vector<std::uint32_t> overdrawOrder = rendern::OptimizeOverdraw(cacheOrder, cpu.vertices);
+	ASSERT_EQ(overdrawOrder.size(), cacheOrder.size());
+	const float cacheAcmr = rendern::AnalyzeVertexCache(cacheOrder, cpu.vertices.size());
+	EXPECT_LT(rendern::AnalyzeVertexCache(overdrawOrder, cpu.vertices.size()), cacheAcmr * 1.1f);
+
+	const auto expected = TriangleSet(cpu, 0, static_cast<std::uint32_t>(cpu.indices.size()));
+	cpu.indices = overdrawOrder;
+	EXPECT_EQ(TriangleSet(cpu, 0, static_cast<std::uint32_t>(cpu.indices.size())), expected);
+}
+
+TEST(MeshOptimize, FetchOrderFollowsFirstUseAndDropsUnusedVertices)
+{
+	MeshCPU cpu = MakeShuffledGrid(8);
+	cpu.vertices.push_back(VertexDesc{}); // never indexed
+	const auto expected = TriangleSet(cpu, 0, static_cast<std::uint32_t>(cpu.indices.size()));
+
+	rendern::OptimizeVertexFetch(cpu);
+	EXPECT_EQ(cpu.vertices.size(), 81u);
+	std::uint32_t next = 0;
+	for (const std::uint32_t index : cpu.indices)
+	{
+		ASSERT_LE(index, next);
+		next = std::max(next, index + 1);
+	}
+	EXPECT_EQ(TriangleSet(cpu, 0, static_cast<std::uint32_t>(cpu.indices.size())), expected);
+}
+
+TEST(MeshOptimize, KeepsEveryLevelsRange)
+{
+	MeshCPU cpu = MakeShuffledGrid(24);
+	rendern::GenerateMeshLods(cpu);
+	ASSERT_GE(cpu.lods.size(), 2u);
+	const std::vector<MeshLod> lods = cpu.lods;
+	std::vector<std::vector<std::array<float, 9>>> expected;
+	for (const MeshLod& lod : lods)
+	{
+		expected.push_back(TriangleSet(cpu, lod.firstIndex, lod.indexCount));
+	}
+
+	rendern::OptimizeMesh(cpu);
+	ASSERT_EQ(cpu.lods.size(), lods.size());
+	for (std::size_t i = 0; i < lods.size(); ++i)
+	{
+		EXPECT_EQ(cpu.lods[i].firstIndex, lods[i].firstIndex);
+		EXPECT_EQ(cpu.lods[i].indexCount, lods[i].indexCount);
+		EXPECT_EQ(TriangleSet(cpu, lods[i].firstIndex, lods[i].indexCount), expected[i]);
+	}
+}
+
+TEST(MeshOptimize, HalfFloatConversion)
+{
+	EXPECT_EQ(rendern::FloatToHalf(0.0f), 0x0000u);
+	EXPECT_EQ(rendern::FloatToHalf(-0.0f), 0x8000u);
+	EXPECT_EQ(rendern::FloatToHalf(1.0f), 0x3C00u);
+	EXPECT_EQ(rendern::FloatToHalf(-2.0f), 0xC000u);
+	EXPECT_EQ(rendern::FloatToHalf(65504.0f), 0x7BFFu);
+	EXPECT_EQ(rendern::FloatToHalf(1.0e6f), 0x7C00u);
+	EXPECT_EQ(rendern::FloatToHalf(std::ldexp(1.0f, -24)), 0x0001u);
+	// Halfway between 1 and the next half: ties to even.
+	EXPECT_EQ(rendern::FloatToHalf(1.0f + std::ldexp(1.0f, -11)), 0x3C00u);
+
+	for (const float value : { 0.5f, 0.25f, 0.75f, 1.5f, 3.0f, -7.25f, 0.001f, 1024.0f })
+	{
+		EXPECT_NEAR(rendern::HalfToFloat(rendern::FloatToHalf(value)), value, std::abs(value) * 1.0e-3f);
+	}
+	EXPECT_TRUE(std::isinf(rendern::HalfToFloat(0x7C00u)));
+}
+
+TEST(MeshOptimize, CompactVerticesRoundTrip)
+{
+	const rendern::VertexQuantization q = rendern::MakeVertexQuantization(mathUtils::Vec3(-2.0f, 0.0f, 1.0f), mathUtils::Vec3(2.0f, 1.0f, 3.0f));
+	EXPECT_EQ(q.scale, 4.0f);
+
+	std::mt19937 rng(3u);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	for (int i = 0; i < 200; ++i)
+	{
+		const mathUtils::Vec3 n = mathUtils::Normalize(mathUtils::Vec3(unit(rng), unit(rng), unit(rng)));
+		const mathUtils::Vec3 t = rendern::BuildFallbackTangent(n);
+		VertexDesc v{};
+		v.px = 2.0f * unit(rng); v.py = 0.5f + 0.5f * unit(rng); v.pz = 2.0f + unit(rng);
+		v.nx = n.x; v.ny = n.y; v.nz = n.z;
+		v.u = 4.0f * unit(rng); v.v = unit(rng);
+		v.tx = t.x; v.ty = t.y; v.tz = t.z; v.tw = (i % 2 == 0) ? 1.0f : -1.0f;
+
+		const VertexDesc d = rendern::DecodeVertexCompact(rendern::EncodeVertexCompact(v, q), q);
+		EXPECT_NEAR(d.px, v.px, q.scale / 65535.0f);
+		EXPECT_NEAR(d.py, v.py, q.scale / 65535.0f);
+		EXPECT_NEAR(d.pz, v.pz, q.scale / 65535.0f);
+		EXPECT_GT(mathUtils::Dot(mathUtils::Vec3(d.nx, d.ny, d.nz), n), 0.99999f);
+		EXPECT_GT(mathUtils::Dot(mathUtils::Vec3(d.tx, d.ty, d.tz), t), 0.99999f);
+		EXPECT_NEAR(d.u, v.u, 4.0e-3f);
+		EXPECT_NEAR(d.v, v.v, 1.0e-3f);
+		EXPECT_EQ(d.tw, v.tw);
+	}
+}
+
+TEST(MeshOptimize, CompactMeshInstanceTransformDequantizes)
+{
+	const auto device = rhi::CreateNullDevice();
+	const std::vector<VertexDesc> vertices{
+		VertexDesc{ 1.0f, 2.0f, 3.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+		VertexDesc{ 5.0f, 2.0f, 3.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+		VertexDesc{ 1.0f, 4.0f, 3.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+	};
+	const std::vector<std::uint32_t> indices{ 0, 1, 2 };
+	const rendern::VertexQuantization q = rendern::MakeVertexQuantization(mathUtils::Vec3(1.0f, 2.0f, 3.0f), mathUtils::Vec3(5.0f, 4.0f, 3.0f));
+	rendern::MeshRHI mesh = rendern::UploadMeshCompact(*device, vertices, indices, q);
+	EXPECT_EQ(mesh.vertexStrideBytes, rendern::strideVCBytes);
+	EXPECT_EQ(mesh.indexCount, 3u);
+	EXPECT_TRUE(mesh.layoutInstanced);
+	EXPECT_EQ(mesh.positionScale, 4.0f);
+
+	// The shader sees UNORM positions in [0, 1]; the folded transform lands them in world space.
+	const mathUtils::Mat4 model = mathUtils::Translate(mathUtils::Mat4(1.0f), mathUtils::Vec3(10.0f, 0.0f, 0.0f));
+	const mathUtils::Mat4 rows = rendern::MeshVertexTransform(model, mesh);
+	const VertexCompact encoded = rendern::EncodeVertexCompact(vertices[1], q);
+	const mathUtils::Vec3 stored(encoded.px / 65535.0f, encoded.py / 65535.0f, encoded.pz / 65535.0f);
+	const mathUtils::Vec3 world = mathUtils::TransformPoint(rows, stored);
+	EXPECT_NEAR(world.x, 15.0f, 1e-4f);
+	EXPECT_NEAR(world.y, 2.0f, 1e-4f);
+	EXPECT_NEAR(world.z, 3.0f, 1e-4f);
+
+	const mathUtils::Vec4 sphere = rendern::MeshVertexSpaceSphere(mathUtils::Vec4(3.0f, 3.0f, 3.0f, 2.0f), mesh);
+	EXPECT_NEAR(sphere.x, 0.5f, 1e-6f);
+	EXPECT_NEAR(sphere.y, 0.25f, 1e-6f);
+	EXPECT_NEAR(sphere.w, 0.5f, 1e-6f);
+
+	// Full-format meshes pass through unchanged.
+	EXPECT_EQ(rendern::MeshVertexTransform(model, rendern::MeshRHI{})[3].x, 10.0f);
+	rendern::DestroyMesh(*device, mesh);
+}
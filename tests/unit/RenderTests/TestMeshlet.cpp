@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+import core;
+
+using rendern::MeshCPU;
+using rendern::Meshlet;
+using rendern::MeshletData;
+using rendern::VertexDesc;
+
+namespace
+{
+	VertexDesc Vertex(float x, float y, float z, float nx, float ny, float nz)
+	{
+		return VertexDesc{ x, y, z, nx, ny, nz, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+	}
+
+	// Unit UV sphere, outward winding (counter-clockwise seen from outside).
+	MeshCPU MakeSphere(std::uint32_t rings, std::uint32_t segments)
+	{
+		MeshCPU cpu{};
+		for (std::uint32_t r = 0; r <= rings; ++r)
+		{
+			const float theta = std::numbers::pi_v<float> * static_cast<float>(r) / static_cast<float>(rings);
+			for (std::uint32_t s = 0; s <= segments; ++s)
+			{
+				const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s % segments) / static_cast<float>(segments);
+				const float x = std::sin(theta) * std::cos(phi);
+				const float y = std::cos(theta);
+				const float z = std::sin(theta) * std::sin(phi);
+				cpu.vertices.push_back(Vertex(x, y, z, x, y, z));
+			}
+		}
+		for (std::uint32_t r = 0; r < rings; ++r)
+		{
+			for (std::uint32_t s = 0; s < segments; ++s)
+			{
+				const std::uint32_t a = r * (segments + 1) + s;
+				const std::uint32_t b = a + segments + 1;
+				if (r != 0)
+				{
+					cpu.indices.insert(cpu.indices.end(), { a, a + 1, b });
+				}
+				if (r + 1 != rings)
+				{
+					cpu.indices.insert(cpu.indices.end(), { a + 1, b + 1, b });
+				}
+			}
+		}
+		return cpu;
+	}
+
+	mathUtils::Vec3 Position(const VertexDesc& v)
+	{
+		return mathUtils::Vec3(v.px, v.py, v.pz);
+	}
+
+	// The mesh vertex of a meshlet triangle corner.
+	std::uint32_t CornerVertex(const MeshletData& data, const Meshlet& meshlet, std::uint32_t triangle, std::uint32_t corner)
+	{
+		const std::uint32_t local = rendern::MeshletTriangleCorner(data.data[meshlet.triangleOffset + triangle], corner);
+		return data.data[meshlet.vertexOffset + local];
+	}
+}
+
+TEST(Meshlet, CoversEveryTriangleInOrderWithinTheLimits)
+{
+	MeshCPU cpu = MakeSphere(24, 48);
+	rendern::OptimizeMesh(cpu);
+
+	const MeshletData data = rendern::BuildMeshlets(cpu.vertices, cpu.indices);
+	ASSERT_EQ(data.lods.size(), 1u);
+	EXPECT_EQ(data.lods[0].firstMeshlet, 0u);
+	EXPECT_EQ(data.lods[0].meshletCount, data.meshlets.size());
+
+	std::vector<std::uint32_t> rebuilt;
+	for (const Meshlet& meshlet : data.meshlets)
+	{
+		ASSERT_GT(meshlet.triangleCount, 0u);
+		ASSERT_LE(meshlet.vertexCount, rendern::kMeshletMaxVertices);
+		ASSERT_LE(meshlet.triangleCount, rendern::kMeshletMaxTriangles);
+		for (std::uint32_t t = 0; t < meshlet.triangleCount; ++t)
+		{
+			for (std::uint32_t corner = 0; corner < 3; ++corner)
+			{
+				ASSERT_LT(rendern::MeshletTriangleCorner(data.data[meshlet.triangleOffset + t], corner), meshlet.vertexCount);
+				rebuilt.push_back(CornerVertex(data, meshlet, t, corner));
+			}
+		}
+
+		// The sphere holds every vertex.
+		for (std::uint32_t v = 0; v < meshlet.vertexCount; ++v)
+		{
+			const mathUtils::Vec3 p = Position(cpu.vertices[data.data[meshlet.vertexOffset + v]]);
+			EXPECT_LE(mathUtils::Length(p - meshlet.center), meshlet.radius + 1e-5f);
+		}
+	}
+	EXPECT_EQ(rebuilt, cpu.indices);
+
+	// Cache-ordered triangles share vertices: meshlets come out reasonably full.
+	const std::size_t triangleCount = cpu.indices.size() / 3;
+	EXPECT_LE(data.meshlets.size(), (triangleCount + 63) / 64);
+}
+
+TEST(Meshlet, BuildsOneRangePerLevelOfDetail)
+{
+	MeshCPU cpu = MakeSphere(32, 64);
+	rendern::GenerateMeshLods(cpu);
+	rendern::OptimizeMesh(cpu);
+	ASSERT_GE(cpu.lods.size(), 2u);
+
+	const MeshletData data = rendern::BuildMeshlets(cpu.vertices, cpu.indices, cpu.lods);
+	ASSERT_EQ(data.lods.size(), cpu.lods.size());
+	std::uint32_t expectedFirst = 0;
+	for (std::size_t lod = 0; lod < cpu.lods.size(); ++lod)
+	{
+		const rendern::MeshletRange& range = data.lods[lod];
+		EXPECT_EQ(range.firstMeshlet, expectedFirst);
+		EXPECT_GT(range.meshletCount, 0u);
+		expectedFirst += range.meshletCount;
+
+		std::uint32_t triangles = 0;
+		for (std::uint32_t m = range.firstMeshlet; m < range.firstMeshlet + range.meshletCount; ++m)
+		{
+			triangles += data.meshlets[m].triangleCount;
+		}
+		EXPECT_EQ(triangles * 3u, cpu.lods[lod].indexCount);
+		if (lod != 0)
+		{
+			EXPECT_LT(range.meshletCount, data.lods[lod - 1].meshletCount);
+		}
+	}
+	EXPECT_EQ(expectedFirst, data.meshlets.size());
+
+	// A level outside the index buffer builds nothing.
+	const std::vector<rendern::MeshLod> broken{ { 0, static_cast<std::uint32_t>(cpu.indices.size()) + 3u } };
+	EXPECT_TRUE(rendern::BuildMeshlets(cpu.vertices, cpu.indices, broken).meshlets.empty());
+}
+
+TEST(Meshlet, ConeCullingOnlyDropsMeshletsThatFaceAway)
+{
+	MeshCPU cpu = MakeSphere(24, 48);
+	rendern::OptimizeMesh(cpu);
+	const MeshletData data = rendern::BuildMeshlets(cpu.vertices, cpu.indices, {}, 32, 32);
+
+	const std::vector<mathUtils::Vec3> cameras{
+		{ 4.0f, 0.0f, 0.0f }, { 0.0f, -3.0f, 0.0f }, { 1.5f, 1.5f, 1.5f }, { -10.0f, 2.0f, 0.5f }, { 0.0f, 0.0f, 1.2f } };
+	for (const mathUtils::Vec3& camera : cameras)
+	{
+		std::size_t culled = 0;
+		for (const Meshlet& meshlet : data.meshlets)
+		{
+			if (!rendern::MeshletConeCulled(meshlet, camera))
+			{
+				continue;
+			}
+			++culled;
+			// Conservative: no triangle of a culled meshlet faces the camera.
+			for (std::uint32_t t = 0; t < meshlet.triangleCount; ++t)
+			{
+				const mathUtils::Vec3 p0 = Position(cpu.vertices[CornerVertex(data, meshlet, t, 0)]);
+				const mathUtils::Vec3 p1 = Position(cpu.vertices[CornerVertex(data, meshlet, t, 1)]);
+				const mathUtils::Vec3 p2 = Position(cpu.vertices[CornerVertex(data, meshlet, t, 2)]);
+				EXPECT_GE(mathUtils::Dot(mathUtils::Cross(p1 - p0, p2 - p0), p0 - camera), 0.0f);
+			}
+		}
+		// The far side of a convex shell is mostly culled.
+		EXPECT_GT(culled, data.meshlets.size() / 5);
+		EXPECT_LT(culled, data.meshlets.size());
+	}
+}
+
+TEST(Meshlet, FlatPatchHasATightConeAndWideOnesNeverCull)
+{
+	// 4x4 quads on z = 0 facing +z.
+	MeshCPU cpu{};
+	constexpr std::uint32_t kSide = 5;
+	for (std::uint32_t y = 0; y < kSide; ++y)
+	{
+		for (std::uint32_t x = 0; x < kSide; ++x)
+		{
+			cpu.vertices.push_back(Vertex(static_cast<float>(x), static_cast<float>(y), 0.0f, 0.0f, 0.0f, 1.0f));
+		}
+	}
+	for (std::uint32_t y = 0; y + 1 < kSide; ++y)
+	{
+		for (std::uint32_t x = 0; x + 1 < kSide; ++x)
+		{
+			const std::uint32_t a = y * kSide + x;
+			cpu.indices.insert(cpu.indices.end(), { a, a + 1, a + kSide + 1, a, a + kSide + 1, a + kSide });
+		}
+	}
+
+	const MeshletData flat = rendern::BuildMeshlets(cpu.vertices, cpu.indices);
+	ASSERT_EQ(flat.meshlets.size(), 1u);
+	const Meshlet& meshlet = flat.meshlets[0];
+	EXPECT_NEAR(meshlet.coneAxis.z, 1.0f, 1e-5f);
+	EXPECT_NEAR(meshlet.coneCutoff, 0.0f, 1e-3f);
+	EXPECT_TRUE(rendern::MeshletConeCulled(meshlet, mathUtils::Vec3(2.0f, 2.0f, -5.0f)));
+	EXPECT_FALSE(rendern::MeshletConeCulled(meshlet, mathUtils::Vec3(2.0f, 2.0f, 5.0f)));
+	// Grazing views keep it: the sphere reaches over the plane.
+	EXPECT_FALSE(rendern::MeshletConeCulled(meshlet, mathUtils::Vec3(30.0f, 2.0f, -0.5f)));
+
+	// A closed shell in one meshlet has normals all around: never cone culled.
+	MeshCPU sphere = MakeSphere(4, 8);
+	const MeshletData closed = rendern::BuildMeshlets(sphere.vertices, sphere.indices);
+	ASSERT_EQ(closed.meshlets.size(), 1u);
+	EXPECT_GE(closed.meshlets[0].coneCutoff, 1.0f);
+	EXPECT_FALSE(rendern::MeshletConeCulled(closed.meshlets[0], mathUtils::Vec3(0.0f, 0.0f, 10.0f)));
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <type_traits>
+
+import core;
+
+TEST(ObjectIdPicking, DrawIndicesRoundTripThroughObjectIds)
+{
+	for (const int drawIndex : { 0, 1, 41, 1 << 20 })
+	{
+		bool skinned = true;
+		EXPECT_EQ(rendern::DrawIndexFromObjectId(rendern::ObjectIdForDrawItem(static_cast<std::uint32_t>(drawIndex)), skinned), drawIndex);
+		EXPECT_FALSE(skinned);
+
+		EXPECT_EQ(rendern::DrawIndexFromObjectId(rendern::ObjectIdForSkinnedDrawItem(static_cast<std::uint32_t>(drawIndex)), skinned), drawIndex);
+		EXPECT_TRUE(skinned);
+	}
+
+	EXPECT_NE(rendern::ObjectIdForDrawItem(0), rendern::kObjectIdNone);
+	EXPECT_NE(rendern::ObjectIdForSkinnedDrawItem(0), rendern::ObjectIdForDrawItem(0));
+
+	bool skinned = true;
+	EXPECT_EQ(rendern::DrawIndexFromObjectId(rendern::kObjectIdNone, skinned), -1);
+	EXPECT_FALSE(skinned);
+}
+
+TEST(ObjectIdPicking, ReadbackTextureRecordsRectAndRequestId)
+{
+	rhi::CommandList list;
+	list.ReadbackTexture(rhi::TextureHandle{ 3 }, 10, 20, 8, 4, 77);
+
+	ASSERT_EQ(list.Size(), 1u);
+	const auto* cmd = (*list.begin()).GetIf<rhi::CommandReadbackTexture>();
+	ASSERT_NE(cmd, nullptr);
+	EXPECT_EQ(cmd->texture, rhi::TextureHandle{ 3 });
+	EXPECT_EQ(cmd->x, 10u);
+	EXPECT_EQ(cmd->y, 20u);
+	EXPECT_EQ(cmd->width, 8u);
+	EXPECT_EQ(cmd->height, 4u);
+	EXPECT_EQ(cmd->requestId, 77u);
+}
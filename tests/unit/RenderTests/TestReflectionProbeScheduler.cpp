@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+import core;
+
+using rendern::ReflectionProbeRequest;
+using rendern::ScheduleReflectionProbeFaces;
+
+namespace
+{
+	std::uint32_t FaceCount(std::span<const std::uint8_t> faces)
+	{
+		std::uint32_t count = 0;
+		for (const std::uint8_t mask : faces)
+		{
+			count += static_cast<std::uint32_t>(std::popcount(mask));
+		}
+		return count;
+	}
+}
+
+TEST(ReflectionProbeScheduler, ZeroBudgetCapturesEveryStaleFace)
+{
+	const std::vector<ReflectionProbeRequest> probes{
+		{ .staleFaces = rendern::kAllReflectionProbeFaces, .priority = 1.0f },
+		{ .staleFaces = 0b000101, .priority = 0.5f },
+		{ .staleFaces = 0, .priority = 2.0f } };
+	std::array<std::uint8_t, 3> faces{};
+
+	EXPECT_EQ(ScheduleReflectionProbeFaces(probes, 0u, faces), 8u);
+	EXPECT_EQ(faces[0], rendern::kAllReflectionProbeFaces);
+	EXPECT_EQ(faces[1], 0b000101);
+	EXPECT_EQ(faces[2], 0);
+}
+
+TEST(ReflectionProbeScheduler, BudgetGoesToTheHighestPriorityFirst)
+{
+	const std::vector<ReflectionProbeRequest> probes{
+		{ .staleFaces = rendern::kAllReflectionProbeFaces, .priority = 0.1f },
+		{ .staleFaces = rendern::kAllReflectionProbeFaces, .priority = 0.9f } };
+	std::array<std::uint8_t, 2> faces{};
+
+	EXPECT_EQ(ScheduleReflectionProbeFaces(probes, 8u, faces), 8u);
+	EXPECT_EQ(faces[1], rendern::kAllReflectionProbeFaces);
+	EXPECT_EQ(faces[0], 0b000011); // the rest of the budget, lowest faces first
+	EXPECT_EQ(FaceCount(faces), 8u);
+}
+
+TEST(ReflectionProbeScheduler, NeverCapturedProbesGoBeforeHigherPriorities)
+{
+	const std::vector<ReflectionProbeRequest> probes{
+		{ .staleFaces = rendern::kAllReflectionProbeFaces, .priority = 100.0f },
+		{ .staleFaces = rendern::kAllReflectionProbeFaces, .neverCaptured = true, .priority = 0.0f } };
+	std::array<std::uint8_t, 2> faces{};
+
+	ScheduleReflectionProbeFaces(probes, 6u, faces);
+	EXPECT_EQ(faces[1], rendern::kAllReflectionProbeFaces);
+	EXPECT_EQ(faces[0], 0);
+}
+
+TEST(ReflectionProbeScheduler, WaitingRaisesPrioritySoDistantProbesAreNotStarved)
+{
+	const mathUtils::Vec3 camera{ 0.0f, 0.0f, 0.0f };
+	const float fovY = mathUtils::DegToRad(60.0f);
+	const float nearNow = rendern::ReflectionProbePriority(camera, fovY, { 0.0f, 0.0f, -5.0f }, 1.0f, 0u);
+	const float farNow = rendern::ReflectionProbePriority(camera, fovY, { 0.0f, 0.0f, -50.0f }, 1.0f, 0u);
+	EXPECT_GT(nearNow, farNow);
+
+	std::uint32_t framesWaiting = 0;
+	while (rendern::ReflectionProbePriority(camera, fovY, { 0.0f, 0.0f, -50.0f }, 1.0f, framesWaiting) <= nearNow)
+	{
+		++framesWaiting;
+		ASSERT_LT(framesWaiting, 1000u);
+	}
+	EXPECT_GT(framesWaiting, 0u);
+
+	// Inside the owner's sphere the probe covers the whole view.
+	EXPECT_FLOAT_EQ(rendern::ReflectionProbePriority(camera, fovY, { 0.0f, 0.0f, -0.5f }, 1.0f, 0u), 1.0f);
+}
@@ -0,0 +1,485 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+import core;
+
+namespace
+{
+	renderGraph::RGTextureDesc ColorDesc()
+	{
+		return renderGraph::RGTextureDesc{
+			.extent = { 64, 64 },
+			.format = rhi::Format::RGBA8_UNORM,
+			.usage = renderGraph::ResourceUsage::RenderTarget
+		};
+	}
+
+	renderGraph::PassAttachments ClearInto(renderGraph::RGTexture color)
+	{
+		renderGraph::PassAttachments att{};
+		att.colors = { color };
+		att.clearDesc.clearColor = true;
+		att.clearDesc.clearDepth = false;
+		att.clearDesc.clearStencil = false;
+		return att;
+	}
+
+	void NoOp(renderGraph::PassContext&) {}
+
+	// Three-pass chain A -> B -> C -> present; A and C share a desc, B does not.
+	void AddChain(renderGraph::RenderGraph& graph, std::vector<rhi::TextureHandle>& seen)
+	{
+		const auto a = graph.CreateTexture(ColorDesc());
+		renderGraph::RGTextureDesc halfDesc = ColorDesc();
+		halfDesc.extent = { 32, 32 };
+		const auto b = graph.CreateTexture(halfDesc);
+		const auto c = graph.CreateTexture(ColorDesc());
+
+		graph.AddPass("A", ClearInto(a), [&seen, a](renderGraph::PassContext& ctx) { seen.push_back(ctx.resources.GetTexture(a)); });
+		renderGraph::PassAttachments passB = ClearInto(b);
+		passB.textures = { renderGraph::Read(a) };
+		graph.AddPass("B", std::move(passB), [&seen, b](renderGraph::PassContext& ctx) { seen.push_back(ctx.resources.GetTexture(b)); });
+		renderGraph::PassAttachments passC = ClearInto(c);
+		passC.textures = { renderGraph::Read(b) };
+		graph.AddPass("C", std::move(passC), [&seen, c](renderGraph::PassContext& ctx) { seen.push_back(ctx.resources.GetTexture(c)); });
+		graph.AddSwapChainPass("Present", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(c) });
+	}
+
+	bool EndsWithBeginPass(const rhi::CommandList& list)
+	{
+		bool last = false;
+		for (const rhi::CommandRecord record : list)
+		{
+			last = record.Is<rhi::CommandBeginPass>();
+		}
+		return last;
+	}
+
+	bool Contains(const std::vector<std::uint32_t>& passes, std::uint32_t pass)
+	{
+		return std::find(passes.begin(), passes.end(), pass) != passes.end();
+	}
+}
+
+TEST(RenderGraph, CullsPassesWhoseOutputsAreNeverRead)
+{
+	renderGraph::RenderGraph graph;
+	const auto used = graph.CreateTexture(ColorDesc());
+	const auto unused = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("Used", ClearInto(used), NoOp);
+	graph.AddPass("Unused", ClearInto(unused), NoOp);
+	graph.AddSwapChainPass("Present", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(used) });
+
+	const renderGraph::CompiledGraph compiled = graph.Compile();
+
+	EXPECT_EQ(compiled.passes, (std::vector<std::uint32_t>{ 0u, 2u }));
+	EXPECT_EQ(compiled.culledPassCount, 1u);
+	ASSERT_EQ(compiled.textureUsed.size(), 2u);
+	EXPECT_EQ(compiled.textureUsed[used.id], 1u);
+	EXPECT_EQ(compiled.textureUsed[unused.id], 0u);
+}
+
+TEST(RenderGraph, KeepsTheWholeChainBehindALiveRead)
+{
+	renderGraph::RenderGraph graph;
+	const auto a = graph.CreateTexture(ColorDesc());
+	const auto b = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("ProduceA", ClearInto(a), NoOp);
+	renderGraph::PassAttachments blur = ClearInto(b);
+	blur.textures = { renderGraph::Read(a) };
+	graph.AddPass("BlurAIntoB", std::move(blur), NoOp);
+	graph.AddSwapChainPass("Present", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(b) });
+
+	const renderGraph::CompiledGraph compiled = graph.Compile();
+
+	EXPECT_EQ(compiled.passes, (std::vector<std::uint32_t>{ 0u, 1u, 2u }));
+	EXPECT_EQ(compiled.culledPassCount, 0u);
+}
+
+TEST(RenderGraph, ReadDependsOnlyOnTheLastEarlierWrite)
+{
+	renderGraph::RenderGraph graph;
+	const auto color = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("Overwritten", ClearInto(color), NoOp);
+	graph.AddPass("Final", ClearInto(color), NoOp);
+	graph.AddSwapChainPass("Present", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(color) });
+
+	const renderGraph::CompiledGraph compiled = graph.Compile();
+
+	EXPECT_FALSE(Contains(compiled.passes, 0u));
+	EXPECT_TRUE(Contains(compiled.passes, 1u));
+}
+
+TEST(RenderGraph, LoadingAColorTargetKeepsItsEarlierWriter)
+{
+	renderGraph::RenderGraph graph;
+	const auto color = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("Base", ClearInto(color), NoOp);
+	renderGraph::PassAttachments overlay = ClearInto(color);
+	overlay.clearDesc.clearColor = false;
+	graph.AddPass("Overlay", std::move(overlay), NoOp);
+	graph.AddSwapChainPass("Present", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(color) });
+
+	const renderGraph::CompiledGraph compiled = graph.Compile();
+
+	EXPECT_EQ(compiled.passes, (std::vector<std::uint32_t>{ 0u, 1u, 2u }));
+}
+
+TEST(RenderGraph, ARectClearKeepsTheEarlierWriter)
+{
+	renderGraph::RenderGraph graph;
+	const auto atlas = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("Tile0", ClearInto(atlas), NoOp);
+	renderGraph::PassAttachments tile1 = ClearInto(atlas);
+	tile1.clearDesc.rect = rhi::ClearRect{ .x = 32, .y = 0, .width = 32, .height = 64 };
+	graph.AddPass("Tile1", std::move(tile1), NoOp);
+	graph.AddSwapChainPass("Present", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(atlas) });
+
+	const renderGraph::CompiledGraph compiled = graph.Compile();
+
+	EXPECT_EQ(compiled.passes, (std::vector<std::uint32_t>{ 0u, 1u, 2u }));
+	EXPECT_EQ(compiled.culledPassCount, 0u);
+}
+
+TEST(RenderGraph, KeepsImportedWritesSideEffectsAndUndeclaredPasses)
+{
+	renderGraph::RenderGraph graph;
+	const auto imported = graph.ImportTexture(rhi::TextureHandle{ 7 }, ColorDesc());
+	const auto transient = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("WritesImported", ClearInto(imported), NoOp);
+	renderGraph::PassAttachments sideEffects = ClearInto(transient);
+	sideEffects.sideEffects = true;
+	graph.AddPass("SideEffects", std::move(sideEffects), NoOp);
+	graph.AddComputePass("Untracked", NoOp);
+
+	const renderGraph::CompiledGraph compiled = graph.Compile();
+
+	EXPECT_EQ(compiled.passes, (std::vector<std::uint32_t>{ 0u, 1u, 2u }));
+	EXPECT_EQ(compiled.culledPassCount, 0u);
+}
+
+TEST(RenderGraph, EmitsBarriersOnlyWhenTheStateChanges)
+{
+	renderGraph::RenderGraph graph;
+	const auto color = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("Write", ClearInto(color), NoOp);
+	graph.AddSwapChainPass("SampleOnce", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(color) });
+	graph.AddSwapChainPass("SampleAgain", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(color) });
+
+	const renderGraph::CompiledGraph compiled = graph.Compile();
+
+	ASSERT_EQ(compiled.passes.size(), 3u);
+	ASSERT_EQ(compiled.barrierOffsets, (std::vector<std::uint32_t>{ 0u, 1u, 2u, 2u }));
+	EXPECT_EQ(compiled.barriers[0].texture.id, color.id);
+	EXPECT_EQ(compiled.barriers[0].state, rhi::TextureState::RenderTarget);
+	EXPECT_EQ(compiled.barriers[1].texture.id, color.id);
+	EXPECT_EQ(compiled.barriers[1].state, rhi::TextureState::ShaderRead);
+}
+
+TEST(RenderGraph, CopiesAnImportedCacheIntoATransientBeforeLoadingIt)
+{
+	renderGraph::RenderGraph graph;
+	const auto cache = graph.ImportTexture(rhi::TextureHandle{ 7 }, ColorDesc());
+	const auto target = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("RefreshCache", ClearInto(cache), NoOp);
+	graph.AddComputePass("Seed", NoOp,
+		{ renderGraph::Read(cache, renderGraph::ResourceUsage::CopySource), renderGraph::Write(target, renderGraph::ResourceUsage::CopyDest) });
+	renderGraph::PassAttachments load{};
+	load.colors = { target };
+	load.clearDesc.clearColor = false;
+	graph.AddPass("DrawOnTop", std::move(load), NoOp);
+	graph.AddSwapChainPass("Present", rhi::ClearDesc{}, NoOp, false, { renderGraph::Read(target) });
+
+	const renderGraph::CompiledGraph compiled = graph.Compile();
+
+	ASSERT_EQ(compiled.passes, (std::vector<std::uint32_t>{ 0u, 1u, 2u, 3u }));
+	ASSERT_EQ(compiled.barrierOffsets[1], 1u);
+	ASSERT_EQ(compiled.barrierOffsets[2], 3u);
+	EXPECT_EQ(compiled.barriers[1].texture.id, cache.id);
+	EXPECT_EQ(compiled.barriers[1].state, rhi::TextureState::CopySource);
+	EXPECT_EQ(compiled.barriers[2].texture.id, target.id);
+	EXPECT_EQ(compiled.barriers[2].state, rhi::TextureState::CopyDest);
+	EXPECT_EQ(compiled.barriers[3].state, rhi::TextureState::RenderTarget);
+}
+
+TEST(RenderGraph, JoinsAsyncComputeAtTheFirstGraphicsPassThatUsesItsOutput)
+{
+	renderGraph::RenderGraph graph;
+	const rhi::BufferHandle culled{ 7 };
+	const auto shadow = graph.CreateTexture(ColorDesc());
+
+	graph.AddComputePass("Cull", NoOp, {}, { renderGraph::Write(culled) }, true);
+	graph.AddPass("Shadow", ClearInto(shadow), NoOp);
+	renderGraph::PassAttachments main{};
+	main.useSwapChainBackbuffer = true;
+	main.textures = { renderGraph::Read(shadow) };
+	main.buffers = { renderGraph::Read(culled) };
+	graph.AddPass("Main", std::move(main), NoOp);
+
+	const renderGraph::CompiledGraph serial = graph.Compile();
+	EXPECT_EQ(serial.asyncSegmentCount, 0u);
+	EXPECT_EQ(serial.asyncSegment, (std::vector<std::uint32_t>(3, renderGraph::kNoPass)));
+	EXPECT_EQ(serial.waitForSegment, (std::vector<std::uint32_t>(3, renderGraph::kNoPass)));
+
+	const renderGraph::CompiledGraph compiled = graph.Compile(true);
+	constexpr std::uint32_t none = renderGraph::kNoPass;
+	EXPECT_EQ(compiled.asyncSegmentCount, 1u);
+	EXPECT_EQ(compiled.asyncSegment, (std::vector<std::uint32_t>{ 0u, none, none }));
+	EXPECT_EQ(compiled.waitForSegment, (std::vector<std::uint32_t>{ none, none, 0u }));
+}
+
+TEST(RenderGraph, GroupsConsecutiveAsyncPassesAndJoinsOnWriteAfterRead)
+{
+	renderGraph::RenderGraph graph;
+	const rhi::TextureHandle sceneDepth{ 5 };
+	const rhi::BufferHandle hiZ{ 1 };
+	const rhi::BufferHandle args{ 2 };
+	const auto depthRead = graph.ImportTexture(sceneDepth, renderGraph::RGTextureDesc{ .extent = { 64, 64 }, .format = rhi::Format::D32_FLOAT });
+	const auto depthWrite = graph.ImportTexture(sceneDepth, renderGraph::RGTextureDesc{ .extent = { 64, 64 }, .format = rhi::Format::D32_FLOAT });
+
+	graph.AddComputePass("HiZ", NoOp, { renderGraph::Read(depthRead) }, { renderGraph::Write(hiZ) }, true);
+	graph.AddComputePass("Cull", NoOp, {}, { renderGraph::Read(hiZ), renderGraph::Write(args) }, true);
+	renderGraph::PassAttachments depthPass{};
+	depthPass.depth = depthWrite;
+	depthPass.clearDesc.clearColor = false;
+	depthPass.clearDesc.clearDepth = true;
+	graph.AddPass("DepthWriter", std::move(depthPass), NoOp);
+	graph.AddComputePass("Undeclared", NoOp, {}, {}, true);
+	graph.AddSwapChainPass("Present", rhi::ClearDesc{}, NoOp, false);
+
+	const renderGraph::CompiledGraph compiled = graph.Compile(true);
+	constexpr std::uint32_t none = renderGraph::kNoPass;
+	ASSERT_EQ(compiled.passes.size(), 5u);
+	EXPECT_EQ(compiled.asyncSegmentCount, 2u);
+	EXPECT_EQ(compiled.asyncSegment, (std::vector<std::uint32_t>{ 0u, 0u, none, 1u, none }));
+	// The depth write must not start while HiZ may still be sampling the same texture.
+	EXPECT_EQ(compiled.waitForSegment, (std::vector<std::uint32_t>{ none, none, 0u, none, 1u }));
+}
+
+TEST(RenderGraph, AsyncTexturesStayAliveUntilTheSegmentIsJoined)
+{
+	renderGraph::RenderGraph graph;
+	const rhi::BufferHandle culled{ 3 };
+	const auto depth = graph.CreateTexture(ColorDesc());
+	const auto bloom = graph.CreateTexture(ColorDesc());
+
+	graph.AddPass("Depth", ClearInto(depth), NoOp);
+	graph.AddComputePass("Cull", NoOp, { renderGraph::Read(depth) }, { renderGraph::Write(culled) }, true);
+	graph.AddPass("Bloom", ClearInto(bloom), NoOp);
+	renderGraph::PassAttachments main{};
+	main.useSwapChainBackbuffer = true;
+	main.textures = { renderGraph::Read(bloom) };
+	main.buffers = { renderGraph::Read(culled) };
+	graph.AddPass("Main", std::move(main), NoOp);
+
+	// Serially the two same-desc textures have disjoint lifetimes and may share one pooled texture.
+	const renderGraph::CompiledGraph serial = graph.Compile();
+	EXPECT_LT(serial.lastUse[depth.id], serial.firstUse[bloom.id]);
+
+	// On the async queue Cull may still read `depth` while Bloom writes; only Main joins it.
+	const renderGraph::CompiledGraph compiled = graph.Compile(true);
+	constexpr std::uint32_t none = renderGraph::kNoPass;
+	ASSERT_EQ(compiled.passes.size(), 4u);
+	EXPECT_EQ(compiled.asyncSegment, (std::vector<std::uint32_t>{ none, 0u, none, none }));
+	EXPECT_EQ(compiled.waitForSegment, (std::vector<std::uint32_t>{ none, none, none, 0u }));
+	EXPECT_EQ(compiled.lastUse[depth.id], 3u);
+	EXPECT_GE(compiled.lastUse[depth.id], compiled.firstUse[bloom.id]);
+}
+
+TEST(RenderGraph, AliasesSameDescTexturesWithDisjointLifetimes)
+{
+	const auto device = rhi::CreateNullDevice();
+	const auto swapChain = rhi::CreateNullSwapChain(*device, rhi::SwapChainDesc{ .extent = { 64, 64 } });
+	renderGraph::TransientResourcePool pool;
+
+	std::vector<rhi::TextureHandle> seen;
+	renderGraph::RenderGraph graph;
+	AddChain(graph, seen);
+	graph.Execute(*device, *swapChain, pool);
+
+	ASSERT_EQ(seen.size(), 3u);
+	EXPECT_EQ(seen[0], seen[2]);
+	EXPECT_NE(seen[0], seen[1]);
+	EXPECT_EQ(pool.TextureCount(), 2u);
+	EXPECT_EQ(pool.FramebufferCount(), 2u);
+}
+
+TEST(RenderGraph, SteadyFramesReusePooledTexturesAndFramebuffers)
+{
+	const auto device = rhi::CreateNullDevice();
+	const auto swapChain = rhi::CreateNullSwapChain(*device, rhi::SwapChainDesc{ .extent = { 64, 64 } });
+	renderGraph::TransientResourcePool pool;
+
+	std::vector<rhi::TextureHandle> firstFrame;
+	{
+		renderGraph::RenderGraph graph;
+		AddChain(graph, firstFrame);
+		graph.Execute(*device, *swapChain, pool);
+	}
+	const std::uint64_t created = pool.CreatedTextureCount();
+
+	std::vector<rhi::TextureHandle> secondFrame;
+	{
+		renderGraph::RenderGraph graph;
+		AddChain(graph, secondFrame);
+		graph.Execute(*device, *swapChain, pool);
+	}
+
+	EXPECT_EQ(pool.CreatedTextureCount(), created);
+	EXPECT_EQ(secondFrame, firstFrame);
+	EXPECT_EQ(pool.FramebufferCount(), 2u);
+}
+
+TEST(RenderGraph, PoolDropsEntriesIdleForTooManyFrames)
+{
+	const auto device = rhi::CreateNullDevice();
+	const auto swapChain = rhi::CreateNullSwapChain(*device, rhi::SwapChainDesc{ .extent = { 64, 64 } });
+	renderGraph::TransientResourcePool pool;
+
+	std::vector<rhi::TextureHandle> seen;
+	{
+		renderGraph::RenderGraph graph;
+		AddChain(graph, seen);
+		graph.Execute(*device, *swapChain, pool);
+	}
+	for (std::uint64_t frame = 0; frame < renderGraph::TransientResourcePool::kMaxIdleFrames; ++frame)
+	{
+		renderGraph::RenderGraph().Execute(*device, *swapChain, pool);
+	}
+	EXPECT_EQ(pool.TextureCount(), 2u);
+
+	renderGraph::RenderGraph().Execute(*device, *swapChain, pool);
+	EXPECT_EQ(pool.TextureCount(), 0u);
+	EXPECT_EQ(pool.FramebufferCount(), 0u);
+}
+
+TEST(RenderGraph, RecordsParallelPassesOnceEachIntoTheirOwnLists)
+{
+	const auto device = rhi::CreateNullDevice();
+	const auto swapChain = rhi::CreateNullSwapChain(*device, rhi::SwapChainDesc{ .extent = { 64, 64 } });
+	jobs::Scheduler scheduler(4);
+	renderGraph::TransientResourcePool pool;
+
+	constexpr int kPassCount = 16;
+	std::vector<std::atomic<int>> calls(kPassCount);
+	std::atomic<int> sharedLists{ 0 };
+
+	renderGraph::RenderGraph graph;
+	graph.SetJobScheduler(&scheduler);
+	const auto shadow = graph.ImportTexture(rhi::TextureHandle{ 7 }, ColorDesc());
+	for (int i = 0; i < kPassCount; ++i)
+	{
+		renderGraph::PassAttachments att = ClearInto(shadow);
+		att.clearDesc.clearColor = (i == 0);
+		att.parallelRecord = true;
+		graph.AddPass("Shadow", std::move(att), [&calls, &sharedLists, i](renderGraph::PassContext& ctx)
+			{
+				calls[i].fetch_add(1, std::memory_order_relaxed);
+				// Only this pass's barriers and BeginPass precede the callback in its list.
+				if (ctx.commandList.Size() > 2 || !EndsWithBeginPass(ctx.commandList))
+				{
+					sharedLists.fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+	}
+	graph.Execute(*device, *swapChain, pool);
+
+	for (int i = 0; i < kPassCount; ++i)
+	{
+		EXPECT_EQ(calls[i].load(), 1) << "pass " << i;
+	}
+	EXPECT_EQ(sharedLists.load(), 0);
+}
+
+TEST(RenderGraph, CountsEachPassesCommandsIntoFrameStats)
+{
+	const auto device = rhi::CreateNullDevice();
+	const auto swapChain = rhi::CreateNullSwapChain(*device, rhi::SwapChainDesc{ .extent = { 64, 64 } });
+	jobs::Scheduler scheduler(2);
+	renderGraph::TransientResourcePool pool;
+
+	renderGraph::RenderGraph graph;
+	graph.SetJobScheduler(&scheduler);
+	const auto color = graph.CreateTexture(ColorDesc());
+	const auto unused = graph.CreateTexture(ColorDesc());
+	for (int i = 0; i < 2; ++i)
+	{
+		renderGraph::PassAttachments att = ClearInto(color);
+		att.clearDesc.clearColor = (i == 0);
+		att.parallelRecord = true;
+		graph.AddPass("Shadow", std::move(att), [](renderGraph::PassContext& ctx)
+			{
+				ctx.commandList.BindPipeline(rhi::PipelineHandle{ 1 });
+				ctx.commandList.DrawIndexed(36, rhi::IndexType::UINT16, 0, 0, 4);
+			});
+	}
+	graph.AddPass("Unused", ClearInto(unused), NoOp);
+	graph.AddSwapChainPass("Present", rhi::ClearDesc{}, [](renderGraph::PassContext& ctx)
+		{
+			ctx.commandList.BindPipeline(rhi::PipelineHandle{ 2 });
+			ctx.commandList.Draw(3);
+			ctx.commandList.SetPrimitiveTopology(rhi::PrimitiveTopology::LineList);
+			ctx.commandList.Draw(2);
+		}, false, { renderGraph::Read(color) });
+
+	rendern::RendererFrameStats stats{};
+	graph.Execute(*device, *swapChain, pool, &stats);
+
+	ASSERT_EQ(stats.passes.size(), 3u);
+	EXPECT_EQ(stats.passes[0].name, "Shadow");
+	EXPECT_EQ(stats.passes[2].name, "Present");
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		EXPECT_EQ(stats.passes[i].drawCalls, 1u) << "pass " << i;
+		EXPECT_EQ(stats.passes[i].instances, 4u) << "pass " << i;
+		EXPECT_EQ(stats.passes[i].triangles, 48u) << "pass " << i;
+		EXPECT_EQ(stats.passes[i].pipelineBinds, 1u) << "pass " << i;
+	}
+	EXPECT_EQ(stats.passes[0].barriers, 1u);
+	EXPECT_EQ(stats.passes[2].drawCalls, 2u);
+	EXPECT_EQ(stats.passes[2].triangles, 1u);
+	EXPECT_EQ(stats.passes[2].barriers, 1u);
+
+	EXPECT_EQ(stats.drawCalls, 4u);
+	EXPECT_EQ(stats.instances, 10u);
+	EXPECT_EQ(stats.triangles, 97u);
+	EXPECT_EQ(stats.pipelineBinds, 3u);
+	EXPECT_EQ(stats.graphPassesCulled, 1u);
+	EXPECT_EQ(stats.transientTextures, 1u);
+	EXPECT_EQ(stats.transientTexturesCreated, 1u);
+	EXPECT_EQ(stats.transientFramebuffersCreated, 1u);
+}
+
+TEST(RenderGraph, CommandListAppendKeepsOrder)
+{
+	rhi::CommandList list;
+	list.SetStencilRef(1);
+
+	rhi::CommandList other;
+	other.SetStencilRef(2);
+	other.SetStencilRef(3);
+	list.Append(std::move(other));
+
+	ASSERT_EQ(list.Size(), 3u);
+	std::uint32_t expected = 1;
+	for (const rhi::CommandRecord record : list)
+	{
+		const auto* stencil = record.GetIf<rhi::CommandSetStencilRef>();
+		ASSERT_NE(stencil, nullptr);
+		EXPECT_EQ(stencil->ref, expected++);
+	}
+	EXPECT_TRUE(other.Empty());
+	EXPECT_EQ(other.begin(), other.end());
+}
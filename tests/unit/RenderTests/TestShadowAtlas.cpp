@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+import core;
+
+using rendern::PackShadowAtlas;
+using rendern::ShadowAtlasAllocator;
+using rendern::ShadowAtlasTile;
+
+namespace
+{
+	bool Overlap(const ShadowAtlasTile& a, const ShadowAtlasTile& b)
+	{
+		return a.x < b.x + b.size && b.x < a.x + a.size && a.y < b.y + b.size && b.y < a.y + a.size;
+	}
+}
+
+TEST(ShadowAtlasAllocator, SplitsTheAtlasIntoQuadrants)
+{
+	ShadowAtlasAllocator allocator(1024u, 128u);
+
+	const ShadowAtlasTile a = allocator.Allocate(512u);
+	const ShadowAtlasTile b = allocator.Allocate(512u);
+	const ShadowAtlasTile c = allocator.Allocate(300u); // rounded up to 512
+	const ShadowAtlasTile d = allocator.Allocate(512u);
+
+	ASSERT_TRUE(a.Valid() && b.Valid() && c.Valid() && d.Valid());
+	EXPECT_EQ(c.size, 512u);
+	EXPECT_EQ(a.x, 0u);
+	EXPECT_EQ(a.y, 0u);
+	EXPECT_EQ(b.x, 512u);
+	EXPECT_EQ(b.y, 0u);
+	EXPECT_EQ(c.x, 0u);
+	EXPECT_EQ(c.y, 512u);
+	EXPECT_EQ(d.x, 512u);
+	EXPECT_EQ(d.y, 512u);
+
+	EXPECT_FALSE(allocator.Allocate(128u).Valid());
+
+	allocator.Reset(1024u, 128u);
+	EXPECT_EQ(allocator.Allocate(1024u).size, 1024u);
+}
+
+TEST(ShadowAtlasAllocator, SmallRequestsAreClampedToTheMinimumTile)
+{
+	ShadowAtlasAllocator allocator(512u, 128u);
+	for (int i = 0; i < 16; ++i)
+	{
+		EXPECT_EQ(allocator.Allocate(16u).size, 128u) << i;
+	}
+	EXPECT_FALSE(allocator.Allocate(16u).Valid());
+}
+
+TEST(ShadowAtlas, PackKeepsRequestOrderAndNeverOverlaps)
+{
+	const std::vector<std::uint32_t> sizes{ 256u, 1024u, 512u, 256u, 512u };
+	std::array<ShadowAtlasTile, 5> tiles{};
+
+	EXPECT_EQ(PackShadowAtlas(sizes, 2048u, 128u, tiles), 5u);
+	for (std::size_t i = 0; i < sizes.size(); ++i)
+	{
+		EXPECT_EQ(tiles[i].size, sizes[i]);
+		EXPECT_LE(tiles[i].x + tiles[i].size, 2048u);
+		EXPECT_LE(tiles[i].y + tiles[i].size, 2048u);
+		for (std::size_t j = 0; j < i; ++j)
+		{
+			EXPECT_FALSE(Overlap(tiles[i], tiles[j])) << i << " overlaps " << j;
+		}
+	}
+	// The largest request is placed first, in the top left corner.
+	EXPECT_EQ(tiles[1].x, 0u);
+	EXPECT_EQ(tiles[1].y, 0u);
+}
+
+TEST(ShadowAtlas, OverfullAtlasShrinksTilesInsteadOfDroppingLights)
+{
+	// Five full-size requests: the earlier ones keep the larger tiles, and every light still gets one.
+	const std::vector<std::uint32_t> sizes{ 1024u, 1024u, 1024u, 1024u, 1024u };
+	std::array<ShadowAtlasTile, 5> tiles{};
+
+	EXPECT_EQ(PackShadowAtlas(sizes, 1024u, 256u, tiles), 5u);
+	EXPECT_EQ(tiles[0].size, 512u);
+	EXPECT_EQ(tiles[1].size, 512u);
+	EXPECT_EQ(tiles[2].size, 512u);
+	EXPECT_EQ(tiles[3].size, 256u);
+	EXPECT_EQ(tiles[4].size, 256u);
+	for (std::size_t i = 0; i < tiles.size(); ++i)
+	{
+		for (std::size_t j = 0; j < i; ++j)
+		{
+			EXPECT_FALSE(Overlap(tiles[i], tiles[j])) << i << " overlaps " << j;
+		}
+	}
+}
+
+TEST(ShadowAtlas, RequestsBeyondTheMinimumTilesGetNoTile)
+{
+	// A 512 atlas holds sixteen 128 tiles: the first sixteen requests get one, the rest none.
+	const std::vector<std::uint32_t> sizes(20u, 256u);
+	std::array<ShadowAtlasTile, 20> tiles{};
+
+	EXPECT_EQ(PackShadowAtlas(sizes, 512u, 128u, tiles), 16u);
+	for (std::size_t i = 0; i < tiles.size(); ++i)
+	{
+		EXPECT_EQ(tiles[i].size, i < 16 ? 128u : 0u) << i;
+	}
+}
+
+TEST(ShadowAtlas, TileSizeFollowsScreenCoverage)
+{
+	EXPECT_EQ(rendern::SpotShadowTileSize(1.0f, 2048u, 128u), 2048u);
+	EXPECT_EQ(rendern::SpotShadowTileSize(2.0f, 2048u, 128u), 2048u);
+	EXPECT_EQ(rendern::SpotShadowTileSize(0.5f, 2048u, 128u), 1024u);
+	EXPECT_EQ(rendern::SpotShadowTileSize(0.3f, 2048u, 128u), 1024u); // rounded up
+	EXPECT_EQ(rendern::SpotShadowTileSize(0.01f, 2048u, 128u), 128u);
+	EXPECT_EQ(rendern::SpotShadowTileSize(0.0f, 2048u, 128u), 128u);
+}
+
+TEST(ShadowAtlas, SpotBoundingSphereContainsTheCone)
+{
+	const mathUtils::Vec3 position(1.0f, 2.0f, 3.0f);
+	const mathUtils::Vec3 direction(0.0f, 0.0f, -2.0f);
+	for (const float halfAngleDeg : { 10.0f, 30.0f, 45.0f, 60.0f, 80.0f })
+	{
+		const float range = 10.0f;
+		const mathUtils::Vec4 sphere = rendern::SpotLightBoundingSphere(position, direction, range, halfAngleDeg);
+		const mathUtils::Vec3 center(sphere.x, sphere.y, sphere.z);
+
+		const float halfAngle = mathUtils::DegToRad(halfAngleDeg);
+		const mathUtils::Vec3 rimPoint = position + mathUtils::Vec3(std::sin(halfAngle), 0.0f, -std::cos(halfAngle)) * range;
+		const mathUtils::Vec3 tip = position + mathUtils::Vec3(0.0f, 0.0f, -range);
+
+		EXPECT_LE(mathUtils::Length(position - center), sphere.w + 1e-3f) << halfAngleDeg;
+		EXPECT_LE(mathUtils::Length(rimPoint - center), sphere.w + 1e-3f) << halfAngleDeg;
+		EXPECT_LE(mathUtils::Length(tip - center), sphere.w + 1e-3f) << halfAngleDeg;
+		EXPECT_LE(sphere.w, range + 1e-3f) << halfAngleDeg;
+	}
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+import core;
+
+TEST(AssetId, HashIsStableAndFoldsAtCompileTime)
+{
+	static constexpr AssetId kLiteral{ "textures/brick.png" };
+	static_assert(kLiteral.IsValid());
+	static_assert(AssetId{ "" }.value == 0xcbf29ce484222325ull);
+	static_assert(AssetId{ "a" }.value == 0xaf63dc4c8601ec8cull);
+
+	const std::string runtime = "textures/brick.png";
+	EXPECT_EQ(AssetId{ runtime }, kLiteral);
+	EXPECT_NE(AssetId{ "textures/brick.PNG" }, kLiteral);
+}
+
+TEST(AssetId, InternRecordsNameInDebugBuilds)
+{
+	const AssetId id = InternAssetId("meshes/crate.obj");
+	EXPECT_EQ(id, AssetId{ "meshes/crate.obj" });
+#ifndef NDEBUG
+	EXPECT_EQ(AssetIdName(id), "meshes/crate.obj");
+#else
+	EXPECT_TRUE(AssetIdName(id).empty());
+#endif
+	EXPECT_TRUE(AssetIdName(AssetId{ "never interned" }).empty());
+}
+
+TEST(FlatHashMap, InsertFindEraseAcrossRehash)
+{
+	containers::FlatHashMap<AssetId, int, AssetIdHash> map;
+	for (int i = 0; i < 1000; ++i)
+	{
+		const auto [it, inserted] = map.try_emplace(AssetId{ std::to_string(i) }, i);
+		EXPECT_TRUE(inserted);
+		EXPECT_EQ(it->second, i);
+	}
+	EXPECT_EQ(map.size(), 1000u);
+	EXPECT_FALSE(map.try_emplace(AssetId{ "7" }, -1).second);
+
+	for (int i = 0; i < 1000; i += 2)
+	{
+		EXPECT_EQ(map.erase(AssetId{ std::to_string(i) }), 1u);
+	}
+	EXPECT_EQ(map.size(), 500u);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		const auto it = map.find(AssetId{ std::to_string(i) });
+		if (i % 2 == 0)
+		{
+			EXPECT_EQ(it, map.end());
+		}
+		else
+		{
+			ASSERT_NE(it, map.end());
+			EXPECT_EQ(it->second, i);
+		}
+	}
+
+	// Tombstones get reused: churn must not grow the table without bound.
+	for (int round = 0; round < 20; ++round)
+	{
+		for (int i = 0; i < 1000; i += 2)
+		{
+			map[AssetId{ std::to_string(i) }] = round;
+		}
+		for (int i = 0; i < 1000; i += 2)
+		{
+			map.erase(AssetId{ std::to_string(i) });
+		}
+	}
+	EXPECT_EQ(map.size(), 500u);
+}
+
+TEST(FlatHashMap, EraseWhileIteratingVisitsEveryElementOnce)
+{
+	containers::FlatHashMap<std::uint64_t, int> map;
+	for (std::uint64_t i = 0; i < 200; ++i)
+	{
+		map.emplace(i, static_cast<int>(i));
+	}
+
+	int visited = 0;
+	for (auto it = map.begin(); it != map.end(); )
+	{
+		++visited;
+		if (it->second % 3 == 0)
+		{
+			it = map.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	EXPECT_EQ(visited, 200);
+	EXPECT_EQ(map.size(), 200u - 67u);
+	for (const auto& [key, value] : map)
+	{
+		EXPECT_NE(value % 3, 0);
+	}
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	std::filesystem::path WriteTempFile(const char* name, const std::string& contents)
+	{
+		const auto dir = std::filesystem::temp_directory_path() / "CoreEngineModuleTests";
+		std::filesystem::create_directories(dir);
+		const auto path = dir / name;
+		std::ofstream(path, std::ios::binary) << contents;
+		return path;
+	}
+}
+
+TEST(AsyncFileReader, ReadsBatchInRequestOrder)
+{
+	const auto a = WriteTempFile("async_a.bin", "first");
+	const auto b = WriteTempFile("async_b.bin", std::string(100000, 'x'));
+
+	corefs::AsyncFileReader reader{ 2 };
+	std::vector<corefs::FileReadResult> results;
+	int calls = 0;
+	reader.ReadBatch({ b, a, b }, [&](std::vector<corefs::FileReadResult>&& files)
+		{
+			++calls;
+			results = std::move(files);
+		});
+	reader.WaitIdle();
+
+	ASSERT_EQ(calls, 1);
+	ASSERT_EQ(results.size(), 3u);
+	for (const corefs::FileReadResult& result : results)
+	{
+		EXPECT_TRUE(result.Ok()) << result.error;
+	}
+	EXPECT_EQ(results[0].Bytes().size(), 100000u);
+	EXPECT_EQ(results[1].Bytes().size(), 5u);
+	EXPECT_EQ(static_cast<char>(results[1].Bytes()[0]), 'f');
+	EXPECT_EQ(results[2].Bytes().size(), 100000u);
+}
+
+TEST(AsyncFileReader, ReportsMissingFilesAndCompletesEmptyBatches)
+{
+	corefs::AsyncFileReader reader{};
+	std::vector<corefs::FileReadResult> results;
+	reader.ReadBatch({ std::filesystem::temp_directory_path() / "CoreEngineModuleTests" / "does_not_exist.bin" },
+		[&](std::vector<corefs::FileReadResult>&& files) { results = std::move(files); });
+
+	bool emptyCompleted = false;
+	reader.ReadBatch({}, [&](std::vector<corefs::FileReadResult>&& files) { emptyCompleted = files.empty(); });
+	reader.WaitIdle();
+
+	ASSERT_EQ(results.size(), 1u);
+	EXPECT_FALSE(results[0].Ok());
+	EXPECT_FALSE(results[0].error.empty());
+	EXPECT_TRUE(emptyCompleted);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+import core;
+
+namespace
+{
+	std::filesystem::path TempCookedPath(const char* name)
+	{
+		return std::filesystem::temp_directory_path() / "CoreEngineModuleTests" / name;
+	}
+}
+
+TEST(CookedAssetManifest, SaveLoadRoundTripsRecords)
+{
+	CookedAssetRecord texture{};
+	texture.kind = CookedAssetKind::Texture;
+	texture.settingsKey = 7u;
+	texture.cookKey = 0xDEADBEEFull;
+	texture.artifact = "textures/00000000deadbeef.dds";
+	texture.source = CookedFileStamp{ .path = "textures/brick wall.png", .bytes = 1234u, .writeTime = -5 };
+	texture.dependencies.push_back(CookedFileStamp{ .path = "textures/brick.json", .bytes = 3u, .writeTime = 9 });
+
+	CookedAssetRecord mesh = texture;
+	mesh.kind = CookedAssetKind::Mesh;
+	mesh.dependencies.clear();
+
+	CookedAssetManifest manifest{};
+	manifest.Upsert(texture);
+	manifest.Upsert(mesh);
+	manifest.Upsert(mesh);
+
+	const auto path = TempCookedPath("manifest.txt");
+	ASSERT_TRUE(manifest.Save(path));
+
+	const CookedAssetManifest loaded = CookedAssetManifest::Load(path);
+	EXPECT_EQ(loaded.Size(), 2u);
+
+	const CookedAssetRecord* found = loaded.Find(CookedAssetKind::Texture, "textures/brick wall.png", 7u);
+	ASSERT_NE(found, nullptr);
+	EXPECT_EQ(found->cookKey, 0xDEADBEEFull);
+	EXPECT_EQ(found->artifact, texture.artifact);
+	EXPECT_EQ(found->source.bytes, 1234u);
+	EXPECT_EQ(found->source.writeTime, -5);
+	ASSERT_EQ(found->dependencies.size(), 1u);
+	EXPECT_EQ(found->dependencies[0].path, "textures/brick.json");
+
+	// Different import settings are a different record.
+	EXPECT_EQ(loaded.Find(CookedAssetKind::Texture, "textures/brick wall.png", 8u), nullptr);
+	EXPECT_TRUE(CookedAssetManifest::Load(TempCookedPath("missing_manifest.txt")).Empty());
+}
+
+TEST(CookedAssetManifest, NormalizesSourcePaths)
+{
+	EXPECT_EQ(NormalizeCookedAssetPath("./models/../models/a.obj"), "models/a.obj");
+	EXPECT_EQ(NormalizeCookedAssetPath(std::filesystem::absolute(corefs::FindAssetRoot()) / "models" / "b.obj"), "models/b.obj");
+}
+
+TEST(CookedAnimation, RoundTripsClipsAndRejectsStaleKeys)
+{
+	rendern::BoneAnimationChannel channel{};
+	channel.boneIndex = 3;
+	channel.boneName = "hips";
+	channel.translationKeys.push_back(rendern::TranslationKey{ 1.0f, mathUtils::Vec3(1.0f, 2.0f, 3.0f) });
+	channel.rotationKeys.push_back(rendern::RotationKey{ 2.0f, mathUtils::Vec4(0.0f, 0.0f, 0.0f, 1.0f) });
+
+	rendern::AnimationClip walk{};
+	walk.name = "walk";
+	walk.durationTicks = 10.0f;
+	walk.looping = false;
+	walk.channels.push_back(channel);
+
+	const std::vector<rendern::AnimationClip> clips{ walk, rendern::AnimationClip{} };
+	const auto path = TempCookedPath("clips.cclip");
+	rendern::WriteCookedClips(path, 42u, clips);
+
+	const std::optional<std::vector<rendern::AnimationClip>> loaded = rendern::ReadCookedClips(path, 42u);
+	ASSERT_TRUE(loaded.has_value());
+	ASSERT_EQ(loaded->size(), 2u);
+	EXPECT_EQ((*loaded)[0].name, "walk");
+	EXPECT_FALSE((*loaded)[0].looping);
+	ASSERT_EQ((*loaded)[0].channels.size(), 1u);
+	EXPECT_EQ((*loaded)[0].channels[0].boneIndex, 3);
+	EXPECT_EQ((*loaded)[0].channels[0].boneName, "hips");
+	EXPECT_FLOAT_EQ((*loaded)[0].channels[0].translationKeys[0].value.y, 2.0f);
+	EXPECT_TRUE((*loaded)[1].channels.empty());
+
+	EXPECT_FALSE(rendern::ReadCookedClips(path, 43u).has_value());
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3u);
+	EXPECT_FALSE(rendern::ReadCookedClips(path, std::nullopt).has_value());
+}
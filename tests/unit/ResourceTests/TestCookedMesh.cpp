@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+import core;
+
+namespace
+{
+	rendern::MeshCPU MakeTriangle()
+	{
+		rendern::MeshCPU cpu{};
+		cpu.vertices = {
+			rendern::VertexDesc{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+			rendern::VertexDesc{ 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+			rendern::VertexDesc{ 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+		};
+		cpu.indices = { 0u, 1u, 2u };
+		return cpu;
+	}
+
+	std::filesystem::path TempCookedPath(const char* name)
+	{
+		return std::filesystem::temp_directory_path() / "CoreEngineModuleTests" / name;
+	}
+}
+
+TEST(CookedMesh, RoundTripsVerticesIndicesAndBounds)
+{
+	const rendern::MeshCPU cpu = MakeTriangle();
+	rendern::CookedMeshBounds bounds{};
+	bounds.aabbMax[0] = 1.0f;
+	bounds.aabbMax[1] = 2.0f;
+	bounds.sphereRadius = 1.5f;
+
+	const auto path = TempCookedPath("roundtrip.cmesh");
+	rendern::WriteCookedMesh(path, 0x1234u, cpu, bounds);
+
+	const std::optional<rendern::CookedMesh> cooked = rendern::OpenCookedMesh(path, 0x1234u);
+	ASSERT_TRUE(cooked.has_value());
+	ASSERT_EQ(cooked->Vertices().size(), cpu.vertices.size());
+	ASSERT_EQ(cooked->Indices().size(), cpu.indices.size());
+	for (std::size_t i = 0; i < cpu.vertices.size(); ++i)
+	{
+		EXPECT_EQ(cooked->Vertices()[i].px, cpu.vertices[i].px);
+		EXPECT_EQ(cooked->Vertices()[i].py, cpu.vertices[i].py);
+		EXPECT_EQ(cooked->Vertices()[i].tw, cpu.vertices[i].tw);
+		EXPECT_EQ(cooked->Indices()[i], cpu.indices[i]);
+	}
+	EXPECT_EQ(cooked->Bounds().aabbMax[1], 2.0f);
+	EXPECT_EQ(cooked->Bounds().sphereRadius, 1.5f);
+}
+
+TEST(CookedMesh, RoundTripsLodRanges)
+{
+	rendern::MeshCPU cpu = MakeTriangle();
+	cpu.indices = { 0u, 1u, 2u, 0u, 1u, 2u, 0u, 2u, 1u };
+	cpu.lods = { { 0u, 6u }, { 6u, 3u } };
+
+	const auto path = TempCookedPath("lods.cmesh");
+	rendern::WriteCookedMesh(path, 0x99u, cpu, rendern::CookedMeshBounds{});
+
+	const std::optional<rendern::CookedMesh> cooked = rendern::OpenCookedMesh(path, 0x99u);
+	ASSERT_TRUE(cooked.has_value());
+	ASSERT_EQ(cooked->Lods().size(), 2u);
+	EXPECT_EQ(cooked->Lods()[1].firstIndex, 6u);
+	EXPECT_EQ(cooked->Lods()[1].indexCount, 3u);
+	EXPECT_EQ(cooked->Indices().size(), 9u);
+
+	// Without levels the header stores none.
+	rendern::WriteCookedMesh(path, 0x99u, MakeTriangle(), rendern::CookedMeshBounds{});
+	EXPECT_TRUE(rendern::OpenCookedMesh(path, 0x99u)->Lods().empty());
+}
+
+TEST(CookedMesh, RejectsStaleKeyAndTruncatedFile)
+{
+	const auto path = TempCookedPath("stale.cmesh");
+	rendern::WriteCookedMesh(path, 7u, MakeTriangle(), rendern::CookedMeshBounds{});
+
+	EXPECT_FALSE(rendern::OpenCookedMesh(path, 8u).has_value());
+
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4u);
+	EXPECT_FALSE(rendern::OpenCookedMesh(path, 7u).has_value());
+
+	EXPECT_FALSE(rendern::OpenCookedMesh(TempCookedPath("missing.cmesh"), 7u).has_value());
+}
+
+TEST(CookedMesh, CookKeyTracksSourceBytesAndSettings)
+{
+	const auto source = TempCookedPath("source.obj");
+	std::filesystem::create_directories(source.parent_path());
+	{
+		std::ofstream out(source, std::ios::binary | std::ios::trunc);
+		out << "v 0 0 0\n";
+	}
+
+	const std::array<std::byte, 1> settingsA{ std::byte{ 0 } };
+	const std::array<std::byte, 1> settingsB{ std::byte{ 1 } };
+	const std::uint64_t keyA = rendern::ComputeMeshCookKey(source, settingsA);
+	EXPECT_EQ(keyA, rendern::ComputeMeshCookKey(source, settingsA));
+	EXPECT_NE(keyA, rendern::ComputeMeshCookKey(source, settingsB));
+
+	{
+		std::ofstream out(source, std::ios::binary | std::ios::trunc);
+		out << "v 0 0 1\n";
+	}
+	EXPECT_NE(keyA, rendern::ComputeMeshCookKey(source, settingsA));
+}
+
+TEST(CookedMesh, CookKeysUseTheSharedFnv1a)
+{
+	const std::array<std::byte, 1> a{ std::byte{ 'a' } };
+	EXPECT_EQ(rendern::HashCookBytes({}), hashUtils::kFnv1a64Offset);
+	EXPECT_EQ(rendern::HashCookBytes(a), 0xaf63dc4c8601ec8cull);
+	EXPECT_EQ(rendern::HashCookBytes(a), hashUtils::Fnv1a64("a"));
+	EXPECT_EQ(rendern::HashCookBytes(a, 42u), hashUtils::Fnv1a64("a", 42u));
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	void PutU32(std::vector<unsigned char>& out, std::uint32_t v)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			out.push_back(static_cast<unsigned char>((v >> (8 * i)) & 0xFFu));
+		}
+	}
+
+	// Legacy-header DDS with a DXT1 (BC1) payload of `mips` levels.
+	std::filesystem::path WriteBc1Dds(const char* name, std::uint32_t width, std::uint32_t height, std::uint32_t mips)
+	{
+		std::vector<unsigned char> bytes;
+		PutU32(bytes, 0x20534444u); // "DDS "
+		PutU32(bytes, 124u);        // header size
+		PutU32(bytes, 0x1007u | 0x20000u); // CAPS|HEIGHT|WIDTH|PIXELFORMAT|MIPMAPCOUNT
+		PutU32(bytes, height);
+		PutU32(bytes, width);
+		PutU32(bytes, 0u);
+		PutU32(bytes, 0u);
+		PutU32(bytes, mips);
+		for (int i = 0; i < 11; ++i)
+		{
+			PutU32(bytes, 0u);
+		}
+		PutU32(bytes, 32u);  // pixel format size
+		PutU32(bytes, 0x4u); // FOURCC
+		PutU32(bytes, 0x31545844u); // "DXT1"
+		for (int i = 0; i < 5; ++i)
+		{
+			PutU32(bytes, 0u);
+		}
+		PutU32(bytes, 0x1000u); // caps
+		for (int i = 0; i < 4; ++i)
+		{
+			PutU32(bytes, 0u);
+		}
+
+		for (std::uint32_t mip = 0; mip < mips; ++mip)
+		{
+			const std::uint32_t w = std::max(1u, width >> mip);
+			const std::uint32_t h = std::max(1u, height >> mip);
+			const std::size_t size = TextureMipBytes(TextureFormat::BC1, w, h);
+			bytes.insert(bytes.end(), size, static_cast<unsigned char>(mip + 1u));
+		}
+
+		const auto path = std::filesystem::temp_directory_path() / "CoreEngineModuleTests" / name;
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		return path;
+	}
+}
+
+TEST(TextureFormats, BlockCompressedMipSizesRoundUpToBlocks)
+{
+	EXPECT_EQ(TextureMipBytes(TextureFormat::RGBA, 3u, 2u), 24u);
+	EXPECT_EQ(TextureMipBytes(TextureFormat::BC1, 8u, 8u), 32u);
+	EXPECT_EQ(TextureMipBytes(TextureFormat::BC1, 1u, 1u), 8u);
+	EXPECT_EQ(TextureMipBytes(TextureFormat::BC7, 2u, 6u), 32u);
+	EXPECT_EQ(TextureRowCount(TextureFormat::BC3, 5u), 2u);
+}
+
+TEST(DdsTextureDecoder, KeepsBakedBc1MipsUntouched)
+{
+	const auto path = WriteBc1Dds("bc1.dds", 8u, 8u, 4u);
+
+	TextureProperties props{};
+	props.filePath = path.string();
+	DdsTextureDecoder decoder{};
+	const std::optional<TextureCPUData> cpu = decoder.Decode(props, path.string());
+
+	ASSERT_TRUE(cpu.has_value());
+	EXPECT_EQ(cpu->format, TextureFormat::BC1);
+	EXPECT_EQ(cpu->width, 8u);
+	ASSERT_EQ(cpu->mips.size(), 4u);
+	EXPECT_EQ(cpu->mips[0].pixels.size(), 32u);
+	EXPECT_EQ(cpu->mips[3].width, 1u);
+	EXPECT_EQ(cpu->mips[3].pixels.size(), 8u);
+	EXPECT_EQ(cpu->mips[2].pixels.front(), 3u);
+}
+
+TEST(DdsTextureDecoder, RejectsTruncatedPayload)
+{
+	const auto path = WriteBc1Dds("bc1_truncated.dds", 8u, 8u, 4u);
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1u);
+
+	TextureProperties props{};
+	DdsTextureDecoder decoder{};
+	EXPECT_THROW((void)decoder.Decode(props, path.string()), std::runtime_error);
+}
+
+TEST(DdsTextureDecoder, RejectsHeaderLargerThanThePayloadBeforeAllocating)
+{
+	// A 16384 x 16384 BC1 header (128 MiB base level) over an empty payload.
+	const auto path = WriteBc1Dds("bc1_header_only.dds", 16384u, 16384u, 0u);
+
+	TextureProperties props{};
+	DdsTextureDecoder decoder{};
+	try
+	{
+		(void)decoder.Decode(props, path.string());
+		FAIL() << "expected a truncated-file error";
+	}
+	catch (const std::runtime_error& e)
+	{
+		EXPECT_NE(std::string(e.what()).find("truncated file"), std::string::npos) << e.what();
+	}
+}
+
+TEST(DdsTextureDecoder, RejectsSizesAboveTheDeviceLimit)
+{
+	const auto path = WriteBc1Dds("bc1_oversized.dds", 65532u, 65532u, 0u);
+
+	TextureProperties props{};
+	DdsTextureDecoder decoder{};
+	EXPECT_THROW((void)decoder.Decode(props, path.string()), std::runtime_error);
+}
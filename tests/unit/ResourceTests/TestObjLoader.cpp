@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+import core;
+
+namespace
+{
+	// Grid of quads with shared positions, per-face normals and a mix of corner forms, relative
+	// indices and comments; big enough to split into many chunks.
+	std::string MakeObjText(std::uint32_t side)
+	{
+		std::string text = "# generated\r\no grid\n";
+		for (std::uint32_t y = 0; y <= side; ++y)
+		{
+			for (std::uint32_t x = 0; x <= side; ++x)
+			{
+				text += "v " + std::to_string(x * 0.5f) + " " + std::to_string(y * 0.25f) + " " + std::to_string((x ^ y) * 0.125f) + "\n";
+				text += "vt " + std::to_string(x / static_cast<float>(side)) + "\t" + std::to_string(y / static_cast<float>(side)) + "\n";
+			}
+		}
+		const std::uint32_t row = side + 1;
+		for (std::uint32_t y = 0; y < side; ++y)
+		{
+			for (std::uint32_t x = 0; x < side; ++x)
+			{
+				text += ((x + y) % 2 == 0) ? "vn 0 0 1\n" : "vn 0.6 0 0.8\r\n";
+				const std::uint32_t a = y * row + x + 1;
+				const std::uint32_t b = a + 1;
+				const std::uint32_t c = a + row + 1;
+				const std::uint32_t d = a + row;
+				switch ((x + 2 * y) % 4)
+				{
+				case 0:
+					text += "f " + std::to_string(a) + "/" + std::to_string(a) + "/-1 " + std::to_string(b) + "/" + std::to_string(b) + "/-1 "
+						+ std::to_string(c) + "/" + std::to_string(c) + "/-1 " + std::to_string(d) + "/" + std::to_string(d) + "/-1\n";
+					break;
+				case 1:
+					text += "f " + std::to_string(a) + "//-1 " + std::to_string(b) + "//-1 " + std::to_string(c) + "//-1\n";
+					text += "f " + std::to_string(a) + " " + std::to_string(c) + " " + std::to_string(d) + "\n";
+					break;
+				case 2:
+					text += "f  " + std::to_string(a) + "/" + std::to_string(a) + "   " + std::to_string(b) + "/" + std::to_string(b) + " "
+						+ std::to_string(c) + "/" + std::to_string(c) + " " + std::to_string(d) + "/" + std::to_string(d) + " \r\n";
+					break;
+				default:
+					text += "s off\nf " + std::to_string(a) + "/" + std::to_string(a) + "/-1 " + std::to_string(b) + "/" + std::to_string(b) + "/-1 "
+						+ std::to_string(c) + "/" + std::to_string(c) + "/-1\n";
+					break;
+				}
+			}
+		}
+		return text;
+	}
+
+	void ExpectSameMesh(const rendern::MeshCPU& actual, const rendern::MeshCPU& expected)
+	{
+		ASSERT_EQ(actual.vertices.size(), expected.vertices.size());
+		ASSERT_EQ(actual.indices, expected.indices);
+		for (std::size_t i = 0; i < expected.vertices.size(); ++i)
+		{
+			const rendern::VertexDesc& a = actual.vertices[i];
+			const rendern::VertexDesc& e = expected.vertices[i];
+			ASSERT_EQ(a.px, e.px);
+			ASSERT_EQ(a.py, e.py);
+			ASSERT_EQ(a.pz, e.pz);
+			ASSERT_EQ(a.nx, e.nx);
+			ASSERT_EQ(a.ny, e.ny);
+			ASSERT_EQ(a.nz, e.nz);
+			ASSERT_EQ(a.u, e.u);
+			ASSERT_EQ(a.v, e.v);
+		}
+	}
+}
+
+TEST(ObjLoader, FastParserMatchesTheReference)
+{
+	const std::string text = MakeObjText(24);
+	const rendern::MeshCPU expected = rendern::ParseObjReference(text);
+	ASSERT_FALSE(expected.indices.empty());
+
+	ExpectSameMesh(rendern::ParseObj(text), expected);
+}
+
+TEST(ObjLoader, ChunkedParseMatchesTheReference)
+{
+	const std::string text = MakeObjText(40);
+	const rendern::MeshCPU expected = rendern::ParseObjReference(text);
+
+	// Relative indices and faces straddle chunk boundaries at every split.
+	for (const std::size_t chunkBytes : { std::size_t{ 64 }, std::size_t{ 997 }, std::size_t{ 4096 } })
+	{
+		rendern::ObjParseOptions options{};
+		options.maxThreads = 8;
+		options.minChunkBytes = chunkBytes;
+		ExpectSameMesh(rendern::ParseObj(text, options), expected);
+	}
+}
+
+TEST(ObjLoader, HandlesMissingTrailingNewlineAndDegenerateFaces)
+{
+	const std::string text = "v 0 0 0\nv 1 0 0\nv 0 1 0\nv +1 1 0\nf 1 2\nf 1 2 3\nf -3 -1 -2";
+	const rendern::MeshCPU mesh = rendern::ParseObj(text);
+	ExpectSameMesh(mesh, rendern::ParseObjReference(text));
+	ASSERT_EQ(mesh.indices.size(), 6u);
+	EXPECT_EQ(mesh.vertices.size(), 4u);
+	EXPECT_EQ(mesh.vertices[3].px, 1.0f);
+}
+
+TEST(ObjLoader, RejectsIndicesOutsideTheFile)
+{
+	EXPECT_THROW((void)rendern::ParseObj("v 0 0 0\nv 1 0 0\nf 1 2 3\n"), std::runtime_error);
+	EXPECT_THROW((void)rendern::ParseObj("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 -4\n"), std::runtime_error);
+	EXPECT_THROW((void)rendern::ParseObj("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1/1 2 3\n"), std::runtime_error);
+	EXPECT_THROW((void)rendern::ParseObj("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 x 3\n"), std::runtime_error);
+}
+
+TEST(ObjLoader, LoadsFromAMappedFile)
+{
+	const auto path = std::filesystem::temp_directory_path() / "CoreEngineModuleTests" / "grid.obj";
+	std::filesystem::create_directories(path.parent_path());
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out << MakeObjText(8);
+	}
+
+	const rendern::MeshCPU mesh = rendern::LoadObj(path);
+	const rendern::MeshCPU reference = rendern::LoadObjReference(path);
+	ExpectSameMesh(mesh, reference);
+	ASSERT_EQ(mesh.vertices.size(), reference.vertices.size());
+	for (std::size_t i = 0; i < mesh.vertices.size(); ++i)
+	{
+		EXPECT_EQ(mesh.vertices[i].tx, reference.vertices[i].tx);
+		EXPECT_EQ(mesh.vertices[i].tw, reference.vertices[i].tw);
+	}
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <span>
+#include <string>
+
+import core;
+
+namespace
+{
+	std::filesystem::path TempPackDir(const char* name)
+	{
+		const auto dir = std::filesystem::temp_directory_path() / "CoreEngineModuleTests" / name;
+		std::filesystem::remove_all(dir);
+		std::filesystem::create_directories(dir / "root");
+		return dir;
+	}
+
+	std::string RandomBytes(std::size_t count)
+	{
+		std::mt19937 rng(7u);
+		std::string bytes(count, '\0');
+		for (char& c : bytes)
+		{
+			c = static_cast<char>(rng());
+		}
+		return bytes;
+	}
+}
+
+TEST(PackFile, MountedPackServesReadsTransparently)
+{
+	const auto dir = TempPackDir("pack_mount");
+	const std::string text(100000, 'a');
+	const std::string noise = RandomBytes(5000);
+	{
+		corefs::PackWriter writer(dir / "assets.pak");
+		EXPECT_TRUE(writer.Add("Shaders\\Foo.HLSL", std::as_bytes(std::span(text)), 42));
+		EXPECT_TRUE(writer.Add("textures/noise.bin", std::as_bytes(std::span(noise)), 7));
+		EXPECT_TRUE(writer.Add("empty.txt", {}, 1));
+		EXPECT_FALSE(writer.Add("shaders/foo.hlsl", {}, 1));
+		writer.Finish();
+	}
+
+	corefs::MountPack(dir / "assets.pak", dir / "root");
+
+	// LZ4 entry, looked up case-insensitively with either separator.
+	EXPECT_EQ(corefs::ReadAllText(dir / "root" / "shaders" / "foo.hlsl"), text);
+	EXPECT_TRUE(corefs::AssetFileExists(dir / "root" / "SHADERS\\foo.hlsl"));
+	EXPECT_FALSE(corefs::AssetFileExists(dir / "root" / "missing.txt"));
+	EXPECT_TRUE(corefs::ReadBinaryFile(dir / "root" / "empty.txt").data.empty());
+
+	// Incompressible entry: stored, and mapped straight out of the page-aligned archive.
+	{
+		const corefs::MappedFile mapped(dir / "root" / "textures" / "noise.bin");
+		ASSERT_EQ(mapped.Size(), noise.size());
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.Bytes().data()) % 4096u, 0u);
+		EXPECT_EQ(std::memcmp(mapped.Bytes().data(), noise.data(), noise.size()), 0);
+
+		// Views outlive the mount.
+		EXPECT_TRUE(corefs::UnmountPack(dir / "assets.pak"));
+		EXPECT_EQ(std::memcmp(mapped.Bytes().data(), noise.data(), noise.size()), 0);
+	}
+
+	EXPECT_FALSE(corefs::AssetFileExists(dir / "root" / "textures" / "noise.bin"));
+	corefs::MountPack(dir / "assets.pak", dir / "root");
+	const auto stat = corefs::StatAssetFile(dir / "root" / "textures" / "noise.bin");
+	ASSERT_TRUE(stat.has_value());
+	EXPECT_EQ(stat->bytes, noise.size());
+	EXPECT_EQ(stat->writeTime.time_since_epoch().count(), 7);
+	corefs::UnmountAllPacks();
+}
+
+TEST(PackFile, RejectsMalformedArchives)
+{
+	const auto dir = TempPackDir("pack_malformed");
+	{
+		corefs::PackWriter writer(dir / "bad.pak");
+		const std::string text = "hello";
+		writer.Add("a.txt", std::as_bytes(std::span(text)));
+		writer.Finish();
+	}
+
+	corefs::BinaryFile file = corefs::ReadBinaryFile(dir / "bad.pak");
+	EXPECT_NO_THROW(corefs::PackArchive(file.data, nullptr));
+
+	file.data[0] = std::byte{ 0 };
+	EXPECT_THROW(corefs::PackArchive(file.data, nullptr), std::runtime_error);
+
+	file.data.resize(16);
+	EXPECT_THROW(corefs::PackArchive(file.data, nullptr), std::runtime_error);
+}
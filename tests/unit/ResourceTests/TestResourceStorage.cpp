@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+import core;
+
+namespace
+{
+	struct CountedResource
+	{
+		std::string id;
+	};
+
+	// Counts loads; a load blocks while `release` is false and throws while `fail` is set.
+	struct LoadProbe
+	{
+		std::atomic<int> loads{ 0 };
+		std::atomic<bool> started{ false };
+		std::atomic<bool> release{ true };
+		std::atomic<bool> fail{ false };
+
+		void WaitStarted()
+		{
+			started.wait(false);
+		}
+
+		void Release()
+		{
+			release.store(true);
+			release.notify_all();
+		}
+	};
+
+	// Long enough for a second requester to reach the in-flight future of a blocked load.
+	void LetWaiterArrive()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+}
+
+template <>
+struct ResourceTraits<CountedResource>
+{
+	static std::shared_ptr<CountedResource> Load(std::string_view id, LoadProbe& probe)
+	{
+		probe.loads.fetch_add(1);
+		probe.started.store(true);
+		probe.started.notify_all();
+		probe.release.wait(false);
+		if (probe.fail.load())
+		{
+			throw std::runtime_error("load failed: " + std::string(id));
+		}
+		return std::make_shared<CountedResource>(CountedResource{ std::string(id) });
+	}
+};
+
+TEST(ResourceStorage, ConcurrentRequestsShareOneLoad)
+{
+	ResourceManager manager;
+	LoadProbe probe;
+	probe.release = false;
+
+	std::shared_ptr<CountedResource> first;
+	std::shared_ptr<CountedResource> second;
+	std::thread owner([&] { first = manager.Load<CountedResource>("storage.shared", probe); });
+	probe.WaitStarted();
+	std::thread waiter([&] { second = manager.Load<CountedResource>("storage.shared", probe); });
+	LetWaiterArrive();
+	probe.Release();
+	owner.join();
+	waiter.join();
+
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(first->id, "storage.shared");
+	EXPECT_EQ(probe.loads.load(), 1);
+	EXPECT_EQ(manager.Get<CountedResource>("storage.shared"), first);
+}
+
+TEST(ResourceStorage, WaiterGetsTheOwnersErrorAndTheNextCallRetries)
+{
+	ResourceManager manager;
+	LoadProbe probe;
+	probe.release = false;
+	probe.fail = true;
+
+	std::string ownerError;
+	std::string waiterError;
+	std::thread owner([&]
+		{
+			try { manager.Load<CountedResource>("storage.failing", probe); }
+			catch (const std::runtime_error& e) { ownerError = e.what(); }
+		});
+	probe.WaitStarted();
+	std::thread waiter([&]
+		{
+			try { manager.Load<CountedResource>("storage.failing", probe); }
+			catch (const std::runtime_error& e) { waiterError = e.what(); }
+		});
+	LetWaiterArrive();
+	probe.Release();
+	owner.join();
+	waiter.join();
+
+	EXPECT_EQ(ownerError, "load failed: storage.failing");
+	EXPECT_EQ(waiterError, ownerError);
+	EXPECT_EQ(probe.loads.load(), 1);
+	EXPECT_EQ(manager.Get<CountedResource>("storage.failing"), nullptr);
+
+	// The failure left no cache entry or in-flight load behind.
+	probe.fail = false;
+	const auto retried = manager.Load<CountedResource>("storage.failing", probe);
+	ASSERT_NE(retried, nullptr);
+	EXPECT_EQ(probe.loads.load(), 2);
+}
+
+TEST(ResourceStorage, LoadManyResolvesRepeatedIdsToOneHandle)
+{
+	ResourceManager manager;
+	LoadProbe probe;
+
+	const auto cached = manager.Load<CountedResource>("storage.many.cached", probe);
+	const std::vector<std::string_view> ids{ "storage.many.a", "storage.many.b", "storage.many.a", "storage.many.cached", "storage.many.a" };
+	const std::vector<std::shared_ptr<CountedResource>> handles = manager.LoadMany<CountedResource>(ids, probe);
+
+	ASSERT_EQ(handles.size(), ids.size());
+	ASSERT_NE(handles[0], nullptr);
+	EXPECT_EQ(handles[0]->id, "storage.many.a");
+	EXPECT_EQ(handles[2], handles[0]);
+	EXPECT_EQ(handles[4], handles[0]);
+	EXPECT_NE(handles[1], handles[0]);
+	EXPECT_EQ(handles[3], cached);
+	EXPECT_EQ(probe.loads.load(), 3); // cached + a + b
+}
+
+TEST(ResourceStorage, LoadManyRethrowsAfterResolvingEveryId)
+{
+	ResourceManager manager;
+	LoadProbe probe;
+	probe.fail = true;
+
+	const std::vector<std::string_view> ids{ "storage.many.bad", "storage.many.bad" };
+	EXPECT_THROW(manager.LoadMany<CountedResource>(ids, probe), std::runtime_error);
+	EXPECT_EQ(probe.loads.load(), 1);
+
+	probe.fail = false;
+	EXPECT_NE(manager.LoadMany<CountedResource>(ids, probe).front(), nullptr);
+	EXPECT_EQ(probe.loads.load(), 2);
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+import core;
+
+namespace
+{
+	// One worker thread, FIFO: the worst case for nested RunSubtasks.
+	class SingleWorkerJobs final : public IJobSystem
+	{
+	public:
+		using IJobSystem::Enqueue;
+
+		SingleWorkerJobs()
+			: worker_([this](std::stop_token stop) { Run(stop); })
+		{
+		}
+
+		~SingleWorkerJobs() override
+		{
+			worker_.request_stop();
+			cv_.notify_all();
+		}
+
+		void Enqueue(std::function<void()> job) override
+		{
+			{
+				std::scoped_lock lock(mutex_);
+				queue_.push_back(std::move(job));
+			}
+			cv_.notify_all();
+		}
+
+		void WaitIdle() override
+		{
+			std::unique_lock lock(mutex_);
+			cv_.wait(lock, [this] { return queue_.empty() && !busy_; });
+		}
+
+	private:
+		void Run(std::stop_token stop)
+		{
+			while (true)
+			{
+				std::function<void()> job;
+				{
+					std::unique_lock lock(mutex_);
+					cv_.wait(lock, [&] { return stop.stop_requested() || !queue_.empty(); });
+					if (queue_.empty())
+					{
+						return;
+					}
+					job = std::move(queue_.front());
+					queue_.pop_front();
+					busy_ = true;
+				}
+				job();
+				{
+					std::scoped_lock lock(mutex_);
+					busy_ = false;
+				}
+				cv_.notify_all();
+			}
+		}
+
+		std::mutex mutex_;
+		std::condition_variable cv_;
+		std::deque<std::function<void()>> queue_;
+		bool busy_{ false };
+		std::jthread worker_;
+	};
+
+	std::vector<unsigned char> MakeImage(std::uint32_t width, std::uint32_t height, std::uint32_t seed)
+	{
+		std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4u);
+		std::uint32_t state = seed;
+		for (unsigned char& p : pixels)
+		{
+			state = state * 1664525u + 1013904223u;
+			p = static_cast<unsigned char>(state >> 24);
+		}
+		return pixels;
+	}
+
+	void ExpectSameChain(const std::vector<TextureMipLevel>& actual, const std::vector<TextureMipLevel>& expected, int tolerance)
+	{
+		ASSERT_EQ(actual.size(), expected.size());
+		for (std::size_t level = 0; level < expected.size(); ++level)
+		{
+			ASSERT_EQ(actual[level].width, expected[level].width);
+			ASSERT_EQ(actual[level].height, expected[level].height);
+			ASSERT_EQ(actual[level].pixels.size(), expected[level].pixels.size());
+			for (std::size_t i = 0; i < expected[level].pixels.size(); ++i)
+			{
+				ASSERT_LE(std::abs(static_cast<int>(actual[level].pixels[i]) - static_cast<int>(expected[level].pixels[i])), tolerance)
+					<< "level " << level << " byte " << i;
+			}
+		}
+	}
+}
+
+TEST(TextureMipChain, MatchesTheReferenceForOddAndThinImages)
+{
+	const std::uint32_t sizes[][2] = { { 37, 20 }, { 1, 9 }, { 64, 1 }, { 5, 5 }, { 128, 96 } };
+	for (const auto& size : sizes)
+	{
+		const std::vector<unsigned char> image = MakeImage(size[0], size[1], size[0] * 31u + size[1]);
+
+		// Byte averages and normals are bit-exact; sRGB may round one step differently.
+		ExpectSameChain(BuildMipChainRGBA8(image, size[0], size[1], true, false, false),
+			BuildMipChainReference(image, size[0], size[1], 4, true, false, false), 0);
+		ExpectSameChain(BuildMipChainRGBA8(image, size[0], size[1], true, true, true),
+			BuildMipChainReference(image, size[0], size[1], 4, true, true, true), 0);
+		ExpectSameChain(BuildMipChainRGBA8(image, size[0], size[1], true, true, false),
+			BuildMipChainReference(image, size[0], size[1], 4, true, true, false), 1);
+	}
+}
+
+TEST(TextureMipChain, OnlyLevelZeroWithoutMips)
+{
+	const std::vector<unsigned char> image = MakeImage(16, 8, 7);
+	const std::vector<TextureMipLevel> chain = BuildMipChainRGBA8(image, 16, 8, false, true, false);
+	ASSERT_EQ(chain.size(), 1u);
+	EXPECT_EQ(chain[0].pixels, image);
+}
+
+TEST(TextureMipChain, ParallelBandsMatchTheInlineChain)
+{
+	SingleWorkerJobs jobs;
+	const std::vector<unsigned char> image = MakeImage(1024, 600, 3);
+
+	for (const bool srgb : { false, true })
+	{
+		const std::vector<TextureMipLevel> inlineChain = BuildMipChainRGBA8(image, 1024, 600, true, srgb, false);
+		ExpectSameChain(BuildMipChainRGBA8(image, 1024, 600, true, srgb, false, &jobs), inlineChain, 0);
+	}
+}
+
+TEST(TextureMipChain, RunSubtasksRunsEveryTaskOnceFromInsideAJob)
+{
+	SingleWorkerJobs jobs;
+
+	// The only worker blocks in RunSubtasks: it must finish the work itself.
+	std::vector<std::atomic<int>> runs(37);
+	std::atomic<bool> finished{ false };
+	jobs.Enqueue([&]
+		{
+			RunSubtasks(&jobs, runs.size(), [&](std::size_t i) { runs[i].fetch_add(1); });
+			finished = true;
+		});
+	jobs.WaitIdle();
+
+	EXPECT_TRUE(finished.load());
+	for (const std::atomic<int>& count : runs)
+	{
+		EXPECT_EQ(count.load(), 1);
+	}
+}
+
+TEST(TextureMipChain, RunSubtasksRethrowsAfterAllTasksFinished)
+{
+	SingleWorkerJobs jobs;
+	std::atomic<int> runs{ 0 };
+	EXPECT_THROW(RunSubtasks(&jobs, 8, [&](std::size_t i)
+		{
+			runs.fetch_add(1);
+			if (i == 3)
+			{
+				throw std::runtime_error("task failed");
+			}
+		}), std::runtime_error);
+	EXPECT_EQ(runs.load(), 8);
+	jobs.WaitIdle();
+}
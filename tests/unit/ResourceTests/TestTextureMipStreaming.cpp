@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+
+import core;
+
+namespace
+{
+	TextureCPUData MakeChain(std::uint32_t width, std::uint32_t height, std::uint32_t mipCount)
+	{
+		TextureCPUData cpu{};
+		cpu.width = width;
+		cpu.height = height;
+		cpu.channels = 4;
+		cpu.format = TextureFormat::RGBA;
+		for (std::uint32_t mip = 0; mip < mipCount; ++mip)
+		{
+			TextureMipLevel level{};
+			level.width = std::max(1u, width >> mip);
+			level.height = std::max(1u, height >> mip);
+			level.pixels.resize(TextureMipBytes(cpu.format, level.width, level.height), static_cast<unsigned char>(mip));
+			cpu.mips.push_back(std::move(level));
+		}
+		return cpu;
+	}
+}
+
+TEST(TextureMipStreaming, MipTailStartsAtFirstLevelWithinMaxDimension)
+{
+	// 1024 -> 512 -> 256 -> 128 -> 64
+	EXPECT_EQ(MipTailFirstLevel(TextureFormat::RGBA, 1024, 512, 11, 64), 4u);
+	EXPECT_EQ(MipTailFirstLevel(TextureFormat::RGBA, 32, 32, 6, 64), 0u);
+
+	// Never past the last mip.
+	EXPECT_EQ(MipTailFirstLevel(TextureFormat::RGBA, 1024, 1024, 3, 64), 2u);
+}
+
+TEST(TextureMipStreaming, MipTailKeepsBlockCompressedBaseAligned)
+{
+	// 1000x1000 BC1: 1000 -> 500 stay block aligned, 250 does not.
+	EXPECT_EQ(MipTailFirstLevel(TextureFormat::BC1, 1000, 1000, 10, 64), 1u);
+	EXPECT_EQ(MipTailFirstLevel(TextureFormat::BC7, 1024, 1024, 11, 64), 4u);
+}
+
+TEST(TextureMipStreaming, MipForScreenSizePicksCoarsestSufficientLevel)
+{
+	EXPECT_EQ(MipForScreenSize(1024, 2000.0f, 11), 0u);
+	EXPECT_EQ(MipForScreenSize(1024, 1024.0f, 11), 0u);
+	EXPECT_EQ(MipForScreenSize(1024, 300.0f, 11), 1u);
+	EXPECT_EQ(MipForScreenSize(1024, 256.0f, 11), 2u);
+	EXPECT_EQ(MipForScreenSize(1024, 0.0f, 11), 10u);
+	EXPECT_EQ(MipForScreenSize(1024, 0.0f, 0), 0u);
+}
+
+TEST(TextureMipStreaming, MipChainBytesSumsTheRequestedRange)
+{
+	EXPECT_EQ(MipChainBytes(TextureFormat::RGBA, 4, 4, 0, 3), 64u + 16u + 4u);
+	EXPECT_EQ(MipChainBytes(TextureFormat::RGBA, 4, 4, 1, 3), 16u + 4u);
+	EXPECT_EQ(MipChainBytes(TextureFormat::BC1, 8, 8, 0, 2), 32u + 8u);
+	EXPECT_EQ(MipChainBytes(TextureFormat::RGBA, 4, 4, 3, 3), 0u);
+}
+
+TEST(TextureMipStreaming, DropTopMipsRebasesTheChain)
+{
+	TextureCPUData cpu = MakeChain(16, 8, 5);
+	DropTopMips(cpu, 2);
+
+	ASSERT_EQ(cpu.mips.size(), 3u);
+	EXPECT_EQ(cpu.width, 4u);
+	EXPECT_EQ(cpu.height, 2u);
+	EXPECT_EQ(cpu.mips.front().pixels.front(), 2u);
+
+	// The last level always stays.
+	DropTopMips(cpu, 10);
+	ASSERT_EQ(cpu.mips.size(), 1u);
+	EXPECT_EQ(cpu.width, 1u);
+	EXPECT_EQ(cpu.height, 1u);
+}
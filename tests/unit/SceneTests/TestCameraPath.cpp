@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+
+import core;
+
+namespace
+{
+	rendern::CameraPath MakeLine()
+	{
+		rendern::CameraPath path{};
+		for (int i = 0; i < 4; ++i)
+		{
+			const float x = static_cast<float>(i) * 10.0f;
+			path.keys.push_back(rendern::CameraPathKey{ static_cast<float>(i), { x, 1.0f, 0.0f }, { x, 0.0f, -5.0f } });
+		}
+		return path;
+	}
+}
+
+TEST(CameraPath, PassesThroughKeysAndClampsAtTheEnds)
+{
+	const rendern::CameraPath path = MakeLine();
+	for (const rendern::CameraPathKey& key : path.keys)
+	{
+		const rendern::CameraPathKey sampled = rendern::EvaluateCameraPath(path, key.timeSeconds);
+		EXPECT_NEAR(sampled.position.x, key.position.x, 1e-4f);
+		EXPECT_NEAR(sampled.target.z, key.target.z, 1e-4f);
+	}
+
+	EXPECT_FLOAT_EQ(rendern::EvaluateCameraPath(path, -1.0f).position.x, 0.0f);
+	EXPECT_FLOAT_EQ(rendern::EvaluateCameraPath(path, 99.0f).position.x, 30.0f);
+
+	// Evenly spaced collinear keys: the spline is the straight line between them.
+	EXPECT_NEAR(rendern::EvaluateCameraPath(path, 1.5f).position.x, 15.0f, 1e-3f);
+	EXPECT_NEAR(rendern::EvaluateCameraPath(path, 1.5f).position.y, 1.0f, 1e-4f);
+}
+
+TEST(CameraPath, OrbitStaysOnTheCircle)
+{
+	const mathUtils::Vec3 center{ 1.0f, 0.0f, 2.0f };
+	const rendern::CameraPath path = rendern::MakeOrbitCameraPath(center, 5.0f, 2.0f, 8.0f);
+	EXPECT_FLOAT_EQ(path.DurationSeconds(), 8.0f);
+
+	for (float t = 0.0f; t <= 8.0f; t += 0.37f)
+	{
+		const rendern::CameraPathKey key = rendern::EvaluateCameraPath(path, t);
+		const float dx = key.position.x - center.x;
+		const float dz = key.position.z - center.z;
+		// The end segments only have one-sided tangents, so allow a little sag there.
+		EXPECT_NEAR(std::sqrt(dx * dx + dz * dz), 5.0f, 0.1f) << "t = " << t;
+		EXPECT_NEAR(key.position.y, 2.0f, 1e-4f);
+	}
+}
+
+TEST(CameraPath, RecordedPathRoundTripsThroughText)
+{
+	rendern::CameraPathRecorder recorder{ 0.5f };
+	rendern::Camera camera{};
+	for (int frame = 0; frame < 60; ++frame)
+	{
+		camera.position = { static_cast<float>(frame) * 0.1f, 2.0f, -1.0f };
+		camera.target = camera.position + mathUtils::Vec3{ 0.0f, 0.0f, -1.0f };
+		recorder.Record(0.1f, camera);
+	}
+	const rendern::CameraPath& recorded = recorder.GetPath();
+	ASSERT_GE(recorded.keys.size(), 10u);
+	ASSERT_LE(recorded.keys.size(), 13u);
+
+	const std::filesystem::path file = std::filesystem::temp_directory_path() / "camera_path_test.txt";
+	rendern::SaveCameraPath(file, recorded);
+	const rendern::CameraPath loaded = rendern::LoadCameraPath(file);
+	std::filesystem::remove(file);
+
+	ASSERT_EQ(loaded.keys.size(), recorded.keys.size());
+	for (std::size_t i = 0; i < loaded.keys.size(); ++i)
+	{
+		EXPECT_NEAR(loaded.keys[i].timeSeconds, recorded.keys[i].timeSeconds, 1e-5f);
+		EXPECT_NEAR(loaded.keys[i].position.x, recorded.keys[i].position.x, 1e-5f);
+		EXPECT_NEAR(loaded.keys[i].target.z, recorded.keys[i].target.z, 1e-5f);
+	}
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+import core;
+
+namespace
+{
+	// A row of cells along +X, cell i covering [i * 10, i * 10 + 10).
+	rendern::LevelCellStreamer MakeRow(int count, std::uint64_t cellBytes, std::uint64_t budget)
+	{
+		std::vector<rendern::LevelCell> cells(static_cast<std::size_t>(count));
+		for (int i = 0; i < count; ++i)
+		{
+			cells[static_cast<std::size_t>(i)].x = i;
+			cells[static_cast<std::size_t>(i)].sizeBytes = cellBytes;
+		}
+		rendern::LevelCellStreamer streamer;
+		streamer.Reset(rendern::LevelStreamingDef{ .cellSize = 10.0f, .loadRadius = 12.0f, .unloadRadius = 25.0f, .memoryBudgetBytes = budget }, std::move(cells));
+		return streamer;
+	}
+
+	std::vector<int> Wanted(const rendern::LevelCellStreamer& streamer)
+	{
+		std::vector<int> out;
+		const auto cells = streamer.GetCells();
+		for (std::size_t i = 0; i < cells.size(); ++i)
+		{
+			if (cells[i].wanted)
+			{
+				out.push_back(static_cast<int>(i));
+			}
+		}
+		return out;
+	}
+
+	// What LevelInstance::UpdateCellStreaming does once the loads and node work are done.
+	void Settle(rendern::LevelCellStreamer& streamer)
+	{
+		for (rendern::LevelCell& cell : streamer.GetCells())
+		{
+			cell.state = cell.wanted ? rendern::LevelCellState::Loaded : rendern::LevelCellState::Unloaded;
+		}
+	}
+}
+
+TEST(LevelCellStreamer, CellCoordFloorsNegativePositions)
+{
+	EXPECT_EQ(rendern::LevelCellStreamer::CellCoord(9.9f, 10.0f), 0);
+	EXPECT_EQ(rendern::LevelCellStreamer::CellCoord(10.0f, 10.0f), 1);
+	EXPECT_EQ(rendern::LevelCellStreamer::CellCoord(-0.1f, 10.0f), -1);
+}
+
+TEST(LevelCellStreamer, KeepsResidentCellsUntilUnloadRadius)
+{
+	rendern::LevelCellStreamer streamer = MakeRow(8, 1, 0);
+
+	streamer.UpdateWanted({ 5.0f, 0.0f, 5.0f });
+	EXPECT_EQ(Wanted(streamer), (std::vector<int>{ 0, 1 }));
+	Settle(streamer);
+
+	// Cell 0 is now 21 away: past the load radius, inside the unload radius.
+	streamer.UpdateWanted({ 31.0f, 0.0f, 5.0f });
+	EXPECT_EQ(Wanted(streamer), (std::vector<int>{ 0, 1, 2, 3, 4 }));
+	Settle(streamer);
+
+	streamer.UpdateWanted({ 36.0f, 0.0f, 5.0f });
+	EXPECT_EQ(Wanted(streamer), (std::vector<int>{ 1, 2, 3, 4 }));
+}
+
+TEST(LevelCellStreamer, BudgetKeepsNearestCellsAndFavoursResidentOnes)
+{
+	rendern::LevelCellStreamer streamer = MakeRow(8, 100, 200);
+
+	streamer.UpdateWanted({ 15.0f, 0.0f, 5.0f });
+	EXPECT_EQ(Wanted(streamer), (std::vector<int>{ 0, 1 })); // cell 2 is in range but over budget
+	EXPECT_EQ(streamer.GetOrder().front(), 1u);
+	Settle(streamer);
+	EXPECT_EQ(streamer.GetResidentBytes(), 200u);
+
+	// Cell 2 becomes slightly nearer than cell 0, which stays as long as it is within the band.
+	streamer.UpdateWanted({ 16.0f, 0.0f, 5.0f });
+	EXPECT_EQ(Wanted(streamer), (std::vector<int>{ 0, 1 }));
+}
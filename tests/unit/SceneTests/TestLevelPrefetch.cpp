@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rendern::LevelNode MeshNode(std::string mesh, std::string material = {})
+	{
+		rendern::LevelNode node{};
+		node.mesh = std::move(mesh);
+		node.material = std::move(material);
+		return node;
+	}
+
+	mathUtils::Mat4 At(float x)
+	{
+		return mathUtils::Translate(mathUtils::Mat4(1.0f), mathUtils::Vec3(x, 0.0f, 0.0f));
+	}
+}
+
+TEST(LevelPrefetch, OrdersNearestFirstAndUnplacedLast)
+{
+	rendern::LevelAsset asset{};
+	asset.meshes["far"] = rendern::LevelMeshDef{ .path = "missing/far.obj" };
+	asset.meshes["near"] = rendern::LevelMeshDef{ .path = "missing/near.obj" };
+	asset.meshes["unplaced"] = rendern::LevelMeshDef{ .path = "missing/unplaced.obj" };
+	asset.textures["farAlbedo"] = rendern::LevelTextureDef{};
+	asset.materials["farMat"] = rendern::LevelMaterialDef{ .textureBindings = { { "albedo", "farAlbedo" } } };
+	asset.nodes = { MeshNode("far", "farMat"), MeshNode("near") };
+	const std::vector<mathUtils::Mat4> world = { At(100.0f), At(2.0f) };
+
+	const rendern::LevelPrefetchManifest manifest = rendern::BuildLevelPrefetchManifest(asset, world, mathUtils::Vec3(0.0f, 0.0f, 0.0f));
+
+	ASSERT_EQ(manifest.requests.size(), 4u);
+	EXPECT_EQ(manifest.requests[0].id, "near");
+	EXPECT_FLOAT_EQ(manifest.requests[0].viewDistance, 2.0f);
+
+	// Same node: the texture ranks with the mesh it is drawn on (equal size, textures first).
+	EXPECT_EQ(manifest.requests[1].id, "farAlbedo");
+	EXPECT_FLOAT_EQ(manifest.requests[1].viewDistance, 100.0f);
+	EXPECT_EQ(manifest.requests[2].id, "far");
+
+	EXPECT_EQ(manifest.requests[3].id, "unplaced");
+	EXPECT_TRUE(std::isinf(manifest.requests[3].viewDistance));
+	EXPECT_EQ(manifest.requests[3].mesh.filePath, "missing/unplaced.obj");
+}
+
+TEST(LevelPrefetch, HiddenAndDeadNodesDontPullAssetsForward)
+{
+	rendern::LevelAsset asset{};
+	asset.meshes["a"] = rendern::LevelMeshDef{ .path = "missing/a.obj" };
+	rendern::LevelNode hidden = MeshNode("a");
+	hidden.visible = false;
+	rendern::LevelNode dead = MeshNode("a");
+	dead.alive = false;
+	asset.nodes = { hidden, dead };
+	const std::vector<mathUtils::Mat4> world = { At(1.0f), At(1.0f) };
+
+	const rendern::LevelPrefetchManifest manifest = rendern::BuildLevelPrefetchManifest(asset, world, mathUtils::Vec3(0.0f, 0.0f, 0.0f));
+
+	ASSERT_EQ(manifest.requests.size(), 1u);
+	EXPECT_TRUE(std::isinf(manifest.requests[0].viewDistance));
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	std::filesystem::path TempSnapshotPath(const char* name)
+	{
+		return std::filesystem::temp_directory_path() / "CoreEngineModuleTests" / name;
+	}
+
+	rendern::LevelAsset MakeLevel()
+	{
+		rendern::LevelAsset level{};
+		level.name = "snapshot";
+		level.meshes["crate"] = rendern::LevelMeshDef{ .path = "models/crate.obj", .submeshIndex = 2u };
+		level.textures["albedo"].props.filePath = "textures/crate.png";
+		level.textures["albedo"].facePaths[4] = "pz.png";
+		level.materials["crateMat"].material.params.roughness = 0.3f;
+		level.materials["crateMat"].textureBindings = { { "albedo", "albedo" } };
+		level.camera = rendern::Camera{};
+		level.camera->fovYDeg = 45.0f;
+		level.lights.resize(2);
+		level.lights[1].type = rendern::LightType::Spot;
+		level.particleEmitters.resize(1);
+		level.particleEmitters[0].name = "sparks";
+		level.particleEmitters[0].uvRect = { 0.5f, 0.0f, 0.5f, 0.25f };
+		level.particleEmitters[0].flipbookColumns = 4u;
+		level.skyboxTexture = "albedo";
+		level.streaming = rendern::LevelStreamingDef{ .cellSize = 32.0f, .memoryBudgetBytes = 1u << 20 };
+
+		rendern::AnimationControllerAsset controller{};
+		controller.id = "walker";
+		controller.states.resize(1);
+		controller.states[0].name = "Idle";
+		controller.states[0].tags = { "grounded" };
+		controller.transitions.resize(1);
+		controller.transitions[0].conditions.resize(2);
+		level.animationControllers["walker"] = controller;
+
+		level.nodes.resize(3);
+		level.nodes[1].alive = false;
+		level.nodes[2].parent = 0;
+		level.nodes[2].mesh = "crate";
+		level.nodes[2].transform.useMatrix = true;
+		level.nodes[2].transform.matrix[3].x = 5.0f;
+		level.nodes[2].materialOverrides = { { 0u, "crateMat" } };
+		level.nodes[2].alwaysLoaded = true;
+		return level;
+	}
+}
+
+TEST(LevelSnapshot, RoundTripsLevelAsset)
+{
+	const auto path = TempSnapshotPath("roundtrip.clvl");
+	rendern::SaveLevelSnapshot(path, MakeLevel(), {});
+
+	const std::optional<rendern::LevelAsset> level = rendern::ReadLevelSnapshot(path, true);
+	ASSERT_TRUE(level.has_value());
+	EXPECT_EQ(level->name, "snapshot");
+	EXPECT_EQ(level->meshes.at("crate").path, "models/crate.obj");
+	EXPECT_EQ(level->meshes.at("crate").submeshIndex, 2u);
+	EXPECT_EQ(level->textures.at("albedo").facePaths[4], "pz.png");
+	EXPECT_FLOAT_EQ(level->materials.at("crateMat").material.params.roughness, 0.3f);
+	EXPECT_EQ(level->materials.at("crateMat").textureBindings.at("albedo"), "albedo");
+	ASSERT_TRUE(level->camera.has_value());
+	EXPECT_FLOAT_EQ(level->camera->fovYDeg, 45.0f);
+	ASSERT_EQ(level->lights.size(), 2u);
+	EXPECT_EQ(level->lights[1].type, rendern::LightType::Spot);
+	EXPECT_EQ(level->particleEmitters.at(0).name, "sparks");
+	EXPECT_FLOAT_EQ(level->particleEmitters.at(0).uvRect.w, 0.25f);
+	EXPECT_EQ(level->particleEmitters.at(0).flipbookColumns, 4u);
+	EXPECT_EQ(level->skyboxTexture, std::optional<std::string>("albedo"));
+	ASSERT_TRUE(level->streaming.has_value());
+	EXPECT_FLOAT_EQ(level->streaming->cellSize, 32.0f);
+	EXPECT_EQ(level->streaming->memoryBudgetBytes, 1u << 20);
+	EXPECT_EQ(level->animationControllers.at("walker").states.at(0).tags.at(0), "grounded");
+	EXPECT_EQ(level->animationControllers.at("walker").transitions.at(0).conditions.size(), 2u);
+	ASSERT_EQ(level->nodes.size(), 3u);
+	EXPECT_FALSE(level->nodes[1].alive);
+	EXPECT_EQ(level->nodes[2].parent, 0);
+	EXPECT_TRUE(level->nodes[2].transform.useMatrix);
+	EXPECT_FLOAT_EQ(level->nodes[2].transform.matrix[3].x, 5.0f);
+	EXPECT_EQ(level->nodes[2].materialOverrides.at(0u), "crateMat");
+	EXPECT_TRUE(level->nodes[2].alwaysLoaded);
+}
+
+TEST(LevelSnapshot, RejectsStaleSourcesAndTruncatedFile)
+{
+	const auto path = TempSnapshotPath("stale.clvl");
+	const std::vector<CookedFileStamp> sources{ CookedFileStamp{ .path = "levels/missing.level.json", .bytes = 10u, .writeTime = 1 } };
+	rendern::SaveLevelSnapshot(path, MakeLevel(), sources);
+
+	EXPECT_FALSE(rendern::ReadLevelSnapshot(path, true).has_value());
+	EXPECT_TRUE(rendern::ReadLevelSnapshot(path, false).has_value());
+
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1u);
+	EXPECT_FALSE(rendern::ReadLevelSnapshot(path, false).has_value());
+
+	EXPECT_FALSE(rendern::ReadLevelSnapshot(TempSnapshotPath("missing.clvl"), false).has_value());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rendern::EntityHandle AddNode(rendern::LevelWorld& world, int nodeIndex, int parentIndex, bool renderable)
+	{
+		const rendern::EntityHandle e = world.CreateEntity();
+		rendern::Transform local{};
+		local.position = { static_cast<float>(nodeIndex), 0.0f, 0.0f };
+		world.EmplaceNodeData(e, nodeIndex, parentIndex, local, mathUtils::Mat4(1.0f), rendern::Flags{});
+		if (renderable)
+		{
+			world.EmplaceRenderable(e, rendern::Renderable{ .drawIndex = nodeIndex });
+		}
+		return e;
+	}
+}
+
+TEST(LevelWorld, ForEachVisitsNodesAndRenderables)
+{
+	rendern::LevelWorld world;
+	for (int i = 0; i < 6; ++i)
+	{
+		AddNode(world, i, i - 1, i % 2 == 0);
+	}
+
+	std::vector<int> nodes;
+	world.ForEachNode([&](rendern::EntityHandle entity,
+		const rendern::LevelNodeId& nodeId,
+		const rendern::ParentIndex& parent,
+		const rendern::LocalTransform& local,
+		const rendern::WorldTransform&,
+		const rendern::Flags&)
+		{
+			EXPECT_EQ(parent.parent, nodeId.index - 1);
+			EXPECT_FLOAT_EQ(local.local.position.x, static_cast<float>(nodeId.index));
+			EXPECT_EQ(world.TryGetLevelNodeIdPtr(entity)->index, nodeId.index);
+			nodes.push_back(nodeId.index);
+		});
+	std::sort(nodes.begin(), nodes.end());
+	EXPECT_EQ(nodes, (std::vector<int>{ 0, 1, 2, 3, 4, 5 }));
+
+	std::vector<int> renderables;
+	const auto collect = [&](rendern::EntityHandle,
+		const rendern::LevelNodeId& nodeId,
+		const rendern::WorldTransform&,
+		const rendern::Renderable& renderable,
+		const rendern::Flags&)
+		{
+			EXPECT_EQ(renderable.drawIndex, nodeId.index);
+			renderables.push_back(nodeId.index);
+		};
+	world.ForEachRenderable(collect);
+	std::sort(renderables.begin(), renderables.end());
+	EXPECT_EQ(renderables, (std::vector<int>{ 0, 2, 4 }));
+	EXPECT_EQ(world.GetRenderableCount(), 3u);
+}
+
+TEST(LevelWorld, GroupsFollowComponentChanges)
+{
+	rendern::LevelWorld world;
+	const rendern::EntityHandle a = AddNode(world, 0, -1, true);
+	const rendern::EntityHandle b = AddNode(world, 1, 0, false);
+
+	world.RemoveRenderable(a);
+	world.UpsertRenderable(b, rendern::Renderable{ .drawIndex = 1 });
+	world.DestroyEntity(AddNode(world, 2, 1, true));
+
+	int nodeCount = 0;
+	world.ForEachNode([&](rendern::EntityHandle, const rendern::LevelNodeId&, const rendern::ParentIndex&,
+		const rendern::LocalTransform&, const rendern::WorldTransform&, const rendern::Flags&)
+		{
+			++nodeCount;
+		});
+	EXPECT_EQ(nodeCount, 2);
+
+	std::vector<rendern::EntityHandle> renderables;
+	world.ForEachRenderable([&](rendern::EntityHandle entity, const rendern::LevelNodeId&, const rendern::WorldTransform&,
+		const rendern::Renderable&, const rendern::Flags&)
+		{
+			renderables.push_back(entity);
+		});
+	EXPECT_EQ(renderables, (std::vector<rendern::EntityHandle>{ b }));
+
+	world.Clear();
+	world.ForEachNode([&](rendern::EntityHandle, const rendern::LevelNodeId&, const rendern::ParentIndex&,
+		const rendern::LocalTransform&, const rendern::WorldTransform&, const rendern::Flags&)
+		{
+			ADD_FAILURE();
+		});
+}
@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rendern::Particle MakeParticle(float x, float lifetime, int owner = -1)
+	{
+		rendern::Particle particle{};
+		particle.position = { x, 0.0f, 0.0f };
+		particle.velocity = { 1.0f, 2.0f, -1.0f };
+		particle.colorBegin = { 1.0f, 1.0f, 1.0f, 1.0f };
+		particle.colorEnd = { 0.0f, 0.5f, 1.0f, 0.5f };
+		particle.color = particle.colorBegin;
+		particle.sizeBegin = 1.0f;
+		particle.sizeEnd = 3.0f;
+		particle.size = particle.sizeBegin;
+		particle.lifetime = lifetime;
+		particle.ownerEmitter = owner;
+		return particle;
+	}
+
+	// The frame lookup VSMainGpu does (GpuParticleFrameUvRect) on the emitter's packed uvRect/flipbook.
+	mathUtils::Vec4 GpuFrameUvRect(const mathUtils::Vec4& uvRect, const mathUtils::Vec4& flipbook, float age, float lifetime)
+	{
+		const unsigned columns = std::max(static_cast<unsigned>(flipbook.x), 1u);
+		const unsigned rows = std::max(static_cast<unsigned>(flipbook.y), 1u);
+		const unsigned frameCount = columns * rows;
+
+		unsigned frame = 0u;
+		if (frameCount > 1u)
+		{
+			if (flipbook.z > 0.0f)
+			{
+				frame = static_cast<unsigned>(std::fmod(std::max(age, 0.0f) * flipbook.z, static_cast<float>(frameCount)));
+			}
+			else if (lifetime > 0.0f)
+			{
+				frame = static_cast<unsigned>(std::clamp(age / lifetime, 0.0f, 1.0f) * static_cast<float>(frameCount));
+			}
+			frame = std::min(frame, frameCount - 1u);
+		}
+
+		const float frameW = uvRect.z / static_cast<float>(columns);
+		const float frameH = uvRect.w / static_cast<float>(rows);
+		return { uvRect.x + static_cast<float>(frame % columns) * frameW, uvRect.y + static_cast<float>(frame / columns) * frameH, frameW, frameH };
+	}
+}
+
+TEST(ParticlePool, UpdateIntegratesAndInterpolatesEveryParticle)
+{
+	// 13 particles: full SIMD steps plus a scalar tail.
+	rendern::ParticlePool pool;
+	for (int i = 0; i < 13; ++i)
+	{
+		pool.Add(MakeParticle(static_cast<float>(i), 4.0f));
+	}
+
+	pool.Update(1.0f);
+
+	ASSERT_EQ(pool.size(), 13u);
+	for (std::size_t i = 0; i < pool.size(); ++i)
+	{
+		const rendern::Particle p = pool.Get(i);
+		EXPECT_FLOAT_EQ(p.position.x, static_cast<float>(i) + 1.0f);
+		EXPECT_FLOAT_EQ(p.position.y, 2.0f);
+		EXPECT_FLOAT_EQ(p.position.z, -1.0f);
+		EXPECT_FLOAT_EQ(p.age, 1.0f);
+		EXPECT_FLOAT_EQ(p.size, 1.5f);
+		EXPECT_FLOAT_EQ(p.color.x, 0.75f);
+		EXPECT_FLOAT_EQ(p.color.y, 0.875f);
+		EXPECT_FLOAT_EQ(p.color.w, 0.875f);
+	}
+}
+
+TEST(ParticlePool, ExpiredParticlesAreSwapRemoved)
+{
+	rendern::ParticlePool pool;
+	const float lifetimes[] = { 1.0f, 5.0f, 0.5f, 5.0f, 0.0f, 1.0f, 5.0f, 5.0f, 0.25f, 5.0f };
+	for (std::size_t i = 0; i < std::size(lifetimes); ++i)
+	{
+		pool.Add(MakeParticle(static_cast<float>(i), lifetimes[i]));
+	}
+
+	pool.Update(1.0f);
+
+	// Lifetime <= 0 never expires; everything with lifetime <= 1 is gone.
+	std::vector<float> survivors;
+	for (const rendern::Particle& p : pool)
+	{
+		survivors.push_back(p.position.x - 1.0f);
+	}
+	ASSERT_EQ(survivors.size(), 6u);
+	for (float x : { 1.0f, 3.0f, 4.0f, 6.0f, 7.0f, 9.0f })
+	{
+		EXPECT_NE(std::find(survivors.begin(), survivors.end(), x), survivors.end()) << x;
+	}
+
+	// The never-expiring particle sits at the end of its life curve.
+	for (const rendern::Particle& p : pool)
+	{
+		if (p.lifetime == 0.0f)
+		{
+			EXPECT_FLOAT_EQ(p.size, 3.0f);
+			EXPECT_FLOAT_EQ(p.color.w, 0.5f);
+		}
+	}
+}
+
+TEST(ParticlePool, FadedOutParticlesAreRemoved)
+{
+	rendern::ParticlePool pool;
+	rendern::Particle shrinking = MakeParticle(0.0f, 2.0f);
+	shrinking.sizeEnd = -1.0f;
+	rendern::Particle fading = MakeParticle(1.0f, 2.0f);
+	fading.colorEnd.w = -1.0f;
+	pool.Add(shrinking);
+	pool.Add(fading);
+	pool.Add(MakeParticle(2.0f, 2.0f));
+
+	pool.Update(1.5f);
+
+	ASSERT_EQ(pool.size(), 1u);
+	EXPECT_FLOAT_EQ(pool.Get(0).position.x, 3.5f);
+}
+
+TEST(ParticlePool, TracksParticlesPerEmitter)
+{
+	rendern::ParticlePool pool;
+	for (int i = 0; i < 6; ++i)
+	{
+		pool.Add(MakeParticle(static_cast<float>(i), i < 2 ? 0.5f : 5.0f, i % 3));
+	}
+	pool.Add(MakeParticle(10.0f, 5.0f));
+
+	rendern::Particle dead = MakeParticle(20.0f, 5.0f, 0);
+	dead.alive = false;
+	pool.Add(dead);
+
+	EXPECT_EQ(pool.size(), 7u);
+	EXPECT_EQ(pool.CountOwnedBy(0), 2u);
+	EXPECT_EQ(pool.CountOwnedBy(1), 2u);
+	EXPECT_EQ(pool.CountOwnedBy(2), 2u);
+	EXPECT_EQ(pool.CountOwnedBy(3), 0u);
+	EXPECT_EQ(pool.CountOwnedBy(-1), 0u);
+
+	pool.Update(1.0f); // particles 0 (emitter 0) and 1 (emitter 1) expire
+	EXPECT_EQ(pool.CountOwnedBy(0), 1u);
+	EXPECT_EQ(pool.CountOwnedBy(1), 1u);
+	EXPECT_EQ(pool.CountOwnedBy(2), 2u);
+
+	pool.RemoveOwnedBy(2);
+	EXPECT_EQ(pool.CountOwnedBy(2), 0u);
+	EXPECT_EQ(pool.size(), 3u);
+	for (const int owner : pool.Owners())
+	{
+		EXPECT_NE(owner, 2);
+	}
+
+	pool.clear();
+	EXPECT_TRUE(pool.empty());
+	EXPECT_EQ(pool.CountOwnedBy(0), 0u);
+}
+
+TEST(ParticlePool, ParallelUpdateMatchesInlineUpdate)
+{
+	jobs::Scheduler scheduler(4);
+	rendern::ParticlePool inlinePool;
+	rendern::ParticlePool parallelPool;
+	const std::size_t count = rendern::ParticlePool::kUpdateGrain * 3 + 5;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const rendern::Particle p = MakeParticle(static_cast<float>(i), (i % 7 == 0) ? 0.5f : 5.0f);
+		inlinePool.Add(p);
+		parallelPool.Add(p);
+	}
+
+	inlinePool.Update(1.0f);
+	parallelPool.Update(1.0f, &scheduler);
+
+	ASSERT_EQ(parallelPool.size(), inlinePool.size());
+	const auto a = inlinePool.Stream(rendern::ParticleStream::PositionX);
+	const auto b = parallelPool.Stream(rendern::ParticleStream::PositionX);
+	for (std::size_t i = 0; i < a.size(); ++i)
+	{
+		ASSERT_FLOAT_EQ(a[i], b[i]) << i;
+	}
+}
+
+TEST(ParticleFlipbook, FramesPlayOverTheLifetimeInsideTheAtlasRegion)
+{
+	rendern::ParticleEmitter emitter{};
+	emitter.uvRect = { 0.5f, 0.5f, 0.5f, 0.5f };
+	emitter.flipbookColumns = 2u;
+	emitter.flipbookRows = 2u;
+
+	const mathUtils::Vec4 first = rendern::ParticleFrameUvRect(emitter, 0.0f, 4.0f);
+	EXPECT_FLOAT_EQ(first.x, 0.5f);
+	EXPECT_FLOAT_EQ(first.y, 0.5f);
+	EXPECT_FLOAT_EQ(first.z, 0.25f);
+	EXPECT_FLOAT_EQ(first.w, 0.25f);
+
+	// Frame 2 of 4 (second row, first column); the end of life stays on the last frame.
+	const mathUtils::Vec4 third = rendern::ParticleFrameUvRect(emitter, 2.5f, 4.0f);
+	EXPECT_FLOAT_EQ(third.x, 0.5f);
+	EXPECT_FLOAT_EQ(third.y, 0.75f);
+	const mathUtils::Vec4 last = rendern::ParticleFrameUvRect(emitter, 4.0f, 4.0f);
+	EXPECT_FLOAT_EQ(last.x, 0.75f);
+	EXPECT_FLOAT_EQ(last.y, 0.75f);
+}
+
+TEST(ParticleFlipbook, FixedRateLoopsAndSingleFrameUsesTheWholeRegion)
+{
+	rendern::ParticleEmitter emitter{};
+	emitter.flipbookColumns = 4u;
+	emitter.flipbookFps = 10.0f;
+
+	EXPECT_FLOAT_EQ(rendern::ParticleFrameUvRect(emitter, 0.25f, 1.0f).x, 0.5f);
+	EXPECT_FLOAT_EQ(rendern::ParticleFrameUvRect(emitter, 0.45f, 1.0f).x, 0.0f); // frame 4 wraps to 0
+
+	const rendern::ParticleEmitter plain{};
+	const mathUtils::Vec4 rect = rendern::ParticleFrameUvRect(plain, 0.7f, 1.0f);
+	EXPECT_FLOAT_EQ(rect.x, 0.0f);
+	EXPECT_FLOAT_EQ(rect.y, 0.0f);
+	EXPECT_FLOAT_EQ(rect.z, 1.0f);
+	EXPECT_FLOAT_EQ(rect.w, 1.0f);
+}
+
+TEST(ParticleFlipbook, GpuPoolPicksTheSameFrameAsTheCpuPath)
+{
+	rendern::ParticleEmitter overLifetime{};
+	overLifetime.uvRect = { 0.25f, 0.5f, 0.75f, 0.5f };
+	overLifetime.flipbookColumns = 3u;
+	overLifetime.flipbookRows = 2u;
+
+	rendern::ParticleEmitter fixedRate = overLifetime;
+	fixedRate.flipbookFps = 12.0f;
+
+	rendern::ParticleEmitter degenerate{};
+	degenerate.flipbookColumns = 0u; // packed as 1 x 1
+	degenerate.flipbookFps = -5.0f;
+
+	const float lifetime = 2.0f;
+	for (const rendern::ParticleEmitter* emitter : { &overLifetime, &fixedRate, &degenerate })
+	{
+		const mathUtils::Vec4 flipbook = rendern::ParticleFlipbookParams(*emitter);
+		for (float age : { -0.5f, 0.0f, 0.3f, 0.99f, 1.0f, 1.7f, 2.0f, 3.5f })
+		{
+			const mathUtils::Vec4 cpu = rendern::ParticleFrameUvRect(*emitter, age, lifetime);
+			const mathUtils::Vec4 gpu = GpuFrameUvRect(emitter->uvRect, flipbook, age, lifetime);
+			EXPECT_FLOAT_EQ(cpu.x, gpu.x) << age;
+			EXPECT_FLOAT_EQ(cpu.y, gpu.y) << age;
+			EXPECT_FLOAT_EQ(cpu.z, gpu.z) << age;
+			EXPECT_FLOAT_EQ(cpu.w, gpu.w) << age;
+		}
+	}
+
+	// A pool particle that never expires stores lifetime 0; without fps both paths hold the first frame.
+	const mathUtils::Vec4 cpuForever = rendern::ParticleFrameUvRect(overLifetime, 5.0f, std::numeric_limits<float>::infinity());
+	const mathUtils::Vec4 gpuForever = GpuFrameUvRect(overLifetime.uvRect, rendern::ParticleFlipbookParams(overLifetime), 5.0f, 0.0f);
+	EXPECT_FLOAT_EQ(cpuForever.x, gpuForever.x);
+	EXPECT_FLOAT_EQ(cpuForever.y, gpuForever.y);
+	EXPECT_FLOAT_EQ(cpuForever.x, 0.25f);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rendern::BvhAabb UnitBoxAt(float x, float y, float z)
+	{
+		return { { x - 0.5f, y - 0.5f, z - 0.5f }, { x + 0.5f, y + 0.5f, z + 0.5f } };
+	}
+
+	std::vector<std::uint32_t> Overlapping(const rendern::SceneBvh& bvh, const rendern::BvhAabb& box)
+	{
+		std::vector<std::uint32_t> out;
+		bvh.QueryOverlap(box, [&](rendern::SceneBvh::ProxyId, std::uint32_t userData) { out.push_back(userData); });
+		std::sort(out.begin(), out.end());
+		return out;
+	}
+
+	std::vector<std::uint32_t> BruteForceOverlapping(const std::vector<rendern::BvhAabb>& boxes, const rendern::BvhAabb& box)
+	{
+		std::vector<std::uint32_t> out;
+		for (std::uint32_t i = 0; i < boxes.size(); ++i)
+		{
+			if (rendern::AabbOverlaps(boxes[i], box))
+			{
+				out.push_back(i);
+			}
+		}
+		return out;
+	}
+}
+
+TEST(SceneBvh, QueriesMatchBruteForceAcrossEdits)
+{
+	rendern::SceneBvh bvh;
+	std::vector<rendern::BvhAabb> boxes;
+	std::vector<rendern::SceneBvh::ProxyId> proxies;
+	for (int i = 0; i < 200; ++i)
+	{
+		boxes.push_back(UnitBoxAt(static_cast<float>(i % 20) * 2.0f, static_cast<float>(i / 20) * 2.0f, static_cast<float>(i % 7)));
+		proxies.push_back(bvh.Insert(boxes.back(), static_cast<std::uint32_t>(i)));
+	}
+	EXPECT_EQ(bvh.GetLeafCount(), 200u);
+
+	const rendern::BvhAabb region{ { 3.0f, 3.0f, -1.0f }, { 11.0f, 9.0f, 4.0f } };
+	EXPECT_EQ(Overlapping(bvh, region), BruteForceOverlapping(boxes, region));
+
+	// Move every other leaf; ids stay valid and queries follow the new boxes.
+	for (std::uint32_t i = 0; i < boxes.size(); i += 2)
+	{
+		boxes[i] = UnitBoxAt(static_cast<float>(i % 13), 5.0f, 1.0f);
+		bvh.Update(proxies[i], boxes[i]);
+	}
+	EXPECT_EQ(Overlapping(bvh, region), BruteForceOverlapping(boxes, region));
+
+	bvh.Rebuild();
+	for (std::uint32_t i = 0; i < proxies.size(); ++i)
+	{
+		ASSERT_TRUE(bvh.IsValid(proxies[i]));
+		EXPECT_EQ(bvh.GetUserData(proxies[i]), i);
+	}
+	EXPECT_EQ(Overlapping(bvh, region), BruteForceOverlapping(boxes, region));
+}
+
+TEST(SceneBvh, RemoveKeepsOtherProxies)
+{
+	rendern::SceneBvh bvh;
+	const rendern::SceneBvh::ProxyId a = bvh.Insert(UnitBoxAt(0.0f, 0.0f, 0.0f), 0);
+	const rendern::SceneBvh::ProxyId b = bvh.Insert(UnitBoxAt(4.0f, 0.0f, 0.0f), 1);
+	const rendern::SceneBvh::ProxyId c = bvh.Insert(UnitBoxAt(8.0f, 0.0f, 0.0f), 2);
+
+	bvh.Remove(b);
+	EXPECT_FALSE(bvh.IsValid(b));
+	EXPECT_TRUE(bvh.IsValid(a));
+	EXPECT_TRUE(bvh.IsValid(c));
+	EXPECT_EQ(bvh.GetLeafCount(), 2u);
+
+	const rendern::BvhAabb everything{ { -100.0f, -100.0f, -100.0f }, { 100.0f, 100.0f, 100.0f } };
+	EXPECT_EQ(Overlapping(bvh, everything), (std::vector<std::uint32_t>{ 0, 2 }));
+
+	bvh.Remove(a);
+	bvh.Remove(c);
+	EXPECT_TRUE(Overlapping(bvh, everything).empty());
+}
+
+TEST(SceneBvh, RayCastReturnsClosestHit)
+{
+	rendern::SceneBvh bvh;
+	for (int i = 0; i < 64; ++i)
+	{
+		bvh.Insert(UnitBoxAt(static_cast<float>(i % 8) * 3.0f, static_cast<float>(i / 8) * 3.0f, 10.0f), static_cast<std::uint32_t>(i));
+	}
+	// A second layer in front of box 9 only.
+	bvh.Insert(UnitBoxAt(3.0f, 3.0f, 5.0f), 100);
+	bvh.Rebuild();
+
+	std::uint32_t hitId = ~0u;
+	const float t = bvh.RayCast({ 3.0f, 3.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, std::numeric_limits<float>::infinity(),
+		[&](rendern::SceneBvh::ProxyId proxy, std::uint32_t userData, float maxT)
+		{
+			const rendern::BvhAabb& box = bvh.GetBounds(proxy);
+			const float entry = box.min.z;
+			if (entry >= maxT)
+			{
+				return maxT;
+			}
+			hitId = userData;
+			return entry;
+		});
+	EXPECT_EQ(hitId, 100u);
+	EXPECT_FLOAT_EQ(t, 4.5f);
+
+	hitId = ~0u;
+	bvh.RayCast({ 100.0f, 100.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, std::numeric_limits<float>::infinity(),
+		[&](rendern::SceneBvh::ProxyId, std::uint32_t userData, float) { hitId = userData; return 0.0f; });
+	EXPECT_EQ(hitId, ~0u);
+}
+
+TEST(SceneBvh, RebuildsWhenDegraded)
+{
+	rendern::SceneBvh bvh;
+	std::vector<rendern::SceneBvh::ProxyId> proxies;
+	for (int i = 0; i < 256; ++i)
+	{
+		proxies.push_back(bvh.Insert(UnitBoxAt(static_cast<float>(i), 0.0f, 0.0f), static_cast<std::uint32_t>(i)));
+	}
+	bvh.Rebuild();
+	const float builtCost = bvh.ComputeCost();
+
+	// Scatter the leaves so the refit boxes overlap badly.
+	for (std::uint32_t i = 0; i < proxies.size(); ++i)
+	{
+		bvh.Update(proxies[i], UnitBoxAt(static_cast<float>((i * 97) % 256), static_cast<float>(i % 3), 0.0f));
+	}
+	EXPECT_GT(bvh.ComputeCost(), builtCost * 1.5f);
+	EXPECT_TRUE(bvh.RebuildIfDegraded());
+	EXPECT_LT(bvh.ComputeCost(), builtCost * 1.5f);
+	EXPECT_FALSE(bvh.RebuildIfDegraded());
+}
+
+TEST(SceneBvh, FrustumAabbTestIsConservative)
+{
+	mathUtils::Frustum frustum{};
+	// Half-space x >= 0 (the other planes accept everything).
+	frustum.planes[0] = { { 1.0f, 0.0f, 0.0f }, 0.0f };
+	for (int i = 1; i < 6; ++i)
+	{
+		frustum.planes[i] = { { 0.0f, 1.0f, 0.0f }, 1000.0f };
+	}
+	EXPECT_TRUE(rendern::IntersectsAabb(frustum, UnitBoxAt(0.2f, 0.0f, 0.0f)));
+	EXPECT_TRUE(rendern::IntersectsAabb(frustum, UnitBoxAt(-0.4f, 0.0f, 0.0f)));
+	EXPECT_FALSE(rendern::IntersectsAabb(frustum, UnitBoxAt(-0.6f, 0.0f, 0.0f)));
+}
@@ -102,4 +102,22 @@ TEST(FixedStepScheduler, AccumulateAnd2Ticks)
     EXPECT_EQ(result.tickToSimulate, 1);
     EXPECT_DOUBLE_EQ(result.alpha, 0.0);
 	EXPECT_EQ(result.firstTickindex, 0); // TODO : Should this be 1?
-}
\ No newline at end of file
+}
+
+TEST(FixedStepScheduler, LongFrameIsCappedWithoutBacklog)
+{
+    FixedStepScheduler scheduler(0.02);
+    scheduler.SetMaxCatchupTicks(2);
+
+    FixedStepResult result = scheduler.Advance(0.105);
+    EXPECT_EQ(result.tickToSimulate, 2);
+    EXPECT_EQ(result.droppedTicks, 3);
+    EXPECT_NEAR(result.alpha, 0.25, 1e-9);
+
+    // The dropped time does not come back on the next frames.
+    result = scheduler.Advance(0.01);
+    EXPECT_EQ(result.tickToSimulate, 0);
+    EXPECT_EQ(result.droppedTicks, 0);
+    EXPECT_EQ(result.firstTickindex, 2); // dropped ticks are not simulated ticks
+    EXPECT_NEAR(result.alpha, 0.75, 1e-9);
+}